@@ -1,152 +1,421 @@
-#include <fstream>
-
-#include "api/alphacc_config.h"
-#include "rtc_base/strings/json.h"
-
-#define RETURN_ON_FAIL(success) \
-  do {                          \
-    bool result = (success);    \
-    if (!result) {              \
-      return false;             \
-    }                           \
-  } while (0)
-
-namespace webrtc {
-// alphaCC global configurations
-static AlphaCCConfig* config;
-
-const AlphaCCConfig* GetAlphaCCConfig() {
-  return config;
-}
-
-bool ParseAlphaCCConfig(const std::string& file_path) {
-  if (!config) {
-    config = new AlphaCCConfig();
-  }
-
-  Json::Reader reader;
-  Json::Value top;
-  Json::Value second;
-  Json::Value third;
-  std::ifstream is(file_path);
-
-  auto GetString = ::rtc::GetStringFromJsonObject;
-  auto GetBool = ::rtc::GetBoolFromJsonObject;
-  auto GetInt = ::rtc::GetIntFromJsonObject;
-  auto GetValue = ::rtc::GetValueFromJsonObject;
-
-  RETURN_ON_FAIL(reader.parse(is, top));
-
-  if (GetValue(top, "server_connection", &second)) {
-    RETURN_ON_FAIL(GetString(second, "ip", &config->conn_server_ip));
-    RETURN_ON_FAIL(GetInt(second, "port", &config->conn_server_port));
-    RETURN_ON_FAIL(GetBool(second, "autoconnect", &config->conn_autoconnect));
-    RETURN_ON_FAIL(GetBool(second, "autocall", &config->conn_autocall));
-    RETURN_ON_FAIL(GetInt(second, "autoclose", &config->conn_autoclose));
-  }
-  second.clear();
-
-  if (GetValue(top, "serverless_connection", &second)) {
-    RETURN_ON_FAIL(GetInt(second, "autoclose", &config->conn_autoclose));
-    RETURN_ON_FAIL(GetValue(second, "sender", &third));
-    RETURN_ON_FAIL(GetBool(third, "enabled", &config->is_sender));
-    if (config->is_sender) {
-      RETURN_ON_FAIL(GetString(third, "dest_ip", &config->dest_ip));
-      RETURN_ON_FAIL(GetInt(third, "dest_port", &config->dest_port));
-    }
-    third.clear();
-    RETURN_ON_FAIL(GetValue(second, "receiver", &third));
-    RETURN_ON_FAIL(GetBool(third, "enabled", &config->is_receiver));
-    if (config->is_receiver) {
-      RETURN_ON_FAIL(GetString(third, "listening_ip", &config->listening_ip));
-      RETURN_ON_FAIL(GetInt(third, "listening_port", &config->listening_port));
-    }
-    third.clear();
-  }
-  second.clear();
-
-  RETURN_ON_FAIL(
-      GetInt(top, "bwe_feedback_duration", &config->bwe_feedback_duration_ms));
-
-  RETURN_ON_FAIL(GetValue(top, "onnx", &second));
-  RETURN_ON_FAIL(
-      GetString(second, "onnx_model_path", &config->onnx_model_path));
-  second.clear();
-
-  bool enabled = false;
-  RETURN_ON_FAIL(GetValue(top, "video_source", &second));
-  RETURN_ON_FAIL(GetValue(second, "video_disabled", &third));
-  RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
-  if (enabled) {
-    config->video_source_option =
-        AlphaCCConfig::VideoSourceOption::kVideoDisabled;
-  } else {
-    third.clear();
-    RETURN_ON_FAIL(GetValue(second, "webcam", &third));
-    RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
-    if (enabled) {
-      config->video_source_option = AlphaCCConfig::VideoSourceOption::kWebcam;
-    } else {
-      third.clear();
-      RETURN_ON_FAIL(GetValue(second, "video_file", &third));
-      RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
-      if (!enabled) {
-        return false;
-      }
-      config->video_source_option =
-          AlphaCCConfig::VideoSourceOption::kVideoFile;
-      RETURN_ON_FAIL(GetInt(third, "height", &config->video_height));
-      RETURN_ON_FAIL(GetInt(third, "width", &config->video_width));
-      RETURN_ON_FAIL(GetInt(third, "fps", &config->video_fps));
-      RETURN_ON_FAIL(GetString(third, "file_path", &config->video_file_path));
-    }
-  }
-  third.clear();
-  second.clear();
-  enabled = false;
-  RETURN_ON_FAIL(GetValue(top, "audio_source", &second));
-  RETURN_ON_FAIL(GetValue(second, "microphone", &third));
-  RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
-  if (enabled) {
-    config->audio_source_option = AlphaCCConfig::AudioSourceOption::kMicrophone;
-  } else {
-    third.clear();
-    RETURN_ON_FAIL(GetValue(second, "audio_file", &third));
-    RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
-    if (enabled) {
-      config->audio_source_option =
-          AlphaCCConfig::AudioSourceOption::kAudioFile;
-      RETURN_ON_FAIL(GetString(third, "file_path", &config->audio_file_path));
-    } else {
-      return false;
-    }
-  }
-
-  second.clear();
-  third.clear();
-  RETURN_ON_FAIL(GetValue(top, "save_to_file", &second));
-  RETURN_ON_FAIL(GetBool(second, "enabled", &config->save_to_file));
-  if (config->save_to_file) {
-    RETURN_ON_FAIL(GetValue(second, "video", &third));
-    RETURN_ON_FAIL(GetString(third, "file_path", &config->video_output_path));
-    RETURN_ON_FAIL(GetInt(third, "height", &config->video_output_height));
-    RETURN_ON_FAIL(GetInt(third, "width", &config->video_output_width));
-    RETURN_ON_FAIL(GetInt(third, "fps", &config->video_output_fps));
-
-    third.clear();
-    RETURN_ON_FAIL(GetValue(second, "audio", &third));
-    RETURN_ON_FAIL(GetString(third, "file_path", &config->audio_output_path));
-  }
-
-  second.clear();
-  third.clear();
-  RETURN_ON_FAIL(GetValue(top, "logging", &second));
-  RETURN_ON_FAIL(GetBool(second, "enabled", &config->save_log_to_file));
-  if (config->save_log_to_file) {
-    RETURN_ON_FAIL(GetString(second, "log_output_path", &config->log_output_path));
-  }
-
-  return true;
-}
-
-}  // namespace webrtc
+#include <atomic>
+#include <fstream>
+
+#include "api/alphacc_config.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/json.h"
+
+#define RETURN_ON_FAIL(success) \
+  do {                          \
+    bool result = (success);    \
+    if (!result) {              \
+      return false;             \
+    }                           \
+  } while (0)
+
+namespace webrtc {
+// alphaCC global configurations
+static AlphaCCConfig* global_config;
+// Set by ScopedAlphaCCConfig.
+static std::atomic<const AlphaCCConfig*> scoped_config(nullptr);
+
+const AlphaCCConfig* GetAlphaCCConfig() {
+  const AlphaCCConfig* config = scoped_config.load();
+  return config ? config : global_config;
+}
+
+ScopedAlphaCCConfig::ScopedAlphaCCConfig(const AlphaCCConfig* config) {
+  const AlphaCCConfig* previous = scoped_config.exchange(config);
+  RTC_DCHECK(!previous);
+}
+
+ScopedAlphaCCConfig::~ScopedAlphaCCConfig() {
+  scoped_config.store(nullptr);
+}
+
+bool ParseAlphaCCConfig(const std::string& file_path) {
+  if (!global_config) {
+    global_config = new AlphaCCConfig();
+  }
+  return ParseAlphaCCConfig(file_path, global_config);
+}
+
+bool ParseAlphaCCConfig(const std::string& file_path, AlphaCCConfig* config) {
+  Json::Reader reader;
+  Json::Value top;
+  Json::Value second;
+  Json::Value third;
+  std::ifstream is(file_path);
+
+  auto GetString = ::rtc::GetStringFromJsonObject;
+  auto GetBool = ::rtc::GetBoolFromJsonObject;
+  auto GetInt = ::rtc::GetIntFromJsonObject;
+  auto GetValue = ::rtc::GetValueFromJsonObject;
+
+  RETURN_ON_FAIL(reader.parse(is, top));
+
+  if (GetValue(top, "server_connection", &second)) {
+    RETURN_ON_FAIL(GetString(second, "ip", &config->conn_server_ip));
+    RETURN_ON_FAIL(GetInt(second, "port", &config->conn_server_port));
+    RETURN_ON_FAIL(GetBool(second, "autoconnect", &config->conn_autoconnect));
+    RETURN_ON_FAIL(GetBool(second, "autocall", &config->conn_autocall));
+    RETURN_ON_FAIL(GetInt(second, "autoclose", &config->conn_autoclose));
+  }
+  second.clear();
+
+  if (GetValue(top, "serverless_connection", &second)) {
+    RETURN_ON_FAIL(GetInt(second, "autoclose", &config->conn_autoclose));
+    RETURN_ON_FAIL(GetValue(second, "sender", &third));
+    RETURN_ON_FAIL(GetBool(third, "enabled", &config->is_sender));
+    if (config->is_sender) {
+      RETURN_ON_FAIL(GetString(third, "dest_ip", &config->dest_ip));
+      RETURN_ON_FAIL(GetInt(third, "dest_port", &config->dest_port));
+    }
+    third.clear();
+    RETURN_ON_FAIL(GetValue(second, "receiver", &third));
+    RETURN_ON_FAIL(GetBool(third, "enabled", &config->is_receiver));
+    if (config->is_receiver) {
+      RETURN_ON_FAIL(GetString(third, "listening_ip", &config->listening_ip));
+      RETURN_ON_FAIL(GetInt(third, "listening_port", &config->listening_port));
+      if (!GetBool(third, "reuse_port", &config->listening_reuse_port)) {
+        config->listening_reuse_port = false;
+      }
+    }
+    third.clear();
+    config->fast_start = false;
+    if (GetValue(second, "fast_start", &third)) {
+      RETURN_ON_FAIL(GetBool(third, "enabled", &config->fast_start));
+      if (!GetString(third, "dtls_certificate_path",
+                     &config->dtls_certificate_path) ||
+          !GetString(third, "dtls_private_key_path",
+                     &config->dtls_private_key_path)) {
+        config->dtls_certificate_path.clear();
+        config->dtls_private_key_path.clear();
+      }
+      if (!GetString(third, "audio_codec", &config->fast_start_audio_codec)) {
+        config->fast_start_audio_codec.clear();
+      }
+      if (!GetString(third, "video_codec", &config->fast_start_video_codec)) {
+        config->fast_start_video_codec.clear();
+      }
+    }
+    third.clear();
+  }
+  second.clear();
+
+  RETURN_ON_FAIL(
+      GetInt(top, "bwe_feedback_duration", &config->bwe_feedback_duration_ms));
+  if (!GetInt(top, "bwe_feedback_change_percent",
+              &config->bwe_feedback_change_percent)) {
+    config->bwe_feedback_change_percent = 0;
+  }
+  if (!GetInt(top, "bwe_feedback_min_interval",
+              &config->bwe_feedback_min_interval_ms)) {
+    config->bwe_feedback_min_interval_ms = 50;
+  }
+  if (!GetInt(top, "bwe_piggyback_tolerance",
+              &config->bwe_piggyback_tolerance_ms)) {
+    config->bwe_piggyback_tolerance_ms = 0;
+  }
+  if (!GetBool(top, "bwe_per_stream_estimates",
+               &config->bwe_per_stream_estimates)) {
+    config->bwe_per_stream_estimates = false;
+  }
+  if (!GetInt(top, "bwe_frame_stats_interval",
+              &config->bwe_frame_stats_interval_ms)) {
+    config->bwe_frame_stats_interval_ms = 1000;
+  }
+  if (config->bwe_frame_stats_interval_ms < 0)
+    return false;
+  if (!GetBool(top, "bwe_audio_only", &config->bwe_audio_only)) {
+    config->bwe_audio_only = false;
+  }
+  if (!GetInt(top, "bwe_audio_feature_window",
+              &config->bwe_audio_feature_window_ms)) {
+    config->bwe_audio_feature_window_ms = 200;
+  }
+  if (!GetInt(top, "bwe_audio_estimate_interval",
+              &config->bwe_audio_estimate_interval_ms)) {
+    config->bwe_audio_estimate_interval_ms = 1000;
+  }
+  if (config->bwe_audio_feature_window_ms <= 0 ||
+      config->bwe_audio_estimate_interval_ms <= 0) {
+    return false;
+  }
+
+  RETURN_ON_FAIL(GetValue(top, "onnx", &second));
+  RETURN_ON_FAIL(
+      GetString(second, "onnx_model_path", &config->onnx_model_path));
+  if (!GetInt(second, "onnx_batch_interval",
+              &config->onnx_batch_interval_ms)) {
+    config->onnx_batch_interval_ms = 0;
+  }
+  if (!GetInt(second, "onnx_intra_op_threads",
+              &config->onnx_intra_op_threads)) {
+    config->onnx_intra_op_threads = 0;
+  }
+  if (!GetInt(second, "onnx_inter_op_threads",
+              &config->onnx_inter_op_threads)) {
+    config->onnx_inter_op_threads = 0;
+  }
+  if (config->onnx_intra_op_threads < 0 || config->onnx_inter_op_threads < 0)
+    return false;
+  if (!GetBool(second, "onnx_global_thread_pools",
+               &config->onnx_global_thread_pools)) {
+    config->onnx_global_thread_pools = false;
+  }
+  std::string onnx_execution_provider;
+  if (!GetString(second, "onnx_execution_provider",
+                 &onnx_execution_provider) ||
+      onnx_execution_provider == "cpu") {
+    config->onnx_execution_provider =
+        AlphaCCConfig::OnnxExecutionProvider::kCpu;
+  } else if (onnx_execution_provider == "openvino") {
+    config->onnx_execution_provider =
+        AlphaCCConfig::OnnxExecutionProvider::kOpenVino;
+  } else if (onnx_execution_provider == "cuda") {
+    config->onnx_execution_provider =
+        AlphaCCConfig::OnnxExecutionProvider::kCuda;
+  } else {
+    return false;
+  }
+  std::string onnx_graph_optimization;
+  if (!GetString(second, "onnx_graph_optimization",
+                 &onnx_graph_optimization) ||
+      onnx_graph_optimization == "all") {
+    config->onnx_graph_optimization =
+        AlphaCCConfig::OnnxGraphOptimization::kAll;
+  } else if (onnx_graph_optimization == "extended") {
+    config->onnx_graph_optimization =
+        AlphaCCConfig::OnnxGraphOptimization::kExtended;
+  } else if (onnx_graph_optimization == "basic") {
+    config->onnx_graph_optimization =
+        AlphaCCConfig::OnnxGraphOptimization::kBasic;
+  } else if (onnx_graph_optimization == "disabled") {
+    config->onnx_graph_optimization =
+        AlphaCCConfig::OnnxGraphOptimization::kDisabled;
+  } else {
+    return false;
+  }
+  if (!GetString(second, "onnx_optimized_model_path",
+                 &config->onnx_optimized_model_path)) {
+    config->onnx_optimized_model_path.clear();
+  }
+  second.clear();
+
+  if (!GetString(top, "bwe_model_path", &config->bwe_model_path)) {
+    config->bwe_model_path.clear();
+  }
+
+  std::string bwe_estimator;
+  if (!GetString(top, "bwe_estimator", &bwe_estimator) ||
+      bwe_estimator == "onnx") {
+    config->bwe_estimator_option = AlphaCCConfig::BweEstimatorOption::kOnnx;
+  } else if (bwe_estimator == "receive_rate") {
+    config->bwe_estimator_option =
+        AlphaCCConfig::BweEstimatorOption::kReceiveRate;
+  } else if (bwe_estimator == "bwe_model") {
+    config->bwe_estimator_option = AlphaCCConfig::BweEstimatorOption::kBweModel;
+  } else {
+    return false;
+  }
+
+  std::string bwe_location;
+  if (!GetString(top, "bwe_location", &bwe_location) ||
+      bwe_location == "receiver") {
+    config->bwe_location = AlphaCCConfig::BweLocation::kReceiver;
+  } else if (bwe_location == "sender") {
+    config->bwe_location = AlphaCCConfig::BweLocation::kSender;
+  } else {
+    return false;
+  }
+
+  std::string bwe_controller;
+  if (!GetString(top, "bwe_controller", &bwe_controller) ||
+      bwe_controller == "model") {
+    config->bwe_controller_option = AlphaCCConfig::BweControllerOption::kModel;
+  } else if (bwe_controller == "hybrid") {
+    config->bwe_controller_option =
+        AlphaCCConfig::BweControllerOption::kHybrid;
+  } else {
+    return false;
+  }
+  if (!GetInt(top, "bwe_shadow_gcc_percent",
+              &config->bwe_shadow_gcc_percent)) {
+    config->bwe_shadow_gcc_percent = 0;
+  }
+  if (config->bwe_shadow_gcc_percent < 0 ||
+      config->bwe_shadow_gcc_percent > 100)
+    return false;
+
+  std::string congestion_controller;
+  if (!GetString(top, "congestion_controller", &congestion_controller) ||
+      congestion_controller == "alpha_cc") {
+    config->congestion_controller_option =
+        AlphaCCConfig::CongestionControllerOption::kAlphaCC;
+  } else if (congestion_controller == "pcc") {
+    config->congestion_controller_option =
+        AlphaCCConfig::CongestionControllerOption::kPcc;
+  } else {
+    return false;
+  }
+
+  std::string bwe_warmup_fallback;
+  if (!GetString(top, "bwe_warmup_fallback", &bwe_warmup_fallback) ||
+      bwe_warmup_fallback == "default") {
+    config->bwe_warmup_fallback_option =
+        AlphaCCConfig::BweWarmupFallbackOption::kDefault;
+  } else if (bwe_warmup_fallback == "receive_rate") {
+    config->bwe_warmup_fallback_option =
+        AlphaCCConfig::BweWarmupFallbackOption::kReceiveRate;
+  } else {
+    return false;
+  }
+
+  std::string bwe_transport_feedback;
+  if (!GetString(top, "bwe_transport_feedback", &bwe_transport_feedback) ||
+      bwe_transport_feedback == "full") {
+    config->bwe_transport_feedback_option =
+        AlphaCCConfig::BweTransportFeedbackOption::kFull;
+  } else if (bwe_transport_feedback == "reduced") {
+    config->bwe_transport_feedback_option =
+        AlphaCCConfig::BweTransportFeedbackOption::kReduced;
+  } else if (bwe_transport_feedback == "loss_only") {
+    config->bwe_transport_feedback_option =
+        AlphaCCConfig::BweTransportFeedbackOption::kLossOnly;
+  } else {
+    return false;
+  }
+  if (!GetInt(top, "bwe_transport_feedback_interval",
+              &config->bwe_transport_feedback_interval_ms)) {
+    config->bwe_transport_feedback_interval_ms = 250;
+  }
+  if (config->bwe_transport_feedback_interval_ms <= 0)
+    return false;
+
+  config->bwe_cache_path.clear();
+  if (GetValue(top, "bwe_cache", &second)) {
+    RETURN_ON_FAIL(GetString(second, "file_path", &config->bwe_cache_path));
+    if (!GetInt(second, "start_percent", &config->bwe_cache_start_percent)) {
+      config->bwe_cache_start_percent = 80;
+    }
+    if (!GetInt(second, "max_age", &config->bwe_cache_max_age_s)) {
+      config->bwe_cache_max_age_s = 24 * 3600;
+    }
+    if (config->bwe_cache_start_percent <= 0 ||
+        config->bwe_cache_start_percent > 100 ||
+        config->bwe_cache_max_age_s <= 0)
+      return false;
+  }
+  second.clear();
+
+  config->packet_capture_path.clear();
+  if (GetValue(top, "packet_capture", &second)) {
+    RETURN_ON_FAIL(
+        GetString(second, "file_path", &config->packet_capture_path));
+    if (!GetInt(second, "records", &config->packet_capture_records)) {
+      config->packet_capture_records = 1 << 16;
+    }
+    if (!GetInt(second, "session_percent",
+                &config->packet_capture_session_percent)) {
+      config->packet_capture_session_percent = 0;
+    }
+    if (!GetInt(second, "anomaly_percent",
+                &config->packet_capture_anomaly_percent)) {
+      config->packet_capture_anomaly_percent = 0;
+    }
+    if (!GetInt(second, "anomaly_window",
+                &config->packet_capture_anomaly_window_ms)) {
+      config->packet_capture_anomaly_window_ms = 2000;
+    }
+    if (config->packet_capture_records <= 0 ||
+        config->packet_capture_session_percent < 0 ||
+        config->packet_capture_session_percent > 100 ||
+        config->packet_capture_anomaly_percent < 0 ||
+        config->packet_capture_anomaly_window_ms <= 0)
+      return false;
+  }
+  second.clear();
+
+  bool enabled = false;
+  RETURN_ON_FAIL(GetValue(top, "video_source", &second));
+  RETURN_ON_FAIL(GetValue(second, "video_disabled", &third));
+  RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
+  if (enabled) {
+    config->video_source_option =
+        AlphaCCConfig::VideoSourceOption::kVideoDisabled;
+  } else {
+    third.clear();
+    RETURN_ON_FAIL(GetValue(second, "webcam", &third));
+    RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
+    if (enabled) {
+      config->video_source_option = AlphaCCConfig::VideoSourceOption::kWebcam;
+    } else {
+      third.clear();
+      RETURN_ON_FAIL(GetValue(second, "video_file", &third));
+      RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
+      if (!enabled) {
+        return false;
+      }
+      config->video_source_option =
+          AlphaCCConfig::VideoSourceOption::kVideoFile;
+      RETURN_ON_FAIL(GetInt(third, "height", &config->video_height));
+      RETURN_ON_FAIL(GetInt(third, "width", &config->video_width));
+      RETURN_ON_FAIL(GetInt(third, "fps", &config->video_fps));
+      RETURN_ON_FAIL(GetString(third, "file_path", &config->video_file_path));
+    }
+  }
+  third.clear();
+  second.clear();
+  enabled = false;
+  RETURN_ON_FAIL(GetValue(top, "audio_source", &second));
+  RETURN_ON_FAIL(GetValue(second, "microphone", &third));
+  RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
+  if (enabled) {
+    config->audio_source_option = AlphaCCConfig::AudioSourceOption::kMicrophone;
+  } else {
+    third.clear();
+    RETURN_ON_FAIL(GetValue(second, "audio_file", &third));
+    RETURN_ON_FAIL(GetBool(third, "enabled", &enabled));
+    if (enabled) {
+      config->audio_source_option =
+          AlphaCCConfig::AudioSourceOption::kAudioFile;
+      RETURN_ON_FAIL(GetString(third, "file_path", &config->audio_file_path));
+    } else {
+      return false;
+    }
+  }
+
+  second.clear();
+  third.clear();
+  RETURN_ON_FAIL(GetValue(top, "save_to_file", &second));
+  RETURN_ON_FAIL(GetBool(second, "enabled", &config->save_to_file));
+  if (config->save_to_file) {
+    RETURN_ON_FAIL(GetValue(second, "video", &third));
+    RETURN_ON_FAIL(GetString(third, "file_path", &config->video_output_path));
+    RETURN_ON_FAIL(GetInt(third, "height", &config->video_output_height));
+    RETURN_ON_FAIL(GetInt(third, "width", &config->video_output_width));
+    RETURN_ON_FAIL(GetInt(third, "fps", &config->video_output_fps));
+
+    third.clear();
+    RETURN_ON_FAIL(GetValue(second, "audio", &third));
+    RETURN_ON_FAIL(GetString(third, "file_path", &config->audio_output_path));
+  }
+
+  second.clear();
+  third.clear();
+  RETURN_ON_FAIL(GetValue(top, "logging", &second));
+  RETURN_ON_FAIL(GetBool(second, "enabled", &config->save_log_to_file));
+  if (config->save_log_to_file) {
+    RETURN_ON_FAIL(GetString(second, "log_output_path", &config->log_output_path));
+    if (!GetString(second, "stats_output_path", &config->stats_output_path)) {
+      config->stats_output_path = config->log_output_path + ".stats";
+    }
+    // Disabled unless set.
+    GetString(second, "frame_timing_log_path", &config->frame_timing_log_path);
+  }
+
+  return true;
+}
+
+}  // namespace webrtc
@@ -1,79 +1,262 @@
-/*
- *  Copyright 2012 The WebRTC Project Authors. All rights reserved.
- *
- *  Use of this source code is governed by a BSD-style license
- *  that can be found in the LICENSE file in the root of the source
- *  tree. An additional intellectual property rights grant can be found
- *  in the file PATENTS.  All contributing project authors may
- *  be found in the AUTHORS file in the root of the source tree.
- */
-
-#ifndef API_ALPHACC_CONFIG_H_
-#define API_ALPHACC_CONFIG_H_
-
-#include <string>
-
-namespace webrtc {
-
-struct AlphaCCConfig {
-  AlphaCCConfig() = default;
-  ~AlphaCCConfig() = default;
-
-  // The server to connect
-  std::string conn_server_ip;
-  int conn_server_port = 0;
-  // Connect to the server without user intervention.
-  bool conn_autoconnect = false;
-  // Call the first available other client on
-  // the server without user intervention. Note: this flag should be set
-  // to true on ONLY one of the two clients.
-  bool conn_autocall = false;
-  // The time in seconds before close automatically (always run
-  // if autoclose=0)"
-  int conn_autoclose = 0;
-
-  bool is_sender = false;
-  bool is_receiver = false;
-
-  // The address to connect to
-  std::string dest_ip;
-  int dest_port = 0;
-  std::string listening_ip;
-  int listening_port = 0;
-
-  int bwe_feedback_duration_ms = 0;
-  std::string onnx_model_path;
-
-  enum class VideoSourceOption {
-    kVideoDisabled,
-    kWebcam,
-    kVideoFile,
-  } video_source_option;
-  int video_height = 0;
-  int video_width = 0;
-  int video_fps = 0;
-  std::string video_file_path;
-
-  enum class AudioSourceOption { kMicrophone, kAudioFile } audio_source_option;
-  std::string audio_file_path;
-
-  bool save_to_file = false;
-  std::string video_output_path;
-  std::string audio_output_path;
-  int video_output_height = 0;
-  int video_output_width = 0;
-  int video_output_fps = 0;
-
-  bool save_log_to_file;
-  std::string log_output_path;
-};
-
-// Get alphaCC global configurations
-const AlphaCCConfig* GetAlphaCCConfig();
-
-// Parse configurations files from |file_path|
-bool ParseAlphaCCConfig(const std::string& file_path);
-
-}  // namespace webrtc
-
-#endif  // API_ALPHACC_CONFIG_H_
+/*
+ *  Copyright 2012 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_ALPHACC_CONFIG_H_
+#define API_ALPHACC_CONFIG_H_
+
+#include <string>
+
+namespace webrtc {
+
+struct AlphaCCConfig {
+  AlphaCCConfig() = default;
+  ~AlphaCCConfig() = default;
+
+  // The server to connect
+  std::string conn_server_ip;
+  int conn_server_port = 0;
+  // Connect to the server without user intervention.
+  bool conn_autoconnect = false;
+  // Call the first available other client on
+  // the server without user intervention. Note: this flag should be set
+  // to true on ONLY one of the two clients.
+  bool conn_autocall = false;
+  // The time in seconds before close automatically (always run
+  // if autoclose=0)"
+  int conn_autoclose = 0;
+
+  bool is_sender = false;
+  bool is_receiver = false;
+
+  // The address to connect to
+  std::string dest_ip;
+  int dest_port = 0;
+  std::string listening_ip;
+  int listening_port = 0;
+  // Lets several receiver processes listen on |listening_port| at once. The
+  // kernel spreads the senders connecting over them by the hash of their
+  // address and port, and each receiver stops listening once it has a
+  // sender, so that the next one is taken by another receiver.
+  bool listening_reuse_port = false;
+  // Fast start, for harnesses running many short sessions. The PeerConnection
+  // is set up before the peer connects, only host candidates are gathered, and
+  // the offer and the answer are each sent once gathering is done, with all
+  // candidates in them, instead of trickling the candidates afterwards.
+  bool fast_start = false;
+  // PEM files with the DTLS certificate and its private key, so that the
+  // fingerprint is the same for every session and no key is generated. If
+  // empty, a certificate is generated per session.
+  std::string dtls_certificate_path;
+  std::string dtls_private_key_path;
+  // If not empty, the only codecs offered and accepted, by name, e.g. "opus"
+  // and "VP8". Retransmission and FEC formats are kept.
+  std::string fast_start_audio_codec;
+  std::string fast_start_video_codec;
+
+  int bwe_feedback_duration_ms = 0;
+  // If positive, the receiver also sends its estimate as soon as it changed
+  // by more than this many percent, but at most every
+  // |bwe_feedback_min_interval_ms|. Stable estimates are then sent less and
+  // less often, down to every |bwe_feedback_duration_ms|.
+  int bwe_feedback_change_percent = 0;
+  int bwe_feedback_min_interval_ms = 50;
+  // Where the bandwidth estimator runs.
+  enum class BweLocation {
+    // The receiver runs |bwe_estimator_option| and sends the estimates back
+    // to the sender every |bwe_feedback_duration_ms|.
+    kReceiver,
+    // The sender runs |bwe_estimator_option| on the transport-wide feedback,
+    // so estimates are not delayed by the trip back and the receiver does not
+    // load the estimator at all.
+    kSender,
+  } bwe_location = BweLocation::kReceiver;
+  // The receive side estimator producing the estimates sent to the sender.
+  enum class BweEstimatorOption {
+    // The ONNX model at |onnx_model_path|.
+    kOnnx,
+    // The received rate plus some headroom, see
+    // ReceiveRateBandwidthEstimator.
+    kReceiveRate,
+    // The model at |bwe_model_path|, run in-tree by
+    // BweModelBandwidthEstimator.
+    kBweModel,
+  } bwe_estimator_option = BweEstimatorOption::kOnnx;
+  // What drives the sender's target rate.
+  enum class BweControllerOption {
+    // The estimates of |bwe_estimator_option| alone.
+    kModel,
+    // Those estimates arbitrated against GCC's delay and loss based
+    // estimates, see HybridNetworkController.
+    kHybrid,
+  } bwe_controller_option = BweControllerOption::kModel;
+  // Share of the calls, in percent, running GCC in the shadow of
+  // BweControllerOption::kModel to compare their estimates, see
+  // ShadowGccNetworkController.
+  int bwe_shadow_gcc_percent = 0;
+  // The congestion controller of the sender, overridden per call by the
+  // WebRTC-Bwe-CongestionController field trial, see
+  // CreateNetworkControllerFactory().
+  enum class CongestionControllerOption {
+    // The AlphaCC controllers above.
+    kAlphaCC,
+    // PCC, which sets the rate from the utility of the rates it tries and
+    // ignores the estimates of |bwe_estimator_option|, see
+    // PccNetworkController.
+    kPcc,
+  } congestion_controller_option = CongestionControllerOption::kAlphaCC;
+  // What the receiver reports while |bwe_estimator_option| is still loading.
+  enum class BweWarmupFallbackOption {
+    // The default BweMessage target rate.
+    kDefault,
+    // The same as BweEstimatorOption::kReceiveRate.
+    kReceiveRate,
+  } bwe_warmup_fallback_option = BweWarmupFallbackOption::kDefault;
+  // Append the estimate to the next transport feedback packet instead of
+  // sending it alone when that packet is due within this many milliseconds.
+  // 0 always sends the estimate in its own RTCP packet.
+  int bwe_piggyback_tolerance_ms = 0;
+  // How the receiver sends transport-wide feedback while it estimates. The
+  // sender must run BweControllerOption::kModel, which only uses the feedback
+  // for probing and the congestion window, so both sides have to agree.
+  enum class BweTransportFeedbackOption {
+    // At a share of the received bitrate, as without AlphaCC.
+    kFull,
+    // Every |bwe_transport_feedback_interval_ms|.
+    kReduced,
+    // Every |bwe_transport_feedback_interval_ms| and without the receive
+    // deltas, so only which packets were lost.
+    kLossOnly,
+  } bwe_transport_feedback_option = BweTransportFeedbackOption::kFull;
+  int bwe_transport_feedback_interval_ms = 250;
+  // If not empty, the sender keeps the last converged estimate of each
+  // |dest_ip| in this file, and later calls to it start at
+  // |bwe_cache_start_percent| of that estimate, unless it is older than
+  // |bwe_cache_max_age_s|.
+  std::string bwe_cache_path;
+  int bwe_cache_start_percent = 80;
+  int bwe_cache_max_age_s = 24 * 3600;
+  // Split the estimate between the received streams, see
+  // ReceiveStreamTracker, so that the sender knows what each SSRC may use.
+  // The split is left out of the estimates whose streams don't fit the
+  // message, see rtcp::AlphaCcBwe.
+  bool bwe_per_stream_estimates = false;
+  // How often the frame statistics of the received video streams are sampled
+  // for the receive side estimator and StatCollect. 0 disables the sampling.
+  int bwe_frame_stats_interval_ms = 1000;
+  // For calls carrying only audio. The receiver hands the estimator, and
+  // StatCollect, one feature aggregating the packets of every
+  // |bwe_audio_feature_window_ms| and estimates every
+  // |bwe_audio_estimate_interval_ms|, until a video packet arrives. The sender
+  // applies the estimates to the audio encoders alone, i.e. to their
+  // AudioNetworkAdaptor, leaving the pacer alone until a video stream is
+  // sent.
+  bool bwe_audio_only = false;
+  int bwe_audio_feature_window_ms = 200;
+  int bwe_audio_estimate_interval_ms = 1000;
+  // Header-only capture of the received RTP packets for training data, into
+  // a ring file per call named |packet_capture_path| followed by the call's
+  // id, see RtpPacketCapture. Empty disables the capture.
+  std::string packet_capture_path;
+  // Records the ring file holds, the oldest are overwritten.
+  int packet_capture_records = 1 << 16;
+  // Share of the calls, in percent, capturing every packet.
+  int packet_capture_session_percent = 0;
+  // The other calls capture the packets received within
+  // |packet_capture_anomaly_window_ms| of an estimate that differs from the
+  // previous one by at least this many percent. 0 disables it.
+  int packet_capture_anomaly_percent = 0;
+  int packet_capture_anomaly_window_ms = 2000;
+  std::string onnx_model_path;
+  // If positive, the calls of the process using the same ONNX model run it
+  // together every this many milliseconds, see OnnxInferenceService, instead
+  // of each on its own.
+  int onnx_batch_interval_ms = 0;
+  // ONNXRuntime session settings of the model. They need an onnxinfer build
+  // exporting CreateONNXInferModelWithOptions(), see onnxinfer_has_model_api,
+  // and are ignored with a warning otherwise. The thread counts are those of
+  // the intra-op and inter-op thread pools, 0 for ONNXRuntime's default.
+  int onnx_intra_op_threads = 0;
+  int onnx_inter_op_threads = 0;
+  // Run all the models of the process on the same thread pools instead of
+  // pools per model, which oversubscribe the cores with many calls.
+  bool onnx_global_thread_pools = false;
+  enum class OnnxExecutionProvider {
+    kCpu,
+    kOpenVino,
+    kCuda,
+  } onnx_execution_provider = OnnxExecutionProvider::kCpu;
+  enum class OnnxGraphOptimization {
+    kDisabled,
+    kBasic,
+    kExtended,
+    kAll,
+  } onnx_graph_optimization = OnnxGraphOptimization::kAll;
+  // If not empty, the optimized model is cached in this file, so that the
+  // graph optimizations run only once.
+  std::string onnx_optimized_model_path;
+  std::string bwe_model_path;
+
+  enum class VideoSourceOption {
+    kVideoDisabled,
+    kWebcam,
+    kVideoFile,
+  } video_source_option;
+  int video_height = 0;
+  int video_width = 0;
+  int video_fps = 0;
+  std::string video_file_path;
+
+  enum class AudioSourceOption { kMicrophone, kAudioFile } audio_source_option;
+  std::string audio_file_path;
+
+  bool save_to_file = false;
+  std::string video_output_path;
+  std::string audio_output_path;
+  int video_output_height = 0;
+  int video_output_width = 0;
+  int video_output_fps = 0;
+
+  bool save_log_to_file;
+  std::string log_output_path;
+  // Binary per-packet stats written by StatCollect::BinaryStatsRecorder.
+  // Defaults to |log_output_path| with a ".stats" suffix.
+  std::string stats_output_path;
+  // Per-frame receiver timing log, see video/frame_timing_log.h, one file per
+  // received stream with the SSRC as suffix. Empty for none.
+  std::string frame_timing_log_path;
+};
+
+// Get alphaCC global configurations
+const AlphaCCConfig* GetAlphaCCConfig();
+
+// Parse configurations files from |file_path|
+bool ParseAlphaCCConfig(const std::string& file_path);
+
+// Parse configurations files from |file_path| into |config|, e.g. for one of
+// several sessions run by the same process.
+bool ParseAlphaCCConfig(const std::string& file_path, AlphaCCConfig* config);
+
+// Makes GetAlphaCCConfig() return |config| while in scope. The modules of a
+// call read their configuration when the call is created, so creating a
+// PeerConnection in this scope gives it its own configuration. Only one may
+// exist at a time; where the factory is created by the caller,
+// PeerConnectionFactoryDependencies::alpha_cc_config is the simpler way.
+class ScopedAlphaCCConfig {
+ public:
+  explicit ScopedAlphaCCConfig(const AlphaCCConfig* config);
+  ~ScopedAlphaCCConfig();
+
+  ScopedAlphaCCConfig(const ScopedAlphaCCConfig&) = delete;
+  ScopedAlphaCCConfig& operator=(const ScopedAlphaCCConfig&) = delete;
+};
+
+}  // namespace webrtc
+
+#endif  // API_ALPHACC_CONFIG_H_
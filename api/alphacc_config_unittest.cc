@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/alphacc_config.h"
+
+#include <fstream>
+#include <string>
+
+#include "rtc_base/strings/json.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+// The smallest configuration ParseAlphaCCConfig() accepts.
+Json::Value CreateConfig() {
+  Json::Value config;
+  config["bwe_feedback_duration"] = 200;
+  config["onnx"]["onnx_model_path"] = "model.onnx";
+  config["video_source"]["video_disabled"]["enabled"] = true;
+  config["audio_source"]["microphone"]["enabled"] = true;
+  config["save_to_file"]["enabled"] = false;
+  config["logging"]["enabled"] = false;
+  return config;
+}
+
+// A receiver of the serverless example listening on |listening_port|.
+Json::Value CreateReceiverConfig(int listening_port) {
+  Json::Value config = CreateConfig();
+  Json::Value& connection = config["serverless_connection"];
+  connection["autoclose"] = 20;
+  connection["sender"]["enabled"] = false;
+  connection["receiver"]["enabled"] = true;
+  connection["receiver"]["listening_ip"] = "0.0.0.0";
+  connection["receiver"]["listening_port"] = listening_port;
+  return config;
+}
+
+class AlphaCCConfigTest : public ::testing::Test {
+ protected:
+  AlphaCCConfigTest()
+      : path_(test::TempFilename(test::OutputPath(), "alphacc_config")) {}
+  ~AlphaCCConfigTest() override { test::RemoveFile(path_); }
+
+  bool Parse(const Json::Value& json, AlphaCCConfig* config) {
+    std::ofstream(path_) << rtc::JsonValueToString(json);
+    return ParseAlphaCCConfig(path_, config);
+  }
+
+  const std::string path_;
+};
+
+TEST_F(AlphaCCConfigTest, ParsesTheReusePortOfTheReceiver) {
+  Json::Value json = CreateReceiverConfig(8000);
+  AlphaCCConfig config;
+  ASSERT_TRUE(Parse(json, &config));
+  EXPECT_TRUE(config.is_receiver);
+  EXPECT_EQ(config.listening_port, 8000);
+  EXPECT_FALSE(config.listening_reuse_port);
+
+  json["serverless_connection"]["receiver"]["reuse_port"] = true;
+  ASSERT_TRUE(Parse(json, &config));
+  EXPECT_TRUE(config.listening_reuse_port);
+}
+
+TEST_F(AlphaCCConfigTest, ParsesTheFastStartOptions) {
+  Json::Value json = CreateReceiverConfig(8000);
+  AlphaCCConfig config;
+  ASSERT_TRUE(Parse(json, &config));
+  EXPECT_FALSE(config.fast_start);
+
+  Json::Value& fast_start = json["serverless_connection"]["fast_start"];
+  fast_start["enabled"] = true;
+  fast_start["dtls_certificate_path"] = "cert.pem";
+  fast_start["dtls_private_key_path"] = "key.pem";
+  fast_start["audio_codec"] = "opus";
+  fast_start["video_codec"] = "VP8";
+  ASSERT_TRUE(Parse(json, &config));
+  EXPECT_TRUE(config.fast_start);
+  EXPECT_EQ(config.dtls_certificate_path, "cert.pem");
+  EXPECT_EQ(config.dtls_private_key_path, "key.pem");
+  EXPECT_EQ(config.fast_start_audio_codec, "opus");
+  EXPECT_EQ(config.fast_start_video_codec, "VP8");
+}
+
+TEST_F(AlphaCCConfigTest, IgnoresACertificateWithoutItsKey) {
+  Json::Value json = CreateReceiverConfig(8000);
+  Json::Value& fast_start = json["serverless_connection"]["fast_start"];
+  fast_start["enabled"] = true;
+  fast_start["dtls_certificate_path"] = "cert.pem";
+  AlphaCCConfig config;
+  ASSERT_TRUE(Parse(json, &config));
+  EXPECT_TRUE(config.fast_start);
+  // A certificate is generated per session instead.
+  EXPECT_TRUE(config.dtls_certificate_path.empty());
+  EXPECT_TRUE(config.fast_start_audio_codec.empty());
+  EXPECT_TRUE(config.fast_start_video_codec.empty());
+}
+
+TEST_F(AlphaCCConfigTest, ParsesTheCongestionController) {
+  Json::Value json = CreateReceiverConfig(8000);
+  AlphaCCConfig config;
+  ASSERT_TRUE(Parse(json, &config));
+  EXPECT_EQ(config.congestion_controller_option,
+            AlphaCCConfig::CongestionControllerOption::kAlphaCC);
+
+  json["congestion_controller"] = "pcc";
+  ASSERT_TRUE(Parse(json, &config));
+  EXPECT_EQ(config.congestion_controller_option,
+            AlphaCCConfig::CongestionControllerOption::kPcc);
+
+  json["congestion_controller"] = "alpha_cc";
+  ASSERT_TRUE(Parse(json, &config));
+  EXPECT_EQ(config.congestion_controller_option,
+            AlphaCCConfig::CongestionControllerOption::kAlphaCC);
+
+  json["congestion_controller"] = "bbr";
+  EXPECT_FALSE(Parse(json, &config));
+}
+
+TEST_F(AlphaCCConfigTest, ParsesSessionsIntoTheirOwnConfig) {
+  const AlphaCCConfig* global_config = GetAlphaCCConfig();
+  AlphaCCConfig first;
+  AlphaCCConfig second;
+  ASSERT_TRUE(Parse(CreateReceiverConfig(8000), &first));
+  ASSERT_TRUE(Parse(CreateReceiverConfig(8001), &second));
+  EXPECT_EQ(first.listening_port, 8000);
+  EXPECT_EQ(second.listening_port, 8001);
+  EXPECT_EQ(GetAlphaCCConfig(), global_config);
+}
+
+TEST_F(AlphaCCConfigTest, ScopedConfigReplacesTheGlobalConfig) {
+  const AlphaCCConfig* global_config = GetAlphaCCConfig();
+  AlphaCCConfig first;
+  AlphaCCConfig second;
+  {
+    ScopedAlphaCCConfig scoped_config(&first);
+    EXPECT_EQ(GetAlphaCCConfig(), &first);
+  }
+  EXPECT_EQ(GetAlphaCCConfig(), global_config);
+  {
+    ScopedAlphaCCConfig scoped_config(&second);
+    EXPECT_EQ(GetAlphaCCConfig(), &second);
+  }
+  EXPECT_EQ(GetAlphaCCConfig(), global_config);
+}
+
+}  // namespace
+}  // namespace webrtc
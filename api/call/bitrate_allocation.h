@@ -30,6 +30,12 @@ struct BitrateAllocationUpdate {
   DataRate stable_target_bitrate = DataRate::Zero();
   // Predicted packet loss ratio.
   double packet_loss_ratio = 0;
+  // Loss ratio the congestion controller expects ahead of the loss reports,
+  // see NetworkEstimate::predicted_loss_rate_ratio.
+  double predicted_packet_loss_ratio = 0;
+  // Share of |target_bitrate| the congestion controller expects to be left a
+  // few hundred ms from now, see NetworkEstimate::predicted_bandwidth_ratio.
+  double predicted_bitrate_ratio = 1;
   // Predicted round trip time.
   TimeDelta round_trip_time = TimeDelta::PlusInfinity();
   // |bwe_period| is deprecated, use |stable_target_bitrate| allocation instead.
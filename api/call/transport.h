@@ -16,6 +16,8 @@
 
 #include <vector>
 
+#include "rtc_base/copy_on_write_buffer.h"
+
 namespace webrtc {
 
 // TODO(holmer): Look into unifying this with the PacketOptions in
@@ -35,6 +37,11 @@ struct PacketOptions {
   bool is_retransmit = false;
   bool included_in_feedback = false;
   bool included_in_allocation = false;
+  // Whether the packet is part of a burst sent by the pacer, and if it is the
+  // last packet of it. Batchable packets may be held back by the transport
+  // until the last packet of the batch, see rtc::PacketOptions.
+  bool batchable = false;
+  bool last_packet_in_batch = false;
 };
 
 class Transport {
@@ -42,6 +49,12 @@ class Transport {
   virtual bool SendRtp(const uint8_t* packet,
                        size_t length,
                        const PacketOptions& options) = 0;
+  // Same as SendRtp(), but shares the buffer of the packet instead of copying
+  // it, so that the packet can be protected and sent in place. Capacity of
+  // |packet| beyond its size may be used for the SRTP authentication tag.
+  // Transports that don't override it get the packet through SendRtp().
+  virtual bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                             const PacketOptions& options);
   virtual bool SendRtcp(const uint8_t* packet, size_t length) = 0;
 
  protected:
@@ -0,0 +1,210 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/aes_gcm_frame_crypto.h"
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <string.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kIvSize = 12;
+constexpr size_t kTagSize = 16;
+constexpr size_t kOverhead = kIvSize + kTagSize;
+
+enum AesGcmStatus {
+  kOk = 0,
+  kBufferTooSmall = 1,
+  kCryptoFailure = 2,
+};
+
+const EVP_CIPHER* CipherForKey(rtc::ArrayView<const uint8_t> key) {
+  switch (key.size()) {
+    case 16:
+      return EVP_aes_128_gcm();
+    case 32:
+      return EVP_aes_256_gcm();
+    default:
+      return nullptr;
+  }
+}
+
+// Sets up the key schedule of |ctx|, only the IV changes between frames.
+bool InitContext(EVP_CIPHER_CTX* ctx,
+                 rtc::ArrayView<const uint8_t> key,
+                 bool encrypt) {
+  const EVP_CIPHER* cipher = CipherForKey(key);
+  if (ctx == nullptr || cipher == nullptr)
+    return false;
+  return EVP_CipherInit_ex(ctx, cipher, nullptr, key.data(), nullptr,
+                           encrypt ? 1 : 0) == 1;
+}
+
+bool AddAdditionalData(EVP_CIPHER_CTX* ctx,
+                       rtc::ArrayView<const uint8_t> additional_data) {
+  int length = 0;
+  return additional_data.empty() ||
+         EVP_CipherUpdate(ctx, nullptr, &length, additional_data.data(),
+                          additional_data.size()) == 1;
+}
+
+}  // namespace
+
+// static
+rtc::scoped_refptr<AesGcmFrameEncryptor> AesGcmFrameEncryptor::Create(
+    rtc::ArrayView<const uint8_t> key) {
+  rtc::scoped_refptr<AesGcmFrameEncryptor> encryptor(
+      new rtc::RefCountedObject<AesGcmFrameEncryptor>());
+  rtc::CritScope cs(&encryptor->crit_);
+  if (!InitContext(encryptor->ctx_, key, /*encrypt=*/true) ||
+      RAND_bytes(encryptor->base_iv_, kIvSize) != 1) {
+    return nullptr;
+  }
+  return encryptor;
+}
+
+AesGcmFrameEncryptor::AesGcmFrameEncryptor() : ctx_(EVP_CIPHER_CTX_new()) {}
+
+AesGcmFrameEncryptor::~AesGcmFrameEncryptor() {
+  EVP_CIPHER_CTX_free(ctx_);
+}
+
+int AesGcmFrameEncryptor::Encrypt(cricket::MediaType media_type,
+                                  uint32_t ssrc,
+                                  rtc::ArrayView<const uint8_t> additional_data,
+                                  rtc::ArrayView<const uint8_t> frame,
+                                  rtc::ArrayView<uint8_t> encrypted_frame,
+                                  size_t* bytes_written) {
+  if (encrypted_frame.size() < frame.size() + kOverhead)
+    return kBufferTooSmall;
+  return Seal(additional_data, frame.data(), frame.size(),
+              encrypted_frame.data(), bytes_written);
+}
+
+int AesGcmFrameEncryptor::EncryptInPlace(
+    cricket::MediaType media_type,
+    uint32_t ssrc,
+    rtc::ArrayView<const uint8_t> additional_data,
+    size_t frame_size,
+    rtc::ArrayView<uint8_t> buffer,
+    size_t* bytes_written) {
+  if (buffer.size() < frame_size + kOverhead)
+    return kBufferTooSmall;
+  return Seal(additional_data, buffer.data(), frame_size, buffer.data(),
+              bytes_written);
+}
+
+size_t AesGcmFrameEncryptor::GetMaxCiphertextByteSize(
+    cricket::MediaType media_type,
+    size_t frame_size) {
+  return frame_size + kOverhead;
+}
+
+int AesGcmFrameEncryptor::Seal(rtc::ArrayView<const uint8_t> additional_data,
+                               const uint8_t* input,
+                               size_t size,
+                               uint8_t* output,
+                               size_t* bytes_written) {
+  rtc::CritScope cs(&crit_);
+  uint8_t* iv = output + size;
+  uint8_t* tag = iv + kIvSize;
+  memcpy(iv, base_iv_, kIvSize);
+  const uint64_t frame_count = frame_count_++;
+  for (size_t i = 0; i < sizeof(frame_count); ++i)
+    iv[kIvSize - 1 - i] ^= static_cast<uint8_t>(frame_count >> (8 * i));
+
+  int length = 0;
+  if (EVP_CipherInit_ex(ctx_, nullptr, nullptr, nullptr, iv, 1) != 1 ||
+      !AddAdditionalData(ctx_, additional_data) ||
+      (size > 0 &&
+       EVP_CipherUpdate(ctx_, output, &length, input, size) != 1) ||
+      EVP_CipherFinal_ex(ctx_, output + length, &length) != 1 ||
+      EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_GET_TAG, kTagSize, tag) != 1) {
+    return kCryptoFailure;
+  }
+  *bytes_written = size + kOverhead;
+  return kOk;
+}
+
+// static
+rtc::scoped_refptr<AesGcmFrameDecryptor> AesGcmFrameDecryptor::Create(
+    rtc::ArrayView<const uint8_t> key) {
+  rtc::scoped_refptr<AesGcmFrameDecryptor> decryptor(
+      new rtc::RefCountedObject<AesGcmFrameDecryptor>());
+  rtc::CritScope cs(&decryptor->crit_);
+  if (!InitContext(decryptor->ctx_, key, /*encrypt=*/false))
+    return nullptr;
+  return decryptor;
+}
+
+AesGcmFrameDecryptor::AesGcmFrameDecryptor() : ctx_(EVP_CIPHER_CTX_new()) {}
+
+AesGcmFrameDecryptor::~AesGcmFrameDecryptor() {
+  EVP_CIPHER_CTX_free(ctx_);
+}
+
+AesGcmFrameDecryptor::Result AesGcmFrameDecryptor::Decrypt(
+    cricket::MediaType media_type,
+    const std::vector<uint32_t>& csrcs,
+    rtc::ArrayView<const uint8_t> additional_data,
+    rtc::ArrayView<const uint8_t> encrypted_frame,
+    rtc::ArrayView<uint8_t> frame) {
+  return Open(additional_data, encrypted_frame, frame.data(), frame.size());
+}
+
+AesGcmFrameDecryptor::Result AesGcmFrameDecryptor::DecryptInPlace(
+    cricket::MediaType media_type,
+    const std::vector<uint32_t>& csrcs,
+    rtc::ArrayView<const uint8_t> additional_data,
+    rtc::ArrayView<uint8_t> frame) {
+  return Open(additional_data, frame, frame.data(), frame.size());
+}
+
+size_t AesGcmFrameDecryptor::GetMaxPlaintextByteSize(
+    cricket::MediaType media_type,
+    size_t encrypted_frame_size) {
+  return encrypted_frame_size > kOverhead ? encrypted_frame_size - kOverhead
+                                          : 0;
+}
+
+AesGcmFrameDecryptor::Result AesGcmFrameDecryptor::Open(
+    rtc::ArrayView<const uint8_t> additional_data,
+    rtc::ArrayView<const uint8_t> encrypted_frame,
+    uint8_t* output,
+    size_t output_size) {
+  if (encrypted_frame.size() < kOverhead)
+    return Result(Status::kFailedToDecrypt, 0);
+  const size_t size = encrypted_frame.size() - kOverhead;
+  if (output_size < size)
+    return Result(Status::kRecoverable, 0);
+  // The tag is read before the plaintext may be written over the frame.
+  const uint8_t* iv = encrypted_frame.data() + size;
+  uint8_t tag[kTagSize];
+  memcpy(tag, iv + kIvSize, kTagSize);
+
+  rtc::CritScope cs(&crit_);
+  int length = 0;
+  if (EVP_CipherInit_ex(ctx_, nullptr, nullptr, nullptr, iv, 0) != 1 ||
+      !AddAdditionalData(ctx_, additional_data) ||
+      (size > 0 && EVP_CipherUpdate(ctx_, output, &length,
+                                    encrypted_frame.data(), size) != 1) ||
+      EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_SET_TAG, kTagSize, tag) != 1 ||
+      EVP_CipherFinal_ex(ctx_, output + length, &length) != 1) {
+    return Result(Status::kFailedToDecrypt, 0);
+  }
+  return Result(Status::kOk, size);
+}
+
+}  // namespace webrtc
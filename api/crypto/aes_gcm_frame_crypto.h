@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_CRYPTO_AES_GCM_FRAME_CRYPTO_H_
+#define API_CRYPTO_AES_GCM_FRAME_CRYPTO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/crypto/frame_decryptor_interface.h"
+#include "api/crypto/frame_encryptor_interface.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+// Forward declaration to avoid pulling in the OpenSSL headers.
+typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+
+namespace webrtc {
+
+// Frame encryption with AES-GCM, using a 128 or 256 bit key shared by the
+// sender and the receivers out of band. An encrypted frame is the ciphertext,
+// which is as long as the frame, followed by the 12 byte IV and the 16 byte
+// authentication tag. The IV is a random base XORed with a frame counter, so
+// that encryptors sharing a key are very unlikely to ever reuse an IV.
+//
+// The key schedule is set up once, when the encryptor is created, and shared
+// by all the frames it encrypts, and EncryptInPlace() writes the ciphertext
+// over the frame, so encrypting a frame neither allocates nor copies it.
+class AesGcmFrameEncryptor : public FrameEncryptorInterface {
+ public:
+  // Returns null if |key| isn't 16 or 32 bytes.
+  static rtc::scoped_refptr<AesGcmFrameEncryptor> Create(
+      rtc::ArrayView<const uint8_t> key);
+
+  int Encrypt(cricket::MediaType media_type,
+              uint32_t ssrc,
+              rtc::ArrayView<const uint8_t> additional_data,
+              rtc::ArrayView<const uint8_t> frame,
+              rtc::ArrayView<uint8_t> encrypted_frame,
+              size_t* bytes_written) override;
+  int EncryptInPlace(cricket::MediaType media_type,
+                     uint32_t ssrc,
+                     rtc::ArrayView<const uint8_t> additional_data,
+                     size_t frame_size,
+                     rtc::ArrayView<uint8_t> buffer,
+                     size_t* bytes_written) override;
+  size_t GetMaxCiphertextByteSize(cricket::MediaType media_type,
+                                  size_t frame_size) override;
+
+ protected:
+  AesGcmFrameEncryptor();
+  ~AesGcmFrameEncryptor() override;
+
+ private:
+  // Encrypts the |size| bytes at |input| into |output|, which may be the same,
+  // and appends the IV and the tag.
+  int Seal(rtc::ArrayView<const uint8_t> additional_data,
+           const uint8_t* input,
+           size_t size,
+           uint8_t* output,
+           size_t* bytes_written);
+
+  rtc::CriticalSection crit_;
+  EVP_CIPHER_CTX* const ctx_ RTC_GUARDED_BY(crit_);
+  uint8_t base_iv_[12] RTC_GUARDED_BY(crit_);
+  uint64_t frame_count_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+// Decrypts the frames of an AesGcmFrameEncryptor using the same key.
+class AesGcmFrameDecryptor : public FrameDecryptorInterface {
+ public:
+  // Returns null if |key| isn't 16 or 32 bytes.
+  static rtc::scoped_refptr<AesGcmFrameDecryptor> Create(
+      rtc::ArrayView<const uint8_t> key);
+
+  Result Decrypt(cricket::MediaType media_type,
+                 const std::vector<uint32_t>& csrcs,
+                 rtc::ArrayView<const uint8_t> additional_data,
+                 rtc::ArrayView<const uint8_t> encrypted_frame,
+                 rtc::ArrayView<uint8_t> frame) override;
+  Result DecryptInPlace(cricket::MediaType media_type,
+                        const std::vector<uint32_t>& csrcs,
+                        rtc::ArrayView<const uint8_t> additional_data,
+                        rtc::ArrayView<uint8_t> frame) override;
+  size_t GetMaxPlaintextByteSize(cricket::MediaType media_type,
+                                 size_t encrypted_frame_size) override;
+
+ protected:
+  AesGcmFrameDecryptor();
+  ~AesGcmFrameDecryptor() override;
+
+ private:
+  // Decrypts |encrypted_frame| into |output|, which may be its start.
+  Result Open(rtc::ArrayView<const uint8_t> additional_data,
+              rtc::ArrayView<const uint8_t> encrypted_frame,
+              uint8_t* output,
+              size_t output_size);
+
+  rtc::CriticalSection crit_;
+  EVP_CIPHER_CTX* const ctx_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // API_CRYPTO_AES_GCM_FRAME_CRYPTO_H_
@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/aes_gcm_frame_crypto.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+const std::vector<uint8_t> kKey(32, 0x42);
+const std::vector<uint8_t> kAdditionalData = {1, 2, 3, 4};
+const std::vector<uint8_t> kFrame = {10, 20, 30, 40, 50, 60, 70, 80, 90};
+
+std::vector<uint8_t> EncryptInPlace(AesGcmFrameEncryptor* encryptor,
+                                    const std::vector<uint8_t>& frame) {
+  std::vector<uint8_t> buffer(encryptor->GetMaxCiphertextByteSize(
+      cricket::MEDIA_TYPE_VIDEO, frame.size()));
+  std::copy(frame.begin(), frame.end(), buffer.begin());
+  size_t bytes_written = 0;
+  EXPECT_EQ(0, encryptor->EncryptInPlace(cricket::MEDIA_TYPE_VIDEO, 1,
+                                         kAdditionalData, frame.size(), buffer,
+                                         &bytes_written));
+  buffer.resize(bytes_written);
+  return buffer;
+}
+
+}  // namespace
+
+TEST(AesGcmFrameCryptoTest, RejectsInvalidKeys) {
+  EXPECT_FALSE(AesGcmFrameEncryptor::Create(std::vector<uint8_t>(20)));
+  EXPECT_FALSE(AesGcmFrameDecryptor::Create(std::vector<uint8_t>(20)));
+  EXPECT_TRUE(AesGcmFrameEncryptor::Create(std::vector<uint8_t>(16)));
+  EXPECT_TRUE(AesGcmFrameDecryptor::Create(std::vector<uint8_t>(16)));
+}
+
+TEST(AesGcmFrameCryptoTest, DecryptsInPlaceWhatWasEncryptedInPlace) {
+  auto encryptor = AesGcmFrameEncryptor::Create(kKey);
+  auto decryptor = AesGcmFrameDecryptor::Create(kKey);
+  std::vector<uint8_t> encrypted = EncryptInPlace(encryptor, kFrame);
+  EXPECT_NE(kFrame, std::vector<uint8_t>(encrypted.begin(),
+                                         encrypted.begin() + kFrame.size()));
+
+  FrameDecryptorInterface::Result result = decryptor->DecryptInPlace(
+      cricket::MEDIA_TYPE_VIDEO, {}, kAdditionalData, encrypted);
+  ASSERT_TRUE(result.IsOk());
+  ASSERT_EQ(kFrame.size(), result.bytes_written);
+  encrypted.resize(result.bytes_written);
+  EXPECT_THAT(encrypted, ElementsAreArray(kFrame));
+}
+
+TEST(AesGcmFrameCryptoTest, InPlaceAndCopyingCallsInteroperate) {
+  auto encryptor = AesGcmFrameEncryptor::Create(kKey);
+  auto decryptor = AesGcmFrameDecryptor::Create(kKey);
+  std::vector<uint8_t> encrypted(
+      encryptor->GetMaxCiphertextByteSize(cricket::MEDIA_TYPE_AUDIO,
+                                          kFrame.size()));
+  size_t bytes_written = 0;
+  ASSERT_EQ(0, encryptor->Encrypt(cricket::MEDIA_TYPE_AUDIO, 1,
+                                  kAdditionalData, kFrame, encrypted,
+                                  &bytes_written));
+  ASSERT_EQ(encrypted.size(), bytes_written);
+  ASSERT_TRUE(decryptor
+                  ->DecryptInPlace(cricket::MEDIA_TYPE_AUDIO, {},
+                                   kAdditionalData, encrypted)
+                  .IsOk());
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(encrypted.data(), kFrame.size()),
+              ElementsAreArray(kFrame));
+
+  encrypted = EncryptInPlace(encryptor, kFrame);
+  std::vector<uint8_t> decrypted(decryptor->GetMaxPlaintextByteSize(
+      cricket::MEDIA_TYPE_VIDEO, encrypted.size()));
+  FrameDecryptorInterface::Result result = decryptor->Decrypt(
+      cricket::MEDIA_TYPE_VIDEO, {}, kAdditionalData, encrypted, decrypted);
+  ASSERT_TRUE(result.IsOk());
+  EXPECT_THAT(decrypted, ElementsAreArray(kFrame));
+}
+
+TEST(AesGcmFrameCryptoTest, UsesADifferentIvForEveryFrame) {
+  auto encryptor = AesGcmFrameEncryptor::Create(kKey);
+  EXPECT_NE(EncryptInPlace(encryptor, kFrame),
+            EncryptInPlace(encryptor, kFrame));
+}
+
+TEST(AesGcmFrameCryptoTest, FailsToDecryptTamperedFrames) {
+  auto encryptor = AesGcmFrameEncryptor::Create(kKey);
+  auto decryptor = AesGcmFrameDecryptor::Create(kKey);
+  std::vector<uint8_t> encrypted = EncryptInPlace(encryptor, kFrame);
+
+  std::vector<uint8_t> tampered = encrypted;
+  tampered[0] ^= 1;
+  EXPECT_EQ(FrameDecryptorInterface::Status::kFailedToDecrypt,
+            decryptor
+                ->DecryptInPlace(cricket::MEDIA_TYPE_VIDEO, {},
+                                 kAdditionalData, tampered)
+                .status);
+  // The additional data is authenticated too.
+  tampered = encrypted;
+  EXPECT_EQ(FrameDecryptorInterface::Status::kFailedToDecrypt,
+            decryptor
+                ->DecryptInPlace(cricket::MEDIA_TYPE_VIDEO, {},
+                                 /*additional_data=*/{}, tampered)
+                .status);
+  auto other_decryptor =
+      AesGcmFrameDecryptor::Create(std::vector<uint8_t>(32, 0x43));
+  EXPECT_EQ(FrameDecryptorInterface::Status::kFailedToDecrypt,
+            other_decryptor
+                ->DecryptInPlace(cricket::MEDIA_TYPE_VIDEO, {},
+                                 kAdditionalData, encrypted)
+                .status);
+}
+
+TEST(AesGcmFrameCryptoTest, RejectsTooSmallBuffers) {
+  auto encryptor = AesGcmFrameEncryptor::Create(kKey);
+  auto decryptor = AesGcmFrameDecryptor::Create(kKey);
+  std::vector<uint8_t> buffer(kFrame.size() + 27);
+  size_t bytes_written = 0;
+  EXPECT_NE(0, encryptor->Encrypt(cricket::MEDIA_TYPE_VIDEO, 1,
+                                  kAdditionalData, kFrame, buffer,
+                                  &bytes_written));
+  std::vector<uint8_t> truncated(27);
+  EXPECT_FALSE(decryptor
+                   ->DecryptInPlace(cricket::MEDIA_TYPE_VIDEO, {},
+                                    kAdditionalData, truncated)
+                   .IsOk());
+}
+
+}  // namespace webrtc
@@ -65,6 +65,19 @@ class FrameDecryptorInterface : public rtc::RefCountInterface {
                          rtc::ArrayView<const uint8_t> encrypted_frame,
                          rtc::ArrayView<uint8_t> frame) = 0;
 
+  // Same as Decrypt(), except that the plaintext is written over the start of
+  // the encrypted |frame|. The default implementation passes |frame| as both
+  // the input and the output of Decrypt(), as the video receive stream always
+  // did; implementations that can't handle that must override it.
+  virtual Result DecryptInPlace(cricket::MediaType media_type,
+                                const std::vector<uint32_t>& csrcs,
+                                rtc::ArrayView<const uint8_t> additional_data,
+                                rtc::ArrayView<uint8_t> frame) {
+    return Decrypt(media_type, csrcs, additional_data, frame,
+                   frame.subview(0, GetMaxPlaintextByteSize(media_type,
+                                                            frame.size())));
+  }
+
   // Returns the total required length in bytes for the output of the
   // decryption. This can be larger than the actual number of bytes you need but
   // must never be smaller as it informs the size of the frame buffer.
@@ -11,6 +11,8 @@
 #ifndef API_CRYPTO_FRAME_ENCRYPTOR_INTERFACE_H_
 #define API_CRYPTO_FRAME_ENCRYPTOR_INTERFACE_H_
 
+#include <vector>
+
 #include "api/array_view.h"
 #include "api/media_types.h"
 #include "rtc_base/ref_count.h"
@@ -43,6 +45,23 @@ class FrameEncryptorInterface : public rtc::RefCountInterface {
                       rtc::ArrayView<uint8_t> encrypted_frame,
                       size_t* bytes_written) = 0;
 
+  // Same as Encrypt(), except that the frame is encrypted within |buffer|. The
+  // first |frame_size| bytes of |buffer| hold the frame, and |buffer| is at
+  // least GetMaxCiphertextByteSize() bytes, leaving tailroom for e.g. an IV or
+  // an authentication tag. The default implementation encrypts a copy of the
+  // frame with Encrypt(); implementations that can encrypt in place, like
+  // AES-GCM or AES-CTR ones, should override it to save the copy.
+  virtual int EncryptInPlace(cricket::MediaType media_type,
+                             uint32_t ssrc,
+                             rtc::ArrayView<const uint8_t> additional_data,
+                             size_t frame_size,
+                             rtc::ArrayView<uint8_t> buffer,
+                             size_t* bytes_written) {
+    std::vector<uint8_t> frame(buffer.begin(), buffer.begin() + frame_size);
+    return Encrypt(media_type, ssrc, additional_data, frame, buffer,
+                   bytes_written);
+  }
+
   // Returns the total required length in bytes for the output of the
   // encryption. This can be larger than the actual number of bytes you need but
   // must never be smaller as it informs the size of the encrypted_frame buffer.
@@ -80,6 +80,11 @@ class FecController {
 
   // Returns whether this FEC Controller needs Loss Vector Mask as input.
   virtual bool UseLossVectorMask() = 0;
+
+  // Informs of the packet loss ratio, in [0, 1], that the congestion
+  // controller expects before the receiver reports it, e.g. when it sees the
+  // link capacity drop. Called before each UpdateFecRates().
+  virtual void OnPredictedPacketLoss(float predicted_loss_ratio) {}
 };
 
 class FecControllerFactoryInterface {
@@ -32,6 +32,14 @@ class TransformableFrameInterface {
   // Copies |data| into the owned frame payload data.
   virtual void SetData(rtc::ArrayView<const uint8_t> data) = 0;
 
+  // Returns the frame payload data resized to |size| bytes, keeping the data
+  // up to that size, for the transform to modify in place. The payload is
+  // shared with e.g. the encoder until then, and only copied by the first call
+  // on a sender frame; transforms writing their output over their input this
+  // way save the copy of SetData(). The data is valid until the next non-const
+  // method call. Frames that don't support it return an empty view.
+  virtual rtc::ArrayView<uint8_t> GetMutableData(size_t size) { return {}; }
+
   virtual uint32_t GetTimestamp() const = 0;
   virtual uint32_t GetSsrc() const = 0;
 };
@@ -72,7 +80,10 @@ class TransformedFrameCallback : public rtc::RefCountInterface {
 };
 
 // Transforms encoded frames. The transformed frame is sent in a callback using
-// the TransformedFrameCallback interface (see above).
+// the TransformedFrameCallback interface (see above). A transformer may also
+// run the callback synchronously, from within Transform(); the video send and
+// receive streams then carry on with the transformed frame right away, on the
+// thread they called Transform() on, instead of posting it back there.
 class FrameTransformerInterface : public rtc::RefCountInterface {
  public:
   // Transforms |frame| using the implementing class' processing logic.
@@ -23,6 +23,7 @@
 #include "api/audio_codecs/audio_format.h"
 #include "api/rtp_headers.h"
 #include "api/scoped_refptr.h"
+#include "api/transport/queueing_delay_trend.h"
 
 namespace webrtc {
 
@@ -257,10 +258,18 @@ class NetEq {
   // Returns current value of base minimum delay in milliseconds.
   virtual int GetBaseMinimumDelayMs() const = 0;
 
+  // Updates the queueing delay trend of the network path, which the target
+  // delay follows ahead of the inter-arrival times.
+  virtual void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) {}
+
   // Returns the current target delay in ms. This includes any extra delay
   // requested through SetMinimumDelay.
   virtual int TargetDelayMs() const = 0;
 
+  // Returns the target delay in ms that the jitter alone calls for, without
+  // any extra delay requested through SetMinimumDelay.
+  virtual int UnconstrainedTargetDelayMs() const { return TargetDelayMs(); }
+
   // Returns the current total delay (packet buffer and sync buffer) in ms,
   // with smoothing applied to even out short-time fluctuations due to jitter.
   // The packet buffer part of the delay is not updated during DTX/CNG periods.
@@ -20,6 +20,7 @@
 #include "absl/types/optional.h"
 #include "api/neteq/neteq.h"
 #include "api/neteq/tick_timer.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
@@ -135,6 +136,10 @@ class NetEqController {
   virtual bool SetBaseMinimumDelay(int delay_ms) = 0;
   virtual int GetBaseMinimumDelay() const = 0;
 
+  // Updates the queueing delay trend of the network path, see
+  // NetEq::UpdateQueueingDelayTrend().
+  virtual void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) {}
+
   // These methods test the |cng_state_| for different conditions.
   virtual bool CngRfc3389On() const = 0;
   virtual bool CngOff() const = 0;
@@ -154,6 +159,10 @@ class NetEqController {
   // Returns the target buffer level in ms.
   virtual int TargetLevelMs() = 0;
 
+  // Returns the target buffer level in ms before any minimum or maximum delay
+  // is applied.
+  virtual int UnconstrainedTargetLevelMs() { return TargetLevelMs(); }
+
   // Notify the NetEqController that a packet has arrived. Returns the relative
   // arrival delay, if it can be computed.
   virtual absl::optional<int> PacketArrived(bool last_cng_or_dtmf,
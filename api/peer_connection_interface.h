@@ -73,6 +73,7 @@
 #include <string>
 #include <vector>
 
+#include "api/alphacc_config.h"
 #include "api/async_resolver_factory.h"
 #include "api/audio/audio_mixer.h"
 #include "api/audio_codecs/audio_decoder_factory.h"
@@ -120,7 +121,12 @@
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/system/rtc_export.h"
 
+namespace cricket {
+class CandidatePairHistory;
+}  // namespace cricket
+
 namespace rtc {
+class SSLSessionCache;
 class Thread;
 }  // namespace rtc
 
@@ -570,6 +576,43 @@ class RTC_EXPORT PeerConnectionInterface : public rtc::RefCountInterface {
     // binding requests to keep NAT bindings open.
     absl::optional<int> stun_candidate_keepalive_interval;
 
+    // If true, the host, relay and TCP candidates of each network are gathered
+    // at once instead of one after the other, 50 ms apart.
+    bool parallel_candidate_gathering = false;
+
+    // If true, the controlling side nominates every candidate pair it checks
+    // unless the remote side is ICE lite, so that the controlled side can
+    // select a candidate pair as soon as one works.
+    bool aggressive_ice_nomination = false;
+
+    // Optional history of the candidate pairs selected in earlier sessions,
+    // see cricket::CandidatePairHistory. Candidate pairs of the kinds selected
+    // more often are checked first. It may be shared between PeerConnections
+    // and has to remain valid until PeerConnection::Close() is called.
+    cricket::CandidatePairHistory* candidate_pair_history = nullptr;
+
+    // Optional cache of the sessions of earlier DTLS handshakes, see
+    // rtc::SSLSessionCache. A new handshake with a remote peer whose
+    // certificate was seen before then takes one round trip instead of two.
+    // It may be shared between PeerConnections and has to remain valid until
+    // PeerConnection::Close() is called.
+    rtc::SSLSessionCache* ssl_session_cache = nullptr;
+
+    // Sizes of the send and receive buffers of the SCTP association of data
+    // channels, which bound the data in flight. The usrsctp defaults cap the
+    // throughput on paths with a large bandwidth-delay product. A send buffer
+    // smaller than the default of 256 kB is ignored.
+    absl::optional<int> sctp_send_buffer_size;
+    absl::optional<int> sctp_receive_buffer_size;
+
+    // If set, data channels are limited to a share of the target rate of the
+    // congestion controller, which is split between them and the media
+    // streams in proportion to the bitrate priorities. Media streams have a
+    // priority of 1.0 by default. So bulk data only fills what media leaves,
+    // instead of SCTP competing with media for the bandwidth. Without media
+    // there is no target rate and data channels are not limited.
+    absl::optional<double> data_channel_bitrate_priority;
+
     // Optional TurnCustomizer.
     // With this class one can modify outgoing TURN messages.
     // The object passed in must remain valid until PeerConnection::Close() is
@@ -1330,6 +1373,16 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   rtc::Thread* network_thread = nullptr;
   rtc::Thread* worker_thread = nullptr;
   rtc::Thread* signaling_thread = nullptr;
+  // More threads to spread the networking of the PeerConnections over, which
+  // like |network_thread| must have a socket server and be started. Each
+  // PeerConnection runs its ports, ICE and DTLS on one of |network_thread|
+  // and these, assigned in turn when it is created.
+  std::vector<rtc::Thread*> additional_network_threads;
+  // The number of certificates the factory generates ahead of time for the
+  // PeerConnections created without a certificate generator, so that they
+  // don't wait on the key generation. 0 generates one per PeerConnection
+  // when it needs it.
+  size_t certificate_pool_size = 0;
   std::unique_ptr<TaskQueueFactory> task_queue_factory;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine;
   std::unique_ptr<CallFactoryInterface> call_factory;
@@ -1341,6 +1394,9 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   std::unique_ptr<MediaTransportFactory> media_transport_factory;
   std::unique_ptr<NetEqFactory> neteq_factory;
   std::unique_ptr<WebRtcKeyValueConfig> trials;
+  // AlphaCC configuration of the calls of the factory's PeerConnections,
+  // which must outlive the factory. Null means GetAlphaCCConfig().
+  const AlphaCCConfig* alpha_cc_config = nullptr;
 };
 
 // PeerConnectionFactoryInterface is the factory interface used for creating
@@ -26,6 +26,7 @@
 namespace webrtc {
 
 class RTCStatsMemberInterface;
+class RTCStatsMemberVisitor;
 
 // Abstract base class for RTCStats-derived dictionaries, see
 // https://w3c.github.io/webrtc-stats/.
@@ -70,6 +71,9 @@ class RTC_EXPORT RTCStats {
   // of this class. This allows for iteration of members. For a given class,
   // |Members| always returns the same members in the same order.
   std::vector<const RTCStatsMemberInterface*> Members() const;
+  // Passes the name and value of each defined member to |visitor|, in the
+  // order of |Members|, without converting the values to strings.
+  void VisitMembers(RTCStatsMemberVisitor* visitor) const;
   // Checks if the two stats objects are of the same type and have the same
   // member values. Timestamps are not compared. These operators are exposed for
   // testing.
@@ -214,6 +218,30 @@ enum class NonStandardGroupId {
   kRtcStatsRelativePacketArrivalDelay,
 };
 
+// Receives the typed values of |RTCStats| members, see
+// |RTCStatsMemberInterface::Accept|. There is a method for each of the types
+// listed in |RTCStatsMemberInterface::Type|.
+class RTCStatsMemberVisitor {
+ public:
+  virtual ~RTCStatsMemberVisitor() {}
+
+  virtual void Visit(const char* name, bool value) = 0;
+  virtual void Visit(const char* name, int32_t value) = 0;
+  virtual void Visit(const char* name, uint32_t value) = 0;
+  virtual void Visit(const char* name, int64_t value) = 0;
+  virtual void Visit(const char* name, uint64_t value) = 0;
+  virtual void Visit(const char* name, double value) = 0;
+  virtual void Visit(const char* name, const std::string& value) = 0;
+  virtual void Visit(const char* name, const std::vector<bool>& value) = 0;
+  virtual void Visit(const char* name, const std::vector<int32_t>& value) = 0;
+  virtual void Visit(const char* name, const std::vector<uint32_t>& value) = 0;
+  virtual void Visit(const char* name, const std::vector<int64_t>& value) = 0;
+  virtual void Visit(const char* name, const std::vector<uint64_t>& value) = 0;
+  virtual void Visit(const char* name, const std::vector<double>& value) = 0;
+  virtual void Visit(const char* name,
+                     const std::vector<std::string>& value) = 0;
+};
+
 // Interface for |RTCStats| members, which have a name and a value of a type
 // defined in a subclass. Only the types listed in |Type| are supported, these
 // are implemented by |RTCStatsMember<T>|. The value of a member may be
@@ -265,6 +293,9 @@ class RTCStatsMemberInterface {
   // cannot be accurately represented, so we prefer to display them as doubles
   // instead.
   virtual std::string ValueToJson() const = 0;
+  // Passes the name and the value to the |visitor| method of the member's
+  // type. The value can only be visited if |is_defined|.
+  virtual void Accept(RTCStatsMemberVisitor* visitor) const = 0;
 
   template <typename T>
   const T& cast_to() const {
@@ -318,6 +349,10 @@ class RTCStatsMember : public RTCStatsMemberInterface {
   }
   std::string ValueToString() const override;
   std::string ValueToJson() const override;
+  void Accept(RTCStatsMemberVisitor* visitor) const override {
+    RTC_DCHECK(is_defined_);
+    visitor->Visit(name_, value_);
+  }
 
   // Assignment operators.
   T& operator=(const T& value) {
@@ -0,0 +1,56 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_STATS_RTC_STATS_BINARY_H_
+#define API_STATS_RTC_STATS_BINARY_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "api/array_view.h"
+#include "api/stats/rtc_stats.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// The binary representation written by |RTCStatsReport::AppendBinary|. Each
+// report is
+//   the magic bytes "RSB1", the timestamp and the number of stats objects,
+// followed by each stats object as
+//   type, id, timestamp and the number of defined members,
+// followed by each defined member as
+//   name, |RTCStatsMemberInterface::Type| as one byte and value.
+// Unsigned integers and counts are LEB128 varints, signed integers and
+// timestamps are zigzag encoded varints, bools are one byte, doubles are
+// 8 bytes little endian and strings are their length followed by their bytes.
+// Sequences are their length followed by their elements. Reports can be
+// appended one after the other to the same file.
+
+// Receives the reports read by |ReadRTCStatsReportsBinary|. The member values
+// of each stats object are passed to the |RTCStatsMemberVisitor| methods after
+// |OnStats|. Names and strings are only valid during the call.
+class RTCStatsReportVisitor : public RTCStatsMemberVisitor {
+ public:
+  virtual void OnReport(int64_t timestamp_us) = 0;
+  virtual void OnStats(const std::string& type,
+                       const std::string& id,
+                       int64_t timestamp_us) = 0;
+};
+
+// Reads the reports that were appended to |data| and passes them to
+// |visitor|. Returns false if |data| is truncated or malformed, in which case
+// the reports before the broken one have been passed to |visitor| already.
+RTC_EXPORT bool ReadRTCStatsReportsBinary(rtc::ArrayView<const uint8_t> data,
+                                          RTCStatsReportVisitor* visitor);
+
+}  // namespace webrtc
+
+#endif  // API_STATS_RTC_STATS_BINARY_H_
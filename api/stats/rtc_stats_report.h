@@ -21,6 +21,7 @@
 
 #include "api/scoped_refptr.h"
 #include "api/stats/rtc_stats.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/ref_count.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/system/rtc_export.h"
@@ -106,6 +107,10 @@ class RTC_EXPORT RTCStatsReport : public rtc::RefCountInterface {
   // Creates a JSON readable string representation of the report,
   // listing all of its stats objects.
   std::string ToJson() const;
+  // Appends a compact binary representation of the report to |output|, which
+  // is read back with |ReadRTCStatsReportsBinary|, see rtc_stats_binary.h.
+  // Unlike |ToJson| no value is converted to a string.
+  void AppendBinary(rtc::Buffer* output) const;
 
   friend class rtc::RefCountedObject<RTCStatsReport>;
 
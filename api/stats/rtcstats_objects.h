@@ -613,6 +613,31 @@ class RTC_EXPORT RTCTransportStats final : public RTCStats {
   RTCStatsMember<std::string> dtls_cipher;
   RTCStatsMember<std::string> srtp_cipher;
   RTCStatsMember<uint32_t> selected_candidate_pair_changes;
+  // Non-standard members, only defined while the AlphaCC receive side
+  // estimator runs. The times are in seconds, the bitrates in bits per second.
+  RTCNonStandardStatsMember<uint64_t> bwe_estimates;
+  RTCNonStandardStatsMember<uint64_t> bwe_dropped_packets;
+  RTCNonStandardStatsMember<double> bwe_inference_time_p50;
+  RTCNonStandardStatsMember<double> bwe_inference_time_p99;
+  RTCNonStandardStatsMember<uint32_t> bwe_pending_packets_p50;
+  RTCNonStandardStatsMember<uint32_t> bwe_pending_packets_p99;
+  // The estimate sent to the remote sender.
+  RTCNonStandardStatsMember<double> bwe_estimate;
+  // False while the estimates come from the fallback estimator.
+  RTCNonStandardStatsMember<bool> bwe_model_ready;
+  // Only defined if the model was picked by BweModelManager.
+  RTCNonStandardStatsMember<std::string> bwe_model_version;
+  // Non-standard members, only defined once an AlphaCC estimate is received
+  // from the remote receive side.
+  RTCNonStandardStatsMember<double> bwe_remote_estimate;
+  RTCNonStandardStatsMember<double> bwe_remote_estimate_age;
+  // Undefined until the second estimate is received.
+  RTCNonStandardStatsMember<double> bwe_remote_estimate_interval;
+  // The target the send side applies, after its rate limits.
+  RTCNonStandardStatsMember<double> bwe_target_bitrate;
+  // Only defined while GCC runs in the shadow of the AlphaCC controller, the
+  // target it would apply.
+  RTCNonStandardStatsMember<double> bwe_shadow_gcc_estimate;
 };
 
 }  // namespace webrtc
@@ -16,6 +16,7 @@
 #include "rtc_base/checks.h"
 #include "test/frame_generator.h"
 #include "test/testsupport/ivf_video_frame_generator.h"
+#include "test/testsupport/streaming_yuv_frame_generator.h"
 
 namespace webrtc {
 namespace test {
@@ -47,6 +48,16 @@ std::unique_ptr<FrameGeneratorInterface> CreateFromYuvFileFrameGenerator(
                                             frame_repeat_count);
 }
 
+std::unique_ptr<FrameGeneratorInterface>
+CreateStreamingFromYuvFileFrameGenerator(std::string filename,
+                                         size_t width,
+                                         size_t height,
+                                         int frame_repeat_count,
+                                         size_t prefetch_frames) {
+  return std::make_unique<StreamingYuvFrameGenerator>(
+      filename, width, height, frame_repeat_count, prefetch_frames);
+}
+
 std::unique_ptr<FrameGeneratorInterface> CreateFromIvfFileFrameGenerator(
     std::string filename) {
   return std::make_unique<IvfVideoFrameGenerator>(std::move(filename));
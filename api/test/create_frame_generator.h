@@ -41,6 +41,16 @@ std::unique_ptr<FrameGeneratorInterface> CreateFromYuvFileFrameGenerator(
     size_t height,
     int frame_repeat_count);
 
+// Creates a frame generator that repeatedly plays a yuv or y4m file, reading
+// up to |prefetch_frames| frames ahead on a thread of its own. The frame size
+// of a y4m file is taken from its header, |width| and |height| are then unused.
+std::unique_ptr<FrameGeneratorInterface>
+CreateStreamingFromYuvFileFrameGenerator(std::string filename,
+                                         size_t width,
+                                         size_t height,
+                                         int frame_repeat_count,
+                                         size_t prefetch_frames = 3);
+
 // Creates a frame generator that repeatedly plays an ivf file.
 std::unique_ptr<FrameGeneratorInterface> CreateFromIvfFileFrameGenerator(
     std::string filename);
@@ -22,4 +22,11 @@ std::unique_ptr<NetworkEmulationManager> CreateNetworkEmulationManager(
   return std::make_unique<test::NetworkEmulationManagerImpl>(mode);
 }
 
+std::unique_ptr<NetworkEmulationManager> CreateNetworkEmulationManager(
+    TimeMode mode,
+    size_t num_shards) {
+  return std::make_unique<test::NetworkEmulationManagerImpl>(mode,
+                                                             num_shards);
+}
+
 }  // namespace webrtc
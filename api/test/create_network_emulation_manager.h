@@ -12,6 +12,8 @@
 #ifndef API_TEST_CREATE_NETWORK_EMULATION_MANAGER_H_
 #define API_TEST_CREATE_NETWORK_EMULATION_MANAGER_H_
 
+#include <stddef.h>
+
 #include <memory>
 
 #include "api/test/network_emulation_manager.h"
@@ -21,6 +23,12 @@ namespace webrtc {
 std::unique_ptr<NetworkEmulationManager> CreateNetworkEmulationManager(
     TimeMode mode = TimeMode::kRealTime);
 
+// Creates a manager processing the packets of its network nodes on
+// |num_shards| task queues, for networks too large for a single one.
+std::unique_ptr<NetworkEmulationManager> CreateNetworkEmulationManager(
+    TimeMode mode,
+    size_t num_shards);
+
 }  // namespace webrtc
 
 #endif  // API_TEST_CREATE_NETWORK_EMULATION_MANAGER_H_
@@ -13,7 +13,15 @@
 #include <memory>
 #include <utility>
 #include "absl/memory/memory.h"
+#include "api/alphacc_config.h"
 #include "modules/congestion_controller/alpha_cc/alpha_cc_network_control.h"
+#include "modules/congestion_controller/alpha_cc/hybrid_network_control.h"
+#include "modules/congestion_controller/alpha_cc/sender_side_network_control.h"
+#include "modules/congestion_controller/alpha_cc/shadow_gcc_network_control.h"
+#include "modules/congestion_controller/pcc/pcc_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
 
 namespace webrtc {
@@ -35,6 +43,33 @@ std::unique_ptr<NetworkControllerInterface>
 GoogCcNetworkControllerFactory::Create(NetworkControllerConfig config) {
   if (event_log_)
     config.event_log = event_log_;
+  std::unique_ptr<NetworkControllerInterface> controller =
+      CreateModelController(config);
+  if (!alpha_cc_config_)
+    return controller;
+  if (alpha_cc_config_->bwe_controller_option ==
+      AlphaCCConfig::BweControllerOption::kHybrid) {
+    return std::make_unique<HybridNetworkController>(config,
+                                                     std::move(controller));
+  }
+  // Sampled per call, so that a sampled call compares over its whole length.
+  if (static_cast<int>(rtc::CreateRandomId() % 100) <
+      alpha_cc_config_->bwe_shadow_gcc_percent) {
+    RTC_LOG(LS_INFO) << "Running GCC in the shadow of the AlphaCC controller";
+    return std::make_unique<ShadowGccNetworkController>(config,
+                                                        std::move(controller));
+  }
+  return controller;
+}
+
+std::unique_ptr<NetworkControllerInterface>
+GoogCcNetworkControllerFactory::CreateModelController(
+    NetworkControllerConfig config) {
+  if (alpha_cc_config_ &&
+      alpha_cc_config_->bwe_location == AlphaCCConfig::BweLocation::kSender) {
+    return std::make_unique<SenderSideNetworkController>(config,
+                                                         *alpha_cc_config_);
+  }
   GoogCcConfig goog_cc_config;
   goog_cc_config.feedback_only = factory_config_.feedback_only;
   if (factory_config_.network_state_estimator_factory) {
@@ -63,4 +98,30 @@ GoogCcFeedbackNetworkControllerFactory::GoogCcFeedbackNetworkControllerFactory(
   factory_config_.feedback_only = true;
 }
 
+std::unique_ptr<NetworkControllerFactoryInterface>
+CreateNetworkControllerFactory(GoogCcFactoryConfig config,
+                               const WebRtcKeyValueConfig* trials) {
+  RTC_DCHECK(trials);
+  const AlphaCCConfig* alpha_cc_config =
+      config.alpha_cc_config ? config.alpha_cc_config : GetAlphaCCConfig();
+  FieldTrialEnum<AlphaCCConfig::CongestionControllerOption> controller(
+      "controller",
+      alpha_cc_config ? alpha_cc_config->congestion_controller_option
+                      : AlphaCCConfig::CongestionControllerOption::kAlphaCC,
+      {{"alpha_cc", AlphaCCConfig::CongestionControllerOption::kAlphaCC},
+       {"pcc", AlphaCCConfig::CongestionControllerOption::kPcc}});
+  ParseFieldTrial({&controller},
+                  trials->Lookup("WebRTC-Bwe-CongestionController"));
+  switch (controller.Get()) {
+    case AlphaCCConfig::CongestionControllerOption::kAlphaCC:
+      return std::make_unique<GoogCcNetworkControllerFactory>(
+          std::move(config));
+    case AlphaCCConfig::CongestionControllerOption::kPcc:
+      RTC_LOG(LS_INFO) << "Using the PCC congestion controller";
+      return std::make_unique<PccNetworkControllerFactory>();
+  }
+  RTC_NOTREACHED();
+  return nullptr;
+}
+
 }  // namespace webrtc
@@ -12,8 +12,10 @@
 #define API_TRANSPORT_GOOG_CC_FACTORY_H_
 #include <memory>
 
+#include "api/alphacc_config.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/network_control.h"
+#include "api/transport/webrtc_key_value_config.h"
 #include "rtc_base/deprecation.h"
 
 namespace webrtc {
@@ -25,6 +27,8 @@ struct GoogCcFactoryConfig {
   NetworkStatePredictorFactoryInterface* network_state_predictor_factory =
       nullptr;
   bool feedback_only = false;
+  // Must outlive the factory, null means GetAlphaCCConfig().
+  const AlphaCCConfig* alpha_cc_config = nullptr;
 };
 
 class GoogCcNetworkControllerFactory
@@ -42,8 +46,17 @@ class GoogCcNetworkControllerFactory
   TimeDelta GetProcessInterval() const override;
 
  protected:
+  // Creates the controller following the AlphaCC estimates.
+  std::unique_ptr<NetworkControllerInterface> CreateModelController(
+      NetworkControllerConfig config);
+
   RtcEventLog* const event_log_ = nullptr;
   GoogCcFactoryConfig factory_config_;
+  // Read when the factory is created, i.e. with the call, as controllers are
+  // created later, on the transport task queue.
+  const AlphaCCConfig* const alpha_cc_config_ =
+      factory_config_.alpha_cc_config ? factory_config_.alpha_cc_config
+                                      : GetAlphaCCConfig();
 };
 
 // Deprecated, use GoogCcFactoryConfig to enable feedback only mode instead.
@@ -55,6 +68,15 @@ class RTC_DEPRECATED GoogCcFeedbackNetworkControllerFactory
   explicit GoogCcFeedbackNetworkControllerFactory(RtcEventLog* event_log);
 };
 
+// Creates the factory of the congestion controller selected by
+// |config.alpha_cc_config|, unless the "controller" parameter of the
+// WebRTC-Bwe-CongestionController field trial selects another one, e.g.
+// "WebRTC-Bwe-CongestionController/controller:pcc/". All the controllers are
+// linked in, so that calls can compare them without a rebuild.
+std::unique_ptr<NetworkControllerFactoryInterface>
+CreateNetworkControllerFactory(GoogCcFactoryConfig config,
+                               const WebRtcKeyValueConfig* trials);
+
 }  // namespace webrtc
 
 #endif  // API_TRANSPORT_GOOG_CC_FACTORY_H_
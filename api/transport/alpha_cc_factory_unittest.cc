@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/transport/alpha_cc_factory.h"
+
+#include <memory>
+
+#include "api/transport/field_trial_based_config.h"
+#include "test/field_trial.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// The AlphaCC controllers are driven by a 25 ms process interval, PCC only
+// by the feedback.
+constexpr TimeDelta kAlphaCCProcessInterval = TimeDelta::Millis(25);
+
+std::unique_ptr<NetworkControllerFactoryInterface> CreateFactory(
+    const AlphaCCConfig* alpha_cc_config) {
+  FieldTrialBasedConfig trials;
+  GoogCcFactoryConfig config;
+  config.alpha_cc_config = alpha_cc_config;
+  return CreateNetworkControllerFactory(std::move(config), &trials);
+}
+
+TEST(CreateNetworkControllerFactoryTest, CreatesTheAlphaCCControllerByDefault) {
+  AlphaCCConfig alpha_cc_config;
+  std::unique_ptr<NetworkControllerFactoryInterface> factory =
+      CreateFactory(&alpha_cc_config);
+  ASSERT_TRUE(factory);
+  EXPECT_EQ(factory->GetProcessInterval(), kAlphaCCProcessInterval);
+}
+
+TEST(CreateNetworkControllerFactoryTest, CreatesTheControllerOfTheConfig) {
+  AlphaCCConfig alpha_cc_config;
+  alpha_cc_config.congestion_controller_option =
+      AlphaCCConfig::CongestionControllerOption::kPcc;
+  std::unique_ptr<NetworkControllerFactoryInterface> factory =
+      CreateFactory(&alpha_cc_config);
+  ASSERT_TRUE(factory);
+  EXPECT_TRUE(factory->GetProcessInterval().IsPlusInfinity());
+}
+
+TEST(CreateNetworkControllerFactoryTest, FieldTrialSelectsPcc) {
+  test::ScopedFieldTrials trials(
+      "WebRTC-Bwe-CongestionController/controller:pcc/");
+  AlphaCCConfig alpha_cc_config;
+  EXPECT_TRUE(
+      CreateFactory(&alpha_cc_config)->GetProcessInterval().IsPlusInfinity());
+}
+
+TEST(CreateNetworkControllerFactoryTest, FieldTrialOverridesTheConfig) {
+  test::ScopedFieldTrials trials(
+      "WebRTC-Bwe-CongestionController/controller:alpha_cc/");
+  AlphaCCConfig alpha_cc_config;
+  alpha_cc_config.congestion_controller_option =
+      AlphaCCConfig::CongestionControllerOption::kPcc;
+  EXPECT_EQ(CreateFactory(&alpha_cc_config)->GetProcessInterval(),
+            kAlphaCCProcessInterval);
+}
+
+TEST(CreateNetworkControllerFactoryTest, IgnoresAnUnknownController) {
+  test::ScopedFieldTrials trials(
+      "WebRTC-Bwe-CongestionController/controller:bbr/");
+  AlphaCCConfig alpha_cc_config;
+  alpha_cc_config.congestion_controller_option =
+      AlphaCCConfig::CongestionControllerOption::kPcc;
+  EXPECT_TRUE(
+      CreateFactory(&alpha_cc_config)->GetProcessInterval().IsPlusInfinity());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -121,6 +121,11 @@ class DataChannelTransportInterface {
   // Note: the default implementation always returns false (as it assumes no one
   // has implemented the interface).  This default implementation is temporary.
   virtual bool IsReadyToSend() const = 0;
+
+  // Limits the rate at which SendData() accepts data to |bitrate_bps|, or
+  // removes the limit if it is unset. Over the limit SendData() fails with
+  // RESOURCE_EXHAUSTED until the sink is told that it is ready to send again.
+  virtual void SetSendRateLimit(absl::optional<int> bitrate_bps) {}
 };
 
 }  // namespace webrtc
@@ -94,6 +94,10 @@ class NetworkControllerInterface {
   // Called with per packet feedback regarding receive time.
   virtual NetworkControlUpdate OnTransportPacketsFeedback(
       TransportPacketsFeedback) ABSL_MUST_USE_RESULT = 0;
+  // Returns false if OnTransportPacketsFeedback() ignores the feedback, so that
+  // the caller can skip building it. Must not change over the lifetime of the
+  // controller.
+  virtual bool ConsumesTransportPacketsFeedback() const { return true; }
   // Called with network state estimate updates.
   virtual NetworkControlUpdate OnNetworkStateEstimate(NetworkStateEstimate)
       ABSL_MUST_USE_RESULT = 0;
@@ -193,6 +193,12 @@ struct NetworkEstimate {
   TimeDelta bwe_period = TimeDelta::PlusInfinity();
 
   float loss_rate_ratio = 0;
+  // Loss ratio the controller expects before it shows up in |loss_rate_ratio|,
+  // e.g. while sending above a capacity that just dropped.
+  float predicted_loss_rate_ratio = 0;
+  // Share of |bandwidth| the controller expects to be left a few hundred ms
+  // from now, below 1 when it sees the capacity falling.
+  float predicted_bandwidth_ratio = 1;
 };
 
 // Network control
@@ -236,6 +242,9 @@ struct NetworkControlUpdate {
   absl::optional<PacerConfig> pacer_config;
   std::vector<ProbeClusterConfig> probe_cluster_configs;
   absl::optional<TargetTransferRate> target_rate;
+  // Target rate of an estimator only run for comparison, e.g. GCC next to the
+  // AlphaCC controller, see ShadowGccNetworkController. Not applied.
+  absl::optional<DataRate> shadow_target_rate;
 };
 
 // Process control
@@ -277,10 +286,24 @@ struct NetworkStateEstimate {
 };
 
 struct BweMessage {
+  struct StreamEstimate {
+    uint32_t ssrc = 0;
+    float target_rate = 0;  // bps
+  };
+
   int64_t timestamp_ms = 0;
   float target_rate = 3000000; // 3Mbps
   float pacing_rate = 3000000; // 3Mbps/2.5
   float padding_rate = 0;
+
+  // Optional hints from the receive side estimator.
+  // Confidence of |target_rate| in [0, 1].
+  absl::optional<float> confidence;
+  absl::optional<int64_t> rtt_ms;
+  // Fraction of packets lost in [0, 1].
+  absl::optional<float> loss_ratio;
+  // How |target_rate| should be split between the received streams.
+  std::vector<StreamEstimate> stream_estimates;
 };
 
 }  // namespace webrtc
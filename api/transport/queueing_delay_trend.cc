@@ -0,0 +1,25 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/transport/queueing_delay_trend.h"
+
+#include <algorithm>
+
+namespace webrtc {
+
+TimeDelta QueueingDelayTrend::PredictedChange(TimeDelta horizon,
+                                              TimeDelta max_growth) const {
+  double change_ms = confidence * slope_ms_per_s * horizon.seconds<double>();
+  change_ms = std::min(change_ms, max_growth.ms<double>());
+  change_ms = std::max(change_ms, -queueing_delay.ms<double>());
+  return TimeDelta::Micros(static_cast<int64_t>(change_ms * 1000));
+}
+
+}  // namespace webrtc
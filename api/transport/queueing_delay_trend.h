@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_TRANSPORT_QUEUEING_DELAY_TREND_H_
+#define API_TRANSPORT_QUEUEING_DELAY_TREND_H_
+
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+
+// Trend of the queueing delay on the path from the sender, as seen by the
+// receive side bandwidth estimator. Lets the jitter buffers react to queues
+// building up or draining before the change shows in the inter-arrival times.
+struct QueueingDelayTrend {
+  // One-way delay above the lowest one seen recently.
+  TimeDelta queueing_delay = TimeDelta::Zero();
+  // Growth of the queueing delay, in ms per second of arrival time. Negative
+  // while the queues drain.
+  double slope_ms_per_s = 0.0;
+  // How much the trend can be trusted, from 0 (not at all) to 1.
+  double confidence = 0.0;
+
+  // Change of the queueing delay expected within |horizon|, scaled by
+  // |confidence|. Grows by at most |max_growth| and never drains more than
+  // the current |queueing_delay|.
+  TimeDelta PredictedChange(TimeDelta horizon, TimeDelta max_growth) const;
+};
+
+class QueueingDelayTrendObserver {
+ public:
+  virtual ~QueueingDelayTrendObserver() = default;
+  virtual void OnQueueingDelayTrend(const QueueingDelayTrend& trend) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_TRANSPORT_QUEUEING_DELAY_TREND_H_
@@ -630,6 +630,136 @@ bool StunMessage::EqualAttributes(
   return true;
 }
 
+// StunMessageView
+
+bool StunMessageView::Parse(const char* data, size_t size) {
+  attributes_ = nullptr;
+  if (size < kStunHeaderSize)
+    return false;
+  type_ = rtc::GetBE16(data);
+  // See StunMessage::Read().
+  if (type_ & 0x8000)
+    return false;
+  length_ = rtc::GetBE16(data + 2);
+  if (length_ != size - kStunHeaderSize)
+    return false;
+  if (rtc::GetBE32(data + 4) == kStunMagicCookie) {
+    transaction_id_ = absl::string_view(data + 4 + kStunMagicCookieLength,
+                                        kStunTransactionIdLength);
+  } else {
+    transaction_id_ =
+        absl::string_view(data + 4, kStunLegacyTransactionIdLength);
+  }
+
+  // Walk the attributes once, so that the getters can trust their lengths.
+  const char* const attributes = data + kStunHeaderSize;
+  size_t offset = 0;
+  while (offset < length_) {
+    if (length_ - offset < kStunAttributeHeaderSize)
+      return false;
+    const size_t value_length = rtc::GetBE16(attributes + offset + 2);
+    offset += kStunAttributeHeaderSize;
+    if (length_ - offset < value_length)
+      return false;
+    offset += value_length;
+    // StunMessage::Read() accepts a last attribute without padding.
+    const size_t padding = (4 - value_length % 4) % 4;
+    if (offset == length_)
+      break;
+    if (length_ - offset < padding)
+      return false;
+    offset += padding;
+  }
+  attributes_ = attributes;
+  return true;
+}
+
+bool StunMessageView::IsLegacy() const {
+  return transaction_id_.size() == kStunLegacyTransactionIdLength;
+}
+
+bool StunMessageView::GetBytes(int type,
+                               rtc::ArrayView<const char>* value) const {
+  if (!attributes_)
+    return false;
+  // Parse() checked that all attributes fit.
+  size_t offset = 0;
+  while (offset < length_) {
+    const char* const attribute = attributes_ + offset;
+    const size_t value_length = rtc::GetBE16(attribute + 2);
+    if (rtc::GetBE16(attribute) == type) {
+      *value = rtc::ArrayView<const char>(attribute + kStunAttributeHeaderSize,
+                                          value_length);
+      return true;
+    }
+    offset += kStunAttributeHeaderSize + value_length +
+              (4 - value_length % 4) % 4;
+  }
+  return false;
+}
+
+bool StunMessageView::GetUInt32(int type, uint32_t* value) const {
+  rtc::ArrayView<const char> bytes;
+  if (!GetBytes(type, &bytes) || bytes.size() != StunUInt32Attribute::SIZE)
+    return false;
+  *value = rtc::GetBE32(bytes.data());
+  return true;
+}
+
+bool StunMessageView::GetAddress(int type, rtc::SocketAddress* address) const {
+  // The layout read by StunAddressAttribute::Read().
+  rtc::ArrayView<const char> bytes;
+  if (!GetBytes(type, &bytes) || bytes.size() < 4)
+    return false;
+  const uint16_t port = rtc::GetBE16(bytes.data() + 2);
+  const uint8_t family = static_cast<uint8_t>(bytes[1]);
+  if (family == STUN_ADDRESS_IPV4 &&
+      bytes.size() == StunAddressAttribute::SIZE_IP4) {
+    in_addr v4addr;
+    memcpy(&v4addr, bytes.data() + 4, sizeof(v4addr));
+    address->SetIP(rtc::IPAddress(v4addr));
+  } else if (family == STUN_ADDRESS_IPV6 &&
+             bytes.size() == StunAddressAttribute::SIZE_IP6) {
+    in6_addr v6addr;
+    memcpy(&v6addr, bytes.data() + 4, sizeof(v6addr));
+    address->SetIP(rtc::IPAddress(v6addr));
+  } else {
+    return false;
+  }
+  address->SetPort(port);
+  return true;
+}
+
+bool StunMessageView::GetXorAddress(int type,
+                                    rtc::SocketAddress* address) const {
+  rtc::SocketAddress xored;
+  if (!GetAddress(type, &xored))
+    return false;
+  // See StunXorAddressAttribute::GetXoredIP().
+  rtc::IPAddress ip;
+  if (xored.family() == AF_INET) {
+    in_addr v4addr = xored.ipaddr().ipv4_address();
+    v4addr.s_addr ^= rtc::HostToNetwork32(kStunMagicCookie);
+    ip = rtc::IPAddress(v4addr);
+  } else if (transaction_id_.size() == kStunTransactionIdLength) {
+    in6_addr v6addr = xored.ipaddr().ipv6_address();
+    uint32_t transaction_id_as_ints[3];
+    memcpy(transaction_id_as_ints, transaction_id_.data(),
+           sizeof(transaction_id_as_ints));
+    uint32_t ip_as_ints[4];
+    memcpy(ip_as_ints, &v6addr.s6_addr, sizeof(ip_as_ints));
+    ip_as_ints[0] ^= rtc::HostToNetwork32(kStunMagicCookie);
+    ip_as_ints[1] ^= transaction_id_as_ints[0];
+    ip_as_ints[2] ^= transaction_id_as_ints[1];
+    ip_as_ints[3] ^= transaction_id_as_ints[2];
+    memcpy(&v6addr.s6_addr, ip_as_ints, sizeof(ip_as_ints));
+    ip = rtc::IPAddress(v6addr);
+  }
+  *address = rtc::SocketAddress(
+      ip, xored.port() ^ static_cast<uint16_t>(kStunMagicCookie >> 16));
+  return true;
+}
+
 // StunAttribute
 
 StunAttribute::StunAttribute(uint16_t type, uint16_t length)
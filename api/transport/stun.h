@@ -21,6 +21,8 @@
 #include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/socket_address.h"
@@ -270,6 +272,37 @@ class StunMessage {
   uint32_t stun_magic_cookie_;
 };
 
+// Reads a STUN message in place, without copying it or allocating memory, for
+// the hot paths that only need a few attributes of a message, like TURN send
+// and data indications. Parse() checks the header and that the attributes
+// fit the message, like StunMessage::Read(), but the value of an attribute is
+// only validated when it is read. The parsed data has to outlive the view.
+class StunMessageView {
+ public:
+  // Returns false if |data| isn't a complete STUN message.
+  bool Parse(const char* data, size_t size);
+
+  int type() const { return type_; }
+  size_t length() const { return length_; }
+  // Like StunMessage::transaction_id(), includes the magic cookie field of
+  // RFC3489 messages.
+  absl::string_view transaction_id() const { return transaction_id_; }
+  bool IsLegacy() const;
+
+  // Get the value of the first attribute of |type|. Return false if there is
+  // no such attribute or if its value is malformed.
+  bool GetBytes(int type, rtc::ArrayView<const char>* value) const;
+  bool GetUInt32(int type, uint32_t* value) const;
+  bool GetAddress(int type, rtc::SocketAddress* address) const;
+  bool GetXorAddress(int type, rtc::SocketAddress* address) const;
+
+ private:
+  const char* attributes_ = nullptr;
+  uint16_t type_ = 0;
+  uint16_t length_ = 0;
+  absl::string_view transaction_id_;
+};
+
 // Base class for all STUN/TURN attributes.
 class StunAttribute {
  public:
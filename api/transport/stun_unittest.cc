@@ -1903,4 +1903,81 @@ TEST_F(StunTest, IsStunMethod) {
       sizeof(kRfc5769SampleRequest)));
 }
 
+TEST_F(StunTest, StunMessageViewReadsXorAddresses) {
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithIPv4XorMappedAddress),
+      sizeof(kStunMessageWithIPv4XorMappedAddress)));
+  EXPECT_EQ(STUN_BINDING_RESPONSE, view.type());
+  EXPECT_FALSE(view.IsLegacy());
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(kTestTransactionId1),
+                        kStunTransactionIdLength),
+            view.transaction_id());
+  rtc::SocketAddress address;
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(rtc::SocketAddress(rtc::IPAddress(kIPv4TestAddress1),
+                               kTestMessagePort3),
+            address);
+  EXPECT_FALSE(view.GetXorAddress(STUN_ATTR_XOR_PEER_ADDRESS, &address));
+
+  ASSERT_TRUE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithIPv6XorMappedAddress),
+      sizeof(kStunMessageWithIPv6XorMappedAddress)));
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(rtc::SocketAddress(rtc::IPAddress(kIPv6TestAddress1),
+                               kTestMessagePort1),
+            address);
+}
+
+TEST_F(StunTest, StunMessageViewReadsAttributesOfWrittenMessage) {
+  TurnMessage msg;
+  msg.SetType(TURN_SEND_INDICATION);
+  msg.SetTransactionID("0123456789ab");
+  const rtc::SocketAddress peer(rtc::IPAddress(kIPv6TestAddress1),
+                                kTestMessagePort2);
+  msg.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_PEER_ADDRESS, peer));
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_DATA, "hello"));
+  auto lifetime = StunAttribute::CreateUInt32(STUN_ATTR_LIFETIME);
+  lifetime->SetValue(600);
+  msg.AddAttribute(std::move(lifetime));
+  rtc::ByteBufferWriter out;
+  ASSERT_TRUE(msg.Write(&out));
+
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(out.Data(), out.Length()));
+  EXPECT_EQ(TURN_SEND_INDICATION, view.type());
+  EXPECT_EQ("0123456789ab", view.transaction_id());
+  rtc::SocketAddress address;
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_PEER_ADDRESS, &address));
+  EXPECT_EQ(peer, address);
+  rtc::ArrayView<const char> data;
+  ASSERT_TRUE(view.GetBytes(STUN_ATTR_DATA, &data));
+  EXPECT_EQ("hello", std::string(data.data(), data.size()));
+  uint32_t value;
+  ASSERT_TRUE(view.GetUInt32(STUN_ATTR_LIFETIME, &value));
+  EXPECT_EQ(600u, value);
+  // The data attribute isn't a 32 bit value.
+  EXPECT_FALSE(view.GetUInt32(STUN_ATTR_DATA, &value));
+  EXPECT_FALSE(view.GetBytes(STUN_ATTR_USERNAME, &data));
+}
+
+TEST_F(StunTest, StunMessageViewRejectsTruncatedMessages) {
+  const char* data =
+      reinterpret_cast<const char*>(kStunMessageWithIPv6XorMappedAddress);
+  const size_t size = sizeof(kStunMessageWithIPv6XorMappedAddress);
+  StunMessageView view;
+  EXPECT_FALSE(view.Parse(data, kStunHeaderSize - 1));
+  EXPECT_FALSE(view.Parse(data, size - 1));
+
+  // The message length covers only part of the attribute.
+  std::string truncated(data, size - 4);
+  rtc::SetBE16(&truncated[2],
+               static_cast<uint16_t>(truncated.size() - kStunHeaderSize));
+  EXPECT_FALSE(view.Parse(truncated.data(), truncated.size()));
+  rtc::SocketAddress address;
+  EXPECT_FALSE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+}
+
 }  // namespace cricket
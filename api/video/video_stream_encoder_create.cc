@@ -12,6 +12,7 @@
 
 #include <memory>
 
+#include "video/adaptation/encode_cpu_budget.h"
 #include "video/adaptation/overuse_frame_detector.h"
 #include "video/video_stream_encoder.h"
 
@@ -25,7 +26,8 @@ std::unique_ptr<VideoStreamEncoderInterface> CreateVideoStreamEncoder(
     const VideoStreamEncoderSettings& settings) {
   return std::make_unique<VideoStreamEncoder>(
       clock, number_of_cores, encoder_stats_observer, settings,
-      std::make_unique<OveruseFrameDetector>(encoder_stats_observer),
+      std::make_unique<OveruseFrameDetector>(encoder_stats_observer,
+                                             EncodeCpuBudget::GetProcessWide()),
       task_queue_factory);
 }
 
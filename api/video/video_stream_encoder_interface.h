@@ -99,6 +99,11 @@ class VideoStreamEncoderInterface : public rtc::VideoSinkInterface<VideoFrame> {
                                 int64_t round_trip_time_ms,
                                 double cwnd_reduce_ratio) = 0;
 
+  // Informs of the share of the target, in [0, 1], that the congestion
+  // controller expects to be left a few hundred ms from now, e.g. when it sees
+  // the link capacity falling. Applies from the next OnBitrateUpdated().
+  virtual void OnPredictedBitrateRatio(double predicted_bitrate_ratio) {}
+
   // Register observer for the bitrate allocation between the temporal
   // and spatial layers.
   virtual void SetBitrateAllocationObserver(
@@ -275,6 +275,10 @@ int AudioReceiveStream::GetBaseMinimumPlayoutDelayMs() const {
   return channel_receive_->GetBaseMinimumPlayoutDelayMs();
 }
 
+void AudioReceiveStream::OnQueueingDelayTrend(const QueueingDelayTrend& trend) {
+  channel_receive_->UpdateQueueingDelayTrend(trend);
+}
+
 std::vector<RtpSource> AudioReceiveStream::GetSources() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return source_tracker_.GetSources();
@@ -312,6 +316,7 @@ absl::optional<Syncable::Info> AudioReceiveStream::GetInfo() const {
     return absl::nullopt;
 
   info->current_delay_ms = channel_receive_->GetDelayEstimate();
+  info->minimum_delay_ms = channel_receive_->GetMinimumDelayEstimate();
   return info;
 }
 
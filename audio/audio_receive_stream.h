@@ -17,6 +17,7 @@
 #include "api/audio/audio_mixer.h"
 #include "api/neteq/neteq_factory.h"
 #include "api/rtp_headers.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "audio/audio_state.h"
 #include "call/audio_receive_stream.h"
 #include "call/syncable.h"
@@ -42,7 +43,8 @@ class AudioSendStream;
 
 class AudioReceiveStream final : public webrtc::AudioReceiveStream,
                                  public AudioMixer::Source,
-                                 public Syncable {
+                                 public Syncable,
+                                 public QueueingDelayTrendObserver {
  public:
   AudioReceiveStream(Clock* clock,
                      RtpStreamReceiverControllerInterface* receiver_controller,
@@ -74,6 +76,9 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
   int GetBaseMinimumPlayoutDelayMs() const override;
   std::vector<webrtc::RtpSource> GetSources() const override;
 
+  // Implements QueueingDelayTrendObserver. May be called from any thread.
+  void OnQueueingDelayTrend(const QueueingDelayTrend& trend) override;
+
   // TODO(nisse): We don't formally implement RtpPacketSinkInterface, and this
   // method shouldn't be needed. But it's currently used by the
   // AudioReceiveStreamTest.ReceiveRtpPacket unittest. Figure out if that test
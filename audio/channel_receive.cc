@@ -133,6 +133,7 @@ class ChannelReceive : public ChannelReceiveInterface {
 
   // Audio+Video Sync.
   uint32_t GetDelayEstimate() const override;
+  uint32_t GetMinimumDelayEstimate() const override;
   void SetMinimumPlayoutDelay(int delayMs) override;
   bool GetPlayoutRtpTimestamp(uint32_t* rtp_timestamp,
                               int64_t* time_ms) const override;
@@ -144,6 +145,7 @@ class ChannelReceive : public ChannelReceiveInterface {
   // Audio quality.
   bool SetBaseMinimumPlayoutDelayMs(int delay_ms) override;
   int GetBaseMinimumPlayoutDelayMs() const override;
+  void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) override;
 
   // Produces the transport-related timestamps; current_delay_ms is left unset.
   absl::optional<Syncable::Info> GetSyncInfo() const override;
@@ -822,6 +824,13 @@ uint32_t ChannelReceive::GetDelayEstimate() const {
   return acm_receiver_.FilteredCurrentDelayMs() + playout_delay_ms_;
 }
 
+uint32_t ChannelReceive::GetMinimumDelayEstimate() const {
+  RTC_DCHECK(worker_thread_checker_.IsCurrent() ||
+             module_process_thread_checker_.IsCurrent());
+  rtc::CritScope lock(&video_sync_lock_);
+  return acm_receiver_.UnconstrainedTargetDelayMs() + playout_delay_ms_;
+}
+
 void ChannelReceive::SetMinimumPlayoutDelay(int delay_ms) {
   RTC_DCHECK(module_process_thread_checker_.IsCurrent());
   // Limit to range accepted by both VoE and ACM, so we're at least getting as
@@ -874,6 +883,10 @@ int ChannelReceive::GetBaseMinimumPlayoutDelayMs() const {
   return acm_receiver_.GetBaseMinimumDelayMs();
 }
 
+void ChannelReceive::UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) {
+  acm_receiver_.UpdateQueueingDelayTrend(trend);
+}
+
 absl::optional<Syncable::Info> ChannelReceive::GetSyncInfo() const {
   RTC_DCHECK(module_process_thread_checker_.IsCurrent());
   Syncable::Info info;
@@ -24,6 +24,7 @@
 #include "api/crypto/crypto_options.h"
 #include "api/frame_transformer_interface.h"
 #include "api/neteq/neteq_factory.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "api/transport/rtp/rtp_source.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
@@ -104,6 +105,9 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
 
   // Audio+Video Sync.
   virtual uint32_t GetDelayEstimate() const = 0;
+  // The delay the jitter buffer would target without any minimum playout
+  // delay, plus the playout delay.
+  virtual uint32_t GetMinimumDelayEstimate() const = 0;
   virtual void SetMinimumPlayoutDelay(int delay_ms) = 0;
   virtual bool GetPlayoutRtpTimestamp(uint32_t* rtp_timestamp,
                                       int64_t* time_ms) const = 0;
@@ -117,6 +121,9 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
   // determines minimum delay until audio playout.
   virtual bool SetBaseMinimumPlayoutDelayMs(int delay_ms) = 0;
   virtual int GetBaseMinimumPlayoutDelayMs() const = 0;
+  // Updates the queueing delay trend the jitter buffer follows. May be called
+  // from any thread.
+  virtual void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) = 0;
 
   // Produces the transport-related timestamps; current_delay_ms is left unset.
   virtual absl::optional<Syncable::Info> GetSyncInfo() const = 0;
@@ -30,6 +30,7 @@
 #include "modules/audio_processing/rms_level.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/utility/include/process_thread.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/format_macros.h"
@@ -232,6 +233,9 @@ class ChannelSend : public ChannelSendInterface,
   // ChannelSend::SendRtpAudio to send the transformed audio.
   rtc::scoped_refptr<ChannelSendFrameTransformerDelegate>
       frame_transformer_delegate_ RTC_GUARDED_BY(encoder_queue_);
+  // The encrypted payload of the frame being sent. Kept between frames so its
+  // capacity is reused.
+  rtc::Buffer encrypted_audio_payload_ RTC_GUARDED_BY(encoder_queue_);
 
   rtc::CriticalSection bitrate_crit_section_;
   int configured_bitrate_bps_ RTC_GUARDED_BY(bitrate_crit_section_) = 0;
@@ -410,25 +414,22 @@ int32_t ChannelSend::SendRtpAudio(AudioFrameType frameType,
   }
 
   // E2EE Custom Audio Frame Encryption (This is optional).
-  // Keep this buffer around for the lifetime of the send call.
-  rtc::Buffer encrypted_audio_payload;
   // We don't invoke encryptor if payload is empty, which means we are to send
   // DTMF, or the encoder entered DTX.
   // TODO(minyue): see whether DTMF packets should be encrypted or not. In
   // current implementation, they are not.
   if (!payload.empty()) {
     if (frame_encryptor_ != nullptr) {
-      // TODO(benwright@webrtc.org) - Allocate enough to always encrypt inline.
-      // Allocate a buffer to hold the maximum possible encrypted payload.
+      // Size the buffer to hold the maximum possible encrypted payload.
       size_t max_ciphertext_size = frame_encryptor_->GetMaxCiphertextByteSize(
           cricket::MEDIA_TYPE_AUDIO, payload.size());
-      encrypted_audio_payload.SetSize(max_ciphertext_size);
+      encrypted_audio_payload_.SetSize(max_ciphertext_size);
 
       // Encrypt the audio payload into the buffer.
       size_t bytes_written = 0;
       int encrypt_status = frame_encryptor_->Encrypt(
           cricket::MEDIA_TYPE_AUDIO, _rtpRtcpModule->SSRC(),
-          /*additional_data=*/nullptr, payload, encrypted_audio_payload,
+          /*additional_data=*/nullptr, payload, encrypted_audio_payload_,
           &bytes_written);
       if (encrypt_status != 0) {
         RTC_DLOG(LS_ERROR)
@@ -437,9 +438,9 @@ int32_t ChannelSend::SendRtpAudio(AudioFrameType frameType,
         return -1;
       }
       // Resize the buffer to the exact number of bytes actually used.
-      encrypted_audio_payload.SetSize(bytes_written);
+      encrypted_audio_payload_.SetSize(bytes_written);
       // Rewrite the payloadData and size to the new encrypted payload.
-      payload = encrypted_audio_payload;
+      payload = encrypted_audio_payload_;
     } else if (crypto_options_.sframe.require_frame_encryption) {
       RTC_DLOG(LS_ERROR) << "Channel::SendData() failed sending audio payload: "
                             "A frame encryptor is required but one is not set.";
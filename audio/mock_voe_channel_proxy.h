@@ -39,6 +39,7 @@ class MockChannelReceive : public voe::ChannelReceiveInterface {
   MOCK_CONST_METHOD0(GetTotalOutputEnergy, double());
   MOCK_CONST_METHOD0(GetTotalOutputDuration, double());
   MOCK_CONST_METHOD0(GetDelayEstimate, uint32_t());
+  MOCK_CONST_METHOD0(GetMinimumDelayEstimate, uint32_t());
   MOCK_METHOD1(SetSink, void(AudioSinkInterface* sink));
   MOCK_METHOD1(OnRtpPacket, void(const RtpPacketReceived& packet));
   MOCK_METHOD2(ReceivedRTCPPacket, void(const uint8_t* packet, size_t length));
@@ -59,6 +60,7 @@ class MockChannelReceive : public voe::ChannelReceiveInterface {
   MOCK_METHOD1(SetMinimumPlayoutDelay, void(int delay_ms));
   MOCK_METHOD1(SetBaseMinimumPlayoutDelayMs, bool(int delay_ms));
   MOCK_CONST_METHOD0(GetBaseMinimumPlayoutDelayMs, int());
+  MOCK_METHOD1(UpdateQueueingDelayTrend, void(const QueueingDelayTrend& trend));
   MOCK_CONST_METHOD0(GetReceiveCodec,
                      absl::optional<std::pair<int, SdpAudioFormat>>());
   MOCK_METHOD1(SetReceiveCodecs,
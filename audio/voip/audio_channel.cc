@@ -34,8 +34,11 @@ AudioChannel::AudioChannel(
     TaskQueueFactory* task_queue_factory,
     ProcessThread* process_thread,
     AudioMixer* audio_mixer,
-    rtc::scoped_refptr<AudioDecoderFactory> decoder_factory)
-    : audio_mixer_(audio_mixer), process_thread_(process_thread) {
+    rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
+    AudioEgressGroup* egress_group)
+    : audio_mixer_(audio_mixer),
+      process_thread_(process_thread),
+      egress_group_(egress_group) {
   RTC_DCHECK(task_queue_factory);
   RTC_DCHECK(process_thread);
   RTC_DCHECK(audio_mixer);
@@ -62,8 +65,14 @@ AudioChannel::AudioChannel(
   ingress_ = std::make_unique<AudioIngress>(rtp_rtcp_.get(), clock,
                                             receive_statistics_.get(),
                                             std::move(decoder_factory));
-  egress_ =
-      std::make_unique<AudioEgress>(rtp_rtcp_.get(), clock, task_queue_factory);
+  if (egress_group_) {
+    egress_ = std::make_unique<AudioEgress>(rtp_rtcp_.get(), clock,
+                                            egress_group_->encoder_queue());
+    egress_group_->AddEgress(egress_.get());
+  } else {
+    egress_ = std::make_unique<AudioEgress>(rtp_rtcp_.get(), clock,
+                                            task_queue_factory);
+  }
 
   // Set the instance of audio ingress to be part of audio mixer for ADM to
   // fetch audio samples to play.
@@ -78,6 +87,9 @@ AudioChannel::~AudioChannel() {
     StopPlay();
   }
 
+  if (egress_group_) {
+    egress_group_->RemoveEgress(egress_.get());
+  }
   audio_mixer_->RemoveSource(ingress_.get());
   process_thread_->DeRegisterModule(rtp_rtcp_.get());
 }
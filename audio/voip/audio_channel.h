@@ -19,6 +19,7 @@
 #include "api/task_queue/task_queue_factory.h"
 #include "api/voip/voip_base.h"
 #include "audio/voip/audio_egress.h"
+#include "audio/voip/audio_egress_group.h"
 #include "audio/voip/audio_ingress.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp.h"
 #include "modules/utility/include/process_thread.h"
@@ -32,12 +33,16 @@ namespace webrtc {
 // these two classes as it has both sending and receiving capabilities.
 class AudioChannel : public rtc::RefCountInterface {
  public:
+  // When |egress_group| is set, the channel encodes on the task queue of the
+  // group, as part of it, rather than on one created by |task_queue_factory|.
+  // The group must outlive the channel.
   AudioChannel(Transport* transport,
                uint32_t local_ssrc,
                TaskQueueFactory* task_queue_factory,
                ProcessThread* process_thread,
                AudioMixer* audio_mixer,
-               rtc::scoped_refptr<AudioDecoderFactory> decoder_factory);
+               rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
+               AudioEgressGroup* egress_group = nullptr);
   ~AudioChannel() override;
 
   // Set and get ChannelId that this audio channel belongs for debugging and
@@ -85,6 +90,9 @@ class AudioChannel : public rtc::RefCountInterface {
   // Synchronization is handled internally by ProcessThread.
   ProcessThread* process_thread_;
 
+  // Synchronization is handled internally by AudioEgressGroup.
+  AudioEgressGroup* const egress_group_;
+
   // Listed in order for safe destruction of AudioChannel object.
   // Synchronization for these are handled internally.
   std::unique_ptr<ReceiveStatistics> receive_statistics_;
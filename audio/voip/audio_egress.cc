@@ -13,23 +13,50 @@
 #include <utility>
 #include <vector>
 
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 
 namespace webrtc {
 
 AudioEgress::AudioEgress(RtpRtcp* rtp_rtcp,
                          Clock* clock,
                          TaskQueueFactory* task_queue_factory)
+    : AudioEgress(rtp_rtcp,
+                  clock,
+                  task_queue_factory->CreateTaskQueue(
+                      "AudioEncoder",
+                      TaskQueueFactory::Priority::NORMAL),
+                  nullptr) {}
+
+AudioEgress::AudioEgress(RtpRtcp* rtp_rtcp,
+                         Clock* clock,
+                         TaskQueueBase* encoder_queue)
+    : AudioEgress(rtp_rtcp, clock, nullptr, encoder_queue) {
+  RTC_DCHECK(encoder_queue);
+}
+
+AudioEgress::AudioEgress(
+    RtpRtcp* rtp_rtcp,
+    Clock* clock,
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> owned_queue,
+    TaskQueueBase* encoder_queue)
     : rtp_rtcp_(rtp_rtcp),
       rtp_sender_audio_(clock, rtp_rtcp_->RtpSender()),
       audio_coding_(AudioCodingModule::Create(AudioCodingModule::Config())),
-      encoder_queue_(task_queue_factory->CreateTaskQueue(
-          "AudioEncoder",
-          TaskQueueFactory::Priority::NORMAL)) {
+      encoder_queue_(owned_queue ? owned_queue.get() : encoder_queue),
+      owned_encoder_queue_(std::move(owned_queue)) {
   audio_coding_->RegisterTransportCallback(this);
 }
 
 AudioEgress::~AudioEgress() {
+  if (!owned_encoder_queue_) {
+    // The tasks of the shared queue would outlive this object.
+    RTC_DCHECK(!encoder_queue_->IsCurrent());
+    rtc::Event done;
+    encoder_queue_->PostTask(ToQueuedTask([&done] { done.Set(); }));
+    done.Wait(rtc::Event::kForever);
+  }
   audio_coding_->RegisterTransportCallback(nullptr);
 }
 
@@ -68,32 +95,34 @@ void AudioEgress::SendAudioData(std::unique_ptr<AudioFrame> audio_frame) {
   RTC_DCHECK_GT(audio_frame->samples_per_channel_, 0);
   RTC_DCHECK_LE(audio_frame->num_channels_, 8);
 
-  encoder_queue_.PostTask(
+  encoder_queue_->PostTask(ToQueuedTask(
       [this, audio_frame = std::move(audio_frame)]() mutable {
-        RTC_DCHECK_RUN_ON(&encoder_queue_);
-        if (!rtp_rtcp_->SendingMedia()) {
-          return;
-        }
-
-        AudioFrameOperations::Mute(audio_frame.get(),
-                                   encoder_context_.previously_muted_,
-                                   encoder_context_.mute_);
-        encoder_context_.previously_muted_ = encoder_context_.mute_;
-
-        audio_frame->timestamp_ = encoder_context_.frame_rtp_timestamp_;
-
-        // This call will trigger AudioPacketizationCallback::SendData if
-        // encoding is done and payload is ready for packetization and
-        // transmission. Otherwise, it will return without invoking the
-        // callback.
-        if (audio_coding_->Add10MsData(*audio_frame) < 0) {
-          RTC_DLOG(LS_ERROR) << "ACM::Add10MsData() failed.";
-          return;
-        }
-
-        encoder_context_.frame_rtp_timestamp_ +=
-            rtc::dchecked_cast<uint32_t>(audio_frame->samples_per_channel_);
-      });
+        EncodeAudioData(audio_frame.get());
+      }));
+}
+
+void AudioEgress::EncodeAudioData(AudioFrame* audio_frame) {
+  RTC_DCHECK_RUN_ON(encoder_queue_);
+  if (!rtp_rtcp_->SendingMedia()) {
+    return;
+  }
+
+  AudioFrameOperations::Mute(audio_frame, encoder_context_.previously_muted_,
+                             encoder_context_.mute_);
+  encoder_context_.previously_muted_ = encoder_context_.mute_;
+
+  audio_frame->timestamp_ = encoder_context_.frame_rtp_timestamp_;
+
+  // This call will trigger AudioPacketizationCallback::SendData if encoding is
+  // done and payload is ready for packetization and transmission. Otherwise,
+  // it will return without invoking the callback.
+  if (audio_coding_->Add10MsData(*audio_frame) < 0) {
+    RTC_DLOG(LS_ERROR) << "ACM::Add10MsData() failed.";
+    return;
+  }
+
+  encoder_context_.frame_rtp_timestamp_ +=
+      rtc::dchecked_cast<uint32_t>(audio_frame->samples_per_channel_);
 }
 
 int32_t AudioEgress::SendData(AudioFrameType frame_type,
@@ -101,7 +130,7 @@ int32_t AudioEgress::SendData(AudioFrameType frame_type,
                               uint32_t timestamp,
                               const uint8_t* payload_data,
                               size_t payload_size) {
-  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  RTC_DCHECK_RUN_ON(encoder_queue_);
 
   rtc::ArrayView<const uint8_t> payload(payload_data, payload_size);
 
@@ -162,10 +191,10 @@ bool AudioEgress::SendTelephoneEvent(int dtmf_event, int duration_ms) {
 }
 
 void AudioEgress::SetMute(bool mute) {
-  encoder_queue_.PostTask([this, mute] {
-    RTC_DCHECK_RUN_ON(&encoder_queue_);
+  encoder_queue_->PostTask(ToQueuedTask([this, mute] {
+    RTC_DCHECK_RUN_ON(encoder_queue_);
     encoder_context_.mute_ = mute;
-  });
+  }));
 }
 
 }  // namespace webrtc
@@ -15,6 +15,7 @@
 #include <string>
 
 #include "api/audio_codecs/audio_format.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "audio/utility/audio_frame_operations.h"
 #include "call/audio_sender.h"
@@ -22,7 +23,6 @@
 #include "modules/rtp_rtcp/include/report_block_data.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp.h"
 #include "modules/rtp_rtcp/source/rtp_sender_audio.h"
-#include "rtc_base/task_queue.h"
 #include "rtc_base/thread_checker.h"
 #include "rtc_base/time_utils.h"
 
@@ -36,7 +36,9 @@ namespace webrtc {
 //
 // TaskQueue is used to encode and send RTP asynchrounously as some OS platform
 // uses the same thread for both audio input and output sample deliveries which
-// can affect audio quality.
+// can affect audio quality. The task queue is either owned by AudioEgress or
+// shared with the other AudioEgress of an AudioEgressGroup, which encodes all
+// of them in a single task per input frame.
 //
 // Note that this class is originally based on ChannelSend in
 // audio/channel_send.cc with non-audio related logic trimmed as aimed for
@@ -46,6 +48,10 @@ class AudioEgress : public AudioSender, public AudioPacketizationCallback {
   AudioEgress(RtpRtcp* rtp_rtcp,
               Clock* clock,
               TaskQueueFactory* task_queue_factory);
+  // Encodes on |encoder_queue|, which must outlive this object.
+  AudioEgress(RtpRtcp* rtp_rtcp, Clock* clock, TaskQueueBase* encoder_queue);
+  // With a shared |encoder_queue|, blocks until the tasks posted to it by
+  // this object have run.
   ~AudioEgress() override;
 
   // Set the encoder format and payload type for AudioCodingModule.
@@ -90,6 +96,10 @@ class AudioEgress : public AudioSender, public AudioPacketizationCallback {
   // Implementation of AudioSender interface.
   void SendAudioData(std::unique_ptr<AudioFrame> audio_frame) override;
 
+  // Encodes |audio_frame| if sending, muting it in place if needed. Must be
+  // called on the encoder queue.
+  void EncodeAudioData(AudioFrame* audio_frame);
+
   // Implementation of AudioPacketizationCallback interface.
   int32_t SendData(AudioFrameType frame_type,
                    uint8_t payload_type,
@@ -98,6 +108,11 @@ class AudioEgress : public AudioSender, public AudioPacketizationCallback {
                    size_t payload_size) override;
 
  private:
+  AudioEgress(RtpRtcp* rtp_rtcp,
+              Clock* clock,
+              std::unique_ptr<TaskQueueBase, TaskQueueDeleter> owned_queue,
+              TaskQueueBase* encoder_queue);
+
   void SetEncoderFormat(const SdpAudioFormat& encoder_format) {
     rtc::CritScope lock(&lock_);
     encoder_format_ = encoder_format;
@@ -130,11 +145,13 @@ class AudioEgress : public AudioSender, public AudioPacketizationCallback {
     bool previously_muted_ = false;
   };
 
+  TaskQueueBase* const encoder_queue_;
+
   EncoderContext encoder_context_ RTC_GUARDED_BY(encoder_queue_);
 
-  // Defined last to ensure that there are no running tasks when the other
-  // members are destroyed.
-  rtc::TaskQueue encoder_queue_;
+  // Null when |encoder_queue_| is shared. Defined last to ensure that there
+  // are no running tasks when the other members are destroyed.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> owned_encoder_queue_;
 };
 
 }  // namespace webrtc
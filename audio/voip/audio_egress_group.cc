@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/voip/audio_egress_group.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+
+AudioEgressGroup::AudioEgressGroup(TaskQueueFactory* task_queue_factory)
+    : encoder_queue_(task_queue_factory->CreateTaskQueue(
+          "AudioEncoder",
+          TaskQueueFactory::Priority::NORMAL)) {}
+
+AudioEgressGroup::~AudioEgressGroup() {
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(egresses_.empty());
+}
+
+void AudioEgressGroup::AddEgress(AudioEgress* egress) {
+  RTC_DCHECK(egress);
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(std::find(egresses_.begin(), egresses_.end(), egress) ==
+             egresses_.end());
+  egresses_.push_back(egress);
+}
+
+void AudioEgressGroup::RemoveEgress(AudioEgress* egress) {
+  rtc::CritScope lock(&lock_);
+  egresses_.erase(std::remove(egresses_.begin(), egresses_.end(), egress),
+                  egresses_.end());
+}
+
+void AudioEgressGroup::SendAudioData(std::unique_ptr<AudioFrame> audio_frame) {
+  RTC_DCHECK_GT(audio_frame->samples_per_channel_, 0);
+  RTC_DCHECK_LE(audio_frame->num_channels_, 8);
+
+  encoder_queue_->PostTask(ToQueuedTask(
+      [this, audio_frame = std::move(audio_frame)] {
+        EncodeAudioData(*audio_frame);
+      }));
+}
+
+void AudioEgressGroup::EncodeAudioData(const AudioFrame& audio_frame) {
+  RTC_DCHECK_RUN_ON(encoder_queue_.get());
+  // Held while encoding, so that RemoveEgress() waits for the AudioEgress to
+  // be done with the frame.
+  rtc::CritScope lock(&lock_);
+  for (AudioEgress* egress : egresses_) {
+    if (!egress->IsSending())
+      continue;
+    egress_frame_.CopyFrom(audio_frame);
+    egress->EncodeAudioData(&egress_frame_);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef AUDIO_VOIP_AUDIO_EGRESS_GROUP_H_
+#define AUDIO_VOIP_AUDIO_EGRESS_GROUP_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "audio/voip/audio_egress.h"
+#include "call/audio_sender.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// AudioEgressGroup encodes the input samples of a group of AudioEgress on a
+// task queue shared by them. It takes the place of its AudioEgress in
+// AudioTransportImpl, so that each input frame is copied once and posted in a
+// single task for the whole group rather than once per AudioEgress.
+class AudioEgressGroup : public AudioSender {
+ public:
+  explicit AudioEgressGroup(TaskQueueFactory* task_queue_factory);
+  ~AudioEgressGroup() override;
+
+  // The task queue the AudioEgress of the group must encode on.
+  TaskQueueBase* encoder_queue() const { return encoder_queue_.get(); }
+
+  // Adds or removes |egress| from the group. Once RemoveEgress() returns, the
+  // group doesn't access |egress| anymore.
+  void AddEgress(AudioEgress* egress) RTC_LOCKS_EXCLUDED(lock_);
+  void RemoveEgress(AudioEgress* egress) RTC_LOCKS_EXCLUDED(lock_);
+
+  // Implementation of AudioSender interface.
+  void SendAudioData(std::unique_ptr<AudioFrame> audio_frame) override;
+
+ private:
+  void EncodeAudioData(const AudioFrame& audio_frame)
+      RTC_LOCKS_EXCLUDED(lock_);
+
+  rtc::CriticalSection lock_;
+  std::vector<AudioEgress*> egresses_ RTC_GUARDED_BY(lock_);
+
+  // Copy of the input frame for each AudioEgress, which mutes it in place.
+  // Only used on |encoder_queue_|.
+  AudioFrame egress_frame_;
+
+  // Defined last to ensure that there are no running tasks when the other
+  // members are destroyed.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> encoder_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // AUDIO_VOIP_AUDIO_EGRESS_GROUP_H_
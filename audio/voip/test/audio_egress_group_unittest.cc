@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/voip/audio_egress_group.h"
+
+#include <map>
+
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/call/transport.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "modules/audio_mixer/sine_wave_generator.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/mock_transport.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Unused;
+
+constexpr uint32_t kSsrcs[] = {0xDEADBEEF, 0xBEEFDEAD};
+constexpr int kNumEgresses = 2;
+
+std::unique_ptr<RtpRtcp> CreateRtpStack(Clock* clock,
+                                        Transport* transport,
+                                        uint32_t ssrc) {
+  RtpRtcp::Configuration rtp_config;
+  rtp_config.clock = clock;
+  rtp_config.audio = true;
+  rtp_config.rtcp_report_interval_ms = 5000;
+  rtp_config.outgoing_transport = transport;
+  rtp_config.local_media_ssrc = ssrc;
+  auto rtp_rtcp = RtpRtcp::Create(rtp_config);
+  rtp_rtcp->SetSendingMediaStatus(false);
+  rtp_rtcp->SetRTCPStatus(RtcpMode::kCompound);
+  return rtp_rtcp;
+}
+
+// AudioEgressGroupTest encodes the frames of the group with two AudioEgress
+// using PCMu, each with its own RTP stack.
+class AudioEgressGroupTest : public ::testing::Test {
+ public:
+  static constexpr int16_t kAudioLevel = 3004;  // Used for sine wave level.
+  static constexpr uint64_t kStartTime = 123456789;
+  const SdpAudioFormat kPcmuFormat = {"pcmu", 8000, 1};
+
+  AudioEgressGroupTest()
+      : fake_clock_(kStartTime),
+        wave_generator_(1000.0, kAudioLevel),
+        task_queue_factory_(CreateDefaultTaskQueueFactory()),
+        encoder_factory_(CreateBuiltinAudioEncoderFactory()),
+        egress_group_(task_queue_factory_.get()) {
+    constexpr int kPcmuPayload = 0;
+    for (int i = 0; i < kNumEgresses; ++i) {
+      rtp_rtcp_[i] = CreateRtpStack(&fake_clock_, &transport_, kSsrcs[i]);
+      egress_[i] = std::make_unique<AudioEgress>(
+          rtp_rtcp_[i].get(), &fake_clock_, egress_group_.encoder_queue());
+      egress_[i]->SetEncoder(kPcmuPayload, kPcmuFormat,
+                             encoder_factory_->MakeAudioEncoder(
+                                 kPcmuPayload, kPcmuFormat, absl::nullopt));
+      egress_[i]->StartSend();
+      rtp_rtcp_[i]->SetSendingStatus(true);
+      egress_group_.AddEgress(egress_[i].get());
+    }
+  }
+
+  ~AudioEgressGroupTest() override {
+    for (int i = 0; i < kNumEgresses; ++i) {
+      egress_group_.RemoveEgress(egress_[i].get());
+      egress_[i]->StopSend();
+      rtp_rtcp_[i]->SetSendingStatus(false);
+      egress_[i].reset();
+    }
+  }
+
+  std::unique_ptr<AudioFrame> GetAudioFrame(int order) {
+    auto frame = std::make_unique<AudioFrame>();
+    frame->sample_rate_hz_ = kPcmuFormat.clockrate_hz;
+    frame->samples_per_channel_ = kPcmuFormat.clockrate_hz / 100;  // 10 ms.
+    frame->num_channels_ = kPcmuFormat.num_channels;
+    frame->timestamp_ = frame->samples_per_channel_ * order;
+    wave_generator_.GenerateNextFrame(frame.get());
+    return frame;
+  }
+
+  // Counts the RTP packets sent by each SSRC, sets |event_| once |ssrc| has
+  // sent |expected| packets.
+  void ExpectPackets(uint32_t ssrc, int expected) {
+    EXPECT_CALL(transport_, SendRtp)
+        .WillRepeatedly(
+            Invoke([this, ssrc, expected](const uint8_t* packet, size_t length,
+                                          Unused) {
+              RtpPacketReceived rtp;
+              rtp.Parse(packet, length);
+              rtc::CritScope lock(&lock_);
+              if (++rtp_count_[rtp.Ssrc()] == expected &&
+                  rtp.Ssrc() == ssrc) {
+                event_.Set();
+              }
+              return true;
+            }));
+  }
+
+  int RtpCount(uint32_t ssrc) {
+    rtc::CritScope lock(&lock_);
+    return rtp_count_[ssrc];
+  }
+
+  SimulatedClock fake_clock_;
+  NiceMock<MockTransport> transport_;
+  SineWaveGenerator wave_generator_;
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  rtc::scoped_refptr<AudioEncoderFactory> encoder_factory_;
+  AudioEgressGroup egress_group_;
+  std::unique_ptr<RtpRtcp> rtp_rtcp_[kNumEgresses];
+  std::unique_ptr<AudioEgress> egress_[kNumEgresses];
+
+  rtc::Event event_;
+  rtc::CriticalSection lock_;
+  std::map<uint32_t, int> rtp_count_ RTC_GUARDED_BY(lock_);
+};
+
+TEST_F(AudioEgressGroupTest, EncodesTheFramesWithEachEgress) {
+  constexpr int kExpected = 10;
+  ExpectPackets(kSsrcs[1], kExpected);
+
+  // Two 10 ms audio frames will result in rtp packet with ptime 20.
+  for (int i = 0; i < kExpected * 2; i++) {
+    egress_group_.SendAudioData(GetAudioFrame(i));
+    fake_clock_.AdvanceTimeMilliseconds(10);
+  }
+
+  EXPECT_TRUE(event_.Wait(/*ms=*/1000));
+  EXPECT_EQ(kExpected, RtpCount(kSsrcs[0]));
+  EXPECT_EQ(kExpected, RtpCount(kSsrcs[1]));
+}
+
+TEST_F(AudioEgressGroupTest, SkipsRemovedAndStoppedEgress) {
+  constexpr int kExpected = 10;
+  ExpectPackets(kSsrcs[1], kExpected);
+  egress_group_.RemoveEgress(egress_[0].get());
+
+  for (int i = 0; i < kExpected * 2; i++) {
+    egress_group_.SendAudioData(GetAudioFrame(i));
+    fake_clock_.AdvanceTimeMilliseconds(10);
+  }
+  EXPECT_TRUE(event_.Wait(/*ms=*/1000));
+  EXPECT_EQ(0, RtpCount(kSsrcs[0]));
+
+  event_.Reset();
+  egress_group_.AddEgress(egress_[0].get());
+  egress_[1]->StopSend();
+  ExpectPackets(kSsrcs[0], kExpected);
+  for (int i = 0; i < kExpected * 2; i++) {
+    egress_group_.SendAudioData(GetAudioFrame(i));
+    fake_clock_.AdvanceTimeMilliseconds(10);
+  }
+  EXPECT_TRUE(event_.Wait(/*ms=*/1000));
+  EXPECT_EQ(kExpected, RtpCount(kSsrcs[1]));
+}
+
+}  // namespace
+}  // namespace webrtc
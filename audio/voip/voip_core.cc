@@ -36,6 +36,11 @@ constexpr uint16_t kAudioDeviceId = 0;
 // logging.
 static constexpr int kMaxChannelId = 100000;
 
+// Number of task queues the channels encode on. Each queue encodes the
+// channels of its group one after the other, a few of them are enough to use
+// the cores of the machine with hundreds of channels.
+static constexpr size_t kNumEgressGroups = 4;
+
 }  // namespace
 
 bool VoipCore::Init(rtc::scoped_refptr<AudioEncoderFactory> encoder_factory,
@@ -128,15 +133,15 @@ absl::optional<ChannelId> VoipCore::CreateChannel(
     local_ssrc = random.Rand<uint32_t>();
   }
 
-  rtc::scoped_refptr<AudioChannel> audio_channel =
-      new rtc::RefCountedObject<AudioChannel>(
-          transport, local_ssrc.value(), task_queue_factory_.get(),
-          process_thread_.get(), audio_mixer_.get(), decoder_factory_);
-
+  rtc::scoped_refptr<AudioChannel> audio_channel;
   {
     rtc::CritScope lock(&lock_);
 
     channel = static_cast<ChannelId>(next_channel_id_);
+    audio_channel = new rtc::RefCountedObject<AudioChannel>(
+        transport, local_ssrc.value(), task_queue_factory_.get(),
+        process_thread_.get(), audio_mixer_.get(), decoder_factory_,
+        GetEgressGroup(*channel));
     channels_[*channel] = audio_channel;
     next_channel_id_++;
     if (next_channel_id_ >= kMaxChannelId) {
@@ -182,18 +187,31 @@ rtc::scoped_refptr<AudioChannel> VoipCore::GetChannel(ChannelId channel) {
   return audio_channel;
 }
 
+AudioEgressGroup* VoipCore::GetEgressGroup(ChannelId channel) {
+  if (egress_groups_.empty()) {
+    egress_groups_.resize(kNumEgressGroups);
+  }
+  std::unique_ptr<AudioEgressGroup>& egress_group =
+      egress_groups_[static_cast<size_t>(channel) % kNumEgressGroups];
+  if (!egress_group) {
+    egress_group =
+        std::make_unique<AudioEgressGroup>(task_queue_factory_.get());
+  }
+  return egress_group.get();
+}
+
 bool VoipCore::UpdateAudioTransportWithSenders() {
   std::vector<AudioSender*> audio_senders;
 
-  // Gather a list of audio channel that are currently sending along with
-  // highest sampling rate and channel numbers to configure into audio
-  // transport.
+  // Gather a list of the groups of audio channels that are currently sending
+  // along with highest sampling rate and channel numbers to configure into
+  // audio transport.
   int max_sampling_rate = 8000;
   size_t max_num_channels = 1;
   {
     rtc::CritScope lock(&lock_);
     // Reserve to prevent run time vector re-allocation.
-    audio_senders.reserve(channels_.size());
+    audio_senders.reserve(egress_groups_.size());
     for (auto kv : channels_) {
       rtc::scoped_refptr<AudioChannel>& channel = kv.second;
       if (channel->IsSendingMedia()) {
@@ -203,7 +221,11 @@ bool VoipCore::UpdateAudioTransportWithSenders() {
               << "channel " << channel->GetId() << " encoder is not set";
           continue;
         }
-        audio_senders.push_back(channel->GetAudioSender());
+        AudioSender* audio_sender = GetEgressGroup(kv.first);
+        if (std::find(audio_senders.begin(), audio_senders.end(),
+                      audio_sender) == audio_senders.end()) {
+          audio_senders.push_back(audio_sender);
+        }
         max_sampling_rate =
             std::max(max_sampling_rate, encoder_format->clockrate_hz);
         max_num_channels =
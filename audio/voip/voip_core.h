@@ -27,6 +27,7 @@
 #include "api/voip/voip_network.h"
 #include "audio/audio_transport_impl.h"
 #include "audio/voip/audio_channel.h"
+#include "audio/voip/audio_egress_group.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_mixer/audio_mixer_impl.h"
 #include "modules/audio_processing/include/audio_processing.h"
@@ -42,6 +43,10 @@ namespace webrtc {
 //
 // This class receives required audio components from caller at construction and
 // owns the life cycle of them to orchestrate the proper destruction sequence.
+//
+// The AudioChannel objects are spread over a few AudioEgressGroup, so that
+// the audio input is encoded on a small number of task queues in a task per
+// group rather than on a task queue per channel.
 class VoipCore : public VoipEngine,
                  public VoipBase,
                  public VoipNetwork,
@@ -99,6 +104,10 @@ class VoipCore : public VoipEngine,
   // initialize where it can't expect to deliver any audio input sample.
   bool UpdateAudioTransportWithSenders();
 
+  // Returns the AudioEgressGroup |channel| encodes in, creating it if needed.
+  AudioEgressGroup* GetEgressGroup(ChannelId channel)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Synchronization for these are handled internally.
   rtc::scoped_refptr<AudioEncoderFactory> encoder_factory_;
   rtc::scoped_refptr<AudioDecoderFactory> decoder_factory_;
@@ -128,6 +137,11 @@ class VoipCore : public VoipEngine,
   // Member to track a next ChannelId for new AudioChannel.
   int next_channel_id_ RTC_GUARDED_BY(lock_) = 0;
 
+  // Groups of the channels, indexed by ChannelId modulo their number. Must be
+  // placed before |channels_| for proper destruction.
+  std::vector<std::unique_ptr<AudioEgressGroup>> egress_groups_
+      RTC_GUARDED_BY(lock_);
+
   // Container to track currently active AudioChannel objects mapped by
   // ChannelId.
   std::unordered_map<ChannelId, rtc::scoped_refptr<AudioChannel>> channels_
@@ -0,0 +1,43 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/audio_only_pacing_filter.h"
+
+#include <utility>
+
+namespace webrtc {
+
+AudioOnlyPacingFilter::AudioOnlyPacingFilter(bool enabled)
+    : enabled_(enabled) {}
+
+absl::optional<PacerConfig> AudioOnlyPacingFilter::SetNumVideoSenders(
+    size_t num_video_senders) {
+  bool was_audio_only = audio_only();
+  num_video_senders_ = num_video_senders;
+  if (!was_audio_only || audio_only())
+    return absl::nullopt;
+  absl::optional<PacerConfig> config = held_pacer_config_;
+  held_pacer_config_.reset();
+  return config;
+}
+
+NetworkControlUpdate AudioOnlyPacingFilter::Filter(
+    NetworkControlUpdate update) {
+  if (!audio_only())
+    return update;
+  if (update.pacer_config) {
+    held_pacer_config_ = update.pacer_config;
+    update.pacer_config.reset();
+  }
+  update.probe_cluster_configs.clear();
+  return update;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_AUDIO_ONLY_PACING_FILTER_H_
+#define CALL_AUDIO_ONLY_PACING_FILTER_H_
+
+#include <stddef.h>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_types.h"
+
+namespace webrtc {
+
+// Implements AlphaCCConfig::bwe_audio_only on the sender: audio is not paced
+// and can't probe, so while no video stream is sent the pacing rates and
+// probe clusters of the controller updates are held back. The last held back
+// pacer config is handed out once the first video stream is registered, so
+// that the pacer doesn't keep running at the start rate.
+class AudioOnlyPacingFilter {
+ public:
+  explicit AudioOnlyPacingFilter(bool enabled);
+
+  bool audio_only() const { return enabled_ && num_video_senders_ == 0; }
+
+  // Returns the pacer config to apply if the call leaves the audio only
+  // mode.
+  absl::optional<PacerConfig> SetNumVideoSenders(size_t num_video_senders);
+
+  // Strips the pacer config and the probe clusters from |update| while in
+  // the audio only mode.
+  NetworkControlUpdate Filter(NetworkControlUpdate update);
+
+ private:
+  const bool enabled_;
+  size_t num_video_senders_ = 0;
+  absl::optional<PacerConfig> held_pacer_config_;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_AUDIO_ONLY_PACING_FILTER_H_
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/audio_only_pacing_filter.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+NetworkControlUpdate CreateUpdate(DataRate pacing_rate) {
+  NetworkControlUpdate update;
+  PacerConfig pacer_config;
+  pacer_config.data_window = pacing_rate * TimeDelta::Seconds(1);
+  pacer_config.time_window = TimeDelta::Seconds(1);
+  update.pacer_config = pacer_config;
+  ProbeClusterConfig probe;
+  probe.target_data_rate = pacing_rate * 2;
+  probe.id = 1;
+  update.probe_cluster_configs.push_back(probe);
+  TargetTransferRate target_rate;
+  target_rate.target_rate = pacing_rate;
+  update.target_rate = target_rate;
+  return update;
+}
+
+TEST(AudioOnlyPacingFilterTest, PassesUpdatesWhenDisabled) {
+  AudioOnlyPacingFilter filter(/*enabled=*/false);
+  EXPECT_FALSE(filter.audio_only());
+  NetworkControlUpdate update =
+      filter.Filter(CreateUpdate(DataRate::KilobitsPerSec(300)));
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(update.pacer_config->data_rate(), DataRate::KilobitsPerSec(300));
+  EXPECT_EQ(update.probe_cluster_configs.size(), 1u);
+}
+
+TEST(AudioOnlyPacingFilterTest, HoldsBackPacingWithoutVideo) {
+  AudioOnlyPacingFilter filter(/*enabled=*/true);
+  EXPECT_TRUE(filter.audio_only());
+  NetworkControlUpdate update =
+      filter.Filter(CreateUpdate(DataRate::KilobitsPerSec(300)));
+  EXPECT_FALSE(update.pacer_config);
+  EXPECT_TRUE(update.probe_cluster_configs.empty());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(300));
+}
+
+TEST(AudioOnlyPacingFilterTest, AppliesHeldPacingOnceVideoStarts) {
+  AudioOnlyPacingFilter filter(/*enabled=*/true);
+  filter.Filter(CreateUpdate(DataRate::KilobitsPerSec(300)));
+  filter.Filter(CreateUpdate(DataRate::KilobitsPerSec(500)));
+
+  absl::optional<PacerConfig> pacer_config = filter.SetNumVideoSenders(1);
+  ASSERT_TRUE(pacer_config);
+  EXPECT_EQ(pacer_config->data_rate(), DataRate::KilobitsPerSec(500));
+  EXPECT_FALSE(filter.audio_only());
+
+  // The held back config is only handed out once.
+  EXPECT_FALSE(filter.SetNumVideoSenders(2));
+  NetworkControlUpdate update =
+      filter.Filter(CreateUpdate(DataRate::KilobitsPerSec(700)));
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(update.pacer_config->data_rate(), DataRate::KilobitsPerSec(700));
+  EXPECT_EQ(update.probe_cluster_configs.size(), 1u);
+}
+
+TEST(AudioOnlyPacingFilterTest, ReentersAudioOnlyWhenVideoStops) {
+  AudioOnlyPacingFilter filter(/*enabled=*/true);
+  EXPECT_FALSE(filter.SetNumVideoSenders(1));
+  EXPECT_FALSE(filter.SetNumVideoSenders(0));
+  EXPECT_TRUE(filter.audio_only());
+  NetworkControlUpdate update =
+      filter.Filter(CreateUpdate(DataRate::KilobitsPerSec(300)));
+  EXPECT_FALSE(update.pacer_config);
+  EXPECT_TRUE(update.probe_cluster_configs.empty());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/bandwidth_estimate_cache.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <fstream>
+#include <utility>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+// Serializes the updates of the calls of this process, those of other
+// processes are made atomic by renaming the updated file.
+rtc::CriticalSection* StoreLock() {
+  static rtc::CriticalSection* const lock = new rtc::CriticalSection();
+  return lock;
+}
+
+}  // namespace
+
+BandwidthEstimateCache::BandwidthEstimateCache(std::string file_path)
+    : file_path_(std::move(file_path)) {}
+
+absl::optional<DataRate> BandwidthEstimateCache::Lookup(
+    absl::string_view destination,
+    Timestamp now,
+    TimeDelta max_age) const {
+  const std::map<std::string, Entry> entries = Read();
+  auto it = entries.find(std::string(destination));
+  if (it == entries.end() || now - it->second.time > max_age)
+    return absl::nullopt;
+  return it->second.estimate;
+}
+
+bool BandwidthEstimateCache::Store(absl::string_view destination,
+                                   DataRate estimate,
+                                   Timestamp now) {
+  rtc::CritScope cs(StoreLock());
+  std::map<std::string, Entry> entries = Read();
+  entries.erase(std::string(destination));
+  entries.emplace(std::string(destination), Entry{estimate, now});
+
+  const std::string temp_path =
+      file_path_ + "." + std::to_string(rtc::CreateRandomId());
+  {
+    std::ofstream file(temp_path, std::ios::trunc);
+    for (const auto& entry : entries) {
+      file << entry.first << " " << entry.second.estimate.bps() << " "
+           << entry.second.time.ms() << "\n";
+    }
+    if (!file.good()) {
+      RTC_LOG(LS_WARNING) << "Failed to write " << temp_path;
+      remove(temp_path.c_str());
+      return false;
+    }
+  }
+  if (rename(temp_path.c_str(), file_path_.c_str()) != 0) {
+    RTC_LOG(LS_WARNING) << "Failed to replace " << file_path_;
+    remove(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+std::map<std::string, BandwidthEstimateCache::Entry>
+BandwidthEstimateCache::Read() const {
+  std::map<std::string, Entry> entries;
+  std::ifstream file(file_path_);
+  std::string destination;
+  int64_t bps;
+  int64_t time_ms;
+  while (file >> destination >> bps >> time_ms) {
+    if (bps <= 0)
+      continue;
+    entries.erase(destination);
+    entries.emplace(destination, Entry{DataRate::BitsPerSec(bps),
+                                       Timestamp::Millis(time_ms)});
+  }
+  return entries;
+}
+
+}  // namespace webrtc
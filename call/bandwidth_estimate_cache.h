@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_BANDWIDTH_ESTIMATE_CACHE_H_
+#define CALL_BANDWIDTH_ESTIMATE_CACHE_H_
+
+#include <map>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+
+// Keeps the last converged bandwidth estimate of each destination in a file,
+// so that the next calls to the same destination start from it instead of
+// the default start rate. The file may be shared by the calls of several
+// processes, each line is "<destination> <bps> <UTC time in ms>".
+class BandwidthEstimateCache {
+ public:
+  explicit BandwidthEstimateCache(std::string file_path);
+
+  // Returns the estimate stored for |destination|, unless it was stored more
+  // than |max_age| before |now|.
+  absl::optional<DataRate> Lookup(absl::string_view destination,
+                                  Timestamp now,
+                                  TimeDelta max_age) const;
+  // Replaces the estimate of |destination|. Returns false if the file could
+  // not be written.
+  bool Store(absl::string_view destination, DataRate estimate, Timestamp now);
+
+ private:
+  struct Entry {
+    DataRate estimate;
+    Timestamp time;
+  };
+
+  std::map<std::string, Entry> Read() const;
+
+  const std::string file_path_;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_BANDWIDTH_ESTIMATE_CACHE_H_
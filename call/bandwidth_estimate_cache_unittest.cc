@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/bandwidth_estimate_cache.h"
+
+#include <stdio.h>
+
+#include <string>
+
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kMaxAge = TimeDelta::Seconds(3600);
+
+class BandwidthEstimateCacheTest : public ::testing::Test {
+ protected:
+  BandwidthEstimateCacheTest()
+      : file_path_(test::TempFilename(test::OutputPath(), "bwe_cache")) {}
+  ~BandwidthEstimateCacheTest() override { remove(file_path_.c_str()); }
+
+  const std::string file_path_;
+  const Timestamp now_ = Timestamp::Seconds(1600000000);
+};
+
+TEST_F(BandwidthEstimateCacheTest, ReturnsNothingWithoutFile) {
+  remove(file_path_.c_str());
+  BandwidthEstimateCache cache(file_path_);
+  EXPECT_FALSE(cache.Lookup("10.0.0.1", now_, kMaxAge));
+}
+
+TEST_F(BandwidthEstimateCacheTest, ReturnsTheEstimateOfTheDestination) {
+  BandwidthEstimateCache cache(file_path_);
+  EXPECT_TRUE(cache.Store("10.0.0.1", DataRate::KilobitsPerSec(1500), now_));
+  EXPECT_TRUE(cache.Store("10.0.0.2", DataRate::KilobitsPerSec(800), now_));
+
+  // Read back by the calls of other processes.
+  BandwidthEstimateCache other_cache(file_path_);
+  EXPECT_EQ(DataRate::KilobitsPerSec(1500),
+            other_cache.Lookup("10.0.0.1", now_, kMaxAge));
+  EXPECT_EQ(DataRate::KilobitsPerSec(800),
+            other_cache.Lookup("10.0.0.2", now_, kMaxAge));
+  EXPECT_FALSE(other_cache.Lookup("10.0.0.3", now_, kMaxAge));
+}
+
+TEST_F(BandwidthEstimateCacheTest, ReplacesTheEstimateOfTheDestination) {
+  BandwidthEstimateCache cache(file_path_);
+  EXPECT_TRUE(cache.Store("10.0.0.1", DataRate::KilobitsPerSec(1500), now_));
+  EXPECT_TRUE(cache.Store("10.0.0.1", DataRate::KilobitsPerSec(600),
+                          now_ + TimeDelta::Seconds(10)));
+  EXPECT_EQ(DataRate::KilobitsPerSec(600),
+            cache.Lookup("10.0.0.1", now_ + TimeDelta::Seconds(10), kMaxAge));
+}
+
+TEST_F(BandwidthEstimateCacheTest, IgnoresOldEstimates) {
+  BandwidthEstimateCache cache(file_path_);
+  EXPECT_TRUE(cache.Store("10.0.0.1", DataRate::KilobitsPerSec(1500), now_));
+  EXPECT_TRUE(cache.Lookup("10.0.0.1", now_ + kMaxAge, kMaxAge));
+  EXPECT_FALSE(cache.Lookup("10.0.0.1", now_ + kMaxAge + TimeDelta::Millis(1),
+                            kMaxAge));
+}
+
+}  // namespace
+}  // namespace webrtc
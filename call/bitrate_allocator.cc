@@ -184,6 +184,90 @@ void DistributeBitrateRelatively(
   }
 }
 
+// Returns the concave hull of |curve|, starting at a quality of 0 at 0 bps and
+// ending where the quality stops increasing, so that the quality gained per
+// bit decreases along the returned points.
+std::vector<RateQualityPoint> ConcaveRateQualityHull(
+    std::vector<RateQualityPoint> curve) {
+  curve.push_back(RateQualityPoint{0, 0.0});
+  absl::c_sort(curve, [](const RateQualityPoint& a, const RateQualityPoint& b) {
+    return a.bitrate_bps < b.bitrate_bps ||
+           (a.bitrate_bps == b.bitrate_bps && a.quality > b.quality);
+  });
+  std::vector<RateQualityPoint> hull;
+  for (const RateQualityPoint& point : curve) {
+    if (!hull.empty() && (point.bitrate_bps == hull.back().bitrate_bps ||
+                          point.quality <= hull.back().quality)) {
+      continue;
+    }
+    // Drop the last point while it is on or below the line from the point
+    // before it to |point|.
+    while (hull.size() >= 2) {
+      const RateQualityPoint& a = hull[hull.size() - 2];
+      const RateQualityPoint& b = hull.back();
+      const double cross =
+          (static_cast<double>(b.bitrate_bps) - a.bitrate_bps) *
+              (point.quality - a.quality) -
+          (b.quality - a.quality) *
+              (static_cast<double>(point.bitrate_bps) - a.bitrate_bps);
+      if (cross < 0)
+        break;
+      hull.pop_back();
+    }
+    hull.push_back(point);
+  }
+  return hull;
+}
+
+// Allocates from |bitrate| to the segments of the rate-quality curves of the
+// observers in the order of decreasing quality gained per bit, within the
+// capacity of each observer. Since the curves are made concave, the segments
+// of each curve are taken in the order of their rates, and this order gives
+// the highest total quality for the allocated bitrate. Returns the bitrate
+// that is left once no segment gains quality.
+uint32_t DistributeBitrateByQuality(
+    const std::vector<AllocatableTrack>& allocatable_tracks,
+    uint32_t bitrate,
+    std::map<BitrateAllocatorObserver*, int>* observers_capacities,
+    std::map<BitrateAllocatorObserver*, int>* allocation) {
+  struct Segment {
+    BitrateAllocatorObserver* observer;
+    uint32_t size_bps;
+    double quality_per_bps;
+  };
+  std::vector<Segment> segments;
+  for (const auto& observer_config : allocatable_tracks) {
+    BitrateAllocatorObserver* observer = observer_config.observer;
+    const int64_t begin_bps = allocation->at(observer);
+    const int64_t end_bps = begin_bps + observers_capacities->at(observer);
+    const std::vector<RateQualityPoint> hull =
+        ConcaveRateQualityHull(observer_config.rate_quality_curve);
+    for (size_t i = 1; i < hull.size(); ++i) {
+      const int64_t size_bps =
+          std::min<int64_t>(hull[i].bitrate_bps, end_bps) -
+          std::max<int64_t>(hull[i - 1].bitrate_bps, begin_bps);
+      if (size_bps <= 0)
+        continue;
+      segments.push_back(Segment{
+          observer, static_cast<uint32_t>(size_bps),
+          (hull[i].quality - hull[i - 1].quality) /
+              (hull[i].bitrate_bps - hull[i - 1].bitrate_bps)});
+    }
+  }
+  absl::c_stable_sort(segments, [](const Segment& a, const Segment& b) {
+    return a.quality_per_bps > b.quality_per_bps;
+  });
+  for (const Segment& segment : segments) {
+    if (bitrate == 0)
+      break;
+    const uint32_t extra_bitrate = std::min(segment.size_bps, bitrate);
+    allocation->at(segment.observer) += extra_bitrate;
+    observers_capacities->at(segment.observer) -= extra_bitrate;
+    bitrate -= extra_bitrate;
+  }
+  return bitrate;
+}
+
 // Allocates bitrate to observers when there isn't enough to allocate the
 // minimum to all observers.
 std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
@@ -282,6 +366,17 @@ std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
     }
   }
 
+  // If all observers know how their quality increases with the bitrate, that
+  // decides where the remaining bitrate goes, up to where quality stops
+  // increasing.
+  if (bitrate > 0 &&
+      absl::c_all_of(allocatable_tracks, [](const AllocatableTrack& track) {
+        return !track.rate_quality_curve.empty();
+      })) {
+    bitrate = DistributeBitrateByQuality(allocatable_tracks, bitrate,
+                                         &observers_capacities, &allocation);
+  }
+
   // From the remaining bitrate, allocate a proportional amount to each observer
   // above the min bitrate already allocated.
   if (bitrate > 0)
@@ -358,6 +453,8 @@ BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
       last_stable_target_bps_(0),
       last_non_zero_bitrate_bps_(kDefaultBitrateBps),
       last_fraction_loss_(0),
+      last_predicted_loss_ratio_(0.0f),
+      last_predicted_bitrate_ratio_(1.0f),
       last_rtt_(0),
       last_bwe_period_ms_(1000),
       num_pause_events_(0),
@@ -385,6 +482,10 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
   int loss_ratio_255 = msg.network_estimate.loss_rate_ratio * 255;
   last_fraction_loss_ =
       rtc::dchecked_cast<uint8_t>(rtc::SafeClamp(loss_ratio_255, 0, 255));
+  last_predicted_loss_ratio_ = rtc::SafeClamp(
+      msg.network_estimate.predicted_loss_rate_ratio, 0.0f, 1.0f);
+  last_predicted_bitrate_ratio_ = rtc::SafeClamp(
+      msg.network_estimate.predicted_bandwidth_ratio, 0.0f, 1.0f);
   last_rtt_ = msg.network_estimate.round_trip_time.ms();
   last_bwe_period_ms_ = msg.network_estimate.bwe_period.ms();
 
@@ -395,6 +496,7 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
     last_bwe_log_time_ = now;
   }
 
+  UpdateRateQualityCurves();
   auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
   auto stable_bitrate_allocation =
       AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
@@ -408,6 +510,8 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
     update.stable_target_bitrate =
         DataRate::BitsPerSec(allocated_stable_target_rate);
     update.packet_loss_ratio = last_fraction_loss_ / 256.0;
+    update.predicted_packet_loss_ratio = last_predicted_loss_ratio_;
+    update.predicted_bitrate_ratio = last_predicted_bitrate_ratio_;
     update.round_trip_time = TimeDelta::Millis(last_rtt_);
     update.bwe_period = TimeDelta::Millis(last_bwe_period_ms_);
     update.cwnd_reduce_ratio = msg.cwnd_reduce_ratio;
@@ -461,7 +565,7 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
 
   if (last_target_bps_ > 0) {
     // Calculate a new allocation and update all observers.
-
+    UpdateRateQualityCurves();
     auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
     auto stable_bitrate_allocation =
         AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
@@ -474,6 +578,8 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
       update.stable_target_bitrate =
           DataRate::BitsPerSec(allocated_stable_bitrate);
       update.packet_loss_ratio = last_fraction_loss_ / 256.0;
+      update.predicted_packet_loss_ratio = last_predicted_loss_ratio_;
+      update.predicted_bitrate_ratio = last_predicted_bitrate_ratio_;
       update.round_trip_time = TimeDelta::Millis(last_rtt_);
       update.bwe_period = TimeDelta::Millis(last_bwe_period_ms_);
       uint32_t protection_bitrate = config.observer->OnBitrateUpdated(update);
@@ -490,6 +596,8 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
     update.target_bitrate = DataRate::Zero();
     update.stable_target_bitrate = DataRate::Zero();
     update.packet_loss_ratio = last_fraction_loss_ / 256.0;
+    update.predicted_packet_loss_ratio = last_predicted_loss_ratio_;
+    update.predicted_bitrate_ratio = last_predicted_bitrate_ratio_;
     update.round_trip_time = TimeDelta::Millis(last_rtt_);
     update.bwe_period = TimeDelta::Millis(last_bwe_period_ms_);
     observer->OnBitrateUpdated(update);
@@ -497,6 +605,11 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   UpdateAllocationLimits();
 }
 
+void BitrateAllocator::UpdateRateQualityCurves() {
+  for (auto& config : allocatable_tracks_)
+    config.rate_quality_curve = config.observer->GetRateQualityCurve();
+}
+
 void BitrateAllocator::UpdateAllocationLimits() {
   BitrateAllocationLimits limits;
   for (const auto& config : allocatable_tracks_) {
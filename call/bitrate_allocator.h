@@ -27,6 +27,14 @@ namespace webrtc {
 
 class Clock;
 
+// A point of the rate-quality curve of a send stream: the quality the stream
+// reaches at |bitrate_bps|. Quality is in a unit shared by all streams of the
+// call, such as an estimated perceptual score.
+struct RateQualityPoint {
+  uint32_t bitrate_bps;
+  double quality;
+};
+
 // Used by all send streams with adaptive bitrate, to get the currently
 // allocated bitrate for the send stream. The current network properties are
 // given at the same time, to let the send stream decide about possible loss
@@ -37,6 +45,14 @@ class BitrateAllocatorObserver {
   // implementation, as bitrate in bps.
   virtual uint32_t OnBitrateUpdated(BitrateAllocationUpdate update) = 0;
 
+  // Returns the quality reached at increasing bitrates, which lets the
+  // allocator spend the bitrate above the min and priority bitrates where it
+  // gains the most quality, instead of by bitrate priority. Only used if all
+  // observers return a curve. Called before every allocation.
+  virtual std::vector<RateQualityPoint> GetRateQualityCurve() const {
+    return {};
+  }
+
  protected:
   virtual ~BitrateAllocatorObserver() {}
 };
@@ -86,6 +102,8 @@ struct AllocatableTrack {
   MediaStreamAllocationConfig config;
   int64_t allocated_bitrate_bps;
   double media_ratio;  // Part of the total bitrate used for media [0.0, 1.0].
+  // Curve returned by the observer for the current allocation.
+  std::vector<RateQualityPoint> rate_quality_curve;
 
   uint32_t LastAllocatedBitrate() const;
   // The minimum bitrate required by this observer, including
@@ -138,6 +156,9 @@ class BitrateAllocator : public BitrateAllocatorInterface {
  private:
   using AllocatableTrack = bitrate_allocator_impl::AllocatableTrack;
 
+  // Gets the rate-quality curves of the observers for a new allocation.
+  void UpdateRateQualityCurves() RTC_RUN_ON(&sequenced_checker_);
+
   // Calculates the minimum requested send bitrate and max padding bitrate and
   // calls LimitObserver::OnAllocationLimitsChanged.
   void UpdateAllocationLimits() RTC_RUN_ON(&sequenced_checker_);
@@ -157,6 +178,8 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   uint32_t last_stable_target_bps_ RTC_GUARDED_BY(&sequenced_checker_);
   uint32_t last_non_zero_bitrate_bps_ RTC_GUARDED_BY(&sequenced_checker_);
   uint8_t last_fraction_loss_ RTC_GUARDED_BY(&sequenced_checker_);
+  float last_predicted_loss_ratio_ RTC_GUARDED_BY(&sequenced_checker_);
+  float last_predicted_bitrate_ratio_ RTC_GUARDED_BY(&sequenced_checker_);
   int64_t last_rtt_ RTC_GUARDED_BY(&sequenced_checker_);
   int64_t last_bwe_period_ms_ RTC_GUARDED_BY(&sequenced_checker_);
   // Number of mute events based on too low BWE, not network up/down.
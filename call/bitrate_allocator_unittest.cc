@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "system_wrappers/include/clock.h"
@@ -78,6 +79,19 @@ class TestBitrateObserver : public BitrateAllocatorObserver {
   double protection_ratio_;
 };
 
+class QualityCurveBitrateObserver : public TestBitrateObserver {
+ public:
+  explicit QualityCurveBitrateObserver(std::vector<RateQualityPoint> curve)
+      : curve_(std::move(curve)) {}
+
+  std::vector<RateQualityPoint> GetRateQualityCurve() const override {
+    return curve_;
+  }
+
+ private:
+  const std::vector<RateQualityPoint> curve_;
+};
+
 constexpr int64_t kDefaultProbingIntervalMs = 3000;
 const double kDefaultBitratePriority = 1.0;
 
@@ -1030,4 +1044,51 @@ TEST_F(BitrateAllocatorTest, PriorityRateThreeObserversTwoAllocatedToMax) {
   allocator_->RemoveObserver(&observer_high);
 }
 
+TEST_F(BitrateAllocatorTest, AllocatesByQualityGainedPerBit) {
+  // 20 and then 4 quality per Mbps.
+  QualityCurveBitrateObserver observer_a({{500000, 10.0}, {1000000, 12.0}});
+  // Not concave, so its 9 quality per Mbps up to 1 Mbps are what counts.
+  QualityCurveBitrateObserver observer_b({{200000, 1.0}, {1000000, 9.0}});
+  AddObserver(&observer_a, 0, 2000000, 0, true, kDefaultBitratePriority);
+  AddObserver(&observer_b, 0, 2000000, 0, true, kDefaultBitratePriority);
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(1500000, 0, 0, kDefaultProbingIntervalMs));
+
+  EXPECT_EQ(500000u, observer_a.last_bitrate_bps_);
+  EXPECT_EQ(1000000u, observer_b.last_bitrate_bps_);
+
+  allocator_->RemoveObserver(&observer_a);
+  allocator_->RemoveObserver(&observer_b);
+}
+
+TEST_F(BitrateAllocatorTest, AllocatesByPriorityWhereQualityStopsIncreasing) {
+  QualityCurveBitrateObserver observer_a({{100000, 10.0}});
+  QualityCurveBitrateObserver observer_b({{300000, 10.0}, {400000, 10.0}});
+  AddObserver(&observer_a, 0, 1500000, 0, true, kDefaultBitratePriority);
+  AddObserver(&observer_b, 0, 1500000, 0, true, kDefaultBitratePriority);
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(1000000, 0, 0, kDefaultProbingIntervalMs));
+
+  EXPECT_EQ(400000u, observer_a.last_bitrate_bps_);
+  EXPECT_EQ(600000u, observer_b.last_bitrate_bps_);
+
+  allocator_->RemoveObserver(&observer_a);
+  allocator_->RemoveObserver(&observer_b);
+}
+
+TEST_F(BitrateAllocatorTest, AllocatesByPriorityUnlessAllObserversHaveCurves) {
+  QualityCurveBitrateObserver observer_a({{500000, 10.0}});
+  TestBitrateObserver observer_b;
+  AddObserver(&observer_a, 0, 1500000, 0, true, kDefaultBitratePriority);
+  AddObserver(&observer_b, 0, 1500000, 0, true, kDefaultBitratePriority);
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(600000, 0, 0, kDefaultProbingIntervalMs));
+
+  EXPECT_EQ(300000u, observer_a.last_bitrate_bps_);
+  EXPECT_EQ(300000u, observer_b.last_bitrate_bps_);
+
+  allocator_->RemoveObserver(&observer_a);
+  allocator_->RemoveObserver(&observer_b);
+}
+
 }  // namespace webrtc
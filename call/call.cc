@@ -10,23 +10,29 @@
 
 #include "call/call.h"
 
+#include <stdio.h>
 #include <string.h>
 
 #include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/alphacc_config.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/transport/network_control.h"
+#include "api/transport/queueing_delay_trend.h"
+#include "api/units/time_delta.h"
 #include "audio/audio_receive_stream.h"
 #include "audio/audio_send_stream.h"
 #include "audio/audio_state.h"
 #include "call/bitrate_allocator.h"
 #include "call/flexfec_receive_stream_impl.h"
+#include "call/queued_rtp_stream_receiver_controller.h"
 #include "call/receive_time_calculator.h"
 #include "call/rtp_stream_receiver_controller.h"
 #include "call/rtp_transport_controller_send.h"
@@ -48,9 +54,13 @@
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/memory_accounting.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/synchronization/rw_lock_wrapper.h"
 #include "rtc_base/synchronization/sequence_checker.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -75,6 +85,10 @@ bool SendPeriodicFeedback(const std::vector<RtpExtension>& extensions) {
   return true;
 }
 
+int64_t ValueOrMinusOne(absl::optional<uint32_t> value) {
+  return value ? static_cast<int64_t>(*value) : -1;
+}
+
 // TODO(nisse): This really begs for a shared context struct.
 bool UseSendSideBwe(const std::vector<RtpExtension>& extensions,
                     bool transport_cc) {
@@ -164,6 +178,28 @@ TaskQueueBase* GetCurrentTaskQueueOrThread() {
   return current;
 }
 
+constexpr int kMaxVideoReceiveQueues = 16;
+
+// With "WebRTC-VideoReceiveQueues/<n>/" the packets of the video receive
+// streams are processed on n task queues, rather than on the worker thread.
+int NumVideoReceiveQueues() {
+  const std::string group_name =
+      field_trial::FindFullName("WebRTC-VideoReceiveQueues");
+  int num_queues = 0;
+  if (!group_name.empty() &&
+      (sscanf(group_name.c_str(), "%d", &num_queues) != 1 || num_queues < 0 ||
+       num_queues > kMaxVideoReceiveQueues)) {
+    RTC_LOG(LS_WARNING) << "Invalid number of video receive queues: "
+                        << group_name;
+    num_queues = 0;
+  }
+  return num_queues;
+}
+
+const AlphaCCConfig* GetAlphaCCConfigOrDefault(const CallConfig& config) {
+  return config.alpha_cc_config ? config.alpha_cc_config : GetAlphaCCConfig();
+}
+
 }  // namespace
 
 namespace internal {
@@ -172,7 +208,8 @@ class Call final : public webrtc::Call,
                    public PacketReceiver,
                    public RecoveredPacketReceiver,
                    public TargetTransferRateObserver,
-                   public BitrateAllocator::LimitObserver {
+                   public BitrateAllocator::LimitObserver,
+                   public QueueingDelayTrendObserver {
  public:
   Call(Clock* clock,
        const Call::Config& config,
@@ -213,6 +250,7 @@ class Call final : public webrtc::Call,
       FlexfecReceiveStream* receive_stream) override;
 
   RtpTransportControllerSendInterface* GetTransportControllerSend() override;
+  BitrateAllocatorInterface* GetBitrateAllocator() override;
 
   Stats GetStats() const override;
 
@@ -238,6 +276,10 @@ class Call final : public webrtc::Call,
   // Implements BitrateAllocator::LimitObserver.
   void OnAllocationLimitsChanged(BitrateAllocationLimits limits) override;
 
+  // Implements QueueingDelayTrendObserver, hands the trend on to the jitter
+  // buffers of all receive streams.
+  void OnQueueingDelayTrend(const QueueingDelayTrend& trend) override;
+
   void SetClientBitratePreferences(const BitrateSettings& preferences) override;
 
  private:
@@ -259,6 +301,9 @@ class Call final : public webrtc::Call,
   void UpdateReceiveHistograms();
   void UpdateHistograms();
   void UpdateAggregateNetworkState();
+  // Hands the frame statistics of the video receive streams to
+  // |receive_side_cc_|.
+  void SampleFrameStats() RTC_RUN_ON(configuration_sequence_checker_);
 
   void RegisterRateObserver();
 
@@ -266,6 +311,12 @@ class Call final : public webrtc::Call,
     return transport_send_ptr_->GetWorkerQueue();
   }
 
+  // Returns the receive queue the packets of the video stream with
+  // |media_ssrc| are processed on, or null if they are processed on the
+  // worker thread. The RTX and FlexFEC streams of a video stream share its
+  // queue, so that it sees all of their packets in one sequence.
+  QueuedRtpStreamReceiverController* GetVideoReceiveQueue(uint32_t media_ssrc);
+
   Clock* const clock_;
   TaskQueueFactory* const task_queue_factory_;
 
@@ -297,6 +348,17 @@ class Call final : public webrtc::Call,
   RtpStreamReceiverController audio_receiver_controller_;
   RtpStreamReceiverController video_receiver_controller_;
 
+  // Video packets are demuxed by |video_receiver_controller_| on the worker
+  // thread, and then processed on the queue of their stream, if any.
+  struct VideoReceiveQueue {
+    VideoReceiveQueue(TaskQueueFactory* task_queue_factory,
+                      RtpStreamReceiverController* receiver_controller);
+
+    rtc::TaskQueue queue;
+    QueuedRtpStreamReceiverController receiver_controller;
+  };
+  std::vector<std::unique_ptr<VideoReceiveQueue>> video_receive_queues_;
+
   // This extra map is used for receive processing which is
   // independent of media type.
 
@@ -371,11 +433,17 @@ class Call final : public webrtc::Call,
   AvgCounter pacer_bitrate_kbps_counter_ RTC_GUARDED_BY(&bitrate_crit_);
 
   ReceiveSideCongestionController receive_side_cc_;
+  // Runs SampleFrameStats() every AlphaCCConfig::bwe_frame_stats_interval_ms.
+  RepeatingTaskHandle frame_stats_task_
+      RTC_GUARDED_BY(configuration_sequence_checker_);
 
   const std::unique_ptr<ReceiveTimeCalculator> receive_time_calculator_;
 
   const std::unique_ptr<SendDelayStats> video_send_delay_stats_;
   const int64_t start_ms_;
+  // Captured at construction, since the AlphaCC config may be scoped to the
+  // creation of the call.
+  const std::string frame_timing_log_path_;
 
   // Caches transport_send_.get(), to avoid racing with destructor.
   // Note that this is declared before transport_send_ to ensure that it is not
@@ -389,6 +457,9 @@ class Call final : public webrtc::Call,
   bool is_target_rate_observer_registered_
       RTC_GUARDED_BY(&configuration_sequence_checker_) = false;
 
+  mutable rtc::ThreadCpuUsageSampler thread_cpu_usage_sampler_
+      RTC_GUARDED_BY(&configuration_sequence_checker_);
+
   RTC_DISALLOW_COPY_AND_ASSIGN(Call);
 };
 }  // namespace internal
@@ -401,7 +472,30 @@ std::string Call::Stats::ToString(int64_t time_ms) const {
   ss << "recv_bw_bps: " << recv_bandwidth_bps << ", ";
   ss << "max_pad_bps: " << max_padding_bitrate_bps << ", ";
   ss << "pacer_delay_ms: " << pacer_delay_ms << ", ";
+  ss << "pacer_max_burst_bytes: " << pacer_max_burst_bytes << ", ";
   ss << "rtt_ms: " << rtt_ms;
+  if (bwe_estimates > 0) {
+    ss << ", bwe_estimates: " << bwe_estimates << ", ";
+    ss << "bwe_inference_p99_us: " << bwe_inference_time_p99_us << ", ";
+    ss << "bwe_pending_p99: " << bwe_pending_packets_p99;
+  }
+  if (bwe_feedback_target_bps >= 0) {
+    ss << ", bwe_feedback_target_bps: " << bwe_feedback_target_bps << ", ";
+    ss << "bwe_feedback_age_ms: " << bwe_feedback_age_ms;
+  }
+  if (bwe_shadow_gcc_target_bps >= 0)
+    ss << ", bwe_shadow_gcc_target_bps: " << bwe_shadow_gcc_target_bps;
+  ss << ", buffer_bytes: "
+     << rtp_packet_history_bytes + video_packet_buffer_bytes +
+            video_frame_buffer_bytes + neteq_packet_buffer_bytes +
+            vp9_frame_buffer_pool_bytes;
+  // The busiest threads only, the buffer is bounded.
+  constexpr size_t kMaxLoggedThreads = 3;
+  for (size_t i = 0; i < thread_cpu_usage.size() && i < kMaxLoggedThreads;
+       ++i) {
+    ss << (i == 0 ? ", busiest_threads: " : " ") << thread_cpu_usage[i].name
+       << '=' << static_cast<int>(thread_cpu_usage[i].cpu_usage * 100) << '%';
+  }
   ss << '}';
   return ss.str();
 }
@@ -422,7 +516,8 @@ Call* Call::Create(const Call::Config& config,
       std::make_unique<RtpTransportControllerSend>(
           clock, config.event_log, config.network_state_predictor_factory,
           config.network_controller_factory, config.bitrate_config,
-          std::move(pacer_thread), config.task_queue_factory, config.trials),
+          std::move(pacer_thread), config.task_queue_factory, config.trials,
+          GetAlphaCCConfigOrDefault(config)),
       std::move(call_thread), config.task_queue_factory);
 }
 
@@ -465,21 +560,50 @@ Call::Call(Clock* clock,
       configured_max_padding_bitrate_bps_(0),
       estimated_send_bitrate_kbps_counter_(clock_, nullptr, true),
       pacer_bitrate_kbps_counter_(clock_, nullptr, true),
-      receive_side_cc_(clock_, transport_send->packet_router()),
+      receive_side_cc_(clock_,
+                       transport_send->packet_router(),
+                       /*network_state_estimator=*/nullptr,
+                       task_queue_factory_,
+                       event_log_,
+                       GetAlphaCCConfigOrDefault(config)),
       receive_time_calculator_(ReceiveTimeCalculator::CreateFromFieldTrial()),
       video_send_delay_stats_(new SendDelayStats(clock_)),
       start_ms_(clock_->TimeInMilliseconds()),
+      frame_timing_log_path_(
+          GetAlphaCCConfigOrDefault(config)->frame_timing_log_path),
       transport_send_ptr_(transport_send.get()),
       transport_send_(std::move(transport_send)) {
   RTC_DCHECK(config.event_log != nullptr);
   RTC_DCHECK(config.trials != nullptr);
   worker_sequence_checker_.Detach();
 
-  call_stats_->RegisterStatsObserver(&receive_side_cc_);
+  const int num_video_receive_queues = NumVideoReceiveQueues();
+  for (int i = 0; i < num_video_receive_queues; ++i) {
+    video_receive_queues_.push_back(std::make_unique<VideoReceiveQueue>(
+        task_queue_factory_, &video_receiver_controller_));
+  }
 
-  module_process_thread_->RegisterModule(
-      receive_side_cc_.GetRemoteBitrateEstimator(true), RTC_FROM_HERE);
-  module_process_thread_->RegisterModule(&receive_side_cc_, RTC_FROM_HERE);
+  call_stats_->RegisterStatsObserver(&receive_side_cc_);
+  if (field_trial::IsEnabled("WebRTC-JitterBufferQueueingDelayTrend"))
+    receive_side_cc_.SetQueueingDelayTrendObserver(this);
+
+  // Feedback and REMB are sent from the controller's own task queue, with the
+  // received packets handed over in batches.
+  receive_side_cc_.StartProcessing(task_queue_factory_);
+
+  const int frame_stats_interval_ms =
+      GetAlphaCCConfigOrDefault(config)->bwe_frame_stats_interval_ms;
+  if (frame_stats_interval_ms > 0) {
+    // Like |call_stats_|, on the thread creating the call, which is the one
+    // the stats of the video receive streams may be read on.
+    const TimeDelta interval = TimeDelta::Millis(frame_stats_interval_ms);
+    frame_stats_task_ = RepeatingTaskHandle::DelayedStart(
+        GetCurrentTaskQueueOrThread(), interval, [this, interval] {
+          RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
+          SampleFrameStats();
+          return interval;
+        });
+  }
 }
 
 Call::~Call() {
@@ -491,10 +615,10 @@ Call::~Call() {
   RTC_CHECK(audio_receive_streams_.empty());
   RTC_CHECK(video_receive_streams_.empty());
 
+  frame_stats_task_.Stop();
   module_process_thread_->Stop();
-  module_process_thread_->DeRegisterModule(
-      receive_side_cc_.GetRemoteBitrateEstimator(true));
-  module_process_thread_->DeRegisterModule(&receive_side_cc_);
+  receive_side_cc_.SetQueueingDelayTrendObserver(nullptr);
+  receive_side_cc_.StopProcessing();
   call_stats_->DeregisterStatsObserver(&receive_side_cc_);
 
   absl::optional<Timestamp> first_sent_packet_ms =
@@ -842,13 +966,28 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
 
   RegisterRateObserver();
 
+  if (!frame_timing_log_path_.empty() &&
+      configuration.frame_timing_log_path.empty()) {
+    configuration.frame_timing_log_path =
+        frame_timing_log_path_ + "." +
+        std::to_string(configuration.rtp.remote_ssrc);
+  }
+
   TaskQueueBase* current = GetCurrentTaskQueueOrThread();
   RTC_CHECK(current);
+  TaskQueueBase* packet_queue = current;
+  RtpStreamReceiverControllerInterface* receiver_controller =
+      &video_receiver_controller_;
+  if (QueuedRtpStreamReceiverController* receive_queue =
+          GetVideoReceiveQueue(configuration.rtp.remote_ssrc)) {
+    packet_queue = receive_queue->queue();
+    receiver_controller = receive_queue;
+  }
   VideoReceiveStream2* receive_stream = new VideoReceiveStream2(
-      task_queue_factory_, current, &video_receiver_controller_, num_cpu_cores_,
-      transport_send_ptr_->packet_router(), std::move(configuration),
-      module_process_thread_.get(), call_stats_.get(), clock_,
-      new VCMTiming(clock_));
+      task_queue_factory_, current, packet_queue, receiver_controller,
+      num_cpu_cores_, transport_send_ptr_->packet_router(),
+      std::move(configuration), module_process_thread_.get(), call_stats_.get(),
+      clock_, new VCMTiming(clock_));
 
   const webrtc::VideoReceiveStream::Config& config = receive_stream->config();
   {
@@ -906,6 +1045,14 @@ FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
   RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
 
   RecoveredPacketReceiver* recovered_packet_receiver = this;
+  RtpStreamReceiverControllerInterface* receiver_controller =
+      &video_receiver_controller_;
+  if (!config.protected_media_ssrcs.empty()) {
+    if (QueuedRtpStreamReceiverController* receive_queue =
+            GetVideoReceiveQueue(config.protected_media_ssrcs[0])) {
+      receiver_controller = receive_queue;
+    }
+  }
 
   FlexfecReceiveStreamImpl* receive_stream;
   {
@@ -920,7 +1067,7 @@ FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
     // TODO(nisse): Fix constructor so that it can be moved outside of
     // this locked scope.
     receive_stream = new FlexfecReceiveStreamImpl(
-        clock_, &video_receiver_controller_, config, recovered_packet_receiver,
+        clock_, receiver_controller, config, recovered_packet_receiver,
         call_stats_->AsRtcpRttStats(), module_process_thread_.get());
 
     RTC_DCHECK(receive_rtp_config_.find(config.remote_ssrc) ==
@@ -958,11 +1105,32 @@ RtpTransportControllerSendInterface* Call::GetTransportControllerSend() {
   return transport_send_ptr_;
 }
 
+BitrateAllocatorInterface* Call::GetBitrateAllocator() {
+  return bitrate_allocator_.get();
+}
+
+Call::VideoReceiveQueue::VideoReceiveQueue(
+    TaskQueueFactory* task_queue_factory,
+    RtpStreamReceiverController* receiver_controller)
+    : queue(task_queue_factory->CreateTaskQueue(
+          "VideoReceiveQueue",
+          TaskQueueFactory::Priority::HIGH)),
+      receiver_controller(receiver_controller, queue.Get()) {}
+
+QueuedRtpStreamReceiverController* Call::GetVideoReceiveQueue(
+    uint32_t media_ssrc) {
+  if (video_receive_queues_.empty())
+    return nullptr;
+  return &video_receive_queues_[media_ssrc % video_receive_queues_.size()]
+              ->receiver_controller;
+}
+
 Call::Stats Call::GetStats() const {
   RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
 
   // TODO(tommi): The following stats are managed on the process thread:
   // - pacer_delay_ms (PacedSender::Process)
+  // - pacer_max_burst_bytes
   // - rtt_ms
   // - recv_bandwidth_bps
   // These are delivered on the network TQ:
@@ -974,6 +1142,8 @@ Call::Stats Call::GetStats() const {
   // available.
   stats.pacer_delay_ms =
       aggregate_network_up_ ? transport_send_ptr_->GetPacerQueuingDelayMs() : 0;
+  stats.pacer_max_burst_bytes =
+      aggregate_network_up_ ? transport_send_ptr_->GetPacerMaxBurstBytes() : 0;
 
   stats.rtt_ms = call_stats_->LastProcessedRtt();
 
@@ -984,6 +1154,36 @@ Call::Stats Call::GetStats() const {
       &ssrcs, &recv_bandwidth);
   stats.recv_bandwidth_bps = recv_bandwidth;
 
+  if (absl::optional<ReceiveSideEstimatorWorker::Stats> bwe_stats =
+          receive_side_cc_.GetEstimatorStats()) {
+    stats.bwe_estimates = bwe_stats->estimates;
+    stats.bwe_dropped_packets = bwe_stats->dropped_packets;
+    stats.bwe_estimate_bps =
+        static_cast<int64_t>(bwe_stats->latest_estimate_bps);
+    stats.bwe_estimator_ready = bwe_stats->estimator_ready;
+    stats.bwe_model_version = bwe_stats->model_version;
+    stats.bwe_inference_time_p50_us =
+        ValueOrMinusOne(bwe_stats->inference_time_p50_us);
+    stats.bwe_inference_time_p99_us =
+        ValueOrMinusOne(bwe_stats->inference_time_p99_us);
+    stats.bwe_pending_packets_p50 =
+        ValueOrMinusOne(bwe_stats->pending_packets_p50);
+    stats.bwe_pending_packets_p99 =
+        ValueOrMinusOne(bwe_stats->pending_packets_p99);
+  }
+  if (absl::optional<AlphaCcFeedbackStats> feedback =
+          transport_send_ptr_->GetAlphaCcFeedbackStats()) {
+    stats.bwe_feedback_target_bps = feedback->target_rate.bps();
+    stats.bwe_feedback_age_ms =
+        clock_->TimeInMilliseconds() - feedback->receive_time.ms();
+    if (feedback->interval)
+      stats.bwe_feedback_interval_ms = feedback->interval->ms();
+  }
+  if (absl::optional<DataRate> shadow_target =
+          transport_send_ptr_->GetShadowTargetRate()) {
+    stats.bwe_shadow_gcc_target_bps = shadow_target->bps();
+  }
+
   {
     rtc::CritScope cs(&last_bandwidth_bps_crit_);
     stats.send_bandwidth_bps = last_bandwidth_bps_;
@@ -994,6 +1194,18 @@ Call::Stats Call::GetStats() const {
     stats.max_padding_bitrate_bps = configured_max_padding_bitrate_bps_;
   }
 
+  stats.rtp_packet_history_bytes =
+      GetTrackedMemoryBytes(MemoryCategory::kRtpPacketHistory);
+  stats.video_packet_buffer_bytes =
+      GetTrackedMemoryBytes(MemoryCategory::kVideoPacketBuffer);
+  stats.video_frame_buffer_bytes =
+      GetTrackedMemoryBytes(MemoryCategory::kVideoFrameBuffer);
+  stats.neteq_packet_buffer_bytes =
+      GetTrackedMemoryBytes(MemoryCategory::kNetEqPacketBuffer);
+  stats.vp9_frame_buffer_pool_bytes =
+      GetTrackedMemoryBytes(MemoryCategory::kVp9FrameBufferPool);
+  stats.thread_cpu_usage = thread_cpu_usage_sampler_.Sample();
+
   return stats;
 }
 
@@ -1028,6 +1240,31 @@ void Call::OnAudioTransportOverheadChanged(int transport_overhead_per_packet) {
   }
 }
 
+void Call::SampleFrameStats() {
+  ReceivedFrameStats frame_stats;
+  frame_stats.time_ms = clock_->TimeInMilliseconds();
+  {
+    ReadLockScoped read_lock(*receive_crit_);
+    if (video_receive_streams_.empty())
+      return;
+    for (VideoReceiveStream2* stream : video_receive_streams_) {
+      const VideoReceiveStream::Stats stats = stream->GetStats();
+      frame_stats.frames_received += stats.frame_counts.key_frames +
+                                     stats.frame_counts.delta_frames;
+      frame_stats.key_frames_received += stats.frame_counts.key_frames;
+      frame_stats.frames_decoded += stats.frames_decoded;
+      frame_stats.frames_dropped += stats.frames_dropped;
+      frame_stats.freeze_count += stats.freeze_count;
+      frame_stats.total_freezes_duration_ms += stats.total_freezes_duration_ms;
+      frame_stats.jitter_buffer_delay_seconds +=
+          stats.jitter_buffer_delay_seconds;
+      frame_stats.jitter_buffer_emitted_count +=
+          stats.jitter_buffer_emitted_count;
+    }
+  }
+  receive_side_cc_.OnFrameStats(frame_stats);
+}
+
 void Call::UpdateAggregateNetworkState() {
   RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
 
@@ -1077,6 +1314,14 @@ void Call::OnStartRateUpdate(DataRate start_rate) {
   bitrate_allocator_->UpdateStartRate(start_rate.bps<uint32_t>());
 }
 
+void Call::OnQueueingDelayTrend(const QueueingDelayTrend& trend) {
+  ReadLockScoped read_lock(*receive_crit_);
+  for (AudioReceiveStream* stream : audio_receive_streams_)
+    stream->OnQueueingDelayTrend(trend);
+  for (VideoReceiveStream2* stream : video_receive_streams_)
+    stream->OnQueueingDelayTrend(trend);
+}
+
 void Call::OnTargetTransferRate(TargetTransferRate msg) {
   RTC_DCHECK(network_queue()->IsCurrent());
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
@@ -1357,6 +1602,9 @@ void Call::NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
 
   RTPHeader header;
   packet.GetHeader(&header);
+  // Lets the receive side estimator tell audio from video.
+  if (media_type == MediaType::VIDEO)
+    header.payload_type_frequency = kVideoPayloadTypeFrequency;
 
   ReceivedPacket packet_msg;
   packet_msg.size = DataSize::Bytes(packet.payload_size());
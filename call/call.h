@@ -28,9 +28,12 @@
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/network_route.h"
+#include "rtc_base/thread_cpu_usage.h"
 
 namespace webrtc {
 
+class BitrateAllocatorInterface;
+
 // A Call instance can contain several send and/or receive streams. All streams
 // are assumed to have the same remote endpoint and will share bitrate estimates
 // etc.
@@ -45,7 +48,40 @@ class Call {
     int max_padding_bitrate_bps = 0;  // Cumulative configured max padding.
     int recv_bandwidth_bps = 0;       // Estimated available receive bandwidth.
     int64_t pacer_delay_ms = 0;
+    // Largest burst sent by the pacer during the last one to two seconds.
+    int64_t pacer_max_burst_bytes = 0;
     int64_t rtt_ms = -1;
+    // AlphaCC receive side estimator, all zero unless it runs in this call.
+    // See ReceiveSideEstimatorWorker::Stats, percentiles are -1 until known.
+    int64_t bwe_estimates = 0;
+    int64_t bwe_dropped_packets = 0;
+    int64_t bwe_estimate_bps = 0;
+    bool bwe_estimator_ready = false;
+    // Empty unless BweModelManager assigned the model.
+    std::string bwe_model_version;
+    int64_t bwe_inference_time_p50_us = -1;
+    int64_t bwe_inference_time_p99_us = -1;
+    int64_t bwe_pending_packets_p50 = -1;
+    int64_t bwe_pending_packets_p99 = -1;
+    // Latest AlphaCC estimate received from the remote receive side, see
+    // AlphaCcFeedbackStats. All -1 until the first one is received, and the
+    // interval until the second one.
+    int64_t bwe_feedback_target_bps = -1;
+    int64_t bwe_feedback_age_ms = -1;
+    int64_t bwe_feedback_interval_ms = -1;
+    // GCC target of ShadowGccNetworkController, -1 unless it runs in this
+    // call.
+    int64_t bwe_shadow_gcc_target_bps = -1;
+    // Bytes held by the buffers of all the calls of the process, see
+    // MemoryCategory.
+    int64_t rtp_packet_history_bytes = 0;
+    int64_t video_packet_buffer_bytes = 0;
+    int64_t video_frame_buffer_bytes = 0;
+    int64_t neteq_packet_buffer_bytes = 0;
+    int64_t vp9_frame_buffer_pool_bytes = 0;
+    // CPU usage of the threads of the process since the previous GetStats()
+    // of this call, busiest first. See rtc::ThreadCpuUsageSampler.
+    std::vector<rtc::ThreadCpuUsageSampler::Usage> thread_cpu_usage;
   };
 
   static Call* Create(const Call::Config& config);
@@ -98,6 +134,11 @@ class Call {
   // remove this method interface.
   virtual RtpTransportControllerSendInterface* GetTransportControllerSend() = 0;
 
+  // Returns the allocator that splits the target rate between the send streams
+  // of the call. Must be used on the worker queue of the transport controller
+  // send. May return null.
+  virtual BitrateAllocatorInterface* GetBitrateAllocator() = 0;
+
   // Returns the call statistics, such as estimated send and receive bandwidth,
   // pacing delay, etc.
   virtual Stats GetStats() const = 0;
@@ -22,6 +22,7 @@
 
 namespace webrtc {
 
+struct AlphaCCConfig;
 class AudioProcessing;
 class RtcEventLog;
 
@@ -63,6 +64,11 @@ struct CallConfig {
   // Key-value mapping of internal configurations to apply,
   // e.g. field trials.
   const WebRtcKeyValueConfig* trials = nullptr;
+
+  // AlphaCC configuration of this call, which must outlive it. Null means the
+  // process-wide GetAlphaCCConfig(). An injected |network_controller_factory|
+  // reads its own configuration.
+  const AlphaCCConfig* alpha_cc_config = nullptr;
 };
 
 }  // namespace webrtc
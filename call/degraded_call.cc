@@ -257,6 +257,10 @@ DegradedCall::GetTransportControllerSend() {
   return call_->GetTransportControllerSend();
 }
 
+BitrateAllocatorInterface* DegradedCall::GetBitrateAllocator() {
+  return call_->GetBitrateAllocator();
+}
+
 Call::Stats DegradedCall::GetStats() const {
   return call_->GetStats();
 }
@@ -80,6 +80,7 @@ class DegradedCall : public Call, private PacketReceiver {
   PacketReceiver* Receiver() override;
 
   RtpTransportControllerSendInterface* GetTransportControllerSend() override;
+  BitrateAllocatorInterface* GetBitrateAllocator() override;
 
   Stats GetStats() const override;
 
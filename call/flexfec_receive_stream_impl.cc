@@ -30,6 +30,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -114,9 +115,13 @@ std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
     return nullptr;
   }
   RTC_DCHECK_EQ(1U, config.protected_media_ssrcs.size());
+  const FecScheme fec_scheme =
+      field_trial::IsEnabled("WebRTC-FlexFEC-ReedSolomon")
+          ? FecScheme::kReedSolomon
+          : FecScheme::kXor;
   return std::unique_ptr<FlexfecReceiver>(new FlexfecReceiver(
       clock, config.remote_ssrc, config.protected_media_ssrcs[0],
-      recovered_packet_receiver));
+      recovered_packet_receiver, fec_scheme));
 }
 
 std::unique_ptr<RtpRtcp> CreateRtpRtcpModule(
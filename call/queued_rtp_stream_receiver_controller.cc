@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/queued_rtp_stream_receiver_controller.h"
+
+#include <utility>
+
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+
+QueuedRtpStreamReceiverController::QueuedSink::QueuedSink(
+    TaskQueueBase* queue,
+    RtpPacketSinkInterface* sink)
+    : queue_(queue), sink_(sink) {}
+
+void QueuedRtpStreamReceiverController::QueuedSink::OnRtpPacket(
+    const RtpPacketReceived& packet) {
+  // The payload buffer is shared, not copied.
+  queue_->PostTask(ToQueuedTask(
+      [sink = sink_, packet]() { sink->OnRtpPacket(packet); }));
+}
+
+QueuedRtpStreamReceiverController::Receiver::Receiver(
+    QueuedRtpStreamReceiverController* controller,
+    uint32_t ssrc,
+    RtpPacketSinkInterface* sink)
+    : controller_(controller),
+      queued_sink_(controller->queue_, sink),
+      receiver_(controller->controller_->CreateReceiver(ssrc, &queued_sink_)) {}
+
+QueuedRtpStreamReceiverController::Receiver::~Receiver() {
+  // No packets are posted for the sink once it's deregistered.
+  receiver_.reset();
+  controller_->Flush();
+}
+
+QueuedRtpStreamReceiverController::QueuedRtpStreamReceiverController(
+    RtpStreamReceiverControllerInterface* controller,
+    TaskQueueBase* queue)
+    : controller_(controller), queue_(queue) {
+  RTC_DCHECK(controller_);
+  RTC_DCHECK(queue_);
+}
+
+QueuedRtpStreamReceiverController::~QueuedRtpStreamReceiverController() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK(sinks_.empty());
+}
+
+std::unique_ptr<RtpStreamReceiverInterface>
+QueuedRtpStreamReceiverController::CreateReceiver(
+    uint32_t ssrc,
+    RtpPacketSinkInterface* sink) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return std::make_unique<Receiver>(this, ssrc, sink);
+}
+
+bool QueuedRtpStreamReceiverController::AddSink(uint32_t ssrc,
+                                                RtpPacketSinkInterface* sink) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  std::unique_ptr<QueuedSink>& queued_sink = sinks_[sink];
+  if (!queued_sink)
+    queued_sink = std::make_unique<QueuedSink>(queue_, sink);
+  return controller_->AddSink(ssrc, queued_sink.get());
+}
+
+size_t QueuedRtpStreamReceiverController::RemoveSink(
+    const RtpPacketSinkInterface* sink) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = sinks_.find(sink);
+  if (it == sinks_.end())
+    return 0;
+  const size_t num_removed = controller_->RemoveSink(it->second.get());
+  Flush();
+  sinks_.erase(it);
+  return num_removed;
+}
+
+void QueuedRtpStreamReceiverController::Flush() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK(!queue_->IsCurrent());
+  rtc::Event done;
+  queue_->PostTask(ToQueuedTask([&done] { done.Set(); }));
+  done.Wait(rtc::Event::kForever);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef CALL_QUEUED_RTP_STREAM_RECEIVER_CONTROLLER_H_
+#define CALL_QUEUED_RTP_STREAM_RECEIVER_CONTROLLER_H_
+
+#include <map>
+#include <memory>
+
+#include "api/task_queue/task_queue_base.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "call/rtp_stream_receiver_controller_interface.h"
+#include "rtc_base/synchronization/sequence_checker.h"
+
+namespace webrtc {
+
+// Registers sinks with another controller, and delivers the packets demuxed to
+// them on |queue| instead of on the thread demuxing them, in the order they
+// were demuxed in. This moves the receive processing of the streams off the
+// demuxing thread, and keeps the order of the packets of every stream.
+//
+// Receivers and sinks are added and removed on one sequence, other than
+// |queue|. Removing them waits for the packets already posted to |queue|, so
+// that a sink may be destroyed as soon as it is removed.
+class QueuedRtpStreamReceiverController
+    : public RtpStreamReceiverControllerInterface {
+ public:
+  QueuedRtpStreamReceiverController(
+      RtpStreamReceiverControllerInterface* controller,
+      TaskQueueBase* queue);
+  ~QueuedRtpStreamReceiverController() override;
+
+  TaskQueueBase* queue() const { return queue_; }
+
+  // Implements RtpStreamReceiverControllerInterface.
+  std::unique_ptr<RtpStreamReceiverInterface> CreateReceiver(
+      uint32_t ssrc,
+      RtpPacketSinkInterface* sink) override;
+  bool AddSink(uint32_t ssrc, RtpPacketSinkInterface* sink) override;
+  size_t RemoveSink(const RtpPacketSinkInterface* sink) override;
+
+ private:
+  class QueuedSink : public RtpPacketSinkInterface {
+   public:
+    QueuedSink(TaskQueueBase* queue, RtpPacketSinkInterface* sink);
+
+    void OnRtpPacket(const RtpPacketReceived& packet) override;
+
+   private:
+    TaskQueueBase* const queue_;
+    RtpPacketSinkInterface* const sink_;
+  };
+
+  class Receiver : public RtpStreamReceiverInterface {
+   public:
+    Receiver(QueuedRtpStreamReceiverController* controller,
+             uint32_t ssrc,
+             RtpPacketSinkInterface* sink);
+    ~Receiver() override;
+
+   private:
+    QueuedRtpStreamReceiverController* const controller_;
+    QueuedSink queued_sink_;
+    std::unique_ptr<RtpStreamReceiverInterface> receiver_;
+  };
+
+  // Waits for the packets posted to |queue_| so far to be delivered.
+  void Flush();
+
+  SequenceChecker sequence_checker_;
+  RtpStreamReceiverControllerInterface* const controller_;
+  TaskQueueBase* const queue_;
+  // The sinks added with AddSink().
+  std::map<const RtpPacketSinkInterface*, std::unique_ptr<QueuedSink>> sinks_
+      RTC_GUARDED_BY(sequence_checker_);
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_QUEUED_RTP_STREAM_RECEIVER_CONTROLLER_H_
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/queued_rtp_stream_receiver_controller.h"
+
+#include <vector>
+
+#include "call/rtp_stream_receiver_controller.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "rtc_base/thread_annotations.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr uint32_t kSsrc = 1111;
+constexpr uint32_t kOtherSsrc = 2222;
+
+RtpPacketReceived CreatePacket(uint32_t ssrc, uint16_t sequence_number) {
+  RtpPacketReceived packet;
+  packet.SetSsrc(ssrc);
+  packet.SetSequenceNumber(sequence_number);
+  return packet;
+}
+
+// Records the packets it receives, which it expects on |queue|.
+class RecordingSink : public RtpPacketSinkInterface {
+ public:
+  explicit RecordingSink(TaskQueueBase* queue) : queue_(queue) {}
+
+  // Blocks delivery with the first packet until Release() is called.
+  void HoldFirstPacket() { hold_ = true; }
+  void Release() { release_.Set(); }
+
+  void OnRtpPacket(const RtpPacketReceived& packet) override {
+    EXPECT_TRUE(queue_->IsCurrent());
+    if (hold_) {
+      hold_ = false;
+      release_.Wait(rtc::Event::kForever);
+    }
+    rtc::CritScope lock(&lock_);
+    sequence_numbers_.push_back(packet.SequenceNumber());
+  }
+
+  std::vector<uint16_t> sequence_numbers() const {
+    rtc::CritScope lock(&lock_);
+    return sequence_numbers_;
+  }
+
+ private:
+  TaskQueueBase* const queue_;
+  bool hold_ = false;
+  rtc::Event release_;
+  rtc::CriticalSection lock_;
+  std::vector<uint16_t> sequence_numbers_ RTC_GUARDED_BY(lock_);
+};
+
+class QueuedRtpStreamReceiverControllerTest : public ::testing::Test {
+ protected:
+  QueuedRtpStreamReceiverControllerTest()
+      : queue_("receive"), queued_controller_(&controller_, queue_.Get()) {}
+
+  TaskQueueForTest queue_;
+  RtpStreamReceiverController controller_;
+  QueuedRtpStreamReceiverController queued_controller_;
+};
+
+TEST_F(QueuedRtpStreamReceiverControllerTest, DeliversPacketsOnQueueInOrder) {
+  RecordingSink sink(queue_.Get());
+  RecordingSink other_sink(queue_.Get());
+  auto receiver = queued_controller_.CreateReceiver(kSsrc, &sink);
+  auto other_receiver =
+      queued_controller_.CreateReceiver(kOtherSsrc, &other_sink);
+
+  for (uint16_t i = 0; i < 10; ++i) {
+    EXPECT_TRUE(controller_.OnRtpPacket(CreatePacket(kSsrc, i)));
+    EXPECT_TRUE(controller_.OnRtpPacket(CreatePacket(kOtherSsrc, 100 + i)));
+  }
+  queue_.WaitForPreviouslyPostedTasks();
+
+  EXPECT_THAT(sink.sequence_numbers(),
+              ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+  EXPECT_THAT(other_sink.sequence_numbers(),
+              ElementsAre(100, 101, 102, 103, 104, 105, 106, 107, 108, 109));
+}
+
+TEST_F(QueuedRtpStreamReceiverControllerTest,
+       DestroyingReceiverWaitsForPostedPackets) {
+  RecordingSink sink(queue_.Get());
+  sink.HoldFirstPacket();
+  auto receiver = queued_controller_.CreateReceiver(kSsrc, &sink);
+  EXPECT_TRUE(controller_.OnRtpPacket(CreatePacket(kSsrc, 1)));
+  EXPECT_TRUE(controller_.OnRtpPacket(CreatePacket(kSsrc, 2)));
+
+  sink.Release();
+  receiver.reset();
+  EXPECT_THAT(sink.sequence_numbers(), ElementsAre(1, 2));
+  EXPECT_FALSE(controller_.OnRtpPacket(CreatePacket(kSsrc, 3)));
+}
+
+TEST_F(QueuedRtpStreamReceiverControllerTest, AddsAndRemovesSinks) {
+  RecordingSink sink(queue_.Get());
+  EXPECT_TRUE(queued_controller_.AddSink(kSsrc, &sink));
+  EXPECT_TRUE(queued_controller_.AddSink(kOtherSsrc, &sink));
+  EXPECT_TRUE(controller_.OnRtpPacket(CreatePacket(kSsrc, 1)));
+  EXPECT_TRUE(controller_.OnRtpPacket(CreatePacket(kOtherSsrc, 2)));
+
+  EXPECT_EQ(queued_controller_.RemoveSink(&sink), 1u);
+  EXPECT_THAT(sink.sequence_numbers(), ElementsAre(1, 2));
+  EXPECT_FALSE(controller_.OnRtpPacket(CreatePacket(kSsrc, 3)));
+  EXPECT_EQ(queued_controller_.RemoveSink(&sink), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
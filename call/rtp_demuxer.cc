@@ -10,6 +10,8 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <algorithm>
+
 #include "call/rtp_packet_sink_interface.h"
 #include "call/rtp_rtcp_demuxer_helper.h"
 #include "call/ssrc_binding_observer.h"
@@ -21,9 +23,88 @@
 
 namespace webrtc {
 
+namespace {
+
+constexpr size_t kMinSsrcSinkCacheSize = 16;
+
+}  // namespace
+
 RtpDemuxerCriteria::RtpDemuxerCriteria() = default;
 RtpDemuxerCriteria::~RtpDemuxerCriteria() = default;
 
+RtpDemuxer::SsrcSinkCache::SsrcSinkCache() = default;
+RtpDemuxer::SsrcSinkCache::~SsrcSinkCache() = default;
+
+RtpPacketSinkInterface* RtpDemuxer::SsrcSinkCache::Find(uint32_t ssrc) {
+  if (last_sink_ && last_ssrc_ == ssrc)
+    return last_sink_;
+  if (entries_.empty())
+    return nullptr;
+  const Entry& entry = Lookup(ssrc);
+  if (entry.used && entry.sink) {
+    last_ssrc_ = ssrc;
+    last_sink_ = entry.sink;
+  }
+  return entry.sink;
+}
+
+void RtpDemuxer::SsrcSinkCache::Set(uint32_t ssrc,
+                                    RtpPacketSinkInterface* sink) {
+  RTC_DCHECK(sink);
+  if (2 * (size_ + 1) > entries_.size())
+    Grow();
+  Entry& entry = Lookup(ssrc);
+  if (!entry.used) {
+    entry.ssrc = ssrc;
+    entry.used = true;
+    ++size_;
+  }
+  entry.sink = sink;
+  if (last_ssrc_ == ssrc)
+    last_sink_ = sink;
+}
+
+void RtpDemuxer::SsrcSinkCache::Invalidate(uint32_t ssrc) {
+  if (last_ssrc_ == ssrc)
+    last_sink_ = nullptr;
+  if (entries_.empty())
+    return;
+  // The entry is kept, so that the entries probed past it are still found.
+  Entry& entry = Lookup(ssrc);
+  if (entry.used)
+    entry.sink = nullptr;
+}
+
+void RtpDemuxer::SsrcSinkCache::Clear() {
+  entries_.clear();
+  size_ = 0;
+  last_sink_ = nullptr;
+}
+
+RtpDemuxer::SsrcSinkCache::Entry& RtpDemuxer::SsrcSinkCache::Lookup(
+    uint32_t ssrc) {
+  const size_t mask = entries_.size() - 1;
+  // Fibonacci hashing spreads the SSRCs, which may be sequential.
+  size_t index = ((ssrc * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & mask;
+  while (entries_[index].used && entries_[index].ssrc != ssrc)
+    index = (index + 1) & mask;
+  return entries_[index];
+}
+
+void RtpDemuxer::SsrcSinkCache::Grow() {
+  std::vector<Entry> entries(
+      std::max(kMinSsrcSinkCacheSize, 2 * entries_.size()));
+  entries_.swap(entries);
+  size_ = 0;
+  for (const Entry& entry : entries) {
+    if (entry.used && entry.sink) {
+      Entry& new_entry = Lookup(entry.ssrc);
+      new_entry = entry;
+      ++size_;
+    }
+  }
+}
+
 // static
 std::string RtpDemuxer::DescribePacket(const RtpPacketReceived& packet) {
   rtc::StringBuilder sb;
@@ -91,6 +172,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  sink_cache_.Clear();
 
   return true;
 }
@@ -168,11 +250,26 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  sink_cache_.Clear();
   return num_removed > 0;
 }
 
 bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
-  RtpPacketSinkInterface* sink = ResolveSink(packet);
+  const uint32_t ssrc = packet.Ssrc();
+  const bool has_ids = (use_mid_ && packet.HasExtension<RtpMid>()) ||
+                       packet.HasExtension<RtpStreamId>() ||
+                       packet.HasExtension<RepairedRtpStreamId>();
+  RtpPacketSinkInterface* sink = has_ids ? nullptr : sink_cache_.Find(ssrc);
+  if (sink == nullptr) {
+    sink = ResolveSink(packet);
+    const auto it = sink_by_ssrc_.find(ssrc);
+    if (sink != nullptr && !has_ids && it != sink_by_ssrc_.end() &&
+        it->second == sink) {
+      sink_cache_.Set(ssrc, sink);
+    } else {
+      sink_cache_.Invalidate(ssrc);
+    }
+  }
   if (sink != nullptr) {
     sink->OnRtpPacket(packet);
     return true;
@@ -143,9 +143,46 @@ class RtpDemuxer {
 
   // Configure whether to look at the MID header extension when demuxing
   // incoming RTP packets. By default this is enabled.
-  void set_use_mid(bool use_mid) { use_mid_ = use_mid; }
+  void set_use_mid(bool use_mid) {
+    use_mid_ = use_mid;
+    sink_cache_.Clear();
+  }
 
  private:
+  // Open addressing table of the sinks that packets of an SSRC are routed to
+  // when they carry no MID or RSID, so that those packets skip ResolveSink().
+  // The last hit is kept apart, since packets mostly come in runs of one SSRC.
+  class SsrcSinkCache {
+   public:
+    SsrcSinkCache();
+    ~SsrcSinkCache();
+
+    // Returns null if the sink of |ssrc| is not cached.
+    RtpPacketSinkInterface* Find(uint32_t ssrc);
+    void Set(uint32_t ssrc, RtpPacketSinkInterface* sink);
+    // Makes |ssrc| miss until it is set again.
+    void Invalidate(uint32_t ssrc);
+    void Clear();
+
+   private:
+    struct Entry {
+      uint32_t ssrc = 0;
+      // Null if the SSRC is invalidated.
+      RtpPacketSinkInterface* sink = nullptr;
+      bool used = false;
+    };
+
+    // Returns the entry of |ssrc|, or the free entry to put it in.
+    Entry& Lookup(uint32_t ssrc);
+    void Grow();
+
+    // Power of two in size, and at most half full.
+    std::vector<Entry> entries_;
+    size_t size_ = 0;
+    uint32_t last_ssrc_ = 0;
+    RtpPacketSinkInterface* last_sink_ = nullptr;
+  };
+
   // Returns true if adding a sink with the given criteria would cause conflicts
   // with the existing criteria and should be rejected.
   bool CriteriaWouldConflict(const RtpDemuxerCriteria& criteria) const;
@@ -207,6 +244,12 @@ class RtpDemuxer {
   std::vector<SsrcBindingObserver*> ssrc_binding_observers_;
 
   bool use_mid_ = true;
+
+  // Cleared whenever sinks are added or removed. Only holds sinks that the
+  // SSRC is bound to in |sink_by_ssrc_|, since ResolveSink() returns those
+  // sinks again for packets without MID and RSID until the sinks change or
+  // a packet of the SSRC with a MID or RSID is received.
+  SsrcSinkCache sink_cache_;
 };
 
 }  // namespace webrtc
@@ -1476,6 +1476,59 @@ TEST_F(RtpDemuxerTest, MaliciousPeerCannotCauseMemoryOveruse) {
   }
 }
 
+TEST_F(RtpDemuxerTest, PacketsWithoutMidFollowNewMidOfSsrc) {
+  constexpr uint32_t ssrc = 10;
+  NiceMock<MockRtpPacketSink> sink_a;
+  NiceMock<MockRtpPacketSink> sink_b;
+  AddSinkOnlyMid("a", &sink_a);
+  AddSinkOnlyMid("b", &sink_b);
+
+  demuxer_.OnRtpPacket(*CreatePacketWithSsrcMid(ssrc, "a"));
+  auto packet = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(sink_a, OnRtpPacket(SamePacketAs(*packet))).Times(2);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+
+  demuxer_.OnRtpPacket(*CreatePacketWithSsrcMid(ssrc, "b"));
+  packet = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(sink_b, OnRtpPacket(SamePacketAs(*packet))).Times(2);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+}
+
+TEST_F(RtpDemuxerTest, PacketsOfSsrcFollowSinkChanges) {
+  constexpr uint32_t ssrc = 10;
+  NiceMock<MockRtpPacketSink> sink_a;
+  NiceMock<MockRtpPacketSink> sink_b;
+  AddSinkOnlySsrc(ssrc, &sink_a);
+  auto packet = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(sink_a, OnRtpPacket(SamePacketAs(*packet))).Times(2);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+
+  RemoveSink(&sink_a);
+  EXPECT_FALSE(demuxer_.OnRtpPacket(*packet));
+
+  AddSinkOnlySsrc(ssrc, &sink_b);
+  EXPECT_CALL(sink_b, OnRtpPacket(SamePacketAs(*packet))).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+}
+
+TEST_F(RtpDemuxerTest, RoutesPacketsOfManySsrcs) {
+  constexpr int kNumSinks = 100;
+  NiceMock<MockRtpPacketSink> sinks[kNumSinks];
+  for (int i = 0; i < kNumSinks; ++i)
+    AddSinkOnlySsrc(1000 * i, &sinks[i]);
+
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < kNumSinks; ++i) {
+      auto packet = CreatePacketWithSsrc(1000 * i);
+      EXPECT_CALL(sinks[i], OnRtpPacket(SamePacketAs(*packet))).Times(1);
+      EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+    }
+  }
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 TEST_F(RtpDemuxerTest, CriteriaMustBeNonEmpty) {
@@ -9,6 +9,7 @@
  */
 #include "call/rtp_transport_controller_send.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -16,18 +17,24 @@
 #include "absl/strings/match.h"
 #include "absl/types/optional.h"
 // Revision for enabling AlphaCC and disabling GCC
+#include "api/alphacc_config.h"
 #include "api/transport/alpha_cc_factory.h"
 #include "api/transport/network_types.h"
 #include "api/units/data_rate.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "call/rtp_video_sender.h"
+#include "logging/rtc_event_log/events/rtc_event_alpha_cc_estimate.h"
 #include "logging/rtc_event_log/events/rtc_event_remote_estimate.h"
 #include "logging/rtc_event_log/events/rtc_event_route_change.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/alpha_cc_bwe.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/rate_limiter.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace {
@@ -36,6 +43,10 @@ static const size_t kMaxOverheadBytes = 500;
 
 constexpr TimeDelta kPacerQueueUpdateInterval = TimeDelta::Millis(25);
 
+// How long the estimate runs before it is assumed to have converged and is
+// worth caching for the next calls.
+constexpr TimeDelta kMinEstimateCacheDuration = TimeDelta::Seconds(10);
+
 TargetRateConstraints ConvertConstraints(int min_bitrate_bps,
                                          int max_bitrate_bps,
                                          int start_bitrate_bps,
@@ -69,6 +80,31 @@ bool IsRelayed(const rtc::NetworkRoute& route) {
   return route.local.uses_turn() || route.remote.uses_turn();
 }
 
+std::unique_ptr<NetworkControllerFactoryInterface> CreateFallbackFactory(
+    NetworkStatePredictorFactoryInterface* predictor_factory,
+    const AlphaCCConfig* alpha_cc_config,
+    const WebRtcKeyValueConfig* trials) {
+  GoogCcFactoryConfig config;
+  config.network_state_predictor_factory = predictor_factory;
+  config.alpha_cc_config = alpha_cc_config;
+  return CreateNetworkControllerFactory(std::move(config), trials);
+}
+
+std::unique_ptr<BandwidthEstimateCache> CreateEstimateCache(
+    const AlphaCCConfig* alpha_cc_config) {
+  if (!alpha_cc_config || !alpha_cc_config->is_sender ||
+      alpha_cc_config->bwe_cache_path.empty() ||
+      alpha_cc_config->dest_ip.empty()) {
+    return nullptr;
+  }
+  return std::make_unique<BandwidthEstimateCache>(
+      alpha_cc_config->bwe_cache_path);
+}
+
+Timestamp UtcNow() {
+  return Timestamp::Millis(rtc::TimeUTCMillis());
+}
+
 }  // namespace
 
 RtpTransportControllerSend::RtpTransportControllerSend(
@@ -79,12 +115,18 @@ RtpTransportControllerSend::RtpTransportControllerSend(
     const BitrateConstraints& bitrate_config,
     std::unique_ptr<ProcessThread> process_thread,
     TaskQueueFactory* task_queue_factory,
-    const WebRtcKeyValueConfig* trials)
+    const WebRtcKeyValueConfig* trials,
+    const AlphaCCConfig* alpha_cc_config)
     : clock_(clock),
       event_log_(event_log),
-      bitrate_configurator_(bitrate_config),
+      estimate_cache_(CreateEstimateCache(alpha_cc_config)),
+      cached_destination_(estimate_cache_ ? alpha_cc_config->dest_ip : ""),
+      bitrate_configurator_(
+          WithCachedStartRate(bitrate_config, alpha_cc_config)),
       process_thread_(std::move(process_thread)),
-      use_task_queue_pacer_(IsEnabled(trials, "WebRTC-TaskQueuePacer")),
+      use_shared_pacer_(IsEnabled(trials, "WebRTC-SharedTaskQueuePacer")),
+      use_task_queue_pacer_(use_shared_pacer_ ||
+                            IsEnabled(trials, "WebRTC-TaskQueuePacer")),
       process_thread_pacer_(use_task_queue_pacer_
                                 ? nullptr
                                 : new PacedSender(clock,
@@ -92,17 +134,24 @@ RtpTransportControllerSend::RtpTransportControllerSend(
                                                   event_log,
                                                   trials,
                                                   process_thread_.get())),
-      task_queue_pacer_(use_task_queue_pacer_
+      task_queue_pacer_(use_task_queue_pacer_ && !use_shared_pacer_
                             ? new TaskQueuePacedSender(clock,
                                                        &packet_router_,
                                                        event_log,
                                                        trials,
                                                        task_queue_factory)
                             : nullptr),
+      shared_pacer_(use_shared_pacer_ ? new SharedTaskQueuePacedSender(
+                                            clock,
+                                            &packet_router_,
+                                            event_log,
+                                            trials,
+                                            SharedPacingThread::GetDefault())
+                                      : nullptr),
       observer_(nullptr),
       controller_factory_override_(controller_factory),
       controller_factory_fallback_(
-          std::make_unique<GoogCcNetworkControllerFactory>(predictor_factory)),
+          CreateFallbackFactory(predictor_factory, alpha_cc_config, trials)),
       process_interval_(controller_factory_fallback_->GetProcessInterval()),
       last_report_block_time_(Timestamp::Millis(clock_->TimeInMilliseconds())),
       reset_feedback_on_route_change_(
@@ -114,19 +163,21 @@ RtpTransportControllerSend::RtpTransportControllerSend(
       relay_bandwidth_cap_("relay_cap", DataRate::PlusInfinity()),
       transport_overhead_bytes_per_packet_(0),
       network_available_(false),
+      audio_only_pacing_(alpha_cc_config && alpha_cc_config->bwe_audio_only),
       retransmission_rate_limiter_(clock, kRetransmitWindowSizeMs),
       task_queue_(task_queue_factory->CreateTaskQueue(
           "rtp_send_controller",
           TaskQueueFactory::Priority::NORMAL)) {
   ParseFieldTrial({&relay_bandwidth_cap_},
                   trials->Lookup("WebRTC-Bwe-NetworkRouteConstraints"));
-  initial_config_.constraints = ConvertConstraints(bitrate_config, clock_);
+  const BitrateConstraints start_config = bitrate_configurator_.GetConfig();
+  initial_config_.constraints = ConvertConstraints(start_config, clock_);
   initial_config_.event_log = event_log;
   initial_config_.key_value_config = trials;
-  RTC_DCHECK(bitrate_config.start_bitrate_bps > 0);
+  RTC_DCHECK(start_config.start_bitrate_bps > 0);
 
-  pacer()->SetPacingRates(
-      DataRate::BitsPerSec(bitrate_config.start_bitrate_bps), DataRate::Zero());
+  pacer()->SetPacingRates(DataRate::BitsPerSec(start_config.start_bitrate_bps),
+                          DataRate::Zero());
 
   if (!use_task_queue_pacer_) {
     process_thread_->Start();
@@ -137,6 +188,39 @@ RtpTransportControllerSend::~RtpTransportControllerSend() {
   if (!use_task_queue_pacer_) {
     process_thread_->Stop();
   }
+  if (estimate_cache_) {
+    rtc::CritScope cs(&alpha_cc_feedback_crit_);
+    if (last_target_ && last_target_->at_time - *first_target_time_ >=
+                            kMinEstimateCacheDuration) {
+      estimate_cache_->Store(cached_destination_,
+                             last_target_->target_rate, UtcNow());
+    }
+  }
+}
+
+BitrateConstraints RtpTransportControllerSend::WithCachedStartRate(
+    const BitrateConstraints& bitrate_config,
+    const AlphaCCConfig* alpha_cc_config) const {
+  if (!estimate_cache_)
+    return bitrate_config;
+  absl::optional<DataRate> estimate = estimate_cache_->Lookup(
+      cached_destination_, UtcNow(),
+      TimeDelta::Seconds(alpha_cc_config->bwe_cache_max_age_s));
+  if (!estimate)
+    return bitrate_config;
+  // The path may have changed since, start a bit lower.
+  int64_t start_bps =
+      estimate->bps() * alpha_cc_config->bwe_cache_start_percent / 100;
+  start_bps = std::max<int64_t>(start_bps, bitrate_config.min_bitrate_bps);
+  if (bitrate_config.max_bitrate_bps > 0)
+    start_bps = std::min<int64_t>(start_bps, bitrate_config.max_bitrate_bps);
+  if (start_bps <= 0)
+    return bitrate_config;
+  RTC_LOG(LS_INFO) << "Starting at " << start_bps << " bps from the estimate "
+                   << "cached for " << cached_destination_;
+  BitrateConstraints cached_config = bitrate_config;
+  cached_config.start_bitrate_bps = rtc::dchecked_cast<int>(start_bps);
+  return cached_config;
 }
 
 RtpVideoSenderInterface* RtpTransportControllerSend::CreateRtpVideoSender(
@@ -158,6 +242,7 @@ RtpVideoSenderInterface* RtpTransportControllerSend::CreateRtpVideoSender(
       this, event_log, &retransmission_rate_limiter_, std::move(fec_controller),
       frame_encryption_config.frame_encryptor,
       frame_encryption_config.crypto_options, std::move(frame_transformer)));
+  OnNumVideoSendersChanged();
   return video_rtp_senders_.back().get();
 }
 
@@ -172,6 +257,19 @@ void RtpTransportControllerSend::DestroyRtpVideoSender(
   }
   RTC_DCHECK(it != video_rtp_senders_.end());
   video_rtp_senders_.erase(it);
+  OnNumVideoSendersChanged();
+}
+
+void RtpTransportControllerSend::OnNumVideoSendersChanged() {
+  task_queue_.PostTask([this, num_senders = video_rtp_senders_.size()]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    absl::optional<PacerConfig> pacer_config =
+        audio_only_pacing_.SetNumVideoSenders(num_senders);
+    if (pacer_config) {
+      pacer()->SetPacingRates(pacer_config->data_rate(),
+                              pacer_config->pad_rate());
+    }
+  });
 }
 
 void RtpTransportControllerSend::UpdateControlState() {
@@ -179,12 +277,21 @@ void RtpTransportControllerSend::UpdateControlState() {
   if (!update)
     return;
   retransmission_rate_limiter_.SetMaxRate(update->target_rate.bps());
+  if (estimate_cache_) {
+    rtc::CritScope cs(&alpha_cc_feedback_crit_);
+    if (!first_target_time_)
+      first_target_time_ = update->at_time;
+    last_target_ = update;
+  }
   // We won't create control_handler_ until we have an observers.
   RTC_DCHECK(observer_ != nullptr);
   observer_->OnTargetTransferRate(*update);
 }
 
 RtpPacketPacer* RtpTransportControllerSend::pacer() {
+  if (use_shared_pacer_) {
+    return shared_pacer_.get();
+  }
   if (use_task_queue_pacer_) {
     return task_queue_pacer_.get();
   }
@@ -192,6 +299,9 @@ RtpPacketPacer* RtpTransportControllerSend::pacer() {
 }
 
 const RtpPacketPacer* RtpTransportControllerSend::pacer() const {
+  if (use_shared_pacer_) {
+    return shared_pacer_.get();
+  }
   if (use_task_queue_pacer_) {
     return task_queue_pacer_.get();
   }
@@ -217,6 +327,9 @@ RtpTransportControllerSend::transport_feedback_observer() {
 }
 
 RtpPacketSender* RtpTransportControllerSend::packet_sender() {
+  if (use_shared_pacer_) {
+    return shared_pacer_.get();
+  }
   if (use_task_queue_pacer_) {
     return task_queue_pacer_.get();
   }
@@ -384,10 +497,25 @@ RtcpBandwidthObserver* RtpTransportControllerSend::GetBandwidthObserver() {
 int64_t RtpTransportControllerSend::GetPacerQueuingDelayMs() const {
   return pacer()->OldestPacketWaitTime().ms();
 }
+int64_t RtpTransportControllerSend::GetPacerMaxBurstBytes() const {
+  return pacer()->MaxBurstSize().bytes();
+}
 absl::optional<Timestamp> RtpTransportControllerSend::GetFirstPacketTime()
     const {
   return pacer()->FirstSentPacketTime();
 }
+
+absl::optional<AlphaCcFeedbackStats>
+RtpTransportControllerSend::GetAlphaCcFeedbackStats() const {
+  rtc::CritScope cs(&alpha_cc_feedback_crit_);
+  return alpha_cc_feedback_;
+}
+
+absl::optional<DataRate> RtpTransportControllerSend::GetShadowTargetRate()
+    const {
+  rtc::CritScope cs(&alpha_cc_feedback_crit_);
+  return shadow_target_rate_;
+}
 void RtpTransportControllerSend::EnablePeriodicAlrProbing(bool enable) {
   task_queue_.PostTask([this, enable]() {
     RTC_DCHECK_RUN_ON(&task_queue_);
@@ -540,11 +668,16 @@ void RtpTransportControllerSend::OnTransportFeedback(
   auto feedback_time = Timestamp::Millis(clock_->TimeInMilliseconds());
   task_queue_.PostTask([this, feedback, feedback_time]() {
     RTC_DCHECK_RUN_ON(&task_queue_);
-    absl::optional<TransportPacketsFeedback> feedback_msg =
-        transport_feedback_adapter_.ProcessTransportFeedback(feedback,
-                                                             feedback_time);
-    if (feedback_msg && controller_) {
-      PostUpdates(controller_->OnTransportPacketsFeedback(*feedback_msg));
+    if (controller_ && controller_->ConsumesTransportPacketsFeedback()) {
+      absl::optional<TransportPacketsFeedback> feedback_msg =
+          transport_feedback_adapter_.ProcessTransportFeedback(feedback,
+                                                               feedback_time);
+      if (feedback_msg)
+        PostUpdates(controller_->OnTransportPacketsFeedback(*feedback_msg));
+    } else {
+      // Only the acknowledged data matters, for the pacer below.
+      transport_feedback_adapter_.AcknowledgeTransportFeedback(feedback,
+                                                               feedback_time);
     }
     pacer()->UpdateOutstandingData(
         transport_feedback_adapter_.GetOutstandingData());
@@ -566,10 +699,32 @@ void RtpTransportControllerSend::OnRemoteNetworkEstimate(
 }
 
 void RtpTransportControllerSend::OnApplicationPacket(const rtcp::App& app) {
-  if (app.sub_type() != kAppPacketSubType || app.name() != kAppPacketName) {
+  BweMessage bwe;
+  if (!rtcp::AlphaCcBwe::Parse(app, &bwe)) {
     return;
   }
-  const BweMessage bwe = *reinterpret_cast<const BweMessage*>(app.data());
+  if (event_log_) {
+    event_log_->Log(std::make_unique<RtcEventAlphaCcEstimate>(
+        RtcEventAlphaCcEstimate::Source::kReceived,
+        DataRate::BitsPerSec(static_cast<int64_t>(bwe.target_rate)),
+        DataRate::BitsPerSec(static_cast<int64_t>(bwe.pacing_rate)),
+        bwe.confidence, bwe.rtt_ms, bwe.loss_ratio));
+  }
+  const Timestamp now = Timestamp::Millis(clock_->TimeInMilliseconds());
+  absl::optional<TimeDelta> interval;
+  {
+    rtc::CritScope cs(&alpha_cc_feedback_crit_);
+    if (alpha_cc_feedback_)
+      interval = now - alpha_cc_feedback_->receive_time;
+    alpha_cc_feedback_ = AlphaCcFeedbackStats{
+        DataRate::BitsPerSec(static_cast<int64_t>(bwe.target_rate)), now,
+        interval};
+  }
+  if (interval) {
+    // How old the applied estimate gets before it is replaced.
+    RTC_HISTOGRAM_COUNTS_10000("WebRTC.Bwe.AlphaCc.EstimateIntervalMs",
+                               static_cast<int>(interval->ms()));
+  }
   task_queue_.PostTask([this, bwe]() {
     RTC_DCHECK_RUN_ON(&task_queue_);
     if (controller_) {
@@ -653,6 +808,9 @@ void RtpTransportControllerSend::PostUpdates(NetworkControlUpdate update) {
   if (update.congestion_window) {
     pacer()->SetCongestionWindow(*update.congestion_window);
   }
+  // Audio is not paced and can't probe, the target rate reaches the audio
+  // encoders through the bitrate allocator.
+  update = audio_only_pacing_.Filter(std::move(update));
   if (update.pacer_config) {
     pacer()->SetPacingRates(update.pacer_config->data_rate(),
                             update.pacer_config->pad_rate());
@@ -664,6 +822,10 @@ void RtpTransportControllerSend::PostUpdates(NetworkControlUpdate update) {
     control_handler_->SetTargetRate(*update.target_rate);
     UpdateControlState();
   }
+  if (update.shadow_target_rate) {
+    rtc::CritScope cs(&alpha_cc_feedback_crit_);
+    shadow_target_rate_ = update.shadow_target_rate;
+  }
 }
 
 void RtpTransportControllerSend::OnReceivedRtcpReceiverReportBlocks(
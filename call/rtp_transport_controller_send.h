@@ -17,9 +17,12 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/network_control.h"
 #include "api/units/data_rate.h"
+#include "call/audio_only_pacing_filter.h"
+#include "call/bandwidth_estimate_cache.h"
 #include "call/rtp_bitrate_configurator.h"
 #include "call/rtp_transport_controller_send_interface.h"
 #include "call/rtp_video_sender.h"
@@ -29,15 +32,18 @@
 #include "modules/pacing/paced_sender.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/pacing/rtp_packet_pacer.h"
+#include "modules/pacing/shared_task_queue_paced_sender.h"
 #include "modules/pacing/task_queue_paced_sender.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/task_utils/repeating_task.h"
 
 namespace webrtc {
+struct AlphaCCConfig;
 class Clock;
 class FrameEncryptorInterface;
 class RtcEventLog;
@@ -51,6 +57,8 @@ class RtpTransportControllerSend final
       public TransportFeedbackObserver,
       public NetworkStateEstimateObserver {
  public:
+  // The controllers created when |controller_factory| is null follow
+  // |alpha_cc_config|, see CallConfig::alpha_cc_config.
   RtpTransportControllerSend(
       Clock* clock,
       RtcEventLog* event_log,
@@ -59,7 +67,8 @@ class RtpTransportControllerSend final
       const BitrateConstraints& bitrate_config,
       std::unique_ptr<ProcessThread> process_thread,
       TaskQueueFactory* task_queue_factory,
-      const WebRtcKeyValueConfig* trials);
+      const WebRtcKeyValueConfig* trials,
+      const AlphaCCConfig* alpha_cc_config);
   ~RtpTransportControllerSend() override;
 
   RtpVideoSenderInterface* CreateRtpVideoSender(
@@ -97,7 +106,11 @@ class RtpTransportControllerSend final
   void OnNetworkAvailability(bool network_available) override;
   RtcpBandwidthObserver* GetBandwidthObserver() override;
   int64_t GetPacerQueuingDelayMs() const override;
+  int64_t GetPacerMaxBurstBytes() const override;
   absl::optional<Timestamp> GetFirstPacketTime() const override;
+  absl::optional<AlphaCcFeedbackStats> GetAlphaCcFeedbackStats()
+      const override;
+  absl::optional<DataRate> GetShadowTargetRate() const override;
   void EnablePeriodicAlrProbing(bool enable) override;
   void OnSentPacket(const rtc::SentPacket& sent_packet) override;
   void OnReceivedPacket(const ReceivedPacket& packet_msg) override;
@@ -143,19 +156,32 @@ class RtpTransportControllerSend final
       RTC_RUN_ON(task_queue_);
   void PostUpdates(NetworkControlUpdate update) RTC_RUN_ON(task_queue_);
   void UpdateControlState() RTC_RUN_ON(task_queue_);
+  // Posts the number of video senders to |task_queue_|.
+  void OnNumVideoSendersChanged();
   RtpPacketPacer* pacer();
   const RtpPacketPacer* pacer() const;
+  // Returns |bitrate_config| starting at the cached estimate of the
+  // destination, if any.
+  BitrateConstraints WithCachedStartRate(
+      const BitrateConstraints& bitrate_config,
+      const AlphaCCConfig* alpha_cc_config) const;
 
   Clock* const clock_;
   RtcEventLog* const event_log_;
+  // Set if the converged estimate of |cached_destination_| is cached.
+  const std::unique_ptr<BandwidthEstimateCache> estimate_cache_;
+  const std::string cached_destination_;
   PacketRouter packet_router_;
   std::vector<std::unique_ptr<RtpVideoSenderInterface>> video_rtp_senders_;
   RtpBitrateConfigurator bitrate_configurator_;
   std::map<std::string, rtc::NetworkRoute> network_routes_;
   const std::unique_ptr<ProcessThread> process_thread_;
+  // Pacers of all the calls run on a single SharedPacingThread.
+  const bool use_shared_pacer_;
   const bool use_task_queue_pacer_;
   std::unique_ptr<PacedSender> process_thread_pacer_;
   std::unique_ptr<TaskQueuePacedSender> task_queue_pacer_;
+  std::unique_ptr<SharedTaskQueuePacedSender> shared_pacer_;
 
   TargetTransferRateObserver* observer_ RTC_GUARDED_BY(task_queue_);
   TransportFeedbackDemuxer feedback_demuxer_;
@@ -179,6 +205,17 @@ class RtpTransportControllerSend final
   std::map<uint32_t, RTCPReportBlock> last_report_blocks_
       RTC_GUARDED_BY(task_queue_);
   Timestamp last_report_block_time_ RTC_GUARDED_BY(task_queue_);
+  rtc::CriticalSection alpha_cc_feedback_crit_;
+  absl::optional<AlphaCcFeedbackStats> alpha_cc_feedback_
+      RTC_GUARDED_BY(alpha_cc_feedback_crit_);
+  absl::optional<DataRate> shadow_target_rate_
+      RTC_GUARDED_BY(alpha_cc_feedback_crit_);
+  // The first and the last targets, the last one is cached when the call ends
+  // if the estimate had the time to converge.
+  absl::optional<Timestamp> first_target_time_
+      RTC_GUARDED_BY(alpha_cc_feedback_crit_);
+  absl::optional<TargetTransferRate> last_target_
+      RTC_GUARDED_BY(alpha_cc_feedback_crit_);
 
   NetworkControllerConfig initial_config_ RTC_GUARDED_BY(task_queue_);
   StreamsConfig streams_config_ RTC_GUARDED_BY(task_queue_);
@@ -190,6 +227,7 @@ class RtpTransportControllerSend final
 
   size_t transport_overhead_bytes_per_packet_ RTC_GUARDED_BY(task_queue_);
   bool network_available_ RTC_GUARDED_BY(task_queue_);
+  AudioOnlyPacingFilter audio_only_pacing_ RTC_GUARDED_BY(task_queue_);
   RepeatingTaskHandle pacer_queue_update_task_ RTC_GUARDED_BY(task_queue_);
   RepeatingTaskHandle controller_task_ RTC_GUARDED_BY(task_queue_);
 
@@ -24,6 +24,8 @@
 #include "api/frame_transformer_interface.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/transport/bitrate_settings.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "call/rtp_config.h"
 #include "modules/rtp_rtcp/include/report_block_data.h"
@@ -67,6 +69,16 @@ struct RtpSenderObservers {
   SendPacketObserver* send_packet_observer;
 };
 
+// The latest AlphaCC estimate received from the remote receive side, see
+// rtcp::AlphaCcBwe.
+struct AlphaCcFeedbackStats {
+  DataRate target_rate = DataRate::Zero();
+  // Local time the estimate was received at.
+  Timestamp receive_time = Timestamp::MinusInfinity();
+  // Time since the estimate before, unset for the first one.
+  absl::optional<TimeDelta> interval;
+};
+
 struct RtpSenderFrameEncryptionConfig {
   FrameEncryptorInterface* frame_encryptor = nullptr;
   CryptoOptions crypto_options;
@@ -138,7 +150,16 @@ class RtpTransportControllerSendInterface {
   virtual void OnNetworkAvailability(bool network_available) = 0;
   virtual RtcpBandwidthObserver* GetBandwidthObserver() = 0;
   virtual int64_t GetPacerQueuingDelayMs() const = 0;
+  // See RtpPacketPacer::MaxBurstSize().
+  virtual int64_t GetPacerMaxBurstBytes() const = 0;
   virtual absl::optional<Timestamp> GetFirstPacketTime() const = 0;
+  // Unset until an AlphaCC estimate is received. May be called on any thread.
+  virtual absl::optional<AlphaCcFeedbackStats> GetAlphaCcFeedbackStats()
+      const = 0;
+  // Latest target of the estimator the network controller runs for
+  // comparison only, see NetworkControlUpdate::shadow_target_rate. Unset if it
+  // runs none. May be called on any thread.
+  virtual absl::optional<DataRate> GetShadowTargetRate() const = 0;
   virtual void EnablePeriodicAlrProbing(bool enable) = 0;
   virtual void OnSentPacket(const rtc::SentPacket& sent_packet) = 0;
   virtual void OnReceivedPacket(const ReceivedPacket& received_packet) = 0;
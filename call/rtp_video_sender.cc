@@ -164,11 +164,19 @@ std::unique_ptr<VideoFecGenerator> MaybeCreateFecGenerator(
       rtp_state = &it->second;
     }
 
+    // The Reed-Solomon repair packets are not signaled, so the receiver must
+    // have the same field trial enabled.
+    const FecScheme fec_scheme =
+        absl::StartsWith(trials.Lookup("WebRTC-FlexFEC-ReedSolomon"),
+                         "Enabled")
+            ? FecScheme::kReedSolomon
+            : FecScheme::kXor;
+
     RTC_DCHECK_EQ(1U, rtp.flexfec.protected_media_ssrcs.size());
     return std::make_unique<FlexfecSender>(
         rtp.flexfec.payload_type, rtp.flexfec.ssrc,
         rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
-        RTPSender::FecExtensionSizes(), rtp_state, clock);
+        RTPSender::FecExtensionSizes(), rtp_state, clock, fec_scheme);
   } else if (rtp.ulpfec.red_payload_type >= 0 &&
              rtp.ulpfec.ulpfec_payload_type >= 0 &&
              !ShouldDisableRedAndUlpfec(/*flexfec_enabled=*/false, rtp,
@@ -184,6 +192,7 @@ std::unique_ptr<VideoFecGenerator> MaybeCreateFecGenerator(
 
 std::vector<RtpStreamSender> CreateRtpStreamSenders(
     Clock* clock,
+    TaskQueueBase* task_queue,
     const RtpConfig& rtp_config,
     const RtpSenderObservers& observers,
     int rtcp_report_interval_ms,
@@ -201,6 +210,7 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
 
   RtpRtcp::Configuration configuration;
   configuration.clock = clock;
+  configuration.task_queue = task_queue;
   configuration.audio = false;
   configuration.receiver_only = false;
   configuration.outgoing_transport = send_transport;
@@ -336,11 +346,13 @@ RtpVideoSender::RtpVideoSender(
           "Disabled")),
       has_packet_feedback_(TransportSeqNumExtensionConfigured(rtp_config)),
       active_(false),
+      task_queue_(TaskQueueBase::Current()),
       module_process_thread_(nullptr),
       suspended_ssrcs_(std::move(suspended_ssrcs)),
       fec_controller_(std::move(fec_controller)),
       fec_allowed_(true),
       rtp_streams_(CreateRtpStreamSenders(clock,
+                                          task_queue_,
                                           rtp_config,
                                           observers,
                                           rtcp_report_interval_ms,
@@ -376,6 +388,12 @@ RtpVideoSender::RtpVideoSender(
     }
     params_.push_back(RtpPayloadParams(ssrc, state, field_trials_));
   }
+  // A single stream covers the spatial layers.
+  if (codec_type_ == kVideoCodecVP9 && rtp_streams_.size() == 1 &&
+      absl::StartsWith(field_trials_.Lookup("WebRTC-Vp9SenderLayerDropping"),
+                       "Enabled")) {
+    svc_layer_dropper_.emplace();
+  }
 
   // RTP/RTCP initialization.
 
@@ -443,6 +461,8 @@ void RtpVideoSender::RegisterProcessThread(
   RTC_DCHECK_RUN_ON(&module_process_thread_checker_);
   RTC_DCHECK(!module_process_thread_);
   module_process_thread_ = module_process_thread;
+  if (task_queue_)
+    return;
 
   for (const RtpStreamSender& stream : rtp_streams_) {
     module_process_thread_->RegisterModule(stream.rtp_rtcp.get(),
@@ -452,6 +472,8 @@ void RtpVideoSender::RegisterProcessThread(
 
 void RtpVideoSender::DeRegisterProcessThread() {
   RTC_DCHECK_RUN_ON(&module_process_thread_checker_);
+  if (task_queue_)
+    return;
   for (const RtpStreamSender& stream : rtp_streams_)
     module_process_thread_->DeRegisterModule(stream.rtp_rtcp.get());
 }
@@ -547,12 +569,19 @@ EncodedImageCallback::Result RtpVideoSender::OnEncodedImage(
             : nullptr);
   }
 
+  RTPVideoHeader rtp_video_header = params_[stream_index].GetRtpVideoHeader(
+      encoded_image, codec_specific_info, shared_frame_id_);
+  if (svc_layer_dropper_ && rtp_video_header.codec == kVideoCodecVP9 &&
+      !svc_layer_dropper_->OnLayerFrame(
+          encoded_image._frameType == VideoFrameType::kVideoFrameKey,
+          &absl::get<RTPVideoHeaderVP9>(rtp_video_header.video_type_header))) {
+    // Not sent until the encoder is reconfigured for the lower rate.
+    return Result(Result::OK, rtp_timestamp);
+  }
+
   bool send_result = rtp_streams_[stream_index].sender_video->SendEncodedImage(
       rtp_config_.payload_type, codec_type_, rtp_timestamp, encoded_image,
-      fragmentation,
-      params_[stream_index].GetRtpVideoHeader(
-          encoded_image, codec_specific_info, shared_frame_id_),
-      expected_retransmission_time_ms);
+      fragmentation, rtp_video_header, expected_retransmission_time_ms);
   if (frame_count_observer_) {
     FrameCounts& counts = frame_counts_[stream_index];
     if (encoded_image._frameType == VideoFrameType::kVideoFrameKey) {
@@ -574,6 +603,8 @@ EncodedImageCallback::Result RtpVideoSender::OnEncodedImage(
 void RtpVideoSender::OnBitrateAllocationUpdated(
     const VideoBitrateAllocation& bitrate) {
   rtc::CritScope lock(&crit_);
+  if (svc_layer_dropper_)
+    svc_layer_dropper_->OnAllocationUpdated(bitrate);
   if (IsActiveLocked()) {
     if (rtp_streams_.size() == 1) {
       // If spatial scalability is enabled, it is covered by a single stream.
@@ -770,6 +801,8 @@ void RtpVideoSender::OnBitrateUpdated(BitrateAllocationUpdate update,
   // Get the encoder target rate. It is the estimated network rate -
   // protection overhead.
   // TODO(srte): We should multiply with 255 here.
+  fec_controller_->OnPredictedPacketLoss(
+      static_cast<float>(update.predicted_packet_loss_ratio));
   encoder_target_rate_bps_ = fec_controller_->UpdateFecRates(
       payload_bitrate_bps, framerate,
       rtc::saturated_cast<uint8_t>(update.packet_loss_ratio * 256),
@@ -794,6 +827,11 @@ void RtpVideoSender::OnBitrateUpdated(BitrateAllocationUpdate update,
 
   loss_mask_vector_.clear();
 
+  if (svc_layer_dropper_) {
+    svc_layer_dropper_->OnTargetRateUpdated(
+        DataRate::BitsPerSec(encoder_target_rate_bps_));
+  }
+
   uint32_t encoder_overhead_rate_bps = 0;
   if (send_side_bwe_with_overhead_ && has_packet_feedback_) {
     // TODO(srte): The packet size should probably be the same as in the
@@ -836,6 +874,14 @@ std::vector<RtpSequenceNumberMap::Info> RtpVideoSender::GetSentRtpPacketInfos(
   return std::vector<RtpSequenceNumberMap::Info>();
 }
 
+bool RtpVideoSender::RetransmitKeyFrameChain(uint32_t ssrc) {
+  for (const auto& rtp_stream : rtp_streams_) {
+    if (ssrc == rtp_stream.rtp_rtcp->SSRC())
+      return rtp_stream.sender_video->RetransmitKeyFrameChain();
+  }
+  return false;
+}
+
 int RtpVideoSender::ProtectionRequest(const FecProtectionParams* delta_params,
                                       const FecProtectionParams* key_params,
                                       uint32_t* sent_video_rate_bps,
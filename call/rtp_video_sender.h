@@ -22,12 +22,14 @@
 #include "api/fec_controller.h"
 #include "api/fec_controller_override.h"
 #include "api/rtc_event_log/rtc_event_log.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/transport/field_trial_based_config.h"
 #include "api/video_codecs/video_encoder.h"
 #include "call/rtp_config.h"
 #include "call/rtp_payload_params.h"
 #include "call/rtp_transport_controller_send_interface.h"
 #include "call/rtp_video_sender_interface.h"
+#include "call/svc_layer_dropper.h"
 #include "modules/rtp_rtcp/include/flexfec_sender.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 #include "modules/rtp_rtcp/source/rtp_sender_video.h"
@@ -93,9 +95,9 @@ class RtpVideoSender : public RtpVideoSenderInterface,
 
   // RegisterProcessThread register |module_process_thread| with those objects
   // that use it. Registration has to happen on the thread were
-  // |module_process_thread| was created (libjingle's worker thread).
-  // TODO(perkj): Replace the use of |module_process_thread| with a TaskQueue,
-  // maybe |worker_queue|.
+  // |module_process_thread| was created (libjingle's worker thread). The rtp
+  // modules are only registered if RtpVideoSender isn't created on a task
+  // queue, otherwise they do their periodic work on that queue.
   void RegisterProcessThread(ProcessThread* module_process_thread)
       RTC_LOCKS_EXCLUDED(crit_) override;
   void DeRegisterProcessThread() RTC_LOCKS_EXCLUDED(crit_) override;
@@ -154,6 +156,8 @@ class RtpVideoSender : public RtpVideoSenderInterface,
       uint32_t ssrc,
       rtc::ArrayView<const uint16_t> sequence_numbers) const
       RTC_LOCKS_EXCLUDED(crit_) override;
+  bool RetransmitKeyFrameChain(uint32_t ssrc)
+      RTC_LOCKS_EXCLUDED(crit_) override;
 
   // From StreamFeedbackObserver.
   void OnPacketFeedbackVector(
@@ -182,6 +186,9 @@ class RtpVideoSender : public RtpVideoSenderInterface,
   rtc::CriticalSection crit_;
   bool active_ RTC_GUARDED_BY(crit_);
 
+  // The queue RtpVideoSender is created on, if any, where the rtp modules do
+  // their periodic work.
+  TaskQueueBase* const task_queue_;
   ProcessThread* module_process_thread_;
   rtc::ThreadChecker module_process_thread_checker_;
   std::map<uint32_t, RtpState> suspended_ssrcs_;
@@ -209,6 +216,10 @@ class RtpVideoSender : public RtpVideoSenderInterface,
 
   std::vector<bool> loss_mask_vector_ RTC_GUARDED_BY(crit_);
 
+  // Set for a VP9 stream when the upper layers are dropped as soon as the
+  // target rate falls.
+  absl::optional<SvcLayerDropper> svc_layer_dropper_ RTC_GUARDED_BY(crit_);
+
   std::vector<FrameCounts> frame_counts_ RTC_GUARDED_BY(crit_);
   FrameCountObserver* const frame_count_observer_;
 
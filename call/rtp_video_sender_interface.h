@@ -62,6 +62,10 @@ class RtpVideoSenderInterface : public EncodedImageCallback,
   virtual std::vector<RtpSequenceNumberMap::Info> GetSentRtpPacketInfos(
       uint32_t ssrc,
       rtc::ArrayView<const uint16_t> sequence_numbers) const = 0;
+  // Answers a key frame request on |ssrc| by retransmitting the last key frame
+  // and the frames which followed it. Returns false if a new key frame has to
+  // be encoded instead.
+  virtual bool RetransmitKeyFrameChain(uint32_t ssrc) = 0;
 
   // Implements FecControllerOverride.
   void SetFecAllowed(bool fec_allowed) override = 0;
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/svc_layer_dropper.h"
+
+#include "api/video/video_codec_constants.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+// The encoder may allocate a bit more than the target rate, the layers are
+// only dropped on a larger drop of the rate.
+constexpr double kAllowedOvershoot = 1.1;
+
+int SpatialIndex(const RTPVideoHeaderVP9& vp9_header) {
+  return vp9_header.spatial_idx == kNoSpatialIdx ? 0 : vp9_header.spatial_idx;
+}
+
+int TemporalIndex(const RTPVideoHeaderVP9& vp9_header) {
+  return vp9_header.temporal_idx == kNoTemporalIdx ? 0
+                                                   : vp9_header.temporal_idx;
+}
+
+}  // namespace
+
+SvcLayerDropper::SvcLayerDropper()
+    : target_spatial_layer_(kMaxSpatialLayers - 1),
+      target_temporal_layer_(kMaxTemporalStreams - 1),
+      max_spatial_layer_(target_spatial_layer_),
+      max_temporal_layer_(target_temporal_layer_) {}
+
+void SvcLayerDropper::OnAllocationUpdated(
+    const VideoBitrateAllocation& allocation) {
+  allocation_ = allocation;
+  UpdateTargetLayers();
+}
+
+void SvcLayerDropper::OnTargetRateUpdated(DataRate target_rate) {
+  target_rate_ = target_rate;
+  UpdateTargetLayers();
+}
+
+bool SvcLayerDropper::OnLayerFrame(bool is_keyframe,
+                                   RTPVideoHeaderVP9* vp9_header) {
+  // All the layer frames of a picture share the picture id.
+  if (picture_id_ != vp9_header->picture_id) {
+    picture_id_ = vp9_header->picture_id;
+    OnPicture(is_keyframe, *vp9_header);
+  }
+  const int spatial_idx = SpatialIndex(*vp9_header);
+  if (spatial_idx > max_spatial_layer_ ||
+      TemporalIndex(*vp9_header) > max_temporal_layer_) {
+    return false;
+  }
+  if (spatial_idx == max_spatial_layer_)
+    vp9_header->end_of_picture = true;
+  return true;
+}
+
+void SvcLayerDropper::UpdateTargetLayers() {
+  target_spatial_layer_ = kMaxSpatialLayers - 1;
+  target_temporal_layer_ = kMaxTemporalStreams - 1;
+  if (target_rate_.IsPlusInfinity())
+    return;
+  const DataRate max_rate = target_rate_ * kAllowedOvershoot;
+  if (DataRate::BitsPerSec(allocation_.get_sum_bps()) <= max_rate)
+    return;
+  // Drop the upper spatial layers first, as the encoder would.
+  DataRate rate = DataRate::Zero();
+  target_spatial_layer_ = 0;
+  for (int s = 0; s < kMaxSpatialLayers; ++s) {
+    rate += DataRate::BitsPerSec(allocation_.GetSpatialLayerSum(s));
+    if (rate > max_rate)
+      break;
+    target_spatial_layer_ = s;
+  }
+  if (DataRate::BitsPerSec(allocation_.GetSpatialLayerSum(0)) <= max_rate)
+    return;
+  // Then the upper temporal layers of the base spatial layer.
+  rate = DataRate::Zero();
+  target_temporal_layer_ = 0;
+  for (int t = 0; t < kMaxTemporalStreams; ++t) {
+    rate += DataRate::BitsPerSec(allocation_.GetBitrate(0, t));
+    if (rate > max_rate)
+      break;
+    target_temporal_layer_ = t;
+  }
+}
+
+void SvcLayerDropper::OnPicture(bool is_keyframe,
+                                const RTPVideoHeaderVP9& vp9_header) {
+  const int previous_spatial_layer = max_spatial_layer_;
+  const int previous_temporal_layer = max_temporal_layer_;
+  // A layer the encoder doesn't produce anymore will be restarted by the
+  // encoder itself.
+  bool spatial_layers_used = false;
+  bool temporal_layers_used = false;
+  for (int s = 0; s < kMaxSpatialLayers; ++s) {
+    if (s > max_spatial_layer_ && s <= target_spatial_layer_)
+      spatial_layers_used |= allocation_.IsSpatialLayerUsed(s);
+    for (int t = max_temporal_layer_ + 1; t <= target_temporal_layer_; ++t)
+      temporal_layers_used |= allocation_.HasBitrate(s, t);
+  }
+
+  if (target_spatial_layer_ < max_spatial_layer_ || is_keyframe ||
+      !spatial_layers_used) {
+    max_spatial_layer_ = target_spatial_layer_;
+  }
+  // The upper temporal layer frames following an up switch don't depend on
+  // the dropped ones.
+  if (target_temporal_layer_ < max_temporal_layer_ || is_keyframe ||
+      !temporal_layers_used ||
+      (vp9_header.temporal_up_switch &&
+       TemporalIndex(vp9_header) <= max_temporal_layer_)) {
+    max_temporal_layer_ = target_temporal_layer_;
+  }
+
+  if (max_spatial_layer_ != previous_spatial_layer ||
+      max_temporal_layer_ != previous_temporal_layer) {
+    RTC_LOG(LS_INFO) << "Sending up to spatial layer " << max_spatial_layer_
+                     << " and temporal layer " << max_temporal_layer_;
+  }
+}
+
+}  // namespace webrtc
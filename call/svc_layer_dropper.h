@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_SVC_LAYER_DROPPER_H_
+#define CALL_SVC_LAYER_DROPPER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/units/data_rate.h"
+#include "api/video/video_bitrate_allocation.h"
+#include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
+
+namespace webrtc {
+
+// Stops sending the upper spatial and temporal layers of a VP9 SVC stream as
+// soon as the target rate falls below their allocation, without waiting for
+// the encoder to be reconfigured and without a key frame. The upper spatial
+// layers are dropped first, then the upper temporal layers of the base
+// spatial layer. A dropped layer is sent again once the rate allows it, from a
+// frame the receiver can decode: a key frame, a temporal up switch, or after
+// the encoder stopped producing it.
+class SvcLayerDropper {
+ public:
+  SvcLayerDropper();
+
+  // The allocation the encoder is configured with.
+  void OnAllocationUpdated(const VideoBitrateAllocation& allocation);
+  void OnTargetRateUpdated(DataRate target_rate);
+
+  // Returns false if the layer frame described by |vp9_header| must not be
+  // sent. Otherwise, marks the end of the picture on the highest layer sent.
+  bool OnLayerFrame(bool is_keyframe, RTPVideoHeaderVP9* vp9_header);
+
+  // The highest layers sent.
+  int max_spatial_layer() const { return max_spatial_layer_; }
+  int max_temporal_layer() const { return max_temporal_layer_; }
+
+ private:
+  void UpdateTargetLayers();
+  void OnPicture(bool is_keyframe, const RTPVideoHeaderVP9& vp9_header);
+
+  VideoBitrateAllocation allocation_;
+  DataRate target_rate_ = DataRate::PlusInfinity();
+  // The highest layers fitting in the target rate.
+  int target_spatial_layer_;
+  int target_temporal_layer_;
+  int max_spatial_layer_;
+  int max_temporal_layer_;
+  absl::optional<int16_t> picture_id_;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_SVC_LAYER_DROPPER_H_
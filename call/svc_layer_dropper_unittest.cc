@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/svc_layer_dropper.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumSpatialLayers = 3;
+
+RTPVideoHeaderVP9 LayerFrame(int16_t picture_id,
+                             int spatial_idx,
+                             int temporal_idx = 0,
+                             bool temporal_up_switch = false) {
+  RTPVideoHeaderVP9 vp9_header;
+  vp9_header.InitRTPVideoHeaderVP9();
+  vp9_header.picture_id = picture_id;
+  vp9_header.spatial_idx = spatial_idx;
+  vp9_header.temporal_idx = temporal_idx;
+  vp9_header.temporal_up_switch = temporal_up_switch;
+  vp9_header.num_spatial_layers = kNumSpatialLayers;
+  vp9_header.end_of_picture = spatial_idx == kNumSpatialLayers - 1;
+  return vp9_header;
+}
+
+// 100, 200 and 400 kbps for the spatial layers, the base one split in three
+// temporal layers.
+VideoBitrateAllocation Allocation() {
+  VideoBitrateAllocation allocation;
+  allocation.SetBitrate(0, 0, 60000);
+  allocation.SetBitrate(0, 1, 20000);
+  allocation.SetBitrate(0, 2, 20000);
+  allocation.SetBitrate(1, 0, 200000);
+  allocation.SetBitrate(2, 0, 400000);
+  return allocation;
+}
+
+// Returns the number of layer frames of the picture which are sent.
+int SendPicture(SvcLayerDropper* dropper,
+                int16_t picture_id,
+                bool is_keyframe = false) {
+  int num_sent = 0;
+  for (int s = 0; s < kNumSpatialLayers; ++s) {
+    RTPVideoHeaderVP9 vp9_header = LayerFrame(picture_id, s);
+    if (dropper->OnLayerFrame(is_keyframe, &vp9_header))
+      ++num_sent;
+  }
+  return num_sent;
+}
+
+TEST(SvcLayerDropperTest, SendsAllLayersWhenTheRateFits) {
+  SvcLayerDropper dropper;
+  dropper.OnAllocationUpdated(Allocation());
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(700));
+  EXPECT_EQ(kNumSpatialLayers, SendPicture(&dropper, 1));
+  // Within the overshoot of the encoder.
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(650));
+  EXPECT_EQ(kNumSpatialLayers, SendPicture(&dropper, 2));
+}
+
+TEST(SvcLayerDropperTest, DropsUpperSpatialLayersWithoutKeyFrame) {
+  SvcLayerDropper dropper;
+  dropper.OnAllocationUpdated(Allocation());
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(400));
+
+  RTPVideoHeaderVP9 s0 = LayerFrame(1, 0);
+  RTPVideoHeaderVP9 s1 = LayerFrame(1, 1);
+  RTPVideoHeaderVP9 s2 = LayerFrame(1, 2);
+  EXPECT_TRUE(dropper.OnLayerFrame(false, &s0));
+  EXPECT_FALSE(s0.end_of_picture);
+  EXPECT_TRUE(dropper.OnLayerFrame(false, &s1));
+  EXPECT_TRUE(s1.end_of_picture);
+  EXPECT_FALSE(dropper.OnLayerFrame(false, &s2));
+  EXPECT_EQ(1, dropper.max_spatial_layer());
+}
+
+TEST(SvcLayerDropperTest, DropsUpperTemporalLayersOfTheBaseLayer) {
+  SvcLayerDropper dropper;
+  dropper.OnAllocationUpdated(Allocation());
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(70));
+
+  RTPVideoHeaderVP9 t0 = LayerFrame(1, 0, 0);
+  EXPECT_TRUE(dropper.OnLayerFrame(false, &t0));
+  EXPECT_TRUE(t0.end_of_picture);
+  RTPVideoHeaderVP9 t1 = LayerFrame(2, 0, 1);
+  EXPECT_FALSE(dropper.OnLayerFrame(false, &t1));
+  EXPECT_EQ(0, dropper.max_spatial_layer());
+  EXPECT_EQ(0, dropper.max_temporal_layer());
+}
+
+TEST(SvcLayerDropperTest, ResumesSpatialLayersOnKeyFrame) {
+  SvcLayerDropper dropper;
+  dropper.OnAllocationUpdated(Allocation());
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(150));
+  EXPECT_EQ(1, SendPicture(&dropper, 1));
+
+  // The upper layer frames depend on the dropped ones.
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(700));
+  EXPECT_EQ(1, SendPicture(&dropper, 2));
+  EXPECT_EQ(kNumSpatialLayers, SendPicture(&dropper, 3, true));
+}
+
+TEST(SvcLayerDropperTest, ResumesSpatialLayersTheEncoderStopped) {
+  SvcLayerDropper dropper;
+  dropper.OnAllocationUpdated(Allocation());
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(150));
+  EXPECT_EQ(1, SendPicture(&dropper, 1));
+
+  VideoBitrateAllocation allocation;
+  allocation.SetBitrate(0, 0, 100000);
+  dropper.OnAllocationUpdated(allocation);
+  EXPECT_EQ(0, dropper.max_spatial_layer());
+  // The encoder restarts the layers with frames not depending on the dropped
+  // ones.
+  EXPECT_EQ(kNumSpatialLayers, SendPicture(&dropper, 2));
+}
+
+TEST(SvcLayerDropperTest, ResumesTemporalLayersOnUpSwitch) {
+  SvcLayerDropper dropper;
+  dropper.OnAllocationUpdated(Allocation());
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(70));
+  RTPVideoHeaderVP9 t0 = LayerFrame(1, 0, 0);
+  EXPECT_TRUE(dropper.OnLayerFrame(false, &t0));
+
+  dropper.OnTargetRateUpdated(DataRate::KilobitsPerSec(120));
+  RTPVideoHeaderVP9 t1 = LayerFrame(2, 0, 1);
+  EXPECT_FALSE(dropper.OnLayerFrame(false, &t1));
+  t0 = LayerFrame(3, 0, 0, /*temporal_up_switch=*/true);
+  EXPECT_TRUE(dropper.OnLayerFrame(false, &t0));
+  t1 = LayerFrame(4, 0, 1);
+  EXPECT_TRUE(dropper.OnLayerFrame(false, &t1));
+  EXPECT_TRUE(t1.end_of_picture);
+}
+
+}  // namespace
+}  // namespace webrtc
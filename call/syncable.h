@@ -29,6 +29,9 @@ class Syncable {
     uint32_t capture_time_ntp_frac = 0;
     uint32_t capture_time_source_clock = 0;
     int current_delay_ms = 0;
+    // The delay the stream needs without any minimum playout delay set, i.e.
+    // what its jitter buffer alone calls for.
+    int minimum_delay_ms = 0;
   };
 
   virtual ~Syncable();
@@ -252,6 +252,10 @@ class VideoReceiveStream {
     // used for streaming instead of a real-time call.
     int target_delay_ms = 0;
 
+    // File to write a line per received frame to, see FrameTimingLog. Empty
+    // string to disable.
+    std::string frame_timing_log_path;
+
     // TODO(nisse): Used with VideoDecoderFactory::LegacyCreateVideoDecoder.
     // Delete when that method is retired.
     std::string stream_id;
@@ -18,7 +18,9 @@ namespace webrtc {
 
 class PushSincResampler;
 
-// Wraps PushSincResampler to provide stereo support.
+// Wraps PushSincResampler to provide stereo support. The per channel
+// resamplers are recycled through a small per thread cache keyed by the rates,
+// so that reinitializing for a previous configuration is cheap.
 // TODO(ajm): add support for an arbitrary number of channels.
 template <typename T>
 class PushResampler {
@@ -37,6 +39,10 @@ class PushResampler {
   int Resample(const T* src, size_t src_length, T* dst, size_t dst_capacity);
 
  private:
+  // Hands the per channel resamplers over to the cache of idle resamplers of
+  // the thread, for the next PushResampler initialized with the same rates.
+  void ReleaseChannelResamplers();
+
   int src_sample_rate_hz_;
   int dst_sample_rate_hz_;
   size_t num_channels_;
@@ -14,13 +14,82 @@
 #include <string.h>
 
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
 #include "common_audio/include/audio_util.h"
 #include "common_audio/resampler/push_sinc_resampler.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 namespace {
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+// Idle resamplers of the thread, most recently released last. Computing the
+// kernels of a resampler is most of the cost of initializing a PushResampler,
+// and streams changing rates often go back and forth between the same ones.
+constexpr size_t kMaxIdleResamplers = 8;
+
+struct IdleResampler {
+  size_t source_frames;
+  size_t destination_frames;
+  std::unique_ptr<PushSincResampler> resampler;
+};
+
+ABSL_CONST_INIT thread_local bool idle_resamplers_destroyed = false;
+
+struct IdleResamplers {
+  ~IdleResamplers() { idle_resamplers_destroyed = true; }
+  std::vector<IdleResampler> resamplers;
+};
+
+// Null while the thread exits.
+std::vector<IdleResampler>* GetIdleResamplers() {
+  if (idle_resamplers_destroyed)
+    return nullptr;
+  static thread_local IdleResamplers idle_resamplers;
+  return &idle_resamplers.resamplers;
+}
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
+// Returns an idle resampler of these sizes from the cache of the thread, or a
+// new one.
+std::unique_ptr<PushSincResampler> TakeResampler(size_t source_frames,
+                                                 size_t destination_frames) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  if (std::vector<IdleResampler>* idle = GetIdleResamplers()) {
+    for (auto it = idle->rbegin(); it != idle->rend(); ++it) {
+      if (it->source_frames == source_frames &&
+          it->destination_frames == destination_frames) {
+        std::unique_ptr<PushSincResampler> resampler = std::move(it->resampler);
+        idle->erase(std::next(it).base());
+        resampler->Reset();
+        return resampler;
+      }
+    }
+  }
+#endif
+  return std::make_unique<PushSincResampler>(source_frames,
+                                             destination_frames);
+}
+
+// Keeps |resampler| in the cache of the thread, evicting the least recently
+// released one if it is full.
+void ReleaseResampler(size_t source_frames,
+                      size_t destination_frames,
+                      std::unique_ptr<PushSincResampler> resampler) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  if (std::vector<IdleResampler>* idle = GetIdleResamplers()) {
+    if (idle->size() == kMaxIdleResamplers)
+      idle->erase(idle->begin());
+    idle->push_back(
+        {source_frames, destination_frames, std::move(resampler)});
+  }
+#endif
+}
+
 // These checks were factored out into a non-templatized function
 // due to problems with clang on Windows in debug builds.
 // For some reason having the DCHECKs inline in the template code
@@ -62,7 +131,19 @@ PushResampler<T>::PushResampler()
     : src_sample_rate_hz_(0), dst_sample_rate_hz_(0), num_channels_(0) {}
 
 template <typename T>
-PushResampler<T>::~PushResampler() {}
+PushResampler<T>::~PushResampler() {
+  ReleaseChannelResamplers();
+}
+
+template <typename T>
+void PushResampler<T>::ReleaseChannelResamplers() {
+  for (ChannelResampler& channel_resampler : channel_resamplers_) {
+    ReleaseResampler(channel_resampler.source.size(),
+                     channel_resampler.destination.size(),
+                     std::move(channel_resampler.resampler));
+  }
+  channel_resamplers_.clear();
+}
 
 template <typename T>
 int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
@@ -89,14 +170,17 @@ int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
       static_cast<size_t>(src_sample_rate_hz / 100);
   const size_t dst_size_10ms_mono =
       static_cast<size_t>(dst_sample_rate_hz / 100);
-  channel_resamplers_.clear();
-  for (size_t i = 0; i < num_channels; ++i) {
-    channel_resamplers_.push_back(ChannelResampler());
-    auto channel_resampler = channel_resamplers_.rbegin();
-    channel_resampler->resampler = std::make_unique<PushSincResampler>(
-        src_size_10ms_mono, dst_size_10ms_mono);
-    channel_resampler->source.resize(src_size_10ms_mono);
-    channel_resampler->destination.resize(dst_size_10ms_mono);
+  ReleaseChannelResamplers();
+  // Matching rates are copied by Resample(), without any resampler.
+  if (src_sample_rate_hz != dst_sample_rate_hz) {
+    for (size_t i = 0; i < num_channels; ++i) {
+      channel_resamplers_.push_back(ChannelResampler());
+      auto channel_resampler = channel_resamplers_.rbegin();
+      channel_resampler->resampler =
+          TakeResampler(src_size_10ms_mono, dst_size_10ms_mono);
+      channel_resampler->source.resize(src_size_10ms_mono);
+      channel_resampler->destination.resize(dst_size_10ms_mono);
+    }
   }
 
   channel_data_array_.resize(num_channels_);
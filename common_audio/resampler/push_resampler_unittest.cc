@@ -10,6 +10,8 @@
 
 #include "common_audio/resampler/include/push_resampler.h"
 
+#include <vector>
+
 #include "rtc_base/checks.h"  // RTC_DCHECK_IS_ON
 #include "test/gtest.h"
 #include "test/testsupport/rtc_expect_death.h"
@@ -52,4 +54,45 @@ TEST(PushResamplerTest, VerifiesBadInputParameters3) {
 #endif
 #endif
 
+// Resamplers recycled by a reinitialization must start over like new ones.
+TEST(PushResamplerTest, ReinitializedResamplerMatchesNewOne) {
+  constexpr size_t kChannels = 2;
+  constexpr size_t kSrcLength = 160 * kChannels;
+  constexpr size_t kDstLength = 480 * kChannels;
+  std::vector<float> src(kSrcLength);
+  for (size_t i = 0; i < kSrcLength; ++i)
+    src[i] = static_cast<float>((i * 37) % 200) - 100.f;
+
+  PushResampler<float> resampler;
+  std::vector<float> dst(kDstLength);
+  ASSERT_EQ(0, resampler.InitializeIfNeeded(16000, 48000, kChannels));
+  resampler.Resample(src.data(), src.size(), dst.data(), dst.size());
+  ASSERT_EQ(0, resampler.InitializeIfNeeded(48000, 16000, kChannels));
+  ASSERT_EQ(0, resampler.InitializeIfNeeded(16000, 48000, kChannels));
+
+  PushResampler<float> new_resampler;
+  std::vector<float> new_dst(kDstLength);
+  ASSERT_EQ(0, new_resampler.InitializeIfNeeded(16000, 48000, kChannels));
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(static_cast<int>(kDstLength),
+              resampler.Resample(src.data(), src.size(), dst.data(),
+                                 dst.size()));
+    EXPECT_EQ(static_cast<int>(kDstLength),
+              new_resampler.Resample(src.data(), src.size(), new_dst.data(),
+                                     new_dst.size()));
+    EXPECT_EQ(dst, new_dst);
+  }
+}
+
+TEST(PushResamplerTest, CopiesMatchingRates) {
+  const std::vector<int16_t> src = {1, -2, 3, -4, 5, -6};
+  PushResampler<int16_t> resampler;
+  // 100 Hz for 10 ms frames of a single sample per channel.
+  ASSERT_EQ(0, resampler.InitializeIfNeeded(300, 300, 2));
+  std::vector<int16_t> dst(src.size());
+  EXPECT_EQ(6, resampler.Resample(src.data(), src.size(), dst.data(),
+                                  dst.size()));
+  EXPECT_EQ(src, dst);
+}
+
 }  // namespace webrtc
@@ -77,6 +77,11 @@ size_t PushSincResampler::Resample(const float* source,
   return destination_frames_;
 }
 
+void PushSincResampler::Reset() {
+  resampler_->Flush();
+  first_pass_ = true;
+}
+
 void PushSincResampler::Run(size_t frames, float* destination) {
   // Ensure we are only asked for the available samples. This would fail if
   // Run() was triggered more than once per Resample() call.
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/correlation_avx2.h"
+
+#include <immintrin.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace {
+
+// Multiplies 16 samples of |a| and |b| and shifts each 32 bit product right
+// by |shift|, as the C versions do before summing. The products end up in
+// |low| and |high| in an order that does not matter for a sum.
+inline void MultiplyAndShift(const int16_t* a,
+                             const int16_t* b,
+                             __m128i shift,
+                             __m256i* low,
+                             __m256i* high) {
+  const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+  const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+  const __m256i products_low = _mm256_mullo_epi16(x, y);
+  const __m256i products_high = _mm256_mulhi_epi16(x, y);
+  *low = _mm256_sra_epi32(_mm256_unpacklo_epi16(products_low, products_high),
+                          shift);
+  *high = _mm256_sra_epi32(_mm256_unpackhi_epi16(products_low, products_high),
+                           shift);
+}
+
+// Like the C version, the sum is accumulated in 32 bits and wraps around on
+// overflow. Unsigned arithmetic keeps that well defined.
+int32_t DotProductWithShift32(const int16_t* vector1,
+                              const int16_t* vector2,
+                              size_t length,
+                              int right_shifts) {
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  __m256i sum = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m256i low;
+    __m256i high;
+    MultiplyAndShift(vector1 + i, vector2 + i, shift, &low, &high);
+    sum = _mm256_add_epi32(sum, _mm256_add_epi32(low, high));
+  }
+  __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                 _mm256_extracti128_si256(sum, 1));
+  sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0x4e));
+  sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0xb1));
+  uint32_t result = static_cast<uint32_t>(_mm_cvtsi128_si32(sum128));
+  for (; i < length; ++i) {
+    result += static_cast<uint32_t>((vector1[i] * vector2[i]) >> right_shifts);
+  }
+  return static_cast<int32_t>(result);
+}
+
+}  // namespace
+
+void WebRtcSpl_CrossCorrelationAVX2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  for (size_t i = 0; i < dim_cross_correlation; ++i) {
+    cross_correlation[i] =
+        DotProductWithShift32(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+  // Avoid the penalty of mixing AVX and legacy SSE code in the caller.
+  _mm256_zeroupper();
+}
+
+int32_t WebRtcSpl_DotProductWithScaleAVX2(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling) {
+  // The shifted products need up to 31 bits, they are summed in 64 bits as
+  // in the C version.
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m256i sum = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m256i low;
+    __m256i high;
+    MultiplyAndShift(vector1 + i, vector2 + i, shift, &low, &high);
+    sum = _mm256_add_epi64(
+        sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(low)));
+    sum = _mm256_add_epi64(
+        sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(low, 1)));
+    sum = _mm256_add_epi64(
+        sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(high)));
+    sum = _mm256_add_epi64(
+        sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(high, 1)));
+  }
+  __m128i sum128 = _mm_add_epi64(_mm256_castsi256_si128(sum),
+                                 _mm256_extracti128_si256(sum, 1));
+  sum128 = _mm_add_epi64(sum128, _mm_unpackhi_epi64(sum128, sum128));
+  int64_t result;
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(&result), sum128);
+  _mm256_zeroupper();
+  for (; i < length; ++i) {
+    result += (vector1[i] * vector2[i]) >> scaling;
+  }
+  return rtc::saturated_cast<int32_t>(result);
+}
+
+int64_t WebRtcSpl_SumOfSquaresW16AVX2(const int16_t* vector,
+                                      size_t length,
+                                      int32_t* max_abs) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sum = zero;
+  // The absolute values are compared unsigned, so that the one of -32768,
+  // which is 0x8000, is the largest.
+  __m256i maximum = zero;
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m256i x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vector + i));
+    // Each pair of squares fits in 32 bits unsigned, being at most 2^31.
+    const __m256i squares = _mm256_madd_epi16(x, x);
+    sum = _mm256_add_epi64(sum, _mm256_unpacklo_epi32(squares, zero));
+    sum = _mm256_add_epi64(sum, _mm256_unpackhi_epi32(squares, zero));
+    maximum = _mm256_max_epu16(maximum, _mm256_abs_epi16(x));
+  }
+  __m128i sum128 = _mm_add_epi64(_mm256_castsi256_si128(sum),
+                                 _mm256_extracti128_si256(sum, 1));
+  sum128 = _mm_add_epi64(sum128, _mm_unpackhi_epi64(sum128, sum128));
+  int64_t result;
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(&result), sum128);
+  // The largest value is the smallest one of the bitwise complements.
+  const __m128i maximum128 =
+      _mm_max_epu16(_mm256_castsi256_si128(maximum),
+                    _mm256_extracti128_si256(maximum, 1));
+  int32_t result_max_abs =
+      0xffff & ~_mm_cvtsi128_si32(_mm_minpos_epu16(
+                   _mm_xor_si128(maximum128, _mm_set1_epi16(-1))));
+  _mm256_zeroupper();
+  for (; i < length; ++i) {
+    const int32_t sample = vector[i];
+    result += sample * sample;
+    result_max_abs = std::max(result_max_abs, abs(sample));
+  }
+  if (max_abs) {
+    *max_abs = result_max_abs;
+  }
+  return result;
+}
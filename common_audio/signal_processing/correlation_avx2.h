@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This header file is used only by the x86 versions of
+// WebRtcSpl_CrossCorrelation(), WebRtcSpl_DotProductWithScale() and
+// WebRtcSpl_SumOfSquaresW16(). It defines their AVX2 routines, which are
+// bit-exact with the C versions.
+
+#ifndef COMMON_AUDIO_SIGNAL_PROCESSING_CORRELATION_AVX2_H_
+#define COMMON_AUDIO_SIGNAL_PROCESSING_CORRELATION_AVX2_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Must only be called if the CPU supports AVX2.
+void WebRtcSpl_CrossCorrelationAVX2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2);
+
+// Must only be called if the CPU supports AVX2.
+int32_t WebRtcSpl_DotProductWithScaleAVX2(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling);
+
+// Must only be called if the CPU supports AVX2.
+int64_t WebRtcSpl_SumOfSquaresW16AVX2(const int16_t* vector,
+                                      size_t length,
+                                      int32_t* max_abs);
+
+#endif  // COMMON_AUDIO_SIGNAL_PROCESSING_CORRELATION_AVX2_H_
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/correlation_avx2.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kAVX2, WebRtc_G...
+
+namespace {
+
+CrossCorrelation SelectCrossCorrelation() {
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return &WebRtcSpl_CrossCorrelationAVX2;
+  }
+  return &WebRtcSpl_CrossCorrelationC;
+}
+
+}  // namespace
+
+// x86 version of WebRtcSpl_CrossCorrelation(), picks the routine for the CPU
+// on first use.
+void WebRtcSpl_CrossCorrelationX86(int32_t* cross_correlation,
+                                   const int16_t* seq1,
+                                   const int16_t* seq2,
+                                   size_t dim_seq,
+                                   size_t dim_cross_correlation,
+                                   int right_shifts,
+                                   int step_seq2) {
+  static const CrossCorrelation cross_correlation_function =
+      SelectCrossCorrelation();
+  cross_correlation_function(cross_correlation, seq1, seq2, dim_seq,
+                             dim_cross_correlation, right_shifts, step_seq2);
+}
@@ -11,11 +11,44 @@
 #include "common_audio/signal_processing/dot_product_with_scale.h"
 
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "common_audio/signal_processing/correlation_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kAVX2, WebRtc_G...
+#endif
+
+namespace {
+
+using DotProductWithScaleFunction = int32_t (*)(const int16_t*,
+                                                const int16_t*,
+                                                size_t,
+                                                int);
+
+DotProductWithScaleFunction SelectDotProductWithScale() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return &WebRtcSpl_DotProductWithScaleAVX2;
+  }
+#endif
+  return &WebRtcSpl_DotProductWithScaleC;
+}
+
+}  // namespace
 
 int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
                                       const int16_t* vector2,
                                       size_t length,
                                       int scaling) {
+  static const DotProductWithScaleFunction dot_product_with_scale =
+      SelectDotProductWithScale();
+  return dot_product_with_scale(vector1, vector2, length, scaling);
+}
+
+int32_t WebRtcSpl_DotProductWithScaleC(const int16_t* vector1,
+                                       const int16_t* vector2,
+                                       size_t length,
+                                       int scaling) {
   int64_t sum = 0;
   size_t i = 0;
 
@@ -17,23 +17,40 @@
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 
+#include "common_audio/signal_processing/dot_product_with_scale.h"
+#include "common_audio/signal_processing/sum_of_squares.h"
+
 int32_t WebRtcSpl_Energy(int16_t* vector,
                          size_t vector_length,
                          int* scale_factor)
 {
-    int32_t en = 0;
-    size_t i;
-    int scaling =
-        WebRtcSpl_GetScalingSquare(vector, vector_length, vector_length);
-    size_t looptimes = vector_length;
-    int16_t *vectorptr = vector;
+    int32_t max_abs = 0;
+    int64_t sum =
+        WebRtcSpl_SumOfSquaresW16(vector, vector_length, &max_abs);
+    int scaling = 0;
 
-    for (i = 0; i < looptimes; i++)
+    if (max_abs > WEBRTC_SPL_WORD16_MAX)
+    {
+      // WebRtcSpl_GetScalingSquare() doesn't see -32768 as the largest
+      // value; let it pick the scaling it always has.
+      scaling = WebRtcSpl_GetScalingSquare(vector, vector_length,
+                                           vector_length);
+    } else if (max_abs > 0)
     {
-      en += (*vectorptr * *vectorptr) >> scaling;
-      vectorptr++;
+      // Same as WebRtcSpl_GetScalingSquare(), from the maximum found above.
+      int16_t nbits = WebRtcSpl_GetSizeInBits((uint32_t)vector_length);
+      int16_t t = WebRtcSpl_NormW32(max_abs * max_abs);
+      scaling = (t > nbits) ? 0 : nbits - t;
     }
     *scale_factor = scaling;
 
-    return en;
+    if (scaling == 0)
+    {
+      // The scaling keeps the sum within 31 bits, so this is the sum of the
+      // unscaled squares, needing no second pass.
+      return (int32_t)sum;
+    }
+    // Each square is scaled before it is summed.
+    return WebRtcSpl_DotProductWithScale(vector, vector, vector_length,
+                                         scaling);
 }
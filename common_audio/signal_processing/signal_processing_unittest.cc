@@ -9,11 +9,20 @@
  */
 
 #include <algorithm>
+#include <vector>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/sum_of_squares.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/system/arch.h"
 #include "test/gtest.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "common_audio/signal_processing/correlation_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
 static const size_t kVector16Size = 9;
 static const int16_t vector16[kVector16Size] = {1,
                                                 -15511,
@@ -471,6 +480,51 @@ TEST(SplTest, DotProductWithScaleTest) {
                                                      kVector16Size, 2));
 }
 
+TEST(SplTest, SumOfSquaresTest) {
+  int32_t max_abs = 0;
+  EXPECT_EQ(2421451192,
+            WebRtcSpl_SumOfSquaresW16(vector16, kVector16Size, &max_abs));
+  EXPECT_EQ(WEBRTC_SPL_WORD16_MAX, max_abs);
+  EXPECT_EQ(0, WebRtcSpl_SumOfSquaresW16(vector16, 0, &max_abs));
+  EXPECT_EQ(0, max_abs);
+
+  // Unlike WebRtcSpl_MaxAbsValueW16(), the absolute value of the most
+  // negative value is not saturated.
+  const int16_t kMostNegative[] = {7, WEBRTC_SPL_WORD16_MIN, -2};
+  EXPECT_EQ(1073741877, WebRtcSpl_SumOfSquaresW16(kMostNegative, 3, &max_abs));
+  EXPECT_EQ(32768, max_abs);
+  EXPECT_EQ(1073741877, WebRtcSpl_SumOfSquaresW16(kMostNegative, 3, nullptr));
+}
+
+TEST(SplTest, EnergyMatchesScaledSumOfSquares) {
+  webrtc::Random random(42);
+  // The lengths of the VAD filter bank, see WebRtcVad_CalculateFeatures().
+  for (size_t length : {5, 10, 15, 20, 30, 40, 60}) {
+    for (int16_t amplitude : {0, 100, 3000, WEBRTC_SPL_WORD16_MAX}) {
+      for (bool most_negative : {false, true}) {
+        std::vector<int16_t> vector(length);
+        for (int16_t& sample : vector) {
+          sample = static_cast<int16_t>(random.Rand(-amplitude, amplitude));
+        }
+        if (most_negative) {
+          vector[length / 2] = WEBRTC_SPL_WORD16_MIN;
+        }
+        const int expected_scaling =
+            WebRtcSpl_GetScalingSquare(vector.data(), length, length);
+        int32_t expected_energy = 0;
+        for (int16_t sample : vector) {
+          expected_energy += (sample * sample) >> expected_scaling;
+        }
+        int scaling = -1;
+        EXPECT_EQ(expected_energy,
+                  WebRtcSpl_Energy(vector.data(), length, &scaling))
+            << "length " << length << " amplitude " << amplitude;
+        EXPECT_EQ(expected_scaling, scaling);
+      }
+    }
+  }
+}
+
 TEST(SplTest, CrossCorrelationTest) {
   // Note the function arguments relation specificed by API.
   const size_t kCrossCorrelationDimension = 3;
@@ -491,18 +545,115 @@ TEST(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
-    expected = kExpectedNeon;
-  }
+  expected = kExpectedNeon;
 #endif
   for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
     EXPECT_EQ(expected[i], vector32[i]);
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Full scale noise, with runs of the most negative value, whose square needs
+// 31 bits.
+std::vector<int16_t> CreateTestSignal(size_t length, webrtc::Random* random) {
+  std::vector<int16_t> signal(length);
+  for (size_t i = 0; i < length; ++i) {
+    signal[i] = (i / 64) % 4 == 3 ? WEBRTC_SPL_WORD16_MIN
+                                  : static_cast<int16_t>(random->Rand(
+                                        WEBRTC_SPL_WORD16_MIN,
+                                        WEBRTC_SPL_WORD16_MAX));
+  }
+  return signal;
+}
+
+TEST(SplTest, CrossCorrelationAVX2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kAVX2) == 0) {
+    return;
+  }
+  webrtc::Random random(42);
+  const size_t kMaxCrossCorrelationDimension = 20;
+  std::vector<int16_t> seq1 = CreateTestSignal(512, &random);
+  std::vector<int16_t> seq2 = CreateTestSignal(
+      512 + 2 * kMaxCrossCorrelationDimension, &random);
+  for (size_t dim_seq : {0, 1, 15, 16, 17, 60, 120, 256, 512}) {
+    for (int right_shifts : {0, 1, 3, 8, 10}) {
+      // Callers pick the shift so that the 32 bit sums do not overflow.
+      if ((static_cast<int64_t>(dim_seq) << 30) >> right_shifts >
+          WEBRTC_SPL_WORD32_MAX) {
+        continue;
+      }
+      for (int step : {-1, 1, 2}) {
+        // Negative steps slide backwards from the end of |seq2|.
+        const int16_t* seq2_start =
+            step > 0 ? seq2.data()
+                     : seq2.data() + 2 * kMaxCrossCorrelationDimension;
+        int32_t expected[kMaxCrossCorrelationDimension];
+        int32_t result[kMaxCrossCorrelationDimension];
+        WebRtcSpl_CrossCorrelationC(expected, seq1.data(), seq2_start, dim_seq,
+                                    kMaxCrossCorrelationDimension,
+                                    right_shifts, step);
+        WebRtcSpl_CrossCorrelationAVX2(result, seq1.data(), seq2_start,
+                                       dim_seq, kMaxCrossCorrelationDimension,
+                                       right_shifts, step);
+        for (size_t i = 0; i < kMaxCrossCorrelationDimension; ++i) {
+          EXPECT_EQ(expected[i], result[i])
+              << "dim_seq " << dim_seq << " right_shifts " << right_shifts
+              << " step " << step << " index " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(SplTest, DotProductWithScaleAVX2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kAVX2) == 0) {
+    return;
+  }
+  webrtc::Random random(42);
+  std::vector<int16_t> vector1 = CreateTestSignal(4100, &random);
+  std::vector<int16_t> vector2 = CreateTestSignal(4100, &random);
+  for (size_t length : {0, 1, 15, 16, 17, 60, 120, 256, 4100}) {
+    for (int scaling : {0, 1, 3, 8}) {
+      // Also the saturation when the square is larger than 32 bits.
+      EXPECT_EQ(WebRtcSpl_DotProductWithScaleC(vector1.data(), vector1.data(),
+                                               length, scaling),
+                WebRtcSpl_DotProductWithScaleAVX2(
+                    vector1.data(), vector1.data(), length, scaling))
+          << "length " << length << " scaling " << scaling;
+      EXPECT_EQ(WebRtcSpl_DotProductWithScaleC(vector1.data(), vector2.data(),
+                                               length, scaling),
+                WebRtcSpl_DotProductWithScaleAVX2(
+                    vector1.data(), vector2.data(), length, scaling))
+          << "length " << length << " scaling " << scaling;
+    }
+  }
+}
+
+TEST(SplTest, SumOfSquaresAVX2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kAVX2) == 0) {
+    return;
+  }
+  webrtc::Random random(42);
+  std::vector<int16_t> vector = CreateTestSignal(4100, &random);
+  for (size_t offset : {0, 3, 200}) {
+    for (size_t length : {0, 1, 15, 16, 17, 60, 120, 256, 3800}) {
+      int32_t expected_max_abs = -1;
+      int32_t max_abs = -1;
+      EXPECT_EQ(WebRtcSpl_SumOfSquaresW16C(vector.data() + offset, length,
+                                           &expected_max_abs),
+                WebRtcSpl_SumOfSquaresW16AVX2(vector.data() + offset, length,
+                                              &max_abs))
+          << "offset " << offset << " length " << length;
+      EXPECT_EQ(expected_max_abs, max_abs)
+          << "offset " << offset << " length " << length;
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
 TEST(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
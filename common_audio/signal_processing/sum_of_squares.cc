@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/sum_of_squares.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "common_audio/signal_processing/correlation_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kAVX2, WebRtc_G...
+#endif
+
+namespace {
+
+using SumOfSquaresFunction = int64_t (*)(const int16_t*, size_t, int32_t*);
+
+SumOfSquaresFunction SelectSumOfSquares() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return &WebRtcSpl_SumOfSquaresW16AVX2;
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  return &WebRtcSpl_SumOfSquaresW16Neon;
+#endif
+  return &WebRtcSpl_SumOfSquaresW16C;
+}
+
+}  // namespace
+
+int64_t WebRtcSpl_SumOfSquaresW16(const int16_t* vector,
+                                  size_t length,
+                                  int32_t* max_abs) {
+  static const SumOfSquaresFunction sum_of_squares = SelectSumOfSquares();
+  return sum_of_squares(vector, length, max_abs);
+}
+
+int64_t WebRtcSpl_SumOfSquaresW16C(const int16_t* vector,
+                                   size_t length,
+                                   int32_t* max_abs) {
+  int64_t sum = 0;
+  int32_t maximum = 0;
+  for (size_t i = 0; i < length; ++i) {
+    const int32_t sample = vector[i];
+    sum += sample * sample;
+    maximum = std::max(maximum, abs(sample));
+  }
+  if (max_abs) {
+    *max_abs = maximum;
+  }
+  return sum;
+}
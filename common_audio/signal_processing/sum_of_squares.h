@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_SIGNAL_PROCESSING_SUM_OF_SQUARES_H_
+#define COMMON_AUDIO_SIGNAL_PROCESSING_SUM_OF_SQUARES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Calculates the exact sum of the squares of an (int16_t) vector and, in the
+// same pass, its largest absolute value, which gives both the level of the
+// vector and the scaling needed to compute its energy in 32 bits.
+//
+// Input:
+//      - vector        : Input vector
+//      - length        : Number of samples in the vector
+//
+// Output:
+//      - max_abs       : The largest absolute value of |vector|, 32768 if it
+//                        contains -32768, 0 if it is empty. May be null.
+//
+// Return value         : The sum of the squares of |vector|
+int64_t WebRtcSpl_SumOfSquaresW16(const int16_t* vector,
+                                  size_t length,
+                                  int32_t* max_abs);
+// The generic version, also used where no SIMD version is available.
+int64_t WebRtcSpl_SumOfSquaresW16C(const int16_t* vector,
+                                   size_t length,
+                                   int32_t* max_abs);
+#if defined(WEBRTC_HAS_NEON)
+int64_t WebRtcSpl_SumOfSquaresW16Neon(const int16_t* vector,
+                                      size_t length,
+                                      int32_t* max_abs);
+#endif
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+#endif  // COMMON_AUDIO_SIGNAL_PROCESSING_SUM_OF_SQUARES_H_
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/sum_of_squares.h"
+
+#include <arm_neon.h>
+#include <stdlib.h>
+
+int64_t WebRtcSpl_SumOfSquaresW16Neon(const int16_t* vector,
+                                      size_t length,
+                                      int32_t* max_abs) {
+  size_t i = 0;
+  int64x2_t sum0 = vdupq_n_s64(0);
+  int64x2_t sum1 = vdupq_n_s64(0);
+  // The absolute values are compared unsigned, so that the one of -32768,
+  // which is 0x8000, is the largest.
+  uint16x8_t maximum = vdupq_n_u16(0);
+  int64_t sum = 0;
+  int32_t result_max_abs = 0;
+
+  for (; i + 8 <= length; i += 8) {
+    int16x8_t x = vld1q_s16(&vector[i]);
+    int32x4_t squares0 = vmull_s16(vget_low_s16(x), vget_low_s16(x));
+    int32x4_t squares1 = vmull_s16(vget_high_s16(x), vget_high_s16(x));
+    sum0 = vpadalq_s32(sum0, squares0);
+    sum1 = vpadalq_s32(sum1, squares1);
+    maximum = vmaxq_u16(maximum, vreinterpretq_u16_s16(vabsq_s16(x)));
+  }
+
+  sum0 = vaddq_s64(sum0, sum1);
+  sum = vgetq_lane_s64(sum0, 0) + vgetq_lane_s64(sum0, 1);
+  {
+    uint16x4_t maximum4 = vmax_u16(vget_low_u16(maximum),
+                                   vget_high_u16(maximum));
+    maximum4 = vpmax_u16(maximum4, maximum4);
+    maximum4 = vpmax_u16(maximum4, maximum4);
+    result_max_abs = vget_lane_u16(maximum4, 0);
+  }
+
+  for (; i < length; i++) {
+    int32_t sample = vector[i];
+    int32_t sample_abs = abs(sample);
+    sum += sample * sample;
+    if (sample_abs > result_max_abs) {
+      result_max_abs = sample_abs;
+    }
+  }
+  if (max_abs) {
+    *max_abs = result_max_abs;
+  }
+  return sum;
+}
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+EncodedImageBufferPool::PooledBuffer::PooledBuffer(size_t size)
+    : EncodedImageBuffer(size), capacity_(size) {}
+
+EncodedImageBufferPool::PooledBuffer::~PooledBuffer() = default;
+
+void EncodedImageBufferPool::PooledBuffer::SetSize(size_t size) {
+  if (size > capacity_) {
+    // The old contents are not needed, but realloc is still cheaper than
+    // another allocation when it can grow in place.
+    Realloc(size);
+    capacity_ = size;
+  }
+  size_ = size;
+}
+
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_number_of_buffers)
+    : max_number_of_buffers_(max_number_of_buffers) {}
+
+EncodedImageBufferPool::~EncodedImageBufferPool() = default;
+
+rtc::scoped_refptr<EncodedImageBuffer> EncodedImageBufferPool::CreateBuffer(
+    size_t size) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  // Realloc() requires a size, empty frames are not worth pooling anyway.
+  if (size == 0)
+    return EncodedImageBuffer::Create(0);
+
+  // If the buffer is in use, the ref count will be >= 2, one from the list
+  // and one from the application. Prefer a free buffer that is large enough.
+  PooledEncodedImageBuffer* free_buffer = nullptr;
+  for (const rtc::scoped_refptr<PooledEncodedImageBuffer>& buffer : buffers_) {
+    if (!buffer->HasOneRef())
+      continue;
+    if (buffer->capacity() >= size) {
+      free_buffer = buffer.get();
+      break;
+    }
+    if (!free_buffer)
+      free_buffer = buffer.get();
+  }
+  if (free_buffer) {
+    free_buffer->SetSize(size);
+    return free_buffer;
+  }
+
+  rtc::scoped_refptr<PooledEncodedImageBuffer> buffer =
+      new PooledEncodedImageBuffer(size);
+  if (buffers_.size() < max_number_of_buffers_)
+    buffers_.push_back(buffer);
+  return buffer;
+}
+
+}  // namespace webrtc
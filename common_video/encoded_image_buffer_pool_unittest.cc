@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <stdint.h>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(TestEncodedImageBufferPool, ReusesReleasedBuffer) {
+  EncodedImageBufferPool pool(4);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(1000);
+  EXPECT_EQ(1000u, buffer->size());
+  const uint8_t* data = buffer->data();
+  buffer = nullptr;
+  // A smaller frame fits into the released buffer.
+  buffer = pool.CreateBuffer(500);
+  EXPECT_EQ(500u, buffer->size());
+  EXPECT_EQ(data, buffer->data());
+}
+
+TEST(TestEncodedImageBufferPool, DoesNotReuseBufferInUse) {
+  EncodedImageBufferPool pool(4);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer1 = pool.CreateBuffer(100);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer2 = pool.CreateBuffer(100);
+  EXPECT_NE(buffer1->data(), buffer2->data());
+}
+
+TEST(TestEncodedImageBufferPool, PrefersFreeBufferThatIsLargeEnough) {
+  EncodedImageBufferPool pool(4);
+  rtc::scoped_refptr<EncodedImageBuffer> small = pool.CreateBuffer(100);
+  rtc::scoped_refptr<EncodedImageBuffer> large = pool.CreateBuffer(1000);
+  const uint8_t* large_data = large->data();
+  small = nullptr;
+  large = nullptr;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(800);
+  EXPECT_EQ(800u, buffer->size());
+  EXPECT_EQ(large_data, buffer->data());
+}
+
+TEST(TestEncodedImageBufferPool, GrowsFreeBuffer) {
+  EncodedImageBufferPool pool(1);
+  pool.CreateBuffer(10);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(100000);
+  EXPECT_EQ(100000u, buffer->size());
+  buffer->data()[99999] = 1;
+}
+
+TEST(TestEncodedImageBufferPool, CreatesUnpooledBuffersWhenFull) {
+  EncodedImageBufferPool pool(1);
+  rtc::scoped_refptr<EncodedImageBuffer> pooled = pool.CreateBuffer(100);
+  rtc::scoped_refptr<EncodedImageBuffer> unpooled = pool.CreateBuffer(100);
+  ASSERT_TRUE(unpooled);
+  const uint8_t* pooled_data = pooled->data();
+  pooled = nullptr;
+  unpooled = nullptr;
+  EXPECT_EQ(pooled_data, pool.CreateBuffer(100)->data());
+}
+
+TEST(TestEncodedImageBufferPool, CreatesEmptyBuffer) {
+  EncodedImageBufferPool pool(1);
+  EXPECT_EQ(0u, pool.CreateBuffer(0)->size());
+}
+
+}  // namespace webrtc
@@ -12,17 +12,63 @@
 
 #include <cstdint>
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
 namespace H264 {
 
+namespace {
+
+// Returns the index of the first two zero bytes of |data| from |begin|, or
+// |size| if there are none. Once emulation prevention is applied, the zero
+// pairs only start the start sequences and the emulation sequences, so the
+// search checks 16 bytes at a time and only the blocks containing one are
+// looked at byte by byte.
+size_t FindZeroPair(const uint8_t* data, size_t begin, size_t size) {
+  size_t i = begin;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 17 <= size; i += 16) {
+    const __m128i first = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(data + i));
+    const __m128i second = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(data + i + 1));
+    if (_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, zero),
+                                        _mm_cmpeq_epi8(second, zero)))) {
+      break;
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  for (; i + 17 <= size; i += 16) {
+    const uint8x16_t pairs =
+        vandq_u8(vceqq_u8(vld1q_u8(data + i), vdupq_n_u8(0)),
+                 vceqq_u8(vld1q_u8(data + i + 1), vdupq_n_u8(0)));
+    const uint64x2_t pairs64 = vreinterpretq_u64_u8(pairs);
+    if (vgetq_lane_u64(pairs64, 0) | vgetq_lane_u64(pairs64, 1))
+      break;
+  }
+#endif
+  for (; i + 1 < size; ++i) {
+    if (data[i] == 0 && data[i + 1] == 0)
+      return i;
+  }
+  return size;
+}
+
+}  // namespace
+
 const uint8_t kNaluTypeMask = 0x1F;
 
 std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
                                        size_t buffer_size) {
-  // This is sorta like Boyer-Moore, but with only the first optimization step:
-  // given a 3-byte sequence we're looking at, if the 3rd byte isn't 1 or 0,
-  // skip ahead to the next 3-byte sequence. 0s and 1s are relatively rare, so
-  // this will skip the majority of reads/checks.
   std::vector<NaluIndex> sequences;
   if (buffer_size < kNaluShortStartSequenceSize)
     return sequences;
@@ -30,28 +76,24 @@ std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
   static_assert(kNaluShortStartSequenceSize >= 2,
                 "kNaluShortStartSequenceSize must be larger or equals to 2");
   const size_t end = buffer_size - kNaluShortStartSequenceSize;
-  for (size_t i = 0; i < end;) {
-    if (buffer[i + 2] > 1) {
-      i += 3;
-    } else if (buffer[i + 2] == 1) {
-      if (buffer[i + 1] == 0 && buffer[i] == 0) {
-        // We found a start sequence, now check if it was a 3 of 4 byte one.
-        NaluIndex index = {i, i + 3, 0};
-        if (index.start_offset > 0 && buffer[index.start_offset - 1] == 0)
-          --index.start_offset;
-
-        // Update length of previous entry.
-        auto it = sequences.rbegin();
-        if (it != sequences.rend())
-          it->payload_size = index.start_offset - it->payload_start_offset;
-
-        sequences.push_back(index);
-      }
-
-      i += 3;
-    } else {
+  for (size_t i = FindZeroPair(buffer, 0, buffer_size); i < end;
+       i = FindZeroPair(buffer, i, buffer_size)) {
+    if (buffer[i + 2] != 1) {
       ++i;
+      continue;
     }
+    // We found a start sequence, now check if it was a 3 of 4 byte one.
+    NaluIndex index = {i, i + 3, 0};
+    if (index.start_offset > 0 && buffer[index.start_offset - 1] == 0)
+      --index.start_offset;
+
+    // Update length of previous entry.
+    auto it = sequences.rbegin();
+    if (it != sequences.rend())
+      it->payload_size = index.start_offset - it->payload_start_offset;
+
+    sequences.push_back(index);
+    i += 3;
   }
 
   // Update length of last entry, if any.
@@ -70,46 +112,43 @@ std::vector<uint8_t> ParseRbsp(const uint8_t* data, size_t length) {
   std::vector<uint8_t> out;
   out.reserve(length);
 
-  for (size_t i = 0; i < length;) {
-    // Be careful about over/underflow here. byte_length_ - 3 can underflow, and
-    // i + 3 can overflow, but byte_length_ - i can't, because i < byte_length_
-    // above, and that expression will produce the number of bytes left in
-    // the stream including the byte at i.
-    if (length - i >= 3 && !data[i] && !data[i + 1] && data[i + 2] == 3) {
-      // Two rbsp bytes.
-      out.push_back(data[i++]);
-      out.push_back(data[i++]);
-      // Skip the emulation byte.
-      i++;
+  // The bytes from |copied| are not in |out| yet.
+  size_t copied = 0;
+  for (size_t i = FindZeroPair(data, 0, length); i < length;
+       i = FindZeroPair(data, i, length)) {
+    if (i + 2 < length && data[i + 2] == 3) {
+      // Copy up to the two rbsp bytes and skip the emulation byte.
+      out.insert(out.end(), data + copied, data + i + 2);
+      copied = i + 3;
+      i += 3;
     } else {
-      // Single rbsp byte.
-      out.push_back(data[i++]);
+      ++i;
     }
   }
+  out.insert(out.end(), data + copied, data + length);
   return out;
 }
 
 void WriteRbsp(const uint8_t* bytes, size_t length, rtc::Buffer* destination) {
-  static const uint8_t kZerosInStartSequence = 2;
   static const uint8_t kEmulationByte = 0x03u;
-  size_t num_consecutive_zeros = 0;
   destination->EnsureCapacity(destination->size() + length);
 
-  for (size_t i = 0; i < length; ++i) {
-    uint8_t byte = bytes[i];
-    if (byte <= kEmulationByte &&
-        num_consecutive_zeros >= kZerosInStartSequence) {
-      // Need to escape.
+  // The bytes from |copied| are not in |destination| yet.
+  size_t copied = 0;
+  for (size_t i = FindZeroPair(bytes, 0, length); i + 2 < length;
+       i = FindZeroPair(bytes, i, length)) {
+    if (bytes[i + 2] <= kEmulationByte) {
+      // Need to escape. The zeros are counted again from the escaped byte.
+      destination->AppendData(bytes + copied, i + 2 - copied);
       destination->AppendData(kEmulationByte);
-      num_consecutive_zeros = 0;
-    }
-    destination->AppendData(byte);
-    if (byte == 0) {
-      ++num_consecutive_zeros;
+      copied = i + 2;
+      i += 2;
     } else {
-      num_consecutive_zeros = 0;
+      // No zero pair starts before the byte after the nonzero one.
+      i += 3;
     }
   }
+  destination->AppendData(bytes + copied, length - copied);
 }
 
 }  // namespace H264
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "common_video/h264/h264_common.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace H264 {
+namespace {
+
+constexpr int kRounds = 200;
+// A 1080p keyframe at a few Mbps, split in slices.
+constexpr size_t kNumSlices = 8;
+constexpr size_t kSliceSize = 25000;
+
+// The slice payloads, with emulation prevention and without start sequences.
+std::vector<rtc::Buffer> CreateSlices() {
+  Random random(4711);
+  std::vector<rtc::Buffer> slices(kNumSlices);
+  for (rtc::Buffer& slice : slices) {
+    // Entropy coded, so mostly random with the zero runs of the skipped
+    // macroblocks.
+    std::vector<uint8_t> rbsp(kSliceSize);
+    for (uint8_t& byte : rbsp)
+      byte = random.Rand(15) == 0 ? 0 : random.Rand<uint8_t>();
+    // The stop bit.
+    rbsp.back() = 0x80;
+    slice.AppendData(uint8_t{0x65});
+    WriteRbsp(rbsp.data(), rbsp.size(), &slice);
+  }
+  return slices;
+}
+
+// Returns an access unit made of an SPS, a PPS and the |slices|.
+rtc::Buffer CreateKeyFrame(const std::vector<rtc::Buffer>& slices) {
+  const uint8_t kStartSequence[] = {0, 0, 0, 1};
+  const uint8_t kSps[] = {0x67, 0x64, 0x00, 0x28, 0xac, 0xd9,
+                          0x40, 0x78, 0x02, 0x27, 0xe5, 0x84};
+  const uint8_t kPps[] = {0x68, 0xeb, 0xe3, 0xcb, 0x22, 0xc0};
+  rtc::Buffer frame;
+  frame.AppendData(kStartSequence);
+  frame.AppendData(kSps);
+  frame.AppendData(kStartSequence);
+  frame.AppendData(kPps);
+  for (const rtc::Buffer& slice : slices) {
+    frame.AppendData(kStartSequence);
+    frame.AppendData(slice);
+  }
+  return frame;
+}
+
+double ElapsedUsPerRound(int64_t start_ns) {
+  return static_cast<double>(rtc::TimeNanos() - start_ns) /
+         (kRounds * rtc::kNumNanosecsPerMicrosec);
+}
+
+TEST(H264CommonPerformanceTest, FindNaluIndicesInKeyFrame) {
+  const rtc::Buffer frame = CreateKeyFrame(CreateSlices());
+  size_t num_nalus = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int round = 0; round < kRounds; ++round)
+    num_nalus += FindNaluIndices(frame.data(), frame.size()).size();
+  const double elapsed_us = ElapsedUsPerRound(start_ns);
+  EXPECT_EQ((kNumSlices + 2) * kRounds, num_nalus);
+  test::PrintResult("h264_find_nalu_indices_time", "", "1080p_keyframe",
+                    elapsed_us, "us", false);
+}
+
+TEST(H264CommonPerformanceTest, ParseRbspOfKeyFrameSlices) {
+  const std::vector<rtc::Buffer> slices = CreateSlices();
+  size_t rbsp_size = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int round = 0; round < kRounds; ++round) {
+    for (const rtc::Buffer& slice : slices)
+      rbsp_size += ParseRbsp(slice.data(), slice.size()).size();
+  }
+  const double elapsed_us = ElapsedUsPerRound(start_ns);
+  EXPECT_EQ(kNumSlices * (kSliceSize + 1) * kRounds, rbsp_size);
+  test::PrintResult("h264_parse_rbsp_time", "", "1080p_keyframe", elapsed_us,
+                    "us", false);
+}
+
+TEST(H264CommonPerformanceTest, WriteRbspOfKeyFrameSlices) {
+  const std::vector<rtc::Buffer> slices = CreateSlices();
+  std::vector<std::vector<uint8_t>> rbsps;
+  for (const rtc::Buffer& slice : slices)
+    rbsps.push_back(ParseRbsp(slice.data(), slice.size()));
+  rtc::Buffer destination;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int round = 0; round < kRounds; ++round) {
+    for (const std::vector<uint8_t>& rbsp : rbsps) {
+      destination.Clear();
+      WriteRbsp(rbsp.data(), rbsp.size(), &destination);
+    }
+  }
+  const double elapsed_us = ElapsedUsPerRound(start_ns);
+  EXPECT_EQ(slices.back(), destination);
+  test::PrintResult("h264_write_rbsp_time", "", "1080p_keyframe", elapsed_us,
+                    "us", false);
+}
+
+}  // namespace
+}  // namespace H264
+}  // namespace webrtc
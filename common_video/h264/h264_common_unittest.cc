@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/h264_common.h"
+
+#include <vector>
+
+#include "rtc_base/buffer.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace H264 {
+namespace {
+
+// The byte by byte implementations the vectorized ones must match.
+std::vector<NaluIndex> ReferenceFindNaluIndices(const uint8_t* buffer,
+                                                size_t buffer_size) {
+  std::vector<NaluIndex> sequences;
+  if (buffer_size < kNaluShortStartSequenceSize)
+    return sequences;
+  for (size_t i = 0; i + kNaluShortStartSequenceSize < buffer_size; ++i) {
+    if (buffer[i] != 0 || buffer[i + 1] != 0 || buffer[i + 2] != 1)
+      continue;
+    NaluIndex index = {i, i + 3, 0};
+    if (i > 0 && buffer[i - 1] == 0)
+      --index.start_offset;
+    if (!sequences.empty()) {
+      sequences.back().payload_size =
+          index.start_offset - sequences.back().payload_start_offset;
+    }
+    sequences.push_back(index);
+  }
+  if (!sequences.empty())
+    sequences.back().payload_size =
+        buffer_size - sequences.back().payload_start_offset;
+  return sequences;
+}
+
+std::vector<uint8_t> ReferenceParseRbsp(const uint8_t* data, size_t length) {
+  std::vector<uint8_t> out;
+  for (size_t i = 0; i < length;) {
+    if (length - i >= 3 && !data[i] && !data[i + 1] && data[i + 2] == 3) {
+      out.push_back(data[i++]);
+      out.push_back(data[i++]);
+      i++;
+    } else {
+      out.push_back(data[i++]);
+    }
+  }
+  return out;
+}
+
+std::vector<uint8_t> ReferenceWriteRbsp(const uint8_t* bytes, size_t length) {
+  std::vector<uint8_t> out;
+  size_t num_consecutive_zeros = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (bytes[i] <= 3 && num_consecutive_zeros >= 2) {
+      out.push_back(3);
+      num_consecutive_zeros = 0;
+    }
+    out.push_back(bytes[i]);
+    num_consecutive_zeros = bytes[i] == 0 ? num_consecutive_zeros + 1 : 0;
+  }
+  return out;
+}
+
+// Returns |size| bytes made mostly of zeros, ones and threes, so that the
+// start and emulation sequences are frequent and cross the 16 byte blocks.
+std::vector<uint8_t> CreateData(Random* random, size_t size) {
+  static const uint8_t kBytes[] = {0, 0, 0, 1, 2, 3, 4, 0x80};
+  std::vector<uint8_t> data(size);
+  for (uint8_t& byte : data)
+    byte = kBytes[random->Rand(7)];
+  return data;
+}
+
+void ExpectSameIndices(const std::vector<NaluIndex>& expected,
+                       const std::vector<NaluIndex>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].start_offset, actual[i].start_offset);
+    EXPECT_EQ(expected[i].payload_start_offset,
+              actual[i].payload_start_offset);
+    EXPECT_EQ(expected[i].payload_size, actual[i].payload_size);
+  }
+}
+
+TEST(H264CommonTest, FindsShortAndLongStartSequences) {
+  const uint8_t kBuffer[] = {0, 0, 0, 1, 0x67, 0x42, 0,    0,    1, 0x68,
+                             0, 0, 3, 1, 0x80, 0,    0,    0,    0, 1,
+                             5, 1, 2, 3, 4,    5,    6,    7,    8, 9};
+  std::vector<NaluIndex> indices =
+      FindNaluIndices(kBuffer, sizeof(kBuffer));
+  ASSERT_EQ(3u, indices.size());
+  EXPECT_EQ(0u, indices[0].start_offset);
+  EXPECT_EQ(4u, indices[0].payload_start_offset);
+  EXPECT_EQ(2u, indices[0].payload_size);
+  EXPECT_EQ(6u, indices[1].start_offset);
+  EXPECT_EQ(9u, indices[1].payload_start_offset);
+  EXPECT_EQ(7u, indices[1].payload_size);
+  EXPECT_EQ(16u, indices[2].start_offset);
+  EXPECT_EQ(20u, indices[2].payload_start_offset);
+  EXPECT_EQ(10u, indices[2].payload_size);
+}
+
+TEST(H264CommonTest, IgnoresStartSequenceEndingTheBuffer) {
+  const uint8_t kBuffer[] = {0x65, 0x80, 0, 0, 1};
+  EXPECT_TRUE(FindNaluIndices(kBuffer, sizeof(kBuffer)).empty());
+}
+
+TEST(H264CommonTest, FindNaluIndicesMatchesByteByByteSearch) {
+  Random random(1234);
+  for (size_t size = 0; size < 200; ++size) {
+    std::vector<uint8_t> data = CreateData(&random, size);
+    ExpectSameIndices(ReferenceFindNaluIndices(data.data(), data.size()),
+                      FindNaluIndices(data.data(), data.size()));
+  }
+}
+
+TEST(H264CommonTest, ParseRbspMatchesByteByByteParsing) {
+  Random random(1234);
+  for (size_t size = 0; size < 200; ++size) {
+    std::vector<uint8_t> data = CreateData(&random, size);
+    EXPECT_EQ(ReferenceParseRbsp(data.data(), data.size()),
+              ParseRbsp(data.data(), data.size()));
+  }
+}
+
+TEST(H264CommonTest, WriteRbspMatchesByteByByteWriting) {
+  Random random(1234);
+  for (size_t size = 0; size < 200; ++size) {
+    std::vector<uint8_t> data = CreateData(&random, size);
+    std::vector<uint8_t> expected =
+        ReferenceWriteRbsp(data.data(), data.size());
+    rtc::Buffer written;
+    WriteRbsp(data.data(), data.size(), &written);
+    EXPECT_EQ(expected,
+              std::vector<uint8_t>(written.data(),
+                                   written.data() + written.size()));
+    EXPECT_EQ(data, ParseRbsp(written.data(), written.size()));
+  }
+}
+
+TEST(H264CommonTest, WriteRbspAppendsToDestination) {
+  const uint8_t kBytes[] = {0, 0, 1, 0x80};
+  rtc::Buffer destination;
+  destination.AppendData(uint8_t{0x42});
+  WriteRbsp(kBytes, sizeof(kBytes), &destination);
+  const uint8_t kExpected[] = {0x42, 0, 0, 3, 1, 0x80};
+  EXPECT_EQ(rtc::Buffer(kExpected), destination);
+}
+
+}  // namespace
+}  // namespace H264
+}  // namespace webrtc
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <list>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+// Buffer pool to avoid allocating a new EncodedImageBuffer for every received
+// frame. Works like I420BufferPool: once the last reference to a buffer
+// returned by CreateBuffer() is released, the buffer is reused by later calls.
+// Buffers keep their largest size, so that frames of varying sizes don't
+// reallocate them.
+class EncodedImageBufferPool {
+ public:
+  explicit EncodedImageBufferPool(size_t max_number_of_buffers);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer of |size| bytes with undefined contents. It is taken from
+  // the pool if one is free, otherwise a new buffer is created, which is kept
+  // in the pool unless it holds |max_number_of_buffers| already. Never returns
+  // null.
+  rtc::scoped_refptr<EncodedImageBuffer> CreateBuffer(size_t size);
+
+ private:
+  class PooledBuffer : public EncodedImageBuffer {
+   public:
+    explicit PooledBuffer(size_t size);
+    ~PooledBuffer();
+
+    size_t capacity() const { return capacity_; }
+    // Sets the size, growing the allocation if |size| exceeds capacity().
+    void SetSize(size_t size);
+
+   private:
+    size_t capacity_;
+  };
+  // Explicitly use a RefCountedObject to get access to HasOneRef, needed to
+  // tell which buffers are free.
+  using PooledEncodedImageBuffer = rtc::RefCountedObject<PooledBuffer>;
+
+  rtc::RaceChecker race_checker_;
+  std::list<rtc::scoped_refptr<PooledEncodedImageBuffer>> buffers_;
+  const size_t max_number_of_buffers_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_MULTI_RESOLUTION_SCALER_H_
+#define COMMON_VIDEO_INCLUDE_MULTI_RESOLUTION_SCALER_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/include/i420_buffer_pool.h"
+
+namespace webrtc {
+
+// Scales a frame to several resolutions at once, e.g. for the layers of a
+// simulcast encoder. The layers are scaled largest first, each from the
+// smallest already scaled layer that covers it, so the full resolution source
+// is read once and every further step reads a smaller image that is likely
+// still in cache. The scaled buffers come from a pool per layer and are
+// reused once the encoders release them.
+class MultiResolutionScaler {
+ public:
+  struct Resolution {
+    int width;
+    int height;
+  };
+
+  MultiResolutionScaler();
+  ~MultiResolutionScaler();
+
+  // Returns |source| scaled to each of |resolutions|, in the same order.
+  // Layers with the size of |source| get |source| itself.
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> Scale(
+      rtc::scoped_refptr<I420BufferInterface> source,
+      rtc::ArrayView<const Resolution> resolutions);
+
+  // Drops the pooled buffers.
+  void Release();
+
+ private:
+  // One pool per layer, a pool only keeps buffers of a single resolution.
+  std::vector<std::unique_ptr<I420BufferPool>> pools_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_MULTI_RESOLUTION_SCALER_H_
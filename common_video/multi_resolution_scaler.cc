@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/multi_resolution_scaler.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+MultiResolutionScaler::MultiResolutionScaler() = default;
+MultiResolutionScaler::~MultiResolutionScaler() = default;
+
+std::vector<rtc::scoped_refptr<I420BufferInterface>>
+MultiResolutionScaler::Scale(rtc::scoped_refptr<I420BufferInterface> source,
+                             rtc::ArrayView<const Resolution> resolutions) {
+  RTC_DCHECK(source);
+  while (pools_.size() < resolutions.size())
+    pools_.push_back(std::make_unique<I420BufferPool>());
+
+  // Largest layer first.
+  std::vector<size_t> order(resolutions.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return resolutions[a].width * resolutions[a].height >
+           resolutions[b].width * resolutions[b].height;
+  });
+
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> scaled(
+      resolutions.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    const Resolution& resolution = resolutions[order[i]];
+    RTC_DCHECK_GT(resolution.width, 0);
+    RTC_DCHECK_GT(resolution.height, 0);
+    // The smallest layer scaled so far that covers this one. Scaling up from
+    // a smaller layer would lose detail, those fall back to |source|.
+    rtc::scoped_refptr<I420BufferInterface> from = source;
+    for (size_t j = i; j > 0; --j) {
+      const rtc::scoped_refptr<I420BufferInterface>& larger =
+          scaled[order[j - 1]];
+      if (larger->width() >= resolution.width &&
+          larger->height() >= resolution.height) {
+        from = larger;
+        break;
+      }
+    }
+    if (from->width() == resolution.width &&
+        from->height() == resolution.height) {
+      scaled[order[i]] = from;
+      continue;
+    }
+    rtc::scoped_refptr<I420Buffer> buffer =
+        pools_[order[i]]->CreateBuffer(resolution.width, resolution.height);
+    RTC_CHECK(buffer);
+    buffer->ScaleFrom(*from);
+    scaled[order[i]] = buffer;
+  }
+  return scaled;
+}
+
+void MultiResolutionScaler::Release() {
+  pools_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/multi_resolution_scaler.h"
+
+#include <stdint.h>
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Resolution = MultiResolutionScaler::Resolution;
+
+rtc::scoped_refptr<I420Buffer> CreateGradient(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x)
+      buffer->MutableDataY()[y * buffer->StrideY() + x] = (x + 2 * y) & 0xff;
+  }
+  for (int y = 0; y < buffer->ChromaHeight(); ++y) {
+    for (int x = 0; x < buffer->ChromaWidth(); ++x) {
+      buffer->MutableDataU()[y * buffer->StrideU() + x] = (3 * x) & 0xff;
+      buffer->MutableDataV()[y * buffer->StrideV() + x] = (3 * y) & 0xff;
+    }
+  }
+  return buffer;
+}
+
+}  // namespace
+
+TEST(MultiResolutionScalerTest, ScalesToEachResolutionInOrder) {
+  MultiResolutionScaler scaler;
+  const Resolution kResolutions[] = {{320, 180}, {640, 360}, {1280, 720}};
+  auto scaled = scaler.Scale(CreateGradient(1280, 720), kResolutions);
+  ASSERT_EQ(scaled.size(), 3u);
+  for (size_t i = 0; i < scaled.size(); ++i) {
+    EXPECT_EQ(scaled[i]->width(), kResolutions[i].width);
+    EXPECT_EQ(scaled[i]->height(), kResolutions[i].height);
+  }
+}
+
+TEST(MultiResolutionScalerTest, PassesSourceSizedLayersThrough) {
+  MultiResolutionScaler scaler;
+  rtc::scoped_refptr<I420BufferInterface> source = CreateGradient(640, 360);
+  const Resolution kResolutions[] = {{320, 180}, {640, 360}};
+  auto scaled = scaler.Scale(source, kResolutions);
+  EXPECT_EQ(scaled[1], source);
+}
+
+TEST(MultiResolutionScalerTest, ReusesReleasedBuffers) {
+  MultiResolutionScaler scaler;
+  rtc::scoped_refptr<I420BufferInterface> source = CreateGradient(640, 360);
+  const Resolution kResolutions[] = {{160, 90}, {320, 180}};
+  auto scaled = scaler.Scale(source, kResolutions);
+  const uint8_t* data_y0 = scaled[0]->DataY();
+  const uint8_t* data_y1 = scaled[1]->DataY();
+  scaled.clear();
+  scaled = scaler.Scale(source, kResolutions);
+  EXPECT_EQ(scaled[0]->DataY(), data_y0);
+  EXPECT_EQ(scaled[1]->DataY(), data_y1);
+}
+
+TEST(MultiResolutionScalerTest, DoesNotReuseBuffersInUse) {
+  MultiResolutionScaler scaler;
+  rtc::scoped_refptr<I420BufferInterface> source = CreateGradient(640, 360);
+  const Resolution kResolutions[] = {{320, 180}};
+  auto first = scaler.Scale(source, kResolutions);
+  auto second = scaler.Scale(source, kResolutions);
+  EXPECT_NE(first[0]->DataY(), second[0]->DataY());
+}
+
+TEST(MultiResolutionScalerTest, MatchesScalingFromTheSource) {
+  MultiResolutionScaler scaler;
+  rtc::scoped_refptr<I420BufferInterface> source = CreateGradient(1280, 720);
+  const Resolution kResolutions[] = {{320, 180}, {640, 360}};
+  auto scaled = scaler.Scale(source, kResolutions);
+  rtc::scoped_refptr<I420Buffer> direct = I420Buffer::Create(320, 180);
+  direct->ScaleFrom(*source);
+  EXPECT_GT(I420PSNR(*direct, *scaled[0]), 40);
+}
+
+TEST(MultiResolutionScalerTest, ScalesLayersNotCoveredFromTheSource) {
+  MultiResolutionScaler scaler;
+  rtc::scoped_refptr<I420BufferInterface> source = CreateGradient(1280, 720);
+  // Neither layer fits into the other.
+  const Resolution kResolutions[] = {{640, 180}, {320, 360}};
+  auto scaled = scaler.Scale(source, kResolutions);
+  rtc::scoped_refptr<I420Buffer> direct = I420Buffer::Create(320, 360);
+  direct->ScaleFrom(*source);
+  EXPECT_EQ(I420PSNR(*direct, *scaled[1]), kPerfectPSNR);
+}
+
+}  // namespace webrtc
@@ -51,6 +51,15 @@ VideoRenderFrames::~VideoRenderFrames() {
 int32_t VideoRenderFrames::AddFrame(VideoFrame&& new_frame) {
   const int64_t time_now = rtc::TimeMillis();
 
+  // A zero render time means render immediately. The frame replaces the queued
+  // ones, which would only be rendered later.
+  if (new_frame.render_time_ms() == 0) {
+    frames_dropped_ += incoming_frames_.size();
+    incoming_frames_.clear();
+    incoming_frames_.emplace_back(std::move(new_frame));
+    return 1;
+  }
+
   // Drop old frames only when there are other frames in the queue, otherwise, a
   // really slow system never renders any frames.
   if (!incoming_frames_.empty() &&
@@ -280,7 +280,7 @@ bool ListeningSocket::Listen(unsigned short port) {
     printf("bind failed\n");
     return false;
   }
-  return listen(socket_, 5) != SOCKET_ERROR;
+  return listen(socket_, SOMAXCONN) != SOCKET_ERROR;
 }
 
 DataSocket* ListeningSocket::Accept() const {
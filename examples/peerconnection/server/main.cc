@@ -11,12 +11,10 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
-#if defined(WEBRTC_POSIX)
-#include <sys/select.h>
-#endif
 #include <time.h>
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "absl/flags/flag.h"
@@ -24,6 +22,7 @@
 #include "absl/flags/usage.h"
 #include "examples/peerconnection/server/data_socket.h"
 #include "examples/peerconnection/server/peer_channel.h"
+#include "examples/peerconnection/server/socket_poller.h"
 #include "system_wrappers/include/field_trial.h"
 #include "test/field_trial.h"
 
@@ -38,8 +37,6 @@ ABSL_FLAG(
     "trials are separated by \"/\"");
 ABSL_FLAG(int, port, 8888, "default: 8888");
 
-static const size_t kMaxConnections = (FD_SETSIZE - 2);
-
 void HandleBrowserRequest(DataSocket* ds, bool* quit) {
   assert(ds && ds->valid());
   assert(quit);
@@ -95,98 +92,97 @@ int main(int argc, char* argv[]) {
 
   printf("Server listening on port %i\n", port);
 
+  SocketPoller poller;
+  if (!poller.valid() || !poller.Add(&listener)) {
+    printf("Failed to poll server socket\n");
+    return -1;
+  }
+
   PeerChannel clients;
-  typedef std::vector<DataSocket*> SocketArray;
-  SocketArray sockets;
+  std::unordered_set<DataSocket*> sockets;
+  std::vector<SocketBase*> ready;
   bool quit = false;
   while (!quit) {
-    fd_set socket_set;
-    FD_ZERO(&socket_set);
-    if (listener.valid())
-      FD_SET(listener.socket(), &socket_set);
-
-    for (SocketArray::iterator i = sockets.begin(); i != sockets.end(); ++i)
-      FD_SET((*i)->socket(), &socket_set);
-
-    struct timeval timeout = {10, 0};
-    if (select(FD_SETSIZE, &socket_set, NULL, NULL, &timeout) == SOCKET_ERROR) {
-      printf("select failed\n");
+    // Wake up every second to time out members without a wait request.
+    if (!poller.Wait(1000, &ready)) {
+      printf("Waiting for sockets failed\n");
       break;
     }
 
-    for (SocketArray::iterator i = sockets.begin(); i != sockets.end(); ++i) {
-      DataSocket* s = *i;
+    bool accept = false;
+    for (SocketBase* socket : ready) {
+      if (socket == &listener) {
+        accept = listener.valid();
+        continue;
+      }
+      DataSocket* s = static_cast<DataSocket*>(socket);
       bool socket_done = true;
-      if (FD_ISSET(s->socket(), &socket_set)) {
-        if (s->OnDataAvailable(&socket_done) && s->request_received()) {
-          ChannelMember* member = clients.Lookup(s);
-          if (member || PeerChannel::IsPeerConnection(s)) {
-            if (!member) {
-              if (s->PathEquals("/sign_in")) {
-                clients.AddMember(s);
-              } else {
-                printf("No member found for: %s\n", s->request_path().c_str());
-                s->Send("500 Error", true, "text/plain", "",
-                        "Peer most likely gone.");
-              }
-            } else if (member->is_wait_request(s)) {
-              // no need to do anything.
-              socket_done = false;
+      if (s->OnDataAvailable(&socket_done) && s->request_received()) {
+        ChannelMember* member = clients.Lookup(s);
+        if (member || PeerChannel::IsPeerConnection(s)) {
+          if (!member) {
+            if (s->PathEquals("/sign_in")) {
+              clients.AddMember(s);
             } else {
-              ChannelMember* target = clients.IsTargetedRequest(s);
-              if (target) {
-                member->ForwardRequestToPeer(s, target);
-              } else if (s->PathEquals("/sign_out")) {
-                s->Send("200 OK", true, "text/plain", "", "");
-              } else {
-                printf("Couldn't find target for request: %s\n",
-                       s->request_path().c_str());
-                s->Send("500 Error", true, "text/plain", "",
-                        "Peer most likely gone.");
-              }
+              printf("No member found for: %s\n", s->request_path().c_str());
+              s->Send("500 Error", true, "text/plain", "",
+                      "Peer most likely gone.");
             }
+          } else if (member->is_wait_request(s)) {
+            // no need to do anything.
+            socket_done = false;
           } else {
-            HandleBrowserRequest(s, &quit);
-            if (quit) {
-              printf("Quitting...\n");
-              FD_CLR(listener.socket(), &socket_set);
-              listener.Close();
-              clients.CloseAll();
+            ChannelMember* target = clients.IsTargetedRequest(s);
+            if (target) {
+              member->ForwardRequestToPeer(s, target);
+            } else if (s->PathEquals("/sign_out")) {
+              s->Send("200 OK", true, "text/plain", "", "");
+            } else {
+              printf("Couldn't find target for request: %s\n",
+                     s->request_path().c_str());
+              s->Send("500 Error", true, "text/plain", "",
+                      "Peer most likely gone.");
             }
           }
+        } else {
+          HandleBrowserRequest(s, &quit);
+          if (quit && listener.valid()) {
+            printf("Quitting...\n");
+            poller.Remove(&listener);
+            listener.Close();
+            clients.CloseAll();
+          }
         }
-      } else {
-        socket_done = false;
       }
 
       if (socket_done) {
         printf("Disconnecting socket\n");
         clients.OnClosing(s);
         assert(s->valid());  // Close must not have been called yet.
-        FD_CLR(s->socket(), &socket_set);
-        delete (*i);
-        i = sockets.erase(i);
-        if (i == sockets.end())
-          break;
+        poller.Remove(s);
+        sockets.erase(s);
+        delete s;
       }
     }
 
     clients.CheckForTimeout();
 
-    if (FD_ISSET(listener.socket(), &socket_set)) {
+    if (accept) {
       DataSocket* s = listener.Accept();
-      if (sockets.size() >= kMaxConnections) {
+      if (!s) {
+        printf("Failed to accept connection\n");
+      } else if (!poller.Add(s)) {
         delete s;  // sorry, that's all we can take.
         printf("Connection limit reached\n");
       } else {
-        sockets.push_back(s);
+        sockets.insert(s);
         printf("New connection...\n");
       }
     }
   }
 
-  for (SocketArray::iterator i = sockets.begin(); i != sockets.end(); ++i)
-    delete (*i);
+  for (DataSocket* s : sockets)
+    delete s;
   sockets.clear();
 
   return 0;
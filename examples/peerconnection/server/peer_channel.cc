@@ -46,6 +46,34 @@ enum RequestPathIndex {
 
 const size_t kMaxNameLength = 512;
 
+// Finds the index of the path of |ds| in |kRequestPaths| and the "peer_id"
+// argument of the request. Returns false if it isn't a request by a member.
+static bool ParseMemberRequest(const DataSocket* ds,
+                               size_t* path_index,
+                               int* peer_id) {
+  if (ds->method() != DataSocket::GET && ds->method() != DataSocket::POST)
+    return false;
+
+  size_t i = 0;
+  for (; i < ARRAYSIZE(kRequestPaths); ++i) {
+    if (ds->PathEquals(kRequestPaths[i]))
+      break;
+  }
+
+  if (i == ARRAYSIZE(kRequestPaths))
+    return false;
+
+  std::string args(ds->request_arguments());
+  static const char kPeerId[] = "peer_id=";
+  size_t found = args.find(kPeerId);
+  if (found == std::string::npos)
+    return false;
+
+  *path_index = i;
+  *peer_id = atoi(&args[found + ARRAYSIZE(kPeerId) - 1]);
+  return true;
+}
+
 //
 // ChannelMember
 //
@@ -175,37 +203,19 @@ bool PeerChannel::IsPeerConnection(const DataSocket* ds) {
 ChannelMember* PeerChannel::Lookup(DataSocket* ds) const {
   assert(ds);
 
-  if (ds->method() != DataSocket::GET && ds->method() != DataSocket::POST)
-    return NULL;
-
-  size_t i = 0;
-  for (; i < ARRAYSIZE(kRequestPaths); ++i) {
-    if (ds->PathEquals(kRequestPaths[i]))
-      break;
-  }
-
-  if (i == ARRAYSIZE(kRequestPaths))
+  size_t i;
+  int id;
+  if (!ParseMemberRequest(ds, &i, &id))
     return NULL;
 
-  std::string args(ds->request_arguments());
-  static const char kPeerId[] = "peer_id=";
-  size_t found = args.find(kPeerId);
-  if (found == std::string::npos)
-    return NULL;
-
-  int id = atoi(&args[found + ARRAYSIZE(kPeerId) - 1]);
-  Members::const_iterator iter = members_.begin();
-  for (; iter != members_.end(); ++iter) {
-    if (id == (*iter)->id()) {
-      if (i == kWait)
-        (*iter)->SetWaitingSocket(ds);
-      if (i == kSignOut)
-        (*iter)->set_disconnected();
-      return *iter;
-    }
+  ChannelMember* member = FindMember(id);
+  if (member) {
+    if (i == kWait)
+      member->SetWaitingSocket(ds);
+    if (i == kSignOut)
+      member->set_disconnected();
   }
-
-  return NULL;
+  return member;
 }
 
 ChannelMember* PeerChannel::IsTargetedRequest(const DataSocket* ds) const {
@@ -228,14 +238,7 @@ ChannelMember* PeerChannel::IsTargetedRequest(const DataSocket* ds) const {
     }
     args = found + ARRAYSIZE(kTargetPeerIdParam) - 1;
   } while (true);
-  int id = atoi(&path[found]);
-  Members::const_iterator i = members_.begin();
-  for (; i != members_.end(); ++i) {
-    if ((*i)->id() == id) {
-      return *i;
-    }
-  }
-  return NULL;
+  return FindMember(atoi(&path[found]));
 }
 
 bool PeerChannel::AddMember(DataSocket* ds) {
@@ -245,6 +248,7 @@ bool PeerChannel::AddMember(DataSocket* ds) {
   BroadcastChangedState(*new_guy, &failures);
   HandleDeliveryFailures(&failures);
   members_.push_back(new_guy);
+  members_by_id_[new_guy->id()] = new_guy;
 
   printf("New member added (total=%s): %s\n",
          size_t2str(members_.size()).c_str(), new_guy->name().c_str());
@@ -266,28 +270,37 @@ void PeerChannel::CloseAll() {
 }
 
 void PeerChannel::OnClosing(DataSocket* ds) {
-  for (Members::iterator i = members_.begin(); i != members_.end(); ++i) {
-    ChannelMember* m = (*i);
+  // Only the requests of a member can be its waiting socket or sign it out,
+  // so there is no need to ask the other members.
+  size_t i;
+  int id;
+  ChannelMember* m = ParseMemberRequest(ds, &i, &id) ? FindMember(id) : NULL;
+  if (m) {
     m->OnClosing(ds);
     if (!m->connected()) {
-      i = members_.erase(i);
+      RemoveMember(m);
       Members failures;
       BroadcastChangedState(*m, &failures);
       HandleDeliveryFailures(&failures);
       delete m;
-      if (i == members_.end())
-        break;
     }
   }
   printf("Total connected: %s\n", size_t2str(members_.size()).c_str());
 }
 
 void PeerChannel::CheckForTimeout() {
+  // Members time out after whole seconds, checking more often is pointless.
+  time_t now = time(NULL);
+  if (now == last_timeout_check_)
+    return;
+  last_timeout_check_ = now;
+
   for (Members::iterator i = members_.begin(); i != members_.end(); ++i) {
     ChannelMember* m = (*i);
     if (m->TimedOut()) {
       printf("Timeout: %s\n", m->name().c_str());
       m->set_disconnected();
+      members_by_id_.erase(m->id());
       i = members_.erase(i);
       Members failures;
       BroadcastChangedState(*m, &failures);
@@ -299,10 +312,21 @@ void PeerChannel::CheckForTimeout() {
   }
 }
 
+ChannelMember* PeerChannel::FindMember(int id) const {
+  auto it = members_by_id_.find(id);
+  return it != members_by_id_.end() ? it->second : NULL;
+}
+
+void PeerChannel::RemoveMember(ChannelMember* member) {
+  members_by_id_.erase(member->id());
+  members_.erase(std::find(members_.begin(), members_.end(), member));
+}
+
 void PeerChannel::DeleteAll() {
   for (Members::iterator i = members_.begin(); i != members_.end(); ++i)
     delete (*i);
   members_.clear();
+  members_by_id_.clear();
 }
 
 void PeerChannel::BroadcastChangedState(const ChannelMember& member,
@@ -320,6 +344,7 @@ void PeerChannel::BroadcastChangedState(const ChannelMember& member,
       if (!(*i)->NotifyOfOtherMember(member)) {
         (*i)->set_disconnected();
         delivery_failures->push_back(*i);
+        members_by_id_.erase((*i)->id());
         i = members_.erase(i);
         if (i == members_.end())
           break;
@@ -15,6 +15,7 @@
 
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class DataSocket;
@@ -70,7 +71,7 @@ class PeerChannel {
  public:
   typedef std::vector<ChannelMember*> Members;
 
-  PeerChannel() {}
+  PeerChannel() : last_timeout_check_(0) {}
 
   ~PeerChannel() { DeleteAll(); }
 
@@ -99,9 +100,14 @@ class PeerChannel {
   // connection went dead).
   void OnClosing(DataSocket* ds);
 
+  // Removes the members that had no wait request for too long. Only checks
+  // once a second, however often it's called.
   void CheckForTimeout();
 
  protected:
+  ChannelMember* FindMember(int id) const;
+  // Removes |member| from |members_| and |members_by_id_|, without deleting it.
+  void RemoveMember(ChannelMember* member);
   void DeleteAll();
   void BroadcastChangedState(const ChannelMember& member,
                              Members* delivery_failures);
@@ -113,6 +119,9 @@ class PeerChannel {
 
  protected:
   Members members_;
+  // Indexes |members_| by id, for the lookups of every request.
+  std::unordered_map<int, ChannelMember*> members_by_id_;
+  time_t last_timeout_check_;
 };
 
 #endif  // EXAMPLES_PEERCONNECTION_SERVER_PEER_CHANNEL_H_
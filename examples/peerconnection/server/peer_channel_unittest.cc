@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/server/peer_channel.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+
+#include "examples/peerconnection/server/data_socket.h"
+#include "examples/peerconnection/server/utils.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+using ::testing::HasSubstr;
+
+namespace {
+
+// A request received by the server, with the client end of its connection.
+class Request {
+ public:
+  explicit Request(const std::string& path) {
+    int fds[2];
+    EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    socket_ = std::make_unique<DataSocket>(fds[0]);
+    client_ = fds[1];
+    std::string request = "GET " + path + " HTTP/1.1\r\n\r\n";
+    EXPECT_EQ(write(client_, request.data(), request.size()),
+              static_cast<ssize_t>(request.size()));
+    bool close_socket;
+    EXPECT_TRUE(socket_->OnDataAvailable(&close_socket));
+    EXPECT_TRUE(socket_->request_received());
+  }
+  ~Request() { close(client_); }
+
+  DataSocket* socket() const { return socket_.get(); }
+
+  // Returns what the server sent so far.
+  std::string Response() const {
+    char buffer[0xfff];
+    ssize_t bytes = recv(client_, buffer, sizeof(buffer), MSG_DONTWAIT);
+    return bytes > 0 ? std::string(buffer, bytes) : "";
+  }
+
+ private:
+  std::unique_ptr<DataSocket> socket_;
+  int client_;
+};
+
+class PeerChannelTest : public ::testing::Test {
+ protected:
+  ChannelMember* SignIn(const std::string& name) {
+    Request request("/sign_in?" + name);
+    EXPECT_TRUE(PeerChannel::IsPeerConnection(request.socket()));
+    EXPECT_TRUE(channel_.AddMember(request.socket()));
+    EXPECT_THAT(request.Response(), HasSubstr("200 Added"));
+    return channel_.members().back();
+  }
+
+  static std::string PeerId(const ChannelMember* member) {
+    return "peer_id=" + int2str(member->id());
+  }
+
+  PeerChannel channel_;
+};
+
+TEST_F(PeerChannelTest, LooksUpTheMemberOfARequest) {
+  ChannelMember* alice = SignIn("alice");
+  ChannelMember* bob = SignIn("bob");
+
+  Request wait("/wait?" + PeerId(bob));
+  EXPECT_EQ(channel_.Lookup(wait.socket()), bob);
+  Request unknown("/wait?peer_id=" + int2str(bob->id() + 1));
+  EXPECT_EQ(channel_.Lookup(unknown.socket()), nullptr);
+  Request no_peer_id("/wait");
+  EXPECT_EQ(channel_.Lookup(no_peer_id.socket()), nullptr);
+  Request other_path("/sign_in?" + PeerId(alice));
+  EXPECT_EQ(channel_.Lookup(other_path.socket()), nullptr);
+}
+
+TEST_F(PeerChannelTest, FindsTheTargetOfARequest) {
+  ChannelMember* alice = SignIn("alice");
+  ChannelMember* bob = SignIn("bob");
+
+  Request message("/message?" + PeerId(alice) + "&to=" + int2str(bob->id()));
+  EXPECT_EQ(channel_.IsTargetedRequest(message.socket()), bob);
+  Request first("/message?to=" + int2str(alice->id()) + "&" + PeerId(bob));
+  EXPECT_EQ(channel_.IsTargetedRequest(first.socket()), alice);
+  // Only a whole "to" argument names the target.
+  Request suffix("/message?" + PeerId(alice) + "&xto=" + int2str(bob->id()));
+  EXPECT_EQ(channel_.IsTargetedRequest(suffix.socket()), nullptr);
+  Request unknown("/message?to=" + int2str(bob->id() + 1));
+  EXPECT_EQ(channel_.IsTargetedRequest(unknown.socket()), nullptr);
+}
+
+TEST_F(PeerChannelTest, RemovesAMemberThatSignsOut) {
+  ChannelMember* alice = SignIn("alice");
+  ChannelMember* bob = SignIn("bob");
+  const int alice_id = alice->id();
+  // Alice was told about bob signing in.
+  Request alice_wait("/wait?" + PeerId(alice));
+  ASSERT_EQ(channel_.Lookup(alice_wait.socket()), alice);
+  EXPECT_THAT(alice_wait.Response(),
+              HasSubstr("bob," + int2str(bob->id()) + ",1"));
+  Request bob_wait("/wait?" + PeerId(bob));
+  ASSERT_EQ(channel_.Lookup(bob_wait.socket()), bob);
+  EXPECT_EQ(bob_wait.Response(), "");
+
+  Request sign_out("/sign_out?" + PeerId(alice));
+  ASSERT_EQ(channel_.Lookup(sign_out.socket()), alice);
+  EXPECT_FALSE(alice->connected());
+  channel_.OnClosing(sign_out.socket());
+  ASSERT_EQ(channel_.members().size(), 1u);
+  EXPECT_EQ(channel_.members()[0], bob);
+  // Bob's waiting request is answered.
+  EXPECT_THAT(bob_wait.Response(),
+              HasSubstr("alice," + int2str(alice_id) + ",0"));
+
+  Request lookup("/wait?peer_id=" + int2str(alice_id));
+  EXPECT_EQ(channel_.Lookup(lookup.socket()), nullptr);
+}
+
+TEST_F(PeerChannelTest, KeepsAMemberWhoseWaitRequestCloses) {
+  ChannelMember* alice = SignIn("alice");
+  {
+    Request wait("/wait?" + PeerId(alice));
+    ASSERT_EQ(channel_.Lookup(wait.socket()), alice);
+    channel_.OnClosing(wait.socket());
+  }
+  ASSERT_EQ(channel_.members().size(), 1u);
+  EXPECT_TRUE(alice->connected());
+  channel_.CheckForTimeout();
+  EXPECT_EQ(channel_.members().size(), 1u);
+}
+
+}  // namespace
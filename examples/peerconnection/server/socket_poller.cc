@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/server/socket_poller.h"
+
+#include <assert.h>
+#include <errno.h>
+#if defined(WEBRTC_LINUX)
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif defined(WEBRTC_MAC)
+#include <sys/event.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_MAC)
+// Maximum number of sockets reported by a single wait, any others are
+// reported by the next one.
+static const int kMaxEvents = 128;
+#endif
+
+#if defined(WEBRTC_LINUX)
+
+SocketPoller::SocketPoller() : poll_fd_(epoll_create1(EPOLL_CLOEXEC)) {}
+
+SocketPoller::~SocketPoller() {
+  if (poll_fd_ >= 0)
+    close(poll_fd_);
+}
+
+bool SocketPoller::valid() const {
+  return poll_fd_ >= 0;
+}
+
+bool SocketPoller::Add(SocketBase* socket) {
+  assert(socket && socket->valid());
+  struct epoll_event event = {0};
+  event.events = EPOLLIN;
+  event.data.ptr = socket;
+  return epoll_ctl(poll_fd_, EPOLL_CTL_ADD, socket->socket(), &event) == 0;
+}
+
+void SocketPoller::Remove(SocketBase* socket) {
+  assert(socket && socket->valid());
+  // The event is ignored, but must not be null on older kernels.
+  struct epoll_event event = {0};
+  epoll_ctl(poll_fd_, EPOLL_CTL_DEL, socket->socket(), &event);
+}
+
+bool SocketPoller::Wait(int timeout_ms, std::vector<SocketBase*>* ready) {
+  ready->clear();
+  struct epoll_event events[kMaxEvents];
+  int count = epoll_wait(poll_fd_, events, kMaxEvents, timeout_ms);
+  if (count < 0)
+    return errno == EINTR;
+  for (int i = 0; i < count; ++i)
+    ready->push_back(static_cast<SocketBase*>(events[i].data.ptr));
+  return true;
+}
+
+#elif defined(WEBRTC_MAC)
+
+SocketPoller::SocketPoller() : poll_fd_(kqueue()) {}
+
+SocketPoller::~SocketPoller() {
+  if (poll_fd_ >= 0)
+    close(poll_fd_);
+}
+
+bool SocketPoller::valid() const {
+  return poll_fd_ >= 0;
+}
+
+bool SocketPoller::Add(SocketBase* socket) {
+  assert(socket && socket->valid());
+  struct kevent event;
+  EV_SET(&event, socket->socket(), EVFILT_READ, EV_ADD, 0, 0, socket);
+  return kevent(poll_fd_, &event, 1, NULL, 0, NULL) == 0;
+}
+
+void SocketPoller::Remove(SocketBase* socket) {
+  assert(socket && socket->valid());
+  struct kevent event;
+  EV_SET(&event, socket->socket(), EVFILT_READ, EV_DELETE, 0, 0, NULL);
+  kevent(poll_fd_, &event, 1, NULL, 0, NULL);
+}
+
+bool SocketPoller::Wait(int timeout_ms, std::vector<SocketBase*>* ready) {
+  ready->clear();
+  struct kevent events[kMaxEvents];
+  struct timespec timeout = {timeout_ms / 1000, (timeout_ms % 1000) * 1000000};
+  int count = kevent(poll_fd_, NULL, 0, events, kMaxEvents, &timeout);
+  if (count < 0)
+    return errno == EINTR;
+  for (int i = 0; i < count; ++i)
+    ready->push_back(static_cast<SocketBase*>(events[i].udata));
+  return true;
+}
+
+#else
+
+SocketPoller::SocketPoller() {}
+
+SocketPoller::~SocketPoller() {}
+
+bool SocketPoller::valid() const {
+  return true;
+}
+
+bool SocketPoller::Add(SocketBase* socket) {
+  assert(socket && socket->valid());
+  if (sockets_.size() >= FD_SETSIZE - 1)
+    return false;
+  sockets_.push_back(socket);
+  return true;
+}
+
+void SocketPoller::Remove(SocketBase* socket) {
+  sockets_.erase(std::remove(sockets_.begin(), sockets_.end(), socket),
+                 sockets_.end());
+}
+
+bool SocketPoller::Wait(int timeout_ms, std::vector<SocketBase*>* ready) {
+  ready->clear();
+  fd_set socket_set;
+  FD_ZERO(&socket_set);
+  for (SocketBase* socket : sockets_)
+    FD_SET(socket->socket(), &socket_set);
+
+  struct timeval timeout = {timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+  if (select(FD_SETSIZE, &socket_set, NULL, NULL, &timeout) == SOCKET_ERROR)
+    return false;
+  for (SocketBase* socket : sockets_) {
+    if (FD_ISSET(socket->socket(), &socket_set))
+      ready->push_back(socket);
+  }
+  return true;
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_SERVER_SOCKET_POLLER_H_
+#define EXAMPLES_PEERCONNECTION_SERVER_SOCKET_POLLER_H_
+
+#include <vector>
+
+#include "examples/peerconnection/server/data_socket.h"
+
+// Waits for any of a set of sockets to become readable. Uses epoll on Linux
+// and kqueue on Mac, where the cost of a wait doesn't grow with the number of
+// sockets that are idle, and select() elsewhere, where at most FD_SETSIZE - 1
+// sockets can be added.
+class SocketPoller {
+ public:
+  SocketPoller();
+  ~SocketPoller();
+
+  bool valid() const;
+
+  // Returns false if |socket| can't be watched, e.g. because the limit of the
+  // select() implementation is reached.
+  bool Add(SocketBase* socket);
+  // Must be called before the socket is closed.
+  void Remove(SocketBase* socket);
+
+  // Waits up to |timeout_ms| for sockets to become readable, or to be closed
+  // by the remote side, and replaces the contents of |ready| with them.
+  // Returns false on failure.
+  bool Wait(int timeout_ms, std::vector<SocketBase*>* ready);
+
+ private:
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_MAC)
+  // The epoll or kqueue descriptor.
+  int poll_fd_;
+#else
+  std::vector<SocketBase*> sockets_;
+#endif
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_SERVER_SOCKET_POLLER_H_
@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/server/socket_poller.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAre;
+
+namespace {
+
+constexpr int kNumPairs = 100;
+
+// A connected pair of sockets, the server side is the one polled.
+struct SocketPair {
+  SocketPair() {
+    int fds[2];
+    EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    server = std::make_unique<SocketBase>(fds[0]);
+    client = std::make_unique<SocketBase>(fds[1]);
+  }
+
+  void Write() { EXPECT_EQ(write(client->socket(), "x", 1), 1); }
+
+  std::unique_ptr<SocketBase> server;
+  std::unique_ptr<SocketBase> client;
+};
+
+TEST(SocketPollerTest, ReportsOnlyTheReadableSockets) {
+  SocketPoller poller;
+  ASSERT_TRUE(poller.valid());
+  std::vector<SocketPair> pairs(kNumPairs);
+  for (SocketPair& pair : pairs)
+    ASSERT_TRUE(poller.Add(pair.server.get()));
+
+  std::vector<SocketBase*> ready;
+  ASSERT_TRUE(poller.Wait(0, &ready));
+  EXPECT_THAT(ready, IsEmpty());
+
+  pairs[3].Write();
+  pairs[kNumPairs - 1].Write();
+  ASSERT_TRUE(poller.Wait(1000, &ready));
+  EXPECT_THAT(ready, UnorderedElementsAre(pairs[3].server.get(),
+                                          pairs[kNumPairs - 1].server.get()));
+}
+
+TEST(SocketPollerTest, ReportsASocketClosedByThePeer) {
+  SocketPoller poller;
+  SocketPair pair;
+  ASSERT_TRUE(poller.Add(pair.server.get()));
+  pair.client->Close();
+
+  std::vector<SocketBase*> ready;
+  ASSERT_TRUE(poller.Wait(1000, &ready));
+  EXPECT_THAT(ready, ElementsAre(pair.server.get()));
+}
+
+TEST(SocketPollerTest, StopsReportingARemovedSocket) {
+  SocketPoller poller;
+  SocketPair removed;
+  SocketPair kept;
+  ASSERT_TRUE(poller.Add(removed.server.get()));
+  ASSERT_TRUE(poller.Add(kept.server.get()));
+  poller.Remove(removed.server.get());
+  removed.Write();
+  kept.Write();
+
+  std::vector<SocketBase*> ready;
+  ASSERT_TRUE(poller.Wait(1000, &ready));
+  EXPECT_THAT(ready, ElementsAre(kept.server.get()));
+}
+
+}  // namespace
@@ -12,12 +12,15 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <fstream>
 #include <memory>
+#include <sstream>
 #include <thread>
 #include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/match.h"
 #include "absl/types/optional.h"
 #include "api/audio/audio_mixer.h"
 #include "api/audio_codecs/audio_decoder_factory.h"
@@ -33,6 +36,7 @@
 #include "api/video_codecs/video_decoder_factory.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "examples/peerconnection/serverless/defaults.h"
+#include "media/base/media_constants.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_device/include/test_audio_device.h"
 #include "modules/audio_processing/include/audio_processing.h"
@@ -46,6 +50,7 @@
 #include "rtc_base/rtc_certificate_generator.h"
 #include "rtc_base/strings/json.h"
 #include "test/frame_generator_capturer.h"
+#include "test/testsupport/async_file_writer.h"
 #include "api/test/create_frame_generator.h"
 #include "test/vcm_capturer.h"
 
@@ -59,6 +64,9 @@ const char kCandidateSdpName[] = "candidate";
 const char kSessionDescriptionTypeName[] = "type";
 const char kSessionDescriptionSdpName[] = "sdp";
 
+// About one second of received video waits for the disk, at most.
+const size_t kMaxQueuedOutputFrames = 60;
+
 class DummySetSessionDescriptionObserver
     : public webrtc::SetSessionDescriptionObserver {
  public:
@@ -72,18 +80,41 @@ class DummySetSessionDescriptionObserver
   }
 };
 
+// Reads the PEM encoded certificate and private key from the given files.
+rtc::scoped_refptr<rtc::RTCCertificate> LoadCertificate(
+    const std::string& certificate_path,
+    const std::string& private_key_path) {
+  std::ifstream certificate_file(certificate_path);
+  std::ifstream private_key_file(private_key_path);
+  if (!certificate_file || !private_key_file) {
+    RTC_LOG(LS_ERROR) << "Failed to open the DTLS certificate or key file";
+    return nullptr;
+  }
+  std::stringstream certificate;
+  std::stringstream private_key;
+  certificate << certificate_file.rdbuf();
+  private_key << private_key_file.rdbuf();
+  rtc::scoped_refptr<rtc::RTCCertificate> result =
+      rtc::RTCCertificate::FromPEM(
+          rtc::RTCCertificatePEM(private_key.str(), certificate.str()));
+  if (!result) {
+    RTC_LOG(LS_ERROR) << "Failed to parse the DTLS certificate";
+  }
+  return result;
+}
+
 class FrameGeneratorTrackSource : public webrtc::VideoTrackSource {
  public:
   static rtc::scoped_refptr<FrameGeneratorTrackSource> Create(
+      const webrtc::AlphaCCConfig* alphaCCConfig,
       std::shared_ptr<rtc::Event> audio_started_) {
-    auto alphaCCConfig = webrtc::GetAlphaCCConfig();
-    // Creat an FrameGenerator, responsible for reading yuv files
+    // Creat an FrameGenerator, responsible for reading yuv or y4m files
+    // ahead of the capturer, so that disk reads don't delay the frames
     std::unique_ptr<webrtc::test::FrameGeneratorInterface> yuv_frame_generator(
-        webrtc::test::CreateFromYuvFileFrameGenerator(
-            std::vector<std::string>{
-                alphaCCConfig->video_file_path}, /* file_path */
-            alphaCCConfig->video_width,          /*video_width */
-            alphaCCConfig->video_height,         /*video_height*/
+        webrtc::test::CreateStreamingFromYuvFileFrameGenerator(
+            alphaCCConfig->video_file_path, /* file_path */
+            alphaCCConfig->video_width,     /*video_width */
+            alphaCCConfig->video_height,    /*video_height*/
             1 /*frame_repeat_count*/));
 
     // Use FrameGenerator to periodically capture frames
@@ -95,19 +126,19 @@ class FrameGeneratorTrackSource : public webrtc::VideoTrackSource {
             *webrtc::CreateDefaultTaskQueueFactory())); /* task_queue_factory */
 
     return new rtc::RefCountedObject<FrameGeneratorTrackSource>(
-        std::move(capturer), audio_started_);
+        alphaCCConfig, std::move(capturer), audio_started_);
   }
 
  protected:
-  explicit FrameGeneratorTrackSource(
+  FrameGeneratorTrackSource(
+      const webrtc::AlphaCCConfig* alphaCCConfig,
       std::unique_ptr<webrtc::test::FrameGeneratorCapturer> capturer,
       std::shared_ptr<rtc::Event> audio_started_)
       : VideoTrackSource(/*remote=*/false), capturer_(std::move(capturer)) {
     // Creat a thread that waits for the audio capturer thread
     // to start
-    std::thread waiting_for_audio_started_([this, audio_started_]() {
-      auto alphaCCConfig = webrtc::GetAlphaCCConfig();
-
+    std::thread waiting_for_audio_started_([this, alphaCCConfig,
+                                            audio_started_]() {
       // Only wait for audio to start when use audio file
       if (alphaCCConfig->audio_source_option ==
           webrtc::AlphaCCConfig::AudioSourceOption::kAudioFile) {
@@ -169,19 +200,40 @@ class CapturerTrackSource : public webrtc::VideoTrackSource {
 }  // namespace
 
 Conductor::Conductor(PeerConnectionClient* client, MainWindow* main_wnd)
+    : Conductor(client,
+                main_wnd,
+                webrtc::GetAlphaCCConfig(),
+                /*resources=*/nullptr) {}
+
+Conductor::Conductor(PeerConnectionClient* client,
+                     MainWindow* main_wnd,
+                     const webrtc::AlphaCCConfig* config,
+                     SharedMediaResources* resources)
     : loopback_(false),
       client_(client),
       main_wnd_(main_wnd),
-      alphacc_config_(webrtc::GetAlphaCCConfig()),
-      audio_started_(std::make_shared<rtc::Event>()) {
+      alphacc_config_(config),
+      resources_(resources),
+      audio_started_(std::make_shared<rtc::Event>()),
+      output_task_queue_factory_(webrtc::CreateDefaultTaskQueueFactory()) {
   if (alphacc_config_->save_to_file) {
-    frame_writer_ = absl::make_unique<webrtc::test::Y4mVideoFrameWriterImpl>(
-        alphacc_config_->video_output_path, alphacc_config_->video_output_width,
-        alphacc_config_->video_output_height,
-        alphacc_config_->video_output_fps);
+    // Write frames on a task queue of its own, so that the disk doesn't
+    // delay the rendering
+    frame_writer_ = absl::make_unique<webrtc::test::AsyncVideoFrameWriter>(
+        absl::make_unique<webrtc::test::Y4mVideoFrameWriterImpl>(
+            alphacc_config_->video_output_path,
+            alphacc_config_->video_output_width,
+            alphacc_config_->video_output_height,
+            alphacc_config_->video_output_fps),
+        output_task_queue_factory_.get(), kMaxQueuedOutputFrames);
   } else {
     frame_writer_ = nullptr;
   }
+  if (alphacc_config_->fast_start &&
+      !alphacc_config_->dtls_certificate_path.empty()) {
+    certificate_ = LoadCertificate(alphacc_config_->dtls_certificate_path,
+                                   alphacc_config_->dtls_private_key_path);
+  }
   client_->RegisterObserver(this);
   main_wnd->RegisterObserver(this);
 }
@@ -190,6 +242,20 @@ Conductor::~Conductor() {
   RTC_DCHECK(!peer_connection_);
 }
 
+bool Conductor::PrewarmFactory() {
+  if (peer_connection_factory_.get()) {
+    return true;
+  }
+  return CreatePeerConnectionFactory();
+}
+
+bool Conductor::Prewarm() {
+  if (peer_connection_.get()) {
+    return true;
+  }
+  return InitializePeerConnection();
+}
+
 void Conductor::ConnectToPeer() {
   if (peer_connection_.get()) {
     main_wnd_->MessageBox(
@@ -197,6 +263,7 @@ void Conductor::ConnectToPeer() {
     return;
   }
   if (InitializePeerConnection()) {
+    StartAutoCloseTimer();
     peer_connection_->CreateOffer(
         this, webrtc::PeerConnectionInterface::RTCOfferAnswerOptions());
   } else {
@@ -209,9 +276,8 @@ void Conductor::Close() {
   DeletePeerConnection();
 }
 
-bool Conductor::InitializePeerConnection() {
+bool Conductor::CreatePeerConnectionFactory() {
   RTC_DCHECK(!peer_connection_factory_);
-  RTC_DCHECK(!peer_connection_);
 
   auto task_queue_factory = webrtc::CreateDefaultTaskQueueFactory();
   rtc::scoped_refptr<webrtc::AudioDeviceModule> audio_device_module = nullptr;
@@ -224,9 +290,10 @@ bool Conductor::InitializePeerConnection() {
 
     std::unique_ptr<webrtc::TestAudioDeviceModule::Renderer> renderer;
     if (alphacc_config_->save_to_file) {
-      renderer = webrtc::TestAudioDeviceModule::CreateWavFileWriter(
+      renderer = absl::make_unique<webrtc::test::AsyncWavFileWriter>(
           alphacc_config_->audio_output_path,
-          capturer.get()->SamplingFrequency(), capturer.get()->NumChannels());
+          capturer.get()->SamplingFrequency(), capturer.get()->NumChannels(),
+          output_task_queue_factory_.get());
     } else {
       renderer = webrtc::TestAudioDeviceModule::CreateDiscardRenderer(
           8000 /*sampling frequecy, unused*/, 2 /*num_channels, ununsed*/);
@@ -240,18 +307,39 @@ bool Conductor::InitializePeerConnection() {
     audio_device_module = nullptr;
   }
 
-  peer_connection_factory_ = webrtc::CreatePeerConnectionFactory(
-      nullptr /* network_thread */, nullptr /* worker_thread */,
-      nullptr /* signaling_thread */, audio_device_module /* default_adm */,
-      webrtc::CreateBuiltinAudioEncoderFactory(),
-      webrtc::CreateBuiltinAudioDecoderFactory(),
-      webrtc::CreateBuiltinVideoEncoderFactory(),
-      webrtc::CreateBuiltinVideoDecoderFactory(), nullptr /* audio_mixer */,
-      nullptr /* audio_processing */);
+  if (resources_) {
+    // The audio device and the mixer carry the audio of this session only.
+    peer_connection_factory_ = webrtc::CreatePeerConnectionFactory(
+        resources_->network_thread(), resources_->worker_thread(),
+        nullptr /* signaling_thread */, audio_device_module /* default_adm */,
+        resources_->audio_encoder_factory(),
+        resources_->audio_decoder_factory(),
+        resources_->CreateVideoEncoderFactory(),
+        resources_->CreateVideoDecoderFactory(), nullptr /* audio_mixer */,
+        resources_->TakeAudioProcessing());
+  } else {
+    peer_connection_factory_ = webrtc::CreatePeerConnectionFactory(
+        nullptr /* network_thread */, nullptr /* worker_thread */,
+        nullptr /* signaling_thread */, audio_device_module /* default_adm */,
+        webrtc::CreateBuiltinAudioEncoderFactory(),
+        webrtc::CreateBuiltinAudioDecoderFactory(),
+        webrtc::CreateBuiltinVideoEncoderFactory(),
+        webrtc::CreateBuiltinVideoDecoderFactory(), nullptr /* audio_mixer */,
+        nullptr /* audio_processing */);
+  }
 
   if (!peer_connection_factory_) {
     main_wnd_->MessageBox("Error", "Failed to initialize PeerConnectionFactory",
                           true);
+    return false;
+  }
+  return true;
+}
+
+bool Conductor::InitializePeerConnection() {
+  RTC_DCHECK(!peer_connection_);
+
+  if (!peer_connection_factory_ && !CreatePeerConnectionFactory()) {
     DeletePeerConnection();
     return false;
   }
@@ -263,12 +351,19 @@ bool Conductor::InitializePeerConnection() {
 
   AddTracks();
 
-  // Start the timer for auto close.
+  return peer_connection_ != nullptr;
+}
+
+void Conductor::StartAutoCloseTimer() {
+  // The session starts with the peer connecting, not with the prewarmed
+  // PeerConnection.
+  if (auto_close_started_) {
+    return;
+  }
+  auto_close_started_ = true;
   if (alphacc_config_->conn_autoclose != kAutoCloseDisableValue) {
     main_wnd_->StartAutoCloseTimer(alphacc_config_->conn_autoclose * 1000);
   }
-
-  return peer_connection_ != nullptr;
 }
 
 bool Conductor::ReinitializePeerConnectionForLoopback() {
@@ -293,10 +388,26 @@ bool Conductor::CreatePeerConnection(bool dtls) {
   webrtc::PeerConnectionInterface::RTCConfiguration config;
   config.sdp_semantics = webrtc::SdpSemantics::kUnifiedPlan;
   config.enable_dtls_srtp = dtls;
-  webrtc::PeerConnectionInterface::IceServer server;
-  server.uri = GetPeerConnectionString();
-  config.servers.push_back(server);
+  if (alphacc_config_->fast_start) {
+    // Host candidates only, on a single transport, so that gathering is done
+    // right away and a single connectivity check is needed.
+    config.bundle_policy =
+        webrtc::PeerConnectionInterface::kBundlePolicyMaxBundle;
+    config.rtcp_mux_policy =
+        webrtc::PeerConnectionInterface::kRtcpMuxPolicyRequire;
+    config.tcp_candidate_policy =
+        webrtc::PeerConnectionInterface::kTcpCandidatePolicyDisabled;
+    if (certificate_) {
+      config.certificates.push_back(certificate_);
+    }
+  } else {
+    webrtc::PeerConnectionInterface::IceServer server;
+    server.uri = GetPeerConnectionString();
+    config.servers.push_back(server);
+  }
 
+  // The call of the PeerConnection reads the session's configuration.
+  webrtc::ScopedAlphaCCConfig scoped_config(alphacc_config_);
   peer_connection_ = peer_connection_factory_->CreatePeerConnection(
       config, nullptr, nullptr, this);
   return peer_connection_ != nullptr;
@@ -329,6 +440,16 @@ void Conductor::OnRemoveTrack(
   main_wnd_->QueueUIThreadCallback(TRACK_REMOVED, receiver->track().release());
 }
 
+void Conductor::OnIceGatheringChange(
+    webrtc::PeerConnectionInterface::IceGatheringState new_state) {
+  RTC_LOG(INFO) << __FUNCTION__ << " " << new_state;
+  if (new_state == webrtc::PeerConnectionInterface::kIceGatheringComplete &&
+      local_description_pending_ && peer_connection_->local_description()) {
+    local_description_pending_ = false;
+    SendSessionDescription(peer_connection_->local_description());
+  }
+}
+
 void Conductor::OnIceCandidate(const webrtc::IceCandidateInterface* candidate) {
   RTC_LOG(INFO) << __FUNCTION__ << " " << candidate->sdp_mline_index();
   // For loopback test. To save some connecting delay.
@@ -338,6 +459,10 @@ void Conductor::OnIceCandidate(const webrtc::IceCandidateInterface* candidate) {
     }
     return;
   }
+  // With fast start the candidates are sent in the session description.
+  if (alphacc_config_->fast_start) {
+    return;
+  }
 
   Json::StyledWriter writer;
   Json::Value jmessage;
@@ -448,6 +573,7 @@ void Conductor::OnGetMessage(const std::string& new_message) {
       return;
     }
   }
+  StartAutoCloseTimer();
 
   // append new message to accumulate_message_
   accumulate_message_ += new_message;
@@ -505,6 +631,9 @@ void Conductor::AddTracks() {
   if (!result_or_error.ok()) {
     RTC_LOG(LS_ERROR) << "Failed to add audio track to PeerConnection: "
                       << result_or_error.error().message();
+  } else if (alphacc_config_->fast_start) {
+    RestrictCodecs(result_or_error.value(),
+                   alphacc_config_->fast_start_audio_codec);
   }
 
   rtc::scoped_refptr<webrtc::VideoTrackSource> video_device;
@@ -518,7 +647,8 @@ void Conductor::AddTracks() {
       video_device = CapturerTrackSource::Create();
       break;
     case VideoSourceOption::kVideoFile:
-      video_device = FrameGeneratorTrackSource::Create(audio_started_);
+      video_device = FrameGeneratorTrackSource::Create(alphacc_config_,
+                                                       audio_started_);
       break;
     default:
       RTC_NOTREACHED();
@@ -533,6 +663,9 @@ void Conductor::AddTracks() {
     if (!result_or_error.ok()) {
       RTC_LOG(LS_ERROR) << "Failed to add video track to PeerConnection: "
                         << result_or_error.error().message();
+    } else if (alphacc_config_->fast_start) {
+      RestrictCodecs(result_or_error.value(),
+                     alphacc_config_->fast_start_video_codec);
     }
   } else {
     RTC_LOG(LS_ERROR) << "OpenVideoCaptureDevice failed";
@@ -541,6 +674,38 @@ void Conductor::AddTracks() {
   main_wnd_->SwitchToStreamingUI();
 }
 
+void Conductor::RestrictCodecs(
+    rtc::scoped_refptr<webrtc::RtpSenderInterface> sender,
+    const std::string& codec_name) {
+  if (codec_name.empty()) {
+    return;
+  }
+  for (const auto& transceiver : peer_connection_->GetTransceivers()) {
+    if (transceiver->sender() != sender) {
+      continue;
+    }
+    std::vector<webrtc::RtpCodecCapability> codecs;
+    for (const webrtc::RtpCodecCapability& codec :
+         peer_connection_factory_
+             ->GetRtpSenderCapabilities(transceiver->media_type())
+             .codecs) {
+      if (absl::EqualsIgnoreCase(codec.name, codec_name) ||
+          codec.name == cricket::kRtxCodecName ||
+          codec.name == cricket::kRedCodecName ||
+          codec.name == cricket::kUlpfecCodecName ||
+          codec.name == cricket::kFlexfecCodecName) {
+        codecs.push_back(codec);
+      }
+    }
+    webrtc::RTCError error = transceiver->SetCodecPreferences(codecs);
+    if (!error.ok()) {
+      RTC_LOG(LS_ERROR) << "Failed to restrict the codecs to " << codec_name
+                        << ": " << error.message();
+    }
+    return;
+  }
+}
+
 void Conductor::UIThreadCallback(int msg_id, void* data) {
   switch (msg_id) {
     case PEER_CONNECTION_CLOSED: {
@@ -597,6 +762,25 @@ void Conductor::OnSuccess(webrtc::SessionDescriptionInterface* desc) {
     return;
   }
 
+  if (alphacc_config_->fast_start) {
+    // Sent with all the candidates once gathering is complete.
+    local_description_pending_ = true;
+    if (peer_connection_->ice_gathering_state() ==
+        webrtc::PeerConnectionInterface::kIceGatheringComplete) {
+      OnIceGatheringChange(
+          webrtc::PeerConnectionInterface::kIceGatheringComplete);
+    }
+    return;
+  }
+
+  SendSessionDescription(desc);
+}
+
+void Conductor::SendSessionDescription(
+    const webrtc::SessionDescriptionInterface* desc) {
+  std::string sdp;
+  desc->ToString(&sdp);
+
   Json::StyledWriter writer;
   Json::Value jmessage;
   jmessage[kSessionDescriptionTypeName] =
@@ -20,9 +20,13 @@
 #include "api/alphacc_config.h"
 #include "api/media_stream_interface.h"
 #include "api/peer_connection_interface.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "examples/peerconnection/serverless/main_wnd.h"
 #include "examples/peerconnection/serverless/peer_connection_client.h"
+#include "examples/peerconnection/serverless/shared_media_resources.h"
 #include "pc/test/fake_video_track_source.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/thread.h"
 #include "test/testsupport/frame_writer.h"
 #include "test/testsupport/video_frame_writer.h"
 
@@ -46,14 +50,36 @@ class Conductor : public webrtc::PeerConnectionObserver,
   };
 
   Conductor(PeerConnectionClient* client, MainWindow* main_wnd);
+  // Runs a session with its own |config|, with the threads, codec factories
+  // and AudioProcessing of |resources| if not null, which may be shared with
+  // other sessions and must outlive this one. Otherwise they are created by
+  // the PeerConnectionFactory.
+  Conductor(PeerConnectionClient* client,
+            MainWindow* main_wnd,
+            const webrtc::AlphaCCConfig* config,
+            SharedMediaResources* resources);
+
+  // Creates the PeerConnectionFactory before the session starts, so that it
+  // is only left to create the PeerConnection.
+  bool PrewarmFactory();
+  // Sets up the PeerConnection before the peer connects, so that only the
+  // offer/answer exchange is left once it does.
+  bool Prewarm();
 
  protected:
   ~Conductor();
+  bool CreatePeerConnectionFactory();
   bool InitializePeerConnection();
   bool ReinitializePeerConnectionForLoopback();
   bool CreatePeerConnection(bool dtls);
   void DeletePeerConnection();
   void AddTracks();
+  // Restricts the codecs negotiated for |sender| to |codec_name|, plus the
+  // retransmission and FEC formats.
+  void RestrictCodecs(rtc::scoped_refptr<webrtc::RtpSenderInterface> sender,
+                      const std::string& codec_name);
+  void StartAutoCloseTimer();
+  void SendSessionDescription(const webrtc::SessionDescriptionInterface* desc);
 
   //
   // PeerConnectionObserver implementation.
@@ -73,7 +99,7 @@ class Conductor : public webrtc::PeerConnectionObserver,
   void OnIceConnectionChange(
       webrtc::PeerConnectionInterface::IceConnectionState new_state) override {}
   void OnIceGatheringChange(
-      webrtc::PeerConnectionInterface::IceGatheringState new_state) override {}
+      webrtc::PeerConnectionInterface::IceGatheringState new_state) override;
   void OnIceCandidate(const webrtc::IceCandidateInterface* candidate) override;
   void OnIceConnectionReceivingChange(bool receiving) override {}
 
@@ -112,10 +138,19 @@ class Conductor : public webrtc::PeerConnectionObserver,
   MainWindow* main_wnd_;
   std::deque<std::string*> pending_messages_;
   const webrtc::AlphaCCConfig* alphacc_config_;
+  SharedMediaResources* const resources_;
   std::shared_ptr<rtc::Event> audio_started_;
+  // For the writers of save_to_file, which must not outlive it.
+  std::unique_ptr<webrtc::TaskQueueFactory> output_task_queue_factory_;
   std::string accumulate_message_;
   std::string part_message_;
   std::unique_ptr<webrtc::test::VideoFrameWriter> frame_writer_;
+  // The DTLS certificate loaded for fast start, if any.
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate_;
+  // With fast start, the local description is sent once ICE gathering is
+  // complete.
+  bool local_description_pending_ = false;
+  bool auto_close_started_ = false;
 };
 
 #endif  // EXAMPLES_PEERCONNECTION_CLIENT_CONDUCTOR_H_
@@ -5,14 +5,18 @@ FileLogSink::FileLogSink(const std::string& log_filepath)
     : log_filepath_(log_filepath) {
   log_file_ = fopen(log_filepath_.c_str(), "a");
   if (log_file_ != NULL) {
-    rtc::LogMessage::AddLogToStream(this, rtc::LoggingSeverity::INFO);
+    async_sink_ = std::make_unique<rtc::AsyncLogSink>(this);
+    rtc::LogMessage::AddLogToStream(async_sink_.get(),
+                                    rtc::LoggingSeverity::INFO);
   }
 }
 
 FileLogSink::~FileLogSink() {
   if (log_file_ != NULL) {
+    rtc::LogMessage::RemoveLogToStream(async_sink_.get());
+    // Writes the queued messages.
+    async_sink_.reset();
     fclose(log_file_);
-    rtc::LogMessage::RemoveLogToStream(this);
   }
 }
 
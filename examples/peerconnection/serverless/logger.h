@@ -1,3 +1,6 @@
+#include <memory>
+
+#include "rtc_base/log_sinks.h"
 #include "rtc_base/logging.h"
 
 class FileLogSink : public rtc::LogSink {
@@ -14,4 +17,7 @@ class FileLogSink : public rtc::LogSink {
  private:
   std::string log_filepath_;
   FILE* log_file_;
+  // Writes to |log_file_| on a thread of its own, so that logging on the
+  // network and worker threads doesn't wait for the disk.
+  std::unique_ptr<rtc::AsyncLogSink> async_sink_;
 };
\ No newline at end of file
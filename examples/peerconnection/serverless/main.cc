@@ -12,6 +12,7 @@
 #include "defaults.h"
 #include "logger.h"
 #include "peer_connection_client.h"
+#include "shared_media_resources.h"
 
 #ifdef WIN32
 #include "rtc_base/win32_socket_init.h"
@@ -21,6 +22,8 @@
 #include "api/alphacc_config.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/string_utils.h"  // For ToUtf8
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/field_trial.h"
 
 #include <chrono>
@@ -29,6 +32,7 @@
 #include <iostream>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include <errno.h>
 #include <stdio.h>
@@ -55,16 +59,10 @@ class MainWindowMock : public MainWindow {
  private:
   std::unique_ptr<VideoRenderer> remote_renderer_;
   MainWndCallback* callback_;
-  std::shared_ptr<rtc::AutoSocketServerThread> socket_thread_;
-  const webrtc::AlphaCCConfig* config_;
-  int close_time_;
+  int64_t close_time_ms_;
 
  public:
-  MainWindowMock(std::shared_ptr<rtc::AutoSocketServerThread> socket_thread)
-      : callback_(NULL),
-        socket_thread_(socket_thread),
-        config_(webrtc::GetAlphaCCConfig()),
-        close_time_(rtc::Thread::kForever) {}
+  MainWindowMock() : callback_(NULL), close_time_ms_(-1) {}
   void RegisterObserver(MainWndCallback* callback) override {
     callback_ = callback;
   }
@@ -96,37 +94,76 @@ class MainWindowMock : public MainWindow {
     callback_->UIThreadCallback(msg_id, data);
   }
 
-  void Run() {
-    if (config_->conn_autoclose != kAutoCloseDisableValue) {
-      while (close_time_ == rtc::Thread::kForever) {
-        RTC_CHECK(socket_thread_->ProcessMessages(0));
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-      }
-      RTC_CHECK(socket_thread_->ProcessMessages(close_time_));
-    } else {
-      socket_thread_->Run();
-    }
+  void StartAutoCloseTimer(int close_time) override {
+    close_time_ms_ = rtc::TimeMillis() + close_time;
+  }
+
+  // Returns true once the auto close timer has expired. Never true if
+  // auto close is disabled.
+  bool IsExpired(int64_t now_ms) const {
+    return close_time_ms_ >= 0 && now_ms >= close_time_ms_;
+  }
+
+  void Close() {
     StopRemoteRenderer();
-    socket_thread_->Stop();
     callback_->Close();
   }
+};
 
-  void StartAutoCloseTimer(int close_time) override {
-    close_time_ = close_time;
-  }
+// One of the sessions run by the process, each with its own configuration.
+struct Session {
+  Session(const webrtc::AlphaCCConfig* config, SharedMediaResources* resources)
+      : conductor(new rtc::RefCountedObject<Conductor>(&client,
+                                                       &wnd,
+                                                       config,
+                                                       resources)) {}
+
+  MainWindowMock wnd;
+  PeerConnectionClient client;
+  rtc::scoped_refptr<Conductor> conductor;
+  bool closed = false;
 };
 
+// Runs the signaling of all sessions on |thread| until every session has
+// been closed by its auto close timer.
+void RunSessions(rtc::Thread* thread,
+                 const std::vector<std::unique_ptr<Session>>& sessions) {
+  const int kPollIntervalMs = 10;
+  size_t open_sessions = sessions.size();
+  while (open_sessions > 0) {
+    RTC_CHECK(thread->ProcessMessages(kPollIntervalMs));
+    int64_t now_ms = rtc::TimeMillis();
+    for (const auto& session : sessions) {
+      if (!session->closed && session->wnd.IsExpired(now_ms)) {
+        session->closed = true;
+        session->wnd.Close();
+        --open_sessions;
+      }
+    }
+  }
+}
+
 int main(int argc, char* argv[]) {
-  if (argc != 2) {
-    fprintf(stderr, "Usage: %s config_file\n", argv[0]);
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s config_file [config_file...]\n", argv[0]);
     exit(EINVAL);
   }
 
+  // The first configuration file is also the one of the process, e.g. for
+  // logging. Each further file adds a session, run on the same threads.
   const auto json_file_path = argv[1];
   if (!webrtc::ParseAlphaCCConfig(json_file_path)) {
     std::cerr << "bad config file" << std::endl;
     exit(EINVAL);
   }
+  std::vector<std::unique_ptr<webrtc::AlphaCCConfig>> session_configs;
+  for (int i = 2; i < argc; ++i) {
+    session_configs.push_back(std::make_unique<webrtc::AlphaCCConfig>());
+    if (!webrtc::ParseAlphaCCConfig(argv[i], session_configs.back().get())) {
+      std::cerr << "bad config file " << argv[i] << std::endl;
+      exit(EINVAL);
+    }
+  }
 
   rtc::LogMessage::LogToDebug(rtc::LS_INFO);
 
@@ -149,24 +186,42 @@ int main(int argc, char* argv[]) {
   rtc::PhysicalSocketServer socket_server;
 #endif
 
-  std::shared_ptr<rtc::AutoSocketServerThread> thread(
-      new rtc::AutoSocketServerThread(&socket_server));
-
-  MainWindowMock wnd(thread);
+  rtc::AutoSocketServerThread thread(&socket_server);
 
   rtc::InitializeSSL();
-  PeerConnectionClient client;
-  rtc::scoped_refptr<Conductor> conductor(
-      new rtc::RefCountedObject<Conductor>(&client, &wnd));
 
-  if (config->is_receiver) {
-    client.StartListen(config->listening_ip, config->listening_port);
-  } else if (config->is_sender) {
-    client.StartConnect(config->dest_ip, config->dest_port);
+  std::vector<const webrtc::AlphaCCConfig*> configs = {config};
+  for (const auto& session_config : session_configs) {
+    configs.push_back(session_config.get());
+  }
+  // Shared by the PeerConnectionFactories of all sessions, which are all
+  // created before any session starts.
+  SharedMediaResources resources(configs);
+  std::vector<std::unique_ptr<Session>> sessions;
+  for (const webrtc::AlphaCCConfig* session_config : configs) {
+    sessions.push_back(std::make_unique<Session>(session_config, &resources));
+    sessions.back()->conductor->PrewarmFactory();
+  }
+  for (size_t i = 0; i < configs.size(); ++i) {
+    const webrtc::AlphaCCConfig* session_config = configs[i];
+    Session* session = sessions[i].get();
+    if (session_config->is_receiver) {
+      if (session_config->fast_start) {
+        session->conductor->Prewarm();
+      }
+      session->client.StartListen(session_config->listening_ip,
+                                  session_config->listening_port,
+                                  session_config->listening_reuse_port);
+    } else if (session_config->is_sender) {
+      session->client.StartConnect(session_config->dest_ip,
+                                   session_config->dest_port);
+    }
   }
 
-  wnd.Run();
+  RunSessions(&thread, sessions);
+  thread.Stop();
+  sessions.clear();
 
   rtc::CleanupSSL();
   return 0;
-}
\ No newline at end of file
+}
@@ -54,10 +54,18 @@ void PeerConnectionClient::RegisterObserver(
   callback_ = callback;
 }
 
-void PeerConnectionClient::StartListen(const std::string& ip, int port) {
+void PeerConnectionClient::StartListen(const std::string& ip,
+                                       int port,
+                                       bool reuse_port) {
   rtc::SocketAddress listening_addr(ip, port);
   listen_socket_.reset(CreateClientSocket(listening_addr.ipaddr().family()));
 
+  reuse_port_ = reuse_port;
+  if (reuse_port_ &&
+      listen_socket_->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0) {
+    RTC_LOG(LS_ERROR) << "Failed to share the listen port " << port;
+  }
+
   int err = listen_socket_->Bind(listening_addr);
   if (err == SOCKET_ERROR) {
     listen_socket_->Close();
@@ -109,6 +117,10 @@ void PeerConnectionClient::OnSenderConnect(rtc::AsyncSocket* socket) {
   message_socket_.reset(socket->Accept(nullptr));
   message_socket_->SignalReadEvent.connect(this,
                                            &PeerConnectionClient::OnGetMessage);
+  if (reuse_port_) {
+    // Leave the following senders to the other receivers on the port.
+    listen_socket_->Close();
+  }
 }
 
 void PeerConnectionClient::OnGetMessage(rtc::AsyncSocket* socket) {
@@ -38,7 +38,9 @@ class PeerConnectionClient : public sigslot::has_slots<> {
   ~PeerConnectionClient();
 
   void RegisterObserver(PeerConnectionClientObserver* callback);
-  void StartListen(const std::string& ip, int port);
+  // With |reuse_port|, other processes may listen on the same port, and only
+  // the first sender connecting is accepted.
+  void StartListen(const std::string& ip, int port, bool reuse_port = false);
   void StartConnect(const std::string& ip, int port);
   void SendClientMessage(const std::string& message);
   void SendAClientMessage(const std::string& message);
@@ -54,6 +56,7 @@ class PeerConnectionClient : public sigslot::has_slots<> {
 
   PeerConnectionClientObserver* callback_;
   std::unique_ptr<rtc::AsyncSocket> listen_socket_;
+  bool reuse_port_ = false;
   std::unique_ptr<rtc::AsyncSocket> message_socket_;
   rtc::CriticalSection cs_;
 };
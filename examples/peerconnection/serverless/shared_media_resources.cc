@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/serverless/shared_media_resources.h"
+
+#include <utility>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/video_codecs/builtin_video_decoder_factory.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_encoder.h"
+#include "modules/remote_bitrate_estimator/onnx_model_registry.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace {
+
+class ForwardingVideoEncoderFactory : public webrtc::VideoEncoderFactory {
+ public:
+  explicit ForwardingVideoEncoderFactory(webrtc::VideoEncoderFactory* factory)
+      : factory_(factory) {}
+
+  std::vector<webrtc::SdpVideoFormat> GetSupportedFormats() const override {
+    return factory_->GetSupportedFormats();
+  }
+  std::vector<webrtc::SdpVideoFormat> GetImplementations() const override {
+    return factory_->GetImplementations();
+  }
+  CodecInfo QueryVideoEncoder(
+      const webrtc::SdpVideoFormat& format) const override {
+    return factory_->QueryVideoEncoder(format);
+  }
+  std::unique_ptr<webrtc::VideoEncoder> CreateVideoEncoder(
+      const webrtc::SdpVideoFormat& format) override {
+    return factory_->CreateVideoEncoder(format);
+  }
+  std::unique_ptr<EncoderSelectorInterface> GetEncoderSelector()
+      const override {
+    return factory_->GetEncoderSelector();
+  }
+
+ private:
+  webrtc::VideoEncoderFactory* const factory_;
+};
+
+class ForwardingVideoDecoderFactory : public webrtc::VideoDecoderFactory {
+ public:
+  explicit ForwardingVideoDecoderFactory(webrtc::VideoDecoderFactory* factory)
+      : factory_(factory) {}
+
+  std::vector<webrtc::SdpVideoFormat> GetSupportedFormats() const override {
+    return factory_->GetSupportedFormats();
+  }
+  std::unique_ptr<webrtc::VideoDecoder> CreateVideoDecoder(
+      const webrtc::SdpVideoFormat& format) override {
+    return factory_->CreateVideoDecoder(format);
+  }
+
+ private:
+  webrtc::VideoDecoderFactory* const factory_;
+};
+
+}  // namespace
+
+SharedMediaResources::SharedMediaResources(
+    const std::vector<const webrtc::AlphaCCConfig*>& configs)
+    : network_thread_(rtc::Thread::CreateWithSocketServer()),
+      worker_thread_(rtc::Thread::Create()),
+      audio_encoder_factory_(webrtc::CreateBuiltinAudioEncoderFactory()),
+      audio_decoder_factory_(webrtc::CreateBuiltinAudioDecoderFactory()),
+      video_encoder_factory_(webrtc::CreateBuiltinVideoEncoderFactory()),
+      video_decoder_factory_(webrtc::CreateBuiltinVideoDecoderFactory()) {
+  network_thread_->SetName("network_thread", nullptr);
+  RTC_CHECK(network_thread_->Start());
+  worker_thread_->SetName("worker_thread", nullptr);
+  RTC_CHECK(worker_thread_->Start());
+
+  for (const webrtc::AlphaCCConfig* config : configs) {
+    audio_processing_.push_back(webrtc::AudioProcessingBuilder().Create());
+    std::shared_ptr<const webrtc::OnnxModel> model =
+        webrtc::PreloadOnnxModel(*config);
+    if (model) {
+      onnx_models_.push_back(std::move(model));
+    } else if (config->bwe_estimator_option ==
+               webrtc::AlphaCCConfig::BweEstimatorOption::kOnnx) {
+      RTC_LOG(LS_WARNING) << "Failed to preload the ONNX model "
+                          << config->onnx_model_path;
+    }
+  }
+}
+
+SharedMediaResources::~SharedMediaResources() = default;
+
+std::unique_ptr<webrtc::VideoEncoderFactory>
+SharedMediaResources::CreateVideoEncoderFactory() {
+  return std::make_unique<ForwardingVideoEncoderFactory>(
+      video_encoder_factory_.get());
+}
+
+std::unique_ptr<webrtc::VideoDecoderFactory>
+SharedMediaResources::CreateVideoDecoderFactory() {
+  return std::make_unique<ForwardingVideoDecoderFactory>(
+      video_decoder_factory_.get());
+}
+
+rtc::scoped_refptr<webrtc::AudioProcessing>
+SharedMediaResources::TakeAudioProcessing() {
+  if (audio_processing_.empty())
+    return webrtc::AudioProcessingBuilder().Create();
+  rtc::scoped_refptr<webrtc::AudioProcessing> audio_processing =
+      std::move(audio_processing_.front());
+  audio_processing_.pop_front();
+  return audio_processing;
+}
@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_SERVERLESS_SHARED_MEDIA_RESOURCES_H_
+#define EXAMPLES_PEERCONNECTION_SERVERLESS_SHARED_MEDIA_RESOURCES_H_
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "api/alphacc_config.h"
+#include "api/audio_codecs/audio_decoder_factory.h"
+#include "api/audio_codecs/audio_encoder_factory.h"
+#include "api/scoped_refptr.h"
+#include "api/video_codecs/video_decoder_factory.h"
+#include "api/video_codecs/video_encoder_factory.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+class OnnxModel;
+}  // namespace webrtc
+
+// The parts of a PeerConnectionFactory that don't depend on the session,
+// set up once when the process starts and shared by the factories of all its
+// sessions, so that a session only creates its audio device and mixer, which
+// can't be shared since they carry its audio.
+class SharedMediaResources {
+ public:
+  // Starts the threads, creates the codec factories and one AudioProcessing
+  // per config, and loads the ONNX models of |configs|.
+  explicit SharedMediaResources(
+      const std::vector<const webrtc::AlphaCCConfig*>& configs);
+  ~SharedMediaResources();
+
+  SharedMediaResources(const SharedMediaResources&) = delete;
+  SharedMediaResources& operator=(const SharedMediaResources&) = delete;
+
+  rtc::Thread* network_thread() { return network_thread_.get(); }
+  rtc::Thread* worker_thread() { return worker_thread_.get(); }
+
+  rtc::scoped_refptr<webrtc::AudioEncoderFactory> audio_encoder_factory() {
+    return audio_encoder_factory_;
+  }
+  rtc::scoped_refptr<webrtc::AudioDecoderFactory> audio_decoder_factory() {
+    return audio_decoder_factory_;
+  }
+  // Return factories forwarding to the shared ones, which outlive them.
+  std::unique_ptr<webrtc::VideoEncoderFactory> CreateVideoEncoderFactory();
+  std::unique_ptr<webrtc::VideoDecoderFactory> CreateVideoDecoderFactory();
+
+  // Returns one of the AudioProcessing created up front, or a new one once
+  // they have all been taken. Each one is used by a single session, as it
+  // holds the state of its capture stream. Must be called on the signaling
+  // thread.
+  rtc::scoped_refptr<webrtc::AudioProcessing> TakeAudioProcessing();
+
+ private:
+  const std::unique_ptr<rtc::Thread> network_thread_;
+  const std::unique_ptr<rtc::Thread> worker_thread_;
+  const rtc::scoped_refptr<webrtc::AudioEncoderFactory> audio_encoder_factory_;
+  const rtc::scoped_refptr<webrtc::AudioDecoderFactory> audio_decoder_factory_;
+  const std::unique_ptr<webrtc::VideoEncoderFactory> video_encoder_factory_;
+  const std::unique_ptr<webrtc::VideoDecoderFactory> video_decoder_factory_;
+  std::deque<rtc::scoped_refptr<webrtc::AudioProcessing>> audio_processing_;
+  // Held so that the estimators of the sessions find the models loaded.
+  std::vector<std::shared_ptr<const webrtc::OnnxModel>> onnx_models_;
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_SERVERLESS_SHARED_MEDIA_RESOURCES_H_
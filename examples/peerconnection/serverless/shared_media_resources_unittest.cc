@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/serverless/shared_media_resources.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/video_codecs/builtin_video_decoder_factory.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "modules/remote_bitrate_estimator/onnx_model_registry.h"
+#include "rtc_base/location.h"
+#include "test/gtest.h"
+
+namespace {
+
+// Loads a fake model per call of CreateModel().
+class FakeOnnxInferBackend : public webrtc::OnnxInferBackend {
+ public:
+  void* CreateModel(const std::string& model_path,
+                    const webrtc::OnnxModelOptions& options) override {
+    ++loads_;
+    return new int(0);
+  }
+  void DestroyModel(void* onnx_infer_model) override {
+    delete static_cast<int*>(onnx_infer_model);
+    ++unloads_;
+  }
+  void* CreateInferInterface(void* onnx_infer_model) override {
+    return onnx_infer_model;
+  }
+  void DestroyInferInterface(void* infer_interface) override {}
+  void OnReceivedBatch(void* infer_interface,
+                       const onnxinfer::PacketFeature* features,
+                       size_t count) override {}
+  bool IsReady(void* infer_interface) override { return true; }
+  void GetEstimates(void* onnx_infer_model,
+                    void* const* infer_interfaces,
+                    size_t count,
+                    float* estimates_bps) override {}
+
+  int loads() const { return loads_; }
+  int unloads() const { return unloads_; }
+
+ private:
+  int loads_ = 0;
+  int unloads_ = 0;
+};
+
+webrtc::AlphaCCConfig CreateConfig(const std::string& onnx_model_path) {
+  webrtc::AlphaCCConfig config;
+  config.bwe_estimator_option =
+      webrtc::AlphaCCConfig::BweEstimatorOption::kOnnx;
+  config.onnx_model_path = onnx_model_path;
+  return config;
+}
+
+class SharedMediaResourcesTest : public ::testing::Test {
+ protected:
+  SharedMediaResourcesTest()
+      : scoped_backend_(&backend_),
+        first_(CreateConfig("first.onnx")),
+        second_(CreateConfig("second.onnx")) {}
+
+  FakeOnnxInferBackend backend_;
+  webrtc::ScopedOnnxInferBackendForTesting scoped_backend_;
+  webrtc::AlphaCCConfig first_;
+  webrtc::AlphaCCConfig second_;
+};
+
+TEST_F(SharedMediaResourcesTest, HoldsThePreloadedModelsOfTheSessions) {
+  webrtc::AlphaCCConfig receive_rate;
+  receive_rate.bwe_estimator_option =
+      webrtc::AlphaCCConfig::BweEstimatorOption::kReceiveRate;
+  {
+    SharedMediaResources resources({&first_, &second_, &receive_rate});
+    EXPECT_EQ(backend_.loads(), 2);
+    // The estimators of the sessions find them loaded.
+    EXPECT_TRUE(webrtc::OnnxModel::Get("first.onnx",
+                                       webrtc::OnnxModelOptions()));
+    EXPECT_TRUE(webrtc::OnnxModel::Get("second.onnx",
+                                       webrtc::OnnxModelOptions()));
+    EXPECT_EQ(backend_.loads(), 2);
+    EXPECT_EQ(backend_.unloads(), 0);
+  }
+  EXPECT_EQ(backend_.unloads(), 2);
+}
+
+TEST_F(SharedMediaResourcesTest, HandsOutOneAudioProcessingPerSession) {
+  SharedMediaResources resources({&first_, &second_});
+  rtc::scoped_refptr<webrtc::AudioProcessing> first =
+      resources.TakeAudioProcessing();
+  rtc::scoped_refptr<webrtc::AudioProcessing> second =
+      resources.TakeAudioProcessing();
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first, second);
+
+  // Created on demand once the prepared ones are taken.
+  rtc::scoped_refptr<webrtc::AudioProcessing> third =
+      resources.TakeAudioProcessing();
+  ASSERT_TRUE(third);
+  EXPECT_NE(third, first);
+  EXPECT_NE(third, second);
+}
+
+TEST_F(SharedMediaResourcesTest, SharesTheCodecFactories) {
+  SharedMediaResources resources({&first_, &second_});
+  EXPECT_EQ(resources.audio_encoder_factory(),
+            resources.audio_encoder_factory());
+  EXPECT_EQ(resources.audio_decoder_factory(),
+            resources.audio_decoder_factory());
+
+  std::unique_ptr<webrtc::VideoEncoderFactory> encoder_factory =
+      resources.CreateVideoEncoderFactory();
+  EXPECT_EQ(encoder_factory->GetSupportedFormats(),
+            webrtc::CreateBuiltinVideoEncoderFactory()->GetSupportedFormats());
+  std::unique_ptr<webrtc::VideoDecoderFactory> decoder_factory =
+      resources.CreateVideoDecoderFactory();
+  EXPECT_EQ(decoder_factory->GetSupportedFormats(),
+            webrtc::CreateBuiltinVideoDecoderFactory()->GetSupportedFormats());
+}
+
+TEST_F(SharedMediaResourcesTest, StartsTheThreads) {
+  SharedMediaResources resources({&first_});
+  ASSERT_TRUE(resources.network_thread());
+  ASSERT_TRUE(resources.worker_thread());
+  EXPECT_NE(resources.network_thread(), resources.worker_thread());
+  EXPECT_TRUE(resources.network_thread()->Invoke<bool>(
+      RTC_FROM_HERE, [&] { return resources.network_thread()->IsCurrent(); }));
+  EXPECT_TRUE(resources.worker_thread()->Invoke<bool>(
+      RTC_FROM_HERE, [&] { return resources.worker_thread()->IsCurrent(); }));
+}
+
+}  // namespace
@@ -66,7 +66,11 @@ int PASCAL wWinMain(HINSTANCE instance,
 
   auto config = webrtc::GetAlphaCCConfig();
   if (config->is_receiver) {
-    client.StartListen(config->listening_ip, config->listening_port);
+    if (config->fast_start) {
+      conductor->Prewarm();
+    }
+    client.StartListen(config->listening_ip, config->listening_port,
+                       config->listening_reuse_port);
   }
   if (config->is_sender) {
     client.StartConnect(config->dest_ip, config->dest_port);
@@ -11,17 +11,20 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "examples/turnserver/read_auth_file.h"
 #include "p2p/base/basic_packet_socket_factory.h"
 #include "p2p/base/port_interface.h"
+#include "p2p/base/sharded_turn_server.h"
 #include "p2p/base/turn_server.h"
 #include "rtc_base/async_udp_socket.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_server.h"
+#include "rtc_base/string_encode.h"
 #include "rtc_base/thread.h"
 
 namespace {
@@ -51,8 +54,8 @@ class TurnFileAuth : public cricket::TurnAuthInterface {
 }  // namespace
 
 int main(int argc, char* argv[]) {
-  if (argc != 5) {
-    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file"
+  if (argc != 5 && argc != 6) {
+    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file [threads]"
               << std::endl;
     return 1;
   }
@@ -69,7 +72,41 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  int num_threads = 1;
+  if (argc == 6 && (!rtc::FromString(argv[5], &num_threads) ||
+                    num_threads < 1)) {
+    std::cerr << "Invalid number of threads: " << argv[5] << std::endl;
+    return 1;
+  }
+
+  std::fstream auth_file(argv[4], std::fstream::in);
+  // Only read after this, so it is safe to use on the threads of all shards.
+  TurnFileAuth auth(auth_file.is_open()
+                        ? webrtc_examples::ReadAuthFile(&auth_file)
+                        : std::map<std::string, std::string>());
+
   rtc::Thread* main = rtc::Thread::Current();
+  if (num_threads > 1) {
+    cricket::ShardedTurnServer::Config config;
+    config.internal_address = int_addr;
+    config.external_ip = ext_addr;
+    config.realm = argv[3];
+    config.software = kSoftware;
+    config.auth_hook = &auth;
+    config.num_shards = num_threads;
+    std::unique_ptr<cricket::ShardedTurnServer> server =
+        cricket::ShardedTurnServer::Create(config);
+    if (!server) {
+      std::cerr << "Failed to bind " << num_threads << " UDP sockets at "
+                << int_addr.ToString() << std::endl;
+      return 1;
+    }
+    std::cout << "Listening internally at " << int_addr.ToString() << " on "
+              << num_threads << " threads" << std::endl;
+    main->Run();
+    return 0;
+  }
+
   rtc::AsyncUDPSocket* int_socket =
       rtc::AsyncUDPSocket::Create(main->socketserver(), int_addr);
   if (!int_socket) {
@@ -79,11 +116,6 @@ int main(int argc, char* argv[]) {
   }
 
   cricket::TurnServer server(main);
-  std::fstream auth_file(argv[4], std::fstream::in);
-
-  TurnFileAuth auth(auth_file.is_open()
-                        ? webrtc_examples::ReadAuthFile(&auth_file)
-                        : std::map<std::string, std::string>());
   server.set_realm(argv[3]);
   server.set_software(kSoftware);
   server.set_auth_hook(&auth);
@@ -31,7 +31,7 @@ uint32_t ConvertPacketLossFractionToProtoFormat(float packet_loss_fraction) {
 
 bool ParsePacketLossFractionFromProtoFormat(uint32_t proto_packet_loss_fraction,
                                             float* output) {
-  if (proto_packet_loss_fraction >= kPacketLossFractionRange) {
+  if (proto_packet_loss_fraction > kPacketLossFractionRange) {
     return false;
   }
   *output = proto_packet_loss_fraction / kPacketLossFractionRangeFloat;
@@ -367,6 +367,7 @@ std::string RtcEventLogEncoderLegacy::Encode(const RtcEvent& event) {
     case RtcEvent::Type::GenericPacketReceived:
     case RtcEvent::Type::GenericPacketSent:
     case RtcEvent::Type::GenericAckReceived:
+    case RtcEvent::Type::AlphaCcEstimate:
       // These are unsupported in the old format, but shouldn't crash.
       return "";
   }
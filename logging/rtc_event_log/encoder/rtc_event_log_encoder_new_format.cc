@@ -15,6 +15,7 @@
 #include "logging/rtc_event_log/encoder/blob_encoding.h"
 #include "logging/rtc_event_log/encoder/delta_encoding.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder_common.h"
+#include "logging/rtc_event_log/events/rtc_event_alpha_cc_estimate.h"
 #include "logging/rtc_event_log/events/rtc_event_alr_state.h"
 #include "logging/rtc_event_log/events/rtc_event_audio_network_adaptation.h"
 #include "logging/rtc_event_log/events/rtc_event_audio_playout.h"
@@ -60,6 +61,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/ignore_wundef.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
 
 // *.pb.h files are generated at build-time by the protobuf compiler.
 RTC_PUSH_IGNORING_WUNDEF()
@@ -75,6 +77,26 @@ using webrtc_event_logging::ToUnsigned;
 namespace webrtc {
 
 namespace {
+rtclog2::AlphaCcEstimates::Source ConvertToProtoFormat(
+    RtcEventAlphaCcEstimate::Source source) {
+  switch (source) {
+    case RtcEventAlphaCcEstimate::Source::kSent:
+      return rtclog2::AlphaCcEstimates::SENT;
+    case RtcEventAlphaCcEstimate::Source::kReceived:
+      return rtclog2::AlphaCcEstimates::RECEIVED;
+  }
+  RTC_NOTREACHED();
+  return rtclog2::AlphaCcEstimates::UNKNOWN_SOURCE;
+}
+
+absl::optional<uint64_t> ConvertFractionToProtoFormat(
+    absl::optional<float> fraction) {
+  if (!fraction)
+    return absl::nullopt;
+  return ConvertPacketLossFractionToProtoFormat(
+      rtc::SafeClamp(*fraction, 0.0f, 1.0f));
+}
+
 rtclog2::DelayBasedBweUpdates::DetectorState ConvertToProtoFormat(
     BandwidthUsage state) {
   switch (state) {
@@ -688,6 +710,7 @@ std::string RtcEventLogEncoderNewFormat::EncodeBatch(
     std::vector<const RtcEventProbeResultSuccess*> probe_result_success_events;
     std::vector<const RtcEventRouteChange*> route_change_events;
     std::vector<const RtcEventRemoteEstimate*> remote_estimate_events;
+    std::vector<const RtcEventAlphaCcEstimate*> alpha_cc_estimate_events;
     std::vector<const RtcEventRtcpPacketIncoming*> incoming_rtcp_packets;
     std::vector<const RtcEventRtcpPacketOutgoing*> outgoing_rtcp_packets;
     std::map<uint32_t /* SSRC */, std::vector<const RtcEventRtpPacketIncoming*>>
@@ -787,6 +810,12 @@ std::string RtcEventLogEncoderNewFormat::EncodeBatch(
           remote_estimate_events.push_back(rtc_event);
           break;
         }
+        case RtcEvent::Type::AlphaCcEstimate: {
+          auto* rtc_event =
+              static_cast<const RtcEventAlphaCcEstimate* const>(it->get());
+          alpha_cc_estimate_events.push_back(rtc_event);
+          break;
+        }
         case RtcEvent::Type::RtcpPacketIncoming: {
           auto* rtc_event =
               static_cast<const RtcEventRtcpPacketIncoming* const>(it->get());
@@ -882,6 +911,7 @@ std::string RtcEventLogEncoderNewFormat::EncodeBatch(
     EncodeProbeResultSuccess(probe_result_success_events, &event_stream);
     EncodeRouteChange(route_change_events, &event_stream);
     EncodeRemoteEstimate(remote_estimate_events, &event_stream);
+    EncodeAlphaCcEstimate(alpha_cc_estimate_events, &event_stream);
     EncodeRtcpPacketIncoming(incoming_rtcp_packets, &event_stream);
     EncodeRtcpPacketOutgoing(outgoing_rtcp_packets, &event_stream);
     EncodeRtpPacketIncoming(incoming_rtp_packets, &event_stream);
@@ -1403,6 +1433,123 @@ void RtcEventLogEncoderNewFormat::EncodeRemoteEstimate(
   }
 }
 
+void RtcEventLogEncoderNewFormat::EncodeAlphaCcEstimate(
+    rtc::ArrayView<const RtcEventAlphaCcEstimate*> batch,
+    rtclog2::EventStream* event_stream) {
+  if (batch.empty())
+    return;
+
+  // Base event
+  const auto* const base_event = batch[0];
+  rtclog2::AlphaCcEstimates* proto_batch =
+      event_stream->add_alpha_cc_estimates();
+  proto_batch->set_timestamp_ms(base_event->timestamp_ms());
+  proto_batch->set_source(ConvertToProtoFormat(base_event->source()));
+  proto_batch->set_target_rate_kbps(
+      base_event->target_rate().kbps<uint32_t>());
+  proto_batch->set_pacing_rate_kbps(
+      base_event->pacing_rate().kbps<uint32_t>());
+  const absl::optional<uint64_t> base_confidence =
+      ConvertFractionToProtoFormat(base_event->confidence());
+  if (base_confidence)
+    proto_batch->set_confidence(*base_confidence);
+  absl::optional<uint64_t> base_rtt_ms;
+  if (base_event->rtt_ms()) {
+    base_rtt_ms = ToUnsigned(*base_event->rtt_ms());
+    proto_batch->set_rtt_ms(*base_rtt_ms);
+  }
+  const absl::optional<uint64_t> base_loss_ratio =
+      ConvertFractionToProtoFormat(base_event->loss_ratio());
+  if (base_loss_ratio)
+    proto_batch->set_loss_ratio(*base_loss_ratio);
+
+  if (batch.size() == 1)
+    return;
+
+  // Delta encoding
+  proto_batch->set_number_of_deltas(batch.size() - 1);
+  std::vector<absl::optional<uint64_t>> values(batch.size() - 1);
+  std::string encoded_deltas;
+
+  // timestamp_ms
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto* event = batch[i + 1];
+    values[i] = ToUnsigned(event->timestamp_ms());
+  }
+  encoded_deltas = EncodeDeltas(ToUnsigned(base_event->timestamp_ms()), values);
+  if (!encoded_deltas.empty()) {
+    proto_batch->set_timestamp_ms_deltas(encoded_deltas);
+  }
+
+  // source
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto* event = batch[i + 1];
+    values[i] = static_cast<uint64_t>(ConvertToProtoFormat(event->source()));
+  }
+  encoded_deltas = EncodeDeltas(
+      static_cast<uint64_t>(ConvertToProtoFormat(base_event->source())),
+      values);
+  if (!encoded_deltas.empty()) {
+    proto_batch->set_source_deltas(encoded_deltas);
+  }
+
+  // target_rate_kbps
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto* event = batch[i + 1];
+    values[i] = event->target_rate().kbps<uint32_t>();
+  }
+  encoded_deltas =
+      EncodeDeltas(base_event->target_rate().kbps<uint32_t>(), values);
+  if (!encoded_deltas.empty()) {
+    proto_batch->set_target_rate_kbps_deltas(encoded_deltas);
+  }
+
+  // pacing_rate_kbps
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto* event = batch[i + 1];
+    values[i] = event->pacing_rate().kbps<uint32_t>();
+  }
+  encoded_deltas =
+      EncodeDeltas(base_event->pacing_rate().kbps<uint32_t>(), values);
+  if (!encoded_deltas.empty()) {
+    proto_batch->set_pacing_rate_kbps_deltas(encoded_deltas);
+  }
+
+  // confidence
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto* event = batch[i + 1];
+    values[i] = ConvertFractionToProtoFormat(event->confidence());
+  }
+  encoded_deltas = EncodeDeltas(base_confidence, values);
+  if (!encoded_deltas.empty()) {
+    proto_batch->set_confidence_deltas(encoded_deltas);
+  }
+
+  // rtt_ms
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto* event = batch[i + 1];
+    if (event->rtt_ms()) {
+      values[i] = ToUnsigned(*event->rtt_ms());
+    } else {
+      values[i].reset();
+    }
+  }
+  encoded_deltas = EncodeDeltas(base_rtt_ms, values);
+  if (!encoded_deltas.empty()) {
+    proto_batch->set_rtt_ms_deltas(encoded_deltas);
+  }
+
+  // loss_ratio
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto* event = batch[i + 1];
+    values[i] = ConvertFractionToProtoFormat(event->loss_ratio());
+  }
+  encoded_deltas = EncodeDeltas(base_loss_ratio, values);
+  if (!encoded_deltas.empty()) {
+    proto_batch->set_loss_ratio_deltas(encoded_deltas);
+  }
+}
+
 void RtcEventLogEncoderNewFormat::EncodeRtcpPacketIncoming(
     rtc::ArrayView<const RtcEventRtcpPacketIncoming*> batch,
     rtclog2::EventStream* event_stream) {
@@ -26,6 +26,7 @@ namespace rtclog2 {
 class EventStream;  // Auto-generated from protobuf.
 }  // namespace rtclog2
 
+class RtcEventAlphaCcEstimate;
 class RtcEventAlrState;
 class RtcEventRouteChange;
 class RtcEventRemoteEstimate;
@@ -126,6 +127,9 @@ class RtcEventLogEncoderNewFormat final : public RtcEventLogEncoder {
                          rtclog2::EventStream* event_stream);
   void EncodeRemoteEstimate(rtc::ArrayView<const RtcEventRemoteEstimate*> batch,
                             rtclog2::EventStream* event_stream);
+  void EncodeAlphaCcEstimate(
+      rtc::ArrayView<const RtcEventAlphaCcEstimate*> batch,
+      rtclog2::EventStream* event_stream);
   void EncodeRtcpPacketIncoming(
       rtc::ArrayView<const RtcEventRtcpPacketIncoming*> batch,
       rtclog2::EventStream* event_stream);
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/events/rtc_event_alpha_cc_estimate.h"
+
+#include "absl/memory/memory.h"
+
+namespace webrtc {
+
+RtcEventAlphaCcEstimate::RtcEventAlphaCcEstimate(
+    Source source,
+    DataRate target_rate,
+    DataRate pacing_rate,
+    absl::optional<float> confidence,
+    absl::optional<int64_t> rtt_ms,
+    absl::optional<float> loss_ratio)
+    : source_(source),
+      target_rate_(target_rate),
+      pacing_rate_(pacing_rate),
+      confidence_(confidence),
+      rtt_ms_(rtt_ms),
+      loss_ratio_(loss_ratio) {}
+
+RtcEventAlphaCcEstimate::RtcEventAlphaCcEstimate(
+    const RtcEventAlphaCcEstimate& other)
+    : RtcEvent(other.timestamp_us_),
+      source_(other.source_),
+      target_rate_(other.target_rate_),
+      pacing_rate_(other.pacing_rate_),
+      confidence_(other.confidence_),
+      rtt_ms_(other.rtt_ms_),
+      loss_ratio_(other.loss_ratio_) {}
+
+RtcEventAlphaCcEstimate::~RtcEventAlphaCcEstimate() = default;
+
+RtcEvent::Type RtcEventAlphaCcEstimate::GetType() const {
+  return RtcEvent::Type::AlphaCcEstimate;
+}
+
+bool RtcEventAlphaCcEstimate::IsConfigEvent() const {
+  return false;
+}
+
+std::unique_ptr<RtcEventAlphaCcEstimate> RtcEventAlphaCcEstimate::Copy()
+    const {
+  return absl::WrapUnique<RtcEventAlphaCcEstimate>(
+      new RtcEventAlphaCcEstimate(*this));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_EVENTS_RTC_EVENT_ALPHA_CC_ESTIMATE_H_
+#define LOGGING_RTC_EVENT_LOG_EVENTS_RTC_EVENT_ALPHA_CC_ESTIMATE_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/rtc_event_log/rtc_event.h"
+#include "api/units/data_rate.h"
+
+namespace webrtc {
+
+// An AlphaCC bandwidth estimate, as sent by the receive side estimator in a
+// BWE message, or as received by the sender.
+class RtcEventAlphaCcEstimate final : public RtcEvent {
+ public:
+  enum class Source { kSent, kReceived };
+
+  RtcEventAlphaCcEstimate(Source source,
+                          DataRate target_rate,
+                          DataRate pacing_rate,
+                          absl::optional<float> confidence,
+                          absl::optional<int64_t> rtt_ms,
+                          absl::optional<float> loss_ratio);
+  ~RtcEventAlphaCcEstimate() override;
+
+  Type GetType() const override;
+
+  bool IsConfigEvent() const override;
+
+  std::unique_ptr<RtcEventAlphaCcEstimate> Copy() const;
+
+  Source source() const { return source_; }
+  DataRate target_rate() const { return target_rate_; }
+  DataRate pacing_rate() const { return pacing_rate_; }
+  // In [0, 1].
+  absl::optional<float> confidence() const { return confidence_; }
+  absl::optional<int64_t> rtt_ms() const { return rtt_ms_; }
+  // In [0, 1].
+  absl::optional<float> loss_ratio() const { return loss_ratio_; }
+
+ private:
+  RtcEventAlphaCcEstimate(const RtcEventAlphaCcEstimate& other);
+
+  const Source source_;
+  const DataRate target_rate_;
+  const DataRate pacing_rate_;
+  const absl::optional<float> confidence_;
+  const absl::optional<int64_t> rtt_ms_;
+  const absl::optional<float> loss_ratio_;
+};
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_EVENTS_RTC_EVENT_ALPHA_CC_ESTIMATE_H_
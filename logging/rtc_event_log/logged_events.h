@@ -18,6 +18,7 @@
 #include "api/units/data_rate.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "logging/rtc_event_log/events/rtc_event_alpha_cc_estimate.h"
 #include "logging/rtc_event_log/events/rtc_event_dtls_transport_state.h"
 #include "logging/rtc_event_log/events/rtc_event_ice_candidate_pair.h"
 #include "logging/rtc_event_log/events/rtc_event_ice_candidate_pair_config.h"
@@ -250,6 +251,21 @@ struct LoggedRemoteEstimateEvent {
   absl::optional<DataRate> link_capacity_upper;
 };
 
+struct LoggedAlphaCcEstimateEvent {
+  LoggedAlphaCcEstimateEvent() = default;
+
+  int64_t log_time_us() const { return timestamp_ms * 1000; }
+  int64_t log_time_ms() const { return timestamp_ms; }
+
+  int64_t timestamp_ms;
+  RtcEventAlphaCcEstimate::Source source;
+  DataRate target_rate = DataRate::Zero();
+  DataRate pacing_rate = DataRate::Zero();
+  absl::optional<float> confidence;
+  absl::optional<int64_t> rtt_ms;
+  absl::optional<float> loss_ratio;
+};
+
 struct LoggedRtpPacket {
   LoggedRtpPacket(int64_t timestamp_us,
                   RTPHeader header,
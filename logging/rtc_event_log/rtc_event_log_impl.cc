@@ -10,6 +10,7 @@
 
 #include "logging/rtc_event_log/rtc_event_log_impl.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -28,6 +29,7 @@
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
@@ -56,7 +58,10 @@ std::unique_ptr<RtcEventLogEncoder> CreateEncoder(
 
 RtcEventLogImpl::RtcEventLogImpl(RtcEventLog::EncodingType encoding_type,
                                  TaskQueueFactory* task_queue_factory)
-    : event_encoder_(CreateEncoder(encoding_type)),
+    : streaming_enabled_("Enabled"),
+      streaming_batch_events_("batch_events", 100),
+      streaming_max_buffered_bytes_("max_buffered_bytes", 256 * 1024),
+      event_encoder_(CreateEncoder(encoding_type)),
       num_config_events_written_(0),
       last_output_ms_(rtc::TimeMillis()),
       output_scheduled_(false),
@@ -64,7 +69,17 @@ RtcEventLogImpl::RtcEventLogImpl(RtcEventLog::EncodingType encoding_type,
       task_queue_(
           std::make_unique<rtc::TaskQueue>(task_queue_factory->CreateTaskQueue(
               "rtc_event_log",
-              TaskQueueFactory::Priority::NORMAL))) {}
+              TaskQueueFactory::Priority::NORMAL))) {
+  ParseFieldTrial({&streaming_enabled_, &streaming_batch_events_,
+                   &streaming_max_buffered_bytes_},
+                  field_trial::FindFullName("WebRTC-RtcEventLogStreaming"));
+  if (streaming_enabled_) {
+    RTC_LOG(LS_INFO) << "Streaming RTC event log, batch_events="
+                     << streaming_batch_events_.Get()
+                     << " max_buffered_bytes="
+                     << streaming_max_buffered_bytes_.Get();
+  }
+}
 
 RtcEventLogImpl::~RtcEventLogImpl() {
   // If we're logging to the output, this will stop that. Blocking function.
@@ -106,6 +121,8 @@ bool RtcEventLogImpl::StartLogging(std::unique_ptr<RtcEventLogOutput> output,
     output_period_ms_ = output_period_ms;
     event_output_ = std::move(output);
     num_config_events_written_ = 0;
+    if (streaming_enabled_)
+      encoded_buffer_.reserve(streaming_max_buffered_bytes_.Get());
     WriteToOutput(event_encoder_->EncodeLogStart(timestamp_us, utc_time_us));
     LogEventsFromMemoryToOutput();
   });
@@ -153,6 +170,18 @@ void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
 
 void RtcEventLogImpl::ScheduleOutput() {
   RTC_DCHECK(event_output_ && event_output_->IsActive());
+  if (streaming_enabled_ && *output_period_ms_ != kImmediateOutput) {
+    if (history_.size() >=
+        static_cast<size_t>(std::max(streaming_batch_events_.Get(), 1))) {
+      EncodeEventsFromMemoryToBuffer();
+    }
+    if (encoded_buffer_.size() >=
+        static_cast<size_t>(streaming_max_buffered_bytes_.Get())) {
+      LogEventsFromMemoryToOutput();
+      return;
+    }
+  }
+
   if (history_.size() >= kMaxEventsInHistory) {
     // We have to emergency drain the buffer. We can't wait for the scheduled
     // output task because there might be other event incoming before that.
@@ -204,18 +233,7 @@ void RtcEventLogImpl::LogEventsFromMemoryToOutput() {
   RTC_DCHECK(event_output_ && event_output_->IsActive());
   last_output_ms_ = rtc::TimeMillis();
 
-  // Serialize all stream configurations that haven't already been written to
-  // this output. |num_config_events_written_| is used to track which configs we
-  // have already written. (Note that the config may have been written to
-  // previous outputs; configs are not discarded.)
-  std::string encoded_configs;
-  RTC_DCHECK_LE(num_config_events_written_, config_history_.size());
-  if (num_config_events_written_ < config_history_.size()) {
-    const auto begin = config_history_.begin() + num_config_events_written_;
-    const auto end = config_history_.end();
-    encoded_configs = event_encoder_->EncodeBatch(begin, end);
-    num_config_events_written_ = config_history_.size();
-  }
+  std::string encoded_configs = EncodeNewConfigs();
 
   // Serialize the events in the event queue. Note that the write may fail,
   // for example if we are writing to a file and have reached the maximum limit.
@@ -228,7 +246,40 @@ void RtcEventLogImpl::LogEventsFromMemoryToOutput() {
       event_encoder_->EncodeBatch(history_.begin(), history_.end());
   history_.clear();
 
-  WriteConfigsAndHistoryToOutput(encoded_configs, encoded_history);
+  if (encoded_buffer_.empty()) {
+    WriteConfigsAndHistoryToOutput(encoded_configs, encoded_history);
+    return;
+  }
+  // Events encoded earlier come first. The buffer keeps its capacity for the
+  // next output period.
+  encoded_buffer_ += encoded_configs;
+  encoded_buffer_ += encoded_history;
+  WriteToOutput(encoded_buffer_);
+  encoded_buffer_.clear();
+}
+
+void RtcEventLogImpl::EncodeEventsFromMemoryToBuffer() {
+  // The configs go first, so that they precede the events that refer to them.
+  encoded_buffer_ += EncodeNewConfigs();
+  encoded_buffer_ +=
+      event_encoder_->EncodeBatch(history_.begin(), history_.end());
+  history_.clear();
+}
+
+std::string RtcEventLogImpl::EncodeNewConfigs() {
+  // Serialize all stream configurations that haven't already been written to
+  // this output. |num_config_events_written_| is used to track which configs we
+  // have already written. (Note that the config may have been written to
+  // previous outputs; configs are not discarded.)
+  std::string encoded_configs;
+  RTC_DCHECK_LE(num_config_events_written_, config_history_.size());
+  if (num_config_events_written_ < config_history_.size()) {
+    const auto begin = config_history_.begin() + num_config_events_written_;
+    const auto end = config_history_.end();
+    encoded_configs = event_encoder_->EncodeBatch(begin, end);
+    num_config_events_written_ = config_history_.size();
+  }
+  return encoded_configs;
 }
 
 void RtcEventLogImpl::WriteConfigsAndHistoryToOutput(
@@ -248,6 +299,8 @@ void RtcEventLogImpl::WriteConfigsAndHistoryToOutput(
 
 void RtcEventLogImpl::StopOutput() {
   event_output_.reset();
+  // Releases the memory too.
+  std::string().swap(encoded_buffer_);
 }
 
 void RtcEventLogImpl::StopLoggingInternal() {
@@ -23,6 +23,7 @@
 #include "api/rtc_event_log_output.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
@@ -50,6 +51,11 @@ class RtcEventLogImpl final : public RtcEventLog {
  private:
   void LogToMemory(std::unique_ptr<RtcEvent> event) RTC_RUN_ON(task_queue_);
   void LogEventsFromMemoryToOutput() RTC_RUN_ON(task_queue_);
+  // Encodes the events in memory to |encoded_buffer_|, see
+  // |streaming_enabled_|.
+  void EncodeEventsFromMemoryToBuffer() RTC_RUN_ON(task_queue_);
+  // Encodes the configs that haven't been written to this output yet.
+  std::string EncodeNewConfigs() RTC_RUN_ON(task_queue_);
 
   void StopOutput() RTC_RUN_ON(task_queue_);
 
@@ -69,6 +75,17 @@ class RtcEventLogImpl final : public RtcEventLog {
   // History containing the most recent (non-configuration) events (~10s).
   std::deque<std::unique_ptr<RtcEvent>> history_ RTC_GUARDED_BY(*task_queue_);
 
+  // If enabled through the WebRTC-RtcEventLogStreaming field trial, events are
+  // encoded every |streaming_batch_events_| events, instead of all at once
+  // every output period, and the output is written as soon as
+  // |streaming_max_buffered_bytes_| have been encoded. This bounds the memory
+  // used and spreads the encoding over the output period.
+  FieldTrialFlag streaming_enabled_;
+  FieldTrialParameter<int> streaming_batch_events_;
+  FieldTrialParameter<int> streaming_max_buffered_bytes_;
+  // Encoded events not written to the output yet.
+  std::string encoded_buffer_ RTC_GUARDED_BY(*task_queue_);
+
   std::unique_ptr<RtcEventLogEncoder> event_encoder_
       RTC_GUARDED_BY(*task_queue_);
   std::unique_ptr<RtcEventLogOutput> event_output_ RTC_GUARDED_BY(*task_queue_);
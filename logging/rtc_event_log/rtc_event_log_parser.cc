@@ -13,14 +13,24 @@
 #include <stdint.h>
 #include <string.h>
 
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <fstream>
 #include <istream>  // no-presubmit-check TODO(webrtc:8982)
+#include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
 #include <utility>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/rtp_headers.h"
@@ -42,6 +52,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/protobuf_utils.h"
 
 // These macros were added to convert existing code using RTC_CHECKs
@@ -110,6 +121,10 @@ constexpr uint16_t kDefaultOverhead =
 constexpr char kIncompleteLogError[] =
     "Could not parse the entire log. Only the beginning will be used.";
 
+// Limits on the messages decoded ahead of being stored, per parse thread.
+constexpr size_t kMaxDecodedEventsPerThread = 1024;
+constexpr size_t kMaxDecodedBytesPerThread = 8 * 1024 * 1024;
+
 struct MediaStreamInfo {
   MediaStreamInfo() = default;
   MediaStreamInfo(LoggedMediaType media_type, bool rtx)
@@ -293,33 +308,201 @@ IceCandidatePairEventType GetRuntimeIceCandidatePairEventType(
   return IceCandidatePairEventType::kCheckSent;
 }
 
-// Reads a VarInt from |stream| and returns it. Also writes the read bytes to
-// |buffer| starting |bytes_written| bytes into the buffer. |bytes_written| is
-// incremented for each written byte.
+// Reads a VarInt from the beginning of |buffer| and returns it. |buffer| is
+// advanced past the read bytes.
 ParsedRtcEventLog::ParseStatusOr<uint64_t> ParseVarInt(
-    std::istream& stream,  // no-presubmit-check TODO(webrtc:8982)
-    char* buffer,
-    size_t* bytes_written) {
+    absl::string_view* buffer) {
   uint64_t varint = 0;
   for (size_t bytes_read = 0; bytes_read < 10; ++bytes_read) {
+    RTC_PARSE_CHECK_OR_RETURN_LT(bytes_read, buffer->size());
     // The most significant bit of each byte is 0 if it is the last byte in
     // the varint and 1 otherwise. Thus, we take the 7 least significant bits
     // of each byte and shift them 7 bits for each byte read previously to get
     // the (unsigned) integer.
-    int byte = stream.get();
-    RTC_PARSE_CHECK_OR_RETURN(!stream.eof());
-    RTC_DCHECK_GE(byte, 0);
-    RTC_DCHECK_LE(byte, 255);
+    const uint8_t byte = static_cast<uint8_t>((*buffer)[bytes_read]);
     varint |= static_cast<uint64_t>(byte & 0x7F) << (7 * bytes_read);
-    buffer[*bytes_written] = byte;
-    *bytes_written += 1;
     if ((byte & 0x80) == 0) {
+      buffer->remove_prefix(bytes_read + 1);
       return varint;
     }
   }
   RTC_PARSE_CHECK_OR_RETURN(false);
 }
 
+// Read-only view of the contents of a file. Where supported, the file is
+// memory mapped rather than read, so that large logs aren't copied before
+// being parsed.
+class FileContents {
+ public:
+  FileContents() = default;
+  FileContents(const FileContents&) = delete;
+  FileContents& operator=(const FileContents&) = delete;
+  ~FileContents() {
+#if defined(WEBRTC_POSIX)
+    if (data_ != nullptr)
+      munmap(data_, size_);
+#endif
+  }
+
+  bool Open(const std::string& file_name) {
+#if defined(WEBRTC_POSIX)
+    const int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+      close(fd);
+      return false;
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    if (size_ > 0) {
+      void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        close(fd);
+        return false;
+      }
+      data_ = data;
+      madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    return true;
+#else
+    std::ifstream file(  // no-presubmit-check TODO(webrtc:8982)
+        file_name, std::ios_base::in | std::ios_base::binary);
+    if (!file.good() || !file.is_open())
+      return false;
+    contents_.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+    return !file.bad();
+#endif
+  }
+
+  absl::string_view data() const {
+#if defined(WEBRTC_POSIX)
+    return absl::string_view(static_cast<const char*>(data_), size_);
+#else
+    return contents_;
+#endif
+  }
+
+ private:
+#if defined(WEBRTC_POSIX)
+  void* data_ = nullptr;
+  size_t size_ = 0;
+#else
+  std::string contents_;
+#endif
+};
+
+// A top-level message of the log, including its field tag and length.
+struct EventFrame {
+  absl::string_view data;
+  bool legacy;
+};
+
+// Splits the next top-level message off the beginning of |stream|.
+ParsedRtcEventLog::ParseStatus ReadEventFrame(absl::string_view* stream,
+                                              EventFrame* frame) {
+  constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
+  const absl::string_view message_begin = *stream;
+
+  // Read the next message tag. Protobuf defines the message tag as
+  // (field_number << 3) | wire_type. In the legacy encoding, the field number
+  // is supposed to be 1 and the wire type for a length-delimited field is 2.
+  // In the new encoding we still expect the wire type to be 2, but the field
+  // number will be greater than 1.
+  constexpr uint64_t kExpectedV1Tag = (1 << 3) | 2;
+  ParsedRtcEventLog::ParseStatusOr<uint64_t> tag = ParseVarInt(stream);
+  if (!tag.ok()) {
+    RTC_LOG(LS_WARNING)
+        << "Missing field tag from beginning of protobuf event.";
+    return tag.status();
+  }
+  constexpr uint64_t kWireTypeMask = 0x07;
+  const uint64_t wire_type = tag.value() & kWireTypeMask;
+  if (wire_type != 2) {
+    RTC_LOG(LS_WARNING) << "Expected field tag with wire type 2 (length "
+                           "delimited message). Found wire type "
+                        << wire_type;
+    RTC_PARSE_CHECK_OR_RETURN_EQ(wire_type, 2);
+  }
+
+  // Read the length field.
+  ParsedRtcEventLog::ParseStatusOr<uint64_t> message_length =
+      ParseVarInt(stream);
+  if (!message_length.ok()) {
+    RTC_LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
+    return message_length.status();
+  } else if (message_length.value() > kMaxEventSize) {
+    RTC_LOG(LS_WARNING) << "Protobuf message length is too large.";
+    RTC_PARSE_CHECK_OR_RETURN_LE(message_length.value(), kMaxEventSize);
+  }
+
+  if (stream->size() < message_length.value()) {
+    RTC_LOG(LS_WARNING) << "Failed to read protobuf message.";
+    RTC_PARSE_CHECK_OR_RETURN(false);
+  }
+  stream->remove_prefix(message_length.value());
+  frame->data = message_begin.substr(0, message_begin.size() - stream->size());
+  frame->legacy = tag.value() == kExpectedV1Tag;
+  return ParsedRtcEventLog::ParseStatus::Success();
+}
+
+// Protobuf decoding of a top-level message. Only the member matching the
+// format of the message is used.
+struct DecodedEvent {
+  bool ok = false;
+  rtclog::EventStream legacy_stream;
+  rtclog2::EventStream new_stream;
+};
+
+struct DecodeTask {
+  const std::vector<EventFrame>* frames;
+  std::vector<DecodedEvent>* events;
+  size_t first;
+  size_t stride;
+};
+
+// Decodes every |stride|th message, starting at |first|.
+void DecodeEvents(void* obj) {
+  const DecodeTask* task = static_cast<const DecodeTask*>(obj);
+  for (size_t i = task->first; i < task->frames->size(); i += task->stride) {
+    const EventFrame& frame = (*task->frames)[i];
+    DecodedEvent& event = (*task->events)[i];
+    if (frame.legacy) {
+      event.ok = event.legacy_stream.ParseFromArray(frame.data.data(),
+                                                    frame.data.size());
+    } else {
+      event.ok =
+          event.new_stream.ParseFromArray(frame.data.data(), frame.data.size());
+    }
+  }
+}
+
+// Decodes |frames| into |events|, spreading the work over |num_threads|
+// threads.
+void DecodeEventFrames(const std::vector<EventFrame>& frames,
+                       size_t num_threads,
+                       std::vector<DecodedEvent>* events) {
+  num_threads = std::min(num_threads, frames.size());
+  std::vector<DecodeTask> tasks;
+  for (size_t i = 0; i < num_threads; ++i)
+    tasks.push_back(DecodeTask{&frames, events, i, num_threads});
+
+  // This thread takes the first share of the messages.
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &DecodeEvents, &tasks[i], "rtc_event_log_parse"));
+    threads.back()->Start();
+  }
+  if (num_threads > 0)
+    DecodeEvents(&tasks[0]);
+  for (auto& thread : threads)
+    thread->Stop();
+}
+
 ParsedRtcEventLog::ParseStatus GetHeaderExtensions(
     std::vector<RtpExtension>* header_extensions,
     const RepeatedPtrField<rtclog::RtpHeaderExtension>&
@@ -770,6 +953,22 @@ BandwidthUsage GetRuntimeDetectorState(
   return BandwidthUsage::kBwNormal;
 }
 
+bool GetRuntimeAlphaCcEstimateSource(
+    rtclog2::AlphaCcEstimates::Source proto_source,
+    RtcEventAlphaCcEstimate::Source* source) {
+  switch (proto_source) {
+    case rtclog2::AlphaCcEstimates::SENT:
+      *source = RtcEventAlphaCcEstimate::Source::kSent;
+      return true;
+    case rtclog2::AlphaCcEstimates::RECEIVED:
+      *source = RtcEventAlphaCcEstimate::Source::kReceived;
+      return true;
+    case rtclog2::AlphaCcEstimates::UNKNOWN_SOURCE:
+      break;
+  }
+  return false;
+}
+
 ProbeFailureReason GetRuntimeProbeFailureReason(
     rtclog2::BweProbeResultFailure::FailureReason failure) {
   switch (failure) {
@@ -1012,10 +1211,13 @@ ParsedRtcEventLog::GetDefaultHeaderExtensionMap() {
 
 ParsedRtcEventLog::ParsedRtcEventLog(
     UnconfiguredHeaderExtensions parse_unconfigured_header_extensions,
-    bool allow_incomplete_logs)
+    bool allow_incomplete_logs,
+    int num_parse_threads)
     : parse_unconfigured_header_extensions_(
           parse_unconfigured_header_extensions),
-      allow_incomplete_logs_(allow_incomplete_logs) {
+      allow_incomplete_logs_(allow_incomplete_logs),
+      num_parse_threads_(num_parse_threads) {
+  RTC_DCHECK_GE(num_parse_threads_, 1);
   Clear();
 }
 
@@ -1083,27 +1285,32 @@ void ParsedRtcEventLog::Clear() {
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseFile(
     const std::string& filename) {
-  std::ifstream file(  // no-presubmit-check TODO(webrtc:8982)
-      filename, std::ios_base::in | std::ios_base::binary);
-  if (!file.good() || !file.is_open()) {
+  FileContents file;
+  const bool file_opened = file.Open(filename);
+  if (!file_opened) {
     RTC_LOG(LS_WARNING) << "Could not open file for reading.";
-    RTC_PARSE_CHECK_OR_RETURN(file.good() && file.is_open());
+    RTC_PARSE_CHECK_OR_RETURN(file_opened);
   }
 
-  return ParseStream(file);
+  return ParseBuffer(file.data());
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseString(
     const std::string& s) {
-  std::istringstream stream(  // no-presubmit-check TODO(webrtc:8982)
-      s, std::ios_base::in | std::ios_base::binary);
-  return ParseStream(stream);
+  return ParseBuffer(s);
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
     std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
+  const std::string s((std::istreambuf_iterator<char>(stream)),
+                      std::istreambuf_iterator<char>());
+  return ParseBuffer(s);
+}
+
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseBuffer(
+    absl::string_view buffer) {
   Clear();
-  ParseStatus status = ParseStreamInternal(stream);
+  ParseStatus status = ParseStreamInternal(buffer);
 
   // Cache the configured SSRCs.
   for (const auto& video_recv_config : video_recv_configs()) {
@@ -1189,6 +1396,7 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
   last_timestamp_ = std::numeric_limits<int64_t>::min();
   StoreFirstAndLastTimestamp(alr_state_events());
   StoreFirstAndLastTimestamp(route_change_events());
+  StoreFirstAndLastTimestamp(alpha_cc_estimate_events());
   for (const auto& audio_stream : audio_playout_events()) {
     // Audio playout events are grouped by SSRC.
     StoreFirstAndLastTimestamp(audio_stream.second);
@@ -1219,97 +1427,62 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
-    std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
-  constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
-  std::vector<char> buffer(0xFFFF);
-
-  RTC_DCHECK(stream.good());
-  while (1) {
-    // Check whether we have reached end of file.
-    stream.peek();
-    if (stream.eof()) {
-      break;
-    }
-
-    // Read the next message tag. Protobuf defines the message tag as
-    // (field_number << 3) | wire_type. In the legacy encoding, the field number
-    // is supposed to be 1 and the wire type for a length-delimited field is 2.
-    // In the new encoding we still expect the wire type to be 2, but the field
-    // number will be greater than 1.
-    constexpr uint64_t kExpectedV1Tag = (1 << 3) | 2;
-    size_t bytes_written = 0;
-    ParsedRtcEventLog::ParseStatusOr<uint64_t> tag =
-        ParseVarInt(stream, buffer.data(), &bytes_written);
-    if (!tag.ok()) {
-      RTC_LOG(LS_WARNING)
-          << "Missing field tag from beginning of protobuf event.";
-      RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
-                                           kIncompleteLogError);
-      return tag.status();
-    }
-    constexpr uint64_t kWireTypeMask = 0x07;
-    const uint64_t wire_type = tag.value() & kWireTypeMask;
-    if (wire_type != 2) {
-      RTC_LOG(LS_WARNING) << "Expected field tag with wire type 2 (length "
-                             "delimited message). Found wire type "
-                          << wire_type;
-      RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
-                                           kIncompleteLogError);
-      RTC_PARSE_CHECK_OR_RETURN_EQ(wire_type, 2);
-    }
+    absl::string_view stream) {
+  // The messages are decoded in batches, so that the decoding can be spread
+  // over |num_parse_threads_| threads while bounding the memory used by the
+  // decoded protobufs. Storing the events depends on the configs seen
+  // earlier in the log, so that is still done in order on this thread.
+  const size_t max_batch_events =
+      kMaxDecodedEventsPerThread * num_parse_threads_;
+  const size_t max_batch_bytes =
+      kMaxDecodedBytesPerThread * num_parse_threads_;
+  while (!stream.empty()) {
+    std::vector<EventFrame> frames;
+    size_t batch_bytes = 0;
+    ParseStatus frame_status = ParseStatus::Success();
+    while (!stream.empty() && frames.size() < max_batch_events &&
+           batch_bytes < max_batch_bytes) {
+      EventFrame frame;
+      frame_status = ReadEventFrame(&stream, &frame);
+      if (!frame_status.ok())
+        break;
+      batch_bytes += frame.data.size();
+      frames.push_back(frame);
+    }
+
+    std::vector<DecodedEvent> events(frames.size());
+    DecodeEventFrames(frames, num_parse_threads_, &events);
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+      if (frames[i].legacy) {
+        if (!events[i].ok) {
+          RTC_LOG(LS_WARNING)
+              << "Failed to parse legacy-format protobuf message.";
+          RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
+                                               kIncompleteLogError);
+          RTC_PARSE_CHECK_OR_RETURN(false);
+        }
 
-    // Read the length field.
-    ParsedRtcEventLog::ParseStatusOr<uint64_t> message_length =
-        ParseVarInt(stream, buffer.data(), &bytes_written);
-    if (!message_length.ok()) {
-      RTC_LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
-      RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
-                                           kIncompleteLogError);
-      return message_length.status();
-    } else if (message_length.value() > kMaxEventSize) {
-      RTC_LOG(LS_WARNING) << "Protobuf message length is too large.";
-      RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
-                                           kIncompleteLogError);
-      RTC_PARSE_CHECK_OR_RETURN_LE(message_length.value(), kMaxEventSize);
+        const rtclog::EventStream& event_stream = events[i].legacy_stream;
+        RTC_PARSE_CHECK_OR_RETURN_EQ(event_stream.stream_size(), 1);
+        auto status = StoreParsedLegacyEvent(event_stream.stream(0));
+        RTC_RETURN_IF_ERROR(status);
+      } else {
+        if (!events[i].ok) {
+          RTC_LOG(LS_WARNING) << "Failed to parse new-format protobuf message.";
+          RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
+                                               kIncompleteLogError);
+          RTC_PARSE_CHECK_OR_RETURN(false);
+        }
+        auto status = StoreParsedNewFormatEvent(events[i].new_stream);
+        RTC_RETURN_IF_ERROR(status);
+      }
     }
 
-    // Read the next protobuf event to a temporary char buffer.
-    if (buffer.size() < bytes_written + message_length.value())
-      buffer.resize(bytes_written + message_length.value());
-    stream.read(buffer.data() + bytes_written, message_length.value());
-    if (stream.gcount() != static_cast<int>(message_length.value())) {
-      RTC_LOG(LS_WARNING) << "Failed to read protobuf message.";
+    if (!frame_status.ok()) {
       RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
                                            kIncompleteLogError);
-      RTC_PARSE_CHECK_OR_RETURN(false);
-    }
-    size_t buffer_size = bytes_written + message_length.value();
-
-    if (tag.value() == kExpectedV1Tag) {
-      // Parse the protobuf event from the buffer.
-      rtclog::EventStream event_stream;
-      if (!event_stream.ParseFromArray(buffer.data(), buffer_size)) {
-        RTC_LOG(LS_WARNING)
-            << "Failed to parse legacy-format protobuf message.";
-        RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
-                                             kIncompleteLogError);
-        RTC_PARSE_CHECK_OR_RETURN(false);
-      }
-
-      RTC_PARSE_CHECK_OR_RETURN_EQ(event_stream.stream_size(), 1);
-      auto status = StoreParsedLegacyEvent(event_stream.stream(0));
-      RTC_RETURN_IF_ERROR(status);
-    } else {
-      // Parse the protobuf event from the buffer.
-      rtclog2::EventStream event_stream;
-      if (!event_stream.ParseFromArray(buffer.data(), buffer_size)) {
-        RTC_LOG(LS_WARNING) << "Failed to parse new-format protobuf message.";
-        RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
-                                             kIncompleteLogError);
-        RTC_PARSE_CHECK_OR_RETURN(false);
-      }
-      auto status = StoreParsedNewFormatEvent(event_stream);
-      RTC_RETURN_IF_ERROR(status);
+      return frame_status;
     }
   }
   return ParseStatus::Success();
@@ -2344,6 +2517,8 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::StoreParsedNewFormatEvent(
     return StoreRouteChangeEvent(stream.route_changes(0));
   } else if (stream.remote_estimates_size() == 1) {
     return StoreRemoteEstimateEvent(stream.remote_estimates(0));
+  } else if (stream.alpha_cc_estimates_size() == 1) {
+    return StoreAlphaCcEstimateEvent(stream.alpha_cc_estimates(0));
   } else if (stream.ice_candidate_configs_size() == 1) {
     return StoreIceCandidatePairConfig(stream.ice_candidate_configs(0));
   } else if (stream.ice_candidate_events_size() == 1) {
@@ -2461,6 +2636,131 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::StoreRemoteEstimateEvent(
   return ParseStatus::Success();
 }
 
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::StoreAlphaCcEstimateEvent(
+    const rtclog2::AlphaCcEstimates& proto) {
+  RTC_PARSE_CHECK_OR_RETURN(proto.has_timestamp_ms());
+  RTC_PARSE_CHECK_OR_RETURN(proto.has_source());
+  RTC_PARSE_CHECK_OR_RETURN(proto.has_target_rate_kbps());
+  RTC_PARSE_CHECK_OR_RETURN(proto.has_pacing_rate_kbps());
+
+  // Base event
+  LoggedAlphaCcEstimateEvent base_event;
+  base_event.timestamp_ms = proto.timestamp_ms();
+  RTC_PARSE_CHECK_OR_RETURN(
+      GetRuntimeAlphaCcEstimateSource(proto.source(), &base_event.source));
+  base_event.target_rate = DataRate::KilobitsPerSec(proto.target_rate_kbps());
+  base_event.pacing_rate = DataRate::KilobitsPerSec(proto.pacing_rate_kbps());
+
+  absl::optional<uint64_t> base_confidence;
+  if (proto.has_confidence()) {
+    base_confidence = proto.confidence();
+    float confidence;
+    RTC_PARSE_CHECK_OR_RETURN(ParsePacketLossFractionFromProtoFormat(
+        proto.confidence(), &confidence));
+    base_event.confidence = confidence;
+  }
+  absl::optional<uint64_t> base_rtt_ms;
+  if (proto.has_rtt_ms()) {
+    base_rtt_ms = proto.rtt_ms();
+    base_event.rtt_ms = proto.rtt_ms();
+  }
+  absl::optional<uint64_t> base_loss_ratio;
+  if (proto.has_loss_ratio()) {
+    base_loss_ratio = proto.loss_ratio();
+    float loss_ratio;
+    RTC_PARSE_CHECK_OR_RETURN(ParsePacketLossFractionFromProtoFormat(
+        proto.loss_ratio(), &loss_ratio));
+    base_event.loss_ratio = loss_ratio;
+  }
+
+  alpha_cc_estimate_events_.push_back(base_event);
+
+  const size_t number_of_deltas =
+      proto.has_number_of_deltas() ? proto.number_of_deltas() : 0u;
+  if (number_of_deltas == 0) {
+    return ParseStatus::Success();
+  }
+
+  // timestamp_ms
+  auto timestamp_ms_values =
+      DecodeDeltas(proto.timestamp_ms_deltas(),
+                   ToUnsigned(proto.timestamp_ms()), number_of_deltas);
+  RTC_PARSE_CHECK_OR_RETURN_EQ(timestamp_ms_values.size(), number_of_deltas);
+
+  // source
+  auto source_values =
+      DecodeDeltas(proto.source_deltas(),
+                   static_cast<uint64_t>(proto.source()), number_of_deltas);
+  RTC_PARSE_CHECK_OR_RETURN_EQ(source_values.size(), number_of_deltas);
+
+  // target_rate_kbps
+  auto target_rate_kbps_values =
+      DecodeDeltas(proto.target_rate_kbps_deltas(), proto.target_rate_kbps(),
+                   number_of_deltas);
+  RTC_PARSE_CHECK_OR_RETURN_EQ(target_rate_kbps_values.size(),
+                               number_of_deltas);
+
+  // pacing_rate_kbps
+  auto pacing_rate_kbps_values =
+      DecodeDeltas(proto.pacing_rate_kbps_deltas(), proto.pacing_rate_kbps(),
+                   number_of_deltas);
+  RTC_PARSE_CHECK_OR_RETURN_EQ(pacing_rate_kbps_values.size(),
+                               number_of_deltas);
+
+  // confidence
+  auto confidence_values = DecodeDeltas(proto.confidence_deltas(),
+                                        base_confidence, number_of_deltas);
+  RTC_PARSE_CHECK_OR_RETURN_EQ(confidence_values.size(), number_of_deltas);
+
+  // rtt_ms
+  auto rtt_ms_values =
+      DecodeDeltas(proto.rtt_ms_deltas(), base_rtt_ms, number_of_deltas);
+  RTC_PARSE_CHECK_OR_RETURN_EQ(rtt_ms_values.size(), number_of_deltas);
+
+  // loss_ratio
+  auto loss_ratio_values = DecodeDeltas(proto.loss_ratio_deltas(),
+                                        base_loss_ratio, number_of_deltas);
+  RTC_PARSE_CHECK_OR_RETURN_EQ(loss_ratio_values.size(), number_of_deltas);
+
+  // Delta decoding
+  for (size_t i = 0; i < number_of_deltas; ++i) {
+    LoggedAlphaCcEstimateEvent event;
+    RTC_PARSE_CHECK_OR_RETURN(timestamp_ms_values[i].has_value());
+    RTC_PARSE_CHECK_OR_RETURN(
+        ToSigned(timestamp_ms_values[i].value(), &event.timestamp_ms));
+    RTC_PARSE_CHECK_OR_RETURN(source_values[i].has_value());
+    RTC_PARSE_CHECK_OR_RETURN(GetRuntimeAlphaCcEstimateSource(
+        static_cast<rtclog2::AlphaCcEstimates::Source>(
+            source_values[i].value()),
+        &event.source));
+    RTC_PARSE_CHECK_OR_RETURN(target_rate_kbps_values[i].has_value());
+    event.target_rate =
+        DataRate::KilobitsPerSec(target_rate_kbps_values[i].value());
+    RTC_PARSE_CHECK_OR_RETURN(pacing_rate_kbps_values[i].has_value());
+    event.pacing_rate =
+        DataRate::KilobitsPerSec(pacing_rate_kbps_values[i].value());
+    if (confidence_values[i].has_value()) {
+      float confidence;
+      RTC_PARSE_CHECK_OR_RETURN(ParsePacketLossFractionFromProtoFormat(
+          rtc::checked_cast<uint32_t>(confidence_values[i].value()),
+          &confidence));
+      event.confidence = confidence;
+    }
+    if (rtt_ms_values[i].has_value()) {
+      event.rtt_ms = rtc::checked_cast<int64_t>(rtt_ms_values[i].value());
+    }
+    if (loss_ratio_values[i].has_value()) {
+      float loss_ratio;
+      RTC_PARSE_CHECK_OR_RETURN(ParsePacketLossFractionFromProtoFormat(
+          rtc::checked_cast<uint32_t>(loss_ratio_values[i].value()),
+          &loss_ratio));
+      event.loss_ratio = loss_ratio;
+    }
+    alpha_cc_estimate_events_.push_back(event);
+  }
+  return ParseStatus::Success();
+}
+
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::StoreAudioPlayoutEvent(
     const rtclog2::AudioPlayoutEvents& proto) {
   RTC_PARSE_CHECK_OR_RETURN(proto.has_timestamp_ms());
@@ -18,6 +18,7 @@
 #include <utility>  // pair
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "call/video_receive_stream.h"
 #include "call/video_send_stream.h"
@@ -332,10 +333,13 @@ class ParsedRtcEventLog {
 
   static webrtc::RtpHeaderExtensionMap GetDefaultHeaderExtensionMap();
 
+  // The protobuf decoding of the log is spread over |num_parse_threads|
+  // threads, which speeds up parsing of large logs.
   explicit ParsedRtcEventLog(
       UnconfiguredHeaderExtensions parse_unconfigured_header_extensions =
           UnconfiguredHeaderExtensions::kDontParse,
-      bool allow_incomplete_log = false);
+      bool allow_incomplete_log = false,
+      int num_parse_threads = 1);
 
   ~ParsedRtcEventLog();
 
@@ -344,6 +348,7 @@ class ParsedRtcEventLog {
   void Clear();
 
   // Reads an RtcEventLog file and returns success if parsing was successful.
+  // Where supported, the file is memory mapped instead of read into memory.
   ParseStatus ParseFile(const std::string& file_name);
 
   // Reads an RtcEventLog from a string and returns success if successful.
@@ -473,6 +478,11 @@ class ParsedRtcEventLog {
     return remote_estimate_events_;
   }
 
+  const std::vector<LoggedAlphaCcEstimateEvent>& alpha_cc_estimate_events()
+      const {
+    return alpha_cc_estimate_events_;
+  }
+
   // RTP
   const std::vector<LoggedRtpStreamIncoming>& incoming_rtp_packets_by_ssrc()
       const {
@@ -610,8 +620,9 @@ class ParsedRtcEventLog {
   std::vector<InferredRouteChangeEvent> GetRouteChanges() const;
 
  private:
-  ABSL_MUST_USE_RESULT ParseStatus ParseStreamInternal(
-      std::istream& stream);  // no-presubmit-check TODO(webrtc:8982)
+  ABSL_MUST_USE_RESULT ParseStatus ParseBuffer(absl::string_view buffer);
+  ABSL_MUST_USE_RESULT ParseStatus
+  ParseStreamInternal(absl::string_view stream);
 
   ABSL_MUST_USE_RESULT ParseStatus
   StoreParsedLegacyEvent(const rtclog::Event& event);
@@ -726,6 +737,7 @@ class ParsedRtcEventLog {
   ParseStatus StoreParsedNewFormatEvent(const rtclog2::EventStream& event);
   ParseStatus StoreRouteChangeEvent(const rtclog2::RouteChange& proto);
   ParseStatus StoreRemoteEstimateEvent(const rtclog2::RemoteEstimates& proto);
+  ParseStatus StoreAlphaCcEstimateEvent(const rtclog2::AlphaCcEstimates& proto);
   ParseStatus StoreStartEvent(const rtclog2::BeginLogEvent& proto);
   ParseStatus StoreStopEvent(const rtclog2::EndLogEvent& proto);
   ParseStatus StoreVideoRecvConfig(const rtclog2::VideoRecvStreamConfig& proto);
@@ -749,6 +761,7 @@ class ParsedRtcEventLog {
 
   const UnconfiguredHeaderExtensions parse_unconfigured_header_extensions_;
   const bool allow_incomplete_logs_;
+  const int num_parse_threads_;
 
   // Make a default extension map for streams without configuration information.
   // TODO(ivoc): Once configuration of audio streams is stored in the event log,
@@ -843,6 +856,7 @@ class ParsedRtcEventLog {
 
   std::vector<LoggedRouteChangeEvent> route_change_events_;
   std::vector<LoggedRemoteEstimateEvent> remote_estimate_events_;
+  std::vector<LoggedAlphaCcEstimateEvent> alpha_cc_estimate_events_;
 
   uint8_t last_incoming_rtcp_packet_[IP_PACKET_SIZE];
   uint8_t last_incoming_rtcp_packet_length_;
@@ -49,6 +49,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/random.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
@@ -128,7 +129,7 @@ class RtcEventLogSession
   // randomized non-config events. Then call StartLogging and finally create and
   // write the remaining non-config events.
   void WriteLog(EventCounts count, size_t num_events_before_log_start);
-  void ReadAndVerifyLog();
+  void ReadAndVerifyLog(int num_parse_threads = 1);
 
   bool IsNewFormat() {
     return encoding_type_ == RtcEventLog::EncodingType::NewFormat;
@@ -542,9 +543,11 @@ void RtcEventLogSession::WriteLog(EventCounts count,
 
 // Read the file and verify that what we read back from the event log is the
 // same as what we wrote down.
-void RtcEventLogSession::ReadAndVerifyLog() {
+void RtcEventLogSession::ReadAndVerifyLog(int num_parse_threads) {
   // Read the generated file from disk.
-  ParsedRtcEventLog parsed_log;
+  ParsedRtcEventLog parsed_log(
+      ParsedRtcEventLog::UnconfiguredHeaderExtensions::kDontParse,
+      /*allow_incomplete_log=*/false, num_parse_threads);
   ASSERT_TRUE(parsed_log.ParseFile(temp_filename_).ok());
 
   // Start and stop events.
@@ -778,6 +781,76 @@ TEST_P(RtcEventLogSession, StartLoggingFromBeginning) {
   ReadAndVerifyLog();
 }
 
+TEST_P(RtcEventLogSession, StartLoggingFromBeginningWithStreaming) {
+  // Small enough for both the batches and the buffer limit to kick in.
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-RtcEventLogStreaming/"
+      "Enabled,batch_events:10,max_buffered_bytes:2000/");
+  EventCounts count;
+  count.audio_send_streams = 2;
+  count.audio_recv_streams = 2;
+  count.video_send_streams = 3;
+  count.video_recv_streams = 4;
+  count.alr_states = 4;
+  count.audio_playouts = 100;
+  count.ana_configs = 3;
+  count.bwe_loss_events = 20;
+  count.bwe_delay_events = 20;
+  count.dtls_transport_states = 4;
+  count.dtls_writable_states = 2;
+  count.probe_creations = 4;
+  count.probe_successes = 2;
+  count.probe_failures = 2;
+  count.ice_configs = 3;
+  count.ice_events = 10;
+  count.incoming_rtp_packets = 100;
+  count.outgoing_rtp_packets = 100;
+  count.incoming_rtcp_packets = 20;
+  count.outgoing_rtcp_packets = 20;
+  if (IsNewFormat()) {
+    count.route_changes = 4;
+    count.generic_packets_sent = 100;
+    count.generic_packets_received = 100;
+    count.generic_acks_received = 20;
+  }
+
+  WriteLog(count, 0);
+  ReadAndVerifyLog();
+}
+
+TEST_P(RtcEventLogSession, StartLoggingFromBeginningWithParallelParsing) {
+  EventCounts count;
+  count.audio_send_streams = 2;
+  count.audio_recv_streams = 2;
+  count.video_send_streams = 3;
+  count.video_recv_streams = 4;
+  count.alr_states = 4;
+  count.audio_playouts = 100;
+  count.ana_configs = 3;
+  count.bwe_loss_events = 20;
+  count.bwe_delay_events = 20;
+  count.dtls_transport_states = 4;
+  count.dtls_writable_states = 2;
+  count.probe_creations = 4;
+  count.probe_successes = 2;
+  count.probe_failures = 2;
+  count.ice_configs = 3;
+  count.ice_events = 10;
+  count.incoming_rtp_packets = 100;
+  count.outgoing_rtp_packets = 100;
+  count.incoming_rtcp_packets = 20;
+  count.outgoing_rtcp_packets = 20;
+  if (IsNewFormat()) {
+    count.route_changes = 4;
+    count.generic_packets_sent = 100;
+    count.generic_packets_received = 100;
+    count.generic_acks_received = 20;
+  }
+
+  WriteLog(count, 0);
+  ReadAndVerifyLog(/*num_parse_threads=*/4);
+}
+
 TEST_P(RtcEventLogSession, StartLoggingInTheMiddle) {
   EventCounts count;
   count.audio_send_streams = 3;
@@ -362,6 +362,24 @@ std::unique_ptr<RtcEventRemoteEstimate> EventGenerator::NewRemoteEstimate() {
       DataRate::KilobitsPerSec(prng_.Rand(0, 100000)));
 }
 
+std::unique_ptr<RtcEventAlphaCcEstimate> EventGenerator::NewAlphaCcEstimate() {
+  auto source = prng_.Rand<bool>() ? RtcEventAlphaCcEstimate::Source::kSent
+                                   : RtcEventAlphaCcEstimate::Source::kReceived;
+  absl::optional<float> confidence;
+  if (prng_.Rand<bool>())
+    confidence = prng_.Rand<float>();
+  absl::optional<int64_t> rtt_ms;
+  if (prng_.Rand<bool>())
+    rtt_ms = prng_.Rand(0, 1000);
+  absl::optional<float> loss_ratio;
+  if (prng_.Rand<bool>())
+    loss_ratio = prng_.Rand<float>();
+  return std::make_unique<RtcEventAlphaCcEstimate>(
+      source, DataRate::KilobitsPerSec(prng_.Rand(0, 100000)),
+      DataRate::KilobitsPerSec(prng_.Rand(0, 100000)), confidence, rtt_ms,
+      loss_ratio);
+}
+
 std::unique_ptr<RtcEventRtcpPacketIncoming>
 EventGenerator::NewRtcpPacketIncoming() {
   enum class SupportedRtcpTypes {
@@ -949,6 +967,30 @@ void EventVerifier::VerifyLoggedRemoteEstimateEvent(
             logged_event.link_capacity_upper);
 }
 
+void EventVerifier::VerifyLoggedAlphaCcEstimateEvent(
+    const RtcEventAlphaCcEstimate& original_event,
+    const LoggedAlphaCcEstimateEvent& logged_event) const {
+  // Fractions are stored with 14 bits of precision.
+  constexpr float kFractionError = 1.0f / ((1 << 14) - 1);
+  EXPECT_EQ(original_event.timestamp_ms(), logged_event.log_time_ms());
+  EXPECT_EQ(original_event.source(), logged_event.source);
+  EXPECT_EQ(original_event.target_rate(), logged_event.target_rate);
+  EXPECT_EQ(original_event.pacing_rate(), logged_event.pacing_rate);
+  ASSERT_EQ(original_event.confidence().has_value(),
+            logged_event.confidence.has_value());
+  if (original_event.confidence()) {
+    EXPECT_NEAR(*original_event.confidence(), *logged_event.confidence,
+                kFractionError);
+  }
+  EXPECT_EQ(original_event.rtt_ms(), logged_event.rtt_ms);
+  ASSERT_EQ(original_event.loss_ratio().has_value(),
+            logged_event.loss_ratio.has_value());
+  if (original_event.loss_ratio()) {
+    EXPECT_NEAR(*original_event.loss_ratio(), *logged_event.loss_ratio,
+                kFractionError);
+  }
+}
+
 void EventVerifier::VerifyLoggedRtpPacketIncoming(
     const RtcEventRtpPacketIncoming& original_event,
     const LoggedRtpPacketIncoming& logged_event) const {
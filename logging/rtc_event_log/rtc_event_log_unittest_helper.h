@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "logging/rtc_event_log/events/rtc_event_alpha_cc_estimate.h"
 #include "logging/rtc_event_log/events/rtc_event_alr_state.h"
 #include "logging/rtc_event_log/events/rtc_event_audio_network_adaptation.h"
 #include "logging/rtc_event_log/events/rtc_event_audio_playout.h"
@@ -81,6 +82,7 @@ class EventGenerator {
   std::unique_ptr<RtcEventProbeResultSuccess> NewProbeResultSuccess();
   std::unique_ptr<RtcEventRouteChange> NewRouteChange();
   std::unique_ptr<RtcEventRemoteEstimate> NewRemoteEstimate();
+  std::unique_ptr<RtcEventAlphaCcEstimate> NewAlphaCcEstimate();
   std::unique_ptr<RtcEventRtcpPacketIncoming> NewRtcpPacketIncoming();
   std::unique_ptr<RtcEventRtcpPacketOutgoing> NewRtcpPacketOutgoing();
 
@@ -205,6 +207,10 @@ class EventVerifier {
       const RtcEventRemoteEstimate& original_event,
       const LoggedRemoteEstimateEvent& logged_event) const;
 
+  void VerifyLoggedAlphaCcEstimateEvent(
+      const RtcEventAlphaCcEstimate& original_event,
+      const LoggedAlphaCcEstimateEvent& logged_event) const;
+
   void VerifyLoggedRtpPacketIncoming(
       const RtcEventRtpPacketIncoming& original_event,
       const LoggedRtpPacketIncoming& logged_event) const;
@@ -289,6 +289,10 @@ class FakeCall final : public webrtc::Call, public webrtc::PacketReceiver {
     return &transport_controller_send_;
   }
 
+  webrtc::BitrateAllocatorInterface* GetBitrateAllocator() override {
+    return nullptr;
+  }
+
   const std::vector<FakeVideoSendStream*>& GetVideoSendStreams();
   const std::vector<FakeVideoReceiveStream*>& GetVideoReceiveStreams();
 
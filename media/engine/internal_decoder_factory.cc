@@ -12,6 +12,7 @@
 
 #include "absl/strings/match.h"
 #include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder_software_fallback_wrapper.h"
 #include "media/base/codec.h"
 #include "media/base/media_constants.h"
 #include "modules/video_coding/codecs/av1/libaom_av1_decoder.h"
@@ -20,6 +21,7 @@
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -38,6 +40,17 @@ bool IsFormatSupported(
   return false;
 }
 
+// Decodes H.264 on the GPU where possible with
+// "WebRTC-H264VaapiDecoder/Enabled/", in software otherwise.
+std::unique_ptr<VideoDecoder> CreateH264Decoder() {
+  if (H264Decoder::IsVaapiSupported() &&
+      field_trial::IsEnabled("WebRTC-H264VaapiDecoder")) {
+    return CreateVideoDecoderSoftwareFallbackWrapper(
+        H264Decoder::Create(), H264Decoder::CreateVaapi());
+  }
+  return H264Decoder::Create();
+}
+
 }  // namespace
 
 std::vector<SdpVideoFormat> InternalDecoderFactory::GetSupportedFormats()
@@ -65,7 +78,7 @@ std::unique_ptr<VideoDecoder> InternalDecoderFactory::CreateVideoDecoder(
   if (absl::EqualsIgnoreCase(format.name, cricket::kVp9CodecName))
     return VP9Decoder::Create();
   if (absl::EqualsIgnoreCase(format.name, cricket::kH264CodecName))
-    return H264Decoder::Create();
+    return CreateH264Decoder();
   if (kIsLibaomAv1DecoderSupported &&
       absl::EqualsIgnoreCase(format.name, cricket::kAv1CodecName))
     return CreateLibaomAv1Decoder();
@@ -33,6 +33,8 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/thread_pool.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace {
@@ -130,6 +132,16 @@ class AdapterEncodedImageCallback : public webrtc::EncodedImageCallback {
   webrtc::SimulcastEncoderAdapter* const adapter_;
   const size_t stream_idx_;
 };
+
+// Process wide pool with a thread per core but one, created on first use and
+// never destroyed. Encoding runs at the priority of the encoder queue.
+webrtc::ThreadPool* EncodeThreadPool() {
+  static webrtc::ThreadPool* const pool = new webrtc::ThreadPool(
+      std::max(1,
+               static_cast<int>(webrtc::CpuInfo::DetectNumberOfCores()) - 1),
+      "EncodeThread", rtc::kNormalPriority);
+  return pool;
+}
 }  // namespace
 
 namespace webrtc {
@@ -151,7 +163,9 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
       boost_base_layer_quality_(RateControlSettings::ParseFromFieldTrials()
                                     .Vp8BoostBaseLayerQuality()),
       prefer_temporal_support_on_base_layer_(field_trial::IsEnabled(
-          "WebRTC-Video-PreferTemporalSupportOnBaseLayer")) {
+          "WebRTC-Video-PreferTemporalSupportOnBaseLayer")),
+      parallel_encode_(
+          field_trial::IsEnabled("WebRTC-SimulcastParallelEncode")) {
   RTC_DCHECK(primary_factory);
 
   // The adapter is typically created on the worker thread, but operated on
@@ -186,6 +200,8 @@ int SimulcastEncoderAdapter::Release() {
     stored_encoders_.push(std::move(encoder));
   }
 
+  scaler_.Release();
+
   // It's legal to move the encoder to another queue now.
   encoder_queue_.Detach();
 
@@ -377,8 +393,12 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  // Temporary thay may hold the result of texture to i420 buffer conversion.
-  rtc::scoped_refptr<I420BufferInterface> src_buffer;
+  // The streams to encode this frame with their frame types. Those that need
+  // scaling are scaled together before any of them is encoded.
+  std::vector<size_t> streams_to_encode;
+  std::vector<std::vector<VideoFrameType>> streams_frame_types;
+  std::vector<size_t> streams_to_scale;
+  std::vector<MultiResolutionScaler::Resolution> resolutions;
   int src_width = input_image.width();
   int src_height = input_image.height();
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
@@ -408,6 +428,8 @@ int SimulcastEncoderAdapter::Encode(
                 VideoFrameType::kVideoFrameDelta);
     }
     streaminfos_[stream_idx].framerate_controller->AddFrame(frame_timestamp_ms);
+    streams_to_encode.push_back(stream_idx);
+    streams_frame_types.push_back(std::move(stream_frame_types));
 
     int dst_width = streaminfos_[stream_idx].width;
     int dst_height = streaminfos_[stream_idx].height;
@@ -421,44 +443,106 @@ int SimulcastEncoderAdapter::Encode(
     // correctly sample/scale the source texture.
     // TODO(perkj): ensure that works going forward, and figure out how this
     // affects webrtc:5683.
-    if ((dst_width == src_width && dst_height == src_height) ||
-        (input_image.video_frame_buffer()->type() ==
-             VideoFrameBuffer::Type::kNative &&
-         streaminfos_[stream_idx]
-             .encoder->GetEncoderInfo()
-             .supports_native_handle)) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(input_image,
-                                                         &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      if (src_buffer == nullptr) {
-        src_buffer = input_image.video_frame_buffer()->ToI420();
-      }
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height);
-
-      dst_buffer->ScaleFrom(*src_buffer);
-
-      // UpdateRect is not propagated to lower simulcast layers currently.
-      // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
-      VideoFrame frame(input_image);
-      frame.set_video_frame_buffer(dst_buffer);
-      frame.set_rotation(webrtc::kVideoRotation_0);
-      frame.set_update_rect(
-          VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret =
-          streaminfos_[stream_idx].encoder->Encode(frame, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+    if (!((dst_width == src_width && dst_height == src_height) ||
+          (input_image.video_frame_buffer()->type() ==
+               VideoFrameBuffer::Type::kNative &&
+           streaminfos_[stream_idx]
+               .encoder->GetEncoderInfo()
+               .supports_native_handle))) {
+      streams_to_scale.push_back(stream_idx);
+      resolutions.push_back({dst_width, dst_height});
+    }
+  }
+
+  // Scaled buffers by stream index, null for the streams that get
+  // |input_image| as is.
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> scaled_buffers(
+      streaminfos_.size());
+  if (!streams_to_scale.empty()) {
+    std::vector<rtc::scoped_refptr<I420BufferInterface>> scaled =
+        scaler_.Scale(input_image.video_frame_buffer()->ToI420(), resolutions);
+    for (size_t i = 0; i < streams_to_scale.size(); ++i)
+      scaled_buffers[streams_to_scale[i]] = std::move(scaled[i]);
+  }
+
+  if (parallel_encode_ && streams_to_encode.size() > 1) {
+    return EncodeInParallel(input_image, streams_to_encode, scaled_buffers,
+                            &streams_frame_types);
+  }
+  for (size_t i = 0; i < streams_to_encode.size(); ++i) {
+    size_t stream_idx = streams_to_encode[i];
+    int ret = EncodeStream(input_image, stream_idx, scaled_buffers[stream_idx],
+                           &streams_frame_types[i]);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
     }
   }
 
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+int SimulcastEncoderAdapter::EncodeStream(
+    const VideoFrame& input_image,
+    size_t stream_idx,
+    const rtc::scoped_refptr<I420BufferInterface>& scaled_buffer,
+    std::vector<VideoFrameType>* frame_types) {
+  if (!scaled_buffer) {
+    return streaminfos_[stream_idx].encoder->Encode(input_image, frame_types);
+  }
+  // UpdateRect is not propagated to lower simulcast layers currently.
+  // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
+  VideoFrame frame(input_image);
+  frame.set_video_frame_buffer(scaled_buffer);
+  frame.set_rotation(webrtc::kVideoRotation_0);
+  frame.set_update_rect(
+      VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
+  return streaminfos_[stream_idx].encoder->Encode(frame, frame_types);
+}
+
+int SimulcastEncoderAdapter::EncodeInParallel(
+    const VideoFrame& input_image,
+    const std::vector<size_t>& streams_to_encode,
+    const std::vector<rtc::scoped_refptr<I420BufferInterface>>& scaled_buffers,
+    std::vector<std::vector<VideoFrameType>>* streams_frame_types) {
+  std::vector<int> results(streams_to_encode.size(), WEBRTC_VIDEO_CODEC_OK);
+  {
+    rtc::CritScope lock(&buffered_images_lock_);
+    buffer_images_ = true;
+  }
+  // Each encoder is only used by one job, the encoders of the streams don't
+  // share state.
+  EncodeThreadPool()->RunAndWait(
+      streams_to_encode.size(), [&](size_t i) {
+        size_t stream_idx = streams_to_encode[i];
+        results[i] =
+            EncodeStream(input_image, stream_idx, scaled_buffers[stream_idx],
+                         &(*streams_frame_types)[i]);
+      });
+  std::vector<BufferedImage> images;
+  {
+    rtc::CritScope lock(&buffered_images_lock_);
+    buffer_images_ = false;
+    images.swap(buffered_images_);
+  }
+
+  // Delivered on this thread in the order the streams are encoded one by one.
+  std::stable_sort(images.begin(), images.end(),
+                   [](const BufferedImage& a, const BufferedImage& b) {
+                     return a.stream_idx < b.stream_idx;
+                   });
+  for (BufferedImage& image : images) {
+    encoded_complete_callback_->OnEncodedImage(
+        image.image, &image.codec_specific_info, image.fragmentation.get());
+  }
+
+  for (int ret : results) {
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
+    }
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
@@ -566,6 +650,26 @@ EncodedImageCallback::Result SimulcastEncoderAdapter::OnEncodedImage(
 
   stream_image.SetSpatialIndex(stream_idx);
 
+  {
+    rtc::CritScope lock(&buffered_images_lock_);
+    if (buffer_images_) {
+      // Encoded in parallel, delivered by EncodeInParallel() once all streams
+      // are done. The encoder may reuse its buffers when it returns.
+      stream_image.Retain();
+      BufferedImage buffered_image;
+      buffered_image.stream_idx = stream_idx;
+      buffered_image.image = stream_image;
+      buffered_image.codec_specific_info = stream_codec_specific;
+      if (fragmentation) {
+        buffered_image.fragmentation =
+            std::make_unique<RTPFragmentationHeader>();
+        buffered_image.fragmentation->CopyFrom(*fragmentation);
+      }
+      buffered_images_.push_back(std::move(buffered_image));
+      return EncodedImageCallback::Result(EncodedImageCallback::Result::OK);
+    }
+  }
+
   return encoded_complete_callback_->OnEncodedImage(
       stream_image, &stream_codec_specific, fragmentation);
 }
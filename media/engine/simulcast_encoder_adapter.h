@@ -20,13 +20,18 @@
 
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
+#include "common_video/include/multi_resolution_scaler.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/framerate_controller.h"
 #include "rtc_base/atomic_ops.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -99,6 +104,15 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     bool send_stream;
   };
 
+  // An image encoded during EncodeInParallel(), with copies of what the
+  // callback only borrows.
+  struct BufferedImage {
+    size_t stream_idx;
+    EncodedImage image;
+    CodecSpecificInfo codec_specific_info;
+    std::unique_ptr<RTPFragmentationHeader> fragmentation;
+  };
+
   enum class StreamResolution {
     OTHER,
     HIGHEST,
@@ -114,6 +128,23 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   bool Initialized() const;
 
+  // Encodes |input_image|, or |scaled_buffer| if not null, with the encoder of
+  // |stream_idx|.
+  int EncodeStream(
+      const VideoFrame& input_image,
+      size_t stream_idx,
+      const rtc::scoped_refptr<I420BufferInterface>& scaled_buffer,
+      std::vector<VideoFrameType>* frame_types);
+  // Encodes |streams_to_encode| at the same time on the EncodeThreadPool.
+  // Their encoded images are buffered and passed on in stream order once all
+  // are done, returns the error of the first stream that failed.
+  int EncodeInParallel(
+      const VideoFrame& input_image,
+      const std::vector<size_t>& streams_to_encode,
+      const std::vector<rtc::scoped_refptr<I420BufferInterface>>&
+          scaled_buffers,
+      std::vector<std::vector<VideoFrameType>>* streams_frame_types);
+
   void DestroyStoredEncoders();
 
   volatile int inited_;  // Accessed atomically.
@@ -131,9 +162,22 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   // have to be recreated. Remaining encoders are destroyed by the destructor.
   std::stack<std::unique_ptr<VideoEncoder>> stored_encoders_;
 
+  // Scales the input frame to the resolutions of the streams, buffers are
+  // pooled across frames.
+  MultiResolutionScaler scaler_;
+
   const absl::optional<unsigned int> experimental_boosted_screenshare_qp_;
   const bool boost_base_layer_quality_;
   const bool prefer_temporal_support_on_base_layer_;
+  // Encode the streams of a frame in parallel, see EncodeInParallel().
+  const bool parallel_encode_;
+
+  // The encoded callbacks come from the threads of the pool while the streams
+  // are encoded in parallel, and are buffered until all are done.
+  rtc::CriticalSection buffered_images_lock_;
+  bool buffer_images_ RTC_GUARDED_BY(buffered_images_lock_) = false;
+  std::vector<BufferedImage> buffered_images_
+      RTC_GUARDED_BY(buffered_images_lock_);
 };
 
 }  // namespace webrtc
@@ -1899,7 +1899,12 @@ std::vector<webrtc::RtpSource> WebRtcVideoChannel::GetSources(
 bool WebRtcVideoChannel::SendRtp(const uint8_t* data,
                                  size_t len,
                                  const webrtc::PacketOptions& options) {
-  rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+  return SendRtpBuffer(rtc::CopyOnWriteBuffer(data, len, kMaxRtpPacketLen),
+                       options);
+}
+
+bool WebRtcVideoChannel::SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                                       const webrtc::PacketOptions& options) {
   rtc::PacketOptions rtc_options;
   rtc_options.packet_id = options.packet_id;
   if (DscpEnabled()) {
@@ -1909,6 +1914,8 @@ bool WebRtcVideoChannel::SendRtp(const uint8_t* data,
       options.included_in_feedback;
   rtc_options.info_signaled_after_sent.included_in_allocation =
       options.included_in_allocation;
+  rtc_options.batchable = options.batchable;
+  rtc_options.last_packet_in_batch = options.last_packet_in_batch;
   return MediaChannel::SendPacket(&packet, rtc_options);
 }
 
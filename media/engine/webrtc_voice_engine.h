@@ -224,7 +224,12 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   bool SendRtp(const uint8_t* data,
                size_t len,
                const webrtc::PacketOptions& options) override {
-    rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+    return SendRtpBuffer(rtc::CopyOnWriteBuffer(data, len, kMaxRtpPacketLen),
+                         options);
+  }
+
+  bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                     const webrtc::PacketOptions& options) override {
     rtc::PacketOptions rtc_options;
     rtc_options.packet_id = options.packet_id;
     if (DscpEnabled()) {
@@ -234,6 +239,8 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
         options.included_in_feedback;
     rtc_options.info_signaled_after_sent.included_in_allocation =
         options.included_in_allocation;
+    rtc_options.batchable = options.batchable;
+    rtc_options.last_packet_in_batch = options.last_packet_in_batch;
     return VoiceMediaChannel::SendPacket(&packet, rtc_options);
   }
 
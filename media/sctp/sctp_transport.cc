@@ -22,6 +22,8 @@ enum PreservedErrno {
 #include <stdio.h>
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
@@ -291,12 +293,11 @@ class SctpTransport::UsrSctpWrapper {
 
     VerboseLogPacket(data, length, SCTP_DUMP_OUTBOUND);
     // Note: We have to copy the data; the caller will delete it.
-    rtc::CopyOnWriteBuffer buf(reinterpret_cast<uint8_t*>(data), length);
-    // TODO(deadbeef): Why do we need an AsyncInvoke here? We're already on the
-    // right thread and don't need to unwind the stack.
-    transport->invoker_.AsyncInvoke<void>(
-        RTC_FROM_HERE, transport->network_thread_,
-        rtc::Bind(&SctpTransport::OnPacketFromSctpToNetwork, transport, buf));
+    // This is called on the network thread from usrsctp_sendv() and when
+    // packets are received, but also on the timer thread of usrsctp, so the
+    // packets are sent from a task on the network thread.
+    transport->QueuePacketFromSctpToNetwork(
+        rtc::CopyOnWriteBuffer(reinterpret_cast<uint8_t*>(data), length));
     return 0;
   }
 
@@ -465,6 +466,26 @@ void SctpTransport::SetDtlsTransport(rtc::PacketTransportInternal* transport) {
   }
 }
 
+void SctpTransport::SetBufferSizes(int send_buffer_size,
+                                   int receive_buffer_size) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  RTC_DCHECK_GE(send_buffer_size, 0);
+  RTC_DCHECK_GE(receive_buffer_size, 0);
+  if (started_) {
+    RTC_LOG(LS_WARNING) << debug_name_
+                        << "->SetBufferSizes(): Ignored after Start().";
+    return;
+  }
+  if (send_buffer_size > 0 && send_buffer_size < kSctpSendBufferSize) {
+    RTC_LOG(LS_WARNING) << debug_name_ << "->SetBufferSizes(): Send buffer of "
+                        << send_buffer_size << " can't fit a message of "
+                        << kSctpSendBufferSize << ", ignored.";
+    send_buffer_size = 0;
+  }
+  send_buffer_size_ = send_buffer_size;
+  receive_buffer_size_ = receive_buffer_size;
+}
+
 bool SctpTransport::Start(int local_sctp_port,
                           int remote_sctp_port,
                           int max_message_size) {
@@ -475,10 +496,12 @@ bool SctpTransport::Start(int local_sctp_port,
   if (remote_sctp_port == -1) {
     remote_sctp_port = kSctpDefaultPort;
   }
-  if (max_message_size > kSctpSendBufferSize) {
+  const int send_buffer_size =
+      send_buffer_size_ > 0 ? send_buffer_size_ : kSctpSendBufferSize;
+  if (max_message_size > send_buffer_size) {
     RTC_LOG(LS_ERROR) << "Max message size of " << max_message_size
                       << " is larger than send bufffer size "
-                      << kSctpSendBufferSize;
+                      << send_buffer_size;
     return false;
   }
   if (max_message_size < 1) {
@@ -761,10 +784,12 @@ bool SctpTransport::OpenSctpSocket() {
   // still have to do something reasonable here.  Look up what the buffer's real
   // size is and set our threshold to something reasonable.
   static const int kSendThreshold = usrsctp_sysctl_get_sctp_sendspace() / 2;
+  const int send_threshold =
+      send_buffer_size_ > 0 ? send_buffer_size_ / 2 : kSendThreshold;
 
   sock_ = usrsctp_socket(
       AF_CONN, SOCK_STREAM, IPPROTO_SCTP, &UsrSctpWrapper::OnSctpInboundPacket,
-      &UsrSctpWrapper::SendThresholdCallback, kSendThreshold, this);
+      &UsrSctpWrapper::SendThresholdCallback, send_threshold, this);
   if (!sock_) {
     RTC_LOG_ERRNO(LS_ERROR) << debug_name_
                             << "->OpenSctpSocket(): "
@@ -811,6 +836,26 @@ bool SctpTransport::ConfigureSctpSocket() {
     return false;
   }
 
+  // Larger buffers, for paths with a large bandwidth-delay product. The
+  // receive buffer is advertised as the receiver window in the INIT, so both
+  // are set before connecting.
+  if (send_buffer_size_ > 0 &&
+      usrsctp_setsockopt(sock_, SOL_SOCKET, SO_SNDBUF, &send_buffer_size_,
+                         sizeof(send_buffer_size_))) {
+    RTC_LOG_ERRNO(LS_ERROR) << debug_name_
+                            << "->ConfigureSctpSocket(): "
+                               "Failed to set SO_SNDBUF.";
+    return false;
+  }
+  if (receive_buffer_size_ > 0 &&
+      usrsctp_setsockopt(sock_, SOL_SOCKET, SO_RCVBUF, &receive_buffer_size_,
+                         sizeof(receive_buffer_size_))) {
+    RTC_LOG_ERRNO(LS_ERROR) << debug_name_
+                            << "->ConfigureSctpSocket(): "
+                               "Failed to set SO_RCVBUF.";
+    return false;
+  }
+
   // Enable stream ID resets.
   struct sctp_assoc_value stream_rst;
   stream_rst.assoc_id = SCTP_ALL_ASSOC;
@@ -1037,8 +1082,36 @@ sockaddr_conn SctpTransport::GetSctpSockAddr(int port) {
   return sconn;
 }
 
+void SctpTransport::QueuePacketFromSctpToNetwork(
+    rtc::CopyOnWriteBuffer buffer) {
+  bool first_packet;
+  {
+    rtc::CritScope lock(&outbound_packets_lock_);
+    first_packet = outbound_packets_.empty();
+    outbound_packets_.push_back(std::move(buffer));
+  }
+  // The packets queued until the task runs are sent with it.
+  if (first_packet) {
+    invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, network_thread_,
+        rtc::Bind(&SctpTransport::OnPacketsFromSctpToNetwork, this));
+  }
+}
+
+void SctpTransport::OnPacketsFromSctpToNetwork() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  {
+    rtc::CritScope lock(&outbound_packets_lock_);
+    packets.swap(outbound_packets_);
+  }
+  for (size_t i = 0; i < packets.size(); ++i)
+    OnPacketFromSctpToNetwork(packets[i], i + 1 == packets.size());
+}
+
 void SctpTransport::OnPacketFromSctpToNetwork(
-    const rtc::CopyOnWriteBuffer& buffer) {
+    const rtc::CopyOnWriteBuffer& buffer,
+    bool last_packet_in_batch) {
   RTC_DCHECK_RUN_ON(network_thread_);
   if (buffer.size() > (kSctpMtu)) {
     RTC_LOG(LS_ERROR) << debug_name_
@@ -1055,9 +1128,13 @@ void SctpTransport::OnPacketFromSctpToNetwork(
     return;
   }
 
-  // Bon voyage.
-  transport_->SendPacket(buffer.data<char>(), buffer.size(),
-                         rtc::PacketOptions(), PF_NORMAL);
+  // Bon voyage. The packets of a batch are sent with a single system call
+  // where the socket supports it.
+  rtc::PacketOptions options;
+  options.batchable = true;
+  options.last_packet_in_batch = last_packet_in_batch;
+  transport_->SendPacket(buffer.data<char>(), buffer.size(), options,
+                         PF_NORMAL);
 }
 
 void SctpTransport::OnInboundPacketFromSctpToTransport(
@@ -24,8 +24,10 @@
 #include "rtc_base/buffer.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
 // For SendDataParams/ReceiveDataParams.
 #include "media/base/media_channel.h"
 #include "media/sctp/sctp_transport_internal.h"
@@ -76,6 +78,7 @@ class SctpTransport : public SctpTransportInternal,
 
   // SctpTransportInternal overrides (see sctptransportinternal.h for comments).
   void SetDtlsTransport(rtc::PacketTransportInternal* transport) override;
+  void SetBufferSizes(int send_buffer_size, int receive_buffer_size) override;
   bool Start(int local_port, int remote_port, int max_message_size) override;
   bool OpenStream(int sid) override;
   bool ResetStream(int sid) override;
@@ -170,8 +173,14 @@ class SctpTransport : public SctpTransportInternal,
   void OnSendThresholdCallback();
   sockaddr_conn GetSctpSockAddr(int port);
 
-  // Called using |invoker_| to send packet on the network.
-  void OnPacketFromSctpToNetwork(const rtc::CopyOnWriteBuffer& buffer);
+  // Queues a packet usrsctp made, on any thread, until the network thread
+  // sends the queued packets with OnPacketsFromSctpToNetwork().
+  void QueuePacketFromSctpToNetwork(rtc::CopyOnWriteBuffer buffer);
+  // Called using |invoker_| to send the queued packets on the network, as one
+  // batch.
+  void OnPacketsFromSctpToNetwork();
+  void OnPacketFromSctpToNetwork(const rtc::CopyOnWriteBuffer& buffer,
+                                 bool last_packet_in_batch);
   // Called using |invoker_| to decide what to do with the packet.
   // The |flags| parameter is used by SCTP to distinguish notification packets
   // from other types of packets.
@@ -193,6 +202,13 @@ class SctpTransport : public SctpTransportInternal,
   // Underlying DTLS transport.
   rtc::PacketTransportInternal* transport_ = nullptr;
 
+  // Packets made by usrsctp that the network thread hasn't sent yet. usrsctp
+  // makes several packets at once, e.g. for a large message or when acking,
+  // and they are sent with a single task.
+  rtc::CriticalSection outbound_packets_lock_;
+  std::vector<rtc::CopyOnWriteBuffer> outbound_packets_
+      RTC_GUARDED_BY(outbound_packets_lock_);
+
   // Track the data received from usrsctp between callbacks until the EOR bit
   // arrives.
   rtc::CopyOnWriteBuffer partial_incoming_message_;
@@ -208,6 +224,9 @@ class SctpTransport : public SctpTransportInternal,
   int local_port_ = kSctpDefaultPort;
   int remote_port_ = kSctpDefaultPort;
   int max_message_size_ = kSctpSendBufferSize;
+  // Set with SetBufferSizes(), 0 for the usrsctp defaults.
+  int send_buffer_size_ = 0;
+  int receive_buffer_size_ = 0;
   struct socket* sock_ = nullptr;  // The socket created by usrsctp_socket(...).
 
   // Has Start been called? Don't create SCTP socket until it has.
@@ -72,7 +72,8 @@ class SctpTransportInternal {
   // to the ports at the IP level. If set to -1, we default to
   // kSctpDefaultPort.
   // |max_message_size_| sets the max message size on the connection.
-  // It must be smaller than or equal to kSctpSendBufferSize.
+  // It must be smaller than or equal to kSctpSendBufferSize, or the send
+  // buffer size set by SetBufferSizes().
   // It can be changed by a secons Start() call.
   //
   // TODO(deadbeef): Support calling Start with different local/remote ports
@@ -82,6 +83,15 @@ class SctpTransportInternal {
                      int remote_sctp_port,
                      int max_message_size) = 0;
 
+  // Sets the sizes of the send and receive buffers of the SCTP socket, which
+  // bound the data in flight in each direction. 0 keeps the usrsctp default,
+  // which is kSctpSendBufferSize for sending and too small for paths with a
+  // large bandwidth-delay product. A send buffer smaller than
+  // kSctpSendBufferSize, the max message size offered in SDP, is ignored.
+  // Only has an effect before the first Start() call, and |max_message_size|
+  // may then be up to |send_buffer_size|.
+  virtual void SetBufferSizes(int send_buffer_size, int receive_buffer_size) {}
+
   // NOTE: Initially there was a "Stop" method here, but it was never used, so
   // it was removed.
 
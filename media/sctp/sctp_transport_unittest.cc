@@ -696,6 +696,28 @@ TEST_F(SctpTransportTest, RejectsTooLargeMessageSize) {
                                 kSctpSendBufferSize + 1));
 }
 
+TEST_F(SctpTransportTest, AcceptsMessageSizeUpToLargerSendBuffer) {
+  FakeDtlsTransport fake_dtls("fake dtls", 0);
+  SctpFakeDataReceiver recv;
+  std::unique_ptr<SctpTransport> transport(CreateTransport(&fake_dtls, &recv));
+
+  transport->SetBufferSizes(2 * kSctpSendBufferSize, 2 * kSctpSendBufferSize);
+  EXPECT_FALSE(transport->Start(kSctpDefaultPort, kSctpDefaultPort,
+                                2 * kSctpSendBufferSize + 1));
+  EXPECT_TRUE(transport->Start(kSctpDefaultPort, kSctpDefaultPort,
+                               2 * kSctpSendBufferSize));
+}
+
+TEST_F(SctpTransportTest, IgnoresSendBufferSmallerThanDefault) {
+  FakeDtlsTransport fake_dtls("fake dtls", 0);
+  SctpFakeDataReceiver recv;
+  std::unique_ptr<SctpTransport> transport(CreateTransport(&fake_dtls, &recv));
+
+  transport->SetBufferSizes(kSctpSendBufferSize / 2, 0);
+  EXPECT_TRUE(transport->Start(kSctpDefaultPort, kSctpDefaultPort,
+                               kSctpSendBufferSize));
+}
+
 TEST_F(SctpTransportTest, RejectsTooSmallMessageSize) {
   FakeDtlsTransport fake_dtls("fake dtls", 0);
   SctpFakeDataReceiver recv;
@@ -85,6 +85,10 @@ int AcmReceiver::GetBaseMinimumDelayMs() const {
   return neteq_->GetBaseMinimumDelayMs();
 }
 
+void AcmReceiver::UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) {
+  neteq_->UpdateQueueingDelayTrend(trend);
+}
+
 absl::optional<int> AcmReceiver::last_packet_sample_rate_hz() const {
   rtc::CritScope lock(&crit_sect_);
   if (!last_decoder_) {
@@ -234,6 +238,10 @@ int AcmReceiver::TargetDelayMs() const {
   return neteq_->TargetDelayMs();
 }
 
+int AcmReceiver::UnconstrainedTargetDelayMs() const {
+  return neteq_->UnconstrainedTargetDelayMs();
+}
+
 absl::optional<std::pair<int, SdpAudioFormat>> AcmReceiver::LastDecoder()
     const {
   rtc::CritScope lock(&crit_sect_);
@@ -23,6 +23,7 @@
 #include "api/array_view.h"
 #include "api/audio_codecs/audio_decoder.h"
 #include "api/audio_codecs/audio_format.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "modules/audio_coding/acm2/acm_resampler.h"
 #include "modules/audio_coding/acm2/call_statistics.h"
 #include "modules/audio_coding/include/audio_coding_module.h"
@@ -118,6 +119,10 @@ class AcmReceiver {
   // Returns current value of base minimum delay in milliseconds.
   int GetBaseMinimumDelayMs() const;
 
+  // Updates the queueing delay trend of the network path, which the target
+  // delay of NetEq follows.
+  void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend);
+
   //
   // Resets the initial delay to zero.
   //
@@ -165,6 +170,11 @@ class AcmReceiver {
   //
   int TargetDelayMs() const;
 
+  // Returns the target delay for NetEq in ms, without the extra delay set
+  // through SetMinimumDelay().
+  //
+  int UnconstrainedTargetDelayMs() const;
+
   //
   // Get payload type and format of the last non-CNG/non-DTMF received payload.
   // If no non-CNG/non-DTMF packet is received absl::nullopt is returned.
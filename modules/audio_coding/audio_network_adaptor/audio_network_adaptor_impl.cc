@@ -72,6 +72,18 @@ void AudioNetworkAdaptorImpl::SetUplinkPacketLossFraction(
   UpdateNetworkMetrics(network_metrics);
 }
 
+void AudioNetworkAdaptorImpl::SetPredictedUplinkPacketLossFraction(
+    float predicted_uplink_packet_loss_fraction) {
+  last_metrics_.predicted_uplink_packet_loss_fraction =
+      predicted_uplink_packet_loss_fraction;
+  DumpNetworkMetrics();
+
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.predicted_uplink_packet_loss_fraction =
+      predicted_uplink_packet_loss_fraction;
+  UpdateNetworkMetrics(network_metrics);
+}
+
 void AudioNetworkAdaptorImpl::SetRtt(int rtt_ms) {
   last_metrics_.rtt_ms = rtt_ms;
   DumpNetworkMetrics();
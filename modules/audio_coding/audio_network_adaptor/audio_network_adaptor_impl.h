@@ -48,6 +48,9 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
 
   void SetUplinkPacketLossFraction(float uplink_packet_loss_fraction) override;
 
+  void SetPredictedUplinkPacketLossFraction(
+      float predicted_uplink_packet_loss_fraction) override;
+
   void SetRtt(int rtt_ms) override;
 
   void SetTargetAudioBitrate(int target_audio_bitrate_bps) override;
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kMaxComplexity = 10;
+
+class ProcessCpuLoadMonitor : public ComplexityController::CpuLoadMonitor {
+ public:
+  explicit ProcessCpuLoadMonitor(int64_t min_interval_ms)
+      : min_interval_ns_(min_interval_ms * rtc::kNumNanosecsPerMillisec),
+        num_cores_(std::max<uint32_t>(1, CpuInfo::DetectNumberOfCores())),
+        last_time_ns_(rtc::SystemTimeNanos()),
+        last_cpu_time_ns_(rtc::GetProcessCpuTimeNanos()) {}
+
+  absl::optional<float> GetCpuLoad() override {
+    const int64_t time_ns = rtc::SystemTimeNanos();
+    const int64_t elapsed_ns = time_ns - last_time_ns_;
+    if (elapsed_ns < min_interval_ns_ || elapsed_ns <= 0)
+      return absl::nullopt;
+    const int64_t cpu_time_ns = rtc::GetProcessCpuTimeNanos();
+    const float load = static_cast<float>(cpu_time_ns - last_cpu_time_ns_) /
+                       (elapsed_ns * num_cores_);
+    last_time_ns_ = time_ns;
+    last_cpu_time_ns_ = cpu_time_ns;
+    return load;
+  }
+
+ private:
+  const int64_t min_interval_ns_;
+  const uint32_t num_cores_;
+  int64_t last_time_ns_;
+  int64_t last_cpu_time_ns_;
+};
+
+}  // namespace
+
+ComplexityController::Config::Config(int complexity,
+                                     int low_rate_complexity,
+                                     int min_complexity,
+                                     int complexity_threshold_bps,
+                                     int complexity_threshold_window_bps,
+                                     float high_cpu_load,
+                                     float low_cpu_load)
+    : complexity(complexity),
+      low_rate_complexity(low_rate_complexity),
+      min_complexity(min_complexity),
+      complexity_threshold_bps(complexity_threshold_bps),
+      complexity_threshold_window_bps(complexity_threshold_window_bps),
+      high_cpu_load(high_cpu_load),
+      low_cpu_load(low_cpu_load) {}
+
+std::unique_ptr<ComplexityController::CpuLoadMonitor>
+ComplexityController::CreateProcessCpuLoadMonitor(int64_t min_interval_ms) {
+  return std::make_unique<ProcessCpuLoadMonitor>(min_interval_ms);
+}
+
+ComplexityController::ComplexityController(const Config& config)
+    : ComplexityController(config, CreateProcessCpuLoadMonitor(1000)) {}
+
+ComplexityController::ComplexityController(
+    const Config& config,
+    std::unique_ptr<CpuLoadMonitor> cpu_load_monitor)
+    : config_(config),
+      cpu_load_monitor_(std::move(cpu_load_monitor)),
+      bandwidth_complexity_(config_.complexity),
+      max_cpu_complexity_(kMaxComplexity) {
+  RTC_DCHECK(cpu_load_monitor_);
+  RTC_DCHECK_LE(0, config_.min_complexity);
+  RTC_DCHECK_LE(config_.min_complexity, config_.complexity);
+  RTC_DCHECK_LE(config_.min_complexity, config_.low_rate_complexity);
+  RTC_DCHECK_GE(kMaxComplexity, config_.complexity);
+  RTC_DCHECK_GE(kMaxComplexity, config_.low_rate_complexity);
+  RTC_DCHECK_LE(config_.low_cpu_load, config_.high_cpu_load);
+}
+
+ComplexityController::~ComplexityController() = default;
+
+void ComplexityController::UpdateNetworkMetrics(
+    const NetworkMetrics& network_metrics) {
+  if (network_metrics.uplink_bandwidth_bps)
+    uplink_bandwidth_bps_ = network_metrics.uplink_bandwidth_bps;
+}
+
+void ComplexityController::MakeDecision(AudioEncoderRuntimeConfig* config) {
+  // Decision on |complexity| should not have been made.
+  RTC_DCHECK(!config->complexity);
+
+  // Keep the current bandwidth based complexity within the hysteresis window.
+  if (uplink_bandwidth_bps_) {
+    if (*uplink_bandwidth_bps_ <= config_.complexity_threshold_bps -
+                                      config_.complexity_threshold_window_bps) {
+      bandwidth_complexity_ = config_.low_rate_complexity;
+    } else if (*uplink_bandwidth_bps_ >=
+               config_.complexity_threshold_bps +
+                   config_.complexity_threshold_window_bps) {
+      bandwidth_complexity_ = config_.complexity;
+    }
+  }
+
+  const absl::optional<float> cpu_load = cpu_load_monitor_->GetCpuLoad();
+  if (cpu_load && *cpu_load > config_.high_cpu_load) {
+    max_cpu_complexity_ =
+        std::max(config_.min_complexity,
+                 std::min(max_cpu_complexity_, bandwidth_complexity_) - 1);
+  } else if (cpu_load && *cpu_load < config_.low_cpu_load) {
+    max_cpu_complexity_ = std::min(kMaxComplexity, max_cpu_complexity_ + 1);
+  }
+
+  config->complexity = std::min(bandwidth_complexity_, max_cpu_complexity_);
+}
+
+}  // namespace webrtc
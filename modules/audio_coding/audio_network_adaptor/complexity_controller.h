@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+#define MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "modules/audio_coding/audio_network_adaptor/controller.h"
+#include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor_config.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// Decides the encoder complexity from the uplink bandwidth and the CPU load of
+// the process. At or below |complexity_threshold_bps| the bandwidth estimate
+// is considered constrained and |low_rate_complexity| is used, otherwise
+// |complexity|, with a hysteresis of +/- |complexity_threshold_window_bps|.
+// While the CPU load is above |high_cpu_load| the complexity is lowered by
+// one at each new load measurement, down to |min_complexity|, and while it is
+// below |low_cpu_load| it is raised by one again, up to the bandwidth based
+// complexity.
+class ComplexityController final : public Controller {
+ public:
+  struct Config {
+    Config(int complexity,
+           int low_rate_complexity,
+           int min_complexity,
+           int complexity_threshold_bps,
+           int complexity_threshold_window_bps,
+           float high_cpu_load,
+           float low_cpu_load);
+    int complexity;
+    int low_rate_complexity;
+    int min_complexity;
+    int complexity_threshold_bps;
+    int complexity_threshold_window_bps;
+    // CPU loads are given as the fraction of all cores used by the process.
+    float high_cpu_load;
+    float low_cpu_load;
+  };
+
+  class CpuLoadMonitor {
+   public:
+    virtual ~CpuLoadMonitor() = default;
+    // Returns the CPU load of the process measured since the previous
+    // measurement, or nullopt if no new measurement is available.
+    virtual absl::optional<float> GetCpuLoad() = 0;
+  };
+
+  // Measures the CPU load of the process over intervals of at least
+  // |min_interval_ms|.
+  static std::unique_ptr<CpuLoadMonitor> CreateProcessCpuLoadMonitor(
+      int64_t min_interval_ms);
+
+  // Uses a process CPU load monitor with an interval of one second.
+  explicit ComplexityController(const Config& config);
+  ComplexityController(const Config& config,
+                       std::unique_ptr<CpuLoadMonitor> cpu_load_monitor);
+
+  ~ComplexityController() override;
+
+  void UpdateNetworkMetrics(const NetworkMetrics& network_metrics) override;
+
+  void MakeDecision(AudioEncoderRuntimeConfig* config) override;
+
+ private:
+  const Config config_;
+  const std::unique_ptr<CpuLoadMonitor> cpu_load_monitor_;
+  int bandwidth_complexity_;
+  // Upper bound imposed by the CPU load.
+  int max_cpu_complexity_;
+  absl::optional<int> uplink_bandwidth_bps_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(ComplexityController);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kComplexity = 9;
+constexpr int kLowRateComplexity = 10;
+constexpr int kMinComplexity = 5;
+constexpr int kComplexityThresholdBps = 12500;
+constexpr int kComplexityThresholdWindowBps = 1500;
+constexpr float kHighCpuLoad = 0.8f;
+constexpr float kLowCpuLoad = 0.5f;
+constexpr float kMediumCpuLoad = (kHighCpuLoad + kLowCpuLoad) / 2;
+
+constexpr int kLowBandwidthBps =
+    kComplexityThresholdBps - kComplexityThresholdWindowBps;
+constexpr int kHighBandwidthBps =
+    kComplexityThresholdBps + kComplexityThresholdWindowBps;
+
+class FakeCpuLoadMonitor : public ComplexityController::CpuLoadMonitor {
+ public:
+  absl::optional<float> GetCpuLoad() override {
+    absl::optional<float> cpu_load = cpu_load_;
+    cpu_load_ = absl::nullopt;
+    return cpu_load;
+  }
+
+  absl::optional<float> cpu_load_;
+};
+
+class ComplexityControllerStates {
+ public:
+  ComplexityControllerStates() {
+    std::unique_ptr<FakeCpuLoadMonitor> cpu_load_monitor(
+        new FakeCpuLoadMonitor());
+    cpu_load_monitor_ = cpu_load_monitor.get();
+    controller_.reset(new ComplexityController(
+        ComplexityController::Config(kComplexity, kLowRateComplexity,
+                                     kMinComplexity, kComplexityThresholdBps,
+                                     kComplexityThresholdWindowBps,
+                                     kHighCpuLoad, kLowCpuLoad),
+        std::move(cpu_load_monitor)));
+  }
+
+  void CheckDecision(const absl::optional<int>& uplink_bandwidth_bps,
+                     const absl::optional<float>& cpu_load,
+                     int expected_complexity) {
+    if (uplink_bandwidth_bps) {
+      Controller::NetworkMetrics network_metrics;
+      network_metrics.uplink_bandwidth_bps = uplink_bandwidth_bps;
+      controller_->UpdateNetworkMetrics(network_metrics);
+    }
+    cpu_load_monitor_->cpu_load_ = cpu_load;
+    AudioEncoderRuntimeConfig config;
+    controller_->MakeDecision(&config);
+    EXPECT_EQ(expected_complexity, config.complexity);
+  }
+
+ private:
+  FakeCpuLoadMonitor* cpu_load_monitor_;
+  std::unique_ptr<ComplexityController> controller_;
+};
+
+}  // namespace
+
+TEST(ComplexityControllerTest, OutputDefaultComplexityWhenNothingIsKnown) {
+  ComplexityControllerStates states;
+  states.CheckDecision(absl::nullopt, absl::nullopt, kComplexity);
+}
+
+TEST(ComplexityControllerTest, RaiseComplexityForLowUplinkBandwidth) {
+  ComplexityControllerStates states;
+  states.CheckDecision(kLowBandwidthBps, absl::nullopt, kLowRateComplexity);
+}
+
+TEST(ComplexityControllerTest, CheckBehaviorOnChangingUplinkBandwidth) {
+  ComplexityControllerStates states;
+  states.CheckDecision(kComplexityThresholdBps, absl::nullopt, kComplexity);
+  states.CheckDecision(kLowBandwidthBps, absl::nullopt, kLowRateComplexity);
+  states.CheckDecision(kComplexityThresholdBps, absl::nullopt,
+                       kLowRateComplexity);
+  states.CheckDecision(kHighBandwidthBps, absl::nullopt, kComplexity);
+  states.CheckDecision(kComplexityThresholdBps, absl::nullopt, kComplexity);
+}
+
+TEST(ComplexityControllerTest, LowerComplexityUnderHighCpuLoad) {
+  ComplexityControllerStates states;
+  states.CheckDecision(kHighBandwidthBps, kHighCpuLoad + 0.1f,
+                       kComplexity - 1);
+  // No new measurement.
+  states.CheckDecision(kHighBandwidthBps, absl::nullopt, kComplexity - 1);
+  states.CheckDecision(kHighBandwidthBps, kMediumCpuLoad, kComplexity - 1);
+  states.CheckDecision(kHighBandwidthBps, kHighCpuLoad + 0.1f,
+                       kComplexity - 2);
+}
+
+TEST(ComplexityControllerTest, DoNotLowerComplexityBelowMinComplexity) {
+  ComplexityControllerStates states;
+  for (int i = 1; i <= kComplexity; ++i) {
+    states.CheckDecision(kHighBandwidthBps, 1.f,
+                         std::max(kMinComplexity, kComplexity - i));
+  }
+}
+
+TEST(ComplexityControllerTest, RaiseComplexityAgainUnderLowCpuLoad) {
+  ComplexityControllerStates states;
+  states.CheckDecision(kHighBandwidthBps, 1.f, kComplexity - 1);
+  states.CheckDecision(kHighBandwidthBps, 1.f, kComplexity - 2);
+  states.CheckDecision(kHighBandwidthBps, kLowCpuLoad - 0.1f, kComplexity - 1);
+  states.CheckDecision(kHighBandwidthBps, kLowCpuLoad - 0.1f, kComplexity);
+  // Not above the complexity for the uplink bandwidth.
+  states.CheckDecision(kHighBandwidthBps, kLowCpuLoad - 0.1f, kComplexity);
+}
+
+TEST(ComplexityControllerTest, CpuLoadLimitsLowRateComplexity) {
+  ComplexityControllerStates states;
+  states.CheckDecision(kHighBandwidthBps, 1.f, kComplexity - 1);
+  states.CheckDecision(kLowBandwidthBps, absl::nullopt, kComplexity - 1);
+  states.CheckDecision(kLowBandwidthBps, kLowCpuLoad - 0.1f, kComplexity);
+  states.CheckDecision(kLowBandwidthBps, kLowCpuLoad - 0.1f,
+                       kLowRateComplexity);
+}
+
+}  // namespace webrtc
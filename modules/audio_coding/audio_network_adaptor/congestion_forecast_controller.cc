@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/congestion_forecast_controller.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+CongestionForecastController::Config::Config(
+    float fec_enabling_predicted_loss_fraction,
+    float bandwidth_drop_fraction,
+    absl::optional<int> congested_frame_length_ms,
+    int hold_time_ms,
+    bool initial_fec_enabled,
+    int initial_frame_length_ms)
+    : fec_enabling_predicted_loss_fraction(
+          fec_enabling_predicted_loss_fraction),
+      bandwidth_drop_fraction(bandwidth_drop_fraction),
+      congested_frame_length_ms(congested_frame_length_ms),
+      hold_time_ms(hold_time_ms),
+      initial_fec_enabled(initial_fec_enabled),
+      initial_frame_length_ms(initial_frame_length_ms) {}
+
+CongestionForecastController::CongestionForecastController(
+    const Config& config)
+    : config_(config), overriding_(false) {
+  RTC_DCHECK_GT(config_.fec_enabling_predicted_loss_fraction, 0.0f);
+  RTC_DCHECK_GE(config_.bandwidth_drop_fraction, 0.0f);
+  RTC_DCHECK_LT(config_.bandwidth_drop_fraction, 1.0f);
+  RTC_DCHECK_GE(config_.hold_time_ms, 0);
+}
+
+CongestionForecastController::~CongestionForecastController() = default;
+
+void CongestionForecastController::UpdateNetworkMetrics(
+    const NetworkMetrics& network_metrics) {
+  if (network_metrics.uplink_bandwidth_bps)
+    uplink_bandwidth_bps_ = network_metrics.uplink_bandwidth_bps;
+  if (network_metrics.target_audio_bitrate_bps)
+    target_audio_bitrate_bps_ = network_metrics.target_audio_bitrate_bps;
+  if (network_metrics.predicted_uplink_packet_loss_fraction) {
+    predicted_packet_loss_fraction_ =
+        network_metrics.predicted_uplink_packet_loss_fraction;
+  }
+  if (CongestionForecast())
+    last_forecast_time_ms_ = rtc::TimeMillis();
+}
+
+bool CongestionForecastController::CongestionForecast() const {
+  if (predicted_packet_loss_fraction_ &&
+      *predicted_packet_loss_fraction_ >=
+          config_.fec_enabling_predicted_loss_fraction) {
+    return true;
+  }
+  return uplink_bandwidth_bps_ && target_audio_bitrate_bps_ &&
+         *target_audio_bitrate_bps_ <
+             (1.0f - config_.bandwidth_drop_fraction) * *uplink_bandwidth_bps_;
+}
+
+void CongestionForecastController::MakeDecision(
+    AudioEncoderRuntimeConfig* config) {
+  const bool congested =
+      last_forecast_time_ms_ &&
+      rtc::TimeMillis() - *last_forecast_time_ms_ <= config_.hold_time_ms;
+
+  if (!congested) {
+    // Give the encoder back its settings, unless other controllers decide on
+    // them anyway.
+    if (overriding_) {
+      if (!config->enable_fec)
+        config->enable_fec = config_.initial_fec_enabled;
+      if (!config->frame_length_ms)
+        config->frame_length_ms = config_.initial_frame_length_ms;
+      overriding_ = false;
+    }
+    return;
+  }
+
+  overriding_ = true;
+  config->enable_fec = true;
+  config->uplink_packet_loss_fraction =
+      std::max(config->uplink_packet_loss_fraction.value_or(0.0f),
+               predicted_packet_loss_fraction_.value_or(0.0f));
+  if (config_.congested_frame_length_ms &&
+      config->frame_length_ms.value_or(0) <
+          *config_.congested_frame_length_ms) {
+    config->frame_length_ms = *config_.congested_frame_length_ms;
+    config->last_fl_change_increase = true;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_CONGESTION_FORECAST_CONTROLLER_H_
+#define MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_CONGESTION_FORECAST_CONTROLLER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "modules/audio_coding/audio_network_adaptor/controller.h"
+#include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor_config.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// Prepares the encoder for congestion forecast by the bandwidth estimator,
+// before the receiver reports any loss. Congestion is expected while the
+// packet loss predicted by the estimator is at least
+// |fec_enabling_predicted_loss_fraction|, or while the target audio bitrate,
+// which follows the estimate directly, is more than |bandwidth_drop_fraction|
+// below the smoothed uplink bandwidth. Until |hold_time_ms| after the last
+// such forecast, FEC is enabled with at least the predicted loss and the
+// frame length is raised to |congested_frame_length_ms|.
+//
+// This controller overrides the decisions of the FEC and frame length
+// controllers, so it has to come after them and can't have a scoring point.
+class CongestionForecastController final : public Controller {
+ public:
+  struct Config {
+    Config(float fec_enabling_predicted_loss_fraction,
+           float bandwidth_drop_fraction,
+           absl::optional<int> congested_frame_length_ms,
+           int hold_time_ms,
+           bool initial_fec_enabled,
+           int initial_frame_length_ms);
+    float fec_enabling_predicted_loss_fraction;
+    float bandwidth_drop_fraction;
+    // Unset if the encoder does not support a longer frame length.
+    absl::optional<int> congested_frame_length_ms;
+    int hold_time_ms;
+    // Restored after the congestion if no other controller decides on them.
+    bool initial_fec_enabled;
+    int initial_frame_length_ms;
+  };
+
+  explicit CongestionForecastController(const Config& config);
+
+  ~CongestionForecastController() override;
+
+  void UpdateNetworkMetrics(const NetworkMetrics& network_metrics) override;
+
+  void MakeDecision(AudioEncoderRuntimeConfig* config) override;
+
+ private:
+  bool CongestionForecast() const;
+
+  const Config config_;
+  absl::optional<int> uplink_bandwidth_bps_;
+  absl::optional<int> target_audio_bitrate_bps_;
+  absl::optional<float> predicted_packet_loss_fraction_;
+  absl::optional<int64_t> last_forecast_time_ms_;
+  bool overriding_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(CongestionForecastController);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_CONGESTION_FORECAST_CONTROLLER_H_
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/congestion_forecast_controller.h"
+
+#include <memory>
+
+#include "rtc_base/fake_clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr float kFecEnablingPredictedLossFraction = 0.05f;
+constexpr float kBandwidthDropFraction = 0.2f;
+constexpr int kCongestedFrameLengthMs = 60;
+constexpr int kHoldTimeMs = 2000;
+constexpr int kInitialFrameLengthMs = 20;
+constexpr int kUplinkBandwidthBps = 40000;
+constexpr int kDroppedBitrateBps = 30000;
+
+std::unique_ptr<CongestionForecastController> CreateController(
+    absl::optional<int> congested_frame_length_ms = kCongestedFrameLengthMs) {
+  return std::unique_ptr<CongestionForecastController>(
+      new CongestionForecastController(CongestionForecastController::Config(
+          kFecEnablingPredictedLossFraction, kBandwidthDropFraction,
+          congested_frame_length_ms, kHoldTimeMs, false,
+          kInitialFrameLengthMs)));
+}
+
+void UpdateNetworkMetrics(CongestionForecastController* controller,
+                          const absl::optional<int>& uplink_bandwidth_bps,
+                          const absl::optional<int>& target_audio_bitrate_bps,
+                          const absl::optional<float>& predicted_loss) {
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.uplink_bandwidth_bps = uplink_bandwidth_bps;
+  network_metrics.target_audio_bitrate_bps = target_audio_bitrate_bps;
+  network_metrics.predicted_uplink_packet_loss_fraction = predicted_loss;
+  controller->UpdateNetworkMetrics(network_metrics);
+}
+
+void CheckCongested(CongestionForecastController* controller,
+                    float expected_packet_loss_fraction) {
+  AudioEncoderRuntimeConfig config;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(true, config.enable_fec);
+  EXPECT_EQ(expected_packet_loss_fraction, config.uplink_packet_loss_fraction);
+  EXPECT_EQ(kCongestedFrameLengthMs, config.frame_length_ms);
+}
+
+void CheckNoDecision(CongestionForecastController* controller) {
+  AudioEncoderRuntimeConfig config;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(AudioEncoderRuntimeConfig(), config);
+}
+
+}  // namespace
+
+TEST(CongestionForecastControllerTest, NoDecisionWithoutForecast) {
+  auto controller = CreateController();
+  CheckNoDecision(controller.get());
+  UpdateNetworkMetrics(controller.get(), kUplinkBandwidthBps,
+                       kUplinkBandwidthBps, 0.01f);
+  CheckNoDecision(controller.get());
+}
+
+TEST(CongestionForecastControllerTest, PrepareForPredictedLoss) {
+  rtc::ScopedFakeClock fake_clock;
+  auto controller = CreateController();
+  UpdateNetworkMetrics(controller.get(), absl::nullopt, absl::nullopt, 0.1f);
+  CheckCongested(controller.get(), 0.1f);
+}
+
+TEST(CongestionForecastControllerTest, PrepareForBandwidthDrop) {
+  rtc::ScopedFakeClock fake_clock;
+  auto controller = CreateController();
+  UpdateNetworkMetrics(controller.get(), kUplinkBandwidthBps,
+                       kDroppedBitrateBps, absl::nullopt);
+  CheckCongested(controller.get(), 0.0f);
+}
+
+TEST(CongestionForecastControllerTest, KeepReportedLossIfHigher) {
+  rtc::ScopedFakeClock fake_clock;
+  auto controller = CreateController();
+  UpdateNetworkMetrics(controller.get(), absl::nullopt, absl::nullopt, 0.1f);
+  AudioEncoderRuntimeConfig config;
+  config.enable_fec = false;
+  config.uplink_packet_loss_fraction = 0.2f;
+  config.frame_length_ms = 120;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(true, config.enable_fec);
+  EXPECT_EQ(0.2f, config.uplink_packet_loss_fraction);
+  EXPECT_EQ(120, config.frame_length_ms);
+}
+
+TEST(CongestionForecastControllerTest, KeepFrameLengthIfUnsupported) {
+  rtc::ScopedFakeClock fake_clock;
+  auto controller = CreateController(absl::nullopt);
+  UpdateNetworkMetrics(controller.get(), absl::nullopt, absl::nullopt, 0.1f);
+  AudioEncoderRuntimeConfig config;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(true, config.enable_fec);
+  EXPECT_FALSE(config.frame_length_ms);
+}
+
+TEST(CongestionForecastControllerTest, RestoreSettingsAfterHoldTime) {
+  rtc::ScopedFakeClock fake_clock;
+  auto controller = CreateController();
+  UpdateNetworkMetrics(controller.get(), absl::nullopt, absl::nullopt, 0.1f);
+  UpdateNetworkMetrics(controller.get(), absl::nullopt, absl::nullopt, 0.0f);
+  fake_clock.AdvanceTime(TimeDelta::Millis(kHoldTimeMs));
+  CheckCongested(controller.get(), 0.0f);
+
+  fake_clock.AdvanceTime(TimeDelta::Millis(1));
+  AudioEncoderRuntimeConfig config;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(false, config.enable_fec);
+  EXPECT_EQ(kInitialFrameLengthMs, config.frame_length_ms);
+  CheckNoDecision(controller.get());
+}
+
+TEST(CongestionForecastControllerTest, DoNotRestoreDecisionsOfOthers) {
+  rtc::ScopedFakeClock fake_clock;
+  auto controller = CreateController();
+  UpdateNetworkMetrics(controller.get(), absl::nullopt, absl::nullopt, 0.1f);
+  CheckCongested(controller.get(), 0.1f);
+  UpdateNetworkMetrics(controller.get(), absl::nullopt, absl::nullopt, 0.0f);
+  fake_clock.AdvanceTime(TimeDelta::Millis(kHoldTimeMs + 1));
+  AudioEncoderRuntimeConfig config;
+  config.enable_fec = true;
+  config.frame_length_ms = 40;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(true, config.enable_fec);
+  EXPECT_EQ(40, config.frame_length_ms);
+}
+
+}  // namespace webrtc
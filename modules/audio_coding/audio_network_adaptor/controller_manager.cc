@@ -10,12 +10,15 @@
 
 #include "modules/audio_coding/audio_network_adaptor/controller_manager.h"
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <utility>
 
 #include "modules/audio_coding/audio_network_adaptor/bitrate_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/channel_controller.h"
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+#include "modules/audio_coding/audio_network_adaptor/congestion_forecast_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/debug_dump_writer.h"
 #include "modules/audio_coding/audio_network_adaptor/dtx_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/fec_controller_plr_based.h"
@@ -179,6 +182,49 @@ std::unique_ptr<DtxController> CreateDtxController(
       dtx_config.dtx_disabling_bandwidth_bps())));
 }
 
+std::unique_ptr<ComplexityController> CreateComplexityController(
+    const audio_network_adaptor::config::ComplexityController& config) {
+  RTC_CHECK(config.has_complexity());
+  RTC_CHECK(config.has_low_rate_complexity());
+  RTC_CHECK(config.has_complexity_threshold_bps());
+  RTC_CHECK(config.has_high_cpu_load());
+  RTC_CHECK(config.has_low_cpu_load());
+
+  return std::unique_ptr<ComplexityController>(
+      new ComplexityController(ComplexityController::Config(
+          config.complexity(), config.low_rate_complexity(),
+          config.min_complexity(), config.complexity_threshold_bps(),
+          config.complexity_threshold_window_bps(), config.high_cpu_load(),
+          config.low_cpu_load())));
+}
+
+std::unique_ptr<CongestionForecastController>
+CreateCongestionForecastController(
+    const audio_network_adaptor::config::CongestionForecastController& config,
+    rtc::ArrayView<const int> encoder_frame_lengths_ms,
+    bool initial_fec_enabled,
+    int initial_frame_length_ms) {
+  RTC_CHECK(config.has_fec_enabling_predicted_loss_fraction());
+  RTC_CHECK(config.has_bandwidth_drop_fraction());
+  RTC_CHECK(config.has_hold_time_ms());
+
+  absl::optional<int> congested_frame_length_ms;
+  if (config.has_congested_frame_length_ms() &&
+      std::find(encoder_frame_lengths_ms.begin(),
+                encoder_frame_lengths_ms.end(),
+                config.congested_frame_length_ms()) !=
+          encoder_frame_lengths_ms.end()) {
+    congested_frame_length_ms = config.congested_frame_length_ms();
+  }
+
+  return std::unique_ptr<CongestionForecastController>(
+      new CongestionForecastController(CongestionForecastController::Config(
+          config.fec_enabling_predicted_loss_fraction(),
+          config.bandwidth_drop_fraction(), congested_frame_length_ms,
+          config.hold_time_ms(), initial_fec_enabled,
+          initial_frame_length_ms)));
+}
+
 using audio_network_adaptor::BitrateController;
 std::unique_ptr<BitrateController> CreateBitrateController(
     const audio_network_adaptor::config::BitrateController& bitrate_config,
@@ -277,6 +323,20 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
             controller_config.bitrate_controller(), initial_bitrate_bps,
             initial_frame_length_ms);
         break;
+      case audio_network_adaptor::config::Controller::kComplexityController:
+        controller = CreateComplexityController(
+            controller_config.complexity_controller());
+        break;
+      case audio_network_adaptor::config::Controller::
+          kCongestionForecastController:
+        // It overrides the decisions of other controllers, so it can't be
+        // reordered.
+        RTC_CHECK(!controller_config.has_scoring_point());
+        controller = CreateCongestionForecastController(
+            controller_config.congestion_forecast_controller(),
+            encoder_frame_lengths_ms, initial_fec_enabled,
+            initial_frame_length_ms);
+        break;
       default:
         RTC_NOTREACHED();
     }
@@ -97,6 +97,11 @@ void DebugDumpWriterImpl::DumpNetworkMetrics(
         *metrics.uplink_packet_loss_fraction);
   }
 
+  if (metrics.predicted_uplink_packet_loss_fraction) {
+    dump_metrics->set_predicted_uplink_packet_loss_fraction(
+        *metrics.predicted_uplink_packet_loss_fraction);
+  }
+
   if (metrics.target_audio_bitrate_bps) {
     dump_metrics->set_target_audio_bitrate_bps(
         *metrics.target_audio_bitrate_bps);
@@ -29,6 +29,11 @@ class AudioNetworkAdaptor {
   virtual void SetUplinkPacketLossFraction(
       float uplink_packet_loss_fraction) = 0;
 
+  // Sets the packet loss fraction that the bandwidth estimator expects ahead
+  // of the loss reports, see BitrateAllocationUpdate.
+  virtual void SetPredictedUplinkPacketLossFraction(
+      float predicted_uplink_packet_loss_fraction) = 0;
+
   virtual void SetRtt(int rtt_ms) = 0;
 
   virtual void SetTargetAudioBitrate(int target_audio_bitrate_bps) = 0;
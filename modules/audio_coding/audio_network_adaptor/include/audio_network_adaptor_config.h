@@ -36,6 +36,9 @@ struct AudioEncoderRuntimeConfig {
   // to encode.
   absl::optional<size_t> num_channels;
 
+  // Complexity of the encoder, in the range of 0 to 10 used by Opus.
+  absl::optional<int> complexity;
+
   // This is true if the last frame length change was an increase, and otherwise
   // false.
   // The value of this boolean is used to apply a different offset to the
@@ -26,6 +26,9 @@ class MockAudioNetworkAdaptor : public AudioNetworkAdaptor {
   MOCK_METHOD1(SetUplinkPacketLossFraction,
                void(float uplink_packet_loss_fraction));
 
+  MOCK_METHOD1(SetPredictedUplinkPacketLossFraction,
+               void(float predicted_uplink_packet_loss_fraction));
+
   MOCK_METHOD1(SetRtt, void(int rtt_ms));
 
   MOCK_METHOD1(SetTargetAudioBitrate, void(int target_audio_bitrate_bps));
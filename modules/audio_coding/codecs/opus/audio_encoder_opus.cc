@@ -437,7 +437,8 @@ AudioEncoderOpusImpl::AudioEncoderOpusImpl(
       packet_loss_fraction_smoother_(new PacketLossFractionSmoother()),
       audio_network_adaptor_creator_(audio_network_adaptor_creator),
       bitrate_smoother_(std::move(bitrate_smoother)),
-      consecutive_dtx_frames_(0) {
+      consecutive_dtx_frames_(0),
+      complexity_set_by_adaptor_(false) {
   RTC_DCHECK(0 <= payload_type && payload_type <= 127);
 
   // Sanity check of the redundant payload type field that we want to get rid
@@ -537,6 +538,7 @@ bool AudioEncoderOpusImpl::EnableAudioNetworkAdaptor(
 
 void AudioEncoderOpusImpl::DisableAudioNetworkAdaptor() {
   audio_network_adaptor_.reset(nullptr);
+  complexity_set_by_adaptor_ = false;
 }
 
 void AudioEncoderOpusImpl::OnReceivedUplinkPacketLossFraction(
@@ -609,6 +611,10 @@ void AudioEncoderOpusImpl::OnReceivedUplinkBandwidth(
 
 void AudioEncoderOpusImpl::OnReceivedUplinkAllocation(
     BitrateAllocationUpdate update) {
+  if (audio_network_adaptor_) {
+    audio_network_adaptor_->SetPredictedUplinkPacketLossFraction(
+        static_cast<float>(update.predicted_packet_loss_ratio));
+  }
   OnReceivedUplinkBandwidth(update.target_bitrate.bps(), update.bwe_period.ms(),
                             update.stable_target_bitrate.bps());
 }
@@ -814,9 +820,20 @@ void AudioEncoderOpusImpl::SetTargetBitrate(int bits_per_second) {
     bitrate_changed_ = true;
   }
 
-  const auto new_complexity = GetNewComplexity(config_);
-  if (new_complexity && complexity_ != *new_complexity) {
-    complexity_ = *new_complexity;
+  // The audio network adaptor takes over the complexity from the bitrate
+  // threshold when it decides on it.
+  if (!complexity_set_by_adaptor_) {
+    const auto new_complexity = GetNewComplexity(config_);
+    if (new_complexity)
+      SetComplexity(*new_complexity);
+  }
+}
+
+void AudioEncoderOpusImpl::SetComplexity(int complexity) {
+  RTC_DCHECK_GE(complexity, 0);
+  RTC_DCHECK_LE(complexity, 10);
+  if (complexity_ != complexity) {
+    complexity_ = complexity;
     RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
   }
 }
@@ -824,6 +841,7 @@ void AudioEncoderOpusImpl::SetTargetBitrate(int bits_per_second) {
 void AudioEncoderOpusImpl::ApplyAudioNetworkAdaptor() {
   auto config = audio_network_adaptor_->GetEncoderRuntimeConfig();
 
+  complexity_set_by_adaptor_ = config.complexity.has_value();
   if (config.bitrate_bps)
     SetTargetBitrate(*config.bitrate_bps);
   if (config.frame_length_ms)
@@ -836,6 +854,8 @@ void AudioEncoderOpusImpl::ApplyAudioNetworkAdaptor() {
     SetDtx(*config.enable_dtx);
   if (config.num_channels)
     SetNumChannelsToEncode(*config.num_channels);
+  if (config.complexity)
+    SetComplexity(*config.complexity);
 }
 
 std::unique_ptr<AudioNetworkAdaptor>
@@ -75,6 +75,12 @@ class DecisionLogic : public NetEqController {
            rtc::CheckedDivExact(sample_rate_, 1000);
   }
 
+  int UnconstrainedTargetLevelMs() override {
+    const int level_q8 = delay_manager_->UnconstrainedTargetLevel();
+    return ((level_q8 * packet_length_samples_) >> 8) /
+           rtc::CheckedDivExact(sample_rate_, 1000);
+  }
+
   absl::optional<int> PacketArrived(bool last_cng_or_dtmf,
                                     size_t packet_length_samples,
                                     bool should_update_stats,
@@ -96,6 +102,9 @@ class DecisionLogic : public NetEqController {
   int GetBaseMinimumDelay() const override {
     return delay_manager_->GetBaseMinimumDelay();
   }
+  void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) override {
+    delay_manager_->UpdateQueueingDelayTrend(trend);
+  }
   bool PeakFound() const override { return false; }
 
   int GetFilteredBufferLevel() const override {
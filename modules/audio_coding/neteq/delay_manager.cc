@@ -19,6 +19,7 @@
 #include <numeric>
 #include <string>
 
+#include "api/units/time_delta.h"
 #include "modules/audio_coding/neteq/histogram.h"
 #include "modules/include/module_common_types_public.h"
 #include "rtc_base/checks.h"
@@ -38,6 +39,13 @@ constexpr int kMaxHistoryMs = 2000;  // Oldest packet to include in history to
 constexpr int kDelayBuckets = 100;
 constexpr int kBucketSizeMs = 20;
 constexpr int kDecelerationTargetLevelOffsetMs = 85 << 8;  // In Q8.
+constexpr int kQueueingDelayTrendTimeoutMs = 1000;
+// How far ahead the queueing delay trend is followed, and by how much the
+// target may grow because of it.
+constexpr webrtc::TimeDelta kQueueingDelayTrendHorizon =
+    webrtc::TimeDelta::Millis(200);
+constexpr webrtc::TimeDelta kMaxQueueingDelayGrowth =
+    webrtc::TimeDelta::Millis(100);
 
 int PercentileToQuantile(double percentile) {
   return static_cast<int>((1 << 30) * percentile / 100.0 + 0.5);
@@ -98,6 +106,7 @@ DelayManager::DelayManager(size_t max_packets_in_buffer,
       effective_minimum_delay_ms_(base_minimum_delay_ms),
       base_target_level_(4),                   // In Q0 domain.
       target_level_(base_target_level_ << 8),  // In Q8 domain.
+      unconstrained_target_level_(target_level_),
       packet_len_ms_(0),
       last_seq_no_(0),
       last_timestamp_(0),
@@ -195,6 +204,7 @@ absl::optional<int> DelayManager::Update(uint16_t sequence_number,
     }
     // Calculate new |target_level_| based on updated statistics.
     target_level_ = CalculateTargetLevel();
+    unconstrained_target_level_ = target_level_;
 
     LimitTargetLevel();
   }  // End if (packet_len_ms > 0).
@@ -282,9 +292,25 @@ int DelayManager::CalculateTargetLevel() {
   target_level = std::max(target_level, 1);
   // Scale to Q8 and assign to member variable.
   target_level_ = target_level << 8;
+
+  if (queueing_delay_trend_ && packet_len_ms_ > 0 &&
+      queueing_delay_trend_stopwatch_->ElapsedMs() <=
+          kQueueingDelayTrendTimeoutMs) {
+    int64_t change_ms = queueing_delay_trend_
+                            ->PredictedChange(kQueueingDelayTrendHorizon,
+                                              kMaxQueueingDelayGrowth)
+                            .ms();
+    target_level_ = std::max<int>(
+        1 << 8, target_level_ + change_ms * 256 / packet_len_ms_);
+  }
   return target_level_;
 }
 
+void DelayManager::UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) {
+  queueing_delay_trend_ = trend;
+  queueing_delay_trend_stopwatch_ = tick_timer_->GetNewStopwatch();
+}
+
 int DelayManager::SetPacketAudioLength(int length_ms) {
   if (length_ms <= 0) {
     RTC_LOG_F(LS_ERROR) << "length_ms = " << length_ms;
@@ -303,6 +329,7 @@ void DelayManager::Reset() {
   delay_history_.clear();
   base_target_level_ = 4;
   target_level_ = base_target_level_ << 8;
+  unconstrained_target_level_ = target_level_;
   packet_iat_stopwatch_ = tick_timer_->GetNewStopwatch();
   last_pack_cng_or_dtmf_ = 1;
 }
@@ -350,6 +377,10 @@ int DelayManager::TargetLevel() const {
   return target_level_;
 }
 
+int DelayManager::UnconstrainedTargetLevel() const {
+  return unconstrained_target_level_;
+}
+
 void DelayManager::LastDecodedWasCngOrDtmf(bool it_was) {
   if (it_was) {
     last_pack_cng_or_dtmf_ = 1;
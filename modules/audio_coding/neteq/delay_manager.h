@@ -18,6 +18,7 @@
 
 #include "absl/types/optional.h"
 #include "api/neteq/tick_timer.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "modules/audio_coding/neteq/histogram.h"
 #include "rtc_base/constructor_magic.h"
 
@@ -81,10 +82,20 @@ class DelayManager {
   // Gets the target buffer level, in (fractions of) packets in Q8.
   virtual int TargetLevel() const;
 
+  // Gets the target buffer level that the packet arrivals alone call for,
+  // before the minimum and maximum delays are applied, in Q8.
+  virtual int UnconstrainedTargetLevel() const;
+
   // Informs the delay manager whether or not the last decoded packet contained
   // speech.
   virtual void LastDecodedWasCngOrDtmf(bool it_was);
 
+  // Updates the queueing delay trend of the network path. The target level
+  // grows ahead of queues building up, and lets go of the delay they added as
+  // soon as they drain rather than once the histogram forgets it, until the
+  // trend is older than a second.
+  virtual void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend);
+
   // Notify the delay manager that empty packets have been received. These are
   // packets that are part of the sequence number series, so that an empty
   // packet will shift the sequence numbers for the following packets.
@@ -159,6 +170,7 @@ class DelayManager {
   // minimum-delay.
   int target_level_;         // Currently preferred buffer level in (fractions)
                              // of packets (Q8), before adding any extra delay.
+  int unconstrained_target_level_;  // |target_level_| before it is limited.
   int packet_len_ms_;        // Length of audio in each incoming packet [ms].
   uint16_t last_seq_no_;     // Sequence number for last received packet.
   uint32_t last_timestamp_;  // Timestamp for the last received packet.
@@ -168,6 +180,10 @@ class DelayManager {
   const bool enable_rtx_handling_;
   int num_reordered_packets_ = 0;  // Number of consecutive reordered packets.
 
+  absl::optional<QueueingDelayTrend> queueing_delay_trend_;
+  // Time since |queueing_delay_trend_| was updated.
+  std::unique_ptr<TickTimer::Stopwatch> queueing_delay_trend_stopwatch_;
+
   struct PacketDelay {
     int iat_delay_ms;
     uint32_t timestamp;
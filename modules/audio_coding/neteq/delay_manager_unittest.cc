@@ -194,6 +194,20 @@ TEST_F(DelayManagerTest, MinDelay) {
   EXPECT_EQ(kMinDelayPackets << 8, dm_->TargetLevel());
 }
 
+TEST_F(DelayManagerTest, UnconstrainedTargetLevelIgnoresMinDelay) {
+  const int kExpectedTarget = 5;
+  SetPacketAudioLength(kFrameSizeMs);
+  InsertNextPacket();
+  IncreaseTime(kExpectedTarget * kFrameSizeMs);
+  InsertNextPacket();
+
+  dm_->SetMinimumDelay((kExpectedTarget + 2) * kFrameSizeMs);
+  IncreaseTime(kFrameSizeMs);
+  InsertNextPacket();
+  EXPECT_EQ((kExpectedTarget + 2) << 8, dm_->TargetLevel());
+  EXPECT_EQ(kExpectedTarget << 8, dm_->UnconstrainedTargetLevel());
+}
+
 TEST_F(DelayManagerTest, BaseMinimumDelayCheckValidRange) {
   SetPacketAudioLength(kFrameSizeMs);
 
@@ -594,4 +608,30 @@ TEST_F(DelayManagerTest, DecelerationTargetLevelOffset) {
   }
 }
 
+TEST_F(DelayManagerTest, FollowsQueueingDelayTrend) {
+  SetPacketAudioLength(kFrameSizeMs);
+  InsertNextPacket();
+  IncreaseTime(kFrameSizeMs);
+  InsertNextPacket();
+  EXPECT_EQ(1 << 8, dm_->TargetLevel());
+
+  // Grows by 40 ms within the next 200 ms, two packets.
+  QueueingDelayTrend trend;
+  trend.queueing_delay = TimeDelta::Millis(100);
+  trend.slope_ms_per_s = 400;
+  trend.confidence = 0.5;
+  dm_->UpdateQueueingDelayTrend(trend);
+  IncreaseTime(kFrameSizeMs);
+  InsertNextPacket();
+  EXPECT_EQ(3 << 8, dm_->TargetLevel());
+  EXPECT_EQ(1, dm_->base_target_level());
+
+  // Draining, but at least a packet is kept.
+  trend.slope_ms_per_s = -400;
+  dm_->UpdateQueueingDelayTrend(trend);
+  IncreaseTime(kFrameSizeMs);
+  InsertNextPacket();
+  EXPECT_EQ(1 << 8, dm_->TargetLevel());
+}
+
 }  // namespace webrtc
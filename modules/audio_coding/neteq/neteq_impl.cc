@@ -324,12 +324,23 @@ int NetEqImpl::GetBaseMinimumDelayMs() const {
   return controller_->GetBaseMinimumDelay();
 }
 
+void NetEqImpl::UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) {
+  rtc::CritScope lock(&crit_sect_);
+  controller_->UpdateQueueingDelayTrend(trend);
+}
+
 int NetEqImpl::TargetDelayMs() const {
   rtc::CritScope lock(&crit_sect_);
   RTC_DCHECK(controller_.get());
   return controller_->TargetLevelMs();
 }
 
+int NetEqImpl::UnconstrainedTargetDelayMs() const {
+  rtc::CritScope lock(&crit_sect_);
+  RTC_DCHECK(controller_.get());
+  return controller_->UnconstrainedTargetLevelMs();
+}
+
 int NetEqImpl::FilteredCurrentDelayMs() const {
   rtc::CritScope lock(&crit_sect_);
   // Sum up the filtered packet buffer level with the future length of the sync
@@ -154,8 +154,12 @@ class NetEqImpl : public webrtc::NetEq {
 
   int GetBaseMinimumDelayMs() const override;
 
+  void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) override;
+
   int TargetDelayMs() const override;
 
+  int UnconstrainedTargetDelayMs() const override;
+
   int FilteredCurrentDelayMs() const override;
 
   // Writes the current network statistics to |stats|. The statistics are reset
@@ -11,11 +11,14 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
 #include "modules/include/module_common_types_public.h"  // IsNewerTimestamp
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/memory/memory_accounting.h"
 
 namespace webrtc {
 
@@ -23,7 +26,10 @@ class DecoderDatabase;
 class StatisticsCalculator;
 class TickTimer;
 
-// This is the actual buffer holding the packets before decoding.
+// This is the actual buffer holding the packets before decoding. The packets
+// are kept sorted in a ring of |max_number_of_packets| slots, allocated up
+// front, and are moved in and out of it, so buffering a packet does not
+// allocate.
 class PacketBuffer {
  public:
   enum BufferReturnCodes {
@@ -146,9 +152,29 @@ class PacketBuffer {
   }
 
  private:
+  // The |index|th packet in decoding order.
+  Packet& PacketAt(size_t index);
+  const Packet& PacketAt(size_t index) const;
+  // Moves |packet| in before the |index|th packet. The buffer must not be
+  // full.
+  void InsertAt(size_t index, Packet&& packet);
+  // Deletes the |index|th packet, keeping the order of the others.
+  void EraseAt(size_t index);
+  // Removes the first packet and returns it.
+  Packet PopFront();
+  // Deletes all packets for which |predicate| returns true, keeping the order
+  // of the others.
+  template <typename Predicate>
+  void RemoveIf(Predicate predicate);
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  std::vector<Packet> slots_;
+  size_t first_slot_ = 0;
+  size_t num_packets_ = 0;
   const TickTimer* tick_timer_;
+  // The slots and the payloads of the packets not parsed yet. The parsed
+  // frames don't tell their size.
+  TrackedMemory memory_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
 
@@ -19,12 +19,14 @@
 #include "modules/audio_coding/neteq/mock/mock_decoder_database.h"
 #include "modules/audio_coding/neteq/mock/mock_statistics_calculator.h"
 #include "modules/audio_coding/neteq/packet.h"
+#include "rtc_base/memory/memory_accounting.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
 using ::testing::_;
 using ::testing::InSequence;
 using ::testing::MockFunction;
+using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::StrictMock;
 
@@ -451,6 +453,158 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Inserts pairs of swapped packets many times the capacity of the buffer,
+// while extracting, so that the packets wrap around the end of its storage.
+TEST(PacketBuffer, KeepsOrderAcrossWraparound) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(5, &tick_timer);  // 5 packets.
+  const uint32_t start_ts = 4711;
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(17u, start_ts, 0, ts_increment);
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  const int payload_len = 10;
+
+  uint32_t current_ts = start_ts;
+  for (int i = 0; i < 50; ++i) {
+    Packet first = gen.NextPacket(payload_len, nullptr);
+    Packet second = gen.NextPacket(payload_len, nullptr);
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(std::move(second), &mock_stats));
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(std::move(first), &mock_stats));
+    // Keeps three packets in the buffer.
+    while (buffer.NumPacketsInBuffer() > 3) {
+      const absl::optional<Packet> packet = buffer.GetNextPacket();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(current_ts, packet->timestamp);
+      current_ts += ts_increment;
+    }
+  }
+  while (!buffer.Empty()) {
+    const absl::optional<Packet> packet = buffer.GetNextPacket();
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(current_ts, packet->timestamp);
+    current_ts += ts_increment;
+  }
+  EXPECT_EQ(start_ts + 100 * ts_increment, current_ts);
+}
+
+// Inserts speech and CNG packets of the builtin decoders into a buffer whose
+// packets wrap around the end of its storage, then discards the CNG packets.
+TEST(PacketBuffer, KeepsOrderWhenDiscardingAcrossWraparound) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(5, &tick_timer);  // 5 packets.
+  const uint8_t kSpeechPt = 0;
+  const uint8_t kCngPt = 13;
+  const uint32_t start_ts = 4711;
+  const uint32_t ts_increment = 10;
+  const int payload_len = 10;
+
+  MockDecoderDatabase decoder_database;
+  auto factory = CreateBuiltinAudioDecoderFactory();
+  const DecoderDatabase::DecoderInfo info_speech(
+      SdpAudioFormat("pcmu", 8000, 1), absl::nullopt, factory);
+  EXPECT_CALL(decoder_database, GetDecoderInfo(kSpeechPt))
+      .WillRepeatedly(Return(&info_speech));
+  const DecoderDatabase::DecoderInfo info_cng(SdpAudioFormat("cn", 8000, 1),
+                                              absl::nullopt, factory);
+  EXPECT_CALL(decoder_database, GetDecoderInfo(kCngPt))
+      .WillRepeatedly(Return(&info_cng));
+  StrictMock<MockStatisticsCalculator> mock_stats;
+
+  // Moves the first packet to the end of the storage.
+  PacketGenerator gen(17u, start_ts, kSpeechPt, ts_increment);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(gen.NextPacket(payload_len, nullptr),
+                                  &mock_stats));
+    ASSERT_TRUE(buffer.GetNextPacket());
+  }
+  PacketList list;
+  for (int i = 0; i < 5; ++i) {
+    Packet packet = gen.NextPacket(payload_len, nullptr);
+    if (i % 2) {
+      packet.payload_type = kCngPt;
+    }
+    list.push_back(std::move(packet));
+  }
+  absl::optional<uint8_t> current_pt;
+  absl::optional<uint8_t> current_cng_pt;
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacketList(&list, decoder_database, &current_pt,
+                                    &current_cng_pt, &mock_stats));
+  EXPECT_EQ(5u, buffer.NumPacketsInBuffer());
+
+  EXPECT_CALL(mock_stats, PacketsDiscarded(1)).Times(2);
+  buffer.DiscardPacketsWithPayloadType(kCngPt, &mock_stats);
+  EXPECT_EQ(3u, buffer.NumPacketsInBuffer());
+  uint32_t current_ts = start_ts + 4 * ts_increment;
+  while (!buffer.Empty()) {
+    const absl::optional<Packet> packet = buffer.GetNextPacket();
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(kSpeechPt, packet->payload_type);
+    EXPECT_EQ(current_ts, packet->timestamp);
+    current_ts += 2 * ts_increment;
+  }
+
+  EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
+}
+
+// Removes packets in each possible way, and checks that only the payloads
+// still in the buffer are accounted for.
+TEST(PacketBuffer, TracksTheMemoryOfThePayloads) {
+  TickTimer tick_timer;
+  // Other buffers may exist in the process, only differences are checked.
+  const int64_t initial_bytes =
+      GetTrackedMemoryBytes(MemoryCategory::kNetEqPacketBuffer);
+  {
+    PacketBuffer buffer(5, &tick_timer);  // 5 packets.
+    const int64_t empty_bytes =
+        GetTrackedMemoryBytes(MemoryCategory::kNetEqPacketBuffer);
+    const uint32_t start_ts = 4711;
+    const uint32_t ts_increment = 10;
+    PacketGenerator gen(17u, start_ts, 0, ts_increment);
+    NiceMock<MockStatisticsCalculator> mock_stats;
+
+    // Wraps the packets around the end of the storage.
+    for (int i = 0; i < 3; ++i) {
+      buffer.InsertPacket(gen.NextPacket(10, nullptr), &mock_stats);
+      ASSERT_TRUE(buffer.GetNextPacket());
+    }
+    for (int i = 0; i < 4; ++i) {
+      Packet packet = gen.NextPacket(10, nullptr);
+      if (i == 1) {
+        packet.priority.red_level = 1;
+      }
+      buffer.InsertPacket(std::move(packet), &mock_stats);
+    }
+    EXPECT_EQ(GetTrackedMemoryBytes(MemoryCategory::kNetEqPacketBuffer),
+              empty_bytes + 40);
+
+    // Replaces the second packet by one with a higher priority.
+    Packet packet = gen.NextPacket(20, nullptr);
+    packet.sequence_number = 17 + 4;
+    packet.timestamp = start_ts + 4 * ts_increment;
+    buffer.InsertPacket(std::move(packet), &mock_stats);
+    EXPECT_EQ(4u, buffer.NumPacketsInBuffer());
+    EXPECT_EQ(GetTrackedMemoryBytes(MemoryCategory::kNetEqPacketBuffer),
+              empty_bytes + 50);
+
+    EXPECT_EQ(PacketBuffer::kOK, buffer.DiscardNextPacket(&mock_stats));
+    EXPECT_EQ(GetTrackedMemoryBytes(MemoryCategory::kNetEqPacketBuffer),
+              empty_bytes + 40);
+    buffer.DiscardOldPackets(start_ts + 6 * ts_increment, 0, &mock_stats);
+    EXPECT_EQ(1u, buffer.NumPacketsInBuffer());
+    EXPECT_EQ(GetTrackedMemoryBytes(MemoryCategory::kNetEqPacketBuffer),
+              empty_bytes + 10);
+
+    // Leaves a packet for the destructor.
+    buffer.InsertPacket(gen.NextPacket(10, nullptr), &mock_stats);
+  }
+  EXPECT_EQ(GetTrackedMemoryBytes(MemoryCategory::kNetEqPacketBuffer),
+            initial_bytes);
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
@@ -41,6 +41,13 @@ namespace {
 
 constexpr int kFrameLengthUs = 10000;
 constexpr int kFramesPerSecond = rtc::kNumMicrosecsPerSec / kFrameLengthUs;
+// Frames whose deadline is this close are processed by the current tick, as
+// the delayed tasks run with a precision of a millisecond.
+constexpr int64_t kFrameDeadlineSlackUs = 1000;
+// Frames processed by a late tick to catch up, before the clock is restarted.
+constexpr int kMaxCatchUpFrames = 5;
+// Larger files are read from the disk as they are captured.
+constexpr size_t kMaxPrefetchedSamples = 16 * 1024 * 1024;
 
 // TestAudioDeviceModule implements an AudioDevice module that can act both as a
 // capturer and a renderer. It will use 10ms audio frames.
@@ -62,7 +69,7 @@ class TestAudioDeviceModuleImpl
                                   std::move(capturer),
                                   std::move(renderer),
                                   nullptr,
-                                  1) {}
+                                  speed) {}
 
   TestAudioDeviceModuleImpl(TaskQueueFactory* task_queue_factory,
                             std::unique_ptr<Capturer> capturer,
@@ -104,7 +111,7 @@ class TestAudioDeviceModuleImpl
             "TestAudioDeviceModuleImpl", TaskQueueFactory::Priority::NORMAL));
 
     RepeatingTaskHandle::Start(task_queue_->Get(), [this]() {
-      ProcessAudio();
+      ProcessDueFrames();
       return TimeDelta::Micros(process_interval_us_);
     });
     return 0;
@@ -134,7 +141,8 @@ class TestAudioDeviceModuleImpl
     rtc::CritScope cs(&lock_);
     RTC_CHECK(capturer_);
     capturing_ = true;
-    audio_started_->Set();
+    if (audio_started_)
+      audio_started_->Set();
     return 0;
   }
 
@@ -167,6 +175,26 @@ class TestAudioDeviceModuleImpl
   }
 
  private:
+  // The frames are due at fixed deadlines from the first tick, so that the
+  // late ticks and the rounding of the delays of the task queue do not add up
+  // over time.
+  void ProcessDueFrames() {
+    const int64_t now_us = rtc::TimeMicros();
+    if (next_frame_time_us_ < 0)
+      next_frame_time_us_ = now_us;
+    int frames = 0;
+    while (next_frame_time_us_ <= now_us + kFrameDeadlineSlackUs) {
+      if (frames == kMaxCatchUpFrames) {
+        // Stalled for too long, drop the missed frames rather than bursting.
+        next_frame_time_us_ = now_us + process_interval_us_;
+        break;
+      }
+      ProcessAudio();
+      next_frame_time_us_ += process_interval_us_;
+      ++frames;
+    }
+  }
+
   void ProcessAudio() {
     rtc::CritScope cs(&lock_);
     if (capturing_) {
@@ -206,6 +234,8 @@ class TestAudioDeviceModuleImpl
   const std::unique_ptr<Capturer> capturer_ RTC_GUARDED_BY(lock_);
   const std::unique_ptr<Renderer> renderer_ RTC_GUARDED_BY(lock_);
   const int64_t process_interval_us_;
+  // Only accessed on |task_queue_|.
+  int64_t next_frame_time_us_ = -1;
 
   rtc::CriticalSection lock_;
   AudioTransport* audio_callback_ RTC_GUARDED_BY(lock_);
@@ -298,17 +328,7 @@ class WavFileReader final : public TestAudioDeviceModule::Capturer {
         TestAudioDeviceModule::SamplesPerFrame(sampling_frequency_in_hz_) *
             num_channels_,
         [&](rtc::ArrayView<int16_t> data) {
-          size_t read = wav_reader_->ReadSamples(data.size(), data.data());
-          if (read < data.size() && repeat_) {
-            do {
-              wav_reader_->Reset();
-              size_t delta = wav_reader_->ReadSamples(
-                  data.size() - read, data.subview(read).data());
-              RTC_CHECK_GT(delta, 0) << "No new data read from file";
-              read += delta;
-            } while (read < data.size());
-          }
-          return read;
+          return wav_reader_ ? ReadFromFile(data) : ReadFromMemory(data);
         });
     return buffer->size() > 0;
   }
@@ -324,11 +344,57 @@ class WavFileReader final : public TestAudioDeviceModule::Capturer {
         repeat_(repeat) {
     RTC_CHECK_EQ(wav_reader_->sample_rate(), sampling_frequency_in_hz);
     RTC_CHECK_EQ(wav_reader_->num_channels(), num_channels);
+    // Reads the whole file up front, so that capturing, and repeating the
+    // file, does not touch the disk on the audio task queue.
+    if (wav_reader_->num_samples() <= kMaxPrefetchedSamples) {
+      samples_.SetData(wav_reader_->num_samples(),
+                       [&](rtc::ArrayView<int16_t> data) {
+                         return wav_reader_->ReadSamples(data.size(),
+                                                         data.data());
+                       });
+      wav_reader_.reset();
+    }
+  }
+
+  size_t ReadFromFile(rtc::ArrayView<int16_t> data) {
+    size_t read = wav_reader_->ReadSamples(data.size(), data.data());
+    if (read < data.size() && repeat_) {
+      do {
+        wav_reader_->Reset();
+        size_t delta = wav_reader_->ReadSamples(data.size() - read,
+                                                data.subview(read).data());
+        RTC_CHECK_GT(delta, 0) << "No new data read from file";
+        read += delta;
+      } while (read < data.size());
+    }
+    return read;
+  }
+
+  size_t ReadFromMemory(rtc::ArrayView<int16_t> data) {
+    size_t read = 0;
+    while (read < data.size()) {
+      if (read_position_ == samples_.size()) {
+        if (!repeat_)
+          break;
+        RTC_CHECK_GT(samples_.size(), 0) << "No new data read from file";
+        read_position_ = 0;
+      }
+      const size_t count =
+          std::min(data.size() - read, samples_.size() - read_position_);
+      std::copy(samples_.data() + read_position_,
+                samples_.data() + read_position_ + count, data.data() + read);
+      read_position_ += count;
+      read += count;
+    }
+    return read;
   }
 
   const int sampling_frequency_in_hz_;
   const int num_channels_;
+  // Null once the file is prefetched into |samples_|.
   std::unique_ptr<WavReader> wav_reader_;
+  rtc::BufferT<int16_t> samples_;
+  size_t read_position_ = 0;
   const bool repeat_;
 };
 
@@ -473,7 +539,7 @@ rtc::scoped_refptr<TestAudioDeviceModule> TestAudioDeviceModule::Create(
     float speed) {
   return new rtc::RefCountedObject<TestAudioDeviceModuleImpl>(
       task_queue_factory, std::move(capturer), std::move(renderer),
-      audio_started);
+      audio_started, speed);
 }
 
 std::unique_ptr<TestAudioDeviceModule::PulsedNoiseCapturer>
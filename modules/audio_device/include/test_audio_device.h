@@ -73,7 +73,8 @@ class TestAudioDeviceModule : public AudioDeviceModule {
   ~TestAudioDeviceModule() override {}
 
   // Creates a new TestAudioDeviceModule. When capturing or playing, 10 ms audio
-  // frames will be processed every 10ms / |speed|.
+  // frames will be processed every 10ms / |speed|, on deadlines fixed from the
+  // start so that the timing does not drift.
   // |capturer| is an object that produces audio data. Can be nullptr if this
   // device is never used for recording.
   // |renderer| is an object that receives audio data that would have been
@@ -109,7 +110,8 @@ class TestAudioDeviceModule : public AudioDeviceModule {
       int sampling_frequency_in_hz,
       int num_channels = 1);
 
-  // WavReader and WavWriter creation based on file name.
+  // WavReader and WavWriter creation based on file name. The readers load
+  // files of up to 32 MiB into memory when they are created.
 
   // Returns a Capturer instance that gets its data from a file. The sample rate
   // and channels will be checked against the Wav file.
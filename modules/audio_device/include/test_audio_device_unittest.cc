@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <array>
+#include <vector>
 
 #include "api/array_view.h"
 #include "common_audio/wav_file.h"
@@ -64,6 +65,10 @@ void RunTest(const std::vector<int16_t>& input_samples,
 
   remove(output_filename.c_str());
 }
+
+std::vector<int16_t> ToVector(const rtc::BufferT<int16_t>& buffer) {
+  return std::vector<int16_t>(buffer.begin(), buffer.end());
+}
 }  // namespace
 
 TEST(BoundedWavFileWriterTest, NoSilence) {
@@ -163,6 +168,65 @@ TEST(WavFileReaderTest, RepeatedTrueWithSingleFrameFileReadTwice) {
   remove(output_filename.c_str());
 }
 
+TEST(WavFileReaderTest, RepeatedTrueWrapsAroundWithinAFrame) {
+  static const std::vector<int16_t> kInputSamples = {1, 2, 3, 4, 5, 6, 7,
+                                                     8, 9, 10, 11, 12};
+
+  const std::string output_filename = test::OutputPath() +
+                                      "WavFileReaderTest_RepeatedWraps_" +
+                                      std::to_string(std::rand()) + ".wav";
+
+  // Create wav file to read.
+  {
+    WavWriter writer(output_filename, 800, 1);
+    writer.WriteSamples(kInputSamples.data(), kInputSamples.size());
+  }
+
+  {
+    std::unique_ptr<TestAudioDeviceModule::Capturer> reader =
+        TestAudioDeviceModule::CreateWavFileReader(output_filename, true);
+    rtc::BufferT<int16_t> buffer;
+    EXPECT_TRUE(reader->Capture(&buffer));
+    EXPECT_EQ(ToVector(buffer), std::vector<int16_t>({1, 2, 3, 4, 5, 6, 7, 8}));
+    EXPECT_TRUE(reader->Capture(&buffer));
+    EXPECT_EQ(ToVector(buffer),
+              std::vector<int16_t>({9, 10, 11, 12, 1, 2, 3, 4}));
+    EXPECT_TRUE(reader->Capture(&buffer));
+    EXPECT_EQ(ToVector(buffer),
+              std::vector<int16_t>({5, 6, 7, 8, 9, 10, 11, 12}));
+  }
+
+  remove(output_filename.c_str());
+}
+
+TEST(WavFileReaderTest, RepeatedFalseStopsAtTheEnd) {
+  static const std::vector<int16_t> kInputSamples = {1, 2, 3, 4, 5, 6, 7,
+                                                     8, 9, 10, 11, 12};
+
+  const std::string output_filename = test::OutputPath() +
+                                      "WavFileReaderTest_RepeatedFalse_" +
+                                      std::to_string(std::rand()) + ".wav";
+
+  // Create wav file to read.
+  {
+    WavWriter writer(output_filename, 800, 1);
+    writer.WriteSamples(kInputSamples.data(), kInputSamples.size());
+  }
+
+  {
+    std::unique_ptr<TestAudioDeviceModule::Capturer> reader =
+        TestAudioDeviceModule::CreateWavFileReader(output_filename, false);
+    rtc::BufferT<int16_t> buffer;
+    EXPECT_TRUE(reader->Capture(&buffer));
+    EXPECT_EQ(8u, buffer.size());
+    EXPECT_TRUE(reader->Capture(&buffer));
+    EXPECT_EQ(ToVector(buffer), std::vector<int16_t>({9, 10, 11, 12}));
+    EXPECT_FALSE(reader->Capture(&buffer));
+  }
+
+  remove(output_filename.c_str());
+}
+
 TEST(PulsedNoiseCapturerTest, SetMaxAmplitude) {
   const int16_t kAmplitude = 50;
   std::unique_ptr<TestAudioDeviceModule::PulsedNoiseCapturer> capturer =
@@ -22,22 +22,27 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread_pool.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
 
-struct SourceFrame {
-  SourceFrame(AudioMixerImpl::SourceStatus* source_status,
-              AudioFrame* audio_frame,
-              bool muted)
-      : source_status(source_status), audio_frame(audio_frame), muted(muted) {
-    RTC_DCHECK(source_status);
-    RTC_DCHECK(audio_frame);
-    if (!muted) {
-      energy = AudioMixerCalculateEnergy(*audio_frame);
-    }
-  }
+// With fewer sources, handing the jobs to other threads costs about as much
+// as getting the audio on the mixing thread.
+constexpr size_t kMinSourcesToGetInParallel = 4;
+
+// Process wide pool with a thread per core but one, created on first use and
+// never destroyed. Decoding runs at the priority of the audio thread.
+ThreadPool* MixerThreadPool() {
+  static ThreadPool* const pool = new ThreadPool(
+      std::max(1, static_cast<int>(CpuInfo::DetectNumberOfCores()) - 1),
+      "MixerThread", rtc::kRealtimePriority);
+  return pool;
+}
 
+struct SourceFrame {
   SourceFrame(AudioMixerImpl::SourceStatus* source_status,
               AudioFrame* audio_frame,
               bool muted,
@@ -100,7 +105,9 @@ AudioMixerImpl::AudioMixerImpl(
       output_frequency_(0),
       sample_size_(0),
       audio_source_list_(),
-      frame_combiner_(use_limiter) {}
+      frame_combiner_(use_limiter),
+      get_audio_in_parallel_(
+          field_trial::IsEnabled("WebRTC-AudioMixer-ParallelSources")) {}
 
 AudioMixerImpl::~AudioMixerImpl() {}
 
@@ -181,19 +188,22 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   std::vector<SourceFrame> audio_source_mixing_data_list;
   std::vector<SourceFrame> ramp_list;
 
-  // Get audio from the audio sources and put it in the SourceFrame vector.
-  for (auto& source_and_status : audio_source_list_) {
-    const auto audio_frame_info =
-        source_and_status->audio_source->GetAudioFrameWithInfo(
-            OutputFrequency(), &source_and_status->audio_frame);
+  std::vector<Source::AudioFrameInfo> frame_infos;
+  std::vector<uint32_t> energies;
+  GetAudioFrames(&frame_infos, &energies);
+
+  // Put the audio from the audio sources in the SourceFrame vector.
+  for (size_t i = 0; i < audio_source_list_.size(); ++i) {
+    SourceStatus* source_and_status = audio_source_list_[i].get();
+    const auto audio_frame_info = frame_infos[i];
 
     if (audio_frame_info == Source::AudioFrameInfo::kError) {
       RTC_LOG_F(LS_WARNING) << "failed to GetAudioFrameWithInfo() from source";
       continue;
     }
     audio_source_mixing_data_list.emplace_back(
-        source_and_status.get(), &source_and_status->audio_frame,
-        audio_frame_info == Source::AudioFrameInfo::kMuted);
+        source_and_status, &source_and_status->audio_frame,
+        audio_frame_info == Source::AudioFrameInfo::kMuted, energies[i]);
   }
 
   // Sort frames by sorting function.
@@ -224,6 +234,36 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   return result;
 }
 
+void AudioMixerImpl::GetAudioFrames(
+    std::vector<Source::AudioFrameInfo>* frame_infos,
+    std::vector<uint32_t>* energies) {
+  const size_t number_of_sources = audio_source_list_.size();
+  frame_infos->resize(number_of_sources);
+  energies->resize(number_of_sources);
+  const int output_frequency = OutputFrequency();
+  // Each job only touches the status of its own source.
+  auto get_audio_frame = [&](size_t i) {
+    SourceStatus* source_and_status = audio_source_list_[i].get();
+    const auto audio_frame_info =
+        source_and_status->audio_source->GetAudioFrameWithInfo(
+            output_frequency, &source_and_status->audio_frame);
+    (*frame_infos)[i] = audio_frame_info;
+    (*energies)[i] = audio_frame_info == Source::AudioFrameInfo::kNormal
+                         ? AudioMixerCalculateEnergy(
+                               source_and_status->audio_frame)
+                         : 0;
+  };
+
+  if (get_audio_in_parallel_ &&
+      number_of_sources >= kMinSourcesToGetInParallel) {
+    MixerThreadPool()->RunAndWait(number_of_sources, get_audio_frame);
+    return;
+  }
+  for (size_t i = 0; i < number_of_sources; ++i) {
+    get_audio_frame(i);
+  }
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
@@ -23,6 +23,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/task_queue_for_test.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -641,4 +642,53 @@ TEST(AudioMixer, MultipleChannelsAndHighRate) {
 #endif
 }
 
+TEST(AudioMixer, ParallelSourcesMixAsSequentialSources) {
+  constexpr int kAudioSources = 20;
+  constexpr int kRounds = 5;
+  std::vector<MockMixerAudioSource> sources(2 * kAudioSources);
+  for (int i = 0; i < 2 * kAudioSources; ++i) {
+    const int source = i % kAudioSources;
+    ResetFrame(sources[i].fake_frame());
+    int16_t* data = sources[i].fake_frame()->mutable_data();
+    for (size_t k = 0; k < sources[i].fake_frame()->samples_per_channel_; ++k)
+      data[k] = static_cast<int16_t>((source + 1) * 100 *
+                                      (static_cast<int>(k % 7) - 3));
+    if (source == 3) {
+      sources[i].set_fake_info(AudioMixer::Source::AudioFrameInfo::kMuted);
+    } else if (source == 5) {
+      sources[i].set_fake_info(AudioMixer::Source::AudioFrameInfo::kError);
+    }
+  }
+
+  const auto sequential_mixer = AudioMixerImpl::Create();
+  rtc::scoped_refptr<AudioMixerImpl> parallel_mixer;
+  {
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-AudioMixer-ParallelSources/Enabled/");
+    parallel_mixer = AudioMixerImpl::Create();
+  }
+  for (int i = 0; i < kAudioSources; ++i) {
+    EXPECT_TRUE(sequential_mixer->AddSource(&sources[i]));
+    EXPECT_TRUE(parallel_mixer->AddSource(&sources[kAudioSources + i]));
+  }
+
+  AudioFrame sequential_frame;
+  AudioFrame parallel_frame;
+  for (int round = 0; round < kRounds; ++round) {
+    sequential_mixer->Mix(1, &sequential_frame);
+    parallel_mixer->Mix(1, &parallel_frame);
+    ASSERT_EQ(sequential_frame.samples_per_channel_,
+              parallel_frame.samples_per_channel_);
+    EXPECT_EQ(0, memcmp(sequential_frame.data(), parallel_frame.data(),
+                        sizeof(int16_t) * parallel_frame.samples_per_channel_));
+    for (int i = 0; i < kAudioSources; ++i) {
+      EXPECT_EQ(
+          sequential_mixer->GetAudioSourceMixabilityStatusForTest(&sources[i]),
+          parallel_mixer->GetAudioSourceMixabilityStatusForTest(
+              &sources[kAudioSources + i]))
+          << "Mixed status of AudioSource #" << i << " differs.";
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -80,21 +80,31 @@ void MixToFloatFrame(const std::vector<AudioFrame*>& mix_list,
                      MixingBuffer* mixing_buffer) {
   RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
-  // Clear the mixing buffer.
-  for (auto& one_channel_buffer : *mixing_buffer) {
-    std::fill(one_channel_buffer.begin(), one_channel_buffer.end(), 0.f);
+  const size_t mixed_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t mixed_samples =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+  // Clear the part of the mixing buffer that is used.
+  for (size_t j = 0; j < mixed_channels; ++j) {
+    std::fill((*mixing_buffer)[j].begin(),
+              (*mixing_buffer)[j].begin() + mixed_samples, 0.f);
   }
 
-  // Convert to FloatS16 and mix.
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
-    for (size_t j = 0; j < std::min(number_of_channels,
-                                    FrameCombiner::kMaximumNumberOfChannels);
-         ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
-        (*mixing_buffer)[j][k] += frame->data()[number_of_channels * k + j];
+  // Convert to FloatS16 and mix. The loops over the samples of a channel
+  // have no dependencies and are vectorized, mono frames unit stride.
+  for (const AudioFrame* const frame : mix_list) {
+    const int16_t* const data = frame->data();
+    if (number_of_channels == 1) {
+      float* const mixed = (*mixing_buffer)[0].data();
+      for (size_t k = 0; k < mixed_samples; ++k) {
+        mixed[k] += data[k];
+      }
+      continue;
+    }
+    for (size_t j = 0; j < mixed_channels; ++j) {
+      float* const mixed = (*mixing_buffer)[j].data();
+      for (size_t k = 0; k < mixed_samples; ++k) {
+        mixed[k] += data[number_of_channels * k + j];
       }
     }
   }
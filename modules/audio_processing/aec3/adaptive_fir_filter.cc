@@ -27,6 +27,10 @@
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "rtc_base/checks.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/audio_processing/aec3/adaptive_fir_filter_avx512.h"
+#endif
+
 namespace webrtc {
 
 namespace aec3 {
@@ -553,6 +557,11 @@ void AdaptiveFirFilter::Filter(const RenderBuffer& render_buffer,
   RTC_DCHECK(S);
   switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kAvx512:
+      aec3::ApplyFilter_Avx512(render_buffer.GetFftBuffer(),
+                               render_buffer.Position(),
+                               current_size_partitions_, H_, S);
+      break;
     case Aec3Optimization::kSse2:
       aec3::ApplyFilter_Sse2(render_buffer, current_size_partitions_, H_, S);
       break;
@@ -594,6 +603,9 @@ void AdaptiveFirFilter::ComputeFrequencyResponse(
 
   switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kAvx512:
+      aec3::ComputeFrequencyResponse_Avx512(current_size_partitions_, H_, H2);
+      break;
     case Aec3Optimization::kSse2:
       aec3::ComputeFrequencyResponse_Sse2(current_size_partitions_, H_, H2);
       break;
@@ -616,6 +628,11 @@ void AdaptiveFirFilter::AdaptAndUpdateSize(const RenderBuffer& render_buffer,
   // Adapt the filter.
   switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kAvx512:
+      aec3::AdaptPartitions_Avx512(render_buffer.GetFftBuffer(),
+                                   render_buffer.Position(), G,
+                                   current_size_partitions_, &H_);
+      break;
     case Aec3Optimization::kSse2:
       aec3::AdaptPartitions_Sse2(render_buffer, G, current_size_partitions_,
                                  &H_);
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_ADAPTIVE_FIR_FILTER_AVX512_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_ADAPTIVE_FIR_FILTER_AVX512_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+
+namespace webrtc {
+namespace aec3 {
+
+// AVX-512 variants of the adaptive FIR filter kernels. They only take the
+// spectra of the render buffer, given by |render_buffer_data| and the
+// |render_buffer_position| of its most recent partition, so that they do not
+// depend on the rest of AEC3. Must only be called when
+// WebRtc_GetCPUInfo(kAVX512) reports support.
+
+void ComputeFrequencyResponse_Avx512(
+    size_t num_partitions,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+
+void AdaptPartitions_Avx512(
+    rtc::ArrayView<const std::vector<FftData>> render_buffer_data,
+    size_t render_buffer_position,
+    const FftData& G,
+    size_t num_partitions,
+    std::vector<std::vector<FftData>>* H);
+
+void ApplyFilter_Avx512(
+    rtc::ArrayView<const std::vector<FftData>> render_buffer_data,
+    size_t render_buffer_position,
+    size_t num_partitions,
+    const std::vector<std::vector<FftData>>& H,
+    FftData* S);
+
+}  // namespace aec3
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_ADAPTIVE_FIR_FILTER_AVX512_H_
@@ -82,6 +82,7 @@ void ComputeErl(const Aec3Optimization& optimization,
   // Update the frequency response and echo return loss for the filter.
   switch (optimization) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kAvx512:
     case Aec3Optimization::kSse2:
       aec3::ErlComputer_SSE2(H2, erl);
       break;
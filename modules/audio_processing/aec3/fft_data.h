@@ -40,12 +40,18 @@ struct FftData {
     im.fill(0.f);
   }
 
+  // AVX-512 variant of Spectrum(), only to be used after checking CPU support.
+  void SpectrumAvx512(rtc::ArrayView<float> power_spectrum) const;
+
   // Computes the power spectrum of the data.
   void Spectrum(Aec3Optimization optimization,
                 rtc::ArrayView<float> power_spectrum) const {
     RTC_DCHECK_EQ(kFftLengthBy2Plus1, power_spectrum.size());
     switch (optimization) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kAvx512:
+        SpectrumAvx512(power_spectrum);
+        break;
       case Aec3Optimization::kSse2: {
         constexpr int kNumFourBinBands = kFftLengthBy2 / 4;
         constexpr int kLimit = kNumFourBinBands * 4;
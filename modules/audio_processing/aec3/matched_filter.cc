@@ -25,6 +25,9 @@
 #include <numeric>
 
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/audio_processing/aec3/matched_filter_avx512.h"
+#endif
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -359,6 +362,11 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
 
     switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kAvx512:
+        aec3::MatchedFilterCore_AVX512(
+            x_start_index, x2_sum_threshold, smoothing_, render_buffer.buffer,
+            y, filters_[n], &filters_updated, &error_sum);
+        break;
       case Aec3Optimization::kSse2:
         aec3::MatchedFilterCore_SSE2(x_start_index, x2_sum_threshold,
                                      smoothing_, render_buffer.buffer, y,
@@ -19,11 +19,19 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_minmax.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
 namespace {
 
+// The capture thread and at most this many pool threads share the channels.
+constexpr size_t kMaxNumThreads = 3;
+
+bool UseThreadPool() {
+  return field_trial::IsEnabled("WebRTC-Aec3ParallelCaptureChannels");
+}
+
 void PredictionError(const Aec3Fft& fft,
                      const FftData& S,
                      rtc::ArrayView<const float> y,
@@ -84,6 +92,12 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
                                  config_.filter.refined_initial.length_blocks,
                                  config_.filter.refined.length_blocks)),
                              0.f)) {
+  if (num_capture_channels_ > 1 && UseThreadPool()) {
+    // Runs at the priority of the capture thread.
+    thread_pool_ = std::make_unique<ThreadPool>(
+        static_cast<int>(std::min(num_capture_channels_ - 1, kMaxNumThreads)),
+        "Aec3Thread", rtc::kRealtimePriority);
+  }
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     refined_filters_[ch] = std::make_unique<AdaptiveFirFilter>(
         config_.filter.refined.length_blocks,
@@ -181,8 +195,9 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                                &X2_coarse);
   }
 
-  // Process all capture channels
-  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+  // Process all capture channels. The channels share no state, other than
+  // the data dumper, which is only used for the first channel.
+  auto process_channel = [&](size_t ch) {
     RTC_DCHECK_EQ(kBlockSize, capture[ch].size());
     SubtractorOutput& output = outputs[ch];
     rtc::ArrayView<const float> y = capture[ch];
@@ -282,6 +297,13 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
       data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
                             &e_coarse[0], 16000, 1);
     }
+  };
+  if (thread_pool_) {
+    thread_pool_->RunAndWait(num_capture_channels_, process_channel);
+  } else {
+    for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+      process_channel(ch);
+    }
   }
 }
 
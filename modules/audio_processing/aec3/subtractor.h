@@ -31,6 +31,7 @@
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/thread_pool.h"
 
 namespace webrtc {
 
@@ -130,6 +131,8 @@ class Subtractor {
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>
       refined_frequency_responses_;
   std::vector<std::vector<float>> refined_impulse_responses_;
+  // Adapts the filters of the capture channels at the same time, if enabled.
+  std::unique_ptr<ThreadPool> thread_pool_;
 };
 
 }  // namespace webrtc
@@ -21,6 +21,7 @@
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -334,4 +335,23 @@ TEST_P(SubtractorMultiChannelUpToFourRender,
     EXPECT_NEAR(1.f, echo_to_nearend_power, 0.25f);
   }
 }
+
+// Verifies that processing the capture channels on the thread pool gives the
+// same output as processing them one after another.
+TEST(Subtractor, ParallelChannelsProcessAsSequentialChannels) {
+  constexpr size_t kNumRenderChannels = 2;
+  constexpr size_t kNumCaptureChannels = 4;
+  constexpr int kNumBlocksToProcess = 500;
+  const std::vector<int> blocks_with_echo_path_changes = {200};
+  std::vector<float> sequential_powers = RunSubtractorTest(
+      kNumRenderChannels, kNumCaptureChannels, kNumBlocksToProcess, 64, 20, 20,
+      false, blocks_with_echo_path_changes);
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Aec3ParallelCaptureChannels/Enabled/");
+  std::vector<float> parallel_powers = RunSubtractorTest(
+      kNumRenderChannels, kNumCaptureChannels, kNumBlocksToProcess, 64, 20, 20,
+      false, blocks_with_echo_path_changes);
+  EXPECT_EQ(sequential_powers, parallel_powers);
+}
+
 }  // namespace webrtc
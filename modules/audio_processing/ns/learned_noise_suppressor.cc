@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/learned_noise_suppressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
+
+namespace webrtc {
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+
+// Band edges in Hz, roughly following the ERB scale up to 24 kHz.
+constexpr std::array<float, LearnedNoiseSuppressor::kNumBands + 1>
+    kBandEdgesHz = {0.f,    200.f,  400.f,   600.f,   800.f,   1000.f,
+                    1200.f, 1400.f, 1600.f,  2000.f,  2400.f,  2800.f,
+                    3200.f, 4000.f, 4800.f,  5600.f,  6800.f,  8000.f,
+                    9600.f, 12000.f, 15600.f, 20000.f, 24000.f};
+
+float BandCenterHz(size_t band) {
+  return 0.5f * (kBandEdgesHz[band] + kBandEdgesHz[band + 1]);
+}
+
+}  // namespace
+
+constexpr size_t LearnedNoiseSuppressor::kNumBands;
+constexpr float LearnedNoiseSuppressor::kEnergyOffset;
+
+std::unique_ptr<LearnedNoiseSuppressor> LearnedNoiseSuppressor::Create(
+    std::unique_ptr<bwe_model::BweModel> model) {
+  if (!model || model->input_size() != kNumBands ||
+      model->output_size() != kNumBands) {
+    RTC_LOG(LS_ERROR) << "The noise suppression model must map " << kNumBands
+                      << " band energies to " << kNumBands << " gains.";
+    return nullptr;
+  }
+  return std::unique_ptr<LearnedNoiseSuppressor>(
+      new LearnedNoiseSuppressor(std::move(model)));
+}
+
+std::unique_ptr<LearnedNoiseSuppressor> LearnedNoiseSuppressor::Create(
+    const std::string& model_path) {
+  std::unique_ptr<bwe_model::BweModel> model =
+      bwe_model::BweModel::Load(model_path);
+  if (!model) {
+    RTC_LOG(LS_ERROR) << "Failed to load the noise suppression model "
+                      << model_path;
+    return nullptr;
+  }
+  return Create(std::move(model));
+}
+
+LearnedNoiseSuppressor::LearnedNoiseSuppressor(
+    std::unique_ptr<bwe_model::BweModel> model)
+    : model_(std::move(model)) {}
+
+LearnedNoiseSuppressor::~LearnedNoiseSuppressor() = default;
+
+void LearnedNoiseSuppressor::Initialize(int sample_rate_hz, int num_channels) {
+  RTC_DCHECK_LT(0, sample_rate_hz);
+  RTC_DCHECK_LT(0, num_channels);
+  frame_size_ = rtc::CheckedDivExact(sample_rate_hz, 100);
+  const size_t window_size = 2 * frame_size_;
+  fft_ = RealFourier::Create(RealFourier::FftOrder(window_size));
+  const size_t fft_size = RealFourier::FftLength(fft_->order());
+  num_bins_ = RealFourier::ComplexLength(fft_->order());
+
+  // The squared periodic Hann windows of two neighboring frames add up to one.
+  window_.resize(window_size);
+  for (size_t n = 0; n < window_size; ++n) {
+    window_[n] = std::sqrt(0.5f - 0.5f * std::cos(2.f * kPi * n / window_size));
+  }
+
+  bin_bands_.resize(num_bins_);
+  bin_weights_.resize(num_bins_);
+  size_t band = 0;
+  for (size_t k = 0; k < num_bins_; ++k) {
+    const float frequency_hz =
+        static_cast<float>(k) * sample_rate_hz / fft_size;
+    while (band + 2 < kNumBands && BandCenterHz(band + 1) <= frequency_hz) {
+      ++band;
+    }
+    bin_bands_[k] = band;
+    bin_weights_[k] = rtc::SafeClamp(
+        (frequency_hz - BandCenterHz(band)) /
+            (BandCenterHz(band + 1) - BandCenterHz(band)),
+        0.f, 1.f);
+  }
+
+  channels_.resize(num_channels);
+  for (ChannelState& channel : channels_) {
+    channel.analysis_memory.assign(frame_size_, 0.f);
+    channel.synthesis_memory.assign(frame_size_, 0.f);
+    channel.spectrum = RealFourier::AllocCplxBuffer(num_bins_);
+  }
+  time_buffer_ = RealFourier::AllocRealBuffer(fft_size);
+  bin_gains_.resize(num_bins_);
+  model_->Reset();
+}
+
+void LearnedNoiseSuppressor::Process(AudioBuffer* audio) {
+  RTC_DCHECK(audio);
+  RTC_DCHECK(fft_);
+  RTC_DCHECK_EQ(frame_size_, audio->num_frames());
+  RTC_DCHECK_EQ(channels_.size(), audio->num_channels());
+  const size_t fft_size = RealFourier::FftLength(fft_->order());
+  float* const time = time_buffer_.get();
+
+  // Analysis.
+  band_energies_.fill(0.f);
+  for (size_t ch = 0; ch < channels_.size(); ++ch) {
+    ChannelState& channel = channels_[ch];
+    const float* input = audio->channels_const()[ch];
+    for (size_t n = 0; n < frame_size_; ++n) {
+      time[n] = window_[n] * channel.analysis_memory[n];
+      time[frame_size_ + n] = window_[frame_size_ + n] * input[n];
+    }
+    std::fill(time + 2 * frame_size_, time + fft_size, 0.f);
+    std::copy(input, input + frame_size_, channel.analysis_memory.begin());
+    fft_->Forward(time, channel.spectrum.get());
+
+    for (size_t k = 0; k < num_bins_; ++k) {
+      const float energy = std::norm(channel.spectrum[k]);
+      band_energies_[bin_bands_[k]] += (1.f - bin_weights_[k]) * energy;
+      band_energies_[bin_bands_[k] + 1] += bin_weights_[k] * energy;
+    }
+  }
+
+  // Gain computation, shared by all channels.
+  std::array<float, kNumBands> features;
+  const float one_by_num_channels = 1.f / channels_.size();
+  for (size_t b = 0; b < kNumBands; ++b) {
+    features[b] =
+        std::log10(kEnergyOffset + band_energies_[b] * one_by_num_channels);
+  }
+  rtc::ArrayView<const float> band_gains = model_->Step(features);
+  RTC_DCHECK_EQ(kNumBands, band_gains.size());
+  for (size_t k = 0; k < num_bins_; ++k) {
+    const float gain = (1.f - bin_weights_[k]) * band_gains[bin_bands_[k]] +
+                       bin_weights_[k] * band_gains[bin_bands_[k] + 1];
+    bin_gains_[k] = rtc::SafeClamp(gain, 0.f, 1.f);
+  }
+
+  // Synthesis.
+  for (size_t ch = 0; ch < channels_.size(); ++ch) {
+    ChannelState& channel = channels_[ch];
+    for (size_t k = 0; k < num_bins_; ++k) {
+      channel.spectrum[k] *= bin_gains_[k];
+    }
+    fft_->Inverse(channel.spectrum.get(), time);
+
+    float* output = audio->channels()[ch];
+    for (size_t n = 0; n < frame_size_; ++n) {
+      output[n] = channel.synthesis_memory[n] + window_[n] * time[n];
+      channel.synthesis_memory[n] =
+          window_[frame_size_ + n] * time[frame_size_ + n];
+    }
+  }
+}
+
+std::string LearnedNoiseSuppressor::ToString() const {
+  return "LearnedNoiseSuppressor";
+}
+
+}  // namespace webrtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_LEARNED_NOISE_SUPPRESSOR_H_
+#define MODULES_AUDIO_PROCESSING_NS_LEARNED_NOISE_SUPPRESSOR_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <complex>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common_audio/real_fourier.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/remote_bitrate_estimator/bwe_model.h"
+
+namespace webrtc {
+
+// Noise suppressor whose gains are computed by a small network, converted
+// from ONNX with tools/onnx_to_bwe_model.py and run with the in-tree runner
+// of the bandwidth estimation models. Meant to replace the legacy noise
+// suppressor as the capture post-processing stage of AudioProcessing, see
+// AudioProcessingBuilder::SetCapturePostProcessing().
+//
+// Every 10 ms the fullband signal of each channel is transformed with a 50 %
+// overlapping sqrt-Hann window of 20 ms. The model gets one feature per band,
+// log10(kEnergyOffset + E) where E is the energy of the band averaged over
+// all channels, and returns one gain in [0, 1] per band. The gains are
+// interpolated between the band centers and applied to all channels, so the
+// model runs once per 10 ms however many channels there are. The output is
+// delayed by 10 ms.
+class LearnedNoiseSuppressor : public CustomProcessing {
+ public:
+  static constexpr size_t kNumBands = 22;
+  // Added to the band energies, in the 16 bit sample scale, before the log.
+  static constexpr float kEnergyOffset = 1.f;
+
+  // Returns null if |model| does not map kNumBands features to kNumBands
+  // gains.
+  static std::unique_ptr<LearnedNoiseSuppressor> Create(
+      std::unique_ptr<bwe_model::BweModel> model);
+  // Returns null if the model at |model_path| can't be loaded or is not
+  // suitable.
+  static std::unique_ptr<LearnedNoiseSuppressor> Create(
+      const std::string& model_path);
+
+  ~LearnedNoiseSuppressor() override;
+
+  LearnedNoiseSuppressor(const LearnedNoiseSuppressor&) = delete;
+  LearnedNoiseSuppressor& operator=(const LearnedNoiseSuppressor&) = delete;
+
+  // CustomProcessing implementation.
+  void Initialize(int sample_rate_hz, int num_channels) override;
+  void Process(AudioBuffer* audio) override;
+  std::string ToString() const override;
+
+ private:
+  explicit LearnedNoiseSuppressor(std::unique_ptr<bwe_model::BweModel> model);
+
+  struct ChannelState {
+    // The previous 10 ms of input.
+    std::vector<float> analysis_memory;
+    // The second half of the previous synthesis frame.
+    std::vector<float> synthesis_memory;
+    RealFourier::fft_cplx_scoper spectrum;
+  };
+
+  const std::unique_ptr<bwe_model::BweModel> model_;
+  size_t frame_size_ = 0;
+  std::unique_ptr<RealFourier> fft_;
+  size_t num_bins_ = 0;
+  std::vector<float> window_;
+  // Each bin is interpolated between the gains of |bin_bands_[k]| and the
+  // next band, with weight |bin_weights_[k]| for the next band.
+  std::vector<size_t> bin_bands_;
+  std::vector<float> bin_weights_;
+  std::vector<ChannelState> channels_;
+  RealFourier::fft_real_scoper time_buffer_;
+  std::array<float, kNumBands> band_energies_;
+  std::vector<float> bin_gains_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_LEARNED_NOISE_SUPPRESSOR_H_
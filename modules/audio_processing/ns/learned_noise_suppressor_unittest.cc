@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/learned_noise_suppressor.h"
+
+#include <string.h>
+
+#include <cmath>
+#include <vector>
+
+#include "modules/audio_processing/audio_buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumBands = LearnedNoiseSuppressor::kNumBands;
+
+void WriteUint32(uint32_t value, std::vector<uint8_t>* data) {
+  for (int i = 0; i < 4; ++i)
+    data->push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void WriteFloat(float value, std::vector<uint8_t>* data) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  WriteUint32(bits, data);
+}
+
+// Returns a model that ignores its input and outputs sigmoid(|bias|) for all
+// bands, in the file format documented in bwe_model.h.
+std::unique_ptr<bwe_model::BweModel> CreateConstantGainModel(
+    float bias,
+    size_t input_size = kNumBands) {
+  std::vector<uint8_t> data = {'B', 'W', 'E', 'M'};
+  WriteUint32(1, &data);
+  WriteUint32(input_size, &data);
+  WriteUint32(2, &data);
+  // Dense layer with zero weights.
+  WriteUint32(0, &data);
+  WriteUint32(kNumBands, &data);
+  WriteUint32(input_size, &data);
+  for (size_t r = 0; r < kNumBands; ++r)
+    WriteFloat(1.f, &data);
+  data.insert(data.end(), kNumBands * input_size, 0);
+  for (size_t r = 0; r < kNumBands; ++r)
+    WriteFloat(bias, &data);
+  // Sigmoid activation.
+  WriteUint32(1, &data);
+  WriteUint32(kNumBands, &data);
+  WriteUint32(static_cast<uint32_t>(bwe_model::Activation::kSigmoid), &data);
+  return bwe_model::BweModel::Parse(data);
+}
+
+std::string ProduceDebugText(int sample_rate_hz, size_t num_channels) {
+  rtc::StringBuilder ss;
+  ss << "Sample rate: " << sample_rate_hz << ", channels: " << num_channels;
+  return ss.Release();
+}
+
+// Runs |num_frames| of white noise through |suppressor| and returns the
+// output, each channel of the input stored in |input|.
+std::vector<std::vector<float>> RunNoise(
+    int sample_rate_hz,
+    size_t num_channels,
+    int num_frames,
+    LearnedNoiseSuppressor* suppressor,
+    std::vector<std::vector<float>>* input) {
+  const size_t frame_size = sample_rate_hz / 100;
+  Random random_generator(42U);
+  AudioBuffer audio(sample_rate_hz, num_channels, sample_rate_hz, num_channels,
+                    sample_rate_hz, num_channels);
+  suppressor->Initialize(sample_rate_hz, num_channels);
+  input->assign(num_channels, std::vector<float>());
+  std::vector<std::vector<float>> output(num_channels);
+  for (int frame = 0; frame < num_frames; ++frame) {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      for (size_t n = 0; n < frame_size; ++n) {
+        const float sample = random_generator.Rand(-10000, 10000);
+        audio.channels()[ch][n] = sample;
+        (*input)[ch].push_back(sample);
+      }
+    }
+    suppressor->Process(&audio);
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      output[ch].insert(output[ch].end(), audio.channels_const()[ch],
+                        audio.channels_const()[ch] + frame_size);
+    }
+  }
+  return output;
+}
+
+}  // namespace
+
+TEST(LearnedNoiseSuppressor, RejectsModelsOfOtherSizes) {
+  EXPECT_FALSE(LearnedNoiseSuppressor::Create(
+      std::unique_ptr<bwe_model::BweModel>()));
+  EXPECT_FALSE(
+      LearnedNoiseSuppressor::Create(CreateConstantGainModel(0.f, 3)));
+  EXPECT_FALSE(LearnedNoiseSuppressor::Create("/nonexistent/model.bwem"));
+  EXPECT_TRUE(LearnedNoiseSuppressor::Create(CreateConstantGainModel(0.f)));
+}
+
+// Verifies that unit gains reconstruct the input, delayed by one frame.
+TEST(LearnedNoiseSuppressor, UnitGainsPassTheSignalThrough) {
+  for (int sample_rate_hz : {16000, 32000, 48000}) {
+    for (size_t num_channels : {1, 2}) {
+      SCOPED_TRACE(ProduceDebugText(sample_rate_hz, num_channels));
+      auto suppressor =
+          LearnedNoiseSuppressor::Create(CreateConstantGainModel(30.f));
+      ASSERT_TRUE(suppressor);
+      std::vector<std::vector<float>> input;
+      std::vector<std::vector<float>> output =
+          RunNoise(sample_rate_hz, num_channels, 20, suppressor.get(), &input);
+      const size_t frame_size = sample_rate_hz / 100;
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        for (size_t n = frame_size; n < output[ch].size(); ++n) {
+          ASSERT_NEAR(input[ch][n - frame_size], output[ch][n], 0.1f);
+        }
+      }
+    }
+  }
+}
+
+// Verifies that gains below one attenuate the signal accordingly.
+TEST(LearnedNoiseSuppressor, AttenuatesTheSignal) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kFrameSize = kSampleRateHz / 100;
+  const float kGain = 1.f / (1.f + std::exp(1.f));
+  auto suppressor =
+      LearnedNoiseSuppressor::Create(CreateConstantGainModel(-1.f));
+  ASSERT_TRUE(suppressor);
+  std::vector<std::vector<float>> input;
+  std::vector<std::vector<float>> output =
+      RunNoise(kSampleRateHz, 2, 20, suppressor.get(), &input);
+  for (size_t ch = 0; ch < 2; ++ch) {
+    for (size_t n = kFrameSize; n < output[ch].size(); ++n) {
+      ASSERT_NEAR(kGain * input[ch][n - kFrameSize], output[ch][n], 0.1f);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -12,8 +12,8 @@
 
 #include <algorithm>
 #include <cmath>
-#include <numeric>
 
+#include "common_audio/signal_processing/sum_of_squares.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -64,9 +64,8 @@ void RmsLevel::Analyze(rtc::ArrayView<const int16_t> data) {
 
   CheckBlockSize(data.size());
 
-  const float sum_square =
-      std::accumulate(data.begin(), data.end(), 0.f,
-                      [](float a, int16_t b) { return a + b * b; });
+  const float sum_square = static_cast<float>(
+      WebRtcSpl_SumOfSquaresW16(data.data(), data.size(), nullptr));
   RTC_DCHECK_GE(sum_square, 0.f);
   sum_square_ += sum_square;
   sample_count_ += data.size();
@@ -13,7 +13,9 @@
 #include <inttypes.h>
 #include <stdio.h>
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <numeric>
 #include <string>
 #include <utility>
@@ -35,11 +37,53 @@ constexpr TimeDelta kLossUpdateInterval = TimeDelta::Millis<1000>();
 // overshoots from the encoder.
 const float kDefaultPaceMultiplier = 2.5f;
 
+// Target used until the first estimate arrives when there is no starting rate.
+constexpr DataRate kDefaultStartRate = DataRate::KilobitsPerSec(300);
+
+// The model does not report how fast it can recover from an overuse, assume
+// the same as the delay based estimator does by default.
+constexpr TimeDelta kDefaultBwePeriod = TimeDelta::Seconds(3);
+
+// The bandwidth forecast extrapolates the trend of the model estimates of the
+// last second to the time the encoders need to follow a new target.
+constexpr TimeDelta kForecastWindow = TimeDelta::Seconds(1);
+constexpr TimeDelta kForecastHorizon = TimeDelta::Millis(300);
+constexpr size_t kMinForecastEstimates = 3;
+
+// The model rates are handed on as int32_t bps. Also false for NaN.
+bool IsValidModelRate(float rate_bps) {
+  return rate_bps >= 0 &&
+         rate_bps < static_cast<float>(std::numeric_limits<int32_t>::max());
+}
+
 bool IsNotDisabled(const WebRtcKeyValueConfig* config, absl::string_view key) {
   return config->Lookup(key).find("Disabled") != 0;
 }
+
+int64_t GetBpsOrDefault(const absl::optional<DataRate>& rate,
+                        int64_t fallback_bps) {
+  if (rate && rate->IsFinite()) {
+    return rate->bps();
+  } else {
+    return fallback_bps;
+  }
+}
 }  // namespace
 
+GoogCcNetworkController::RateLimitSettings::RateLimitSettings(
+    const WebRtcKeyValueConfig* key_value_config) {
+  ParseFieldTrial({&increase_smoothing, &max_increase_per_second,
+                   &max_decrease_factor, &deadband},
+                  key_value_config->Lookup("WebRTC-Bwe-AlphaCcRateLimits"));
+}
+
+GoogCcNetworkController::CapacityBoundSettings::CapacityBoundSettings(
+    const WebRtcKeyValueConfig* key_value_config) {
+  ParseFieldTrial(
+      {&enabled, &hold_time},
+      key_value_config->Lookup("WebRTC-Bwe-AlphaCcCapacityBounds"));
+}
+
 GoogCcNetworkController::GoogCcNetworkController(NetworkControllerConfig config,
                                                  GoogCcConfig alpha_cc_config)
     : key_value_config_(config.key_value_config ? config.key_value_config
@@ -48,33 +92,109 @@ GoogCcNetworkController::GoogCcNetworkController(NetworkControllerConfig config,
       safe_reset_acknowledged_rate_("ack"),
       use_min_allocatable_as_lower_bound_(
           IsNotDisabled(key_value_config_, "WebRTC-Bwe-MinAllocAsLowerBound")),
+      rate_limits_(key_value_config_),
+      capacity_bounds_(key_value_config_),
+      rate_control_settings_(
+          RateControlSettings::ParseFromKeyValueConfig(key_value_config_)),
+      event_log_(config.event_log),
+      probe_controller_(
+          std::make_unique<ProbeController>(key_value_config_, event_log_)),
+      alr_detector_(
+          std::make_unique<AlrDetector>(key_value_config_, event_log_)),
+      probe_bitrate_estimator_(
+          std::make_unique<ProbeBitrateEstimator>(event_log_)),
+      acknowledged_bitrate_estimator_(
+          AcknowledgedBitrateEstimatorInterface::Create(key_value_config_)),
+      congestion_window_pushback_controller_(
+          rate_control_settings_.UseCongestionWindowPushback()
+              ? std::make_unique<CongestionWindowPushbackController>(
+                    key_value_config_)
+              : nullptr),
       initial_config_(config),
+      min_target_rate_(
+          config.constraints.min_data_rate.value_or(DataRate::Zero())),
+      max_data_rate_(
+          config.constraints.max_data_rate.value_or(DataRate::PlusInfinity())),
+      starting_rate_(config.constraints.starting_rate),
       pacing_factor_(config.stream_based_config.pacing_factor.value_or(
           kDefaultPaceMultiplier)),
       min_total_allocated_bitrate_(
           config.stream_based_config.min_total_allocated_bitrate.value_or(
-              DataRate::Zero())) {
+              DataRate::Zero())),
+      max_padding_rate_(config.stream_based_config.max_padding_rate.value_or(
+          DataRate::Zero())) {
   RTC_DCHECK(config.constraints.at_time.IsFinite());
   ParseFieldTrial(
       {&safe_reset_on_route_change_, &safe_reset_acknowledged_rate_},
       key_value_config_->Lookup("WebRTC-Bwe-SafeResetOnRouteChange"));
+  // The model only ever sees what the application sends, so unlike GoogCC
+  // probe while application limited unless told otherwise.
+  probe_controller_->EnablePeriodicAlrProbing(
+      config.stream_based_config.requests_alr_probing.value_or(IsNotDisabled(
+          key_value_config_, "WebRTC-Bwe-AlphaCcAlrProbing")));
 }
 
 GoogCcNetworkController::~GoogCcNetworkController() {}
 
 NetworkControlUpdate GoogCcNetworkController::OnNetworkAvailability(
     NetworkAvailability msg) {
-  return NetworkControlUpdate();
+  NetworkControlUpdate update;
+  update.probe_cluster_configs = probe_controller_->OnNetworkAvailability(msg);
+  return update;
 }
 
 NetworkControlUpdate GoogCcNetworkController::OnNetworkRouteChange(
     NetworkRouteChange msg) {
+  // The trend and the capacity of the old route say nothing about the new
+  // one.
+  recent_estimates_.clear();
+  predicted_bandwidth_ratio_ = 1;
+  acknowledged_bitrate_estimator_ =
+      AcknowledgedBitrateEstimatorInterface::Create(key_value_config_);
+  acknowledged_rate_.reset();
+  link_capacity_.Reset();
+  above_capacity_since_ = Timestamp::PlusInfinity();
   return NetworkControlUpdate();
 }
 
 NetworkControlUpdate GoogCcNetworkController::OnProcessInterval(
     ProcessInterval msg) {
-  return NetworkControlUpdate();
+  current_time_ = msg.at_time;
+  NetworkControlUpdate update;
+  if (initial_config_) {
+    absl::optional<DataRate> total_bitrate =
+        initial_config_->stream_based_config.max_total_allocated_bitrate;
+    if (total_bitrate) {
+      update.probe_cluster_configs =
+          probe_controller_->OnMaxTotalAllocatedBitrate(total_bitrate->bps(),
+                                                        msg.at_time.ms());
+      max_total_allocated_bitrate_ = *total_bitrate;
+    }
+    initial_config_.reset();
+  }
+  if (congestion_window_pushback_controller_ && msg.pacer_queue) {
+    congestion_window_pushback_controller_->UpdatePacingQueue(
+        msg.pacer_queue->bytes());
+  }
+  probe_controller_->SetAlrStartTimeMs(
+      alr_detector_->GetApplicationLimitedRegionStartTime());
+  std::vector<ProbeClusterConfig> probes =
+      probe_controller_->Process(msg.at_time.ms());
+  update.probe_cluster_configs.insert(update.probe_cluster_configs.end(),
+                                      probes.begin(), probes.end());
+
+  if (rate_control_settings_.UseCongestionWindow() && last_target_rate_ &&
+      !feedback_max_rtts_.empty()) {
+    UpdateCongestionWindowSize();
+  }
+  if (congestion_window_pushback_controller_ && current_data_window_) {
+    congestion_window_pushback_controller_->SetDataWindow(
+        *current_data_window_);
+  } else {
+    update.congestion_window = current_data_window_;
+  }
+  MaybeTriggerOnNetworkChanged(&update, msg.at_time);
+  return update;
 }
 
 NetworkControlUpdate GoogCcNetworkController::OnRemoteBitrateReport(
@@ -89,12 +209,37 @@ NetworkControlUpdate GoogCcNetworkController::OnRoundTripTimeUpdate(
 
 NetworkControlUpdate GoogCcNetworkController::OnSentPacket(
     SentPacket sent_packet) {
+  current_time_ = std::max(current_time_, sent_packet.send_time);
+  alr_detector_->OnBytesSent(sent_packet.size.bytes(),
+                             sent_packet.send_time.ms());
+  if (congestion_window_pushback_controller_) {
+    congestion_window_pushback_controller_->UpdateOutstandingData(
+        sent_packet.data_in_flight.bytes());
+  }
   return NetworkControlUpdate();
 }
 
 NetworkControlUpdate GoogCcNetworkController::OnStreamsConfig(
     StreamsConfig msg) {
-  return GetDefaultState(msg.at_time);
+  if (msg.requests_alr_probing)
+    probe_controller_->EnablePeriodicAlrProbing(*msg.requests_alr_probing);
+  if (msg.pacing_factor)
+    pacing_factor_ = *msg.pacing_factor;
+  if (msg.min_total_allocated_bitrate)
+    min_total_allocated_bitrate_ = *msg.min_total_allocated_bitrate;
+  if (msg.max_padding_rate)
+    max_padding_rate_ = *msg.max_padding_rate;
+  std::vector<ProbeClusterConfig> probes;
+  if (msg.max_total_allocated_bitrate &&
+      *msg.max_total_allocated_bitrate != max_total_allocated_bitrate_) {
+    probes = probe_controller_->OnMaxTotalAllocatedBitrate(
+        msg.max_total_allocated_bitrate->bps(), msg.at_time.ms());
+    max_total_allocated_bitrate_ = *msg.max_total_allocated_bitrate;
+  }
+  NetworkControlUpdate update = GetDefaultState(msg.at_time);
+  update.probe_cluster_configs.insert(update.probe_cluster_configs.end(),
+                                      probes.begin(), probes.end());
+  return update;
 }
 
 NetworkControlUpdate GoogCcNetworkController::OnReceivedPacket(
@@ -102,103 +247,235 @@ NetworkControlUpdate GoogCcNetworkController::OnReceivedPacket(
   return NetworkControlUpdate();
 }
 
-// Make this alive since this might be used to tune the birate.
 NetworkControlUpdate GoogCcNetworkController::OnTargetRateConstraints(
     TargetRateConstraints constraints) {
-  return NetworkControlUpdate();
+  NetworkControlUpdate update;
+  std::vector<ProbeClusterConfig> probes = ResetConstraints(constraints);
+  if (last_target_rate_) {
+    // Apply the new limits right away rather than on the next estimate.
+    DataRate target = ClampTarget(*last_target_rate_);
+    if (target != *last_target_rate_) {
+      update = CreateRateUpdate(target, target, constraints.at_time);
+      last_target_rate_ = target;
+    }
+  }
+  update.probe_cluster_configs = std::move(probes);
+  return update;
+}
+
+std::vector<ProbeClusterConfig> GoogCcNetworkController::ResetConstraints(
+    TargetRateConstraints new_constraints) {
+  min_target_rate_ = new_constraints.min_data_rate.value_or(DataRate::Zero());
+  max_data_rate_ =
+      new_constraints.max_data_rate.value_or(DataRate::PlusInfinity());
+  starting_rate_ = new_constraints.starting_rate;
+  ClampConstraints();
+  return probe_controller_->SetBitrates(
+      min_data_rate_.bps(), GetBpsOrDefault(starting_rate_, -1),
+      max_data_rate_.bps_or(-1), new_constraints.at_time.ms());
 }
 
 NetworkControlUpdate GoogCcNetworkController::GetDefaultState(
     Timestamp at_time) {
-  //*-----Set target_rate-----*//
-  constexpr int32_t default_bitrate_bps = 300000;  // default: 300000 bps = 300 kbps
-  DataRate bandwidth = DataRate::BitsPerSec(default_bitrate_bps);
-  TimeDelta rtt = TimeDelta::Millis(last_estimated_rtt_ms_);
-  NetworkControlUpdate update;
-  update.target_rate = TargetTransferRate();
-  update.target_rate->network_estimate.at_time = at_time;
-  update.target_rate->network_estimate.bandwidth = bandwidth;
-  update.target_rate->network_estimate.loss_rate_ratio =
-      last_estimated_fraction_loss_ / 255.0;
-  update.target_rate->network_estimate.round_trip_time = rtt;
-
-  TimeDelta default_bwe_period = TimeDelta::Seconds(3);  // the default is 3sec
-  update.target_rate->network_estimate.bwe_period = default_bwe_period;
-  update.target_rate->at_time = at_time;
-  update.target_rate->target_rate = bandwidth;
-
-  //*-----Set pacing & padding_rate-----*//
-  int32_t default_pacing_rate = 300000;   // default:300000;=> 750000 bps = 750 kbps
-  int32_t default_padding_rate = 0;  // default: 0bps = 0kbps
-  DataRate pacing_rate = DataRate::BitsPerSec(default_pacing_rate * pacing_factor_);
-  DataRate padding_rate = DataRate::BitsPerSec(default_padding_rate);
-  PacerConfig msg;
-  msg.at_time = at_time;
-  msg.time_window = TimeDelta::Seconds(1);
-  msg.data_window = pacing_rate * msg.time_window;
-  msg.pad_window = padding_rate * msg.time_window;
-
-  update.pacer_config = msg;
-
-  //*-----Set congestion_window-----*//
-  update.congestion_window = current_data_window_;
-
-  //*-----Set probe_cluster_configs-----*//
-
-  /*
   ClampConstraints();
+  //*-----Set target_rate & pacer_config-----*//
+  DataRate target = ClampTarget(
+      last_target_rate_.value_or(starting_rate_.value_or(kDefaultStartRate)));
+  NetworkControlUpdate update = CreateRateUpdate(target, target, at_time);
 
+  //*-----Set probe_cluster_configs-----*//
   update.probe_cluster_configs = probe_controller_->SetBitrates(
       min_data_rate_.bps(), GetBpsOrDefault(starting_rate_, -1),
       max_data_rate_.bps_or(-1), at_time.ms());
-  */
-
-  // MSRA:SetBitrates:32000,300000,-1,139444174
-  // 0,-1,-1,139861040
   return update;
 }
 
 NetworkControlUpdate GoogCcNetworkController::OnReceiveBwe(BweMessage bwe) {
-  int32_t default_bitrate_bps = static_cast<int32_t>(bwe.target_rate);  // default: 300000 bps = 300 kbps
-  DataRate bandwidth = DataRate::BitsPerSec(default_bitrate_bps);
-  TimeDelta rtt = TimeDelta::Millis(last_estimated_rtt_ms_);
+  if (!IsValidModelRate(bwe.target_rate) ||
+      !IsValidModelRate(bwe.pacing_rate)) {
+    RTC_LOG(LS_WARNING) << "Ignoring a model estimate out of range, target "
+                        << bwe.target_rate << " bps, pacing "
+                        << bwe.pacing_rate << " bps";
+    return NetworkControlUpdate();
+  }
+  DataRate bandwidth =
+      DataRate::BitsPerSec(static_cast<int64_t>(bwe.target_rate));
+  DataRate pacing_rate =
+      DataRate::BitsPerSec(static_cast<int64_t>(bwe.pacing_rate));
+  Timestamp at_time = Timestamp::Millis(bwe.timestamp_ms);
+  const DataRate model_bandwidth = bandwidth;
+  bandwidth = BoundByLinkCapacity(bandwidth, at_time);
+  DataRate target = ClampTarget(LimitRateChange(bandwidth, at_time));
+  // Keep the pacing headroom the model asked for relative to its target.
+  if (model_bandwidth > DataRate::Zero())
+    pacing_rate = pacing_rate * (target / model_bandwidth);
+  // The encoders keep producing the previous target until they adapt, and
+  // the rate limits may keep the new target above the estimate. What exceeds
+  // the estimated capacity is expected to be lost, before the receiver can
+  // report it.
+  const DataRate sending_rate =
+      std::max(last_target_rate_.value_or(target), target);
+  predicted_loss_ratio_ =
+      sending_rate > bandwidth && !sending_rate.IsZero()
+          ? static_cast<float>(1.0 - bandwidth / sending_rate)
+          : 0.0f;
+  UpdateBandwidthForecast(bandwidth, at_time);
+  NetworkControlUpdate update = CreateRateUpdate(target, pacing_rate, at_time);
+  last_estimated_bitrate_bps_ = bandwidth.bps();
+  last_target_rate_ = target;
+  last_target_update_time_ = at_time;
+
+  //*-----Set probe_cluster_configs-----*//
+  // The probe controller runs on the local clock, unlike |bwe.timestamp_ms|.
+  alr_detector_->SetEstimatedBitrate(target.bps());
+  if (current_time_.IsFinite()) {
+    update.probe_cluster_configs = probe_controller_->SetEstimatedBitrate(
+        target.bps(), current_time_.ms());
+  }
+  return update;
+}
+
+void GoogCcNetworkController::UpdateBandwidthForecast(DataRate bandwidth,
+                                                      Timestamp at_time) {
+  recent_estimates_.emplace_back(at_time, bandwidth);
+  while (at_time - recent_estimates_.front().first > kForecastWindow)
+    recent_estimates_.pop_front();
+  predicted_bandwidth_ratio_ = 1;
+  if (recent_estimates_.size() < kMinForecastEstimates || bandwidth.IsZero())
+    return;
+
+  // Least squares slope of the estimates over time.
+  double mean_time_ms = 0;
+  double mean_bps = 0;
+  for (const auto& estimate : recent_estimates_) {
+    mean_time_ms += (estimate.first - at_time).ms<double>();
+    mean_bps += estimate.second.bps<double>();
+  }
+  mean_time_ms /= recent_estimates_.size();
+  mean_bps /= recent_estimates_.size();
+  double covariance = 0;
+  double variance = 0;
+  for (const auto& estimate : recent_estimates_) {
+    double time_ms = (estimate.first - at_time).ms<double>() - mean_time_ms;
+    covariance += time_ms * (estimate.second.bps<double>() - mean_bps);
+    variance += time_ms * time_ms;
+  }
+  if (variance <= 0)
+    return;
+  double slope_bps_per_ms = covariance / variance;
+  // Only a falling capacity needs to be acted on ahead of time.
+  if (slope_bps_per_ms >= 0)
+    return;
+  double predicted_bps =
+      bandwidth.bps<double>() + slope_bps_per_ms * kForecastHorizon.ms();
+  predicted_bandwidth_ratio_ = static_cast<float>(
+      std::max(0.0, predicted_bps / bandwidth.bps<double>()));
+}
+
+TargetTransferRate GoogCcNetworkController::CreateTargetTransferRate(
+    DataRate target_rate,
+    Timestamp at_time) {
+  DataRate pushback_target_rate = target_rate;
+  double cwnd_reduce_ratio = 0.0;
+  if (congestion_window_pushback_controller_) {
+    int64_t pushback_rate =
+        congestion_window_pushback_controller_->UpdateTargetBitrate(
+            target_rate.bps());
+    pushback_rate = std::max<int64_t>(min_data_rate_.bps(), pushback_rate);
+    pushback_target_rate = DataRate::BitsPerSec(pushback_rate);
+    if (rate_control_settings_.UseCongestionWindowDropFrameOnly() &&
+        !target_rate.IsZero()) {
+      cwnd_reduce_ratio = static_cast<double>(target_rate.bps() -
+                                              pushback_target_rate.bps()) /
+                          target_rate.bps();
+    }
+  }
+  last_pushback_target_rate_ = pushback_target_rate;
+
+  TargetTransferRate msg;
+  msg.network_estimate.at_time = at_time;
+  msg.network_estimate.bandwidth = target_rate;
+  msg.network_estimate.loss_rate_ratio = last_estimated_fraction_loss_ / 255.0;
+  msg.network_estimate.predicted_loss_rate_ratio = predicted_loss_ratio_;
+  msg.network_estimate.predicted_bandwidth_ratio = predicted_bandwidth_ratio_;
+  msg.network_estimate.round_trip_time =
+      TimeDelta::Millis(last_estimated_rtt_ms_);
+  msg.network_estimate.bwe_period = kDefaultBwePeriod;
+  msg.at_time = at_time;
+  if (rate_control_settings_.UseCongestionWindowDropFrameOnly()) {
+    msg.target_rate = target_rate;
+    msg.cwnd_reduce_ratio = cwnd_reduce_ratio;
+  } else {
+    msg.target_rate = pushback_target_rate;
+  }
+  return msg;
+}
+
+NetworkControlUpdate GoogCcNetworkController::CreateRateUpdate(
+    DataRate target_rate,
+    DataRate pacing_rate,
+    Timestamp at_time) {
   NetworkControlUpdate update;
-  update.target_rate = TargetTransferRate();
-  update.target_rate->network_estimate.at_time = Timestamp::Millis(bwe.timestamp_ms);
-  update.target_rate->network_estimate.bandwidth = bandwidth;
-  update.target_rate->network_estimate.loss_rate_ratio =
-      last_estimated_fraction_loss_ / 255.0;
-  update.target_rate->network_estimate.round_trip_time = rtt;
-
-  TimeDelta default_bwe_period = TimeDelta::Seconds(3);  // the default is 3sec
-  update.target_rate->network_estimate.bwe_period = default_bwe_period;
-  update.target_rate->at_time = Timestamp::Millis(bwe.timestamp_ms);
-  update.target_rate->target_rate = bandwidth;
+  update.target_rate = CreateTargetTransferRate(target_rate, at_time);
 
   //*-----Set pacing & padding_rate-----*//
-  int32_t default_pacing_rate = static_cast<int32_t>(bwe.pacing_rate); 
-  int32_t default_padding_rate = 0;  // default: 0bps = 0kbps
-  DataRate pacing_rate = DataRate::BitsPerSec(default_pacing_rate * pacing_factor_);
-  DataRate padding_rate = DataRate::BitsPerSec(default_padding_rate);
+  // Pacing follows the target before pushback, so that pushback does not
+  // build a queue in the pacer.
+  DataRate padding_rate =
+      std::min(max_padding_rate_, last_pushback_target_rate_);
   PacerConfig msg;
-  msg.at_time = Timestamp::Millis(bwe.timestamp_ms);
+  msg.at_time = at_time;
   msg.time_window = TimeDelta::Seconds(1);
-  msg.data_window = pacing_rate * msg.time_window;
+  msg.data_window = pacing_rate * pacing_factor_ * msg.time_window;
   msg.pad_window = padding_rate * msg.time_window;
 
   update.pacer_config = msg;
 
   //*-----Set congestion_window-----*//
-  update.congestion_window = current_data_window_;
+  // With pushback the window throttles the encoders instead of the pacer.
+  if (!congestion_window_pushback_controller_)
+    update.congestion_window = current_data_window_;
   return update;
 }
 
+void GoogCcNetworkController::UpdateCongestionWindowSize() {
+  TimeDelta min_feedback_max_rtt = TimeDelta::Millis(
+      *std::min_element(feedback_max_rtts_.begin(), feedback_max_rtts_.end()));
+
+  const DataSize kMinCwnd = DataSize::Bytes(2 * 1500);
+  TimeDelta time_window =
+      min_feedback_max_rtt +
+      TimeDelta::Millis(
+          rate_control_settings_.GetCongestionWindowAdditionalTimeMs());
+
+  DataSize data_window = *last_target_rate_ * time_window;
+  if (current_data_window_) {
+    data_window =
+        std::max(kMinCwnd, (data_window + current_data_window_.value()) / 2);
+  } else {
+    data_window = std::max(kMinCwnd, data_window);
+  }
+  current_data_window_ = data_window;
+}
+
+void GoogCcNetworkController::MaybeTriggerOnNetworkChanged(
+    NetworkControlUpdate* update,
+    Timestamp at_time) {
+  if (!congestion_window_pushback_controller_ || !last_target_rate_)
+    return;
+  DataRate previous_pushback_target_rate = last_pushback_target_rate_;
+  TargetTransferRate target_rate =
+      CreateTargetTransferRate(*last_target_rate_, at_time);
+  if (last_pushback_target_rate_ != previous_pushback_target_rate)
+    update->target_rate = target_rate;
+}
+
 void GoogCcNetworkController::ClampConstraints() {
   // TODO(holmer): We should make sure the default bitrates are set to 10 kbps,
   // and that we don't try to set the min bitrate to 0 from any applications.
   // The congestion controller should allow a min bitrate of 0.
   min_data_rate_ =
-      std::max(min_data_rate_, congestion_controller::GetMinBitrate());
+      std::max(min_target_rate_, congestion_controller::GetMinBitrate());
   if (use_min_allocatable_as_lower_bound_)
     min_data_rate_ = std::max(min_data_rate_, min_total_allocated_bitrate_);
   if (max_data_rate_ < min_data_rate_) {
@@ -211,6 +488,73 @@ void GoogCcNetworkController::ClampConstraints() {
   }
 }
 
+DataRate GoogCcNetworkController::ClampTarget(DataRate target_rate) const {
+  return std::min(std::max(target_rate, min_data_rate_), max_data_rate_);
+}
+
+DataRate GoogCcNetworkController::LimitRateChange(DataRate estimate,
+                                                  Timestamp at_time) const {
+  if (!last_target_rate_ || last_target_update_time_.IsInfinite() ||
+      at_time < last_target_update_time_) {
+    return estimate;
+  }
+  DataRate current = *last_target_rate_;
+  if (current.IsZero())
+    return estimate;
+  double ratio = estimate / current;
+  if (std::abs(ratio - 1.0) < rate_limits_.deadband.Get())
+    return current;
+  if (estimate < current) {
+    // Back off quickly, bounded so that one bad estimate can't starve the
+    // encoders.
+    return std::max(estimate, current * rate_limits_.max_decrease_factor.Get());
+  }
+  DataRate smoothed = current + (estimate - current) *
+                                    rate_limits_.increase_smoothing.Get();
+  double elapsed_seconds =
+      (at_time - last_target_update_time_).seconds<double>();
+  DataRate max_increase =
+      current *
+      (1.0 + rate_limits_.max_increase_per_second.Get() * elapsed_seconds);
+  return std::min(smoothed, max_increase);
+}
+
+DataRate GoogCcNetworkController::BoundByLinkCapacity(DataRate bandwidth,
+                                                      Timestamp at_time) {
+  if (!capacity_bounds_.enabled)
+    return bandwidth;
+  if (acknowledged_rate_) {
+    // Same as AimdRateControl: what got through is a capacity sample when the
+    // link is full, which is what an estimate below it says.
+    if (*acknowledged_rate_ > link_capacity_.UpperBound())
+      link_capacity_.Reset();
+    if (bandwidth < *acknowledged_rate_) {
+      if (*acknowledged_rate_ < link_capacity_.LowerBound())
+        link_capacity_.Reset();
+      link_capacity_.OnOveruseDetected(*acknowledged_rate_);
+    }
+  }
+  // Estimates below the capacity are applied as they are, backing off late is
+  // what builds the queues.
+  if (!link_capacity_.has_estimate() ||
+      bandwidth <= link_capacity_.UpperBound()) {
+    above_capacity_since_ = Timestamp::PlusInfinity();
+    return bandwidth;
+  }
+  if (above_capacity_since_.IsInfinite())
+    above_capacity_since_ = at_time;
+  if (at_time - above_capacity_since_ >= capacity_bounds_.hold_time.Get()) {
+    RTC_LOG(LS_INFO) << "Dropping the link capacity estimate of "
+                     << ToString(link_capacity_.estimate())
+                     << ", the model has estimated above it since "
+                     << ToString(above_capacity_since_);
+    link_capacity_.Reset();
+    above_capacity_since_ = Timestamp::PlusInfinity();
+    return bandwidth;
+  }
+  return link_capacity_.UpperBound();
+}
+
 NetworkControlUpdate GoogCcNetworkController::OnTransportLossReport(
     TransportLossReport msg) {
   return NetworkControlUpdate();
@@ -218,7 +562,76 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportLossReport(
 
 NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     TransportPacketsFeedback report) {
-  return NetworkControlUpdate();
+  current_time_ = std::max(current_time_, report.feedback_time);
+  if (congestion_window_pushback_controller_) {
+    congestion_window_pushback_controller_->UpdateOutstandingData(
+        report.data_in_flight.bytes());
+  }
+  TimeDelta max_feedback_rtt = TimeDelta::MinusInfinity();
+  for (const PacketResult& feedback : report.ReceivedWithSendInfo()) {
+    max_feedback_rtt =
+        std::max(max_feedback_rtt,
+                 report.feedback_time - feedback.sent_packet.send_time);
+  }
+  if (max_feedback_rtt.IsFinite()) {
+    feedback_max_rtts_.push_back(max_feedback_rtt.ms());
+    const size_t kMaxFeedbackRttWindow = 32;
+    if (feedback_max_rtts_.size() > kMaxFeedbackRttWindow)
+      feedback_max_rtts_.pop_front();
+  }
+
+  absl::optional<int64_t> alr_start_time =
+      alr_detector_->GetApplicationLimitedRegionStartTime();
+  if (previously_in_alr && !alr_start_time.has_value()) {
+    probe_controller_->SetAlrEndedTimeMs(report.feedback_time.ms());
+    acknowledged_bitrate_estimator_->SetAlrEndedTime(report.feedback_time);
+  }
+  previously_in_alr = alr_start_time.has_value();
+  std::vector<PacketResult> received_feedback = report.SortedByReceiveTime();
+  acknowledged_bitrate_estimator_->SetAlr(alr_start_time.has_value());
+  acknowledged_bitrate_estimator_->IncomingPacketFeedbackVector(
+      received_feedback);
+  acknowledged_rate_ = acknowledged_bitrate_estimator_->bitrate();
+
+  for (const PacketResult& feedback : received_feedback) {
+    if (feedback.sent_packet.pacing_info.probe_cluster_id !=
+        PacedPacketInfo::kNotAProbe) {
+      probe_bitrate_estimator_->HandleProbeAndEstimateBitrate(feedback);
+    }
+  }
+  absl::optional<DataRate> probe_bitrate =
+      probe_bitrate_estimator_->FetchAndResetLastEstimatedBitrate();
+  if (probe_bitrate)
+    link_capacity_.OnProbeRate(*probe_bitrate);
+
+  NetworkControlUpdate update;
+  if (rate_control_settings_.UseCongestionWindow() && last_target_rate_ &&
+      !feedback_max_rtts_.empty()) {
+    UpdateCongestionWindowSize();
+  }
+  if (congestion_window_pushback_controller_ && current_data_window_) {
+    congestion_window_pushback_controller_->SetDataWindow(
+        *current_data_window_);
+  } else {
+    update.congestion_window = current_data_window_;
+  }
+  if (probe_bitrate) {
+    // A successful probe raises the target right away instead of waiting for
+    // the model to notice the extra capacity; its next estimate takes over.
+    DataRate probe_target = std::min(*probe_bitrate, max_data_rate_);
+    if (!last_target_rate_ || probe_target > *last_target_rate_) {
+      probe_target = ClampTarget(probe_target);
+      update = CreateRateUpdate(probe_target, probe_target,
+                                report.feedback_time);
+      last_estimated_bitrate_bps_ = probe_target.bps();
+      last_target_rate_ = probe_target;
+    }
+    update.probe_cluster_configs = probe_controller_->SetEstimatedBitrate(
+        probe_target.bps(), report.feedback_time.ms());
+  }
+  if (!update.target_rate)
+    MaybeTriggerOnNetworkChanged(&update, report.feedback_time);
+  return update;
 }
 
 NetworkControlUpdate GoogCcNetworkController::OnNetworkStateEstimate(
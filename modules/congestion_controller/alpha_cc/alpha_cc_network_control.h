@@ -15,6 +15,7 @@
 
 #include <deque>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -22,8 +23,15 @@
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/transport/field_trial_based_config.h"
 #include "api/transport/network_control.h"
+#include "modules/congestion_controller/alpha_cc/link_capacity_estimator.h"
+#include "modules/congestion_controller/goog_cc/acknowledged_bitrate_estimator_interface.h"
+#include "modules/congestion_controller/goog_cc/alr_detector.h"
+#include "modules/congestion_controller/goog_cc/congestion_window_pushback_controller.h"
+#include "modules/congestion_controller/goog_cc/probe_bitrate_estimator.h"
+#include "modules/congestion_controller/goog_cc/probe_controller.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/rate_control_settings.h"
 
 namespace webrtc {
 struct GoogCcConfig {
@@ -60,18 +68,77 @@ class GoogCcNetworkController : public NetworkControllerInterface {
 
  private:
   friend class GoogCcStatePrinter;
+  // Limits how fast the model can move the target, so that a single outlier
+  // does not reconfigure the encoders.
+  struct RateLimitSettings {
+    // Weight of a new estimate that increases the target, 1 applies it as is.
+    FieldTrialParameter<double> increase_smoothing{"alpha", 0.5};
+    // Maximum relative increase of the target per second.
+    FieldTrialParameter<double> max_increase_per_second{"inc", 1.0};
+    // Lowest fraction of the current target a single estimate can go to.
+    FieldTrialParameter<double> max_decrease_factor{"dec", 0.5};
+    // Relative changes smaller than this are not applied.
+    FieldTrialParameter<double> deadband{"deadband", 0.05};
+    explicit RateLimitSettings(const WebRtcKeyValueConfig* key_value_config);
+  };
+  // Bounds the model estimates by the link capacity measured by the probes
+  // and by the acknowledged rate, so that a single bad estimate does not
+  // overshoot the link and build a queue.
+  struct CapacityBoundSettings {
+    FieldTrialParameter<bool> enabled{"enabled", true};
+    // How long the model may estimate above the bound before the capacity
+    // estimate is dropped as outdated, the capacity may rise without a probe
+    // measuring it.
+    FieldTrialParameter<TimeDelta> hold_time{"hold", TimeDelta::Seconds(2)};
+    explicit CapacityBoundSettings(
+        const WebRtcKeyValueConfig* key_value_config);
+  };
+
   std::vector<ProbeClusterConfig> ResetConstraints(
       TargetRateConstraints new_constraints);
   void ClampConstraints();
+  DataRate ClampTarget(DataRate target_rate) const;
+  // Returns the target following |estimate| at |at_time| on the remote clock,
+  // within the limits of |rate_limits_|.
+  DataRate LimitRateChange(DataRate estimate, Timestamp at_time) const;
+  // Updates |link_capacity_| with the model estimate |bandwidth| at |at_time|
+  // on the remote clock, and returns the estimate capped to the upper bound
+  // of the capacity.
+  DataRate BoundByLinkCapacity(DataRate bandwidth, Timestamp at_time);
+  // Adds the model estimate |bandwidth| at |at_time| and updates
+  // |predicted_bandwidth_ratio_| from the trend of the recent ones.
+  void UpdateBandwidthForecast(DataRate bandwidth, Timestamp at_time);
+  // Sizes the congestion window to the target over the feedback RTT plus the
+  // configured queueing allowance.
+  void UpdateCongestionWindowSize();
+  // Sets the target of |update| if congestion window pushback changed it.
   void MaybeTriggerOnNetworkChanged(NetworkControlUpdate* update,
                                     Timestamp at_time);
   PacerConfig GetPacingRates(Timestamp at_time) const;
+  // Target to report for |target_rate| after congestion window pushback.
+  TargetTransferRate CreateTargetTransferRate(DataRate target_rate,
+                                              Timestamp at_time);
+  NetworkControlUpdate CreateRateUpdate(DataRate target_rate,
+                                        DataRate pacing_rate,
+                                        Timestamp at_time);
   const FieldTrialBasedConfig trial_based_config_;
 
   const WebRtcKeyValueConfig* const key_value_config_;
   FieldTrialFlag safe_reset_on_route_change_;
   FieldTrialFlag safe_reset_acknowledged_rate_;
   const bool use_min_allocatable_as_lower_bound_;
+  const RateLimitSettings rate_limits_;
+  const CapacityBoundSettings capacity_bounds_;
+  const RateControlSettings rate_control_settings_;
+
+  RtcEventLog* const event_log_;
+  const std::unique_ptr<ProbeController> probe_controller_;
+  const std::unique_ptr<AlrDetector> alr_detector_;
+  std::unique_ptr<ProbeBitrateEstimator> probe_bitrate_estimator_;
+  std::unique_ptr<AcknowledgedBitrateEstimatorInterface>
+      acknowledged_bitrate_estimator_;
+  const std::unique_ptr<CongestionWindowPushbackController>
+      congestion_window_pushback_controller_;
 
   absl::optional<NetworkControllerConfig> initial_config_;
 
@@ -81,6 +148,8 @@ class GoogCcNetworkController : public NetworkControllerInterface {
   absl::optional<DataRate> starting_rate_;
 
   bool first_packet_sent_ = false;
+  // Latest local time seen, BWE messages are stamped with the remote clock.
+  Timestamp current_time_ = Timestamp::MinusInfinity();
 
   Timestamp next_loss_update_ = Timestamp::MinusInfinity();
   int lost_packets_since_last_loss_update_ = 0;
@@ -89,11 +158,29 @@ class GoogCcNetworkController : public NetworkControllerInterface {
   std::deque<int64_t> feedback_max_rtts_;
 
   int32_t last_estimated_bitrate_bps_ = 0;
+  // Target last reported, null before the first estimate.
+  absl::optional<DataRate> last_target_rate_;
+  // Remote time of the last estimate that updated |last_target_rate_|.
+  Timestamp last_target_update_time_ = Timestamp::MinusInfinity();
+  DataRate last_pushback_target_rate_ = DataRate::Zero();
   uint8_t last_estimated_fraction_loss_ = 0;
+  // Share of the current target above the capacity of the last estimate,
+  // which is expected to be lost until the encoders follow the estimate.
+  float predicted_loss_ratio_ = 0;
+  // Model estimates of the last kForecastWindow, on the remote clock.
+  std::deque<std::pair<Timestamp, DataRate>> recent_estimates_;
+  // Share of the last estimate that its trend leaves after kForecastHorizon.
+  float predicted_bandwidth_ratio_ = 1;
   int64_t last_estimated_rtt_ms_ = 0;
+  absl::optional<DataRate> acknowledged_rate_;
+  LinkCapacityEstimator link_capacity_;
+  // Remote time since which the model estimates are above the capacity.
+  Timestamp above_capacity_since_ = Timestamp::PlusInfinity();
 
   double pacing_factor_;
   DataRate min_total_allocated_bitrate_;
+  DataRate max_total_allocated_bitrate_ = DataRate::Zero();
+  DataRate max_padding_rate_;
   bool previously_in_alr = false;
 
   absl::optional<DataSize> current_data_window_;
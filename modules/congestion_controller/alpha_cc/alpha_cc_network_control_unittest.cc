@@ -0,0 +1,413 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/alpha_cc/alpha_cc_network_control.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "logging/rtc_event_log/mock/mock_rtc_event_log.h"
+#include "rtc_base/fake_clock.h"
+#include "test/field_trial.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+using ::testing::NiceMock;
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr DataRate kStartRate = DataRate::KilobitsPerSec(300);
+constexpr Timestamp kStartTime = Timestamp::Seconds(1);
+
+BweMessage CreateBwe(DataRate target, Timestamp at_time) {
+  BweMessage bwe;
+  bwe.timestamp_ms = at_time.ms();
+  bwe.target_rate = target.bps<float>();
+  bwe.pacing_rate = target.bps<float>();
+  return bwe;
+}
+
+PacketResult CreatePacketResult(int64_t sequence_number,
+                                Timestamp send_time,
+                                Timestamp receive_time,
+                                PacedPacketInfo pacing_info) {
+  PacketResult result;
+  result.sent_packet.sequence_number = sequence_number;
+  result.sent_packet.send_time = send_time;
+  result.sent_packet.size = DataSize::Bytes(1000);
+  result.sent_packet.pacing_info = pacing_info;
+  result.receive_time = receive_time;
+  return result;
+}
+
+class AlphaCcNetworkControllerTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<GoogCcNetworkController> CreateController() {
+    NetworkControllerConfig config;
+    config.constraints.at_time = kStartTime;
+    config.constraints.starting_rate = kStartRate;
+    config.event_log = &event_log_;
+    return std::make_unique<GoogCcNetworkController>(config, GoogCcConfig());
+  }
+
+  static TargetRateConstraints CreateConstraints(
+      absl::optional<DataRate> max_rate) {
+    TargetRateConstraints constraints;
+    constraints.at_time = kStartTime;
+    constraints.min_data_rate = DataRate::KilobitsPerSec(30);
+    constraints.max_data_rate = max_rate;
+    constraints.starting_rate = kStartRate;
+    return constraints;
+  }
+
+  // Feedback for a single packet sent |rtt| before |feedback_time|.
+  static TransportPacketsFeedback CreateFeedback(Timestamp feedback_time,
+                                                 TimeDelta rtt) {
+    TransportPacketsFeedback feedback;
+    feedback.feedback_time = feedback_time;
+    feedback.packet_feedbacks.push_back(
+        CreatePacketResult(1, feedback_time - rtt, feedback_time - rtt / 2,
+                           PacedPacketInfo()));
+    return feedback;
+  }
+
+  // Ten probe packets of 1000 bytes, 10 ms apart, measuring 800 kbps.
+  static TransportPacketsFeedback CreateProbeFeedback() {
+    TransportPacketsFeedback feedback;
+    PacedPacketInfo probe_info(/*probe_cluster_id=*/0,
+                               /*probe_cluster_min_probes=*/5,
+                               /*probe_cluster_min_bytes=*/5000);
+    for (int i = 0; i < 10; ++i) {
+      Timestamp send_time = kStartTime + TimeDelta::Millis(10 * i);
+      feedback.packet_feedbacks.push_back(CreatePacketResult(
+          i, send_time, send_time + TimeDelta::Millis(50), probe_info));
+    }
+    feedback.feedback_time = kStartTime + TimeDelta::Millis(200);
+    return feedback;
+  }
+
+  NiceMock<MockRtcEventLog> event_log_;
+};
+
+TEST_F(AlphaCcNetworkControllerTest, ProbesOnStart) {
+  auto controller = CreateController();
+  NetworkControlUpdate update =
+      controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  ASSERT_EQ(update.probe_cluster_configs.size(), 2u);
+  EXPECT_EQ(update.probe_cluster_configs[0].target_data_rate, kStartRate * 3);
+  EXPECT_EQ(update.probe_cluster_configs[1].target_data_rate, kStartRate * 6);
+}
+
+TEST_F(AlphaCcNetworkControllerTest, ProbesOnceNetworkIsAvailable) {
+  auto controller = CreateController();
+  NetworkAvailability msg;
+  msg.at_time = kStartTime;
+  msg.network_available = false;
+  controller->OnNetworkAvailability(msg);
+  NetworkControlUpdate update =
+      controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  EXPECT_TRUE(update.probe_cluster_configs.empty());
+
+  msg.at_time += TimeDelta::Millis(100);
+  msg.network_available = true;
+  update = controller->OnNetworkAvailability(msg);
+  EXPECT_EQ(update.probe_cluster_configs.size(), 2u);
+}
+
+TEST_F(AlphaCcNetworkControllerTest, ProbesWhileApplicationLimited) {
+  // The ALR detector stamps the start of ALR with the global clock.
+  rtc::ScopedBaseFakeClock clock;
+  clock.SetTime(kStartTime);
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  ProcessInterval msg;
+  msg.at_time = kStartTime;
+  controller->OnProcessInterval(msg);
+  const DataRate estimate = DataRate::KilobitsPerSec(500);
+  controller->OnReceiveBwe(CreateBwe(estimate, kStartTime));
+
+  // Sending far less than the estimate for a second.
+  Timestamp now = kStartTime;
+  SentPacket sent_packet;
+  sent_packet.size = DataSize::Bytes(100);
+  for (int i = 0; i <= 10; ++i) {
+    now += TimeDelta::Millis(100);
+    clock.SetTime(now);
+    sent_packet.send_time = now;
+    controller->OnSentPacket(sent_packet);
+  }
+  // The initial probes are given up on once they time out.
+  msg.at_time = now;
+  EXPECT_TRUE(controller->OnProcessInterval(msg).probe_cluster_configs.empty());
+
+  msg.at_time += TimeDelta::Seconds(5);
+  NetworkControlUpdate update = controller->OnProcessInterval(msg);
+  ASSERT_EQ(update.probe_cluster_configs.size(), 1u);
+  EXPECT_EQ(update.probe_cluster_configs[0].target_data_rate, estimate * 2);
+}
+
+TEST_F(AlphaCcNetworkControllerTest, ClampsTargetToConstraints) {
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  NetworkControlUpdate update = controller->OnReceiveBwe(
+      CreateBwe(DataRate::KilobitsPerSec(500), kStartTime));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(500));
+
+  // A lower maximum applies right away.
+  update = controller->OnTargetRateConstraints(
+      CreateConstraints(DataRate::KilobitsPerSec(400)));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(400));
+
+  update = controller->OnReceiveBwe(CreateBwe(
+      DataRate::KilobitsPerSec(2000), kStartTime + TimeDelta::Seconds(1)));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(400));
+}
+
+TEST_F(AlphaCcNetworkControllerTest, IgnoresModelRatesOutOfRange) {
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  for (float rate : {-1.0f, 1e22f, std::numeric_limits<float>::infinity(),
+                     std::numeric_limits<float>::quiet_NaN()}) {
+    BweMessage bwe = CreateBwe(DataRate::KilobitsPerSec(500), kStartTime);
+    bwe.target_rate = rate;
+    EXPECT_FALSE(controller->OnReceiveBwe(bwe).target_rate) << rate;
+    bwe = CreateBwe(DataRate::KilobitsPerSec(500), kStartTime);
+    bwe.pacing_rate = rate;
+    EXPECT_FALSE(controller->OnReceiveBwe(bwe).target_rate) << rate;
+  }
+  NetworkControlUpdate update = controller->OnReceiveBwe(
+      CreateBwe(DataRate::KilobitsPerSec(500), kStartTime));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(500));
+}
+
+TEST_F(AlphaCcNetworkControllerTest, LimitsTheIncreaseOfTheModelEstimate) {
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnReceiveBwe(
+      CreateBwe(DataRate::KilobitsPerSec(500), kStartTime));
+
+  // Doubles at most per second, below the smoothed 2750 kbps.
+  Timestamp now = kStartTime + TimeDelta::Seconds(1);
+  NetworkControlUpdate update =
+      controller->OnReceiveBwe(CreateBwe(DataRate::KilobitsPerSec(5000), now));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(1000));
+
+  // Changes within the deadband keep the target.
+  now += TimeDelta::Millis(100);
+  update =
+      controller->OnReceiveBwe(CreateBwe(DataRate::KilobitsPerSec(1020), now));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(1000));
+}
+
+TEST_F(AlphaCcNetworkControllerTest, LimitsTheDecreaseOfTheModelEstimate) {
+  auto controller = CreateController();
+  TargetRateConstraints constraints =
+      CreateConstraints(DataRate::KilobitsPerSec(2000));
+  constraints.min_data_rate = DataRate::KilobitsPerSec(100);
+  controller->OnTargetRateConstraints(constraints);
+  Timestamp now = kStartTime;
+  controller->OnReceiveBwe(CreateBwe(DataRate::KilobitsPerSec(1000), now));
+
+  // A collapse of the model halves the target per estimate, down to the
+  // minimum of the constraints.
+  const DataRate kCollapsed = DataRate::KilobitsPerSec(1);
+  for (int expected_kbps : {500, 250, 125, 100, 100}) {
+    now += TimeDelta::Millis(50);
+    NetworkControlUpdate update =
+        controller->OnReceiveBwe(CreateBwe(kCollapsed, now));
+    ASSERT_TRUE(update.target_rate);
+    EXPECT_EQ(update.target_rate->target_rate,
+              DataRate::KilobitsPerSec(expected_kbps));
+  }
+}
+
+TEST_F(AlphaCcNetworkControllerTest, AppliesThePacingFactorOfTheStreams) {
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnReceiveBwe(
+      CreateBwe(DataRate::KilobitsPerSec(500), kStartTime));
+
+  StreamsConfig msg;
+  msg.at_time = kStartTime;
+  msg.pacing_factor = 2.0;
+  NetworkControlUpdate update = controller->OnStreamsConfig(msg);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(update.pacer_config->data_rate(), DataRate::KilobitsPerSec(1000));
+}
+
+TEST_F(AlphaCcNetworkControllerTest, SizesCongestionWindowFromFeedbackRtt) {
+  ScopedFieldTrials trial("WebRTC-CongestionWindow/QueueSize:100/");
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnReceiveBwe(CreateBwe(kStartRate, kStartTime));
+
+  NetworkControlUpdate update = controller->OnTransportPacketsFeedback(
+      CreateFeedback(kStartTime + TimeDelta::Millis(100),
+                     TimeDelta::Millis(100)));
+  // The target over the RTT plus the queue allowance.
+  EXPECT_EQ(update.congestion_window,
+            kStartRate * TimeDelta::Millis(100 + 100));
+}
+
+TEST_F(AlphaCcNetworkControllerTest, PushesBackTargetWhenWindowIsFull) {
+  ScopedFieldTrials trial(
+      "WebRTC-CongestionWindow/QueueSize:100,MinBitrate:30000/");
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnReceiveBwe(CreateBwe(kStartRate, kStartTime));
+  Timestamp now = kStartTime + TimeDelta::Millis(100);
+  NetworkControlUpdate update = controller->OnTransportPacketsFeedback(
+      CreateFeedback(now, TimeDelta::Millis(100)));
+  // The window throttles the encoders instead of the pacer.
+  EXPECT_FALSE(update.congestion_window);
+
+  SentPacket sent_packet;
+  sent_packet.send_time = now;
+  sent_packet.size = DataSize::Bytes(1000);
+  sent_packet.data_in_flight = DataSize::Bytes(40000);
+  controller->OnSentPacket(sent_packet);
+  ProcessInterval msg;
+  msg.at_time = now + TimeDelta::Millis(25);
+  update = controller->OnProcessInterval(msg);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_LT(update.target_rate->target_rate, kStartRate);
+  EXPECT_GE(update.target_rate->target_rate, DataRate::KilobitsPerSec(30));
+}
+
+TEST_F(AlphaCcNetworkControllerTest, ReleasesPushbackOnceDataIsAcknowledged) {
+  ScopedFieldTrials trial(
+      "WebRTC-CongestionWindow/QueueSize:100,MinBitrate:30000/");
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnReceiveBwe(CreateBwe(kStartRate, kStartTime));
+  Timestamp now = kStartTime + TimeDelta::Millis(100);
+  controller->OnTransportPacketsFeedback(
+      CreateFeedback(now, TimeDelta::Millis(100)));
+  SentPacket sent_packet;
+  sent_packet.send_time = now;
+  sent_packet.size = DataSize::Bytes(1000);
+  sent_packet.data_in_flight = DataSize::Bytes(40000);
+  controller->OnSentPacket(sent_packet);
+  ProcessInterval msg;
+  msg.at_time = now + TimeDelta::Millis(25);
+  NetworkControlUpdate update = controller->OnProcessInterval(msg);
+  ASSERT_TRUE(update.target_rate);
+  ASSERT_LT(update.target_rate->target_rate, kStartRate);
+
+  // The feedback reports the outstanding data as delivered.
+  now += TimeDelta::Millis(100);
+  TransportPacketsFeedback feedback =
+      CreateFeedback(now, TimeDelta::Millis(100));
+  feedback.data_in_flight = DataSize::Zero();
+  update = controller->OnTransportPacketsFeedback(feedback);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, kStartRate);
+}
+
+TEST_F(AlphaCcNetworkControllerTest, CongestionWindowFollowsTheTarget) {
+  ScopedFieldTrials trial("WebRTC-CongestionWindow/QueueSize:100/");
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnReceiveBwe(CreateBwe(kStartRate, kStartTime));
+  Timestamp now = kStartTime + TimeDelta::Millis(100);
+  NetworkControlUpdate update = controller->OnTransportPacketsFeedback(
+      CreateFeedback(now, TimeDelta::Millis(100)));
+  const DataSize initial_window = kStartRate * TimeDelta::Millis(200);
+  EXPECT_EQ(update.congestion_window, initial_window);
+
+  // A lower target shrinks the window, smoothed over the updates.
+  const DataRate lower_rate = kStartRate / 2;
+  controller->OnReceiveBwe(CreateBwe(lower_rate, now));
+  now += TimeDelta::Millis(100);
+  update = controller->OnTransportPacketsFeedback(
+      CreateFeedback(now, TimeDelta::Millis(100)));
+  EXPECT_EQ(update.congestion_window,
+            (initial_window + lower_rate * TimeDelta::Millis(200)) / 2);
+}
+
+TEST_F(AlphaCcNetworkControllerTest, BoundsModelEstimateByProbedCapacity) {
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+
+  NetworkControlUpdate update =
+      controller->OnTransportPacketsFeedback(CreateProbeFeedback());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_NEAR(update.target_rate->target_rate.kbps(), 800, 10);
+
+  update = controller->OnReceiveBwe(
+      CreateBwe(DataRate::KilobitsPerSec(5000), kStartTime));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_LT(update.target_rate->target_rate, DataRate::KilobitsPerSec(1000));
+}
+
+TEST_F(AlphaCcNetworkControllerTest, DropsCapacityBoundAfterHoldTime) {
+  ScopedFieldTrials trial("WebRTC-Bwe-AlphaCcCapacityBounds/hold:1s/");
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnTransportPacketsFeedback(CreateProbeFeedback());
+  const DataRate kModelRate = DataRate::KilobitsPerSec(5000);
+  NetworkControlUpdate update =
+      controller->OnReceiveBwe(CreateBwe(kModelRate, kStartTime));
+  ASSERT_TRUE(update.target_rate);
+  const DataRate bounded_rate = update.target_rate->target_rate;
+  ASSERT_LT(bounded_rate, DataRate::KilobitsPerSec(1000));
+
+  update = controller->OnReceiveBwe(
+      CreateBwe(kModelRate, kStartTime + TimeDelta::Millis(500)));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, bounded_rate);
+
+  // The model kept estimating above the capacity, the bound is outdated and
+  // only the rate limits apply.
+  update = controller->OnReceiveBwe(
+      CreateBwe(kModelRate, kStartTime + TimeDelta::Seconds(1)));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, bounded_rate * 1.5);
+}
+
+TEST_F(AlphaCcNetworkControllerTest, DropsCapacityBoundOnRouteChange) {
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnTransportPacketsFeedback(CreateProbeFeedback());
+  NetworkRouteChange msg;
+  msg.at_time = kStartTime + TimeDelta::Millis(200);
+  msg.constraints = CreateConstraints(absl::nullopt);
+  controller->OnNetworkRouteChange(msg);
+
+  NetworkControlUpdate update = controller->OnReceiveBwe(
+      CreateBwe(DataRate::KilobitsPerSec(5000), kStartTime));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_GT(update.target_rate->target_rate, DataRate::KilobitsPerSec(1000));
+}
+
+TEST_F(AlphaCcNetworkControllerTest, CapacityBoundCanBeDisabled) {
+  ScopedFieldTrials trial("WebRTC-Bwe-AlphaCcCapacityBounds/enabled:false/");
+  auto controller = CreateController();
+  controller->OnTargetRateConstraints(CreateConstraints(absl::nullopt));
+  controller->OnTransportPacketsFeedback(CreateProbeFeedback());
+
+  NetworkControlUpdate update = controller->OnReceiveBwe(
+      CreateBwe(DataRate::KilobitsPerSec(5000), kStartTime));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(5000));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/alpha_cc/gcc_estimator.h"
+
+#include <algorithm>
+
+#include "absl/types/optional.h"
+#include "modules/remote_bitrate_estimator/include/bwe_defines.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+GccEstimator::GccEstimator(const WebRtcKeyValueConfig* key_value_config,
+                           RtcEventLog* event_log,
+                           const TargetRateConstraints& constraints)
+    : key_value_config_(key_value_config),
+      bandwidth_estimation_(
+          std::make_unique<SendSideBandwidthEstimation>(event_log)),
+      delay_based_bwe_(std::make_unique<DelayBasedBwe>(key_value_config_,
+                                                       event_log,
+                                                       nullptr)),
+      acknowledged_bitrate_estimator_(
+          AcknowledgedBitrateEstimatorInterface::Create(key_value_config_)) {
+  RTC_DCHECK(key_value_config_);
+  RTC_DCHECK(constraints.at_time.IsFinite());
+  OnTargetRateConstraints(constraints);
+}
+
+GccEstimator::~GccEstimator() = default;
+
+void GccEstimator::OnNetworkRouteChange() {
+  acknowledged_bitrate_estimator_ =
+      AcknowledgedBitrateEstimatorInterface::Create(key_value_config_);
+  bandwidth_estimation_->OnRouteChange();
+}
+
+void GccEstimator::OnProcessInterval(const ProcessInterval& msg) {
+  bandwidth_estimation_->UpdateEstimate(msg.at_time);
+}
+
+void GccEstimator::OnRemoteBitrateReport(const RemoteBitrateReport& msg) {
+  bandwidth_estimation_->UpdateReceiverEstimate(msg.receive_time,
+                                                msg.bandwidth);
+}
+
+void GccEstimator::OnRoundTripTimeUpdate(const RoundTripTimeUpdate& msg) {
+  if (msg.smoothed || msg.round_trip_time.IsZero())
+    return;
+  delay_based_bwe_->OnRttUpdate(msg.round_trip_time);
+  bandwidth_estimation_->UpdateRtt(msg.round_trip_time, msg.receive_time);
+}
+
+void GccEstimator::OnSentPacket(const SentPacket& msg) {
+  bandwidth_estimation_->OnSentPacket(msg);
+}
+
+void GccEstimator::OnTargetRateConstraints(
+    const TargetRateConstraints& constraints) {
+  DataRate min_data_rate =
+      std::max(constraints.min_data_rate.value_or(DataRate::Zero()),
+               congestion_controller::GetMinBitrate());
+  DataRate max_data_rate =
+      constraints.max_data_rate.value_or(DataRate::PlusInfinity());
+  if (max_data_rate < min_data_rate)
+    max_data_rate = min_data_rate;
+  bandwidth_estimation_->SetBitrates(constraints.starting_rate, min_data_rate,
+                                     max_data_rate, constraints.at_time);
+  if (constraints.starting_rate)
+    delay_based_bwe_->SetStartBitrate(*constraints.starting_rate);
+  delay_based_bwe_->SetMinBitrate(min_data_rate);
+}
+
+void GccEstimator::OnTransportLossReport(const TransportLossReport& msg) {
+  int64_t total_packets_delta =
+      msg.packets_received_delta + msg.packets_lost_delta;
+  bandwidth_estimation_->UpdatePacketsLost(
+      msg.packets_lost_delta, total_packets_delta, msg.receive_time);
+}
+
+void GccEstimator::OnTransportPacketsFeedback(
+    const TransportPacketsFeedback& report) {
+  if (report.packet_feedbacks.empty())
+    return;
+
+  acknowledged_bitrate_estimator_->IncomingPacketFeedbackVector(
+      report.SortedByReceiveTime());
+  absl::optional<DataRate> acknowledged_bitrate =
+      acknowledged_bitrate_estimator_->bitrate();
+  bandwidth_estimation_->SetAcknowledgedRate(acknowledged_bitrate,
+                                             report.feedback_time);
+  bandwidth_estimation_->IncomingPacketFeedbackVector(report);
+
+  DelayBasedBwe::Result result =
+      delay_based_bwe_->IncomingPacketFeedbackVector(
+          report, acknowledged_bitrate, /*probe_bitrate=*/absl::nullopt,
+          /*network_estimate=*/absl::nullopt, /*in_alr=*/false);
+  if (result.updated) {
+    bandwidth_estimation_->UpdateDelayBasedEstimate(report.feedback_time,
+                                                    result.target_bitrate);
+  }
+}
+
+DataRate GccEstimator::target_rate() const {
+  return bandwidth_estimation_->target_rate();
+}
+
+float GccEstimator::loss_ratio() const {
+  return bandwidth_estimation_->fraction_loss() / 255.0f;
+}
+
+TimeDelta GccEstimator::round_trip_time() const {
+  return bandwidth_estimation_->round_trip_time();
+}
+
+TimeDelta GccEstimator::expected_bwe_period() const {
+  return delay_based_bwe_->GetExpectedBwePeriod();
+}
+
+}  // namespace webrtc
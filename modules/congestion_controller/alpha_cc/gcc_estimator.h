@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_ALPHA_CC_GCC_ESTIMATOR_H_
+#define MODULES_CONGESTION_CONTROLLER_ALPHA_CC_GCC_ESTIMATOR_H_
+
+#include <memory>
+
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/transport/network_types.h"
+#include "api/transport/webrtc_key_value_config.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/goog_cc/acknowledged_bitrate_estimator_interface.h"
+#include "modules/congestion_controller/goog_cc/delay_based_bwe.h"
+#include "modules/congestion_controller/goog_cc/send_side_bandwidth_estimation.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// GCC's delay and loss based estimators, fed from the same messages as the
+// GoogCcNetworkController they come from, for the controllers that run them
+// next to the AlphaCC controller. Probing and ALR are left to the AlphaCC
+// controller, so the estimators run without probe results.
+class GccEstimator {
+ public:
+  GccEstimator(const WebRtcKeyValueConfig* key_value_config,
+               RtcEventLog* event_log,
+               const TargetRateConstraints& constraints);
+  ~GccEstimator();
+
+  void OnNetworkRouteChange();
+  void OnProcessInterval(const ProcessInterval& msg);
+  void OnRemoteBitrateReport(const RemoteBitrateReport& msg);
+  void OnRoundTripTimeUpdate(const RoundTripTimeUpdate& msg);
+  void OnSentPacket(const SentPacket& msg);
+  void OnTargetRateConstraints(const TargetRateConstraints& constraints);
+  void OnTransportLossReport(const TransportLossReport& msg);
+  void OnTransportPacketsFeedback(const TransportPacketsFeedback& report);
+
+  DataRate target_rate() const;
+  // In [0, 1].
+  float loss_ratio() const;
+  TimeDelta round_trip_time() const;
+  TimeDelta expected_bwe_period() const;
+
+ private:
+  const WebRtcKeyValueConfig* const key_value_config_;
+  const std::unique_ptr<SendSideBandwidthEstimation> bandwidth_estimation_;
+  const std::unique_ptr<DelayBasedBwe> delay_based_bwe_;
+  std::unique_ptr<AcknowledgedBitrateEstimatorInterface>
+      acknowledged_bitrate_estimator_;
+
+  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(GccEstimator);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_ALPHA_CC_GCC_ESTIMATOR_H_
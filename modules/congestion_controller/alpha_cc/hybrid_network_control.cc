@@ -0,0 +1,265 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/alpha_cc/hybrid_network_control.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Same as GoogCcNetworkController.
+const float kDefaultPaceMultiplier = 2.5f;
+
+const char* SourceName(int source) {
+  static const char* const kNames[] = {"gcc", "model", "minimum"};
+  return kNames[source];
+}
+
+}  // namespace
+
+HybridNetworkController::Settings::Settings(
+    const WebRtcKeyValueConfig* key_value_config) {
+  ParseFieldTrial(
+      {&model_timeout, &divergence_factor, &divergence_time, &loss_threshold},
+      key_value_config->Lookup("WebRTC-Bwe-AlphaCcHybrid"));
+}
+
+HybridNetworkController::HybridNetworkController(
+    NetworkControllerConfig config,
+    std::unique_ptr<NetworkControllerInterface> model_controller)
+    : key_value_config_(config.key_value_config ? config.key_value_config
+                                                : &trial_based_config_),
+      settings_(key_value_config_),
+      model_controller_(std::move(model_controller)),
+      gcc_estimator_(key_value_config_, config.event_log, config.constraints),
+      pacing_factor_(config.stream_based_config.pacing_factor.value_or(
+          kDefaultPaceMultiplier)) {
+  RTC_DCHECK(model_controller_);
+}
+
+HybridNetworkController::~HybridNetworkController() = default;
+
+NetworkControlUpdate HybridNetworkController::OnNetworkAvailability(
+    NetworkAvailability msg) {
+  OnModelUpdate(model_controller_->OnNetworkAvailability(msg));
+  return TakeModelUpdate();
+}
+
+NetworkControlUpdate HybridNetworkController::OnNetworkRouteChange(
+    NetworkRouteChange msg) {
+  OnModelUpdate(model_controller_->OnNetworkRouteChange(msg));
+  gcc_estimator_.OnNetworkRouteChange();
+  model_estimate_.reset();
+  model_predicted_loss_ratio_ = 0;
+  model_predicted_bandwidth_ratio_ = 1;
+  divergence_start_ = Timestamp::PlusInfinity();
+  return MaybeUpdateTarget(msg.at_time);
+}
+
+NetworkControlUpdate HybridNetworkController::OnProcessInterval(
+    ProcessInterval msg) {
+  current_time_ = msg.at_time;
+  OnModelUpdate(model_controller_->OnProcessInterval(msg));
+  gcc_estimator_.OnProcessInterval(msg);
+  return MaybeUpdateTarget(msg.at_time);
+}
+
+NetworkControlUpdate HybridNetworkController::OnRemoteBitrateReport(
+    RemoteBitrateReport msg) {
+  OnModelUpdate(model_controller_->OnRemoteBitrateReport(msg));
+  gcc_estimator_.OnRemoteBitrateReport(msg);
+  return TakeModelUpdate();
+}
+
+NetworkControlUpdate HybridNetworkController::OnRoundTripTimeUpdate(
+    RoundTripTimeUpdate msg) {
+  OnModelUpdate(model_controller_->OnRoundTripTimeUpdate(msg));
+  gcc_estimator_.OnRoundTripTimeUpdate(msg);
+  return TakeModelUpdate();
+}
+
+NetworkControlUpdate HybridNetworkController::OnSentPacket(
+    SentPacket sent_packet) {
+  OnModelUpdate(model_controller_->OnSentPacket(sent_packet));
+  gcc_estimator_.OnSentPacket(sent_packet);
+  return TakeModelUpdate();
+}
+
+NetworkControlUpdate HybridNetworkController::OnReceivedPacket(
+    ReceivedPacket received_packet) {
+  OnModelUpdate(model_controller_->OnReceivedPacket(received_packet));
+  return TakeModelUpdate();
+}
+
+NetworkControlUpdate HybridNetworkController::OnStreamsConfig(
+    StreamsConfig msg) {
+  OnModelUpdate(model_controller_->OnStreamsConfig(msg));
+  if (msg.pacing_factor)
+    pacing_factor_ = *msg.pacing_factor;
+  // Always tell the caller where we are, not only on changes.
+  last_target_.reset();
+  return MaybeUpdateTarget(msg.at_time);
+}
+
+NetworkControlUpdate HybridNetworkController::OnTargetRateConstraints(
+    TargetRateConstraints constraints) {
+  OnModelUpdate(model_controller_->OnTargetRateConstraints(constraints));
+  gcc_estimator_.OnTargetRateConstraints(constraints);
+  return TakeModelUpdate();
+}
+
+NetworkControlUpdate HybridNetworkController::OnTransportLossReport(
+    TransportLossReport msg) {
+  OnModelUpdate(model_controller_->OnTransportLossReport(msg));
+  gcc_estimator_.OnTransportLossReport(msg);
+  return TakeModelUpdate();
+}
+
+NetworkControlUpdate HybridNetworkController::OnTransportPacketsFeedback(
+    TransportPacketsFeedback report) {
+  current_time_ = report.feedback_time;
+  OnModelUpdate(model_controller_->OnTransportPacketsFeedback(report));
+  gcc_estimator_.OnTransportPacketsFeedback(report);
+  return MaybeUpdateTarget(report.feedback_time);
+}
+
+NetworkControlUpdate HybridNetworkController::OnNetworkStateEstimate(
+    NetworkStateEstimate msg) {
+  OnModelUpdate(model_controller_->OnNetworkStateEstimate(msg));
+  return TakeModelUpdate();
+}
+
+NetworkControlUpdate HybridNetworkController::OnReceiveBwe(BweMessage bwe) {
+  OnModelUpdate(model_controller_->OnReceiveBwe(bwe));
+  // |bwe.timestamp_ms| is on the receiver's clock, so wait for the next local
+  // timestamp instead of updating the target here.
+  return TakeModelUpdate();
+}
+
+void HybridNetworkController::OnModelUpdate(
+    const NetworkControlUpdate& update) {
+  // Probing and the congestion window are left to the model controller, only
+  // the target is arbitrated.
+  pending_probe_cluster_configs_.insert(
+      pending_probe_cluster_configs_.end(),
+      update.probe_cluster_configs.begin(), update.probe_cluster_configs.end());
+  if (update.congestion_window)
+    pending_congestion_window_ = update.congestion_window;
+  if (update.pacer_config)
+    model_padding_rate_ = update.pacer_config->pad_rate();
+  if (!update.target_rate)
+    return;
+  model_estimate_ = update.target_rate->target_rate;
+  model_predicted_loss_ratio_ =
+      update.target_rate->network_estimate.predicted_loss_rate_ratio;
+  model_predicted_bandwidth_ratio_ =
+      update.target_rate->network_estimate.predicted_bandwidth_ratio;
+  // The model may stamp its updates with the remote clock, see OnReceiveBwe().
+  model_estimate_time_ = current_time_;
+}
+
+NetworkControlUpdate HybridNetworkController::TakeModelUpdate() {
+  NetworkControlUpdate update;
+  update.probe_cluster_configs = std::move(pending_probe_cluster_configs_);
+  pending_probe_cluster_configs_.clear();
+  update.congestion_window = pending_congestion_window_;
+  pending_congestion_window_.reset();
+  return update;
+}
+
+NetworkControlUpdate HybridNetworkController::MaybeUpdateTarget(
+    Timestamp at_time) {
+  NetworkControlUpdate update = TakeModelUpdate();
+  DataRate target = ArbitrateTarget(at_time);
+  if (last_target_ == target)
+    return update;
+  last_target_ = target;
+
+  update.target_rate = TargetTransferRate();
+  update.target_rate->at_time = at_time;
+  update.target_rate->target_rate = target;
+  update.target_rate->network_estimate.at_time = at_time;
+  update.target_rate->network_estimate.bandwidth = target;
+  update.target_rate->network_estimate.loss_rate_ratio =
+      gcc_estimator_.loss_ratio();
+  update.target_rate->network_estimate.predicted_loss_rate_ratio =
+      model_predicted_loss_ratio_;
+  update.target_rate->network_estimate.predicted_bandwidth_ratio =
+      model_predicted_bandwidth_ratio_;
+  update.target_rate->network_estimate.round_trip_time =
+      gcc_estimator_.round_trip_time();
+  update.target_rate->network_estimate.bwe_period =
+      gcc_estimator_.expected_bwe_period();
+
+  PacerConfig pacer_config;
+  pacer_config.at_time = at_time;
+  pacer_config.time_window = TimeDelta::Seconds(1);
+  pacer_config.data_window =
+      target * pacing_factor_ * pacer_config.time_window;
+  pacer_config.pad_window =
+      std::min(model_padding_rate_, target) * pacer_config.time_window;
+  update.pacer_config = pacer_config;
+  return update;
+}
+
+DataRate HybridNetworkController::ArbitrateTarget(Timestamp at_time) {
+  DataRate gcc_target = gcc_estimator_.target_rate();
+  Source source = Source::kGcc;
+  DataRate target = gcc_target;
+
+  bool model_fresh =
+      model_estimate_ && model_estimate_->IsFinite() &&
+      at_time - model_estimate_time_ <= settings_.model_timeout.Get();
+  if (model_fresh) {
+    DataRate low = std::min(*model_estimate_, gcc_target);
+    DataRate high = std::max(*model_estimate_, gcc_target);
+    if (high > low * settings_.divergence_factor.Get()) {
+      if (divergence_start_.IsInfinite())
+        divergence_start_ = at_time;
+    } else {
+      divergence_start_ = Timestamp::PlusInfinity();
+    }
+    bool diverged = divergence_start_.IsFinite() &&
+                    at_time - divergence_start_ >=
+                        settings_.divergence_time.Get();
+    double loss_ratio = gcc_estimator_.loss_ratio();
+
+    if (diverged) {
+      // Keep |source| and |target| from GCC.
+    } else if (loss_ratio > settings_.loss_threshold.Get()) {
+      source = Source::kMinimum;
+      target = low;
+    } else {
+      source = Source::kModel;
+      target = *model_estimate_;
+    }
+  } else {
+    divergence_start_ = Timestamp::PlusInfinity();
+  }
+
+  if (source_ != source) {
+    RTC_LOG(LS_INFO) << "Hybrid controller using "
+                     << SourceName(static_cast<int>(source))
+                     << " estimate, model: "
+                     << (model_estimate_ ? ToString(*model_estimate_)
+                                         : std::string("none"))
+                     << ", gcc: " << ToString(gcc_target);
+    source_ = source;
+  }
+  return target;
+}
+
+}  // namespace webrtc
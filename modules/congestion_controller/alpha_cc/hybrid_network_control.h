@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_ALPHA_CC_HYBRID_NETWORK_CONTROL_H_
+#define MODULES_CONGESTION_CONTROLLER_ALPHA_CC_HYBRID_NETWORK_CONTROL_H_
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/transport/field_trial_based_config.h"
+#include "api/transport/network_control.h"
+#include "api/transport/webrtc_key_value_config.h"
+#include "modules/congestion_controller/alpha_cc/gcc_estimator.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+
+namespace webrtc {
+
+// Runs the AlphaCC controller and the GCC delay and loss based estimators side
+// by side and arbitrates between them per update. The model estimate is used
+// while it is fresh. GCC takes over while the model estimate is missing, stale
+// or diverges from GCC for too long, and under heavy loss the lower of the two
+// is used.
+class HybridNetworkController : public NetworkControllerInterface {
+ public:
+  HybridNetworkController(
+      NetworkControllerConfig config,
+      std::unique_ptr<NetworkControllerInterface> model_controller);
+  ~HybridNetworkController() override;
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override;
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override;
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override;
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override;
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override;
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override;
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override;
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override;
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override;
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override;
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override;
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override;
+  NetworkControlUpdate OnReceiveBwe(BweMessage msg) override;
+
+ private:
+  struct Settings {
+    // Model estimates older than this are not used.
+    FieldTrialParameter<TimeDelta> model_timeout{"timeout",
+                                                 TimeDelta::Seconds(2)};
+    // The model is considered diverged once it has been more than this factor
+    // away from GCC for |divergence_time|.
+    FieldTrialParameter<double> divergence_factor{"factor", 3.0};
+    FieldTrialParameter<TimeDelta> divergence_time{"div_time",
+                                                   TimeDelta::Seconds(2)};
+    // Loss ratio above which the lower of the two estimates is used.
+    FieldTrialParameter<double> loss_threshold{"loss", 0.1};
+    explicit Settings(const WebRtcKeyValueConfig* key_value_config);
+  };
+
+  enum class Source { kGcc, kModel, kMinimum };
+
+  // Remembers the target rate of an update of |model_controller_| and keeps
+  // its probes and congestion window to be forwarded.
+  void OnModelUpdate(const NetworkControlUpdate& update);
+  // Returns the probes and congestion window of the model updates since the
+  // last call.
+  NetworkControlUpdate TakeModelUpdate();
+  // Same as TakeModelUpdate(), with the target rate if the arbitrated target
+  // changed.
+  NetworkControlUpdate MaybeUpdateTarget(Timestamp at_time);
+  DataRate ArbitrateTarget(Timestamp at_time);
+
+  const FieldTrialBasedConfig trial_based_config_;
+  const WebRtcKeyValueConfig* const key_value_config_;
+  const Settings settings_;
+  const std::unique_ptr<NetworkControllerInterface> model_controller_;
+
+  GccEstimator gcc_estimator_;
+
+  double pacing_factor_;
+  // Latest local time seen in any message.
+  Timestamp current_time_ = Timestamp::MinusInfinity();
+  absl::optional<DataRate> model_estimate_;
+  Timestamp model_estimate_time_ = Timestamp::MinusInfinity();
+  // Loss the model expects ahead of the loss reports, forwarded as is.
+  float model_predicted_loss_ratio_ = 0;
+  float model_predicted_bandwidth_ratio_ = 1;
+  // Padding the model asked for, capped to the arbitrated target.
+  DataRate model_padding_rate_ = DataRate::Zero();
+  std::vector<ProbeClusterConfig> pending_probe_cluster_configs_;
+  absl::optional<DataSize> pending_congestion_window_;
+  Timestamp divergence_start_ = Timestamp::PlusInfinity();
+  absl::optional<Source> source_;
+  absl::optional<DataRate> last_target_;
+
+  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(HybridNetworkController);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_ALPHA_CC_HYBRID_NETWORK_CONTROL_H_
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/alpha_cc/hybrid_network_control.h"
+
+#include <memory>
+#include <utility>
+
+#include "logging/rtc_event_log/mock/mock_rtc_event_log.h"
+#include "modules/congestion_controller/alpha_cc/test/mock_network_controller.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr DataRate kStartRate = DataRate::KilobitsPerSec(300);
+
+NetworkControlUpdate CreateModelUpdate(DataRate target, Timestamp at_time) {
+  NetworkControlUpdate update;
+  update.target_rate = TargetTransferRate();
+  update.target_rate->at_time = at_time;
+  update.target_rate->target_rate = target;
+  update.target_rate->network_estimate.bandwidth = target;
+  return update;
+}
+
+class HybridNetworkControllerTest : public ::testing::Test {
+ protected:
+  HybridNetworkControllerTest() {
+    NetworkControllerConfig config;
+    config.constraints.at_time = Timestamp::Seconds(1);
+    config.constraints.starting_rate = kStartRate;
+    config.event_log = &event_log_;
+    auto model_controller = std::make_unique<NiceMock<MockNetworkController>>();
+    model_controller_ = model_controller.get();
+    controller_ = std::make_unique<HybridNetworkController>(
+        config, std::move(model_controller));
+  }
+
+  NetworkControlUpdate ProcessAt(Timestamp at_time) {
+    ProcessInterval msg;
+    msg.at_time = at_time;
+    return controller_->OnProcessInterval(msg);
+  }
+
+  NiceMock<MockRtcEventLog> event_log_;
+  NiceMock<MockNetworkController>* model_controller_;
+  std::unique_ptr<HybridNetworkController> controller_;
+};
+
+TEST_F(HybridNetworkControllerTest, ForwardsModelProbesOnNetworkAvailability) {
+  NetworkControlUpdate model_update;
+  model_update.probe_cluster_configs.emplace_back();
+  model_update.probe_cluster_configs.back().target_data_rate =
+      DataRate::KilobitsPerSec(900);
+  EXPECT_CALL(*model_controller_, OnNetworkAvailability)
+      .WillOnce(Return(model_update));
+
+  NetworkAvailability msg;
+  msg.at_time = Timestamp::Seconds(1);
+  msg.network_available = true;
+  NetworkControlUpdate update = controller_->OnNetworkAvailability(msg);
+  ASSERT_EQ(update.probe_cluster_configs.size(), 1u);
+  EXPECT_EQ(update.probe_cluster_configs[0].target_data_rate,
+            DataRate::KilobitsPerSec(900));
+}
+
+TEST_F(HybridNetworkControllerTest, ForwardsModelCongestionWindowWithTarget) {
+  const Timestamp now = Timestamp::Seconds(1);
+  NetworkControlUpdate model_update =
+      CreateModelUpdate(DataRate::KilobitsPerSec(500), now);
+  model_update.congestion_window = DataSize::Bytes(20000);
+  model_update.probe_cluster_configs.emplace_back();
+  EXPECT_CALL(*model_controller_, OnProcessInterval)
+      .WillOnce(Return(model_update))
+      .WillRepeatedly(Return(NetworkControlUpdate()));
+
+  NetworkControlUpdate update = ProcessAt(now);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(500));
+  EXPECT_EQ(update.congestion_window, DataSize::Bytes(20000));
+  EXPECT_EQ(update.probe_cluster_configs.size(), 1u);
+
+  // Forwarded once only.
+  update = ProcessAt(now + TimeDelta::Millis(25));
+  EXPECT_FALSE(update.congestion_window);
+  EXPECT_TRUE(update.probe_cluster_configs.empty());
+}
+
+TEST_F(HybridNetworkControllerTest, ForwardsProbesWithoutTargetChange) {
+  EXPECT_CALL(*model_controller_, OnProcessInterval)
+      .WillOnce(Return(NetworkControlUpdate()));
+  ProcessAt(Timestamp::Seconds(1));
+
+  NetworkControlUpdate model_update;
+  model_update.probe_cluster_configs.emplace_back();
+  EXPECT_CALL(*model_controller_, OnProcessInterval)
+      .WillOnce(Return(model_update));
+  NetworkControlUpdate update = ProcessAt(Timestamp::Millis(1025));
+  EXPECT_FALSE(update.target_rate);
+  EXPECT_EQ(update.probe_cluster_configs.size(), 1u);
+}
+
+TEST_F(HybridNetworkControllerTest, CapsModelPaddingToTarget) {
+  const Timestamp now = Timestamp::Seconds(1);
+  NetworkControlUpdate model_update =
+      CreateModelUpdate(DataRate::KilobitsPerSec(400), now);
+  model_update.pacer_config = PacerConfig();
+  model_update.pacer_config->time_window = TimeDelta::Seconds(1);
+  model_update.pacer_config->pad_window =
+      DataRate::KilobitsPerSec(1000) * TimeDelta::Seconds(1);
+  EXPECT_CALL(*model_controller_, OnProcessInterval)
+      .WillOnce(Return(model_update));
+
+  NetworkControlUpdate update = ProcessAt(now);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(update.pacer_config->pad_rate(), DataRate::KilobitsPerSec(400));
+}
+
+TEST_F(HybridNetworkControllerTest, FallsBackToGccWhenModelEstimateIsStale) {
+  const Timestamp now = Timestamp::Seconds(1);
+  EXPECT_CALL(*model_controller_, OnProcessInterval)
+      .WillOnce(Return(CreateModelUpdate(DataRate::KilobitsPerSec(500), now)))
+      .WillRepeatedly(Return(NetworkControlUpdate()));
+  NetworkControlUpdate update = ProcessAt(now);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(500));
+
+  update = ProcessAt(now + TimeDelta::Seconds(3));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, kStartRate);
+}
+
+TEST_F(HybridNetworkControllerTest, IgnoresTheConfidenceOfTheReceiver) {
+  const Timestamp now = Timestamp::Seconds(1);
+  // The model estimate is stamped with the last local time.
+  ProcessAt(now);
+  EXPECT_CALL(*model_controller_, OnReceiveBwe)
+      .WillOnce(Return(CreateModelUpdate(DataRate::KilobitsPerSec(500), now)));
+  BweMessage bwe;
+  bwe.target_rate = 500000;
+  bwe.confidence = 0.1f;
+  controller_->OnReceiveBwe(bwe);
+
+  NetworkControlUpdate update = ProcessAt(now + TimeDelta::Millis(25));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(500));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
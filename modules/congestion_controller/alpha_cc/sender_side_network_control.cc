@@ -0,0 +1,223 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/alpha_cc/sender_side_network_control.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Same as GoogCcNetworkController.
+const float kDefaultPaceMultiplier = 2.5f;
+
+float InitialEstimateBps(const NetworkControllerConfig& config) {
+  if (config.constraints.starting_rate)
+    return static_cast<float>(config.constraints.starting_rate->bps());
+  return BweMessage().target_rate;
+}
+
+}  // namespace
+
+SenderSideNetworkController::SenderSideNetworkController(
+    NetworkControllerConfig config,
+    const AlphaCCConfig& alpha_cc_config)
+    : SenderSideNetworkController(config,
+                                  alpha_cc_config,
+                                  /*task_queue_factory=*/nullptr) {}
+
+SenderSideNetworkController::SenderSideNetworkController(
+    NetworkControllerConfig config,
+    const AlphaCCConfig& alpha_cc_config,
+    TaskQueueFactory* task_queue_factory)
+    : pacing_factor_(config.stream_based_config.pacing_factor.value_or(
+          kDefaultPaceMultiplier)),
+      min_data_rate_(
+          config.constraints.min_data_rate.value_or(DataRate::Zero())),
+      max_data_rate_(
+          config.constraints.max_data_rate.value_or(DataRate::PlusInfinity())),
+      bwe_period_(TimeDelta::Millis(
+          std::max(alpha_cc_config.bwe_feedback_duration_ms, 1))),
+      estimator_worker_(std::make_unique<ReceiveSideEstimatorWorker>(
+          task_queue_factory,
+          [alpha_cc_config] {
+            return CreateReceiveSideBandwidthEstimator(alpha_cc_config);
+          },
+          /*model_version=*/"",
+          CreateWarmupFallbackEstimator(alpha_cc_config),
+          InitialEstimateBps(config),
+          alpha_cc_config.bwe_feedback_duration_ms,
+          /*estimate_callback=*/nullptr)) {
+  RTC_DCHECK(config.constraints.at_time.IsFinite());
+}
+
+SenderSideNetworkController::~SenderSideNetworkController() = default;
+
+NetworkControlUpdate SenderSideNetworkController::OnNetworkAvailability(
+    NetworkAvailability msg) {
+  if (msg.network_available == network_available_)
+    return NetworkControlUpdate();
+  network_available_ = msg.network_available;
+  if (!network_available_) {
+    // Packets lost while the network is down say nothing about congestion.
+    lost_since_last_received_ = 0;
+    return NetworkControlUpdate();
+  }
+  // Estimates published in the meantime were not reported.
+  last_reported_estimate_bps_ = estimator_worker_->LatestEstimateBps();
+  return CreateUpdate(DataRate::BitsPerSec(*last_reported_estimate_bps_),
+                      msg.at_time);
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnNetworkRouteChange(
+    NetworkRouteChange msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnProcessInterval(
+    ProcessInterval msg) {
+  // The estimator updates on its own schedule, pick up estimates published
+  // between two feedback packets here.
+  return MaybeUpdateEstimate(msg.at_time);
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnRemoteBitrateReport(
+    RemoteBitrateReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnRoundTripTimeUpdate(
+    RoundTripTimeUpdate msg) {
+  if (msg.smoothed && msg.round_trip_time.IsFinite())
+    rtt_ms_ = msg.round_trip_time.ms();
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnSentPacket(
+    SentPacket sent_packet) {
+  // The feedback carries the SentPacket of every packet it reports, which is
+  // all the estimator needs to know about sent packets.
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnReceivedPacket(
+    ReceivedPacket received_packet) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnStreamsConfig(
+    StreamsConfig msg) {
+  if (msg.pacing_factor)
+    pacing_factor_ = *msg.pacing_factor;
+  if (!network_available_)
+    return NetworkControlUpdate();
+  return CreateUpdate(
+      DataRate::BitsPerSec(estimator_worker_->LatestEstimateBps()),
+      msg.at_time);
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnTargetRateConstraints(
+    TargetRateConstraints constraints) {
+  min_data_rate_ = constraints.min_data_rate.value_or(DataRate::Zero());
+  max_data_rate_ =
+      constraints.max_data_rate.value_or(DataRate::PlusInfinity());
+  if (!network_available_)
+    return NetworkControlUpdate();
+  return CreateUpdate(
+      DataRate::BitsPerSec(estimator_worker_->LatestEstimateBps()),
+      constraints.at_time);
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnTransportLossReport(
+    TransportLossReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnTransportPacketsFeedback(
+    TransportPacketsFeedback report) {
+  for (const PacketResult& result : report.PacketsWithFeedback()) {
+    if (result.receive_time.IsInfinite()) {
+      if (network_available_)
+        ++lost_since_last_received_;
+      continue;
+    }
+    // The feedback does not tell which stream a packet belonged to, nor how
+    // much of it was header, so those are left unset and |payload_size| is
+    // the whole packet.
+    ReceivedPacketInfo packet;
+    packet.sequence_number =
+        static_cast<uint16_t>(result.sent_packet.sequence_number);
+    packet.send_time_ms =
+        static_cast<uint32_t>(result.sent_packet.send_time.ms());
+    packet.send_time_us = result.sent_packet.send_time.us();
+    packet.arrival_time_ms = result.receive_time.ms();
+    packet.payload_size = result.sent_packet.size.bytes();
+    packet.loss_count = lost_since_last_received_;
+    packet.rtt_ms = rtt_ms_;
+    lost_since_last_received_ = 0;
+    estimator_worker_->OnPacket(packet);
+  }
+  return MaybeUpdateEstimate(report.feedback_time);
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnNetworkStateEstimate(
+    NetworkStateEstimate msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate SenderSideNetworkController::OnReceiveBwe(BweMessage bwe) {
+  // The receiver does not estimate in this mode, see
+  // AlphaCCConfig::BweLocation.
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate SenderSideNetworkController::MaybeUpdateEstimate(
+    Timestamp at_time) {
+  if (!network_available_)
+    return NetworkControlUpdate();
+  float estimate_bps = estimator_worker_->LatestEstimateBps();
+  if (last_reported_estimate_bps_ == estimate_bps)
+    return NetworkControlUpdate();
+  last_reported_estimate_bps_ = estimate_bps;
+  return CreateUpdate(DataRate::BitsPerSec(estimate_bps), at_time);
+}
+
+NetworkControlUpdate SenderSideNetworkController::CreateUpdate(
+    DataRate estimate,
+    Timestamp at_time) const {
+  // The minimum wins if the constraints contradict each other, as in
+  // SendSideBandwidthEstimation.
+  DataRate target =
+      std::max(std::min(estimate, max_data_rate_), min_data_rate_);
+  NetworkControlUpdate update;
+  update.target_rate = TargetTransferRate();
+  update.target_rate->at_time = at_time;
+  update.target_rate->target_rate = target;
+  update.target_rate->network_estimate.at_time = at_time;
+  update.target_rate->network_estimate.bandwidth = estimate;
+  update.target_rate->network_estimate.round_trip_time =
+      TimeDelta::Millis(rtt_ms_ < 0 ? 0 : rtt_ms_);
+  update.target_rate->network_estimate.bwe_period = bwe_period_;
+
+  PacerConfig pacer_config;
+  pacer_config.at_time = at_time;
+  pacer_config.time_window = TimeDelta::Seconds(1);
+  pacer_config.data_window =
+      target * pacing_factor_ * pacer_config.time_window;
+  pacer_config.pad_window = DataSize::Zero();
+  update.pacer_config = pacer_config;
+  return update;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_ALPHA_CC_SENDER_SIDE_NETWORK_CONTROL_H_
+#define MODULES_CONGESTION_CONTROLLER_ALPHA_CC_SENDER_SIDE_NETWORK_CONTROL_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/alphacc_config.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/transport/network_control.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "modules/remote_bitrate_estimator/receive_side_estimator_worker.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// Runs the AlphaCC bandwidth estimator on the sender, used with
+// AlphaCCConfig::BweLocation::kSender. Instead of waiting for the receiver's
+// estimate, the per-packet send and receive times reported by transport-wide
+// feedback are handed to the estimator, which saves the trip back of the
+// receiver's BWE messages. The estimates are clamped to the target rate
+// constraints and not reported while the network is unavailable.
+class SenderSideNetworkController : public NetworkControllerInterface {
+ public:
+  SenderSideNetworkController(NetworkControllerConfig config,
+                              const AlphaCCConfig& alpha_cc_config);
+  // Runs the estimator on task queues of |task_queue_factory| instead of the
+  // default one, e.g. to run in simulated time. Null means the default
+  // factory.
+  SenderSideNetworkController(NetworkControllerConfig config,
+                              const AlphaCCConfig& alpha_cc_config,
+                              TaskQueueFactory* task_queue_factory);
+  ~SenderSideNetworkController() override;
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override;
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override;
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override;
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override;
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override;
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override;
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override;
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override;
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override;
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override;
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override;
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override;
+  NetworkControlUpdate OnReceiveBwe(BweMessage msg) override;
+
+ private:
+  // Returns an update if the estimator published a new estimate since the
+  // last one that was reported.
+  NetworkControlUpdate MaybeUpdateEstimate(Timestamp at_time);
+  NetworkControlUpdate CreateUpdate(DataRate estimate, Timestamp at_time) const;
+
+  double pacing_factor_;
+  DataRate min_data_rate_;
+  DataRate max_data_rate_;
+  // The estimator publishes an estimate per interval, which is how long a
+  // change of the estimate takes to show.
+  const TimeDelta bwe_period_;
+  bool network_available_ = true;
+  const std::unique_ptr<ReceiveSideEstimatorWorker> estimator_worker_;
+
+  // Lost packets reported since the last received one, handed to the
+  // estimator with the next received packet.
+  int32_t lost_since_last_received_ = 0;
+  int64_t rtt_ms_ = -1;
+  absl::optional<float> last_reported_estimate_bps_;
+
+  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(SenderSideNetworkController);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_ALPHA_CC_SENDER_SIDE_NETWORK_CONTROL_H_
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/alpha_cc/sender_side_network_control.h"
+
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr DataRate kStartRate = DataRate::KilobitsPerSec(300);
+constexpr Timestamp kStartTime = Timestamp::Seconds(1);
+constexpr int kEstimateIntervalMs = 50;
+
+AlphaCCConfig CreateAlphaCcConfig() {
+  AlphaCCConfig config;
+  config.bwe_location = AlphaCCConfig::BweLocation::kSender;
+  config.bwe_estimator_option = AlphaCCConfig::BweEstimatorOption::kReceiveRate;
+  config.bwe_feedback_duration_ms = kEstimateIntervalMs;
+  return config;
+}
+
+NetworkControllerConfig CreateConfig() {
+  NetworkControllerConfig config;
+  config.constraints.at_time = kStartTime;
+  config.constraints.starting_rate = kStartRate;
+  return config;
+}
+
+class SenderSideNetworkControllerTest : public ::testing::Test {
+ protected:
+  SenderSideNetworkControllerTest()
+      : time_controller_(kStartTime),
+        controller_(CreateConfig(),
+                    CreateAlphaCcConfig(),
+                    time_controller_.GetTaskQueueFactory()) {}
+
+  NetworkControlUpdate OnStreamsConfig() {
+    StreamsConfig msg;
+    msg.at_time = time_controller_.GetClock()->CurrentTime();
+    return controller_.OnStreamsConfig(msg);
+  }
+
+  NetworkControlUpdate OnNetworkAvailability(bool network_available) {
+    NetworkAvailability msg;
+    msg.at_time = time_controller_.GetClock()->CurrentTime();
+    msg.network_available = network_available;
+    return controller_.OnNetworkAvailability(msg);
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  SenderSideNetworkController controller_;
+};
+
+TEST_F(SenderSideNetworkControllerTest, ReportsStartingRateUntilFirstEstimate) {
+  NetworkControlUpdate update = OnStreamsConfig();
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, kStartRate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(update.pacer_config->data_rate(), kStartRate * 2.5);
+}
+
+TEST_F(SenderSideNetworkControllerTest, EstimatesFromTransportFeedback) {
+  // 1000 byte packets every 10 ms received at 800 kbps.
+  absl::optional<DataRate> estimate;
+  for (int i = 0; i < 500 && !estimate; ++i) {
+    Timestamp now = time_controller_.GetClock()->CurrentTime();
+    TransportPacketsFeedback feedback;
+    feedback.feedback_time = now;
+    PacketResult result;
+    result.sent_packet.sequence_number = i;
+    result.sent_packet.send_time = now - TimeDelta::Millis(50);
+    result.sent_packet.size = DataSize::Bytes(1000);
+    result.receive_time = now - TimeDelta::Millis(30);
+    feedback.packet_feedbacks.push_back(result);
+    NetworkControlUpdate update =
+        controller_.OnTransportPacketsFeedback(feedback);
+    // The first update reports the starting rate.
+    if (update.target_rate && update.target_rate->target_rate != kStartRate)
+      estimate = update.target_rate->target_rate;
+    time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  }
+  ASSERT_TRUE(estimate);
+  EXPECT_GT(*estimate, DataRate::Zero());
+}
+
+TEST_F(SenderSideNetworkControllerTest, ClampsTheEstimateToTheConstraints) {
+  TargetRateConstraints constraints;
+  constraints.at_time = time_controller_.GetClock()->CurrentTime();
+  constraints.max_data_rate = DataRate::KilobitsPerSec(200);
+  NetworkControlUpdate update =
+      controller_.OnTargetRateConstraints(constraints);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(200));
+  EXPECT_EQ(update.target_rate->network_estimate.bandwidth, kStartRate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(update.pacer_config->data_rate(),
+            DataRate::KilobitsPerSec(200) * 2.5);
+
+  constraints.min_data_rate = DataRate::KilobitsPerSec(400);
+  constraints.max_data_rate.reset();
+  update = controller_.OnTargetRateConstraints(constraints);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(400));
+
+  // Later updates keep the constraints.
+  update = OnStreamsConfig();
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(400));
+}
+
+TEST_F(SenderSideNetworkControllerTest, ReportsTheEstimateIntervalAsBwePeriod) {
+  NetworkControlUpdate update = OnStreamsConfig();
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->network_estimate.bwe_period,
+            TimeDelta::Millis(kEstimateIntervalMs));
+}
+
+TEST_F(SenderSideNetworkControllerTest,
+       ReportsNothingWhileTheNetworkIsUnavailable) {
+  EXPECT_FALSE(OnNetworkAvailability(false).target_rate);
+  EXPECT_FALSE(OnStreamsConfig().target_rate);
+  ProcessInterval msg;
+  msg.at_time = time_controller_.GetClock()->CurrentTime();
+  EXPECT_FALSE(controller_.OnProcessInterval(msg).target_rate);
+
+  // The latest estimate is reported again once the network is back.
+  NetworkControlUpdate update = OnNetworkAvailability(true);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, kStartRate);
+  EXPECT_FALSE(OnNetworkAvailability(true).target_rate);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/alpha_cc/shadow_gcc_network_control.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ShadowGccNetworkController::ShadowGccNetworkController(
+    NetworkControllerConfig config,
+    std::unique_ptr<NetworkControllerInterface> model_controller)
+    : model_controller_(std::move(model_controller)),
+      gcc_estimator_(config.key_value_config ? config.key_value_config
+                                             : &trial_based_config_,
+                     config.event_log,
+                     config.constraints) {
+  RTC_DCHECK(model_controller_);
+}
+
+ShadowGccNetworkController::~ShadowGccNetworkController() = default;
+
+NetworkControlUpdate ShadowGccNetworkController::OnNetworkAvailability(
+    NetworkAvailability msg) {
+  return model_controller_->OnNetworkAvailability(msg);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnNetworkRouteChange(
+    NetworkRouteChange msg) {
+  gcc_estimator_.OnNetworkRouteChange();
+  return WithShadowTarget(model_controller_->OnNetworkRouteChange(msg));
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnProcessInterval(
+    ProcessInterval msg) {
+  gcc_estimator_.OnProcessInterval(msg);
+  return WithShadowTarget(model_controller_->OnProcessInterval(msg));
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnRemoteBitrateReport(
+    RemoteBitrateReport msg) {
+  gcc_estimator_.OnRemoteBitrateReport(msg);
+  return model_controller_->OnRemoteBitrateReport(msg);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnRoundTripTimeUpdate(
+    RoundTripTimeUpdate msg) {
+  gcc_estimator_.OnRoundTripTimeUpdate(msg);
+  return model_controller_->OnRoundTripTimeUpdate(msg);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnSentPacket(
+    SentPacket sent_packet) {
+  gcc_estimator_.OnSentPacket(sent_packet);
+  return model_controller_->OnSentPacket(sent_packet);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnReceivedPacket(
+    ReceivedPacket received_packet) {
+  return model_controller_->OnReceivedPacket(received_packet);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnStreamsConfig(
+    StreamsConfig msg) {
+  return model_controller_->OnStreamsConfig(msg);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnTargetRateConstraints(
+    TargetRateConstraints constraints) {
+  gcc_estimator_.OnTargetRateConstraints(constraints);
+  return model_controller_->OnTargetRateConstraints(constraints);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnTransportLossReport(
+    TransportLossReport msg) {
+  gcc_estimator_.OnTransportLossReport(msg);
+  return model_controller_->OnTransportLossReport(msg);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnTransportPacketsFeedback(
+    TransportPacketsFeedback report) {
+  gcc_estimator_.OnTransportPacketsFeedback(report);
+  return WithShadowTarget(
+      model_controller_->OnTransportPacketsFeedback(report));
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnNetworkStateEstimate(
+    NetworkStateEstimate msg) {
+  return model_controller_->OnNetworkStateEstimate(msg);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::OnReceiveBwe(BweMessage bwe) {
+  return model_controller_->OnReceiveBwe(bwe);
+}
+
+NetworkControlUpdate ShadowGccNetworkController::WithShadowTarget(
+    NetworkControlUpdate update) {
+  DataRate target = gcc_estimator_.target_rate();
+  if (last_shadow_target_ != target) {
+    last_shadow_target_ = target;
+    update.shadow_target_rate = target;
+  }
+  return update;
+}
+
+}  // namespace webrtc
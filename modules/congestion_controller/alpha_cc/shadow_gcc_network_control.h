@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_ALPHA_CC_SHADOW_GCC_NETWORK_CONTROL_H_
+#define MODULES_CONGESTION_CONTROLLER_ALPHA_CC_SHADOW_GCC_NETWORK_CONTROL_H_
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/transport/field_trial_based_config.h"
+#include "api/transport/network_control.h"
+#include "api/units/data_rate.h"
+#include "modules/congestion_controller/alpha_cc/gcc_estimator.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// Runs the GCC delay and loss based estimators in the shadow of the AlphaCC
+// controller, to compare online what GCC would have done with the same
+// traffic. The updates of the AlphaCC controller are returned as they are,
+// the GCC target only rides along in NetworkControlUpdate::shadow_target_rate
+// when it changes. The GCC estimators log their estimates to the event log
+// of the call, next to the logged AlphaCC estimates.
+class ShadowGccNetworkController : public NetworkControllerInterface {
+ public:
+  ShadowGccNetworkController(
+      NetworkControllerConfig config,
+      std::unique_ptr<NetworkControllerInterface> model_controller);
+  ~ShadowGccNetworkController() override;
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override;
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override;
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override;
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override;
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override;
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override;
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override;
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override;
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override;
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override;
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override;
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override;
+  NetworkControlUpdate OnReceiveBwe(BweMessage msg) override;
+
+ private:
+  // Adds the GCC target to |update| if it changed.
+  NetworkControlUpdate WithShadowTarget(NetworkControlUpdate update);
+
+  const FieldTrialBasedConfig trial_based_config_;
+  const std::unique_ptr<NetworkControllerInterface> model_controller_;
+  GccEstimator gcc_estimator_;
+  absl::optional<DataRate> last_shadow_target_;
+
+  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(ShadowGccNetworkController);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_ALPHA_CC_SHADOW_GCC_NETWORK_CONTROL_H_
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/alpha_cc/shadow_gcc_network_control.h"
+
+#include <memory>
+#include <utility>
+
+#include "logging/rtc_event_log/mock/mock_rtc_event_log.h"
+#include "modules/congestion_controller/alpha_cc/test/mock_network_controller.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr DataRate kStartRate = DataRate::KilobitsPerSec(300);
+
+class ShadowGccNetworkControllerTest : public ::testing::Test {
+ protected:
+  ShadowGccNetworkControllerTest() {
+    NetworkControllerConfig config;
+    config.constraints.at_time = Timestamp::Seconds(1);
+    config.constraints.starting_rate = kStartRate;
+    config.event_log = &event_log_;
+    auto model_controller = std::make_unique<NiceMock<MockNetworkController>>();
+    model_controller_ = model_controller.get();
+    controller_ = std::make_unique<ShadowGccNetworkController>(
+        config, std::move(model_controller));
+  }
+
+  NiceMock<MockRtcEventLog> event_log_;
+  NiceMock<MockNetworkController>* model_controller_;
+  std::unique_ptr<ShadowGccNetworkController> controller_;
+};
+
+TEST_F(ShadowGccNetworkControllerTest, ReturnsModelUpdateWithShadowTarget) {
+  NetworkControlUpdate model_update;
+  model_update.target_rate = TargetTransferRate();
+  model_update.target_rate->target_rate = DataRate::KilobitsPerSec(800);
+  model_update.congestion_window = DataSize::Bytes(10000);
+  EXPECT_CALL(*model_controller_, OnProcessInterval)
+      .WillRepeatedly(Return(model_update));
+
+  ProcessInterval msg;
+  msg.at_time = Timestamp::Seconds(1);
+  NetworkControlUpdate update = controller_->OnProcessInterval(msg);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(800));
+  EXPECT_EQ(update.congestion_window, DataSize::Bytes(10000));
+  EXPECT_EQ(update.shadow_target_rate, kStartRate);
+
+  // The shadow target only rides along when it changes.
+  msg.at_time += TimeDelta::Millis(25);
+  update = controller_->OnProcessInterval(msg);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_FALSE(update.shadow_target_rate);
+}
+
+TEST_F(ShadowGccNetworkControllerTest, ForwardsModelBweUpdate) {
+  NetworkControlUpdate model_update;
+  model_update.target_rate = TargetTransferRate();
+  model_update.target_rate->target_rate = DataRate::KilobitsPerSec(600);
+  model_update.probe_cluster_configs.emplace_back();
+  EXPECT_CALL(*model_controller_, OnReceiveBwe).WillOnce(Return(model_update));
+
+  NetworkControlUpdate update = controller_->OnReceiveBwe(BweMessage());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(600));
+  EXPECT_EQ(update.probe_cluster_configs.size(), 1u);
+  EXPECT_FALSE(update.shadow_target_rate);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_ALPHA_CC_TEST_MOCK_NETWORK_CONTROLLER_H_
+#define MODULES_CONGESTION_CONTROLLER_ALPHA_CC_TEST_MOCK_NETWORK_CONTROLLER_H_
+
+#include "api/transport/network_control.h"
+#include "test/gmock.h"
+
+namespace webrtc {
+namespace test {
+
+class MockNetworkController : public NetworkControllerInterface {
+ public:
+  MOCK_METHOD(NetworkControlUpdate,
+              OnNetworkAvailability,
+              (NetworkAvailability),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnNetworkRouteChange,
+              (NetworkRouteChange),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnProcessInterval,
+              (ProcessInterval),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnRemoteBitrateReport,
+              (RemoteBitrateReport),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnRoundTripTimeUpdate,
+              (RoundTripTimeUpdate),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate, OnSentPacket, (SentPacket), (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnReceivedPacket,
+              (ReceivedPacket),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnStreamsConfig,
+              (StreamsConfig),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnTargetRateConstraints,
+              (TargetRateConstraints),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnTransportLossReport,
+              (TransportLossReport),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnTransportPacketsFeedback,
+              (TransportPacketsFeedback),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate,
+              OnNetworkStateEstimate,
+              (NetworkStateEstimate),
+              (override));
+  MOCK_METHOD(NetworkControlUpdate, OnReceiveBwe, (BweMessage), (override));
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_ALPHA_CC_TEST_MOCK_NETWORK_CONTROLLER_H_
@@ -0,0 +1,396 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "api/alphacc_config.h"
+#include "api/transport/alpha_cc_factory.h"
+#include "call/simulated_network.h"
+#include "modules/congestion_controller/pcc/pcc_factory.h"
+#include "rtc_base/random.h"
+#include "test/field_trial.h"
+#include "test/gtest.h"
+#include "test/network/trace_network_behavior.h"
+#include "test/scenario/scenario.h"
+#include "test/testsupport/file_utils.h"
+#include "test/testsupport/perf_test.h"
+
+ABSL_FLAG(std::string,
+          cc_benchmark_alpha_cc_config,
+          "",
+          "AlphaCC configuration file of the alpha_cc and gcc controllers, "
+          "e.g. to run the ONNX model. By default the sender runs the "
+          "receive rate estimator, so that no model is needed.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr TimeDelta kStatsInterval = TimeDelta::Millis(100);
+constexpr TimeDelta kPropagationDelay = TimeDelta::Millis(40);
+constexpr int kQueueLengthPackets = 100;
+// The target rate has converged once it stays in this share of the capacity
+// available to the call.
+constexpr double kConvergedLowShare = 0.6;
+constexpr double kConvergedHighShare = 1.1;
+// GCC takes over from the model on any difference, so the hybrid controller
+// runs GCC's delay and loss based estimators alone.
+constexpr char kGccOnlyFieldTrial[] =
+    "WebRTC-Bwe-AlphaCcHybrid/factor:1,div_time:0ms/";
+
+enum class Controller { kAlphaCc, kGcc, kPcc };
+
+std::string ControllerName(Controller controller) {
+  switch (controller) {
+    case Controller::kAlphaCc:
+      return "alpha_cc";
+    case Controller::kGcc:
+      return "gcc";
+    case Controller::kPcc:
+      return "pcc";
+  }
+}
+
+// Delay and loss of the packets of all flows crossing the bottleneck link.
+struct BottleneckStats {
+  SampleStats<TimeDelta> delay;
+  int lost_packets = 0;
+  int delivered_packets = 0;
+  DataSize delivered = DataSize::Zero();
+};
+
+// Runs |link| and records what happens to its packets in |stats|.
+class MeasuredLink : public NetworkBehaviorInterface {
+ public:
+  MeasuredLink(std::unique_ptr<NetworkBehaviorInterface> link,
+               BottleneckStats* stats)
+      : link_(std::move(link)), stats_(stats) {}
+
+  bool EnqueuePacket(PacketInFlightInfo packet) override {
+    if (!link_->EnqueuePacket(packet)) {
+      ++stats_->lost_packets;
+      return false;
+    }
+    in_flight_.emplace(packet.packet_id, packet);
+    return true;
+  }
+
+  std::vector<PacketDeliveryInfo> DequeueDeliverablePackets(
+      int64_t receive_time_us) override {
+    std::vector<PacketDeliveryInfo> delivered =
+        link_->DequeueDeliverablePackets(receive_time_us);
+    for (const PacketDeliveryInfo& info : delivered) {
+      auto it = in_flight_.find(info.packet_id);
+      RTC_CHECK(it != in_flight_.end());
+      if (info.receive_time_us == PacketDeliveryInfo::kNotReceived) {
+        ++stats_->lost_packets;
+      } else {
+        ++stats_->delivered_packets;
+        stats_->delivered += DataSize::Bytes(it->second.size);
+        stats_->delay.AddSample(
+            TimeDelta::Micros(info.receive_time_us - it->second.send_time_us));
+      }
+      in_flight_.erase(it);
+    }
+    return delivered;
+  }
+
+  absl::optional<int64_t> NextDeliveryTimeUs() const override {
+    return link_->NextDeliveryTimeUs();
+  }
+
+ private:
+  const std::unique_ptr<NetworkBehaviorInterface> link_;
+  BottleneckStats* const stats_;
+  std::map<uint64_t, PacketInFlightInfo> in_flight_;
+};
+
+// Part of a link profile during which the capacity available to the call does
+// not change.
+struct Phase {
+  TimeDelta duration = TimeDelta::Zero();
+  // Capacity of the bottleneck link, zero if it follows a trace.
+  DataRate link_capacity = DataRate::Zero();
+  // Fair share of the call, used for the convergence time. Zero if there is
+  // no expected share.
+  DataRate call_share = DataRate::Zero();
+  bool start_tcp_cross_traffic = false;
+};
+
+// Bounds guarding against regressions of any controller, loose enough for
+// all of them.
+struct Thresholds {
+  double min_utilization = 0;
+  TimeDelta max_queueing_delay_p95 = TimeDelta::PlusInfinity();
+  double max_loss_ratio = 1;
+  TimeDelta max_convergence_time = TimeDelta::PlusInfinity();
+};
+
+struct LinkProfile {
+  std::string name;
+  std::vector<Phase> phases;
+  // If not empty, the bottleneck link follows this Mahimahi trace.
+  std::string trace_path;
+  DataSize trace_capacity = DataSize::Zero();
+  Thresholds thresholds;
+};
+
+// Writes a Mahimahi trace of a cellular-like link, whose capacity does a
+// random walk between 0.5 and 4 Mbps with a new rate every 500 ms. Returns
+// the capacity of the trace.
+DataSize WriteCellularTrace(const std::string& path, TimeDelta duration) {
+  constexpr int kBytesPerOpportunity = 1504;
+  Random random(/*seed=*/12345);
+  std::ofstream trace(path, std::ios::trunc);
+  double rate_bps = 2e6;
+  double pending_bytes = 0;
+  int64_t opportunities = 0;
+  for (int64_t ms = 0; ms < duration.ms(); ++ms) {
+    if (ms % 500 == 0) {
+      rate_bps *= 1 + random.Gaussian(0, 0.3);
+      rate_bps = std::min(std::max(rate_bps, 0.5e6), 4e6);
+    }
+    pending_bytes += rate_bps / 8 / 1000;
+    for (; pending_bytes >= kBytesPerOpportunity;
+         pending_bytes -= kBytesPerOpportunity) {
+      trace << ms << "\n";
+      ++opportunities;
+    }
+  }
+  RTC_CHECK(trace.good()) << "Failed to write " << path;
+  return DataSize::Bytes(opportunities * kBytesPerOpportunity);
+}
+
+SimulatedNetwork::Config LinkConfig(DataRate capacity) {
+  SimulatedNetwork::Config config;
+  config.link_capacity_kbps = capacity.kbps();
+  config.queue_delay_ms = kPropagationDelay.ms();
+  config.queue_length_packets = kQueueLengthPackets;
+  return config;
+}
+
+// Returns how long after the start of each phase with an expected call share
+// the target rate took to stay in the converged range, or the whole phase if
+// it never did.
+SampleStats<TimeDelta> ConvergenceTimes(
+    const std::vector<Phase>& phases,
+    const std::vector<std::pair<TimeDelta, DataRate>>& targets) {
+  SampleStats<TimeDelta> convergence_times;
+  TimeDelta phase_start = TimeDelta::Zero();
+  for (const Phase& phase : phases) {
+    TimeDelta phase_end = phase_start + phase.duration;
+    if (!phase.call_share.IsZero()) {
+      TimeDelta converged = phase_start;
+      for (const auto& target : targets) {
+        if (target.first < phase_start || target.first >= phase_end)
+          continue;
+        if (target.second < phase.call_share * kConvergedLowShare ||
+            target.second > phase.call_share * kConvergedHighShare) {
+          converged = target.first + kStatsInterval;
+        }
+      }
+      convergence_times.AddSample(std::min(converged, phase_end) - phase_start);
+    }
+    phase_start = phase_end;
+  }
+  return convergence_times;
+}
+
+void RunProfile(const LinkProfile& profile, Controller controller) {
+  AlphaCCConfig alpha_cc_config;
+  const std::string config_path =
+      absl::GetFlag(FLAGS_cc_benchmark_alpha_cc_config);
+  if (config_path.empty()) {
+    alpha_cc_config.bwe_location = AlphaCCConfig::BweLocation::kSender;
+    alpha_cc_config.bwe_estimator_option =
+        AlphaCCConfig::BweEstimatorOption::kReceiveRate;
+  } else {
+    RTC_CHECK(ParseAlphaCCConfig(config_path, &alpha_cc_config))
+        << "Failed to parse " << config_path;
+  }
+  std::unique_ptr<ScopedFieldTrials> field_trials;
+  if (controller == Controller::kGcc) {
+    alpha_cc_config.bwe_controller_option =
+        AlphaCCConfig::BweControllerOption::kHybrid;
+    field_trials = std::make_unique<ScopedFieldTrials>(kGccOnlyFieldTrial);
+  }
+  ScopedAlphaCCConfig scoped_alpha_cc_config(&alpha_cc_config);
+  std::unique_ptr<NetworkControllerFactoryInterface> cc_factory;
+  if (controller == Controller::kPcc) {
+    cc_factory = std::make_unique<PccNetworkControllerFactory>();
+  } else {
+    GoogCcFactoryConfig factory_config;
+    factory_config.alpha_cc_config = &alpha_cc_config;
+    cc_factory = std::make_unique<GoogCcNetworkControllerFactory>(
+        std::move(factory_config));
+  }
+
+  BottleneckStats bottleneck_stats;
+  std::vector<std::pair<TimeDelta, DataRate>> targets;
+  {
+    Scenario s;
+    SimulatedNetwork* simulated_link = nullptr;
+    std::unique_ptr<NetworkBehaviorInterface> link;
+    if (!profile.trace_path.empty()) {
+      TraceNetworkBehavior::Config trace_config;
+      trace_config.trace_path = profile.trace_path;
+      trace_config.delay_ms = kPropagationDelay.ms();
+      trace_config.queue_length_packets = kQueueLengthPackets;
+      link = TraceNetworkBehavior::Create(trace_config);
+      RTC_CHECK(link);
+    } else {
+      auto simulated = std::make_unique<SimulatedNetwork>(
+          LinkConfig(profile.phases.front().link_capacity));
+      simulated_link = simulated.get();
+      link = std::move(simulated);
+    }
+    EmulatedNetworkNode* bottleneck = s.net()->CreateEmulatedNode(
+        std::make_unique<MeasuredLink>(std::move(link), &bottleneck_stats));
+    NetworkSimulationConfig return_config;
+    return_config.delay = kPropagationDelay;
+    EmulatedNetworkNode* return_link = s.CreateSimulationNode(return_config);
+
+    CallClientConfig client_config;
+    client_config.transport.cc_factory = cc_factory.get();
+    CallClient* caller = s.CreateClient("caller", client_config);
+    CallClient* callee = s.CreateClient("callee", CallClientConfig());
+    auto* route = s.CreateRoutes(caller, {bottleneck}, callee, {return_link});
+    s.CreateVideoStream(route->forward(), [](VideoStreamConfig* c) {
+      c->source.generator.width = 1280;
+      c->source.generator.height = 720;
+      c->encoder.codec = VideoStreamConfig::Encoder::Codec::kVideoCodecVP8;
+      c->encoder.implementation =
+          VideoStreamConfig::Encoder::Implementation::kSoftware;
+    });
+    s.Every(kStatsInterval, [&](TimeDelta since_start) {
+      targets.emplace_back(
+          since_start,
+          DataRate::BitsPerSec(caller->GetStats().send_bandwidth_bps));
+    });
+
+    for (const Phase& phase : profile.phases) {
+      if (simulated_link)
+        simulated_link->SetConfig(LinkConfig(phase.link_capacity));
+      if (phase.start_tcp_cross_traffic) {
+        s.net()->StartFakeTcpCrossTraffic({bottleneck}, {return_link},
+                                          FakeTcpConfig());
+      }
+      s.RunFor(phase.duration);
+    }
+  }
+
+  TimeDelta run_time = TimeDelta::Zero();
+  DataSize capacity = profile.trace_capacity;
+  for (const Phase& phase : profile.phases) {
+    run_time += phase.duration;
+    capacity += phase.link_capacity * phase.duration;
+  }
+  const std::string test_case =
+      ControllerName(controller) + "_" + profile.name;
+  const Thresholds& thresholds = profile.thresholds;
+
+  double utilization = bottleneck_stats.delivered / capacity;
+  PrintResult("utilization", "", test_case, utilization, "unitless", true,
+              ImproveDirection::kBiggerIsBetter);
+  EXPECT_GE(utilization, thresholds.min_utilization) << test_case;
+
+  // The fastest packet only saw the propagation delay.
+  SampleStats<TimeDelta>& delay = bottleneck_stats.delay;
+  ASSERT_FALSE(delay.IsEmpty()) << test_case;
+  TimeDelta queueing_p50 = delay.Quantile(0.5) - delay.Min();
+  TimeDelta queueing_p95 = delay.Quantile(0.95) - delay.Min();
+  PrintResult("queueing_delay_p50", "", test_case, queueing_p50.ms<double>(),
+              "ms", false, ImproveDirection::kSmallerIsBetter);
+  PrintResult("queueing_delay_p95", "", test_case, queueing_p95.ms<double>(),
+              "ms", true, ImproveDirection::kSmallerIsBetter);
+  EXPECT_LE(queueing_p95, thresholds.max_queueing_delay_p95) << test_case;
+
+  double loss_ratio =
+      static_cast<double>(bottleneck_stats.lost_packets) /
+      (bottleneck_stats.lost_packets + bottleneck_stats.delivered_packets);
+  PrintResult("loss", "", test_case, loss_ratio, "unitless", true,
+              ImproveDirection::kSmallerIsBetter);
+  EXPECT_LE(loss_ratio, thresholds.max_loss_ratio) << test_case;
+
+  SampleStats<TimeDelta> convergence_times =
+      ConvergenceTimes(profile.phases, targets);
+  if (!convergence_times.IsEmpty()) {
+    PrintResult("convergence_time", "", test_case,
+                convergence_times.Mean().ms<double>(), "ms", true,
+                ImproveDirection::kSmallerIsBetter);
+    EXPECT_LE(convergence_times.Max(), thresholds.max_convergence_time)
+        << test_case;
+  }
+}
+
+void RunControllers(const LinkProfile& profile) {
+  for (Controller controller :
+       {Controller::kAlphaCc, Controller::kGcc, Controller::kPcc}) {
+    RunProfile(profile, controller);
+  }
+}
+
+}  // namespace
+
+TEST(CongestionControlBenchmark, StepChanges) {
+  LinkProfile profile;
+  profile.name = "step_changes";
+  profile.phases = {
+      {TimeDelta::Seconds(20), DataRate::KilobitsPerSec(2500),
+       DataRate::KilobitsPerSec(2500)},
+      {TimeDelta::Seconds(20), DataRate::KilobitsPerSec(800),
+       DataRate::KilobitsPerSec(800)},
+      {TimeDelta::Seconds(20), DataRate::KilobitsPerSec(2500),
+       DataRate::KilobitsPerSec(2500)},
+  };
+  profile.thresholds = {0.4, TimeDelta::Millis(500), 0.05,
+                        TimeDelta::Seconds(15)};
+  RunControllers(profile);
+}
+
+TEST(CongestionControlBenchmark, CellularTrace) {
+  constexpr TimeDelta kRunTime = TimeDelta::Seconds(60);
+  LinkProfile profile;
+  profile.name = "cellular_trace";
+  profile.phases = {{kRunTime, DataRate::Zero(), DataRate::Zero()}};
+  profile.trace_path = TempFilename(OutputPath(), "cellular_trace");
+  profile.trace_capacity = WriteCellularTrace(profile.trace_path, kRunTime);
+  profile.thresholds = {0.3, TimeDelta::Millis(1000), 0.1,
+                        TimeDelta::PlusInfinity()};
+  RunControllers(profile);
+  remove(profile.trace_path.c_str());
+}
+
+TEST(CongestionControlBenchmark, TcpCrossTraffic) {
+  LinkProfile profile;
+  profile.name = "tcp_cross_traffic";
+  // The call should leave the TCP flow half of the link.
+  profile.phases = {
+      {TimeDelta::Seconds(15), DataRate::KilobitsPerSec(2000),
+       DataRate::KilobitsPerSec(2000)},
+      {TimeDelta::Seconds(45), DataRate::KilobitsPerSec(2000),
+       DataRate::KilobitsPerSec(1000), /*start_tcp_cross_traffic=*/true},
+  };
+  profile.thresholds = {0.5, TimeDelta::Millis(1000), 0.2,
+                        TimeDelta::Seconds(20)};
+  RunControllers(profile);
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -14,12 +14,20 @@
 #include <memory>
 #include <vector>
 
+#include "api/alphacc_config.h"
+#include "api/array_view.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/transport/field_trial_based_config.h"
 #include "api/transport/network_control.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "modules/include/module.h"
 #include "modules/remote_bitrate_estimator/remote_estimator_proxy.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 class RemoteBitrateEstimator;
@@ -38,8 +46,29 @@ class ReceiveSideCongestionController : public CallStatsObserver,
       Clock* clock,
       PacketRouter* packet_router,
       NetworkStateEstimator* network_state_estimator);
-
-  ~ReceiveSideCongestionController() override {}
+  // |task_queue_factory| runs the AlphaCC receive side estimator, null means
+  // the default factory. The AlphaCC estimates sent are logged to |event_log|
+  // unless it is null. |alpha_cc_config| must outlive the controller, null
+  // means GetAlphaCCConfig().
+  ReceiveSideCongestionController(
+      Clock* clock,
+      PacketRouter* packet_router,
+      NetworkStateEstimator* network_state_estimator,
+      TaskQueueFactory* task_queue_factory,
+      RtcEventLog* event_log,
+      const AlphaCCConfig* alpha_cc_config);
+
+  ~ReceiveSideCongestionController() override;
+
+  // Moves the packet handling and the periodic processing onto a task queue
+  // created by |task_queue_factory|. Packets given to OnReceivedPacket() are
+  // then queued and handed to the estimators in batches, one per wakeup of
+  // the task queue, and neither this nor GetRemoteBitrateEstimator(true) may
+  // be registered as a Module anymore. Must be called before the first packet.
+  void StartProcessing(TaskQueueFactory* task_queue_factory);
+  // Stops the task queue, dropping the packets that are still queued. Called
+  // before the objects given to the constructor go away.
+  void StopProcessing();
 
   virtual void OnReceivedPacket(int64_t arrival_time_ms,
                                 size_t payload_size,
@@ -50,6 +79,14 @@ class ReceiveSideCongestionController : public CallStatsObserver,
   virtual RemoteBitrateEstimator* GetRemoteBitrateEstimator(bool send_side_bwe);
   virtual const RemoteBitrateEstimator* GetRemoteBitrateEstimator(
       bool send_side_bwe) const;
+  // Stats of the AlphaCC receive side estimator, unset if it does not run.
+  absl::optional<ReceiveSideEstimatorWorker::Stats> GetEstimatorStats() const;
+  // |observer| is told the queueing delay trend of the send side BWE packets
+  // whenever transport feedback is processed. Null stops the estimation.
+  void SetQueueingDelayTrendObserver(QueueingDelayTrendObserver* observer);
+  // Sampled frame statistics of the video receive streams, for the AlphaCC
+  // receive side estimator. Must always be called from the same thread.
+  void OnFrameStats(const ReceivedFrameStats& frame_stats);
 
   // Implements CallStatsObserver.
   void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override;
@@ -71,6 +108,11 @@ class ReceiveSideCongestionController : public CallStatsObserver,
     void IncomingPacket(int64_t arrival_time_ms,
                         size_t payload_size,
                         const RTPHeader& header) override;
+    // Same as calling IncomingPacket() for those of |packets| without a
+    // transport sequence number, which are left to the send side, but only
+    // takes the lock once.
+    void IncomingPackets(
+        rtc::ArrayView<const RemoteEstimatorProxy::IncomingRtpPacket> packets);
 
     void Process() override;
 
@@ -100,9 +142,25 @@ class ReceiveSideCongestionController : public CallStatsObserver,
     RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(WrappingBitrateEstimator);
   };
 
+  void DeliverPendingPackets();
+  // Runs the Process() of the estimators that are due and returns the time
+  // until the next one is.
+  int64_t MaybeProcess();
+
   const FieldTrialBasedConfig field_trial_config_;
   WrappingBitrateEstimator remote_bitrate_estimator_;
   RemoteEstimatorProxy remote_estimator_proxy_;
+
+  rtc::CriticalSection pending_lock_;
+  // Received since the last DeliverPendingPackets() task was posted.
+  std::vector<RemoteEstimatorProxy::IncomingRtpPacket> pending_packets_
+      RTC_GUARDED_BY(pending_lock_);
+  // Swapped with |pending_packets_| so that both keep their capacity.
+  std::vector<RemoteEstimatorProxy::IncomingRtpPacket> delivered_packets_;
+  RepeatingTaskHandle process_task_;
+  // Null unless StartProcessing() was called. Declared last so that no task
+  // runs while the members above are destroyed.
+  std::unique_ptr<rtc::TaskQueue> task_queue_;
 };
 
 }  // namespace webrtc
@@ -10,6 +10,9 @@
 
 #include "modules/congestion_controller/include/receive_side_congestion_controller.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "api/alphacc_config.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/remote_bitrate_estimator/include/bwe_defines.h"
@@ -44,6 +47,18 @@ void ReceiveSideCongestionController::WrappingBitrateEstimator::IncomingPacket(
   rbe_->IncomingPacket(arrival_time_ms, payload_size, header);
 }
 
+void ReceiveSideCongestionController::WrappingBitrateEstimator::IncomingPackets(
+    rtc::ArrayView<const RemoteEstimatorProxy::IncomingRtpPacket> packets) {
+  rtc::CritScope cs(&crit_sect_);
+  for (const RemoteEstimatorProxy::IncomingRtpPacket& packet : packets) {
+    if (packet.header.extension.hasTransportSequenceNumber)
+      continue;
+    PickEstimatorFromHeader(packet.header);
+    rbe_->IncomingPacket(packet.arrival_time_ms, packet.payload_size,
+                         packet.header);
+  }
+}
+
 void ReceiveSideCongestionController::WrappingBitrateEstimator::Process() {
   rtc::CritScope cs(&crit_sect_);
   rbe_->Process();
@@ -128,16 +143,96 @@ ReceiveSideCongestionController::ReceiveSideCongestionController(
     Clock* clock,
     PacketRouter* packet_router,
     NetworkStateEstimator* network_state_estimator)
+    : ReceiveSideCongestionController(clock,
+                                      packet_router,
+                                      network_state_estimator,
+                                      /*task_queue_factory=*/nullptr,
+                                      /*event_log=*/nullptr,
+                                      /*alpha_cc_config=*/nullptr) {}
+
+ReceiveSideCongestionController::ReceiveSideCongestionController(
+    Clock* clock,
+    PacketRouter* packet_router,
+    NetworkStateEstimator* network_state_estimator,
+    TaskQueueFactory* task_queue_factory,
+    RtcEventLog* event_log,
+    const AlphaCCConfig* alpha_cc_config)
     : remote_bitrate_estimator_(packet_router, clock),
       remote_estimator_proxy_(clock,
                               packet_router,
                               &field_trial_config_,
-                              network_state_estimator) {}
+                              network_state_estimator,
+                              task_queue_factory,
+                              event_log,
+                              alpha_cc_config) {}
+
+ReceiveSideCongestionController::~ReceiveSideCongestionController() = default;
+
+void ReceiveSideCongestionController::StartProcessing(
+    TaskQueueFactory* task_queue_factory) {
+  RTC_DCHECK(!task_queue_);
+  task_queue_ = std::make_unique<rtc::TaskQueue>(
+      task_queue_factory->CreateTaskQueue(
+          "receive_side_cc", TaskQueueFactory::Priority::NORMAL));
+  task_queue_->PostTask([this] {
+    RTC_DCHECK_RUN_ON(task_queue_.get());
+    process_task_ = RepeatingTaskHandle::Start(task_queue_->Get(), [this] {
+      RTC_DCHECK_RUN_ON(task_queue_.get());
+      return TimeDelta::Millis(MaybeProcess());
+    });
+  });
+}
+
+void ReceiveSideCongestionController::StopProcessing() {
+  // Waits for a running task, the others are dropped with the queue.
+  task_queue_.reset();
+}
+
+void ReceiveSideCongestionController::DeliverPendingPackets() {
+  RTC_DCHECK_RUN_ON(task_queue_.get());
+  {
+    rtc::CritScope cs(&pending_lock_);
+    std::swap(pending_packets_, delivered_packets_);
+  }
+  remote_estimator_proxy_.IncomingPackets(delivered_packets_);
+  remote_bitrate_estimator_.IncomingPackets(delivered_packets_);
+  delivered_packets_.clear();
+}
+
+int64_t ReceiveSideCongestionController::MaybeProcess() {
+  int64_t time_until_feedback_ms =
+      remote_estimator_proxy_.TimeUntilNextProcess();
+  if (time_until_feedback_ms <= 0) {
+    remote_estimator_proxy_.Process();
+    time_until_feedback_ms = remote_estimator_proxy_.TimeUntilNextProcess();
+  }
+  int64_t time_until_remb_ms = remote_bitrate_estimator_.TimeUntilNextProcess();
+  if (time_until_remb_ms <= 0) {
+    remote_bitrate_estimator_.Process();
+    time_until_remb_ms = remote_bitrate_estimator_.TimeUntilNextProcess();
+  }
+  // Never spin, even if an estimator keeps asking to be processed right away.
+  return std::max<int64_t>(
+      std::min(time_until_feedback_ms, time_until_remb_ms), 1);
+}
 
 void ReceiveSideCongestionController::OnReceivedPacket(
     int64_t arrival_time_ms,
     size_t payload_size,
     const RTPHeader& header) {
+  if (task_queue_) {
+    bool post_task;
+    {
+      rtc::CritScope cs(&pending_lock_);
+      // A task is already posted for the packets before this one.
+      post_task = pending_packets_.empty();
+      pending_packets_.push_back({arrival_time_ms, payload_size, header});
+    }
+    if (post_task) {
+      task_queue_->PostTask([this] { DeliverPendingPackets(); });
+    }
+    return;
+  }
   remote_estimator_proxy_.IncomingPacket(arrival_time_ms, payload_size, header);
   if (!header.extension.hasTransportSequenceNumber) {
     // Receive-side BWE.
@@ -170,9 +265,25 @@ ReceiveSideCongestionController::GetRemoteBitrateEstimator(
   }
 }
 
+absl::optional<ReceiveSideEstimatorWorker::Stats>
+ReceiveSideCongestionController::GetEstimatorStats() const {
+  return remote_estimator_proxy_.GetEstimatorStats();
+}
+
+void ReceiveSideCongestionController::SetQueueingDelayTrendObserver(
+    QueueingDelayTrendObserver* observer) {
+  remote_estimator_proxy_.SetQueueingDelayTrendObserver(observer);
+}
+
+void ReceiveSideCongestionController::OnFrameStats(
+    const ReceivedFrameStats& frame_stats) {
+  remote_estimator_proxy_.OnFrameStats(frame_stats);
+}
+
 void ReceiveSideCongestionController::OnRttUpdate(int64_t avg_rtt_ms,
                                                   int64_t max_rtt_ms) {
   remote_bitrate_estimator_.OnRttUpdate(avg_rtt_ms, max_rtt_ms);
+  remote_estimator_proxy_.OnRttUpdate(avg_rtt_ms, max_rtt_ms);
 }
 
 void ReceiveSideCongestionController::OnBitrateChanged(int bitrate_bps) {
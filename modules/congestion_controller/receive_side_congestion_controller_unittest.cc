@@ -10,7 +10,9 @@
 
 #include "modules/congestion_controller/include/receive_side_congestion_controller.h"
 
+#include "api/task_queue/default_task_queue_factory.h"
 #include "modules/pacing/packet_router.h"
+#include "rtc_base/event.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -18,6 +20,7 @@
 
 using ::testing::_;
 using ::testing::AtLeast;
+using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::SaveArg;
@@ -73,6 +76,44 @@ TEST(ReceiveSideCongestionControllerTest, OnReceivedPacketWithAbsSendTime) {
   EXPECT_EQ(header.ssrc, ssrcs[0]);
 }
 
+TEST(ReceiveSideCongestionControllerTest, HandlesPacketsOnTaskQueue) {
+  StrictMock<MockPacketRouter> packet_router;
+  SimulatedClock clock_(123456);
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+
+  ReceiveSideCongestionController controller(&clock_, &packet_router);
+  controller.StartProcessing(task_queue_factory.get());
+
+  size_t payload_size = 1000;
+  RTPHeader header;
+  header.ssrc = 0x11eb21c;
+  header.extension.hasAbsoluteSendTime = true;
+
+  // The estimate is updated from the task queue, once the queued packets have
+  // been handed over.
+  std::vector<unsigned int> ssrcs;
+  rtc::Event estimate_updated;
+  EXPECT_CALL(packet_router, OnReceiveBitrateChanged(_, _))
+      .WillRepeatedly(Invoke([&](const std::vector<uint32_t>& update_ssrcs,
+                                 uint32_t bitrate) {
+        ssrcs = update_ssrcs;
+        estimate_updated.Set();
+      }));
+
+  for (int i = 0; i < 10; ++i) {
+    clock_.AdvanceTimeMilliseconds((1000 * payload_size) / kInitialBitrateBps);
+    int64_t now_ms = clock_.TimeInMilliseconds();
+    header.extension.absoluteSendTime = AbsSendTime(now_ms, 1000);
+    controller.OnReceivedPacket(now_ms, payload_size, header);
+  }
+
+  ASSERT_TRUE(estimate_updated.Wait(1000));
+  controller.StopProcessing();
+  ASSERT_EQ(1u, ssrcs.size());
+  EXPECT_EQ(header.ssrc, ssrcs[0]);
+}
+
 TEST(ReceiveSideCongestionControllerTest, ConvergesToCapacity) {
   Scenario s("recieve_cc_unit/converge");
   NetworkSimulationConfig net_conf;
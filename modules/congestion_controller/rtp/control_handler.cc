@@ -72,6 +72,10 @@ absl::optional<TargetTransferRate> CongestionControlHandler::GetUpdate() {
       (!new_outgoing.target_rate.IsZero() &&
        (last_reported_->network_estimate.loss_rate_ratio !=
             new_outgoing.network_estimate.loss_rate_ratio ||
+        last_reported_->network_estimate.predicted_loss_rate_ratio !=
+            new_outgoing.network_estimate.predicted_loss_rate_ratio ||
+        last_reported_->network_estimate.predicted_bandwidth_ratio !=
+            new_outgoing.network_estimate.predicted_bandwidth_ratio ||
         last_reported_->network_estimate.round_trip_time !=
             new_outgoing.network_estimate.round_trip_time))) {
     if (encoder_paused_in_last_report_ != pause_encoding)
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/rtp/send_time_history.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+// Smallest ring allocated, grown by doubling up to what the span of stored
+// sequence numbers needs.
+constexpr size_t kMinCapacity = 64;
+}  // namespace
+
+constexpr int64_t SendTimeHistory::kMaxSpan;
+
+SendTimeHistory::SendTimeHistory() = default;
+SendTimeHistory::~SendTimeHistory() = default;
+
+bool SendTimeHistory::Insert(const PacketFeedback& packet) {
+  const int64_t seq = packet.sent.sequence_number;
+  if (empty()) {
+    Reserve(1);
+    begin_sequence_number_ = seq;
+    end_sequence_number_ = seq + 1;
+  } else if (seq >= end_sequence_number_) {
+    if (seq + 1 - begin_sequence_number_ > kMaxSpan)
+      return false;
+    Reserve(seq + 1 - begin_sequence_number_);
+    end_sequence_number_ = seq + 1;
+  } else if (seq < begin_sequence_number_) {
+    if (end_sequence_number_ - seq > kMaxSpan)
+      return false;
+    Reserve(end_sequence_number_ - seq);
+    begin_sequence_number_ = seq;
+  } else if (stored_[Index(seq)]) {
+    return false;
+  }
+  packets_[Index(seq)] = packet;
+  stored_[Index(seq)] = true;
+  return true;
+}
+
+PacketFeedback* SendTimeHistory::Find(int64_t sequence_number) {
+  if (sequence_number < begin_sequence_number_ ||
+      sequence_number >= end_sequence_number_ ||
+      !stored_[Index(sequence_number)]) {
+    return nullptr;
+  }
+  return &packets_[Index(sequence_number)];
+}
+
+void SendTimeHistory::Erase(int64_t sequence_number) {
+  if (!Find(sequence_number))
+    return;
+  if (sequence_number == begin_sequence_number_) {
+    PopFront();
+    return;
+  }
+  stored_[Index(sequence_number)] = false;
+}
+
+void SendTimeHistory::PopFront() {
+  RTC_DCHECK(!empty());
+  stored_[Index(begin_sequence_number_)] = false;
+  ++begin_sequence_number_;
+  while (begin_sequence_number_ < end_sequence_number_ &&
+         !stored_[Index(begin_sequence_number_)]) {
+    ++begin_sequence_number_;
+  }
+}
+
+void SendTimeHistory::Reserve(int64_t span) {
+  RTC_DCHECK_GT(span, 0);
+  RTC_DCHECK_LE(span, kMaxSpan);
+  const size_t capacity = packets_.size();
+  if (static_cast<size_t>(span) <= capacity)
+    return;
+  size_t new_capacity = std::max(capacity, kMinCapacity);
+  while (new_capacity < static_cast<size_t>(span))
+    new_capacity *= 2;
+
+  std::vector<PacketFeedback> packets(new_capacity);
+  std::vector<bool> stored(new_capacity);
+  std::swap(packets_, packets);
+  std::swap(stored_, stored);
+  if (empty())
+    return;
+  // Re-index every stored packet for the new size.
+  for (int64_t seq = begin_sequence_number_; seq < end_sequence_number_;
+       ++seq) {
+    const size_t old_index =
+        static_cast<size_t>(static_cast<uint64_t>(seq) & (capacity - 1));
+    if (stored[old_index]) {
+      packets_[Index(seq)] = std::move(packets[old_index]);
+      stored_[Index(seq)] = true;
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_RTP_SEND_TIME_HISTORY_H_
+#define MODULES_CONGESTION_CONTROLLER_RTP_SEND_TIME_HISTORY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "rtc_base/network_route.h"
+
+namespace webrtc {
+
+struct PacketFeedback {
+  PacketFeedback() = default;
+  // Time corresponding to when this object was created.
+  Timestamp creation_time = Timestamp::MinusInfinity();
+  SentPacket sent;
+  // Time corresponding to when the packet was received. Timestamped with the
+  // receiver's clock. For unreceived packet, Timestamp::PlusInfinity() is
+  // used.
+  Timestamp receive_time = Timestamp::PlusInfinity();
+
+  // The network route that this packet is associated with.
+  rtc::NetworkRoute network_route;
+};
+
+// SendTimeHistory stores the PacketFeedback of sent packets by unwrapped
+// transport sequence number. It replaces a std::map<int64_t, PacketFeedback>
+// for TransportFeedbackAdapter: transport sequence numbers are assigned in
+// order, so the packets are kept in a ring buffer indexed by sequence number
+// and lookups are O(1). Packets can be erased anywhere, the oldest stored
+// packet is always the front.
+class SendTimeHistory {
+ public:
+  // The largest span of sequence numbers that is stored. Feedback carries 16
+  // bit sequence numbers, so older packets couldn't be told apart anyway.
+  static constexpr int64_t kMaxSpan = 1 << 16;
+
+  SendTimeHistory();
+  ~SendTimeHistory();
+
+  bool empty() const { return begin_sequence_number_ == end_sequence_number_; }
+
+  // The oldest stored packet. Undefined if empty().
+  PacketFeedback& front() { return packets_[Index(begin_sequence_number_)]; }
+  int64_t begin_sequence_number() const { return begin_sequence_number_; }
+  // One past the newest sequence number stored since the history was last
+  // empty. Undefined if empty().
+  int64_t end_sequence_number() const { return end_sequence_number_; }
+
+  // Stores |packet| by |packet.sent.sequence_number| unless a packet with that
+  // sequence number is already stored. The caller must have removed packets
+  // so that the span stays within kMaxSpan, packets that would exceed it
+  // behind the newest one are dropped. Returns true if |packet| was stored.
+  bool Insert(const PacketFeedback& packet);
+
+  // Returns the packet with |sequence_number| or null if it isn't stored.
+  PacketFeedback* Find(int64_t sequence_number);
+
+  // Removes the packet with |sequence_number| if it is stored.
+  void Erase(int64_t sequence_number);
+  // Removes the oldest stored packet. Must not be empty().
+  void PopFront();
+
+  // Calls |callback| with every stored packet whose sequence number is in
+  // (|after_sequence_number|, |last_sequence_number|], in order.
+  template <typename Callback>
+  void ForEachInRange(int64_t after_sequence_number,
+                      int64_t last_sequence_number,
+                      Callback callback) {
+    int64_t seq = after_sequence_number < begin_sequence_number_
+                      ? begin_sequence_number_
+                      : after_sequence_number + 1;
+    int64_t end = last_sequence_number < end_sequence_number_
+                      ? last_sequence_number + 1
+                      : end_sequence_number_;
+    for (; seq < end; ++seq) {
+      if (stored_[Index(seq)])
+        callback(packets_[Index(seq)]);
+    }
+  }
+
+ private:
+  size_t Index(int64_t sequence_number) const {
+    return static_cast<size_t>(static_cast<uint64_t>(sequence_number) &
+                               (packets_.size() - 1));
+  }
+  // Makes room for at least |span| consecutive sequence numbers.
+  void Reserve(int64_t span);
+
+  // Indexed by sequence number modulo the size, which is a power of two.
+  std::vector<PacketFeedback> packets_;
+  // Tells which entries of |packets_| are stored. Entries outside
+  // [begin_sequence_number_, end_sequence_number_) are always false.
+  std::vector<bool> stored_;
+  int64_t begin_sequence_number_ = 0;
+  int64_t end_sequence_number_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_RTP_SEND_TIME_HISTORY_H_
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/rtp/send_time_history.h"
+
+#include <map>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+PacketFeedback CreatePacket(int64_t sequence_number, int64_t size_bytes) {
+  PacketFeedback packet;
+  packet.sent.sequence_number = sequence_number;
+  packet.sent.size = DataSize::Bytes(size_bytes);
+  return packet;
+}
+
+std::vector<int64_t> SequenceNumbersInRange(SendTimeHistory* history,
+                                            int64_t after_sequence_number,
+                                            int64_t last_sequence_number) {
+  std::vector<int64_t> sequence_numbers;
+  history->ForEachInRange(after_sequence_number, last_sequence_number,
+                          [&](const PacketFeedback& packet) {
+                            sequence_numbers.push_back(
+                                packet.sent.sequence_number);
+                          });
+  return sequence_numbers;
+}
+
+TEST(SendTimeHistoryTest, IsEmptyInitially) {
+  SendTimeHistory history;
+  EXPECT_TRUE(history.empty());
+  EXPECT_EQ(history.Find(0), nullptr);
+  EXPECT_TRUE(SequenceNumbersInRange(&history, -1, 100).empty());
+}
+
+TEST(SendTimeHistoryTest, FindsInsertedPackets) {
+  SendTimeHistory history;
+  EXPECT_TRUE(history.Insert(CreatePacket(10, 100)));
+  EXPECT_TRUE(history.Insert(CreatePacket(12, 200)));
+  EXPECT_TRUE(history.Insert(CreatePacket(9, 300)));
+  // Like std::map::insert(), an existing packet isn't replaced.
+  EXPECT_FALSE(history.Insert(CreatePacket(12, 400)));
+
+  EXPECT_EQ(history.begin_sequence_number(), 9);
+  EXPECT_EQ(history.end_sequence_number(), 13);
+  ASSERT_NE(history.Find(12), nullptr);
+  EXPECT_EQ(history.Find(12)->sent.size, DataSize::Bytes(200));
+  EXPECT_EQ(history.Find(11), nullptr);
+  EXPECT_EQ(history.Find(13), nullptr);
+  EXPECT_EQ(history.front().sent.size, DataSize::Bytes(300));
+}
+
+TEST(SendTimeHistoryTest, ErasesAnywhere) {
+  SendTimeHistory history;
+  for (int64_t seq = 0; seq < 5; ++seq)
+    history.Insert(CreatePacket(seq, 100));
+  history.Erase(2);
+  EXPECT_EQ(history.Find(2), nullptr);
+  EXPECT_EQ(history.begin_sequence_number(), 0);
+  history.Erase(0);
+  EXPECT_EQ(history.begin_sequence_number(), 1);
+  history.PopFront();
+  // The erased packet is skipped.
+  EXPECT_EQ(history.begin_sequence_number(), 3);
+  history.PopFront();
+  history.PopFront();
+  EXPECT_TRUE(history.empty());
+}
+
+TEST(SendTimeHistoryTest, IteratesOverRange) {
+  SendTimeHistory history;
+  for (int64_t seq : {3, 4, 6, 7, 9})
+    history.Insert(CreatePacket(seq, 100));
+  EXPECT_EQ(SequenceNumbersInRange(&history, -1, 6),
+            (std::vector<int64_t>{3, 4, 6}));
+  EXPECT_EQ(SequenceNumbersInRange(&history, 4, 100),
+            (std::vector<int64_t>{6, 7, 9}));
+  EXPECT_TRUE(SequenceNumbersInRange(&history, 7, 8).empty());
+}
+
+TEST(SendTimeHistoryTest, DropsPacketsBeyondMaxSpan) {
+  SendTimeHistory history;
+  EXPECT_TRUE(history.Insert(CreatePacket(100, 100)));
+  EXPECT_FALSE(
+      history.Insert(CreatePacket(100 + SendTimeHistory::kMaxSpan, 100)));
+  EXPECT_TRUE(
+      history.Insert(CreatePacket(99 + SendTimeHistory::kMaxSpan, 100)));
+  EXPECT_FALSE(history.Insert(CreatePacket(99, 100)));
+  EXPECT_EQ(history.begin_sequence_number(), 100);
+}
+
+TEST(SendTimeHistoryTest, MatchesStdMapWithRandomTraffic) {
+  Random random(0x12345678);
+  std::map<int64_t, PacketFeedback> reference;
+  SendTimeHistory history;
+  int64_t next_seq = 0;
+  for (int i = 0; i < 100000; ++i) {
+    int op = random.Rand(0, 99);
+    if (op < 60) {
+      int64_t seq = next_seq++;
+      if (random.Rand(0, 99) < 5)
+        seq -= random.Rand(1, 20);
+      if (!reference.empty() &&
+          (seq - reference.begin()->first >= SendTimeHistory::kMaxSpan ||
+           seq < reference.begin()->first)) {
+        continue;
+      }
+      PacketFeedback packet = CreatePacket(seq, random.Rand(1, 1500));
+      EXPECT_EQ(reference.insert({seq, packet}).second, history.Insert(packet));
+    } else if (op < 90) {
+      int64_t seq = next_seq - random.Rand(0, 100);
+      reference.erase(seq);
+      history.Erase(seq);
+    } else if (!reference.empty()) {
+      reference.erase(reference.begin());
+      history.PopFront();
+    }
+    ASSERT_EQ(reference.empty(), history.empty());
+    if (!reference.empty()) {
+      ASSERT_EQ(reference.begin()->first, history.begin_sequence_number());
+      ASSERT_EQ(reference.begin()->second.sent.size,
+                history.front().sent.size);
+    }
+  }
+  for (const auto& entry : reference) {
+    const PacketFeedback* packet = history.Find(entry.first);
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(packet->sent.size, entry.second.sent.size);
+  }
+  std::vector<int64_t> sequence_numbers;
+  for (const auto& entry : reference)
+    sequence_numbers.push_back(entry.first);
+  EXPECT_EQ(SequenceNumbersInRange(&history, -1, next_seq), sequence_numbers);
+}
+
+}  // namespace
+}  // namespace webrtc
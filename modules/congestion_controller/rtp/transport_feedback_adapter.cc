@@ -100,27 +100,33 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
   packet.sent.pacing_info = packet_info.pacing_info;
 
   while (!history_.empty() &&
-         creation_time - history_.begin()->second.creation_time >
-             kSendTimeHistoryWindow) {
+         (creation_time - history_.front().creation_time >
+              kSendTimeHistoryWindow ||
+          packet.sent.sequence_number - history_.begin_sequence_number() >=
+              SendTimeHistory::kMaxSpan)) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    if (history_.begin()->second.sent.sequence_number > last_ack_seq_num_)
-      in_flight_.RemoveInFlightPacketBytes(history_.begin()->second);
-    history_.erase(history_.begin());
+    if (history_.front().sent.sequence_number > last_ack_seq_num_)
+      in_flight_.RemoveInFlightPacketBytes(history_.front());
+    history_.PopFront();
   }
-  history_.insert(std::make_pair(packet.sent.sequence_number, packet));
+  history_.Insert(packet);
 }
 
 absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
     const rtc::SentPacket& sent_packet) {
-  auto send_time = Timestamp::Millis(sent_packet.send_time_ms);
+  // The precise send time, where known, keeps the send intervals of small
+  // probes accurate.
+  auto send_time = sent_packet.send_time_us >= 0
+                       ? Timestamp::Micros(sent_packet.send_time_us)
+                       : Timestamp::Millis(sent_packet.send_time_ms);
   // TODO(srte): Only use one way to indicate that packet feedback is used.
   if (sent_packet.info.included_in_feedback || sent_packet.packet_id != -1) {
     int64_t unwrapped_seq_num =
         seq_num_unwrapper_.Unwrap(sent_packet.packet_id);
-    auto it = history_.find(unwrapped_seq_num);
-    if (it != history_.end()) {
-      bool packet_retransmit = it->second.sent.send_time.IsFinite();
-      it->second.sent.send_time = send_time;
+    PacketFeedback* packet = history_.Find(unwrapped_seq_num);
+    if (packet) {
+      bool packet_retransmit = packet->sent.send_time.IsFinite();
+      packet->sent.send_time = send_time;
       last_send_time_ = std::max(last_send_time_, send_time);
       // TODO(srte): Don't do this on retransmit.
       if (!pending_untracked_size_.IsZero()) {
@@ -128,14 +134,14 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
           RTC_LOG(LS_WARNING)
               << "appending acknowledged data for out of order packet. (Diff: "
               << ToString(last_untracked_send_time_ - send_time) << " ms.)";
-        it->second.sent.prior_unacked_data += pending_untracked_size_;
+        packet->sent.prior_unacked_data += pending_untracked_size_;
         pending_untracked_size_ = DataSize::Zero();
       }
       if (!packet_retransmit) {
-        if (it->second.sent.sequence_number > last_ack_seq_num_)
-          in_flight_.AddInFlightPacketBytes(it->second);
-        it->second.sent.data_in_flight = GetOutstandingData();
-        return it->second.sent;
+        if (packet->sent.sequence_number > last_ack_seq_num_)
+          in_flight_.AddInFlightPacketBytes(*packet);
+        packet->sent.data_in_flight = GetOutstandingData();
+        return packet->sent;
       }
     }
   } else if (sent_packet.info.included_in_allocation) {
@@ -162,20 +168,30 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
   msg.feedback_time = feedback_receive_time;
 
   msg.prior_in_flight = in_flight_.GetOutstandingData(network_route_);
-  msg.packet_feedbacks =
-      ProcessTransportFeedbackInner(feedback, feedback_receive_time);
+  ProcessTransportFeedbackInner(feedback, feedback_receive_time,
+                                &msg.packet_feedbacks);
   if (msg.packet_feedbacks.empty())
     return absl::nullopt;
 
-  auto it = history_.find(last_ack_seq_num_);
-  if (it != history_.end()) {
-    msg.first_unacked_send_time = it->second.sent.send_time;
+  const PacketFeedback* last_acked = history_.Find(last_ack_seq_num_);
+  if (last_acked) {
+    msg.first_unacked_send_time = last_acked->sent.send_time;
   }
   msg.data_in_flight = in_flight_.GetOutstandingData(network_route_);
 
   return msg;
 }
 
+void TransportFeedbackAdapter::AcknowledgeTransportFeedback(
+    const rtcp::TransportFeedback& feedback,
+    Timestamp feedback_receive_time) {
+  if (feedback.GetPacketStatusCount() == 0) {
+    RTC_LOG(LS_INFO) << "Empty transport feedback packet received.";
+    return;
+  }
+  ProcessTransportFeedbackInner(feedback, feedback_receive_time, nullptr);
+}
+
 void TransportFeedbackAdapter::SetNetworkRoute(
     const rtc::NetworkRoute& network_route) {
   network_route_ = network_route;
@@ -185,10 +201,10 @@ DataSize TransportFeedbackAdapter::GetOutstandingData() const {
   return in_flight_.GetOutstandingData(network_route_);
 }
 
-std::vector<PacketResult>
-TransportFeedbackAdapter::ProcessTransportFeedbackInner(
+void TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     const rtcp::TransportFeedback& feedback,
-    Timestamp feedback_receive_time) {
+    Timestamp feedback_receive_time,
+    std::vector<PacketResult>* packet_results) {
   // Add timestamp deltas to a local time base selected on first packet arrival.
   // This won't be the true time base, but makes it easier to manually inspect
   // time stamps.
@@ -208,8 +224,8 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
   }
   last_timestamp_ = feedback.GetBaseTime();
 
-  std::vector<PacketResult> packet_result_vector;
-  packet_result_vector.reserve(feedback.GetPacketStatusCount());
+  if (packet_results)
+    packet_results->reserve(feedback.GetPacketStatusCount());
 
   size_t failed_lookups = 0;
   size_t ignored = 0;
@@ -218,22 +234,22 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     int64_t seq_num = seq_num_unwrapper_.Unwrap(packet.sequence_number());
 
     if (seq_num > last_ack_seq_num_) {
-      // Starts at history_.begin() if last_ack_seq_num_ < 0, since any valid
+      // Starts at the oldest packet if last_ack_seq_num_ < 0, since any valid
       // sequence number is >= 0.
-      for (auto it = history_.upper_bound(last_ack_seq_num_);
-           it != history_.upper_bound(seq_num); ++it) {
-        in_flight_.RemoveInFlightPacketBytes(it->second);
-      }
+      history_.ForEachInRange(last_ack_seq_num_, seq_num,
+                              [this](const PacketFeedback& acked) {
+                                in_flight_.RemoveInFlightPacketBytes(acked);
+                              });
       last_ack_seq_num_ = seq_num;
     }
 
-    auto it = history_.find(seq_num);
-    if (it == history_.end()) {
+    const PacketFeedback* packet_feedback = history_.Find(seq_num);
+    if (!packet_feedback) {
       ++failed_lookups;
       continue;
     }
 
-    if (it->second.sent.send_time.IsInfinite()) {
+    if (packet_feedback->sent.send_time.IsInfinite()) {
       // TODO(srte): Fix the tests that makes this happen and make this a
       // DCHECK.
       RTC_DLOG(LS_ERROR)
@@ -241,23 +257,27 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
       continue;
     }
 
-    PacketFeedback packet_feedback = it->second;
+    Timestamp receive_time = packet_feedback->receive_time;
     if (packet.received()) {
       packet_offset += packet.delta();
-      packet_feedback.receive_time =
+      receive_time =
           current_offset_ + packet_offset.RoundDownTo(TimeDelta::Millis(1));
-      // Note: Lost packets are not removed from history because they might be
-      // reported as received by a later feedback.
-      history_.erase(it);
     }
-    if (packet_feedback.network_route == network_route_) {
-      PacketResult result;
-      result.sent_packet = packet_feedback.sent;
-      result.receive_time = packet_feedback.receive_time;
-      packet_result_vector.push_back(result);
+    // Results are built straight from the history entry, which is only
+    // erased afterwards.
+    if (packet_feedback->network_route == network_route_) {
+      if (packet_results) {
+        packet_results->emplace_back();
+        packet_results->back().sent_packet = packet_feedback->sent;
+        packet_results->back().receive_time = receive_time;
+      }
     } else {
       ++ignored;
     }
+    // Note: Lost packets are not removed from history because they might be
+    // reported as received by a later feedback.
+    if (packet.received())
+      history_.Erase(seq_num);
   }
 
   if (failed_lookups > 0) {
@@ -269,8 +289,6 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     RTC_LOG(LS_INFO) << "Ignoring " << ignored
                      << " packets because they were sent on a different route.";
   }
-
-  return packet_result_vector;
 }
 
 }  // namespace webrtc
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "api/transport/network_types.h"
+#include "modules/congestion_controller/rtp/send_time_history.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/critical_section.h"
@@ -28,20 +29,6 @@
 
 namespace webrtc {
 
-struct PacketFeedback {
-  PacketFeedback() = default;
-  // Time corresponding to when this object was created.
-  Timestamp creation_time = Timestamp::MinusInfinity();
-  SentPacket sent;
-  // Time corresponding to when the packet was received. Timestamped with the
-  // receiver's clock. For unreceived packet, Timestamp::PlusInfinity() is
-  // used.
-  Timestamp receive_time = Timestamp::PlusInfinity();
-
-  // The network route that this packet is associated with.
-  rtc::NetworkRoute network_route;
-};
-
 namespace rtcp {
   class TransportFeedback;
   class App;
@@ -74,6 +61,10 @@ class TransportFeedbackAdapter {
   absl::optional<TransportPacketsFeedback> ProcessTransportFeedback(
       const rtcp::TransportFeedback& feedback,
       Timestamp feedback_receive_time);
+  // Updates the history and the data in flight like ProcessTransportFeedback()
+  // without building the feedback message, for when nothing consumes it.
+  void AcknowledgeTransportFeedback(const rtcp::TransportFeedback& feedback,
+                                    Timestamp feedback_receive_time);
 
   void SetNetworkRoute(const rtc::NetworkRoute& network_route);
 
@@ -82,15 +73,17 @@ class TransportFeedbackAdapter {
  private:
   enum class SendTimeHistoryStatus { kNotAdded, kOk, kDuplicate };
 
-  std::vector<PacketResult> ProcessTransportFeedbackInner(
+  // Appends the results to |packet_results| unless it is null.
+  void ProcessTransportFeedbackInner(
       const rtcp::TransportFeedback& feedback,
-      Timestamp feedback_receive_time);
+      Timestamp feedback_receive_time,
+      std::vector<PacketResult>* packet_results);
 
   DataSize pending_untracked_size_ = DataSize::Zero();
   Timestamp last_send_time_ = Timestamp::MinusInfinity();
   Timestamp last_untracked_send_time_ = Timestamp::MinusInfinity();
   SequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketFeedback> history_;
+  SendTimeHistory history_;
 
   // Sequence numbers are never negative, using -1 as it always < a real
   // sequence number.
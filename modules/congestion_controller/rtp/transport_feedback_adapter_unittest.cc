@@ -410,6 +410,63 @@ TEST_F(TransportFeedbackAdapterTest, IgnoreDuplicatePacketSentCalls) {
   EXPECT_FALSE(duplicate_packet.has_value());
 }
 
+TEST_F(TransportFeedbackAdapterTest, UsesMicrosecondSendTimeIfKnown) {
+  RtpPacketSendInfo packet_info;
+  packet_info.ssrc = kSsrc;
+  packet_info.length = 1500;
+  packet_info.packet_type = RtpPacketMediaType::kVideo;
+  for (int64_t sequence_number = 0; sequence_number < 2; ++sequence_number) {
+    packet_info.transport_sequence_number = sequence_number;
+    adapter_->AddPacket(packet_info, 0u, clock_.CurrentTime());
+  }
+
+  rtc::SentPacket precise_packet(0, 200, rtc::PacketInfo());
+  precise_packet.send_time_us = 200250;
+  absl::optional<SentPacket> sent_packet =
+      adapter_->ProcessSentPacket(precise_packet);
+  ASSERT_TRUE(sent_packet.has_value());
+  EXPECT_EQ(sent_packet->send_time, Timestamp::Micros(200250));
+
+  sent_packet =
+      adapter_->ProcessSentPacket(rtc::SentPacket(1, 201, rtc::PacketInfo()));
+  ASSERT_TRUE(sent_packet.has_value());
+  EXPECT_EQ(sent_packet->send_time, Timestamp::Millis(201));
+}
+
+TEST_F(TransportFeedbackAdapterTest, AcknowledgesFeedbackWithoutResults) {
+  std::vector<PacketResult> packets;
+  for (int i = 0; i < 5; ++i)
+    packets.push_back(CreatePacket(100 + 10 * i, 200 + 10 * i, i, 1500,
+                                   kPacingInfo0));
+  for (const auto& packet : packets)
+    OnSentPacket(packet);
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Bytes(5 * 1500));
+
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(0, packets[0].receive_time.us());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(feedback.AddReceivedPacket(
+        packets[i].sent_packet.sequence_number, packets[i].receive_time.us()));
+  }
+  adapter_->AcknowledgeTransportFeedback(feedback, clock_.CurrentTime());
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Bytes(2 * 1500));
+
+  // The acknowledged packets are gone from the history, the others are still
+  // reported by the next feedback.
+  rtcp::TransportFeedback next_feedback;
+  next_feedback.SetBase(2, packets[2].receive_time.us());
+  for (int i = 2; i < 5; ++i) {
+    EXPECT_TRUE(next_feedback.AddReceivedPacket(
+        packets[i].sent_packet.sequence_number, packets[i].receive_time.us()));
+  }
+  auto result =
+      adapter_->ProcessTransportFeedback(next_feedback, clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  ComparePacketFeedbackVectors({packets[3], packets[4]},
+                               result->packet_feedbacks);
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Zero());
+}
+
 }  // namespace test
 }  // namespace webrtc_cc
 }  // namespace webrtc
@@ -86,4 +86,30 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+TEST(BlockDifferenceTestEveryByte, BlockDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+
+  for (int i = 0; i < kSizeOfBlock; ++i) {
+    block2[i] += 1;
+    EXPECT_TRUE(BlockDifference(block1, block2, kBlockSize * kBytesPerPixel));
+    block2[i] -= 1;
+  }
+  EXPECT_FALSE(BlockDifference(block1, block2, kBlockSize * kBytesPerPixel));
+}
+
+TEST(BlockDifferenceTestPartialHeight, BlockDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+  const int stride = kBlockSize * kBytesPerPixel;
+  // Change the first byte of the last row, which is not compared when the
+  // height excludes it.
+  block2[stride * (kBlockSize - 1)] += 1;
+
+  EXPECT_FALSE(BlockDifference(block1, block2, kBlockSize - 1, stride));
+  EXPECT_TRUE(BlockDifference(block1, block2, kBlockSize, stride));
+}
+
 }  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns the bitwise difference of the 32 bytes at |i1| and |i2|.
+inline __m256i Xor256(const __m256i* i1, const __m256i* i2) {
+  return _mm256_xor_si256(_mm256_loadu_si256(i1), _mm256_loadu_si256(i2));
+}
+
+// A vector of 16 pixels is 64 bytes, i.e. two 256-bit lanes.
+inline __m256i DiffW16(const uint8_t* image1, const uint8_t* image2) {
+  const __m256i* i1 = reinterpret_cast<const __m256i*>(image1);
+  const __m256i* i2 = reinterpret_cast<const __m256i*>(image2);
+  return _mm256_or_si256(Xor256(i1, i2), Xor256(i1 + 1, i2 + 1));
+}
+
+// A vector of 32 pixels is 128 bytes, i.e. four 256-bit lanes.
+inline __m256i DiffW32(const uint8_t* image1, const uint8_t* image2) {
+  return _mm256_or_si256(DiffW16(image1, image2),
+                         DiffW16(image1 + 64, image2 + 64));
+}
+
+inline bool HasDifference(__m256i v) {
+  return _mm256_testz_si256(v, v) == 0;
+}
+
+}  // namespace
+
+bool VectorDifference_AVX2_W16(const uint8_t* image1, const uint8_t* image2) {
+  return HasDifference(DiffW16(image1, image2));
+}
+
+bool VectorDifference_AVX2_W32(const uint8_t* image1, const uint8_t* image2) {
+  return HasDifference(DiffW32(image1, image2));
+}
+
+bool BlockDifference_AVX2_W16(const uint8_t* image1,
+                              const uint8_t* image2,
+                              int height,
+                              int stride) {
+  for (int i = 0; i < height; i++) {
+    if (HasDifference(DiffW16(image1, image2))) {
+      return true;
+    }
+    image1 += stride;
+    image2 += stride;
+  }
+  return false;
+}
+
+bool BlockDifference_AVX2_W32(const uint8_t* image1,
+                              const uint8_t* image2,
+                              int height,
+                              int stride) {
+  for (int i = 0; i < height; i++) {
+    if (HasDifference(DiffW32(image1, image2))) {
+      return true;
+    }
+    image1 += stride;
+    image2 += stride;
+  }
+  return false;
+}
+
+}  // namespace webrtc
@@ -22,6 +22,15 @@ enum FecMaskType {
   kFecMaskBursty,
 };
 
+// The erasure code used for the FlexFEC stream. |kXor| is the code of the
+// FlexFEC RFC, |kReedSolomon| can recover as many lost media packets as
+// repair packets were received, but is only understood by receivers that have
+// it enabled as well.
+enum class FecScheme {
+  kXor,
+  kReedSolomon,
+};
+
 // Struct containing forward error correction settings.
 struct FecProtectionParams {
   int fec_rate = 0;
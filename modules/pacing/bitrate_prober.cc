@@ -37,9 +37,10 @@ BitrateProberConfig::BitrateProberConfig(
     : min_probe_packets_sent("min_probe_packets_sent", 5),
       min_probe_delta("min_probe_delta", TimeDelta::Millis(1)),
       min_probe_duration("min_probe_duration", TimeDelta::Millis(15)),
-      max_probe_delay("max_probe_delay", TimeDelta::Millis(3)) {
+      max_probe_delay("max_probe_delay", TimeDelta::Millis(3)),
+      packet_trains("packet_trains") {
   ParseFieldTrial({&min_probe_packets_sent, &min_probe_delta,
-                   &min_probe_duration, &max_probe_delay},
+                   &min_probe_duration, &max_probe_delay, &packet_trains},
                   key_value_config->Lookup("WebRTC-Bwe-ProbingConfiguration"));
   ParseFieldTrial({&min_probe_packets_sent, &min_probe_delta,
                    &min_probe_duration, &max_probe_delay},
@@ -147,11 +148,30 @@ PacedPacketInfo BitrateProber::CurrentCluster() const {
 
 // Probe size is recommended based on the probe bitrate required. We choose
 // a minimum of twice |kMinProbeDeltaMs| interval to allow scheduling to be
-// feasible.
+// feasible. Packet trains catch up with their schedule instead, so a single
+// interval is enough.
 size_t BitrateProber::RecommendedMinProbeSize() const {
   RTC_DCHECK(!clusters_.empty());
-  return clusters_.front().pace_info.send_bitrate_bps * 2 *
-         config_.min_probe_delta->ms() / (8 * 1000);
+  const int64_t intervals = config_.packet_trains ? 1 : 2;
+  return clusters_.front().pace_info.send_bitrate_bps * intervals *
+         config_.min_probe_delta->us() / (8 * 1000000);
+}
+
+size_t BitrateProber::RecommendedProbeSize(Timestamp now) const {
+  RTC_DCHECK(!clusters_.empty());
+  const size_t min_probe_size = RecommendedMinProbeSize();
+  const ProbeCluster& cluster = clusters_.front();
+  if (!config_.packet_trains || cluster.started_at.IsInfinite() ||
+      now <= cluster.started_at) {
+    return min_probe_size;
+  }
+  // A probe sent late, e.g. because the pacer is woken up on a millisecond
+  // timer, makes up for the delay so that the cluster keeps its bitrate.
+  const int64_t due_bytes = cluster.pace_info.send_bitrate_bps *
+                            (now - cluster.started_at).us() / (8 * 1000000);
+  return min_probe_size +
+         static_cast<size_t>(std::max<int64_t>(
+             due_bytes - cluster.sent_bytes, 0));
 }
 
 void BitrateProber::ProbeSent(Timestamp now, size_t bytes) {
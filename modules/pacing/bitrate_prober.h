@@ -38,6 +38,11 @@ struct BitrateProberConfig {
   // Maximum amount of time each probe can be delayed. Probe cluster is reset
   // and retried from the start when this limit is reached.
   FieldTrialParameter<TimeDelta> max_probe_delay;
+  // Sends each probe as a packet train, handed to the network in one batch at
+  // the exact time it is due: |min_probe_delta| worth of data rather than
+  // twice that, plus whatever the cluster fell behind its bitrate. Probes
+  // that small need microsecond send times, see SentPacket::send_time_us.
+  FieldTrialFlag packet_trains;
 };
 
 // Note that this class isn't thread-safe by itself and therefore relies
@@ -75,6 +80,14 @@ class BitrateProber {
   // the next probe.
   size_t RecommendedMinProbeSize() const;
 
+  // Returns the number of bytes to send in the probe sent at |now|. With
+  // packet trains, that includes what the cluster fell behind its bitrate if
+  // the probe is late, otherwise it is RecommendedMinProbeSize().
+  size_t RecommendedProbeSize(Timestamp now) const;
+
+  // Whether probes should be sent as packet trains, see BitrateProberConfig.
+  bool sends_packet_trains() const { return config_.packet_trains; }
+
   // Called to report to the prober that a probe has been sent. In case of
   // multiple packets per probe, this call would be made at the end of sending
   // the last packet in probe. |probe_size| is the total size of all packets
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -213,4 +214,43 @@ TEST(BitrateProberTest, ProbeClusterTimeout) {
 
   EXPECT_FALSE(prober.is_probing());
 }
+
+TEST(BitrateProberTest, PacketTrainsUseASingleProbeInterval) {
+  test::ScopedFieldTrials trials(
+      "WebRTC-Bwe-ProbingConfiguration/packet_trains,min_probe_delta:250us/");
+  const FieldTrialBasedConfig config;
+  BitrateProber prober(config);
+  const DataRate kBitrate = DataRate::KilobitsPerSec(8000);  // 1 byte per us.
+
+  prober.CreateProbeCluster(kBitrate, Timestamp::Millis(0), /*cluster_id=*/0);
+  EXPECT_TRUE(prober.sends_packet_trains());
+  EXPECT_EQ(prober.RecommendedMinProbeSize(), 250u);
+}
+
+TEST(BitrateProberTest, LatePacketTrainsCatchUpWithTheClusterBitrate) {
+  test::ScopedFieldTrials trials(
+      "WebRTC-Bwe-ProbingConfiguration/packet_trains/");
+  const FieldTrialBasedConfig config;
+  BitrateProber prober(config);
+  const DataRate kBitrate = DataRate::KilobitsPerSec(800);  // 100 bytes per ms.
+
+  Timestamp now = Timestamp::Millis(0);
+  prober.CreateProbeCluster(kBitrate, now, /*cluster_id=*/0);
+  prober.OnIncomingPacket(1000);
+  ASSERT_TRUE(prober.is_probing());
+  EXPECT_EQ(prober.RecommendedProbeSize(now), 100u);
+  prober.ProbeSent(now, 100);
+  EXPECT_EQ(prober.NextProbeTime(now), now + TimeDelta::Millis(1));
+
+  // Two milliseconds late, the probe includes what should have been sent.
+  now += TimeDelta::Millis(3);
+  EXPECT_EQ(prober.RecommendedProbeSize(now), 300u);
+  prober.ProbeSent(now, 300);
+  EXPECT_EQ(prober.NextProbeTime(now), now + TimeDelta::Millis(1));
+
+  // On time, it is back to a single interval.
+  now += TimeDelta::Millis(1);
+  EXPECT_EQ(prober.RecommendedProbeSize(now), 100u);
+}
+
 }  // namespace webrtc
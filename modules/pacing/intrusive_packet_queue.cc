@@ -0,0 +1,386 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/intrusive_packet_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+constexpr DataSize kMaxLeadingSize = DataSize::Bytes(1400);
+constexpr size_t kMinEnqueueTimesSize = 16;
+}  // namespace
+
+constexpr int IntrusivePacketQueue::kNumPriorityLevels;
+constexpr int IntrusivePacketQueue::kNoIndex;
+constexpr int IntrusivePacketQueue::kNumLists;
+
+IntrusivePacketQueue::Stream::Stream(uint32_t ssrc)
+    : ssrc(ssrc), size(DataSize::Zero()) {}
+
+IntrusivePacketQueue::IntrusivePacketQueue(
+    Timestamp start_time,
+    const WebRtcKeyValueConfig* field_trials)
+    : transport_overhead_per_packet_(DataSize::Zero()),
+      time_last_updated_(start_time),
+      paused_(false),
+      single_packet_(false),
+      size_packets_(0),
+      size_(DataSize::Zero()),
+      max_size_(kMaxLeadingSize),
+      queue_time_sum_(TimeDelta::Zero()),
+      pause_time_sum_(TimeDelta::Zero()),
+      schedule_counter_(0),
+      free_packets_(kNoIndex),
+      enqueue_times_begin_(0),
+      enqueue_times_end_(0),
+      include_overhead_(false) {}
+
+IntrusivePacketQueue::~IntrusivePacketQueue() = default;
+
+void IntrusivePacketQueue::Push(int priority,
+                                Timestamp enqueue_time,
+                                uint64_t enqueue_order,
+                                std::unique_ptr<RtpPacketToSend> packet) {
+  RTC_DCHECK(packet->packet_type().has_value());
+  RTC_CHECK_GE(priority, 0);
+  RTC_CHECK_LT(priority, kNumPriorityLevels);
+  // Packets of the same stream, priority and type are kept in push order,
+  // which is the |enqueue_order| order as long as that is increasing.
+  const bool was_empty = size_packets_ == 0;
+  // RoundRobinPacketQueue keeps a packet pushed to an empty queue aside, and
+  // does not account it to its stream unless more packets are pushed before it
+  // is popped. Mirror that to send in exactly the same order.
+  single_packet_ = was_empty;
+
+  // Subtract the total amount of time the queue has been paused so far, and
+  // when the packet is popped subtract the total amount of time the queue has
+  // been paused at that moment. That way the time the packet has spent in the
+  // queue while paused is excluded from the queue time.
+  UpdateQueueTime(enqueue_time);
+  size_packets_ += 1;
+  size_ += PacketSize(*packet);
+
+  const int stream_index = FindOrCreateStream(packet->Ssrc());
+  const int list_index = ListIndex(priority, *packet);
+  const int packet_index = AllocatePacket();
+  QueuedPacket& queued_packet = packets_[packet_index];
+  queued_packet.rtp_packet = std::move(packet);
+  queued_packet.priority = priority;
+  queued_packet.enqueue_time = enqueue_time - pause_time_sum_;
+  // RoundRobinPacketQueue reports the pause adjusted enqueue time as oldest
+  // when the packet was pushed to an empty queue, and the actual one else.
+  queued_packet.enqueue_time_position =
+      AddEnqueueTime(was_empty ? queued_packet.enqueue_time : enqueue_time);
+  queued_packet.next = kNoIndex;
+
+  Stream& stream = streams_[stream_index];
+  PacketList& list = stream.lists[list_index];
+  if (list.tail == kNoIndex) {
+    list.head = packet_index;
+  } else {
+    packets_[list.tail].next = packet_index;
+  }
+  list.tail = packet_index;
+  stream.non_empty_lists |= 1u << list_index;
+
+  if (stream.heap_index == kNoIndex) {
+    stream.priority = priority;
+    stream.schedule_order = schedule_counter_++;
+    HeapPush(stream_index);
+  } else if (priority < stream.priority) {
+    // The priority of the stream increased, reschedule it. Note that lower
+    // ordinal means higher priority.
+    stream.priority = priority;
+    stream.schedule_order = schedule_counter_++;
+    HeapSiftUp(stream.heap_index);
+  }
+}
+
+std::unique_ptr<RtpPacketToSend> IntrusivePacketQueue::Pop() {
+  RTC_DCHECK(!Empty());
+  const int stream_index = stream_heap_.front();
+  Stream& stream = streams_[stream_index];
+  const int list_index = TopListIndex(stream);
+  PacketList& list = stream.lists[list_index];
+  const int packet_index = list.head;
+  QueuedPacket& queued_packet = packets_[packet_index];
+
+  list.head = queued_packet.next;
+  if (list.head == kNoIndex) {
+    list.tail = kNoIndex;
+    stream.non_empty_lists &= ~(1u << list_index);
+  }
+
+  // See Push() for why |pause_time_sum_| is subtracted here.
+  TimeDelta time_in_non_paused_state =
+      time_last_updated_ - queued_packet.enqueue_time - pause_time_sum_;
+  queue_time_sum_ -= time_in_non_paused_state;
+  RemoveEnqueueTime(queued_packet.enqueue_time_position);
+
+  std::unique_ptr<RtpPacketToSend> rtp_packet =
+      std::move(queued_packet.rtp_packet);
+  queued_packet.next = free_packets_;
+  free_packets_ = packet_index;
+
+  // Same budget as in RoundRobinPacketQueue: the stream that has sent the
+  // least goes first, but may not lag more than kMaxLeadingSize behind the
+  // stream that has sent the most.
+  DataSize packet_size = PacketSize(*rtp_packet);
+  if (!single_packet_) {
+    stream.size =
+        std::max(stream.size + packet_size, max_size_ - kMaxLeadingSize);
+    max_size_ = std::max(max_size_, stream.size);
+  }
+  single_packet_ = false;
+
+  size_ -= packet_size;
+  size_packets_ -= 1;
+  RTC_CHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
+
+  // If there are packets left to be sent, schedule the stream again.
+  if (stream.non_empty_lists == 0) {
+    HeapRemoveTop();
+  } else {
+    stream.priority = TopPacket(stream).priority;
+    stream.schedule_order = schedule_counter_++;
+    HeapSiftDown(0);
+  }
+
+  return rtp_packet;
+}
+
+bool IntrusivePacketQueue::Empty() const {
+  RTC_DCHECK_EQ(size_packets_ == 0, stream_heap_.empty());
+  return size_packets_ == 0;
+}
+
+size_t IntrusivePacketQueue::SizeInPackets() const {
+  return size_packets_;
+}
+
+DataSize IntrusivePacketQueue::Size() const {
+  return size_;
+}
+
+absl::optional<Timestamp> IntrusivePacketQueue::LeadingAudioPacketEnqueueTime()
+    const {
+  if (Empty()) {
+    return absl::nullopt;
+  }
+  const QueuedPacket& top_packet = TopPacket(streams_[stream_heap_.front()]);
+  if (top_packet.rtp_packet->packet_type() == RtpPacketMediaType::kAudio) {
+    return top_packet.enqueue_time;
+  }
+  return absl::nullopt;
+}
+
+Timestamp IntrusivePacketQueue::OldestEnqueueTime() const {
+  if (Empty())
+    return Timestamp::MinusInfinity();
+  RTC_CHECK_NE(enqueue_times_begin_, enqueue_times_end_);
+  return enqueue_times_[enqueue_times_begin_ & (enqueue_times_.size() - 1)]
+      .time;
+}
+
+void IntrusivePacketQueue::UpdateQueueTime(Timestamp now) {
+  RTC_CHECK_GE(now, time_last_updated_);
+  if (now == time_last_updated_)
+    return;
+
+  TimeDelta delta = now - time_last_updated_;
+
+  if (paused_) {
+    pause_time_sum_ += delta;
+  } else {
+    queue_time_sum_ += TimeDelta::Micros(delta.us() * size_packets_);
+  }
+
+  time_last_updated_ = now;
+}
+
+void IntrusivePacketQueue::SetPauseState(bool paused, Timestamp now) {
+  if (paused_ == paused)
+    return;
+  UpdateQueueTime(now);
+  paused_ = paused;
+}
+
+void IntrusivePacketQueue::SetIncludeOverhead() {
+  single_packet_ = false;
+  include_overhead_ = true;
+  // We need to update the size to reflect overhead for existing packets.
+  for (const QueuedPacket& packet : packets_) {
+    if (packet.rtp_packet) {
+      size_ += DataSize::Bytes(packet.rtp_packet->headers_size()) +
+               transport_overhead_per_packet_;
+    }
+  }
+}
+
+void IntrusivePacketQueue::SetTransportOverhead(DataSize overhead_per_packet) {
+  single_packet_ = false;
+  if (include_overhead_) {
+    // We need to update the size to reflect overhead for existing packets.
+    int64_t packets = static_cast<int64_t>(size_packets_);
+    size_ -= packets * transport_overhead_per_packet_;
+    size_ += packets * overhead_per_packet;
+  }
+  transport_overhead_per_packet_ = overhead_per_packet;
+}
+
+TimeDelta IntrusivePacketQueue::AverageQueueTime() const {
+  if (Empty())
+    return TimeDelta::Zero();
+  return queue_time_sum_ / size_packets_;
+}
+
+int IntrusivePacketQueue::ListIndex(int priority,
+                                    const RtpPacketToSend& packet) {
+  const bool is_retransmission =
+      packet.packet_type() == RtpPacketMediaType::kRetransmission;
+  return 2 * priority + (is_retransmission ? 0 : 1);
+}
+
+DataSize IntrusivePacketQueue::PacketSize(const RtpPacketToSend& packet) const {
+  DataSize packet_size =
+      DataSize::Bytes(packet.payload_size() + packet.padding_size());
+  if (include_overhead_) {
+    packet_size += DataSize::Bytes(packet.headers_size()) +
+                   transport_overhead_per_packet_;
+  }
+  return packet_size;
+}
+
+int IntrusivePacketQueue::AllocatePacket() {
+  if (free_packets_ == kNoIndex) {
+    packets_.emplace_back();
+    return static_cast<int>(packets_.size()) - 1;
+  }
+  int index = free_packets_;
+  free_packets_ = packets_[index].next;
+  return index;
+}
+
+int IntrusivePacketQueue::FindOrCreateStream(uint32_t ssrc) {
+  auto it = std::lower_bound(
+      stream_indices_.begin(), stream_indices_.end(), ssrc,
+      [](const std::pair<uint32_t, int>& entry, uint32_t ssrc) {
+        return entry.first < ssrc;
+      });
+  if (it != stream_indices_.end() && it->first == ssrc)
+    return it->second;
+  int index = static_cast<int>(streams_.size());
+  streams_.emplace_back(ssrc);
+  stream_indices_.emplace(it, ssrc, index);
+  return index;
+}
+
+int IntrusivePacketQueue::TopListIndex(const Stream& stream) {
+  RTC_DCHECK_NE(stream.non_empty_lists, 0u);
+  int list_index = 0;
+  while ((stream.non_empty_lists & (1u << list_index)) == 0)
+    ++list_index;
+  return list_index;
+}
+
+const IntrusivePacketQueue::QueuedPacket& IntrusivePacketQueue::TopPacket(
+    const Stream& stream) const {
+  return packets_[stream.lists[TopListIndex(stream)].head];
+}
+
+uint64_t IntrusivePacketQueue::AddEnqueueTime(Timestamp time) {
+  if (enqueue_times_end_ - enqueue_times_begin_ == enqueue_times_.size()) {
+    std::vector<EnqueueTimeEntry> grown(
+        std::max(kMinEnqueueTimesSize, 2 * enqueue_times_.size()));
+    for (uint64_t position = enqueue_times_begin_;
+         position != enqueue_times_end_; ++position) {
+      grown[position & (grown.size() - 1)] =
+          enqueue_times_[position & (enqueue_times_.size() - 1)];
+    }
+    enqueue_times_.swap(grown);
+  }
+  const size_t mask = enqueue_times_.size() - 1;
+  RTC_DCHECK(enqueue_times_begin_ == enqueue_times_end_ ||
+             enqueue_times_[(enqueue_times_end_ - 1) & mask].time <= time);
+  enqueue_times_[enqueue_times_end_ & mask] = {time, /*removed=*/false};
+  return enqueue_times_end_++;
+}
+
+void IntrusivePacketQueue::RemoveEnqueueTime(uint64_t position) {
+  const size_t mask = enqueue_times_.size() - 1;
+  enqueue_times_[position & mask].removed = true;
+  while (enqueue_times_begin_ != enqueue_times_end_ &&
+         enqueue_times_[enqueue_times_begin_ & mask].removed) {
+    ++enqueue_times_begin_;
+  }
+}
+
+bool IntrusivePacketQueue::StreamHasPriorityOver(int a, int b) const {
+  const Stream& stream_a = streams_[a];
+  const Stream& stream_b = streams_[b];
+  if (stream_a.priority != stream_b.priority)
+    return stream_a.priority < stream_b.priority;
+  if (stream_a.size != stream_b.size)
+    return stream_a.size < stream_b.size;
+  return stream_a.schedule_order < stream_b.schedule_order;
+}
+
+void IntrusivePacketQueue::HeapPush(int stream_index) {
+  streams_[stream_index].heap_index = static_cast<int>(stream_heap_.size());
+  stream_heap_.push_back(stream_index);
+  HeapSiftUp(streams_[stream_index].heap_index);
+}
+
+void IntrusivePacketQueue::HeapRemoveTop() {
+  RTC_DCHECK(!stream_heap_.empty());
+  HeapSwap(0, static_cast<int>(stream_heap_.size()) - 1);
+  streams_[stream_heap_.back()].heap_index = kNoIndex;
+  stream_heap_.pop_back();
+  if (!stream_heap_.empty())
+    HeapSiftDown(0);
+}
+
+void IntrusivePacketQueue::HeapSiftUp(int heap_index) {
+  while (heap_index > 0) {
+    int parent = (heap_index - 1) / 2;
+    if (!StreamHasPriorityOver(stream_heap_[heap_index], stream_heap_[parent]))
+      return;
+    HeapSwap(heap_index, parent);
+    heap_index = parent;
+  }
+}
+
+void IntrusivePacketQueue::HeapSiftDown(int heap_index) {
+  const int size = static_cast<int>(stream_heap_.size());
+  while (true) {
+    int best = heap_index;
+    for (int child = 2 * heap_index + 1;
+         child <= 2 * heap_index + 2 && child < size; ++child) {
+      if (StreamHasPriorityOver(stream_heap_[child], stream_heap_[best]))
+        best = child;
+    }
+    if (best == heap_index)
+      return;
+    HeapSwap(heap_index, best);
+    heap_index = best;
+  }
+}
+
+void IntrusivePacketQueue::HeapSwap(int a, int b) {
+  std::swap(stream_heap_[a], stream_heap_[b]);
+  streams_[stream_heap_[a]].heap_index = a;
+  streams_[stream_heap_[b]].heap_index = b;
+}
+
+}  // namespace webrtc
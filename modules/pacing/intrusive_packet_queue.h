@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_INTRUSIVE_PACKET_QUEUE_H_
+#define MODULES_PACING_INTRUSIVE_PACKET_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/transport/webrtc_key_value_config.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/pacer_packet_queue.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+// Drop-in replacement for RoundRobinPacketQueue, popping packets in the exact
+// same order, that does not allocate once it has grown to its working size.
+// Packets live in a pool and are chained into per stream, per priority FIFO
+// lists by index. Streams live in a slot array and the ones with packets are
+// kept in an indexed binary heap. Since packets are pushed in time order, the
+// enqueue times form a ring from which popped packets are lazily removed.
+class IntrusivePacketQueue : public PacerPacketQueue {
+ public:
+  // Priorities passed to Push() must be in [0, kNumPriorityLevels).
+  static constexpr int kNumPriorityLevels = 8;
+
+  IntrusivePacketQueue(Timestamp start_time,
+                       const WebRtcKeyValueConfig* field_trials);
+  ~IntrusivePacketQueue() override;
+
+  void Push(int priority,
+            Timestamp enqueue_time,
+            uint64_t enqueue_order,
+            std::unique_ptr<RtpPacketToSend> packet) override;
+  std::unique_ptr<RtpPacketToSend> Pop() override;
+
+  bool Empty() const override;
+  size_t SizeInPackets() const override;
+  DataSize Size() const override;
+  absl::optional<Timestamp> LeadingAudioPacketEnqueueTime() const override;
+
+  Timestamp OldestEnqueueTime() const override;
+  TimeDelta AverageQueueTime() const override;
+  void UpdateQueueTime(Timestamp now) override;
+  void SetPauseState(bool paused, Timestamp now) override;
+  void SetIncludeOverhead() override;
+  void SetTransportOverhead(DataSize overhead_per_packet) override;
+
+ private:
+  static constexpr int kNoIndex = -1;
+  // Within a stream, retransmissions go before other packets of the same
+  // priority, so every priority level has two lists.
+  static constexpr int kNumLists = 2 * kNumPriorityLevels;
+
+  struct QueuedPacket {
+    std::unique_ptr<RtpPacketToSend> rtp_packet;
+    // Enqueue time with the pause time sum at enqueue subtracted.
+    Timestamp enqueue_time = Timestamp::MinusInfinity();
+    int priority = 0;
+    // Position of the entry in |enqueue_times_|.
+    uint64_t enqueue_time_position = 0;
+    // Next packet in the same list, or in the free list.
+    int next = kNoIndex;
+  };
+
+  struct PacketList {
+    int head = kNoIndex;
+    int tail = kNoIndex;
+  };
+
+  struct Stream {
+    explicit Stream(uint32_t ssrc);
+
+    uint32_t ssrc;
+    DataSize size;
+    PacketList lists[kNumLists];
+    // Bit i is set iff lists[i] is non-empty.
+    uint32_t non_empty_lists = 0;
+    // Position in |stream_heap_|, kNoIndex if the stream has no packets.
+    int heap_index = kNoIndex;
+    // Scheduling key: priority of the top packet, |size| and the order in
+    // which the stream was (re)scheduled, the latter breaking ties in the same
+    // way as the insertion order of RoundRobinPacketQueue's multimap.
+    int priority = 0;
+    uint64_t schedule_order = 0;
+  };
+
+  struct EnqueueTimeEntry {
+    Timestamp time = Timestamp::MinusInfinity();
+    bool removed = false;
+  };
+
+  static int ListIndex(int priority, const RtpPacketToSend& packet);
+
+  DataSize PacketSize(const RtpPacketToSend& packet) const;
+  int AllocatePacket();
+  int FindOrCreateStream(uint32_t ssrc);
+  static int TopListIndex(const Stream& stream);
+  const QueuedPacket& TopPacket(const Stream& stream) const;
+
+  uint64_t AddEnqueueTime(Timestamp time);
+  void RemoveEnqueueTime(uint64_t position);
+
+  bool StreamHasPriorityOver(int a, int b) const;
+  void HeapPush(int stream_index);
+  void HeapRemoveTop();
+  void HeapSiftUp(int heap_index);
+  void HeapSiftDown(int heap_index);
+  void HeapSwap(int a, int b);
+
+  DataSize transport_overhead_per_packet_;
+
+  Timestamp time_last_updated_;
+
+  bool paused_;
+  // True while the only packet in the queue was pushed to an empty queue.
+  bool single_packet_;
+  size_t size_packets_;
+  DataSize size_;
+  DataSize max_size_;
+  TimeDelta queue_time_sum_;
+  TimeDelta pause_time_sum_;
+  uint64_t schedule_counter_;
+
+  // Pool of packets, unused entries are chained from |free_packets_|.
+  std::vector<QueuedPacket> packets_;
+  int free_packets_;
+
+  std::vector<Stream> streams_;
+  // Sorted by SSRC, maps to the index in |streams_|.
+  std::vector<std::pair<uint32_t, int>> stream_indices_;
+  // Indices in |streams_| of the streams that have packets.
+  std::vector<int> stream_heap_;
+
+  // Ring buffer with a power of two size, indexed by position modulo size.
+  // Holds the enqueue times of [enqueue_times_begin_, enqueue_times_end_).
+  std::vector<EnqueueTimeEntry> enqueue_times_;
+  uint64_t enqueue_times_begin_;
+  uint64_t enqueue_times_end_;
+
+  bool include_overhead_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_INTRUSIVE_PACKET_QUEUE_H_
@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/intrusive_packet_queue.h"
+
+#include <memory>
+#include <random>
+
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr Timestamp kStartTime = Timestamp::Millis(123456);
+
+std::unique_ptr<RtpPacketToSend> BuildPacket(RtpPacketMediaType type,
+                                             uint32_t ssrc,
+                                             uint16_t sequence_number,
+                                             size_t payload_size) {
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+  packet->set_packet_type(type);
+  packet->SetSsrc(ssrc);
+  packet->SetSequenceNumber(sequence_number);
+  packet->SetPayloadSize(payload_size);
+  return packet;
+}
+
+struct TypeAndPriority {
+  RtpPacketMediaType type;
+  int priority;
+};
+
+// Same priorities as assigned by the PacingController.
+constexpr TypeAndPriority kTypes[] = {
+    {RtpPacketMediaType::kAudio, 1},
+    {RtpPacketMediaType::kRetransmission, 2},
+    {RtpPacketMediaType::kVideo, 3},
+    {RtpPacketMediaType::kForwardErrorCorrection, 3},
+    {RtpPacketMediaType::kPadding, 4}};
+
+TEST(IntrusivePacketQueueTest, PopsByPriorityThenRoundRobin) {
+  IntrusivePacketQueue queue(kStartTime, nullptr);
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::MinusInfinity());
+
+  uint64_t enqueue_order = 0;
+  for (uint16_t seq = 0; seq < 2; ++seq) {
+    for (uint32_t ssrc : {1u, 2u}) {
+      queue.Push(3, kStartTime, enqueue_order++,
+                 BuildPacket(RtpPacketMediaType::kVideo, ssrc, seq, 1000));
+    }
+  }
+  queue.Push(1, kStartTime, enqueue_order++,
+             BuildPacket(RtpPacketMediaType::kAudio, 3, 0, 100));
+  EXPECT_EQ(queue.SizeInPackets(), 5u);
+  EXPECT_EQ(queue.Size(), DataSize::Bytes(4100));
+  EXPECT_EQ(queue.LeadingAudioPacketEnqueueTime(), kStartTime);
+
+  EXPECT_EQ(queue.Pop()->Ssrc(), 3u);
+  EXPECT_FALSE(queue.LeadingAudioPacketEnqueueTime().has_value());
+  // Video streams alternate as each pop makes the stream's sent size larger.
+  for (uint16_t seq = 0; seq < 2; ++seq) {
+    for (uint32_t ssrc : {1u, 2u}) {
+      std::unique_ptr<RtpPacketToSend> packet = queue.Pop();
+      EXPECT_EQ(packet->Ssrc(), ssrc);
+      EXPECT_EQ(packet->SequenceNumber(), seq);
+    }
+  }
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Size(), DataSize::Zero());
+}
+
+TEST(IntrusivePacketQueueTest, RetransmissionsFirstWithinPriority) {
+  IntrusivePacketQueue queue(kStartTime, nullptr);
+  queue.Push(0, kStartTime, 0,
+             BuildPacket(RtpPacketMediaType::kPadding, 1, 0, 100));
+  queue.Push(0, kStartTime, 1,
+             BuildPacket(RtpPacketMediaType::kRetransmission, 1, 1, 100));
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 1);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 0);
+}
+
+TEST(IntrusivePacketQueueTest, TracksOldestEnqueueTime) {
+  IntrusivePacketQueue queue(kStartTime, nullptr);
+  queue.Push(3, kStartTime, 0,
+             BuildPacket(RtpPacketMediaType::kVideo, 1, 0, 100));
+  queue.Push(2, kStartTime + TimeDelta::Millis(10), 1,
+             BuildPacket(RtpPacketMediaType::kRetransmission, 1, 1, 100));
+  queue.Push(3, kStartTime + TimeDelta::Millis(20), 2,
+             BuildPacket(RtpPacketMediaType::kVideo, 1, 2, 100));
+  EXPECT_EQ(queue.OldestEnqueueTime(), kStartTime);
+  // The retransmission goes first, which still leaves the first packet.
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 1);
+  EXPECT_EQ(queue.OldestEnqueueTime(), kStartTime);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 0);
+  EXPECT_EQ(queue.OldestEnqueueTime(), kStartTime + TimeDelta::Millis(20));
+
+  queue.UpdateQueueTime(kStartTime + TimeDelta::Millis(30));
+  EXPECT_EQ(queue.AverageQueueTime(), TimeDelta::Millis(10));
+}
+
+// Drives both queues with the same random operations and expects the same
+// packets to come out in the same order, with the same stats on the way.
+TEST(IntrusivePacketQueueTest, MatchesRoundRobinPacketQueue) {
+  std::mt19937 random(4711);
+  RoundRobinPacketQueue expected(kStartTime, nullptr);
+  IntrusivePacketQueue queue(kStartTime, nullptr);
+  Timestamp now = kStartTime;
+  uint64_t enqueue_order = 0;
+  bool paused = false;
+  bool include_overhead = false;
+
+  for (int i = 0; i < 50000; ++i) {
+    int action = std::uniform_int_distribution<int>(0, 99)(random);
+    if (action < 45) {
+      const TypeAndPriority& type =
+          kTypes[std::uniform_int_distribution<int>(0, 4)(random)];
+      uint32_t ssrc = std::uniform_int_distribution<uint32_t>(1, 8)(random);
+      size_t size = std::uniform_int_distribution<size_t>(50, 1200)(random);
+      // Padding is sometimes enqueued at the highest priority.
+      int priority = action < 2 ? 0 : type.priority;
+      uint16_t seq = static_cast<uint16_t>(enqueue_order);
+      expected.Push(priority, now, enqueue_order,
+                    BuildPacket(type.type, ssrc, seq, size));
+      queue.Push(priority, now, enqueue_order,
+                 BuildPacket(type.type, ssrc, seq, size));
+      ++enqueue_order;
+    } else if (action < 90) {
+      ASSERT_EQ(queue.Empty(), expected.Empty());
+      if (!queue.Empty()) {
+        std::unique_ptr<RtpPacketToSend> expected_packet = expected.Pop();
+        std::unique_ptr<RtpPacketToSend> packet = queue.Pop();
+        ASSERT_EQ(packet->Ssrc(), expected_packet->Ssrc()) << "at " << i;
+        ASSERT_EQ(packet->SequenceNumber(), expected_packet->SequenceNumber())
+            << "at " << i;
+      }
+    } else if (action < 97) {
+      now += TimeDelta::Millis(
+          std::uniform_int_distribution<int>(0, 20)(random));
+      expected.UpdateQueueTime(now);
+      queue.UpdateQueueTime(now);
+    } else if (action < 99) {
+      paused = !paused;
+      expected.SetPauseState(paused, now);
+      queue.SetPauseState(paused, now);
+    } else if (i > 25000) {
+      DataSize overhead = DataSize::Bytes(
+          std::uniform_int_distribution<int>(20, 60)(random));
+      if (!include_overhead) {
+        expected.SetIncludeOverhead();
+        queue.SetIncludeOverhead();
+        include_overhead = true;
+      }
+      expected.SetTransportOverhead(overhead);
+      queue.SetTransportOverhead(overhead);
+    }
+
+    ASSERT_EQ(queue.SizeInPackets(), expected.SizeInPackets());
+    ASSERT_EQ(queue.Size(), expected.Size());
+    ASSERT_EQ(queue.OldestEnqueueTime(), expected.OldestEnqueueTime());
+    ASSERT_EQ(queue.AverageQueueTime(), expected.AverageQueueTime());
+    ASSERT_EQ(queue.LeadingAudioPacketEnqueueTime(),
+              expected.LeadingAudioPacketEnqueueTime());
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -155,6 +155,11 @@ TimeDelta PacedSender::OldestPacketWaitTime() const {
   return pacing_controller_.OldestPacketWaitTime();
 }
 
+DataSize PacedSender::MaxBurstSize() const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.MaxBurstSize();
+}
+
 int64_t PacedSender::TimeUntilNextProcess() {
   rtc::CritScope cs(&critsect_);
 
@@ -162,7 +167,7 @@ int64_t PacedSender::TimeUntilNextProcess() {
   TimeDelta sleep_time =
       std::max(TimeDelta::Zero(), next_send_time - clock_->CurrentTime());
   if (process_mode_ == PacingController::ProcessMode::kDynamic) {
-    return std::max(sleep_time, PacingController::kMinSleepTime).ms();
+    return std::max(sleep_time, pacing_controller_.MinSleepTime()).ms();
   }
   return sleep_time.ms();
 }
@@ -201,6 +206,14 @@ void PacedSender::SendRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   critsect_.Enter();
 }
 
+void PacedSender::SendRtpPackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+    const PacedPacketInfo& cluster_info) {
+  critsect_.Leave();
+  packet_router_->SendPackets(std::move(packets), cluster_info);
+  critsect_.Enter();
+}
+
 std::vector<std::unique_ptr<RtpPacketToSend>> PacedSender::GeneratePadding(
     DataSize size) {
   std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets;
@@ -103,6 +103,8 @@ class PacedSender : public Module,
   // Returns the time since the oldest queued packet was enqueued.
   TimeDelta OldestPacketWaitTime() const override;
 
+  DataSize MaxBurstSize() const override;
+
   DataSize QueueSizeData() const override;
 
   // Returns the time when the first packet was sent;
@@ -144,6 +146,9 @@ class PacedSender : public Module,
   void SendRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
                      const PacedPacketInfo& cluster_info) override
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  void SendRtpPackets(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                      const PacedPacketInfo& cluster_info) override
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
 
   std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       DataSize size) override RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_PACER_TIMER_WHEEL_H_
+#define MODULES_PACING_PACER_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Hierarchical timer wheel holding one deadline per key. Scheduling and
+// cancelling are O(1), and expiring costs O(1) per elapsed tick plus the
+// cascading of entries into finer levels, independent of the number of keys.
+//
+// Deadlines are rounded up to |resolution|, so keys due within the same tick
+// expire together and never before their deadline.
+template <typename Key>
+class PacerTimerWheel {
+ public:
+  PacerTimerWheel(Timestamp start, TimeDelta resolution)
+      : resolution_us_(resolution.us()),
+        current_tick_(start.us() / resolution_us_) {
+    RTC_DCHECK_GT(resolution_us_, 0);
+  }
+
+  PacerTimerWheel(const PacerTimerWheel&) = delete;
+  PacerTimerWheel& operator=(const PacerTimerWheel&) = delete;
+
+  bool empty() const { return deadlines_.empty(); }
+  size_t size() const { return deadlines_.size(); }
+
+  // Replaces the deadline of |key|, if any. Deadlines in the past expire on
+  // the next call to Advance().
+  void Schedule(const Key& key, Timestamp at) {
+    RTC_DCHECK(at.IsFinite());
+    int64_t tick = DivideRoundUp(at.us());
+    Deadline& deadline = deadlines_[key];
+    deadline.tick = tick;
+    deadline.generation = ++last_generation_;
+    if (tick < current_tick_) {
+      overdue_.push_back({key, deadline.generation, tick});
+    } else {
+      Place({key, deadline.generation, tick});
+    }
+  }
+
+  void Cancel(const Key& key) { deadlines_.erase(key); }
+
+  // Lower bound of the earliest deadline, PlusInfinity() if there is none.
+  // Keys in the coarser levels are accounted for with the time they move to
+  // a finer level, which may be before their actual deadline.
+  Timestamp NextExpiry() const {
+    if (deadlines_.empty())
+      return Timestamp::PlusInfinity();
+    if (!overdue_.empty())
+      return Timestamp::Micros((current_tick_ - 1) * resolution_us_);
+    return Timestamp::Micros(NextTick() * resolution_us_);
+  }
+
+  // Expires everything due at or before |now| and appends the keys to |due|,
+  // earliest tick first.
+  void Advance(Timestamp now, std::vector<Key>* due) {
+    std::vector<Entry> overdue;
+    overdue.swap(overdue_);
+    for (const Entry& entry : overdue)
+      Expire(entry, due);
+    int64_t now_tick = now.us() / resolution_us_;
+    while (current_tick_ <= now_tick) {
+      if (deadlines_.empty()) {
+        // Only stale entries are left, they are dropped whenever reached.
+        current_tick_ = now_tick + 1;
+        return;
+      }
+      // Skip the ticks where nothing expires or cascades.
+      int64_t next_tick = NextTick();
+      if (next_tick > current_tick_) {
+        current_tick_ = std::min(next_tick, now_tick + 1);
+        Cascade();
+        continue;
+      }
+      std::vector<Entry> slot;
+      slot.swap(slots_[0][current_tick_ & kSlotMask]);
+      for (const Entry& entry : slot)
+        Expire(entry, due);
+      ++current_tick_;
+      Cascade();
+    }
+  }
+
+ private:
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots = 1 << kSlotBits;
+  static constexpr int64_t kSlotMask = kSlots - 1;
+  // Ticks further away than this are kept in the last slot of the coarsest
+  // level until they get closer.
+  static constexpr int64_t kMaxDelta =
+      (int64_t{1} << (kLevels * kSlotBits)) - 1;
+
+  struct Deadline {
+    int64_t tick = 0;
+    uint64_t generation = 0;
+  };
+  // Entries are removed lazily: cancelled or rescheduled keys leave their old
+  // entry behind, which is dropped once its generation no longer matches.
+  struct Entry {
+    Key key;
+    uint64_t generation;
+    int64_t tick;
+  };
+
+  // First tick where a level 0 slot expires or a coarser slot cascades.
+  int64_t NextTick() const {
+    int64_t next_tick = INT64_MAX;
+    for (int level = 0; level < kLevels; ++level) {
+      int shift = level * kSlotBits;
+      int64_t level_tick = current_tick_ >> shift;
+      // Level 0 slots expire when the tick reaches them. Coarser slots are
+      // cascaded when the tick reaches their start, which is after the
+      // current one and up to a full turn away.
+      int first = level == 0 ? 0 : 1;
+      for (int offset = first; offset < first + kSlots; ++offset) {
+        if (!slots_[level][(level_tick + offset) & kSlotMask].empty()) {
+          next_tick = std::min(next_tick, (level_tick + offset) << shift);
+          break;
+        }
+      }
+    }
+    return next_tick;
+  }
+
+  // Appends the key of |entry| to |due| if it is still scheduled for this
+  // entry and due, or moves it closer to its deadline otherwise.
+  void Expire(const Entry& entry, std::vector<Key>* due) {
+    auto it = deadlines_.find(entry.key);
+    if (it == deadlines_.end() || it->second.generation != entry.generation)
+      return;
+    if (entry.tick <= current_tick_) {
+      due->push_back(entry.key);
+      deadlines_.erase(it);
+    } else {
+      Place(entry);
+    }
+  }
+
+  int64_t DivideRoundUp(int64_t us) const {
+    return us >= 0 ? (us + resolution_us_ - 1) / resolution_us_
+                   : us / resolution_us_;
+  }
+
+  void Place(const Entry& entry) {
+    int64_t tick = std::min(entry.tick, current_tick_ + kMaxDelta);
+    int64_t delta = tick - current_tick_;
+    int level = 0;
+    while (level < kLevels - 1 && delta >> ((level + 1) * kSlotBits) != 0)
+      ++level;
+    int64_t slot = (tick >> (level * kSlotBits)) & kSlotMask;
+    slots_[level][slot].push_back(entry);
+  }
+
+  // Moves the entries of the coarser slots starting at |current_tick_| into
+  // finer levels, coarsest first.
+  void Cascade() {
+    for (int level = kLevels - 1; level > 0; --level) {
+      int shift = level * kSlotBits;
+      if ((current_tick_ & ((int64_t{1} << shift) - 1)) != 0)
+        continue;
+      std::vector<Entry> slot;
+      slot.swap(slots_[level][(current_tick_ >> shift) & kSlotMask]);
+      for (const Entry& entry : slot) {
+        auto it = deadlines_.find(entry.key);
+        if (it != deadlines_.end() && it->second.generation == entry.generation)
+          Place(entry);
+      }
+    }
+  }
+
+  const int64_t resolution_us_;
+  // Every tick before this one has expired. Cascade() must run whenever it
+  // changes.
+  int64_t current_tick_;
+  uint64_t last_generation_ = 0;
+  std::unordered_map<Key, Deadline> deadlines_;
+  // Scheduled before |current_tick_|, expired by the next Advance().
+  std::vector<Entry> overdue_;
+  std::vector<Entry> slots_[kLevels][kSlots];
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_PACER_TIMER_WHEEL_H_
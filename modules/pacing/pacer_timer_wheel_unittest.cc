@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pacer_timer_wheel.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr Timestamp kStart = Timestamp::Millis(1000);
+constexpr TimeDelta kResolution = TimeDelta::Millis(1);
+
+std::vector<int> AdvanceTo(PacerTimerWheel<int>* wheel, Timestamp now) {
+  std::vector<int> due;
+  wheel->Advance(now, &due);
+  return due;
+}
+
+TEST(PacerTimerWheelTest, ExpiresAtDeadline) {
+  PacerTimerWheel<int> wheel(kStart, kResolution);
+  EXPECT_TRUE(wheel.NextExpiry().IsPlusInfinity());
+  wheel.Schedule(1, kStart + TimeDelta::Millis(5));
+  wheel.Schedule(2, kStart + TimeDelta::Millis(3));
+  EXPECT_EQ(wheel.NextExpiry(), kStart + TimeDelta::Millis(3));
+
+  EXPECT_THAT(AdvanceTo(&wheel, kStart + TimeDelta::Millis(2)), IsEmpty());
+  EXPECT_THAT(AdvanceTo(&wheel, kStart + TimeDelta::Millis(3)),
+              ElementsAre(2));
+  EXPECT_EQ(wheel.NextExpiry(), kStart + TimeDelta::Millis(5));
+  EXPECT_THAT(AdvanceTo(&wheel, kStart + TimeDelta::Millis(10)),
+              ElementsAre(1));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(PacerTimerWheelTest, RoundsDeadlinesUp) {
+  PacerTimerWheel<int> wheel(kStart, TimeDelta::Millis(2));
+  wheel.Schedule(1, kStart + TimeDelta::Micros(2500));
+  wheel.Schedule(2, kStart + TimeDelta::Millis(4));
+  EXPECT_EQ(wheel.NextExpiry(), kStart + TimeDelta::Millis(4));
+  EXPECT_THAT(AdvanceTo(&wheel, kStart + TimeDelta::Micros(3999)), IsEmpty());
+  EXPECT_THAT(AdvanceTo(&wheel, kStart + TimeDelta::Millis(4)),
+              ElementsAre(1, 2));
+}
+
+TEST(PacerTimerWheelTest, PastDeadlinesExpireRightAway) {
+  PacerTimerWheel<int> wheel(kStart, kResolution);
+  AdvanceTo(&wheel, kStart + TimeDelta::Millis(10));
+  wheel.Schedule(1, kStart);
+  EXPECT_EQ(wheel.NextExpiry(), kStart + TimeDelta::Millis(10));
+  EXPECT_THAT(AdvanceTo(&wheel, kStart + TimeDelta::Millis(10)),
+              ElementsAre(1));
+}
+
+TEST(PacerTimerWheelTest, RescheduleAndCancel) {
+  PacerTimerWheel<int> wheel(kStart, kResolution);
+  wheel.Schedule(1, kStart + TimeDelta::Millis(5));
+  wheel.Schedule(1, kStart + TimeDelta::Millis(500));
+  wheel.Schedule(2, kStart + TimeDelta::Millis(5));
+  wheel.Cancel(2);
+  EXPECT_EQ(wheel.size(), 1u);
+  EXPECT_THAT(AdvanceTo(&wheel, kStart + TimeDelta::Millis(499)), IsEmpty());
+  EXPECT_THAT(AdvanceTo(&wheel, kStart + TimeDelta::Millis(500)),
+              ElementsAre(1));
+}
+
+TEST(PacerTimerWheelTest, NextExpiryIsLowerBoundForFarDeadlines) {
+  PacerTimerWheel<int> wheel(kStart, kResolution);
+  const Timestamp deadline = kStart + TimeDelta::Seconds(100);
+  wheel.Schedule(1, deadline);
+  Timestamp now = kStart;
+  int wakeups = 0;
+  std::vector<int> due;
+  while (due.empty()) {
+    Timestamp next = wheel.NextExpiry();
+    ASSERT_GT(next, now);
+    ASSERT_LE(next, deadline);
+    now = next;
+    wheel.Advance(now, &due);
+    ++wakeups;
+  }
+  EXPECT_EQ(now, deadline);
+  // One wakeup per level at most.
+  EXPECT_LE(wakeups, 4);
+}
+
+TEST(PacerTimerWheelTest, DeadlinesBeyondRange) {
+  PacerTimerWheel<int> wheel(kStart, kResolution);
+  const Timestamp deadline = kStart + TimeDelta::Seconds(24 * 3600);
+  wheel.Schedule(1, deadline);
+  Timestamp now = kStart;
+  std::vector<int> due;
+  while (due.empty()) {
+    Timestamp next = wheel.NextExpiry();
+    ASSERT_GT(next, now);
+    ASSERT_LE(next, deadline);
+    now = next;
+    wheel.Advance(now, &due);
+  }
+  EXPECT_EQ(now, deadline);
+}
+
+TEST(PacerTimerWheelTest, MatchesOrderedMap) {
+  std::mt19937 random(1234);
+  std::uniform_int_distribution<int> key_distribution(0, 199);
+  std::uniform_int_distribution<int> delay_distribution(0, 20000);
+  PacerTimerWheel<int> wheel(kStart, kResolution);
+  std::map<int, int64_t> expected;
+  Timestamp now = kStart;
+  for (int i = 0; i < 20000; ++i) {
+    int key = key_distribution(random);
+    if (i % 7 == 0) {
+      wheel.Cancel(key);
+      expected.erase(key);
+    } else {
+      int64_t deadline_ms = now.ms() + delay_distribution(random) / 10 *
+                                           (i % 3 == 0 ? 10 : 1);
+      wheel.Schedule(key, Timestamp::Millis(deadline_ms));
+      expected[key] = deadline_ms;
+    }
+    now += TimeDelta::Millis(i % 5);
+    std::vector<int> due;
+    wheel.Advance(now, &due);
+    for (int due_key : due) {
+      ASSERT_EQ(expected.count(due_key), 1u);
+      EXPECT_LE(expected[due_key], now.ms());
+      expected.erase(due_key);
+    }
+    for (const auto& entry : expected)
+      ASSERT_GT(entry.second, now.ms()) << "key " << entry.first;
+    ASSERT_EQ(wheel.size(), expected.size());
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
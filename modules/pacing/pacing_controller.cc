@@ -18,6 +18,8 @@
 #include "absl/strings/match.h"
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
+#include "modules/pacing/intrusive_packet_queue.h"
+#include "modules/pacing/round_robin_packet_queue.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/field_trial_parser.h"
@@ -34,6 +36,8 @@ constexpr TimeDelta kCongestedPacketInterval = TimeDelta::Millis(500);
 // The maximum debt level, in terms of time, capped when sending packets.
 constexpr TimeDelta kMaxDebtInTime = TimeDelta::Millis(500);
 constexpr TimeDelta kMaxElapsedTime = TimeDelta::Seconds(2);
+// MaxBurstSize() reports the largest burst of the current and previous window.
+constexpr TimeDelta kBurstStatsWindow = TimeDelta::Seconds(1);
 
 // Upper cap on process interval, in case process has not been called in a long
 // time. Applies only to periodic mode.
@@ -59,6 +63,15 @@ TimeDelta GetDynamicPaddingTarget(const WebRtcKeyValueConfig& field_trials) {
   return padding_target.Get();
 }
 
+std::unique_ptr<PacerPacketQueue> CreatePacketQueue(
+    Timestamp start_time,
+    const WebRtcKeyValueConfig& field_trials) {
+  if (IsEnabled(field_trials, "WebRTC-Pacer-IntrusivePacketQueue")) {
+    return std::make_unique<IntrusivePacketQueue>(start_time, &field_trials);
+  }
+  return std::make_unique<RoundRobinPacketQueue>(start_time, &field_trials);
+}
+
 int GetPriorityForType(RtpPacketMediaType type) {
   // Lower number takes priority over higher.
   switch (type) {
@@ -90,6 +103,30 @@ const TimeDelta PacingController::kPausedProcessInterval =
     kCongestedPacketInterval;
 const TimeDelta PacingController::kMinSleepTime = TimeDelta::Millis(1);
 
+PacingController::HighResolutionConfig::HighResolutionConfig(
+    const WebRtcKeyValueConfig& field_trials,
+    ProcessMode mode)
+    : enabled(false), min_sleep(kMinSleepTime), max_burst(kMinSleepTime) {
+  FieldTrialFlag enabled_flag("Enabled");
+  FieldTrialParameter<TimeDelta> min_sleep_param("min_sleep",
+                                                 TimeDelta::Micros(250));
+  FieldTrialParameter<TimeDelta> max_burst_param("max_burst",
+                                                 TimeDelta::Millis(1));
+  ParseFieldTrial({&enabled_flag, &min_sleep_param, &max_burst_param},
+                  field_trials.Lookup("WebRTC-Pacer-HighResolution"));
+  if (!enabled_flag)
+    return;
+  if (mode != ProcessMode::kDynamic) {
+    RTC_LOG(LS_WARNING) << "High resolution pacing needs dynamic mode.";
+    return;
+  }
+  enabled = true;
+  min_sleep = std::max(min_sleep_param.Get(), TimeDelta::Micros(1));
+  // A pacer woken every |min_sleep| must be allowed to send at least that
+  // much per wakeup to keep up with the pacing rate.
+  max_burst = std::max(max_burst_param.Get(), min_sleep);
+}
+
 PacingController::PacingController(Clock* clock,
                                    PacketSender* packet_sender,
                                    RtcEventLog* event_log,
@@ -110,7 +147,9 @@ PacingController::PacingController(Clock* clock,
           IsEnabled(*field_trials_, "WebRTC-Pacer-SmallFirstProbePacket")),
       ignore_transport_overhead_(
           IsEnabled(*field_trials_, "WebRTC-Pacer-IgnoreTransportOverhead")),
+      batch_send_(IsEnabled(*field_trials_, "WebRTC-Pacer-BatchSend")),
       padding_target_duration_(GetDynamicPaddingTarget(*field_trials_)),
+      high_resolution_(*field_trials_, mode),
       min_packet_limit_(kDefaultMinPacketLimit),
       transport_overhead_per_packet_(DataSize::Zero()),
       last_timestamp_(clock_->CurrentTime()),
@@ -126,7 +165,10 @@ PacingController::PacingController(Clock* clock,
       pacing_bitrate_(DataRate::Zero()),
       last_process_time_(clock->CurrentTime()),
       last_send_time_(last_process_time_),
-      packet_queue_(last_process_time_, field_trials_),
+      burst_window_start_(last_process_time_),
+      max_burst_size_(DataSize::Zero()),
+      previous_max_burst_size_(DataSize::Zero()),
+      packet_queue_(CreatePacketQueue(last_process_time_, *field_trials_)),
       packet_counter_(0),
       congestion_window_size_(DataSize::PlusInfinity()),
       outstanding_data_(DataSize::Zero()),
@@ -154,14 +196,14 @@ void PacingController::Pause() {
   if (!paused_)
     RTC_LOG(LS_INFO) << "PacedSender paused.";
   paused_ = true;
-  packet_queue_.SetPauseState(true, CurrentTime());
+  packet_queue_->SetPauseState(true, CurrentTime());
 }
 
 void PacingController::Resume() {
   if (paused_)
     RTC_LOG(LS_INFO) << "PacedSender resumed.";
   paused_ = false;
-  packet_queue_.SetPauseState(false, CurrentTime());
+  packet_queue_->SetPauseState(false, CurrentTime());
 }
 
 bool PacingController::IsPaused() const {
@@ -240,14 +282,14 @@ void PacingController::SetAccountForAudioPackets(bool account_for_audio) {
 
 void PacingController::SetIncludeOverhead() {
   include_overhead_ = true;
-  packet_queue_.SetIncludeOverhead();
+  packet_queue_->SetIncludeOverhead();
 }
 
 void PacingController::SetTransportOverhead(DataSize overhead_per_packet) {
   if (ignore_transport_overhead_)
     return;
   transport_overhead_per_packet_ = overhead_per_packet;
-  packet_queue_.SetTransportOverhead(overhead_per_packet);
+  packet_queue_->SetTransportOverhead(overhead_per_packet);
 }
 
 TimeDelta PacingController::ExpectedQueueTime() const {
@@ -258,23 +300,34 @@ TimeDelta PacingController::ExpectedQueueTime() const {
 }
 
 size_t PacingController::QueueSizePackets() const {
-  return packet_queue_.SizeInPackets();
+  return packet_queue_->SizeInPackets();
 }
 
 DataSize PacingController::QueueSizeData() const {
-  return packet_queue_.Size();
+  return packet_queue_->Size();
 }
 
 DataSize PacingController::CurrentBufferLevel() const {
   return std::max(media_debt_, padding_debt_);
 }
 
+DataSize PacingController::MaxBurstSize() const {
+  TimeDelta time_in_window = CurrentTime() - burst_window_start_;
+  if (time_in_window >= 2 * kBurstStatsWindow) {
+    return DataSize::Zero();
+  }
+  if (time_in_window >= kBurstStatsWindow) {
+    return max_burst_size_;
+  }
+  return std::max(max_burst_size_, previous_max_burst_size_);
+}
+
 absl::optional<Timestamp> PacingController::FirstSentPacketTime() const {
   return first_sent_packet_time_;
 }
 
 TimeDelta PacingController::OldestPacketWaitTime() const {
-  Timestamp oldest_packet = packet_queue_.OldestEnqueueTime();
+  Timestamp oldest_packet = packet_queue_->OldestEnqueueTime();
   if (oldest_packet.IsInfinite()) {
     return TimeDelta::Zero();
   }
@@ -293,12 +346,12 @@ void PacingController::EnqueuePacketInternal(
     packet->set_capture_time_ms(now.ms());
   }
 
-  if (mode_ == ProcessMode::kDynamic && packet_queue_.Empty() &&
+  if (mode_ == ProcessMode::kDynamic && packet_queue_->Empty() &&
       NextSendTime() <= now) {
     TimeDelta elapsed_time = UpdateTimeAndGetElapsed(now);
     UpdateBudgetWithElapsedTime(elapsed_time);
   }
-  packet_queue_.Push(priority, now, packet_counter_++, std::move(packet));
+  packet_queue_->Push(priority, now, packet_counter_++, std::move(packet));
 }
 
 TimeDelta PacingController::UpdateTimeAndGetElapsed(Timestamp now) {
@@ -358,7 +411,7 @@ Timestamp PacingController::NextSendTime() const {
     // Not pacing audio, if leading packet is audio its target send
     // time is the time at which it was enqueued.
     absl::optional<Timestamp> audio_enqueue_time =
-        packet_queue_.LeadingAudioPacketEnqueueTime();
+        packet_queue_->LeadingAudioPacketEnqueueTime();
     if (audio_enqueue_time.has_value()) {
       return *audio_enqueue_time;
     }
@@ -370,7 +423,7 @@ Timestamp PacingController::NextSendTime() const {
   }
 
   // Check how long until we can send the next media packet.
-  if (media_rate_ > DataRate::Zero() && !packet_queue_.Empty()) {
+  if (media_rate_ > DataRate::Zero() && !packet_queue_->Empty()) {
     return std::min(last_send_time_ + kPausedProcessInterval,
                     last_process_time_ + media_debt_ / media_rate_);
   }
@@ -378,7 +431,7 @@ Timestamp PacingController::NextSendTime() const {
   // If we _don't_ have pending packets, check how long until we have
   // bandwidth for padding packets. Both media and padding debts must
   // have been drained to do this.
-  if (padding_rate_ > DataRate::Zero() && packet_queue_.Empty()) {
+  if (padding_rate_ > DataRate::Zero() && packet_queue_->Empty()) {
     TimeDelta drain_time =
         std::max(media_debt_ / media_rate_, padding_debt_ / padding_rate_);
     return std::min(last_send_time_ + kPausedProcessInterval,
@@ -391,6 +444,10 @@ Timestamp PacingController::NextSendTime() const {
   return last_process_time_ + kPausedProcessInterval;
 }
 
+TimeDelta PacingController::MinSleepTime() const {
+  return high_resolution_.enabled ? high_resolution_.min_sleep : kMinSleepTime;
+}
+
 void PacingController::ProcessPackets() {
   Timestamp now = CurrentTime();
   Timestamp target_send_time = now;
@@ -446,16 +503,16 @@ void PacingController::ProcessPackets() {
 
   if (elapsed_time > TimeDelta::Zero()) {
     DataRate target_rate = pacing_bitrate_;
-    DataSize queue_size_data = packet_queue_.Size();
+    DataSize queue_size_data = packet_queue_->Size();
     if (queue_size_data > DataSize::Zero()) {
       // Assuming equal size packets and input/output rate, the average packet
       // has avg_time_left_ms left to get queue_size_bytes out of the queue, if
       // time constraint shall be met. Determine bitrate needed for that.
-      packet_queue_.UpdateQueueTime(now);
+      packet_queue_->UpdateQueueTime(now);
       if (drain_large_queues_) {
         TimeDelta avg_time_left =
             std::max(TimeDelta::Millis(1),
-                     queue_time_limit - packet_queue_.AverageQueueTime());
+                     queue_time_limit - packet_queue_->AverageQueueTime());
         DataRate min_rate_needed = queue_size_data / avg_time_left;
         if (min_rate_needed > target_rate) {
           target_rate = min_rate_needed;
@@ -483,10 +540,15 @@ void PacingController::ProcessPackets() {
   if (is_probing) {
     pacing_info = prober_.CurrentCluster();
     first_packet_in_probe = pacing_info.probe_cluster_bytes_sent == 0;
-    recommended_probe_size = DataSize::Bytes(prober_.RecommendedMinProbeSize());
+    recommended_probe_size = DataSize::Bytes(prober_.RecommendedProbeSize(now));
   }
 
   DataSize data_sent = DataSize::Zero();
+  std::vector<std::unique_ptr<RtpPacketToSend>> batch;
+  // A probe sent as a packet train leaves in one batch, so that its packets
+  // are spaced by the network rather than by how fast they are sent.
+  const bool send_as_batch =
+      batch_send_ || (is_probing && prober_.sends_packet_trains());
 
   // The paused state is checked in the loop since it leaves the critical
   // section allowing the paused state to be changed from other code.
@@ -494,6 +556,7 @@ void PacingController::ProcessPackets() {
     if (small_first_probe_packet_ && first_packet_in_probe) {
       // If first packet in probe, insert a small padding packet so we have a
       // more reliable start window for the rate estimation.
+      SendBatch(&batch, pacing_info);
       auto padding = packet_sender_->GeneratePadding(DataSize::Bytes(1));
       // If no RTP modules sending media are registered, we may not get a
       // padding packet back.
@@ -517,6 +580,12 @@ void PacingController::ProcessPackets() {
       previous_process_time = target_send_time;
     }
 
+    if (!is_probing && BurstLimitReached(data_sent)) {
+      // Leave the remaining packets to the next process call, which the
+      // owner schedules MinSleepTime() from now.
+      break;
+    }
+
     // Fetch the next packet, so long as queue is not empty or budget is not
     // exhausted.
     std::unique_ptr<RtpPacketToSend> rtp_packet =
@@ -526,6 +595,8 @@ void PacingController::ProcessPackets() {
       // No packet available to send, check if we should send padding.
       DataSize padding_to_add = PaddingToAdd(recommended_probe_size, data_sent);
       if (padding_to_add > DataSize::Zero()) {
+        // Padding may be generated from the packets just sent.
+        SendBatch(&batch, pacing_info);
         std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets =
             packet_sender_->GeneratePadding(padding_to_add);
         if (padding_packets.empty()) {
@@ -553,7 +624,11 @@ void PacingController::ProcessPackets() {
       packet_size += DataSize::Bytes(rtp_packet->headers_size()) +
                      transport_overhead_per_packet_;
     }
-    packet_sender_->SendRtpPacket(std::move(rtp_packet), pacing_info);
+    if (send_as_batch) {
+      batch.push_back(std::move(rtp_packet));
+    } else {
+      packet_sender_->SendRtpPacket(std::move(rtp_packet), pacing_info);
+    }
 
     data_sent += packet_size;
 
@@ -574,8 +649,13 @@ void PacingController::ProcessPackets() {
     }
   }
 
+  SendBatch(&batch, pacing_info);
   last_process_time_ = std::max(last_process_time_, previous_process_time);
 
+  if (!is_probing && data_sent > DataSize::Zero()) {
+    OnBurstSent(data_sent, now);
+  }
+
   if (is_probing) {
     probing_send_failure_ = data_sent == DataSize::Zero();
     if (!probing_send_failure_) {
@@ -584,10 +664,19 @@ void PacingController::ProcessPackets() {
   }
 }
 
+void PacingController::SendBatch(
+    std::vector<std::unique_ptr<RtpPacketToSend>>* batch,
+    const PacedPacketInfo& pacing_info) {
+  if (batch->empty())
+    return;
+  packet_sender_->SendRtpPackets(std::move(*batch), pacing_info);
+  batch->clear();
+}
+
 DataSize PacingController::PaddingToAdd(
     absl::optional<DataSize> recommended_probe_size,
     DataSize data_sent) const {
-  if (!packet_queue_.Empty()) {
+  if (!packet_queue_->Empty()) {
     // Actual payload available, no need to add padding.
     return DataSize::Zero();
   }
@@ -623,7 +712,7 @@ std::unique_ptr<RtpPacketToSend> PacingController::GetPendingPacket(
     const PacedPacketInfo& pacing_info,
     Timestamp target_send_time,
     Timestamp now) {
-  if (packet_queue_.Empty()) {
+  if (packet_queue_->Empty()) {
     return nullptr;
   }
 
@@ -631,7 +720,7 @@ std::unique_ptr<RtpPacketToSend> PacingController::GetPendingPacket(
 
   // Unpaced audio packets and probes are exempted from send checks.
   bool unpaced_audio_packet =
-      !pace_audio_ && packet_queue_.LeadingAudioPacketEnqueueTime().has_value();
+      !pace_audio_ && packet_queue_->LeadingAudioPacketEnqueueTime().has_value();
   bool is_probe = pacing_info.probe_cluster_id != PacedPacketInfo::kNotAProbe;
   if (!unpaced_audio_packet && !is_probe) {
     if (Congested()) {
@@ -658,7 +747,7 @@ std::unique_ptr<RtpPacketToSend> PacingController::GetPendingPacket(
     }
   }
 
-  return packet_queue_.Pop();
+  return packet_queue_->Pop();
 }
 
 void PacingController::OnPacketSent(RtpPacketMediaType packet_type,
@@ -684,6 +773,30 @@ void PacingController::OnPaddingSent(DataSize data_sent) {
   last_process_time_ = CurrentTime();
 }
 
+void PacingController::OnBurstSent(DataSize burst_size, Timestamp now) {
+  TimeDelta time_in_window = now - burst_window_start_;
+  if (time_in_window >= kBurstStatsWindow) {
+    previous_max_burst_size_ = time_in_window >= 2 * kBurstStatsWindow
+                                   ? DataSize::Zero()
+                                   : max_burst_size_;
+    max_burst_size_ = DataSize::Zero();
+    burst_window_start_ = now;
+  }
+  max_burst_size_ = std::max(max_burst_size_, burst_size);
+}
+
+bool PacingController::BurstLimitReached(DataSize data_sent) const {
+  if (!high_resolution_.enabled || data_sent.IsZero()) {
+    return false;
+  }
+  if (!pace_audio_ &&
+      packet_queue_->LeadingAudioPacketEnqueueTime().has_value()) {
+    // Unpaced audio is never held back.
+    return false;
+  }
+  return data_sent >= media_rate_ * high_resolution_.max_burst;
+}
+
 void PacingController::UpdateBudgetWithElapsedTime(TimeDelta delta) {
   if (mode_ == ProcessMode::kPeriodic) {
     delta = std::min(kMaxProcessingInterval, delta);
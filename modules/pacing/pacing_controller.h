@@ -26,7 +26,7 @@
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
-#include "modules/pacing/round_robin_packet_queue.h"
+#include "modules/pacing/pacer_packet_queue.h"
 #include "modules/pacing/rtp_packet_pacer.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -57,6 +57,14 @@ class PacingController {
     virtual ~PacketSender() = default;
     virtual void SendRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
                                const PacedPacketInfo& cluster_info) = 0;
+    // Sends the packets of a burst in order. Only used if the
+    // "WebRTC-Pacer-BatchSend" field trial is enabled.
+    virtual void SendRtpPackets(
+        std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+        const PacedPacketInfo& cluster_info) {
+      for (auto& packet : packets)
+        SendRtpPacket(std::move(packet), cluster_info);
+    }
     virtual std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
         DataSize size) = 0;
   };
@@ -123,6 +131,10 @@ class PacingController {
   // Current buffer level, i.e. max of media and padding debt.
   DataSize CurrentBufferLevel() const;
 
+  // Largest amount of data sent by a single ProcessPackets() call, probes
+  // excluded, during the last one to two seconds.
+  DataSize MaxBurstSize() const;
+
   // Returns the time when the first packet was sent;
   absl::optional<Timestamp> FirstSentPacketTime() const;
 
@@ -140,6 +152,10 @@ class PacingController {
   // Returns the next time we expect ProcessPackets() to be called.
   Timestamp NextSendTime() const;
 
+  // Shortest time the owner should wait between two ProcessPackets() calls.
+  // kMinSleepTime unless the "WebRTC-Pacer-HighResolution" trial is enabled.
+  TimeDelta MinSleepTime() const;
+
   // Check queue of pending packets and send them or padding packets, if budget
   // is available.
   void ProcessPackets();
@@ -147,6 +163,19 @@ class PacingController {
   bool Congested() const;
 
  private:
+  // Dynamic mode pacing at microsecond granularity, e.g.
+  // "WebRTC-Pacer-HighResolution/Enabled,min_sleep:250us,max_burst:1ms/".
+  // Process calls may be scheduled |min_sleep| apart, and a late call sends at
+  // most |max_burst| times the pacing rate instead of catching up at once.
+  struct HighResolutionConfig {
+    HighResolutionConfig(const WebRtcKeyValueConfig& field_trials,
+                         ProcessMode mode);
+
+    bool enabled;
+    TimeDelta min_sleep;
+    TimeDelta max_burst;
+  };
+
   void EnqueuePacketInternal(std::unique_ptr<RtpPacketToSend> packet,
                              int priority);
   TimeDelta UpdateTimeAndGetElapsed(Timestamp now);
@@ -167,6 +196,12 @@ class PacingController {
                     DataSize packet_size,
                     Timestamp send_time);
   void OnPaddingSent(DataSize padding_sent);
+  void OnBurstSent(DataSize burst_size, Timestamp now);
+  // True if the high resolution mode stops sending more in this call.
+  bool BurstLimitReached(DataSize data_sent) const;
+  // Hands the packets collected in |batch| to the PacketSender, if any.
+  void SendBatch(std::vector<std::unique_ptr<RtpPacketToSend>>* batch,
+                 const PacedPacketInfo& pacing_info);
 
   Timestamp CurrentTime() const;
 
@@ -181,9 +216,13 @@ class PacingController {
   const bool pace_audio_;
   const bool small_first_probe_packet_;
   const bool ignore_transport_overhead_;
+  // Collects the packets sent by one ProcessPackets() call and hands them to
+  // the PacketSender together, so that they can be sent in one syscall.
+  const bool batch_send_;
   // In dynamic mode, indicates the target size when requesting padding,
   // expressed as a duration in order to adjust for varying padding rate.
   const TimeDelta padding_target_duration_;
+  const HighResolutionConfig high_resolution_;
 
   TimeDelta min_packet_limit_;
 
@@ -220,7 +259,12 @@ class PacingController {
   Timestamp last_send_time_;
   absl::optional<Timestamp> first_sent_packet_time_;
 
-  RoundRobinPacketQueue packet_queue_;
+  // Largest burst since |burst_window_start_| and in the window before that.
+  Timestamp burst_window_start_;
+  DataSize max_burst_size_;
+  DataSize previous_max_burst_size_;
+
+  const std::unique_ptr<PacerPacketQueue> packet_queue_;
   uint64_t packet_counter_;
 
   DataSize congestion_window_size_;
@@ -105,6 +105,9 @@ class MockPacketSender : public PacingController::PacketSender {
   MOCK_METHOD2(SendRtpPacket,
                void(std::unique_ptr<RtpPacketToSend> packet,
                     const PacedPacketInfo& cluster_info));
+  MOCK_METHOD2(SendRtpPackets,
+               void(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                    const PacedPacketInfo& cluster_info));
   MOCK_METHOD1(
       GeneratePadding,
       std::vector<std::unique_ptr<RtpPacketToSend>>(DataSize target_size));
@@ -1656,6 +1659,136 @@ TEST_P(PacingControllerTest, OwnedPacketPrioritizedOnType) {
   }
 }
 
+TEST_P(PacingControllerTest, BatchesPacketsSentTogether) {
+  ScopedFieldTrials trial("WebRTC-Pacer-BatchSend/Enabled/");
+  MockPacketSender callback;
+  pacer_ = std::make_unique<PacingController>(&clock_, &callback, nullptr,
+                                              nullptr, GetParam());
+  pacer_->SetPacingRates(DataRate::KilobitsPerSec(10000), DataRate::Zero());
+
+  const size_t kNumPackets = 5;
+  for (size_t i = 0; i < kNumPackets; ++i)
+    pacer_->EnqueuePacket(BuildRtpPacket(RtpPacketMediaType::kVideo));
+
+  // The packets are late, expect all of them in a single batch.
+  EXPECT_CALL(callback, SendRtpPacket).Times(0);
+  EXPECT_CALL(callback, SendRtpPackets)
+      .WillOnce([&](std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                    const PacedPacketInfo& cluster_info) {
+        EXPECT_EQ(packets.size(), kNumPackets);
+      });
+  clock_.AdvanceTimeMilliseconds(5);
+  pacer_->ProcessPackets();
+  EXPECT_EQ(pacer_->QueueSizePackets(), 0u);
+}
+
+TEST_P(PacingControllerTest, SendsProbesAsPacketTrains) {
+  ScopedFieldTrials trial("WebRTC-Bwe-ProbingConfiguration/packet_trains/");
+  MockPacketSender callback;
+  pacer_ = std::make_unique<PacingController>(&clock_, &callback, nullptr,
+                                              nullptr, GetParam());
+  pacer_->CreateProbeCluster(kSecondClusterRate, /*cluster_id=*/0);
+  pacer_->SetPacingRates(kTargetRate * kPaceMultiplier, DataRate::Zero());
+  for (uint16_t sequence_number = 0; sequence_number < 50; ++sequence_number) {
+    pacer_->EnqueuePacket(BuildPacket(RtpPacketMediaType::kVideo, kVideoSsrc,
+                                      sequence_number,
+                                      clock_.TimeInMilliseconds(), 200));
+  }
+
+  // Each probe is handed over in one batch, even without batch sending.
+  EXPECT_CALL(callback, SendRtpPacket).Times(::testing::AnyNumber());
+  EXPECT_CALL(callback,
+              SendRtpPacket(_, Field(&PacedPacketInfo::probe_cluster_id, 0)))
+      .Times(0);
+  DataSize probe_data_sent = DataSize::Zero();
+  DataSize last_packet_size = DataSize::Zero();
+  Timestamp first_probe_time = Timestamp::MinusInfinity();
+  Timestamp last_probe_time = Timestamp::MinusInfinity();
+  EXPECT_CALL(callback, SendRtpPackets)
+      .WillRepeatedly(
+          [&](std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+              const PacedPacketInfo& cluster_info) {
+            EXPECT_EQ(cluster_info.probe_cluster_id, 0);
+            if (first_probe_time.IsInfinite())
+              first_probe_time = clock_.CurrentTime();
+            last_probe_time = clock_.CurrentTime();
+            for (const auto& packet : packets) {
+              last_packet_size = DataSize::Bytes(packet->payload_size());
+              probe_data_sent += last_packet_size;
+            }
+          });
+
+  // Processed every 5 ms, too rarely to send the 1 ms probes on time.
+  for (int i = 0; i < 20; ++i) {
+    pacer_->ProcessPackets();
+    clock_.AdvanceTimeMilliseconds(5);
+  }
+
+  // The late probes make up for it, so that the cluster keeps its bitrate.
+  ASSERT_GT(last_probe_time, first_probe_time);
+  EXPECT_NEAR(((probe_data_sent - last_packet_size) /
+               (last_probe_time - first_probe_time))
+                  .bps(),
+              kSecondClusterRate.bps(), kProbingErrorMargin.bps());
+}
+
+TEST_P(PacingControllerTest, ReportsMaxBurstSize) {
+  MockPacketSender callback;
+  pacer_ = std::make_unique<PacingController>(&clock_, &callback, nullptr,
+                                              nullptr, GetParam());
+  pacer_->SetPacingRates(DataRate::KilobitsPerSec(8000), DataRate::Zero());
+  EXPECT_EQ(pacer_->MaxBurstSize(), DataSize::Zero());
+
+  size_t packets_sent = 0;
+  EXPECT_CALL(callback, SendRtpPacket).WillRepeatedly([&] { ++packets_sent; });
+  for (uint16_t sequence_number = 0; sequence_number < 20; ++sequence_number) {
+    pacer_->EnqueuePacket(BuildPacket(RtpPacketMediaType::kVideo, kVideoSsrc,
+                                      sequence_number,
+                                      clock_.TimeInMilliseconds(), 1000));
+  }
+  clock_.AdvanceTimeMilliseconds(5);
+  pacer_->ProcessPackets();
+  ASSERT_GT(packets_sent, 1u);
+  EXPECT_EQ(pacer_->MaxBurstSize(), DataSize::Bytes(1000 * packets_sent));
+
+  // Bursts are forgotten after at most two seconds.
+  clock_.AdvanceTimeMilliseconds(2000);
+  EXPECT_EQ(pacer_->MaxBurstSize(), DataSize::Zero());
+}
+
+TEST_P(PacingControllerTest, HighResolutionSpreadsLateBurst) {
+  if (PeriodicProcess()) {
+    // Only applies to dynamic mode.
+    return;
+  }
+  ScopedFieldTrials trial(
+      "WebRTC-Pacer-HighResolution/Enabled,min_sleep:250us,max_burst:2ms/");
+  MockPacketSender callback;
+  pacer_ = std::make_unique<PacingController>(&clock_, &callback, nullptr,
+                                              nullptr, GetParam());
+  EXPECT_EQ(pacer_->MinSleepTime(), TimeDelta::Micros(250));
+  // One 1000 byte packet per millisecond.
+  pacer_->SetPacingRates(DataRate::KilobitsPerSec(8000), DataRate::Zero());
+  for (uint16_t sequence_number = 0; sequence_number < 20; ++sequence_number) {
+    pacer_->EnqueuePacket(BuildPacket(RtpPacketMediaType::kVideo, kVideoSsrc,
+                                      sequence_number,
+                                      clock_.TimeInMilliseconds(), 1000));
+  }
+
+  // Ten milliseconds late, but only two milliseconds worth is sent at once.
+  clock_.AdvanceTimeMilliseconds(10);
+  EXPECT_CALL(callback, SendRtpPacket).Times(2);
+  pacer_->ProcessPackets();
+  ::testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(pacer_->MaxBurstSize(), DataSize::Bytes(2000));
+
+  // The rest follows in small bursts, still catching up.
+  EXPECT_LE(pacer_->NextSendTime(), clock_.CurrentTime());
+  EXPECT_CALL(callback, SendRtpPacket).Times(2);
+  clock_.AdvanceTime(pacer_->MinSleepTime());
+  pacer_->ProcessPackets();
+}
+
 TEST_P(PacingControllerTest, SmallFirstProbePacket) {
   ScopedFieldTrials trial("WebRTC-Pacer-SmallFirstProbePacket/Enabled/");
   MockPacketSender callback;
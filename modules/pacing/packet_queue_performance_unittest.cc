@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/pacing/intrusive_packet_queue.h"
+#include "modules/pacing/pacer_packet_queue.h"
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr Timestamp kStartTime = Timestamp::Millis(123456);
+constexpr int kPacketsPerStream = 32;
+constexpr int kPacketsPerRound = 3200;
+constexpr int kRounds = 200;
+
+struct QueueTimes {
+  double push_ns;
+  double pop_ns;
+};
+
+// Returns the average times in nanoseconds of a Push() and of a Pop() with a
+// queue that holds |kPacketsPerStream| packets of each of |num_streams|
+// streams. A tenth of the packets are retransmissions, so that the queues have
+// to reorder packets within a stream too.
+QueueTimes MeasureQueueTimesNs(PacerPacketQueue* queue, int num_streams) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  const int packets_per_batch = num_streams * kPacketsPerStream;
+  for (int i = 0; i < packets_per_batch; ++i) {
+    auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+    packet->set_packet_type(i % 10 == 0 ? RtpPacketMediaType::kRetransmission
+                                        : RtpPacketMediaType::kVideo);
+    packet->SetSsrc(1000 + i % num_streams);
+    packet->SetSequenceNumber(i / num_streams);
+    packet->SetPayloadSize(1000 + i % 200);
+    packets.push_back(std::move(packet));
+  }
+
+  Timestamp now = kStartTime;
+  uint64_t enqueue_order = 0;
+  int64_t push_time_ns = 0;
+  int64_t pop_time_ns = 0;
+  int64_t pops = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    for (int pushed = 0; pushed < kPacketsPerRound;
+         pushed += packets_per_batch) {
+      // The queue is filled with one packet of every stream at a time and then
+      // drained.
+      int64_t start_ns = rtc::TimeNanos();
+      for (auto& packet : packets) {
+        int priority = packet->packet_type() ==
+                               RtpPacketMediaType::kRetransmission
+                           ? 2
+                           : 3;
+        queue->Push(priority, now, enqueue_order++, std::move(packet));
+      }
+      push_time_ns += rtc::TimeNanos() - start_ns;
+      now += TimeDelta::Millis(1);
+      queue->UpdateQueueTime(now);
+
+      start_ns = rtc::TimeNanos();
+      for (auto& packet : packets) {
+        packet = queue->Pop();
+      }
+      pop_time_ns += rtc::TimeNanos() - start_ns;
+      pops += packets_per_batch;
+    }
+  }
+  EXPECT_TRUE(queue->Empty());
+  return {static_cast<double>(push_time_ns) / pops,
+          static_cast<double>(pop_time_ns) / pops};
+}
+
+void RunQueueBenchmark(int num_streams) {
+  RoundRobinPacketQueue round_robin_queue(kStartTime, nullptr);
+  IntrusivePacketQueue intrusive_queue(kStartTime, nullptr);
+  const std::string streams = std::to_string(num_streams) + "_streams";
+  const QueueTimes round_robin_times =
+      MeasureQueueTimesNs(&round_robin_queue, num_streams);
+  const QueueTimes intrusive_times =
+      MeasureQueueTimesNs(&intrusive_queue, num_streams);
+  test::PrintResult("pacer_queue_push_time", "", "round_robin_" + streams,
+                    round_robin_times.push_ns, "ns", false);
+  test::PrintResult("pacer_queue_push_time", "", "intrusive_" + streams,
+                    intrusive_times.push_ns, "ns", false);
+  test::PrintResult("pacer_queue_pop_time", "", "round_robin_" + streams,
+                    round_robin_times.pop_ns, "ns", false);
+  test::PrintResult("pacer_queue_pop_time", "", "intrusive_" + streams,
+                    intrusive_times.pop_ns, "ns", false);
+}
+
+// The push times are reported by the same tests.
+TEST(PacerPacketQueuePerformanceTest, PopTimeWith1Stream) {
+  RunQueueBenchmark(1);
+}
+
+TEST(PacerPacketQueuePerformanceTest, PopTimeWith10Streams) {
+  RunQueueBenchmark(10);
+}
+
+TEST(PacerPacketQueuePerformanceTest, PopTimeWith100Streams) {
+  RunQueueBenchmark(100);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -166,6 +166,16 @@ void PacketRouter::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
   }
 }
 
+void PacketRouter::SendPackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+    const PacedPacketInfo& cluster_info) {
+  for (size_t i = 0; i < packets.size(); ++i) {
+    packets[i]->set_batchable(true);
+    packets[i]->set_last_packet_in_batch(i + 1 == packets.size());
+    SendPacket(std::move(packets[i]), cluster_info);
+  }
+}
+
 std::vector<std::unique_ptr<RtpPacketToSend>> PacketRouter::GeneratePadding(
     size_t target_size_bytes) {
   rtc::CritScope cs(&modules_crit_);
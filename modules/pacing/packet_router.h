@@ -54,6 +54,10 @@ class PacketRouter : public RemoteBitrateObserver,
 
   virtual void SendPacket(std::unique_ptr<RtpPacketToSend> packet,
                           const PacedPacketInfo& cluster_info);
+  // Sends a burst of packets in order, marking them so that the transport
+  // may send them together once the last one arrives.
+  void SendPackets(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                   const PacedPacketInfo& cluster_info);
 
   virtual std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       size_t target_size_bytes);
@@ -34,6 +34,7 @@ namespace webrtc {
 namespace {
 
 using ::testing::_;
+using ::testing::AllOf;
 using ::testing::AnyNumber;
 using ::testing::AtLeast;
 using ::testing::Field;
@@ -360,6 +361,36 @@ TEST_F(PacketRouterTest, SendPacketWithoutTransportSequenceNumbers) {
   packet_router_.RemoveSendRtpModule(&rtp_1);
 }
 
+TEST_F(PacketRouterTest, SendPacketsMarksLastPacketInBatch) {
+  const uint16_t kSsrc1 = 1234;
+  NiceMock<MockRtpRtcp> rtp_1;
+  ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  for (int i = 0; i < 3; ++i) {
+    packets.push_back(std::make_unique<RtpPacketToSend>(nullptr));
+    packets.back()->SetSsrc(kSsrc1);
+  }
+  ::testing::InSequence in_sequence;
+  EXPECT_CALL(rtp_1, TrySendPacket(
+                         AllOf(Property(&RtpPacketToSend::batchable, true),
+                               Property(&RtpPacketToSend::last_packet_in_batch,
+                                        false)),
+                         _))
+      .Times(2)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(rtp_1, TrySendPacket(
+                         AllOf(Property(&RtpPacketToSend::batchable, true),
+                               Property(&RtpPacketToSend::last_packet_in_batch,
+                                        true)),
+                         _))
+      .WillOnce(Return(true));
+  packet_router_.SendPackets(std::move(packets), PacedPacketInfo());
+
+  packet_router_.RemoveSendRtpModule(&rtp_1);
+}
+
 TEST_F(PacketRouterTest, SendPacketAssignsTransportSequenceNumbers) {
   NiceMock<MockRtpRtcp> rtp_1;
   NiceMock<MockRtpRtcp> rtp_2;
@@ -49,6 +49,10 @@ class RtpPacketPacer {
   // Returns the time when the first packet was sent.
   virtual absl::optional<Timestamp> FirstSentPacketTime() const = 0;
 
+  // Largest amount of data sent back to back, probes excluded, during the
+  // last one to two seconds.
+  virtual DataSize MaxBurstSize() const = 0;
+
   // Returns the expected number of milliseconds it will take to send the
   // current packets in the queue, given the current size and bitrate, ignoring
   // priority.
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacing_thread.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+constexpr TimeDelta SharedPacingThread::kDefaultResolution;
+
+SharedPacingThread* SharedPacingThread::GetDefault() {
+  static TaskQueueFactory* const task_queue_factory =
+      CreateDefaultTaskQueueFactory().release();
+  static SharedPacingThread* const thread = new SharedPacingThread(
+      Clock::GetRealTimeClock(), task_queue_factory, kDefaultResolution);
+  return thread;
+}
+
+SharedPacingThread::SharedPacingThread(Clock* clock,
+                                       TaskQueueFactory* task_queue_factory,
+                                       TimeDelta resolution)
+    : clock_(clock),
+      wheel_(clock->CurrentTime(), resolution),
+      next_timer_time_(Timestamp::PlusInfinity()),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "SharedPacingThread",
+          TaskQueueFactory::Priority::HIGH)) {}
+
+SharedPacingThread::~SharedPacingThread() = default;
+
+void SharedPacingThread::ScheduleWakeup(Client* client, Timestamp at) {
+  RTC_DCHECK_RUN_ON(&task_queue_);
+  wheel_.Schedule(client, at);
+  MaybePostTimer();
+}
+
+void SharedPacingThread::CancelWakeup(Client* client) {
+  RTC_DCHECK_RUN_ON(&task_queue_);
+  wheel_.Cancel(client);
+}
+
+void SharedPacingThread::MaybePostTimer() {
+  if (running_clients_)
+    return;
+  Timestamp next_expiry = wheel_.NextExpiry();
+  if (next_expiry.IsPlusInfinity() || next_expiry >= next_timer_time_)
+    return;
+  next_timer_time_ = next_expiry;
+  // Round up, the timer must not fire before the wheel expires anything.
+  int64_t delay_us =
+      std::max<int64_t>((next_expiry - clock_->CurrentTime()).us(), 0);
+  task_queue_.PostDelayedTask(
+      [this, next_expiry]() {
+        RTC_DCHECK_RUN_ON(&task_queue_);
+        OnTimer(next_expiry);
+      },
+      static_cast<uint32_t>((delay_us + 999) / 1000));
+}
+
+void SharedPacingThread::OnTimer(Timestamp scheduled_time) {
+  if (scheduled_time != next_timer_time_)
+    return;
+  next_timer_time_ = Timestamp::PlusInfinity();
+  due_clients_.clear();
+  wheel_.Advance(clock_->CurrentTime(), &due_clients_);
+  running_clients_ = true;
+  for (Client* client : due_clients_)
+    client->OnWakeup();
+  running_clients_ = false;
+  MaybePostTimer();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_SHARED_PACING_THREAD_H_
+#define MODULES_PACING_SHARED_PACING_THREAD_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/pacer_timer_wheel.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+class Clock;
+
+// Runs the wakeups of many pacers on a single task queue. Instead of each
+// pacer posting its own delayed tasks, wakeups are kept in a timer wheel and
+// the task queue only sleeps until the earliest of them. All pacers due in
+// the same tick of |resolution| are then run in one batch, so that a process
+// pacing hundreds of calls wakes up at most once per tick.
+class SharedPacingThread {
+ public:
+  class Client {
+   public:
+    // Called on task_queue() once the time passed to ScheduleWakeup() is
+    // reached.
+    virtual void OnWakeup() = 0;
+
+   protected:
+    virtual ~Client() = default;
+  };
+
+  static constexpr TimeDelta kDefaultResolution = TimeDelta::Millis(1);
+
+  // Process wide instance on the real time clock, created on first use and
+  // never destroyed.
+  static SharedPacingThread* GetDefault();
+
+  SharedPacingThread(Clock* clock,
+                     TaskQueueFactory* task_queue_factory,
+                     TimeDelta resolution);
+  ~SharedPacingThread();
+
+  SharedPacingThread(const SharedPacingThread&) = delete;
+  SharedPacingThread& operator=(const SharedPacingThread&) = delete;
+
+  rtc::TaskQueue* task_queue() { return &task_queue_; }
+
+  // Must be called on task_queue(). Replaces the pending wakeup of |client|,
+  // if any. Wakeups are never run before |at|, but up to one tick after it.
+  void ScheduleWakeup(Client* client, Timestamp at);
+  void CancelWakeup(Client* client);
+
+ private:
+  void MaybePostTimer() RTC_RUN_ON(task_queue_);
+  void OnTimer(Timestamp scheduled_time) RTC_RUN_ON(task_queue_);
+
+  Clock* const clock_;
+  PacerTimerWheel<Client*> wheel_ RTC_GUARDED_BY(task_queue_);
+  // Time of the earliest delayed task in flight, PlusInfinity() if none.
+  // Tasks posted for another time have been superseded and do nothing.
+  Timestamp next_timer_time_ RTC_GUARDED_BY(task_queue_);
+  // Set while the due clients run, which reschedule themselves.
+  bool running_clients_ RTC_GUARDED_BY(task_queue_) = false;
+  // Reused between batches.
+  std::vector<Client*> due_clients_ RTC_GUARDED_BY(task_queue_);
+
+  // Declared last so that pending tasks are stopped before the members they
+  // access are destroyed.
+  rtc::TaskQueue task_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_SHARED_PACING_THREAD_H_
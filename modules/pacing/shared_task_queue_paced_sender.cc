@@ -0,0 +1,255 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_task_queue_paced_sender.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+
+namespace webrtc {
+namespace {
+// If no calls to MaybeProcessPackets() happen, make sure we update stats
+// at least every |kMaxTimeBetweenStatsUpdates| as long as the pacer isn't
+// completely drained.
+constexpr TimeDelta kMaxTimeBetweenStatsUpdates = TimeDelta::Millis(33);
+// Don't call UpdateStats() more than |kMinTimeBetweenStatsUpdates| apart,
+// for performance reasons.
+constexpr TimeDelta kMinTimeBetweenStatsUpdates = TimeDelta::Millis(1);
+}  // namespace
+
+SharedTaskQueuePacedSender::SharedTaskQueuePacedSender(
+    Clock* clock,
+    PacketRouter* packet_router,
+    RtcEventLog* event_log,
+    const WebRtcKeyValueConfig* field_trials,
+    SharedPacingThread* pacing_thread)
+    : clock_(clock),
+      pacing_thread_(pacing_thread),
+      task_queue_(*pacing_thread->task_queue()),
+      packet_router_(packet_router),
+      pacing_controller_(clock,
+                         static_cast<PacingController::PacketSender*>(this),
+                         event_log,
+                         field_trials,
+                         PacingController::ProcessMode::kDynamic),
+      next_wakeup_(Timestamp::PlusInfinity()),
+      last_stats_time_(Timestamp::MinusInfinity()),
+      is_shutdown_(false) {}
+
+SharedTaskQueuePacedSender::~SharedTaskQueuePacedSender() {
+  RTC_DCHECK(!task_queue_.IsCurrent());
+  // The task queue outlives this pacer, wait for the tasks already posted to
+  // it and remove the pending wakeup.
+  rtc::Event done;
+  task_queue_.PostTask([this, &done]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    is_shutdown_ = true;
+    pacing_thread_->CancelWakeup(this);
+    done.Set();
+  });
+  done.Wait(rtc::Event::kForever);
+}
+
+void SharedTaskQueuePacedSender::CreateProbeCluster(DataRate bitrate,
+                                              int cluster_id) {
+  task_queue_.PostTask([this, bitrate, cluster_id]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.CreateProbeCluster(bitrate, cluster_id);
+    MaybeProcessPackets();
+  });
+}
+
+void SharedTaskQueuePacedSender::Pause() {
+  task_queue_.PostTask([this]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.Pause();
+  });
+}
+
+void SharedTaskQueuePacedSender::Resume() {
+  task_queue_.PostTask([this]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.Resume();
+    MaybeProcessPackets();
+  });
+}
+
+void SharedTaskQueuePacedSender::SetCongestionWindow(
+    DataSize congestion_window_size) {
+  task_queue_.PostTask([this, congestion_window_size]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.SetCongestionWindow(congestion_window_size);
+    MaybeProcessPackets();
+  });
+}
+
+void SharedTaskQueuePacedSender::UpdateOutstandingData(DataSize outstanding_data) {
+  if (task_queue_.IsCurrent()) {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    // Fast path since this can be called once per sent packet while on the
+    // task queue.
+    pacing_controller_.UpdateOutstandingData(outstanding_data);
+    return;
+  }
+
+  task_queue_.PostTask([this, outstanding_data]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.UpdateOutstandingData(outstanding_data);
+    MaybeProcessPackets();
+  });
+}
+
+void SharedTaskQueuePacedSender::SetPacingRates(DataRate pacing_rate,
+                                          DataRate padding_rate) {
+  task_queue_.PostTask([this, pacing_rate, padding_rate]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.SetPacingRates(pacing_rate, padding_rate);
+    MaybeProcessPackets();
+  });
+}
+
+void SharedTaskQueuePacedSender::EnqueuePackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
+  task_queue_.PostTask([this, packets_ = std::move(packets)]() mutable {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    for (auto& packet : packets_) {
+      pacing_controller_.EnqueuePacket(std::move(packet));
+    }
+    MaybeProcessPackets();
+  });
+}
+
+void SharedTaskQueuePacedSender::SetAccountForAudioPackets(bool account_for_audio) {
+  task_queue_.PostTask([this, account_for_audio]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.SetAccountForAudioPackets(account_for_audio);
+  });
+}
+
+void SharedTaskQueuePacedSender::SetIncludeOverhead() {
+  task_queue_.PostTask([this]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.SetIncludeOverhead();
+  });
+}
+
+void SharedTaskQueuePacedSender::SetTransportOverhead(DataSize overhead_per_packet) {
+  task_queue_.PostTask([this, overhead_per_packet]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.SetTransportOverhead(overhead_per_packet);
+  });
+}
+
+void SharedTaskQueuePacedSender::SetQueueTimeLimit(TimeDelta limit) {
+  task_queue_.PostTask([this, limit]() {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    pacing_controller_.SetQueueTimeLimit(limit);
+    MaybeProcessPackets();
+  });
+}
+
+TimeDelta SharedTaskQueuePacedSender::ExpectedQueueTime() const {
+  return GetStats().expected_queue_time;
+}
+
+DataSize SharedTaskQueuePacedSender::QueueSizeData() const {
+  return GetStats().queue_size;
+}
+
+absl::optional<Timestamp> SharedTaskQueuePacedSender::FirstSentPacketTime() const {
+  return GetStats().first_sent_packet_time;
+}
+
+DataSize SharedTaskQueuePacedSender::MaxBurstSize() const {
+  return GetStats().max_burst_size;
+}
+
+TimeDelta SharedTaskQueuePacedSender::OldestPacketWaitTime() const {
+  return GetStats().oldest_packet_wait_time;
+}
+
+void SharedTaskQueuePacedSender::OnWakeup() {
+  next_wakeup_ = Timestamp::PlusInfinity();
+  MaybeProcessPackets();
+}
+
+void SharedTaskQueuePacedSender::MaybeProcessPackets() {
+  if (is_shutdown_) {
+    return;
+  }
+
+  // Wakeups are never early, but several may be merged into one when the
+  // pacer is called in between.
+  Timestamp now = clock_->CurrentTime();
+  if (now >= pacing_controller_.NextSendTime()) {
+    pacing_controller_.ProcessPackets();
+    now = clock_->CurrentTime();
+  }
+  bool pacer_drained = MaybeUpdateStats(now);
+
+  Timestamp next_wakeup = std::max(now + pacing_controller_.MinSleepTime(),
+                                   pacing_controller_.NextSendTime());
+  // Keep updating the stats while there is something in the pacer.
+  if (!pacer_drained) {
+    next_wakeup =
+        std::min(next_wakeup, last_stats_time_ + kMaxTimeBetweenStatsUpdates);
+  }
+  if (next_wakeup != next_wakeup_) {
+    next_wakeup_ = next_wakeup;
+    pacing_thread_->ScheduleWakeup(this, next_wakeup);
+  }
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+SharedTaskQueuePacedSender::GeneratePadding(DataSize size) {
+  return packet_router_->GeneratePadding(size.bytes());
+}
+
+void SharedTaskQueuePacedSender::SendRtpPacket(
+    std::unique_ptr<RtpPacketToSend> packet,
+    const PacedPacketInfo& cluster_info) {
+  packet_router_->SendPacket(std::move(packet), cluster_info);
+}
+
+void SharedTaskQueuePacedSender::SendRtpPackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+    const PacedPacketInfo& cluster_info) {
+  packet_router_->SendPackets(std::move(packets), cluster_info);
+}
+
+bool SharedTaskQueuePacedSender::MaybeUpdateStats(Timestamp now) {
+  bool pacer_drained = pacing_controller_.QueueSizePackets() == 0 &&
+                       pacing_controller_.CurrentBufferLevel().IsZero();
+  if (now - last_stats_time_ < kMinTimeBetweenStatsUpdates) {
+    // Too frequent stats update, return early.
+    return pacer_drained;
+  }
+
+  rtc::CritScope cs(&stats_crit_);
+  current_stats_.expected_queue_time = pacing_controller_.ExpectedQueueTime();
+  current_stats_.first_sent_packet_time =
+      pacing_controller_.FirstSentPacketTime();
+  current_stats_.oldest_packet_wait_time =
+      pacing_controller_.OldestPacketWaitTime();
+  current_stats_.queue_size = pacing_controller_.QueueSizeData();
+  current_stats_.max_burst_size = pacing_controller_.MaxBurstSize();
+  last_stats_time_ = now;
+  return pacer_drained;
+}
+
+SharedTaskQueuePacedSender::Stats SharedTaskQueuePacedSender::GetStats() const {
+  rtc::CritScope cs(&stats_crit_);
+  return current_stats_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_SHARED_TASK_QUEUE_PACED_SENDER_H_
+#define MODULES_PACING_SHARED_TASK_QUEUE_PACED_SENDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/pacing_controller.h"
+#include "modules/pacing/packet_router.h"
+#include "modules/pacing/rtp_packet_pacer.h"
+#include "modules/pacing/shared_pacing_thread.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+class Clock;
+class RtcEventLog;
+
+// Same as TaskQueuePacedSender, but runs on the task queue of a
+// SharedPacingThread together with the other pacers of the process, rather
+// than owning a task queue and posting a delayed task per wakeup. Wakeups are
+// rounded up to the resolution of the thread, so that pacers due in the same
+// tick are processed in a single batch.
+class SharedTaskQueuePacedSender : public RtpPacketPacer,
+                                   public RtpPacketSender,
+                                   private PacingController::PacketSender,
+                                   private SharedPacingThread::Client {
+ public:
+  SharedTaskQueuePacedSender(Clock* clock,
+                             PacketRouter* packet_router,
+                             RtcEventLog* event_log,
+                             const WebRtcKeyValueConfig* field_trials,
+                             SharedPacingThread* pacing_thread);
+
+  // Blocks until the tasks posted to the shared task queue have run, must not
+  // be called on that queue.
+  ~SharedTaskQueuePacedSender() override;
+
+  // Methods implementing RtpPacketSender.
+
+  // Adds the packet to the queue and calls PacketRouter::SendPacket() when
+  // it's time to send.
+  void EnqueuePackets(
+      std::vector<std::unique_ptr<RtpPacketToSend>> packets) override;
+
+  // Methods implementing RtpPacketPacer:
+
+  void CreateProbeCluster(DataRate bitrate, int cluster_id) override;
+
+  // Temporarily pause all sending.
+  void Pause() override;
+
+  // Resume sending packets.
+  void Resume() override;
+
+  void SetCongestionWindow(DataSize congestion_window_size) override;
+  void UpdateOutstandingData(DataSize outstanding_data) override;
+
+  // Sets the pacing rates. Must be called once before packets can be sent.
+  void SetPacingRates(DataRate pacing_rate, DataRate padding_rate) override;
+
+  // Currently audio traffic is not accounted for by pacer and passed through.
+  // With the introduction of audio BWE, audio traffic will be accounted for
+  // in the pacer budget calculation. The audio traffic will still be injected
+  // at high priority.
+  void SetAccountForAudioPackets(bool account_for_audio) override;
+
+  void SetIncludeOverhead() override;
+  void SetTransportOverhead(DataSize overhead_per_packet) override;
+
+  // Returns the time since the oldest queued packet was enqueued.
+  TimeDelta OldestPacketWaitTime() const override;
+
+  // Returns total size of all packets in the pacer queue.
+  DataSize QueueSizeData() const override;
+
+  // Returns the time when the first packet was sent;
+  absl::optional<Timestamp> FirstSentPacketTime() const override;
+
+  DataSize MaxBurstSize() const override;
+
+  // Returns the number of milliseconds it will take to send the current
+  // packets in the queue, given the current size and bitrate, ignoring prio.
+  TimeDelta ExpectedQueueTime() const override;
+
+  // Set the max desired queuing delay, pacer will override the pacing rate
+  // specified by SetPacingRates() if needed to achieve this goal.
+  void SetQueueTimeLimit(TimeDelta limit) override;
+
+ private:
+  struct Stats {
+    Stats()
+        : oldest_packet_wait_time(TimeDelta::Zero()),
+          queue_size(DataSize::Zero()),
+          max_burst_size(DataSize::Zero()),
+          expected_queue_time(TimeDelta::Zero()) {}
+    TimeDelta oldest_packet_wait_time;
+    DataSize queue_size;
+    DataSize max_burst_size;
+    TimeDelta expected_queue_time;
+    absl::optional<Timestamp> first_sent_packet_time;
+  };
+
+  // Implements SharedPacingThread::Client.
+  void OnWakeup() override RTC_RUN_ON(task_queue_);
+
+  // Processes packets if it is time to send, updates the stats and schedules
+  // the next wakeup.
+  void MaybeProcessPackets() RTC_RUN_ON(task_queue_);
+
+  // Methods implementing PacedSenderController:PacketSender.
+
+  void SendRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
+                     const PacedPacketInfo& cluster_info) override
+      RTC_RUN_ON(task_queue_);
+  void SendRtpPackets(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                      const PacedPacketInfo& cluster_info) override
+      RTC_RUN_ON(task_queue_);
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
+      DataSize size) override RTC_RUN_ON(task_queue_);
+
+  // Returns true if the pacer has nothing left to send.
+  bool MaybeUpdateStats(Timestamp now) RTC_RUN_ON(task_queue_);
+  Stats GetStats() const;
+
+  Clock* const clock_;
+  SharedPacingThread* const pacing_thread_;
+  rtc::TaskQueue& task_queue_;
+  PacketRouter* const packet_router_ RTC_GUARDED_BY(task_queue_);
+  PacingController pacing_controller_ RTC_GUARDED_BY(task_queue_);
+
+  // Time of the wakeup scheduled on |pacing_thread_|, PlusInfinity() if none.
+  Timestamp next_wakeup_ RTC_GUARDED_BY(task_queue_);
+  // Last time stats were updated.
+  Timestamp last_stats_time_ RTC_GUARDED_BY(task_queue_);
+
+  // Set by the destructor, no more wakeups are scheduled once it is.
+  bool is_shutdown_ RTC_GUARDED_BY(task_queue_);
+
+  rtc::CriticalSection stats_crit_;
+  Stats current_stats_ RTC_GUARDED_BY(stats_crit_);
+};
+}  // namespace webrtc
+#endif  // MODULES_PACING_SHARED_TASK_QUEUE_PACED_SENDER_H_
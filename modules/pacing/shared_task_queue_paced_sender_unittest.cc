@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_task_queue_paced_sender.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "modules/pacing/packet_router.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+constexpr uint32_t kAudioSsrc = 12345;
+constexpr uint32_t kVideoSsrc = 234565;
+constexpr size_t kDefaultPacketSize = 1234;
+
+class MockPacketRouter : public PacketRouter {
+ public:
+  MOCK_METHOD2(SendPacket,
+               void(std::unique_ptr<RtpPacketToSend> packet,
+                    const PacedPacketInfo& cluster_info));
+  MOCK_METHOD1(
+      GeneratePadding,
+      std::vector<std::unique_ptr<RtpPacketToSend>>(size_t target_size_bytes));
+};
+
+std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePackets(
+    RtpPacketMediaType type,
+    size_t num_packets) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  for (size_t i = 0; i < num_packets; ++i) {
+    auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+    packet->set_packet_type(type);
+    packet->SetSsrc(type == RtpPacketMediaType::kAudio ? kAudioSsrc
+                                                       : kVideoSsrc);
+    packet->SetPayloadSize(kDefaultPacketSize);
+    packets.push_back(std::move(packet));
+  }
+  return packets;
+}
+}  // namespace
+
+namespace test {
+
+class SharedTaskQueuePacedSenderTest : public ::testing::Test {
+ public:
+  SharedTaskQueuePacedSenderTest()
+      : time_controller_(Timestamp::Millis(1234)),
+        pacing_thread_(time_controller_.GetClock(),
+                       time_controller_.GetTaskQueueFactory(),
+                       SharedPacingThread::kDefaultResolution) {}
+
+ protected:
+  std::unique_ptr<SharedTaskQueuePacedSender> CreatePacer(
+      PacketRouter* packet_router) {
+    return std::make_unique<SharedTaskQueuePacedSender>(
+        time_controller_.GetClock(), packet_router,
+        /*event_log=*/nullptr,
+        /*field_trials=*/nullptr, &pacing_thread_);
+  }
+
+  Timestamp CurrentTime() { return time_controller_.GetClock()->CurrentTime(); }
+
+  GlobalSimulatedTimeController time_controller_;
+  SharedPacingThread pacing_thread_;
+};
+
+TEST_F(SharedTaskQueuePacedSenderTest, PacesPacketsOfSeveralPacers) {
+  // Insert a number of packets in each pacer, covering one second.
+  static constexpr size_t kPacketsToSend = 42;
+  static constexpr int kNumPacers = 3;
+  MockPacketRouter packet_routers[kNumPacers];
+  std::unique_ptr<SharedTaskQueuePacedSender> pacers[kNumPacers];
+  size_t packets_sent[kNumPacers] = {};
+  Timestamp end_times[kNumPacers] = {
+      Timestamp::PlusInfinity(), Timestamp::PlusInfinity(),
+      Timestamp::PlusInfinity()};
+  for (int i = 0; i < kNumPacers; ++i) {
+    pacers[i] = CreatePacer(&packet_routers[i]);
+    EXPECT_CALL(packet_routers[i], SendPacket)
+        .WillRepeatedly([&, i](std::unique_ptr<RtpPacketToSend> packet,
+                               const PacedPacketInfo& cluster_info) {
+          if (++packets_sent[i] == kPacketsToSend)
+            end_times[i] = CurrentTime();
+        });
+    pacers[i]->SetPacingRates(
+        DataRate::BitsPerSec(kDefaultPacketSize * 8 * kPacketsToSend),
+        DataRate::Zero());
+    pacers[i]->EnqueuePackets(
+        GeneratePackets(RtpPacketMediaType::kVideo, kPacketsToSend));
+  }
+
+  const Timestamp start_time = CurrentTime();
+  time_controller_.AdvanceTime(TimeDelta::Seconds(1));
+  for (int i = 0; i < kNumPacers; ++i) {
+    EXPECT_EQ(packets_sent[i], kPacketsToSend);
+    ASSERT_TRUE(end_times[i].IsFinite());
+    EXPECT_NEAR((end_times[i] - start_time).ms<double>(), 1000.0, 50.0);
+  }
+}
+
+TEST_F(SharedTaskQueuePacedSenderTest, SendsAudioImmediately) {
+  const DataRate kPacingDataRate = DataRate::KilobitsPerSec(125);
+  const DataSize kPacketSize = DataSize::Bytes(kDefaultPacketSize);
+  const TimeDelta kPacketPacingTime = kPacketSize / kPacingDataRate;
+  MockPacketRouter packet_router;
+  auto pacer = CreatePacer(&packet_router);
+
+  pacer->SetPacingRates(kPacingDataRate, DataRate::Zero());
+
+  // Add some initial video packets, only one should be sent.
+  EXPECT_CALL(packet_router, SendPacket);
+  pacer->EnqueuePackets(GeneratePackets(RtpPacketMediaType::kVideo, 10));
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  ::testing::Mock::VerifyAndClearExpectations(&packet_router);
+
+  // Advance time, but still before next packet should be sent.
+  time_controller_.AdvanceTime(kPacketPacingTime / 2);
+
+  // Insert an audio packet, it should be sent immediately.
+  EXPECT_CALL(packet_router, SendPacket);
+  pacer->EnqueuePackets(GeneratePackets(RtpPacketMediaType::kAudio, 1));
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  ::testing::Mock::VerifyAndClearExpectations(&packet_router);
+}
+
+TEST_F(SharedTaskQueuePacedSenderTest, UpdatesStatsWhileNotDrained) {
+  MockPacketRouter packet_router;
+  auto pacer = CreatePacer(&packet_router);
+  EXPECT_CALL(packet_router, SendPacket).Times(::testing::AnyNumber());
+  // One packet per second, the queue drains slowly.
+  pacer->SetPacingRates(DataRate::BitsPerSec(kDefaultPacketSize * 8),
+                        DataRate::Zero());
+  pacer->EnqueuePackets(GeneratePackets(RtpPacketMediaType::kVideo, 10));
+  time_controller_.AdvanceTime(TimeDelta::Millis(100));
+  EXPECT_GE(pacer->OldestPacketWaitTime(), TimeDelta::Millis(100 - 33));
+  EXPECT_GT(pacer->QueueSizeData(), DataSize::Zero());
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -170,6 +170,10 @@ absl::optional<Timestamp> TaskQueuePacedSender::FirstSentPacketTime() const {
   return GetStats().first_sent_packet_time;
 }
 
+DataSize TaskQueuePacedSender::MaxBurstSize() const {
+  return GetStats().max_burst_size;
+}
+
 TimeDelta TaskQueuePacedSender::OldestPacketWaitTime() const {
   return GetStats().oldest_packet_wait_time;
 }
@@ -200,18 +204,23 @@ void TaskQueuePacedSender::MaybeProcessPackets(
     next_process_time = pacing_controller_.NextSendTime();
   }
 
-  next_process_time =
-      std::max(now + PacingController::kMinSleepTime, next_process_time);
+  const TimeDelta min_sleep_time = pacing_controller_.MinSleepTime();
+  next_process_time = std::max(now + min_sleep_time, next_process_time);
 
   TimeDelta sleep_time = next_process_time - now;
   if (next_process_time_.IsMinusInfinity() ||
-      next_process_time <=
-          next_process_time_ - PacingController::kMinSleepTime) {
+      next_process_time <= next_process_time_ - min_sleep_time) {
     next_process_time_ = next_process_time;
 
+    // Delayed tasks have millisecond resolution. With sub-millisecond sleeps,
+    // round up so that the task never runs before the pacer can send.
+    uint32_t sleep_time_ms =
+        min_sleep_time < PacingController::kMinSleepTime
+            ? static_cast<uint32_t>((sleep_time.us() + 999) / 1000)
+            : sleep_time.ms<uint32_t>();
     task_queue_.PostDelayedTask(
         [this, next_process_time]() { MaybeProcessPackets(next_process_time); },
-        sleep_time.ms<uint32_t>());
+        sleep_time_ms);
   }
 
   MaybeUpdateStats(false);
@@ -228,6 +237,12 @@ void TaskQueuePacedSender::SendRtpPacket(
   packet_router_->SendPacket(std::move(packet), cluster_info);
 }
 
+void TaskQueuePacedSender::SendRtpPackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+    const PacedPacketInfo& cluster_info) {
+  packet_router_->SendPackets(std::move(packets), cluster_info);
+}
+
 void TaskQueuePacedSender::MaybeUpdateStats(bool is_scheduled_call) {
   if (is_shutdown_) {
     return;
@@ -247,6 +262,7 @@ void TaskQueuePacedSender::MaybeUpdateStats(bool is_scheduled_call) {
   current_stats_.oldest_packet_wait_time =
       pacing_controller_.OldestPacketWaitTime();
   current_stats_.queue_size = pacing_controller_.QueueSizeData();
+  current_stats_.max_burst_size = pacing_controller_.MaxBurstSize();
   last_stats_time_ = now;
 
   bool pacer_drained = pacing_controller_.QueueSizePackets() == 0 &&
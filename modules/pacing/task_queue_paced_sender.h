@@ -91,6 +91,8 @@ class TaskQueuePacedSender : public RtpPacketPacer,
   // Returns the time when the first packet was sent;
   absl::optional<Timestamp> FirstSentPacketTime() const override;
 
+  DataSize MaxBurstSize() const override;
+
   // Returns the number of milliseconds it will take to send the current
   // packets in the queue, given the current size and bitrate, ignoring prio.
   TimeDelta ExpectedQueueTime() const override;
@@ -104,9 +106,11 @@ class TaskQueuePacedSender : public RtpPacketPacer,
     Stats()
         : oldest_packet_wait_time(TimeDelta::Zero()),
           queue_size(DataSize::Zero()),
+          max_burst_size(DataSize::Zero()),
           expected_queue_time(TimeDelta::Zero()) {}
     TimeDelta oldest_packet_wait_time;
     DataSize queue_size;
+    DataSize max_burst_size;
     TimeDelta expected_queue_time;
     absl::optional<Timestamp> first_sent_packet_time;
   };
@@ -123,6 +127,9 @@ class TaskQueuePacedSender : public RtpPacketPacer,
   void SendRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
                      const PacedPacketInfo& cluster_info) override
       RTC_RUN_ON(task_queue_);
+  void SendRtpPackets(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                      const PacedPacketInfo& cluster_info) override
+      RTC_RUN_ON(task_queue_);
 
   std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       DataSize size) override RTC_RUN_ON(task_queue_);
@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/abs_send_time_unwrapper.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+// Rounds to the nearest integer, halves away from zero.
+int64_t DivideRounded(int64_t numerator, int64_t denominator) {
+  return numerator >= 0 ? (numerator + denominator / 2) / denominator
+                        : -((-numerator + denominator / 2) / denominator);
+}
+}  // namespace
+
+int64_t AbsSendTimeUnwrapper::UnwrapUs(uint32_t abs_send_time) {
+  RTC_DCHECK_LT(abs_send_time, 1u << 24);
+  // 10^6 / 2^18 = 15625 / 2^12.
+  return DivideRounded(unwrapper_.Unwrap(abs_send_time) * 15625, 1 << 12);
+}
+
+uint32_t AbsSendTimeUnwrapper::ToMs(int64_t send_time_us) {
+  return static_cast<uint32_t>(DivideRounded(send_time_us, 1000));
+}
+
+}  // namespace webrtc
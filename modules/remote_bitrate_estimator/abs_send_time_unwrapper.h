@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_ABS_SEND_TIME_UNWRAPPER_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_ABS_SEND_TIME_UNWRAPPER_H_
+
+#include <stdint.h>
+
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+
+// Turns the 24 bit, 6.18 fixed point, abs-send-time of the packets of a call
+// into a continuous send time in microseconds, which keeps the ~4 us
+// resolution of the extension. The send time wraps every 64 s; a packet is
+// taken to be sent less than 32 s away from the previous one, which holds for
+// packets reordered around a wrap as well.
+class AbsSendTimeUnwrapper {
+ public:
+  // Returns the send time of the packet with |abs_send_time|, counted from the
+  // same origin as the first packet's, which is within the first 64 s. Packets
+  // sent before the first one may get a negative send time.
+  int64_t UnwrapUs(uint32_t abs_send_time);
+
+  // Rounds |send_time_us| to milliseconds, truncated to 32 bits, the way the
+  // send times are given to the ONNX model and recorded in the stats.
+  static uint32_t ToMs(int64_t send_time_us);
+
+ private:
+  SeqNumUnwrapper<uint32_t, 1 << 24> unwrapper_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_ABS_SEND_TIME_UNWRAPPER_H_
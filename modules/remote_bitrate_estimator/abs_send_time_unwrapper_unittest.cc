@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/abs_send_time_unwrapper.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// One second in the 6.18 fixed point of abs-send-time.
+constexpr uint32_t kOneSecond = 1 << 18;
+constexpr uint32_t kWrap = 1 << 24;
+constexpr int64_t kWrapUs = 64000000;
+
+TEST(AbsSendTimeUnwrapperTest, KeepsSubMillisecondPrecision) {
+  AbsSendTimeUnwrapper unwrapper;
+  EXPECT_EQ(unwrapper.UnwrapUs(kOneSecond), 1000000);
+  // A unit is about 3.8 us.
+  EXPECT_EQ(unwrapper.UnwrapUs(kOneSecond + 26), 1000099);
+  EXPECT_EQ(unwrapper.UnwrapUs(kOneSecond + 27), 1000103);
+  EXPECT_EQ(AbsSendTimeUnwrapper::ToMs(1000499), 1000u);
+  EXPECT_EQ(AbsSendTimeUnwrapper::ToMs(1000500), 1001u);
+}
+
+TEST(AbsSendTimeUnwrapperTest, CountsWraps) {
+  AbsSendTimeUnwrapper unwrapper;
+  EXPECT_EQ(unwrapper.UnwrapUs(kWrap - kOneSecond), kWrapUs - 1000000);
+  EXPECT_EQ(unwrapper.UnwrapUs(kOneSecond), kWrapUs + 1000000);
+  EXPECT_EQ(unwrapper.UnwrapUs(30 * kOneSecond), kWrapUs + 30000000);
+  EXPECT_EQ(unwrapper.UnwrapUs(60 * kOneSecond), kWrapUs + 60000000);
+  EXPECT_EQ(unwrapper.UnwrapUs(0), 2 * kWrapUs);
+}
+
+TEST(AbsSendTimeUnwrapperTest, HandlesPacketsReorderedAroundAWrap) {
+  AbsSendTimeUnwrapper unwrapper;
+  EXPECT_EQ(unwrapper.UnwrapUs(kWrap - 10 * kOneSecond), kWrapUs - 10000000);
+  EXPECT_EQ(unwrapper.UnwrapUs(kOneSecond), kWrapUs + 1000000);
+  // Sent before the wrap, received after it.
+  EXPECT_EQ(unwrapper.UnwrapUs(kWrap - kOneSecond), kWrapUs - 1000000);
+  EXPECT_EQ(unwrapper.UnwrapUs(2 * kOneSecond), kWrapUs + 2000000);
+}
+
+TEST(AbsSendTimeUnwrapperTest, GoesNegativeForPacketsSentBeforeTheFirst) {
+  AbsSendTimeUnwrapper unwrapper;
+  EXPECT_EQ(unwrapper.UnwrapUs(kOneSecond), 1000000);
+  EXPECT_EQ(unwrapper.UnwrapUs(kWrap - kOneSecond), -1000000);
+  EXPECT_EQ(AbsSendTimeUnwrapper::ToMs(-1000000), static_cast<uint32_t>(-1000));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/audio_feature_aggregator.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+AudioFeatureAggregator::AudioFeatureAggregator(int64_t window_ms)
+    : window_ms_(window_ms) {
+  RTC_DCHECK_GT(window_ms_, 0);
+}
+
+absl::optional<ReceivedPacketInfo> AudioFeatureAggregator::OnPacket(
+    const ReceivedPacketInfo& packet) {
+  if (!feature_) {
+    window_start_ms_ = packet.arrival_time_ms;
+    feature_ = packet;
+  } else {
+    ReceivedPacketInfo& feature = *feature_;
+    feature.payload_type = packet.payload_type;
+    feature.sequence_number = packet.sequence_number;
+    feature.send_time_ms = packet.send_time_ms;
+    feature.send_time_us = packet.send_time_us;
+    feature.ssrc = packet.ssrc;
+    feature.padding_length += packet.padding_length;
+    feature.header_length += packet.header_length;
+    feature.arrival_time_ms = packet.arrival_time_ms;
+    feature.payload_size += packet.payload_size;
+    // Unknown only if unknown for every packet of the window.
+    if (packet.loss_count >= 0)
+      feature.loss_count = std::max(feature.loss_count, 0) + packet.loss_count;
+    if (packet.rtt_ms >= 0)
+      feature.rtt_ms = packet.rtt_ms;
+  }
+  if (packet.arrival_time_ms - window_start_ms_ < window_ms_)
+    return absl::nullopt;
+  return Flush();
+}
+
+absl::optional<ReceivedPacketInfo> AudioFeatureAggregator::Flush() {
+  absl::optional<ReceivedPacketInfo> feature = feature_;
+  feature_.reset();
+  return feature;
+}
+
+}  // namespace webrtc
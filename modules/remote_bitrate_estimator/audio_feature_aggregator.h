@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_AUDIO_FEATURE_AGGREGATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_AUDIO_FEATURE_AGGREGATOR_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+
+namespace webrtc {
+
+// Turns the packets of an audio-only call, one every 20 ms or so, into one
+// feature per window for the estimator, see AlphaCCConfig::bwe_audio_only.
+// A feature sums the sizes and the losses of the packets of its window, so
+// that the received rate is kept, and carries the sequence number, the
+// timestamps and the RTT of the last one.
+class AudioFeatureAggregator {
+ public:
+  explicit AudioFeatureAggregator(int64_t window_ms);
+
+  // Adds |packet| to the current window. Returns the feature of the window
+  // once |packet| arrived |window_ms| or more after its first packet, which
+  // starts the next one.
+  absl::optional<ReceivedPacketInfo> OnPacket(const ReceivedPacketInfo& packet);
+
+  // Returns the feature of the packets added since the last one returned, if
+  // any.
+  absl::optional<ReceivedPacketInfo> Flush();
+
+ private:
+  const int64_t window_ms_;
+  int64_t window_start_ms_ = 0;
+  absl::optional<ReceivedPacketInfo> feature_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_AUDIO_FEATURE_AGGREGATOR_H_
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/audio_feature_aggregator.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kWindowMs = 200;
+constexpr int64_t kPacketIntervalMs = 20;
+
+ReceivedPacketInfo AudioPacket(uint16_t sequence_number,
+                               int64_t arrival_time_ms) {
+  ReceivedPacketInfo packet;
+  packet.payload_type = 111;
+  packet.sequence_number = sequence_number;
+  packet.send_time_ms = static_cast<uint32_t>(arrival_time_ms - 30);
+  packet.ssrc = 1;
+  packet.header_length = 12;
+  packet.arrival_time_ms = arrival_time_ms;
+  packet.payload_size = 80;
+  return packet;
+}
+
+TEST(AudioFeatureAggregatorTest, AggregatesTheWindow) {
+  AudioFeatureAggregator aggregator(kWindowMs);
+  const int kPacketsPerWindow = kWindowMs / kPacketIntervalMs;
+  for (int i = 0; i < kPacketsPerWindow; ++i) {
+    ReceivedPacketInfo packet = AudioPacket(i, i * kPacketIntervalMs);
+    packet.loss_count = i == 3 ? 2 : -1;
+    packet.rtt_ms = i < 5 ? 40 : -1;
+    EXPECT_FALSE(aggregator.OnPacket(packet));
+  }
+
+  absl::optional<ReceivedPacketInfo> feature =
+      aggregator.OnPacket(AudioPacket(kPacketsPerWindow, kWindowMs));
+  ASSERT_TRUE(feature);
+  EXPECT_EQ(feature->sequence_number, kPacketsPerWindow);
+  EXPECT_EQ(feature->arrival_time_ms, kWindowMs);
+  EXPECT_EQ(feature->send_time_ms, kWindowMs - 30);
+  EXPECT_EQ(feature->payload_size, 80u * (kPacketsPerWindow + 1));
+  EXPECT_EQ(feature->header_length, 12u * (kPacketsPerWindow + 1));
+  EXPECT_EQ(feature->loss_count, 2);
+  EXPECT_EQ(feature->rtt_ms, 40);
+  EXPECT_FALSE(aggregator.Flush());
+}
+
+TEST(AudioFeatureAggregatorTest, LossIsUnknownIfUnknownForEveryPacket) {
+  AudioFeatureAggregator aggregator(kWindowMs);
+  EXPECT_FALSE(aggregator.OnPacket(AudioPacket(0, 0)));
+  absl::optional<ReceivedPacketInfo> feature =
+      aggregator.OnPacket(AudioPacket(1, kWindowMs));
+  ASSERT_TRUE(feature);
+  EXPECT_EQ(feature->loss_count, -1);
+  EXPECT_EQ(feature->rtt_ms, -1);
+}
+
+TEST(AudioFeatureAggregatorTest, StartsTheNextWindowAfterAFeature) {
+  AudioFeatureAggregator aggregator(kWindowMs);
+  EXPECT_FALSE(aggregator.OnPacket(AudioPacket(0, 0)));
+  EXPECT_TRUE(aggregator.OnPacket(AudioPacket(1, kWindowMs)));
+  EXPECT_FALSE(aggregator.OnPacket(AudioPacket(2, kWindowMs + 1)));
+  EXPECT_FALSE(aggregator.OnPacket(AudioPacket(3, 2 * kWindowMs)));
+
+  absl::optional<ReceivedPacketInfo> feature =
+      aggregator.OnPacket(AudioPacket(4, 2 * kWindowMs + 1));
+  ASSERT_TRUE(feature);
+  EXPECT_EQ(feature->payload_size, 3 * 80u);
+}
+
+TEST(AudioFeatureAggregatorTest, FlushReturnsTheUnfinishedWindow) {
+  AudioFeatureAggregator aggregator(kWindowMs);
+  EXPECT_FALSE(aggregator.Flush());
+  EXPECT_FALSE(aggregator.OnPacket(AudioPacket(0, 0)));
+  EXPECT_FALSE(aggregator.OnPacket(AudioPacket(1, kPacketIntervalMs)));
+
+  absl::optional<ReceivedPacketInfo> feature = aggregator.Flush();
+  ASSERT_TRUE(feature);
+  EXPECT_EQ(feature->sequence_number, 1);
+  EXPECT_EQ(feature->payload_size, 2 * 80u);
+  EXPECT_FALSE(aggregator.Flush());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_feedback_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace webrtc {
+namespace {
+
+BweFeedbackScheduler::Config Sanitize(BweFeedbackScheduler::Config config) {
+  config.max_interval_ms = std::max<int64_t>(config.max_interval_ms, 0);
+  config.min_interval_ms = std::min(
+      std::max<int64_t>(config.min_interval_ms, 0), config.max_interval_ms);
+  config.change_threshold = std::max(config.change_threshold, 0.0);
+  return config;
+}
+
+}  // namespace
+
+BweFeedbackScheduler::BweFeedbackScheduler(const Config& config,
+                                           int64_t now_ms)
+    : config_(Sanitize(config)),
+      last_sent_ms_(now_ms),
+      interval_ms_(config_.change_threshold > 0 ? config_.min_interval_ms
+                                                : config_.max_interval_ms) {}
+
+bool BweFeedbackScheduler::OnEstimate(int64_t now_ms, float estimate_bps) {
+  int64_t elapsed_ms = now_ms - last_sent_ms_;
+  bool changed = IsSignificantChange(estimate_bps);
+  if (changed && elapsed_ms >= config_.min_interval_ms) {
+    interval_ms_ = config_.min_interval_ms;
+  } else if (elapsed_ms >= interval_ms_) {
+    // Nothing worth reporting happened for a whole interval, back off.
+    interval_ms_ = std::min(std::max<int64_t>(2 * interval_ms_, 1),
+                            config_.max_interval_ms);
+  } else {
+    return false;
+  }
+  last_sent_ms_ = now_ms;
+  last_sent_estimate_bps_ = estimate_bps;
+  return true;
+}
+
+int64_t BweFeedbackScheduler::TimeUntilNextFeedbackMs(int64_t now_ms) const {
+  return std::max<int64_t>(last_sent_ms_ + interval_ms_ - now_ms, 0);
+}
+
+bool BweFeedbackScheduler::IsSignificantChange(float estimate_bps) const {
+  if (config_.change_threshold <= 0)
+    return false;
+  if (!last_sent_estimate_bps_)
+    return true;
+  if (*last_sent_estimate_bps_ <= 0)
+    return estimate_bps != *last_sent_estimate_bps_;
+  return std::abs(estimate_bps - *last_sent_estimate_bps_) >
+         config_.change_threshold * *last_sent_estimate_bps_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_FEEDBACK_SCHEDULER_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_FEEDBACK_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// Decides when the receiver sends its estimate back to the sender.
+//
+// An estimate is sent as soon as it differs from the last one sent by more
+// than |change_threshold|, but never more often than every |min_interval_ms|.
+// While the estimate is stable, the interval between two messages doubles up
+// to |max_interval_ms|, which bounds how stale the sender's view can get.
+// With a |change_threshold| of 0 estimates are sent every |max_interval_ms|.
+// Estimates are expected at least every |min_interval_ms|, see
+// ReceiveSideEstimatorWorker::EstimateCallback.
+class BweFeedbackScheduler {
+ public:
+  struct Config {
+    int64_t min_interval_ms = 0;
+    int64_t max_interval_ms = 0;
+    // Relative change, e.g. 0.1 for 10%.
+    double change_threshold = 0;
+  };
+
+  BweFeedbackScheduler(const Config& config, int64_t now_ms);
+
+  // Returns true if |estimate_bps| should be sent at |now_ms|, in which case
+  // it is taken as sent.
+  bool OnEstimate(int64_t now_ms, float estimate_bps);
+
+  // Time until the next message is due even if the estimate does not change.
+  int64_t TimeUntilNextFeedbackMs(int64_t now_ms) const;
+
+  // Minimum interval at which new estimates are worth being looked at.
+  int64_t min_interval_ms() const { return config_.min_interval_ms; }
+
+ private:
+  bool IsSignificantChange(float estimate_bps) const;
+
+  const Config config_;
+  int64_t last_sent_ms_;
+  int64_t interval_ms_;
+  absl::optional<float> last_sent_estimate_bps_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_FEEDBACK_SCHEDULER_H_
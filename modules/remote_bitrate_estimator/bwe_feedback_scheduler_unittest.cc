@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_feedback_scheduler.h"
+
+#include <algorithm>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+BweFeedbackScheduler::Config AdaptiveConfig() {
+  BweFeedbackScheduler::Config config;
+  config.min_interval_ms = 50;
+  config.max_interval_ms = 400;
+  config.change_threshold = 0.1;
+  return config;
+}
+
+TEST(BweFeedbackSchedulerTest, FixedIntervalWithoutThreshold) {
+  BweFeedbackScheduler::Config config;
+  config.max_interval_ms = 200;
+  BweFeedbackScheduler scheduler(config, 1000);
+  EXPECT_FALSE(scheduler.OnEstimate(1100, 1e6));
+  EXPECT_FALSE(scheduler.OnEstimate(1199, 2e6));
+  EXPECT_EQ(scheduler.TimeUntilNextFeedbackMs(1199), 1);
+  EXPECT_TRUE(scheduler.OnEstimate(1200, 2e6));
+  EXPECT_FALSE(scheduler.OnEstimate(1300, 1e5));
+  EXPECT_TRUE(scheduler.OnEstimate(1400, 1e5));
+}
+
+TEST(BweFeedbackSchedulerTest, SendsSignificantChangesAfterMinInterval) {
+  BweFeedbackScheduler scheduler(AdaptiveConfig(), 1000);
+  EXPECT_FALSE(scheduler.OnEstimate(1010, 1e6));
+  EXPECT_TRUE(scheduler.OnEstimate(1050, 1e6));
+  // Significant, but too soon after the last one.
+  EXPECT_FALSE(scheduler.OnEstimate(1060, 0.5e6));
+  // Within the threshold.
+  EXPECT_FALSE(scheduler.OnEstimate(1080, 1.05e6));
+  EXPECT_TRUE(scheduler.OnEstimate(1100, 1.2e6));
+}
+
+TEST(BweFeedbackSchedulerTest, ReportsDropImmediately) {
+  BweFeedbackScheduler scheduler(AdaptiveConfig(), 1000);
+  EXPECT_TRUE(scheduler.OnEstimate(1050, 1e6));
+  EXPECT_FALSE(scheduler.OnEstimate(1080, 0.5e6));
+  EXPECT_TRUE(scheduler.OnEstimate(1100, 0.5e6));
+}
+
+TEST(BweFeedbackSchedulerTest, BacksOffWhileStable) {
+  BweFeedbackScheduler scheduler(AdaptiveConfig(), 0);
+  int64_t now_ms = 50;
+  EXPECT_TRUE(scheduler.OnEstimate(now_ms, 1e6));
+  int64_t expected_interval_ms = 50;
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(scheduler.TimeUntilNextFeedbackMs(now_ms), expected_interval_ms);
+    EXPECT_FALSE(scheduler.OnEstimate(now_ms + expected_interval_ms - 1, 1e6));
+    now_ms += expected_interval_ms;
+    EXPECT_TRUE(scheduler.OnEstimate(now_ms, 1e6));
+    expected_interval_ms = std::min<int64_t>(2 * expected_interval_ms, 400);
+  }
+  EXPECT_EQ(scheduler.TimeUntilNextFeedbackMs(now_ms), 400);
+
+  // A change resets the interval.
+  now_ms += 50;
+  EXPECT_TRUE(scheduler.OnEstimate(now_ms, 2e6));
+  EXPECT_EQ(scheduler.TimeUntilNextFeedbackMs(now_ms), 50);
+}
+
+}  // namespace
+}  // namespace webrtc
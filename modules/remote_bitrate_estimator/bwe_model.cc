@@ -0,0 +1,478 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_model.h"
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace bwe_model {
+namespace {
+
+constexpr char kMagic[] = {'B', 'W', 'E', 'M'};
+constexpr uint32_t kVersion = 1;
+// Bounds what a corrupt file can make us allocate.
+constexpr uint32_t kMaxLayers = 64;
+constexpr uint32_t kMaxUnits = 4096;
+
+enum LayerType : uint32_t {
+  kDense = 0,
+  kActivation = 1,
+  kGru = 2,
+  kLstm = 3,
+};
+
+constexpr size_t kNumGruGates = 3;
+constexpr size_t kNumLstmGates = 4;
+
+float Sigmoid(float x) {
+  return 1.f / (1.f + std::exp(-x));
+}
+
+float Apply(Activation activation, float x) {
+  switch (activation) {
+    case Activation::kLinear:
+      return x;
+    case Activation::kRelu:
+      return x < 0.f ? 0.f : x;
+    case Activation::kSigmoid:
+      return Sigmoid(x);
+    case Activation::kTanh:
+      return std::tanh(x);
+  }
+  RTC_NOTREACHED();
+  return x;
+}
+
+std::vector<float> Dequantize(const QuantizedMatrix& matrix) {
+  RTC_DCHECK_EQ(matrix.values.size(), matrix.rows * matrix.cols);
+  RTC_DCHECK_EQ(matrix.row_scales.size(), matrix.rows);
+  std::vector<float> result(matrix.values.size());
+  for (size_t r = 0; r < matrix.rows; ++r) {
+    for (size_t c = 0; c < matrix.cols; ++c) {
+      size_t index = r * matrix.cols + c;
+      result[index] = matrix.row_scales[r] * matrix.values[index];
+    }
+  }
+  return result;
+}
+
+float DotProduct(const float* x, const float* w, size_t size) {
+  float sum = 0.f;
+  for (size_t i = 0; i < size; ++i)
+    sum += x[i] * w[i];
+  return sum;
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+float DotProductSse2(const float* x, const float* w, size_t size) {
+  __m128 sum_128 = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    sum_128 = _mm_add_ps(sum_128,
+                         _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(w + i)));
+  }
+  float v[4];
+  _mm_storeu_ps(v, sum_128);
+  return v[0] + v[1] + v[2] + v[3] + DotProduct(x + i, w + i, size - i);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+float DotProductNeon(const float* x, const float* w, size_t size) {
+  float32x4_t sum_128 = vdupq_n_f32(0.f);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4)
+    sum_128 = vmlaq_f32(sum_128, vld1q_f32(x + i), vld1q_f32(w + i));
+  return vgetq_lane_f32(sum_128, 0) + vgetq_lane_f32(sum_128, 1) +
+         vgetq_lane_f32(sum_128, 2) + vgetq_lane_f32(sum_128, 3) +
+         DotProduct(x + i, w + i, size - i);
+}
+#endif
+
+// |output| = |weights| * |input| + |bias|, where |weights| has
+// |output.size()| rows of |input.size()| values.
+void MatVec(rtc::ArrayView<const float> weights,
+            rtc::ArrayView<const float> bias,
+            rtc::ArrayView<const float> input,
+            Optimization optimization,
+            rtc::ArrayView<float> output) {
+  const size_t cols = input.size();
+  RTC_DCHECK_EQ(weights.size(), output.size() * cols);
+  RTC_DCHECK_EQ(bias.size(), output.size());
+  for (size_t r = 0; r < output.size(); ++r) {
+    const float* row = weights.data() + r * cols;
+    switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Optimization::kSse2:
+        output[r] = bias[r] + DotProductSse2(input.data(), row, cols);
+        break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Optimization::kNeon:
+        output[r] = bias[r] + DotProductNeon(input.data(), row, cols);
+        break;
+#endif
+      default:
+        output[r] = bias[r] + DotProduct(input.data(), row, cols);
+    }
+  }
+}
+
+class Reader {
+ public:
+  explicit Reader(rtc::ArrayView<const uint8_t> data) : data_(data) {}
+
+  bool Read(void* destination, size_t size) {
+    if (data_.size() - offset_ < size)
+      return false;
+    memcpy(destination, data_.data() + offset_, size);
+    offset_ += size;
+    return true;
+  }
+  bool ReadUint32(uint32_t* value) {
+    uint8_t bytes[4];
+    if (!Read(bytes, sizeof(bytes)))
+      return false;
+    *value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+             (static_cast<uint32_t>(bytes[3]) << 24);
+    return true;
+  }
+  bool ReadFloats(size_t count, std::vector<float>* values) {
+    values->resize(count);
+    for (float& value : *values) {
+      uint32_t bits;
+      if (!ReadUint32(&bits))
+        return false;
+      memcpy(&value, &bits, sizeof(value));
+    }
+    return true;
+  }
+  bool ReadMatrix(QuantizedMatrix* matrix) {
+    uint32_t rows;
+    uint32_t cols;
+    if (!ReadUint32(&rows) || !ReadUint32(&cols) || rows == 0 || cols == 0 ||
+        rows > kNumLstmGates * kMaxUnits || cols > kMaxUnits) {
+      return false;
+    }
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->values.resize(matrix->rows * matrix->cols);
+    return ReadFloats(rows, &matrix->row_scales) &&
+           Read(matrix->values.data(), matrix->values.size());
+  }
+  bool done() const { return offset_ == data_.size(); }
+
+ private:
+  const rtc::ArrayView<const uint8_t> data_;
+  size_t offset_ = 0;
+};
+
+// Reads the weights of a recurrent layer with |num_gates| gates.
+bool ReadRecurrentWeights(Reader* reader,
+                          size_t num_gates,
+                          QuantizedMatrix* weights,
+                          QuantizedMatrix* recurrent_weights,
+                          std::vector<float>* bias) {
+  if (!reader->ReadMatrix(weights) || !reader->ReadMatrix(recurrent_weights))
+    return false;
+  size_t hidden_size = weights->rows / num_gates;
+  if (weights->rows != num_gates * hidden_size ||
+      recurrent_weights->rows != weights->rows ||
+      recurrent_weights->cols != hidden_size) {
+    return false;
+  }
+  return reader->ReadFloats(2 * weights->rows, bias);
+}
+
+std::unique_ptr<Layer> ReadLayer(Reader* reader, Optimization optimization) {
+  uint32_t type;
+  if (!reader->ReadUint32(&type))
+    return nullptr;
+  QuantizedMatrix weights;
+  QuantizedMatrix recurrent_weights;
+  std::vector<float> bias;
+  switch (type) {
+    case kDense:
+      if (!reader->ReadMatrix(&weights) ||
+          !reader->ReadFloats(weights.rows, &bias)) {
+        return nullptr;
+      }
+      return std::make_unique<DenseLayer>(weights, std::move(bias),
+                                          optimization);
+    case kActivation: {
+      uint32_t size;
+      uint32_t activation;
+      if (!reader->ReadUint32(&size) || !reader->ReadUint32(&activation) ||
+          size == 0 || size > kMaxUnits ||
+          activation > static_cast<uint32_t>(Activation::kTanh)) {
+        return nullptr;
+      }
+      return std::make_unique<ActivationLayer>(
+          size, static_cast<Activation>(activation));
+    }
+    case kGru:
+      if (!ReadRecurrentWeights(reader, kNumGruGates, &weights,
+                                &recurrent_weights, &bias)) {
+        return nullptr;
+      }
+      return std::make_unique<GruLayer>(weights, recurrent_weights,
+                                        std::move(bias), optimization);
+    case kLstm:
+      if (!ReadRecurrentWeights(reader, kNumLstmGates, &weights,
+                                &recurrent_weights, &bias)) {
+        return nullptr;
+      }
+      return std::make_unique<LstmLayer>(weights, recurrent_weights,
+                                         std::move(bias), optimization);
+  }
+  RTC_LOG(LS_ERROR) << "Unsupported BWE model layer type " << type;
+  return nullptr;
+}
+
+}  // namespace
+
+Optimization DetectOptimization() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    return Optimization::kSse2;
+  }
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+  return Optimization::kNeon;
+#endif
+
+  return Optimization::kNone;
+}
+
+DenseLayer::DenseLayer(const QuantizedMatrix& weights,
+                       std::vector<float> bias,
+                       Optimization optimization)
+    : input_size_(weights.cols),
+      output_size_(weights.rows),
+      weights_(Dequantize(weights)),
+      bias_(std::move(bias)),
+      optimization_(optimization),
+      output_(output_size_) {
+  RTC_DCHECK_EQ(bias_.size(), output_size_);
+}
+
+DenseLayer::~DenseLayer() = default;
+
+rtc::ArrayView<const float> DenseLayer::ComputeOutput(
+    rtc::ArrayView<const float> input) {
+  RTC_DCHECK_EQ(input.size(), input_size_);
+  MatVec(weights_, bias_, input, optimization_, output_);
+  return output_;
+}
+
+ActivationLayer::ActivationLayer(size_t size, Activation activation)
+    : activation_(activation), output_(size) {}
+
+ActivationLayer::~ActivationLayer() = default;
+
+rtc::ArrayView<const float> ActivationLayer::ComputeOutput(
+    rtc::ArrayView<const float> input) {
+  RTC_DCHECK_EQ(input.size(), output_.size());
+  for (size_t i = 0; i < output_.size(); ++i)
+    output_[i] = Apply(activation_, input[i]);
+  return output_;
+}
+
+GruLayer::GruLayer(const QuantizedMatrix& weights,
+                   const QuantizedMatrix& recurrent_weights,
+                   std::vector<float> bias,
+                   Optimization optimization)
+    : input_size_(weights.cols),
+      weights_(Dequantize(weights)),
+      recurrent_weights_(Dequantize(recurrent_weights)),
+      bias_(std::move(bias)),
+      optimization_(optimization),
+      state_(weights.rows / kNumGruGates),
+      input_gates_(weights.rows),
+      recurrent_gates_(weights.rows),
+      reset_state_(state_.size()) {
+  RTC_DCHECK_EQ(weights.rows, kNumGruGates * state_.size());
+  RTC_DCHECK_EQ(recurrent_weights.rows, weights.rows);
+  RTC_DCHECK_EQ(recurrent_weights.cols, state_.size());
+  RTC_DCHECK_EQ(bias_.size(), 2 * weights.rows);
+}
+
+GruLayer::~GruLayer() = default;
+
+void GruLayer::Reset() {
+  std::fill(state_.begin(), state_.end(), 0.f);
+}
+
+rtc::ArrayView<const float> GruLayer::ComputeOutput(
+    rtc::ArrayView<const float> input) {
+  RTC_DCHECK_EQ(input.size(), input_size_);
+  const size_t hidden_size = state_.size();
+  const rtc::ArrayView<const float> bias(bias_);
+  const rtc::ArrayView<const float> recurrent_weights(recurrent_weights_);
+  MatVec(weights_, bias.subview(0, kNumGruGates * hidden_size), input,
+         optimization_, input_gates_);
+  // Update and reset gates.
+  rtc::ArrayView<float> recurrent_gates(recurrent_gates_);
+  MatVec(recurrent_weights.subview(0, 2 * hidden_size * hidden_size),
+         bias.subview(kNumGruGates * hidden_size, 2 * hidden_size), state_,
+         optimization_, recurrent_gates.subview(0, 2 * hidden_size));
+  for (size_t i = 0; i < 2 * hidden_size; ++i)
+    input_gates_[i] = Sigmoid(input_gates_[i] + recurrent_gates_[i]);
+  // Hidden gate, which sees the state through the reset gate.
+  for (size_t i = 0; i < hidden_size; ++i)
+    reset_state_[i] = input_gates_[hidden_size + i] * state_[i];
+  MatVec(recurrent_weights.subview(2 * hidden_size * hidden_size,
+                                   hidden_size * hidden_size),
+         bias.subview((kNumGruGates + 2) * hidden_size, hidden_size),
+         reset_state_, optimization_,
+         recurrent_gates.subview(2 * hidden_size, hidden_size));
+  for (size_t i = 0; i < hidden_size; ++i) {
+    float update = input_gates_[i];
+    float candidate = std::tanh(input_gates_[2 * hidden_size + i] +
+                                recurrent_gates_[2 * hidden_size + i]);
+    state_[i] = (1.f - update) * candidate + update * state_[i];
+  }
+  return state_;
+}
+
+LstmLayer::LstmLayer(const QuantizedMatrix& weights,
+                     const QuantizedMatrix& recurrent_weights,
+                     std::vector<float> bias,
+                     Optimization optimization)
+    : input_size_(weights.cols),
+      weights_(Dequantize(weights)),
+      recurrent_weights_(Dequantize(recurrent_weights)),
+      bias_(std::move(bias)),
+      optimization_(optimization),
+      state_(weights.rows / kNumLstmGates),
+      cell_(state_.size()),
+      gates_(weights.rows),
+      recurrent_gates_(weights.rows) {
+  RTC_DCHECK_EQ(weights.rows, kNumLstmGates * state_.size());
+  RTC_DCHECK_EQ(recurrent_weights.rows, weights.rows);
+  RTC_DCHECK_EQ(recurrent_weights.cols, state_.size());
+  RTC_DCHECK_EQ(bias_.size(), 2 * weights.rows);
+}
+
+LstmLayer::~LstmLayer() = default;
+
+void LstmLayer::Reset() {
+  std::fill(state_.begin(), state_.end(), 0.f);
+  std::fill(cell_.begin(), cell_.end(), 0.f);
+}
+
+rtc::ArrayView<const float> LstmLayer::ComputeOutput(
+    rtc::ArrayView<const float> input) {
+  RTC_DCHECK_EQ(input.size(), input_size_);
+  const size_t hidden_size = state_.size();
+  const size_t gates_size = kNumLstmGates * hidden_size;
+  const rtc::ArrayView<const float> bias(bias_);
+  MatVec(weights_, bias.subview(0, gates_size), input, optimization_, gates_);
+  MatVec(recurrent_weights_, bias.subview(gates_size, gates_size), state_,
+         optimization_, recurrent_gates_);
+  for (size_t i = 0; i < hidden_size; ++i) {
+    float input_gate = Sigmoid(gates_[i] + recurrent_gates_[i]);
+    float output_gate =
+        Sigmoid(gates_[hidden_size + i] + recurrent_gates_[hidden_size + i]);
+    float forget_gate = Sigmoid(gates_[2 * hidden_size + i] +
+                                recurrent_gates_[2 * hidden_size + i]);
+    float candidate = std::tanh(gates_[3 * hidden_size + i] +
+                                recurrent_gates_[3 * hidden_size + i]);
+    cell_[i] = forget_gate * cell_[i] + input_gate * candidate;
+    state_[i] = output_gate * std::tanh(cell_[i]);
+  }
+  return state_;
+}
+
+std::unique_ptr<BweModel> BweModel::Load(const std::string& path) {
+  FileWrapper file = FileWrapper::OpenReadOnly(path);
+  if (!file.is_open()) {
+    RTC_LOG(LS_ERROR) << "Failed to open BWE model " << path;
+    return nullptr;
+  }
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t read;
+  while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+    data.insert(data.end(), buffer, buffer + read);
+  std::unique_ptr<BweModel> model = Parse(data);
+  if (!model)
+    RTC_LOG(LS_ERROR) << "Invalid BWE model " << path;
+  return model;
+}
+
+std::unique_ptr<BweModel> BweModel::Parse(rtc::ArrayView<const uint8_t> data) {
+  Reader reader(data);
+  char magic[sizeof(kMagic)];
+  uint32_t version;
+  uint32_t input_size;
+  uint32_t num_layers;
+  if (!reader.Read(magic, sizeof(magic)) ||
+      memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader.ReadUint32(&version) || version != kVersion ||
+      !reader.ReadUint32(&input_size) || !reader.ReadUint32(&num_layers) ||
+      num_layers == 0 || num_layers > kMaxLayers) {
+    return nullptr;
+  }
+  const Optimization optimization = DetectOptimization();
+  std::vector<std::unique_ptr<Layer>> layers;
+  size_t next_input_size = input_size;
+  for (uint32_t i = 0; i < num_layers; ++i) {
+    std::unique_ptr<Layer> layer = ReadLayer(&reader, optimization);
+    if (!layer || layer->input_size() != next_input_size)
+      return nullptr;
+    next_input_size = layer->output_size();
+    layers.push_back(std::move(layer));
+  }
+  if (!reader.done())
+    return nullptr;
+  return std::unique_ptr<BweModel>(new BweModel(std::move(layers)));
+}
+
+BweModel::BweModel(std::vector<std::unique_ptr<Layer>> layers)
+    : layers_(std::move(layers)) {
+  RTC_DCHECK(!layers_.empty());
+}
+
+BweModel::~BweModel() = default;
+
+void BweModel::Reset() {
+  for (const std::unique_ptr<Layer>& layer : layers_)
+    layer->Reset();
+}
+
+rtc::ArrayView<const float> BweModel::Step(rtc::ArrayView<const float> input) {
+  for (const std::unique_ptr<Layer>& layer : layers_)
+    input = layer->ComputeOutput(input);
+  return input;
+}
+
+}  // namespace bwe_model
+}  // namespace webrtc
@@ -0,0 +1,192 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+namespace bwe_model {
+
+enum class Optimization { kNone, kSse2, kNeon };
+
+// Detects what kind of optimizations to use for the code.
+Optimization DetectOptimization();
+
+enum class Activation { kLinear, kRelu, kSigmoid, kTanh };
+
+// Weights as stored in a model file: |rows| x |cols| row-major int8 values,
+// each row scaled by its own factor. Layers expand them to float once.
+struct QuantizedMatrix {
+  size_t rows = 0;
+  size_t cols = 0;
+  std::vector<int8_t> values;
+  std::vector<float> row_scales;
+};
+
+// A layer of a BweModel. Layers are not thread safe and keep their output,
+// and recurrent layers their state, between two calls to ComputeOutput().
+class Layer {
+ public:
+  virtual ~Layer() = default;
+  virtual size_t input_size() const = 0;
+  virtual size_t output_size() const = 0;
+  // Clears the recurrent state, if any.
+  virtual void Reset() {}
+  // Returns the output for |input|, valid until the next call.
+  virtual rtc::ArrayView<const float> ComputeOutput(
+      rtc::ArrayView<const float> input) = 0;
+};
+
+// ONNX Gemm with transB=1: |weights| * input + |bias|.
+class DenseLayer : public Layer {
+ public:
+  DenseLayer(const QuantizedMatrix& weights,
+             std::vector<float> bias,
+             Optimization optimization);
+  ~DenseLayer() override;
+
+  size_t input_size() const override { return input_size_; }
+  size_t output_size() const override { return output_size_; }
+  rtc::ArrayView<const float> ComputeOutput(
+      rtc::ArrayView<const float> input) override;
+
+ private:
+  const size_t input_size_;
+  const size_t output_size_;
+  const std::vector<float> weights_;
+  const std::vector<float> bias_;
+  const Optimization optimization_;
+  std::vector<float> output_;
+};
+
+// Element-wise activation.
+class ActivationLayer : public Layer {
+ public:
+  ActivationLayer(size_t size, Activation activation);
+  ~ActivationLayer() override;
+
+  size_t input_size() const override { return output_.size(); }
+  size_t output_size() const override { return output_.size(); }
+  rtc::ArrayView<const float> ComputeOutput(
+      rtc::ArrayView<const float> input) override;
+
+ private:
+  const Activation activation_;
+  std::vector<float> output_;
+};
+
+// ONNX GRU with the default activations and linear_before_reset=0, in the
+// ONNX layout: gates in z, r, h order, |bias| is Wb followed by Rb.
+class GruLayer : public Layer {
+ public:
+  GruLayer(const QuantizedMatrix& weights,
+           const QuantizedMatrix& recurrent_weights,
+           std::vector<float> bias,
+           Optimization optimization);
+  ~GruLayer() override;
+
+  size_t input_size() const override { return input_size_; }
+  size_t output_size() const override { return state_.size(); }
+  void Reset() override;
+  rtc::ArrayView<const float> ComputeOutput(
+      rtc::ArrayView<const float> input) override;
+
+ private:
+  const size_t input_size_;
+  const std::vector<float> weights_;
+  const std::vector<float> recurrent_weights_;
+  const std::vector<float> bias_;
+  const Optimization optimization_;
+  std::vector<float> state_;
+  // Scratch space for the gates.
+  std::vector<float> input_gates_;
+  std::vector<float> recurrent_gates_;
+  std::vector<float> reset_state_;
+};
+
+// ONNX LSTM with the default activations and no peepholes, in the ONNX
+// layout: gates in i, o, f, c order, |bias| is Wb followed by Rb.
+class LstmLayer : public Layer {
+ public:
+  LstmLayer(const QuantizedMatrix& weights,
+            const QuantizedMatrix& recurrent_weights,
+            std::vector<float> bias,
+            Optimization optimization);
+  ~LstmLayer() override;
+
+  size_t input_size() const override { return input_size_; }
+  size_t output_size() const override { return state_.size(); }
+  void Reset() override;
+  rtc::ArrayView<const float> ComputeOutput(
+      rtc::ArrayView<const float> input) override;
+
+ private:
+  const size_t input_size_;
+  const std::vector<float> weights_;
+  const std::vector<float> recurrent_weights_;
+  const std::vector<float> bias_;
+  const Optimization optimization_;
+  std::vector<float> state_;
+  std::vector<float> cell_;
+  // Scratch space for the gates.
+  std::vector<float> gates_;
+  std::vector<float> recurrent_gates_;
+};
+
+// A small network run one step at a time, as exported from ONNX by
+// tools/onnx_to_bwe_model.py. Only the operators above are supported, which
+// covers the recurrent networks used for bandwidth estimation without pulling
+// in ONNXRuntime.
+//
+// File format, little-endian:
+//   "BWEM", uint32 version (1), uint32 input size, uint32 layer count,
+//   then for each layer uint32 type and the type specific payload:
+//   - 0 dense: matrix weights, float bias[rows]
+//   - 1 activation: uint32 size, uint32 Activation
+//   - 2 gru: matrix weights, matrix recurrent weights, float bias[2 * rows]
+//   - 3 lstm: same as gru
+//   where a matrix is uint32 rows, uint32 cols, float row_scales[rows] and
+//   int8 values[rows * cols].
+class BweModel {
+ public:
+  // Returns null if |path| can't be read or is not a valid model.
+  static std::unique_ptr<BweModel> Load(const std::string& path);
+  static std::unique_ptr<BweModel> Parse(rtc::ArrayView<const uint8_t> data);
+  ~BweModel();
+
+  BweModel(const BweModel&) = delete;
+  BweModel& operator=(const BweModel&) = delete;
+
+  size_t input_size() const { return layers_.front()->input_size(); }
+  size_t output_size() const { return layers_.back()->output_size(); }
+  // Clears the recurrent state.
+  void Reset();
+  // Runs one step; the output is valid until the next call.
+  rtc::ArrayView<const float> Step(rtc::ArrayView<const float> input);
+
+ private:
+  explicit BweModel(std::vector<std::unique_ptr<Layer>> layers);
+
+  const std::vector<std::unique_ptr<Layer>> layers_;
+};
+
+}  // namespace bwe_model
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_H_
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_model_bandwidth_estimator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Same as the minimum bitrate of the congestion controller.
+constexpr float kMinEstimateBps = 5000;
+
+// Returns |model| if it takes the features the estimator produces.
+std::unique_ptr<bwe_model::BweModel> CheckModel(
+    std::unique_ptr<bwe_model::BweModel> model) {
+  constexpr size_t kNumFeatures = BweModelBandwidthEstimator::kNumFeatures;
+  if (model &&
+      (model->input_size() != kNumFeatures || model->output_size() == 0)) {
+    RTC_LOG(LS_ERROR) << "BWE model expects " << model->input_size()
+                      << " features instead of " << kNumFeatures;
+    return nullptr;
+  }
+  return model;
+}
+
+}  // namespace
+
+constexpr int64_t BweModelBandwidthEstimator::kStepMs;
+constexpr size_t BweModelBandwidthEstimator::kNumFeatures;
+
+BweModelBandwidthEstimator::BweModelBandwidthEstimator(
+    const std::string& model_path)
+    : BweModelBandwidthEstimator(bwe_model::BweModel::Load(model_path)) {}
+
+BweModelBandwidthEstimator::BweModelBandwidthEstimator(
+    std::unique_ptr<bwe_model::BweModel> model)
+    : model_(CheckModel(std::move(model))) {}
+
+BweModelBandwidthEstimator::~BweModelBandwidthEstimator() = default;
+
+void BweModelBandwidthEstimator::OnPacket(const ReceivedPacketInfo& packet) {
+  OnPacketBatch(rtc::MakeArrayView(&packet, 1));
+}
+
+void BweModelBandwidthEstimator::OnPacketBatch(
+    rtc::ArrayView<const ReceivedPacketInfo> packets) {
+  features_.clear();
+  feature_extractor_.AddPackets(packets, &features_);
+  if (!model_)
+    return;
+  for (size_t i = 0; i < features_.size(); i += kNumFeatures) {
+    rtc::ArrayView<const float> step_features(&features_[i], kNumFeatures);
+    float estimate_bps = model_->Step(step_features)[0] * 1e6f;
+    estimate_bps_ = std::max(estimate_bps, kMinEstimateBps);
+  }
+}
+
+float BweModelBandwidthEstimator::GetEstimate() {
+  return estimate_bps_.value_or(0);
+}
+
+bool BweModelBandwidthEstimator::IsReady() const {
+  return estimate_bps_.has_value();
+}
+
+}  // namespace webrtc
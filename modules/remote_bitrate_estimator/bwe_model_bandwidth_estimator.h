@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_BANDWIDTH_ESTIMATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_BANDWIDTH_ESTIMATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "modules/remote_bitrate_estimator/bwe_model.h"
+#include "modules/remote_bitrate_estimator/bwe_model_features.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+
+namespace webrtc {
+
+// Runs a bwe_model::BweModel in-tree instead of going through ONNXRuntime.
+// The model is run once per step of kStepMs, on the features of
+// BweModelFeatureExtractor. The first output of the model is the estimate in
+// Mbps.
+class BweModelBandwidthEstimator : public ReceiveSideBandwidthEstimator {
+ public:
+  static constexpr int64_t kStepMs = BweModelFeatureExtractor::kStepMs;
+  static constexpr size_t kNumFeatures = BweModelFeatureExtractor::kNumFeatures;
+
+  explicit BweModelBandwidthEstimator(const std::string& model_path);
+  // |model| may be null, in which case the estimator is never ready.
+  explicit BweModelBandwidthEstimator(
+      std::unique_ptr<bwe_model::BweModel> model);
+  ~BweModelBandwidthEstimator() override;
+
+  BweModelBandwidthEstimator(const BweModelBandwidthEstimator&) = delete;
+  BweModelBandwidthEstimator& operator=(const BweModelBandwidthEstimator&) =
+      delete;
+
+  void OnPacket(const ReceivedPacketInfo& packet) override;
+  void OnPacketBatch(
+      rtc::ArrayView<const ReceivedPacketInfo> packets) override;
+  float GetEstimate() override;
+  bool IsReady() const override;
+
+ private:
+  const std::unique_ptr<bwe_model::BweModel> model_;
+  BweModelFeatureExtractor feature_extractor_;
+  // The features of the steps ended by the latest batch, reused between
+  // batches.
+  std::vector<float> features_;
+  absl::optional<float> estimate_bps_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_BANDWIDTH_ESTIMATOR_H_
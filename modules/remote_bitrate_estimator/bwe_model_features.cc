@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_model_features.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace webrtc {
+namespace {
+
+// Longer gaps are not replayed step by step, the model just sees one empty
+// step.
+constexpr int64_t kMaxEmptySteps = 10;
+
+}  // namespace
+
+constexpr int64_t BweModelFeatureExtractor::kStepMs;
+constexpr size_t BweModelFeatureExtractor::kNumFeatures;
+
+BweModelFeatureExtractor::BweModelFeatureExtractor() = default;
+
+BweModelFeatureExtractor::~BweModelFeatureExtractor() = default;
+
+void BweModelFeatureExtractor::AddPackets(
+    rtc::ArrayView<const ReceivedPacketInfo> packets,
+    std::vector<float>* features) {
+  if (packets.empty())
+    return;
+  SplitFields(packets);
+  if (!step_start_ms_)
+    step_start_ms_ = arrival_times_ms_[0];
+
+  const size_t num_packets = arrival_times_ms_.size();
+  size_t begin = 0;
+  while (true) {
+    const int64_t step_end_ms = *step_start_ms_ + kStepMs;
+    size_t end = begin;
+    while (end < num_packets && arrival_times_ms_[end] < step_end_ms)
+      ++end;
+    AccumulateStep(begin, end);
+    if (end == num_packets)
+      return;
+
+    // |end| is the first packet of a later step.
+    FinishStep(features);
+    int64_t empty_steps =
+        (arrival_times_ms_[end] - *step_start_ms_) / kStepMs;
+    if (empty_steps > kMaxEmptySteps) {
+      FinishStep(features);
+      step_start_ms_ = arrival_times_ms_[end];
+    } else {
+      for (int64_t i = 0; i < empty_steps; ++i)
+        FinishStep(features);
+    }
+    begin = end;
+  }
+}
+
+void BweModelFeatureExtractor::SplitFields(
+    rtc::ArrayView<const ReceivedPacketInfo> packets) {
+  arrival_times_ms_.resize(packets.size());
+  sizes_.resize(packets.size());
+  delays_us_.resize(packets.size());
+  loss_counts_.resize(packets.size());
+  rtts_ms_.resize(packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const ReceivedPacketInfo& packet = packets[i];
+    arrival_times_ms_[i] = packet.arrival_time_ms;
+    sizes_[i] =
+        packet.payload_size + packet.header_length + packet.padding_length;
+    const int64_t send_time_us =
+        packet.send_time_us.value_or(int64_t{packet.send_time_ms} * 1000);
+    delays_us_[i] = packet.arrival_time_ms * 1000 - send_time_us;
+    loss_counts_[i] = std::max(packet.loss_count, 0);
+    rtts_ms_[i] = packet.rtt_ms;
+  }
+}
+
+void BweModelFeatureExtractor::AccumulateStep(size_t begin, size_t end) {
+  if (begin == end)
+    return;
+  int64_t bytes = 0;
+  for (size_t i = begin; i < end; ++i)
+    bytes += sizes_[i];
+  int64_t lost_packets = 0;
+  for (size_t i = begin; i < end; ++i)
+    lost_packets += loss_counts_[i];
+  int64_t delay_sum_us = 0;
+  int64_t min_delay_us = std::numeric_limits<int64_t>::max();
+  for (size_t i = begin; i < end; ++i) {
+    delay_sum_us += delays_us_[i];
+    min_delay_us = std::min(min_delay_us, delays_us_[i]);
+  }
+  for (size_t i = end; i > begin; --i) {
+    if (rtts_ms_[i - 1] >= 0) {
+      rtt_ms_ = rtts_ms_[i - 1];
+      break;
+    }
+  }
+
+  step_bytes_ += bytes;
+  step_packets_ += end - begin;
+  step_lost_packets_ += lost_packets;
+  step_delay_sum_us_ += delay_sum_us;
+  min_delay_us_ = std::min(min_delay_us_.value_or(min_delay_us), min_delay_us);
+}
+
+void BweModelFeatureExtractor::FinishStep(std::vector<float>* features) {
+  double mean_delay_us = last_mean_delay_us_;
+  if (step_packets_ > 0) {
+    mean_delay_us = static_cast<double>(step_delay_sum_us_) / step_packets_ -
+                    *min_delay_us_;
+  }
+  int64_t expected_packets = step_packets_ + step_lost_packets_;
+
+  features->push_back(step_bytes_ * 8.f / (kStepMs * 1000.f));
+  features->push_back(mean_delay_us / 1e6);
+  features->push_back((mean_delay_us - last_mean_delay_us_) / 1e6);
+  features->push_back(
+      expected_packets > 0
+          ? static_cast<float>(step_lost_packets_) / expected_packets
+          : 0.f);
+  features->push_back(rtt_ms_ >= 0 ? rtt_ms_ / 1000.f : 0.f);
+
+  *step_start_ms_ += kStepMs;
+  step_bytes_ = 0;
+  step_packets_ = 0;
+  step_lost_packets_ = 0;
+  step_delay_sum_us_ = 0;
+  last_mean_delay_us_ = mean_delay_us;
+}
+
+}  // namespace webrtc
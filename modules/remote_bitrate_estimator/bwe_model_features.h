@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_FEATURES_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_FEATURES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+
+namespace webrtc {
+
+// Computes the input of the BWE model from the received packets. Packets are
+// aggregated into steps of kStepMs, and each step gives these features, in
+// this order:
+//   0: received rate in Mbps, headers and padding included.
+//   1: mean one way delay above the minimum seen so far, in seconds. Computed
+//      in microseconds from ReceivedPacketInfo::send_time_us when known.
+//   2: change of that delay since the previous step, in seconds.
+//   3: fraction of packets lost.
+//   4: latest RTT in seconds, 0 if unknown.
+// rtc_tools/alphacc_dataset/bwe_model_features.py computes the same features
+// from the exported datasets, for training.
+//
+// Batches are first split into one array per packet field, so that each
+// feature of a step is a plain loop over contiguous values, which the
+// compiler vectorizes.
+class BweModelFeatureExtractor {
+ public:
+  static constexpr int64_t kStepMs = 100;
+  static constexpr size_t kNumFeatures = 5;
+
+  BweModelFeatureExtractor();
+  ~BweModelFeatureExtractor();
+
+  BweModelFeatureExtractor(const BweModelFeatureExtractor&) = delete;
+  BweModelFeatureExtractor& operator=(const BweModelFeatureExtractor&) =
+      delete;
+
+  // Adds |packets|, in arrival order, and appends the features of the steps
+  // they end to |features|, kNumFeatures per step, so that |features| is the
+  // model input of these steps in row-major order. The step of the last
+  // packet is only ended by a later packet.
+  void AddPackets(rtc::ArrayView<const ReceivedPacketInfo> packets,
+                  std::vector<float>* features);
+
+ private:
+  void SplitFields(rtc::ArrayView<const ReceivedPacketInfo> packets);
+  // Adds the packets [begin, end) of the split batch to the current step.
+  void AccumulateStep(size_t begin, size_t end);
+  void FinishStep(std::vector<float>* features);
+
+  // The fields of the batch being added, reused between batches.
+  std::vector<int64_t> arrival_times_ms_;
+  std::vector<int64_t> sizes_;
+  std::vector<int64_t> delays_us_;
+  std::vector<int32_t> loss_counts_;
+  std::vector<int64_t> rtts_ms_;
+
+  absl::optional<int64_t> step_start_ms_;
+  int64_t step_bytes_ = 0;
+  int64_t step_packets_ = 0;
+  int64_t step_lost_packets_ = 0;
+  int64_t step_delay_sum_us_ = 0;
+  absl::optional<int64_t> min_delay_us_;
+  double last_mean_delay_us_ = 0;
+  int64_t rtt_ms_ = -1;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_FEATURES_H_
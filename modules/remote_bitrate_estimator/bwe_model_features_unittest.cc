@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_model_features.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumFeatures = BweModelFeatureExtractor::kNumFeatures;
+
+ReceivedPacketInfo Packet(int64_t arrival_time_ms,
+                          uint32_t send_time_ms,
+                          size_t payload_size,
+                          size_t padding_length,
+                          int32_t loss_count,
+                          int64_t rtt_ms) {
+  ReceivedPacketInfo packet;
+  packet.arrival_time_ms = arrival_time_ms;
+  packet.send_time_ms = send_time_ms;
+  packet.payload_size = payload_size;
+  packet.header_length = 20;
+  packet.padding_length = padding_length;
+  packet.loss_count = loss_count;
+  packet.rtt_ms = rtt_ms;
+  return packet;
+}
+
+// Covers a partial step, an empty step, and a gap too long to be replayed.
+std::vector<ReceivedPacketInfo> CreatePackets() {
+  return {Packet(1000, 900, 1000, 0, -1, -1),
+          Packet(1040, 930, 1000, 0, 0, 50),
+          Packet(1090, 975, 500, 10, 2, -1),
+          Packet(1130, 1010, 1000, 0, 0, -1),
+          Packet(1350, 1200, 1200, 0, 1, 80),
+          Packet(1360, 1230, 800, 0, 0, -1),
+          Packet(3000, 2850, 1000, 0, 0, -1),
+          Packet(3100, 2950, 1000, 0, 0, -1)};
+}
+
+// Computed from the same packets by compute_features() of
+// rtc_tools/alphacc_dataset/bwe_model_features.py.
+const std::vector<std::vector<double>> kExpectedFeatures = {
+    {0.2056, 0.00833333333, 0.00833333333, 0.4, 0.05},
+    {0.0816, 0.02, 0.0116666667, 0, 0.05},
+    {0, 0.02, 0, 0, 0.05},
+    {0.1632, 0.04, 0.02, 0.333333333, 0.08},
+    {0, 0.04, 0, 0, 0.08},
+    {0.0816, 0.05, 0.01, 0, 0.08}};
+
+void ExpectFeatures(const std::vector<float>& features) {
+  ASSERT_EQ(features.size(), kExpectedFeatures.size() * kNumFeatures);
+  for (size_t step = 0; step < kExpectedFeatures.size(); ++step) {
+    for (size_t i = 0; i < kNumFeatures; ++i) {
+      EXPECT_NEAR(features[step * kNumFeatures + i], kExpectedFeatures[step][i],
+                  1e-6)
+          << "step " << step << ", feature " << i;
+    }
+  }
+}
+
+TEST(BweModelFeatureExtractorTest, MatchesTrainingFeatures) {
+  const std::vector<ReceivedPacketInfo> packets = CreatePackets();
+  BweModelFeatureExtractor extractor;
+  std::vector<float> features;
+  extractor.AddPackets(packets, &features);
+  ExpectFeatures(features);
+}
+
+TEST(BweModelFeatureExtractorTest, DoesNotDependOnTheBatches) {
+  const std::vector<ReceivedPacketInfo> packets = CreatePackets();
+  for (size_t batch_size = 1; batch_size < packets.size(); ++batch_size) {
+    BweModelFeatureExtractor extractor;
+    std::vector<float> features;
+    rtc::ArrayView<const ReceivedPacketInfo> remaining(packets);
+    while (!remaining.empty()) {
+      size_t size = std::min(batch_size, remaining.size());
+      extractor.AddPackets(remaining.subview(0, size), &features);
+      remaining = remaining.subview(size);
+    }
+    SCOPED_TRACE(batch_size);
+    ExpectFeatures(features);
+  }
+}
+
+TEST(BweModelFeatureExtractorTest, UsesMicrosecondSendTimes) {
+  std::vector<ReceivedPacketInfo> packets = CreatePackets();
+  // Half a millisecond later than |send_time_ms| tells, but for the first.
+  for (size_t i = 1; i < packets.size(); ++i)
+    packets[i].send_time_us = int64_t{packets[i].send_time_ms} * 1000 + 500;
+  BweModelFeatureExtractor extractor;
+  std::vector<float> features;
+  extractor.AddPackets(packets, &features);
+  ASSERT_GE(features.size(), kNumFeatures);
+  // Delays of 100, 109.5 and 114.5 ms.
+  EXPECT_NEAR(features[1], 0.008, 1e-6);
+  EXPECT_NEAR(features[2], 0.008, 1e-6);
+}
+
+TEST(BweModelFeatureExtractorTest, KeepsTheLastStepOpen) {
+  BweModelFeatureExtractor extractor;
+  std::vector<float> features;
+  std::vector<ReceivedPacketInfo> packets = {Packet(0, 0, 1000, 0, 0, -1),
+                                             Packet(99, 99, 1000, 0, 0, -1)};
+  extractor.AddPackets(packets, &features);
+  EXPECT_TRUE(features.empty());
+
+  packets = {Packet(100, 100, 1000, 0, 0, -1)};
+  extractor.AddPackets(packets, &features);
+  ASSERT_EQ(features.size(), kNumFeatures);
+  EXPECT_NEAR(features[0], 2 * 1020 * 8 / 100000.0, 1e-6);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_model_manager.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+BweModelManager* BweModelManager::GetProcessWide() {
+  // Leaked on purpose, calls may still unregister during shutdown.
+  static BweModelManager* const manager = new BweModelManager();
+  return manager;
+}
+
+BweModelManager::BweModelManager() = default;
+
+BweModelManager::~BweModelManager() {
+  RTC_DCHECK(sessions_.empty());
+}
+
+bool BweModelManager::SetModelVersions(std::vector<ModelVersion> versions,
+                                       bool switch_existing_sessions) {
+  int total_percent = 0;
+  for (const ModelVersion& version : versions) {
+    if (version.version.empty() || version.model_path.empty() ||
+        version.percent < 0) {
+      return false;
+    }
+    total_percent += version.percent;
+  }
+  if (!versions.empty() && total_percent != 100)
+    return false;
+
+  rtc::CritScope cs(&lock_);
+  versions_ = std::move(versions);
+  RTC_LOG(LS_INFO) << "Rolling out " << versions_.size()
+                   << " BWE model versions.";
+  if (!switch_existing_sessions || versions_.empty())
+    return true;
+  for (auto& id_and_session : sessions_) {
+    Session& session = id_and_session.second;
+    const ModelVersion* version = FindModelVersion(id_and_session.first);
+    if (version->version == session.model_version)
+      continue;
+    session.model_version = version->version;
+    session.on_switch(*version);
+  }
+  return true;
+}
+
+absl::optional<BweModelManager::ModelVersion> BweModelManager::GetModelVersion(
+    uint32_t session_id) const {
+  rtc::CritScope cs(&lock_);
+  const ModelVersion* version = FindModelVersion(session_id);
+  if (!version)
+    return absl::nullopt;
+  return *version;
+}
+
+void BweModelManager::AddSession(uint32_t session_id,
+                                 const std::string& model_version,
+                                 SwitchCallback on_switch) {
+  RTC_DCHECK(on_switch);
+  rtc::CritScope cs(&lock_);
+  Session& session = sessions_[session_id];
+  RTC_DCHECK(!session.on_switch) << "Session id used twice.";
+  session.model_version = model_version;
+  session.on_switch = std::move(on_switch);
+  const ModelVersion* version = FindModelVersion(session_id);
+  if (version && version->version != session.model_version) {
+    session.model_version = version->version;
+    session.on_switch(*version);
+  }
+}
+
+void BweModelManager::RemoveSession(uint32_t session_id) {
+  rtc::CritScope cs(&lock_);
+  sessions_.erase(session_id);
+}
+
+const BweModelManager::ModelVersion* BweModelManager::FindModelVersion(
+    uint32_t session_id) const {
+  const int percentile = session_id % 100;
+  int upper_percentile = 0;
+  for (const ModelVersion& version : versions_) {
+    upper_percentile += version.percent;
+    if (percentile < upper_percentile)
+      return &version;
+  }
+  return nullptr;
+}
+
+}  // namespace webrtc
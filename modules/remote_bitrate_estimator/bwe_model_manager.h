@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_MANAGER_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_MANAGER_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Decides which model the receive side estimator of each call runs, so that
+// new model versions can be rolled out, and A/B tested, without restarting the
+// process. Until model versions are set, the calls run the model of their
+// AlphaCCConfig.
+//
+// Calls are assigned to the versions by their session id: the id modulo 100
+// picks the percentile, and the versions cover the percentiles in order. A
+// call therefore only changes version when the share of its percentile does.
+class BweModelManager {
+ public:
+  struct ModelVersion {
+    // Reported in the stats of the calls running it.
+    std::string version;
+    // Replaces the model path of the configured estimator, e.g.
+    // AlphaCCConfig::onnx_model_path.
+    std::string model_path;
+    // Share of the calls running this version.
+    int percent = 100;
+  };
+  // Tells a call to switch to |version|. Called with the manager's lock held,
+  // so it must not call back into the manager.
+  using SwitchCallback = std::function<void(const ModelVersion& version)>;
+
+  // The manager of the receivers of the process. Never destroyed.
+  static BweModelManager* GetProcessWide();
+
+  BweModelManager();
+  ~BweModelManager();
+
+  BweModelManager(const BweModelManager&) = delete;
+  BweModelManager& operator=(const BweModelManager&) = delete;
+
+  // Replaces the model versions. The percentages must add up to 100, an empty
+  // list goes back to the configured models for the new calls. Calls already
+  // running keep their version, unless |switch_existing_sessions| is set, in
+  // which case the calls assigned to another version are told to switch,
+  // which they do once the new model is loaded and ready. Returns false and
+  // changes nothing if |versions| is invalid.
+  bool SetModelVersions(std::vector<ModelVersion> versions,
+                        bool switch_existing_sessions);
+
+  // Returns the version a new call with |session_id| runs, if any.
+  absl::optional<ModelVersion> GetModelVersion(uint32_t session_id) const;
+
+  // Registers the call with |session_id|, which runs |model_version|, empty
+  // for the configured model. |on_switch| is called right away if the call is
+  // assigned another version by now, e.g. because the versions changed while
+  // it was created.
+  void AddSession(uint32_t session_id,
+                  const std::string& model_version,
+                  SwitchCallback on_switch);
+  void RemoveSession(uint32_t session_id);
+
+ private:
+  struct Session {
+    std::string model_version;
+    SwitchCallback on_switch;
+  };
+
+  const ModelVersion* FindModelVersion(uint32_t session_id) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  rtc::CriticalSection lock_;
+  std::vector<ModelVersion> versions_ RTC_GUARDED_BY(lock_);
+  std::map<uint32_t, Session> sessions_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_MODEL_MANAGER_H_
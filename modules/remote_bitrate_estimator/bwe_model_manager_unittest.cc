@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_model_manager.h"
+
+#include <string>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+BweModelManager::ModelVersion Version(const std::string& version,
+                                      int percent) {
+  BweModelManager::ModelVersion model_version;
+  model_version.version = version;
+  model_version.model_path = version + ".onnx";
+  model_version.percent = percent;
+  return model_version;
+}
+
+// Records the versions a session is told to switch to.
+class SwitchRecorder {
+ public:
+  BweModelManager::SwitchCallback Callback() {
+    return [this](const BweModelManager::ModelVersion& model_version) {
+      versions_.push_back(model_version.version);
+    };
+  }
+  const std::vector<std::string>& versions() const { return versions_; }
+
+ private:
+  std::vector<std::string> versions_;
+};
+
+TEST(BweModelManagerTest, UsesConfiguredModelWithoutVersions) {
+  BweModelManager manager;
+  EXPECT_FALSE(manager.GetModelVersion(7));
+}
+
+TEST(BweModelManagerTest, AssignsVersionsByPercentile) {
+  BweModelManager manager;
+  ASSERT_TRUE(manager.SetModelVersions({Version("a", 10), Version("b", 90)},
+                                       /*switch_existing_sessions=*/false));
+  EXPECT_EQ(manager.GetModelVersion(109)->version, "a");
+  EXPECT_EQ(manager.GetModelVersion(110)->version, "b");
+  EXPECT_EQ(manager.GetModelVersion(110)->model_path, "b.onnx");
+  EXPECT_EQ(manager.GetModelVersion(199)->version, "b");
+}
+
+TEST(BweModelManagerTest, RejectsInvalidVersions) {
+  BweModelManager manager;
+  ASSERT_TRUE(manager.SetModelVersions({Version("a", 100)},
+                                       /*switch_existing_sessions=*/false));
+  EXPECT_FALSE(manager.SetModelVersions({Version("b", 50)},
+                                        /*switch_existing_sessions=*/false));
+  EXPECT_FALSE(manager.SetModelVersions({Version("", 100)},
+                                        /*switch_existing_sessions=*/false));
+  EXPECT_EQ(manager.GetModelVersion(0)->version, "a");
+
+  // No versions are valid and go back to the configured model.
+  EXPECT_TRUE(manager.SetModelVersions({}, /*switch_existing_sessions=*/false));
+  EXPECT_FALSE(manager.GetModelVersion(0));
+}
+
+TEST(BweModelManagerTest, SwitchesExistingSessionsOnlyIfAsked) {
+  BweModelManager manager;
+  SwitchRecorder first;
+  SwitchRecorder second;
+  manager.AddSession(5, "", first.Callback());
+  manager.AddSession(50, "", second.Callback());
+
+  ASSERT_TRUE(manager.SetModelVersions({Version("a", 100)},
+                                       /*switch_existing_sessions=*/false));
+  EXPECT_THAT(first.versions(), IsEmpty());
+
+  ASSERT_TRUE(manager.SetModelVersions({Version("a", 100)},
+                                       /*switch_existing_sessions=*/true));
+  EXPECT_THAT(first.versions(), ElementsAre("a"));
+  EXPECT_THAT(second.versions(), ElementsAre("a"));
+
+  // Only the sessions whose percentile moved to another version switch.
+  ASSERT_TRUE(manager.SetModelVersions({Version("a", 20), Version("b", 80)},
+                                       /*switch_existing_sessions=*/true));
+  EXPECT_THAT(first.versions(), ElementsAre("a"));
+  EXPECT_THAT(second.versions(), ElementsAre("a", "b"));
+
+  manager.RemoveSession(5);
+  manager.RemoveSession(50);
+}
+
+TEST(BweModelManagerTest, SwitchesSessionStartedWithAnOldVersion) {
+  BweModelManager manager;
+  ASSERT_TRUE(manager.SetModelVersions({Version("b", 100)},
+                                       /*switch_existing_sessions=*/false));
+  SwitchRecorder up_to_date;
+  SwitchRecorder outdated;
+  manager.AddSession(1, "b", up_to_date.Callback());
+  manager.AddSession(2, "a", outdated.Callback());
+  EXPECT_THAT(up_to_date.versions(), IsEmpty());
+  EXPECT_THAT(outdated.versions(), ElementsAre("b"));
+  manager.RemoveSession(1);
+  manager.RemoveSession(2);
+}
+
+}  // namespace
+}  // namespace webrtc
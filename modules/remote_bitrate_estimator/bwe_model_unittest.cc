@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_model.h"
+
+#include <string.h>
+
+#include <cmath>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bwe_model {
+namespace {
+
+float Sigmoid(float x) {
+  return 1.f / (1.f + std::exp(-x));
+}
+
+// Writes the model file format documented in bwe_model.h.
+class ModelWriter {
+ public:
+  ModelWriter(uint32_t input_size, uint32_t num_layers) {
+    data_ = {'B', 'W', 'E', 'M'};
+    WriteUint32(1);
+    WriteUint32(input_size);
+    WriteUint32(num_layers);
+  }
+
+  void WriteUint32(uint32_t value) {
+    for (int i = 0; i < 4; ++i)
+      data_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+  void WriteFloat(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteUint32(bits);
+  }
+  // |values| is row-major, all rows are scaled by |scale|.
+  void WriteMatrix(uint32_t rows,
+                   uint32_t cols,
+                   float scale,
+                   const std::vector<int8_t>& values) {
+    WriteUint32(rows);
+    WriteUint32(cols);
+    for (uint32_t r = 0; r < rows; ++r)
+      WriteFloat(scale);
+    for (int8_t value : values)
+      data_.push_back(static_cast<uint8_t>(value));
+  }
+  void WriteFloats(const std::vector<float>& values) {
+    for (float value : values)
+      WriteFloat(value);
+  }
+
+  const std::vector<uint8_t>& data() const { return data_; }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+TEST(BweModelTest, DenseAndActivation) {
+  ModelWriter writer(2, 2);
+  writer.WriteUint32(0);  // Dense.
+  writer.WriteMatrix(2, 2, 0.5f, {2, 4, -2, 0});
+  writer.WriteFloats({1.f, 0.5f});
+  writer.WriteUint32(1);  // Activation.
+  writer.WriteUint32(2);
+  writer.WriteUint32(static_cast<uint32_t>(Activation::kRelu));
+
+  std::unique_ptr<BweModel> model = BweModel::Parse(writer.data());
+  ASSERT_TRUE(model);
+  EXPECT_EQ(model->input_size(), 2u);
+  EXPECT_EQ(model->output_size(), 2u);
+  std::vector<float> input = {1.f, 2.f};
+  rtc::ArrayView<const float> output = model->Step(input);
+  ASSERT_EQ(output.size(), 2u);
+  // 0.5 * (2 * 1 + 4 * 2) + 1 and relu(0.5 * (-2 * 1) + 0.5).
+  EXPECT_FLOAT_EQ(output[0], 6.f);
+  EXPECT_FLOAT_EQ(output[1], 0.f);
+}
+
+TEST(BweModelTest, GruMatchesOnnxDefinition) {
+  // One input and one hidden unit, gates in z, r, h order.
+  const float kScale = 0.1f;
+  const std::vector<int8_t> w = {3, -4, 5};
+  const std::vector<int8_t> r = {2, 6, -7};
+  const std::vector<float> wb = {0.1f, 0.2f, 0.3f};
+  const std::vector<float> rb = {-0.1f, 0.05f, 0.2f};
+  ModelWriter writer(1, 1);
+  writer.WriteUint32(2);  // GRU.
+  writer.WriteMatrix(3, 1, kScale, w);
+  writer.WriteMatrix(3, 1, kScale, r);
+  writer.WriteFloats({wb[0], wb[1], wb[2], rb[0], rb[1], rb[2]});
+
+  std::unique_ptr<BweModel> model = BweModel::Parse(writer.data());
+  ASSERT_TRUE(model);
+  float h = 0.f;
+  for (float x : {1.f, -0.5f, 2.f}) {
+    float z = Sigmoid(kScale * w[0] * x + wb[0] + kScale * r[0] * h + rb[0]);
+    float reset =
+        Sigmoid(kScale * w[1] * x + wb[1] + kScale * r[1] * h + rb[1]);
+    float candidate = std::tanh(kScale * w[2] * x + wb[2] +
+                                kScale * r[2] * (reset * h) + rb[2]);
+    h = (1 - z) * candidate + z * h;
+    std::vector<float> input = {x};
+    EXPECT_NEAR(model->Step(input)[0], h, 1e-6);
+  }
+  model->Reset();
+  std::vector<float> input = {1.f};
+  float z = Sigmoid(kScale * w[0] + wb[0] + rb[0]);
+  float candidate = std::tanh(kScale * w[2] + wb[2] + rb[2]);
+  EXPECT_NEAR(model->Step(input)[0], (1 - z) * candidate, 1e-6);
+}
+
+TEST(BweModelTest, LstmMatchesOnnxDefinition) {
+  // One input and one hidden unit, gates in i, o, f, c order.
+  const float kScale = 0.1f;
+  const std::vector<int8_t> w = {3, -4, 5, 8};
+  const std::vector<int8_t> r = {2, 6, -7, 1};
+  const std::vector<float> b = {0.1f, 0.2f, 0.3f, -0.2f,
+                                0.f,  0.1f, 0.f,  0.1f};
+  ModelWriter writer(1, 1);
+  writer.WriteUint32(3);  // LSTM.
+  writer.WriteMatrix(4, 1, kScale, w);
+  writer.WriteMatrix(4, 1, kScale, r);
+  writer.WriteFloats(b);
+
+  std::unique_ptr<BweModel> model = BweModel::Parse(writer.data());
+  ASSERT_TRUE(model);
+  float h = 0.f;
+  float c = 0.f;
+  for (float x : {1.f, -0.5f, 2.f}) {
+    float gates[4];
+    for (int g = 0; g < 4; ++g)
+      gates[g] = kScale * w[g] * x + kScale * r[g] * h + b[g] + b[4 + g];
+    c = Sigmoid(gates[2]) * c + Sigmoid(gates[0]) * std::tanh(gates[3]);
+    h = Sigmoid(gates[1]) * std::tanh(c);
+    std::vector<float> input = {x};
+    EXPECT_NEAR(model->Step(input)[0], h, 1e-6);
+  }
+}
+
+TEST(BweModelTest, SimdMatchesPlainDotProduct) {
+  // Long enough for the vectorized loop and a remainder.
+  const size_t kInputSize = 11;
+  QuantizedMatrix weights;
+  weights.rows = 2;
+  weights.cols = kInputSize;
+  weights.row_scales = {0.01f, 0.02f};
+  std::vector<float> input;
+  for (size_t i = 0; i < 2 * kInputSize; ++i)
+    weights.values.push_back(static_cast<int8_t>(13 * i - 100));
+  for (size_t i = 0; i < kInputSize; ++i)
+    input.push_back(0.25f * i - 1.f);
+
+  DenseLayer plain(weights, {0.f, 1.f}, Optimization::kNone);
+  DenseLayer optimized(weights, {0.f, 1.f}, DetectOptimization());
+  rtc::ArrayView<const float> expected = plain.ComputeOutput(input);
+  rtc::ArrayView<const float> output = optimized.ComputeOutput(input);
+  ASSERT_EQ(output.size(), expected.size());
+  for (size_t i = 0; i < output.size(); ++i)
+    EXPECT_NEAR(output[i], expected[i], 1e-5);
+}
+
+TEST(BweModelTest, RejectsInvalidModels) {
+  ModelWriter writer(3, 1);
+  writer.WriteUint32(0);  // Dense.
+  writer.WriteMatrix(1, 2, 1.f, {1, 1});
+  writer.WriteFloats({0.f});
+  // The layer takes 2 inputs instead of 3.
+  EXPECT_FALSE(BweModel::Parse(writer.data()));
+
+  ModelWriter truncated(2, 1);
+  truncated.WriteUint32(0);
+  truncated.WriteMatrix(1, 2, 1.f, {1});
+  EXPECT_FALSE(BweModel::Parse(truncated.data()));
+
+  ModelWriter unknown(2, 1);
+  unknown.WriteUint32(42);
+  EXPECT_FALSE(BweModel::Parse(unknown.data()));
+}
+
+}  // namespace
+}  // namespace bwe_model
+}  // namespace webrtc
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/onnx_bandwidth_estimator.h"
+
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+onnxinfer::PacketFeature ToPacketFeature(const ReceivedPacketInfo& packet) {
+  onnxinfer::PacketFeature feature = {};
+  feature.arrivalTimestamp = packet.arrival_time_ms;
+  feature.sendTimestamp = packet.send_time_ms;
+  feature.ssrc = packet.ssrc;
+  feature.paddingLength = static_cast<uint32_t>(packet.padding_length);
+  feature.headerLength = static_cast<uint32_t>(packet.header_length);
+  feature.payloadSize = static_cast<uint32_t>(packet.payload_size);
+  // Both are -1 when unknown, which the model expects as well.
+  feature.lossCount = packet.loss_count;
+  feature.rtt = packet.rtt_ms < 0 ? -1.0f : packet.rtt_ms / 1000.0f;
+  feature.sequenceNumber = packet.sequence_number;
+  feature.payloadType = packet.payload_type;
+  return feature;
+}
+
+}  // namespace
+
+OnnxBandwidthEstimator::OnnxBandwidthEstimator(
+    const std::string& model_path,
+    const OnnxModelOptions& model_options)
+    : model_(OnnxModel::Get(model_path, model_options)),
+      onnx_infer_(model_ ? model_->CreateInferInterface() : nullptr) {
+  if (!IsReady()) {
+    RTC_LOG(LS_ERROR) << "Failed to create onnx_infer_.";
+  }
+}
+
+OnnxBandwidthEstimator::~OnnxBandwidthEstimator() {
+  if (onnx_infer_) {
+    model_->DestroyInferInterface(onnx_infer_);
+  }
+}
+
+void OnnxBandwidthEstimator::OnPacket(const ReceivedPacketInfo& packet) {
+  OnPacketBatch(rtc::ArrayView<const ReceivedPacketInfo>(&packet, 1));
+}
+
+void OnnxBandwidthEstimator::OnPacketBatch(
+    rtc::ArrayView<const ReceivedPacketInfo> packets) {
+  if (!onnx_infer_ || packets.empty())
+    return;
+  features_.clear();
+  for (const ReceivedPacketInfo& packet : packets)
+    features_.push_back(ToPacketFeature(packet));
+  // A single call per batch amortizes the library call and model
+  // preprocessing over every packet in it.
+  onnxinfer::OnReceivedBatch(onnx_infer_, features_.data(), features_.size());
+}
+
+float OnnxBandwidthEstimator::GetEstimate() {
+  if (!onnx_infer_)
+    return 0;
+  return onnxinfer::GetBweEstimate(onnx_infer_);
+}
+
+bool OnnxBandwidthEstimator::IsReady() const {
+  return onnx_infer_ && onnxinfer::IsReady(onnx_infer_);
+}
+
+BatchedOnnxBandwidthEstimator::BatchedOnnxBandwidthEstimator(
+    const std::string& model_path,
+    const OnnxModelOptions& model_options,
+    int64_t interval_ms)
+    : session_(OnnxInferenceService::CreateSession(model_path,
+                                                   model_options,
+                                                   interval_ms)) {
+  if (!session_) {
+    RTC_LOG(LS_ERROR) << "Failed to create the inference session.";
+  }
+}
+
+BatchedOnnxBandwidthEstimator::~BatchedOnnxBandwidthEstimator() = default;
+
+void BatchedOnnxBandwidthEstimator::OnPacket(const ReceivedPacketInfo& packet) {
+  OnPacketBatch(rtc::ArrayView<const ReceivedPacketInfo>(&packet, 1));
+}
+
+void BatchedOnnxBandwidthEstimator::OnPacketBatch(
+    rtc::ArrayView<const ReceivedPacketInfo> packets) {
+  if (!session_ || packets.empty())
+    return;
+  features_.clear();
+  for (const ReceivedPacketInfo& packet : packets)
+    features_.push_back(ToPacketFeature(packet));
+  session_->OnPacketBatch(features_);
+}
+
+float BatchedOnnxBandwidthEstimator::GetEstimate() {
+  if (!session_)
+    return 0;
+  return session_->GetEstimate();
+}
+
+bool BatchedOnnxBandwidthEstimator::IsReady() const {
+  return session_ && session_->IsReady();
+}
+
+}  // namespace webrtc
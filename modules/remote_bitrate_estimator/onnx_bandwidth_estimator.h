@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_BANDWIDTH_ESTIMATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_BANDWIDTH_ESTIMATOR_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/remote_bitrate_estimator/onnx_inference_service.h"
+#include "modules/remote_bitrate_estimator/onnx_model_registry.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+#include "modules/third_party/onnxinfer/ONNXInferInterface.h"
+
+namespace webrtc {
+
+// Runs the ONNX model at |model_path| through the onnxinfer library. The model
+// is shared with every other estimator using the same file, see OnnxModel;
+// loading it happens in the constructor of the first one and may take a while.
+class OnnxBandwidthEstimator : public ReceiveSideBandwidthEstimator {
+ public:
+  OnnxBandwidthEstimator(const std::string& model_path,
+                         const OnnxModelOptions& model_options);
+  ~OnnxBandwidthEstimator() override;
+
+  OnnxBandwidthEstimator(const OnnxBandwidthEstimator&) = delete;
+  OnnxBandwidthEstimator& operator=(const OnnxBandwidthEstimator&) = delete;
+
+  void OnPacket(const ReceivedPacketInfo& packet) override;
+  void OnPacketBatch(rtc::ArrayView<const ReceivedPacketInfo> packets) override;
+  float GetEstimate() override;
+  bool IsReady() const override;
+
+ private:
+  // Declared before |onnx_infer_|, which must be destroyed first.
+  const std::shared_ptr<const OnnxModel> model_;
+  void* const onnx_infer_;
+  // Reused between batches so that batching does not allocate per packet.
+  std::vector<onnxinfer::PacketFeature> features_;
+};
+
+// Same as OnnxBandwidthEstimator, but runs the model in the batches of an
+// OnnxInferenceService ticking every |interval_ms|, together with the other
+// calls using the same model. The estimates are up to |interval_ms| older.
+class BatchedOnnxBandwidthEstimator : public ReceiveSideBandwidthEstimator {
+ public:
+  BatchedOnnxBandwidthEstimator(const std::string& model_path,
+                                const OnnxModelOptions& model_options,
+                                int64_t interval_ms);
+  ~BatchedOnnxBandwidthEstimator() override;
+
+  BatchedOnnxBandwidthEstimator(const BatchedOnnxBandwidthEstimator&) = delete;
+  BatchedOnnxBandwidthEstimator& operator=(
+      const BatchedOnnxBandwidthEstimator&) = delete;
+
+  void OnPacket(const ReceivedPacketInfo& packet) override;
+  void OnPacketBatch(rtc::ArrayView<const ReceivedPacketInfo> packets) override;
+  float GetEstimate() override;
+  bool IsReady() const override;
+
+ private:
+  const std::unique_ptr<OnnxInferenceService::Session> session_;
+  // Reused between batches so that batching does not allocate per packet.
+  std::vector<onnxinfer::PacketFeature> features_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_BANDWIDTH_ESTIMATOR_H_
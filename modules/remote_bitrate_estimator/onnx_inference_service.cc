@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/onnx_inference_service.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+
+using ServiceKey = std::tuple<std::string, OnnxModelOptions, int64_t>;
+
+// Services are only weakly referenced, like the models, so that a service
+// stops once the last call using it ends.
+struct Registry {
+  rtc::CriticalSection lock;
+  std::map<ServiceKey, std::weak_ptr<OnnxInferenceService>> services
+      RTC_GUARDED_BY(lock);
+};
+
+Registry* GetRegistry() {
+  // Leaked on purpose, calls may still release services during shutdown.
+  static Registry* const registry = new Registry();
+  return registry;
+}
+
+}  // namespace
+
+// The part of a session that the ticks use, so that a tick keeps it alive if
+// the session is destroyed meanwhile.
+struct OnnxInferenceService::Session::State {
+  State(std::shared_ptr<const OnnxModel> model, void* onnx_infer)
+      : model(std::move(model)), onnx_infer(onnx_infer) {}
+  ~State() { model->DestroyInferInterface(onnx_infer); }
+
+  const std::shared_ptr<const OnnxModel> model;
+  // Only used by the ticks, which run on the task queue of the service.
+  void* const onnx_infer;
+  rtc::CriticalSection lock;
+  std::vector<onnxinfer::PacketFeature> pending_features RTC_GUARDED_BY(lock);
+  float estimate_bps RTC_GUARDED_BY(lock) = 0;
+  bool ready RTC_GUARDED_BY(lock) = false;
+};
+
+OnnxInferenceService::Session::Session(
+    std::shared_ptr<OnnxInferenceService> service,
+    std::shared_ptr<State> state)
+    : service_(std::move(service)), state_(std::move(state)) {
+  service_->AddSession(state_);
+}
+
+OnnxInferenceService::Session::~Session() {
+  service_->RemoveSession(state_.get());
+}
+
+void OnnxInferenceService::Session::OnPacketBatch(
+    rtc::ArrayView<const onnxinfer::PacketFeature> features) {
+  rtc::CritScope cs(&state_->lock);
+  state_->pending_features.insert(state_->pending_features.end(),
+                                  features.begin(), features.end());
+}
+
+float OnnxInferenceService::Session::GetEstimate() const {
+  rtc::CritScope cs(&state_->lock);
+  return state_->estimate_bps;
+}
+
+bool OnnxInferenceService::Session::IsReady() const {
+  rtc::CritScope cs(&state_->lock);
+  return state_->ready;
+}
+
+std::unique_ptr<OnnxInferenceService::Session>
+OnnxInferenceService::CreateSession(const std::string& model_path,
+                                    const OnnxModelOptions& model_options,
+                                    int64_t interval_ms) {
+  interval_ms = std::max<int64_t>(interval_ms, 1);
+  const ServiceKey key(model_path, model_options, interval_ms);
+  Registry* registry = GetRegistry();
+  std::shared_ptr<OnnxInferenceService> service;
+  {
+    rtc::CritScope cs(&registry->lock);
+    auto it = registry->services.find(key);
+    if (it != registry->services.end())
+      service = it->second.lock();
+  }
+  if (!service) {
+    // Loading without the lock, the registry of the models deduplicates
+    // concurrent loads.
+    std::shared_ptr<const OnnxModel> model =
+        OnnxModel::Get(model_path, model_options);
+    if (!model)
+      return nullptr;
+    rtc::CritScope cs(&registry->lock);
+    std::weak_ptr<OnnxInferenceService>& entry = registry->services[key];
+    service = entry.lock();
+    if (!service) {
+      service.reset(new OnnxInferenceService(std::move(model), interval_ms));
+      entry = service;
+    }
+  }
+  void* onnx_infer = service->model_->CreateInferInterface();
+  if (!onnx_infer) {
+    RTC_LOG(LS_ERROR) << "Failed to create an inference interface for "
+                      << model_path;
+    return nullptr;
+  }
+  auto state = std::make_shared<Session::State>(service->model_, onnx_infer);
+  return std::unique_ptr<Session>(
+      new Session(std::move(service), std::move(state)));
+}
+
+OnnxInferenceService::OnnxInferenceService(
+    std::shared_ptr<const OnnxModel> model,
+    int64_t interval_ms)
+    : model_(std::move(model)),
+      task_queue_factory_(CreateDefaultTaskQueueFactory()),
+      task_queue_(task_queue_factory_->CreateTaskQueue(
+          "OnnxInference",
+          TaskQueueFactory::Priority::NORMAL)) {
+  const TimeDelta interval = TimeDelta::Millis(interval_ms);
+  task_queue_.PostTask([this, interval] {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    tick_task_ = RepeatingTaskHandle::DelayedStart(
+        task_queue_.Get(), interval, [this, interval] {
+          RTC_DCHECK_RUN_ON(&task_queue_);
+          RunBatch();
+          return interval;
+        });
+  });
+}
+
+OnnxInferenceService::~OnnxInferenceService() {
+  rtc::Event done;
+  task_queue_.PostTask([this, &done] {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    tick_task_.Stop();
+    done.Set();
+  });
+  done.Wait(rtc::Event::kForever);
+}
+
+void OnnxInferenceService::AddSession(std::shared_ptr<Session::State> session) {
+  rtc::CritScope cs(&sessions_lock_);
+  sessions_.push_back(std::move(session));
+}
+
+void OnnxInferenceService::RemoveSession(Session::State* session) {
+  rtc::CritScope cs(&sessions_lock_);
+  auto it = std::find_if(sessions_.begin(), sessions_.end(),
+                         [session](const std::shared_ptr<Session::State>& s) {
+                           return s.get() == session;
+                         });
+  RTC_DCHECK(it != sessions_.end());
+  sessions_.erase(it);
+}
+
+void OnnxInferenceService::RunBatch() {
+  {
+    rtc::CritScope cs(&sessions_lock_);
+    batch_ = sessions_;
+  }
+  TRACE_EVENT1("webrtc", "OnnxInferenceService::RunBatch", "sessions",
+               batch_.size());
+  ready_sessions_.clear();
+  ready_interfaces_.clear();
+  for (const std::shared_ptr<Session::State>& session : batch_) {
+    {
+      // Swapping leaves the session an empty buffer that keeps its capacity.
+      rtc::CritScope session_cs(&session->lock);
+      features_.swap(session->pending_features);
+    }
+    if (!features_.empty()) {
+      model_->OnReceivedBatch(session->onnx_infer, features_.data(),
+                              features_.size());
+      features_.clear();
+    }
+    if (model_->IsReady(session->onnx_infer)) {
+      ready_sessions_.push_back(session.get());
+      ready_interfaces_.push_back(session->onnx_infer);
+    }
+  }
+
+  if (!ready_sessions_.empty()) {
+    estimates_bps_.resize(ready_sessions_.size());
+    model_->GetEstimates(ready_interfaces_.data(), ready_interfaces_.size(),
+                         estimates_bps_.data());
+    for (size_t i = 0; i < ready_sessions_.size(); ++i) {
+      Session::State* session = ready_sessions_[i];
+      rtc::CritScope session_cs(&session->lock);
+      session->estimate_bps = estimates_bps_[i];
+      session->ready = true;
+    }
+  }
+  // Releases the sessions destroyed during the tick.
+  ready_sessions_.clear();
+  batch_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_INFERENCE_SERVICE_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_INFERENCE_SERVICE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "modules/remote_bitrate_estimator/onnx_model_registry.h"
+#include "modules/third_party/onnxinfer/ONNXInferInterface.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs the ONNX model for all the calls of the process using the same model
+// file at once. Every |interval_ms| the packets each call received since the
+// previous tick are fed to its inference interface, then the model runs a
+// single time for all the calls, the calls being the batch dimension, and each
+// call gets its estimate back. With many calls on a server this amortizes the
+// ONNXRuntime dispatch, which dominates the run of a model this small.
+class OnnxInferenceService {
+ public:
+  // The inference interface of one call. May be used from any thread.
+  class Session {
+   public:
+    // Does not wait for a tick using the session to end, the tick keeps the
+    // inference interface alive until then. Only the last session of a
+    // service waits for it, stopping the service.
+    ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    // Queues |features| for the next tick.
+    void OnPacketBatch(
+        rtc::ArrayView<const onnxinfer::PacketFeature> features);
+    // Returns the estimate of the latest tick in bps. Only meaningful if
+    // IsReady().
+    float GetEstimate() const;
+    bool IsReady() const;
+
+   private:
+    friend class OnnxInferenceService;
+    struct State;
+    Session(std::shared_ptr<OnnxInferenceService> service,
+            std::shared_ptr<State> state);
+
+    const std::shared_ptr<OnnxInferenceService> service_;
+    const std::shared_ptr<State> state_;
+  };
+
+  // Returns a new session running the model at |model_path|, on the service
+  // shared by every session of that model with the same |model_options| and
+  // |interval_ms|, or null if the model can't be loaded. The service is
+  // created with the first such session and lives as long as any of its
+  // sessions. May be slow when it loads the model, see OnnxModel::Get().
+  // Thread safe.
+  static std::unique_ptr<Session> CreateSession(
+      const std::string& model_path,
+      const OnnxModelOptions& model_options,
+      int64_t interval_ms);
+
+  ~OnnxInferenceService();
+
+  OnnxInferenceService(const OnnxInferenceService&) = delete;
+  OnnxInferenceService& operator=(const OnnxInferenceService&) = delete;
+
+ private:
+  OnnxInferenceService(std::shared_ptr<const OnnxModel> model,
+                       int64_t interval_ms);
+
+  void AddSession(std::shared_ptr<Session::State> session);
+  void RemoveSession(Session::State* session);
+  void RunBatch() RTC_RUN_ON(task_queue_);
+
+  const std::shared_ptr<const OnnxModel> model_;
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+
+  // Only held to copy the sessions at the start of a tick, the inference runs
+  // without it.
+  rtc::CriticalSection sessions_lock_;
+  std::vector<std::shared_ptr<Session::State>> sessions_
+      RTC_GUARDED_BY(sessions_lock_);
+
+  // Reused between ticks so that they do not allocate. |batch_| holds the
+  // sessions of the running tick, possibly destroyed since it started.
+  std::vector<std::shared_ptr<Session::State>> batch_
+      RTC_GUARDED_BY(task_queue_);
+  std::vector<onnxinfer::PacketFeature> features_ RTC_GUARDED_BY(task_queue_);
+  std::vector<Session::State*> ready_sessions_ RTC_GUARDED_BY(task_queue_);
+  std::vector<void*> ready_interfaces_ RTC_GUARDED_BY(task_queue_);
+  std::vector<float> estimates_bps_ RTC_GUARDED_BY(task_queue_);
+  RepeatingTaskHandle tick_task_ RTC_GUARDED_BY(task_queue_);
+
+  // Declared last so that it is destroyed first, before the members that
+  // pending tasks might still access.
+  rtc::TaskQueue task_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_INFERENCE_SERVICE_H_
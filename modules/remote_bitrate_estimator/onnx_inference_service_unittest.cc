@@ -0,0 +1,291 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/onnx_inference_service.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kModelPath[] = "service.onnx";
+constexpr int64_t kIntervalMs = 1;
+constexpr int kTimeoutMs = 5000;
+
+// The inference interface of a session, ready once it received a packet.
+struct FakeInferInterface {
+  size_t packets = 0;
+};
+
+// Estimates the number of packets a session received, in kbps.
+class FakeOnnxInferBackend : public OnnxInferBackend {
+ public:
+  void* CreateModel(const std::string& model_path,
+                    const OnnxModelOptions& options) override {
+    rtc::CritScope cs(&lock_);
+    ++loads_;
+    return new int(0);
+  }
+  void DestroyModel(void* onnx_infer_model) override {
+    delete static_cast<int*>(onnx_infer_model);
+    rtc::CritScope cs(&lock_);
+    ++unloads_;
+  }
+  void* CreateInferInterface(void* onnx_infer_model) override {
+    rtc::CritScope cs(&lock_);
+    ++created_interfaces_;
+    return new FakeInferInterface();
+  }
+  void DestroyInferInterface(void* infer_interface) override {
+    delete static_cast<FakeInferInterface*>(infer_interface);
+    rtc::CritScope cs(&lock_);
+    ++destroyed_interfaces_;
+  }
+  void OnReceivedBatch(void* infer_interface,
+                       const onnxinfer::PacketFeature* features,
+                       size_t count) override {
+    static_cast<FakeInferInterface*>(infer_interface)->packets += count;
+  }
+  bool IsReady(void* infer_interface) override {
+    return static_cast<FakeInferInterface*>(infer_interface)->packets > 0;
+  }
+  void GetEstimates(void* onnx_infer_model,
+                    void* const* infer_interfaces,
+                    size_t count,
+                    float* estimates_bps) override {
+    for (size_t i = 0; i < count; ++i) {
+      estimates_bps[i] =
+          1000 * static_cast<FakeInferInterface*>(infer_interfaces[i])->packets;
+    }
+    bool block;
+    {
+      rtc::CritScope cs(&lock_);
+      batch_sizes_.push_back(count);
+      max_batch_size_ = std::max(max_batch_size_, count);
+      block = block_batches_;
+    }
+    batch_event_.Set();
+    if (block) {
+      batch_blocked_.Set();
+      release_batch_.Wait(rtc::Event::kForever);
+    }
+  }
+
+  // Waits for a batch of |size| sessions to start.
+  bool WaitForBatch(size_t size) {
+    while (true) {
+      {
+        rtc::CritScope cs(&lock_);
+        if (std::find(batch_sizes_.begin(), batch_sizes_.end(), size) !=
+            batch_sizes_.end()) {
+          batch_sizes_.clear();
+          return true;
+        }
+        batch_sizes_.clear();
+      }
+      if (!batch_event_.Wait(kTimeoutMs))
+        return false;
+    }
+  }
+  // Waits for the running batch, if any, to end.
+  bool WaitForRunningBatch() {
+    {
+      rtc::CritScope cs(&lock_);
+      batch_sizes_.clear();
+    }
+    // The batch that starts next only does once the previous one ended.
+    return batch_event_.Wait(kTimeoutMs) && batch_event_.Wait(kTimeoutMs);
+  }
+  size_t max_batch_size() const {
+    rtc::CritScope cs(&lock_);
+    return max_batch_size_;
+  }
+
+  void BlockBatches() {
+    rtc::CritScope cs(&lock_);
+    block_batches_ = true;
+  }
+  bool WaitForBlockedBatch() { return batch_blocked_.Wait(kTimeoutMs); }
+  void ReleaseBatches() {
+    {
+      rtc::CritScope cs(&lock_);
+      block_batches_ = false;
+    }
+    release_batch_.Set();
+  }
+
+  int loads() const {
+    rtc::CritScope cs(&lock_);
+    return loads_;
+  }
+  int unloads() const {
+    rtc::CritScope cs(&lock_);
+    return unloads_;
+  }
+  int created_interfaces() const {
+    rtc::CritScope cs(&lock_);
+    return created_interfaces_;
+  }
+  int destroyed_interfaces() const {
+    rtc::CritScope cs(&lock_);
+    return destroyed_interfaces_;
+  }
+
+ private:
+  rtc::CriticalSection lock_;
+  int loads_ RTC_GUARDED_BY(lock_) = 0;
+  int unloads_ RTC_GUARDED_BY(lock_) = 0;
+  int created_interfaces_ RTC_GUARDED_BY(lock_) = 0;
+  int destroyed_interfaces_ RTC_GUARDED_BY(lock_) = 0;
+  std::vector<size_t> batch_sizes_ RTC_GUARDED_BY(lock_);
+  size_t max_batch_size_ RTC_GUARDED_BY(lock_) = 0;
+  bool block_batches_ RTC_GUARDED_BY(lock_) = false;
+  rtc::Event batch_event_;
+  rtc::Event batch_blocked_;
+  rtc::Event release_batch_;
+};
+
+std::vector<onnxinfer::PacketFeature> Packets(size_t count) {
+  return std::vector<onnxinfer::PacketFeature>(count);
+}
+
+class OnnxInferenceServiceTest : public ::testing::Test {
+ protected:
+  OnnxInferenceServiceTest() : scoped_backend_(&backend_) {}
+
+  std::unique_ptr<OnnxInferenceService::Session> CreateSession(
+      const OnnxModelOptions& options = OnnxModelOptions(),
+      int64_t interval_ms = kIntervalMs) {
+    return OnnxInferenceService::CreateSession(kModelPath, options,
+                                               interval_ms);
+  }
+
+  FakeOnnxInferBackend backend_;
+  ScopedOnnxInferBackendForTesting scoped_backend_;
+};
+
+TEST_F(OnnxInferenceServiceTest, RunsTheSessionsOfAModelInOneBatch) {
+  std::unique_ptr<OnnxInferenceService::Session> first = CreateSession();
+  std::unique_ptr<OnnxInferenceService::Session> second = CreateSession();
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_FALSE(first->IsReady());
+  first->OnPacketBatch(Packets(1));
+  second->OnPacketBatch(Packets(2));
+
+  ASSERT_TRUE(backend_.WaitForBatch(2));
+  ASSERT_TRUE(backend_.WaitForRunningBatch());
+  EXPECT_TRUE(first->IsReady());
+  EXPECT_TRUE(second->IsReady());
+  EXPECT_EQ(first->GetEstimate(), 1000);
+  EXPECT_EQ(second->GetEstimate(), 2000);
+  EXPECT_EQ(backend_.loads(), 1);
+}
+
+TEST_F(OnnxInferenceServiceTest, SeparatesTheSessionsOfOtherSettings) {
+  OnnxModelOptions two_threads;
+  two_threads.intra_op_threads = 2;
+  std::vector<std::unique_ptr<OnnxInferenceService::Session>> sessions;
+  sessions.push_back(CreateSession());
+  sessions.push_back(CreateSession(two_threads));
+  sessions.push_back(CreateSession(OnnxModelOptions(), kIntervalMs + 1));
+  for (auto& session : sessions) {
+    ASSERT_TRUE(session);
+    session->OnPacketBatch(Packets(1));
+  }
+  // The options load their own model, the interval runs its own service.
+  EXPECT_EQ(backend_.loads(), 2);
+
+  for (int i = 0; i < 10; ++i)
+    ASSERT_TRUE(backend_.WaitForBatch(1));
+  EXPECT_EQ(backend_.max_batch_size(), 1u);
+}
+
+struct DestroySessionArgs {
+  std::unique_ptr<OnnxInferenceService::Session> session;
+  rtc::Event destroyed;
+};
+
+void DestroySession(void* obj) {
+  DestroySessionArgs* args = static_cast<DestroySessionArgs*>(obj);
+  args->session.reset();
+  args->destroyed.Set();
+}
+
+TEST_F(OnnxInferenceServiceTest, DestroysASessionWithoutWaitingForTheBatch) {
+  // Keeps the service running.
+  std::unique_ptr<OnnxInferenceService::Session> kept = CreateSession();
+  DestroySessionArgs args;
+  args.session = CreateSession();
+  kept->OnPacketBatch(Packets(1));
+  args.session->OnPacketBatch(Packets(1));
+  ASSERT_TRUE(backend_.WaitForBatch(2));
+  // The next batch holds both sessions.
+  backend_.BlockBatches();
+  ASSERT_TRUE(backend_.WaitForBlockedBatch());
+
+  rtc::PlatformThread thread(&DestroySession, &args, "DestroySession");
+  thread.Start();
+  EXPECT_TRUE(args.destroyed.Wait(kTimeoutMs));
+  // The blocked batch still uses the interface of the session.
+  EXPECT_EQ(backend_.destroyed_interfaces(), 0);
+  backend_.ReleaseBatches();
+  thread.Stop();
+
+  ASSERT_TRUE(backend_.WaitForRunningBatch());
+  EXPECT_EQ(backend_.destroyed_interfaces(), 1);
+  EXPECT_TRUE(kept->IsReady());
+}
+
+TEST_F(OnnxInferenceServiceTest, StopsWithItsLastSession) {
+  std::unique_ptr<OnnxInferenceService::Session> session = CreateSession();
+  session->OnPacketBatch(Packets(1));
+  ASSERT_TRUE(backend_.WaitForBatch(1));
+  session.reset();
+  EXPECT_EQ(backend_.destroyed_interfaces(), 1);
+  EXPECT_EQ(backend_.unloads(), 1);
+}
+
+void CreateAndDestroySessions(void* obj) {
+  for (int i = 0; i < 100; ++i) {
+    std::unique_ptr<OnnxInferenceService::Session> session =
+        OnnxInferenceService::CreateSession(kModelPath, OnnxModelOptions(),
+                                            kIntervalMs);
+    if (session)
+      session->OnPacketBatch(Packets(1));
+  }
+}
+
+TEST_F(OnnxInferenceServiceTest, CreatesAndDestroysSessionsConcurrently) {
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &CreateAndDestroySessions, nullptr, "CreateAndDestroySessions"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+
+  EXPECT_EQ(backend_.created_interfaces(), 400);
+  EXPECT_EQ(backend_.destroyed_interfaces(), 400);
+  EXPECT_EQ(backend_.unloads(), backend_.loads());
+}
+
+}  // namespace
+}  // namespace webrtc
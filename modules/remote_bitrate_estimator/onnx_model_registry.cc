@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/onnx_model_registry.h"
+
+#include <atomic>
+#include <map>
+#include <tuple>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace {
+
+class OnnxInferLibrary : public OnnxInferBackend {
+ public:
+  void* CreateModel(const std::string& model_path,
+                    const OnnxModelOptions& options) override {
+    onnxinfer::ModelOptions model_options;
+    model_options.intraOpNumThreads = options.intra_op_threads;
+    model_options.interOpNumThreads = options.inter_op_threads;
+    model_options.useGlobalThreadPools = options.use_global_thread_pools;
+    model_options.executionProvider = options.execution_provider;
+    model_options.graphOptimizationLevel = options.graph_optimization_level;
+    model_options.optimizedModelPath = options.optimized_model_path.c_str();
+    return onnxinfer::CreateONNXInferModelWithOptions(model_path.c_str(),
+                                                      &model_options);
+  }
+  void DestroyModel(void* onnx_infer_model) override {
+    onnxinfer::DestroyONNXInferModel(onnx_infer_model);
+  }
+  void* CreateInferInterface(void* onnx_infer_model) override {
+    return onnxinfer::CreateONNXInferInterfaceFromModel(onnx_infer_model);
+  }
+  void DestroyInferInterface(void* infer_interface) override {
+    onnxinfer::DestroyONNXInferInterface(infer_interface);
+  }
+  void OnReceivedBatch(void* infer_interface,
+                       const onnxinfer::PacketFeature* features,
+                       size_t count) override {
+    onnxinfer::OnReceivedBatch(infer_interface, features, count);
+  }
+  bool IsReady(void* infer_interface) override {
+    return onnxinfer::IsReady(infer_interface);
+  }
+  void GetEstimates(void* onnx_infer_model,
+                    void* const* infer_interfaces,
+                    size_t count,
+                    float* estimates_bps) override {
+    onnxinfer::GetBweEstimateBatch(onnx_infer_model, infer_interfaces, count,
+                                   estimates_bps);
+  }
+};
+
+std::atomic<OnnxInferBackend*> g_backend_for_testing{nullptr};
+
+OnnxInferBackend* GetBackend() {
+  OnnxInferBackend* backend = g_backend_for_testing.load();
+  if (backend)
+    return backend;
+  static OnnxInferLibrary* const library = new OnnxInferLibrary();
+  return library;
+}
+
+using ModelKey = std::pair<std::string, OnnxModelOptions>;
+
+struct ModelEntry {
+  std::weak_ptr<const OnnxModel> model;
+  // Set while a call loads the model, the other calls asking for it wait for
+  // it to be signaled instead of loading it again.
+  std::shared_ptr<rtc::Event> loaded;
+};
+
+// Models are only weakly referenced so that a model is unloaded once the last
+// call using it ends.
+struct Registry {
+  rtc::CriticalSection lock;
+  std::map<ModelKey, ModelEntry> models RTC_GUARDED_BY(lock);
+};
+
+Registry* GetRegistry() {
+  // Leaked on purpose, calls may still release models during shutdown.
+  static Registry* const registry = new Registry();
+  return registry;
+}
+
+}  // namespace
+
+bool operator<(const OnnxModelOptions& a, const OnnxModelOptions& b) {
+  return std::tie(a.intra_op_threads, a.inter_op_threads,
+                  a.use_global_thread_pools, a.execution_provider,
+                  a.graph_optimization_level, a.optimized_model_path) <
+         std::tie(b.intra_op_threads, b.inter_op_threads,
+                  b.use_global_thread_pools, b.execution_provider,
+                  b.graph_optimization_level, b.optimized_model_path);
+}
+
+std::shared_ptr<const OnnxModel> OnnxModel::Get(
+    const std::string& model_path,
+    const OnnxModelOptions& options) {
+  Registry* registry = GetRegistry();
+  const ModelKey key(model_path, options);
+  std::shared_ptr<rtc::Event> loaded;
+  while (true) {
+    std::shared_ptr<rtc::Event> other_load;
+    {
+      rtc::CritScope cs(&registry->lock);
+      ModelEntry& entry = registry->models[key];
+      std::shared_ptr<const OnnxModel> model = entry.model.lock();
+      if (model)
+        return model;
+      if (!entry.loaded) {
+        loaded = std::make_shared<rtc::Event>(/*manual_reset=*/true,
+                                              /*initially_signaled=*/false);
+        entry.loaded = loaded;
+        break;
+      }
+      other_load = entry.loaded;
+    }
+    // Look again once the other load ended, it may have failed or its model
+    // may already be released.
+    other_load->Wait(rtc::Event::kForever);
+  }
+
+  // Loading without the lock, which would block the calls of other models.
+  OnnxInferBackend* backend = GetBackend();
+  void* onnx_infer_model = backend->CreateModel(model_path, options);
+  std::shared_ptr<const OnnxModel> model;
+  if (onnx_infer_model)
+    model.reset(new OnnxModel(backend, onnx_infer_model));
+  {
+    rtc::CritScope cs(&registry->lock);
+    if (model) {
+      ModelEntry& entry = registry->models[key];
+      entry.model = model;
+      entry.loaded = nullptr;
+    } else {
+      registry->models.erase(key);
+    }
+  }
+  loaded->Set();
+  if (!model)
+    RTC_LOG(LS_ERROR) << "Failed to load ONNX model " << model_path;
+  return model;
+}
+
+OnnxModel::OnnxModel(OnnxInferBackend* backend, void* onnx_infer_model)
+    : backend_(backend), onnx_infer_model_(onnx_infer_model) {}
+
+OnnxModel::~OnnxModel() {
+  backend_->DestroyModel(onnx_infer_model_);
+}
+
+void* OnnxModel::CreateInferInterface() const {
+  return backend_->CreateInferInterface(onnx_infer_model_);
+}
+
+void OnnxModel::DestroyInferInterface(void* infer_interface) const {
+  backend_->DestroyInferInterface(infer_interface);
+}
+
+void OnnxModel::OnReceivedBatch(void* infer_interface,
+                                const onnxinfer::PacketFeature* features,
+                                size_t count) const {
+  backend_->OnReceivedBatch(infer_interface, features, count);
+}
+
+bool OnnxModel::IsReady(void* infer_interface) const {
+  return backend_->IsReady(infer_interface);
+}
+
+void OnnxModel::GetEstimates(void* const* infer_interfaces,
+                             size_t count,
+                             float* estimates_bps) const {
+  backend_->GetEstimates(onnx_infer_model_, infer_interfaces, count,
+                         estimates_bps);
+}
+
+ScopedOnnxInferBackendForTesting::ScopedOnnxInferBackendForTesting(
+    OnnxInferBackend* backend) {
+  RTC_CHECK(!g_backend_for_testing.exchange(backend));
+}
+
+ScopedOnnxInferBackendForTesting::~ScopedOnnxInferBackendForTesting() {
+  g_backend_for_testing.store(nullptr);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_MODEL_REGISTRY_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_MODEL_REGISTRY_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "modules/third_party/onnxinfer/ONNXInferInterface.h"
+
+namespace webrtc {
+
+// ONNXRuntime session settings of a model, see onnxinfer::ModelOptions.
+struct OnnxModelOptions {
+  int intra_op_threads = 0;
+  int inter_op_threads = 0;
+  bool use_global_thread_pools = false;
+  onnxinfer::ExecutionProvider execution_provider =
+      onnxinfer::kExecutionProviderCpu;
+  onnxinfer::GraphOptimizationLevel graph_optimization_level =
+      onnxinfer::kGraphOptimizationAll;
+  std::string optimized_model_path;
+};
+
+// Orders the options so that they can key the loaded models.
+bool operator<(const OnnxModelOptions& a, const OnnxModelOptions& b);
+
+// The onnxinfer library entry points behind OnnxModel, see
+// ScopedOnnxInferBackendForTesting.
+class OnnxInferBackend {
+ public:
+  virtual ~OnnxInferBackend() = default;
+
+  // Returns null if the model can't be loaded.
+  virtual void* CreateModel(const std::string& model_path,
+                            const OnnxModelOptions& options) = 0;
+  virtual void DestroyModel(void* onnx_infer_model) = 0;
+  virtual void* CreateInferInterface(void* onnx_infer_model) = 0;
+  virtual void DestroyInferInterface(void* infer_interface) = 0;
+  virtual void OnReceivedBatch(void* infer_interface,
+                               const onnxinfer::PacketFeature* features,
+                               size_t count) = 0;
+  virtual bool IsReady(void* infer_interface) = 0;
+  virtual void GetEstimates(void* onnx_infer_model,
+                            void* const* infer_interfaces,
+                            size_t count,
+                            float* estimates_bps) = 0;
+};
+
+// Makes the models loaded during its lifetime use |backend| instead of the
+// onnxinfer library, so that tests run without ONNXRuntime. Not thread safe,
+// must not overlap with other instances.
+class ScopedOnnxInferBackendForTesting {
+ public:
+  explicit ScopedOnnxInferBackendForTesting(OnnxInferBackend* backend);
+  ~ScopedOnnxInferBackendForTesting();
+
+  ScopedOnnxInferBackendForTesting(const ScopedOnnxInferBackendForTesting&) =
+      delete;
+  ScopedOnnxInferBackendForTesting& operator=(
+      const ScopedOnnxInferBackendForTesting&) = delete;
+};
+
+// An immutable ONNX model loaded once per process and shared by every call
+// using the same model file. Each call creates its own inference interface
+// from it, holding only that call's recurrent state.
+class OnnxModel {
+ public:
+  // Returns the model loaded from |model_path| with |options|, loading it if
+  // no other call holds it at the moment. Calls asking for the same file
+  // with different options get different models. Returns null if the model
+  // can't be loaded. Thread safe, a slow load only blocks the calls waiting
+  // for the same model.
+  static std::shared_ptr<const OnnxModel> Get(const std::string& model_path,
+                                              const OnnxModelOptions& options);
+
+  ~OnnxModel();
+
+  OnnxModel(const OnnxModel&) = delete;
+  OnnxModel& operator=(const OnnxModel&) = delete;
+
+  // Returns a new onnxinfer interface backed by this model, to be destroyed
+  // with DestroyInferInterface() before the model is released.
+  void* CreateInferInterface() const;
+  void DestroyInferInterface(void* infer_interface) const;
+
+  // See onnxinfer::OnReceivedBatch() and onnxinfer::IsReady().
+  void OnReceivedBatch(void* infer_interface,
+                       const onnxinfer::PacketFeature* features,
+                       size_t count) const;
+  bool IsReady(void* infer_interface) const;
+
+  // Runs the model once for all the |count| |infer_interfaces|, created by
+  // this model, and writes their estimates to |estimates_bps|. Must not run
+  // concurrently with other calls on the same interfaces.
+  void GetEstimates(void* const* infer_interfaces,
+                    size_t count,
+                    float* estimates_bps) const;
+
+ private:
+  OnnxModel(OnnxInferBackend* backend, void* onnx_infer_model);
+
+  OnnxInferBackend* const backend_;
+  void* const onnx_infer_model_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_ONNX_MODEL_REGISTRY_H_
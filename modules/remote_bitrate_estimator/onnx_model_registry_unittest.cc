@@ -0,0 +1,296 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/onnx_model_registry.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kMissingModelPath[] = "missing.onnx";
+// Loading it blocks until |slow_load_done| is signaled.
+constexpr char kSlowModelPath[] = "slow.onnx";
+
+// Loads a fake model per call of CreateModel().
+class FakeOnnxInferBackend : public OnnxInferBackend {
+ public:
+  void* CreateModel(const std::string& model_path,
+                    const OnnxModelOptions& options) override {
+    if (model_path == kSlowModelPath) {
+      slow_load_started.Set();
+      slow_load_done.Wait(rtc::Event::kForever);
+    }
+    rtc::CritScope cs(&lock_);
+    ++loads_;
+    if (model_path == kMissingModelPath)
+      return nullptr;
+    return new std::string(model_path);
+  }
+  void DestroyModel(void* onnx_infer_model) override {
+    delete static_cast<std::string*>(onnx_infer_model);
+    rtc::CritScope cs(&lock_);
+    ++unloads_;
+  }
+  void* CreateInferInterface(void* onnx_infer_model) override {
+    return onnx_infer_model;
+  }
+  void DestroyInferInterface(void* infer_interface) override {}
+  void OnReceivedBatch(void* infer_interface,
+                       const onnxinfer::PacketFeature* features,
+                       size_t count) override {}
+  bool IsReady(void* infer_interface) override { return false; }
+  void GetEstimates(void* onnx_infer_model,
+                    void* const* infer_interfaces,
+                    size_t count,
+                    float* estimates_bps) override {}
+
+  int loads() const {
+    rtc::CritScope cs(&lock_);
+    return loads_;
+  }
+  int unloads() const {
+    rtc::CritScope cs(&lock_);
+    return unloads_;
+  }
+
+  rtc::Event slow_load_started;
+  rtc::Event slow_load_done;
+
+ private:
+  rtc::CriticalSection lock_;
+  int loads_ RTC_GUARDED_BY(lock_) = 0;
+  int unloads_ RTC_GUARDED_BY(lock_) = 0;
+};
+
+class OnnxModelTest : public ::testing::Test {
+ protected:
+  OnnxModelTest() : scoped_backend_(&backend_) {}
+
+  FakeOnnxInferBackend backend_;
+  ScopedOnnxInferBackendForTesting scoped_backend_;
+};
+
+TEST_F(OnnxModelTest, SharesTheModelOfAPath) {
+  std::shared_ptr<const OnnxModel> first =
+      OnnxModel::Get("shared.onnx", OnnxModelOptions());
+  std::shared_ptr<const OnnxModel> second =
+      OnnxModel::Get("shared.onnx", OnnxModelOptions());
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(backend_.loads(), 1);
+}
+
+TEST_F(OnnxModelTest, LoadsOneModelPerPath) {
+  std::shared_ptr<const OnnxModel> first =
+      OnnxModel::Get("first.onnx", OnnxModelOptions());
+  std::shared_ptr<const OnnxModel> second =
+      OnnxModel::Get("second.onnx", OnnxModelOptions());
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(backend_.loads(), 2);
+}
+
+TEST_F(OnnxModelTest, LoadsOneModelPerOptions) {
+  OnnxModelOptions single_thread;
+  single_thread.intra_op_threads = 1;
+  OnnxModelOptions two_threads;
+  two_threads.intra_op_threads = 2;
+  std::shared_ptr<const OnnxModel> first =
+      OnnxModel::Get("options.onnx", single_thread);
+  std::shared_ptr<const OnnxModel> second =
+      OnnxModel::Get("options.onnx", two_threads);
+  std::shared_ptr<const OnnxModel> third =
+      OnnxModel::Get("options.onnx", single_thread);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(first, third);
+  EXPECT_EQ(backend_.loads(), 2);
+}
+
+TEST_F(OnnxModelTest, UnloadsTheModelWithItsLastUser) {
+  std::shared_ptr<const OnnxModel> first =
+      OnnxModel::Get("released.onnx", OnnxModelOptions());
+  std::shared_ptr<const OnnxModel> second =
+      OnnxModel::Get("released.onnx", OnnxModelOptions());
+  first.reset();
+  EXPECT_EQ(backend_.unloads(), 0);
+  second.reset();
+  EXPECT_EQ(backend_.unloads(), 1);
+
+  // The next user loads it again.
+  EXPECT_TRUE(OnnxModel::Get("released.onnx", OnnxModelOptions()));
+  EXPECT_EQ(backend_.loads(), 2);
+  EXPECT_EQ(backend_.unloads(), 2);
+}
+
+TEST_F(OnnxModelTest, RetriesAModelThatFailedToLoad) {
+  EXPECT_FALSE(OnnxModel::Get(kMissingModelPath, OnnxModelOptions()));
+  EXPECT_FALSE(OnnxModel::Get(kMissingModelPath, OnnxModelOptions()));
+  EXPECT_EQ(backend_.loads(), 2);
+}
+
+struct GetSlowModelArgs {
+  std::shared_ptr<const OnnxModel> model;
+};
+
+void GetSlowModel(void* obj) {
+  static_cast<GetSlowModelArgs*>(obj)->model =
+      OnnxModel::Get(kSlowModelPath, OnnxModelOptions());
+}
+
+TEST_F(OnnxModelTest, LoadsOtherModelsDuringASlowLoad) {
+  GetSlowModelArgs args;
+  rtc::PlatformThread thread(&GetSlowModel, &args, "GetSlowModel");
+  thread.Start();
+  ASSERT_TRUE(backend_.slow_load_started.Wait(rtc::Event::kForever));
+
+  EXPECT_TRUE(OnnxModel::Get("fast.onnx", OnnxModelOptions()));
+  backend_.slow_load_done.Set();
+  thread.Stop();
+  EXPECT_TRUE(args.model);
+}
+
+TEST_F(OnnxModelTest, SharesAModelThatIsStillLoading) {
+  GetSlowModelArgs first;
+  GetSlowModelArgs second;
+  rtc::PlatformThread first_thread(&GetSlowModel, &first, "GetSlowModel");
+  rtc::PlatformThread second_thread(&GetSlowModel, &second, "GetSlowModel");
+  first_thread.Start();
+  ASSERT_TRUE(backend_.slow_load_started.Wait(rtc::Event::kForever));
+  // The second call waits for the first load rather than loading the model
+  // again.
+  second_thread.Start();
+  backend_.slow_load_done.Set();
+  first_thread.Stop();
+  second_thread.Stop();
+
+  ASSERT_TRUE(first.model);
+  EXPECT_EQ(first.model, second.model);
+  EXPECT_EQ(backend_.loads(), 1);
+}
+
+struct GetAndReleaseArgs {
+  std::vector<std::string> model_paths;
+  int iterations = 0;
+  // If not empty, the models the main thread holds, which Get() must return.
+  std::map<std::string, const OnnxModel*> held_models;
+  int failures = 0;
+};
+
+void GetAndRelease(void* obj) {
+  GetAndReleaseArgs* args = static_cast<GetAndReleaseArgs*>(obj);
+  for (int i = 0; i < args->iterations; ++i) {
+    const std::string& model_path =
+        args->model_paths[i % args->model_paths.size()];
+    std::shared_ptr<const OnnxModel> model =
+        OnnxModel::Get(model_path, OnnxModelOptions());
+    if (!model || (!args->held_models.empty() &&
+                   model.get() != args->held_models[model_path])) {
+      ++args->failures;
+    }
+  }
+}
+
+void RunConcurrently(std::vector<GetAndReleaseArgs>* args) {
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (GetAndReleaseArgs& thread_args : *args) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &GetAndRelease, &thread_args, "GetAndRelease"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+}
+
+// Each path is used by two of the threads.
+std::vector<GetAndReleaseArgs> CreateArgs(bool same_path) {
+  std::vector<GetAndReleaseArgs> args(4);
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (same_path) {
+      args[i].model_paths = {"concurrent.onnx"};
+    } else {
+      args[i].model_paths = {"concurrent_" + std::to_string(i % 2) + ".onnx",
+                             "concurrent_" + std::to_string(2 + i / 2) +
+                                 ".onnx"};
+    }
+    args[i].iterations = 1000;
+  }
+  return args;
+}
+
+TEST_F(OnnxModelTest, SharesAHeldModelWithConcurrentUsers) {
+  std::vector<GetAndReleaseArgs> args = CreateArgs(/*same_path=*/true);
+  std::shared_ptr<const OnnxModel> held =
+      OnnxModel::Get("concurrent.onnx", OnnxModelOptions());
+  for (GetAndReleaseArgs& thread_args : args)
+    thread_args.held_models["concurrent.onnx"] = held.get();
+  RunConcurrently(&args);
+
+  for (const GetAndReleaseArgs& thread_args : args)
+    EXPECT_EQ(thread_args.failures, 0);
+  EXPECT_EQ(backend_.loads(), 1);
+  held.reset();
+  EXPECT_EQ(backend_.unloads(), 1);
+}
+
+TEST_F(OnnxModelTest, SharesHeldModelsOfPathsWithConcurrentUsers) {
+  std::vector<GetAndReleaseArgs> args = CreateArgs(/*same_path=*/false);
+  std::vector<std::shared_ptr<const OnnxModel>> held;
+  for (int i = 0; i < 4; ++i) {
+    const std::string model_path =
+        "concurrent_" + std::to_string(i) + ".onnx";
+    held.push_back(OnnxModel::Get(model_path, OnnxModelOptions()));
+    for (GetAndReleaseArgs& thread_args : args)
+      thread_args.held_models[model_path] = held.back().get();
+  }
+  RunConcurrently(&args);
+
+  for (const GetAndReleaseArgs& thread_args : args)
+    EXPECT_EQ(thread_args.failures, 0);
+  EXPECT_EQ(backend_.loads(), 4);
+  held.clear();
+  EXPECT_EQ(backend_.unloads(), 4);
+}
+
+TEST_F(OnnxModelTest, GetsAndReleasesAPathConcurrently) {
+  std::vector<GetAndReleaseArgs> args = CreateArgs(/*same_path=*/true);
+  RunConcurrently(&args);
+
+  for (const GetAndReleaseArgs& thread_args : args)
+    EXPECT_EQ(thread_args.failures, 0);
+  // Every model loaded, possibly several times, is unloaded once.
+  EXPECT_GE(backend_.loads(), 1);
+  EXPECT_EQ(backend_.unloads(), backend_.loads());
+}
+
+TEST_F(OnnxModelTest, GetsAndReleasesPathsConcurrently) {
+  std::vector<GetAndReleaseArgs> args = CreateArgs(/*same_path=*/false);
+  RunConcurrently(&args);
+
+  for (const GetAndReleaseArgs& thread_args : args)
+    EXPECT_EQ(thread_args.failures, 0);
+  EXPECT_GE(backend_.loads(), 4);
+  EXPECT_EQ(backend_.unloads(), backend_.loads());
+}
+
+}  // namespace
+}  // namespace webrtc
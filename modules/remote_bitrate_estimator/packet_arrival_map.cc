@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+// Smallest ring allocated, grown by doubling up to what the span of stored
+// sequence numbers needs.
+constexpr size_t kMinCapacity = 64;
+constexpr size_t kBitsPerWord = 64;
+}  // namespace
+
+constexpr int64_t PacketArrivalTimeMap::kMaxNumberOfPackets;
+
+PacketArrivalTimeMap::PacketArrivalTimeMap() = default;
+PacketArrivalTimeMap::~PacketArrivalTimeMap() = default;
+
+bool PacketArrivalTimeMap::has_received(int64_t sequence_number) const {
+  return sequence_number >= begin_sequence_number_ &&
+         sequence_number < end_sequence_number_ && IsSet(sequence_number);
+}
+
+int64_t PacketArrivalTimeMap::get(int64_t sequence_number) const {
+  RTC_DCHECK(has_received(sequence_number));
+  return arrival_times_[Index(sequence_number)];
+}
+
+int64_t PacketArrivalTimeMap::LowerBound(int64_t sequence_number) const {
+  int64_t seq = std::max(sequence_number, begin_sequence_number_);
+  while (seq < end_sequence_number_ && !IsSet(seq))
+    ++seq;
+  return std::min(seq, end_sequence_number_);
+}
+
+void PacketArrivalTimeMap::GetArrivalTimesUs(
+    int64_t begin_sequence_number,
+    int64_t end_sequence_number,
+    int64_t not_received,
+    std::vector<int64_t>* arrival_times_us) const {
+  RTC_DCHECK_LE(begin_sequence_number, end_sequence_number);
+  arrival_times_us->assign(end_sequence_number - begin_sequence_number,
+                           not_received);
+  int64_t seq = std::max(begin_sequence_number, begin_sequence_number_);
+  const int64_t end = std::min(end_sequence_number, end_sequence_number_);
+  for (; seq < end; ++seq) {
+    if (IsSet(seq)) {
+      (*arrival_times_us)[seq - begin_sequence_number] =
+          arrival_times_[Index(seq)] * 1000;
+    }
+  }
+}
+
+bool PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
+                                     int64_t arrival_time_ms) {
+  if (empty()) {
+    Reserve(1);
+    begin_sequence_number_ = sequence_number;
+    end_sequence_number_ = sequence_number + 1;
+    Set(sequence_number, arrival_time_ms);
+    return false;
+  }
+
+  if (sequence_number >= end_sequence_number_) {
+    // |sequence_number| becomes the newest packet, drop what falls out of the
+    // window before growing the ring so it never exceeds the window.
+    bool removed = EraseTo(sequence_number - kMaxNumberOfPackets);
+    if (empty()) {
+      begin_sequence_number_ = sequence_number;
+    } else {
+      Reserve(sequence_number + 1 - begin_sequence_number_);
+    }
+    end_sequence_number_ = sequence_number + 1;
+    Set(sequence_number, arrival_time_ms);
+    return removed;
+  }
+
+  if (sequence_number < begin_sequence_number_) {
+    if (sequence_number < end_sequence_number_ - 1 - kMaxNumberOfPackets) {
+      // Too old to be kept, it is removed as soon as it is added.
+      return true;
+    }
+    Reserve(end_sequence_number_ - sequence_number);
+    begin_sequence_number_ = sequence_number;
+  }
+  Set(sequence_number, arrival_time_ms);
+  return false;
+}
+
+void PacketArrivalTimeMap::RemoveOldPackets(int64_t sequence_number,
+                                            int64_t arrival_time_limit) {
+  while (!empty() && begin_sequence_number_ < sequence_number &&
+         arrival_times_[Index(begin_sequence_number_)] <= arrival_time_limit) {
+    Clear(begin_sequence_number_);
+    begin_sequence_number_ = LowerBound(begin_sequence_number_ + 1);
+  }
+}
+
+bool PacketArrivalTimeMap::EraseTo(int64_t sequence_number) {
+  if (empty() || sequence_number <= begin_sequence_number_)
+    return false;
+  if (sequence_number >= end_sequence_number_) {
+    std::fill(received_.begin(), received_.end(), 0);
+    begin_sequence_number_ = end_sequence_number_;
+    return true;
+  }
+  for (int64_t seq = begin_sequence_number_; seq < sequence_number; ++seq)
+    Clear(seq);
+  // The newest packet is never removed here, so the scan always stops on a
+  // received packet.
+  begin_sequence_number_ = LowerBound(sequence_number);
+  return true;
+}
+
+bool PacketArrivalTimeMap::IsSet(int64_t sequence_number) const {
+  size_t index = Index(sequence_number);
+  return (received_[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1;
+}
+
+void PacketArrivalTimeMap::Set(int64_t sequence_number,
+                               int64_t arrival_time_ms) {
+  size_t index = Index(sequence_number);
+  arrival_times_[index] = arrival_time_ms;
+  received_[index / kBitsPerWord] |= uint64_t{1} << (index % kBitsPerWord);
+}
+
+void PacketArrivalTimeMap::Clear(int64_t sequence_number) {
+  size_t index = Index(sequence_number);
+  received_[index / kBitsPerWord] &= ~(uint64_t{1} << (index % kBitsPerWord));
+}
+
+void PacketArrivalTimeMap::Reserve(int64_t span) {
+  RTC_DCHECK_GT(span, 0);
+  RTC_DCHECK_LE(span, kMaxNumberOfPackets + 1);
+  size_t capacity = arrival_times_.size();
+  if (static_cast<size_t>(span) <= capacity)
+    return;
+  size_t new_capacity = std::max(capacity, kMinCapacity);
+  while (new_capacity < static_cast<size_t>(span))
+    new_capacity *= 2;
+
+  std::vector<int64_t> arrival_times(new_capacity);
+  std::vector<uint64_t> received(new_capacity / kBitsPerWord);
+  if (!empty()) {
+    // Re-index every stored packet for the new size.
+    std::swap(arrival_times_, arrival_times);
+    std::swap(received_, received);
+    for (int64_t seq = begin_sequence_number_; seq < end_sequence_number_;
+         ++seq) {
+      size_t old_index = static_cast<size_t>(static_cast<uint64_t>(seq) &
+                                             (capacity - 1));
+      if ((received[old_index / kBitsPerWord] >> (old_index % kBitsPerWord)) &
+          1) {
+        Set(seq, arrival_times[old_index]);
+      }
+    }
+  } else {
+    arrival_times_ = std::move(arrival_times);
+    received_ = std::move(received);
+  }
+}
+
+}  // namespace webrtc
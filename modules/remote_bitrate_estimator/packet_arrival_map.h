@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace webrtc {
+
+// PacketArrivalTimeMap maps unwrapped transport sequence numbers to arrival
+// times. It replaces a std::map<int64_t, int64_t> for RemoteEstimatorProxy:
+// since sequence numbers are dense and the span of stored sequence numbers is
+// bounded, the arrival times are kept in a ring buffer indexed by sequence
+// number with a bitmap telling which of them were received. All operations
+// except growing the ring and scanning over gaps are O(1).
+class PacketArrivalTimeMap {
+ public:
+  // Packets older than the newest received sequence number minus this are
+  // removed, as feedback can't be requested for them.
+  static constexpr int64_t kMaxNumberOfPackets = (1 << 15);
+
+  PacketArrivalTimeMap();
+  ~PacketArrivalTimeMap();
+
+  bool empty() const { return begin_sequence_number_ == end_sequence_number_; }
+
+  // Returns true if |sequence_number| has been received and not removed.
+  bool has_received(int64_t sequence_number) const;
+
+  // Returns the arrival time of |sequence_number|, which must have been
+  // received.
+  int64_t get(int64_t sequence_number) const;
+
+  // The lowest received sequence number. Undefined if empty().
+  int64_t begin_sequence_number() const { return begin_sequence_number_; }
+
+  // One past the highest received sequence number. Undefined if empty().
+  int64_t end_sequence_number() const { return end_sequence_number_; }
+
+  // Returns the lowest received sequence number that is >= |sequence_number|
+  // or end_sequence_number() if there is none.
+  int64_t LowerBound(int64_t sequence_number) const;
+
+  // Replaces |arrival_times_us| with the arrival time in microseconds of every
+  // sequence number in [begin_sequence_number, end_sequence_number), using
+  // |not_received| for the ones that haven't been received.
+  void GetArrivalTimesUs(int64_t begin_sequence_number,
+                         int64_t end_sequence_number,
+                         int64_t not_received,
+                         std::vector<int64_t>* arrival_times_us) const;
+
+  // Records the arrival of |sequence_number| and removes every packet older
+  // than the newest sequence number minus kMaxNumberOfPackets, which may
+  // include |sequence_number| itself. Returns true if any packet was removed.
+  bool AddPacket(int64_t sequence_number, int64_t arrival_time_ms);
+
+  // Removes packets from the beginning while their sequence number is lower
+  // than |sequence_number| and they arrived at or before
+  // |arrival_time_limit|.
+  void RemoveOldPackets(int64_t sequence_number, int64_t arrival_time_limit);
+
+  // Removes every packet with a sequence number lower than |sequence_number|.
+  // Returns true if any packet was removed.
+  bool EraseTo(int64_t sequence_number);
+
+ private:
+  size_t Index(int64_t sequence_number) const {
+    return static_cast<size_t>(static_cast<uint64_t>(sequence_number) &
+                               (arrival_times_.size() - 1));
+  }
+  bool IsSet(int64_t sequence_number) const;
+  void Set(int64_t sequence_number, int64_t arrival_time_ms);
+  void Clear(int64_t sequence_number);
+  // Makes room for at least |span| consecutive sequence numbers.
+  void Reserve(int64_t span);
+
+  // Indexed by sequence number modulo the size, which is a power of two.
+  std::vector<int64_t> arrival_times_;
+  // One bit per entry in |arrival_times_|. Bits outside
+  // [begin_sequence_number_, end_sequence_number_) are always cleared.
+  std::vector<uint64_t> received_;
+  int64_t begin_sequence_number_ = 0;
+  int64_t end_sequence_number_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
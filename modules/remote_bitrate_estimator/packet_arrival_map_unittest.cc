@@ -0,0 +1,305 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include <map>
+#include <vector>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kMaxNumberOfPackets =
+    PacketArrivalTimeMap::kMaxNumberOfPackets;
+
+// The std::map based bookkeeping RemoteEstimatorProxy used before, kept as
+// the reference behavior.
+class ReferenceMap {
+ public:
+  bool AddPacket(int64_t sequence_number, int64_t arrival_time_ms) {
+    map_[sequence_number] = arrival_time_ms;
+    auto first_to_keep =
+        map_.lower_bound(map_.rbegin()->first - kMaxNumberOfPackets);
+    if (first_to_keep == map_.begin())
+      return false;
+    map_.erase(map_.begin(), first_to_keep);
+    return true;
+  }
+
+  void RemoveOldPackets(int64_t sequence_number, int64_t arrival_time_limit) {
+    for (auto it = map_.begin(); it != map_.end() &&
+                                 it->first < sequence_number &&
+                                 it->second <= arrival_time_limit;) {
+      it = map_.erase(it);
+    }
+  }
+
+  bool EraseTo(int64_t sequence_number) {
+    auto it = map_.lower_bound(sequence_number);
+    bool removed = it != map_.begin();
+    map_.erase(map_.begin(), it);
+    return removed;
+  }
+
+  const std::map<int64_t, int64_t>& map() const { return map_; }
+
+ private:
+  std::map<int64_t, int64_t> map_;
+};
+
+void ExpectSameContent(const ReferenceMap& reference,
+                       const PacketArrivalTimeMap& map) {
+  const std::map<int64_t, int64_t>& expected = reference.map();
+  ASSERT_EQ(expected.empty(), map.empty());
+  if (expected.empty())
+    return;
+  EXPECT_EQ(expected.begin()->first, map.begin_sequence_number());
+  EXPECT_EQ(expected.rbegin()->first + 1, map.end_sequence_number());
+  size_t received = 0;
+  for (int64_t seq = map.begin_sequence_number();
+       seq < map.end_sequence_number(); ++seq) {
+    auto it = expected.find(seq);
+    ASSERT_EQ(it != expected.end(), map.has_received(seq)) << seq;
+    if (it != expected.end()) {
+      EXPECT_EQ(it->second, map.get(seq));
+      ++received;
+    }
+  }
+  EXPECT_EQ(expected.size(), received);
+}
+
+TEST(PacketArrivalMapTest, IsConsistentWhenEmpty) {
+  PacketArrivalTimeMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.has_received(0));
+  EXPECT_EQ(map.LowerBound(10), map.end_sequence_number());
+  EXPECT_FALSE(map.EraseTo(10));
+}
+
+TEST(PacketArrivalMapTest, InsertsFirstItemIntoMap) {
+  PacketArrivalTimeMap map;
+  EXPECT_FALSE(map.AddPacket(42, 10));
+  EXPECT_EQ(map.begin_sequence_number(), 42);
+  EXPECT_EQ(map.end_sequence_number(), 43);
+  EXPECT_FALSE(map.has_received(41));
+  EXPECT_TRUE(map.has_received(42));
+  EXPECT_FALSE(map.has_received(44));
+  EXPECT_EQ(map.get(42), 10);
+}
+
+TEST(PacketArrivalMapTest, InsertsWithGaps) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  map.AddPacket(45, 11);
+  EXPECT_EQ(map.begin_sequence_number(), 42);
+  EXPECT_EQ(map.end_sequence_number(), 46);
+  EXPECT_FALSE(map.has_received(43));
+  EXPECT_FALSE(map.has_received(44));
+  EXPECT_TRUE(map.has_received(45));
+  EXPECT_EQ(map.LowerBound(43), 45);
+  EXPECT_EQ(map.LowerBound(46), 46);
+}
+
+TEST(PacketArrivalMapTest, InsertsReorderedPacketBeforeBegin) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  map.AddPacket(40, 11);
+  EXPECT_EQ(map.begin_sequence_number(), 40);
+  EXPECT_EQ(map.end_sequence_number(), 43);
+  EXPECT_FALSE(map.has_received(41));
+  EXPECT_EQ(map.get(40), 11);
+}
+
+TEST(PacketArrivalMapTest, LimitsRangeOfSequenceNumbers) {
+  PacketArrivalTimeMap map;
+  EXPECT_FALSE(map.AddPacket(0, 10));
+  EXPECT_FALSE(map.AddPacket(kMaxNumberOfPackets, 11));
+  EXPECT_TRUE(map.has_received(0));
+  EXPECT_TRUE(map.AddPacket(kMaxNumberOfPackets + 1, 12));
+  EXPECT_EQ(map.begin_sequence_number(), kMaxNumberOfPackets);
+  // Too old to be stored.
+  EXPECT_TRUE(map.AddPacket(0, 13));
+  EXPECT_FALSE(map.has_received(0));
+  EXPECT_EQ(map.begin_sequence_number(), kMaxNumberOfPackets);
+}
+
+TEST(PacketArrivalMapTest, HandlesLargeJumpForward) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(1, 10);
+  map.AddPacket(2, 11);
+  EXPECT_TRUE(map.AddPacket(1000000, 12));
+  EXPECT_EQ(map.begin_sequence_number(), 1000000);
+  EXPECT_EQ(map.end_sequence_number(), 1000001);
+  EXPECT_FALSE(map.has_received(1));
+}
+
+TEST(PacketArrivalMapTest, RemovesOldPacketsByArrivalTime) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(10, 100);
+  map.AddPacket(11, 200);
+  map.AddPacket(13, 300);
+  map.RemoveOldPackets(13, 250);
+  EXPECT_EQ(map.begin_sequence_number(), 13);
+  // Never removes |sequence_number| or newer.
+  map.RemoveOldPackets(13, 1000);
+  EXPECT_TRUE(map.has_received(13));
+}
+
+TEST(PacketArrivalMapTest, ErasesToSequenceNumber) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(10, 100);
+  map.AddPacket(12, 200);
+  map.AddPacket(14, 300);
+  EXPECT_FALSE(map.EraseTo(10));
+  EXPECT_TRUE(map.EraseTo(11));
+  EXPECT_EQ(map.begin_sequence_number(), 12);
+  EXPECT_TRUE(map.EraseTo(20));
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PacketArrivalMapTest, GetsArrivalTimesInMicroseconds) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(10, 100);
+  map.AddPacket(12, 200);
+  std::vector<int64_t> arrival_times_us = {1, 2, 3, 4, 5, 6, 7};
+  map.GetArrivalTimesUs(9, 14, -1, &arrival_times_us);
+  EXPECT_EQ(arrival_times_us,
+            (std::vector<int64_t>{-1, 100000, -1, 200000, -1}));
+  map.GetArrivalTimesUs(12, 12, -1, &arrival_times_us);
+  EXPECT_TRUE(arrival_times_us.empty());
+}
+
+TEST(PacketArrivalMapTest, MatchesStdMapWithRandomTraffic) {
+  Random random(0x12345678);
+  ReferenceMap reference;
+  PacketArrivalTimeMap map;
+  // Start close to zero so that reordering produces negative sequence numbers.
+  int64_t next_seq = 5;
+  int64_t now_ms = 0;
+  for (int i = 0; i < 200000; ++i) {
+    now_ms += random.Rand(0, 2);
+    int op = random.Rand(0, 999);
+    if (op < 900) {
+      int64_t seq = next_seq++;
+      if (random.Rand(0, 99) < 5)
+        seq -= random.Rand(1, 50);  // Reordered.
+      if (random.Rand(0, 99) < 2)
+        continue;  // Lost.
+      if (random.Rand(0, 9999) == 0) {
+        // Large jump forward.
+        next_seq +=
+            random.Rand(0, static_cast<int32_t>(2 * kMaxNumberOfPackets));
+        seq = next_seq++;
+      }
+      if (reference.map().count(seq) != 0) {
+        EXPECT_TRUE(map.has_received(seq));
+        continue;
+      }
+      ASSERT_EQ(reference.AddPacket(seq, now_ms), map.AddPacket(seq, now_ms));
+    } else if (op < 950) {
+      int64_t seq = next_seq - random.Rand(0, 200);
+      reference.RemoveOldPackets(seq, now_ms - 500);
+      map.RemoveOldPackets(seq, now_ms - 500);
+    } else {
+      int64_t seq = next_seq - random.Rand(0, 1000);
+      ASSERT_EQ(reference.EraseTo(seq), map.EraseTo(seq));
+    }
+    if (i % 1000 == 0) {
+      ExpectSameContent(reference, map);
+      int64_t seq = next_seq - random.Rand(0, 2000);
+      auto it = reference.map().lower_bound(seq);
+      EXPECT_EQ(it == reference.map().end() ? map.end_sequence_number()
+                                            : it->first,
+                map.LowerBound(seq));
+    }
+  }
+  ExpectSameContent(reference, map);
+}
+
+// Runs the feedback bookkeeping done by RemoteEstimatorProxy for a stream
+// with some loss and reordering. Run manually to compare with the std::map
+// it replaced.
+TEST(PacketArrivalMapTest, DISABLED_BenchmarkAgainstStdMap) {
+  constexpr int kNumPackets = 2000000;
+  constexpr int kPacketsPerFeedback = 100;
+
+  std::vector<int64_t> sequence_numbers;
+  sequence_numbers.reserve(kNumPackets);
+  Random random(0x12345678);
+  for (int64_t seq = 0; seq < kNumPackets; ++seq) {
+    if (random.Rand(0, 99) == 0)
+      continue;
+    sequence_numbers.push_back(seq);
+    if (random.Rand(0, 99) == 0 && sequence_numbers.size() > 2)
+      std::swap(sequence_numbers[sequence_numbers.size() - 1],
+                sequence_numbers[sequence_numbers.size() - 2]);
+  }
+
+  int64_t checksum_map = 0;
+  int64_t start_us = rtc::TimeMicros();
+  {
+    std::map<int64_t, int64_t> map;
+    int64_t window_start = 0;
+    for (size_t i = 0; i < sequence_numbers.size(); ++i) {
+      int64_t seq = sequence_numbers[i];
+      if (map.find(seq) != map.end())
+        continue;
+      map[seq] = i;
+      auto first_to_keep =
+          map.lower_bound(map.rbegin()->first - kMaxNumberOfPackets);
+      map.erase(map.begin(), first_to_keep);
+      if (i % kPacketsPerFeedback == 0) {
+        auto begin = map.lower_bound(window_start);
+        for (auto it = begin; it != map.end(); ++it) {
+          checksum_map += it->second;
+          window_start = it->first + 1;
+        }
+        map.erase(map.begin(), map.lower_bound(window_start - 500));
+      }
+    }
+  }
+  int64_t map_us = rtc::TimeMicros() - start_us;
+
+  int64_t checksum_ring = 0;
+  start_us = rtc::TimeMicros();
+  {
+    PacketArrivalTimeMap map;
+    int64_t window_start = 0;
+    for (size_t i = 0; i < sequence_numbers.size(); ++i) {
+      int64_t seq = sequence_numbers[i];
+      if (map.has_received(seq))
+        continue;
+      map.AddPacket(seq, i);
+      if (i % kPacketsPerFeedback == 0) {
+        for (int64_t s = map.LowerBound(window_start);
+             s < map.end_sequence_number(); ++s) {
+          if (!map.has_received(s))
+            continue;
+          checksum_ring += map.get(s);
+          window_start = s + 1;
+        }
+        map.EraseTo(window_start - 500);
+      }
+    }
+  }
+  int64_t ring_us = rtc::TimeMicros() - start_us;
+
+  EXPECT_EQ(checksum_map, checksum_ring);
+  RTC_LOG(LS_INFO) << "std::map: " << map_us / 1000.0
+                   << " ms, PacketArrivalTimeMap: " << ring_us / 1000.0
+                   << " ms for " << sequence_numbers.size() << " packets";
+}
+
+}  // namespace
+}  // namespace webrtc
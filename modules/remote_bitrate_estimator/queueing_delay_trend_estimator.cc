@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/queueing_delay_trend_estimator.h"
+
+#include <algorithm>
+
+namespace webrtc {
+namespace {
+// Fewer packets give no trend at all.
+constexpr size_t kMinSamples = 10;
+// The confidence grows linearly with the number of packets up to this many.
+constexpr size_t kFullConfidenceSamples = 50;
+}  // namespace
+
+constexpr int64_t QueueingDelayTrendEstimator::kTrendWindowMs;
+constexpr int64_t QueueingDelayTrendEstimator::kBaseDelayWindowMs;
+
+QueueingDelayTrendEstimator::QueueingDelayTrendEstimator() = default;
+QueueingDelayTrendEstimator::~QueueingDelayTrendEstimator() = default;
+
+void QueueingDelayTrendEstimator::OnPacket(int64_t send_time_ms,
+                                           int64_t arrival_time_ms) {
+  Sample sample{arrival_time_ms,
+                static_cast<double>(arrival_time_ms - send_time_ms)};
+  samples_.push_back(sample);
+  while (!base_delays_.empty() &&
+         base_delays_.back().delay_ms >= sample.delay_ms) {
+    base_delays_.pop_back();
+  }
+  base_delays_.push_back(sample);
+  RemoveOldSamples(arrival_time_ms);
+}
+
+void QueueingDelayTrendEstimator::RemoveOldSamples(int64_t now_ms) {
+  while (!samples_.empty() &&
+         samples_.front().arrival_time_ms <= now_ms - kTrendWindowMs) {
+    samples_.pop_front();
+  }
+  // The newest is kept, even if old, to serve as the base delay.
+  while (base_delays_.size() > 1 &&
+         base_delays_.front().arrival_time_ms <= now_ms - kBaseDelayWindowMs) {
+    base_delays_.pop_front();
+  }
+}
+
+absl::optional<QueueingDelayTrend> QueueingDelayTrendEstimator::GetTrend(
+    int64_t now_ms) {
+  RemoveOldSamples(now_ms);
+  if (samples_.size() < kMinSamples)
+    return absl::nullopt;
+
+  // Least squares fit of the delay over the arrival time, relative to the
+  // first sample to keep the sums small.
+  const int64_t first_arrival_ms = samples_.front().arrival_time_ms;
+  const double n = samples_.size();
+  double sum_x = 0;
+  double sum_y = 0;
+  for (const Sample& sample : samples_) {
+    sum_x += sample.arrival_time_ms - first_arrival_ms;
+    sum_y += sample.delay_ms;
+  }
+  const double mean_x = sum_x / n;
+  const double mean_y = sum_y / n;
+  double sxx = 0;
+  double sxy = 0;
+  double syy = 0;
+  for (const Sample& sample : samples_) {
+    double dx = sample.arrival_time_ms - first_arrival_ms - mean_x;
+    double dy = sample.delay_ms - mean_y;
+    sxx += dx * dx;
+    sxy += dx * dy;
+    syy += dy * dy;
+  }
+  // All packets arrived at once.
+  if (sxx == 0)
+    return absl::nullopt;
+
+  const double slope = sxy / sxx;
+  // A constant delay is fitted perfectly.
+  const double r_squared = syy == 0 ? 1.0 : sxy * sxy / (sxx * syy);
+  const double last_x = samples_.back().arrival_time_ms - first_arrival_ms;
+  const double fitted_delay_ms = mean_y + slope * (last_x - mean_x);
+
+  QueueingDelayTrend trend;
+  trend.queueing_delay = TimeDelta::Micros(static_cast<int64_t>(
+      std::max(0.0, fitted_delay_ms - base_delays_.front().delay_ms) * 1000));
+  trend.slope_ms_per_s = slope * 1000;
+  trend.confidence = r_squared * std::min(1.0, n / kFullConfidenceSamples);
+  return trend;
+}
+
+}  // namespace webrtc
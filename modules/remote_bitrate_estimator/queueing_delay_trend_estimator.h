@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_QUEUEING_DELAY_TREND_ESTIMATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_QUEUEING_DELAY_TREND_ESTIMATOR_H_
+
+#include <stdint.h>
+
+#include <deque>
+
+#include "absl/types/optional.h"
+#include "api/transport/queueing_delay_trend.h"
+
+namespace webrtc {
+
+// Estimates the QueueingDelayTrend from the send and arrival times of the
+// received packets. The one-way delay of the packets of the last
+// |kTrendWindowMs| is fitted to a line; its slope is the trend and the
+// coefficient of determination of the fit its confidence, so that the random
+// jitter of an uncongested path yields little confidence. The queueing delay
+// is the fitted delay above the lowest one of the last |kBaseDelayWindowMs|,
+// which also cancels the offset between the clocks of sender and receiver.
+class QueueingDelayTrendEstimator {
+ public:
+  static constexpr int64_t kTrendWindowMs = 500;
+  static constexpr int64_t kBaseDelayWindowMs = 10000;
+
+  QueueingDelayTrendEstimator();
+  ~QueueingDelayTrendEstimator();
+
+  // Must be called for every packet in the order they arrived.
+  void OnPacket(int64_t send_time_ms, int64_t arrival_time_ms);
+
+  // Unset while too few packets arrived in the last |kTrendWindowMs|.
+  absl::optional<QueueingDelayTrend> GetTrend(int64_t now_ms);
+
+ private:
+  struct Sample {
+    int64_t arrival_time_ms;
+    double delay_ms;
+  };
+
+  void RemoveOldSamples(int64_t now_ms);
+
+  std::deque<Sample> samples_;
+  // Candidates for the lowest delay, in increasing order of delay.
+  std::deque<Sample> base_delays_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_QUEUEING_DELAY_TREND_ESTIMATOR_H_
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/queueing_delay_trend_estimator.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Clock offset between sender and receiver.
+constexpr int64_t kOffsetMs = 12345;
+constexpr int64_t kPacketIntervalMs = 5;
+
+// Receives a packet every |kPacketIntervalMs| in [|start_ms|, |end_ms|), sent
+// |delay_ms(arrival_time_ms)| before it arrived.
+template <typename DelayFunction>
+void Receive(QueueingDelayTrendEstimator* estimator,
+             int64_t start_ms,
+             int64_t end_ms,
+             DelayFunction delay_ms) {
+  for (int64_t now_ms = start_ms; now_ms < end_ms;
+       now_ms += kPacketIntervalMs) {
+    estimator->OnPacket(now_ms - kOffsetMs - delay_ms(now_ms), now_ms);
+  }
+}
+
+TEST(QueueingDelayTrendEstimatorTest, NoTrendWithoutPackets) {
+  QueueingDelayTrendEstimator estimator;
+  EXPECT_FALSE(estimator.GetTrend(1000));
+  Receive(&estimator, 0, 20, [](int64_t) { return 20; });
+  EXPECT_FALSE(estimator.GetTrend(20));
+}
+
+TEST(QueueingDelayTrendEstimatorTest, ConstantDelayIsFlat) {
+  QueueingDelayTrendEstimator estimator;
+  Receive(&estimator, 0, 1000, [](int64_t) { return 20; });
+  absl::optional<QueueingDelayTrend> trend = estimator.GetTrend(1000);
+  ASSERT_TRUE(trend);
+  EXPECT_EQ(trend->queueing_delay, TimeDelta::Zero());
+  EXPECT_DOUBLE_EQ(trend->slope_ms_per_s, 0.0);
+  EXPECT_DOUBLE_EQ(trend->confidence, 1.0);
+}
+
+TEST(QueueingDelayTrendEstimatorTest, FollowsGrowingAndDrainingQueue) {
+  QueueingDelayTrendEstimator estimator;
+  Receive(&estimator, 0, 1000, [](int64_t) { return 20; });
+  // The queue grows by 100 ms per second.
+  Receive(&estimator, 1000, 2000,
+          [](int64_t now_ms) { return 20 + (now_ms - 1000) / 10; });
+  absl::optional<QueueingDelayTrend> trend = estimator.GetTrend(2000);
+  ASSERT_TRUE(trend);
+  EXPECT_NEAR(trend->slope_ms_per_s, 100, 1);
+  EXPECT_NEAR(trend->queueing_delay.ms(), 100, 2);
+  EXPECT_GT(trend->confidence, 0.99);
+
+  // And drains twice as fast.
+  Receive(&estimator, 2000, 2500,
+          [](int64_t now_ms) { return 120 - (now_ms - 2000) / 5; });
+  trend = estimator.GetTrend(2500);
+  ASSERT_TRUE(trend);
+  EXPECT_NEAR(trend->slope_ms_per_s, -200, 2);
+  EXPECT_NEAR(trend->queueing_delay.ms(), 0, 2);
+}
+
+TEST(QueueingDelayTrendEstimatorTest, RandomJitterGivesLittleConfidence) {
+  QueueingDelayTrendEstimator estimator;
+  Receive(&estimator, 0, 1000, [](int64_t now_ms) {
+    // Alternates between 0 and 30 ms of jitter.
+    return 20 + (now_ms / kPacketIntervalMs % 2) * 30;
+  });
+  absl::optional<QueueingDelayTrend> trend = estimator.GetTrend(1000);
+  ASSERT_TRUE(trend);
+  EXPECT_LT(trend->confidence, 0.1);
+}
+
+TEST(QueueingDelayTrendEstimatorTest, BaseDelayFollowsRoutes) {
+  QueueingDelayTrendEstimator estimator;
+  Receive(&estimator, 0, 1000, [](int64_t) { return 20; });
+  // Moved to a longer route, which is queueing delay until the short one is
+  // forgotten.
+  Receive(&estimator, 1000, 2000, [](int64_t) { return 50; });
+  EXPECT_EQ(estimator.GetTrend(2000)->queueing_delay, TimeDelta::Millis(30));
+  const int64_t end_ms = 1000 + QueueingDelayTrendEstimator::kBaseDelayWindowMs;
+  Receive(&estimator, 2000, end_ms, [](int64_t) { return 50; });
+  EXPECT_EQ(estimator.GetTrend(end_ms)->queueing_delay, TimeDelta::Zero());
+}
+
+TEST(QueueingDelayTrendTest, PredictedChangeIsBounded) {
+  QueueingDelayTrend trend;
+  trend.queueing_delay = TimeDelta::Millis(40);
+  trend.slope_ms_per_s = 200;
+  trend.confidence = 0.5;
+  const TimeDelta kHorizon = TimeDelta::Millis(500);
+  EXPECT_EQ(trend.PredictedChange(kHorizon, TimeDelta::Millis(100)),
+            TimeDelta::Millis(50));
+  EXPECT_EQ(trend.PredictedChange(kHorizon, TimeDelta::Millis(20)),
+            TimeDelta::Millis(20));
+  // Can't drain more than is queued.
+  trend.slope_ms_per_s = -400;
+  EXPECT_EQ(trend.PredictedChange(kHorizon, TimeDelta::Millis(100)),
+            TimeDelta::Millis(-40));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_rate_bandwidth_estimator.h"
+
+#include <algorithm>
+
+namespace webrtc {
+namespace {
+constexpr int64_t kRateWindowMs = 1000;
+// Same as the maximum increase per second of AimdRateControl.
+constexpr float kHeadroom = 1.08f;
+}  // namespace
+
+ReceiveRateBandwidthEstimator::ReceiveRateBandwidthEstimator()
+    : received_rate_(kRateWindowMs, RateStatistics::kBpsScale) {}
+
+ReceiveRateBandwidthEstimator::~ReceiveRateBandwidthEstimator() = default;
+
+void ReceiveRateBandwidthEstimator::OnPacket(const ReceivedPacketInfo& packet) {
+  // RateStatistics requires non-decreasing timestamps.
+  int64_t now_ms = std::max(packet.arrival_time_ms, last_arrival_time_ms_);
+  received_rate_.Update(
+      packet.payload_size + packet.header_length + packet.padding_length,
+      now_ms);
+  last_arrival_time_ms_ = now_ms;
+}
+
+float ReceiveRateBandwidthEstimator::GetEstimate() {
+  if (last_arrival_time_ms_ < 0)
+    return 0;
+  absl::optional<int64_t> rate_bps = received_rate_.Rate(last_arrival_time_ms_);
+  return rate_bps ? *rate_bps * kHeadroom : 0;
+}
+
+bool ReceiveRateBandwidthEstimator::IsReady() const {
+  return last_arrival_time_ms_ >= 0 &&
+         received_rate_.Rate(last_arrival_time_ms_).has_value();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_RATE_BANDWIDTH_ESTIMATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_RATE_BANDWIDTH_ESTIMATOR_H_
+
+#include <stdint.h>
+
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+#include "rtc_base/rate_statistics.h"
+
+namespace webrtc {
+
+// Cheap estimator that reports the rate packets were received at over the
+// last second, raised by a small headroom so that the sender is allowed to
+// ramp up. It does not detect congestion before losses or queuing reduce the
+// received rate, so it is meant for deployments that can't afford running a
+// model.
+class ReceiveRateBandwidthEstimator : public ReceiveSideBandwidthEstimator {
+ public:
+  ReceiveRateBandwidthEstimator();
+  ~ReceiveRateBandwidthEstimator() override;
+
+  void OnPacket(const ReceivedPacketInfo& packet) override;
+  float GetEstimate() override;
+  bool IsReady() const override;
+
+ private:
+  RateStatistics received_rate_;
+  int64_t last_arrival_time_ms_ = -1;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_RATE_BANDWIDTH_ESTIMATOR_H_
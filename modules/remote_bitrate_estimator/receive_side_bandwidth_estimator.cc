@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+
+#include "modules/remote_bitrate_estimator/bwe_model_bandwidth_estimator.h"
+#include "modules/remote_bitrate_estimator/onnx_bandwidth_estimator.h"
+#include "modules/remote_bitrate_estimator/onnx_model_registry.h"
+#include "modules/remote_bitrate_estimator/receive_rate_bandwidth_estimator.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+OnnxModelOptions GetOnnxModelOptions(const AlphaCCConfig& config) {
+  OnnxModelOptions options;
+  options.intra_op_threads = config.onnx_intra_op_threads;
+  options.inter_op_threads = config.onnx_inter_op_threads;
+  options.use_global_thread_pools = config.onnx_global_thread_pools;
+  switch (config.onnx_execution_provider) {
+    case AlphaCCConfig::OnnxExecutionProvider::kCpu:
+      options.execution_provider = onnxinfer::kExecutionProviderCpu;
+      break;
+    case AlphaCCConfig::OnnxExecutionProvider::kOpenVino:
+      options.execution_provider = onnxinfer::kExecutionProviderOpenVino;
+      break;
+    case AlphaCCConfig::OnnxExecutionProvider::kCuda:
+      options.execution_provider = onnxinfer::kExecutionProviderCuda;
+      break;
+  }
+  switch (config.onnx_graph_optimization) {
+    case AlphaCCConfig::OnnxGraphOptimization::kDisabled:
+      options.graph_optimization_level = onnxinfer::kGraphOptimizationDisabled;
+      break;
+    case AlphaCCConfig::OnnxGraphOptimization::kBasic:
+      options.graph_optimization_level = onnxinfer::kGraphOptimizationBasic;
+      break;
+    case AlphaCCConfig::OnnxGraphOptimization::kExtended:
+      options.graph_optimization_level = onnxinfer::kGraphOptimizationExtended;
+      break;
+    case AlphaCCConfig::OnnxGraphOptimization::kAll:
+      options.graph_optimization_level = onnxinfer::kGraphOptimizationAll;
+      break;
+  }
+  options.optimized_model_path = config.onnx_optimized_model_path;
+  return options;
+}
+
+}  // namespace
+
+void ReceiveSideBandwidthEstimator::OnPacketBatch(
+    rtc::ArrayView<const ReceivedPacketInfo> packets) {
+  for (const ReceivedPacketInfo& packet : packets)
+    OnPacket(packet);
+}
+
+std::unique_ptr<ReceiveSideBandwidthEstimator>
+CreateReceiveSideBandwidthEstimator(const AlphaCCConfig& config) {
+  switch (config.bwe_estimator_option) {
+    case AlphaCCConfig::BweEstimatorOption::kOnnx:
+      if (config.onnx_batch_interval_ms > 0) {
+        return std::make_unique<BatchedOnnxBandwidthEstimator>(
+            config.onnx_model_path, GetOnnxModelOptions(config),
+            config.onnx_batch_interval_ms);
+      }
+      return std::make_unique<OnnxBandwidthEstimator>(
+          config.onnx_model_path, GetOnnxModelOptions(config));
+    case AlphaCCConfig::BweEstimatorOption::kReceiveRate:
+      return std::make_unique<ReceiveRateBandwidthEstimator>();
+    case AlphaCCConfig::BweEstimatorOption::kBweModel:
+      return std::make_unique<BweModelBandwidthEstimator>(
+          config.bwe_model_path);
+  }
+  RTC_NOTREACHED();
+  return nullptr;
+}
+
+std::unique_ptr<ReceiveSideBandwidthEstimator>
+CreateWarmupFallbackEstimator(const AlphaCCConfig& config) {
+  switch (config.bwe_warmup_fallback_option) {
+    case AlphaCCConfig::BweWarmupFallbackOption::kDefault:
+      return nullptr;
+    case AlphaCCConfig::BweWarmupFallbackOption::kReceiveRate:
+      return std::make_unique<ReceiveRateBandwidthEstimator>();
+  }
+  RTC_NOTREACHED();
+  return nullptr;
+}
+
+std::shared_ptr<const OnnxModel> PreloadOnnxModel(const AlphaCCConfig& config) {
+  if (config.bwe_estimator_option != AlphaCCConfig::BweEstimatorOption::kOnnx)
+    return nullptr;
+  return OnnxModel::Get(config.onnx_model_path, GetOnnxModelOptions(config));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_BANDWIDTH_ESTIMATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_BANDWIDTH_ESTIMATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/alphacc_config.h"
+#include "api/array_view.h"
+
+namespace webrtc {
+
+class OnnxModel;
+
+// Per-packet input of a ReceiveSideBandwidthEstimator.
+struct ReceivedPacketInfo {
+  uint8_t payload_type = 0;
+  uint16_t sequence_number = 0;
+  // Rounded to milliseconds and truncated, see AbsSendTimeUnwrapper::ToMs().
+  uint32_t send_time_ms = 0;
+  // The send time with the full precision it is known with, unset if only
+  // |send_time_ms| is known.
+  absl::optional<int64_t> send_time_us;
+  uint32_t ssrc = 0;
+  size_t padding_length = 0;
+  size_t header_length = 0;
+  int64_t arrival_time_ms = 0;
+  size_t payload_size = 0;
+  // Packets lost right before this one, -1 if unknown.
+  int32_t loss_count = -1;
+  // Latest round trip time, -1 if unknown.
+  int64_t rtt_ms = -1;
+};
+
+// Frame statistics of the video streams of the call, summed over the streams
+// and cumulative since they started. Sampled at a low rate, see
+// AlphaCCConfig::bwe_frame_stats_interval_ms.
+struct ReceivedFrameStats {
+  int64_t time_ms = 0;
+  uint32_t frames_received = 0;
+  uint32_t key_frames_received = 0;
+  uint32_t frames_decoded = 0;
+  uint32_t frames_dropped = 0;
+  uint32_t freeze_count = 0;
+  uint32_t total_freezes_duration_ms = 0;
+  // Sum of the time each emitted frame spent in the jitter buffer.
+  double jitter_buffer_delay_seconds = 0;
+  uint64_t jitter_buffer_emitted_count = 0;
+};
+
+// Estimates the available bandwidth on the receive side from the received
+// packets; the sender is told the result in AlphaCC BWE messages.
+// Implementations are only ever used from a single sequence, see
+// ReceiveSideEstimatorWorker.
+class ReceiveSideBandwidthEstimator {
+ public:
+  virtual ~ReceiveSideBandwidthEstimator() = default;
+
+  virtual void OnPacket(const ReceivedPacketInfo& packet) = 0;
+  // Equivalent to calling OnPacket() for every packet in order.
+  // Implementations that have a cheaper way to ingest several packets at once
+  // should override it.
+  virtual void OnPacketBatch(rtc::ArrayView<const ReceivedPacketInfo> packets);
+  // Called with the frame statistics every time they are sampled, after the
+  // packets received until then. Ignored by default.
+  virtual void OnFrameStats(const ReceivedFrameStats& frame_stats) {}
+
+  // Returns the current estimate in bps. Only meaningful if IsReady().
+  virtual float GetEstimate() = 0;
+
+  // Returns false until the estimator is able to produce estimates, or if it
+  // failed to initialize.
+  virtual bool IsReady() const = 0;
+};
+
+// Creates the estimator selected by |config|.
+std::unique_ptr<ReceiveSideBandwidthEstimator>
+CreateReceiveSideBandwidthEstimator(const AlphaCCConfig& config);
+
+// Creates the estimator used while the one selected by |config| is not ready
+// yet, or returns null if the default estimate should be used instead.
+std::unique_ptr<ReceiveSideBandwidthEstimator>
+CreateWarmupFallbackEstimator(const AlphaCCConfig& config);
+
+// Loads the ONNX model of the estimator selected by |config| ahead of the
+// calls, which then share it instead of loading it for as long as the result
+// is held. Returns null if the estimator doesn't use ONNX or the model can't
+// be loaded.
+std::shared_ptr<const OnnxModel> PreloadOnnxModel(const AlphaCCConfig& config);
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_BANDWIDTH_ESTIMATOR_H_
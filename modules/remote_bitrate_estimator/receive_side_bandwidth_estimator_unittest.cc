@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+
+#include <memory>
+#include <string>
+
+#include "modules/remote_bitrate_estimator/onnx_model_registry.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kModelPath[] = "preload.onnx";
+constexpr char kMissingModelPath[] = "missing.onnx";
+
+// Records the models loaded, without running them.
+class FakeOnnxInferBackend : public OnnxInferBackend {
+ public:
+  void* CreateModel(const std::string& model_path,
+                    const OnnxModelOptions& options) override {
+    ++loads_;
+    last_options_ = options;
+    if (model_path == kMissingModelPath)
+      return nullptr;
+    return new int(0);
+  }
+  void DestroyModel(void* onnx_infer_model) override {
+    delete static_cast<int*>(onnx_infer_model);
+    ++unloads_;
+  }
+  void* CreateInferInterface(void* onnx_infer_model) override {
+    return onnx_infer_model;
+  }
+  void DestroyInferInterface(void* infer_interface) override {}
+  void OnReceivedBatch(void* infer_interface,
+                       const onnxinfer::PacketFeature* features,
+                       size_t count) override {}
+  bool IsReady(void* infer_interface) override { return true; }
+  void GetEstimates(void* onnx_infer_model,
+                    void* const* infer_interfaces,
+                    size_t count,
+                    float* estimates_bps) override {}
+
+  int loads() const { return loads_; }
+  int unloads() const { return unloads_; }
+  const OnnxModelOptions& last_options() const { return last_options_; }
+
+ private:
+  int loads_ = 0;
+  int unloads_ = 0;
+  OnnxModelOptions last_options_;
+};
+
+class PreloadOnnxModelTest : public ::testing::Test {
+ protected:
+  PreloadOnnxModelTest() : scoped_backend_(&backend_) {
+    config_.bwe_estimator_option = AlphaCCConfig::BweEstimatorOption::kOnnx;
+    config_.onnx_model_path = kModelPath;
+  }
+
+  FakeOnnxInferBackend backend_;
+  ScopedOnnxInferBackendForTesting scoped_backend_;
+  AlphaCCConfig config_;
+};
+
+TEST_F(PreloadOnnxModelTest, SharesTheModelWithTheEstimatorsOfTheConfig) {
+  config_.onnx_intra_op_threads = 2;
+  config_.onnx_graph_optimization =
+      AlphaCCConfig::OnnxGraphOptimization::kBasic;
+  std::shared_ptr<const OnnxModel> model = PreloadOnnxModel(config_);
+  ASSERT_TRUE(model);
+  EXPECT_EQ(backend_.loads(), 1);
+  EXPECT_EQ(backend_.last_options().intra_op_threads, 2);
+  EXPECT_EQ(backend_.last_options().graph_optimization_level,
+            onnxinfer::kGraphOptimizationBasic);
+
+  std::unique_ptr<ReceiveSideBandwidthEstimator> estimator =
+      CreateReceiveSideBandwidthEstimator(config_);
+  ASSERT_TRUE(estimator);
+  EXPECT_EQ(backend_.loads(), 1);
+
+  // Held by the estimator once the preloaded model is released.
+  model.reset();
+  EXPECT_EQ(backend_.unloads(), 0);
+  estimator.reset();
+  EXPECT_EQ(backend_.unloads(), 1);
+}
+
+TEST_F(PreloadOnnxModelTest, LoadsNothingForTheOtherEstimators) {
+  config_.bwe_estimator_option =
+      AlphaCCConfig::BweEstimatorOption::kReceiveRate;
+  EXPECT_FALSE(PreloadOnnxModel(config_));
+  EXPECT_EQ(backend_.loads(), 0);
+}
+
+TEST_F(PreloadOnnxModelTest, ReturnsNullForAMissingModel) {
+  config_.onnx_model_path = kMissingModelPath;
+  EXPECT_FALSE(PreloadOnnxModel(config_));
+  EXPECT_EQ(backend_.loads(), 1);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,306 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_side_estimator_worker.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/trace_event.h"
+#include "system_wrappers/include/metrics.h"
+
+namespace webrtc {
+namespace {
+
+// Values above are still counted, just less efficiently.
+constexpr uint32_t kInferenceTimeLongTailUs = 10000;
+
+}  // namespace
+
+constexpr size_t ReceiveSideEstimatorWorker::kMaxPendingPackets;
+constexpr size_t ReceiveSideEstimatorWorker::kEarlyDrainPackets;
+constexpr size_t ReceiveSideEstimatorWorker::kMaxPendingFrameStats;
+
+ReceiveSideEstimatorWorker::ReceiveSideEstimatorWorker(
+    EstimatorFactory estimator_factory,
+    std::unique_ptr<ReceiveSideBandwidthEstimator> fallback_estimator,
+    float initial_estimate_bps,
+    int64_t estimate_interval_ms,
+    EstimateCallback estimate_callback)
+    : ReceiveSideEstimatorWorker(/*task_queue_factory=*/nullptr,
+                                 std::move(estimator_factory),
+                                 /*model_version=*/"",
+                                 std::move(fallback_estimator),
+                                 initial_estimate_bps,
+                                 estimate_interval_ms,
+                                 std::move(estimate_callback)) {}
+
+ReceiveSideEstimatorWorker::ReceiveSideEstimatorWorker(
+    TaskQueueFactory* task_queue_factory,
+    EstimatorFactory estimator_factory,
+    std::string model_version,
+    std::unique_ptr<ReceiveSideBandwidthEstimator> fallback_estimator,
+    float initial_estimate_bps,
+    int64_t estimate_interval_ms,
+    EstimateCallback estimate_callback)
+    : default_task_queue_factory_(
+          task_queue_factory ? nullptr : CreateDefaultTaskQueueFactory()),
+      task_queue_factory_(task_queue_factory
+                              ? task_queue_factory
+                              : default_task_queue_factory_.get()),
+      estimate_interval_ms_(std::max<int64_t>(estimate_interval_ms, 1)),
+      estimate_callback_(std::move(estimate_callback)),
+      pending_packets_(kMaxPendingPackets),
+      pending_frame_stats_(kMaxPendingFrameStats),
+      latest_estimate_bps_(initial_estimate_bps),
+      model_version_(std::move(model_version)),
+      inference_time_us_(kInferenceTimeLongTailUs),
+      pending_packets_counter_(kMaxPendingPackets + 1),
+      fallback_estimator_(std::move(fallback_estimator)),
+      task_queue_(task_queue_factory_->CreateTaskQueue(
+          "ReceiveSideBwe",
+          TaskQueueFactory::Priority::NORMAL)),
+      load_task_queue_(task_queue_factory_->CreateTaskQueue(
+          "ReceiveSideBweLoad",
+          TaskQueueFactory::Priority::LOW)) {
+  task_queue_.PostTask([this] {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    batch_.reserve(kMaxPendingPackets);
+    frame_stats_batch_.reserve(kMaxPendingFrameStats);
+    StartEstimateTask();
+  });
+  // Creating the estimator may load a model, which must neither delay the
+  // caller nor the fallback estimator.
+  load_task_queue_.PostTask([this, estimator_factory =
+                                       std::move(estimator_factory)] {
+    std::unique_ptr<ReceiveSideBandwidthEstimator> estimator =
+        estimator_factory();
+    task_queue_.PostTask([this, estimator = std::move(estimator)]() mutable {
+      RTC_DCHECK_RUN_ON(&task_queue_);
+      estimator_ = std::move(estimator);
+    });
+  });
+}
+
+ReceiveSideEstimatorWorker::~ReceiveSideEstimatorWorker() {
+  rtc::Event done;
+  task_queue_.PostTask([this, &done] {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    estimate_task_.Stop();
+    estimator_.reset();
+    next_estimator_.reset();
+    fallback_estimator_.reset();
+    done.Set();
+  });
+  done.Wait(rtc::Event::kForever);
+  int64_t dropped = dropped_packets_.load(std::memory_order_relaxed);
+  if (dropped > 0) {
+    RTC_LOG(LS_WARNING) << "ReceiveSideEstimatorWorker dropped " << dropped
+                        << " packets because the estimator fell behind.";
+  }
+}
+
+void ReceiveSideEstimatorWorker::SetEstimateInterval(
+    int64_t estimate_interval_ms) {
+  task_queue_.PostTask([this, estimate_interval_ms] {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    int64_t interval_ms = std::max<int64_t>(estimate_interval_ms, 1);
+    if (interval_ms == estimate_interval_ms_)
+      return;
+    estimate_interval_ms_ = interval_ms;
+    estimate_task_.Stop();
+    StartEstimateTask();
+  });
+}
+
+void ReceiveSideEstimatorWorker::StartEstimateTask() {
+  estimate_task_ = RepeatingTaskHandle::DelayedStart(
+      task_queue_.Get(), TimeDelta::Millis(estimate_interval_ms_), [this] {
+        RTC_DCHECK_RUN_ON(&task_queue_);
+        UpdateEstimate();
+        if (estimate_callback_)
+          estimate_callback_(LatestEstimateBps());
+        return TimeDelta::Millis(estimate_interval_ms_);
+      });
+}
+
+void ReceiveSideEstimatorWorker::ReplaceEstimator(
+    EstimatorFactory estimator_factory,
+    std::string model_version) {
+  load_task_queue_.PostTask([this,
+                             estimator_factory = std::move(estimator_factory),
+                             model_version = std::move(model_version)] {
+    std::unique_ptr<ReceiveSideBandwidthEstimator> estimator =
+        estimator_factory();
+    task_queue_.PostTask([this, estimator = std::move(estimator),
+                          model_version]() mutable {
+      RTC_DCHECK_RUN_ON(&task_queue_);
+      // A replacement still warming up is superseded.
+      next_estimator_ = std::move(estimator);
+      next_model_version_ = model_version;
+    });
+  });
+}
+
+bool ReceiveSideEstimatorWorker::OnPacket(const ReceivedPacketInfo& packet) {
+  insert_packet_ = packet;
+  if (!pending_packets_.Insert(&insert_packet_)) {
+    dropped_packets_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  // The estimate task drains the packets of its interval in one batch, which
+  // amortizes the cost of a call into the estimator over all of them.
+  if (pending_packet_count_.fetch_add(1, std::memory_order_relaxed) + 1 >=
+      kEarlyDrainPackets) {
+    PostDrain();
+  }
+  return true;
+}
+
+bool ReceiveSideEstimatorWorker::OnFrameStats(
+    const ReceivedFrameStats& frame_stats) {
+  insert_frame_stats_ = frame_stats;
+  if (!pending_frame_stats_.Insert(&insert_frame_stats_))
+    return false;
+  PostDrain();
+  return true;
+}
+
+void ReceiveSideEstimatorWorker::PostDrain() {
+  if (!drain_posted_.exchange(true, std::memory_order_acq_rel)) {
+    task_queue_.PostTask([this] {
+      RTC_DCHECK_RUN_ON(&task_queue_);
+      Drain();
+    });
+  }
+}
+
+float ReceiveSideEstimatorWorker::LatestEstimateBps() const {
+  return latest_estimate_bps_.load(std::memory_order_acquire);
+}
+
+int64_t ReceiveSideEstimatorWorker::DroppedPackets() const {
+  return dropped_packets_.load(std::memory_order_relaxed);
+}
+
+ReceiveSideEstimatorWorker::Stats ReceiveSideEstimatorWorker::GetStats() const {
+  Stats stats;
+  stats.dropped_packets = DroppedPackets();
+  stats.latest_estimate_bps = LatestEstimateBps();
+  rtc::CritScope cs(&stats_lock_);
+  stats.estimates = estimates_;
+  stats.estimator_ready = estimator_ready_;
+  stats.model_version = model_version_;
+  stats.inference_time_p50_us = inference_time_us_.GetPercentile(0.5f);
+  stats.inference_time_p99_us = inference_time_us_.GetPercentile(0.99f);
+  stats.pending_packets_p50 = pending_packets_counter_.GetPercentile(0.5f);
+  stats.pending_packets_p99 = pending_packets_counter_.GetPercentile(0.99f);
+  return stats;
+}
+
+void ReceiveSideEstimatorWorker::Drain() {
+  // Clear the flag before draining so that anything inserted while we drain
+  // posts a new task instead of being left behind in the queues.
+  drain_posted_.store(false, std::memory_order_release);
+  // Taken before the packets, so that the packets queued before the frame
+  // statistics are fed first.
+  frame_stats_batch_.clear();
+  ReceivedFrameStats frame_stats;
+  while (pending_frame_stats_.Remove(&frame_stats))
+    frame_stats_batch_.push_back(frame_stats);
+  DrainPendingPackets();
+  for (const ReceivedFrameStats& pending_frame_stats : frame_stats_batch_) {
+    if (estimator_)
+      estimator_->OnFrameStats(pending_frame_stats);
+    if (next_estimator_)
+      next_estimator_->OnFrameStats(pending_frame_stats);
+    if (fallback_estimator_)
+      fallback_estimator_->OnFrameStats(pending_frame_stats);
+  }
+}
+
+void ReceiveSideEstimatorWorker::DrainPendingPackets() {
+  batch_.clear();
+  ReceivedPacketInfo packet;
+  while (pending_packets_.Remove(&packet))
+    batch_.push_back(packet);
+  if (batch_.empty())
+    return;
+  pending_packet_count_.fetch_sub(batch_.size(), std::memory_order_relaxed);
+  TRACE_EVENT1("webrtc", "ReceiveSideEstimatorWorker::DrainPendingPackets",
+               "packets", batch_.size());
+  RTC_HISTOGRAM_COUNTS_10000("WebRTC.Bwe.AlphaCc.PendingPackets",
+                             static_cast<int>(batch_.size()));
+  {
+    rtc::CritScope cs(&stats_lock_);
+    pending_packets_counter_.Add(batch_.size());
+  }
+  if (estimator_ || next_estimator_) {
+    int64_t start_us = rtc::TimeMicros();
+    if (estimator_)
+      estimator_->OnPacketBatch(batch_);
+    if (next_estimator_)
+      next_estimator_->OnPacketBatch(batch_);
+    pending_inference_time_us_ += rtc::TimeMicros() - start_us;
+  }
+  if (fallback_estimator_)
+    fallback_estimator_->OnPacketBatch(batch_);
+}
+
+void ReceiveSideEstimatorWorker::UpdateEstimate() {
+  TRACE_EVENT0("webrtc", "ReceiveSideEstimatorWorker::UpdateEstimate");
+  // Feed everything that arrived since the last drain so the estimate reflects
+  // the most recent packets, usually all the packets of the interval.
+  Drain();
+  if (next_estimator_ && next_estimator_->IsReady()) {
+    RTC_LOG(LS_INFO) << "Receive side estimator replaced by model version "
+                     << next_model_version_;
+    estimator_ = std::move(next_estimator_);
+    rtc::CritScope cs(&stats_lock_);
+    model_version_ = std::move(next_model_version_);
+    next_model_version_.clear();
+  }
+  if (estimator_ && estimator_->IsReady()) {
+    if (fallback_estimator_) {
+      RTC_LOG(LS_INFO) << "Receive side estimator ready, dropping fallback.";
+      fallback_estimator_.reset();
+    }
+    int64_t start_us = rtc::TimeMicros();
+    latest_estimate_bps_.store(estimator_->GetEstimate(),
+                               std::memory_order_release);
+    uint32_t inference_time_us = rtc::saturated_cast<uint32_t>(
+        pending_inference_time_us_ + rtc::TimeMicros() - start_us);
+    pending_inference_time_us_ = 0;
+    RTC_HISTOGRAM_COUNTS_100000("WebRTC.Bwe.AlphaCc.InferenceTimeUs",
+                                inference_time_us);
+    rtc::CritScope cs(&stats_lock_);
+    ++estimates_;
+    estimator_ready_ = true;
+    inference_time_us_.Add(inference_time_us);
+    return;
+  }
+  // Warm-up is not representative of the inference time.
+  pending_inference_time_us_ = 0;
+  if (fallback_estimator_ && fallback_estimator_->IsReady()) {
+    latest_estimate_bps_.store(fallback_estimator_->GetEstimate(),
+                               std::memory_order_release);
+    rtc::CritScope cs(&stats_lock_);
+    ++estimates_;
+  }
+}
+
+}  // namespace webrtc
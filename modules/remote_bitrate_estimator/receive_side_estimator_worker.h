@@ -0,0 +1,206 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_ESTIMATOR_WORKER_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_ESTIMATOR_WORKER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
+#include "rtc_base/swap_queue.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs a ReceiveSideBandwidthEstimator on a dedicated task queue so that the
+// RTP receive path never blocks on the estimator, e.g. on ONNXRuntime.
+// Packets, and the frame statistics, are handed over through bounded
+// single-producer/single-consumer queues and submitted to the estimator in
+// batches, one per estimate interval unless the frame statistics or a filling
+// queue drain it earlier. The most recent estimate is published through an
+// atomic.
+class ReceiveSideEstimatorWorker {
+ public:
+  using EstimatorFactory =
+      std::function<std::unique_ptr<ReceiveSideBandwidthEstimator>()>;
+  // Called on the worker's task queue with the latest estimate every
+  // |estimate_interval_ms|, whether or not packets arrived in between.
+  using EstimateCallback = std::function<void(float estimate_bps)>;
+
+  struct Stats {
+    // Estimates produced so far, including those of the fallback estimator.
+    int64_t estimates = 0;
+    int64_t dropped_packets = 0;
+    // See LatestEstimateBps().
+    float latest_estimate_bps = 0;
+    // Set once the estimates come from the estimator instead of the fallback
+    // estimator or the initial estimate.
+    bool estimator_ready = false;
+    // Version of the model producing the estimates, see ReplaceEstimator().
+    std::string model_version;
+    // Time spent in the estimator per estimate, including the packets fed
+    // since the previous estimate. Unset until the estimator is ready.
+    absl::optional<uint32_t> inference_time_p50_us;
+    absl::optional<uint32_t> inference_time_p99_us;
+    // Packets waiting in the queue whenever the estimator drained it.
+    absl::optional<uint32_t> pending_packets_p50;
+    absl::optional<uint32_t> pending_packets_p99;
+  };
+
+  // Maximum number of packets waiting for the estimator. Packets arriving
+  // while the queue is full are dropped and counted.
+  static constexpr size_t kMaxPendingPackets = 4096;
+  // Packets are drained before the next estimate once that many are waiting,
+  // so that bursts do not fill the queue.
+  static constexpr size_t kEarlyDrainPackets = kMaxPendingPackets / 2;
+  // Frame statistics are sampled at a low rate, a few slots absorb a late
+  // drain.
+  static constexpr size_t kMaxPendingFrameStats = 4;
+
+  // |estimator_factory| is called on a background task queue, so estimators
+  // that are slow to create, e.g. because they load a model, neither block the
+  // caller nor the packet processing. Until the created estimator IsReady(),
+  // estimates come from |fallback_estimator| if not null and ready, or are
+  // |initial_estimate_bps|. |estimate_callback| may be null.
+  ReceiveSideEstimatorWorker(
+      EstimatorFactory estimator_factory,
+      std::unique_ptr<ReceiveSideBandwidthEstimator> fallback_estimator,
+      float initial_estimate_bps,
+      int64_t estimate_interval_ms,
+      EstimateCallback estimate_callback);
+  // Creates the task queues with |task_queue_factory| instead of the default
+  // one, e.g. to run in simulated time. Null means the default factory.
+  // |model_version| is the version of the model run by the estimator
+  // |estimator_factory| creates, if known.
+  ReceiveSideEstimatorWorker(
+      TaskQueueFactory* task_queue_factory,
+      EstimatorFactory estimator_factory,
+      std::string model_version,
+      std::unique_ptr<ReceiveSideBandwidthEstimator> fallback_estimator,
+      float initial_estimate_bps,
+      int64_t estimate_interval_ms,
+      EstimateCallback estimate_callback);
+  ~ReceiveSideEstimatorWorker();
+
+  ReceiveSideEstimatorWorker(const ReceiveSideEstimatorWorker&) = delete;
+  ReceiveSideEstimatorWorker& operator=(const ReceiveSideEstimatorWorker&) =
+      delete;
+
+  // Creates a new estimator with |estimator_factory| in the background, which
+  // gets the packets from then on and replaces the current estimator at the
+  // first estimate it is ready for, e.g. to switch to another version of the
+  // model without interrupting the estimates. May be called from any thread.
+  void ReplaceEstimator(EstimatorFactory estimator_factory,
+                        std::string model_version);
+
+  // Produces the estimates every |estimate_interval_ms| from now on instead
+  // of the interval given at construction. May be called from any thread.
+  void SetEstimateInterval(int64_t estimate_interval_ms);
+
+  // Must always be called from the same thread. Never blocks; returns false if
+  // the packet was dropped because the queue is full. The packet is fed to the
+  // estimators at the next estimate at the latest.
+  bool OnPacket(const ReceivedPacketInfo& packet);
+
+  // Hands |frame_stats| to the estimators, after the packets queued so far.
+  // Must always be called from the same thread, which may differ from the one
+  // calling OnPacket(). Never blocks; returns false if |frame_stats| was
+  // dropped because the queue is full.
+  bool OnFrameStats(const ReceivedFrameStats& frame_stats);
+
+  // Latest estimate in bps. May be called from any thread.
+  float LatestEstimateBps() const;
+
+  // Number of packets dropped so far because the queue was full.
+  int64_t DroppedPackets() const;
+
+  // May be called from any thread.
+  Stats GetStats() const;
+
+ private:
+  void PostDrain();
+  // Feeds the queued packets and frame statistics to the estimators.
+  void Drain() RTC_RUN_ON(task_queue_);
+  void DrainPendingPackets() RTC_RUN_ON(task_queue_);
+  void UpdateEstimate() RTC_RUN_ON(task_queue_);
+  void StartEstimateTask() RTC_RUN_ON(task_queue_);
+
+  // Null if a task queue factory was given.
+  const std::unique_ptr<TaskQueueFactory> default_task_queue_factory_;
+  TaskQueueFactory* const task_queue_factory_;
+  int64_t estimate_interval_ms_ RTC_GUARDED_BY(task_queue_);
+  const EstimateCallback estimate_callback_;
+
+  SwapQueue<ReceivedPacketInfo> pending_packets_;
+  // Producer side scratch slot, only accessed by the thread calling OnPacket.
+  ReceivedPacketInfo insert_packet_;
+  SwapQueue<ReceivedFrameStats> pending_frame_stats_;
+  // Producer side scratch slot, only accessed by the thread calling
+  // OnFrameStats.
+  ReceivedFrameStats insert_frame_stats_;
+  // Set while a drain task is posted but has not started yet, so at most one
+  // drain task is in flight regardless of the packet rate.
+  std::atomic<bool> drain_posted_{false};
+  // Packets inserted but not drained yet, see kEarlyDrainPackets.
+  std::atomic<size_t> pending_packet_count_{0};
+  std::atomic<float> latest_estimate_bps_;
+  std::atomic<int64_t> dropped_packets_{0};
+
+  // Time spent in |estimator_| since the last estimate.
+  int64_t pending_inference_time_us_ RTC_GUARDED_BY(task_queue_) = 0;
+  rtc::CriticalSection stats_lock_;
+  int64_t estimates_ RTC_GUARDED_BY(stats_lock_) = 0;
+  bool estimator_ready_ RTC_GUARDED_BY(stats_lock_) = false;
+  std::string model_version_ RTC_GUARDED_BY(stats_lock_);
+  // GetPercentile() is not const.
+  mutable rtc::HistogramPercentileCounter inference_time_us_
+      RTC_GUARDED_BY(stats_lock_);
+  mutable rtc::HistogramPercentileCounter pending_packets_counter_
+      RTC_GUARDED_BY(stats_lock_);
+
+  // Reused between drains so that batching does not allocate per packet.
+  std::vector<ReceivedPacketInfo> batch_ RTC_GUARDED_BY(task_queue_);
+  std::vector<ReceivedFrameStats> frame_stats_batch_
+      RTC_GUARDED_BY(task_queue_);
+  // Null until created on |load_task_queue_|.
+  std::unique_ptr<ReceiveSideBandwidthEstimator> estimator_
+      RTC_GUARDED_BY(task_queue_);
+  // Replaces |estimator_| once ready, see ReplaceEstimator().
+  std::unique_ptr<ReceiveSideBandwidthEstimator> next_estimator_
+      RTC_GUARDED_BY(task_queue_);
+  std::string next_model_version_ RTC_GUARDED_BY(task_queue_);
+  // Used during warm-up, released once |estimator_| is ready.
+  std::unique_ptr<ReceiveSideBandwidthEstimator> fallback_estimator_
+      RTC_GUARDED_BY(task_queue_);
+  RepeatingTaskHandle estimate_task_ RTC_GUARDED_BY(task_queue_);
+
+  // Declared last so that they are destroyed first, before the members that
+  // pending tasks might still access. |load_task_queue_| posts to
+  // |task_queue_| and therefore goes first.
+  rtc::TaskQueue task_queue_;
+  rtc::TaskQueue load_task_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_ESTIMATOR_WORKER_H_
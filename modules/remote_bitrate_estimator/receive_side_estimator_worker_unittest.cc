@@ -0,0 +1,392 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_side_estimator_worker.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kTimeoutMs = 5000;
+// Long enough for no estimate to be made during a test.
+constexpr int64_t kEstimateIntervalMs = 60 * 1000;
+constexpr float kInitialEstimateBps = 300000;
+
+// Written on the worker's task queue, read once |frame_stats_received| is set.
+struct FakeEstimatorInputs {
+  int packets = 0;
+  // Sizes of the batches of packets fed.
+  std::vector<size_t> packet_batches;
+  rtc::Event packets_received;
+  // Packets fed before each of the frame statistics.
+  std::vector<int> packets_before_frame_stats;
+  std::vector<uint32_t> frames_decoded;
+  rtc::Event frame_stats_received;
+};
+
+// Estimates |estimate_bps| once it was fed |ready_after_packets| packets.
+class FakeEstimator : public ReceiveSideBandwidthEstimator {
+ public:
+  explicit FakeEstimator(FakeEstimatorInputs* inputs,
+                         float estimate_bps = 0,
+                         int ready_after_packets = 0)
+      : inputs_(inputs),
+        estimate_bps_(estimate_bps),
+        ready_after_packets_(ready_after_packets) {}
+
+  void OnPacket(const ReceivedPacketInfo& packet) override {
+    ++inputs_->packets;
+  }
+  void OnPacketBatch(
+      rtc::ArrayView<const ReceivedPacketInfo> packets) override {
+    inputs_->packets += packets.size();
+    inputs_->packet_batches.push_back(packets.size());
+    inputs_->packets_received.Set();
+  }
+  void OnFrameStats(const ReceivedFrameStats& frame_stats) override {
+    inputs_->packets_before_frame_stats.push_back(inputs_->packets);
+    inputs_->frames_decoded.push_back(frame_stats.frames_decoded);
+    inputs_->frame_stats_received.Set();
+  }
+  float GetEstimate() override { return estimate_bps_; }
+  bool IsReady() const override {
+    return inputs_->packets >= ready_after_packets_;
+  }
+
+ private:
+  FakeEstimatorInputs* const inputs_;
+  const float estimate_bps_;
+  const int ready_after_packets_;
+};
+
+// Only implements the interface every estimator has to.
+class SinglePacketEstimator : public ReceiveSideBandwidthEstimator {
+ public:
+  explicit SinglePacketEstimator(int* packets) : packets_(packets) {}
+
+  void OnPacket(const ReceivedPacketInfo& packet) override { ++*packets_; }
+  float GetEstimate() override { return *packets_; }
+  bool IsReady() const override { return true; }
+
+ private:
+  int* const packets_;
+};
+
+TEST(ReceiveSideEstimatorWorkerTest, FeedsFrameStatsAfterTheQueuedPackets) {
+  FakeEstimatorInputs inputs;
+  // Without an estimator the fallback estimator gets all the inputs.
+  ReceiveSideEstimatorWorker worker(
+      [] { return nullptr; }, std::make_unique<FakeEstimator>(&inputs),
+      /*initial_estimate_bps=*/300000, kEstimateIntervalMs,
+      /*estimate_callback=*/nullptr);
+
+  for (int i = 0; i < 3; ++i)
+    EXPECT_TRUE(worker.OnPacket(ReceivedPacketInfo()));
+  ReceivedFrameStats frame_stats;
+  frame_stats.frames_decoded = 25;
+  EXPECT_TRUE(worker.OnFrameStats(frame_stats));
+  ASSERT_TRUE(inputs.frame_stats_received.Wait(kTimeoutMs));
+
+  EXPECT_EQ(inputs.packets_before_frame_stats, std::vector<int>({3}));
+  EXPECT_EQ(inputs.frames_decoded, std::vector<uint32_t>({25}));
+}
+
+TEST(ReceiveSideEstimatorWorkerTest, FeedsFrameStatsWithoutPackets) {
+  FakeEstimatorInputs inputs;
+  ReceiveSideEstimatorWorker worker(
+      [] { return nullptr; }, std::make_unique<FakeEstimator>(&inputs),
+      /*initial_estimate_bps=*/300000, kEstimateIntervalMs,
+      /*estimate_callback=*/nullptr);
+
+  ReceivedFrameStats frame_stats;
+  frame_stats.frames_decoded = 10;
+  EXPECT_TRUE(worker.OnFrameStats(frame_stats));
+  ASSERT_TRUE(inputs.frame_stats_received.Wait(kTimeoutMs));
+  EXPECT_EQ(inputs.packets_before_frame_stats, std::vector<int>({0}));
+
+  frame_stats.frames_decoded = 40;
+  EXPECT_TRUE(worker.OnFrameStats(frame_stats));
+  ASSERT_TRUE(inputs.frame_stats_received.Wait(kTimeoutMs));
+  EXPECT_EQ(inputs.frames_decoded, std::vector<uint32_t>({10, 40}));
+}
+
+TEST(ReceiveSideEstimatorWorkerTest, FeedsThePacketsOfAnIntervalInOneBatch) {
+  FakeEstimatorInputs inputs;
+  rtc::Event estimated;
+  ReceiveSideEstimatorWorker worker(
+      [] { return nullptr; }, std::make_unique<FakeEstimator>(&inputs),
+      /*initial_estimate_bps=*/300000, kEstimateIntervalMs,
+      [&estimated](float estimate_bps) { estimated.Set(); });
+
+  for (int i = 0; i < 10; ++i)
+    EXPECT_TRUE(worker.OnPacket(ReceivedPacketInfo()));
+  // Nothing is fed before the next estimate.
+  EXPECT_FALSE(inputs.packets_received.Wait(/*give_up_after_ms=*/20));
+  worker.SetEstimateInterval(/*estimate_interval_ms=*/5);
+  ASSERT_TRUE(estimated.Wait(kTimeoutMs));
+
+  EXPECT_EQ(inputs.packet_batches, std::vector<size_t>({10}));
+}
+
+TEST(ReceiveSideEstimatorWorkerTest, FeedsPilingUpPacketsBeforeTheEstimate) {
+  FakeEstimatorInputs inputs;
+  ReceiveSideEstimatorWorker worker(
+      [] { return nullptr; }, std::make_unique<FakeEstimator>(&inputs),
+      /*initial_estimate_bps=*/300000, kEstimateIntervalMs,
+      /*estimate_callback=*/nullptr);
+
+  for (size_t i = 0; i < ReceiveSideEstimatorWorker::kEarlyDrainPackets; ++i)
+    EXPECT_TRUE(worker.OnPacket(ReceivedPacketInfo()));
+  ASSERT_TRUE(inputs.packets_received.Wait(kTimeoutMs));
+
+  EXPECT_EQ(inputs.packet_batches,
+            std::vector<size_t>(
+                {ReceiveSideEstimatorWorker::kEarlyDrainPackets}));
+  EXPECT_EQ(worker.DroppedPackets(), 0);
+}
+
+TEST(ReceiveSideEstimatorWorkerTest, EstimatesAtTheNewInterval) {
+  rtc::Event estimated;
+  ReceiveSideEstimatorWorker worker(
+      [] { return nullptr; }, /*fallback_estimator=*/nullptr,
+      /*initial_estimate_bps=*/300000, kEstimateIntervalMs,
+      [&estimated](float estimate_bps) {
+        EXPECT_EQ(estimate_bps, 300000);
+        estimated.Set();
+      });
+  EXPECT_FALSE(estimated.Wait(/*give_up_after_ms=*/20));
+
+  worker.SetEstimateInterval(/*estimate_interval_ms=*/5);
+  EXPECT_TRUE(estimated.Wait(kTimeoutMs));
+}
+
+struct OnPacketsArgs {
+  ReceiveSideEstimatorWorker* worker;
+  int packets = 0;
+  int accepted_packets = 0;
+};
+
+void OnPackets(void* obj) {
+  OnPacketsArgs* args = static_cast<OnPacketsArgs*>(obj);
+  for (int i = 0; i < args->packets; ++i) {
+    if (args->worker->OnPacket(ReceivedPacketInfo()))
+      ++args->accepted_packets;
+  }
+}
+
+TEST(ReceiveSideEstimatorWorkerTest, FeedsThePacketsOfAnotherThread) {
+  FakeEstimatorInputs inputs;
+  OnPacketsArgs args;
+  args.packets = 100000;
+  int64_t dropped_packets;
+  {
+    rtc::Event estimated;
+    ReceiveSideEstimatorWorker worker(
+        [] { return nullptr; }, std::make_unique<FakeEstimator>(&inputs),
+        kInitialEstimateBps, /*estimate_interval_ms=*/1,
+        [&estimated](float estimate_bps) { estimated.Set(); });
+    args.worker = &worker;
+    rtc::PlatformThread thread(&OnPackets, &args, "OnPackets");
+    thread.Start();
+    // Estimates keep coming while the packets are handed over.
+    EXPECT_TRUE(estimated.Wait(kTimeoutMs));
+    thread.Stop();
+    // The second estimate starts after the last packet was queued.
+    estimated.Reset();
+    ASSERT_TRUE(estimated.Wait(kTimeoutMs));
+    ASSERT_TRUE(estimated.Wait(kTimeoutMs));
+    dropped_packets = worker.DroppedPackets();
+  }
+
+  EXPECT_EQ(inputs.packets, args.accepted_packets);
+  EXPECT_EQ(args.accepted_packets + dropped_packets, args.packets);
+}
+
+TEST(ReceiveSideEstimatorWorkerTest, DoesNotWaitForTheEstimatorToLoad) {
+  FakeEstimatorInputs inputs;
+  rtc::Event load_started;
+  rtc::Event load_done;
+  rtc::Event estimated;
+  ReceiveSideEstimatorWorker worker(
+      [&] {
+        load_started.Set();
+        load_done.Wait(rtc::Event::kForever);
+        return std::make_unique<FakeEstimator>(&inputs,
+                                               /*estimate_bps=*/500000);
+      },
+      /*fallback_estimator=*/nullptr, kInitialEstimateBps,
+      /*estimate_interval_ms=*/1, [&estimated](float estimate_bps) {
+        if (estimate_bps == 500000)
+          estimated.Set();
+      });
+  ASSERT_TRUE(load_started.Wait(kTimeoutMs));
+
+  // Packets are taken and estimates made while the model loads.
+  EXPECT_TRUE(worker.OnPacket(ReceivedPacketInfo()));
+  EXPECT_FALSE(estimated.Wait(/*give_up_after_ms=*/20));
+  EXPECT_EQ(worker.LatestEstimateBps(), kInitialEstimateBps);
+
+  load_done.Set();
+  EXPECT_TRUE(estimated.Wait(kTimeoutMs));
+}
+
+// Runs the task queues of the worker in simulated time, nothing runs before
+// AdvanceTime().
+class SimulatedReceiveSideEstimatorWorkerTest : public ::testing::Test {
+ protected:
+  static constexpr int64_t kIntervalMs = 100;
+
+  SimulatedReceiveSideEstimatorWorkerTest()
+      : time_controller_(Timestamp::Seconds(1000)) {}
+
+  std::unique_ptr<ReceiveSideEstimatorWorker> CreateWorker(
+      ReceiveSideEstimatorWorker::EstimatorFactory estimator_factory,
+      std::unique_ptr<ReceiveSideBandwidthEstimator> fallback_estimator =
+          nullptr) {
+    return std::make_unique<ReceiveSideEstimatorWorker>(
+        time_controller_.GetTaskQueueFactory(), std::move(estimator_factory),
+        /*model_version=*/"", std::move(fallback_estimator),
+        kInitialEstimateBps, kIntervalMs, [this](float estimate_bps) {
+          estimates_.push_back(estimate_bps);
+        });
+  }
+
+  void AdvanceIntervals(int intervals) {
+    time_controller_.AdvanceTime(TimeDelta::Millis(kIntervalMs * intervals));
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  // Written on the task queue of the worker, which runs in AdvanceTime().
+  std::vector<float> estimates_;
+};
+
+TEST_F(SimulatedReceiveSideEstimatorWorkerTest,
+       DropsPacketsWhenTheQueueIsFull) {
+  auto worker = CreateWorker([] { return nullptr; });
+  for (size_t i = 0; i < ReceiveSideEstimatorWorker::kMaxPendingPackets; ++i)
+    ASSERT_TRUE(worker->OnPacket(ReceivedPacketInfo()));
+  EXPECT_FALSE(worker->OnPacket(ReceivedPacketInfo()));
+  EXPECT_EQ(worker->DroppedPackets(), 1);
+
+  // The drain posted once the packets piled up makes room again.
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  EXPECT_TRUE(worker->OnPacket(ReceivedPacketInfo()));
+  EXPECT_EQ(worker->GetStats().dropped_packets, 1);
+}
+
+TEST_F(SimulatedReceiveSideEstimatorWorkerTest,
+       PublishesTheEstimateEachInterval) {
+  FakeEstimatorInputs inputs;
+  auto worker = CreateWorker([&inputs] {
+    return std::make_unique<FakeEstimator>(&inputs, /*estimate_bps=*/500000);
+  });
+  EXPECT_EQ(worker->LatestEstimateBps(), kInitialEstimateBps);
+
+  AdvanceIntervals(1);
+  EXPECT_EQ(worker->LatestEstimateBps(), 500000);
+  AdvanceIntervals(2);
+  EXPECT_EQ(estimates_, std::vector<float>({500000, 500000, 500000}));
+  EXPECT_EQ(worker->GetStats().estimates, 3);
+}
+
+TEST_F(SimulatedReceiveSideEstimatorWorkerTest,
+       FeedsTheEstimatorUntilItIsReady) {
+  FakeEstimatorInputs inputs;
+  auto worker = CreateWorker([&inputs] {
+    return std::make_unique<FakeEstimator>(&inputs, /*estimate_bps=*/500000,
+                                           /*ready_after_packets=*/3);
+  });
+  // Lets the estimator load.
+  AdvanceIntervals(1);
+  worker->OnPacket(ReceivedPacketInfo());
+  worker->OnPacket(ReceivedPacketInfo());
+  AdvanceIntervals(1);
+  EXPECT_EQ(inputs.packets, 2);
+  EXPECT_EQ(worker->LatestEstimateBps(), kInitialEstimateBps);
+  EXPECT_FALSE(worker->GetStats().estimator_ready);
+
+  worker->OnPacket(ReceivedPacketInfo());
+  AdvanceIntervals(1);
+  EXPECT_EQ(worker->LatestEstimateBps(), 500000);
+  EXPECT_TRUE(worker->GetStats().estimator_ready);
+  // Only the estimates of a ready estimator are counted.
+  EXPECT_EQ(worker->GetStats().estimates, 1);
+}
+
+TEST_F(SimulatedReceiveSideEstimatorWorkerTest,
+       FeedsBatchesToEstimatorsOfSinglePackets) {
+  int packets = 0;
+  auto worker = CreateWorker(
+      [&packets] { return std::make_unique<SinglePacketEstimator>(&packets); });
+  for (int i = 0; i < 5; ++i)
+    worker->OnPacket(ReceivedPacketInfo());
+  AdvanceIntervals(1);
+  EXPECT_EQ(packets, 5);
+  EXPECT_EQ(worker->LatestEstimateBps(), 5);
+}
+
+TEST_F(SimulatedReceiveSideEstimatorWorkerTest,
+       UsesTheFallbackUntilTheEstimatorIsReady) {
+  FakeEstimatorInputs inputs;
+  FakeEstimatorInputs fallback_inputs;
+  auto worker = CreateWorker(
+      [&inputs] {
+        return std::make_unique<FakeEstimator>(&inputs, /*estimate_bps=*/500000,
+                                               /*ready_after_packets=*/2);
+      },
+      std::make_unique<FakeEstimator>(&fallback_inputs,
+                                      /*estimate_bps=*/200000));
+  worker->OnPacket(ReceivedPacketInfo());
+  AdvanceIntervals(1);
+  EXPECT_EQ(worker->LatestEstimateBps(), 200000);
+  EXPECT_FALSE(worker->GetStats().estimator_ready);
+
+  worker->OnPacket(ReceivedPacketInfo());
+  AdvanceIntervals(1);
+  EXPECT_EQ(worker->LatestEstimateBps(), 500000);
+  EXPECT_TRUE(worker->GetStats().estimator_ready);
+
+  // The fallback estimator is released once the estimator is ready.
+  worker->OnPacket(ReceivedPacketInfo());
+  AdvanceIntervals(1);
+  EXPECT_EQ(fallback_inputs.packets, 2);
+  EXPECT_EQ(inputs.packets, 3);
+  EXPECT_EQ(estimates_, std::vector<float>({200000, 500000, 500000}));
+}
+
+TEST_F(SimulatedReceiveSideEstimatorWorkerTest,
+       KeepsTheInitialEstimateUntilTheFallbackIsReady) {
+  FakeEstimatorInputs fallback_inputs;
+  auto worker = CreateWorker(
+      [] { return nullptr; },
+      std::make_unique<FakeEstimator>(&fallback_inputs,
+                                      /*estimate_bps=*/200000,
+                                      /*ready_after_packets=*/1));
+  AdvanceIntervals(1);
+  EXPECT_EQ(worker->LatestEstimateBps(), kInitialEstimateBps);
+  EXPECT_EQ(worker->GetStats().estimates, 0);
+
+  worker->OnPacket(ReceivedPacketInfo());
+  AdvanceIntervals(1);
+  EXPECT_EQ(worker->LatestEstimateBps(), 200000);
+  EXPECT_EQ(worker->GetStats().estimates, 1);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_side_feature_provider.h"
+
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+
+ReceiveSideFeatureProvider::ReceiveSideFeatureProvider() = default;
+ReceiveSideFeatureProvider::~ReceiveSideFeatureProvider() = default;
+
+void ReceiveSideFeatureProvider::OnRttUpdate(int64_t avg_rtt_ms) {
+  rtt_ms_.store(avg_rtt_ms, std::memory_order_relaxed);
+}
+
+void ReceiveSideFeatureProvider::OnPacket(uint16_t transport_sequence_number,
+                                          ReceivedPacketInfo* packet) {
+  int64_t seq = unwrapper_.Unwrap(transport_sequence_number);
+  int64_t loss_count = 0;
+  if (!newest_sequence_number_) {
+    newest_sequence_number_ = seq;
+  } else if (seq > *newest_sequence_number_) {
+    loss_count = seq - *newest_sequence_number_ - 1;
+    newest_sequence_number_ = seq;
+  }
+  packet->loss_count = rtc::saturated_cast<int32_t>(loss_count);
+  packet->rtt_ms = rtt_ms_.load(std::memory_order_relaxed);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_FEATURE_PROVIDER_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_FEATURE_PROVIDER_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "absl/types/optional.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+
+// Fills in the loss and RTT of ReceivedPacketInfo, which can't be derived from
+// a single packet. Loss is counted from gaps in the transport-wide sequence
+// numbers; the RTT is the latest one reported through OnRttUpdate().
+class ReceiveSideFeatureProvider {
+ public:
+  ReceiveSideFeatureProvider();
+  ~ReceiveSideFeatureProvider();
+
+  // May be called from any thread.
+  void OnRttUpdate(int64_t avg_rtt_ms);
+
+  // Must always be called from the same thread, for every received packet.
+  // Sets |packet->loss_count| to the number of packets skipped since the
+  // newest packet so far, which is 0 for reordered packets, and
+  // |packet->rtt_ms| to the latest RTT if any.
+  void OnPacket(uint16_t transport_sequence_number,
+                ReceivedPacketInfo* packet);
+
+ private:
+  std::atomic<int64_t> rtt_ms_{-1};
+  SeqNumUnwrapper<uint16_t> unwrapper_;
+  absl::optional<int64_t> newest_sequence_number_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_FEATURE_PROVIDER_H_
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_side_feature_provider.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+ReceivedPacketInfo OnPacket(ReceiveSideFeatureProvider* provider,
+                            uint16_t transport_sequence_number) {
+  ReceivedPacketInfo packet;
+  provider->OnPacket(transport_sequence_number, &packet);
+  return packet;
+}
+
+TEST(ReceiveSideFeatureProviderTest, RttUnknownUntilUpdated) {
+  ReceiveSideFeatureProvider provider;
+  EXPECT_EQ(OnPacket(&provider, 1).rtt_ms, -1);
+  provider.OnRttUpdate(80);
+  EXPECT_EQ(OnPacket(&provider, 2).rtt_ms, 80);
+}
+
+TEST(ReceiveSideFeatureProviderTest, CountsGapsAsLoss) {
+  ReceiveSideFeatureProvider provider;
+  EXPECT_EQ(OnPacket(&provider, 10).loss_count, 0);
+  EXPECT_EQ(OnPacket(&provider, 11).loss_count, 0);
+  EXPECT_EQ(OnPacket(&provider, 14).loss_count, 2);
+  // Reordered packet.
+  EXPECT_EQ(OnPacket(&provider, 12).loss_count, 0);
+  EXPECT_EQ(OnPacket(&provider, 15).loss_count, 0);
+}
+
+TEST(ReceiveSideFeatureProviderTest, CountsLossAcrossWrapAround) {
+  ReceiveSideFeatureProvider provider;
+  EXPECT_EQ(OnPacket(&provider, 0xfffe).loss_count, 0);
+  EXPECT_EQ(OnPacket(&provider, 1).loss_count, 2);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_stream_tracker.h"
+
+#include <algorithm>
+
+namespace webrtc {
+
+ReceiveStreamTracker::Stream::Stream(int64_t window_ms)
+    : rate(window_ms, RateStatistics::kBpsScale) {}
+
+ReceiveStreamTracker::ReceiveStreamTracker(int64_t window_ms)
+    : window_ms_(std::max<int64_t>(window_ms, 1)) {}
+
+ReceiveStreamTracker::~ReceiveStreamTracker() = default;
+
+void ReceiveStreamTracker::OnPacket(int64_t now_ms,
+                                    uint32_t ssrc,
+                                    bool is_audio,
+                                    size_t bytes) {
+  auto it = streams_.find(ssrc);
+  if (it == streams_.end())
+    it = streams_.emplace(ssrc, Stream(window_ms_)).first;
+  it->second.is_audio = is_audio;
+  it->second.last_packet_ms = now_ms;
+  it->second.rate.Update(bytes, now_ms);
+}
+
+std::vector<ReceiveStreamTracker::StreamStats> ReceiveStreamTracker::GetStreams(
+    int64_t now_ms) {
+  std::vector<StreamStats> result;
+  for (auto it = streams_.begin(); it != streams_.end();) {
+    if (now_ms - it->second.last_packet_ms >= window_ms_) {
+      it = streams_.erase(it);
+      continue;
+    }
+    StreamStats stats;
+    stats.ssrc = it->first;
+    stats.is_audio = it->second.is_audio;
+    stats.rate_bps = it->second.rate.Rate(now_ms).value_or(0);
+    result.push_back(stats);
+    ++it;
+  }
+  return result;
+}
+
+std::vector<BweMessage::StreamEstimate> ReceiveStreamTracker::SplitEstimate(
+    int64_t now_ms,
+    float target_bps) {
+  std::vector<StreamStats> streams = GetStreams(now_ms);
+  float audio_bps = 0;
+  float other_bps = 0;
+  size_t num_audio = 0;
+  for (const StreamStats& stream : streams) {
+    if (stream.is_audio) {
+      audio_bps += stream.rate_bps;
+      ++num_audio;
+    } else {
+      other_bps += stream.rate_bps;
+    }
+  }
+  size_t num_other = streams.size() - num_audio;
+  target_bps = std::max(target_bps, 0.0f);
+  // Audio keeps what it receives, and gets everything if it is alone.
+  float audio_target_bps =
+      num_other == 0 ? target_bps : std::min(audio_bps, target_bps);
+  float other_target_bps = target_bps - audio_target_bps;
+
+  // Shares |total_bps| in proportion to the received rates, or evenly if
+  // nothing was received.
+  auto share = [](float total_bps, float rate_bps, float sum_bps,
+                  size_t count) {
+    return sum_bps > 0 ? total_bps * rate_bps / sum_bps : total_bps / count;
+  };
+  std::vector<BweMessage::StreamEstimate> result;
+  result.reserve(streams.size());
+  for (const StreamStats& stream : streams) {
+    BweMessage::StreamEstimate estimate;
+    estimate.ssrc = stream.ssrc;
+    estimate.target_rate =
+        stream.is_audio
+            ? share(audio_target_bps, stream.rate_bps, audio_bps, num_audio)
+            : share(other_target_bps, stream.rate_bps, other_bps, num_other);
+    result.push_back(estimate);
+  }
+  return result;
+}
+
+}  // namespace webrtc
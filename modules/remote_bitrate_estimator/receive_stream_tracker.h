@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_STREAM_TRACKER_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_STREAM_TRACKER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "rtc_base/rate_statistics.h"
+
+namespace webrtc {
+
+// Keeps the received rate of every SSRC so that the receiver's estimate can be
+// split between the streams it covers. Audio is served first since it needs
+// little and suffers most from being starved, the rest goes to the other
+// streams in proportion to what they currently receive.
+class ReceiveStreamTracker {
+ public:
+  struct StreamStats {
+    uint32_t ssrc = 0;
+    bool is_audio = false;
+    float rate_bps = 0;
+  };
+
+  // Streams that received nothing for |window_ms| are forgotten.
+  explicit ReceiveStreamTracker(int64_t window_ms);
+  ~ReceiveStreamTracker();
+
+  void OnPacket(int64_t now_ms, uint32_t ssrc, bool is_audio, size_t bytes);
+
+  // Streams that received packets in the last |window_ms|, by SSRC.
+  std::vector<StreamStats> GetStreams(int64_t now_ms);
+
+  // Splits |target_bps| between the streams GetStreams() returns.
+  std::vector<BweMessage::StreamEstimate> SplitEstimate(int64_t now_ms,
+                                                        float target_bps);
+
+ private:
+  struct Stream {
+    explicit Stream(int64_t window_ms);
+    bool is_audio = false;
+    int64_t last_packet_ms = 0;
+    RateStatistics rate;
+  };
+
+  const int64_t window_ms_;
+  std::map<uint32_t, Stream> streams_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_STREAM_TRACKER_H_
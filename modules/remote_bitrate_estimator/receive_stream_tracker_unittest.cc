@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_stream_tracker.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kWindowMs = 1000;
+constexpr uint32_t kAudioSsrc = 1;
+constexpr uint32_t kVideoSsrc = 2;
+constexpr uint32_t kOtherVideoSsrc = 3;
+
+// Feeds |bytes_per_ms| into |ssrc| for every millisecond in [0, |end_ms|).
+void ReceiveAtRate(ReceiveStreamTracker* tracker,
+                   uint32_t ssrc,
+                   bool is_audio,
+                   size_t bytes_per_ms,
+                   int64_t end_ms) {
+  for (int64_t now_ms = 0; now_ms < end_ms; ++now_ms)
+    tracker->OnPacket(now_ms, ssrc, is_audio, bytes_per_ms);
+}
+
+TEST(ReceiveStreamTrackerTest, AudioKeepsItsRate) {
+  ReceiveStreamTracker tracker(kWindowMs);
+  // 40 kbps of audio and 800 kbps and 400 kbps of video.
+  ReceiveAtRate(&tracker, kAudioSsrc, true, 5, kWindowMs);
+  ReceiveAtRate(&tracker, kVideoSsrc, false, 100, kWindowMs);
+  ReceiveAtRate(&tracker, kOtherVideoSsrc, false, 50, kWindowMs);
+
+  std::vector<BweMessage::StreamEstimate> estimates =
+      tracker.SplitEstimate(kWindowMs - 1, 640000);
+  ASSERT_EQ(estimates.size(), 3u);
+  EXPECT_EQ(estimates[0].ssrc, kAudioSsrc);
+  EXPECT_NEAR(estimates[0].target_rate, 40000, 1);
+  EXPECT_EQ(estimates[1].ssrc, kVideoSsrc);
+  EXPECT_NEAR(estimates[1].target_rate, 400000, 1);
+  EXPECT_EQ(estimates[2].ssrc, kOtherVideoSsrc);
+  EXPECT_NEAR(estimates[2].target_rate, 200000, 1);
+}
+
+TEST(ReceiveStreamTrackerTest, AudioGetsEverythingWhenAlone) {
+  ReceiveStreamTracker tracker(kWindowMs);
+  ReceiveAtRate(&tracker, kAudioSsrc, true, 5, kWindowMs);
+
+  std::vector<BweMessage::StreamEstimate> estimates =
+      tracker.SplitEstimate(kWindowMs - 1, 300000);
+  ASSERT_EQ(estimates.size(), 1u);
+  EXPECT_NEAR(estimates[0].target_rate, 300000, 1);
+}
+
+TEST(ReceiveStreamTrackerTest, ScalesAudioDownBelowItsRate) {
+  ReceiveStreamTracker tracker(kWindowMs);
+  ReceiveAtRate(&tracker, kAudioSsrc, true, 5, kWindowMs);
+  ReceiveAtRate(&tracker, kVideoSsrc, false, 100, kWindowMs);
+
+  std::vector<BweMessage::StreamEstimate> estimates =
+      tracker.SplitEstimate(kWindowMs - 1, 20000);
+  ASSERT_EQ(estimates.size(), 2u);
+  EXPECT_NEAR(estimates[0].target_rate, 20000, 1);
+  EXPECT_NEAR(estimates[1].target_rate, 0, 1);
+}
+
+TEST(ReceiveStreamTrackerTest, ForgetsSilentStreams) {
+  ReceiveStreamTracker tracker(kWindowMs);
+  ReceiveAtRate(&tracker, kAudioSsrc, true, 5, kWindowMs);
+  tracker.OnPacket(2 * kWindowMs, kVideoSsrc, false, 100);
+
+  std::vector<ReceiveStreamTracker::StreamStats> streams =
+      tracker.GetStreams(2 * kWindowMs);
+  ASSERT_EQ(streams.size(), 1u);
+  EXPECT_EQ(streams[0].ssrc, kVideoSsrc);
+  EXPECT_FALSE(streams[0].is_audio);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -20,16 +20,66 @@
 #include <utility>
 
 #include "api/alphacc_config.h"
+#include "logging/rtc_event_log/events/rtc_event_alpha_cc_estimate.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/alpha_cc_bwe.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
+namespace {
+
+// Streams are split by what they received over this window.
+constexpr int64_t kStreamRateWindowMs = 1000;
+
+BweFeedbackScheduler::Config GetBweFeedbackSchedulerConfig(
+    const AlphaCCConfig& alpha_cc_config) {
+  BweFeedbackScheduler::Config config;
+  config.max_interval_ms = alpha_cc_config.bwe_feedback_duration_ms;
+  if (alpha_cc_config.bwe_feedback_change_percent > 0) {
+    config.min_interval_ms = alpha_cc_config.bwe_feedback_min_interval_ms;
+    config.change_threshold =
+        alpha_cc_config.bwe_feedback_change_percent / 100.0;
+  } else {
+    config.min_interval_ms = config.max_interval_ms;
+  }
+  return config;
+}
+
+// The sender only needs less transport feedback if it is sent estimates.
+AlphaCCConfig::BweTransportFeedbackOption GetTransportFeedbackOption(
+    const AlphaCCConfig& alpha_cc_config) {
+  if (alpha_cc_config.bwe_location != AlphaCCConfig::BweLocation::kReceiver)
+    return AlphaCCConfig::BweTransportFeedbackOption::kFull;
+  return alpha_cc_config.bwe_transport_feedback_option;
+}
+
+// Creates the configured estimator, running |model_version| if set.
+ReceiveSideEstimatorWorker::EstimatorFactory CreateEstimatorFactory(
+    const AlphaCCConfig& alpha_cc_config,
+    const absl::optional<BweModelManager::ModelVersion>& model_version) {
+  AlphaCCConfig config = alpha_cc_config;
+  if (model_version) {
+    switch (config.bwe_estimator_option) {
+      case AlphaCCConfig::BweEstimatorOption::kOnnx:
+        config.onnx_model_path = model_version->model_path;
+        break;
+      case AlphaCCConfig::BweEstimatorOption::kBweModel:
+        config.bwe_model_path = model_version->model_path;
+        break;
+      case AlphaCCConfig::BweEstimatorOption::kReceiveRate:
+        break;
+    }
+  }
+  return [config] { return CreateReceiveSideBandwidthEstimator(config); };
+}
 
-// Impossible to request feedback older than what can be represented by 15 bits.
-const int RemoteEstimatorProxy::kMaxNumberOfPackets = (1 << 15);
+}  // namespace
 
 // The maximum allowed value for a timestamp in milliseconds. This is lower
 // than the numerical limit since we often convert to microseconds.
@@ -41,24 +91,110 @@ RemoteEstimatorProxy::RemoteEstimatorProxy(
     TransportFeedbackSenderInterface* feedback_sender,
     const WebRtcKeyValueConfig* key_value_config,
     NetworkStateEstimator* network_state_estimator)
+    : RemoteEstimatorProxy(clock,
+                           feedback_sender,
+                           key_value_config,
+                           network_state_estimator,
+                           /*task_queue_factory=*/nullptr,
+                           /*event_log=*/nullptr,
+                           /*alpha_cc_config=*/nullptr) {}
+
+RemoteEstimatorProxy::RemoteEstimatorProxy(
+    Clock* clock,
+    TransportFeedbackSenderInterface* feedback_sender,
+    const WebRtcKeyValueConfig* key_value_config,
+    NetworkStateEstimator* network_state_estimator,
+    TaskQueueFactory* task_queue_factory,
+    RtcEventLog* event_log,
+    const AlphaCCConfig* alpha_cc_config)
     : clock_(clock),
       feedback_sender_(feedback_sender),
+      event_log_(event_log),
+      alpha_cc_config_(alpha_cc_config ? alpha_cc_config
+                                       : GetAlphaCCConfig()),
       send_config_(key_value_config),
+      transport_feedback_option_(GetTransportFeedbackOption(*alpha_cc_config_)),
       last_process_time_ms_(-1),
       network_state_estimator_(network_state_estimator),
       media_ssrc_(0),
       feedback_packet_count_(0),
-      send_interval_ms_(send_config_.default_interval->ms()),
+      send_interval_ms_(
+          transport_feedback_option_ ==
+                  AlphaCCConfig::BweTransportFeedbackOption::kFull
+              ? send_config_.default_interval->ms()
+              : alpha_cc_config_->bwe_transport_feedback_interval_ms),
       send_periodic_feedback_(true),
-      bwe_sendback_interval_ms_(GetAlphaCCConfig()->bwe_feedback_duration_ms),
-      last_bwe_sendback_ms_(clock->TimeInMilliseconds()),
-      stats_collect_(StatCollect::SC_TYPE_STRUCT),
-      cycles_(-1),
-      max_abs_send_time_(0) {
-  onnx_infer_ = onnxinfer::CreateONNXInferInterface(
-      GetAlphaCCConfig()->onnx_model_path.c_str());
-  if (!onnxinfer::IsReady(onnx_infer_)) {
-    RTC_LOG(LS_ERROR) << "Failed to create onnx_infer_.";
+      bwe_feedback_scheduler_(GetBweFeedbackSchedulerConfig(*alpha_cc_config_),
+                              clock->TimeInMilliseconds()),
+      bwe_piggyback_tolerance_ms_(
+          alpha_cc_config_->bwe_piggyback_tolerance_ms),
+      stats_recorder_(
+          alpha_cc_config_->save_log_to_file
+              ? std::make_unique<StatCollect::BinaryStatsRecorder>(
+                    alpha_cc_config_->stats_output_path)
+              : nullptr),
+      video_stats_recorder_(
+          alpha_cc_config_->save_log_to_file &&
+                  alpha_cc_config_->bwe_frame_stats_interval_ms > 0
+              ? std::make_unique<StatCollect::BinaryVideoStatsRecorder>(
+                    alpha_cc_config_->stats_output_path + ".video")
+              : nullptr),
+      stream_tracker_(alpha_cc_config_->bwe_per_stream_estimates
+                          ? std::make_unique<ReceiveStreamTracker>(
+                                kStreamRateWindowMs)
+                          : nullptr),
+      audio_feature_aggregator_(
+          alpha_cc_config_->bwe_audio_only
+              ? std::make_unique<AudioFeatureAggregator>(
+                    alpha_cc_config_->bwe_audio_feature_window_ms)
+              : nullptr),
+      model_session_id_(rtc::CreateRandomId()),
+      initial_model_version_(
+          BweModelManager::GetProcessWide()->GetModelVersion(
+              model_session_id_)),
+      packet_capture_(
+          RtpPacketCapture::Create(*alpha_cc_config_, model_session_id_)),
+      estimator_worker_(
+          alpha_cc_config_->bwe_location ==
+                  AlphaCCConfig::BweLocation::kSender
+              ? nullptr
+              : std::make_unique<ReceiveSideEstimatorWorker>(
+                    task_queue_factory,
+                    CreateEstimatorFactory(*alpha_cc_config_,
+                                           initial_model_version_),
+                    initial_model_version_ ? initial_model_version_->version
+                                           : "",
+                    CreateWarmupFallbackEstimator(*alpha_cc_config_),
+                    BweMessage().target_rate,
+                    // Looks at estimates as often as they may be sent.
+                    alpha_cc_config_->bwe_audio_only
+                        ? std::max(
+                              bwe_feedback_scheduler_.min_interval_ms(),
+                              static_cast<int64_t>(
+                                  alpha_cc_config_
+                                      ->bwe_audio_estimate_interval_ms))
+                        : bwe_feedback_scheduler_.min_interval_ms(),
+                    [this](float estimate_bps) {
+                      OnEstimateUpdated(estimate_bps);
+                    })) {
+  if (estimator_worker_) {
+    // Switches at the next estimate the new model is ready for.
+    BweModelManager::GetProcessWide()->AddSession(
+        model_session_id_,
+        initial_model_version_ ? initial_model_version_->version : "",
+        [this](const BweModelManager::ModelVersion& model_version) {
+          estimator_worker_->ReplaceEstimator(
+              CreateEstimatorFactory(*alpha_cc_config_, model_version),
+              model_version.version);
+        });
+  }
+  if (stats_recorder_ && !stats_recorder_->IsOpen()) {
+    RTC_LOG(LS_ERROR) << "Failed to open stats output file "
+                      << alpha_cc_config_->stats_output_path;
+  }
+  if (video_stats_recorder_ && !video_stats_recorder_->IsOpen()) {
+    RTC_LOG(LS_ERROR) << "Failed to open video stats output file "
+                      << alpha_cc_config_->stats_output_path << ".video";
   }
   RTC_LOG(LS_INFO)
       << "Maximum interval between transport feedback RTCP messages (ms): "
@@ -66,67 +202,122 @@ RemoteEstimatorProxy::RemoteEstimatorProxy(
 }
 
 RemoteEstimatorProxy::~RemoteEstimatorProxy() {
-  if (onnx_infer_) {
-    onnxinfer::DestroyONNXInferInterface(onnx_infer_);
-  }
+  if (estimator_worker_)
+    BweModelManager::GetProcessWide()->RemoveSession(model_session_id_);
 }
 
 void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
                                           size_t payload_size,
                                           const RTPHeader& header) {
+  TRACE_EVENT0("webrtc", "RemoteEstimatorProxy::IncomingPacket");
+  rtc::CritScope cs(&lock_);
+  IncomingPacketLocked(arrival_time_ms, payload_size, header);
+}
+
+void RemoteEstimatorProxy::IncomingPackets(
+    rtc::ArrayView<const IncomingRtpPacket> packets) {
+  TRACE_EVENT1("webrtc", "RemoteEstimatorProxy::IncomingPackets", "packets",
+               packets.size());
+  rtc::CritScope cs(&lock_);
+  for (const IncomingRtpPacket& packet : packets) {
+    IncomingPacketLocked(packet.arrival_time_ms, packet.payload_size,
+                         packet.header);
+  }
+}
+
+void RemoteEstimatorProxy::IncomingPacketLocked(int64_t arrival_time_ms,
+                                                size_t payload_size,
+                                                const RTPHeader& header) {
   if (arrival_time_ms < 0 || arrival_time_ms > kMaxTimeMs) {
-    RTC_LOG(LS_WARNING) << "Arrival time out of bounds: " << arrival_time_ms;
+    RTC_LOG_EVERY_N_MS(LS_WARNING, 1000)
+        << "Arrival time out of bounds: " << arrival_time_ms;
     return;
   }
-  rtc::CritScope cs(&lock_);
   media_ssrc_ = header.ssrc;
   OnPacketArrival(header.extension.transportSequenceNumber, arrival_time_ms,
                   header.extension.feedback_request);
+  if (packet_capture_)
+    packet_capture_->OnPacket(arrival_time_ms, payload_size, header);
+
+  //--- Hand the per-packet info to the bandwidth estimator ---
+  ReceivedPacketInfo packet;
+  // Packets without the extension, e.g. audio, are left out of the unwrapping
+  // so that they can't be taken for a wrap.
+  if (header.extension.hasAbsoluteSendTime) {
+    packet.send_time_us =
+        abs_send_time_unwrapper_.UnwrapUs(header.extension.absoluteSendTime);
+    packet.send_time_ms = AbsSendTimeUnwrapper::ToMs(*packet.send_time_us);
+  }
+  const uint32_t send_time_ms = packet.send_time_ms;
+  packet.payload_type = header.payloadType;
+  packet.sequence_number = header.sequenceNumber;
+  packet.ssrc = header.ssrc;
+  packet.padding_length = header.paddingLength;
+  packet.header_length = header.headerLength;
+  packet.arrival_time_ms = arrival_time_ms;
+  packet.payload_size = payload_size;
+  feature_provider_.OnPacket(header.extension.transportSequenceNumber,
+                             &packet);
+  if (stream_tracker_) {
+    // Call sets the video clock rate before handing packets to the BWE,
+    // anything else is audio.
+    stream_tracker_->OnPacket(
+        arrival_time_ms, header.ssrc,
+        header.payload_type_frequency != kVideoPayloadTypeFrequency,
+        payload_size);
+  }
+  if (queueing_delay_trend_observer_ &&
+      header.extension.hasAbsoluteSendTime) {
+    queueing_delay_trend_estimator_.OnPacket(send_time_ms, arrival_time_ms);
+  }
 
-  //--- ONNXInfer: Input the per-packet info to ONNXInfer module ---
-  uint32_t send_time_ms =
-      GetTtimeFromAbsSendtime(header.extension.absoluteSendTime);
-
-  // lossCound and RTT field for onnxinfer::OnReceived() are set to -1 since
-  // no available lossCound and RTT in webrtc
-  onnxinfer::OnReceived(onnx_infer_, header.payloadType, header.sequenceNumber,
-                        send_time_ms, header.ssrc, header.paddingLength,
-                        header.headerLength, arrival_time_ms, payload_size, -1, -1);
-
-  //--- BandWidthControl: Send back bandwidth estimation into to sender ---
-  bool time_to_send_bew_message = TimeToSendBweMessage();
-  float estimation = 0;
-  if (time_to_send_bew_message) {
-    BweMessage bwe;
-    estimation = onnxinfer::GetBweEstimate(onnx_infer_);
-    bwe.pacing_rate = bwe.padding_rate = bwe.target_rate = estimation;
-    bwe.timestamp_ms = clock_->TimeInMilliseconds();
-    SendbackBweEstimation(bwe);
+  if (!audio_feature_aggregator_) {
+    OnPacketFeature(packet);
+    return;
+  }
+  if (header.payload_type_frequency == kVideoPayloadTypeFrequency) {
+    // Not audio-only after all, the features of the video would be lost in
+    // the windows.
+    RTC_LOG(LS_INFO) << "Video received, estimating from every packet.";
+    absl::optional<ReceivedPacketInfo> feature =
+        audio_feature_aggregator_->Flush();
+    audio_feature_aggregator_.reset();
+    if (estimator_worker_) {
+      estimator_worker_->SetEstimateInterval(
+          bwe_feedback_scheduler_.min_interval_ms());
+    }
+    if (feature)
+      OnPacketFeature(*feature);
+    OnPacketFeature(packet);
+    return;
   }
+  if (absl::optional<ReceivedPacketInfo> feature =
+          audio_feature_aggregator_->OnPacket(packet)) {
+    OnPacketFeature(*feature);
+  }
+}
 
-  // Save per-packet info locally on receiving
-  // ---------- Collect packet-related info into a local file ----------
-  double pacing_rate =
-      time_to_send_bew_message ? estimation : SC_PACER_PACING_RATE_EMPTY;
-  double padding_rate =
-      time_to_send_bew_message ? estimation : SC_PACER_PADDING_RATE_EMPTY;
+void RemoteEstimatorProxy::OnPacketFeature(const ReceivedPacketInfo& feature) {
+  // Estimates are sent back from OnEstimateUpdated().
+  if (estimator_worker_)
+    estimator_worker_->OnPacket(feature);
 
   // Save per-packet info locally on receiving
-  auto res = stats_collect_.StatsCollect(
-      pacing_rate, padding_rate, header.payloadType,
-                              header.sequenceNumber, send_time_ms, header.ssrc,
-                              header.paddingLength, header.headerLength,
-                              arrival_time_ms, payload_size, 0);
-  if (res != StatCollect::SCResult::SC_SUCCESS)
-  {
-    RTC_LOG(LS_ERROR) << "Collect data failed";
-  }
-  std::string out_data = stats_collect_.DumpData();
-  if (out_data.empty())
-  {
-    RTC_LOG(LS_ERROR) << "Save data failed";
+  // ---------- Collect packet-related info into a local file ----------
+  if (stats_recorder_) {
+    double pacing_rate =
+        unlogged_sent_estimate_bps_.value_or(SC_PACER_PACING_RATE_EMPTY);
+    double padding_rate =
+        unlogged_sent_estimate_bps_.value_or(SC_PACER_PADDING_RATE_EMPTY);
+    unlogged_sent_estimate_bps_.reset();
+    // Only copies the record into a preallocated ring, the file is written
+    // by the recorder's own thread.
+    stats_recorder_->Record(pacing_rate, padding_rate, feature.payload_type,
+                            feature.sequence_number, feature.send_time_ms,
+                            feature.ssrc, feature.padding_length,
+                            feature.header_length, feature.arrival_time_ms,
+                            feature.payload_size, 0);
   }
-  RTC_LOG(LS_INFO) << out_data;
 }
 
 bool RemoteEstimatorProxy::LatestEstimate(std::vector<unsigned int>* ssrcs,
@@ -134,13 +325,40 @@ bool RemoteEstimatorProxy::LatestEstimate(std::vector<unsigned int>* ssrcs,
   return false;
 }
 
+void RemoteEstimatorProxy::OnRttUpdate(int64_t avg_rtt_ms,
+                                       int64_t max_rtt_ms) {
+  feature_provider_.OnRttUpdate(avg_rtt_ms);
+}
+
+void RemoteEstimatorProxy::OnFrameStats(const ReceivedFrameStats& frame_stats) {
+  if (estimator_worker_)
+    estimator_worker_->OnFrameStats(frame_stats);
+  if (video_stats_recorder_) {
+    StatCollect::BinaryVideoRecord record;
+    record.timeMs = frame_stats.time_ms;
+    record.jitterBufferDelay = frame_stats.jitter_buffer_delay_seconds;
+    record.jitterBufferEmittedCount = frame_stats.jitter_buffer_emitted_count;
+    record.framesReceived = frame_stats.frames_received;
+    record.keyFramesReceived = frame_stats.key_frames_received;
+    record.framesDecoded = frame_stats.frames_decoded;
+    record.framesDropped = frame_stats.frames_dropped;
+    record.freezeCount = frame_stats.freeze_count;
+    record.totalFreezesDurationMs = frame_stats.total_freezes_duration_ms;
+    video_stats_recorder_->Record(record);
+  }
+}
+
 int64_t RemoteEstimatorProxy::TimeUntilNextProcess() {
   rtc::CritScope cs(&lock_);
+  return TimeUntilPeriodicFeedbackMs();
+}
+
+int64_t RemoteEstimatorProxy::TimeUntilPeriodicFeedbackMs() const {
   if (!send_periodic_feedback_) {
     // Wait a day until next process.
     return 24 * 60 * 60 * 1000;
   } else if (last_process_time_ms_ != -1) {
-    int64_t now = clock_->TimeInMilliseconds();
+    int64_t now = clock_->CoarseTimeInMilliseconds();
     if (now - last_process_time_ms_ < send_interval_ms_)
       return last_process_time_ms_ + send_interval_ms_ - now;
   }
@@ -148,16 +366,32 @@ int64_t RemoteEstimatorProxy::TimeUntilNextProcess() {
 }
 
 void RemoteEstimatorProxy::Process() {
-  rtc::CritScope cs(&lock_);
-  if (!send_periodic_feedback_) {
-    return;
+  QueueingDelayTrendObserver* trend_observer;
+  absl::optional<QueueingDelayTrend> trend;
+  {
+    rtc::CritScope cs(&lock_);
+    trend_observer = queueing_delay_trend_observer_;
+    const int64_t now_ms = clock_->CoarseTimeInMilliseconds();
+    if (trend_observer) {
+      trend = queueing_delay_trend_estimator_.GetTrend(now_ms);
+    }
+    if (send_periodic_feedback_) {
+      last_process_time_ms_ = now_ms;
+      SendPeriodicFeedbacks();
+    }
   }
-  last_process_time_ms_ = clock_->TimeInMilliseconds();
-
-  SendPeriodicFeedbacks();
+  // The observer hands the trend on to the receive streams, which must not
+  // happen under |lock_| since their packets arrive while holding it.
+  if (trend)
+    trend_observer->OnQueueingDelayTrend(*trend);
 }
 
 void RemoteEstimatorProxy::OnBitrateChanged(int bitrate_bps) {
+  // The sender gets estimates instead, the interval is fixed then.
+  if (transport_feedback_option_ !=
+      AlphaCCConfig::BweTransportFeedbackOption::kFull) {
+    return;
+  }
   // TwccReportSize = Ipv4(20B) + UDP(8B) + SRTP(10B) +
   // AverageTwccReport(30B)
   // TwccReport size at 50ms interval is 24 byte.
@@ -181,6 +415,25 @@ void RemoteEstimatorProxy::SetSendPeriodicFeedback(
     bool send_periodic_feedback) {
   rtc::CritScope cs(&lock_);
   send_periodic_feedback_ = send_periodic_feedback;
+  if (!send_periodic_feedback_ && pending_bwe_) {
+    // Nothing will pick up the waiting estimate anymore.
+    SendBwePacket(TakePendingBwePacket());
+  }
+}
+
+absl::optional<ReceiveSideEstimatorWorker::Stats>
+RemoteEstimatorProxy::GetEstimatorStats() const {
+  if (!estimator_worker_)
+    return absl::nullopt;
+  return estimator_worker_->GetStats();
+}
+
+void RemoteEstimatorProxy::SetQueueingDelayTrendObserver(
+    QueueingDelayTrendObserver* observer) {
+  rtc::CritScope cs(&lock_);
+  queueing_delay_trend_observer_ = observer;
+  if (!observer)
+    queueing_delay_trend_estimator_ = QueueingDelayTrendEstimator();
 }
 
 void RemoteEstimatorProxy::OnPacketArrival(
@@ -188,7 +441,8 @@ void RemoteEstimatorProxy::OnPacketArrival(
     int64_t arrival_time,
     absl::optional<FeedbackRequest> feedback_request) {
   if (arrival_time < 0 || arrival_time > kMaxTimeMs) {
-    RTC_LOG(LS_WARNING) << "Arrival time out of bounds: " << arrival_time;
+    RTC_LOG_EVERY_N_MS(LS_WARNING, 1000)
+        << "Arrival time out of bounds: " << arrival_time;
     return;
   }
 
@@ -196,14 +450,12 @@ void RemoteEstimatorProxy::OnPacketArrival(
 
   if (send_periodic_feedback_) {
     if (periodic_window_start_seq_ &&
-        packet_arrival_times_.lower_bound(*periodic_window_start_seq_) ==
-            packet_arrival_times_.end()) {
+        (packet_arrival_times_.empty() ||
+         packet_arrival_times_.end_sequence_number() <=
+             *periodic_window_start_seq_)) {
       // Start new feedback packet, cull old packets.
-      for (auto it = packet_arrival_times_.begin();
-           it != packet_arrival_times_.end() && it->first < seq &&
-           arrival_time - it->second >= send_config_.back_window->ms();) {
-        it = packet_arrival_times_.erase(it);
-      }
+      packet_arrival_times_.RemoveOldPackets(
+          seq, arrival_time - send_config_.back_window->ms());
     }
     if (!periodic_window_start_seq_ || seq < *periodic_window_start_seq_) {
       periodic_window_start_seq_ = seq;
@@ -211,23 +463,16 @@ void RemoteEstimatorProxy::OnPacketArrival(
   }
 
   // We are only interested in the first time a packet is received.
-  if (packet_arrival_times_.find(seq) != packet_arrival_times_.end())
+  if (packet_arrival_times_.has_received(seq))
     return;
 
-  packet_arrival_times_[seq] = arrival_time;
-
-  // Limit the range of sequence numbers to send feedback for.
-  auto first_arrival_time_to_keep = packet_arrival_times_.lower_bound(
-      packet_arrival_times_.rbegin()->first - kMaxNumberOfPackets);
-  if (first_arrival_time_to_keep != packet_arrival_times_.begin()) {
-    packet_arrival_times_.erase(packet_arrival_times_.begin(),
-                                first_arrival_time_to_keep);
-    if (send_periodic_feedback_) {
-      // |packet_arrival_times_| cannot be empty since we just added one element
-      // and the last element is not deleted.
-      RTC_DCHECK(!packet_arrival_times_.empty());
-      periodic_window_start_seq_ = packet_arrival_times_.begin()->first;
-    }
+  // Also limits the range of sequence numbers to send feedback for.
+  if (packet_arrival_times_.AddPacket(seq, arrival_time) &&
+      send_periodic_feedback_) {
+    // |packet_arrival_times_| cannot be empty since we just added one element
+    // and the last element is not deleted.
+    RTC_DCHECK(!packet_arrival_times_.empty());
+    periodic_window_start_seq_ = packet_arrival_times_.begin_sequence_number();
   }
 
   if (feedback_request) {
@@ -236,21 +481,34 @@ void RemoteEstimatorProxy::OnPacketArrival(
   }
 }
 
-bool RemoteEstimatorProxy::TimeToSendBweMessage() {
-  int64_t time_now = clock_->TimeInMilliseconds();
-  if (time_now - bwe_sendback_interval_ms_ > last_bwe_sendback_ms_) {
-    last_bwe_sendback_ms_ = time_now;
-    return true;
-  }
-  return false;
+void RemoteEstimatorProxy::OnEstimateUpdated(float estimate_bps) {
+  rtc::CritScope cs(&lock_);
+  //--- BandWidthControl: Send back bandwidth estimation into to sender ---
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (packet_capture_)
+    packet_capture_->OnEstimate(now_ms, estimate_bps);
+  if (!bwe_feedback_scheduler_.OnEstimate(now_ms, estimate_bps))
+    return;
+  BweMessage bwe;
+  bwe.pacing_rate = bwe.padding_rate = bwe.target_rate = estimate_bps;
+  bwe.timestamp_ms = now_ms;
+  if (stream_tracker_)
+    bwe.stream_estimates = stream_tracker_->SplitEstimate(now_ms, estimate_bps);
+  SendbackBweEstimation(bwe);
+  unlogged_sent_estimate_bps_ = estimate_bps;
 }
 
 void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
+  TRACE_EVENT0("webrtc", "RemoteEstimatorProxy::SendPeriodicFeedbacks");
   // |periodic_window_start_seq_| is the first sequence number to include in the
   // current feedback packet. Some older may still be in the map, in case a
   // reordering happens and we need to retransmit them.
-  if (!periodic_window_start_seq_)
+  std::unique_ptr<rtcp::AlphaCcBwe> bwe_packet = TakePendingBwePacket();
+  if (!periodic_window_start_seq_) {
+    if (bwe_packet)
+      SendBwePacket(std::move(bwe_packet));
     return;
+  }
 
   std::unique_ptr<rtcp::RemoteEstimate> remote_estimate;
   if (network_state_estimator_) {
@@ -262,15 +520,18 @@ void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
     }
   }
 
-  for (auto begin_iterator =
-           packet_arrival_times_.lower_bound(*periodic_window_start_seq_);
-       begin_iterator != packet_arrival_times_.cend();
-       begin_iterator =
-           packet_arrival_times_.lower_bound(*periodic_window_start_seq_)) {
-    auto feedback_packet = std::make_unique<rtcp::TransportFeedback>();
+  for (int64_t begin_sequence_number =
+           packet_arrival_times_.LowerBound(*periodic_window_start_seq_);
+       begin_sequence_number < packet_arrival_times_.end_sequence_number();
+       begin_sequence_number =
+           packet_arrival_times_.LowerBound(*periodic_window_start_seq_)) {
+    auto feedback_packet = std::make_unique<rtcp::TransportFeedback>(
+        /*include_timestamps=*/transport_feedback_option_ !=
+        AlphaCCConfig::BweTransportFeedbackOption::kLossOnly);
     periodic_window_start_seq_ = BuildFeedbackPacket(
         feedback_packet_count_++, media_ssrc_, *periodic_window_start_seq_,
-        begin_iterator, packet_arrival_times_.cend(), feedback_packet.get());
+        begin_sequence_number, packet_arrival_times_.end_sequence_number(),
+        feedback_packet.get());
 
     RTC_DCHECK(feedback_sender_ != nullptr);
 
@@ -278,6 +539,9 @@ void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
     if (remote_estimate) {
       packets.push_back(std::move(remote_estimate));
     }
+    if (bwe_packet) {
+      packets.push_back(std::move(bwe_packet));
+    }
     packets.push_back(std::move(feedback_packet));
 
     feedback_sender_->SendCombinedRtcpPacket(std::move(packets));
@@ -285,11 +549,16 @@ void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
     // they need to be re-sent after a reordering. Removal will be handled
     // by OnPacketArrival once packets are too old.
   }
+  // No packets arrived since the last feedback, so there was no feedback
+  // packet for the waiting estimate to ride along with.
+  if (bwe_packet)
+    SendBwePacket(std::move(bwe_packet));
 }
 
 void RemoteEstimatorProxy::SendFeedbackOnRequest(
     int64_t sequence_number,
     const FeedbackRequest& feedback_request) {
+  TRACE_EVENT0("webrtc", "RemoteEstimatorProxy::SendFeedbackOnRequest");
   if (feedback_request.sequence_count == 0) {
     return;
   }
@@ -299,16 +568,17 @@ void RemoteEstimatorProxy::SendFeedbackOnRequest(
 
   int64_t first_sequence_number =
       sequence_number - feedback_request.sequence_count + 1;
-  auto begin_iterator =
-      packet_arrival_times_.lower_bound(first_sequence_number);
-  auto end_iterator = packet_arrival_times_.upper_bound(sequence_number);
+  int64_t begin_sequence_number =
+      packet_arrival_times_.LowerBound(first_sequence_number);
+  int64_t end_sequence_number =
+      packet_arrival_times_.LowerBound(sequence_number + 1);
 
   BuildFeedbackPacket(feedback_packet_count_++, media_ssrc_,
-                      first_sequence_number, begin_iterator, end_iterator,
-                      feedback_packet.get());
+                      first_sequence_number, begin_sequence_number,
+                      end_sequence_number, feedback_packet.get());
 
   // Clear up to the first packet that is included in this feedback packet.
-  packet_arrival_times_.erase(packet_arrival_times_.begin(), begin_iterator);
+  packet_arrival_times_.EraseTo(begin_sequence_number);
 
   RTC_DCHECK(feedback_sender_ != nullptr);
   std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets;
@@ -317,24 +587,57 @@ void RemoteEstimatorProxy::SendFeedbackOnRequest(
 }
 
 void RemoteEstimatorProxy::SendbackBweEstimation(const BweMessage& bwe) {
-  auto app_packet = std::make_unique<rtcp::App>();
-  app_packet->SetSubType(kAppPacketSubType);
-  app_packet->SetName(kAppPacketName);
+  TRACE_EVENT1("webrtc", "RemoteEstimatorProxy::SendbackBweEstimation",
+               "target_rate_bps", bwe.target_rate);
+  // The periodic feedback is only sent once packets have been received, so
+  // don't hold the estimate back before that.
+  if (bwe_piggyback_tolerance_ms_ > 0 && periodic_window_start_seq_ &&
+      TimeUntilPeriodicFeedbackMs() <= bwe_piggyback_tolerance_ms_) {
+    // A newer estimate replaces one that is still waiting.
+    pending_bwe_ = bwe;
+    return;
+  }
+  SendBwePacket(CreateBwePacket(bwe));
+}
+
+std::unique_ptr<rtcp::AlphaCcBwe> RemoteEstimatorProxy::TakePendingBwePacket() {
+  if (!pending_bwe_)
+    return nullptr;
+  std::unique_ptr<rtcp::AlphaCcBwe> app_packet = CreateBwePacket(*pending_bwe_);
+  pending_bwe_.reset();
+  return app_packet;
+}
 
-  app_packet->SetData(reinterpret_cast<const uint8_t*>(&bwe), sizeof(bwe));
+void RemoteEstimatorProxy::SendBwePacket(
+    std::unique_ptr<rtcp::AlphaCcBwe> bwe_packet) {
   std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets;
-  packets.push_back(std::move(app_packet));
+  packets.push_back(std::move(bwe_packet));
   feedback_sender_->SendCombinedRtcpPacket(std::move(packets));
 }
 
+std::unique_ptr<rtcp::AlphaCcBwe> RemoteEstimatorProxy::CreateBwePacket(
+    const BweMessage& bwe) {
+  if (event_log_) {
+    event_log_->Log(std::make_unique<RtcEventAlphaCcEstimate>(
+        RtcEventAlphaCcEstimate::Source::kSent,
+        DataRate::BitsPerSec(static_cast<int64_t>(bwe.target_rate)),
+        DataRate::BitsPerSec(static_cast<int64_t>(bwe.pacing_rate)),
+        bwe.confidence, bwe.rtt_ms, bwe.loss_ratio));
+  }
+  auto app_packet = std::make_unique<rtcp::AlphaCcBwe>();
+  app_packet->SetBwe(bwe);
+  return app_packet;
+}
+
 int64_t RemoteEstimatorProxy::BuildFeedbackPacket(
     uint8_t feedback_packet_count,
     uint32_t media_ssrc,
     int64_t base_sequence_number,
-    std::map<int64_t, int64_t>::const_iterator begin_iterator,
-    std::map<int64_t, int64_t>::const_iterator end_iterator,
+    int64_t begin_sequence_number,
+    int64_t end_sequence_number,
     rtcp::TransportFeedback* feedback_packet) {
-  RTC_DCHECK(begin_iterator != end_iterator);
+  RTC_DCHECK_LT(begin_sequence_number, end_sequence_number);
+  RTC_DCHECK(packet_arrival_times_.has_received(begin_sequence_number));
 
   // TODO(sprang): Measure receive times in microseconds and remove the
   // conversions below.
@@ -342,54 +645,21 @@ int64_t RemoteEstimatorProxy::BuildFeedbackPacket(
   // Base sequence number is the expected first sequence number. This is known,
   // but we might not have actually received it, so the base time shall be the
   // time of the first received packet in the feedback.
-  feedback_packet->SetBase(static_cast<uint16_t>(base_sequence_number & 0xFFFF),
-                           begin_iterator->second * 1000);
+  feedback_packet->SetBase(
+      static_cast<uint16_t>(base_sequence_number & 0xFFFF),
+      packet_arrival_times_.get(begin_sequence_number) * 1000);
   feedback_packet->SetFeedbackSequenceNumber(feedback_packet_count);
-  int64_t next_sequence_number = base_sequence_number;
-  for (auto it = begin_iterator; it != end_iterator; ++it) {
-    if (!feedback_packet->AddReceivedPacket(
-            static_cast<uint16_t>(it->first & 0xFFFF), it->second * 1000)) {
-      // If we can't even add the first seq to the feedback packet, we won't be
-      // able to build it at all.
-      RTC_CHECK(begin_iterator != it);
-
-      // Could not add timestamp, feedback packet might be full. Return and
-      // try again with a fresh packet.
-      break;
-    }
-    next_sequence_number = it->first + 1;
-  }
-  return next_sequence_number;
-}
-
-uint32_t RemoteEstimatorProxy::GetTtimeFromAbsSendtime(
-    uint32_t absoluteSendTime) {
-  if (cycles_ == -1) {
-    // Initalize
-    max_abs_send_time_ = absoluteSendTime;
-    cycles_ = 0;
-  }
-  // Abs sender time is 24 bit 6.18 fixed point. Shift by 8 to normalize to
-  // 32 bits (unsigned). Calculate the difference between this packet's
-  // send time and the maximum observed. Cast to signed 32-bit to get the
-  // desired wrap-around behavior.
-  if (static_cast<int32_t>((absoluteSendTime << 8) -
-                           (max_abs_send_time_ << 8)) >= 0) {
-    // The difference is non-negative, meaning that this packet is newer
-    // than the previously observed maximum absolute send time.
-    if (absoluteSendTime < max_abs_send_time_) {
-      // Wrap detected.
-      cycles_++;
-    }
-    max_abs_send_time_ = absoluteSendTime;
-  }
-  // Abs sender time is 24 bit 6.18 fixed point. Divide by 2^18 to convert
-  // to floating point representation.
-  double send_time_seconds =
-      static_cast<double>(absoluteSendTime) / 262144 + 64.0 * cycles_;
-  uint32_t send_time_ms =
-      static_cast<uint32_t>(std::round(send_time_seconds * 1000));
-  return send_time_ms;
+  packet_arrival_times_.GetArrivalTimesUs(
+      begin_sequence_number, end_sequence_number,
+      rtcp::TransportFeedback::kNotReceived, &feedback_arrival_times_us_);
+  size_t covered = feedback_packet->AddReceivedPackets(
+      static_cast<uint16_t>(begin_sequence_number & 0xFFFF),
+      feedback_arrival_times_us_);
+  // If we can't even add the first seq to the feedback packet, we won't be
+  // able to build it at all. Otherwise the feedback packet might be full, the
+  // rest is sent with a fresh packet.
+  RTC_CHECK_GT(covered, 0u);
+  return begin_sequence_number + static_cast<int64_t>(covered);
 }
 
 }  // namespace webrtc
@@ -11,23 +11,39 @@
 #ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 #define MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 
-#include <map>
+#include <memory>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/alphacc_config.h"
+#include "api/array_view.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/transport/network_control.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "api/transport/webrtc_key_value_config.h"
+#include "modules/remote_bitrate_estimator/abs_send_time_unwrapper.h"
+#include "modules/remote_bitrate_estimator/audio_feature_aggregator.h"
+#include "modules/remote_bitrate_estimator/bwe_feedback_scheduler.h"
+#include "modules/remote_bitrate_estimator/bwe_model_manager.h"
 #include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
-#include "modules/third_party/onnxinfer/ONNXInferInterface.h"
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+#include "modules/remote_bitrate_estimator/queueing_delay_trend_estimator.h"
+#include "modules/remote_bitrate_estimator/receive_side_estimator_worker.h"
+#include "modules/remote_bitrate_estimator/receive_side_feature_provider.h"
+#include "modules/remote_bitrate_estimator/receive_stream_tracker.h"
+#include "modules/remote_bitrate_estimator/rtp_packet_capture.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/numerics/sequence_number_util.h"
-#include "modules/third_party/statcollect/StatCollect.h"
+#include "modules/third_party/statcollect/StatRecorder.h"
 
 namespace webrtc {
 
 class Clock;
 class PacketRouter;
 namespace rtcp {
+class AlphaCcBwe;
 class TransportFeedback;
 }
 
@@ -37,24 +53,55 @@ class TransportFeedback;
 
 class RemoteEstimatorProxy : public RemoteBitrateEstimator {
  public:
+  // The arguments of one IncomingPacket() call.
+  struct IncomingRtpPacket {
+    int64_t arrival_time_ms;
+    size_t payload_size;
+    RTPHeader header;
+  };
+
   RemoteEstimatorProxy(Clock* clock,
                        TransportFeedbackSenderInterface* feedback_sender,
                        const WebRtcKeyValueConfig* key_value_config,
                        NetworkStateEstimator* network_state_estimator);
+  // |task_queue_factory| runs the receive side estimator, null means the
+  // default factory. The estimates sent are logged to |event_log| unless it is
+  // null. |alpha_cc_config| must outlive the proxy, null means
+  // GetAlphaCCConfig().
+  RemoteEstimatorProxy(Clock* clock,
+                       TransportFeedbackSenderInterface* feedback_sender,
+                       const WebRtcKeyValueConfig* key_value_config,
+                       NetworkStateEstimator* network_state_estimator,
+                       TaskQueueFactory* task_queue_factory,
+                       RtcEventLog* event_log,
+                       const AlphaCCConfig* alpha_cc_config);
   ~RemoteEstimatorProxy() override;
 
   void IncomingPacket(int64_t arrival_time_ms,
                       size_t payload_size,
                       const RTPHeader& header) override;
+  // Same as calling IncomingPacket() for each of |packets| in order, but only
+  // takes the lock once.
+  void IncomingPackets(rtc::ArrayView<const IncomingRtpPacket> packets);
   void RemoveStream(uint32_t ssrc) override {}
   bool LatestEstimate(std::vector<unsigned int>* ssrcs,
                       unsigned int* bitrate_bps) const override;
-  void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override {}
+  void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override;
   void SetMinBitrate(int min_bitrate_bps) override {}
   int64_t TimeUntilNextProcess() override;
   void Process() override;
   void OnBitrateChanged(int bitrate);
   void SetSendPeriodicFeedback(bool send_periodic_feedback);
+  // Unset if the estimator does not run on the receiver.
+  absl::optional<ReceiveSideEstimatorWorker::Stats> GetEstimatorStats() const;
+  // |observer| is told the queueing delay trend of the packets with an
+  // absolute send time on every Process(), from the thread calling it. Null
+  // stops the estimation. Must outlive this object or be reset.
+  void SetQueueingDelayTrendObserver(QueueingDelayTrendObserver* observer);
+  // Hands the sampled frame statistics of the video receive streams to the
+  // estimator and, if logging to file is enabled, to StatCollect. Must always
+  // be called from the same thread. Does not take the lock of the packets.
+  void OnFrameStats(const ReceivedFrameStats& frame_stats);
 
  private:
   struct TransportWideFeedbackConfig {
@@ -73,7 +120,14 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
     }
   };
 
-  static const int kMaxNumberOfPackets;
+  void IncomingPacketLocked(int64_t arrival_time_ms,
+                            size_t payload_size,
+                            const RTPHeader& header)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // Hands |feature|, a packet or the aggregate of several, to the estimator
+  // and StatCollect.
+  void OnPacketFeature(const ReceivedPacketInfo& feature)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void OnPacketArrival(uint16_t sequence_number,
                        int64_t arrival_time,
                        absl::optional<FeedbackRequest> feedback_request)
@@ -83,26 +137,38 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
                              const FeedbackRequest& feedback_request)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
 
+  // Sends |bwe_message| right away, or keeps it for the next periodic
+  // feedback if that is due within |bwe_piggyback_tolerance_ms_|.
   void SendbackBweEstimation(const BweMessage& bwe_message)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
-  bool TimeToSendBweMessage() RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  std::unique_ptr<rtcp::AlphaCcBwe> TakePendingBwePacket()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // Sends |bwe_packet| in a compound packet of its own.
+  void SendBwePacket(std::unique_ptr<rtcp::AlphaCcBwe> bwe_packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  std::unique_ptr<rtcp::AlphaCcBwe> CreateBwePacket(const BweMessage& bwe)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  int64_t TimeUntilPeriodicFeedbackMs() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // Called by |estimator_worker_| with every new estimate.
+  void OnEstimateUpdated(float estimate_bps);
 
   int64_t BuildFeedbackPacket(
       uint8_t feedback_packet_count,
       uint32_t media_ssrc,
       int64_t base_sequence_number,
-      std::map<int64_t, int64_t>::const_iterator
-          begin_iterator,  // |begin_iterator| is inclusive.
-      std::map<int64_t, int64_t>::const_iterator
-          end_iterator,  // |end_iterator| is exclusive.
-      rtcp::TransportFeedback* feedback_packet);
-
-  uint32_t GetTtimeFromAbsSendtime(uint32_t absoluteSendTime)
+      int64_t begin_sequence_number,  // |begin_sequence_number| is inclusive.
+      int64_t end_sequence_number,    // |end_sequence_number| is exclusive.
+      rtcp::TransportFeedback* feedback_packet)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
 
   Clock* const clock_;
   TransportFeedbackSenderInterface* const feedback_sender_;
+  RtcEventLog* const event_log_;
+  const AlphaCCConfig* const alpha_cc_config_;
   const TransportWideFeedbackConfig send_config_;
+  // Anything but kFull sends the periodic feedback at a fixed interval.
+  const AlphaCCConfig::BweTransportFeedbackOption transport_feedback_option_;
   int64_t last_process_time_ms_;
 
   rtc::CriticalSection lock_;
@@ -114,19 +180,50 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
   SeqNumUnwrapper<uint16_t> unwrapper_ RTC_GUARDED_BY(&lock_);
   absl::optional<int64_t> periodic_window_start_seq_ RTC_GUARDED_BY(&lock_);
   // Map unwrapped seq -> time.
-  std::map<int64_t, int64_t> packet_arrival_times_ RTC_GUARDED_BY(&lock_);
+  PacketArrivalTimeMap packet_arrival_times_ RTC_GUARDED_BY(&lock_);
+  // Scratch space reused by BuildFeedbackPacket().
+  std::vector<int64_t> feedback_arrival_times_us_ RTC_GUARDED_BY(&lock_);
   int64_t send_interval_ms_ RTC_GUARDED_BY(&lock_);
   bool send_periodic_feedback_ RTC_GUARDED_BY(&lock_);
 
   // Bandwidth estimation sending back
-  int64_t bwe_sendback_interval_ms_ RTC_GUARDED_BY(&lock_);
-  int64_t last_bwe_sendback_ms_ RTC_GUARDED_BY(&lock_);
-
-  // StatCollect moudule
-  StatCollect::StatsCollectModule stats_collect_;
-  int cycles_ RTC_GUARDED_BY(&lock_);
-  uint32_t max_abs_send_time_ RTC_GUARDED_BY(&lock_);
-  void* onnx_infer_;
+  BweFeedbackScheduler bwe_feedback_scheduler_ RTC_GUARDED_BY(&lock_);
+  // Estimate sent since the last packet was logged by |stats_recorder_|.
+  absl::optional<float> unlogged_sent_estimate_bps_ RTC_GUARDED_BY(&lock_);
+  const int64_t bwe_piggyback_tolerance_ms_;
+  // Estimate waiting to be appended to the next periodic feedback.
+  absl::optional<BweMessage> pending_bwe_ RTC_GUARDED_BY(&lock_);
+
+  // StatCollect moudule, null unless logging to file is enabled.
+  std::unique_ptr<StatCollect::BinaryStatsRecorder> stats_recorder_;
+  // Only used by OnFrameStats(), null unless logging to file is enabled.
+  const std::unique_ptr<StatCollect::BinaryVideoStatsRecorder>
+      video_stats_recorder_;
+  AbsSendTimeUnwrapper abs_send_time_unwrapper_ RTC_GUARDED_BY(&lock_);
+  QueueingDelayTrendObserver* queueing_delay_trend_observer_
+      RTC_GUARDED_BY(&lock_) = nullptr;
+  QueueingDelayTrendEstimator queueing_delay_trend_estimator_
+      RTC_GUARDED_BY(&lock_);
+  // Null unless AlphaCCConfig::bwe_per_stream_estimates is set.
+  const std::unique_ptr<ReceiveStreamTracker> stream_tracker_
+      RTC_PT_GUARDED_BY(&lock_);
+  // Null unless AlphaCCConfig::bwe_audio_only is set, or once a video packet
+  // arrived.
+  std::unique_ptr<AudioFeatureAggregator> audio_feature_aggregator_
+      RTC_GUARDED_BY(&lock_);
+  // Only fed while holding |lock_|, provides RTT updates without taking it.
+  ReceiveSideFeatureProvider feature_provider_;
+  // Identifies the call to BweModelManager.
+  const uint32_t model_session_id_;
+  // The version BweModelManager assigned when the call started, if any.
+  const absl::optional<BweModelManager::ModelVersion> initial_model_version_;
+  // Null unless the call captures packets, see
+  // AlphaCCConfig::packet_capture_path.
+  const std::unique_ptr<RtpPacketCapture> packet_capture_
+      RTC_PT_GUARDED_BY(&lock_);
+  // Runs the estimator off the packet path; only fed while holding |lock_|.
+  // Null if the sender estimates, see AlphaCCConfig::BweLocation.
+  const std::unique_ptr<ReceiveSideEstimatorWorker> estimator_worker_;
 };
 
 }  // namespace webrtc
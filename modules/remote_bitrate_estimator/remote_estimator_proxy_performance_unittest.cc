@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/transport/field_trial_based_config.h"
+#include "modules/remote_bitrate_estimator/remote_estimator_proxy.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 456;
+constexpr int64_t kBaseTimeMs = 123456;
+// Feedback is sent every 100 ms, i.e. every 100 packets at 1 packet per ms.
+constexpr int kPacketsPerProcess = 100;
+constexpr int kNumPackets = 1000000;
+
+class CountingFeedbackSender : public TransportFeedbackSenderInterface {
+ public:
+  bool SendCombinedRtcpPacket(
+      std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets) override {
+    num_packets_ += packets.size();
+    return true;
+  }
+  size_t num_packets() const { return num_packets_; }
+
+ private:
+  size_t num_packets_ = 0;
+};
+
+// Packets arriving about 1 ms apart, 1% of them lost and 1% reordered.
+std::vector<RemoteEstimatorProxy::IncomingRtpPacket> CreatePackets() {
+  Random random(0x5eed);
+  std::vector<RemoteEstimatorProxy::IncomingRtpPacket> packets;
+  packets.reserve(kNumPackets);
+  uint16_t sequence_number = 0;
+  for (int i = 0; i < kNumPackets; ++i) {
+    ++sequence_number;
+    const int event = random.Rand(0, 99);
+    if (event == 0)
+      continue;
+    RemoteEstimatorProxy::IncomingRtpPacket packet;
+    packet.arrival_time_ms = kBaseTimeMs + i;
+    packet.payload_size = 1000 + random.Rand(0, 200);
+    packet.header.ssrc = kMediaSsrc;
+    packet.header.extension.hasTransportSequenceNumber = true;
+    packet.header.extension.transportSequenceNumber =
+        event == 1 ? sequence_number - 2 : sequence_number;
+    packets.push_back(packet);
+  }
+  return packets;
+}
+
+// Returns the average time in nanoseconds to register an arriving packet,
+// delivering the packets one by one or in batches of |batch_size|. Building
+// and sending the feedback is not measured.
+double MeasureIncomingPacketTimeNs(
+    const std::vector<RemoteEstimatorProxy::IncomingRtpPacket>& packets,
+    size_t batch_size) {
+  FieldTrialBasedConfig field_trial_config;
+  SimulatedClock clock(kBaseTimeMs * rtc::kNumMicrosecsPerMillisec);
+  CountingFeedbackSender feedback_sender;
+  RemoteEstimatorProxy proxy(&clock, &feedback_sender, &field_trial_config,
+                             /*network_state_estimator=*/nullptr);
+
+  int64_t total_ns = 0;
+  for (size_t first = 0; first < packets.size();
+       first += kPacketsPerProcess) {
+    const size_t end = std::min(first + kPacketsPerProcess, packets.size());
+    int64_t start_ns = rtc::TimeNanos();
+    if (batch_size == 1) {
+      for (size_t i = first; i < end; ++i) {
+        proxy.IncomingPacket(packets[i].arrival_time_ms,
+                             packets[i].payload_size, packets[i].header);
+      }
+    } else {
+      for (size_t i = first; i < end; i += batch_size) {
+        proxy.IncomingPackets(
+            rtc::MakeArrayView(&packets[i], std::min(batch_size, end - i)));
+      }
+    }
+    total_ns += rtc::TimeNanos() - start_ns;
+    clock.AdvanceTimeMilliseconds(packets[end - 1].arrival_time_ms -
+                                  clock.TimeInMilliseconds());
+    proxy.Process();
+  }
+  EXPECT_GT(feedback_sender.num_packets(), 0u);
+  return static_cast<double>(total_ns) / packets.size();
+}
+
+TEST(RemoteEstimatorProxyPerformanceTest, IncomingPacketTime) {
+  const std::vector<RemoteEstimatorProxy::IncomingRtpPacket> packets =
+      CreatePackets();
+  for (size_t batch_size : {1, 10}) {
+    test::PrintResult("remote_estimator_proxy_incoming_packet_time", "",
+                      "batches_of_" + std::to_string(batch_size),
+                      MeasureIncomingPacketTimeNs(packets, batch_size), "ns",
+                      false);
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -13,14 +13,18 @@
 #include <memory>
 #include <utility>
 
+#include "api/alphacc_config.h"
 #include "api/transport/field_trial_based_config.h"
 #include "api/transport/network_types.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "api/transport/test/mock_network_control.h"
 #include "modules/pacing/packet_router.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/alpha_cc_bwe.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
 
 using ::testing::_;
 using ::testing::ElementsAre;
@@ -42,6 +46,7 @@ constexpr int kBackWindowMs = 500;
 constexpr int kMinSendIntervalMs = 50;
 constexpr int kMaxSendIntervalMs = 250;
 constexpr int kDefaultSendIntervalMs = 100;
+constexpr int kReducedSendIntervalMs = 1000;
 
 std::vector<uint16_t> SequenceNumbers(
     const rtcp::TransportFeedback& feedback_packet) {
@@ -70,6 +75,11 @@ class MockTransportFeedbackSender : public TransportFeedbackSenderInterface {
       bool(std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets));
 };
 
+class MockQueueingDelayTrendObserver : public QueueingDelayTrendObserver {
+ public:
+  MOCK_METHOD1(OnQueueingDelayTrend, void(const QueueingDelayTrend& trend));
+};
+
 class RemoteEstimatorProxyTest : public ::testing::Test {
  public:
   RemoteEstimatorProxyTest()
@@ -162,6 +172,34 @@ TEST_F(RemoteEstimatorProxyTest, DuplicatedPackets) {
   Process();
 }
 
+TEST_F(RemoteEstimatorProxyTest, HandlesBatchOfPackets) {
+  const RemoteEstimatorProxy::IncomingRtpPacket kPackets[] = {
+      {kBaseTimeMs, kDefaultPacketSize,
+       CreateHeader(kBaseSeq, absl::nullopt, absl::nullopt)},
+      {kBaseTimeMs + 1, kDefaultPacketSize,
+       CreateHeader(kBaseSeq + 2, absl::nullopt, absl::nullopt)},
+      // Duplicates within a batch are ignored like any other.
+      {kBaseTimeMs + 2, kDefaultPacketSize,
+       CreateHeader(kBaseSeq + 2, absl::nullopt, absl::nullopt)}};
+  proxy_.IncomingPackets(kPackets);
+
+  EXPECT_CALL(router_, SendCombinedRtcpPacket)
+      .WillOnce(Invoke(
+          [](std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets) {
+            rtcp::TransportFeedback* feedback_packet =
+                static_cast<rtcp::TransportFeedback*>(
+                    feedback_packets[0].get());
+            EXPECT_EQ(kBaseSeq, feedback_packet->GetBaseSequence());
+            EXPECT_THAT(SequenceNumbers(*feedback_packet),
+                        ElementsAre(kBaseSeq, kBaseSeq + 2));
+            EXPECT_THAT(TimestampsMs(*feedback_packet),
+                        ElementsAre(kBaseTimeMs, kBaseTimeMs + 1));
+            return true;
+          }));
+
+  Process();
+}
+
 TEST_F(RemoteEstimatorProxyTest, FeedbackWithMissingStart) {
   // First feedback.
   IncomingPacket(kBaseSeq, kBaseTimeMs);
@@ -482,6 +520,132 @@ TEST_F(RemoteEstimatorProxyTest, TwccReportsUse5PercentOfAvailableBandwidth) {
   EXPECT_EQ(136, proxy_.TimeUntilNextProcess());
 }
 
+// A receiver estimating with the cheapest estimator, which never gets to send
+// an estimate in these tests.
+AlphaCCConfig ReceiverEstimatingConfig(
+    AlphaCCConfig::BweTransportFeedbackOption transport_feedback_option) {
+  AlphaCCConfig config{};
+  config.bwe_location = AlphaCCConfig::BweLocation::kReceiver;
+  config.bwe_estimator_option = AlphaCCConfig::BweEstimatorOption::kReceiveRate;
+  config.bwe_feedback_duration_ms = 60 * 60 * 1000;
+  config.bwe_transport_feedback_option = transport_feedback_option;
+  config.bwe_transport_feedback_interval_ms = kReducedSendIntervalMs;
+  return config;
+}
+
+TEST(RemoteEstimatorProxyTransportFeedbackOptionTest,
+     ReducedFeedbackIgnoresBitrate) {
+  const AlphaCCConfig config = ReceiverEstimatingConfig(
+      AlphaCCConfig::BweTransportFeedbackOption::kReduced);
+  ScopedAlphaCCConfig scoped_config(&config);
+  FieldTrialBasedConfig field_trial_config;
+  SimulatedClock clock(0);
+  ::testing::StrictMock<MockTransportFeedbackSender> router;
+  RemoteEstimatorProxy proxy(&clock, &router, &field_trial_config, nullptr);
+
+  proxy.Process();
+  EXPECT_EQ(kReducedSendIntervalMs, proxy.TimeUntilNextProcess());
+  proxy.OnBitrateChanged(300000);
+  EXPECT_EQ(kReducedSendIntervalMs, proxy.TimeUntilNextProcess());
+}
+
+TEST(RemoteEstimatorProxyTransportFeedbackOptionTest, UsesTheConfigOfItsCall) {
+  const AlphaCCConfig config = ReceiverEstimatingConfig(
+      AlphaCCConfig::BweTransportFeedbackOption::kReduced);
+  AlphaCCConfig other_config = config;
+  other_config.bwe_transport_feedback_interval_ms = 2 * kReducedSendIntervalMs;
+  FieldTrialBasedConfig field_trial_config;
+  SimulatedClock clock(0);
+  ::testing::StrictMock<MockTransportFeedbackSender> router;
+  RemoteEstimatorProxy proxy(&clock, &router, &field_trial_config, nullptr,
+                             /*task_queue_factory=*/nullptr,
+                             /*event_log=*/nullptr, &config);
+  RemoteEstimatorProxy other_proxy(&clock, &router, &field_trial_config,
+                                   nullptr, /*task_queue_factory=*/nullptr,
+                                   /*event_log=*/nullptr, &other_config);
+
+  proxy.Process();
+  other_proxy.Process();
+  EXPECT_EQ(kReducedSendIntervalMs, proxy.TimeUntilNextProcess());
+  EXPECT_EQ(2 * kReducedSendIntervalMs, other_proxy.TimeUntilNextProcess());
+}
+
+TEST(RemoteEstimatorProxyTransportFeedbackOptionTest,
+     LossOnlyFeedbackHasNoTimestamps) {
+  const AlphaCCConfig config = ReceiverEstimatingConfig(
+      AlphaCCConfig::BweTransportFeedbackOption::kLossOnly);
+  ScopedAlphaCCConfig scoped_config(&config);
+  FieldTrialBasedConfig field_trial_config;
+  SimulatedClock clock(0);
+  ::testing::StrictMock<MockTransportFeedbackSender> router;
+  RemoteEstimatorProxy proxy(&clock, &router, &field_trial_config, nullptr);
+
+  for (uint16_t seq : {kBaseSeq, static_cast<uint16_t>(kBaseSeq + 2)}) {
+    RTPHeader header;
+    header.extension.hasTransportSequenceNumber = true;
+    header.extension.transportSequenceNumber = seq;
+    header.ssrc = kMediaSsrc;
+    proxy.IncomingPacket(kBaseTimeMs + seq, kDefaultPacketSize, header);
+  }
+
+  EXPECT_CALL(router, SendCombinedRtcpPacket)
+      .WillOnce(Invoke(
+          [](std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets) {
+            rtcp::TransportFeedback* feedback_packet =
+                static_cast<rtcp::TransportFeedback*>(
+                    feedback_packets[0].get());
+            EXPECT_FALSE(feedback_packet->IncludeTimestamps());
+            EXPECT_THAT(SequenceNumbers(*feedback_packet),
+                        ElementsAre(kBaseSeq, kBaseSeq + 2));
+            return true;
+          }));
+  clock.AdvanceTimeMilliseconds(kReducedSendIntervalMs);
+  proxy.Process();
+}
+
+TEST(RemoteEstimatorProxyBwePiggybackTest,
+     SendsWaitingEstimateWithoutNewPackets) {
+  AlphaCCConfig config = ReceiverEstimatingConfig(
+      AlphaCCConfig::BweTransportFeedbackOption::kFull);
+  config.bwe_feedback_duration_ms = 10;
+  // Every estimate waits for the next periodic feedback.
+  config.bwe_piggyback_tolerance_ms = 60 * 60 * 1000;
+  FieldTrialBasedConfig field_trial_config;
+  // Runs the estimator's task queue in simulated time as well.
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(0));
+  ::testing::NiceMock<MockTransportFeedbackSender> router;
+  // BWE packets sent without a transport feedback packet.
+  int standalone_bwe_packets = 0;
+  ON_CALL(router, SendCombinedRtcpPacket)
+      .WillByDefault(Invoke(
+          [&](std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets) {
+            if (packets.size() == 1 &&
+                dynamic_cast<rtcp::AlphaCcBwe*>(packets[0].get())) {
+              ++standalone_bwe_packets;
+            }
+            return true;
+          }));
+  RemoteEstimatorProxy proxy(time_controller.GetClock(), &router,
+                             &field_trial_config, nullptr,
+                             time_controller.GetTaskQueueFactory(),
+                             /*event_log=*/nullptr, &config);
+
+  RTPHeader header;
+  header.extension.hasTransportSequenceNumber = true;
+  header.extension.transportSequenceNumber = kBaseSeq;
+  header.ssrc = kMediaSsrc;
+  proxy.IncomingPacket(kBaseTimeMs, kDefaultPacketSize, header);
+  time_controller.AdvanceTime(TimeDelta::Millis(kDefaultSendIntervalMs));
+  proxy.Process();
+  ASSERT_EQ(standalone_bwe_packets, 0);
+
+  // No more packets arrive, so the periodic feedback has nothing to carry the
+  // estimates along with.
+  time_controller.AdvanceTime(TimeDelta::Millis(kDefaultSendIntervalMs));
+  proxy.Process();
+  EXPECT_EQ(standalone_bwe_packets, 1);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Tests for the extended protocol where the feedback is explicitly requested
 // by the sender.
@@ -667,5 +831,33 @@ TEST_F(RemoteEstimatorProxyTest, SendTransportFeedbackAndNetworkStateUpdate) {
   Process();
 }
 
+TEST_F(RemoteEstimatorProxyTest, ReportsQueueingDelayTrendOnProcess) {
+  ::testing::StrictMock<MockQueueingDelayTrendObserver> observer;
+  proxy_.SetQueueingDelayTrendObserver(&observer);
+  // The queue grows by 100 ms per second.
+  for (int i = 0; i < 100; ++i) {
+    int64_t arrival_time_ms = kBaseTimeMs + i * 5;
+    int64_t send_time_ms = arrival_time_ms - 20 - i * 5 / 10;
+    proxy_.IncomingPacket(
+        arrival_time_ms, kDefaultPacketSize,
+        CreateHeader(kBaseSeq + i, absl::nullopt,
+                     AbsoluteSendTime::MsTo24Bits(send_time_ms)));
+  }
+  clock_.AdvanceTimeMilliseconds(kBaseTimeMs + 500);
+
+  EXPECT_CALL(router_, SendCombinedRtcpPacket).WillOnce(Return(true));
+  EXPECT_CALL(observer, OnQueueingDelayTrend)
+      .WillOnce([](const QueueingDelayTrend& trend) {
+        EXPECT_NEAR(trend.slope_ms_per_s, 100, 5);
+        EXPECT_GT(trend.confidence, 0.9);
+      });
+  Process();
+
+  proxy_.SetQueueingDelayTrendObserver(nullptr);
+  EXPECT_CALL(router_, SendCombinedRtcpPacket).WillOnce(Return(true));
+  IncomingPacket(kBaseSeq + 100, kBaseTimeMs + 500);
+  Process();
+}
+
 }  // namespace
 }  // namespace webrtc
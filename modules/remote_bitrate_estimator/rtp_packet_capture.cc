@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/rtp_packet_capture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/string_encode.h"
+
+namespace webrtc {
+namespace {
+
+// Enough for the anomaly window of a few Mbps of video.
+constexpr size_t kMaxHistoryRecords = 4096;
+
+StatCollect::CaptureRecord ToRecord(int64_t arrival_time_ms,
+                                    size_t payload_size,
+                                    const RTPHeader& header) {
+  StatCollect::CaptureRecord record;
+  record.arrivalTimeMs = arrival_time_ms;
+  record.rtpTimestamp = header.timestamp;
+  record.ssrc = header.ssrc;
+  record.absoluteSendTime = header.extension.absoluteSendTime;
+  record.payloadSize = static_cast<uint32_t>(payload_size);
+  record.sequenceNumber = header.sequenceNumber;
+  record.transportSequenceNumber = header.extension.transportSequenceNumber;
+  record.headerLength = static_cast<uint16_t>(header.headerLength);
+  record.paddingLength = static_cast<uint16_t>(header.paddingLength);
+  record.payloadType = header.payloadType;
+  record.flags = 0;
+  if (header.markerBit)
+    record.flags |= SC_CAPTURE_FLAG_MARKER;
+  if (header.extension.hasTransportSequenceNumber)
+    record.flags |= SC_CAPTURE_FLAG_TRANSPORT_SEQUENCE_NUMBER;
+  if (header.extension.hasAbsoluteSendTime)
+    record.flags |= SC_CAPTURE_FLAG_ABSOLUTE_SEND_TIME;
+  return record;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<RtpPacketCapture> RtpPacketCapture::Create(
+    const AlphaCCConfig& config,
+    uint32_t session_id) {
+  if (config.packet_capture_path.empty())
+    return nullptr;
+  // Sampled per call, so that a sampled call is captured over its whole
+  // length.
+  const bool capture_all = static_cast<int>(rtc::CreateRandomId() % 100) <
+                           config.packet_capture_session_percent;
+  if (!capture_all && config.packet_capture_anomaly_percent <= 0)
+    return nullptr;
+  const std::string path =
+      config.packet_capture_path + "." + rtc::ToString(session_id);
+  auto ring = std::make_unique<StatCollect::MappedCaptureRing>(
+      path, config.packet_capture_records);
+  if (!ring->IsOpen()) {
+    RTC_LOG(LS_ERROR) << "Failed to create the packet capture file " << path;
+    return nullptr;
+  }
+  RTC_LOG(LS_INFO) << "Capturing "
+                   << (capture_all ? "every packet" : "the anomalies")
+                   << " into " << path;
+  return std::make_unique<RtpPacketCapture>(
+      std::move(ring), capture_all, config.packet_capture_anomaly_percent,
+      config.packet_capture_anomaly_window_ms);
+}
+
+RtpPacketCapture::RtpPacketCapture(
+    std::unique_ptr<StatCollect::MappedCaptureRing> ring,
+    bool capture_all,
+    int anomaly_percent,
+    int64_t anomaly_window_ms)
+    : ring_(std::move(ring)),
+      capture_all_(capture_all),
+      anomaly_percent_(anomaly_percent),
+      anomaly_window_ms_(anomaly_window_ms),
+      history_(capture_all || anomaly_percent <= 0 ? 0 : kMaxHistoryRecords) {
+  RTC_DCHECK(ring_);
+}
+
+RtpPacketCapture::~RtpPacketCapture() = default;
+
+void RtpPacketCapture::OnPacket(int64_t arrival_time_ms,
+                                size_t payload_size,
+                                const RTPHeader& header) {
+  StatCollect::CaptureRecord record =
+      ToRecord(arrival_time_ms, payload_size, header);
+  if (capture_all_) {
+    ring_->Record(record);
+  } else if (arrival_time_ms <= capture_until_ms_) {
+    record.flags |= SC_CAPTURE_FLAG_TRIGGERED;
+    ring_->Record(record);
+  } else if (!history_.empty()) {
+    history_[history_next_] = record;
+    history_next_ = (history_next_ + 1) % history_.size();
+    history_size_ = std::min(history_size_ + 1, history_.size());
+  }
+}
+
+void RtpPacketCapture::OnEstimate(int64_t now_ms, float estimate_bps) {
+  const float last_estimate_bps = last_estimate_bps_;
+  last_estimate_bps_ = estimate_bps;
+  if (capture_all_ || anomaly_percent_ <= 0 || last_estimate_bps <= 0)
+    return;
+  if (std::fabs(estimate_bps - last_estimate_bps) * 100 <
+      anomaly_percent_ * last_estimate_bps) {
+    return;
+  }
+  CaptureHistory(now_ms - anomaly_window_ms_);
+  capture_until_ms_ = std::max(capture_until_ms_, now_ms + anomaly_window_ms_);
+}
+
+void RtpPacketCapture::CaptureHistory(int64_t since_ms) {
+  if (history_size_ == 0)
+    return;
+  size_t index =
+      (history_next_ + history_.size() - history_size_) % history_.size();
+  for (; history_size_ > 0; --history_size_) {
+    StatCollect::CaptureRecord& record = history_[index];
+    if (record.arrivalTimeMs >= since_ms) {
+      record.flags |= SC_CAPTURE_FLAG_TRIGGERED;
+      ring_->Record(record);
+    }
+    index = (index + 1) % history_.size();
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_RTP_PACKET_CAPTURE_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_RTP_PACKET_CAPTURE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/alphacc_config.h"
+#include "api/rtp_headers.h"
+#include "modules/third_party/statcollect/StatRecorder.h"
+
+namespace webrtc {
+
+// Captures the headers of the received RTP packets of a call into a
+// StatCollect::MappedCaptureRing, for training data on production traffic,
+// see AlphaCCConfig::packet_capture_path. A sampled call captures every
+// packet. The others keep the latest packets in memory and only capture those
+// within the anomaly window of an estimate that changed abruptly, and the ones
+// following it. A packet costs a copy of its header fields either way.
+class RtpPacketCapture {
+ public:
+  // Returns null if |config| doesn't capture the call with id |session_id|,
+  // or if its ring file can't be created.
+  static std::unique_ptr<RtpPacketCapture> Create(const AlphaCCConfig& config,
+                                                  uint32_t session_id);
+
+  // Captures every packet if |capture_all|, or those around the anomalies
+  // otherwise. |anomaly_percent| 0 disables the anomalies.
+  RtpPacketCapture(std::unique_ptr<StatCollect::MappedCaptureRing> ring,
+                   bool capture_all,
+                   int anomaly_percent,
+                   int64_t anomaly_window_ms);
+  ~RtpPacketCapture();
+
+  RtpPacketCapture(const RtpPacketCapture&) = delete;
+  RtpPacketCapture& operator=(const RtpPacketCapture&) = delete;
+
+  void OnPacket(int64_t arrival_time_ms,
+                size_t payload_size,
+                const RTPHeader& header);
+  // Called with every estimate, on the clock of the arrival times.
+  void OnEstimate(int64_t now_ms, float estimate_bps);
+
+ private:
+  // Writes the records of |history_| received since |since_ms|, oldest first.
+  void CaptureHistory(int64_t since_ms);
+
+  const std::unique_ptr<StatCollect::MappedCaptureRing> ring_;
+  const bool capture_all_;
+  const int anomaly_percent_;
+  const int64_t anomaly_window_ms_;
+  float last_estimate_bps_ = 0;
+  // Packets arriving until then are captured, set by an anomaly.
+  int64_t capture_until_ms_ = -1;
+  // Latest packets not captured, a ring of |history_size_| records, the next
+  // one going to |history_next_|.
+  std::vector<StatCollect::CaptureRecord> history_;
+  size_t history_next_ = 0;
+  size_t history_size_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_RTP_PACKET_CAPTURE_H_
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/rtp_packet_capture.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc = 1234;
+constexpr int64_t kPacketIntervalMs = 10;
+
+RTPHeader VideoHeader(uint16_t sequence_number) {
+  RTPHeader header;
+  header.markerBit = sequence_number % 2 == 0;
+  header.payloadType = 96;
+  header.sequenceNumber = sequence_number;
+  header.timestamp = sequence_number * 900u;
+  header.ssrc = kSsrc;
+  header.headerLength = 24;
+  header.extension.hasTransportSequenceNumber = true;
+  header.extension.transportSequenceNumber = sequence_number + 1;
+  return header;
+}
+
+class RtpPacketCaptureTest : public ::testing::Test {
+ protected:
+  RtpPacketCaptureTest()
+      : file_path_(test::TempFilename(test::OutputPath(), "capture")) {}
+  ~RtpPacketCaptureTest() override { remove(file_path_.c_str()); }
+
+  std::unique_ptr<RtpPacketCapture> CreateCapture(size_t capacity,
+                                                  bool capture_all,
+                                                  int anomaly_percent) {
+    auto ring =
+        std::make_unique<StatCollect::MappedCaptureRing>(file_path_, capacity);
+    EXPECT_TRUE(ring->IsOpen());
+    return std::make_unique<RtpPacketCapture>(std::move(ring), capture_all,
+                                              anomaly_percent,
+                                              /*anomaly_window_ms=*/100);
+  }
+
+  // Reads back the file of a capture that was destroyed, oldest record
+  // first.
+  std::vector<StatCollect::CaptureRecord> ReadRecords() {
+    std::vector<StatCollect::CaptureRecord> records;
+    FILE* file = fopen(file_path_.c_str(), "rb");
+    EXPECT_TRUE(file);
+    if (!file)
+      return records;
+    StatCollect::CaptureRingHeader header;
+    EXPECT_EQ(fread(&header, sizeof(header), 1, file), 1u);
+    EXPECT_EQ(header.magic, static_cast<uint32_t>(SC_CAPTURE_MAGIC));
+    EXPECT_EQ(header.recordSize, sizeof(StatCollect::CaptureRecord));
+    std::vector<StatCollect::CaptureRecord> slots(header.capacity);
+    EXPECT_EQ(fread(slots.data(), sizeof(StatCollect::CaptureRecord),
+                    slots.size(), file),
+              slots.size());
+    fclose(file);
+    const uint64_t records_written = header.recordsWritten;
+    for (uint64_t i = records_written > slots.size()
+                          ? records_written - slots.size()
+                          : 0;
+         i < records_written; ++i) {
+      records.push_back(slots[i % slots.size()]);
+    }
+    return records;
+  }
+
+  const std::string file_path_;
+};
+
+TEST_F(RtpPacketCaptureTest, SampledCallKeepsTheLatestPackets) {
+  auto capture = CreateCapture(/*capacity=*/4, /*capture_all=*/true,
+                               /*anomaly_percent=*/0);
+  for (uint16_t i = 0; i < 6; ++i)
+    capture->OnPacket(i * kPacketIntervalMs, 1000 + i, VideoHeader(i));
+  capture.reset();
+
+  std::vector<StatCollect::CaptureRecord> records = ReadRecords();
+  ASSERT_EQ(records.size(), 4u);
+  for (uint16_t i = 0; i < 4; ++i) {
+    const StatCollect::CaptureRecord& record = records[i];
+    const uint16_t sequence_number = i + 2;
+    EXPECT_EQ(record.sequenceNumber, sequence_number);
+    EXPECT_EQ(record.arrivalTimeMs, sequence_number * kPacketIntervalMs);
+    EXPECT_EQ(record.payloadSize, 1000u + sequence_number);
+    EXPECT_EQ(record.rtpTimestamp, sequence_number * 900u);
+    EXPECT_EQ(record.ssrc, kSsrc);
+    EXPECT_EQ(record.headerLength, 24);
+    EXPECT_EQ(record.payloadType, 96);
+    EXPECT_EQ(record.transportSequenceNumber, sequence_number + 1);
+    EXPECT_EQ(record.flags,
+              SC_CAPTURE_FLAG_TRANSPORT_SEQUENCE_NUMBER |
+                  (sequence_number % 2 == 0 ? SC_CAPTURE_FLAG_MARKER : 0));
+  }
+}
+
+TEST_F(RtpPacketCaptureTest, CapturesTheWindowAroundAnAnomaly) {
+  auto capture = CreateCapture(/*capacity=*/1000, /*capture_all=*/false,
+                               /*anomaly_percent=*/50);
+  for (uint16_t i = 0; i < 100; ++i) {
+    const int64_t now_ms = i * kPacketIntervalMs;
+    capture->OnPacket(now_ms, 1000, VideoHeader(i));
+    if (now_ms == 500 || now_ms == 600)
+      capture->OnEstimate(now_ms, 1000000);
+    if (now_ms == 700)
+      capture->OnEstimate(now_ms, 300000);
+  }
+  capture.reset();
+
+  // 100 ms before and after the anomaly.
+  std::vector<StatCollect::CaptureRecord> records = ReadRecords();
+  ASSERT_EQ(records.size(), 21u);
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i].arrivalTimeMs,
+              600 + static_cast<int64_t>(i) * kPacketIntervalMs);
+    EXPECT_TRUE(records[i].flags & SC_CAPTURE_FLAG_TRIGGERED);
+  }
+}
+
+TEST_F(RtpPacketCaptureTest, CapturesNothingWithoutAnomaly) {
+  auto capture = CreateCapture(/*capacity=*/1000, /*capture_all=*/false,
+                               /*anomaly_percent=*/50);
+  for (uint16_t i = 0; i < 100; ++i) {
+    const int64_t now_ms = i * kPacketIntervalMs;
+    capture->OnPacket(now_ms, 1000, VideoHeader(i));
+    if (now_ms % 100 == 0)
+      capture->OnEstimate(now_ms, 1000000 + 2000 * i);
+  }
+  capture.reset();
+
+  EXPECT_TRUE(ReadRecords().empty());
+}
+
+TEST(RtpPacketCaptureCreateTest, CapturesNothingUnlessConfigured) {
+  AlphaCCConfig config;
+  EXPECT_FALSE(RtpPacketCapture::Create(config, 1));
+  config.packet_capture_path = "capture";
+  EXPECT_FALSE(RtpPacketCapture::Create(config, 1));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+#
+#  Use of this source code is governed by a BSD-style license
+#  that can be found in the LICENSE file in the root of the source
+#  tree. An additional intellectual property rights grant can be found
+#  in the file PATENTS.  All contributing project authors may
+#  be found in the AUTHORS file in the root of the source tree.
+
+"""Converts an ONNX model to the format read by bwe_model::BweModel.
+
+Only a chain of Gemm, GRU, LSTM, Relu, Sigmoid and Tanh nodes is supported,
+shape-only nodes such as Reshape or Squeeze are skipped. Weights are
+quantized to int8 with one scale per row.
+
+  python3 onnx_to_bwe_model.py --input model.onnx --output model.bwem
+"""
+
+import argparse
+import struct
+import sys
+
+import numpy as np
+import onnx
+from onnx import numpy_helper
+
+_DENSE = 0
+_ACTIVATION = 1
+_GRU = 2
+_LSTM = 3
+
+_ACTIVATIONS = {'Relu': 1, 'Sigmoid': 2, 'Tanh': 3}
+_SKIPPED_OPS = {'Identity', 'Reshape', 'Squeeze', 'Unsqueeze', 'Flatten'}
+
+
+class _Writer(object):
+
+  def __init__(self):
+    self.data = bytearray()
+
+  def Uint32(self, value):
+    self.data += struct.pack('<I', value)
+
+  def Floats(self, values):
+    values = np.asarray(values, dtype='<f4').ravel()
+    self.data += values.tobytes()
+
+  def Matrix(self, matrix):
+    matrix = np.asarray(matrix, dtype=np.float32)
+    if matrix.ndim != 2:
+      raise ValueError('Expected a matrix, got shape %s' % (matrix.shape,))
+    scales = np.abs(matrix).max(axis=1) / 127
+    scales[scales == 0] = 1
+    values = np.round(matrix / scales[:, None]).clip(-127, 127)
+    self.Uint32(matrix.shape[0])
+    self.Uint32(matrix.shape[1])
+    self.Floats(scales)
+    self.data += values.astype(np.int8).tobytes()
+
+
+def _Attributes(node):
+  return {a.name: onnx.helper.get_attribute_value(a) for a in node.attribute}
+
+
+def _RecurrentWeights(node, initializers, gates):
+  """Returns W, R and B of a single direction GRU or LSTM node."""
+  attributes = _Attributes(node)
+  if attributes.get('direction', b'forward') != b'forward':
+    raise ValueError('%s: only forward recurrent layers are supported' %
+                     node.name)
+  if 'activations' in attributes or 'clip' in attributes:
+    raise ValueError('%s: only the default activations are supported' %
+                     node.name)
+  w = initializers[node.input[1]][0]
+  r = initializers[node.input[2]][0]
+  if len(node.input) > 3 and node.input[3]:
+    b = initializers[node.input[3]][0]
+  else:
+    b = np.zeros(2 * w.shape[0], dtype=np.float32)
+  # sequence_lens does not matter when running one step at a time.
+  if any(node.input[5:]):
+    raise ValueError('%s: initial states and peepholes are not supported' %
+                     node.name)
+  if w.shape[0] != gates * r.shape[1]:
+    raise ValueError('%s: unexpected weight shape' % node.name)
+  return w, r, b
+
+
+def Convert(model):
+  graph = model.graph
+  initializers = {i.name: numpy_helper.to_array(i) for i in graph.initializer}
+  inputs = [i for i in graph.input if i.name not in initializers]
+  if len(inputs) != 1:
+    raise ValueError('Expected a single input, got %d' % len(inputs))
+  input_size = inputs[0].type.tensor_type.shape.dim[-1].dim_value
+
+  layers = _Writer()
+  num_layers = 0
+  output_size = input_size
+  for node in graph.node:
+    if node.op_type in _SKIPPED_OPS:
+      continue
+    if node.op_type == 'Gemm':
+      attributes = _Attributes(node)
+      if attributes.get('alpha', 1.0) != 1.0 or attributes.get(
+          'beta', 1.0) != 1.0 or attributes.get('transA', 0):
+        raise ValueError('%s: only plain Gemm is supported' % node.name)
+      weights = initializers[node.input[1]]
+      if not attributes.get('transB', 0):
+        weights = weights.T
+      if len(node.input) > 2 and node.input[2]:
+        bias = initializers[node.input[2]]
+      else:
+        bias = np.zeros(weights.shape[0], dtype=np.float32)
+      layers.Uint32(_DENSE)
+      layers.Matrix(weights)
+      layers.Floats(np.broadcast_to(bias, (weights.shape[0],)))
+      output_size = weights.shape[0]
+    elif node.op_type in _ACTIVATIONS:
+      layers.Uint32(_ACTIVATION)
+      layers.Uint32(output_size)
+      layers.Uint32(_ACTIVATIONS[node.op_type])
+    elif node.op_type == 'GRU':
+      if _Attributes(node).get('linear_before_reset', 0):
+        raise ValueError('%s: linear_before_reset is not supported' %
+                         node.name)
+      w, r, b = _RecurrentWeights(node, initializers, 3)
+      layers.Uint32(_GRU)
+      layers.Matrix(w)
+      layers.Matrix(r)
+      layers.Floats(b)
+      output_size = r.shape[1]
+    elif node.op_type == 'LSTM':
+      w, r, b = _RecurrentWeights(node, initializers, 4)
+      layers.Uint32(_LSTM)
+      layers.Matrix(w)
+      layers.Matrix(r)
+      layers.Floats(b)
+      output_size = r.shape[1]
+    else:
+      raise ValueError('%s: unsupported operator %s' %
+                       (node.name, node.op_type))
+    num_layers += 1
+
+  header = _Writer()
+  header.data += b'BWEM'
+  header.Uint32(1)
+  header.Uint32(input_size)
+  header.Uint32(num_layers)
+  return bytes(header.data + layers.data)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--input', required=True, help='ONNX model')
+  parser.add_argument('--output', required=True, help='BweModel file')
+  args = parser.parse_args()
+  try:
+    data = Convert(onnx.load(args.input))
+  except (KeyError, ValueError) as e:
+    sys.stderr.write('Can\'t convert %s: %s\n' % (args.input, e))
+    return 1
+  with open(args.output, 'wb') as f:
+    f.write(data)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
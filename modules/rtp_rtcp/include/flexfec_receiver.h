@@ -15,6 +15,7 @@
 
 #include <memory>
 
+#include "modules/include/module_fec_types.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/include/ulpfec_receiver.h"
 #include "modules/rtp_rtcp/source/forward_error_correction.h"
@@ -35,6 +36,12 @@ class FlexfecReceiver {
                   uint32_t ssrc,
                   uint32_t protected_media_ssrc,
                   RecoveredPacketReceiver* recovered_packet_receiver);
+  // |fec_scheme| must match the one used by the FlexfecSender.
+  FlexfecReceiver(Clock* clock,
+                  uint32_t ssrc,
+                  uint32_t protected_media_ssrc,
+                  RecoveredPacketReceiver* recovered_packet_receiver,
+                  FecScheme fec_scheme);
   ~FlexfecReceiver();
 
   // Inserts a received packet (can be either media or FlexFEC) into the
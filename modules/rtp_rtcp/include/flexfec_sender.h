@@ -17,6 +17,7 @@
 
 #include "api/array_view.h"
 #include "api/rtp_parameters.h"
+#include "modules/include/module_fec_types.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
@@ -43,6 +44,15 @@ class FlexfecSender : public VideoFecGenerator {
                 rtc::ArrayView<const RtpExtensionSize> extension_sizes,
                 const RtpState* rtp_state,
                 Clock* clock);
+  FlexfecSender(int payload_type,
+                uint32_t ssrc,
+                uint32_t protected_media_ssrc,
+                const std::string& mid,
+                const std::vector<RtpExtension>& rtp_header_extensions,
+                rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+                const RtpState* rtp_state,
+                Clock* clock,
+                FecScheme fec_scheme);
   ~FlexfecSender();
 
   FecType GetFecType() const override {
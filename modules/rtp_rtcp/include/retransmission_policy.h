@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_INCLUDE_RETRANSMISSION_POLICY_H_
+#define MODULES_RTP_RTCP_INCLUDE_RETRANSMISSION_POLICY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace webrtc {
+
+// Decides which of the packets NACKed by the receiver are retransmitted, and
+// in which order. Called on the thread that handles incoming RTCP.
+class RetransmissionPolicy {
+ public:
+  // A NACKed packet that is still in the packet history.
+  struct Candidate {
+    uint16_t sequence_number = 0;
+    bool is_key_frame = false;
+    int64_t capture_time_ms = 0;
+    size_t packet_size = 0;
+    // Number of times retransmitted so far, not counting the first send.
+    size_t times_retransmitted = 0;
+  };
+
+  virtual ~RetransmissionPolicy() = default;
+
+  // Reorders |candidates| into the order they should be retransmitted in, and
+  // removes the ones that shouldn't be. |candidates| comes in the order of the
+  // NACK. The retransmission rate limiter still applies to the ones kept.
+  virtual void Prioritize(int64_t now_ms,
+                          int64_t rtt_ms,
+                          std::vector<Candidate>* candidates) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_INCLUDE_RETRANSMISSION_POLICY_H_
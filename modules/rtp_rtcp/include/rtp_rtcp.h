@@ -41,8 +41,10 @@ class FrameEncryptorInterface;
 class RateLimiter;
 class ReceiveStatisticsProvider;
 class RemoteBitrateEstimator;
+class RetransmissionPolicy;
 class RtcEventLog;
 class RTPSender;
+class TaskQueueBase;
 class Transport;
 class VideoBitrateAllocationObserver;
 
@@ -112,6 +114,10 @@ class RtpRtcp : public Module, public RtcpFeedbackSenderInterface {
     RtcEventLog* event_log = nullptr;
     SendPacketObserver* send_packet_observer = nullptr;
     RateLimiter* retransmission_rate_limiter = nullptr;
+    // Picks and orders the NACKed packets to retransmit. If not set, a policy
+    // is created from the WebRTC-SelectiveRetransmission field trial, and if
+    // that's off every NACKed packet is retransmitted, in order.
+    RetransmissionPolicy* retransmission_policy = nullptr;
     StreamDataCountersCallback* rtp_stats_callback = nullptr;
 
     int rtcp_report_interval_ms = 0;
@@ -140,6 +146,12 @@ class RtpRtcp : public Module, public RtcpFeedbackSenderInterface {
     // defaults to  webrtc::FieldTrialBasedConfig.
     const WebRtcKeyValueConfig* field_trials = nullptr;
 
+    // If set, the module does its periodic work in delayed tasks on
+    // |task_queue|, scheduled for when the work is due, and must not be
+    // registered with a ProcessThread. The module must be created and
+    // destroyed on |task_queue|.
+    TaskQueueBase* task_queue = nullptr;
+
     // SSRCs for media and retransmission, respectively.
     // FlexFec SSRC is fetched from |flexfec_sender|.
     uint32_t local_media_ssrc = 0;
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/deadline_retransmission_policy.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/field_trial_units.h"
+
+namespace webrtc {
+
+std::unique_ptr<DeadlineRetransmissionPolicy>
+DeadlineRetransmissionPolicy::CreateFromFieldTrial(
+    const WebRtcKeyValueConfig& field_trials) {
+  FieldTrialOptional<TimeDelta> max_delay("max_delay");
+  ParseFieldTrial({&max_delay},
+                  field_trials.Lookup("WebRTC-SelectiveRetransmission"));
+  if (!max_delay || *max_delay <= TimeDelta::Zero())
+    return nullptr;
+  return std::make_unique<DeadlineRetransmissionPolicy>(*max_delay);
+}
+
+DeadlineRetransmissionPolicy::DeadlineRetransmissionPolicy(
+    TimeDelta max_frame_delay)
+    : max_frame_delay_(max_frame_delay) {
+  RTC_DCHECK_GT(max_frame_delay_, TimeDelta::Zero());
+}
+
+DeadlineRetransmissionPolicy::~DeadlineRetransmissionPolicy() = default;
+
+void DeadlineRetransmissionPolicy::Prioritize(
+    int64_t now_ms,
+    int64_t rtt_ms,
+    std::vector<Candidate>* candidates) {
+  const int64_t oldest_useful_capture_time_ms =
+      now_ms + rtt_ms / 2 - max_frame_delay_.ms();
+  candidates->erase(
+      std::remove_if(candidates->begin(), candidates->end(),
+                     [&](const Candidate& candidate) {
+                       return !candidate.is_key_frame &&
+                              candidate.capture_time_ms <
+                                  oldest_useful_capture_time_ms;
+                     }),
+      candidates->end());
+  std::stable_partition(
+      candidates->begin(), candidates->end(),
+      [](const Candidate& candidate) { return candidate.is_key_frame; });
+}
+
+}  // namespace webrtc
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_DEADLINE_RETRANSMISSION_POLICY_H_
+#define MODULES_RTP_RTCP_SOURCE_DEADLINE_RETRANSMISSION_POLICY_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/transport/webrtc_key_value_config.h"
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/include/retransmission_policy.h"
+
+namespace webrtc {
+
+// Retransmits the packets of key frames first, since every frame after them
+// depends on them. Skips the packets of delta frames that would reach the
+// receiver too late to be played out: a retransmission arrives about half an
+// RTT after it's sent, so packets captured more than |max_frame_delay| minus
+// that ago aren't worth the bandwidth.
+class DeadlineRetransmissionPolicy : public RetransmissionPolicy {
+ public:
+  // Returns a policy if enabled by the field trial
+  // "WebRTC-SelectiveRetransmission/max_delay:<duration>/", else nullptr.
+  static std::unique_ptr<DeadlineRetransmissionPolicy> CreateFromFieldTrial(
+      const WebRtcKeyValueConfig& field_trials);
+
+  explicit DeadlineRetransmissionPolicy(TimeDelta max_frame_delay);
+  ~DeadlineRetransmissionPolicy() override;
+
+  void Prioritize(int64_t now_ms,
+                  int64_t rtt_ms,
+                  std::vector<Candidate>* candidates) override;
+
+ private:
+  const TimeDelta max_frame_delay_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_DEADLINE_RETRANSMISSION_POLICY_H_
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/deadline_retransmission_policy.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int64_t kNowMs = 10000;
+constexpr int64_t kRttMs = 100;
+constexpr TimeDelta kMaxFrameDelay = TimeDelta::Millis(300);
+
+class FieldTrialConfig : public WebRtcKeyValueConfig {
+ public:
+  explicit FieldTrialConfig(std::string value) : value_(std::move(value)) {}
+  std::string Lookup(absl::string_view key) const override {
+    return key == "WebRTC-SelectiveRetransmission" ? value_ : "";
+  }
+
+ private:
+  const std::string value_;
+};
+
+RetransmissionPolicy::Candidate CreateCandidate(uint16_t sequence_number,
+                                                bool is_key_frame,
+                                                int64_t capture_time_ms) {
+  RetransmissionPolicy::Candidate candidate;
+  candidate.sequence_number = sequence_number;
+  candidate.is_key_frame = is_key_frame;
+  candidate.capture_time_ms = capture_time_ms;
+  return candidate;
+}
+
+std::vector<uint16_t> SequenceNumbers(
+    const std::vector<RetransmissionPolicy::Candidate>& candidates) {
+  std::vector<uint16_t> sequence_numbers;
+  for (const auto& candidate : candidates)
+    sequence_numbers.push_back(candidate.sequence_number);
+  return sequence_numbers;
+}
+
+TEST(DeadlineRetransmissionPolicyTest, RetransmitsKeyFramePacketsFirst) {
+  DeadlineRetransmissionPolicy policy(kMaxFrameDelay);
+  std::vector<RetransmissionPolicy::Candidate> candidates = {
+      CreateCandidate(1, false, kNowMs - 10),
+      CreateCandidate(2, true, kNowMs - 20),
+      CreateCandidate(3, false, kNowMs - 10),
+      CreateCandidate(4, true, kNowMs - 20)};
+
+  policy.Prioritize(kNowMs, kRttMs, &candidates);
+  EXPECT_THAT(SequenceNumbers(candidates), ElementsAre(2, 4, 1, 3));
+}
+
+TEST(DeadlineRetransmissionPolicyTest, SkipsDeltaFramePacketsTooLateToPlay) {
+  DeadlineRetransmissionPolicy policy(kMaxFrameDelay);
+  // Arrives 50 ms from now, so only frames captured within the last 250 ms
+  // can still be played out.
+  std::vector<RetransmissionPolicy::Candidate> candidates = {
+      CreateCandidate(1, false, kNowMs - 251),
+      CreateCandidate(2, false, kNowMs - 250),
+      CreateCandidate(3, true, kNowMs - 1000)};
+
+  policy.Prioritize(kNowMs, kRttMs, &candidates);
+  EXPECT_THAT(SequenceNumbers(candidates), ElementsAre(3, 2));
+}
+
+TEST(DeadlineRetransmissionPolicyTest, CreatedOnlyWithFieldTrial) {
+  EXPECT_FALSE(DeadlineRetransmissionPolicy::CreateFromFieldTrial(
+      FieldTrialConfig("")));
+  EXPECT_FALSE(DeadlineRetransmissionPolicy::CreateFromFieldTrial(
+      FieldTrialConfig("max_delay:0ms")));
+  EXPECT_TRUE(DeadlineRetransmissionPolicy::CreateFromFieldTrial(
+      FieldTrialConfig("max_delay:400ms")));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -43,10 +43,25 @@ FlexfecReceiver::FlexfecReceiver(
     uint32_t ssrc,
     uint32_t protected_media_ssrc,
     RecoveredPacketReceiver* recovered_packet_receiver)
+    : FlexfecReceiver(clock,
+                      ssrc,
+                      protected_media_ssrc,
+                      recovered_packet_receiver,
+                      FecScheme::kXor) {}
+
+FlexfecReceiver::FlexfecReceiver(
+    Clock* clock,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    RecoveredPacketReceiver* recovered_packet_receiver,
+    FecScheme fec_scheme)
     : ssrc_(ssrc),
       protected_media_ssrc_(protected_media_ssrc),
-      erasure_code_(
-          ForwardErrorCorrection::CreateFlexfec(ssrc, protected_media_ssrc)),
+      erasure_code_(fec_scheme == FecScheme::kReedSolomon
+                        ? ForwardErrorCorrection::CreateFlexfecReedSolomon(
+                              ssrc, protected_media_ssrc)
+                        : ForwardErrorCorrection::CreateFlexfec(
+                              ssrc, protected_media_ssrc)),
       recovered_packet_receiver_(recovered_packet_receiver),
       clock_(clock),
       last_recovered_packet_ms_(-1) {
@@ -21,6 +21,8 @@
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/flexfec_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
+#include "modules/rtp_rtcp/source/forward_error_correction_xor.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -104,6 +106,13 @@ std::unique_ptr<ForwardErrorCorrection> ForwardErrorCorrection::CreateFlexfec(
       protected_media_ssrc));
 }
 
+std::unique_ptr<ForwardErrorCorrection>
+ForwardErrorCorrection::CreateFlexfecReedSolomon(
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc) {
+  return std::make_unique<ReedSolomonFec>(ssrc, protected_media_ssrc);
+}
+
 int ForwardErrorCorrection::EncodeFec(const PacketList& media_packets,
                                       uint8_t protection_factor,
                                       int num_important_packets,
@@ -635,11 +644,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   if (dst_offset + payload_length > dst->data.size()) {
     dst->data.SetSize(dst_offset + payload_length);
   }
-  uint8_t* dst_data = dst->data.data();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  internal::XorBytes(src.data.cdata() + kRtpHeaderSize, payload_length,
+                     dst->data.data() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -145,13 +145,19 @@ class ForwardErrorCorrection {
   using RecoveredPacketList = std::list<std::unique_ptr<RecoveredPacket>>;
   using ReceivedFecPacketList = std::list<std::unique_ptr<ReceivedFecPacket>>;
 
-  ~ForwardErrorCorrection();
+  virtual ~ForwardErrorCorrection();
 
   // Creates a ForwardErrorCorrection tailored for a specific FEC scheme.
   static std::unique_ptr<ForwardErrorCorrection> CreateUlpfec(uint32_t ssrc);
   static std::unique_ptr<ForwardErrorCorrection> CreateFlexfec(
       uint32_t ssrc,
       uint32_t protected_media_ssrc);
+  // Creates a Reed-Solomon erasure code, carried in the FlexFEC stream, which
+  // can recover as many lost media packets as repair packets were received.
+  // See reed_solomon_fec.h.
+  static std::unique_ptr<ForwardErrorCorrection> CreateFlexfecReedSolomon(
+      uint32_t ssrc,
+      uint32_t protected_media_ssrc);
 
   // Generates a list of FEC packets from supplied media packets.
   //
@@ -189,12 +195,12 @@ class ForwardErrorCorrection {
   //
   // Returns 0 on success, -1 on failure.
   //
-  int EncodeFec(const PacketList& media_packets,
-                uint8_t protection_factor,
-                int num_important_packets,
-                bool use_unequal_protection,
-                FecMaskType fec_mask_type,
-                std::list<Packet*>* fec_packets);
+  virtual int EncodeFec(const PacketList& media_packets,
+                        uint8_t protection_factor,
+                        int num_important_packets,
+                        bool use_unequal_protection,
+                        FecMaskType fec_mask_type,
+                        std::list<Packet*>* fec_packets);
 
   // Decodes a list of received media and FEC packets. It will parse the
   // |received_packets|, storing FEC packets internally, and move
@@ -218,8 +224,8 @@ class ForwardErrorCorrection {
   //                            list will be valid until the next call to
   //                            DecodeFec().
   //
-  void DecodeFec(const ReceivedPacket& received_packet,
-                 RecoveredPacketList* recovered_packets);
+  virtual void DecodeFec(const ReceivedPacket& received_packet,
+                         RecoveredPacketList* recovered_packets);
 
   // Get the number of generated FEC packets, given the number of media packets
   // and the protection factor.
@@ -227,11 +233,11 @@ class ForwardErrorCorrection {
 
   // Gets the maximum size of the FEC headers in bytes, which must be
   // accounted for as packet overhead.
-  size_t MaxPacketOverhead() const;
+  virtual size_t MaxPacketOverhead() const;
 
   // Reset internal states from last frame and clear |recovered_packets|.
   // Frees all memory allocated by this class.
-  void ResetState(RecoveredPacketList* recovered_packets);
+  virtual void ResetState(RecoveredPacketList* recovered_packets);
 
   // TODO(brandtr): Remove these functions when the Packet classes
   // have been refactored.
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/forward_error_correction_xor.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 1254983;
+constexpr uint32_t kFecSsrc = 4711;
+constexpr int kNumMediaPackets = 40;
+constexpr uint32_t kPacketSize = 1200;
+constexpr int kFrames = 500;
+constexpr size_t kXorLength = 1188;
+constexpr int kXorRounds = 200000;
+
+// Returns the average time in microseconds to protect a frame of
+// |kNumMediaPackets| full size packets with 25% overhead, where every FEC
+// packet protects several media packets.
+double MeasureEncodeTimeUs(ForwardErrorCorrection* fec) {
+  Random random(0xabcdef);
+  test::fec::MediaPacketGenerator generator(kPacketSize, kPacketSize,
+                                            kMediaSsrc, &random);
+  ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(kNumMediaPackets);
+
+  int64_t encode_time_ns = 0;
+  for (int frame = 0; frame < kFrames; ++frame) {
+    std::list<ForwardErrorCorrection::Packet*> fec_packets;
+    int64_t start_ns = rtc::TimeNanos();
+    EXPECT_EQ(0, fec->EncodeFec(media_packets, /*protection_factor=*/64,
+                                /*num_important_packets=*/0,
+                                /*use_unequal_protection=*/false,
+                                kFecMaskRandom, &fec_packets));
+    encode_time_ns += rtc::TimeNanos() - start_ns;
+    EXPECT_FALSE(fec_packets.empty());
+  }
+  return static_cast<double>(encode_time_ns) / kFrames / 1000;
+}
+
+// Returns the average time in nanoseconds to XOR one packet payload.
+double MeasureXorTimeNs(
+    void (*xor_function)(const uint8_t*, size_t, uint8_t*)) {
+  std::vector<uint8_t> src(kXorLength, 0x5a);
+  std::vector<uint8_t> dst(kXorLength, 0xa5);
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kXorRounds; ++i) {
+    xor_function(src.data(), kXorLength, dst.data());
+  }
+  int64_t xor_time_ns = rtc::TimeNanos() - start_ns;
+  // The result depends on the number of rounds, keep it alive.
+  EXPECT_EQ(dst[0], kXorRounds % 2 == 0 ? 0xa5 : 0xff);
+  return static_cast<double>(xor_time_ns) / kXorRounds;
+}
+
+TEST(ForwardErrorCorrectionPerformanceTest, EncodeTime) {
+  std::unique_ptr<ForwardErrorCorrection> ulpfec =
+      ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  std::unique_ptr<ForwardErrorCorrection> flexfec =
+      ForwardErrorCorrection::CreateFlexfec(kFecSsrc, kMediaSsrc);
+  test::PrintResult("fec_encode_time", "", "ulpfec",
+                    MeasureEncodeTimeUs(ulpfec.get()), "us", false);
+  test::PrintResult("fec_encode_time", "", "flexfec",
+                    MeasureEncodeTimeUs(flexfec.get()), "us", false);
+}
+
+TEST(ForwardErrorCorrectionPerformanceTest, XorTime) {
+  test::PrintResult("fec_xor_time", "", "portable",
+                    MeasureXorTimeNs(&internal::XorBytes_C), "ns", false);
+  test::PrintResult("fec_xor_time", "", "dispatched",
+                    MeasureXorTimeNs(&internal::XorBytes), "ns", false);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/forward_error_correction_xor.h"
+
+#include <string.h>
+
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include "modules/rtp_rtcp/source/forward_error_correction_xor_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/rtp_rtcp/source/forward_error_correction_xor_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kAVX2, WebRtc_G...
+#endif
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using XorFunction = void (*)(const uint8_t*, size_t, uint8_t*);
+
+XorFunction SelectXorFunction() {
+#if defined(WEBRTC_HAS_NEON)
+  return &XorBytes_NEON;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return &XorBytes_AVX2;
+  }
+  return &XorBytes_C;
+#else
+  return &XorBytes_C;
+#endif
+}
+
+}  // namespace
+
+void XorBytes(const uint8_t* src, size_t length, uint8_t* dst) {
+  static const XorFunction xor_function = SelectXorFunction();
+  xor_function(src, length, dst);
+}
+
+void XorBytes_C(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  // memcpy() is used for unaligned access, compilers turn it into plain
+  // loads and stores.
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t src_word;
+    uint64_t dst_word;
+    memcpy(&src_word, src + i, sizeof(src_word));
+    memcpy(&dst_word, dst + i, sizeof(dst_word));
+    dst_word ^= src_word;
+    memcpy(dst + i, &dst_word, sizeof(dst_word));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/forward_error_correction_xor.h"
+
+#include <random>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+constexpr size_t kMaxLength = 1500;
+constexpr size_t kMaxOffset = 7;
+
+std::vector<uint8_t> RandomBytes(size_t size, std::mt19937* random) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = static_cast<uint8_t>((*random)());
+  }
+  return bytes;
+}
+
+using XorFunction = void (*)(const uint8_t*, size_t, uint8_t*);
+
+// Checks |xor_function| against a byte-wise XOR for all lengths up to a full
+// packet and all relative alignments of the buffers, and that no byte past
+// |length| is touched.
+void ExpectBitExact(XorFunction xor_function) {
+  std::mt19937 random(4711);
+  for (size_t src_offset = 0; src_offset <= kMaxOffset; ++src_offset) {
+    for (size_t dst_offset = 0; dst_offset <= kMaxOffset; dst_offset += 3) {
+      for (size_t length = 0; length <= kMaxLength;
+           length += length < 100 ? 1 : 37) {
+        const std::vector<uint8_t> src =
+            RandomBytes(src_offset + length + kMaxOffset, &random);
+        std::vector<uint8_t> dst =
+            RandomBytes(dst_offset + length + kMaxOffset, &random);
+        std::vector<uint8_t> expected = dst;
+        for (size_t i = 0; i < length; ++i) {
+          expected[dst_offset + i] ^= src[src_offset + i];
+        }
+        xor_function(src.data() + src_offset, length, dst.data() + dst_offset);
+        ASSERT_EQ(dst, expected) << "length " << length << ", src offset "
+                                 << src_offset << ", dst offset "
+                                 << dst_offset;
+      }
+    }
+  }
+}
+
+TEST(ForwardErrorCorrectionXorTest, PortableXorIsBitExact) {
+  ExpectBitExact(&XorBytes_C);
+}
+
+TEST(ForwardErrorCorrectionXorTest, DispatchedXorIsBitExact) {
+  ExpectBitExact(&XorBytes);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace webrtc
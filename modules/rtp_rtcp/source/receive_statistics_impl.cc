@@ -100,9 +100,9 @@ bool StreamStatisticianImpl::UpdateOutOfOrder(const RtpPacketReceived& packet,
 }
 
 void StreamStatisticianImpl::UpdateCounters(const RtpPacketReceived& packet) {
-  rtc::CritScope cs(&stream_lock_);
   RTC_DCHECK_EQ(ssrc_, packet.Ssrc());
-  int64_t now_ms = clock_->TimeInMilliseconds();
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  rtc::CritScope cs(&stream_lock_);
 
   incoming_bitrate_.Update(packet.size(), now_ms);
   receive_counters_.last_packet_received_timestamp_ms = now_ms;
@@ -301,6 +301,7 @@ std::unique_ptr<ReceiveStatistics> ReceiveStatistics::Create(Clock* clock) {
 ReceiveStatisticsImpl::ReceiveStatisticsImpl(Clock* clock)
     : clock_(clock),
       last_returned_ssrc_(0),
+      last_statistician_(nullptr),
       max_reordering_threshold_(kDefaultMaxReorderingThreshold) {}
 
 ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
@@ -315,7 +316,13 @@ void ReceiveStatisticsImpl::OnRtpPacket(const RtpPacketReceived& packet) {
   // this whole ReceiveStatisticsImpl is destroyed. StreamStatisticianImpl has
   // it's own locking so don't hold receive_statistics_lock_ (potential
   // deadlock).
-  GetOrCreateStatistician(packet.Ssrc())->UpdateCounters(packet);
+  StreamStatisticianImpl* statistician =
+      last_statistician_.load(std::memory_order_acquire);
+  if (!statistician || statistician->ssrc() != packet.Ssrc()) {
+    statistician = GetOrCreateStatistician(packet.Ssrc());
+    last_statistician_.store(statistician, std::memory_order_release);
+  }
+  statistician->UpdateCounters(packet);
 }
 
 StreamStatisticianImpl* ReceiveStatisticsImpl::GetStatistician(
@@ -12,6 +12,7 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <vector>
 
@@ -31,6 +32,8 @@ class StreamStatisticianImpl : public StreamStatistician {
                          int max_reordering_threshold);
   ~StreamStatisticianImpl() override;
 
+  uint32_t ssrc() const { return ssrc_; }
+
   RtpReceiveStats GetStats() const override;
 
   bool GetActiveStatisticsAndReset(RtcpStatistics* statistics);
@@ -125,6 +128,10 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
   Clock* const clock_;
   rtc::CriticalSection receive_statistics_lock_;
   uint32_t last_returned_ssrc_;
+  // The statistician of the last packet received. Packets of the same stream
+  // mostly follow each other, so it's usually found without taking
+  // |receive_statistics_lock_|. Statisticians live as long as this object.
+  std::atomic<StreamStatisticianImpl*> last_statistician_;
   int max_reordering_threshold_ RTC_GUARDED_BY(receive_statistics_lock_);
   std::map<uint32_t, StreamStatisticianImpl*> statisticians_
       RTC_GUARDED_BY(receive_statistics_lock_);
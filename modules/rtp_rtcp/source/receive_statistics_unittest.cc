@@ -217,6 +217,24 @@ TEST_F(ReceiveStatisticsTest,
   EXPECT_EQ(1u, receive_statistics_->RtcpReportBlocks(3).size());
 }
 
+TEST_F(ReceiveStatisticsTest, CountsPacketsOfInterleavedStreams) {
+  receive_statistics_->OnRtpPacket(packet1_);
+  for (int i = 0; i < 3; ++i) {
+    IncrementSequenceNumber(&packet2_);
+    receive_statistics_->OnRtpPacket(packet2_);
+  }
+  IncrementSequenceNumber(&packet1_, 2);
+  receive_statistics_->OnRtpPacket(packet1_);
+
+  RtpReceiveStats stats =
+      receive_statistics_->GetStatistician(kSsrc1)->GetStats();
+  EXPECT_EQ(stats.packet_counter.packets, 2u);
+  EXPECT_EQ(stats.packets_lost, 1);
+  stats = receive_statistics_->GetStatistician(kSsrc2)->GetStats();
+  EXPECT_EQ(stats.packet_counter.packets, 3u);
+  EXPECT_EQ(stats.packets_lost, 0);
+}
+
 TEST_F(ReceiveStatisticsTest, GetReceiveStreamDataCounters) {
   receive_statistics_->OnRtpPacket(packet1_);
   StreamStatistician* statistician =
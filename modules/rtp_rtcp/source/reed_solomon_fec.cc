@@ -0,0 +1,516 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "modules/include/module_common_types_public.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/flexfec_header_reader_writer.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_galois.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/mod_ops.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint8_t kVersion = 1;
+// Size of the repair header, see reed_solomon_fec.h.
+constexpr size_t kRepairHeaderSize = 18;
+// Size of the fields of a symbol that replace the fixed RTP header.
+constexpr size_t kSymbolHeaderSize = 8;
+
+// Maximum number of consecutive sequence numbers in a block, limited by the
+// coverage mask. This also limits the number of repair packets per block.
+constexpr size_t kMaxSpan = 48;
+
+// Transport header size in bytes. Assume UDP/IPv4 as a reasonable minimum.
+constexpr size_t kTransportOverhead = 28;
+
+// Media packets are kept for two blocks, so that a block can be recovered
+// while the media packets of the next one are arriving.
+constexpr size_t kMaxRecoveredPackets = 2 * kMaxSpan;
+// Blocks for which repair packets were received but which can not be
+// recovered yet, since too many of their packets are missing.
+constexpr size_t kMaxBlocks = 8;
+
+// Coefficient of the media packet at |position| in a block in the repair
+// packet |index|. The coefficients form a Cauchy matrix, 1 / (x_index + y_pos)
+// with x_index = kMaxSpan + index and y_pos = position, all of whose square
+// submatrices are invertible. This is what allows recovering any |e| lost
+// packets from any |e| repair packets.
+uint8_t Coefficient(size_t index, size_t position) {
+  RTC_DCHECK_LT(index, kMaxSpan);
+  RTC_DCHECK_LT(position, kMaxSpan);
+  return internal::GaloisInverse(
+      static_cast<uint8_t>((kMaxSpan + index) ^ position));
+}
+
+bool IsCovered(uint64_t coverage, size_t position) {
+  return position < kMaxSpan && ((coverage >> (kMaxSpan - 1 - position)) & 1);
+}
+
+// Writes the fields of the symbol of |media_packet| that replace its fixed
+// RTP header.
+void WriteSymbolHeader(const uint8_t* media_packet,
+                       size_t media_packet_length,
+                       uint8_t* symbol_header) {
+  symbol_header[0] = media_packet[0];
+  symbol_header[1] = media_packet[1];
+  ByteWriter<uint16_t>::WriteBigEndian(
+      &symbol_header[2],
+      static_cast<uint16_t>(media_packet_length - kRtpHeaderSize));
+  memcpy(&symbol_header[4], &media_packet[4], 4);
+}
+
+// Adds |coefficient| times the symbol of |media_packet| to |symbol|.
+void MultiplyAddMediaPacket(uint8_t coefficient,
+                            const rtc::CopyOnWriteBuffer& media_packet,
+                            uint8_t* symbol) {
+  uint8_t symbol_header[kSymbolHeaderSize];
+  WriteSymbolHeader(media_packet.cdata(), media_packet.size(), symbol_header);
+  internal::GaloisMultiplyAdd(coefficient, symbol_header, kSymbolHeaderSize,
+                              symbol);
+  internal::GaloisMultiplyAdd(
+      coefficient, media_packet.cdata() + kRtpHeaderSize,
+      media_packet.size() - kRtpHeaderSize, symbol + kSymbolHeaderSize);
+}
+
+// Inverts the |size| x |size| |matrix| in place, by Gauss-Jordan elimination.
+// Returns false if the matrix is singular.
+bool InvertMatrix(size_t size, std::vector<uint8_t>* matrix) {
+  std::vector<uint8_t>& a = *matrix;
+  std::vector<uint8_t> inverse(size * size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    inverse[i * size + i] = 1;
+  }
+  for (size_t col = 0; col < size; ++col) {
+    size_t pivot = col;
+    while (pivot < size && a[pivot * size + col] == 0) {
+      ++pivot;
+    }
+    if (pivot == size) {
+      return false;
+    }
+    if (pivot != col) {
+      for (size_t k = 0; k < size; ++k) {
+        std::swap(a[pivot * size + k], a[col * size + k]);
+        std::swap(inverse[pivot * size + k], inverse[col * size + k]);
+      }
+    }
+    const uint8_t scale = internal::GaloisInverse(a[col * size + col]);
+    for (size_t k = 0; k < size; ++k) {
+      a[col * size + k] = internal::GaloisMultiply(a[col * size + k], scale);
+      inverse[col * size + k] =
+          internal::GaloisMultiply(inverse[col * size + k], scale);
+    }
+    for (size_t row = 0; row < size; ++row) {
+      const uint8_t factor = a[row * size + col];
+      if (row == col || factor == 0) {
+        continue;
+      }
+      for (size_t k = 0; k < size; ++k) {
+        a[row * size + k] ^=
+            internal::GaloisMultiply(factor, a[col * size + k]);
+        inverse[row * size + k] ^=
+            internal::GaloisMultiply(factor, inverse[col * size + k]);
+      }
+    }
+  }
+  a = std::move(inverse);
+  return true;
+}
+
+}  // namespace
+
+ReedSolomonFec::Block::Block() = default;
+ReedSolomonFec::Block::~Block() = default;
+
+// The header reader and writer are only used by the XOR based implementation
+// in the base class, which is not used by this class.
+ReedSolomonFec::ReedSolomonFec(uint32_t ssrc, uint32_t protected_media_ssrc)
+    : ForwardErrorCorrection(std::make_unique<FlexfecHeaderReader>(),
+                             std::make_unique<FlexfecHeaderWriter>(),
+                             ssrc,
+                             protected_media_ssrc),
+      ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      generated_repair_packets_(kMaxSpan) {}
+
+ReedSolomonFec::~ReedSolomonFec() = default;
+
+int ReedSolomonFec::EncodeFec(const PacketList& media_packets,
+                              uint8_t protection_factor,
+                              int num_important_packets,
+                              bool use_unequal_protection,
+                              FecMaskType fec_mask_type,
+                              std::list<Packet*>* fec_packets) {
+  const size_t num_media_packets = media_packets.size();
+
+  // Sanity check arguments.
+  RTC_DCHECK_GT(num_media_packets, 0);
+  RTC_DCHECK(fec_packets->empty());
+  if (num_media_packets > kMaxSpan) {
+    RTC_LOG(LS_WARNING) << "Can't protect " << num_media_packets
+                        << " media packets per frame. Max is " << kMaxSpan
+                        << ".";
+    return -1;
+  }
+
+  // Error check the media packets, and find the layout of the block.
+  const uint16_t seq_num_base = ByteReader<uint16_t>::ReadBigEndian(
+      &media_packets.front()->data.cdata()[2]);
+  size_t max_media_packet_length = 0;
+  uint64_t coverage = 0;
+  size_t span = 0;
+  for (const auto& media_packet : media_packets) {
+    RTC_DCHECK(media_packet);
+    if (media_packet->data.size() < kRtpHeaderSize) {
+      RTC_LOG(LS_WARNING) << "Media packet " << media_packet->data.size()
+                          << " bytes "
+                             "is smaller than RTP header.";
+      return -1;
+    }
+    // Ensure the FEC packets will fit in a typical MTU.
+    if (media_packet->data.size() + MaxPacketOverhead() + kTransportOverhead >
+        IP_PACKET_SIZE) {
+      RTC_LOG(LS_WARNING) << "Media packet " << media_packet->data.size()
+                          << " bytes "
+                             "with overhead is larger than "
+                          << IP_PACKET_SIZE << " bytes.";
+    }
+    const uint16_t position =
+        ByteReader<uint16_t>::ReadBigEndian(&media_packet->data.cdata()[2]) -
+        seq_num_base;
+    if (position >= kMaxSpan || (span > 0 && position < span)) {
+      RTC_LOG(LS_WARNING) << "Media packets must be in sequence number order "
+                             "and span at most "
+                          << kMaxSpan << " sequence numbers.";
+      return -1;
+    }
+    span = position + 1;
+    coverage |= uint64_t{1} << (kMaxSpan - 1 - position);
+    max_media_packet_length =
+        std::max(max_media_packet_length, media_packet->data.size());
+  }
+
+  // Prepare generated FEC packets.
+  const size_t num_repair_packets =
+      NumFecPackets(num_media_packets, protection_factor);
+  if (num_repair_packets == 0) {
+    return 0;
+  }
+  RTC_DCHECK_LE(num_repair_packets, kMaxSpan);
+  const size_t symbol_length =
+      max_media_packet_length - kRtpHeaderSize + kSymbolHeaderSize;
+  for (size_t i = 0; i < num_repair_packets; ++i) {
+    Packet& repair_packet = generated_repair_packets_[i];
+    repair_packet.data.SetSize(kRepairHeaderSize + symbol_length);
+    uint8_t* data = repair_packet.data.data();
+    data[0] = kVersion;
+    data[1] = static_cast<uint8_t>(span);
+    data[2] = static_cast<uint8_t>(i);
+    data[3] = static_cast<uint8_t>(num_repair_packets);
+    ByteWriter<uint32_t>::WriteBigEndian(
+        &data[4], ByteReader<uint32_t>::ReadBigEndian(
+                      &media_packets.front()->data.cdata()[8]));
+    ByteWriter<uint16_t>::WriteBigEndian(&data[8], seq_num_base);
+    ByteWriter<uint16_t>::WriteBigEndian(&data[10],
+                                         static_cast<uint16_t>(symbol_length));
+    ByteWriter<uint64_t, 6>::WriteBigEndian(&data[12], coverage);
+    memset(&data[kRepairHeaderSize], 0, symbol_length);
+    fec_packets->push_back(&repair_packet);
+  }
+
+  // Write repair symbols, one media packet at a time for cache locality.
+  for (const auto& media_packet : media_packets) {
+    const uint16_t position =
+        ByteReader<uint16_t>::ReadBigEndian(&media_packet->data.cdata()[2]) -
+        seq_num_base;
+    for (size_t i = 0; i < num_repair_packets; ++i) {
+      MultiplyAddMediaPacket(
+          Coefficient(i, position), media_packet->data,
+          generated_repair_packets_[i].data.data() + kRepairHeaderSize);
+    }
+  }
+
+  return 0;
+}
+
+void ReedSolomonFec::DecodeFec(const ReceivedPacket& received_packet,
+                               RecoveredPacketList* recovered_packets) {
+  RTC_DCHECK(recovered_packets);
+
+  if (!recovered_packets->empty() &&
+      received_packet.ssrc == recovered_packets->back()->ssrc &&
+      MinDiff(received_packet.seq_num, recovered_packets->back()->seq_num) >
+          kMaxRecoveredPackets) {
+    // A big gap in sequence numbers. The old recovered packets
+    // are now useless, so it's safe to do a reset.
+    RTC_LOG(LS_INFO) << "Big gap in media sequence numbers. No need to keep "
+                        "the old packets in the FEC buffers, thus resetting "
+                        "them.";
+    ResetState(recovered_packets);
+  }
+
+  if (received_packet.is_fec) {
+    auto block_it = InsertRepairPacket(received_packet);
+    if (block_it != blocks_.end() &&
+        AttemptRecovery(*block_it, recovered_packets)) {
+      blocks_.erase(block_it);
+    }
+  } else {
+    InsertMediaPacket(received_packet, recovered_packets);
+    for (auto it = blocks_.begin(); it != blocks_.end();) {
+      const uint16_t position = received_packet.seq_num - it->seq_num_base;
+      if (IsCovered(it->coverage, position) &&
+          AttemptRecovery(*it, recovered_packets)) {
+        it = blocks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  DiscardOldRecoveredPackets(recovered_packets);
+}
+
+size_t ReedSolomonFec::MaxPacketOverhead() const {
+  return kRepairHeaderSize + kSymbolHeaderSize;
+}
+
+void ReedSolomonFec::ResetState(RecoveredPacketList* recovered_packets) {
+  // Free the memory for any existing recovered packets, if the caller hasn't.
+  recovered_packets->clear();
+  blocks_.clear();
+}
+
+void ReedSolomonFec::InsertMediaPacket(const ReceivedPacket& received_packet,
+                                       RecoveredPacketList* recovered_packets) {
+  if (received_packet.ssrc != protected_media_ssrc_) {
+    RTC_LOG(LS_INFO) << "Received media packet with SSRC "
+                     << received_packet.ssrc << " which is not protected.";
+    return;
+  }
+  if (received_packet.pkt->data.size() < kRtpHeaderSize) {
+    RTC_LOG(LS_WARNING) << "Truncated media packet, discarding.";
+    return;
+  }
+
+  // Search for duplicate packets.
+  for (const auto& recovered_packet : *recovered_packets) {
+    if (recovered_packet->seq_num == received_packet.seq_num) {
+      // Duplicate packet, no need to add to list.
+      return;
+    }
+  }
+
+  std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
+  // This "recovered packet" was not recovered using parity packets.
+  recovered_packet->was_recovered = false;
+  // This media packet has already been passed on.
+  recovered_packet->returned = true;
+  recovered_packet->ssrc = received_packet.ssrc;
+  recovered_packet->seq_num = received_packet.seq_num;
+  recovered_packet->pkt = received_packet.pkt;
+  recovered_packets->push_back(std::move(recovered_packet));
+  recovered_packets->sort(SortablePacket::LessThan());
+}
+
+std::list<ReedSolomonFec::Block>::iterator ReedSolomonFec::InsertRepairPacket(
+    const ReceivedPacket& received_packet) {
+  if (received_packet.ssrc != ssrc_) {
+    RTC_LOG(LS_INFO) << "Received repair packet with SSRC "
+                     << received_packet.ssrc << " instead of " << ssrc_ << ".";
+    return blocks_.end();
+  }
+  const rtc::CopyOnWriteBuffer& data = received_packet.pkt->data;
+  if (data.size() < kRepairHeaderSize) {
+    RTC_LOG(LS_WARNING) << "Truncated repair packet, discarding.";
+    return blocks_.end();
+  }
+  const uint8_t* header = data.cdata();
+  const uint8_t version = header[0];
+  const uint8_t span = header[1];
+  const uint8_t index = header[2];
+  const uint8_t num_repair_packets = header[3];
+  const uint32_t protected_ssrc =
+      ByteReader<uint32_t>::ReadBigEndian(&header[4]);
+  const uint16_t seq_num_base = ByteReader<uint16_t>::ReadBigEndian(&header[8]);
+  const size_t symbol_length = ByteReader<uint16_t>::ReadBigEndian(&header[10]);
+  const uint64_t coverage = ByteReader<uint64_t, 6>::ReadBigEndian(&header[12]);
+  if (version != kVersion) {
+    RTC_LOG(LS_WARNING) << "Unsupported repair packet version "
+                        << static_cast<int>(version) << ", discarding.";
+    return blocks_.end();
+  }
+  // The first covered packet is at the sequence number base and the last one
+  // ends the span.
+  if (span == 0 || span > kMaxSpan || !IsCovered(coverage, 0) ||
+      !IsCovered(coverage, span - 1) ||
+      (coverage & ((uint64_t{1} << (kMaxSpan - span)) - 1)) != 0 ||
+      index >= num_repair_packets || num_repair_packets > kMaxSpan ||
+      symbol_length < kSymbolHeaderSize ||
+      data.size() != kRepairHeaderSize + symbol_length) {
+    RTC_LOG(LS_WARNING) << "Malformed repair packet, discarding.";
+    return blocks_.end();
+  }
+  if (protected_ssrc != protected_media_ssrc_) {
+    RTC_LOG(LS_INFO) << "Received repair packet protecting SSRC "
+                     << protected_ssrc << ", discarding.";
+    return blocks_.end();
+  }
+
+  for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+    if (it->seq_num_base != seq_num_base) {
+      continue;
+    }
+    if (it->span != span || it->coverage != coverage ||
+        it->symbol_length != symbol_length) {
+      RTC_LOG(LS_WARNING) << "Repair packet does not match its block, "
+                             "discarding.";
+      return blocks_.end();
+    }
+    for (const Repair& repair : it->repairs) {
+      if (repair.index == index) {
+        // Duplicate packet, nothing new to recover from.
+        return blocks_.end();
+      }
+    }
+    it->repairs.push_back(Repair{index, received_packet.pkt});
+    return it;
+  }
+
+  blocks_.emplace_back();
+  Block& block = blocks_.back();
+  block.seq_num_base = seq_num_base;
+  block.span = span;
+  block.coverage = coverage;
+  block.symbol_length = symbol_length;
+  block.repairs.push_back(Repair{index, received_packet.pkt});
+  if (blocks_.size() > kMaxBlocks) {
+    blocks_.pop_front();
+  }
+  return std::prev(blocks_.end());
+}
+
+bool ReedSolomonFec::AttemptRecovery(const Block& block,
+                                     RecoveredPacketList* recovered_packets) {
+  // Find the received media packets of the block.
+  const Packet* media_packets[kMaxSpan] = {};
+  for (const auto& recovered_packet : *recovered_packets) {
+    const uint16_t position = recovered_packet->seq_num - block.seq_num_base;
+    if (IsCovered(block.coverage, position)) {
+      media_packets[position] = recovered_packet->pkt.get();
+    }
+  }
+  std::vector<size_t> missing_positions;
+  for (size_t position = 0; position < block.span; ++position) {
+    if (IsCovered(block.coverage, position) && !media_packets[position]) {
+      missing_positions.push_back(position);
+    }
+  }
+  const size_t num_missing = missing_positions.size();
+  if (num_missing == 0) {
+    return true;
+  }
+  if (block.repairs.size() < num_missing) {
+    return false;
+  }
+
+  // Subtract the received media packets from the first |num_missing| repair
+  // symbols, leaving the contribution of the missing ones.
+  const size_t symbol_length = block.symbol_length;
+  std::vector<uint8_t> syndromes(num_missing * symbol_length);
+  for (size_t i = 0; i < num_missing; ++i) {
+    const Repair& repair = block.repairs[i];
+    uint8_t* syndrome = &syndromes[i * symbol_length];
+    memcpy(syndrome, repair.pkt->data.cdata() + kRepairHeaderSize,
+           symbol_length);
+    for (size_t position = 0; position < block.span; ++position) {
+      const Packet* media_packet = media_packets[position];
+      if (!media_packet) {
+        continue;
+      }
+      if (media_packet->data.size() - kRtpHeaderSize + kSymbolHeaderSize >
+          symbol_length) {
+        RTC_LOG(LS_WARNING) << "Media packet is larger than the repair "
+                               "symbols protecting it.";
+        return true;
+      }
+      MultiplyAddMediaPacket(Coefficient(repair.index, position),
+                             media_packet->data, syndrome);
+    }
+  }
+
+  // Solve for the missing symbols.
+  std::vector<uint8_t> matrix(num_missing * num_missing);
+  for (size_t i = 0; i < num_missing; ++i) {
+    for (size_t k = 0; k < num_missing; ++k) {
+      matrix[i * num_missing + k] =
+          Coefficient(block.repairs[i].index, missing_positions[k]);
+    }
+  }
+  if (!InvertMatrix(num_missing, &matrix)) {
+    RTC_NOTREACHED() << "Cauchy matrices are invertible.";
+    return true;
+  }
+  std::vector<uint8_t> symbol(symbol_length);
+  for (size_t k = 0; k < num_missing; ++k) {
+    std::fill(symbol.begin(), symbol.end(), 0);
+    for (size_t i = 0; i < num_missing; ++i) {
+      internal::GaloisMultiplyAdd(matrix[k * num_missing + i],
+                                  &syndromes[i * symbol_length], symbol_length,
+                                  symbol.data());
+    }
+
+    const size_t length = ByteReader<uint16_t>::ReadBigEndian(&symbol[2]);
+    if (kSymbolHeaderSize + length > symbol_length) {
+      RTC_LOG(LS_WARNING) << "Recovered packet length " << length
+                          << " does not fit the repair symbol.";
+      continue;
+    }
+    std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
+    recovered_packet->was_recovered = true;
+    recovered_packet->returned = false;
+    recovered_packet->ssrc = protected_media_ssrc_;
+    recovered_packet->seq_num = block.seq_num_base + missing_positions[k];
+    recovered_packet->pkt = new Packet();
+    recovered_packet->pkt->data.SetSize(kRtpHeaderSize + length);
+    uint8_t* data = recovered_packet->pkt->data.data();
+    data[0] = symbol[0];
+    data[1] = symbol[1];
+    ByteWriter<uint16_t>::WriteBigEndian(&data[2], recovered_packet->seq_num);
+    memcpy(&data[4], &symbol[4], 4);
+    ByteWriter<uint32_t>::WriteBigEndian(&data[8], protected_media_ssrc_);
+    memcpy(&data[kRtpHeaderSize], &symbol[kSymbolHeaderSize], length);
+    recovered_packets->push_back(std::move(recovered_packet));
+  }
+  recovered_packets->sort(SortablePacket::LessThan());
+  return true;
+}
+
+void ReedSolomonFec::DiscardOldRecoveredPackets(
+    RecoveredPacketList* recovered_packets) {
+  while (recovered_packets->size() > kMaxRecoveredPackets) {
+    recovered_packets->pop_front();
+  }
+}
+
+}  // namespace webrtc
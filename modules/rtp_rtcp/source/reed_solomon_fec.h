@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+
+namespace webrtc {
+
+// Systematic Reed-Solomon erasure code over GF(2^8). Unlike the XOR based
+// codes, where every FEC packet can repair at most one of the media packets
+// it protects, any |m| repair packets generated for a block of media packets
+// recover any |m| losses within that block. This allows for a lower
+// protection overhead at the same residual loss, in particular for bursty
+// loss.
+//
+// The repair packets are carried as the payload of the FlexFEC stream, with
+// their own header instead of the one of the FlexFEC RFC, so both ends must
+// agree on using this scheme.
+//
+// Repair packet payload:
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |    Version    |     Span      |     Index     |  Num repairs  |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                      Protected SSRC                           |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |          SN base              |        Symbol length          |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                     Coverage mask (48 bits)                   |
+//   +                               +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                               |        Repair symbol...       |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// Bit i of the coverage mask, counted from the most significant bit, is set
+// if the media packet with sequence number |SN base| + i is protected. The
+// media packets are protected as the symbol
+//
+//   RTP byte 0 | RTP byte 1 | length (16 bits) | timestamp | RTP payload
+//
+// where the length counts everything past the 12 byte fixed RTP header, and
+// the RTP payload includes CSRCs and header extensions. Symbols are zero
+// padded to the symbol length of the block.
+class ReedSolomonFec : public ForwardErrorCorrection {
+ public:
+  ReedSolomonFec(uint32_t ssrc, uint32_t protected_media_ssrc);
+  ~ReedSolomonFec() override;
+
+  // The protection factor has the same meaning as for the XOR based codes.
+  // |num_important_packets|, |use_unequal_protection| and |fec_mask_type| are
+  // ignored, as all repair packets protect all media packets.
+  int EncodeFec(const PacketList& media_packets,
+                uint8_t protection_factor,
+                int num_important_packets,
+                bool use_unequal_protection,
+                FecMaskType fec_mask_type,
+                std::list<Packet*>* fec_packets) override;
+
+  void DecodeFec(const ReceivedPacket& received_packet,
+                 RecoveredPacketList* recovered_packets) override;
+
+  size_t MaxPacketOverhead() const override;
+
+  void ResetState(RecoveredPacketList* recovered_packets) override;
+
+ private:
+  struct Repair {
+    uint8_t index;
+    rtc::scoped_refptr<Packet> pkt;
+  };
+
+  // The repair packets received for one encoded block of media packets.
+  struct Block {
+    Block();
+    Block(const Block&) = delete;
+    Block& operator=(const Block&) = delete;
+    ~Block();
+
+    uint16_t seq_num_base;
+    uint8_t span;
+    uint64_t coverage;
+    size_t symbol_length;
+    std::vector<Repair> repairs;
+  };
+
+  void InsertMediaPacket(const ReceivedPacket& received_packet,
+                         RecoveredPacketList* recovered_packets);
+  // Returns the block that the repair packet was added to, or the end of
+  // |blocks_| if the packet is malformed or a duplicate.
+  std::list<Block>::iterator InsertRepairPacket(
+      const ReceivedPacket& received_packet);
+
+  // Recovers the missing media packets of |block| if enough repair packets
+  // have been received. Returns true if |block| is no longer needed.
+  bool AttemptRecovery(const Block& block,
+                       RecoveredPacketList* recovered_packets);
+
+  void DiscardOldRecoveredPackets(RecoveredPacketList* recovered_packets);
+
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+
+  // Encoder state.
+  std::vector<Packet> generated_repair_packets_;
+
+  // Decoder state, oldest block first.
+  std::list<Block> blocks_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_galois.h"
+
+#include "modules/rtp_rtcp/source/forward_error_correction_xor.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include "modules/rtp_rtcp/source/reed_solomon_fec_galois_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/rtp_rtcp/source/reed_solomon_fec_galois_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kAVX2, WebRtc_G...
+#endif
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+// x^8 + x^4 + x^3 + x^2 + 1, for which x is a generator of the field.
+constexpr int kFieldPolynomial = 0x11d;
+
+struct LogTables {
+  LogTables() {
+    int value = 1;
+    for (int i = 0; i < 255; ++i) {
+      exp[i] = static_cast<uint8_t>(value);
+      exp[i + 255] = static_cast<uint8_t>(value);
+      log[value] = static_cast<uint8_t>(i);
+      value <<= 1;
+      if (value & 0x100) {
+        value ^= kFieldPolynomial;
+      }
+    }
+    log[0] = 0;
+  }
+
+  // Twice the group order, so that the sum of two logarithms can index it.
+  uint8_t exp[510];
+  uint8_t log[256];
+};
+
+const LogTables& GetLogTables() {
+  static const LogTables* const tables = new LogTables();
+  return *tables;
+}
+
+using MultiplyAddFunction = void (*)(const uint8_t*,
+                                     const uint8_t*,
+                                     const uint8_t*,
+                                     size_t,
+                                     uint8_t*);
+
+MultiplyAddFunction SelectMultiplyAddFunction() {
+#if defined(WEBRTC_HAS_NEON)
+  return &GaloisMultiplyAdd_NEON;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return &GaloisMultiplyAdd_AVX2;
+  }
+  return &GaloisMultiplyAdd_C;
+#else
+  return &GaloisMultiplyAdd_C;
+#endif
+}
+
+}  // namespace
+
+uint8_t GaloisMultiply(uint8_t a, uint8_t b) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  const LogTables& tables = GetLogTables();
+  return tables.exp[tables.log[a] + tables.log[b]];
+}
+
+uint8_t GaloisInverse(uint8_t a) {
+  RTC_DCHECK_NE(a, 0);
+  const LogTables& tables = GetLogTables();
+  return tables.exp[255 - tables.log[a]];
+}
+
+void GaloisMultiplyAdd(uint8_t coefficient,
+                       const uint8_t* src,
+                       size_t length,
+                       uint8_t* dst) {
+  if (coefficient == 0) {
+    return;
+  }
+  if (coefficient == 1) {
+    XorBytes(src, length, dst);
+    return;
+  }
+  static const MultiplyAddFunction multiply_add = SelectMultiplyAddFunction();
+  uint8_t low_products[16];
+  uint8_t high_products[16];
+  for (int i = 0; i < 16; ++i) {
+    low_products[i] = GaloisMultiply(coefficient, static_cast<uint8_t>(i));
+    high_products[i] =
+        GaloisMultiply(coefficient, static_cast<uint8_t>(i << 4));
+  }
+  multiply_add(low_products, high_products, src, length, dst);
+}
+
+void GaloisMultiplyAdd_C(const uint8_t* low_products,
+                         const uint8_t* high_products,
+                         const uint8_t* src,
+                         size_t length,
+                         uint8_t* dst) {
+  // Expanding the nibble tables to all byte values pays off already for
+  // short payloads.
+  uint8_t products[256];
+  for (int i = 0; i < 256; ++i) {
+    products[i] = low_products[i & 0xf] ^ high_products[i >> 4];
+  }
+  for (size_t i = 0; i < length; ++i) {
+    dst[i] ^= products[src[i]];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
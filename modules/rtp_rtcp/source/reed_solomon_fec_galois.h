@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_GALOIS_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_GALOIS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+namespace internal {
+
+// Arithmetic in GF(2^8), with the field polynomial x^8 + x^4 + x^3 + x^2 + 1.
+// Addition is XOR.
+uint8_t GaloisMultiply(uint8_t a, uint8_t b);
+// |a| must not be zero.
+uint8_t GaloisInverse(uint8_t a);
+
+// Adds |coefficient| times each of the |length| bytes of |src| to |dst|, using
+// the widest vector instructions supported by the CPU. The buffers must not
+// overlap.
+void GaloisMultiplyAdd(uint8_t coefficient,
+                       const uint8_t* src,
+                       size_t length,
+                       uint8_t* dst);
+
+// Portable version of GaloisMultiplyAdd(). The coefficient is given by its
+// products with all values of the low and of the high nibble of a byte, i.e.
+// c * x = low_products[x & 0xf] ^ high_products[x >> 4], which is the form
+// used by the vector versions for their table lookups.
+void GaloisMultiplyAdd_C(const uint8_t* low_products,
+                         const uint8_t* high_products,
+                         const uint8_t* src,
+                         size_t length,
+                         uint8_t* dst);
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_GALOIS_H_
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_galois_neon.h"
+
+#include <arm_neon.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace internal {
+
+void GaloisMultiplyAdd_NEON(const uint8_t* low_products,
+                            const uint8_t* high_products,
+                            const uint8_t* src,
+                            size_t length,
+                            uint8_t* dst) {
+  const uint8x16_t nibble_mask = vdupq_n_u8(0x0f);
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_ARM64)
+  const uint8x16_t low = vld1q_u8(low_products);
+  const uint8x16_t high = vld1q_u8(high_products);
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t s = vld1q_u8(src + i);
+    const uint8x16_t product =
+        veorq_u8(vqtbl1q_u8(low, vandq_u8(s, nibble_mask)),
+                 vqtbl1q_u8(high, vshrq_n_u8(s, 4)));
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), product));
+  }
+#else
+  // ARMv7 only has 64 bit table lookups, with a 16 byte table split in two.
+  const uint8x8x2_t low = {
+      {vld1_u8(low_products), vld1_u8(low_products + 8)}};
+  const uint8x8x2_t high = {
+      {vld1_u8(high_products), vld1_u8(high_products + 8)}};
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t s = vld1q_u8(src + i);
+    const uint8x16_t s_low = vandq_u8(s, nibble_mask);
+    const uint8x16_t s_high = vshrq_n_u8(s, 4);
+    const uint8x16_t product = vcombine_u8(
+        veor_u8(vtbl2_u8(low, vget_low_u8(s_low)),
+                vtbl2_u8(high, vget_low_u8(s_high))),
+        veor_u8(vtbl2_u8(low, vget_high_u8(s_low)),
+                vtbl2_u8(high, vget_high_u8(s_high))));
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), product));
+  }
+#endif
+  for (; i < length; ++i) {
+    dst[i] ^= low_products[src[i] & 0xf] ^ high_products[src[i] >> 4];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
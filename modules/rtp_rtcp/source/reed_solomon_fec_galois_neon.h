@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This header file is used only by reed_solomon_fec_galois.cc. It defines
+// the NEON routine for multiplying and adding FEC payloads in GF(2^8).
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_GALOIS_NEON_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_GALOIS_NEON_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+namespace internal {
+
+void GaloisMultiplyAdd_NEON(const uint8_t* low_products,
+                            const uint8_t* high_products,
+                            const uint8_t* src,
+                            size_t length,
+                            uint8_t* dst);
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_GALOIS_NEON_H_
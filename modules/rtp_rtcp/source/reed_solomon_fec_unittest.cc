@@ -0,0 +1,251 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
+
+#include <list>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_galois.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+using Packet = ForwardErrorCorrection::Packet;
+using PacketList = ForwardErrorCorrection::PacketList;
+using ReceivedPacket = ForwardErrorCorrection::ReceivedPacket;
+using RecoveredPacketList = ForwardErrorCorrection::RecoveredPacketList;
+
+constexpr uint32_t kFecSsrc = 0xfec;
+constexpr uint32_t kMediaSsrc = 0x12345678;
+constexpr uint16_t kStartSeqNum = 0xfff0;  // Wraps within the block.
+
+// 10 media packets, 3 repair packets.
+constexpr int kNumMediaPackets = 10;
+constexpr uint8_t kProtectionFactor = 77;
+
+TEST(ReedSolomonFecGaloisTest, InverseIsInverse) {
+  for (int a = 1; a < 256; ++a) {
+    EXPECT_EQ(1, internal::GaloisMultiply(
+                     a, internal::GaloisInverse(static_cast<uint8_t>(a))));
+  }
+}
+
+TEST(ReedSolomonFecGaloisTest, MultiplyAddMatchesScalarMultiply) {
+  std::mt19937 random(4711);
+  for (int coefficient : {0, 1, 2, 0x1d, 0x80, 0xff}) {
+    uint8_t low_products[16];
+    uint8_t high_products[16];
+    for (int i = 0; i < 16; ++i) {
+      low_products[i] = internal::GaloisMultiply(coefficient, i);
+      high_products[i] = internal::GaloisMultiply(coefficient, i << 4);
+    }
+    for (size_t length : {0, 1, 15, 31, 32, 33, 100, 1500}) {
+      std::vector<uint8_t> src(length);
+      std::vector<uint8_t> dst(length + 1);
+      for (uint8_t& byte : src) {
+        byte = static_cast<uint8_t>(random());
+      }
+      for (uint8_t& byte : dst) {
+        byte = static_cast<uint8_t>(random());
+      }
+      std::vector<uint8_t> expected = dst;
+      for (size_t i = 0; i < length; ++i) {
+        expected[i] ^= internal::GaloisMultiply(coefficient, src[i]);
+      }
+      std::vector<uint8_t> portable = dst;
+      internal::GaloisMultiplyAdd_C(low_products, high_products, src.data(),
+                                    length, portable.data());
+      EXPECT_EQ(expected, portable) << "length " << length;
+      internal::GaloisMultiplyAdd(coefficient, src.data(), length, dst.data());
+      EXPECT_EQ(expected, dst) << "length " << length;
+    }
+  }
+}
+
+class ReedSolomonFecTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecTest()
+      : random_(0xabcdef123456),
+        media_packet_generator_(kRtpHeaderSize + 1,
+                                IP_PACKET_SIZE - 60,
+                                kMediaSsrc,
+                                &random_),
+        encoder_(kFecSsrc, kMediaSsrc),
+        decoder_(kFecSsrc, kMediaSsrc) {}
+
+  void Encode(int num_media_packets, uint8_t protection_factor) {
+    media_packets_ = media_packet_generator_.ConstructMediaPackets(
+        num_media_packets, kStartSeqNum);
+    std::list<Packet*> fec_packets;
+    ASSERT_EQ(0, encoder_.EncodeFec(media_packets_, protection_factor, 0,
+                                    false, kFecMaskRandom, &fec_packets));
+    uint16_t fec_seq_num = 0;
+    for (const Packet* fec_packet : fec_packets) {
+      std::unique_ptr<ReceivedPacket> received(new ReceivedPacket());
+      received->ssrc = kFecSsrc;
+      received->seq_num = fec_seq_num++;
+      received->is_fec = true;
+      received->pkt = new Packet();
+      received->pkt->data.SetData(fec_packet->data.cdata(),
+                                  fec_packet->data.size());
+      fec_packets_.push_back(std::move(received));
+    }
+  }
+
+  void DecodeMedia(const std::set<int>& lost) {
+    int i = 0;
+    for (const auto& media_packet : media_packets_) {
+      if (lost.count(i++) == 0) {
+        ReceivedPacket received;
+        received.ssrc = kMediaSsrc;
+        received.seq_num = ForwardErrorCorrection::ParseSequenceNumber(
+            media_packet->data.data());
+        received.is_fec = false;
+        received.pkt = new Packet();
+        received.pkt->data = media_packet->data;
+        decoder_.DecodeFec(received, &recovered_packets_);
+      }
+    }
+  }
+
+  void DecodeFec(const std::set<int>& lost) {
+    int i = 0;
+    for (const auto& fec_packet : fec_packets_) {
+      if (lost.count(i++) == 0) {
+        decoder_.DecodeFec(*fec_packet, &recovered_packets_);
+      }
+    }
+  }
+
+  // Returns true if all media packets are in |recovered_packets_|, bit exact,
+  // and exactly the |lost| ones are marked as recovered.
+  bool IsRecoveryComplete(const std::set<int>& lost) {
+    if (recovered_packets_.size() != media_packets_.size()) {
+      return false;
+    }
+    auto recovered_it = recovered_packets_.begin();
+    int i = 0;
+    for (const auto& media_packet : media_packets_) {
+      const auto& recovered = *recovered_it++;
+      if (recovered->was_recovered != (lost.count(i++) != 0) ||
+          recovered->pkt->data != media_packet->data) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Random random_;
+  test::fec::MediaPacketGenerator media_packet_generator_;
+  ReedSolomonFec encoder_;
+  ReedSolomonFec decoder_;
+  PacketList media_packets_;
+  std::vector<std::unique_ptr<ReceivedPacket>> fec_packets_;
+  RecoveredPacketList recovered_packets_;
+};
+
+TEST_F(ReedSolomonFecTest, GeneratesRepairPacketsForProtectionFactor) {
+  Encode(kNumMediaPackets, kProtectionFactor);
+  EXPECT_EQ(3u, fec_packets_.size());
+}
+
+TEST_F(ReedSolomonFecTest, NoRecoveryWithoutLoss) {
+  Encode(kNumMediaPackets, kProtectionFactor);
+  DecodeMedia({});
+  DecodeFec({});
+  EXPECT_TRUE(IsRecoveryComplete({}));
+}
+
+TEST_F(ReedSolomonFecTest, RecoversAsManyLossesAsRepairPackets) {
+  Encode(kNumMediaPackets, kProtectionFactor);
+  const std::set<int> lost = {0, 4, 5};
+  DecodeMedia(lost);
+  DecodeFec({});
+  EXPECT_TRUE(IsRecoveryComplete(lost));
+}
+
+TEST_F(ReedSolomonFecTest, RecoversBurstLossWithAnyRepairPackets) {
+  Encode(kNumMediaPackets, kProtectionFactor);
+  const std::set<int> lost = {7, 8};
+  DecodeMedia(lost);
+  DecodeFec({0});
+  EXPECT_TRUE(IsRecoveryComplete(lost));
+}
+
+TEST_F(ReedSolomonFecTest, RecoversWhenMediaArrivesAfterRepairPackets) {
+  Encode(kNumMediaPackets, kProtectionFactor);
+  const std::set<int> lost = {1, 9};
+  DecodeFec({2});
+  DecodeMedia(lost);
+  EXPECT_TRUE(IsRecoveryComplete(lost));
+}
+
+TEST_F(ReedSolomonFecTest, DoesNotRecoverMoreLossesThanRepairPackets) {
+  Encode(kNumMediaPackets, kProtectionFactor);
+  const std::set<int> lost = {2, 3, 6, 8};
+  DecodeMedia(lost);
+  DecodeFec({});
+  EXPECT_EQ(static_cast<size_t>(kNumMediaPackets) - lost.size(),
+            recovered_packets_.size());
+  for (const auto& recovered : recovered_packets_) {
+    EXPECT_FALSE(recovered->was_recovered);
+  }
+}
+
+TEST_F(ReedSolomonFecTest, RecoversAllMediaPacketsWithFullProtection) {
+  Encode(kNumMediaPackets, 255);
+  ASSERT_EQ(static_cast<size_t>(kNumMediaPackets), fec_packets_.size());
+  std::set<int> lost;
+  for (int i = 0; i < kNumMediaPackets; ++i) {
+    lost.insert(i);
+  }
+  DecodeFec({});
+  EXPECT_TRUE(IsRecoveryComplete(lost));
+}
+
+TEST_F(ReedSolomonFecTest, RecoversMaximumBlock) {
+  Encode(kUlpfecMaxMediaPackets, 128);
+  const std::set<int> lost = {0, 1, 2, 10, 20, 30, 40, 45, 46, 47};
+  DecodeMedia(lost);
+  DecodeFec({3, 5, 7});
+  EXPECT_TRUE(IsRecoveryComplete(lost));
+}
+
+TEST_F(ReedSolomonFecTest, IgnoresTruncatedRepairPackets) {
+  Encode(kNumMediaPackets, kProtectionFactor);
+  for (auto& fec_packet : fec_packets_) {
+    fec_packet->pkt->data.SetSize(fec_packet->pkt->data.size() - 1);
+  }
+  const std::set<int> lost = {5};
+  DecodeMedia(lost);
+  DecodeFec({});
+  EXPECT_EQ(static_cast<size_t>(kNumMediaPackets) - 1,
+            recovered_packets_.size());
+}
+
+TEST_F(ReedSolomonFecTest, FailsToEncodeTooManyMediaPackets) {
+  PacketList media_packets = media_packet_generator_.ConstructMediaPackets(
+      kUlpfecMaxMediaPackets + 1, kStartSeqNum);
+  std::list<Packet*> fec_packets;
+  EXPECT_EQ(-1, encoder_.EncodeFec(media_packets, kProtectionFactor, 0, false,
+                                   kFecMaskRandom, &fec_packets));
+}
+
+}  // namespace
+
+}  // namespace webrtc
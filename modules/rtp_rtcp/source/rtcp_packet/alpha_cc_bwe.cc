@@ -0,0 +1,347 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/rtp_rtcp/source/rtcp_packet/alpha_cc_bwe.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+namespace rtcp {
+namespace {
+
+constexpr uint8_t kHasPacingRate = 1 << 0;
+constexpr uint8_t kHasPaddingRate = 1 << 1;
+constexpr uint8_t kHasConfidence = 1 << 2;
+constexpr uint8_t kHasRtt = 1 << 3;
+constexpr uint8_t kHasLossRatio = 1 << 4;
+constexpr uint8_t kHasStreamEstimates = 1 << 5;
+
+// Size of the raw in-memory BweMessage sent by legacy receivers.
+constexpr size_t kLegacyDataSize = 24;
+// Upper bound of a 64 bit value encoded as varint.
+constexpr size_t kMaxVarIntLength = 10;
+// The rates are handed on as int32_t bps, larger ones are rejected.
+constexpr uint64_t kMaxRateKbps = std::numeric_limits<int32_t>::max() / 1000;
+// Version, flags, timestamp and target rate.
+constexpr size_t kMaxRequiredSize = 2 + 2 * kMaxVarIntLength;
+static_assert(kMaxRequiredSize <= AlphaCcBwe::kMaxDataSize,
+              "The required fields must always fit");
+static_assert(AlphaCcBwe::kMaxDataSize % 4 == 0,
+              "The padding must not exceed the maximum size");
+
+size_t VarIntLength(uint64_t value) {
+  size_t length = 1;
+  while (value >>= 7)
+    ++length;
+  return length;
+}
+
+class Writer {
+ public:
+  explicit Writer(rtc::Buffer* buffer) : buffer_(buffer) {}
+
+  void WriteByte(uint8_t value) { buffer_->AppendData(&value, 1); }
+
+  void WriteVarInt(uint64_t value) {
+    uint8_t bytes[kMaxVarIntLength];
+    size_t size = 0;
+    do {
+      uint8_t byte = value & 0x7f;
+      value >>= 7;
+      if (value != 0)
+        byte |= 0x80;
+      bytes[size++] = byte;
+    } while (value != 0);
+    buffer_->AppendData(bytes, size);
+  }
+
+  void WriteUint32(uint32_t value) {
+    uint8_t bytes[4];
+    ByteWriter<uint32_t>::WriteBigEndian(bytes, value);
+    buffer_->AppendData(bytes, sizeof(bytes));
+  }
+
+ private:
+  rtc::Buffer* const buffer_;
+};
+
+class Reader {
+ public:
+  explicit Reader(rtc::ArrayView<const uint8_t> data) : data_(data) {}
+
+  bool ReadByte(uint8_t* value) {
+    if (pos_ >= data_.size())
+      return false;
+    *value = data_[pos_++];
+    return true;
+  }
+
+  bool ReadVarInt(uint64_t* value) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < kMaxVarIntLength; ++i) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      result |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+      if ((byte & 0x80) == 0) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadUint32(uint32_t* value) {
+    if (data_.size() - pos_ < 4)
+      return false;
+    *value = ByteReader<uint32_t>::ReadBigEndian(&data_[pos_]);
+    pos_ += 4;
+    return true;
+  }
+
+ private:
+  const rtc::ArrayView<const uint8_t> data_;
+  size_t pos_ = 0;
+};
+
+uint64_t RateToKbps(float rate_bps) {
+  if (!(rate_bps > 0))
+    return 0;
+  return std::min(rtc::saturated_cast<uint64_t>(std::round(rate_bps / 1000.0)),
+                  kMaxRateKbps);
+}
+
+float KbpsToRate(uint64_t rate_kbps) {
+  return static_cast<float>(rate_kbps) * 1000.0f;
+}
+
+bool ReadRate(Reader* reader, float* rate_bps) {
+  uint64_t rate_kbps;
+  if (!reader->ReadVarInt(&rate_kbps) || rate_kbps > kMaxRateKbps)
+    return false;
+  *rate_bps = KbpsToRate(rate_kbps);
+  return true;
+}
+
+// Also false for NaN.
+bool IsValidLegacyRate(float rate_bps) {
+  return rate_bps >= 0 && rate_bps <= kMaxRateKbps * 1000.0f;
+}
+
+uint8_t RatioToByte(float ratio) {
+  return static_cast<uint8_t>(
+      std::round(std::min(std::max(ratio, 0.0f), 1.0f) * 255.0f));
+}
+
+float ByteToRatio(uint8_t value) {
+  return value / 255.0f;
+}
+
+float ReadLittleEndianFloat(const uint8_t* data) {
+  uint32_t bits = ByteReader<uint32_t>::ReadLittleEndian(data);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+bool ParseLegacyData(rtc::ArrayView<const uint8_t> data, BweMessage* bwe) {
+  if (data.size() != kLegacyDataSize) {
+    RTC_LOG(LS_WARNING) << "Unexpected legacy AlphaCC BWE size "
+                        << data.size();
+    return false;
+  }
+  BweMessage result;
+  result.timestamp_ms = ByteReader<int64_t>::ReadLittleEndian(&data[0]);
+  result.target_rate = ReadLittleEndianFloat(&data[8]);
+  result.pacing_rate = ReadLittleEndianFloat(&data[12]);
+  result.padding_rate = ReadLittleEndianFloat(&data[16]);
+  if (!IsValidLegacyRate(result.target_rate) ||
+      !IsValidLegacyRate(result.pacing_rate) ||
+      !IsValidLegacyRate(result.padding_rate)) {
+    RTC_LOG(LS_WARNING) << "Legacy AlphaCC BWE rate out of range";
+    return false;
+  }
+  *bwe = std::move(result);
+  return true;
+}
+
+}  // namespace
+
+constexpr uint32_t AlphaCcBwe::kName;
+constexpr uint8_t AlphaCcBwe::kLegacySubType;
+constexpr uint8_t AlphaCcBwe::kSubType;
+constexpr uint8_t AlphaCcBwe::kVersion;
+constexpr size_t AlphaCcBwe::kMaxStreamEstimates;
+constexpr size_t AlphaCcBwe::kMaxDataSize;
+
+AlphaCcBwe::AlphaCcBwe() {
+  SetSubType(kSubType);
+  SetName(kName);
+  SetSenderSsrc(0);
+}
+
+AlphaCcBwe::~AlphaCcBwe() = default;
+
+bool AlphaCcBwe::IsAlphaCcBwe(const App& app) {
+  return app.name() == kName &&
+         (app.sub_type() == kSubType || app.sub_type() == kLegacySubType);
+}
+
+bool AlphaCcBwe::Parse(const App& app, BweMessage* bwe) {
+  if (!IsAlphaCcBwe(app))
+    return false;
+  rtc::ArrayView<const uint8_t> data(app.data(), app.data_size());
+  if (app.sub_type() == kLegacySubType)
+    return ParseLegacyData(data, bwe);
+  return ParseData(data, bwe);
+}
+
+rtc::Buffer AlphaCcBwe::Serialize(const BweMessage& bwe) {
+  const uint64_t timestamp_ms =
+      static_cast<uint64_t>(std::max<int64_t>(bwe.timestamp_ms, 0));
+  const uint64_t target_kbps = RateToKbps(bwe.target_rate);
+  const uint64_t pacing_kbps = RateToKbps(bwe.pacing_rate);
+  const uint64_t padding_kbps = RateToKbps(bwe.padding_rate);
+  size_t size = 2 + VarIntLength(timestamp_ms) + VarIntLength(target_kbps);
+  // Reserves |field_size| bytes for an optional field if it fits.
+  auto fits = [&size](size_t field_size) {
+    if (size + field_size > kMaxDataSize)
+      return false;
+    size += field_size;
+    return true;
+  };
+
+  uint8_t flags = 0;
+  if (pacing_kbps != target_kbps && fits(VarIntLength(pacing_kbps)))
+    flags |= kHasPacingRate;
+  if (padding_kbps != 0 && fits(VarIntLength(padding_kbps)))
+    flags |= kHasPaddingRate;
+  if (bwe.confidence && fits(1))
+    flags |= kHasConfidence;
+  if (bwe.rtt_ms && *bwe.rtt_ms >= 0 &&
+      fits(VarIntLength(static_cast<uint64_t>(*bwe.rtt_ms)))) {
+    flags |= kHasRtt;
+  }
+  if (bwe.loss_ratio && fits(1))
+    flags |= kHasLossRatio;
+  if (!bwe.stream_estimates.empty() &&
+      bwe.stream_estimates.size() <= kMaxStreamEstimates) {
+    size_t streams_size = 1;
+    for (const BweMessage::StreamEstimate& stream : bwe.stream_estimates)
+      streams_size += 4 + VarIntLength(RateToKbps(stream.target_rate));
+    if (fits(streams_size))
+      flags |= kHasStreamEstimates;
+  }
+
+  rtc::Buffer buffer;
+  Writer writer(&buffer);
+  writer.WriteByte(kVersion);
+  writer.WriteByte(flags);
+  writer.WriteVarInt(timestamp_ms);
+  writer.WriteVarInt(target_kbps);
+  if (flags & kHasPacingRate)
+    writer.WriteVarInt(pacing_kbps);
+  if (flags & kHasPaddingRate)
+    writer.WriteVarInt(padding_kbps);
+  if (flags & kHasConfidence)
+    writer.WriteByte(RatioToByte(*bwe.confidence));
+  if (flags & kHasRtt)
+    writer.WriteVarInt(static_cast<uint64_t>(*bwe.rtt_ms));
+  if (flags & kHasLossRatio)
+    writer.WriteByte(RatioToByte(*bwe.loss_ratio));
+  if (flags & kHasStreamEstimates) {
+    writer.WriteByte(static_cast<uint8_t>(bwe.stream_estimates.size()));
+    for (const BweMessage::StreamEstimate& stream : bwe.stream_estimates) {
+      writer.WriteUint32(stream.ssrc);
+      writer.WriteVarInt(RateToKbps(stream.target_rate));
+    }
+  }
+  RTC_DCHECK_EQ(buffer.size(), size);
+  // App data must be 32 bit aligned.
+  while (buffer.size() % 4 != 0)
+    writer.WriteByte(0);
+  return buffer;
+}
+
+bool AlphaCcBwe::ParseData(rtc::ArrayView<const uint8_t> data,
+                           BweMessage* bwe) {
+  Reader reader(data);
+  uint8_t version;
+  uint8_t flags;
+  if (!reader.ReadByte(&version) || !reader.ReadByte(&flags))
+    return false;
+  if (version != kVersion) {
+    RTC_LOG(LS_WARNING) << "Unsupported AlphaCC BWE version "
+                        << static_cast<int>(version);
+    return false;
+  }
+  uint64_t value;
+  BweMessage result;
+  if (!reader.ReadVarInt(&value))
+    return false;
+  result.timestamp_ms = rtc::saturated_cast<int64_t>(value);
+  if (!ReadRate(&reader, &result.target_rate))
+    return false;
+  result.pacing_rate = result.target_rate;
+  result.padding_rate = 0;
+  if ((flags & kHasPacingRate) && !ReadRate(&reader, &result.pacing_rate))
+    return false;
+  if ((flags & kHasPaddingRate) && !ReadRate(&reader, &result.padding_rate))
+    return false;
+  uint8_t byte;
+  if (flags & kHasConfidence) {
+    if (!reader.ReadByte(&byte))
+      return false;
+    result.confidence = ByteToRatio(byte);
+  }
+  if (flags & kHasRtt) {
+    if (!reader.ReadVarInt(&value))
+      return false;
+    result.rtt_ms = rtc::saturated_cast<int64_t>(value);
+  }
+  if (flags & kHasLossRatio) {
+    if (!reader.ReadByte(&byte))
+      return false;
+    result.loss_ratio = ByteToRatio(byte);
+  }
+  if (flags & kHasStreamEstimates) {
+    uint8_t count;
+    if (!reader.ReadByte(&count))
+      return false;
+    result.stream_estimates.resize(count);
+    for (BweMessage::StreamEstimate& stream : result.stream_estimates) {
+      if (!reader.ReadUint32(&stream.ssrc) ||
+          !ReadRate(&reader, &stream.target_rate)) {
+        return false;
+      }
+    }
+  }
+  // Unknown flags and trailing padding are ignored so that future minor
+  // additions remain readable.
+  *bwe = std::move(result);
+  return true;
+}
+
+void AlphaCcBwe::SetBwe(const BweMessage& bwe) {
+  rtc::Buffer data = Serialize(bwe);
+  SetData(data.data(), data.size());
+}
+
+}  // namespace rtcp
+}  // namespace webrtc
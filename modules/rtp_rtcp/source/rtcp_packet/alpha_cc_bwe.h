@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_ALPHA_CC_BWE_H_
+#define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_ALPHA_CC_BWE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+#include "api/transport/network_types.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/app.h"
+#include "rtc_base/buffer.h"
+
+namespace webrtc {
+namespace rtcp {
+
+// The AlphaCC bandwidth estimate sent from the receiver to the sender in an
+// RTCP APP packet.
+//
+// Data layout, all multi-byte integers are unsigned LEB128 varints unless
+// noted otherwise, rates are in kbps:
+//   version (1 byte), flags (1 byte), timestamp_ms, target_rate,
+//   [pacing_rate], [padding_rate], [confidence (1 byte, 1/255 units)],
+//   [rtt_ms], [loss_ratio (1 byte, 1/255 units)],
+//   [stream count (1 byte), {ssrc (4 bytes, big endian), target_rate}...]
+// followed by zero padding up to a multiple of 4 bytes. Optional fields are
+// present only if their flag is set. A typical message is 8-12 bytes.
+//
+// The data never exceeds kMaxDataSize, the size of the legacy format, so that
+// the estimates do not add to the feedback overhead. Optional fields are added
+// in the order above as long as they fit, and the stream estimates are sent
+// all or none. |timestamp_ms| is sent in full rather than as a delta to the
+// previous estimate: the estimates are sent unreliably and parsed without
+// state, so a delta would not survive a lost packet.
+//
+// Packets using the legacy sub type carry the raw in-memory BweMessage of
+// older receivers (int64 timestamp and three floats, little endian, 24 bytes)
+// and are still accepted by Parse().
+class AlphaCcBwe : public App {
+ public:
+  static constexpr uint32_t kName = NameToInt("rate");
+  static constexpr uint8_t kLegacySubType = 1;
+  static constexpr uint8_t kSubType = 2;
+  static constexpr uint8_t kVersion = 1;
+  static constexpr size_t kMaxStreamEstimates = 255;
+  static constexpr size_t kMaxDataSize = 24;
+
+  AlphaCcBwe();
+  ~AlphaCcBwe() override;
+
+  // Returns true if |app| carries an AlphaCC estimate in either format.
+  static bool IsAlphaCcBwe(const App& app);
+  // Parses the data of |app| into |bwe|. Returns false if |app| is not an
+  // AlphaCC estimate or is malformed.
+  static bool Parse(const App& app, BweMessage* bwe);
+
+  static rtc::Buffer Serialize(const BweMessage& bwe);
+  static bool ParseData(rtc::ArrayView<const uint8_t> data, BweMessage* bwe);
+
+  void SetBwe(const BweMessage& bwe);
+};
+
+}  // namespace rtcp
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_ALPHA_CC_BWE_H_
@@ -0,0 +1,258 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/rtp_rtcp/source/rtcp_packet/alpha_cc_bwe.h"
+
+#include <string.h>
+
+#include <limits>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace rtcp {
+namespace {
+
+BweMessage CreateBwe() {
+  BweMessage bwe;
+  bwe.timestamp_ms = 123456;
+  bwe.target_rate = 1500000;
+  bwe.pacing_rate = 1500000;
+  bwe.padding_rate = 0;
+  return bwe;
+}
+
+}  // namespace
+
+TEST(AlphaCcBweTest, EncodesTypicalEstimateCompactly) {
+  rtc::Buffer data = AlphaCcBwe::Serialize(CreateBwe());
+  EXPECT_LT(data.size(), 24u);
+  EXPECT_EQ(data.size() % 4, 0u);
+
+  BweMessage dst;
+  EXPECT_TRUE(AlphaCcBwe::ParseData(data, &dst));
+  EXPECT_EQ(dst.timestamp_ms, 123456);
+  EXPECT_EQ(dst.target_rate, 1500000);
+  EXPECT_EQ(dst.pacing_rate, 1500000);
+  EXPECT_EQ(dst.padding_rate, 0);
+  EXPECT_FALSE(dst.confidence);
+  EXPECT_FALSE(dst.rtt_ms);
+  EXPECT_FALSE(dst.loss_ratio);
+  EXPECT_TRUE(dst.stream_estimates.empty());
+}
+
+TEST(AlphaCcBweTest, EncodesOptionalFields) {
+  BweMessage src = CreateBwe();
+  src.pacing_rate = 1800000;
+  src.padding_rate = 200000;
+  src.confidence = 1.0f;
+  src.rtt_ms = 80;
+  src.loss_ratio = 0.0f;
+  rtc::Buffer data = AlphaCcBwe::Serialize(src);
+
+  BweMessage dst;
+  EXPECT_TRUE(AlphaCcBwe::ParseData(data, &dst));
+  EXPECT_EQ(dst.pacing_rate, 1800000);
+  EXPECT_EQ(dst.padding_rate, 200000);
+  EXPECT_EQ(dst.confidence, 1.0f);
+  EXPECT_EQ(dst.rtt_ms, 80);
+  EXPECT_EQ(dst.loss_ratio, 0.0f);
+}
+
+TEST(AlphaCcBweTest, EncodesStreamEstimates) {
+  BweMessage src = CreateBwe();
+  src.stream_estimates.push_back({0x12345678, 1000000});
+  src.stream_estimates.push_back({0x9abcdef0, 500000});
+  rtc::Buffer data = AlphaCcBwe::Serialize(src);
+
+  BweMessage dst;
+  EXPECT_TRUE(AlphaCcBwe::ParseData(data, &dst));
+  ASSERT_EQ(dst.stream_estimates.size(), 2u);
+  EXPECT_EQ(dst.stream_estimates[0].ssrc, 0x12345678u);
+  EXPECT_EQ(dst.stream_estimates[0].target_rate, 1000000);
+  EXPECT_EQ(dst.stream_estimates[1].ssrc, 0x9abcdef0u);
+  EXPECT_EQ(dst.stream_estimates[1].target_rate, 500000);
+}
+
+TEST(AlphaCcBweTest, EncodesAsManyStreamEstimatesAsFit) {
+  // 7 bytes of required fields and a count byte leave room for three streams
+  // of 5 bytes each.
+  BweMessage src = CreateBwe();
+  for (uint32_t ssrc = 1; ssrc <= 3; ++ssrc)
+    src.stream_estimates.push_back({ssrc, 100000});
+  rtc::Buffer data = AlphaCcBwe::Serialize(src);
+  EXPECT_EQ(data.size(), AlphaCcBwe::kMaxDataSize);
+
+  BweMessage dst;
+  EXPECT_TRUE(AlphaCcBwe::ParseData(data, &dst));
+  ASSERT_EQ(dst.stream_estimates.size(), 3u);
+  for (uint32_t ssrc = 1; ssrc <= 3; ++ssrc) {
+    EXPECT_EQ(dst.stream_estimates[ssrc - 1].ssrc, ssrc);
+    EXPECT_EQ(dst.stream_estimates[ssrc - 1].target_rate, 100000);
+  }
+
+  // A partial split would be wrong, so all the streams are left out.
+  src.stream_estimates.push_back({4, 100000});
+  data = AlphaCcBwe::Serialize(src);
+  EXPECT_LE(data.size(), AlphaCcBwe::kMaxDataSize);
+  EXPECT_TRUE(AlphaCcBwe::ParseData(data, &dst));
+  EXPECT_TRUE(dst.stream_estimates.empty());
+  EXPECT_EQ(dst.target_rate, 1500000);
+}
+
+TEST(AlphaCcBweTest, NeverExceedsMaxDataSize) {
+  BweMessage src;
+  src.timestamp_ms = std::numeric_limits<int64_t>::max();
+  src.target_rate = std::numeric_limits<float>::max();
+  src.pacing_rate = 1000000;
+  src.padding_rate = 1000000;
+  src.confidence = 0.5f;
+  src.rtt_ms = 100;
+  src.loss_ratio = 0.1f;
+  for (uint32_t ssrc = 0; ssrc < AlphaCcBwe::kMaxStreamEstimates; ++ssrc)
+    src.stream_estimates.push_back({ssrc, 1000000});
+  rtc::Buffer data = AlphaCcBwe::Serialize(src);
+  EXPECT_LE(data.size(), AlphaCcBwe::kMaxDataSize);
+
+  // The optional fields that do not fit are left out.
+  BweMessage dst;
+  EXPECT_TRUE(AlphaCcBwe::ParseData(data, &dst));
+  EXPECT_EQ(dst.timestamp_ms, std::numeric_limits<int64_t>::max());
+  // The target rate is capped to what the parser accepts.
+  EXPECT_LT(dst.target_rate, std::numeric_limits<int32_t>::max());
+  EXPECT_EQ(dst.pacing_rate, 1000000);
+  EXPECT_TRUE(dst.stream_estimates.empty());
+}
+
+TEST(AlphaCcBweTest, RoundsRatesToKbps) {
+  BweMessage src = CreateBwe();
+  src.target_rate = 1234567;
+  src.pacing_rate = 1234567;
+  rtc::Buffer data = AlphaCcBwe::Serialize(src);
+
+  BweMessage dst;
+  EXPECT_TRUE(AlphaCcBwe::ParseData(data, &dst));
+  EXPECT_EQ(dst.target_rate, 1235000);
+  EXPECT_EQ(dst.pacing_rate, 1235000);
+}
+
+TEST(AlphaCcBweTest, ParsesThroughAppPacket) {
+  AlphaCcBwe packet;
+  packet.SetBwe(CreateBwe());
+  EXPECT_TRUE(AlphaCcBwe::IsAlphaCcBwe(packet));
+
+  BweMessage dst;
+  EXPECT_TRUE(AlphaCcBwe::Parse(packet, &dst));
+  EXPECT_EQ(dst.target_rate, 1500000);
+}
+
+TEST(AlphaCcBweTest, ParsesLegacyFormat) {
+  struct {
+    int64_t timestamp_ms;
+    float target_rate;
+    float pacing_rate;
+    float padding_rate;
+    uint32_t reserved;
+  } legacy = {987654, 300000, 450000, 10000, 0};
+  uint8_t data[24];
+  static_assert(sizeof(legacy) == sizeof(data), "");
+  memcpy(data, &legacy, sizeof(data));
+
+  App app;
+  app.SetSubType(AlphaCcBwe::kLegacySubType);
+  app.SetName(AlphaCcBwe::kName);
+  app.SetData(data, sizeof(data));
+
+  BweMessage dst;
+  EXPECT_TRUE(AlphaCcBwe::Parse(app, &dst));
+  EXPECT_EQ(dst.timestamp_ms, 987654);
+  EXPECT_EQ(dst.target_rate, 300000);
+  EXPECT_EQ(dst.pacing_rate, 450000);
+  EXPECT_EQ(dst.padding_rate, 10000);
+}
+
+TEST(AlphaCcBweTest, RejectsOtherAppPackets) {
+  App app;
+  app.SetSubType(AlphaCcBwe::kSubType);
+  app.SetName(App::NameToInt("abcd"));
+  rtc::Buffer data = AlphaCcBwe::Serialize(CreateBwe());
+  app.SetData(data.data(), data.size());
+
+  BweMessage dst;
+  EXPECT_FALSE(AlphaCcBwe::Parse(app, &dst));
+}
+
+TEST(AlphaCcBweTest, RejectsTruncatedData) {
+  BweMessage src = CreateBwe();
+  src.stream_estimates.push_back({0x12345678, 1000000});
+  rtc::Buffer data = AlphaCcBwe::Serialize(src);
+
+  BweMessage dst;
+  for (size_t size = 0; size < 8; ++size) {
+    EXPECT_FALSE(AlphaCcBwe::ParseData(
+        rtc::ArrayView<const uint8_t>(data.data(), size), &dst));
+  }
+}
+
+TEST(AlphaCcBweTest, RejectsUnknownVersion) {
+  rtc::Buffer data = AlphaCcBwe::Serialize(CreateBwe());
+  data[0] = AlphaCcBwe::kVersion + 1;
+
+  BweMessage dst;
+  EXPECT_FALSE(AlphaCcBwe::ParseData(data, &dst));
+}
+
+TEST(AlphaCcBweTest, RejectsOversizedRates) {
+  // Version, flags, timestamp 0, then a target rate of 2^63 kbps.
+  const uint8_t kOversizedTarget[] = {AlphaCcBwe::kVersion, 0, 0, 0x80, 0x80,
+                                      0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+                                      0x80, 0x01};
+  BweMessage dst;
+  EXPECT_FALSE(AlphaCcBwe::ParseData(kOversizedTarget, &dst));
+
+  BweMessage src = CreateBwe();
+  src.target_rate = 3e9;
+  src.pacing_rate = 4e12;
+  src.stream_estimates.push_back({0x12345678, 5e20});
+  rtc::Buffer data = AlphaCcBwe::Serialize(src);
+  ASSERT_TRUE(AlphaCcBwe::ParseData(data, &dst));
+  EXPECT_LT(dst.target_rate, std::numeric_limits<int32_t>::max());
+  EXPECT_LT(dst.pacing_rate, std::numeric_limits<int32_t>::max());
+  ASSERT_EQ(dst.stream_estimates.size(), 1u);
+  EXPECT_LT(dst.stream_estimates[0].target_rate,
+            std::numeric_limits<int32_t>::max());
+}
+
+TEST(AlphaCcBweTest, RejectsLegacyRatesOutOfRange) {
+  for (float rate : {-1.0f, 3e9f, std::numeric_limits<float>::infinity(),
+                     std::numeric_limits<float>::quiet_NaN()}) {
+    struct {
+      int64_t timestamp_ms;
+      float target_rate;
+      float pacing_rate;
+      float padding_rate;
+      uint32_t reserved;
+    } legacy = {987654, rate, 450000, 10000, 0};
+    uint8_t data[24];
+    static_assert(sizeof(legacy) == sizeof(data), "");
+    memcpy(data, &legacy, sizeof(data));
+
+    App app;
+    app.SetSubType(AlphaCcBwe::kLegacySubType);
+    app.SetName(AlphaCcBwe::kName);
+    app.SetData(data, sizeof(data));
+
+    BweMessage dst;
+    EXPECT_FALSE(AlphaCcBwe::Parse(app, &dst)) << rate;
+    EXPECT_EQ(dst.target_rate, BweMessage().target_rate);
+  }
+}
+
+}  // namespace rtcp
+}  // namespace webrtc
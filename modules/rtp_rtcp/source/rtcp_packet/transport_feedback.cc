@@ -74,6 +74,7 @@ constexpr int64_t kTimeWrapPeriodUs = (1ll << 24) * kBaseScaleFactor;
 }  // namespace
 constexpr uint8_t TransportFeedback::kFeedbackMessageType;
 constexpr size_t TransportFeedback::kMaxReportedPackets;
+constexpr int64_t TransportFeedback::kNotReceived;
 
 constexpr size_t TransportFeedback::LastChunk::kMaxRunLengthCapacity;
 constexpr size_t TransportFeedback::LastChunk::kMaxOneBitCapacity;
@@ -309,9 +310,88 @@ void TransportFeedback::SetFeedbackSequenceNumber(uint8_t feedback_sequence) {
 
 bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
                                           int64_t timestamp_us) {
+  int16_t delta;
+  if (!GetDeltaTicks(timestamp_us, &delta))
+    return false;
+
+  uint16_t next_seq_no = base_seq_no_ + num_seq_no_;
+  if (sequence_number != next_seq_no) {
+    uint16_t last_seq_no = next_seq_no - 1;
+    if (!IsNewerSequenceNumber(sequence_number, last_seq_no))
+      return false;
+    for (; next_seq_no != sequence_number; ++next_seq_no) {
+      if (!AddDeltaSize(0))
+        return false;
+      if (include_lost_)
+        all_packets_.emplace_back(next_seq_no);
+    }
+  }
+
+  return AddReceivedDelta(sequence_number, delta);
+}
+
+size_t TransportFeedback::AddReceivedPackets(
+    uint16_t first_sequence_number,
+    rtc::ArrayView<const int64_t> timestamps_us) {
+  size_t num_received = 0;
+  size_t end = 0;
+  for (size_t i = 0; i < timestamps_us.size(); ++i) {
+    if (timestamps_us[i] != kNotReceived) {
+      ++num_received;
+      end = i + 1;
+    }
+  }
+  if (num_received == 0)
+    return 0;
+
+  // Reserve for every packet up front. A chunk holds at least 7 statuses.
+  constexpr size_t kMinStatusesPerChunk = 7;
+  received_packets_.reserve(received_packets_.size() + num_received);
+  if (include_lost_)
+    all_packets_.reserve(all_packets_.size() + end);
+  encoded_chunks_.reserve(encoded_chunks_.size() +
+                          end / kMinStatusesPerChunk + 1);
+
+  // The first packet goes through the checks of AddReceivedPacket(), which
+  // also reports the packets missing before it. The following ones are known
+  // to be in order.
+  size_t index = 0;
+  while (timestamps_us[index] == kNotReceived)
+    ++index;
+  if (!AddReceivedPacket(static_cast<uint16_t>(first_sequence_number + index),
+                         timestamps_us[index])) {
+    return 0;
+  }
+  size_t covered = index + 1;
+
+  for (index = covered; index < end; ++index) {
+    if (timestamps_us[index] == kNotReceived)
+      continue;
+    int16_t delta;
+    if (!GetDeltaTicks(timestamps_us[index], &delta))
+      return covered;
+    // Report the packets missing since the previous received one.
+    for (size_t lost = covered; lost < index; ++lost) {
+      if (!AddDeltaSize(0))
+        return covered;
+      if (include_lost_)
+        all_packets_.emplace_back(
+            static_cast<uint16_t>(first_sequence_number + lost));
+    }
+    if (!AddReceivedDelta(
+            static_cast<uint16_t>(first_sequence_number + index), delta)) {
+      return covered;
+    }
+    covered = index + 1;
+  }
+  return covered;
+}
+
+bool TransportFeedback::GetDeltaTicks(int64_t timestamp_us,
+                                      int16_t* delta) const {
   // Set delta to zero if timestamps are not included, this will simplify the
   // encoding process.
-  int16_t delta = 0;
+  *delta = 0;
   if (include_timestamps_) {
     // Convert to ticks and round.
     int64_t delta_full =
@@ -322,27 +402,18 @@ bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
         delta_full < 0 ? -(kDeltaScaleFactor / 2) : kDeltaScaleFactor / 2;
     delta_full /= kDeltaScaleFactor;
 
-    delta = static_cast<int16_t>(delta_full);
+    *delta = static_cast<int16_t>(delta_full);
     // If larger than 16bit signed, we can't represent it - need new fb packet.
-    if (delta != delta_full) {
+    if (*delta != delta_full) {
       RTC_LOG(LS_WARNING) << "Delta value too large ( >= 2^16 ticks )";
       return false;
     }
   }
+  return true;
+}
 
-  uint16_t next_seq_no = base_seq_no_ + num_seq_no_;
-  if (sequence_number != next_seq_no) {
-    uint16_t last_seq_no = next_seq_no - 1;
-    if (!IsNewerSequenceNumber(sequence_number, last_seq_no))
-      return false;
-    for (; next_seq_no != sequence_number; ++next_seq_no) {
-      if (!AddDeltaSize(0))
-        return false;
-      if (include_lost_)
-        all_packets_.emplace_back(next_seq_no);
-    }
-  }
-
+bool TransportFeedback::AddReceivedDelta(uint16_t sequence_number,
+                                         int16_t delta) {
   DeltaSize delta_size = (delta >= 0 && delta <= 0xff) ? 1 : 2;
   if (!AddDeltaSize(delta_size))
     return false;
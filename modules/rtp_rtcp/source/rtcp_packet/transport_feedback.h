@@ -11,9 +11,11 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_TRANSPORT_FEEDBACK_H_
 #define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_TRANSPORT_FEEDBACK_H_
 
+#include <limits>
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/units/time_delta.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
 
@@ -51,6 +53,8 @@ class TransportFeedback : public Rtpfb {
   static constexpr int kDeltaScaleFactor = 250;
   // Maximum number of packets (including missing) TransportFeedback can report.
   static constexpr size_t kMaxReportedPackets = 0xffff;
+  // Marks a packet that wasn't received in AddReceivedPackets().
+  static constexpr int64_t kNotReceived = std::numeric_limits<int64_t>::min();
 
   TransportFeedback();
 
@@ -68,6 +72,15 @@ class TransportFeedback : public Rtpfb {
   void SetFeedbackSequenceNumber(uint8_t feedback_sequence);
   // NOTE: This method requires increasing sequence numbers (excepting wraps).
   bool AddReceivedPacket(uint16_t sequence_number, int64_t timestamp_us);
+  // Equivalent to calling AddReceivedPacket() for every received packet in
+  // order, where |timestamps_us[i]| is the receive time of
+  // |first_sequence_number| + i or kNotReceived. Encodes all of them in one
+  // pass with the buffers sized up front, which is faster for many packets.
+  // Returns the number of entries of |timestamps_us| covered by the packet:
+  // one past the last received packet that could be added, so 0 if none could
+  // be. Fewer entries are covered when the feedback is full.
+  size_t AddReceivedPackets(uint16_t first_sequence_number,
+                            rtc::ArrayView<const int64_t> timestamps_us);
   const std::vector<ReceivedPacket>& GetReceivedPackets() const;
   const std::vector<ReceivedPacket>& GetAllPackets() const;
 
@@ -158,6 +171,11 @@ class TransportFeedback : public Rtpfb {
   void Clear();
 
   bool AddDeltaSize(DeltaSize delta_size);
+  // Converts |timestamp_us| to ticks since the last added packet. Returns false
+  // if the delta doesn't fit.
+  bool GetDeltaTicks(int64_t timestamp_us, int16_t* delta) const;
+  // Adds a received packet right after the last reported one.
+  bool AddReceivedDelta(uint16_t sequence_number, int16_t delta);
 
   const bool include_lost_;
   uint16_t base_seq_no_;
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+using rtcp::TransportFeedback;
+
+constexpr uint16_t kBaseSequenceNumber = 65000;
+constexpr int64_t kBaseTimeUs = 123456789;
+constexpr int kRounds = 2000;
+
+// Receive times of |num_packets| packets arriving about 1 ms apart, 2% of
+// them lost, the way RemoteEstimatorProxy hands them to a feedback packet.
+std::vector<int64_t> CreateArrivalTimes(int num_packets) {
+  Random random(0x5eed);
+  std::vector<int64_t> timestamps_us(num_packets);
+  int64_t time_us = kBaseTimeUs;
+  for (int64_t& timestamp_us : timestamps_us) {
+    time_us += random.Rand(0, 2000);
+    timestamp_us = random.Rand(0, 99) < 2 ? TransportFeedback::kNotReceived
+                                          : time_us;
+  }
+  timestamps_us[0] = kBaseTimeUs;
+  return timestamps_us;
+}
+
+// Returns the average time in nanoseconds to build and serialize one feedback
+// packet covering |timestamps_us|.
+double MeasureBuildTimeNs(const std::vector<int64_t>& timestamps_us,
+                          bool bulk) {
+  int64_t total_ns = 0;
+  size_t total_size = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    int64_t start_ns = rtc::TimeNanos();
+    TransportFeedback feedback;
+    feedback.SetBase(kBaseSequenceNumber, kBaseTimeUs);
+    if (bulk) {
+      feedback.AddReceivedPackets(kBaseSequenceNumber, timestamps_us);
+    } else {
+      for (size_t i = 0; i < timestamps_us.size(); ++i) {
+        if (timestamps_us[i] != TransportFeedback::kNotReceived)
+          feedback.AddReceivedPacket(kBaseSequenceNumber + i, timestamps_us[i]);
+      }
+    }
+    total_size += feedback.Build().size();
+    total_ns += rtc::TimeNanos() - start_ns;
+  }
+  EXPECT_GT(total_size, 0u);
+  return static_cast<double>(total_ns) / kRounds;
+}
+
+void RunBuildBenchmark(int num_packets) {
+  const std::vector<int64_t> timestamps_us = CreateArrivalTimes(num_packets);
+  const std::string packets = std::to_string(num_packets) + "_packets";
+  test::PrintResult("transport_feedback_build_time", "",
+                    "one_by_one_" + packets,
+                    MeasureBuildTimeNs(timestamps_us, /*bulk=*/false), "ns",
+                    false);
+  test::PrintResult("transport_feedback_build_time", "", "bulk_" + packets,
+                    MeasureBuildTimeNs(timestamps_us, /*bulk=*/true), "ns",
+                    false);
+}
+
+// Returns the average time in nanoseconds to parse the serialized feedback
+// packet covering |timestamps_us|, and to walk its received packets like the
+// send side does.
+double MeasureParseTimeNs(const std::vector<int64_t>& timestamps_us) {
+  TransportFeedback feedback;
+  feedback.SetBase(kBaseSequenceNumber, kBaseTimeUs);
+  feedback.AddReceivedPackets(kBaseSequenceNumber, timestamps_us);
+  const rtc::Buffer buffer = feedback.Build();
+
+  int64_t total_ns = 0;
+  int64_t total_delta_us = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    int64_t start_ns = rtc::TimeNanos();
+    std::unique_ptr<TransportFeedback> parsed =
+        TransportFeedback::ParseFrom(buffer.data(), buffer.size());
+    if (!parsed) {
+      ADD_FAILURE() << "Failed to parse the feedback packet.";
+      return 0;
+    }
+    for (const auto& packet : parsed->GetReceivedPackets())
+      total_delta_us += packet.delta_us();
+    total_ns += rtc::TimeNanos() - start_ns;
+  }
+  EXPECT_GT(total_delta_us, 0);
+  return static_cast<double>(total_ns) / kRounds;
+}
+
+void RunParseBenchmark(int num_packets) {
+  test::PrintResult("transport_feedback_parse_time", "",
+                    std::to_string(num_packets) + "_packets",
+                    MeasureParseTimeNs(CreateArrivalTimes(num_packets)), "ns",
+                    false);
+}
+
+TEST(TransportFeedbackPerformanceTest, BuildTimeWith100Packets) {
+  RunBuildBenchmark(100);
+}
+
+TEST(TransportFeedbackPerformanceTest, BuildTimeWith1000Packets) {
+  RunBuildBenchmark(1000);
+}
+
+TEST(TransportFeedbackPerformanceTest, BuildTimeWith10000Packets) {
+  RunBuildBenchmark(10000);
+}
+
+TEST(TransportFeedbackPerformanceTest, ParseTimeWith100Packets) {
+  RunParseBenchmark(100);
+}
+
+TEST(TransportFeedbackPerformanceTest, ParseTimeWith1000Packets) {
+  RunParseBenchmark(1000);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -13,9 +13,11 @@
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "rtc_base/random.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -602,5 +604,117 @@ TEST(TransportFeedbackTest, ReportsMissingPacketsWithoutTimestamps) {
   EXPECT_FALSE(packets[2].received());
   EXPECT_TRUE(packets[3].received());
 }
+// Adds the packets one by one, returning what AddReceivedPackets() should.
+size_t AddOneByOne(TransportFeedback* feedback,
+                   uint16_t first_sequence_number,
+                   const std::vector<int64_t>& timestamps_us) {
+  size_t covered = 0;
+  for (size_t i = 0; i < timestamps_us.size(); ++i) {
+    if (timestamps_us[i] == TransportFeedback::kNotReceived)
+      continue;
+    if (!feedback->AddReceivedPacket(first_sequence_number + i,
+                                     timestamps_us[i])) {
+      break;
+    }
+    covered = i + 1;
+  }
+  return covered;
+}
+
+void ExpectSameAsOneByOne(bool include_timestamps,
+                          bool include_lost,
+                          uint16_t base_sequence_number,
+                          int64_t base_time_us,
+                          const std::vector<int64_t>& timestamps_us) {
+  TransportFeedback expected(include_timestamps, include_lost);
+  expected.SetBase(base_sequence_number, base_time_us);
+  TransportFeedback feedback(include_timestamps, include_lost);
+  feedback.SetBase(base_sequence_number, base_time_us);
+
+  EXPECT_EQ(feedback.AddReceivedPackets(base_sequence_number, timestamps_us),
+            AddOneByOne(&expected, base_sequence_number, timestamps_us));
+  EXPECT_EQ(feedback.GetPacketStatusCount(), expected.GetPacketStatusCount());
+  EXPECT_EQ(feedback.GetAllPackets().size(), expected.GetAllPackets().size());
+  if (expected.GetReceivedPackets().empty()) {
+    EXPECT_TRUE(feedback.GetReceivedPackets().empty());
+    return;
+  }
+  EXPECT_TRUE(feedback.IsConsistent());
+  EXPECT_EQ(feedback.Build(), expected.Build());
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsMatchesAddReceivedPacket) {
+  Random random(0x1234);
+  for (int round = 0; round < 200; ++round) {
+    const uint16_t base_sequence_number = random.Rand<uint16_t>();
+    const int64_t base_time_us = 1000000 + random.Rand(0, 1000000);
+    std::vector<int64_t> timestamps_us(random.Rand(1, 500));
+    const int loss_percent = random.Rand(0, 50);
+    int64_t time_us = base_time_us;
+    for (int64_t& timestamp_us : timestamps_us) {
+      // Mostly small deltas with a few large and reordered ones.
+      time_us += random.Rand(0, 100) < 90 ? random.Rand(0, 10000)
+                                          : random.Rand(-50000, 500000);
+      timestamp_us = random.Rand(0, 99) < loss_percent
+                         ? TransportFeedback::kNotReceived
+                         : time_us;
+    }
+    const bool include_timestamps = random.Rand<bool>();
+    const bool include_lost = random.Rand<bool>();
+    ExpectSameAsOneByOne(include_timestamps, include_lost, base_sequence_number,
+                         base_time_us, timestamps_us);
+  }
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsCoversLeadingLosses) {
+  const std::vector<int64_t> kTimestampsUs = {
+      TransportFeedback::kNotReceived, TransportFeedback::kNotReceived, 1000,
+      TransportFeedback::kNotReceived, 2000, TransportFeedback::kNotReceived};
+  TransportFeedback feedback(/*include_timestamps*/ true,
+                             /*include_lost*/ true);
+  feedback.SetBase(10, 0);
+  // Trailing losses aren't reported.
+  EXPECT_EQ(feedback.AddReceivedPackets(10, kTimestampsUs), 5u);
+  EXPECT_EQ(feedback.GetPacketStatusCount(), 5u);
+  EXPECT_EQ(feedback.GetReceivedPackets().size(), 2u);
+  ExpectSameAsOneByOne(true, true, 10, 0, kTimestampsUs);
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsStopsAtTooLargeDelta) {
+  const std::vector<int64_t> kTimestampsUs = {
+      1000, 2000, TransportFeedback::kNotReceived,
+      2000 + (1 << 15) * TransportFeedback::kDeltaScaleFactor, 3000};
+  TransportFeedback feedback;
+  feedback.SetBase(0, 0);
+  EXPECT_EQ(feedback.AddReceivedPackets(0, kTimestampsUs), 2u);
+  EXPECT_EQ(feedback.GetReceivedPackets().size(), 2u);
+  ExpectSameAsOneByOne(true, false, 0, 0, kTimestampsUs);
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsReturnsZeroWithoutPackets) {
+  TransportFeedback feedback;
+  feedback.SetBase(0, 0);
+  EXPECT_EQ(feedback.AddReceivedPackets(0, {}), 0u);
+  const std::vector<int64_t> kLost(10, TransportFeedback::kNotReceived);
+  EXPECT_EQ(feedback.AddReceivedPackets(0, kLost), 0u);
+  EXPECT_EQ(feedback.GetPacketStatusCount(), 0u);
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsFillsPacket) {
+  // More packets than a feedback can report, so it fills up before all of them
+  // are added.
+  std::vector<int64_t> timestamps_us(TransportFeedback::kMaxReportedPackets +
+                                     100);
+  for (size_t i = 0; i < timestamps_us.size(); ++i) {
+    timestamps_us[i] = i % 2 ? TransportFeedback::kNotReceived
+                             : static_cast<int64_t>(i) * 100000;
+  }
+  TransportFeedback expected;
+  expected.SetBase(0, 0);
+  const size_t covered = AddOneByOne(&expected, 0, timestamps_us);
+  EXPECT_GT(covered, 0u);
+  EXPECT_LT(covered, timestamps_us.size());
+  ExpectSameAsOneByOne(true, false, 0, 0, timestamps_us);
+}
 }  // namespace
 }  // namespace webrtc
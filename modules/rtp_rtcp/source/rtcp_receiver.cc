@@ -80,9 +80,29 @@ std::set<uint32_t> GetRegisteredSsrcs(const RtpRtcp::Configuration& config) {
   }
   return ssrcs;
 }
+
+// Parses |rtcp_block| into |*spare|, and on success swaps it with |*parsed|,
+// so that the packets of a receiver are allocated once rather than per block.
+// |*parsed| is left as it was when the block is malformed.
+template <typename Packet>
+bool ParseIntoSpare(const CommonHeader& rtcp_block,
+                    std::unique_ptr<Packet>* spare,
+                    std::unique_ptr<Packet>* parsed) {
+  if (!*spare)
+    *spare = std::make_unique<Packet>();
+  if (!(*spare)->Parse(rtcp_block))
+    return false;
+  std::swap(*spare, *parsed);
+  return true;
+}
 }  // namespace
 
+// Kept by the receiver between compound packets, so that the vectors and the
+// parsed packets below keep their storage. Members are only valid when the
+// matching bit of |packet_type_flags| is set.
 struct RTCPReceiver::PacketInformation {
+  void Reset();
+
   uint32_t packet_type_flags = 0;  // RTCPPacketTypeFlags bit field.
 
   uint32_t remote_ssrc = 0;
@@ -97,8 +117,25 @@ struct RTCPReceiver::PacketInformation {
   absl::optional<NetworkStateEstimate> network_state_estimate;
   std::unique_ptr<rtcp::LossNotification> loss_notification;
   std::unique_ptr<rtcp::App> application;
+
+  // Parsed into before they replace the members above.
+  std::unique_ptr<rtcp::TransportFeedback> spare_transport_feedback;
+  std::unique_ptr<rtcp::LossNotification> spare_loss_notification;
+  std::unique_ptr<rtcp::App> spare_application;
 };
 
+void RTCPReceiver::PacketInformation::Reset() {
+  packet_type_flags = 0;
+  remote_ssrc = 0;
+  nack_sequence_numbers.clear();
+  report_blocks.clear();
+  report_block_datas.clear();
+  rtt_ms = 0;
+  receiver_estimated_max_bitrate_bps = 0;
+  target_bitrate_allocation.reset();
+  network_state_estimate.reset();
+}
+
 // Structure for handing TMMBR and TMMBN rtcp messages (RFC5104, section 3.5.4).
 struct RTCPReceiver::TmmbrInformation {
   struct TimedTmmbrItem {
@@ -167,7 +204,9 @@ RTCPReceiver::RTCPReceiver(const RtpRtcp::Configuration& config,
       report_block_data_observer_(config.report_block_data_observer),
       packet_type_counter_observer_(config.rtcp_packet_type_counter_observer),
       num_skipped_packets_(0),
-      last_skipped_packets_warning_ms_(clock_->TimeInMilliseconds()) {
+      last_skipped_packets_warning_ms_(clock_->TimeInMilliseconds()),
+      packet_information_(std::make_unique<PacketInformation>()),
+      packet_information_in_use_(false) {
   RTC_DCHECK(owner);
 }
 
@@ -179,10 +218,18 @@ void RTCPReceiver::IncomingPacket(rtc::ArrayView<const uint8_t> packet) {
     return;
   }
 
-  PacketInformation packet_information;
-  if (!ParseCompoundPacket(packet, &packet_information))
+  // Packets received at the same time, or from within the callbacks, are
+  // parsed into storage of their own.
+  if (packet_information_in_use_.exchange(true)) {
+    PacketInformation packet_information;
+    if (ParseCompoundPacket(packet, &packet_information))
+      TriggerCallbacksFromRtcpPacket(packet_information);
     return;
-  TriggerCallbacksFromRtcpPacket(packet_information);
+  }
+  packet_information_->Reset();
+  if (ParseCompoundPacket(packet, packet_information_.get()))
+    TriggerCallbacksFromRtcpPacket(*packet_information_);
+  packet_information_in_use_ = false;
 }
 
 int64_t RTCPReceiver::LastReceivedReportBlockMs() const {
@@ -697,14 +744,13 @@ void RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
 
 void RTCPReceiver::HandleApp(const rtcp::CommonHeader& rtcp_block,
                              PacketInformation* packet_information) {
-  std::unique_ptr<rtcp::App> app_packet(new rtcp::App());
-  if (!app_packet->Parse(rtcp_block)) {
+  if (!ParseIntoSpare(rtcp_block, &packet_information->spare_application,
+                      &packet_information->application)) {
     ++num_skipped_packets_;
     return;
   }
 
   packet_information->packet_type_flags |= kRtcpApp;
-  packet_information->application = std::move(app_packet);
 }
 
 void RTCPReceiver::HandleBye(const CommonHeader& rtcp_block) {
@@ -905,13 +951,11 @@ void RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
     }
   }
 
-  {
-    auto loss_notification = std::make_unique<rtcp::LossNotification>();
-    if (loss_notification->Parse(rtcp_block)) {
-      packet_information->packet_type_flags |= kRtcpLossNotification;
-      packet_information->loss_notification = std::move(loss_notification);
-      return;
-    }
+  if (ParseIntoSpare(rtcp_block,
+                     &packet_information->spare_loss_notification,
+                     &packet_information->loss_notification)) {
+    packet_information->packet_type_flags |= kRtcpLossNotification;
+    return;
   }
 
   RTC_LOG(LS_WARNING) << "Unknown PSFB-APP packet.";
@@ -962,15 +1006,14 @@ void RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
 void RTCPReceiver::HandleTransportFeedback(
     const CommonHeader& rtcp_block,
     PacketInformation* packet_information) {
-  std::unique_ptr<rtcp::TransportFeedback> transport_feedback(
-      new rtcp::TransportFeedback());
-  if (!transport_feedback->Parse(rtcp_block)) {
+  if (!ParseIntoSpare(rtcp_block,
+                      &packet_information->spare_transport_feedback,
+                      &packet_information->transport_feedback)) {
     ++num_skipped_packets_;
     return;
   }
 
   packet_information->packet_type_flags |= kRtcpTransportFeedback;
-  packet_information->transport_feedback = std::move(transport_feedback);
 }
 
 void RTCPReceiver::NotifyTmmbrUpdated() {
@@ -11,8 +11,10 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
 #define MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
 
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -275,6 +277,10 @@ class RTCPReceiver final {
 
   size_t num_skipped_packets_;
   int64_t last_skipped_packets_warning_ms_;
+
+  // Reused by IncomingPacket() for one compound packet at a time.
+  const std::unique_ptr<PacketInformation> packet_information_;
+  std::atomic<bool> packet_information_in_use_;
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
@@ -1577,6 +1577,42 @@ TEST(RtcpReceiverTest, ReceivesTransportFeedback) {
   receiver.IncomingPacket(packet.Build());
 }
 
+TEST(RtcpReceiverTest, ReceivesTransportFeedbackOfConsecutivePackets) {
+  ReceiverMocks mocks;
+  RTCPReceiver receiver(DefaultConfiguration(&mocks), &mocks.rtp_rtcp_impl);
+  receiver.SetRemoteSSRC(kSenderSsrc);
+
+  rtcp::TransportFeedback packet1;
+  packet1.SetMediaSsrc(kReceiverMainSsrc);
+  packet1.SetSenderSsrc(kSenderSsrc);
+  packet1.SetBase(1, 1000);
+  packet1.AddReceivedPacket(1, 1000);
+
+  rtcp::TransportFeedback packet2;
+  packet2.SetMediaSsrc(kReceiverMainSsrc);
+  packet2.SetSenderSsrc(kSenderSsrc);
+  packet2.SetBase(10, 2000);
+  packet2.AddReceivedPacket(10, 2000);
+  packet2.AddReceivedPacket(11, 2250);
+
+  rtcp::Remb remb;
+  remb.SetSenderSsrc(kSenderSsrc);
+  remb.SetBitrateBps(50000);
+
+  InSequence sequence;
+  EXPECT_CALL(mocks.transport_feedback_observer,
+              OnTransportFeedback(
+                  Property(&rtcp::TransportFeedback::GetBaseSequence, 1)));
+  EXPECT_CALL(mocks.transport_feedback_observer,
+              OnTransportFeedback(
+                  Property(&rtcp::TransportFeedback::GetBaseSequence, 10)));
+  // The feedback of the previous packet isn't reported again.
+  EXPECT_CALL(mocks.bandwidth_observer, OnReceivedEstimatedBitrate(50000));
+  receiver.IncomingPacket(packet1.Build());
+  receiver.IncomingPacket(packet2.Build());
+  receiver.IncomingPacket(remb.Build());
+}
+
 TEST(RtcpReceiverTest, ReceivesRemb) {
   ReceiverMocks mocks;
   RTCPReceiver receiver(DefaultConfiguration(&mocks), &mocks.rtp_rtcp_impl);
@@ -18,9 +18,9 @@
 
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "logging/rtc_event_log/events/rtc_event_rtcp_packet_outgoing.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/app.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
-#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/loss_notification.h"
@@ -51,67 +51,42 @@ const uint32_t kRtcpAnyExtendedReports = kRtcpXrReceiverReferenceTime |
 constexpr int32_t kDefaultVideoReportInterval = 1000;
 constexpr int32_t kDefaultAudioReportInterval = 5000;
 
-class PacketContainer : public rtcp::CompoundPacket {
+// Writes the APP packet set by SetApplicationSpecificData straight from its
+// data, which rtcp::App would copy.
+class AppBlock : public rtcp::RtcpPacket {
  public:
-  PacketContainer(Transport* transport, RtcEventLog* event_log)
-      : transport_(transport), event_log_(event_log) {}
-  ~PacketContainer() override {
-    for (RtcpPacket* packet : appended_packets_)
-      delete packet;
-  }
+  AppBlock(uint8_t sub_type,
+           uint32_t name,
+           rtc::ArrayView<const uint8_t> data)
+      : sub_type_(sub_type), name_(name), data_(data) {}
 
-  size_t SendPackets(size_t max_payload_length) {
-    size_t bytes_sent = 0;
-    Build(max_payload_length, [&](rtc::ArrayView<const uint8_t> packet) {
-      if (transport_->SendRtcp(packet.data(), packet.size())) {
-        bytes_sent += packet.size();
-        if (event_log_) {
-          event_log_->Log(std::make_unique<RtcEventRtcpPacketOutgoing>(packet));
-        }
-      }
-    });
-    return bytes_sent;
+  size_t BlockLength() const override {
+    return kHeaderLength + kAppBaseLength + data_.size();
   }
 
- private:
-  Transport* transport_;
-  RtcEventLog* const event_log_;
-
-  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(PacketContainer);
-};
-
-// Helper to put several RTCP packets into lower layer datagram RTCP packet.
-// Prefer to use this class instead of PacketContainer.
-class PacketSender {
- public:
-  PacketSender(rtcp::RtcpPacket::PacketReadyCallback callback,
-               size_t max_packet_size)
-      : callback_(callback), max_packet_size_(max_packet_size) {
-    RTC_CHECK_LE(max_packet_size, IP_PACKET_SIZE);
-  }
-  ~PacketSender() { RTC_DCHECK_EQ(index_, 0) << "Unsent rtcp packet."; }
-
-  // Appends a packet to pending compound packet.
-  // Sends rtcp packet if buffer is full and resets the buffer.
-  void AppendPacket(const rtcp::RtcpPacket& packet) {
-    packet.Create(buffer_, &index_, max_packet_size_, callback_);
-  }
-
-  // Sends pending rtcp packet.
-  void Send() {
-    if (index_ > 0) {
-      callback_(rtc::ArrayView<const uint8_t>(buffer_, index_));
-      index_ = 0;
+  bool Create(uint8_t* packet,
+              size_t* index,
+              size_t max_length,
+              PacketReadyCallback callback) const override {
+    while (*index + BlockLength() > max_length) {
+      if (!OnBufferFull(packet, index, callback))
+        return false;
     }
+    CreateHeader(sub_type_, rtcp::App::kPacketType, HeaderLength(), packet,
+                 index);
+    ByteWriter<uint32_t>::WriteBigEndian(&packet[*index + 0], sender_ssrc());
+    ByteWriter<uint32_t>::WriteBigEndian(&packet[*index + 4], name_);
+    memcpy(&packet[*index + kAppBaseLength], data_.data(), data_.size());
+    *index += kAppBaseLength + data_.size();
+    return true;
   }
 
-  bool IsEmpty() const { return index_ == 0; }
-
  private:
-  const rtcp::RtcpPacket::PacketReadyCallback callback_;
-  const size_t max_packet_size_;
-  size_t index_ = 0;
-  uint8_t buffer_[IP_PACKET_SIZE];
+  static constexpr size_t kAppBaseLength = 8;  // Ssrc and Name.
+
+  const uint8_t sub_type_;
+  const uint32_t name_;
+  const rtc::ArrayView<const uint8_t> data_;
 };
 
 }  // namespace
@@ -148,6 +123,40 @@ class RTCPSender::RtcpContext {
   const int64_t now_us_;
 };
 
+// Helper to put several RTCP packets into lower layer datagram RTCP packet.
+// The packets are written to a buffer on the stack, without allocating them.
+class RTCPSender::PacketSender {
+ public:
+  PacketSender(rtcp::RtcpPacket::PacketReadyCallback callback,
+               size_t max_packet_size)
+      : callback_(callback), max_packet_size_(max_packet_size) {
+    RTC_CHECK_LE(max_packet_size, IP_PACKET_SIZE);
+  }
+  ~PacketSender() { RTC_DCHECK_EQ(index_, 0) << "Unsent rtcp packet."; }
+
+  // Appends a packet to pending compound packet.
+  // Sends rtcp packet if buffer is full and resets the buffer.
+  void AppendPacket(const rtcp::RtcpPacket& packet) {
+    packet.Create(buffer_, &index_, max_packet_size_, callback_);
+  }
+
+  // Sends pending rtcp packet.
+  void Send() {
+    if (index_ > 0) {
+      callback_(rtc::ArrayView<const uint8_t>(buffer_, index_));
+      index_ = 0;
+    }
+  }
+
+  bool IsEmpty() const { return index_ == 0; }
+
+ private:
+  const rtcp::RtcpPacket::PacketReadyCallback callback_;
+  const size_t max_packet_size_;
+  size_t index_ = 0;
+  uint8_t buffer_[IP_PACKET_SIZE];
+};
+
 RTCPSender::RTCPSender(const RtpRtcp::Configuration& config)
     : audio_(config.audio),
       ssrc_(config.local_media_ssrc),
@@ -178,28 +187,14 @@ RTCPSender::RTCPSender(const RtpRtcp::Configuration& config)
 
       app_sub_type_(0),
       app_name_(0),
-      app_data_(nullptr),
-      app_length_(0),
 
       xr_send_receiver_reference_time_enabled_(false),
       packet_type_counter_observer_(config.rtcp_packet_type_counter_observer),
       send_video_bitrate_allocation_(false),
-      last_payload_type_(-1) {
+      last_payload_type_(-1),
+      report_flags_(0),
+      volatile_report_flags_(0) {
   RTC_DCHECK(transport_ != nullptr);
-
-  builders_[kRtcpSr] = &RTCPSender::BuildSR;
-  builders_[kRtcpRr] = &RTCPSender::BuildRR;
-  builders_[kRtcpSdes] = &RTCPSender::BuildSDES;
-  builders_[kRtcpPli] = &RTCPSender::BuildPLI;
-  builders_[kRtcpFir] = &RTCPSender::BuildFIR;
-  builders_[kRtcpRemb] = &RTCPSender::BuildREMB;
-  builders_[kRtcpBye] = &RTCPSender::BuildBYE;
-  builders_[kRtcpApp] = &RTCPSender::BuildAPP;
-  builders_[kRtcpLossNotification] = &RTCPSender::BuildLossNotification;
-  builders_[kRtcpTmmbr] = &RTCPSender::BuildTMMBR;
-  builders_[kRtcpTmmbn] = &RTCPSender::BuildTMMBN;
-  builders_[kRtcpNack] = &RTCPSender::BuildNACK;
-  builders_[kRtcpAnyExtendedReports] = &RTCPSender::BuildExtendedReports;
 }
 
 RTCPSender::~RTCPSender() {}
@@ -262,8 +257,9 @@ int32_t RTCPSender::SendLossNotification(const FeedbackState& feedback_state,
     return 0;
   }
 
-  return SendCompoundRTCP(feedback_state,
-                          {RTCPPacketType::kRtcpLossNotification});
+  return SendCompoundRTCPFlags(feedback_state,
+                               RTCPPacketType::kRtcpLossNotification, 0,
+                               nullptr);
 }
 
 void RTCPSender::SetRemb(int64_t bitrate_bps, std::vector<uint32_t> ssrcs) {
@@ -453,7 +449,14 @@ bool RTCPSender::TimeToSendRTCPReport(bool sendKeyframeBeforeRTP) const {
   return false;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSR(const RtcpContext& ctx) {
+absl::optional<int64_t> RTCPSender::NextTimeToSendRTCPReportMs() const {
+  rtc::CritScope lock(&critical_section_rtcp_sender_);
+  if (method_ == RtcpMode::kOff)
+    return absl::nullopt;
+  return next_time_to_send_rtcp_;
+}
+
+void RTCPSender::BuildSR(const RtcpContext& ctx, PacketSender& sender) {
   // Timestamp shouldn't be estimated before first media frame.
   RTC_DCHECK_GE(last_frame_capture_time_ms_, 0);
   // The timestamp of this RTCP packet should be estimated as the timestamp of
@@ -472,69 +475,62 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSR(const RtcpContext& ctx) {
       timestamp_offset_ + last_rtp_timestamp_ +
       ((ctx.now_us_ + 500) / 1000 - last_frame_capture_time_ms_) * rtp_rate;
 
-  rtcp::SenderReport* report = new rtcp::SenderReport();
-  report->SetSenderSsrc(ssrc_);
-  report->SetNtp(TimeMicrosToNtp(ctx.now_us_));
-  report->SetRtpTimestamp(rtp_timestamp);
-  report->SetPacketCount(ctx.feedback_state_.packets_sent);
-  report->SetOctetCount(ctx.feedback_state_.media_bytes_sent);
-  report->SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
-
-  return std::unique_ptr<rtcp::RtcpPacket>(report);
+  rtcp::SenderReport report;
+  report.SetSenderSsrc(ssrc_);
+  report.SetNtp(TimeMicrosToNtp(ctx.now_us_));
+  report.SetRtpTimestamp(rtp_timestamp);
+  report.SetPacketCount(ctx.feedback_state_.packets_sent);
+  report.SetOctetCount(ctx.feedback_state_.media_bytes_sent);
+  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
+  sender.AppendPacket(report);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSDES(
-    const RtcpContext& ctx) {
+void RTCPSender::BuildSDES(const RtcpContext& ctx, PacketSender& sender) {
   size_t length_cname = cname_.length();
   RTC_CHECK_LT(length_cname, RTCP_CNAME_SIZE);
 
-  rtcp::Sdes* sdes = new rtcp::Sdes();
-  sdes->AddCName(ssrc_, cname_);
+  rtcp::Sdes sdes;
+  sdes.AddCName(ssrc_, cname_);
 
   for (const auto& it : csrc_cnames_)
-    RTC_CHECK(sdes->AddCName(it.first, it.second));
+    RTC_CHECK(sdes.AddCName(it.first, it.second));
 
-  return std::unique_ptr<rtcp::RtcpPacket>(sdes);
+  sender.AppendPacket(sdes);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildRR(const RtcpContext& ctx) {
-  rtcp::ReceiverReport* report = new rtcp::ReceiverReport();
-  report->SetSenderSsrc(ssrc_);
-  report->SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
-
-  return std::unique_ptr<rtcp::RtcpPacket>(report);
+void RTCPSender::BuildRR(const RtcpContext& ctx, PacketSender& sender) {
+  rtcp::ReceiverReport report;
+  report.SetSenderSsrc(ssrc_);
+  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
+  sender.AppendPacket(report);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildPLI(const RtcpContext& ctx) {
-  rtcp::Pli* pli = new rtcp::Pli();
-  pli->SetSenderSsrc(ssrc_);
-  pli->SetMediaSsrc(remote_ssrc_);
+void RTCPSender::BuildPLI(const RtcpContext& ctx, PacketSender& sender) {
+  rtcp::Pli pli;
+  pli.SetSenderSsrc(ssrc_);
+  pli.SetMediaSsrc(remote_ssrc_);
 
   ++packet_type_counter_.pli_packets;
-
-  return std::unique_ptr<rtcp::RtcpPacket>(pli);
+  sender.AppendPacket(pli);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildFIR(const RtcpContext& ctx) {
+void RTCPSender::BuildFIR(const RtcpContext& ctx, PacketSender& sender) {
   ++sequence_number_fir_;
 
-  rtcp::Fir* fir = new rtcp::Fir();
-  fir->SetSenderSsrc(ssrc_);
-  fir->AddRequestTo(remote_ssrc_, sequence_number_fir_);
+  rtcp::Fir fir;
+  fir.SetSenderSsrc(ssrc_);
+  fir.AddRequestTo(remote_ssrc_, sequence_number_fir_);
 
   ++packet_type_counter_.fir_packets;
-
-  return std::unique_ptr<rtcp::RtcpPacket>(fir);
+  sender.AppendPacket(fir);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildREMB(
-    const RtcpContext& ctx) {
-  rtcp::Remb* remb = new rtcp::Remb();
-  remb->SetSenderSsrc(ssrc_);
-  remb->SetBitrateBps(remb_bitrate_);
-  remb->SetSsrcs(remb_ssrcs_);
-
-  return std::unique_ptr<rtcp::RtcpPacket>(remb);
+void RTCPSender::BuildREMB(const RtcpContext& ctx, PacketSender& sender) {
+  rtcp::Remb remb;
+  remb.SetSenderSsrc(ssrc_);
+  remb.SetBitrateBps(remb_bitrate_);
+  remb.SetSsrcs(remb_ssrcs_);
+  sender.AppendPacket(remb);
 }
 
 void RTCPSender::SetTargetBitrate(unsigned int target_bitrate) {
@@ -542,10 +538,9 @@ void RTCPSender::SetTargetBitrate(unsigned int target_bitrate) {
   tmmbr_send_bps_ = target_bitrate;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
-    const RtcpContext& ctx) {
+void RTCPSender::BuildTMMBR(const RtcpContext& ctx, PacketSender& sender) {
   if (ctx.feedback_state_.module == nullptr)
-    return nullptr;
+    return;
   // Before sending the TMMBR check the received TMMBN, only an owner is
   // allowed to raise the bitrate:
   // * If the sender is an owner of the TMMBN -> send TMMBR
@@ -565,7 +560,7 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
       if (candidate.bitrate_bps() == tmmbr_send_bps_ &&
           candidate.packet_overhead() == packet_oh_send_) {
         // Do not send the same tuple.
-        return nullptr;
+        return;
       }
     }
     if (!tmmbr_owner) {
@@ -579,65 +574,57 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
       tmmbr_owner = TMMBRHelp::IsOwner(bounding, ssrc_);
       if (!tmmbr_owner) {
         // Did not enter bounding set, no meaning to send this request.
-        return nullptr;
+        return;
       }
     }
   }
 
   if (!tmmbr_send_bps_)
-    return nullptr;
+    return;
 
-  rtcp::Tmmbr* tmmbr = new rtcp::Tmmbr();
-  tmmbr->SetSenderSsrc(ssrc_);
+  rtcp::Tmmbr tmmbr;
+  tmmbr.SetSenderSsrc(ssrc_);
   rtcp::TmmbItem request;
   request.set_ssrc(remote_ssrc_);
   request.set_bitrate_bps(tmmbr_send_bps_);
   request.set_packet_overhead(packet_oh_send_);
-  tmmbr->AddTmmbr(request);
-
-  return std::unique_ptr<rtcp::RtcpPacket>(tmmbr);
+  tmmbr.AddTmmbr(request);
+  sender.AppendPacket(tmmbr);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBN(
-    const RtcpContext& ctx) {
-  rtcp::Tmmbn* tmmbn = new rtcp::Tmmbn();
-  tmmbn->SetSenderSsrc(ssrc_);
+void RTCPSender::BuildTMMBN(const RtcpContext& ctx, PacketSender& sender) {
+  rtcp::Tmmbn tmmbn;
+  tmmbn.SetSenderSsrc(ssrc_);
   for (const rtcp::TmmbItem& tmmbr : tmmbn_to_send_) {
     if (tmmbr.bitrate_bps() > 0) {
-      tmmbn->AddTmmbr(tmmbr);
+      tmmbn.AddTmmbr(tmmbr);
     }
   }
-
-  return std::unique_ptr<rtcp::RtcpPacket>(tmmbn);
+  sender.AppendPacket(tmmbn);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildAPP(const RtcpContext& ctx) {
-  rtcp::App* app = new rtcp::App();
-  app->SetSenderSsrc(ssrc_);
-  app->SetSubType(app_sub_type_);
-  app->SetName(app_name_);
-  app->SetData(app_data_.get(), app_length_);
-
-  return std::unique_ptr<rtcp::RtcpPacket>(app);
+void RTCPSender::BuildAPP(const RtcpContext& ctx, PacketSender& sender) {
+  AppBlock app(app_sub_type_, app_name_, app_data_);
+  app.SetSenderSsrc(ssrc_);
+  sender.AppendPacket(app);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildLossNotification(
-    const RtcpContext& ctx) {
-  auto loss_notification = std::make_unique<rtcp::LossNotification>(
+void RTCPSender::BuildLossNotification(const RtcpContext& ctx,
+                                       PacketSender& sender) {
+  rtcp::LossNotification loss_notification(
       loss_notification_state_.last_decoded_seq_num,
       loss_notification_state_.last_received_seq_num,
       loss_notification_state_.decodability_flag);
-  loss_notification->SetSenderSsrc(ssrc_);
-  loss_notification->SetMediaSsrc(remote_ssrc_);
-  return std::move(loss_notification);
+  loss_notification.SetSenderSsrc(ssrc_);
+  loss_notification.SetMediaSsrc(remote_ssrc_);
+  sender.AppendPacket(loss_notification);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildNACK(
-    const RtcpContext& ctx) {
-  rtcp::Nack* nack = new rtcp::Nack();
-  nack->SetSenderSsrc(ssrc_);
-  nack->SetMediaSsrc(remote_ssrc_);
-  nack->SetPacketIds(ctx.nack_list_, ctx.nack_size_);
+void RTCPSender::BuildNACK(const RtcpContext& ctx, PacketSender& sender) {
+  rtcp::Nack nack;
+  nack.SetSenderSsrc(ssrc_);
+  nack.SetMediaSsrc(remote_ssrc_);
+  nack.SetPacketIds(ctx.nack_list_, ctx.nack_size_);
 
   // Report stats.
   for (int idx = 0; idx < ctx.nack_size_; ++idx) {
@@ -647,31 +634,29 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildNACK(
   packet_type_counter_.unique_nack_requests = nack_stats_.unique_requests();
 
   ++packet_type_counter_.nack_packets;
-
-  return std::unique_ptr<rtcp::RtcpPacket>(nack);
+  sender.AppendPacket(nack);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildBYE(const RtcpContext& ctx) {
-  rtcp::Bye* bye = new rtcp::Bye();
-  bye->SetSenderSsrc(ssrc_);
-  bye->SetCsrcs(csrcs_);
-
-  return std::unique_ptr<rtcp::RtcpPacket>(bye);
+void RTCPSender::BuildBYE(const RtcpContext& ctx, PacketSender& sender) {
+  rtcp::Bye bye;
+  bye.SetSenderSsrc(ssrc_);
+  bye.SetCsrcs(csrcs_);
+  sender.AppendPacket(bye);
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildExtendedReports(
-    const RtcpContext& ctx) {
-  std::unique_ptr<rtcp::ExtendedReports> xr(new rtcp::ExtendedReports());
-  xr->SetSenderSsrc(ssrc_);
+void RTCPSender::BuildExtendedReports(const RtcpContext& ctx,
+                                      PacketSender& sender) {
+  rtcp::ExtendedReports xr;
+  xr.SetSenderSsrc(ssrc_);
 
   if (!sending_ && xr_send_receiver_reference_time_enabled_) {
     rtcp::Rrtr rrtr;
     rrtr.SetNtp(TimeMicrosToNtp(ctx.now_us_));
-    xr->SetRrtr(rrtr);
+    xr.SetRrtr(rrtr);
   }
 
   for (const rtcp::ReceiveTimeInfo& rti : ctx.feedback_state_.last_xr_rtis) {
-    xr->AddDlrrItem(rti);
+    xr.AddDlrrItem(rti);
   }
 
   if (send_video_bitrate_allocation_) {
@@ -686,20 +671,18 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildExtendedReports(
       }
     }
 
-    xr->SetTargetBitrate(target_bitrate);
+    xr.SetTargetBitrate(target_bitrate);
     send_video_bitrate_allocation_ = false;
   }
-
-  return std::move(xr);
+  sender.AppendPacket(xr);
 }
 
 int32_t RTCPSender::SendRTCP(const FeedbackState& feedback_state,
                              RTCPPacketType packetType,
                              int32_t nack_size,
                              const uint16_t* nack_list) {
-  return SendCompoundRTCP(
-      feedback_state, std::set<RTCPPacketType>(&packetType, &packetType + 1),
-      nack_size, nack_list);
+  return SendCompoundRTCPFlags(feedback_state, packetType, nack_size,
+                               nack_list);
 }
 
 int32_t RTCPSender::SendCompoundRTCP(
@@ -707,8 +690,46 @@ int32_t RTCPSender::SendCompoundRTCP(
     const std::set<RTCPPacketType>& packet_types,
     int32_t nack_size,
     const uint16_t* nack_list) {
-  PacketContainer container(transport_, event_log_);
-  size_t max_packet_size;
+  uint32_t flags = 0;
+  for (RTCPPacketType type : packet_types)
+    flags |= type;
+  return SendCompoundRTCPFlags(feedback_state, flags, nack_size, nack_list);
+}
+
+int32_t RTCPSender::SendCompoundRTCPFlags(const FeedbackState& feedback_state,
+                                          uint32_t packet_types,
+                                          int32_t nack_size,
+                                          const uint16_t* nack_list) {
+  // In the order the packets are appended, the BYE last.
+  static constexpr struct {
+    uint32_t type;
+    void (RTCPSender::*builder)(const RtcpContext&, PacketSender&);
+  } kBuilders[] = {
+      {kRtcpSr, &RTCPSender::BuildSR},
+      {kRtcpRr, &RTCPSender::BuildRR},
+      {kRtcpSdes, &RTCPSender::BuildSDES},
+      {kRtcpPli, &RTCPSender::BuildPLI},
+      {kRtcpNack, &RTCPSender::BuildNACK},
+      {kRtcpFir, &RTCPSender::BuildFIR},
+      {kRtcpTmmbr, &RTCPSender::BuildTMMBR},
+      {kRtcpTmmbn, &RTCPSender::BuildTMMBN},
+      {kRtcpApp, &RTCPSender::BuildAPP},
+      {kRtcpLossNotification, &RTCPSender::BuildLossNotification},
+      {kRtcpRemb, &RTCPSender::BuildREMB},
+      {kRtcpAnyExtendedReports, &RTCPSender::BuildExtendedReports},
+      {kRtcpBye, &RTCPSender::BuildBYE},
+  };
+
+  size_t bytes_sent = 0;
+  auto callback = [&](rtc::ArrayView<const uint8_t> packet) {
+    if (transport_->SendRtcp(packet.data(), packet.size())) {
+      bytes_sent += packet.size();
+      if (event_log_)
+        event_log_->Log(std::make_unique<RtcEventRtcpPacketOutgoing>(packet));
+    }
+  };
+  // Declared before the lock, so that the last packet is sent without it.
+  absl::optional<PacketSender> sender;
 
   {
     rtc::CritScope lock(&critical_section_rtcp_sender_);
@@ -745,35 +766,12 @@ int32_t RTCPSender::SendCompoundRTCP(
 
     PrepareReport(feedback_state);
 
-    std::unique_ptr<rtcp::RtcpPacket> packet_bye;
-
-    auto it = report_flags_.begin();
-    while (it != report_flags_.end()) {
-      auto builder_it = builders_.find(it->type);
-      RTC_DCHECK(builder_it != builders_.end())
-          << "Could not find builder for packet type " << it->type;
-      if (it->is_volatile) {
-        report_flags_.erase(it++);
-      } else {
-        ++it;
-      }
-
-      BuilderFunc func = builder_it->second;
-      std::unique_ptr<rtcp::RtcpPacket> packet = (this->*func)(context);
-      if (packet == nullptr)
-        return -1;
-      // If there is a BYE, don't append now - save it and append it
-      // at the end later.
-      if (builder_it->first == kRtcpBye) {
-        packet_bye = std::move(packet);
-      } else {
-        container.Append(packet.release());
-      }
-    }
-
-    // Append the BYE now at the end
-    if (packet_bye) {
-      container.Append(packet_bye.release());
+    sender.emplace(callback, max_packet_size_);
+    for (const auto& entry : kBuilders) {
+      if (!IsFlagPresent(entry.type))
+        continue;
+      ConsumeFlag(entry.type, /*forced=*/false);
+      (this->*entry.builder)(context, *sender);
     }
 
     if (packet_type_counter_observer_ != nullptr) {
@@ -782,10 +780,9 @@ int32_t RTCPSender::SendCompoundRTCP(
     }
 
     RTC_DCHECK(AllVolatileFlagsConsumed());
-    max_packet_size = max_packet_size_;
   }
 
-  size_t bytes_sent = container.SendPackets(max_packet_size);
+  sender->Send();
   return bytes_sent == 0 ? -1 : 0;
 }
 
@@ -890,9 +887,7 @@ int32_t RTCPSender::SetApplicationSpecificData(uint8_t subType,
   SetFlag(kRtcpApp, true);
   app_sub_type_ = subType;
   app_name_ = name;
-  app_data_.reset(new uint8_t[length]);
-  app_length_ = length;
-  memcpy(app_data_.get(), data, length);
+  app_data_.SetData(data, length);
   return 0;
 }
 
@@ -913,38 +908,44 @@ void RTCPSender::SetTmmbn(std::vector<rtcp::TmmbItem> bounding_set) {
 }
 
 void RTCPSender::SetFlag(uint32_t type, bool is_volatile) {
-  if (type & kRtcpAnyExtendedReports) {
-    report_flags_.insert(ReportFlag(kRtcpAnyExtendedReports, is_volatile));
-  } else {
-    report_flags_.insert(ReportFlag(type, is_volatile));
-  }
+  if (type & kRtcpAnyExtendedReports)
+    type = kRtcpAnyExtendedReports;
+  // A flag already set keeps its volatility.
+  if (IsFlagPresent(type))
+    return;
+  report_flags_ |= type;
+  if (is_volatile)
+    volatile_report_flags_ |= type;
 }
 
-void RTCPSender::SetFlags(const std::set<RTCPPacketType>& types,
-                          bool is_volatile) {
-  for (RTCPPacketType type : types)
+void RTCPSender::SetFlags(uint32_t types, bool is_volatile) {
+  while (types != 0) {
+    const uint32_t type = types & ~(types - 1);
     SetFlag(type, is_volatile);
+    types &= ~type;
+  }
 }
 
 bool RTCPSender::IsFlagPresent(uint32_t type) const {
-  return report_flags_.find(ReportFlag(type, false)) != report_flags_.end();
+  if (type & kRtcpAnyExtendedReports)
+    type = kRtcpAnyExtendedReports;
+  return (report_flags_ & type) != 0;
 }
 
 bool RTCPSender::ConsumeFlag(uint32_t type, bool forced) {
-  auto it = report_flags_.find(ReportFlag(type, false));
-  if (it == report_flags_.end())
+  if (type & kRtcpAnyExtendedReports)
+    type = kRtcpAnyExtendedReports;
+  if (!IsFlagPresent(type))
     return false;
-  if (it->is_volatile || forced)
-    report_flags_.erase((it));
+  if ((volatile_report_flags_ & type) || forced) {
+    report_flags_ &= ~type;
+    volatile_report_flags_ &= ~type;
+  }
   return true;
 }
 
 bool RTCPSender::AllVolatileFlagsConsumed() const {
-  for (const ReportFlag& flag : report_flags_) {
-    if (flag.is_volatile)
-      return false;
-  }
-  return true;
+  return volatile_report_flags_ == 0;
 }
 
 void RTCPSender::SetVideoBitrateAllocation(
@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/base/macros.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -58,9 +59,11 @@ class TestTransport : public Transport {
   }
   bool SendRtcp(const uint8_t* data, size_t len) override {
     parser_.Parse(data, len);
+    packet_sizes_.push_back(len);
     return true;
   }
   test::RtcpPacketParser parser_;
+  std::vector<size_t> packet_sizes_;
 };
 
 namespace {
@@ -825,6 +828,62 @@ TEST_F(RtcpSenderTest, DoesntSchedulesInitialReportWhenSsrcSetOnConstruction) {
   EXPECT_FALSE(rtcp_sender_->TimeToSendRTCPReport(false));
 }
 
+TEST_F(RtcpSenderTest, SkipsTmmbrWithoutBitrateInCompoundPacket) {
+  rtcp_sender_->SetRTCPStatus(RtcpMode::kCompound);
+  rtcp_sender_->SetTMMBRStatus(true);
+  EXPECT_EQ(0, rtcp_sender_->SendRTCP(feedback_state(), kRtcpPli));
+  EXPECT_EQ(1, parser()->receiver_report()->num_packets());
+  EXPECT_EQ(1, parser()->pli()->num_packets());
+  EXPECT_EQ(0, parser()->tmmbr()->num_packets());
+}
+
+TEST_F(RtcpSenderTest, SendsTheLatestApplicationSpecificData) {
+  const uint8_t kSubType = 30;
+  const uint32_t kName = 0x6E616D65;
+  const uint8_t kLongData[] = {'l', 'o', 'n', 'g', 'd', 'a', 't', 'a'};
+  const uint8_t kShortData[] = {'d', 'a', 't', 'a'};
+  rtcp_sender_->SetRTCPStatus(RtcpMode::kReducedSize);
+  EXPECT_EQ(0, rtcp_sender_->SetApplicationSpecificData(
+                   kSubType, kName, kLongData, sizeof(kLongData)));
+  EXPECT_EQ(0, rtcp_sender_->SetApplicationSpecificData(
+                   kSubType, kName, kShortData, sizeof(kShortData)));
+  EXPECT_EQ(0, rtcp_sender_->SendRTCP(feedback_state(), kRtcpApp));
+  EXPECT_EQ(1, parser()->app()->num_packets());
+  ASSERT_EQ(sizeof(kShortData), parser()->app()->data_size());
+  EXPECT_EQ(0, memcmp(kShortData, parser()->app()->data(), sizeof(kShortData)));
+}
+
+TEST_F(RtcpSenderTest, SplitsCompoundPacketLargerThanMaxPacketSize) {
+  const size_t kMaxPacketSize = 100;
+  const uint8_t kData[64] = {};
+  rtcp_sender_->SetRTCPStatus(RtcpMode::kCompound);
+  rtcp_sender_->SetMaxRtpPacketSize(kMaxPacketSize);
+  rtcp_sender_->SetCNAME("alice@host");
+  rtcp_sender_->SetRemb(261011, {kRemoteSsrc});
+  EXPECT_EQ(0, rtcp_sender_->SetApplicationSpecificData(0, 0, kData,
+                                                        sizeof(kData)));
+  std::set<RTCPPacketType> packet_types = {kRtcpPli, kRtcpFir, kRtcpApp,
+                                           kRtcpRemb};
+  EXPECT_EQ(0, rtcp_sender_->SendCompoundRTCP(feedback_state(), packet_types));
+
+  EXPECT_GT(test_transport_.packet_sizes_.size(), 1u);
+  for (size_t size : test_transport_.packet_sizes_)
+    EXPECT_LE(size, kMaxPacketSize);
+  EXPECT_EQ(1, parser()->receiver_report()->num_packets());
+  EXPECT_EQ(1, parser()->sdes()->num_packets());
+  EXPECT_EQ(1, parser()->pli()->num_packets());
+  EXPECT_EQ(1, parser()->fir()->num_packets());
+  EXPECT_EQ(1, parser()->app()->num_packets());
+  EXPECT_EQ(1, parser()->remb()->num_packets());
+
+  // The requested packets are sent once.
+  EXPECT_EQ(0, rtcp_sender_->SendRTCP(feedback_state(), kRtcpReport));
+  EXPECT_EQ(2, parser()->receiver_report()->num_packets());
+  EXPECT_EQ(1, parser()->pli()->num_packets());
+  EXPECT_EQ(1, parser()->fir()->num_packets());
+  EXPECT_EQ(1, parser()->app()->num_packets());
+}
+
 TEST_F(RtcpSenderTest, SendsCombinedRtcpPacket) {
   rtcp_sender_->SetRTCPStatus(RtcpMode::kReducedSize);
 
@@ -11,6 +11,7 @@
 #include "modules/rtp_rtcp/source/rtp_format.h"
 
 #include <memory>
+#include <utility>
 
 #include "absl/types/variant.h"
 #include "modules/rtp_rtcp/source/rtp_format_h264.h"
@@ -31,7 +32,8 @@ std::unique_ptr<RtpPacketizer> RtpPacketizer::Create(
     PayloadSizeLimits limits,
     // Codec-specific details.
     const RTPVideoHeader& rtp_video_header,
-    const RTPFragmentationHeader* fragmentation) {
+    const RTPFragmentationHeader* fragmentation,
+    rtc::scoped_refptr<rtc::RefCountInterface> payload_owner) {
   if (!type) {
     // Use raw packetizer.
     return std::make_unique<RtpPacketizerGeneric>(payload, limits);
@@ -43,7 +45,8 @@ std::unique_ptr<RtpPacketizer> RtpPacketizer::Create(
       const auto& h264 =
           absl::get<RTPVideoHeaderH264>(rtp_video_header.video_type_header);
       return std::make_unique<RtpPacketizerH264>(
-          payload, limits, h264.packetization_mode, *fragmentation);
+          payload, limits, h264.packetization_mode, *fragmentation,
+          std::move(payload_owner));
     }
     case kVideoCodecVP8: {
       const auto& vp8 =
@@ -18,8 +18,10 @@
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/scoped_refptr.h"
 #include "modules/include/module_common_types.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "rtc_base/ref_count.h"
 
 namespace webrtc {
 
@@ -35,14 +37,17 @@ class RtpPacketizer {
     int single_packet_reduction_len = 0;
   };
 
-  // If type is not set, returns a raw packetizer.
+  // If type is not set, returns a raw packetizer. If |payload_owner| is set,
+  // it keeps |payload| alive, and the H264 packetizer references |payload|
+  // from the packets instead of copying it.
   static std::unique_ptr<RtpPacketizer> Create(
       absl::optional<VideoCodecType> type,
       rtc::ArrayView<const uint8_t> payload,
       PayloadSizeLimits limits,
       // Codec-specific details.
       const RTPVideoHeader& rtp_video_header,
-      const RTPFragmentationHeader* fragmentation);
+      const RTPFragmentationHeader* fragmentation,
+      rtc::scoped_refptr<rtc::RefCountInterface> payload_owner);
 
   virtual ~RtpPacketizer() = default;
 
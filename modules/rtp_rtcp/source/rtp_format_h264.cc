@@ -50,8 +50,11 @@ RtpPacketizerH264::RtpPacketizerH264(
     rtc::ArrayView<const uint8_t> payload,
     PayloadSizeLimits limits,
     H264PacketizationMode packetization_mode,
-    const RTPFragmentationHeader& fragmentation)
-    : limits_(limits), num_packets_left_(0) {
+    const RTPFragmentationHeader& fragmentation,
+    rtc::scoped_refptr<rtc::RefCountInterface> payload_owner)
+    : limits_(limits),
+      payload_owner_(std::move(payload_owner)),
+      num_packets_left_(0) {
   // Guard against uninitialized memory in packetization_mode.
   RTC_CHECK(packetization_mode == H264PacketizationMode::NonInterleaved ||
             packetization_mode == H264PacketizationMode::SingleNalUnit);
@@ -245,9 +248,7 @@ bool RtpPacketizerH264::NextPacket(RtpPacketToSend* rtp_packet) {
   PacketUnit packet = packets_.front();
   if (packet.first_fragment && packet.last_fragment) {
     // Single NAL unit packet.
-    size_t bytes_to_send = packet.source_fragment.size();
-    uint8_t* buffer = rtp_packet->AllocatePayload(bytes_to_send);
-    memcpy(buffer, packet.source_fragment.data(), bytes_to_send);
+    AllocatePayload(rtp_packet, 0, packet.source_fragment);
     packets_.pop();
     input_fragments_.pop_front();
   } else if (packet.aggregated) {
@@ -306,15 +307,26 @@ void RtpPacketizerH264::NextFragmentPacket(RtpPacketToSend* rtp_packet) {
   fu_header |= (packet->last_fragment ? kEBit : 0);
   uint8_t type = packet->header & kTypeMask;
   fu_header |= type;
-  rtc::ArrayView<const uint8_t> fragment = packet->source_fragment;
   uint8_t* buffer =
-      rtp_packet->AllocatePayload(kFuAHeaderSize + fragment.size());
+      AllocatePayload(rtp_packet, kFuAHeaderSize, packet->source_fragment);
   buffer[0] = fu_indicator;
   buffer[1] = fu_header;
-  memcpy(buffer + kFuAHeaderSize, fragment.data(), fragment.size());
   if (packet->last_fragment)
     input_fragments_.pop_front();
   packets_.pop();
 }
 
+uint8_t* RtpPacketizerH264::AllocatePayload(
+    RtpPacketToSend* rtp_packet,
+    size_t prefix_size,
+    rtc::ArrayView<const uint8_t> fragment) {
+  if (payload_owner_) {
+    return rtp_packet->AllocatePayloadWithView(prefix_size, fragment,
+                                               payload_owner_);
+  }
+  uint8_t* buffer = rtp_packet->AllocatePayload(prefix_size + fragment.size());
+  memcpy(buffer + prefix_size, fragment.data(), fragment.size());
+  return buffer;
+}
+
 }  // namespace webrtc
@@ -19,12 +19,14 @@
 #include <queue>
 
 #include "api/array_view.h"
+#include "api/scoped_refptr.h"
 #include "modules/include/module_common_types.h"
 #include "modules/rtp_rtcp/source/rtp_format.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/video_coding/codecs/h264/include/h264_globals.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/ref_count.h"
 
 namespace webrtc {
 
@@ -32,10 +34,14 @@ class RtpPacketizerH264 : public RtpPacketizer {
  public:
   // Initialize with payload from encoder.
   // The payload_data must be exactly one encoded H264 frame.
-  RtpPacketizerH264(rtc::ArrayView<const uint8_t> payload,
-                    PayloadSizeLimits limits,
-                    H264PacketizationMode packetization_mode,
-                    const RTPFragmentationHeader& fragmentation);
+  // If |payload_owner| is set, it keeps |payload| alive, and the single NAL
+  // unit and FU-A packets reference |payload| instead of copying it.
+  RtpPacketizerH264(
+      rtc::ArrayView<const uint8_t> payload,
+      PayloadSizeLimits limits,
+      H264PacketizationMode packetization_mode,
+      const RTPFragmentationHeader& fragmentation,
+      rtc::scoped_refptr<rtc::RefCountInterface> payload_owner = nullptr);
 
   ~RtpPacketizerH264() override;
 
@@ -79,8 +85,14 @@ class RtpPacketizerH264 : public RtpPacketizer {
 
   void NextAggregatePacket(RtpPacketToSend* rtp_packet);
   void NextFragmentPacket(RtpPacketToSend* rtp_packet);
+  // Sets the payload of |rtp_packet| to |prefix_size| bytes, to write at the
+  // returned pointer, followed by |fragment|.
+  uint8_t* AllocatePayload(RtpPacketToSend* rtp_packet,
+                           size_t prefix_size,
+                           rtc::ArrayView<const uint8_t> fragment);
 
   const PayloadSizeLimits limits_;
+  const rtc::scoped_refptr<rtc::RefCountInterface> payload_owner_;
   size_t num_packets_left_;
   std::deque<rtc::ArrayView<const uint8_t>> input_fragments_;
   std::queue<PacketUnit> packets_;
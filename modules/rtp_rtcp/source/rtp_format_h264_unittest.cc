@@ -11,6 +11,7 @@
 #include "modules/rtp_rtcp/source/rtp_format_h264.h"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "api/array_view.h"
@@ -19,6 +20,7 @@
 #include "modules/rtp_rtcp/mocks/mock_rtp_rtcp.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/ref_counted_object.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -497,5 +499,51 @@ TEST(RtpPacketizerH264Test, RejectsOverlongDataInPacketizationMode0) {
 
   EXPECT_THAT(packets, IsEmpty());
 }
+
+// Holds the frame viewed by the packets.
+class FrameOwner : public rtc::RefCountInterface {
+ public:
+  explicit FrameOwner(rtc::Buffer frame) : frame_(std::move(frame)) {}
+  const rtc::Buffer& frame() const { return frame_; }
+
+ private:
+  const rtc::Buffer frame_;
+};
+
+TEST(RtpPacketizerH264Test, ViewsThePayloadOfTheOwner) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = kMaxPayloadSize;
+  // A STAP-A, three FU-A and a single NAL unit packets.
+  const size_t fragment_sizes[] = {2, 2, 3000, 600};
+  RTPFragmentationHeader fragmentation = CreateFragmentation(fragment_sizes);
+  rtc::scoped_refptr<rtc::RefCountedObject<FrameOwner>> owner(
+      new rtc::RefCountedObject<FrameOwner>(CreateFrame(fragmentation)));
+
+  RtpPacketizerH264 copying_packetizer(owner->frame(), limits,
+                                       H264PacketizationMode::NonInterleaved,
+                                       fragmentation);
+  std::vector<RtpPacketToSend> expected_packets =
+      FetchAllPackets(&copying_packetizer);
+  EXPECT_TRUE(owner->HasOneRef());
+
+  std::vector<RtpPacketToSend> packets;
+  {
+    RtpPacketizerH264 packetizer(owner->frame(), limits,
+                                 H264PacketizationMode::NonInterleaved,
+                                 fragmentation, owner);
+    packets = FetchAllPackets(&packetizer);
+  }
+  ASSERT_THAT(packets, SizeIs(5));
+  EXPECT_FALSE(owner->HasOneRef());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(expected_packets[i].size(), packets[i].size());
+    EXPECT_EQ(expected_packets[i].GatherBuffer(), packets[i].GatherBuffer());
+    EXPECT_THAT(packets[i].payload(),
+                ElementsAreArray(expected_packets[i].payload()));
+  }
+  packets.clear();
+  EXPECT_TRUE(owner->HasOneRef());
+}
+
 }  // namespace
 }  // namespace webrtc
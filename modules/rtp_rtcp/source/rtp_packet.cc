@@ -68,10 +68,19 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
   Clear();
 }
 
+RtpPacket::RtpPacket(const ExtensionManager* extensions,
+                     rtc::CopyOnWriteBuffer buffer)
+    : extensions_(extensions ? *extensions : ExtensionManager()),
+      buffer_(std::move(buffer)) {
+  RTC_DCHECK_GE(buffer_.capacity(), kFixedHeaderSize);
+  Clear();
+}
+
 RtpPacket::~RtpPacket() {}
 
 void RtpPacket::IdentifyExtensions(const ExtensionManager& extensions) {
   extensions_ = extensions;
+  IndexExtensionEntries();
 }
 
 bool RtpPacket::Parse(const uint8_t* buffer, size_t buffer_size) {
@@ -79,6 +88,7 @@ bool RtpPacket::Parse(const uint8_t* buffer, size_t buffer_size) {
     Clear();
     return false;
   }
+  ResetPayloadView();
   buffer_.SetData(buffer, buffer_size);
   RTC_DCHECK_EQ(size(), buffer_size);
   return true;
@@ -94,18 +104,19 @@ bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer) {
     return false;
   }
   size_t buffer_size = buffer.size();
+  ResetPayloadView();
   buffer_ = std::move(buffer);
   RTC_DCHECK_EQ(size(), buffer_size);
   return true;
 }
 
 std::vector<uint32_t> RtpPacket::Csrcs() const {
-  size_t num_csrc = data()[0] & 0x0F;
+  size_t num_csrc = *ReadAt(0) & 0x0F;
   RTC_DCHECK_GE(capacity(), kFixedHeaderSize + num_csrc * 4);
   std::vector<uint32_t> csrcs(num_csrc);
   for (size_t i = 0; i < num_csrc; ++i) {
     csrcs[i] =
-        ByteReader<uint32_t>::ReadBigEndian(&data()[kFixedHeaderSize + i * 4]);
+        ByteReader<uint32_t>::ReadBigEndian(ReadAt(kFixedHeaderSize + i * 4));
   }
   return csrcs;
 }
@@ -121,9 +132,11 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   payload_offset_ = packet.payload_offset_;
   extensions_ = packet.extensions_;
   extension_entries_ = packet.extension_entries_;
+  entry_index_by_type_ = packet.entry_index_by_type_;
   extensions_size_ = packet.extensions_size_;
   buffer_ = packet.buffer_.Slice(0, packet.headers_size());
   // Reset payload and padding.
+  ResetPayloadView();
   payload_size_ = 0;
   padding_size_ = 0;
 }
@@ -131,16 +144,16 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
 void RtpPacket::SetMarker(bool marker_bit) {
   marker_ = marker_bit;
   if (marker_) {
-    WriteAt(1, data()[1] | 0x80);
+    WriteAt(1, *ReadAt(1) | 0x80);
   } else {
-    WriteAt(1, data()[1] & 0x7F);
+    WriteAt(1, *ReadAt(1) & 0x7F);
   }
 }
 
 void RtpPacket::SetPayloadType(uint8_t payload_type) {
   RTC_DCHECK_LE(payload_type, 0x7Fu);
   payload_type_ = payload_type;
-  WriteAt(1, (data()[1] & 0x80) | payload_type);
+  WriteAt(1, (*ReadAt(1) & 0x80) | payload_type);
 }
 
 void RtpPacket::SetSequenceNumber(uint16_t seq_no) {
@@ -213,7 +226,7 @@ void RtpPacket::SetCsrcs(rtc::ArrayView<const uint32_t> csrcs) {
   RTC_DCHECK_LE(csrcs.size(), 0x0fu);
   RTC_DCHECK_LE(kFixedHeaderSize + 4 * csrcs.size(), capacity());
   payload_offset_ = kFixedHeaderSize + 4 * csrcs.size();
-  WriteAt(0, (data()[0] & 0xF0) | rtc::dchecked_cast<uint8_t>(csrcs.size()));
+  WriteAt(0, (*ReadAt(0) & 0xF0) | rtc::dchecked_cast<uint8_t>(csrcs.size()));
   size_t offset = kFixedHeaderSize;
   for (uint32_t csrc : csrcs) {
     ByteWriter<uint32_t>::WriteBigEndian(WriteAt(offset), csrc);
@@ -250,7 +263,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
     return nullptr;
   }
 
-  const size_t num_csrc = data()[0] & 0x0F;
+  const size_t num_csrc = *ReadAt(0) & 0x0F;
   const size_t extensions_offset = kFixedHeaderSize + (num_csrc * 4) + 4;
   // Determine if two-byte header is required for the extension based on id and
   // length. Please note that a length of 0 also requires two-byte header
@@ -263,7 +276,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
   uint16_t profile_id;
   if (extensions_size_ > 0) {
     profile_id =
-        ByteReader<uint16_t>::ReadBigEndian(data() + extensions_offset - 4);
+        ByteReader<uint16_t>::ReadBigEndian(ReadAt(extensions_offset - 4));
     if (profile_id == kOneByteExtensionProfileId && two_byte_header_required) {
       // Is buffer size big enough to fit promotion and new data field?
       // The header extension will grow with one byte per already allocated
@@ -303,7 +316,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
   // All checks passed, write down the extension headers.
   if (extensions_size_ == 0) {
     RTC_DCHECK_EQ(payload_offset_, kFixedHeaderSize + (num_csrc * 4));
-    WriteAt(0, data()[0] | 0x10);  // Set extension bit.
+    WriteAt(0, *ReadAt(0) | 0x10);  // Set extension bit.
     ByteWriter<uint16_t>::WriteBigEndian(WriteAt(extensions_offset - 4),
                                          profile_id);
   }
@@ -325,6 +338,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
   const uint8_t extension_info_length = rtc::dchecked_cast<uint8_t>(length);
   extension_entries_.emplace_back(id, extension_info_length,
                                   extension_info_offset);
+  IndexExtensionEntry(extension_entries_.size() - 1);
 
   extensions_size_ = new_extensions_size;
 
@@ -337,13 +351,13 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
 }
 
 void RtpPacket::PromoteToTwoByteHeaderExtension() {
-  size_t num_csrc = data()[0] & 0x0F;
+  size_t num_csrc = *ReadAt(0) & 0x0F;
   size_t extensions_offset = kFixedHeaderSize + (num_csrc * 4) + 4;
 
   RTC_CHECK_GT(extension_entries_.size(), 0);
   RTC_CHECK_EQ(payload_size_, 0);
   RTC_CHECK_EQ(kOneByteExtensionProfileId, ByteReader<uint16_t>::ReadBigEndian(
-                                               data() + extensions_offset - 4));
+                                               ReadAt(extensions_offset - 4)));
   // Rewrite data.
   // Each extension adds one to the offset. The write-read delta for the last
   // extension is therefore the same as the number of extension entries.
@@ -355,7 +369,7 @@ void RtpPacket::PromoteToTwoByteHeaderExtension() {
     // Update offset.
     extension_entry->offset = rtc::dchecked_cast<uint16_t>(write_index);
     // Copy data. Use memmove since read/write regions may overlap.
-    memmove(WriteAt(write_index), data() + read_index, extension_entry->length);
+    memmove(WriteAt(write_index), ReadAt(read_index), extension_entry->length);
     // Rewrite id and length.
     WriteAt(--write_index, extension_entry->length);
     WriteAt(--write_index, extension_entry->id);
@@ -389,12 +403,32 @@ uint16_t RtpPacket::SetExtensionLengthMaybeAddZeroPadding(
 uint8_t* RtpPacket::AllocatePayload(size_t size_bytes) {
   // Reset payload size to 0. If CopyOnWrite buffer_ was shared, this will cause
   // reallocation and memcpy. Keeping just header reduces memcpy size.
+  ResetPayloadView();
   SetPayloadSize(0);
   return SetPayloadSize(size_bytes);
 }
 
+uint8_t* RtpPacket::AllocatePayloadWithView(
+    size_t prefix_size,
+    rtc::ArrayView<const uint8_t> payload,
+    rtc::scoped_refptr<rtc::RefCountInterface> payload_owner) {
+  RTC_DCHECK(payload_owner || payload.empty());
+  if (payload_offset_ + prefix_size + payload.size() > capacity()) {
+    RTC_LOG(LS_WARNING) << "Cannot set payload, not enough space in buffer.";
+    return nullptr;
+  }
+  uint8_t* prefix = AllocatePayload(prefix_size);
+  payload_size_ += payload.size();
+  if (!payload.empty()) {
+    payload_view_ = payload;
+    payload_owner_ = std::move(payload_owner);
+  }
+  return prefix;
+}
+
 uint8_t* RtpPacket::SetPayloadSize(size_t size_bytes) {
   RTC_DCHECK_EQ(padding_size_, 0);
+  MaybeMergePayloadView();
   if (payload_offset_ + size_bytes > capacity()) {
     RTC_LOG(LS_WARNING) << "Cannot set payload, not enough space in buffer.";
     return nullptr;
@@ -405,6 +439,7 @@ uint8_t* RtpPacket::SetPayloadSize(size_t size_bytes) {
 }
 
 bool RtpPacket::SetPadding(size_t padding_bytes) {
+  MaybeMergePayloadView();
   if (payload_offset_ + payload_size_ + padding_bytes > capacity()) {
     RTC_LOG(LS_WARNING) << "Cannot set padding size " << padding_bytes
                         << ", only "
@@ -419,14 +454,23 @@ bool RtpPacket::SetPadding(size_t padding_bytes) {
     size_t padding_end = padding_offset + padding_size_;
     memset(WriteAt(padding_offset), 0, padding_size_ - 1);
     WriteAt(padding_end - 1, padding_size_);
-    WriteAt(0, data()[0] | 0x20);  // Set padding bit.
+    WriteAt(0, *ReadAt(0) | 0x20);  // Set padding bit.
   } else {
-    WriteAt(0, data()[0] & ~0x20);  // Clear padding bit.
+    WriteAt(0, *ReadAt(0) & ~0x20);  // Clear padding bit.
   }
   return true;
 }
 
+rtc::CopyOnWriteBuffer RtpPacket::GatherBuffer() const {
+  if (payload_view_.empty())
+    return buffer_;
+  rtc::CopyOnWriteBuffer buffer(buffer_.cdata(), buffer_.size(), capacity());
+  buffer.AppendData(payload_view_.data(), payload_view_.size());
+  return buffer;
+}
+
 void RtpPacket::Clear() {
+  ResetPayloadView();
   marker_ = false;
   payload_type_ = 0;
   sequence_number_ = 0;
@@ -437,12 +481,27 @@ void RtpPacket::Clear() {
   padding_size_ = 0;
   extensions_size_ = 0;
   extension_entries_.clear();
+  entry_index_by_type_.fill(kNoExtensionEntry);
 
   memset(WriteAt(0), 0, kFixedHeaderSize);
   buffer_.SetSize(kFixedHeaderSize);
   WriteAt(0, kRtpVersion << 6);
 }
 
+void RtpPacket::MergePayloadView() const {
+  RTC_DCHECK_EQ(padding_size_, 0);
+  RTC_DCHECK_EQ(buffer_.size() + payload_view_.size(),
+                payload_offset_ + payload_size_);
+  buffer_.AppendData(payload_view_.data(), payload_view_.size());
+  payload_view_ = rtc::ArrayView<const uint8_t>();
+  payload_owner_ = nullptr;
+}
+
+void RtpPacket::ResetPayloadView() {
+  payload_view_ = rtc::ArrayView<const uint8_t>();
+  payload_owner_ = nullptr;
+}
+
 bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   if (size < kFixedHeaderSize) {
     return false;
@@ -553,6 +612,7 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
     }
     payload_offset_ = extension_offset + extensions_capacity;
   }
+  IndexExtensionEntries();
 
   if (payload_offset_ + padding_size_ > size) {
     return false;
@@ -580,18 +640,32 @@ RtpPacket::ExtensionInfo& RtpPacket::FindOrCreateExtensionInfo(int id) {
   return extension_entries_.back();
 }
 
+void RtpPacket::IndexExtensionEntries() {
+  entry_index_by_type_.fill(kNoExtensionEntry);
+  for (size_t i = 0; i < extension_entries_.size(); ++i) {
+    IndexExtensionEntry(i);
+  }
+}
+
+void RtpPacket::IndexExtensionEntry(size_t index) {
+  RTPExtensionType type = extensions_.GetType(extension_entries_[index].id);
+  if (type == ExtensionManager::kInvalidType) {
+    // Extension not registered, can only be accessed by id.
+    return;
+  }
+  // At most 255 ids are valid, so the index fits and can't be confused
+  // with kNoExtensionEntry.
+  RTC_DCHECK_LT(index, kNoExtensionEntry);
+  entry_index_by_type_[type] = static_cast<uint8_t>(index);
+}
+
 rtc::ArrayView<const uint8_t> RtpPacket::FindExtension(
     ExtensionType type) const {
-  uint8_t id = extensions_.GetId(type);
-  if (id == ExtensionManager::kInvalidId) {
-    // Extension not registered.
-    return nullptr;
-  }
-  ExtensionInfo const* extension_info = FindExtensionInfo(id);
+  const ExtensionInfo* extension_info = FindExtensionInfoByType(type);
   if (extension_info == nullptr) {
     return nullptr;
   }
-  return rtc::MakeArrayView(data() + extension_info->offset,
+  return rtc::MakeArrayView(ReadAt(extension_info->offset),
                             extension_info->length);
 }
 
@@ -617,12 +691,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateExtension(ExtensionType type,
 }
 
 bool RtpPacket::HasExtension(ExtensionType type) const {
-  uint8_t id = extensions_.GetId(type);
-  if (id == ExtensionManager::kInvalidId) {
-    // Extension not registered.
-    return false;
-  }
-  return FindExtensionInfo(id) != nullptr;
+  return FindExtensionInfoByType(type) != nullptr;
 }
 
 bool RtpPacket::RemoveExtension(ExtensionType type) {
@@ -10,14 +10,19 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 
+#include <array>
 #include <string>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/scoped_refptr.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/ref_count.h"
 
 namespace webrtc {
 
@@ -34,6 +39,9 @@ class RtpPacket {
   explicit RtpPacket(const ExtensionManager* extensions);
   RtpPacket(const RtpPacket&);
   RtpPacket(const ExtensionManager* extensions, size_t capacity);
+  // Builds the packet in the storage of |buffer|, which should not be shared
+  // with other buffers and needs room for at least the fixed header.
+  RtpPacket(const ExtensionManager* extensions, rtc::CopyOnWriteBuffer buffer);
   ~RtpPacket();
 
   RtpPacket& operator=(const RtpPacket&) = default;
@@ -65,19 +73,33 @@ class RtpPacket {
   size_t payload_size() const { return payload_size_; }
   size_t padding_size() const { return padding_size_; }
   rtc::ArrayView<const uint8_t> payload() const {
+    // A payload view without a prefix is returned as is.
+    if (!payload_view_.empty() && buffer_.size() == payload_offset_)
+      return payload_view_;
     return rtc::MakeArrayView(data() + payload_offset_, payload_size_);
   }
   rtc::CopyOnWriteBuffer PayloadBuffer() const {
+    MaybeMergePayloadView();
     return buffer_.Slice(payload_offset_, payload_size_);
   }
 
   // Buffer.
-  rtc::CopyOnWriteBuffer Buffer() const { return buffer_; }
+  rtc::CopyOnWriteBuffer Buffer() const {
+    MaybeMergePayloadView();
+    return buffer_;
+  }
+  // Same as Buffer(), except that a payload view is copied with the headers
+  // to a new buffer of capacity(), not shared with the packet, instead of
+  // being merged into the buffer of the packet.
+  rtc::CopyOnWriteBuffer GatherBuffer() const;
   size_t capacity() const { return buffer_.capacity(); }
   size_t size() const {
     return payload_offset_ + payload_size_ + padding_size_;
   }
-  const uint8_t* data() const { return buffer_.cdata(); }
+  const uint8_t* data() const {
+    MaybeMergePayloadView();
+    return buffer_.cdata();
+  }
   size_t FreeCapacity() const { return capacity() - size(); }
   size_t MaxPayloadSize() const { return capacity() - headers_size(); }
 
@@ -140,12 +162,25 @@ class RtpPacket {
   uint8_t* SetPayloadSize(size_t size_bytes);
   // Same as SetPayloadSize but doesn't guarantee to keep current payload.
   uint8_t* AllocatePayload(size_t size_bytes);
+  // Same as AllocatePayload(|prefix_size| + |payload.size()|), but only the
+  // |prefix_size| bytes to write at the returned pointer are in the buffer of
+  // the packet. They are followed by the |payload| view, not copied until
+  // the contiguous packet is needed, and kept alive by |payload_owner|.
+  uint8_t* AllocatePayloadWithView(
+      size_t prefix_size,
+      rtc::ArrayView<const uint8_t> payload,
+      rtc::scoped_refptr<rtc::RefCountInterface> payload_owner);
 
   bool SetPadding(size_t padding_size);
 
   // Returns debug string of RTP packet (without detailed extension info).
   std::string ToString() const;
 
+ protected:
+  // For subclasses that recycle the storage of the packet. Doesn't include
+  // the payload view, if any.
+  rtc::CopyOnWriteBuffer& mutable_buffer() { return buffer_; }
+
  private:
   struct ExtensionInfo {
     explicit ExtensionInfo(uint8_t id) : ExtensionInfo(id, 0, 0) {}
@@ -156,6 +191,12 @@ class RtpPacket {
     uint16_t offset;
   };
 
+  // Number of extension entries stored without a heap allocation, enough for
+  // the extensions negotiated in practice.
+  static constexpr size_t kInlinedExtensionEntries = 16;
+  // Marks a type without an entry in |entry_index_by_type_|.
+  static constexpr uint8_t kNoExtensionEntry = 0xff;
+
   // Helper function for Parse. Fill header fields using data in given buffer,
   // but does not touch packet own buffer, leaving packet in invalid state.
   bool ParseBuffer(const uint8_t* buffer, size_t size);
@@ -168,6 +209,24 @@ class RtpPacket {
   // with the specified id if not found.
   ExtensionInfo& FindOrCreateExtensionInfo(int id);
 
+  // Returns pointer to extension info for a given registered type, or nullptr
+  // if the type is not registered or not present. Inlined, so that the lookup
+  // reduces to an array access when |type| is known at compile time.
+  const ExtensionInfo* FindExtensionInfoByType(ExtensionType type) const {
+    RTC_DCHECK_GT(type, kRtpExtensionNone);
+    RTC_DCHECK_LT(type, kRtpExtensionNumberOfExtensions);
+    uint8_t index = entry_index_by_type_[type];
+    if (index == kNoExtensionEntry) {
+      return nullptr;
+    }
+    return &extension_entries_[index];
+  }
+
+  // Maps the types registered in |extensions_| to the entries of
+  // |extension_entries_|.
+  void IndexExtensionEntries();
+  void IndexExtensionEntry(size_t index);
+
   // Allocates and returns place to store rtp header extension.
   // Returns empty arrayview on failure.
   rtc::ArrayView<uint8_t> AllocateRawExtension(int id, size_t length);
@@ -180,7 +239,17 @@ class RtpPacket {
 
   uint8_t* WriteAt(size_t offset) { return buffer_.data() + offset; }
   void WriteAt(size_t offset, uint8_t byte) { buffer_.data()[offset] = byte; }
-  const uint8_t* ReadAt(size_t offset) const { return buffer_.data() + offset; }
+  const uint8_t* ReadAt(size_t offset) const {
+    return buffer_.cdata() + offset;
+  }
+
+  void MaybeMergePayloadView() const {
+    if (!payload_view_.empty())
+      MergePayloadView();
+  }
+  // Appends the payload view to |buffer_| and drops it.
+  void MergePayloadView() const;
+  void ResetPayloadView();
 
   // Header.
   bool marker_;
@@ -193,19 +262,29 @@ class RtpPacket {
   size_t payload_size_;
 
   ExtensionManager extensions_;
-  std::vector<ExtensionInfo> extension_entries_;
+  absl::InlinedVector<ExtensionInfo, kInlinedExtensionEntries>
+      extension_entries_;
+  // Index into |extension_entries_| per extension type, filled while parsing
+  // so that lookups by type don't need to search the entries.
+  std::array<uint8_t, kRtpExtensionNumberOfExtensions> entry_index_by_type_;
   size_t extensions_size_ = 0;  // Unaligned.
-  rtc::CopyOnWriteBuffer buffer_;
+  // Mutable to merge the payload view in on the first access to the
+  // contiguous packet.
+  mutable rtc::CopyOnWriteBuffer buffer_;
+  // The end of the payload when it isn't in |buffer_|, which then ends with
+  // the start of the payload.
+  mutable rtc::ArrayView<const uint8_t> payload_view_;
+  mutable rtc::scoped_refptr<rtc::RefCountInterface> payload_owner_;
 };
 
 template <typename Extension>
 bool RtpPacket::HasExtension() const {
-  return HasExtension(Extension::kId);
+  return FindExtensionInfoByType(Extension::kId) != nullptr;
 }
 
 template <typename Extension, typename FirstValue, typename... Values>
 bool RtpPacket::GetExtension(FirstValue first, Values... values) const {
-  auto raw = FindExtension(Extension::kId);
+  auto raw = GetRawExtension<Extension>();
   if (raw.empty())
     return false;
   return Extension::Parse(raw, first, values...);
@@ -214,7 +293,7 @@ bool RtpPacket::GetExtension(FirstValue first, Values... values) const {
 template <typename Extension>
 absl::optional<typename Extension::value_type> RtpPacket::GetExtension() const {
   absl::optional<typename Extension::value_type> result;
-  auto raw = FindExtension(Extension::kId);
+  auto raw = GetRawExtension<Extension>();
   if (raw.empty() || !Extension::Parse(raw, &result.emplace()))
     result = absl::nullopt;
   return result;
@@ -222,7 +301,13 @@ absl::optional<typename Extension::value_type> RtpPacket::GetExtension() const {
 
 template <typename Extension>
 rtc::ArrayView<const uint8_t> RtpPacket::GetRawExtension() const {
-  return FindExtension(Extension::kId);
+  const ExtensionInfo* extension_info =
+      FindExtensionInfoByType(Extension::kId);
+  if (extension_info == nullptr) {
+    return nullptr;
+  }
+  return rtc::MakeArrayView(data() + extension_info->offset,
+                            extension_info->length);
 }
 
 template <typename Extension, typename... Values>
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+RtpPacketBufferPool::RtpPacketBufferPool(size_t max_free_buffers)
+    : max_free_buffers_(max_free_buffers) {}
+
+RtpPacketBufferPool::~RtpPacketBufferPool() = default;
+
+rtc::CopyOnWriteBuffer RtpPacketBufferPool::GetBuffer(size_t capacity) {
+  RTC_DCHECK_GT(capacity, 0);
+  rtc::CopyOnWriteBuffer buffer;
+  {
+    rtc::CritScope lock(&crit_);
+    if (!free_buffers_.empty()) {
+      buffer = std::move(free_buffers_.back());
+      free_buffers_.pop_back();
+    }
+  }
+  // Buffers of another size, left from before the max packet size changed,
+  // are dropped rather than reused, so that packets never get more room than
+  // asked for.
+  if (buffer.capacity() != capacity) {
+    buffer = rtc::CopyOnWriteBuffer(0, capacity);
+  }
+  return buffer;
+}
+
+void RtpPacketBufferPool::ReturnBuffer(rtc::CopyOnWriteBuffer buffer) {
+  if (buffer.capacity() == 0 || buffer.IsShared()) {
+    return;
+  }
+  buffer.Clear();
+  rtc::CritScope lock(&crit_);
+  if (free_buffers_.size() < max_free_buffers_) {
+    free_buffers_.push_back(std::move(buffer));
+  }
+}
+
+size_t RtpPacketBufferPool::NumFreeBuffers() const {
+  rtc::CritScope lock(&crit_);
+  return free_buffers_.size();
+}
+
+}  // namespace webrtc
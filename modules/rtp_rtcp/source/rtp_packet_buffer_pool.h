@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Recycles the buffers of RtpPacketToSend objects, so that packets created in
+// steady state do not allocate memory for their data. A packet created with a
+// pool hands its buffer back when destroyed, unless the buffer is still shared
+// with a copy of the packet, e.g. the one kept in RtpPacketHistory. The last
+// copy to go returns it. Packets are created and destroyed on different
+// threads, so the pool is thread safe.
+class RtpPacketBufferPool : public rtc::RefCountInterface {
+ public:
+  static constexpr size_t kDefaultMaxFreeBuffers = 256;
+
+  explicit RtpPacketBufferPool(size_t max_free_buffers = kDefaultMaxFreeBuffers);
+
+  // Returns an empty buffer, not shared with any other buffer, with
+  // |capacity| bytes of storage.
+  rtc::CopyOnWriteBuffer GetBuffer(size_t capacity);
+  // Takes |buffer| back for reuse, unless it is still shared or the pool
+  // already holds |max_free_buffers| buffers.
+  void ReturnBuffer(rtc::CopyOnWriteBuffer buffer);
+
+  size_t NumFreeBuffers() const;
+
+ protected:
+  ~RtpPacketBufferPool() override;
+
+ private:
+  const size_t max_free_buffers_;
+  rtc::CriticalSection crit_;
+  std::vector<rtc::CopyOnWriteBuffer> free_buffers_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
+
+#include <memory>
+
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kCapacity = 1216;
+constexpr uint8_t kPayload[] = {1, 2, 3, 4};
+
+rtc::scoped_refptr<RtpPacketBufferPool> CreatePool(size_t max_free_buffers) {
+  return new rtc::RefCountedObject<RtpPacketBufferPool>(max_free_buffers);
+}
+
+TEST(RtpPacketBufferPoolTest, ReusesReturnedBuffer) {
+  auto pool = CreatePool(RtpPacketBufferPool::kDefaultMaxFreeBuffers);
+  rtc::CopyOnWriteBuffer buffer = pool->GetBuffer(kCapacity);
+  EXPECT_EQ(buffer.capacity(), kCapacity);
+  buffer.SetData(kPayload, sizeof(kPayload));
+  const uint8_t* data = buffer.cdata();
+
+  pool->ReturnBuffer(std::move(buffer));
+  EXPECT_EQ(pool->NumFreeBuffers(), 1u);
+  rtc::CopyOnWriteBuffer reused = pool->GetBuffer(kCapacity);
+  EXPECT_EQ(reused.cdata(), data);
+  EXPECT_EQ(reused.size(), 0u);
+  EXPECT_EQ(pool->NumFreeBuffers(), 0u);
+}
+
+TEST(RtpPacketBufferPoolTest, DropsSharedAndMismatchingBuffers) {
+  auto pool = CreatePool(RtpPacketBufferPool::kDefaultMaxFreeBuffers);
+  rtc::CopyOnWriteBuffer buffer = pool->GetBuffer(kCapacity);
+  rtc::CopyOnWriteBuffer copy = buffer;
+  pool->ReturnBuffer(std::move(buffer));
+  EXPECT_EQ(pool->NumFreeBuffers(), 0u);
+
+  pool->ReturnBuffer(std::move(copy));
+  EXPECT_EQ(pool->NumFreeBuffers(), 1u);
+  EXPECT_EQ(pool->GetBuffer(2 * kCapacity).capacity(), 2 * kCapacity);
+  EXPECT_EQ(pool->NumFreeBuffers(), 0u);
+}
+
+TEST(RtpPacketBufferPoolTest, KeepsAtMostMaxFreeBuffers) {
+  auto pool = CreatePool(1);
+  rtc::CopyOnWriteBuffer first = pool->GetBuffer(kCapacity);
+  rtc::CopyOnWriteBuffer second = pool->GetBuffer(kCapacity);
+  pool->ReturnBuffer(std::move(first));
+  pool->ReturnBuffer(std::move(second));
+  EXPECT_EQ(pool->NumFreeBuffers(), 1u);
+}
+
+TEST(RtpPacketBufferPoolTest, LastPacketCopyReturnsBuffer) {
+  auto pool = CreatePool(RtpPacketBufferPool::kDefaultMaxFreeBuffers);
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr, kCapacity, pool);
+  packet->SetPayloadSize(100);
+  const uint8_t* data = packet->data();
+  // E.g. the copy kept in the packet history.
+  auto copy = std::make_unique<RtpPacketToSend>(*packet);
+  EXPECT_EQ(copy->data(), data);
+
+  packet.reset();
+  EXPECT_EQ(pool->NumFreeBuffers(), 0u);
+  copy.reset();
+  EXPECT_EQ(pool->NumFreeBuffers(), 1u);
+
+  RtpPacketToSend reused(nullptr, kCapacity, pool);
+  EXPECT_EQ(reused.data(), data);
+  EXPECT_EQ(reused.size(), 12u);
+}
+
+TEST(RtpPacketBufferPoolTest, UnshareBufferCopiesIntoPooledBuffer) {
+  auto pool = CreatePool(RtpPacketBufferPool::kDefaultMaxFreeBuffers);
+  RtpPacketToSend packet_template(nullptr, kCapacity, pool);
+  packet_template.SetSsrc(1234);
+  // Leave a free buffer in the pool.
+  RtpPacketToSend(nullptr, kCapacity, pool);
+  ASSERT_EQ(pool->NumFreeBuffers(), 1u);
+
+  RtpPacketToSend packet(packet_template);
+  EXPECT_EQ(packet.data(), packet_template.data());
+  packet.UnshareBuffer();
+  EXPECT_NE(packet.data(), packet_template.data());
+  EXPECT_EQ(pool->NumFreeBuffers(), 0u);
+  EXPECT_EQ(packet.Ssrc(), 1234u);
+  EXPECT_EQ(packet.capacity(), kCapacity);
+
+  // Already unshared, so keeps the buffer.
+  const uint8_t* data = packet.data();
+  packet.UnshareBuffer();
+  EXPECT_EQ(packet.data(), data);
+}
+
+}  // namespace
+}  // namespace webrtc
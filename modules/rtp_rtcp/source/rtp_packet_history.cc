@@ -23,16 +23,6 @@
 
 namespace webrtc {
 
-constexpr size_t RtpPacketHistory::kMaxCapacity;
-constexpr size_t RtpPacketHistory::kMaxPaddingtHistory;
-constexpr int64_t RtpPacketHistory::kMinPacketDurationMs;
-constexpr int RtpPacketHistory::kMinPacketDurationRtt;
-constexpr int RtpPacketHistory::kPacketCullingDelayFactor;
-
-RtpPacketHistory::PacketState::PacketState() = default;
-RtpPacketHistory::PacketState::PacketState(const PacketState&) = default;
-RtpPacketHistory::PacketState::~PacketState() = default;
-
 RtpPacketHistory::StoredPacket::StoredPacket(
     std::unique_ptr<RtpPacketToSend> packet,
     absl::optional<int64_t> send_time_ms,
@@ -86,7 +76,8 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock, bool enable_padding_prio)
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_ms_(-1),
-      packets_inserted_(0) {}
+      packets_inserted_(0),
+      memory_(MemoryCategory::kRtpPacketHistory) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -156,6 +147,7 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   RTC_DCHECK_LT(packet_index, packet_history_.size());
   RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
 
+  memory_.Add(packet->capacity());
   packet_history_[packet_index] =
       StoredPacket(std::move(packet), send_time_ms, packets_inserted_++);
 
@@ -198,14 +190,6 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   return std::make_unique<RtpPacketToSend>(*packet->packet_);
 }
 
-std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
-    uint16_t sequence_number) {
-  return GetPacketAndMarkAsPending(
-      sequence_number, [](const RtpPacketToSend& packet) {
-        return std::make_unique<RtpPacketToSend>(packet);
-      });
-}
-
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
     uint16_t sequence_number,
     rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
@@ -301,13 +285,6 @@ bool RtpPacketHistory::VerifyRtt(const RtpPacketHistory::StoredPacket& packet,
   return true;
 }
 
-std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket() {
-  // Default implementation always just returns a copy of the packet.
-  return GetPayloadPaddingPacket([](const RtpPacketToSend& packet) {
-    return std::make_unique<RtpPacketToSend>(packet);
-  });
-}
-
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
     rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
         encapsulate) {
@@ -391,6 +368,7 @@ void RtpPacketHistory::Clear() {
 void RtpPacketHistory::Reset() {
   packet_history_.clear();
   padding_priority_.clear();
+  memory_.Set(0);
 }
 
 void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
@@ -434,6 +412,9 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
   // Move the packet out from the StoredPacket container.
   std::unique_ptr<RtpPacketToSend> rtp_packet =
       std::move(packet_history_[packet_index].packet_);
+  if (rtp_packet) {
+    memory_.Subtract(rtp_packet->capacity());
+  }
 
   // Erase from padding priority set, if eligible.
   if (enable_padding_prio_) {
@@ -497,6 +478,7 @@ RtpPacketHistory::PacketState RtpPacketHistory::StoredPacketToPacketState(
   state.packet_size = stored_packet.packet_->size();
   state.times_retransmitted = stored_packet.times_retransmitted();
   state.pending_transmission = stored_packet.pending_transmission_;
+  state.is_key_frame = stored_packet.packet_->is_key_frame();
   return state;
 }
 
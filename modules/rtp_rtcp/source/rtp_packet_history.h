@@ -19,8 +19,10 @@
 
 #include "api/function_view.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history_interface.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/memory/memory_accounting.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -28,112 +30,36 @@ namespace webrtc {
 class Clock;
 class RtpPacketToSend;
 
-class RtpPacketHistory {
+// RtpPacketHistoryInterface implementation with all state guarded by one lock.
+class RtpPacketHistory : public RtpPacketHistoryInterface {
  public:
-  enum class StorageMode {
-    kDisabled,     // Don't store any packets.
-    kStoreAndCull  // Store up to |number_to_store| packets, but try to remove
-                   // packets as they time out or as signaled as received.
-  };
-
-  // Snapshot indicating the state of a packet in the history.
-  struct PacketState {
-    PacketState();
-    PacketState(const PacketState&);
-    ~PacketState();
-
-    uint16_t rtp_sequence_number = 0;
-    absl::optional<int64_t> send_time_ms;
-    int64_t capture_time_ms = 0;
-    uint32_t ssrc = 0;
-    size_t packet_size = 0;
-    // Number of times RE-transmitted, ie not including the first transmission.
-    size_t times_retransmitted = 0;
-    bool pending_transmission = false;
-  };
-
-  // Maximum number of packets we ever allow in the history.
-  static constexpr size_t kMaxCapacity = 9600;
-  // Maximum number of entries in prioritized queue of padding packets.
-  static constexpr size_t kMaxPaddingtHistory = 63;
-  // Don't remove packets within max(1000ms, 3x RTT).
-  static constexpr int64_t kMinPacketDurationMs = 1000;
-  static constexpr int kMinPacketDurationRtt = 3;
-  // With kStoreAndCull, always remove packets after 3x max(1000ms, 3x rtt).
-  static constexpr int kPacketCullingDelayFactor = 3;
-
   RtpPacketHistory(Clock* clock, bool enable_padding_prio);
-  ~RtpPacketHistory();
-
-  // Set/get storage mode. Note that setting the state will clear the history,
-  // even if setting the same state as is currently used.
-  void SetStorePacketsStatus(StorageMode mode, size_t number_to_store);
-  StorageMode GetStorageMode() const;
+  ~RtpPacketHistory() override;
 
-  // Set RTT, used to avoid premature retransmission and to prevent over-writing
-  // a packet in the history before we are reasonably sure it has been received.
-  void SetRtt(int64_t rtt_ms);
+  using RtpPacketHistoryInterface::GetPacketAndMarkAsPending;
+  using RtpPacketHistoryInterface::GetPayloadPaddingPacket;
 
-  // If |send_time| is set, packet was sent without using pacer, so state will
-  // be set accordingly.
+  void SetStorePacketsStatus(StorageMode mode, size_t number_to_store) override;
+  StorageMode GetStorageMode() const override;
+  void SetRtt(int64_t rtt_ms) override;
   void PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
-                    absl::optional<int64_t> send_time_ms);
-
-  // Gets stored RTP packet corresponding to the input |sequence number|.
-  // Returns nullptr if packet is not found or was (re)sent too recently.
+                    absl::optional<int64_t> send_time_ms) override;
   std::unique_ptr<RtpPacketToSend> GetPacketAndSetSendTime(
-      uint16_t sequence_number);
-
-  // Gets stored RTP packet corresponding to the input |sequence number|.
-  // Returns nullptr if packet is not found or was (re)sent too recently.
-  // If a packet copy is returned, it will be marked as pending transmission but
-  // does not update send time, that must be done by MarkPacketAsSent().
-  std::unique_ptr<RtpPacketToSend> GetPacketAndMarkAsPending(
-      uint16_t sequence_number);
-
-  // In addition to getting packet and marking as sent, this method takes an
-  // encapsulator function that takes a reference to the packet and outputs a
-  // copy that may be wrapped in a container, eg RTX.
-  // If the the encapsulator returns nullptr, the retransmit is aborted and the
-  // packet will not be marked as pending.
+      uint16_t sequence_number) override;
   std::unique_ptr<RtpPacketToSend> GetPacketAndMarkAsPending(
       uint16_t sequence_number,
       rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
-          const RtpPacketToSend&)> encapsulate);
-
-  // Updates the send time for the given packet and increments the transmission
-  // counter. Marks the packet as no longer being in the pacer queue.
-  void MarkPacketAsSent(uint16_t sequence_number);
-
-  // Similar to GetPacketAndSetSendTime(), but only returns a snapshot of the
-  // current state for packet, and never updates internal state.
-  absl::optional<PacketState> GetPacketState(uint16_t sequence_number) const;
-
-  // Get the packet (if any) from the history, that is deemed most likely to
-  // the remote side. This is calculated from heuristics such as packet age
-  // and times retransmitted. Updated the send time of the packet, so is not
-  // a const method.
-  std::unique_ptr<RtpPacketToSend> GetPayloadPaddingPacket();
-
-  // Same as GetPayloadPaddingPacket(void), but adds an encapsulation
-  // that can be used for instance to encapsulate the packet in an RTX
-  // container, or to abort getting the packet if the function returns
-  // nullptr.
+          const RtpPacketToSend&)> encapsulate) override;
+  void MarkPacketAsSent(uint16_t sequence_number) override;
+  absl::optional<PacketState> GetPacketState(
+      uint16_t sequence_number) const override;
   std::unique_ptr<RtpPacketToSend> GetPayloadPaddingPacket(
       rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
-          const RtpPacketToSend&)> encapsulate);
-
-  // Cull packets that have been acknowledged as received by the remote end.
-  void CullAcknowledgedPackets(rtc::ArrayView<const uint16_t> sequence_numbers);
-
-  // Mark packet as queued for transmission. This will prevent premature
-  // removal or duplicate retransmissions in the pacer queue.
-  // Returns true if status was set, false if packet was not found.
-  bool SetPendingTransmission(uint16_t sequence_number);
-
-  // Remove all pending packets from the history, but keep storage mode and
-  // capacity.
-  void Clear();
+          const RtpPacketToSend&)> encapsulate) override;
+  void CullAcknowledgedPackets(
+      rtc::ArrayView<const uint16_t> sequence_numbers) override;
+  bool SetPendingTransmission(uint16_t sequence_number) override;
+  void Clear() override;
 
  private:
   struct MoreUseful;
@@ -211,6 +137,8 @@ class RtpPacketHistory {
   // Objects from |packet_history_| ordered by "most likely to be useful", used
   // in GetPayloadPaddingPacket().
   PacketPrioritySet padding_priority_ RTC_GUARDED_BY(lock_);
+  // The capacity of the stored packets.
+  TrackedMemory memory_ RTC_GUARDED_BY(lock_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
 };
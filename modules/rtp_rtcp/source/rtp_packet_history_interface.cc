@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_history_interface.h"
+
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+constexpr size_t RtpPacketHistoryInterface::kMaxCapacity;
+constexpr size_t RtpPacketHistoryInterface::kMaxPaddingtHistory;
+constexpr int64_t RtpPacketHistoryInterface::kMinPacketDurationMs;
+constexpr int RtpPacketHistoryInterface::kMinPacketDurationRtt;
+constexpr int RtpPacketHistoryInterface::kPacketCullingDelayFactor;
+
+RtpPacketHistoryInterface::PacketState::PacketState() = default;
+RtpPacketHistoryInterface::PacketState::PacketState(const PacketState&) =
+    default;
+RtpPacketHistoryInterface::PacketState::~PacketState() = default;
+
+std::unique_ptr<RtpPacketToSend>
+RtpPacketHistoryInterface::GetPacketAndMarkAsPending(uint16_t sequence_number) {
+  return GetPacketAndMarkAsPending(
+      sequence_number, [](const RtpPacketToSend& packet) {
+        return std::make_unique<RtpPacketToSend>(packet);
+      });
+}
+
+std::unique_ptr<RtpPacketToSend>
+RtpPacketHistoryInterface::GetPayloadPaddingPacket() {
+  // Default implementation always just returns a copy of the packet.
+  return GetPayloadPaddingPacket([](const RtpPacketToSend& packet) {
+    return std::make_unique<RtpPacketToSend>(packet);
+  });
+}
+
+}  // namespace webrtc
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_INTERFACE_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_INTERFACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/function_view.h"
+
+namespace webrtc {
+
+class RtpPacketToSend;
+
+// Storage of sent RTP packets, used for retransmissions and payload padding.
+// Packets are put by the egress on the pacer thread while retransmissions are
+// requested on the RTCP thread, so implementations are thread safe.
+class RtpPacketHistoryInterface {
+ public:
+  enum class StorageMode {
+    kDisabled,     // Don't store any packets.
+    kStoreAndCull  // Store up to |number_to_store| packets, but try to remove
+                   // packets as they time out or as signaled as received.
+  };
+
+  // Snapshot indicating the state of a packet in the history.
+  struct PacketState {
+    PacketState();
+    PacketState(const PacketState&);
+    ~PacketState();
+
+    uint16_t rtp_sequence_number = 0;
+    absl::optional<int64_t> send_time_ms;
+    int64_t capture_time_ms = 0;
+    uint32_t ssrc = 0;
+    size_t packet_size = 0;
+    // Number of times RE-transmitted, ie not including the first transmission.
+    size_t times_retransmitted = 0;
+    bool pending_transmission = false;
+    bool is_key_frame = false;
+  };
+
+  // Maximum number of packets we ever allow in the history.
+  static constexpr size_t kMaxCapacity = 9600;
+  // Maximum number of entries in prioritized queue of padding packets.
+  static constexpr size_t kMaxPaddingtHistory = 63;
+  // Don't remove packets within max(1000ms, 3x RTT).
+  static constexpr int64_t kMinPacketDurationMs = 1000;
+  static constexpr int kMinPacketDurationRtt = 3;
+  // With kStoreAndCull, always remove packets after 3x max(1000ms, 3x rtt).
+  static constexpr int kPacketCullingDelayFactor = 3;
+
+  virtual ~RtpPacketHistoryInterface() = default;
+
+  // Set/get storage mode. Note that setting the state will clear the history,
+  // even if setting the same state as is currently used.
+  virtual void SetStorePacketsStatus(StorageMode mode,
+                                     size_t number_to_store) = 0;
+  virtual StorageMode GetStorageMode() const = 0;
+
+  // Set RTT, used to avoid premature retransmission and to prevent over-writing
+  // a packet in the history before we are reasonably sure it has been received.
+  virtual void SetRtt(int64_t rtt_ms) = 0;
+
+  // If |send_time| is set, packet was sent without using pacer, so state will
+  // be set accordingly.
+  virtual void PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
+                            absl::optional<int64_t> send_time_ms) = 0;
+
+  // Gets stored RTP packet corresponding to the input |sequence number|.
+  // Returns nullptr if packet is not found or was (re)sent too recently.
+  virtual std::unique_ptr<RtpPacketToSend> GetPacketAndSetSendTime(
+      uint16_t sequence_number) = 0;
+
+  // Gets stored RTP packet corresponding to the input |sequence number|.
+  // Returns nullptr if packet is not found or was (re)sent too recently.
+  // If a packet copy is returned, it will be marked as pending transmission but
+  // does not update send time, that must be done by MarkPacketAsSent().
+  std::unique_ptr<RtpPacketToSend> GetPacketAndMarkAsPending(
+      uint16_t sequence_number);
+
+  // In addition to getting packet and marking as sent, this method takes an
+  // encapsulator function that takes a reference to the packet and outputs a
+  // copy that may be wrapped in a container, eg RTX.
+  // If the the encapsulator returns nullptr, the retransmit is aborted and the
+  // packet will not be marked as pending.
+  virtual std::unique_ptr<RtpPacketToSend> GetPacketAndMarkAsPending(
+      uint16_t sequence_number,
+      rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
+          const RtpPacketToSend&)> encapsulate) = 0;
+
+  // Updates the send time for the given packet and increments the transmission
+  // counter. Marks the packet as no longer being in the pacer queue.
+  virtual void MarkPacketAsSent(uint16_t sequence_number) = 0;
+
+  // Similar to GetPacketAndSetSendTime(), but only returns a snapshot of the
+  // current state for packet, and never updates internal state.
+  virtual absl::optional<PacketState> GetPacketState(
+      uint16_t sequence_number) const = 0;
+
+  // Get the packet (if any) from the history, that is deemed most likely to
+  // the remote side. This is calculated from heuristics such as packet age
+  // and times retransmitted. Updated the send time of the packet, so is not
+  // a const method.
+  std::unique_ptr<RtpPacketToSend> GetPayloadPaddingPacket();
+
+  // Same as GetPayloadPaddingPacket(void), but adds an encapsulation
+  // that can be used for instance to encapsulate the packet in an RTX
+  // container, or to abort getting the packet if the function returns
+  // nullptr.
+  virtual std::unique_ptr<RtpPacketToSend> GetPayloadPaddingPacket(
+      rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
+          const RtpPacketToSend&)> encapsulate) = 0;
+
+  // Cull packets that have been acknowledged as received by the remote end.
+  virtual void CullAcknowledgedPackets(
+      rtc::ArrayView<const uint16_t> sequence_numbers) = 0;
+
+  // Mark packet as queued for transmission. This will prevent premature
+  // removal or duplicate retransmissions in the pacer queue.
+  // Returns true if status was set, false if packet was not found.
+  virtual bool SetPendingTransmission(uint16_t sequence_number) = 0;
+
+  // Remove all pending packets from the history, but keep storage mode and
+  // capacity.
+  virtual void Clear() = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_INTERFACE_H_
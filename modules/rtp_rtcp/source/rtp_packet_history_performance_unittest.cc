@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_ring_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumPackets = 200000;
+constexpr size_t kNumToStore = 2000;
+constexpr size_t kPayloadSize = 1100;
+
+struct ContentionResult {
+  double pacer_time_ns;
+  double nack_time_ns;
+};
+
+// The pacer thread stores each packet and then takes it out to send it, as
+// RTPSender and the egress do for paced packets, while a NACK thread keeps
+// asking for retransmissions of recent packets. Returns the average time of
+// each pacer packet and of each retransmission request.
+ContentionResult MeasureContention(RtpPacketHistoryInterface* history) {
+  history->SetStorePacketsStatus(
+      RtpPacketHistoryInterface::StorageMode::kStoreAndCull, kNumToStore);
+  history->SetRtt(1);
+  std::atomic<int> newest_seq_no(-1);
+  std::atomic<bool> done(false);
+  int64_t nack_time_ns = 0;
+  int64_t nacks = 0;
+
+  std::thread nack_thread([&] {
+    std::mt19937 random(4711);
+    while (!done.load(std::memory_order_relaxed)) {
+      int newest = newest_seq_no.load(std::memory_order_relaxed);
+      if (newest < 0) {
+        continue;
+      }
+      uint16_t seq_no = static_cast<uint16_t>(
+          newest - std::uniform_int_distribution<int>(
+                       0, kNumToStore - 1)(random));
+      int64_t start_ns = rtc::TimeNanos();
+      if (history->GetPacketAndMarkAsPending(seq_no)) {
+        history->MarkPacketAsSent(seq_no);
+      }
+      nack_time_ns += rtc::TimeNanos() - start_ns;
+      ++nacks;
+    }
+  });
+
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+  packet->SetPayloadSize(kPayloadSize);
+  packet->set_allow_retransmission(true);
+  int64_t pacer_time_ns = 0;
+  for (int i = 0; i < kNumPackets; ++i) {
+    uint16_t seq_no = static_cast<uint16_t>(i);
+    auto copy = std::make_unique<RtpPacketToSend>(*packet);
+    copy->SetSequenceNumber(seq_no);
+    int64_t start_ns = rtc::TimeNanos();
+    history->PutRtpPacket(std::move(copy), absl::nullopt);
+    EXPECT_TRUE(history->GetPacketAndSetSendTime(seq_no));
+    pacer_time_ns += rtc::TimeNanos() - start_ns;
+    newest_seq_no.store(seq_no, std::memory_order_relaxed);
+  }
+  done.store(true);
+  nack_thread.join();
+
+  return {static_cast<double>(pacer_time_ns) / kNumPackets,
+          nacks > 0 ? static_cast<double>(nack_time_ns) / nacks : 0.0};
+}
+
+void PrintContentionResults(const std::string& name,
+                            RtpPacketHistoryInterface* history) {
+  ContentionResult result = MeasureContention(history);
+  test::PrintResult("packet_history_pacer_time", "", name,
+                    result.pacer_time_ns, "ns", false);
+  test::PrintResult("packet_history_nack_time", "", name, result.nack_time_ns,
+                    "ns", false);
+}
+
+TEST(RtpPacketHistoryPerformanceTest, PacerAndNackContention) {
+  Clock* clock = Clock::GetRealTimeClock();
+  RtpPacketHistory history(clock, /*enable_padding_prio=*/true);
+  RtpPacketRingHistory ring_history(clock, /*enable_padding_prio=*/true);
+  PrintContentionResults("locked", &history);
+  PrintContentionResults("ring", &ring_history);
+}
+
+}  // namespace
+}  // namespace webrtc
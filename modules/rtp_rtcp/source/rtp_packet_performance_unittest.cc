@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kRounds = 1000000;
+constexpr size_t kPayloadSize = 1100;
+
+// The extensions a video receiver typically negotiates.
+RtpHeaderExtensionMap CreateExtensions() {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransmissionOffset>(1);
+  extensions.Register<AbsoluteSendTime>(2);
+  extensions.Register<TransportSequenceNumber>(3);
+  extensions.Register<VideoOrientation>(4);
+  extensions.Register<PlayoutDelayLimits>(5);
+  extensions.Register<VideoContentTypeExtension>(6);
+  extensions.Register<VideoTimingExtension>(7);
+  return extensions;
+}
+
+// Returns a video packet with |kPayloadSize| bytes of payload, carrying the
+// extensions that are set on most packets if |with_extensions|.
+rtc::CopyOnWriteBuffer CreatePacket(const RtpHeaderExtensionMap& extensions,
+                                    bool with_extensions) {
+  RtpPacketToSend packet(&extensions);
+  packet.SetPayloadType(96);
+  packet.SetSequenceNumber(4321);
+  packet.SetTimestamp(0x12345678);
+  packet.SetSsrc(0x11223344);
+  if (with_extensions) {
+    packet.SetExtension<TransmissionOffset>(1234);
+    packet.SetExtension<AbsoluteSendTime>(0x123456);
+    packet.SetExtension<TransportSequenceNumber>(5678);
+  }
+  uint8_t* payload = packet.AllocatePayload(kPayloadSize);
+  for (size_t i = 0; i < kPayloadSize; ++i)
+    payload[i] = static_cast<uint8_t>(i);
+  return packet.Buffer();
+}
+
+// Returns the average time in nanoseconds to parse |buffer|, including
+// looking up the transport sequence number like the receive path does.
+double MeasureParseTimeNs(const RtpHeaderExtensionMap& extensions,
+                          const rtc::CopyOnWriteBuffer& buffer) {
+  RtpPacketReceived packet(&extensions);
+  int num_parsed = 0;
+  uint32_t checksum = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int round = 0; round < kRounds; ++round) {
+    if (packet.Parse(buffer))
+      ++num_parsed;
+    uint16_t transport_sequence_number = 0;
+    packet.GetExtension<TransportSequenceNumber>(&transport_sequence_number);
+    checksum += transport_sequence_number + packet.SequenceNumber();
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  EXPECT_EQ(num_parsed, kRounds);
+  EXPECT_GT(checksum, 0u);
+  return static_cast<double>(elapsed_ns) / kRounds;
+}
+
+void RunParseBenchmark(bool with_extensions) {
+  const RtpHeaderExtensionMap extensions = CreateExtensions();
+  test::PrintResult(
+      "rtp_packet_parse_time", "",
+      with_extensions ? "with_extensions" : "without_extensions",
+      MeasureParseTimeNs(extensions, CreatePacket(extensions, with_extensions)),
+      "ns", false);
+}
+
+TEST(RtpPacketPerformanceTest, ParseTimeWithoutExtensions) {
+  RunParseBenchmark(/*with_extensions=*/false);
+}
+
+TEST(RtpPacketPerformanceTest, ParseTimeWithExtensions) {
+  RunParseBenchmark(/*with_extensions=*/true);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,518 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_ring_history.h"
+
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+void YieldToReaders() {
+#if defined(WEBRTC_WIN)
+  ::Sleep(0);
+#else
+  sched_yield();
+#endif
+}
+
+}  // namespace
+
+constexpr size_t RtpPacketRingHistory::kRingSize;
+
+static_assert((RtpPacketRingHistory::kRingSize &
+               (RtpPacketRingHistory::kRingSize - 1)) == 0,
+              "Ring size must be a power of two.");
+static_assert(RtpPacketRingHistory::kRingSize >=
+                  RtpPacketHistoryInterface::kMaxCapacity,
+              "Ring must fit the max capacity.");
+
+RtpPacketRingHistory::PinnedSlot::PinnedSlot(
+    const RtpPacketRingHistory& history,
+    uint16_t sequence_number)
+    : slot_(nullptr) {
+  Slot* slots = history.slots();
+  if (slots == nullptr) {
+    return;
+  }
+  Slot* slot = &slots[sequence_number & (kRingSize - 1)];
+  uint32_t state = slot->state.load(std::memory_order_relaxed);
+  while (HoldsPacket(state, sequence_number) && !(state & kExclusive)) {
+    RTC_DCHECK_LT(state >> kReaderShift, (1u << (32 - kReaderShift)) - 1);
+    if (slot->state.compare_exchange_weak(state, state + kReaderIncrement,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed)) {
+      slot_ = slot;
+      return;
+    }
+  }
+}
+
+RtpPacketRingHistory::PinnedSlot::~PinnedSlot() {
+  if (slot_) {
+    slot_->state.fetch_sub(kReaderIncrement, std::memory_order_release);
+  }
+}
+
+RtpPacketRingHistory::RtpPacketRingHistory(Clock* clock,
+                                           bool enable_padding_prio)
+    : clock_(clock),
+      enable_padding_prio_(enable_padding_prio),
+      mode_(StorageMode::kDisabled),
+      rtt_ms_(-1),
+      slots_(nullptr),
+      number_to_store_(0),
+      first_(0),
+      end_(0),
+      memory_(MemoryCategory::kRtpPacketHistory) {}
+
+RtpPacketRingHistory::~RtpPacketRingHistory() = default;
+
+void RtpPacketRingHistory::SetStorePacketsStatus(StorageMode mode,
+                                                 size_t number_to_store) {
+  RTC_DCHECK_LE(number_to_store, kMaxCapacity);
+  rtc::CritScope cs(&lock_);
+  if (mode != StorageMode::kDisabled && mode_ != StorageMode::kDisabled) {
+    RTC_LOG(LS_WARNING) << "Purging packet history in order to re-set status.";
+  }
+  Reset();
+  if (mode != StorageMode::kDisabled && !ring_) {
+    ring_ = std::make_unique<Slot[]>(kRingSize);
+    slots_.store(ring_.get(), std::memory_order_release);
+  }
+  mode_ = mode;
+  number_to_store_ = std::min(kMaxCapacity, number_to_store);
+}
+
+RtpPacketRingHistory::StorageMode RtpPacketRingHistory::GetStorageMode()
+    const {
+  return mode_;
+}
+
+void RtpPacketRingHistory::SetRtt(int64_t rtt_ms) {
+  rtc::CritScope cs(&lock_);
+  RTC_DCHECK_GE(rtt_ms, 0);
+  rtt_ms_ = rtt_ms;
+  // If storage is not disabled,  packets will be removed after a timeout
+  // that depends on the RTT. Changing the RTT may thus cause some packets
+  // become "old" and subject to removal.
+  if (mode_ != StorageMode::kDisabled) {
+    CullOldPackets(clock_->TimeInMilliseconds());
+  }
+}
+
+void RtpPacketRingHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
+                                        absl::optional<int64_t> send_time_ms) {
+  RTC_DCHECK(packet);
+  rtc::CritScope cs(&lock_);
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (mode_ == StorageMode::kDisabled) {
+    return;
+  }
+
+  RTC_DCHECK(packet->allow_retransmission());
+  CullOldPackets(now_ms);
+
+  const uint16_t rtp_seq_no = packet->SequenceNumber();
+  const int64_t position = sequence_number_unwrapper_.Unwrap(rtp_seq_no);
+  if (first_ == end_) {
+    first_ = position;
+    end_ = position + 1;
+  } else if (position < first_) {
+    if (end_ - position > static_cast<int64_t>(kRingSize)) {
+      RTC_LOG(LS_WARNING) << "Packet too old to be stored: " << rtp_seq_no;
+      return;
+    }
+    first_ = position;
+  } else if (position >= end_) {
+    end_ = position + 1;
+    // Make room in the ring, the packets that would be overwritten are older
+    // than any packet RtpPacketHistory could have left after culling.
+    while (end_ - first_ > static_cast<int64_t>(kRingSize)) {
+      RemovePacket(first_, /*unless_pending=*/false);
+      ++first_;
+    }
+    SkipRemovedPackets();
+  } else if (RemovePacket(position, /*unless_pending=*/false)) {
+    // Remove previous packet to avoid inconsistent state. The new one takes
+    // its place, so |first_| stays valid.
+    RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
+  }
+
+  Slot& slot = SlotAt(position);
+  LockSlot(&slot);
+  memory_.Add(packet->capacity());
+  slot.packet = std::move(packet);
+  slot.send_time_ms.store(send_time_ms.value_or(kNoSendTime),
+                          std::memory_order_relaxed);
+  slot.times_retransmitted.store(0, std::memory_order_relaxed);
+  // No send time indicates packet is not sent immediately, but instead will
+  // be put in the pacer queue and later retrieved via
+  // GetPacketAndSetSendTime().
+  slot.state.store(rtp_seq_no | kStored | (send_time_ms ? 0 : kPending),
+                   std::memory_order_release);
+}
+
+std::unique_ptr<RtpPacketToSend> RtpPacketRingHistory::GetPacketAndSetSendTime(
+    uint16_t sequence_number) {
+  if (mode_ == StorageMode::kDisabled) {
+    return nullptr;
+  }
+
+  PinnedSlot slot(*this, sequence_number);
+  if (!slot) {
+    return nullptr;
+  }
+
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (!VerifyRtt(*slot, now_ms)) {
+    return nullptr;
+  }
+
+  if (slot->send_time_ms.load(std::memory_order_relaxed) != kNoSendTime) {
+    slot->times_retransmitted.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Update send-time and mark as no long in pacer queue.
+  slot->send_time_ms.store(now_ms, std::memory_order_relaxed);
+  slot->state.fetch_and(~kPending, std::memory_order_release);
+
+  // Return copy of packet instance since it may need to be retransmitted.
+  return std::make_unique<RtpPacketToSend>(*slot->packet);
+}
+
+std::unique_ptr<RtpPacketToSend>
+RtpPacketRingHistory::GetPacketAndMarkAsPending(
+    uint16_t sequence_number,
+    rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
+        encapsulate) {
+  if (mode_ == StorageMode::kDisabled) {
+    return nullptr;
+  }
+
+  PinnedSlot slot(*this, sequence_number);
+  if (!slot) {
+    return nullptr;
+  }
+
+  if (!VerifyRtt(*slot, clock_->TimeInMilliseconds())) {
+    // Packet already resent within too short a time window, ignore.
+    return nullptr;
+  }
+
+  // Claim the packet before encapsulating it, so that concurrent requests for
+  // the same packet do not both queue it.
+  if (slot->state.fetch_or(kPending, std::memory_order_acq_rel) & kPending) {
+    // Packet already in pacer queue, ignore this request.
+    return nullptr;
+  }
+
+  // Copy and/or encapsulate packet.
+  std::unique_ptr<RtpPacketToSend> encapsulated_packet =
+      encapsulate(*slot->packet);
+  if (!encapsulated_packet) {
+    slot->state.fetch_and(~kPending, std::memory_order_release);
+  }
+
+  return encapsulated_packet;
+}
+
+void RtpPacketRingHistory::MarkPacketAsSent(uint16_t sequence_number) {
+  if (mode_ == StorageMode::kDisabled) {
+    return;
+  }
+
+  PinnedSlot slot(*this, sequence_number);
+  if (!slot) {
+    return;
+  }
+
+  RTC_DCHECK_NE(slot->send_time_ms.load(std::memory_order_relaxed),
+                kNoSendTime);
+
+  // Update send-time, mark as no longer in pacer queue, and increment
+  // transmission count.
+  slot->send_time_ms.store(clock_->TimeInMilliseconds(),
+                           std::memory_order_relaxed);
+  slot->times_retransmitted.fetch_add(1, std::memory_order_relaxed);
+  slot->state.fetch_and(~kPending, std::memory_order_release);
+}
+
+absl::optional<RtpPacketHistoryInterface::PacketState>
+RtpPacketRingHistory::GetPacketState(uint16_t sequence_number) const {
+  if (mode_ == StorageMode::kDisabled) {
+    return absl::nullopt;
+  }
+
+  PinnedSlot slot(*this, sequence_number);
+  if (!slot) {
+    return absl::nullopt;
+  }
+
+  if (!VerifyRtt(*slot, clock_->TimeInMilliseconds())) {
+    return absl::nullopt;
+  }
+
+  return SlotToPacketState(*slot,
+                           slot->state.load(std::memory_order_acquire));
+}
+
+std::unique_ptr<RtpPacketToSend> RtpPacketRingHistory::GetPayloadPaddingPacket(
+    rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
+        encapsulate) {
+  rtc::CritScope cs(&lock_);
+  if (mode_ == StorageMode::kDisabled) {
+    return nullptr;
+  }
+
+  // Without prioritization pick the last packet, otherwise the one least
+  // retransmitted among the last ones, preferring newer packets.
+  absl::optional<uint16_t> best_sequence_number;
+  uint32_t best_times_retransmitted = 0;
+  size_t candidates = 0;
+  for (int64_t position = end_ - 1;
+       position >= first_ && candidates < kMaxPaddingtHistory - 1;
+       --position) {
+    const uint16_t sequence_number = static_cast<uint16_t>(position);
+    const Slot& slot = SlotAt(position);
+    if (!HoldsPacket(slot.state.load(std::memory_order_acquire),
+                     sequence_number)) {
+      continue;
+    }
+    ++candidates;
+    uint32_t times_retransmitted =
+        slot.times_retransmitted.load(std::memory_order_relaxed);
+    if (!best_sequence_number ||
+        times_retransmitted < best_times_retransmitted) {
+      best_sequence_number = sequence_number;
+      best_times_retransmitted = times_retransmitted;
+    }
+    if (!enable_padding_prio_ || times_retransmitted == 0) {
+      break;
+    }
+  }
+  if (!best_sequence_number) {
+    return nullptr;
+  }
+
+  PinnedSlot slot(*this, *best_sequence_number);
+  RTC_DCHECK(slot);
+  if (slot->state.load(std::memory_order_acquire) & kPending) {
+    // Because PacedSender releases it's lock when it calls
+    // GeneratePadding() there is the potential for a race where a new
+    // packet ends up here instead of the regular transmit path. In such a
+    // case, just return empty and it will be picked up on the next
+    // Process() call.
+    return nullptr;
+  }
+
+  auto padding_packet = encapsulate(*slot->packet);
+  if (!padding_packet) {
+    return nullptr;
+  }
+
+  slot->send_time_ms.store(clock_->TimeInMilliseconds(),
+                           std::memory_order_relaxed);
+  slot->times_retransmitted.fetch_add(1, std::memory_order_relaxed);
+
+  return padding_packet;
+}
+
+void RtpPacketRingHistory::CullAcknowledgedPackets(
+    rtc::ArrayView<const uint16_t> sequence_numbers) {
+  rtc::CritScope cs(&lock_);
+  if (first_ == end_) {
+    return;
+  }
+  for (uint16_t sequence_number : sequence_numbers) {
+    // Find the position in the stored range that has this sequence number.
+    int64_t position =
+        end_ - 1 - static_cast<uint16_t>(static_cast<uint16_t>(end_ - 1) -
+                                         sequence_number);
+    if (position >= first_) {
+      RemovePacket(position, /*unless_pending=*/false);
+    }
+  }
+  SkipRemovedPackets();
+}
+
+bool RtpPacketRingHistory::SetPendingTransmission(uint16_t sequence_number) {
+  if (mode_ == StorageMode::kDisabled) {
+    return false;
+  }
+
+  PinnedSlot slot(*this, sequence_number);
+  if (!slot) {
+    return false;
+  }
+
+  slot->state.fetch_or(kPending, std::memory_order_acq_rel);
+  return true;
+}
+
+void RtpPacketRingHistory::Clear() {
+  rtc::CritScope cs(&lock_);
+  Reset();
+}
+
+RtpPacketRingHistory::Slot& RtpPacketRingHistory::SlotAt(
+    int64_t position) const {
+  return slots()[position & (kRingSize - 1)];
+}
+
+bool RtpPacketRingHistory::HoldsPacket(uint32_t state,
+                                       uint16_t sequence_number) {
+  return (state & kStored) && (state & kSequenceNumberMask) == sequence_number;
+}
+
+bool RtpPacketRingHistory::VerifyRtt(const Slot& slot, int64_t now_ms) const {
+  int64_t send_time_ms = slot.send_time_ms.load(std::memory_order_relaxed);
+  if (send_time_ms != kNoSendTime) {
+    // Send-time already set, this check must be for a retransmission.
+    if (slot.times_retransmitted.load(std::memory_order_relaxed) > 0 &&
+        now_ms < send_time_ms + rtt_ms_) {
+      // This packet has already been retransmitted once, and the time since
+      // that even is lower than on RTT. Ignore request as this packet is
+      // likely already in the network pipe.
+      return false;
+    }
+  }
+
+  return true;
+}
+
+RtpPacketHistoryInterface::PacketState RtpPacketRingHistory::SlotToPacketState(
+    const Slot& slot,
+    uint32_t state) {
+  PacketState packet_state;
+  packet_state.rtp_sequence_number = slot.packet->SequenceNumber();
+  int64_t send_time_ms = slot.send_time_ms.load(std::memory_order_relaxed);
+  if (send_time_ms != kNoSendTime) {
+    packet_state.send_time_ms = send_time_ms;
+  }
+  packet_state.capture_time_ms = slot.packet->capture_time_ms();
+  packet_state.ssrc = slot.packet->Ssrc();
+  packet_state.packet_size = slot.packet->size();
+  packet_state.times_retransmitted =
+      slot.times_retransmitted.load(std::memory_order_relaxed);
+  packet_state.pending_transmission = (state & kPending) != 0;
+  packet_state.is_key_frame = slot.packet->is_key_frame();
+  return packet_state;
+}
+
+uint32_t RtpPacketRingHistory::LockSlot(Slot* slot) {
+  uint32_t state = slot->state.load(std::memory_order_relaxed);
+  while (true) {
+    RTC_DCHECK(!(state & kExclusive));
+    if ((state >> kReaderShift) != 0) {
+      // Readers only copy the packet, wait for them to be done.
+      YieldToReaders();
+      state = slot->state.load(std::memory_order_relaxed);
+    } else if (slot->state.compare_exchange_weak(state, state | kExclusive,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+      return state;
+    }
+  }
+}
+
+bool RtpPacketRingHistory::RemovePacket(int64_t position, bool unless_pending) {
+  const uint16_t sequence_number = static_cast<uint16_t>(position);
+  Slot& slot = SlotAt(position);
+  if (!HoldsPacket(slot.state.load(std::memory_order_relaxed),
+                   sequence_number)) {
+    return false;
+  }
+  uint32_t state = LockSlot(&slot);
+  if (unless_pending && (state & kPending)) {
+    // Queued for retransmission since it was checked, keep it.
+    slot.state.store(state, std::memory_order_release);
+    return false;
+  }
+  std::unique_ptr<RtpPacketToSend> packet = std::move(slot.packet);
+  memory_.Subtract(packet->capacity());
+  slot.send_time_ms.store(kNoSendTime, std::memory_order_relaxed);
+  slot.times_retransmitted.store(0, std::memory_order_relaxed);
+  slot.state.store(0, std::memory_order_release);
+  return true;
+}
+
+void RtpPacketRingHistory::SkipRemovedPackets() {
+  while (first_ < end_ &&
+         !HoldsPacket(SlotAt(first_).state.load(std::memory_order_relaxed),
+                      static_cast<uint16_t>(first_))) {
+    ++first_;
+  }
+}
+
+void RtpPacketRingHistory::Reset() {
+  for (int64_t position = first_; position < end_; ++position) {
+    RemovePacket(position, /*unless_pending=*/false);
+  }
+  first_ = 0;
+  end_ = 0;
+  sequence_number_unwrapper_ = SeqNumUnwrapper<uint16_t>();
+}
+
+void RtpPacketRingHistory::CullOldPackets(int64_t now_ms) {
+  int64_t packet_duration_ms =
+      std::max(kMinPacketDurationRtt * rtt_ms_, kMinPacketDurationMs);
+  while (first_ < end_) {
+    if (end_ - first_ >= static_cast<int64_t>(kMaxCapacity)) {
+      // We have reached the absolute max capacity, remove one packet
+      // unconditionally.
+      RemovePacket(first_, /*unless_pending=*/false);
+      SkipRemovedPackets();
+      continue;
+    }
+
+    const Slot& slot = SlotAt(first_);
+    if (slot.state.load(std::memory_order_acquire) & kPending) {
+      // Don't remove packets in the pacer queue, pending tranmission.
+      return;
+    }
+
+    int64_t send_time_ms = slot.send_time_ms.load(std::memory_order_relaxed);
+    if (send_time_ms == kNoSendTime ||
+        send_time_ms + packet_duration_ms > now_ms) {
+      // Don't cull packets too early to avoid failed retransmission requests.
+      return;
+    }
+
+    if (end_ - first_ >= static_cast<int64_t>(number_to_store_) ||
+        send_time_ms + (packet_duration_ms * kPacketCullingDelayFactor) <=
+            now_ms) {
+      // Too many packets in history, or this packet has timed out. Remove it
+      // and continue.
+      if (!RemovePacket(first_, /*unless_pending=*/true)) {
+        return;
+      }
+      SkipRemovedPackets();
+    } else {
+      // No more packets can be removed right now.
+      return;
+    }
+  }
+}
+
+}  // namespace webrtc
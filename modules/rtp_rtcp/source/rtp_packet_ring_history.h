@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_RING_HISTORY_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_RING_HISTORY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/function_view.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history_interface.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/memory/memory_accounting.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+class RtpPacketToSend;
+
+// Packet history stored in a ring of slots indexed by sequence number, with
+// the same behavior as RtpPacketHistory except that payload padding is picked
+// among the last kMaxPaddingtHistory - 1 stored packets, rather than from a
+// set sorted at insert time.
+// Lookups by sequence number, i.e. the NACK path and the pacer marking packets
+// as sent, take no lock. They pin the slot through an atomic state word,
+// which also holds the pending transmission flag, so they only ever wait for
+// each other on the same packet. Operations that add or remove packets, and
+// picking padding, are serialized by a lock and wait for the few readers of
+// a slot before changing it.
+class RtpPacketRingHistory : public RtpPacketHistoryInterface {
+ public:
+  // Power of two that fits kMaxCapacity packets.
+  static constexpr size_t kRingSize = 16384;
+
+  RtpPacketRingHistory(Clock* clock, bool enable_padding_prio);
+  ~RtpPacketRingHistory() override;
+
+  using RtpPacketHistoryInterface::GetPacketAndMarkAsPending;
+  using RtpPacketHistoryInterface::GetPayloadPaddingPacket;
+
+  void SetStorePacketsStatus(StorageMode mode, size_t number_to_store) override;
+  StorageMode GetStorageMode() const override;
+  void SetRtt(int64_t rtt_ms) override;
+  void PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
+                    absl::optional<int64_t> send_time_ms) override;
+  std::unique_ptr<RtpPacketToSend> GetPacketAndSetSendTime(
+      uint16_t sequence_number) override;
+  std::unique_ptr<RtpPacketToSend> GetPacketAndMarkAsPending(
+      uint16_t sequence_number,
+      rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
+          const RtpPacketToSend&)> encapsulate) override;
+  void MarkPacketAsSent(uint16_t sequence_number) override;
+  absl::optional<PacketState> GetPacketState(
+      uint16_t sequence_number) const override;
+  std::unique_ptr<RtpPacketToSend> GetPayloadPaddingPacket(
+      rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
+          const RtpPacketToSend&)> encapsulate) override;
+  void CullAcknowledgedPackets(
+      rtc::ArrayView<const uint16_t> sequence_numbers) override;
+  bool SetPendingTransmission(uint16_t sequence_number) override;
+  void Clear() override;
+
+ private:
+  // Layout of Slot::state. The low bits hold the sequence number of the
+  // stored packet and the high bits the number of readers pinning the slot.
+  static constexpr uint32_t kSequenceNumberMask = 0xFFFF;
+  static constexpr uint32_t kStored = 1u << 16;
+  static constexpr uint32_t kPending = 1u << 17;
+  static constexpr uint32_t kExclusive = 1u << 18;
+  static constexpr int kReaderShift = 19;
+  static constexpr uint32_t kReaderIncrement = 1u << kReaderShift;
+  static constexpr int64_t kNoSendTime = -1;
+
+  struct Slot {
+    std::atomic<uint32_t> state{0};
+    // The time of last transmission, including retransmissions.
+    std::atomic<int64_t> send_time_ms{kNoSendTime};
+    // Number of times RE-transmitted, ie excluding the first transmission.
+    std::atomic<uint32_t> times_retransmitted{0};
+    // Only changed while the writer holds kExclusive, so it may be read by
+    // anyone who has pinned the slot.
+    std::unique_ptr<RtpPacketToSend> packet;
+  };
+
+  // Reader access to the slot holding a given packet, if it is stored.
+  class PinnedSlot {
+   public:
+    PinnedSlot(const RtpPacketRingHistory& history, uint16_t sequence_number);
+    ~PinnedSlot();
+
+    explicit operator bool() const { return slot_ != nullptr; }
+    Slot& operator*() const { return *slot_; }
+    Slot* operator->() const { return slot_; }
+
+   private:
+    Slot* slot_;
+
+    RTC_DISALLOW_COPY_AND_ASSIGN(PinnedSlot);
+  };
+
+  Slot* slots() const { return slots_.load(std::memory_order_acquire); }
+  Slot& SlotAt(int64_t position) const;
+  static bool HoldsPacket(uint32_t state, uint16_t sequence_number);
+  bool VerifyRtt(const Slot& slot, int64_t now_ms) const;
+  static PacketState SlotToPacketState(const Slot& slot, uint32_t state);
+
+  // Waits for readers of |slot| and locks it for writing; Returns the state
+  // from before it was locked.
+  static uint32_t LockSlot(Slot* slot);
+  // Removes the packet at |position|, if stored. With |unless_pending| the
+  // packet is kept if it is pending transmission.
+  bool RemovePacket(int64_t position, bool unless_pending)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Moves |first_| past removed packets.
+  void SkipRemovedPackets() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void CullOldPackets(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  Clock* const clock_;
+  const bool enable_padding_prio_;
+  std::atomic<StorageMode> mode_;
+  std::atomic<int64_t> rtt_ms_;
+
+  rtc::CriticalSection lock_;
+  // Allocated once storage is first enabled, then kept until destruction.
+  std::unique_ptr<Slot[]> ring_ RTC_GUARDED_BY(lock_);
+  // Points into |ring_|, for the lookups that take no lock.
+  std::atomic<Slot*> slots_;
+  size_t number_to_store_ RTC_GUARDED_BY(lock_);
+  SeqNumUnwrapper<uint16_t> sequence_number_unwrapper_ RTC_GUARDED_BY(lock_);
+  // Unwrapped sequence numbers of the stored packets are in [first_, end_),
+  // with the packet at |first_| always stored if the range is non-empty.
+  int64_t first_ RTC_GUARDED_BY(lock_);
+  int64_t end_ RTC_GUARDED_BY(lock_);
+  TrackedMemory memory_ RTC_GUARDED_BY(lock_);
+
+  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketRingHistory);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKET_RING_HISTORY_H_
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_ring_history.h"
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using StorageMode = RtpPacketHistoryInterface::StorageMode;
+
+// Set a high sequence number so we'll suffer a wrap-around.
+constexpr uint16_t kStartSeqNum = 65534u;
+
+std::unique_ptr<RtpPacketToSend> CreateRtpPacket(uint16_t seq_num) {
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+  packet->SetSequenceNumber(seq_num);
+  packet->set_allow_retransmission(true);
+  return packet;
+}
+
+std::unique_ptr<RtpPacketToSend> CopyPacket(const RtpPacketToSend& packet) {
+  return std::make_unique<RtpPacketToSend>(packet);
+}
+
+class RtpPacketRingHistoryTest : public ::testing::TestWithParam<bool> {
+ protected:
+  RtpPacketRingHistoryTest()
+      : fake_clock_(123456),
+        hist_(&fake_clock_, /*enable_padding_prio=*/GetParam()) {}
+
+  SimulatedClock fake_clock_;
+  RtpPacketRingHistory hist_;
+};
+
+TEST_P(RtpPacketRingHistoryTest, KeepsPacketsAcrossRingWrap) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull,
+                              RtpPacketHistoryInterface::kMaxCapacity);
+  hist_.SetRtt(1);
+  // Send more packets than fit the ring, acknowledging them as we go, so
+  // that slots are reused for new sequence numbers.
+  const int kNumPackets = 3 * RtpPacketRingHistory::kRingSize;
+  for (int i = 0; i < kNumPackets; ++i) {
+    uint16_t seq_no = static_cast<uint16_t>(kStartSeqNum + i);
+    hist_.PutRtpPacket(CreateRtpPacket(seq_no),
+                       fake_clock_.TimeInMilliseconds());
+    if (i >= 100) {
+      uint16_t acked = static_cast<uint16_t>(seq_no - 100);
+      hist_.CullAcknowledgedPackets(rtc::ArrayView<const uint16_t>(&acked, 1));
+      EXPECT_FALSE(hist_.GetPacketState(acked));
+    }
+    absl::optional<RtpPacketHistoryInterface::PacketState> state =
+        hist_.GetPacketState(seq_no);
+    ASSERT_TRUE(state);
+    EXPECT_EQ(state->rtp_sequence_number, seq_no);
+  }
+  // A sequence number mapping to the same slot as a stored packet is not
+  // mistaken for it.
+  uint16_t last = static_cast<uint16_t>(kStartSeqNum + kNumPackets - 1);
+  EXPECT_FALSE(hist_.GetPacketState(
+      static_cast<uint16_t>(last - RtpPacketRingHistory::kRingSize)));
+}
+
+TEST_P(RtpPacketRingHistoryTest, OnlyOneConcurrentRequestQueuesPacket) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum),
+                     fake_clock_.TimeInMilliseconds());
+
+  // Encapsulating the packet asks for it again, as if another thread's NACK
+  // arrived meanwhile. Only the outer request may queue the packet.
+  bool nested_request_queued = true;
+  std::unique_ptr<RtpPacketToSend> packet = hist_.GetPacketAndMarkAsPending(
+      kStartSeqNum, [&](const RtpPacketToSend& packet) {
+        nested_request_queued =
+            hist_.GetPacketAndMarkAsPending(kStartSeqNum) != nullptr;
+        return CopyPacket(packet);
+      });
+  EXPECT_TRUE(packet);
+  EXPECT_FALSE(nested_request_queued);
+  EXPECT_TRUE(hist_.GetPacketState(kStartSeqNum)->pending_transmission);
+}
+
+TEST_P(RtpPacketRingHistoryTest, ClearsPendingIfEncapsulationFails) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum),
+                     fake_clock_.TimeInMilliseconds());
+  EXPECT_FALSE(hist_.GetPacketAndMarkAsPending(
+      kStartSeqNum, [](const RtpPacketToSend&) {
+        return std::unique_ptr<RtpPacketToSend>();
+      }));
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum)->pending_transmission);
+  EXPECT_TRUE(hist_.GetPacketAndMarkAsPending(kStartSeqNum));
+}
+
+TEST_P(RtpPacketRingHistoryTest, ConcurrentNacksWhileStoringPackets) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 600);
+  std::atomic<int> newest_seq_no(-1);
+  std::atomic<bool> done(false);
+
+  // Retransmission requests for recent packets race with the pacer thread
+  // storing, sending and culling packets.
+  std::thread nack_thread([&] {
+    std::mt19937 random(4711);
+    while (!done.load()) {
+      int newest = newest_seq_no.load();
+      if (newest < 0) {
+        continue;
+      }
+      uint16_t seq_no = static_cast<uint16_t>(
+          newest - std::uniform_int_distribution<int>(0, 1000)(random));
+      std::unique_ptr<RtpPacketToSend> packet =
+          hist_.GetPacketAndMarkAsPending(seq_no);
+      if (packet) {
+        EXPECT_EQ(packet->SequenceNumber(), seq_no);
+        hist_.MarkPacketAsSent(seq_no);
+      }
+    }
+  });
+
+  for (int i = 0; i < 20000; ++i) {
+    uint16_t seq_no = static_cast<uint16_t>(kStartSeqNum + i);
+    hist_.PutRtpPacket(CreateRtpPacket(seq_no), absl::nullopt);
+    std::unique_ptr<RtpPacketToSend> packet =
+        hist_.GetPacketAndSetSendTime(seq_no);
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(packet->SequenceNumber(), seq_no);
+    newest_seq_no.store(seq_no);
+    fake_clock_.AdvanceTimeMilliseconds(1);
+  }
+  done.store(true);
+  nack_thread.join();
+}
+
+// Drives both histories with the same random operations and expects the same
+// answers, except for payload padding which is picked differently.
+TEST_P(RtpPacketRingHistoryTest, MatchesRtpPacketHistory) {
+  std::mt19937 random(4711);
+  RtpPacketHistory expected(&fake_clock_, GetParam());
+  expected.SetStorePacketsStatus(StorageMode::kStoreAndCull, 200);
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 200);
+  uint16_t next_seq_no = kStartSeqNum;
+
+  for (int i = 0; i < 50000; ++i) {
+    int action = std::uniform_int_distribution<int>(0, 99)(random);
+    uint16_t seq_no = static_cast<uint16_t>(
+        next_seq_no - std::uniform_int_distribution<int>(1, 300)(random));
+    if (action < 30) {
+      absl::optional<int64_t> send_time_ms;
+      if (action < 20) {
+        send_time_ms = fake_clock_.TimeInMilliseconds();
+      }
+      expected.PutRtpPacket(CreateRtpPacket(next_seq_no), send_time_ms);
+      hist_.PutRtpPacket(CreateRtpPacket(next_seq_no), send_time_ms);
+      ++next_seq_no;
+    } else if (action < 45) {
+      std::unique_ptr<RtpPacketToSend> expected_packet =
+          expected.GetPacketAndSetSendTime(seq_no);
+      std::unique_ptr<RtpPacketToSend> packet =
+          hist_.GetPacketAndSetSendTime(seq_no);
+      ASSERT_EQ(packet != nullptr, expected_packet != nullptr) << "at " << i;
+    } else if (action < 60) {
+      std::unique_ptr<RtpPacketToSend> expected_packet =
+          expected.GetPacketAndMarkAsPending(seq_no);
+      std::unique_ptr<RtpPacketToSend> packet =
+          hist_.GetPacketAndMarkAsPending(seq_no);
+      ASSERT_EQ(packet != nullptr, expected_packet != nullptr) << "at " << i;
+    } else if (action < 70) {
+      if (expected.GetPacketState(seq_no) &&
+          expected.GetPacketState(seq_no)->send_time_ms) {
+        expected.MarkPacketAsSent(seq_no);
+        hist_.MarkPacketAsSent(seq_no);
+      }
+    } else if (action < 75) {
+      ASSERT_EQ(hist_.SetPendingTransmission(seq_no),
+                expected.SetPendingTransmission(seq_no))
+          << "at " << i;
+    } else if (action < 80) {
+      std::vector<uint16_t> acked;
+      for (int j = 0; j < 5; ++j) {
+        acked.push_back(static_cast<uint16_t>(seq_no + j));
+      }
+      expected.CullAcknowledgedPackets(acked);
+      hist_.CullAcknowledgedPackets(acked);
+    } else if (action < 82) {
+      int64_t rtt_ms = std::uniform_int_distribution<int>(1, 200)(random);
+      expected.SetRtt(rtt_ms);
+      hist_.SetRtt(rtt_ms);
+    } else {
+      fake_clock_.AdvanceTimeMilliseconds(
+          std::uniform_int_distribution<int>(0, 10)(random));
+    }
+
+    // Compare the state of the packet touched and the newest one.
+    for (uint16_t check : {seq_no, static_cast<uint16_t>(next_seq_no - 1)}) {
+      absl::optional<RtpPacketHistoryInterface::PacketState> expected_state =
+          expected.GetPacketState(check);
+      absl::optional<RtpPacketHistoryInterface::PacketState> state =
+          hist_.GetPacketState(check);
+      ASSERT_EQ(state.has_value(), expected_state.has_value()) << "at " << i;
+      if (state) {
+        EXPECT_EQ(state->send_time_ms, expected_state->send_time_ms);
+        EXPECT_EQ(state->times_retransmitted,
+                  expected_state->times_retransmitted);
+        EXPECT_EQ(state->pending_transmission,
+                  expected_state->pending_transmission);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(WithAndWithoutPaddingPrio,
+                         RtpPacketRingHistoryTest,
+                         ::testing::Bool());
+
+}  // namespace
+}  // namespace webrtc
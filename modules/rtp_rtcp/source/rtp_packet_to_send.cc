@@ -11,6 +11,7 @@
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 
 #include <cstdint>
+#include <utility>
 
 namespace webrtc {
 
@@ -19,6 +20,12 @@ RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions)
 RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions,
                                  size_t capacity)
     : RtpPacket(extensions, capacity) {}
+RtpPacketToSend::RtpPacketToSend(
+    const ExtensionManager* extensions,
+    size_t capacity,
+    rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool)
+    : RtpPacket(extensions, buffer_pool->GetBuffer(capacity)),
+      buffer_pool_(std::move(buffer_pool)) {}
 RtpPacketToSend::RtpPacketToSend(const RtpPacketToSend& packet) = default;
 RtpPacketToSend::RtpPacketToSend(RtpPacketToSend&& packet) = default;
 
@@ -26,6 +33,20 @@ RtpPacketToSend& RtpPacketToSend::operator=(const RtpPacketToSend& packet) =
     default;
 RtpPacketToSend& RtpPacketToSend::operator=(RtpPacketToSend&& packet) = default;
 
-RtpPacketToSend::~RtpPacketToSend() = default;
+RtpPacketToSend::~RtpPacketToSend() {
+  if (buffer_pool_) {
+    buffer_pool_->ReturnBuffer(std::move(mutable_buffer()));
+  }
+}
+
+void RtpPacketToSend::UnshareBuffer() {
+  rtc::CopyOnWriteBuffer& buffer = mutable_buffer();
+  if (!buffer_pool_ || !buffer.IsShared()) {
+    return;
+  }
+  rtc::CopyOnWriteBuffer unshared = buffer_pool_->GetBuffer(buffer.capacity());
+  unshared.SetData(buffer.cdata(), buffer.size());
+  buffer = std::move(unshared);
+}
 
 }  // namespace webrtc
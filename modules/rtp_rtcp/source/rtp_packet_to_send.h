@@ -17,10 +17,12 @@
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/scoped_refptr.h"
 #include "api/video/video_timing.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
 
 namespace webrtc {
 // Class to hold rtp packet with metadata for sender side.
@@ -31,6 +33,11 @@ class RtpPacketToSend : public RtpPacket {
 
   explicit RtpPacketToSend(const ExtensionManager* extensions);
   RtpPacketToSend(const ExtensionManager* extensions, size_t capacity);
+  // Takes the buffer from |buffer_pool| and gives it back when destroyed. So do
+  // copies of the packet, the last one to release the buffer returns it.
+  RtpPacketToSend(const ExtensionManager* extensions,
+                  size_t capacity,
+                  rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool);
   RtpPacketToSend(const RtpPacketToSend& packet);
   RtpPacketToSend(RtpPacketToSend&& packet);
 
@@ -108,6 +115,21 @@ class RtpPacketToSend : public RtpPacket {
   void set_is_key_frame(bool is_key_frame) { is_key_frame_ = is_key_frame; }
   bool is_key_frame() const { return is_key_frame_; }
 
+  // Indicates if the packet is sent as part of a burst from the pacer, and if
+  // it is the last packet of that burst.
+  void set_batchable(bool batchable) { batchable_ = batchable; }
+  bool batchable() const { return batchable_; }
+  void set_last_packet_in_batch(bool last_packet_in_batch) {
+    last_packet_in_batch_ = last_packet_in_batch;
+  }
+  bool last_packet_in_batch() const { return last_packet_in_batch_; }
+
+  // If the buffer is shared with other packets, e.g. because this packet was
+  // copied from a template, moves the data to a buffer from the pool, so that
+  // writing to the packet does not allocate a new one. No-op for packets not
+  // created with a pool.
+  void UnshareBuffer();
+
  private:
   int64_t capture_time_ms_ = 0;
   absl::optional<RtpPacketMediaType> packet_type_;
@@ -116,6 +138,9 @@ class RtpPacketToSend : public RtpPacket {
   std::vector<uint8_t> application_data_;
   bool is_first_packet_of_frame_ = false;
   bool is_key_frame_ = false;
+  bool batchable_ = false;
+  bool last_packet_in_batch_ = false;
+  rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool_;
 };
 
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/random.h"
+#include "rtc_base/ref_counted_object.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -700,6 +701,64 @@ TEST(RtpPacketTest, ParseWithExtensionDelayed) {
   EXPECT_EQ(0u, packet.padding_size());
 }
 
+TEST(RtpPacketTest, ParseWithExtensionsReidentified) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  RtpPacketReceived packet(&extensions);
+  EXPECT_TRUE(packet.Parse(kPacketWithTOAndAL, sizeof(kPacketWithTOAndAL)));
+  EXPECT_TRUE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_FALSE(packet.HasExtension<AudioLevel>());
+
+  // Map the id of the transmission offset to another type.
+  RtpPacketToSend::ExtensionManager other_extensions;
+  other_extensions.Register<AudioLevel>(kTransmissionOffsetExtensionId);
+  packet.IdentifyExtensions(other_extensions);
+  EXPECT_FALSE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_TRUE(packet.HasExtension<AudioLevel>());
+  EXPECT_EQ(packet.GetRawExtension<AudioLevel>().size(), 3u);
+}
+
+TEST(RtpPacketTest, CopyHeaderPreservesExtensionLookup) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  RtpPacketReceived packet(&extensions);
+  EXPECT_TRUE(packet.Parse(kPacketWithTOAndAL, sizeof(kPacketWithTOAndAL)));
+
+  RtpPacketToSend copy(nullptr);
+  copy.CopyHeaderFrom(packet);
+  EXPECT_EQ(copy.GetExtension<TransmissionOffset>(), kTimeOffset);
+  EXPECT_TRUE(copy.HasExtension<AudioLevel>());
+}
+
+TEST(RtpPacketTest, ParseMoreExtensionsThanStoredInline) {
+  // Two-byte header extensions with ids 1 to 32, each with a single byte
+  // value equal to the id, and the transmission offset registered last.
+  constexpr int kNumExtensions = 32;
+  std::vector<uint8_t> buffer(std::begin(kMinimumPacket),
+                              std::end(kMinimumPacket));
+  buffer[0] |= 0x10;
+  const size_t extensions_size = (kNumExtensions - 1) * 3 + 5;
+  const size_t extensions_words = (extensions_size + 3) / 4;
+  buffer.insert(buffer.end(),
+                {0x10, 0x00, 0x00, static_cast<uint8_t>(extensions_words)});
+  for (int id = 1; id < kNumExtensions; ++id) {
+    buffer.insert(buffer.end(), {static_cast<uint8_t>(id), 0x01,
+                                  static_cast<uint8_t>(id)});
+  }
+  buffer.insert(buffer.end(), {kNumExtensions, 0x03, 0x00, 0x56, 0xce});
+  buffer.resize(sizeof(kMinimumPacket) + 4 + extensions_words * 4);
+
+  RtpPacketToSend::ExtensionManager extensions(/*extmap_allow_mixed=*/true);
+  extensions.Register<TransmissionOffset>(kNumExtensions);
+  extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  RtpPacketReceived packet(&extensions);
+  ASSERT_TRUE(packet.Parse(buffer.data(), buffer.size()));
+  EXPECT_EQ(packet.GetExtension<TransmissionOffset>(), kTimeOffset);
+  EXPECT_THAT(packet.GetRawExtension<AudioLevel>(),
+              ElementsAre(kAudioLevelExtensionId));
+}
+
 TEST(RtpPacketTest, ParseDynamicSizeExtension) {
   // clang-format off
   const uint8_t kPacket1[] = {
@@ -1141,5 +1200,67 @@ TEST(RtpPacketTest, RemoveExtensionFailure) {
   EXPECT_THAT(kPacketWithTO, ElementsAreArray(packet.data(), packet.size()));
 }
 
+// The owner of the payload views, holding the viewed bytes.
+class PayloadOwner : public rtc::RefCountInterface {
+ public:
+  explicit PayloadOwner(rtc::ArrayView<const uint8_t> data)
+      : data_(data.data(), data.size()) {}
+  const rtc::Buffer& data() const { return data_; }
+
+ private:
+  const rtc::Buffer data_;
+};
+
+TEST(RtpPacketTest, GathersPayloadViewWithoutMergingIt) {
+  const uint8_t kPayload[] = {0x11, 0x22, 0x33, 0x44};
+  rtc::scoped_refptr<rtc::RefCountedObject<PayloadOwner>> owner(
+      new rtc::RefCountedObject<PayloadOwner>(kPayload));
+  RtpPacketToSend packet(nullptr);
+  packet.SetSsrc(kSsrc);
+  uint8_t* prefix = packet.AllocatePayloadWithView(2, owner->data(), owner);
+  ASSERT_TRUE(prefix);
+  prefix[0] = 0x7c;
+  prefix[1] = 0x85;
+  EXPECT_EQ(sizeof(kMinimumPacket) + 2 + sizeof(kPayload), packet.size());
+
+  rtc::CopyOnWriteBuffer gathered = packet.GatherBuffer();
+  EXPECT_EQ(packet.capacity(), gathered.capacity());
+  EXPECT_FALSE(gathered.IsShared());
+  EXPECT_THAT(rtc::MakeArrayView(gathered.cdata(), gathered.size())
+                  .subview(sizeof(kMinimumPacket)),
+              ElementsAre(0x7c, 0x85, 0x11, 0x22, 0x33, 0x44));
+  // Still viewed by the packet.
+  EXPECT_FALSE(owner->HasOneRef());
+
+  EXPECT_THAT(packet.payload(),
+              ElementsAre(0x7c, 0x85, 0x11, 0x22, 0x33, 0x44));
+  EXPECT_TRUE(owner->HasOneRef());
+  EXPECT_EQ(gathered, packet.Buffer());
+}
+
+TEST(RtpPacketTest, ReturnsPayloadViewWithoutPrefix) {
+  const uint8_t kPayload[] = {0x11, 0x22, 0x33};
+  rtc::scoped_refptr<rtc::RefCountedObject<PayloadOwner>> owner(
+      new rtc::RefCountedObject<PayloadOwner>(kPayload));
+  RtpPacketToSend packet(nullptr);
+  ASSERT_TRUE(packet.AllocatePayloadWithView(0, owner->data(), owner));
+
+  EXPECT_EQ(owner->data().data(), packet.payload().data());
+  EXPECT_EQ(sizeof(kPayload), packet.payload_size());
+  EXPECT_FALSE(owner->HasOneRef());
+  // Setting the padding merges the payload.
+  EXPECT_TRUE(packet.SetPadding(4));
+  EXPECT_TRUE(owner->HasOneRef());
+  EXPECT_THAT(packet.payload(), ElementsAre(0x11, 0x22, 0x33));
+}
+
+TEST(RtpPacketTest, RejectsPayloadViewLargerThanCapacity) {
+  rtc::scoped_refptr<rtc::RefCountedObject<PayloadOwner>> owner(
+      new rtc::RefCountedObject<PayloadOwner>(rtc::Buffer(2000)));
+  RtpPacketToSend packet(nullptr, 1500);
+  EXPECT_FALSE(packet.AllocatePayloadWithView(2, owner->data(), owner));
+  EXPECT_TRUE(owner->HasOneRef());
+}
+
 }  // namespace
 }  // namespace webrtc
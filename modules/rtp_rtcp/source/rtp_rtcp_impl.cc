@@ -19,11 +19,16 @@
 #include <string>
 #include <utility>
 
+#include "absl/strings/match.h"
 #include "api/transport/field_trial_based_config.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/dlrr.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_ring_history.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 
 #ifdef _WIN32
 // Disable warning C4355: 'this' : used in base member initializer list.
@@ -36,16 +41,30 @@ const int64_t kRtpRtcpMaxIdleTimeProcessMs = 5;
 const int64_t kRtpRtcpRttProcessTimeMs = 1000;
 const int64_t kRtpRtcpBitrateProcessTimeMs = 10;
 const int64_t kDefaultExpectedRetransmissionTimeMs = 125;
+
+std::unique_ptr<RtpPacketHistoryInterface> CreatePacketHistory(
+    const RtpRtcp::Configuration& config) {
+  FieldTrialBasedConfig default_trials;
+  const WebRtcKeyValueConfig& trials =
+      config.field_trials ? *config.field_trials : default_trials;
+  if (absl::StartsWith(trials.Lookup("WebRTC-RtpPacketHistory-Ring"),
+                       "Enabled")) {
+    return std::make_unique<RtpPacketRingHistory>(
+        config.clock, config.enable_rtx_padding_prioritization);
+  }
+  return std::make_unique<RtpPacketHistory>(
+      config.clock, config.enable_rtx_padding_prioritization);
+}
 }  // namespace
 
 ModuleRtpRtcpImpl::RtpSenderContext::RtpSenderContext(
     const RtpRtcp::Configuration& config)
-    : packet_history(config.clock, config.enable_rtx_padding_prioritization),
-      packet_sender(config, &packet_history),
+    : packet_history(CreatePacketHistory(config)),
+      packet_sender(config, packet_history.get()),
       non_paced_sender(&packet_sender),
       packet_generator(
           config,
-          &packet_history,
+          packet_history.get(),
           config.paced_sender ? config.paced_sender : &non_paced_sender) {}
 
 RtpRtcp::Configuration::Configuration() = default;
@@ -60,6 +79,7 @@ ModuleRtpRtcpImpl::ModuleRtpRtcpImpl(const Configuration& configuration)
     : rtcp_sender_(configuration),
       rtcp_receiver_(configuration, this),
       clock_(configuration.clock),
+      task_queue_(configuration.task_queue),
       last_bitrate_process_time_(clock_->TimeInMilliseconds()),
       last_rtt_process_time_(clock_->TimeInMilliseconds()),
       next_process_time_(clock_->TimeInMilliseconds() +
@@ -82,6 +102,11 @@ ModuleRtpRtcpImpl::ModuleRtpRtcpImpl(const Configuration& configuration)
   // webrtc::VideoSendStream::Config::Rtp::kDefaultMaxPacketSize.
   const size_t kTcpOverIpv4HeaderSize = 40;
   SetMaxRtpPacketSize(IP_PACKET_SIZE - kTcpOverIpv4HeaderSize);
+
+  if (task_queue_) {
+    RTC_DCHECK(task_queue_->IsCurrent());
+    ScheduleProcess(next_process_time_);
+  }
 }
 
 ModuleRtpRtcpImpl::~ModuleRtpRtcpImpl() = default;
@@ -177,6 +202,60 @@ void ModuleRtpRtcpImpl::Process() {
   }
 }
 
+void ModuleRtpRtcpImpl::ScheduleProcess(int64_t time_ms) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  if (scheduled_process_time_ms_ && *scheduled_process_time_ms_ <= time_ms)
+    return;
+  scheduled_process_time_ms_ = time_ms;
+  const int64_t delay_ms =
+      std::max<int64_t>(0, time_ms - clock_->TimeInMilliseconds());
+  task_queue_->PostDelayedTask(ToQueuedTask(task_safety_,
+                                            [this, time_ms] {
+                                              ProcessScheduled(time_ms);
+                                            }),
+                               rtc::dchecked_cast<uint32_t>(delay_ms));
+}
+
+void ModuleRtpRtcpImpl::ProcessScheduled(int64_t time_ms) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  if (scheduled_process_time_ms_ != time_ms)
+    return;
+  scheduled_process_time_ms_ = absl::nullopt;
+  Process();
+
+  int64_t next_time_ms = last_rtt_process_time_ + kRtpRtcpRttProcessTimeMs;
+  if (rtp_sender_) {
+    next_time_ms =
+        std::min(next_time_ms,
+                 last_bitrate_process_time_ + kRtpRtcpBitrateProcessTimeMs);
+  }
+  absl::optional<int64_t> rtcp_time_ms =
+      rtcp_sender_.NextTimeToSendRTCPReportMs();
+  if (rtcp_time_ms)
+    next_time_ms = std::min(next_time_ms, *rtcp_time_ms);
+  // A report that is due but could not be sent, e.g. before the first frame,
+  // is retried at the polling interval of the ProcessThread.
+  next_time_ms =
+      std::max(next_time_ms,
+               clock_->TimeInMilliseconds() + kRtpRtcpMaxIdleTimeProcessMs);
+  ScheduleProcess(next_time_ms);
+}
+
+void ModuleRtpRtcpImpl::ScheduleNextRtcpReport() {
+  if (!task_queue_)
+    return;
+  if (!task_queue_->IsCurrent()) {
+    task_queue_->PostTask(
+        ToQueuedTask(task_safety_, [this] { ScheduleNextRtcpReport(); }));
+    return;
+  }
+  RTC_DCHECK_RUN_ON(task_queue_);
+  absl::optional<int64_t> rtcp_time_ms =
+      rtcp_sender_.NextTimeToSendRTCPReportMs();
+  if (rtcp_time_ms)
+    ScheduleProcess(*rtcp_time_ms);
+}
+
 void ModuleRtpRtcpImpl::SetRtxSendStatus(int mode) {
   rtp_sender_->packet_generator.SetRtxStatus(mode);
 }
@@ -374,7 +453,7 @@ bool ModuleRtpRtcpImpl::TrySendPacket(RtpPacketToSend* packet,
 void ModuleRtpRtcpImpl::OnPacketsAcknowledged(
     rtc::ArrayView<const uint16_t> sequence_numbers) {
   RTC_DCHECK(rtp_sender_);
-  rtp_sender_->packet_history.CullAcknowledgedPackets(sequence_numbers);
+  rtp_sender_->packet_history->CullAcknowledgedPackets(sequence_numbers);
 }
 
 bool ModuleRtpRtcpImpl::SupportsPadding() const {
@@ -432,6 +511,7 @@ RtcpMode ModuleRtpRtcpImpl::RTCP() const {
 // Configure RTCP status i.e on/off.
 void ModuleRtpRtcpImpl::SetRTCPStatus(const RtcpMode method) {
   rtcp_sender_.SetRTCPStatus(method);
+  ScheduleNextRtcpReport();
 }
 
 int32_t ModuleRtpRtcpImpl::SetCNAME(const char* c_name) {
@@ -560,6 +640,7 @@ std::vector<ReportBlockData> ModuleRtpRtcpImpl::GetLatestReportBlockData()
 void ModuleRtpRtcpImpl::SetRemb(int64_t bitrate_bps,
                                 std::vector<uint32_t> ssrcs) {
   rtcp_sender_.SetRemb(bitrate_bps, std::move(ssrcs));
+  ScheduleNextRtcpReport();
 }
 
 void ModuleRtpRtcpImpl::UnsetRemb() {
@@ -666,14 +747,14 @@ bool ModuleRtpRtcpImpl::TimeToSendFullNackList(int64_t now) const {
 // Store the sent packets, needed to answer to Negative acknowledgment requests.
 void ModuleRtpRtcpImpl::SetStorePacketsStatus(const bool enable,
                                               const uint16_t number_to_store) {
-  rtp_sender_->packet_history.SetStorePacketsStatus(
+  rtp_sender_->packet_history->SetStorePacketsStatus(
       enable ? RtpPacketHistory::StorageMode::kStoreAndCull
              : RtpPacketHistory::StorageMode::kDisabled,
       number_to_store);
 }
 
 bool ModuleRtpRtcpImpl::StorePackets() const {
-  return rtp_sender_->packet_history.GetStorageMode() !=
+  return rtp_sender_->packet_history->GetStorageMode() !=
          RtpPacketHistory::StorageMode::kDisabled;
 }
 
@@ -784,7 +865,7 @@ void ModuleRtpRtcpImpl::set_rtt_ms(int64_t rtt_ms) {
     rtt_ms_ = rtt_ms;
   }
   if (rtp_sender_) {
-    rtp_sender_->packet_history.SetRtt(rtt_ms);
+    rtp_sender_->packet_history->SetRtt(rtt_ms);
   }
 }
 
@@ -796,6 +877,7 @@ int64_t ModuleRtpRtcpImpl::rtt_ms() const {
 void ModuleRtpRtcpImpl::SetVideoBitrateAllocation(
     const VideoBitrateAllocation& bitrate) {
   rtcp_sender_.SetVideoBitrateAllocation(bitrate);
+  ScheduleNextRtcpReport();
 }
 
 RTPSender* ModuleRtpRtcpImpl::RtpSender() {
@@ -21,6 +21,7 @@
 
 #include "absl/types/optional.h"
 #include "api/rtp_headers.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "modules/include/module_fec_types.h"
 #include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
@@ -29,12 +30,14 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/tmmb_item.h"
 #include "modules/rtp_rtcp/source/rtcp_receiver.h"
 #include "modules/rtp_rtcp/source/rtcp_sender.h"
-#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history_interface.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 #include "modules/rtp_rtcp/source/rtp_sender_egress.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/gtest_prod_util.h"
+#include "rtc_base/synchronization/sequence_checker.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
 
 namespace webrtc {
 
@@ -307,7 +310,7 @@ class ModuleRtpRtcpImpl : public RtpRtcp, public RTCPReceiver::ModuleRtpRtcp {
   struct RtpSenderContext {
     explicit RtpSenderContext(const RtpRtcp::Configuration& config);
     // Storage of packets, for retransmissions and padding, if applicable.
-    RtpPacketHistory packet_history;
+    std::unique_ptr<RtpPacketHistoryInterface> packet_history;
     // Handles final time timestamping/stats/etc and handover to Transport.
     RtpSenderEgress packet_sender;
     // If no paced sender configured, this class will be used to pass packets
@@ -322,16 +325,28 @@ class ModuleRtpRtcpImpl : public RtpRtcp, public RTCPReceiver::ModuleRtpRtcp {
 
   bool TimeToSendFullNackList(int64_t now) const;
 
+  // Makes sure Process runs on |task_queue_| by |time_ms|.
+  void ScheduleProcess(int64_t time_ms);
+  // Runs the Process scheduled for |time_ms|, unless it was moved earlier, and
+  // schedules the next one for when its periodic work is due.
+  void ProcessScheduled(int64_t time_ms);
+  // Moves the next Process earlier if the RTCP report became due sooner.
+  void ScheduleNextRtcpReport();
+
   std::unique_ptr<RtpSenderContext> rtp_sender_;
 
   RTCPSender rtcp_sender_;
   RTCPReceiver rtcp_receiver_;
 
   Clock* const clock_;
+  TaskQueueBase* const task_queue_;
 
   int64_t last_bitrate_process_time_;
   int64_t last_rtt_process_time_;
   int64_t next_process_time_;
+  // The time of the next Process on |task_queue_|, if any.
+  absl::optional<int64_t> scheduled_process_time_ms_
+      RTC_GUARDED_BY(task_queue_);
   uint16_t packet_overhead_;
 
   // Send side
@@ -345,6 +360,8 @@ class ModuleRtpRtcpImpl : public RtpRtcp, public RTCPReceiver::ModuleRtpRtcp {
   // The processed RTT from RtcpRttStats.
   rtc::CriticalSection critical_section_rtt_;
   int64_t rtt_ms_;
+
+  ScopedTaskSafety task_safety_;
 };
 
 }  // namespace webrtc
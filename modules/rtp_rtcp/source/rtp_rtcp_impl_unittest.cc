@@ -14,6 +14,7 @@
 #include <memory>
 #include <set>
 
+#include "api/task_queue/task_queue_factory.h"
 #include "api/transport/field_trial_based_config.h"
 #include "api/video_codecs/video_codec.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -22,10 +23,12 @@
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_sender_video.h"
 #include "rtc_base/rate_limiter.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/rtcp_packet_parser.h"
 #include "test/rtp_header_parser.h"
+#include "test/time_controller/simulated_time_controller.h"
 
 using ::testing::ElementsAre;
 
@@ -95,6 +98,25 @@ class SendTransport : public Transport {
   std::vector<uint16_t> last_nack_list_;
 };
 
+class RtcpCountingTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* data,
+               size_t len,
+               const PacketOptions& options) override {
+    return true;
+  }
+  bool SendRtcp(const uint8_t* data, size_t len) override {
+    test::RtcpPacketParser parser;
+    parser.Parse(data, len);
+    num_receiver_reports_ += parser.receiver_report()->num_packets();
+    num_rembs_ += parser.remb()->num_packets();
+    return true;
+  }
+
+  int num_receiver_reports_ = 0;
+  int num_rembs_ = 0;
+};
+
 class RtpRtcpModule : public RtcpPacketTypeCounterObserver {
  public:
   RtpRtcpModule(SimulatedClock* clock, bool is_sender)
@@ -627,4 +649,63 @@ TEST_F(RtpRtcpImplTest, StoresPacketInfoForSentPackets) {
                                           /*is_last=*/1)));
 }
 
+class RtpRtcpImplTaskQueueTest : public ::testing::Test {
+ protected:
+  RtpRtcpImplTaskQueueTest()
+      : time_controller_(Timestamp::Millis(133590000)),
+        task_queue_(time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "rtp_rtcp",
+            TaskQueueFactory::Priority::NORMAL)) {
+    RunOnTaskQueue([this] {
+      RtpRtcp::Configuration config;
+      config.receiver_only = true;
+      config.clock = time_controller_.GetClock();
+      config.outgoing_transport = &transport_;
+      config.rtcp_report_interval_ms = kReportIntervalMs;
+      config.local_media_ssrc = kReceiverSsrc;
+      config.task_queue = task_queue_.get();
+      impl_ = std::make_unique<ModuleRtpRtcpImpl>(config);
+      impl_->SetRemoteSSRC(kSenderSsrc);
+      impl_->SetRTCPStatus(RtcpMode::kCompound);
+    });
+  }
+  ~RtpRtcpImplTaskQueueTest() override {
+    RunOnTaskQueue([this] { impl_.reset(); });
+  }
+
+  template <typename Closure>
+  void RunOnTaskQueue(Closure&& closure) {
+    task_queue_->PostTask(ToQueuedTask(std::forward<Closure>(closure)));
+    time_controller_.AdvanceTime(TimeDelta::Zero());
+  }
+
+  static constexpr int kReportIntervalMs = 1000;
+
+  GlobalSimulatedTimeController time_controller_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
+  RtcpCountingTransport transport_;
+  std::unique_ptr<ModuleRtpRtcpImpl> impl_;
+};
+
+TEST_F(RtpRtcpImplTaskQueueTest, SendsReportsWithoutProcessThread) {
+  // The first report is sent within half the interval.
+  time_controller_.AdvanceTime(TimeDelta::Millis(kReportIntervalMs / 2));
+  EXPECT_EQ(1, transport_.num_receiver_reports_);
+
+  // And the next ones within [0.5, 1.5] times the interval.
+  time_controller_.AdvanceTime(TimeDelta::Millis(10 * kReportIntervalMs));
+  EXPECT_GE(transport_.num_receiver_reports_, 1 + 10 * 2 / 3);
+  EXPECT_LE(transport_.num_receiver_reports_, 1 + 10 * 2);
+}
+
+TEST_F(RtpRtcpImplTaskQueueTest, SendsRembRightAway) {
+  time_controller_.AdvanceTime(TimeDelta::Millis(kReportIntervalMs / 2));
+  EXPECT_EQ(0, transport_.num_rembs_);
+
+  // From another thread than the task queue.
+  impl_->SetRemb(300000, {kSenderSsrc});
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  EXPECT_EQ(1, transport_.num_rembs_);
+}
+
 }  // namespace webrtc
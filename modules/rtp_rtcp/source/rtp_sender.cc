@@ -22,6 +22,7 @@
 #include "logging/rtc_event_log/events/rtc_event_rtp_packet_outgoing.h"
 #include "modules/rtp_rtcp/include/rtp_cvo.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/deadline_retransmission_policy.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
@@ -32,6 +33,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/rate_limiter.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
@@ -152,10 +154,18 @@ double GetMaxPaddingSizeFactor(const WebRtcKeyValueConfig* field_trials) {
   return factor.Value();
 }
 
+std::unique_ptr<RetransmissionPolicy> MaybeCreateRetransmissionPolicy(
+    const RtpRtcp::Configuration& config) {
+  if (config.retransmission_policy || !config.field_trials || config.audio)
+    return nullptr;
+  return DeadlineRetransmissionPolicy::CreateFromFieldTrial(
+      *config.field_trials);
+}
+
 }  // namespace
 
 RTPSender::RTPSender(const RtpRtcp::Configuration& config,
-                     RtpPacketHistory* packet_history,
+                     RtpPacketHistoryInterface* packet_history,
                      RtpPacketSender* packet_sender)
     : clock_(config.clock),
       random_(clock_->TimeInMicroseconds()),
@@ -167,6 +177,7 @@ RTPSender::RTPSender(const RtpRtcp::Configuration& config,
       max_padding_size_factor_(GetMaxPaddingSizeFactor(config.field_trials)),
       packet_history_(packet_history),
       paced_sender_(packet_sender),
+      packet_buffer_pool_(new rtc::RefCountedObject<RtpPacketBufferPool>()),
       sending_media_(true),                   // Default to sending media.
       max_packet_size_(IP_PACKET_SIZE - 28),  // Default is IP-v4/UDP.
       last_payload_type_(-1),
@@ -185,7 +196,11 @@ RTPSender::RTPSender(const RtpRtcp::Configuration& config,
       csrcs_(),
       rtx_(kRtxOff),
       supports_bwe_extension_(false),
-      retransmission_rate_limiter_(config.retransmission_rate_limiter) {
+      retransmission_rate_limiter_(config.retransmission_rate_limiter),
+      owned_retransmission_policy_(MaybeCreateRetransmissionPolicy(config)),
+      retransmission_policy_(config.retransmission_policy
+                                 ? config.retransmission_policy
+                                 : owned_retransmission_policy_.get()) {
   // This random initialization is not intended to be cryptographic strong.
   timestamp_offset_ = random_.Rand<uint32_t>();
   // Random start, 16 bits. Can't be 0.
@@ -302,7 +317,7 @@ void RTPSender::SetRtxPayloadType(int payload_type,
 int32_t RTPSender::ReSendPacket(uint16_t packet_id) {
   // Try to find packet in RTP packet history. Also verify RTT here, so that we
   // don't retransmit too often.
-  absl::optional<RtpPacketHistory::PacketState> stored_packet =
+  absl::optional<RtpPacketHistoryInterface::PacketState> stored_packet =
       packet_history_->GetPacketState(packet_id);
   if (!stored_packet || stored_packet->pending_transmission) {
     // Packet not found or already queued for retransmission, ignore.
@@ -365,6 +380,10 @@ void RTPSender::OnReceivedNack(
     const std::vector<uint16_t>& nack_sequence_numbers,
     int64_t avg_rtt) {
   packet_history_->SetRtt(5 + avg_rtt);
+  if (retransmission_policy_) {
+    OnReceivedNackWithPolicy(nack_sequence_numbers, avg_rtt);
+    return;
+  }
   for (uint16_t seq_no : nack_sequence_numbers) {
     const int32_t bytes_sent = ReSendPacket(seq_no);
     if (bytes_sent < 0) {
@@ -376,6 +395,37 @@ void RTPSender::OnReceivedNack(
   }
 }
 
+void RTPSender::OnReceivedNackWithPolicy(
+    const std::vector<uint16_t>& nack_sequence_numbers,
+    int64_t avg_rtt) {
+  std::vector<RetransmissionPolicy::Candidate> candidates;
+  candidates.reserve(nack_sequence_numbers.size());
+  for (uint16_t seq_no : nack_sequence_numbers) {
+    absl::optional<RtpPacketHistoryInterface::PacketState> stored_packet =
+        packet_history_->GetPacketState(seq_no);
+    if (!stored_packet || stored_packet->pending_transmission)
+      continue;
+    RetransmissionPolicy::Candidate candidate;
+    candidate.sequence_number = seq_no;
+    candidate.is_key_frame = stored_packet->is_key_frame;
+    candidate.capture_time_ms = stored_packet->capture_time_ms;
+    candidate.packet_size = stored_packet->packet_size;
+    candidate.times_retransmitted = stored_packet->times_retransmitted;
+    candidates.push_back(candidate);
+  }
+  retransmission_policy_->Prioritize(clock_->TimeInMilliseconds(), avg_rtt,
+                                     &candidates);
+  for (const RetransmissionPolicy::Candidate& candidate : candidates) {
+    if (ReSendPacket(candidate.sequence_number) < 0) {
+      // The rate limiter is out of budget, and the rest is less important.
+      RTC_LOG(LS_WARNING) << "Failed resending RTP packet "
+                          << candidate.sequence_number
+                          << ", Discard rest of packets.";
+      break;
+    }
+  }
+}
+
 bool RTPSender::SupportsPadding() const {
   rtc::CritScope lock(&send_critsect_);
   return sending_media_ && supports_bwe_extension_;
@@ -573,7 +623,8 @@ std::unique_ptr<RtpPacketToSend> RTPSender::AllocatePacket() const {
   // it is better than crash on drop packet without trying to send it.
   static constexpr int kExtraCapacity = 16;
   auto packet = std::make_unique<RtpPacketToSend>(
-      &rtp_header_extension_map_, max_packet_size_ + kExtraCapacity);
+      &rtp_header_extension_map_, max_packet_size_ + kExtraCapacity,
+      packet_buffer_pool_);
   packet->SetSsrc(ssrc_);
   packet->SetCsrcs(csrcs_);
   // Reserve extensions, if registered, RtpSender set in SendToNetwork.
@@ -23,11 +23,13 @@
 #include "api/call/transport.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/rtp_rtcp/include/flexfec_sender.h"
+#include "modules/rtp_rtcp/include/retransmission_policy.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
-#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history_interface.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
@@ -46,7 +48,7 @@ class RtpPacketToSend;
 class RTPSender {
  public:
   RTPSender(const RtpRtcp::Configuration& config,
-            RtpPacketHistory* packet_history,
+            RtpPacketHistoryInterface* packet_history,
             RtpPacketSender* packet_sender);
 
   ~RTPSender();
@@ -151,6 +153,11 @@ class RTPSender {
 
   bool IsFecPacket(const RtpPacketToSend& packet) const;
 
+  // Retransmits the NACKed packets picked by |retransmission_policy_|.
+  void OnReceivedNackWithPolicy(
+      const std::vector<uint16_t>& nack_sequence_numbers,
+      int64_t avg_rtt);
+
   void UpdateHeaderSizes() RTC_EXCLUSIVE_LOCKS_REQUIRED(send_critsect_);
 
   Clock* const clock_;
@@ -165,8 +172,10 @@ class RTPSender {
   //  |max_padding_size_factor_| * |target_size_bytes|
   const double max_padding_size_factor_;
 
-  RtpPacketHistory* const packet_history_;
+  RtpPacketHistoryInterface* const packet_history_;
   RtpPacketSender* const paced_sender_;
+  // Recycles the buffers of the packets returned by AllocatePacket().
+  const rtc::scoped_refptr<RtpPacketBufferPool> packet_buffer_pool_;
 
   rtc::CriticalSection send_critsect_;
 
@@ -206,6 +215,8 @@ class RTPSender {
   bool supports_bwe_extension_ RTC_GUARDED_BY(send_critsect_);
 
   RateLimiter* const retransmission_rate_limiter_;
+  const std::unique_ptr<RetransmissionPolicy> owned_retransmission_policy_;
+  RetransmissionPolicy* const retransmission_policy_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RTPSender);
 };
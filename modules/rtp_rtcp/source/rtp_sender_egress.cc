@@ -10,8 +10,11 @@
 
 #include "modules/rtp_rtcp/source/rtp_sender_egress.h"
 
+#include <string.h>
+
 #include <limits>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "absl/strings/match.h"
@@ -26,6 +29,8 @@ constexpr uint32_t kTimestampTicksPerMs = 90;
 constexpr int kSendSideDelayWindowMs = 1000;
 constexpr int kBitrateStatisticsWindowMs = 1000;
 constexpr size_t kRtpSequenceNumberMapMaxEntries = 1 << 13;
+// The largest bursts of the pacer.
+constexpr size_t kMaxPendingRateSamples = 64;
 
 bool IsEnabled(absl::string_view name,
                const WebRtcKeyValueConfig* field_trials) {
@@ -53,8 +58,48 @@ void RtpSenderEgress::NonPacedPacketSender::EnqueuePackets(
   }
 }
 
+RtpSenderEgress::CountersSnapshot::CountersSnapshot() : sequence_number_(0) {
+  static_assert(std::is_trivially_copyable<StreamDataCounters>::value, "");
+  Publish(StreamDataCounters(), StreamDataCounters());
+}
+
+void RtpSenderEgress::CountersSnapshot::Publish(
+    const StreamDataCounters& rtp_stats,
+    const StreamDataCounters& rtx_stats) {
+  const Counters counters = {rtp_stats, rtx_stats};
+  uint64_t words[kNumWords] = {};
+  memcpy(words, &counters, sizeof(counters));
+
+  const uint32_t sequence_number =
+      sequence_number_.load(std::memory_order_relaxed);
+  sequence_number_.store(sequence_number + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < kNumWords; ++i)
+    words_[i].store(words[i], std::memory_order_relaxed);
+  sequence_number_.store(sequence_number + 2, std::memory_order_release);
+}
+
+void RtpSenderEgress::CountersSnapshot::Read(
+    StreamDataCounters* rtp_stats,
+    StreamDataCounters* rtx_stats) const {
+  uint64_t words[kNumWords];
+  uint32_t sequence_number;
+  do {
+    sequence_number = sequence_number_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < kNumWords; ++i)
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence_number & 1) != 0 ||
+           sequence_number != sequence_number_.load(std::memory_order_relaxed));
+
+  Counters counters;
+  memcpy(&counters, words, sizeof(counters));
+  *rtp_stats = counters.rtp_stats;
+  *rtx_stats = counters.rtx_stats;
+}
+
 RtpSenderEgress::RtpSenderEgress(const RtpRtcp::Configuration& config,
-                                 RtpPacketHistory* packet_history)
+                                 RtpPacketHistoryInterface* packet_history)
     : ssrc_(config.local_media_ssrc),
       rtx_ssrc_(config.rtx_send_ssrc),
       flexfec_ssrc_(config.fec_generator ? config.fec_generator->FecSsrc()
@@ -73,6 +118,8 @@ RtpSenderEgress::RtpSenderEgress(const RtpRtcp::Configuration& config,
       send_packet_observer_(config.send_packet_observer),
       rtp_stats_callback_(config.rtp_stats_callback),
       bitrate_callback_(config.send_bitrate_observer),
+      rtp_stats_updated_(false),
+      rtx_rtp_stats_updated_(false),
       media_has_been_sent_(false),
       force_part_of_allocation_(false),
       timestamp_offset_(0),
@@ -84,10 +131,13 @@ RtpSenderEgress::RtpSenderEgress(const RtpRtcp::Configuration& config,
       rtp_sequence_number_map_(need_rtp_packet_infos_
                                    ? std::make_unique<RtpSequenceNumberMap>(
                                          kRtpSequenceNumberMapMaxEntries)
-                                   : nullptr) {}
+                                   : nullptr) {
+  pending_rate_samples_.reserve(kMaxPendingRateSamples);
+}
 
 void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
                                  const PacedPacketInfo& pacing_info) {
+  RTC_DCHECK_RUNS_SERIALIZED(&send_race_checker_);
   RTC_DCHECK(packet);
 
   const uint32_t packet_ssrc = packet->Ssrc();
@@ -175,6 +225,8 @@ void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
 
   options.application_data.assign(packet->application_data().begin(),
                                   packet->application_data().end());
+  options.batchable = packet->batchable();
+  options.last_packet_in_batch = packet->last_packet_in_batch();
 
   if (packet->packet_type() != RtpPacketMediaType::kPadding &&
       packet->packet_type() != RtpPacketMediaType::kRetransmission) {
@@ -195,9 +247,11 @@ void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
   }
 
   if (send_success) {
-    rtc::CritScope lock(&lock_);
     UpdateRtpStats(*packet);
-    media_has_been_sent_ = true;
+  }
+  if (!packet->batchable() || packet->last_packet_in_batch() ||
+      pending_rate_samples_.size() >= kMaxPendingRateSamples) {
+    FlushRtpStats();
   }
 }
 
@@ -230,9 +284,7 @@ RtpSendRates RtpSenderEgress::GetSendRatesLocked() const {
 
 void RtpSenderEgress::GetDataCounters(StreamDataCounters* rtp_stats,
                                       StreamDataCounters* rtx_stats) const {
-  rtc::CritScope lock(&lock_);
-  *rtp_stats = rtp_stats_;
-  *rtx_stats = rtx_rtp_stats_;
+  counters_snapshot_.Read(rtp_stats, rtx_stats);
 }
 
 void RtpSenderEgress::ForceIncludeSendPacketsInAllocation(
@@ -418,7 +470,11 @@ bool RtpSenderEgress::SendPacketToNetwork(const RtpPacketToSend& packet,
                                           const PacedPacketInfo& pacing_info) {
   int bytes_sent = -1;
   if (transport_) {
-    bytes_sent = transport_->SendRtp(packet.data(), packet.size(), options)
+    // The buffer stays shared with |packet| and with its copy in the packet
+    // history, if any, so it is only copied if it is protected in place while
+    // one of them is still around. A packet referencing its payload is
+    // gathered into a new buffer instead, which can be protected in place.
+    bytes_sent = transport_->SendRtpBuffer(packet.GatherBuffer(), options)
                      ? static_cast<int>(packet.size())
                      : -1;
     if (event_log_ && bytes_sent > 0) {
@@ -435,10 +491,16 @@ bool RtpSenderEgress::SendPacketToNetwork(const RtpPacketToSend& packet,
 }
 
 void RtpSenderEgress::UpdateRtpStats(const RtpPacketToSend& packet) {
-  int64_t now_ms = clock_->TimeInMilliseconds();
+  int64_t now_ms = clock_->CoarseTimeInMilliseconds();
 
-  StreamDataCounters* counters =
-      packet.Ssrc() == rtx_ssrc_ ? &rtx_rtp_stats_ : &rtp_stats_;
+  StreamDataCounters* counters;
+  if (packet.Ssrc() == rtx_ssrc_) {
+    counters = &rtx_rtp_stats_;
+    rtx_rtp_stats_updated_ = true;
+  } else {
+    counters = &rtp_stats_;
+    rtp_stats_updated_ = true;
+  }
 
   if (counters->first_packet_time_ms == -1) {
     counters->first_packet_time_ms = now_ms;
@@ -454,12 +516,35 @@ void RtpSenderEgress::UpdateRtpStats(const RtpPacketToSend& packet) {
   counters->transmitted.AddPacket(packet);
 
   RTC_DCHECK(packet.packet_type().has_value());
-  send_rates_[static_cast<size_t>(*packet.packet_type())].Update(packet.size(),
-                                                                 now_ms);
+  pending_rate_samples_.push_back(
+      RateSample{*packet.packet_type(), packet.size(), now_ms});
+}
+
+void RtpSenderEgress::FlushRtpStats() {
+  if (pending_rate_samples_.empty())
+    return;
+
+  counters_snapshot_.Publish(rtp_stats_, rtx_rtp_stats_);
+  {
+    rtc::CritScope lock(&lock_);
+    for (const RateSample& sample : pending_rate_samples_) {
+      send_rates_[static_cast<size_t>(sample.type)].Update(sample.size,
+                                                           sample.time_ms);
+    }
+    media_has_been_sent_ = true;
+  }
+  pending_rate_samples_.clear();
 
   if (rtp_stats_callback_) {
-    rtp_stats_callback_->DataCountersUpdated(*counters, packet.Ssrc());
+    if (rtp_stats_updated_)
+      rtp_stats_callback_->DataCountersUpdated(rtp_stats_, ssrc_);
+    if (rtx_rtp_stats_updated_) {
+      RTC_DCHECK(rtx_ssrc_);
+      rtp_stats_callback_->DataCountersUpdated(rtx_rtp_stats_, *rtx_ssrc_);
+    }
   }
+  rtp_stats_updated_ = false;
+  rtx_rtp_stats_updated_ = false;
 }
 
 }  // namespace webrtc
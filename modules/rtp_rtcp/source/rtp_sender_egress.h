@@ -11,6 +11,7 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_SENDER_EGRESS_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_SENDER_EGRESS_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <vector>
@@ -21,10 +22,11 @@
 #include "api/units/data_rate.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
-#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history_interface.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/race_checker.h"
 #include "rtc_base/rate_statistics.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -48,9 +50,13 @@ class RtpSenderEgress {
   };
 
   RtpSenderEgress(const RtpRtcp::Configuration& config,
-                  RtpPacketHistory* packet_history);
+                  RtpPacketHistoryInterface* packet_history);
   ~RtpSenderEgress() = default;
 
+  // The packets are sent by one thread at a time. The send rates, the data
+  // counters returned by GetDataCounters() and the |rtp_stats_callback_| are
+  // updated once per burst of the pacer, after the last packet of a batch or
+  // after a packet sent on its own.
   void SendPacket(RtpPacketToSend* packet, const PacedPacketInfo& pacing_info)
       RTC_LOCKS_EXCLUDED(lock_);
   uint32_t Ssrc() const { return ssrc_; }
@@ -84,6 +90,38 @@ class RtpSenderEgress {
   // time.
   typedef std::map<int64_t, int> SendDelayMap;
 
+  // Data counters of the media and RTX streams written by the sending thread
+  // and read by the other ones without blocking it: the writer makes the
+  // sequence number odd while it stores the words of the counters, the
+  // readers copy them until they see the same even sequence number before and
+  // after the copy.
+  class CountersSnapshot {
+   public:
+    CountersSnapshot();
+
+    void Publish(const StreamDataCounters& rtp_stats,
+                 const StreamDataCounters& rtx_stats);
+    void Read(StreamDataCounters* rtp_stats,
+              StreamDataCounters* rtx_stats) const;
+
+   private:
+    struct Counters {
+      StreamDataCounters rtp_stats;
+      StreamDataCounters rtx_stats;
+    };
+    static constexpr size_t kNumWords =
+        (sizeof(Counters) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> sequence_number_;
+    std::atomic<uint64_t> words_[kNumWords];
+  };
+
+  struct RateSample {
+    RtpPacketMediaType type;
+    size_t size;
+    int64_t time_ms;
+  };
+
   RtpSendRates GetSendRatesLocked() const RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   bool HasCorrectSsrc(const RtpPacketToSend& packet) const;
   void AddPacketToTransportFeedback(uint16_t packet_id,
@@ -101,7 +139,10 @@ class RtpSenderEgress {
                            const PacketOptions& options,
                            const PacedPacketInfo& pacing_info);
   void UpdateRtpStats(const RtpPacketToSend& packet)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(send_race_checker_);
+  // Applies the statistics of the packets sent since the last call.
+  void FlushRtpStats() RTC_EXCLUSIVE_LOCKS_REQUIRED(send_race_checker_)
+      RTC_LOCKS_EXCLUDED(lock_);
 
   const uint32_t ssrc_;
   const absl::optional<uint32_t> rtx_ssrc_;
@@ -109,7 +150,7 @@ class RtpSenderEgress {
   const bool populate_network2_timestamp_;
   const bool send_side_bwe_with_overhead_;
   Clock* const clock_;
-  RtpPacketHistory* const packet_history_;
+  RtpPacketHistoryInterface* const packet_history_;
   Transport* const transport_;
   RtcEventLog* const event_log_;
   const bool is_audio_;
@@ -121,6 +162,15 @@ class RtpSenderEgress {
   StreamDataCountersCallback* const rtp_stats_callback_;
   BitrateStatisticsObserver* const bitrate_callback_;
 
+  rtc::RaceChecker send_race_checker_;
+  StreamDataCounters rtp_stats_ RTC_GUARDED_BY(send_race_checker_);
+  StreamDataCounters rtx_rtp_stats_ RTC_GUARDED_BY(send_race_checker_);
+  bool rtp_stats_updated_ RTC_GUARDED_BY(send_race_checker_);
+  bool rtx_rtp_stats_updated_ RTC_GUARDED_BY(send_race_checker_);
+  std::vector<RateSample> pending_rate_samples_
+      RTC_GUARDED_BY(send_race_checker_);
+  CountersSnapshot counters_snapshot_;
+
   rtc::CriticalSection lock_;
   bool media_has_been_sent_ RTC_GUARDED_BY(lock_);
   bool force_part_of_allocation_ RTC_GUARDED_BY(lock_);
@@ -131,8 +181,6 @@ class RtpSenderEgress {
   // The sum of delays over a kSendSideDelayWindowMs sliding window.
   int64_t sum_delays_ms_ RTC_GUARDED_BY(lock_);
   uint64_t total_packet_send_delay_ms_ RTC_GUARDED_BY(lock_);
-  StreamDataCounters rtp_stats_ RTC_GUARDED_BY(lock_);
-  StreamDataCounters rtx_rtp_stats_ RTC_GUARDED_BY(lock_);
   // One element per value in RtpPacketMediaType, with index matching value.
   std::vector<RateStatistics> send_rates_ RTC_GUARDED_BY(lock_);
 
@@ -27,6 +27,7 @@
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/rtp_rtcp/source/rtp_sender_egress.h"
@@ -1937,6 +1938,38 @@ TEST_P(RtpSenderTestWithoutPacer, BytesReportedCorrectly) {
       rtp_stats.transmitted.TotalBytes() + rtx_stats.transmitted.TotalBytes());
 }
 
+TEST_P(RtpSenderTest, UpdatesStatsAfterTheLastPacketOfABatch) {
+  const int64_t capture_time_ms = fake_clock_.TimeInMilliseconds();
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  for (int i = 0; i < 3; ++i) {
+    packets.push_back(
+        BuildRtpPacket(kPayload, kMarkerBit, kTimestamp, capture_time_ms));
+    packets.back()->set_batchable(true);
+    packets.back()->set_last_packet_in_batch(i == 2);
+  }
+
+  StreamDataCounters rtp_stats;
+  StreamDataCounters rtx_stats;
+  StreamDataCounters expected;
+  for (int i = 0; i < 2; ++i) {
+    rtp_egress()->SendPacket(packets[i].get(), PacedPacketInfo());
+    rtp_egress()->GetDataCounters(&rtp_stats, &rtx_stats);
+    EXPECT_EQ(0u, rtp_stats.transmitted.packets);
+    rtp_stats_callback_.Matches(0, expected);
+  }
+  EXPECT_FALSE(rtp_egress()->MediaHasBeenSent());
+
+  rtp_egress()->SendPacket(packets[2].get(), PacedPacketInfo());
+  EXPECT_EQ(3, transport_.packets_sent());
+  rtp_egress()->GetDataCounters(&rtp_stats, &rtx_stats);
+  EXPECT_EQ(3u, rtp_stats.transmitted.packets);
+  EXPECT_EQ(0u, rtx_stats.transmitted.packets);
+  expected.transmitted.header_bytes = 3 * packets[0]->headers_size();
+  expected.transmitted.packets = 3;
+  rtp_stats_callback_.Matches(kSsrc, expected);
+  EXPECT_TRUE(rtp_egress()->MediaHasBeenSent());
+}
+
 TEST_P(RtpSenderTestWithoutPacer, RespectsNackBitrateLimit) {
   const int32_t kPacketSize = 1400;
   const int32_t kNumPackets = 30;
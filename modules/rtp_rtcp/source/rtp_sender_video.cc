@@ -44,6 +44,10 @@ namespace webrtc {
 namespace {
 constexpr size_t kRedForFecHeaderLength = 1;
 constexpr int64_t kMaxUnretransmittableFrameIntervalMs = 33 * 4;
+// Past these, a new key frame is cheaper than the retransmission of the last
+// one and of the frames which followed.
+constexpr int64_t kMaxKeyFrameChainAgeMs = 1000;
+constexpr size_t kMaxKeyFrameChainBytes = 500000;
 
 void BuildRedPayload(const RtpPacketToSend& media_packet,
                      RtpPacketToSend* red_packet) {
@@ -126,6 +130,9 @@ RTPSenderVideo::RTPSenderVideo(const Config& config)
       transmit_color_space_next_frame_(false),
       current_playout_delay_{-1, -1},
       playout_delay_pending_(false),
+      key_frame_chain_retransmission_(absl::StartsWith(
+          config.field_trials->Lookup("WebRTC-KeyFrameChainRetransmission"),
+          "Enabled")),
       red_payload_type_(config.red_payload_type),
       fec_generator_(config.fec_generator),
       fec_type_(config.fec_type),
@@ -137,6 +144,9 @@ RTPSenderVideo::RTPSenderVideo(const Config& config)
       generic_descriptor_auth_experiment_(!absl::StartsWith(
           config.field_trials->Lookup("WebRTC-GenericDescriptorAuth"),
           "Disabled")),
+      zero_copy_packetization_(!absl::StartsWith(
+          config.field_trials->Lookup("WebRTC-ZeroCopyPacketization"),
+          "Disabled")),
       absolute_capture_time_sender_(config.clock),
       frame_transformer_delegate_(
           config.frame_transformer
@@ -397,6 +407,23 @@ bool RTPSenderVideo::SendVideo(
     const RTPFragmentationHeader* fragmentation,
     RTPVideoHeader video_header,
     absl::optional<int64_t> expected_retransmission_time_ms) {
+  return SendVideoInternal(payload_type, codec_type, rtp_timestamp,
+                           capture_time_ms, payload, fragmentation,
+                           std::move(video_header),
+                           expected_retransmission_time_ms,
+                           /*payload_owner=*/nullptr);
+}
+
+bool RTPSenderVideo::SendVideoInternal(
+    int payload_type,
+    absl::optional<VideoCodecType> codec_type,
+    uint32_t rtp_timestamp,
+    int64_t capture_time_ms,
+    rtc::ArrayView<const uint8_t> payload,
+    const RTPFragmentationHeader* fragmentation,
+    RTPVideoHeader video_header,
+    absl::optional<int64_t> expected_retransmission_time_ms,
+    rtc::scoped_refptr<rtc::RefCountInterface> payload_owner) {
 #if RTC_TRACE_EVENTS_ENABLED
   TRACE_EVENT_ASYNC_STEP1("webrtc", "Video", capture_time_ms, "Send", "type",
                           FrameTypeToString(video_header.frame_type));
@@ -445,6 +472,9 @@ bool RTPSenderVideo::SendVideo(
   auto first_packet = std::make_unique<RtpPacketToSend>(*single_packet);
   auto middle_packet = std::make_unique<RtpPacketToSend>(*single_packet);
   auto last_packet = std::make_unique<RtpPacketToSend>(*single_packet);
+  first_packet->UnshareBuffer();
+  middle_packet->UnshareBuffer();
+  last_packet->UnshareBuffer();
   // Simplest way to estimate how much extensions would occupy is to set them.
   AddRtpHeaderExtensions(video_header, absolute_capture_time,
                          /*first_packet=*/true, /*last_packet=*/true,
@@ -488,8 +518,6 @@ bool RTPSenderVideo::SendVideo(
     MinimizeDescriptor(&video_header);
   }
 
-  // TODO(benwright@webrtc.org) - Allocate enough to always encrypt inline.
-  rtc::Buffer encrypted_video_payload;
   if (frame_encryptor_ != nullptr) {
     if (!has_generic_descriptor) {
       return false;
@@ -498,7 +526,9 @@ bool RTPSenderVideo::SendVideo(
     const size_t max_ciphertext_size =
         frame_encryptor_->GetMaxCiphertextByteSize(cricket::MEDIA_TYPE_VIDEO,
                                                    payload.size());
-    encrypted_video_payload.SetSize(max_ciphertext_size);
+    // The encoded image may be shared with other sinks, so it's not encrypted
+    // in place, but into a buffer reused for every frame.
+    encrypted_payload_.SetSize(max_ciphertext_size);
 
     size_t bytes_written = 0;
 
@@ -510,20 +540,22 @@ bool RTPSenderVideo::SendVideo(
 
     if (frame_encryptor_->Encrypt(
             cricket::MEDIA_TYPE_VIDEO, first_packet->Ssrc(), additional_data,
-            payload, encrypted_video_payload, &bytes_written) != 0) {
+            payload, encrypted_payload_, &bytes_written) != 0) {
       return false;
     }
 
-    encrypted_video_payload.SetSize(bytes_written);
-    payload = encrypted_video_payload;
+    encrypted_payload_.SetSize(bytes_written);
+    payload = encrypted_payload_;
+    payload_owner = nullptr;
   } else if (require_frame_encryption_) {
     RTC_LOG(LS_WARNING)
         << "No FrameEncryptor is attached to this video sending stream but "
            "one is required since require_frame_encryptor is set";
   }
 
-  std::unique_ptr<RtpPacketizer> packetizer = RtpPacketizer::Create(
-      codec_type, payload, limits, video_header, fragmentation);
+  std::unique_ptr<RtpPacketizer> packetizer =
+      RtpPacketizer::Create(codec_type, payload, limits, video_header,
+                            fragmentation, std::move(payload_owner));
 
   // TODO(bugs.webrtc.org/10714): retransmission_settings_ should generally be
   // replaced by expected_retransmission_time_ms.has_value(). For now, though,
@@ -568,10 +600,13 @@ bool RTPSenderVideo::SendVideo(
           limits.max_payload_len - limits.last_packet_reduction_len;
     } else {
       packet = std::make_unique<RtpPacketToSend>(*middle_packet);
+      packet->UnshareBuffer();
       expected_payload_capacity = limits.max_payload_len;
     }
 
     packet->set_first_packet_of_frame(i == 0);
+    packet->set_is_key_frame(video_header.frame_type ==
+                             VideoFrameType::kVideoFrameKey);
 
     if (!packetizer->NextPacket(packet.get()))
       return false;
@@ -636,6 +671,12 @@ bool RTPSenderVideo::SendVideo(
     }
   }
 
+  if (key_frame_chain_retransmission_) {
+    UpdateKeyFrameChain(
+        video_header.frame_type == VideoFrameType::kVideoFrameKey,
+        allow_retransmission, rtp_packets);
+  }
+
   LogAndSendToNetwork(std::move(rtp_packets), unpacketized_payload_size);
 
   // Update details about the last sent frame.
@@ -680,9 +721,69 @@ bool RTPSenderVideo::SendEncodedImage(
         payload_type, codec_type, rtp_timestamp, encoded_image, fragmentation,
         video_header, expected_retransmission_time_ms);
   }
-  return SendVideo(payload_type, codec_type, rtp_timestamp,
-                   encoded_image.capture_time_ms_, encoded_image, fragmentation,
-                   video_header, expected_retransmission_time_ms);
+  // Only the H264 packetizer references the payload.
+  if (!zero_copy_packetization_ || codec_type != kVideoCodecH264) {
+    return SendVideo(payload_type, codec_type, rtp_timestamp,
+                     encoded_image.capture_time_ms_, encoded_image,
+                     fragmentation, video_header,
+                     expected_retransmission_time_ms);
+  }
+  // The packets keep a reference to the encoded data, which the encoders
+  // don't modify once delivered. An image referencing memory it doesn't own
+  // is copied once here, instead of in pieces by the packetizer.
+  EncodedImage retained_image = encoded_image;
+  retained_image.Retain();
+  return SendVideoInternal(payload_type, codec_type, rtp_timestamp,
+                           retained_image.capture_time_ms_, retained_image,
+                           fragmentation, std::move(video_header),
+                           expected_retransmission_time_ms,
+                           retained_image.GetEncodedData());
+}
+
+bool RTPSenderVideo::RetransmitKeyFrameChain() {
+  std::vector<uint16_t> sequence_numbers;
+  {
+    rtc::CritScope cs(&crit_);
+    if (!key_frame_chain_ ||
+        clock_->TimeInMilliseconds() - key_frame_chain_->key_frame_time_ms >
+            kMaxKeyFrameChainAgeMs) {
+      return false;
+    }
+    sequence_numbers = std::move(key_frame_chain_->sequence_numbers);
+    // Retransmitted once, a new request gets a new key frame.
+    key_frame_chain_.reset();
+  }
+  for (uint16_t sequence_number : sequence_numbers) {
+    if (rtp_sender_->ReSendPacket(sequence_number) < 0)
+      return false;
+  }
+  return true;
+}
+
+void RTPSenderVideo::UpdateKeyFrameChain(
+    bool is_key_frame,
+    bool allow_retransmission,
+    const std::vector<std::unique_ptr<RtpPacketToSend>>& packets) {
+  rtc::CritScope cs(&crit_);
+  if (is_key_frame) {
+    key_frame_chain_.emplace();
+    key_frame_chain_->key_frame_time_ms = clock_->TimeInMilliseconds();
+  }
+  if (!key_frame_chain_)
+    return;
+  // Not in the packet history.
+  if (!allow_retransmission) {
+    key_frame_chain_.reset();
+    return;
+  }
+  for (const auto& packet : packets) {
+    if (*packet->packet_type() != RtpPacketMediaType::kVideo)
+      continue;
+    key_frame_chain_->sequence_numbers.push_back(packet->SequenceNumber());
+    key_frame_chain_->size_bytes += packet->size();
+  }
+  if (key_frame_chain_->size_bytes > kMaxKeyFrameChainBytes)
+    key_frame_chain_.reset();
 }
 
 uint32_t RTPSenderVideo::VideoBitrateSent() const {
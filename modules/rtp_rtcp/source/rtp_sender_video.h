@@ -31,6 +31,7 @@
 #include "modules/rtp_rtcp/source/rtp_sender_video_frame_transformer_delegate.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
 #include "modules/rtp_rtcp/source/video_fec_generator.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/one_time_event.h"
 #include "rtc_base/race_checker.h"
@@ -116,6 +117,12 @@ class RTPSenderVideo {
   void SetVideoStructureUnderLock(
       const FrameDependencyStructure* video_structure);
 
+  // Retransmits the packets of the last key frame and of the frames sent since,
+  // to answer a key frame request without a new key frame. Returns false if
+  // the key frame is too old, if the packets exceed the budget or were already
+  // retransmitted this way, or if the retransmission rate is exhausted.
+  bool RetransmitKeyFrameChain();
+
   uint32_t VideoBitrateSent() const;
 
   // Returns the current packetization overhead rate, in bps. Note that this is
@@ -141,6 +148,19 @@ class RTPSenderVideo {
     int64_t last_frame_time_ms;
   };
 
+  // Same as SendVideo(), except that the packets may reference |payload|
+  // instead of copying it if |payload_owner| is set to keep it alive.
+  bool SendVideoInternal(
+      int payload_type,
+      absl::optional<VideoCodecType> codec_type,
+      uint32_t rtp_timestamp,
+      int64_t capture_time_ms,
+      rtc::ArrayView<const uint8_t> payload,
+      const RTPFragmentationHeader* fragmentation,
+      RTPVideoHeader video_header,
+      absl::optional<int64_t> expected_retransmission_time_ms,
+      rtc::scoped_refptr<rtc::RefCountInterface> payload_owner);
+
   void AddRtpHeaderExtensions(
       const RTPVideoHeader& video_header,
       const absl::optional<AbsoluteCaptureTime>& absolute_capture_time,
@@ -164,6 +184,11 @@ class RTPSenderVideo {
   void MaybeUpdateCurrentPlayoutDelay(const RTPVideoHeader& header)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(send_checker_);
 
+  void UpdateKeyFrameChain(
+      bool is_key_frame,
+      bool allow_retransmission,
+      const std::vector<std::unique_ptr<RtpPacketToSend>>& packets);
+
   RTPSender* const rtp_sender_;
   Clock* const clock_;
 
@@ -187,6 +212,15 @@ class RTPSenderVideo {
   // Should never be held when calling out of this class.
   rtc::CriticalSection crit_;
 
+  // The media packets of the last key frame and of the frames which followed.
+  struct KeyFrameChain {
+    int64_t key_frame_time_ms = 0;
+    std::vector<uint16_t> sequence_numbers;
+    size_t size_bytes = 0;
+  };
+  const bool key_frame_chain_retransmission_;
+  absl::optional<KeyFrameChain> key_frame_chain_ RTC_GUARDED_BY(crit_);
+
   const absl::optional<int> red_payload_type_;
   VideoFecGenerator* const fec_generator_;
   absl::optional<VideoFecGenerator::FecType> fec_type_;
@@ -204,12 +238,17 @@ class RTPSenderVideo {
 
   // E2EE Custom Video Frame Encryptor (optional)
   FrameEncryptorInterface* const frame_encryptor_ = nullptr;
+  // The encrypted payload of the frame being sent. Kept between frames so its
+  // capacity is reused, the packetizer copies the payload into the packets.
+  rtc::Buffer encrypted_payload_ RTC_GUARDED_BY(send_checker_);
   // If set to true will require all outgoing frames to pass through an
   // initialized frame_encryptor_ before being sent out of the network.
   // Otherwise these payloads will be dropped.
   const bool require_frame_encryption_;
   // Set to true if the generic descriptor should be authenticated.
   const bool generic_descriptor_auth_experiment_;
+  // Set to true if the packets may reference the encoded images.
+  const bool zero_copy_packetization_;
 
   AbsoluteCaptureTimeSender absolute_capture_time_sender_;
 
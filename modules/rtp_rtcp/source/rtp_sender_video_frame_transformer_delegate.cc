@@ -10,6 +10,9 @@
 
 #include "modules/rtp_rtcp/source/rtp_sender_video_frame_transformer_delegate.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -30,6 +33,14 @@ std::unique_ptr<RTPFragmentationHeader> CreateFragmentationHeader(
   return ret;
 }
 
+// The encoded data of |encoded_image|, copied only if the image doesn't own it.
+rtc::scoped_refptr<EncodedImageBufferInterface> SharedEncodedData(
+    const EncodedImage& encoded_image) {
+  if (encoded_image.GetEncodedData())
+    return encoded_image.GetEncodedData();
+  return EncodedImageBuffer::Create(encoded_image.data(), encoded_image.size());
+}
+
 class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
  public:
   TransformableVideoSenderFrame(
@@ -41,7 +52,7 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
       const RTPFragmentationHeader* fragmentation_header,
       absl::optional<int64_t> expected_retransmission_time_ms,
       uint32_t ssrc)
-      : encoded_data_(encoded_image.GetEncodedData()),
+      : encoded_data_(SharedEncodedData(encoded_image)),
         header_(video_header),
         frame_type_(encoded_image._frameType),
         payload_type_(payload_type),
@@ -61,7 +72,22 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
   }
 
   void SetData(rtc::ArrayView<const uint8_t> data) override {
-    encoded_data_ = EncodedImageBuffer::Create(data.data(), data.size());
+    owned_data_ = EncodedImageBuffer::Create(data.data(), data.size());
+    encoded_data_ = owned_data_;
+  }
+
+  rtc::ArrayView<uint8_t> GetMutableData(size_t size) override {
+    if (!owned_data_ || size == 0) {
+      // The encoded data may still be read by the encoder or the other sinks
+      // of the encoded image, so it's copied before its first modification.
+      owned_data_ = EncodedImageBuffer::Create(size);
+      memcpy(owned_data_->data(), encoded_data_->data(),
+             std::min(size, encoded_data_->size()));
+      encoded_data_ = owned_data_;
+    } else if (owned_data_->size() != size) {
+      owned_data_->Realloc(size);
+    }
+    return rtc::ArrayView<uint8_t>(owned_data_->data(), owned_data_->size());
   }
 
   uint32_t GetTimestamp() const override { return timestamp_; }
@@ -90,6 +116,8 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
 
  private:
   rtc::scoped_refptr<EncodedImageBufferInterface> encoded_data_;
+  // Set once |encoded_data_| is a buffer of this frame's own.
+  rtc::scoped_refptr<EncodedImageBuffer> owned_data_;
   const RTPVideoHeader header_;
   const VideoFrameType frame_type_;
   const int payload_type_;
@@ -133,6 +161,12 @@ bool RTPSenderVideoFrameTransformerDelegate::TransformFrame(
 
 void RTPSenderVideoFrameTransformerDelegate::OnTransformedFrame(
     std::unique_ptr<TransformableFrameInterface> frame) {
+  // A transformer running synchronously calls back from within
+  // TransformFrame(), the frame is then sent without a thread hop.
+  if (encoder_queue_ && encoder_queue_->IsCurrent()) {
+    SendVideo(std::move(frame));
+    return;
+  }
   rtc::CritScope lock(&sender_lock_);
 
   // The encoder queue gets destroyed after the sender; as long as the sender is
@@ -875,6 +875,74 @@ TEST_P(RtpSenderVideoTest, PopulatesPlayoutDelay) {
   EXPECT_EQ(received_delay, kExpectedDelay);
 }
 
+class KeyFrameChainFieldTrials : public WebRtcKeyValueConfig {
+ public:
+  std::string Lookup(absl::string_view key) const override {
+    return key == "WebRTC-KeyFrameChainRetransmission" ? "Enabled" : "";
+  }
+};
+
+TEST_P(RtpSenderVideoTest, RetransmitsTheKeyFrameChainOnce) {
+  uint8_t kFrame[100] = {};
+  KeyFrameChainFieldTrials field_trials;
+  RTPSenderVideo::Config config;
+  config.clock = &fake_clock_;
+  config.rtp_sender = rtp_module_->RtpSender();
+  config.field_trials = &field_trials;
+  RTPSenderVideo rtp_sender_video(config);
+  rtp_module_->SetStorePacketsStatus(true, 10);
+
+  RTPVideoHeader hdr;
+  hdr.frame_type = VideoFrameType::kVideoFrameKey;
+  rtp_sender_video.SendVideo(kPayload, kType, kTimestamp, 0, kFrame, nullptr,
+                             hdr, kDefaultExpectedRetransmissionTimeMs);
+  hdr.frame_type = VideoFrameType::kVideoFrameDelta;
+  rtp_sender_video.SendVideo(kPayload, kType, kTimestamp + 3000, 0, kFrame,
+                             nullptr, hdr,
+                             kDefaultExpectedRetransmissionTimeMs);
+  ASSERT_EQ(2, transport_.packets_sent());
+
+  fake_clock_.AdvanceTimeMilliseconds(100);
+  EXPECT_TRUE(rtp_sender_video.RetransmitKeyFrameChain());
+  ASSERT_EQ(4, transport_.packets_sent());
+  EXPECT_EQ(transport_.sent_packets()[0].SequenceNumber(),
+            transport_.sent_packets()[2].SequenceNumber());
+  EXPECT_EQ(transport_.sent_packets()[1].SequenceNumber(),
+            transport_.sent_packets()[3].SequenceNumber());
+  // A new key frame is needed if the receiver still asks for one.
+  EXPECT_FALSE(rtp_sender_video.RetransmitKeyFrameChain());
+}
+
+TEST_P(RtpSenderVideoTest, DoesNotRetransmitAnOldKeyFrameChain) {
+  uint8_t kFrame[100] = {};
+  KeyFrameChainFieldTrials field_trials;
+  RTPSenderVideo::Config config;
+  config.clock = &fake_clock_;
+  config.rtp_sender = rtp_module_->RtpSender();
+  config.field_trials = &field_trials;
+  RTPSenderVideo rtp_sender_video(config);
+  rtp_module_->SetStorePacketsStatus(true, 10);
+
+  RTPVideoHeader hdr;
+  hdr.frame_type = VideoFrameType::kVideoFrameKey;
+  rtp_sender_video.SendVideo(kPayload, kType, kTimestamp, 0, kFrame, nullptr,
+                             hdr, kDefaultExpectedRetransmissionTimeMs);
+  fake_clock_.AdvanceTimeMilliseconds(2000);
+  EXPECT_FALSE(rtp_sender_video.RetransmitKeyFrameChain());
+  EXPECT_EQ(1, transport_.packets_sent());
+}
+
+TEST_P(RtpSenderVideoTest, KeyFrameChainIsNotRetransmittedByDefault) {
+  uint8_t kFrame[100] = {};
+  rtp_module_->SetStorePacketsStatus(true, 10);
+  RTPVideoHeader hdr;
+  hdr.frame_type = VideoFrameType::kVideoFrameKey;
+  rtp_sender_video_.SendVideo(kPayload, kType, kTimestamp, 0, kFrame, nullptr,
+                              hdr, kDefaultExpectedRetransmissionTimeMs);
+  fake_clock_.AdvanceTimeMilliseconds(100);
+  EXPECT_FALSE(rtp_sender_video_.RetransmitKeyFrameChain());
+}
+
 INSTANTIATE_TEST_SUITE_P(WithAndWithoutOverhead,
                          RtpSenderVideoTest,
                          ::testing::Bool());
@@ -989,5 +1057,46 @@ TEST_F(RtpSenderVideoWithFrameTransformerTest, OnTransformedFrameSendsVideo) {
   EXPECT_EQ(transport_.packets_sent(), 1);
 }
 
+TEST_F(RtpSenderVideoWithFrameTransformerTest,
+       SendsFrameTransformedInPlaceSynchronously) {
+  rtc::scoped_refptr<MockFrameTransformer> mock_frame_transformer =
+      new rtc::RefCountedObject<NiceMock<MockFrameTransformer>>();
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  std::unique_ptr<RTPSenderVideo> rtp_sender_video =
+      CreateSenderWithFrameTransformer(mock_frame_transformer);
+  ASSERT_TRUE(callback);
+
+  auto encoded_image = CreateDefaultEncodedImage();
+  RTPVideoHeader video_header;
+  video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  ON_CALL(*mock_frame_transformer, Transform)
+      .WillByDefault(
+          [&](std::unique_ptr<TransformableFrameInterface> frame) {
+            // The frame shares the encoded image data until it's modified.
+            EXPECT_EQ(encoded_image->data(), frame->GetData().data());
+            rtc::ArrayView<uint8_t> data = frame->GetMutableData(5);
+            ASSERT_EQ(5u, data.size());
+            EXPECT_NE(encoded_image->data(), data.data());
+            EXPECT_EQ(4, data[3]);
+            data[4] = 5;
+            EXPECT_EQ(data.data(), frame->GetMutableData(5).data());
+            callback->OnTransformedFrame(std::move(frame));
+          });
+  TaskQueueForTest encoder_queue;
+  encoder_queue.SendTask(
+      [&] {
+        rtp_sender_video->SendEncodedImage(
+            kPayload, kType, kTimestamp, *encoded_image, nullptr, video_header,
+            kDefaultExpectedRetransmissionTimeMs);
+        // Sent without a task being posted to the encoder queue.
+        EXPECT_EQ(transport_.packets_sent(), 1);
+      },
+      RTC_FROM_HERE);
+  EXPECT_EQ(encoded_image->size(), 4u);
+  EXPECT_EQ(encoded_image->data()[3], 4);
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -16,19 +16,21 @@
 #include "api/array_view.h"
 #include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
 rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::AssembleFrame(
-    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads) {
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads,
+    EncodedImageBufferPool* buffer_pool) {
   size_t frame_size = 0;
   for (rtc::ArrayView<const uint8_t> payload : rtp_payloads) {
     frame_size += payload.size();
   }
 
   rtc::scoped_refptr<EncodedImageBuffer> bitstream =
-      EncodedImageBuffer::Create(frame_size);
+      CreateBuffer(frame_size, buffer_pool);
 
   uint8_t* write_at = bitstream->data();
   for (rtc::ArrayView<const uint8_t> payload : rtp_payloads) {
@@ -39,4 +41,12 @@ rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::AssembleFrame(
   return bitstream;
 }
 
+rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::CreateBuffer(
+    size_t size,
+    EncodedImageBufferPool* buffer_pool) {
+  if (buffer_pool)
+    return buffer_pool->CreateBuffer(size);
+  return EncodedImageBuffer::Create(size);
+}
+
 }  // namespace webrtc
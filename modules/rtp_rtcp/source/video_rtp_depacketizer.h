@@ -11,6 +11,7 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H_
 #define MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "absl/types/optional.h"
@@ -22,6 +23,8 @@
 
 namespace webrtc {
 
+class EncodedImageBufferPool;
+
 class VideoRtpDepacketizer {
  public:
   struct ParsedRtpPayload {
@@ -32,8 +35,21 @@ class VideoRtpDepacketizer {
   virtual ~VideoRtpDepacketizer() = default;
   virtual absl::optional<ParsedRtpPayload> Parse(
       rtc::CopyOnWriteBuffer rtp_payload) = 0;
+  // Writes the frame into a buffer from |buffer_pool|, or into a new buffer if
+  // it is null.
   virtual rtc::scoped_refptr<EncodedImageBuffer> AssembleFrame(
-      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads);
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads,
+      EncodedImageBufferPool* buffer_pool);
+  rtc::scoped_refptr<EncodedImageBuffer> AssembleFrame(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads) {
+    return AssembleFrame(rtp_payloads, /*buffer_pool=*/nullptr);
+  }
+
+ protected:
+  // A buffer of |size| bytes from |buffer_pool|, or a new one if it is null.
+  static rtc::scoped_refptr<EncodedImageBuffer> CreateBuffer(
+      size_t size,
+      EncodedImageBufferPool* buffer_pool);
 };
 
 }  // namespace webrtc
@@ -336,7 +336,8 @@ bool CalculateObuSizes(ObuInfo* obu_info) {
 }  // namespace
 
 rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizerAv1::AssembleFrame(
-    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads) {
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads,
+    EncodedImageBufferPool* buffer_pool) {
   VectorObuInfo obu_infos = ParseObus(rtp_payloads);
   if (obu_infos.empty()) {
     return nullptr;
@@ -351,7 +352,7 @@ rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizerAv1::AssembleFrame(
   }
 
   rtc::scoped_refptr<EncodedImageBuffer> bitstream =
-      EncodedImageBuffer::Create(frame_size);
+      CreateBuffer(frame_size, buffer_pool);
   uint8_t* write_at = bitstream->data();
   for (const ObuInfo& obu_info : obu_infos) {
     // Copy the obu_header and obu_size fields.
@@ -30,9 +30,10 @@ class VideoRtpDepacketizerAv1 : public VideoRtpDepacketizer {
   VideoRtpDepacketizerAv1& operator=(const VideoRtpDepacketizerAv1&) = delete;
   ~VideoRtpDepacketizerAv1() override = default;
 
+  using VideoRtpDepacketizer::AssembleFrame;
   rtc::scoped_refptr<EncodedImageBuffer> AssembleFrame(
-      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads)
-      override;
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads,
+      EncodedImageBufferPool* buffer_pool) override;
 
   absl::optional<ParsedRtpPayload> Parse(
       rtc::CopyOnWriteBuffer rtp_payload) override;
@@ -11,11 +11,36 @@
 #define ONNXInferInterface_DLL_EXPORT_IMPORT_
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
     namespace onnxinfer {
 
+#pragma pack(push, 1)
+        // Per-packet input of the model, see OnReceived() for the meaning of
+        // each field. Fields are ordered by size and padded to a multiple of
+        // 8 bytes, so that the packed layout is also naturally aligned in an
+        // array.
+        struct PacketFeature {
+            uint64_t arrivalTimestamp; // ms
+            uint32_t sendTimestamp; // ms
+            uint32_t ssrc;
+            uint32_t paddingLength;
+            uint32_t headerLength;
+            uint32_t payloadSize; // bytes
+            int32_t lossCount; // packet, -1 indicates no valid lossCount from RTC
+            float rtt; // sec, -1 indicates no valid rtt from RTC
+            uint16_t sequenceNumber;
+            uint8_t payloadType;
+            uint8_t reserved; // must be 0
+        };
+#pragma pack(pop)
+        static_assert(sizeof(PacketFeature) == 40,
+                      "PacketFeature must stay naturally aligned");
+
         ONNXInferInterface_DLL_EXPORT_IMPORT_
             void OnReceived(
                 void* onnx_infer_interface,
@@ -30,6 +55,15 @@ extern "C" {
                 int lossCount, // packet, -1 indicates no valid lossCount from RTC
                 float rtt); // sec, -1 indicates no valid rtt from RTC
 
+        // Equivalent to calling OnReceived() for each of the |count| entries
+        // of |features|, in order, but crosses the library boundary once.
+        // Not exported by the prebuilt binaries yet; the onnxinfer_batch
+        // target provides it on top of OnReceived() in the meantime.
+        void OnReceivedBatch(
+            void* onnx_infer_interface,
+            const PacketFeature* features,
+            size_t count);
+
         ONNXInferInterface_DLL_EXPORT_IMPORT_
             float GetBweEstimate(void* onnx_infer_interface); // bps
 
@@ -45,6 +79,72 @@ extern "C" {
         ONNXInferInterface_DLL_EXPORT_IMPORT_
             void DestroyONNXInferInterface(void* onnx_infer_interface);
 
+        // A loaded model and its ONNXRuntime session, which any number of
+        // inference interfaces can share. Each interface created from a model
+        // only owns the recurrent state and feature window of one call.
+        // Not exported by the prebuilt binaries yet; unless the gn arg
+        // onnxinfer_has_model_api is set, the onnxinfer_batch target provides
+        // fallbacks, which still load the model once per interface.
+        void* CreateONNXInferModel(const char* model_path);
+
+        void DestroyONNXInferModel(void* onnx_infer_model);
+
+        // ONNXRuntime session settings of a model, see ModelOptions.
+        enum ExecutionProvider : int32_t {
+            kExecutionProviderCpu = 0,
+            kExecutionProviderOpenVino = 1,
+            kExecutionProviderCuda = 2,
+        };
+        // The values of ONNXRuntime's GraphOptimizationLevel.
+        enum GraphOptimizationLevel : int32_t {
+            kGraphOptimizationDisabled = 0,
+            kGraphOptimizationBasic = 1,
+            kGraphOptimizationExtended = 2,
+            kGraphOptimizationAll = 99,
+        };
+        struct ModelOptions {
+            // Threads of the session's intra-op and inter-op thread pools,
+            // 0 for ONNXRuntime's default.
+            int32_t intraOpNumThreads;
+            int32_t interOpNumThreads;
+            // Run on the thread pools of the process wide ONNXRuntime
+            // environment, shared by every model created with this set,
+            // instead of on pools of the session's own. The thread counts
+            // then size the shared pools, as set by the first such model.
+            bool useGlobalThreadPools;
+            // Falls back to the CPU if the provider is not available.
+            ExecutionProvider executionProvider;
+            GraphOptimizationLevel graphOptimizationLevel;
+            // If not null nor empty, the optimized model is loaded from this
+            // file if it exists and saved to it otherwise, so that the
+            // optimizations only run once.
+            const char* optimizedModelPath;
+        };
+
+        // Same as CreateONNXInferModel(), but with the session set up as
+        // |options| says. Part of the model API above; its fallback ignores
+        // |options|.
+        void* CreateONNXInferModelWithOptions(
+            const char* model_path,
+            const ModelOptions* options);
+
+        // |onnx_infer_model| must outlive the returned interface, which is
+        // destroyed with DestroyONNXInferInterface().
+        void* CreateONNXInferInterfaceFromModel(void* onnx_infer_model);
+
+        // Computes the estimates of the |count| interfaces in
+        // |onnx_infer_interfaces|, all created from |onnx_infer_model|, in a
+        // single run of the model whose batch dimension is the interfaces,
+        // and writes them to |estimates| in the same order, in bps.
+        // Not exported by the prebuilt binaries yet; the onnxinfer_batch
+        // target provides a fallback in the meantime, which still runs the
+        // model once per interface.
+        void GetBweEstimateBatch(
+            void* onnx_infer_model,
+            void* const* onnx_infer_interfaces,
+            size_t count,
+            float* estimates);
+
     } //namespace onnxinfer
 #ifdef __cplusplus
 } //extern "C"
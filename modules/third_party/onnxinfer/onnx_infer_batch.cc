@@ -0,0 +1,31 @@
+// Fallback implementations of onnxinfer::OnReceivedBatch() and
+// onnxinfer::GetBweEstimateBatch() for prebuilt onnxinfer libraries that only
+// export the per-packet OnReceived() and per-call GetBweEstimate() entry
+// points. Remove this file once the shipped binaries export the batch API.
+
+#include "ONNXInferInterface.h"
+
+namespace onnxinfer {
+
+void OnReceivedBatch(void* onnx_infer_interface,
+                     const PacketFeature* features,
+                     size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const PacketFeature& feature = features[i];
+    OnReceived(onnx_infer_interface, feature.payloadType,
+               feature.sequenceNumber, feature.sendTimestamp, feature.ssrc,
+               feature.paddingLength, feature.headerLength,
+               feature.arrivalTimestamp, feature.payloadSize,
+               feature.lossCount, feature.rtt);
+  }
+}
+
+void GetBweEstimateBatch(void* onnx_infer_model,
+                         void* const* onnx_infer_interfaces,
+                         size_t count,
+                         float* estimates) {
+  for (size_t i = 0; i < count; ++i)
+    estimates[i] = GetBweEstimate(onnx_infer_interfaces[i]);
+}
+
+}  // namespace onnxinfer
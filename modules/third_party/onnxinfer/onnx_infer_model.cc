@@ -0,0 +1,57 @@
+// Fallback implementation of the shared model entry points for prebuilt
+// onnxinfer libraries that only export CreateONNXInferInterface(). The model
+// only remembers its path and every interface loads its own session, so
+// callers get the shared model API but neither its memory savings nor its
+// session options. Left out of the build when the gn arg
+// onnxinfer_has_model_api is set, since these definitions would collide with
+// the exports of a libonnxinfer implementing the model API.
+
+#include <atomic>
+#include <string>
+
+#include "ONNXInferInterface.h"
+#include "rtc_base/logging.h"
+
+namespace onnxinfer {
+namespace {
+
+struct FallbackModel {
+  std::string model_path;
+};
+
+bool HasDefaultValues(const ModelOptions& options) {
+  return options.intraOpNumThreads == 0 && options.interOpNumThreads == 0 &&
+         !options.useGlobalThreadPools &&
+         options.executionProvider == kExecutionProviderCpu &&
+         options.graphOptimizationLevel == kGraphOptimizationAll &&
+         (!options.optimizedModelPath || !*options.optimizedModelPath);
+}
+
+}  // namespace
+
+void* CreateONNXInferModel(const char* model_path) {
+  return new FallbackModel{model_path};
+}
+
+void* CreateONNXInferModelWithOptions(const char* model_path,
+                                      const ModelOptions* options) {
+  // The sessions of CreateONNXInferInterface() can't be configured.
+  static std::atomic<bool> warned(false);
+  if (options && !HasDefaultValues(*options) && !warned.exchange(true)) {
+    RTC_LOG(LS_WARNING) << "The ONNX model options are ignored, the onnxinfer "
+                           "library doesn't export "
+                           "CreateONNXInferModelWithOptions().";
+  }
+  return CreateONNXInferModel(model_path);
+}
+
+void DestroyONNXInferModel(void* onnx_infer_model) {
+  delete static_cast<FallbackModel*>(onnx_infer_model);
+}
+
+void* CreateONNXInferInterfaceFromModel(void* onnx_infer_model) {
+  return CreateONNXInferInterface(
+      static_cast<FallbackModel*>(onnx_infer_model)->model_path.c_str());
+}
+
+}  // namespace onnxinfer
@@ -1,6 +1,7 @@
 /**
  * @file      StatCollect.h
- * @brief     The header file of StatsCollectModule. StatsCollectModule is provided for RTC application to update their states to local file for states collection and training.
+ * @brief     The stats collection definitions shared by the recorders of StatRecorder.h: the result codes, the
+ *            SC_*_EMPTY sentinels of the fields that are not collected and the layout of the collected stats.
  * @repo      AlphaRTC
  * @author    Kangjie Xu <xkjrst@outlook.com>
  * @author    Dan Yang <v-danya@microsoft.com>
@@ -13,10 +14,6 @@
 #ifndef STATES_COLLECTION_H_
 #define STATES_COLLECTION_H_
 
-#include <memory>
-#include <queue>
-#include <vector>
-#include <mutex>
 #include <float.h>
 #include <climits>
 
@@ -40,16 +37,7 @@ namespace StatCollect {
         SC_CONNECT_EXIST_ERROR = 0x10010001,
         SC_SESSION_ERROR = 0x10020000,
         SC_SAVE_ERROR = 0x10030000,
-    };
-
-    /**
-     ** The type of queue in StatCollect (collectQueue_)
-     ** SC_TYPE_STRUCT: collectQueue_ will use sturture to store states
-     ** SC_TYPE_JSON: collectQueue_ will use json to store states
-    **/
-    enum SCType {
-        SC_TYPE_STRUCT = 0,
-        SC_TYPE_JSON = 1,
+        SC_BUFFER_FULL_ERROR = 0x10040000,
     };
 
     /**
@@ -193,364 +181,5 @@ namespace StatCollect {
         double    pacerPacingRate;
         double    pacerPaddingRate;
     };
-
-    class StatsCollectModule {
-    public:
-        /**
-         **========================================================
-         ** StatsCollectInterface External Function StatsCollectModule
-         **========================================================
-        */
-        /**
-        ** The constructor function of StatsCollectModule class
-        ** @param  SCType       collectType,  The collect type
-        */
-        StatsCollectModule(SCType collectType);
-        
-        /**
-        **========================================================
-        ** StatsCollectInterface External Function !StatsCollectModule
-        **========================================================
-        */
-        /**
-        ** The destructor function of StatsCollectModule class
-        */
-        ~StatsCollectModule();
-
-        /**
-         **========================================================
-         ** StatsCollectInterface External Function StatsCollect
-         **========================================================
-        */
-        /**
-         ** Collect the pakcet info ,video info, audio info from RTC Program
-         ** Just Put the collect info in a buffer queue.
-         ** @param   double        pacerPacingRate,   the pacer pacing rate
-         ** @param   double        pacerPaddingRate,  the pacer padding rate
-         ** //Pakcet Info
-         ** @param  unsigned char  payloadType,       the RTP header Payload Type
-         ** @param  unsigned short sequenceNumber,    the RTP header Sequence Number
-         ** @param  unsigned int   sendTimestamp,     the RTP header send timestamp
-         ** @param  unsigned int   ssrc,              the RTP header ssrc
-         ** @param  unsigned long  paddingLength,     the RTP header Padding size
-         ** @param  unsigned long  headerLength,      the RTP header Header size
-         ** @param  long long      arrivalTimeMs,     the RTP packet receive timestamp
-         ** @param  unsigned long  payloadSize,       the RTP pakcet data size
-         ** @param  float          lossRate,          the loss rate of pakcet size
-            //Video Info
-         ** @param  unsigned long framesCaptured,                     the video frames between captured and encoders
-         ** @param  unsigned long framesSent,                         the video frames of sender sent.
-         ** @param  unsigned long hugeFramesSent,                     the video huge frames of sender sent.
-         ** @param  unsigned long keyFramesSent,                      the video key frames of sender sent.
-         ** @param  double        videoJitterBufferDelay,             the video receiver jitterBuffer Delay.
-         ** @param  unsigned long long videoJitterBufferEmittedCount, the video receiver jitterBuffer Emitted Count.
-         ** @param  unsigned long framesReceived,                     the video frames of receiver received.
-         ** @param  unsigned long keyFramesReceived,                  the video key frames of receiver received.
-         ** @param  unsigned long framesDecoded,                      the video frames of receiver decoder decoded.
-         ** @param  unsigned long framesDropped,                      the video frames of receiver decoder droped.
-         ** @param  unsigned long partialFramesLost,                  the video frames of receiver multi frame partial lost.
-         ** @param  unsigned long fullFramesLost,                     the video frames of receiver multi frame fully lost.
-            //Audio Info
-         ** @param  double             echoReturnLoss,                the audio loss for echo cancellation
-         ** @param  double             echoReturnLossEnhancement,     the enhancement for echo  audio cancellation
-         ** @param  unsigned long      long totalSamplesSent,         the count of audio frames sender sent
-         ** @param  unsigned long long estimatedPlayoutTimestamp,     the timestamp of estimate audio playout buffer
-         ** @param  double             audioJitterBufferDelay,        the audio receiver jitterBuffer Delay.
-         ** @param  unsigned long long audioJitterBufferEmittedCount, the audio receiver jitterBuffer Emitted Count.
-         ** @param  unsigned long long totalSamplesReceived,          the audio frames of receiver received
-         ** @param  unsigned long long concealedSamples,              the audio samples of receiver received
-         ** @param  unsigned long long concealmentEvents,             the audio samples event of receiver received
-         **
-         ** return: SC_SUCCESS             if successfully created
-                    SC_COLLECT_TYPE_ERROR  if the collect type error.
-                    SC_NEW_MEMORY_FAIL     if the new memory fail
-        */
-        SCResult StatsCollect(
-            double             pacerPacingRate,
-            double             pacerPaddingRate,
-            //Packet Info
-            unsigned char      payloadType,
-            unsigned short     sequenceNumber,
-            unsigned int       sendTimestamp,
-            unsigned int       ssrc,
-            unsigned long      paddingLength,
-            unsigned long      headerLength,
-            unsigned long long arrivalTimeMs,
-            unsigned long      payloadSize,
-            float              lossRate,
-            // Video Info
-            unsigned long      framesCaptured,
-            unsigned long      framesSent,
-            unsigned long      hugeFramesSent,
-            unsigned long      keyFramesSent,
-            double             videoJitterBufferDelay,
-            unsigned long long videoJitterBufferEmittedCount,
-            unsigned long      framesReceived,
-            unsigned long      keyFramesReceived,
-            unsigned long      framesDecoded,
-            unsigned long      framesDropped,
-            unsigned long      partialFramesLost,
-            unsigned long      fullFramesLost,
-            // Audio Info
-            double             echoReturnLoss,
-            double             echoReturnLossEnhancement,
-            unsigned long long totalSamplesSent,
-            long long          estimatedPlayoutTimestamp,
-            double             audioJitterBufferDelay,
-            unsigned long long audioJitterBufferEmittedCount,
-            unsigned long long totalSamplesReceived,
-            unsigned long long concealedSamples,
-            unsigned long long concealmentEvents);
-        
-        /**
-         **========================================================
-         ** StatsCollectInterface External Function StatsCollect
-         **========================================================
-        */
-        /**
-         ** Collect the pakcet info ,video info, audio info from RTC Program
-         ** Just Put the collect info in a buffer queue.
-         ** @param  int            collectType,       the collect type, 0 means struct, 1 means json.
-         ** @param  double         pacerPacingRate,   the pacer pacing rate
-         ** @param  double         pacerPaddingRate,  the pacer padding rate
-         ** //Pakcet Info
-         ** @param  unsigned char  payloadType,       the RTP header Payload Type
-         ** @param  unsigned short sequenceNumber,    the RTP header Sequence Number
-         ** @param  unsigned int   sendTimestamp,     the RTP header send timestamp
-         ** @param  unsigned int   ssrc,              the RTP header ssrc
-         ** @param  unsigned long  paddingLength,     the RTP header Padding size
-         ** @param  unsigned long  headerLength,      the RTP header Header size
-         ** @param  long long      arrivalTimeMs,     the RTP packet receive timestamp
-         ** @param  unsigned long  payloadSize,       the RTP pakcet data size
-         ** @param  float          lossRate,          the loss rate of pakcet size
-         **
-         ** return: SC_SUCCESS             if successfully created
-                    SC_COLLECT_TYPE_ERROR  if the collect type error.
-                    SC_NEW_MEMORY_FAIL     if the new memory fail
-        */
-        SCResult StatsCollect(
-            double             pacerPacingRate,
-            double             pacerPaddingRate,
-            //Packet Info
-            unsigned char      payloadType,
-            unsigned short     sequenceNumber,
-            unsigned int       sendTimestamp,
-            unsigned int       ssrc,
-            unsigned long      paddingLength,
-            unsigned long      headerLength,
-            unsigned long long arrivalTimeMs,
-            unsigned long      payloadSize,
-            float              lossRate
-        );
-
-        /**
-         **========================================================
-         ** StatsCollectInterface External Function StatsCollectByStruct
-         **========================================================
-        */
-        /**
-         ** Collect the pakcet info ,video info, audio info from RTC Program
-         ** Just Put the collect info in a buffer queue.
-         ** @param  double         pacerPacingRate,   the pacer pacing rate
-         ** @param  double         pacerPaddingRate,  the pacer padding rate
-         ** //Pakcet Info
-         ** @param  unsigned char  payloadType,       the RTP header Payload Type
-         ** @param  unsigned short sequenceNumber,    the RTP header Sequence Number
-         ** @param  unsigned int   sendTimestamp,     the RTP header send timestamp
-         ** @param  unsigned int   ssrc,              the RTP header ssrc
-         ** @param  unsigned long  paddingLength,     the RTP header Padding size
-         ** @param  unsigned long  headerLength,      the RTP header Header size
-         ** @param  long long      arrivalTimeMs,     the RTP packet receive timestamp
-         ** @param  unsigned long  payloadSize,       the RTP pakcet data size
-         ** @param  float          lossRate,          the loss rate of pakcet size
-            //Video Info
-         ** @param  unsigned long framesCaptured,                     the video frames between captured and encoders
-         ** @param  unsigned long framesSent,                         the video frames of sender sent.
-         ** @param  unsigned long hugeFramesSent,                     the video huge frames of sender sent.
-         ** @param  unsigned long keyFramesSent,                      the video key frames of sender sent.
-         ** @param  double        videoJitterBufferDelay,             the video receiver jitterBuffer Delay.
-         ** @param  unsigned long long videoJitterBufferEmittedCount, the video receiver jitterBuffer Emitted Count.
-         ** @param  unsigned long framesReceived,                     the video frames of receiver received.
-         ** @param  unsigned long keyFramesReceived,                  the video key frames of receiver received.
-         ** @param  unsigned long framesDecoded,                      the video frames of receiver decoder decoded.
-         ** @param  unsigned long framesDropped,                      the video frames of receiver decoder droped.
-         ** @param  unsigned long partialFramesLost,                  the video frames of receiver multi frame partial lost.
-         ** @param  unsigned long fullFramesLost,                     the video frames of receiver multi frame fully lost.
-            //Audio Info
-         ** @param  double             echoReturnLoss,                the audio loss for echo cancellation
-         ** @param  double             echoReturnLossEnhancement,     the enhancement for echo  audio cancellation
-         ** @param  unsigned long      long totalSamplesSent,         the count of audio frames sender sent
-         ** @param  unsigned long long estimatedPlayoutTimestamp,     the timestamp of estimate audio playout buffer
-         ** @param  double             audioJitterBufferDelay,        the audio receiver jitterBuffer Delay.
-         ** @param  unsigned long long audioJitterBufferEmittedCount, the audio receiver jitterBuffer Emitted Count.
-         ** @param  unsigned long long totalSamplesReceived,          the audio frames of receiver received
-         ** @param  unsigned long long concealedSamples,              the audio samples of receiver received
-         ** @param  unsigned long long concealmentEvents,             the audio samples event of receiver received
-         **
-         ** return: struct Collect info pointer  if successfully created
-                    NULL                         if failed.
-        */
-        struct CollectInfo* StatsCollectByStruct(
-            double             pacerPacingRate,
-            double             pacerPaddingRate,
-            //Packet Info
-            unsigned char      payloadType,
-            unsigned short     sequenceNumber,
-            unsigned int       sendTimestamp,
-            unsigned int       ssrc,
-            unsigned long      paddingLength,
-            unsigned long      headerLength,
-            unsigned long long arrivalTimeMs,
-            unsigned long      payloadSize,
-            float              lossRate,
-            // Video Info
-            unsigned long      framesCaptured,
-            unsigned long      framesSent,
-            unsigned long      hugeFramesSent,
-            unsigned long      keyFramesSent,
-            double             videoJitterBufferDelay,
-            unsigned long long videoJitterBufferEmittedCount,
-            unsigned long      framesReceived,
-            unsigned long      keyFramesReceived,
-            unsigned long      framesDecoded,
-            unsigned long      framesDropped,
-            unsigned long      partialFramesLost,
-            unsigned long      fullFramesLost,
-            // Audio Info
-            double             echoReturnLoss,
-            double             echoReturnLossEnhancement,
-            unsigned long long totalSamplesSent,
-            long long          estimatedPlayoutTimestamp,
-            double             audioJitterBufferDelay,
-            unsigned long long audioJitterBufferEmittedCount,
-            unsigned long long totalSamplesReceived,
-            unsigned long long concealedSamples,
-            unsigned long long concealmentEvents);
-
-        /*
-         **========================================================
-         ** StatsCollectInterface External Function StatsCollectByJSON
-         **========================================================
-        */
-        /**
-         ** Collect the pakcet info ,video info, audio info from RTC Program
-         ** Just Put the collect info in a buffer queue.
-         ** @param  double         pacerPacingRate,   the pacer pacing rate
-         ** @param  double         pacerPaddingRate,  the pacer padding rate
-         ** //Pakcet Info
-         ** @param  unsigned char  payloadType,       the RTP header Payload Type
-         ** @param  unsigned short sequenceNumber,    the RTP header Sequence Number
-         ** @param  unsigned int   sendTimestamp,     the RTP header send timestamp
-         ** @param  unsigned int   ssrc,              the RTP header ssrc
-         ** @param  unsigned long  paddingLength,     the RTP header Padding size
-         ** @param  unsigned long  headerLength,      the RTP header Header size
-         ** @param  long long      arrivalTimeMs,     the RTP packet receive timestamp
-         ** @param  unsigned long  payloadSize,       the RTP pakcet data size
-         ** @param  float          lossRate,          the loss rate of pakcet size
-           //Video Info
-         ** @param  unsigned long framesCaptured,                     the video frames between captured and encoders
-         ** @param  unsigned long framesSent,                         the video frames of sender sent.
-         ** @param  unsigned long hugeFramesSent,                     the video huge frames of sender sent.
-         ** @param  unsigned long keyFramesSent,                      the video key frames of sender sent.
-         ** @param  double        videoJitterBufferDelay,             the video receiver jitterBuffer Delay.
-         ** @param  unsigned long long videoJitterBufferEmittedCount, the video receiver jitterBuffer Emitted Count.
-         ** @param  unsigned long framesReceived,                     the video frames of receiver received.
-         ** @param  unsigned long keyFramesReceived,                  the video key frames of receiver received.
-         ** @param  unsigned long framesDecoded,                      the video frames of receiver decoder decoded.
-         ** @param  unsigned long framesDropped,                      the video frames of receiver decoder droped.
-         ** @param  unsigned long partialFramesLost,                  the video frames of receiver multi frame partial lost.
-         ** @param  unsigned long fullFramesLost,                     the video frames of receiver multi frame fully lost.
-           //Audio Info
-         ** @param  double             echoReturnLoss,                the audio loss for echo cancellation
-         ** @param  double             echoReturnLossEnhancement,     the enhancement for echo  audio cancellation
-         ** @param  unsigned long      long totalSamplesSent,         the count of audio frames sender sent
-         ** @param  unsigned long long estimatedPlayoutTimestamp,     the timestamp of estimate audio playout buffer
-         ** @param  double             audioJitterBufferDelay,        the audio receiver jitterBuffer Delay.
-         ** @param  unsigned long long audioJitterBufferEmittedCount, the audio receiver jitterBuffer Emitted Count.
-         ** @param  unsigned long long totalSamplesReceived,          the audio frames of receiver received
-         ** @param  unsigned long long concealedSamples,              the audio samples of receiver received
-         ** @param  unsigned long long concealmentEvents,             the audio samples event of receiver received
-
-         ** return: json string format   if successfully
-        */
-        std::string StatsCollectByJSON(
-            double             pacerPacingRate,
-            double             pacerPaddingRate,
-            //Packet Info
-            unsigned char      payloadType,
-            unsigned short     sequenceNumber,
-            unsigned int       sendTimestamp,
-            unsigned int       ssrc,
-            unsigned long      paddingLength,
-            unsigned long      headerLength,
-            unsigned long long arrivalTimeMs,
-            unsigned long      payloadSize,
-            float              lossRate,
-            // Video Info
-            unsigned long      framesCaptured,
-            unsigned long      framesSent,
-            unsigned long      hugeFramesSent,
-            unsigned long      keyFramesSent,
-            double             videoJitterBufferDelay,
-            unsigned long long videoJitterBufferEmittedCount,
-            unsigned long      framesReceived,
-            unsigned long      keyFramesReceived,
-            unsigned long      framesDecoded,
-            unsigned long      framesDropped,
-            unsigned long      partialFramesLost,
-            unsigned long      fullFramesLost,
-            // Audio Info
-            double             echoReturnLoss,
-            double             echoReturnLossEnhancement,
-            unsigned long long totalSamplesSent,
-            long long          estimatedPlayoutTimestamp,
-            double             audioJitterBufferDelay,
-            unsigned long long audioJitterBufferEmittedCount,
-            unsigned long long totalSamplesReceived,
-            unsigned long long concealedSamples,
-            unsigned long long concealmentEvents);
-
-        /*
-        **========================================================
-        ** StatsCollectInterface External Function ConvertStructToJSON
-        **========================================================
-        */
-        /**
-         ** Convert the struct to json
-         ** @param  collectInfo* CollectInfoPtr,  the ptr of the struct
-         ** return: json string format   if successfully
-         */
-        std::string ConvertStructToJSON(CollectInfo* CollectInfoPtr);
-
-        /**
-         **========================================================
-         ** StatsCollectInterface External Function SetStatsConfig
-         **========================================================
-         */
-        /**
-         ** Set the Stats Collect config
-         ** @param  SCType         collectType,  the collectType
-         ** return: 
-         **         SC_COLLECT_TYPE_ERROR,if the collect type error.
-         **         SC_SUCCESS,           if the save operate succeed.
-         */
-        SCResult SetStatsConfig(SCType collectType);
-
-        /**
-         **========================================================
-         ** StatsCollectInterface External Function DumpData
-         **========================================================
-         */
-        /**
-         ** Dump packet data
-         ** return: json string format if successfully
-        */
-        std::string DumpData();
-
-    private:
-        std::queue<void*>  collectQueue_;
-        SCType collectType_;
-        std::mutex* queueMutex_;
-    };
 }  // namespace StatCollect
 #endif 
\ No newline at end of file
@@ -0,0 +1,312 @@
+/**
+ * @file      StatRecorder.cpp
+ * @brief     The c++ file of BinaryStatsRecorder, BinaryVideoStatsRecorder and MappedCaptureRing.
+ * @repo      AlphaRTC
+ * @version   0.1
+ * @copyright Copyright (c) Microsoft Corporation. All rights reserved.
+ * @license   Licensed under the MIT License.
+ **/
+
+#include "StatRecorder.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace StatCollect {
+
+    struct SharedFile {
+        explicit SharedFile(FILE* file) : file(file) {}
+        ~SharedFile() {
+            fclose(file);
+        }
+
+        FILE* const file;
+        // Held while writing, so that the records of the recorders don't interleave.
+        std::mutex mutex;
+    };
+
+    namespace {
+        size_t RoundUpToPowerOfTwo(size_t value) {
+            size_t result = 1;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        /**
+         ** Open |filePath| for a recorder, or return the file other recorders already write to.
+         ** Every call of a process records to the same path, so only the first open of a path
+         ** truncates the file and writes the header, later ones append to it.
+         ** return: NULL if the file could not be opened.
+        */
+        std::shared_ptr<SharedFile> OpenSharedFile(const std::string& filePath,
+                                                   uint32_t magic,
+                                                   uint32_t recordSize) {
+            static std::mutex* registryMutex = new std::mutex();
+            static std::map<std::string, std::weak_ptr<SharedFile>>* registry =
+                new std::map<std::string, std::weak_ptr<SharedFile>>();
+            std::lock_guard<std::mutex> lock(*registryMutex);
+            std::weak_ptr<SharedFile>* entry = NULL;
+            std::map<std::string, std::weak_ptr<SharedFile>>::iterator it =
+                registry->find(filePath);
+            if (it != registry->end()) {
+                std::shared_ptr<SharedFile> sharedFile = it->second.lock();
+                if (sharedFile) {
+                    return sharedFile;
+                }
+                entry = &it->second;
+            }
+
+            FILE* file = fopen(filePath.c_str(), entry != NULL ? "ab" : "wb");
+            if (file == NULL) {
+                return std::shared_ptr<SharedFile>();
+            }
+            if (entry == NULL) {
+                BinaryFileHeader header;
+                header.magic = magic;
+                header.version = SC_BINARY_VERSION;
+                header.recordSize = recordSize;
+                fwrite(&header, sizeof(header), 1, file);
+                entry = &(*registry)[filePath];
+            }
+            std::shared_ptr<SharedFile> sharedFile = std::make_shared<SharedFile>(file);
+            *entry = sharedFile;
+            return sharedFile;
+        }
+    }  // namespace
+
+    BinaryStatsRecorder::BinaryStatsRecorder(const std::string& filePath,
+                                             size_t capacity,
+                                             int flushIntervalMs)
+        : file_(OpenSharedFile(filePath, SC_BINARY_MAGIC, sizeof(BinaryPacketRecord))),
+          ring_(RoundUpToPowerOfTwo(capacity > 0 ? capacity : 1)),
+          mask_(ring_.size() - 1),
+          flushIntervalMs_(flushIntervalMs),
+          head_(0),
+          tail_(0),
+          dropped_(0),
+          stop_(false) {
+        if (file_ == nullptr) {
+            return;
+        }
+        writer_ = std::thread(&BinaryStatsRecorder::WriterLoop, this);
+    }
+
+    BinaryStatsRecorder::~BinaryStatsRecorder() {
+        if (writer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(wakeupMutex_);
+                stop_ = true;
+            }
+            wakeup_.notify_one();
+            writer_.join();
+        }
+    }
+
+    SCResult BinaryStatsRecorder::Record(
+        double             pacerPacingRate,
+        double             pacerPaddingRate,
+        unsigned char      payloadType,
+        unsigned short     sequenceNumber,
+        unsigned int       sendTimestamp,
+        unsigned int       ssrc,
+        unsigned long      paddingLength,
+        unsigned long      headerLength,
+        unsigned long long arrivalTimeMs,
+        unsigned long      payloadSize,
+        float              lossRate) {
+        if (file_ == nullptr) {
+            return SC_SAVE_ERROR;
+        }
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) > mask_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return SC_BUFFER_FULL_ERROR;
+        }
+
+        BinaryPacketRecord& record = ring_[head & mask_];
+        record.pacerPacingRate = pacerPacingRate;
+        record.pacerPaddingRate = pacerPaddingRate;
+        record.arrivalTimeMs = static_cast<int64_t>(arrivalTimeMs);
+        record.sendTimestamp = sendTimestamp;
+        record.ssrc = ssrc;
+        record.paddingLength = static_cast<uint32_t>(paddingLength);
+        record.headerLength = static_cast<uint32_t>(headerLength);
+        record.payloadSize = static_cast<uint32_t>(payloadSize);
+        record.lossRate = lossRate;
+        record.sequenceNumber = sequenceNumber;
+        record.payloadType = payloadType;
+
+        // Publish the record to the writer thread.
+        head_.store(head + 1, std::memory_order_release);
+        return SC_SUCCESS;
+    }
+
+    bool BinaryStatsRecorder::IsOpen() const {
+        return file_ != nullptr;
+    }
+
+    unsigned long long BinaryStatsRecorder::DroppedRecords() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    void BinaryStatsRecorder::WriterLoop() {
+        std::unique_lock<std::mutex> lock(wakeupMutex_);
+        while (!stop_) {
+            wakeup_.wait_for(lock, std::chrono::milliseconds(flushIntervalMs_));
+            lock.unlock();
+            bool ok = Drain();
+            lock.lock();
+            if (!ok) {
+                break;
+            }
+        }
+        lock.unlock();
+        // Write whatever the producer queued before the destructor ran.
+        Drain();
+        std::lock_guard<std::mutex> fileLock(file_->mutex);
+        fflush(file_->file);
+    }
+
+    bool BinaryStatsRecorder::Drain() {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        if (head == tail) {
+            return true;
+        }
+        // The pending records are at most two contiguous runs in the ring, write them straight
+        // from the ring without copying.
+        const size_t begin = tail & mask_;
+        const size_t count = head - tail;
+        const size_t firstRun = std::min(count, ring_.size() - begin);
+        bool ok;
+        {
+            std::lock_guard<std::mutex> fileLock(file_->mutex);
+            ok = fwrite(&ring_[begin], sizeof(BinaryPacketRecord), firstRun, file_->file) ==
+                 firstRun;
+            if (ok && count > firstRun) {
+                ok = fwrite(&ring_[0], sizeof(BinaryPacketRecord), count - firstRun,
+                            file_->file) == count - firstRun;
+            }
+        }
+        tail_.store(head, std::memory_order_release);
+        return ok;
+    }
+
+    BinaryVideoStatsRecorder::BinaryVideoStatsRecorder(const std::string& filePath)
+        : file_(OpenSharedFile(filePath, SC_BINARY_VIDEO_MAGIC, sizeof(BinaryVideoRecord))) {
+    }
+
+    BinaryVideoStatsRecorder::~BinaryVideoStatsRecorder() {
+        if (file_ != nullptr) {
+            std::lock_guard<std::mutex> fileLock(file_->mutex);
+            fflush(file_->file);
+        }
+    }
+
+    SCResult BinaryVideoStatsRecorder::Record(const BinaryVideoRecord& record) {
+        if (file_ == nullptr) {
+            return SC_SAVE_ERROR;
+        }
+        std::lock_guard<std::mutex> fileLock(file_->mutex);
+        if (fwrite(&record, sizeof(record), 1, file_->file) != 1) {
+            return SC_SAVE_ERROR;
+        }
+        return SC_SUCCESS;
+    }
+
+    bool BinaryVideoStatsRecorder::IsOpen() const {
+        return file_ != nullptr;
+    }
+
+    MappedCaptureRing::MappedCaptureRing(const std::string& filePath, size_t capacity)
+        : capacity_(capacity > 0 ? capacity : 1),
+          mappedSize_(sizeof(CaptureRingHeader) + capacity_ * sizeof(CaptureRecord)),
+          mapping_(NULL),
+          header_(NULL),
+          records_(NULL) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ | GENERIC_WRITE,
+                                  FILE_SHARE_READ, NULL, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        const unsigned long long size = mappedSize_;
+        HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READWRITE,
+                                                static_cast<DWORD>(size >> 32),
+                                                static_cast<DWORD>(size), NULL);
+        CloseHandle(file);
+        if (fileMapping == NULL) {
+            return;
+        }
+        // The view keeps the mapping alive.
+        mapping_ = MapViewOfFile(fileMapping, FILE_MAP_WRITE, 0, 0, mappedSize_);
+        CloseHandle(fileMapping);
+#else
+        const int fd = open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return;
+        }
+        if (ftruncate(fd, static_cast<off_t>(mappedSize_)) == 0) {
+            void* mapping = mmap(NULL, mappedSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapping != MAP_FAILED) {
+                mapping_ = mapping;
+            }
+        }
+        // The mapping keeps the file open.
+        close(fd);
+#endif
+        if (mapping_ == NULL) {
+            return;
+        }
+        header_ = static_cast<CaptureRingHeader*>(mapping_);
+        records_ = reinterpret_cast<CaptureRecord*>(header_ + 1);
+        header_->magic = SC_CAPTURE_MAGIC;
+        header_->version = SC_CAPTURE_VERSION;
+        header_->recordSize = sizeof(CaptureRecord);
+        header_->capacity = static_cast<uint32_t>(capacity_);
+        header_->recordsWritten = 0;
+    }
+
+    MappedCaptureRing::~MappedCaptureRing() {
+        if (mapping_ == NULL) {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(mapping_);
+#else
+        munmap(mapping_, mappedSize_);
+#endif
+    }
+
+    SCResult MappedCaptureRing::Record(const CaptureRecord& record) {
+        if (mapping_ == NULL) {
+            return SC_SAVE_ERROR;
+        }
+        const uint64_t recordsWritten = header_->recordsWritten;
+        memcpy(&records_[recordsWritten % capacity_], &record, sizeof(record));
+        header_->recordsWritten = recordsWritten + 1;
+        return SC_SUCCESS;
+    }
+
+    bool MappedCaptureRing::IsOpen() const {
+        return mapping_ != NULL;
+    }
+
+    unsigned long long MappedCaptureRing::RecordsWritten() const {
+        return mapping_ != NULL ? header_->recordsWritten : 0;
+    }
+}  // namespace StatCollect
@@ -0,0 +1,287 @@
+/**
+ * @file      StatRecorder.h
+ * @brief     The header file of BinaryStatsRecorder. BinaryStatsRecorder records per-packet stats into a
+ *            preallocated ring buffer and a background thread writes them to a compact binary file.
+ *            BinaryVideoStatsRecorder writes the periodically sampled video stats in the same layout.
+ *            MappedCaptureRing keeps the last RTP headers received in a fixed-size mapped file.
+ * @repo      AlphaRTC
+ * @version   0.1
+ * @copyright Copyright (c) Microsoft Corporation. All rights reserved.
+ * @license   Licensed under the MIT License.
+ **/
+
+#ifndef STATS_RECORDER_H_
+#define STATS_RECORDER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "StatCollect.h"
+
+namespace StatCollect {
+    /**
+     ** Binary file layout:
+     **   BinaryFileHeader, followed by BinaryPacketRecord entries until the end of file.
+     ** All fields are little-endian. parse.py -b reads this format back.
+     ** The recorders of the same path in one process share the file: the first one truncates
+     ** it and writes the header, the records of all of them follow in whole records.
+     ** Video stats files have the same layout, with SC_BINARY_VIDEO_MAGIC and
+     ** BinaryVideoRecord entries.
+    **/
+#define SC_BINARY_MAGIC                              0x31424353  // "SCB1"
+#define SC_BINARY_VIDEO_MAGIC                        0x31564353  // "SCV1"
+#define SC_BINARY_VERSION                            1
+
+    /**
+     ** Capture ring file layout:
+     **   CaptureRingHeader, followed by |capacity| CaptureRecord slots. Record n, counting
+     **   from 0, is in slot n % capacity, so the slots hold the last
+     **   min(recordsWritten, capacity) records, the oldest in slot recordsWritten % capacity
+     **   once the ring wrapped. parse.py -r reads this format back.
+    **/
+#define SC_CAPTURE_MAGIC                             0x31524353  // "SCR1"
+#define SC_CAPTURE_VERSION                           1
+#define SC_CAPTURE_FLAG_MARKER                       0x01
+#define SC_CAPTURE_FLAG_TRANSPORT_SEQUENCE_NUMBER    0x02
+#define SC_CAPTURE_FLAG_ABSOLUTE_SEND_TIME           0x04
+// The record was captured around an anomaly instead of as part of a sampled session.
+#define SC_CAPTURE_FLAG_TRIGGERED                    0x08
+
+#pragma pack(push, 1)
+    struct BinaryFileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t recordSize;
+    };
+
+    /**
+     ** The fixed-size record stored for every received packet. Empty values use the same
+     ** SC_*_EMPTY sentinels as CollectInfo.
+    */
+    struct BinaryPacketRecord {
+        double   pacerPacingRate;
+        double   pacerPaddingRate;
+        int64_t  arrivalTimeMs;
+        uint32_t sendTimestamp;
+        uint32_t ssrc;
+        uint32_t paddingLength;
+        uint32_t headerLength;
+        uint32_t payloadSize;
+        float    lossRate;
+        uint16_t sequenceNumber;
+        uint8_t  payloadType;
+    };
+
+    /**
+     ** The fixed-size record stored for every sample of the video receive stats, summed over
+     ** the video streams and cumulative since they started. See VideoInfo.
+    */
+    struct BinaryVideoRecord {
+        int64_t  timeMs;
+        double   jitterBufferDelay;
+        uint64_t jitterBufferEmittedCount;
+        uint32_t framesReceived;
+        uint32_t keyFramesReceived;
+        uint32_t framesDecoded;
+        uint32_t framesDropped;
+        uint32_t freezeCount;
+        uint32_t totalFreezesDurationMs;
+    };
+
+    struct CaptureRingHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t recordSize;
+        uint32_t capacity;
+        // Updated after every record, so that a reader of a live file knows where the ring is.
+        uint64_t recordsWritten;
+    };
+
+    /**
+     ** The header-only record of one received RTP packet, see MappedCaptureRing.
+    */
+    struct CaptureRecord {
+        int64_t  arrivalTimeMs;
+        uint32_t rtpTimestamp;
+        uint32_t ssrc;
+        // 24 bits, valid with SC_CAPTURE_FLAG_ABSOLUTE_SEND_TIME.
+        uint32_t absoluteSendTime;
+        uint32_t payloadSize;
+        uint16_t sequenceNumber;
+        // Valid with SC_CAPTURE_FLAG_TRANSPORT_SEQUENCE_NUMBER.
+        uint16_t transportSequenceNumber;
+        uint16_t headerLength;
+        uint16_t paddingLength;
+        uint8_t  payloadType;
+        uint8_t  flags;
+    };
+#pragma pack(pop)
+
+    // The output file of the recorders of one path, see OpenSharedFile().
+    struct SharedFile;
+
+    class BinaryStatsRecorder {
+    public:
+        /**
+         ** The constructor function of BinaryStatsRecorder class
+         ** @param  const std::string& filePath,        the output binary file
+         ** @param  size_t             capacity,        the number of records the ring can hold,
+         **                                             rounded up to a power of two
+         ** @param  int                flushIntervalMs, how often the writer thread drains the ring
+        */
+        BinaryStatsRecorder(const std::string& filePath,
+                            size_t capacity = 1 << 16,
+                            int flushIntervalMs = 100);
+
+        /**
+         ** The destructor function of BinaryStatsRecorder class.
+         ** Stops the writer thread after writing every pending record.
+        */
+        ~BinaryStatsRecorder();
+
+        BinaryStatsRecorder(const BinaryStatsRecorder&) = delete;
+        BinaryStatsRecorder& operator=(const BinaryStatsRecorder&) = delete;
+
+        /**
+         ** Record the packet info of one received packet. Must always be called from the same
+         ** thread. Never allocates, locks or touches the file.
+         **
+         ** return: SC_SUCCESS             if the record was queued.
+                    SC_SAVE_ERROR          if the output file could not be opened.
+                    SC_BUFFER_FULL_ERROR   if the writer fell behind and the record was dropped.
+        */
+        SCResult Record(
+            double             pacerPacingRate,
+            double             pacerPaddingRate,
+            unsigned char      payloadType,
+            unsigned short     sequenceNumber,
+            unsigned int       sendTimestamp,
+            unsigned int       ssrc,
+            unsigned long      paddingLength,
+            unsigned long      headerLength,
+            unsigned long long arrivalTimeMs,
+            unsigned long      payloadSize,
+            float              lossRate);
+
+        /**
+         ** Whether the output file was opened successfully.
+        */
+        bool IsOpen() const;
+
+        /**
+         ** The number of records dropped because the ring was full.
+        */
+        unsigned long long DroppedRecords() const;
+
+    private:
+        void WriterLoop();
+        // Writes every record currently in the ring, returns false on write error.
+        bool Drain();
+
+        const std::shared_ptr<SharedFile> file_;
+        std::vector<BinaryPacketRecord> ring_;
+        const size_t mask_;
+        const int flushIntervalMs_;
+        // head_ is only written by the producer and tail_ only by the writer thread.
+        std::atomic<size_t> head_;
+        std::atomic<size_t> tail_;
+        std::atomic<unsigned long long> dropped_;
+
+        std::mutex wakeupMutex_;
+        std::condition_variable wakeup_;
+        bool stop_;
+        std::thread writer_;
+    };
+
+    class BinaryVideoStatsRecorder {
+    public:
+        /**
+         ** The constructor function of BinaryVideoStatsRecorder class
+         ** @param  const std::string& filePath,        the output binary file
+        */
+        explicit BinaryVideoStatsRecorder(const std::string& filePath);
+
+        /**
+         ** The destructor function of BinaryVideoStatsRecorder class.
+        */
+        ~BinaryVideoStatsRecorder();
+
+        BinaryVideoStatsRecorder(const BinaryVideoStatsRecorder&) = delete;
+        BinaryVideoStatsRecorder& operator=(const BinaryVideoStatsRecorder&) = delete;
+
+        /**
+         ** Record one sample of the video stats. Samples come at a low rate, e.g. once per
+         ** second, so they are written by the calling thread through the buffered file
+         ** without a ring or a writer thread.
+         **
+         ** return: SC_SUCCESS             if the record was written.
+                    SC_SAVE_ERROR          if the output file could not be opened or written.
+        */
+        SCResult Record(const BinaryVideoRecord& record);
+
+        /**
+         ** Whether the output file was opened successfully.
+        */
+        bool IsOpen() const;
+
+    private:
+        const std::shared_ptr<SharedFile> file_;
+    };
+
+    class MappedCaptureRing {
+    public:
+        /**
+         ** The constructor function of MappedCaptureRing class. Creates |filePath| with room
+         ** for |capacity| records and maps it, the file keeps its size from then on.
+         ** @param  const std::string& filePath,        the output capture file
+         ** @param  size_t             capacity,        the number of records the ring can hold
+        */
+        MappedCaptureRing(const std::string& filePath, size_t capacity);
+
+        /**
+         ** The destructor function of MappedCaptureRing class. Unmaps the file, the records
+         ** are written back by the OS like those of a process that crashed.
+        */
+        ~MappedCaptureRing();
+
+        MappedCaptureRing(const MappedCaptureRing&) = delete;
+        MappedCaptureRing& operator=(const MappedCaptureRing&) = delete;
+
+        /**
+         ** Copy |record| into the next slot, overwriting the oldest record once the ring is
+         ** full. Must always be called from the same thread. Never allocates, locks or makes
+         ** a system call.
+         **
+         ** return: SC_SUCCESS             if the record was stored.
+                    SC_SAVE_ERROR          if the capture file could not be created or mapped.
+        */
+        SCResult Record(const CaptureRecord& record);
+
+        /**
+         ** Whether the capture file was created and mapped successfully.
+        */
+        bool IsOpen() const;
+
+        /**
+         ** The number of records stored so far, including those overwritten since.
+        */
+        unsigned long long RecordsWritten() const;
+
+    private:
+        const size_t capacity_;
+        size_t mappedSize_;
+        void* mapping_;
+        CaptureRingHeader* header_;
+        CaptureRecord* records_;
+    };
+}  // namespace StatCollect
+
+#endif  // STATS_RECORDER_H_
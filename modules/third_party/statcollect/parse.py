@@ -1,30 +1,314 @@
-import sys
-import os
-import getopt
-
-def main(argv):
-    file_name = "webrtc.log"
-    out_file_name = "outdata.txt"
-    try:
-        opts, args = getopt.getopt(argv,"hi:o:",["input=","output="])
-    except getopt.GetoptError:
-        print ("parse.py -i <inputfile> -o <outputfile>")
-        sys.exit(2)
-    for opt, arg in opts:
-        if opt == '-h':
-            print ("parse.py -i <inputfile> -o <outputfile>")
-            sys.exit()
-        elif opt in ("-i", "--input"):
-            file_name = arg
-        elif opt in ("-o", "--output"):
-            out_file_name = arg
-    substr = "{\"mediaInfo\":"
-    f = open(out_file_name,"a")
-    for line in open(file_name):
-        start = line.find(substr)
-        if start != -1:
-            data = line[start:]
-            f.write(data)
-    f.close()
-if __name__ == "__main__":
-    main(sys.argv[1:])
\ No newline at end of file
+import sys
+import os
+import getopt
+import json
+import struct
+
+# Must match BinaryFileHeader / BinaryPacketRecord in StatRecorder.h
+BINARY_MAGIC = 0x31424353
+BINARY_HEADER = struct.Struct("<III")
+BINARY_RECORD = struct.Struct("<ddqIIIIIfHB")
+# Must match BinaryVideoRecord in StatRecorder.h
+BINARY_VIDEO_MAGIC = 0x31564353
+BINARY_VIDEO_RECORD = struct.Struct("<qdQIIIIII")
+
+# The SC_*_EMPTY sentinels of StatCollect.h, as built for 64-bit Linux.
+EMPTY_DOUBLE = sys.float_info.max
+EMPTY_ULONG = 2**64 - 1
+EMPTY_LLONG = 2**63 - 1
+
+# Must match CaptureRingHeader / CaptureRecord in StatRecorder.h
+CAPTURE_MAGIC = 0x31524353
+CAPTURE_HEADER = struct.Struct("<IIIIQ")
+CAPTURE_RECORD = struct.Struct("<qIIIIHHHHBB")
+(CAPTURE_FLAG_MARKER, CAPTURE_FLAG_TRANSPORT_SEQUENCE_NUMBER,
+ CAPTURE_FLAG_ABSOLUTE_SEND_TIME, CAPTURE_FLAG_TRIGGERED) = (1, 2, 4, 8)
+
+# Must match RTCStatsReport::AppendBinary, see api/stats/rtc_stats_binary.h
+RTC_STATS_MAGIC = b"RSB1"
+# RTCStatsMemberInterface::Type
+(RTC_STATS_BOOL, RTC_STATS_INT32, RTC_STATS_UINT32, RTC_STATS_INT64,
+ RTC_STATS_UINT64, RTC_STATS_DOUBLE, RTC_STATS_STRING) = range(7)
+RTC_STATS_SEQUENCE_OFFSET = 7
+
+def parse_log(file_name, f):
+    substr = "{\"mediaInfo\":"
+    for line in open(file_name):
+        start = line.find(substr)
+        if start != -1:
+            data = line[start:]
+            f.write(data)
+
+# The mediaInfo of the JSON lines StatsCollectModule logged for every packet,
+# the receive path never filled it in.
+def empty_media_info():
+    return {
+        "videoInfo": {
+            "framesCaptured": EMPTY_ULONG,
+            "framesSent": EMPTY_ULONG,
+            "hugeFreameSent": EMPTY_ULONG,
+            "keyFramesSent": EMPTY_ULONG,
+            "videoJitterBufferDelay": EMPTY_DOUBLE,
+            "videoJitterBufferEmittedCount": EMPTY_ULONG,
+            "framesReceived": EMPTY_ULONG,
+            "keyFramesReceived": EMPTY_ULONG,
+            "framesDecoded": EMPTY_ULONG,
+            "framesDroped": EMPTY_ULONG,
+            "partialFramesLost": EMPTY_ULONG,
+            "fullFramesLost": EMPTY_ULONG,
+        },
+        "audioInfo": {
+            "echoReturnLoss": EMPTY_DOUBLE,
+            "echoReturnLossEnhancement": EMPTY_DOUBLE,
+            "totalSamplesSent": EMPTY_ULONG,
+            "estimatedPlayoutTimestamp": EMPTY_LLONG,
+            "audioJitterBufferDelay": EMPTY_DOUBLE,
+            "audioJitterBufferEmittedCount": EMPTY_ULONG,
+            "totalSamplesReceived": EMPTY_ULONG,
+            "concealedSamples": EMPTY_ULONG,
+            "concealmentEvents": EMPTY_ULONG,
+        },
+    }
+
+def parse_binary(file_name, f):
+    with open(file_name, "rb") as binary:
+        magic, version, record_size = BINARY_HEADER.unpack(
+            binary.read(BINARY_HEADER.size))
+        if magic != BINARY_MAGIC or record_size != BINARY_RECORD.size:
+            print ("%s is not a StatCollect binary file" % file_name)
+            sys.exit(2)
+        while True:
+            data = binary.read(record_size)
+            if len(data) < record_size:
+                break
+            (pacing_rate, padding_rate, arrival_time_ms, send_timestamp, ssrc,
+             padding_length, header_length, payload_size, loss_rate,
+             sequence_number, payload_type) = BINARY_RECORD.unpack(data)
+            record = {
+                "pacerPacingRate": pacing_rate,
+                "pacerPaddingRate": padding_rate,
+                "packetInfo": {
+                    "header": {
+                        "payloadType": payload_type,
+                        "sequenceNumber": sequence_number,
+                        "sendTimestamp": send_timestamp,
+                        "ssrc": ssrc,
+                        "paddingLength": padding_length,
+                        "headerLength": header_length,
+                    },
+                    "arrivalTimeMs": arrival_time_ms,
+                    "payloadSize": payload_size,
+                    "lossRates": loss_rate,
+                },
+                "mediaInfo": empty_media_info(),
+            }
+            f.write(json.dumps(record, sort_keys=True, separators=(",", ":")))
+            f.write("\n")
+
+def parse_binary_video(file_name, f):
+    with open(file_name, "rb") as binary:
+        magic, version, record_size = BINARY_HEADER.unpack(
+            binary.read(BINARY_HEADER.size))
+        if (magic != BINARY_VIDEO_MAGIC or
+                record_size != BINARY_VIDEO_RECORD.size):
+            print ("%s is not a StatCollect video stats file" % file_name)
+            sys.exit(2)
+        while True:
+            data = binary.read(record_size)
+            if len(data) < record_size:
+                break
+            (time_ms, jitter_buffer_delay, jitter_buffer_emitted_count,
+             frames_received, key_frames_received, frames_decoded,
+             frames_dropped, freeze_count,
+             total_freezes_duration_ms) = BINARY_VIDEO_RECORD.unpack(data)
+            # The baseline videoInfo keys, with the fields the samples don't
+            # have left empty, plus the freeze stats.
+            media_info = empty_media_info()
+            media_info["videoInfo"].update({
+                "videoJitterBufferDelay": jitter_buffer_delay,
+                "videoJitterBufferEmittedCount": jitter_buffer_emitted_count,
+                "framesReceived": frames_received,
+                "keyFramesReceived": key_frames_received,
+                "framesDecoded": frames_decoded,
+                "framesDroped": frames_dropped,
+                "freezeCount": freeze_count,
+                "totalFreezesDurationMs": total_freezes_duration_ms,
+            })
+            record = {
+                "timeMs": time_ms,
+                "mediaInfo": media_info,
+            }
+            f.write(json.dumps(record, sort_keys=True, separators=(",", ":")))
+            f.write("\n")
+
+def parse_capture(file_name, f):
+    with open(file_name, "rb") as binary:
+        data = binary.read()
+    if len(data) < CAPTURE_HEADER.size:
+        print ("%s is not a StatCollect capture file" % file_name)
+        sys.exit(2)
+    magic, version, record_size, capacity, records_written = \
+        CAPTURE_HEADER.unpack_from(data)
+    if (magic != CAPTURE_MAGIC or record_size != CAPTURE_RECORD.size or
+            len(data) < CAPTURE_HEADER.size + capacity * record_size):
+        print ("%s is not a StatCollect capture file" % file_name)
+        sys.exit(2)
+    # Oldest first, the ring only holds the last |capacity| records.
+    first = max(records_written - capacity, 0)
+    for index in range(first, records_written):
+        (arrival_time_ms, rtp_timestamp, ssrc, absolute_send_time,
+         payload_size, sequence_number, transport_sequence_number,
+         header_length, padding_length, payload_type,
+         flags) = CAPTURE_RECORD.unpack_from(
+             data, CAPTURE_HEADER.size + (index % capacity) * record_size)
+        header = {
+            "markerBit": bool(flags & CAPTURE_FLAG_MARKER),
+            "payloadType": payload_type,
+            "sequenceNumber": sequence_number,
+            "timestamp": rtp_timestamp,
+            "ssrc": ssrc,
+            "paddingLength": padding_length,
+            "headerLength": header_length,
+        }
+        if flags & CAPTURE_FLAG_TRANSPORT_SEQUENCE_NUMBER:
+            header["transportSequenceNumber"] = transport_sequence_number
+        if flags & CAPTURE_FLAG_ABSOLUTE_SEND_TIME:
+            header["absoluteSendTime"] = absolute_send_time
+        record = {
+            "packetInfo": {
+                "header": header,
+                "arrivalTimeMs": arrival_time_ms,
+                "payloadSize": payload_size,
+            },
+            "triggered": bool(flags & CAPTURE_FLAG_TRIGGERED),
+        }
+        f.write(json.dumps(record, sort_keys=True, separators=(",", ":")))
+        f.write("\n")
+
+class RTCStatsReader:
+    def __init__(self, data):
+        self.data = data
+        self.position = 0
+
+    def read_bytes(self, size):
+        if self.position + size > len(self.data):
+            raise ValueError("truncated RTCStats report")
+        data = self.data[self.position:self.position + size]
+        self.position += size
+        return data
+
+    def read_unsigned(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.read_bytes(1)[0]
+            value |= (byte & 0x7f) << shift
+            if not byte & 0x80:
+                return value
+            shift += 7
+
+    def read_signed(self):
+        value = self.read_unsigned()
+        return (value >> 1) ^ -(value & 1)
+
+    def read_string(self):
+        return self.read_bytes(self.read_unsigned()).decode("utf-8")
+
+    def read_value(self, value_type):
+        if value_type == RTC_STATS_BOOL:
+            return self.read_bytes(1)[0] == 1
+        if value_type in (RTC_STATS_INT32, RTC_STATS_INT64):
+            return self.read_signed()
+        if value_type in (RTC_STATS_UINT32, RTC_STATS_UINT64):
+            return self.read_unsigned()
+        if value_type == RTC_STATS_DOUBLE:
+            return struct.unpack("<d", self.read_bytes(8))[0]
+        if value_type == RTC_STATS_STRING:
+            return self.read_string()
+        raise ValueError("unknown RTCStats member type %d" % value_type)
+
+    def read_member(self):
+        name = self.read_string()
+        value_type = self.read_bytes(1)[0]
+        if value_type < RTC_STATS_SEQUENCE_OFFSET:
+            return name, self.read_value(value_type)
+        element_type = value_type - RTC_STATS_SEQUENCE_OFFSET
+        return name, [self.read_value(element_type)
+                      for _ in range(self.read_unsigned())]
+
+    def read_stats(self):
+        stats = {"type": self.read_string(), "id": self.read_string(),
+                 "timestamp": self.read_signed()}
+        for _ in range(self.read_unsigned()):
+            name, value = self.read_member()
+            stats[name] = value
+        return stats
+
+    # Returns the stats objects of the next report, like RTCStatsReport::ToJson
+    # lists them, or None at the end of the data.
+    def read_report(self):
+        if self.position == len(self.data):
+            return None
+        if self.read_bytes(len(RTC_STATS_MAGIC)) != RTC_STATS_MAGIC:
+            raise ValueError("not an RTCStats report")
+        self.read_signed()
+        return [self.read_stats() for _ in range(self.read_unsigned())]
+
+def parse_rtc_stats(file_name, f):
+    with open(file_name, "rb") as binary:
+        reader = RTCStatsReader(bytearray(binary.read()))
+    try:
+        while True:
+            report = reader.read_report()
+            if report is None:
+                break
+            f.write(json.dumps(report, separators=(",", ":")))
+            f.write("\n")
+    except ValueError as error:
+        print ("%s: %s" % (file_name, error))
+        sys.exit(2)
+
+def main(argv):
+    file_name = "webrtc.log"
+    out_file_name = "outdata.txt"
+    binary = False
+    video = False
+    rtc_stats = False
+    capture = False
+    try:
+        opts, args = getopt.getopt(argv,"hbvsri:o:",
+                                   ["binary","video","rtc-stats","capture",
+                                    "input=","output="])
+    except getopt.GetoptError:
+        print ("parse.py [-b|-v|-s|-r] -i <inputfile> -o <outputfile>")
+        sys.exit(2)
+    for opt, arg in opts:
+        if opt == '-h':
+            print ("parse.py [-b|-v|-s|-r] -i <inputfile> -o <outputfile>")
+            sys.exit()
+        elif opt in ("-b", "--binary"):
+            binary = True
+        elif opt in ("-v", "--video"):
+            video = True
+        elif opt in ("-s", "--rtc-stats"):
+            rtc_stats = True
+        elif opt in ("-r", "--capture"):
+            capture = True
+        elif opt in ("-i", "--input"):
+            file_name = arg
+        elif opt in ("-o", "--output"):
+            out_file_name = arg
+    f = open(out_file_name,"a")
+    if rtc_stats:
+        parse_rtc_stats(file_name, f)
+    elif capture:
+        parse_capture(file_name, f)
+    elif video:
+        parse_binary_video(file_name, f)
+    elif binary:
+        parse_binary(file_name, f)
+    else:
+        parse_log(file_name, f)
+    f.close()
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,116 @@
+import io
+import json
+import os
+import struct
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import parse
+
+def binary_file(magic, record_size, records):
+    data = parse.BINARY_HEADER.pack(magic, 1, record_size)
+    for record in records:
+        data += record
+    binary = tempfile.NamedTemporaryFile(delete=False)
+    binary.write(data)
+    binary.close()
+    return binary.name
+
+def packet_record(sequence_number, pacing_rate=sys.float_info.max):
+    return parse.BINARY_RECORD.pack(
+        pacing_rate, sys.float_info.max, 5000 + sequence_number,
+        1000 + sequence_number, 1234, 0, 12, 1200, 0.25, sequence_number, 96)
+
+class ParseBinaryTest(unittest.TestCase):
+    def setUp(self):
+        self.files = []
+
+    def tearDown(self):
+        for file_name in self.files:
+            os.remove(file_name)
+
+    def parse(self, records, magic=parse.BINARY_MAGIC,
+              record_size=parse.BINARY_RECORD.size):
+        file_name = binary_file(magic, record_size, records)
+        self.files.append(file_name)
+        output = io.StringIO()
+        parse.parse_binary(file_name, output)
+        return [json.loads(line) for line in output.getvalue().splitlines()]
+
+    def test_reads_the_records_in_order(self):
+        lines = self.parse([packet_record(1, 300000.0), packet_record(2)])
+        self.assertEqual(len(lines), 2)
+        self.assertEqual(lines[0]["pacerPacingRate"], 300000.0)
+        self.assertEqual(lines[1]["pacerPacingRate"], sys.float_info.max)
+        packet_info = lines[0]["packetInfo"]
+        self.assertEqual(packet_info["header"], {
+            "payloadType": 96,
+            "sequenceNumber": 1,
+            "sendTimestamp": 1001,
+            "ssrc": 1234,
+            "paddingLength": 0,
+            "headerLength": 12,
+        })
+        self.assertEqual(packet_info["arrivalTimeMs"], 5001)
+        self.assertEqual(packet_info["payloadSize"], 1200)
+        self.assertEqual(packet_info["lossRates"], 0.25)
+        self.assertEqual(lines[1]["packetInfo"]["header"]["sequenceNumber"], 2)
+
+    def test_emits_the_media_info_of_the_json_log(self):
+        lines = self.parse([packet_record(1)])
+        media_info = lines[0]["mediaInfo"]
+        self.assertEqual(media_info, parse.empty_media_info())
+        self.assertEqual(media_info["videoInfo"]["videoJitterBufferDelay"],
+                         sys.float_info.max)
+        self.assertEqual(media_info["videoInfo"]["framesDroped"],
+                         parse.EMPTY_ULONG)
+        self.assertEqual(
+            media_info["audioInfo"]["estimatedPlayoutTimestamp"],
+            parse.EMPTY_LLONG)
+
+    def test_ignores_a_truncated_record(self):
+        lines = self.parse([packet_record(1), packet_record(2)[:10]])
+        self.assertEqual(len(lines), 1)
+
+    def test_rejects_other_files(self):
+        with self.assertRaises(SystemExit):
+            self.parse([packet_record(1)], magic=parse.BINARY_VIDEO_MAGIC)
+        with self.assertRaises(SystemExit):
+            self.parse([packet_record(1)],
+                       record_size=parse.BINARY_RECORD.size + 1)
+
+class ParseBinaryVideoTest(unittest.TestCase):
+    def test_uses_the_baseline_video_info_keys(self):
+        file_name = binary_file(
+            parse.BINARY_VIDEO_MAGIC, parse.BINARY_VIDEO_RECORD.size,
+            [parse.BINARY_VIDEO_RECORD.pack(7000, 1.5, 30, 31, 2, 29, 1, 3,
+                                            450)])
+        try:
+            output = io.StringIO()
+            parse.parse_binary_video(file_name, output)
+        finally:
+            os.remove(file_name)
+        lines = [json.loads(line) for line in output.getvalue().splitlines()]
+        self.assertEqual(len(lines), 1)
+        self.assertEqual(lines[0]["timeMs"], 7000)
+        video_info = lines[0]["mediaInfo"]["videoInfo"]
+        self.assertEqual(video_info["videoJitterBufferDelay"], 1.5)
+        self.assertEqual(video_info["videoJitterBufferEmittedCount"], 30)
+        self.assertEqual(video_info["framesReceived"], 31)
+        self.assertEqual(video_info["keyFramesReceived"], 2)
+        self.assertEqual(video_info["framesDecoded"], 29)
+        self.assertEqual(video_info["framesDroped"], 1)
+        self.assertEqual(video_info["freezeCount"], 3)
+        self.assertEqual(video_info["totalFreezesDurationMs"], 450)
+        # Not sampled.
+        self.assertEqual(video_info["framesCaptured"], parse.EMPTY_ULONG)
+        self.assertEqual(lines[0]["mediaInfo"]["audioInfo"],
+                         parse.empty_media_info()["audioInfo"])
+        self.assertTrue(set(parse.empty_media_info()["videoInfo"]) <=
+                        set(video_info))
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,205 @@
+/**
+ * @file      stat_recorder_unittest.cc
+ * @brief     The unit tests of BinaryStatsRecorder and BinaryVideoStatsRecorder.
+ * @repo      AlphaRTC
+ * @version   0.1
+ * @copyright Copyright (c) Microsoft Corporation. All rights reserved.
+ * @license   Licensed under the MIT License.
+ **/
+
+#include "modules/third_party/statcollect/StatRecorder.h"
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+using StatCollect::BinaryFileHeader;
+using StatCollect::BinaryPacketRecord;
+using StatCollect::BinaryStatsRecorder;
+using StatCollect::BinaryVideoRecord;
+using StatCollect::BinaryVideoStatsRecorder;
+
+// Long enough that the writer thread only drains the ring when the recorder
+// is destroyed.
+constexpr int kNoFlushIntervalMs = 60 * 60 * 1000;
+
+struct BinaryFile {
+  BinaryFileHeader header;
+  std::vector<BinaryPacketRecord> records;
+};
+
+BinaryFile ReadBinaryFile(const std::string& path) {
+  BinaryFile file = {};
+  FILE* input = fopen(path.c_str(), "rb");
+  EXPECT_TRUE(input);
+  if (!input)
+    return file;
+  EXPECT_EQ(fread(&file.header, sizeof(file.header), 1, input), 1u);
+  BinaryPacketRecord record;
+  while (fread(&record, sizeof(record), 1, input) == 1) {
+    file.records.push_back(record);
+  }
+  fclose(input);
+  return file;
+}
+
+StatCollect::SCResult RecordPacket(BinaryStatsRecorder* recorder,
+                                   uint16_t sequence_number) {
+  return recorder->Record(/*pacerPacingRate=*/300000.0,
+                          /*pacerPaddingRate=*/0.0, /*payloadType=*/96,
+                          sequence_number,
+                          /*sendTimestamp=*/1000 + sequence_number,
+                          /*ssrc=*/1234, /*paddingLength=*/0,
+                          /*headerLength=*/12,
+                          /*arrivalTimeMs=*/5000 + sequence_number,
+                          /*payloadSize=*/1200, /*lossRate=*/0.25f);
+}
+
+class BinaryStatsRecorderTest : public ::testing::Test {
+ protected:
+  BinaryStatsRecorderTest()
+      : path_(test::TempFilename(test::OutputPath(), "stat_recorder")) {}
+  ~BinaryStatsRecorderTest() override { test::RemoveFile(path_); }
+
+  const std::string path_;
+};
+
+TEST_F(BinaryStatsRecorderTest, WritesTheHeaderAndTheRecordsInOrder) {
+  {
+    BinaryStatsRecorder recorder(path_, /*capacity=*/16);
+    ASSERT_TRUE(recorder.IsOpen());
+    for (uint16_t sequence_number = 0; sequence_number < 3; ++sequence_number) {
+      EXPECT_EQ(RecordPacket(&recorder, sequence_number),
+                StatCollect::SC_SUCCESS);
+    }
+  }
+
+  BinaryFile file = ReadBinaryFile(path_);
+  EXPECT_EQ(file.header.magic, static_cast<uint32_t>(SC_BINARY_MAGIC));
+  EXPECT_EQ(file.header.version, static_cast<uint32_t>(SC_BINARY_VERSION));
+  EXPECT_EQ(file.header.recordSize, sizeof(BinaryPacketRecord));
+  ASSERT_EQ(file.records.size(), 3u);
+  for (uint16_t sequence_number = 0; sequence_number < 3; ++sequence_number) {
+    const BinaryPacketRecord& record = file.records[sequence_number];
+    EXPECT_EQ(record.sequenceNumber, sequence_number);
+    EXPECT_EQ(record.sendTimestamp, 1000u + sequence_number);
+    EXPECT_EQ(record.arrivalTimeMs, 5000 + sequence_number);
+    EXPECT_EQ(record.pacerPacingRate, 300000.0);
+    EXPECT_EQ(record.ssrc, 1234u);
+    EXPECT_EQ(record.headerLength, 12u);
+    EXPECT_EQ(record.payloadSize, 1200u);
+    EXPECT_EQ(record.lossRate, 0.25f);
+    EXPECT_EQ(record.payloadType, 96);
+  }
+}
+
+TEST_F(BinaryStatsRecorderTest, WritesTheRecordsOfAWrappedRing) {
+  {
+    BinaryStatsRecorder recorder(path_, /*capacity=*/4,
+                                 /*flushIntervalMs=*/1);
+    ASSERT_TRUE(recorder.IsOpen());
+    uint16_t sequence_number = 0;
+    while (sequence_number < 64) {
+      // Retry until the writer thread made room.
+      if (RecordPacket(&recorder, sequence_number) == StatCollect::SC_SUCCESS)
+        ++sequence_number;
+    }
+  }
+
+  BinaryFile file = ReadBinaryFile(path_);
+  ASSERT_EQ(file.records.size(), 64u);
+  for (uint16_t sequence_number = 0; sequence_number < 64; ++sequence_number) {
+    EXPECT_EQ(file.records[sequence_number].sequenceNumber, sequence_number);
+  }
+}
+
+TEST_F(BinaryStatsRecorderTest, DropsTheRecordsThatDontFitTheRing) {
+  {
+    BinaryStatsRecorder recorder(path_, /*capacity=*/4, kNoFlushIntervalMs);
+    for (uint16_t sequence_number = 0; sequence_number < 4; ++sequence_number) {
+      EXPECT_EQ(RecordPacket(&recorder, sequence_number),
+                StatCollect::SC_SUCCESS);
+    }
+    EXPECT_EQ(RecordPacket(&recorder, 4), StatCollect::SC_BUFFER_FULL_ERROR);
+    EXPECT_EQ(recorder.DroppedRecords(), 1u);
+  }
+
+  BinaryFile file = ReadBinaryFile(path_);
+  ASSERT_EQ(file.records.size(), 4u);
+  EXPECT_EQ(file.records[3].sequenceNumber, 3);
+}
+
+TEST_F(BinaryStatsRecorderTest, RecordersOfOnePathShareTheFile) {
+  {
+    BinaryStatsRecorder first(path_, /*capacity=*/16, kNoFlushIntervalMs);
+    BinaryStatsRecorder second(path_, /*capacity=*/16, kNoFlushIntervalMs);
+    EXPECT_EQ(RecordPacket(&first, 1), StatCollect::SC_SUCCESS);
+    EXPECT_EQ(RecordPacket(&second, 2), StatCollect::SC_SUCCESS);
+  }
+
+  BinaryFile file = ReadBinaryFile(path_);
+  EXPECT_EQ(file.header.magic, static_cast<uint32_t>(SC_BINARY_MAGIC));
+  ASSERT_EQ(file.records.size(), 2u);
+  EXPECT_NE(file.records[0].sequenceNumber, file.records[1].sequenceNumber);
+}
+
+TEST_F(BinaryStatsRecorderTest, LaterRecordersAppendToTheFile) {
+  {
+    BinaryStatsRecorder recorder(path_);
+    EXPECT_EQ(RecordPacket(&recorder, 1), StatCollect::SC_SUCCESS);
+  }
+  {
+    BinaryStatsRecorder recorder(path_);
+    EXPECT_EQ(RecordPacket(&recorder, 2), StatCollect::SC_SUCCESS);
+  }
+
+  BinaryFile file = ReadBinaryFile(path_);
+  ASSERT_EQ(file.records.size(), 2u);
+  EXPECT_EQ(file.records[0].sequenceNumber, 1);
+  EXPECT_EQ(file.records[1].sequenceNumber, 2);
+}
+
+TEST(BinaryStatsRecorderOpenTest, FailsWithoutTheOutputFile) {
+  BinaryStatsRecorder recorder(
+      test::OutputPath() + "missing_directory/stat_recorder");
+  EXPECT_FALSE(recorder.IsOpen());
+  EXPECT_EQ(RecordPacket(&recorder, 1), StatCollect::SC_SAVE_ERROR);
+}
+
+TEST_F(BinaryStatsRecorderTest, VideoRecordersOfOnePathShareTheFile) {
+  {
+    BinaryVideoStatsRecorder first(path_);
+    BinaryVideoStatsRecorder second(path_);
+    ASSERT_TRUE(first.IsOpen());
+    BinaryVideoRecord record = {};
+    record.timeMs = 1000;
+    EXPECT_EQ(first.Record(record), StatCollect::SC_SUCCESS);
+    record.timeMs = 2000;
+    EXPECT_EQ(second.Record(record), StatCollect::SC_SUCCESS);
+  }
+
+  FILE* input = fopen(path_.c_str(), "rb");
+  ASSERT_TRUE(input);
+  BinaryFileHeader header;
+  ASSERT_EQ(fread(&header, sizeof(header), 1, input), 1u);
+  EXPECT_EQ(header.magic, static_cast<uint32_t>(SC_BINARY_VIDEO_MAGIC));
+  EXPECT_EQ(header.recordSize, sizeof(BinaryVideoRecord));
+  std::vector<int64_t> times_ms;
+  BinaryVideoRecord record;
+  while (fread(&record, sizeof(record), 1, input) == 1) {
+    times_ms.push_back(record.timeMs);
+  }
+  fclose(input);
+  EXPECT_EQ(times_ms, (std::vector<int64_t>{1000, 2000}));
+}
+
+}  // namespace
+}  // namespace webrtc
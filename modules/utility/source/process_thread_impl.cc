@@ -201,7 +201,10 @@ void ProcessThreadImpl::Run(void* obj) {
 
 bool ProcessThreadImpl::Process() {
   TRACE_EVENT1("webrtc", "ProcessThreadImpl", "name", thread_name_);
-  int64_t now = rtc::TimeMillis();
+  // Every module, task and TimeUntilNextProcess() call gets a snapshot of the
+  // time it runs at, consistent with the time used for scheduling it.
+  rtc::ScopedTimeSnapshot time_snapshot;
+  int64_t now = time_snapshot.time_ms();
   int64_t next_checkpoint = now + (1000 * 60);
 
   {
@@ -222,12 +225,14 @@ bool ProcessThreadImpl::Process() {
           TRACE_EVENT2("webrtc", "ModuleProcess", "function",
                        m.location.function_name(), "file",
                        m.location.file_name());
+          rtc::ScopedTimeSnapshot process_time_snapshot;
           m.module->Process();
         }
         // Use a new 'now' reference to calculate when the next callback
         // should occur.  We'll continue to use 'now' above for the baseline
         // of calculating how long we should wait, to reduce variance.
-        int64_t new_now = rtc::TimeMillis();
+        rtc::ScopedTimeSnapshot new_time_snapshot;
+        int64_t new_now = new_time_snapshot.time_ms();
         m.next_callback = GetNextCallbackTime(m.module, new_now);
       }
 
@@ -249,8 +254,11 @@ bool ProcessThreadImpl::Process() {
       QueuedTask* task = queue_.front();
       queue_.pop();
       lock_.Leave();
-      if (task->Run()) {
-        delete task;
+      {
+        rtc::ScopedTimeSnapshot task_time_snapshot;
+        if (task->Run()) {
+          delete task;
+        }
       }
       lock_.Enter();
     }
@@ -0,0 +1,223 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/keep_ref_until_done.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "third_party/libyuv/include/libyuv.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+// static
+rtc::scoped_refptr<V4L2BufferPool> V4L2BufferPool::Create(int device_fd,
+                                                          int count,
+                                                          bool export_dmabuf) {
+  struct v4l2_requestbuffers rbuffer;
+  memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
+
+  rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  rbuffer.memory = V4L2_MEMORY_MMAP;
+  rbuffer.count = count;
+
+  if (ioctl(device_fd, VIDIOC_REQBUFS, &rbuffer) < 0) {
+    RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
+    return nullptr;
+  }
+
+  if (rbuffer.count > static_cast<unsigned int>(count))
+    rbuffer.count = count;
+
+  // Whatever was mapped so far is unmapped by the destructor on failure.
+  rtc::scoped_refptr<V4L2BufferPool> pool(
+      new rtc::RefCountedObject<V4L2BufferPool>(device_fd));
+  for (unsigned int i = 0; i < rbuffer.count; i++) {
+    struct v4l2_buffer buffer;
+    memset(&buffer, 0, sizeof(v4l2_buffer));
+    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+    buffer.index = i;
+
+    if (ioctl(device_fd, VIDIOC_QUERYBUF, &buffer) < 0) {
+      return nullptr;
+    }
+
+    Buffer mapped;
+    mapped.start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, device_fd, buffer.m.offset);
+    if (MAP_FAILED == mapped.start) {
+      return nullptr;
+    }
+    mapped.length = buffer.length;
+
+    if (export_dmabuf) {
+      struct v4l2_exportbuffer expbuf;
+      memset(&expbuf, 0, sizeof(v4l2_exportbuffer));
+      expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      expbuf.index = i;
+      expbuf.flags = O_RDONLY | O_CLOEXEC;
+      if (ioctl(device_fd, VIDIOC_EXPBUF, &expbuf) == 0) {
+        mapped.dmabuf_fd = expbuf.fd;
+      } else {
+        // Not fatal, the frames are still reachable through the mapping.
+        RTC_LOG(LS_INFO) << "Failed to export capture buffer " << i
+                         << " as DMABUF. errno = " << errno;
+      }
+    }
+    pool->AddBuffer(mapped);
+
+    if (ioctl(device_fd, VIDIOC_QBUF, &buffer) < 0) {
+      return nullptr;
+    }
+    rtc::CritScope cs(&pool->crit_);
+    ++pool->num_queued_;
+  }
+  return pool;
+}
+
+V4L2BufferPool::V4L2BufferPool(int device_fd) : device_fd_(device_fd) {}
+
+V4L2BufferPool::~V4L2BufferPool() {
+  for (const Buffer& buffer : buffers_) {
+    if (buffer.dmabuf_fd != -1)
+      close(buffer.dmabuf_fd);
+    munmap(buffer.start, buffer.length);
+  }
+}
+
+bool V4L2BufferPool::Dequeue(struct v4l2_buffer* buf) {
+  memset(buf, 0, sizeof(struct v4l2_buffer));
+  buf->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  buf->memory = V4L2_MEMORY_MMAP;
+  // dequeue a buffer - repeat until dequeued properly!
+  while (ioctl(device_fd_, VIDIOC_DQBUF, buf) < 0) {
+    if (errno != EINTR)
+      return false;
+  }
+  RTC_DCHECK_LT(buf->index, buffers_.size());
+  rtc::CritScope cs(&crit_);
+  --num_queued_;
+  return true;
+}
+
+void V4L2BufferPool::Enqueue(int index) {
+  struct v4l2_buffer buf;
+  memset(&buf, 0, sizeof(struct v4l2_buffer));
+  buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  buf.memory = V4L2_MEMORY_MMAP;
+  buf.index = index;
+  // Held across the ioctl so that Stop() can't return, and the device be
+  // closed, while the buffer is being queued.
+  rtc::CritScope cs(&crit_);
+  if (stopped_)
+    return;
+  if (ioctl(device_fd_, VIDIOC_QBUF, &buf) == -1) {
+    RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+    return;
+  }
+  ++num_queued_;
+}
+
+int V4L2BufferPool::NumQueued() const {
+  rtc::CritScope cs(&crit_);
+  return num_queued_;
+}
+
+void V4L2BufferPool::Stop() {
+  rtc::CritScope cs(&crit_);
+  stopped_ = true;
+}
+
+V4L2FrameBuffer::V4L2FrameBuffer(rtc::scoped_refptr<V4L2BufferPool> pool,
+                                 int index,
+                                 size_t bytes_used,
+                                 int width,
+                                 int height,
+                                 VideoType video_type)
+    : pool_(std::move(pool)),
+      index_(index),
+      bytes_used_(bytes_used),
+      width_(width),
+      height_(height),
+      video_type_(video_type) {
+  RTC_DCHECK_LE(bytes_used_, pool_->buffer(index_).length);
+}
+
+V4L2FrameBuffer::~V4L2FrameBuffer() {
+  pool_->Enqueue(index_);
+}
+
+VideoFrameBuffer::Type V4L2FrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int V4L2FrameBuffer::width() const {
+  return width_;
+}
+
+int V4L2FrameBuffer::height() const {
+  return height_;
+}
+
+const uint8_t* V4L2FrameBuffer::data() const {
+  return static_cast<const uint8_t*>(pool_->buffer(index_).start);
+}
+
+int V4L2FrameBuffer::dmabuf_fd() const {
+  return pool_->buffer(index_).dmabuf_fd;
+}
+
+rtc::scoped_refptr<I420BufferInterface> V4L2FrameBuffer::ToI420() {
+  if (video_type_ == VideoType::kI420) {
+    // Not cached, the wrapper keeps this frame alive.
+    const int stride_uv = (width_ + 1) / 2;
+    const uint8_t* data_u = data() + width_ * height_;
+    const uint8_t* data_v = data_u + stride_uv * ((height_ + 1) / 2);
+    return WrapI420Buffer(width_, height_, data(), width_, data_u, stride_uv,
+                          data_v, stride_uv,
+                          rtc::KeepRefUntilDone(
+                              rtc::scoped_refptr<V4L2FrameBuffer>(this)));
+  }
+
+  rtc::CritScope cs(&crit_);
+  if (converted_)
+    return converted_;
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+  const int conversion_result = libyuv::ConvertToI420(
+      data(), bytes_used_, buffer->MutableDataY(), buffer->StrideY(),
+      buffer->MutableDataU(), buffer->StrideU(), buffer->MutableDataV(),
+      buffer->StrideV(), 0, 0,  // No Cropping
+      width_, height_, width_, height_, libyuv::kRotate0,
+      ConvertVideoType(video_type_));
+  if (conversion_result < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to convert capture frame from type "
+                      << static_cast<int>(video_type_) << " to I420.";
+    return nullptr;
+  }
+  converted_ = buffer;
+  return converted_;
+}
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
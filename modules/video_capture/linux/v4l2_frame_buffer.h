@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+
+#include <linux/videodev2.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+// The mmap'd buffers of a V4L2 capture queue. A buffer dequeued by the capture
+// thread may be handed out in a V4L2FrameBuffer, which queues it again when
+// released, on whatever thread that happens. The mappings live as long as the
+// pool, i.e. until the last frame referencing them is gone, which may be after
+// the capture was stopped.
+class V4L2BufferPool : public rtc::RefCountInterface {
+ public:
+  struct Buffer {
+    void* start = nullptr;
+    size_t length = 0;
+    // The buffer exported with VIDIOC_EXPBUF, or -1.
+    int dmabuf_fd = -1;
+  };
+
+  // Requests, maps and queues up to |count| buffers on |device_fd|, and
+  // exports them as DMABUF if |export_dmabuf| and the driver supports it.
+  // Returns null on failure.
+  static rtc::scoped_refptr<V4L2BufferPool> Create(int device_fd,
+                                                   int count,
+                                                   bool export_dmabuf);
+
+  int size() const { return static_cast<int>(buffers_.size()); }
+  const Buffer& buffer(int index) const { return buffers_[index]; }
+
+  // Dequeues a filled buffer into |buf|, retrying if interrupted. Returns
+  // false with errno set on failure.
+  bool Dequeue(struct v4l2_buffer* buf);
+  // Hands the buffer at |index| back to the driver, unless Stop() was called.
+  // Virtual for testing.
+  virtual void Enqueue(int index);
+  // Number of buffers the driver can currently capture into.
+  int NumQueued() const;
+  // Must be called before the device is closed, nothing is queued after.
+  void Stop();
+
+ protected:
+  explicit V4L2BufferPool(int device_fd);
+  ~V4L2BufferPool() override;
+
+  // Takes ownership of the mapping and DMABUF of |buffer|.
+  void AddBuffer(const Buffer& buffer) { buffers_.push_back(buffer); }
+
+ private:
+  const int device_fd_;
+  std::vector<Buffer> buffers_;
+  rtc::CriticalSection crit_;
+  bool stopped_ RTC_GUARDED_BY(crit_) = false;
+  int num_queued_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+// A captured frame that still lives in the V4L2 buffer it was captured into.
+// Sinks that can consume the captured format, or the DMABUF it was exported
+// as, do so without any copy; the conversion to I420 only runs when ToI420()
+// is called. The buffer goes back to the driver once the frame is released.
+class V4L2FrameBuffer : public VideoFrameBuffer {
+ public:
+  V4L2FrameBuffer(rtc::scoped_refptr<V4L2BufferPool> pool,
+                  int index,
+                  size_t bytes_used,
+                  int width,
+                  int height,
+                  VideoType video_type);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  // I420 captures are wrapped, other formats are converted once and cached.
+  // Returns null if the conversion fails, e.g. for a corrupt MJPEG frame.
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  VideoType video_type() const { return video_type_; }
+  const uint8_t* data() const;
+  size_t size() const { return bytes_used_; }
+  // The DMABUF holding the frame, or -1 if it wasn't exported. Owned by the
+  // pool, it must not be closed and is only valid while the frame is held.
+  int dmabuf_fd() const;
+
+ protected:
+  ~V4L2FrameBuffer() override;
+
+ private:
+  const rtc::scoped_refptr<V4L2BufferPool> pool_;
+  const int index_;
+  const size_t bytes_used_;
+  const int width_;
+  const int height_;
+  const VideoType video_type_;
+  rtc::CriticalSection crit_;
+  rtc::scoped_refptr<I420BufferInterface> converted_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
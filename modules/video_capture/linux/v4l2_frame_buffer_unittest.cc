@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
+
+#include <string.h>
+#include <sys/mman.h>
+
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+namespace {
+
+constexpr int kWidth = 4;
+constexpr int kHeight = 2;
+constexpr int kNumBuffers = 2;
+
+// Maps anonymous memory instead of the buffers of a device, and records the
+// buffers handed back instead of queueing them.
+class FakeV4L2BufferPool : public V4L2BufferPool {
+ public:
+  FakeV4L2BufferPool() : V4L2BufferPool(/*device_fd=*/-1) {
+    for (int i = 0; i < kNumBuffers; ++i) {
+      Buffer buffer;
+      buffer.length = CalcBufferSize(VideoType::kI420, kWidth, kHeight) * 2;
+      buffer.start = mmap(nullptr, buffer.length, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      RTC_CHECK_NE(buffer.start, MAP_FAILED);
+      AddBuffer(buffer);
+    }
+  }
+
+  void Enqueue(int index) override { enqueued_.push_back(index); }
+
+  uint8_t* data(int index) {
+    return static_cast<uint8_t*>(buffer(index).start);
+  }
+  const std::vector<int>& enqueued() const { return enqueued_; }
+
+ private:
+  std::vector<int> enqueued_;
+};
+
+class V4L2FrameBufferTest : public ::testing::Test {
+ protected:
+  V4L2FrameBufferTest()
+      : pool_(new rtc::RefCountedObject<FakeV4L2BufferPool>()) {}
+
+  rtc::scoped_refptr<V4L2FrameBuffer> CreateFrame(int index,
+                                                  VideoType video_type) {
+    return new rtc::RefCountedObject<V4L2FrameBuffer>(
+        pool_, index, CalcBufferSize(video_type, kWidth, kHeight), kWidth,
+        kHeight, video_type);
+  }
+
+  rtc::scoped_refptr<FakeV4L2BufferPool> pool_;
+};
+
+TEST_F(V4L2FrameBufferTest, WrapsAnI420CaptureWithoutACopy) {
+  uint8_t* data = pool_->data(1);
+  memset(data, 16, kWidth * kHeight);
+  rtc::scoped_refptr<V4L2FrameBuffer> frame =
+      CreateFrame(1, VideoType::kI420);
+  EXPECT_EQ(frame->type(), VideoFrameBuffer::Type::kNative);
+  EXPECT_EQ(frame->data(), data);
+  EXPECT_EQ(frame->size(), CalcBufferSize(VideoType::kI420, kWidth, kHeight));
+  EXPECT_EQ(frame->dmabuf_fd(), -1);
+
+  rtc::scoped_refptr<I420BufferInterface> i420 = frame->ToI420();
+  ASSERT_TRUE(i420);
+  EXPECT_EQ(i420->width(), kWidth);
+  EXPECT_EQ(i420->height(), kHeight);
+  EXPECT_EQ(i420->DataY(), data);
+  EXPECT_EQ(i420->DataU(), data + kWidth * kHeight);
+  EXPECT_EQ(i420->DataV(), data + kWidth * kHeight + kWidth * kHeight / 4);
+
+  // The wrapper keeps the buffer from the driver.
+  frame = nullptr;
+  EXPECT_TRUE(pool_->enqueued().empty());
+  i420 = nullptr;
+  EXPECT_EQ(pool_->enqueued(), std::vector<int>({1}));
+}
+
+TEST_F(V4L2FrameBufferTest, ConvertsOtherFormatsOnce) {
+  // A gray YUY2 frame, Y0 U Y1 V.
+  uint8_t* data = pool_->data(0);
+  for (int i = 0; i < kWidth * kHeight * 2; i += 2) {
+    data[i] = 100;
+    data[i + 1] = 128;
+  }
+  rtc::scoped_refptr<V4L2FrameBuffer> frame =
+      CreateFrame(0, VideoType::kYUY2);
+  rtc::scoped_refptr<I420BufferInterface> i420 = frame->ToI420();
+  ASSERT_TRUE(i420);
+  EXPECT_NE(i420->DataY(), data);
+  EXPECT_EQ(i420->DataY()[0], 100);
+  EXPECT_EQ(i420->DataU()[0], 128);
+  EXPECT_EQ(frame->ToI420(), i420);
+
+  // The converted frame doesn't hold the V4L2 buffer.
+  frame = nullptr;
+  EXPECT_EQ(pool_->enqueued(), std::vector<int>({0}));
+  EXPECT_EQ(i420->DataY()[0], 100);
+}
+
+TEST_F(V4L2FrameBufferTest, HandsEachBufferBackOnce) {
+  rtc::scoped_refptr<V4L2FrameBuffer> first = CreateFrame(0, VideoType::kI420);
+  rtc::scoped_refptr<V4L2FrameBuffer> second =
+      CreateFrame(1, VideoType::kI420);
+  rtc::scoped_refptr<V4L2FrameBuffer> copy = second;
+  second = nullptr;
+  EXPECT_TRUE(pool_->enqueued().empty());
+  copy = nullptr;
+  first = nullptr;
+  EXPECT_EQ(pool_->enqueued(), std::vector<int>({1, 0}));
+}
+
+}  // namespace
+}  // namespace videocapturemodule
+}  // namespace webrtc
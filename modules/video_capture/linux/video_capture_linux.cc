@@ -25,13 +25,35 @@
 #include <string>
 
 #include "api/scoped_refptr.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "media/base/video_common.h"
 #include "modules/video_capture/video_capture.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/ref_counted_object.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace videocapturemodule {
+namespace {
+// "Enabled" delivers the captured frames in V4L2FrameBuffers rather than
+// converting them to I420 right away, "dmabuf" exports them as DMABUF too.
+constexpr char kNativeBuffersFieldTrial[] =
+    "WebRTC-VideoCapture-V4L2NativeBuffers";
+
+bool NativeBuffersEnabled() {
+  return field_trial::IsEnabled(kNativeBuffersFieldTrial);
+}
+
+bool ExportDmabufEnabled() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialFlag dmabuf("dmabuf");
+  ParseFieldTrial({&enabled, &dmabuf},
+                  field_trial::FindFullName(kNativeBuffersFieldTrial));
+  return enabled && dmabuf;
+}
+}  // namespace
+
 rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
     const char* deviceUniqueId) {
   rtc::scoped_refptr<VideoCaptureModuleV4L2> implementation(
@@ -53,7 +75,8 @@ VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
       _currentFrameRate(-1),
       _captureStarted(false),
       _captureVideoType(VideoType::kI420),
-      _pool(NULL) {}
+      native_buffers_(NativeBuffersEnabled()),
+      export_dmabuf_(ExportDmabufEnabled()) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   int len = strlen((const char*)deviceUniqueIdUTF8);
@@ -287,61 +310,18 @@ int32_t VideoCaptureModuleV4L2::StopCapture() {
 // critical section protected by the caller
 
 bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
-  struct v4l2_requestbuffers rbuffer;
-  memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
-
-  rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-  rbuffer.memory = V4L2_MEMORY_MMAP;
-  rbuffer.count = kNoOfV4L2Bufffers;
-
-  if (ioctl(_deviceFd, VIDIOC_REQBUFS, &rbuffer) < 0) {
-    RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
+  _pool = V4L2BufferPool::Create(_deviceFd, kNoOfV4L2Bufffers, export_dmabuf_);
+  if (!_pool)
     return false;
-  }
-
-  if (rbuffer.count > kNoOfV4L2Bufffers)
-    rbuffer.count = kNoOfV4L2Bufffers;
-
-  _buffersAllocatedByDevice = rbuffer.count;
-
-  // Map the buffers
-  _pool = new Buffer[rbuffer.count];
-
-  for (unsigned int i = 0; i < rbuffer.count; i++) {
-    struct v4l2_buffer buffer;
-    memset(&buffer, 0, sizeof(v4l2_buffer));
-    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    buffer.memory = V4L2_MEMORY_MMAP;
-    buffer.index = i;
-
-    if (ioctl(_deviceFd, VIDIOC_QUERYBUF, &buffer) < 0) {
-      return false;
-    }
-
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
-
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
-      return false;
-    }
-
-    _pool[i].length = buffer.length;
-
-    if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
-      return false;
-    }
-  }
+  _buffersAllocatedByDevice = _pool->size();
   return true;
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
+  // Frames still held by the sinks keep the buffers mapped, but must not
+  // queue them on the device that is about to be closed.
+  _pool->Stop();
+  _pool = nullptr;
 
   // turn off stream
   enum v4l2_buf_type type;
@@ -395,28 +375,33 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
 
     if (_captureStarted) {
       struct v4l2_buffer buf;
-      memset(&buf, 0, sizeof(struct v4l2_buffer));
-      buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-      buf.memory = V4L2_MEMORY_MMAP;
-      // dequeue a buffer - repeat until dequeued properly!
-      while (ioctl(_deviceFd, VIDIOC_DQBUF, &buf) < 0) {
-        if (errno != EINTR) {
-          RTC_LOG(LS_INFO) << "could not sync on a buffer on device "
-                           << strerror(errno);
-          return true;
-        }
+      if (!_pool->Dequeue(&buf)) {
+        RTC_LOG(LS_INFO) << "could not sync on a buffer on device "
+                         << strerror(errno);
+        return true;
       }
       VideoCaptureCapability frameInfo;
       frameInfo.width = _currentWidth;
       frameInfo.height = _currentHeight;
       frameInfo.videoType = _captureVideoType;
 
-      // convert to to I420 if needed
-      IncomingFrame((unsigned char*)_pool[buf.index].start, buf.bytesused,
-                    frameInfo);
-      // enqueue the buffer again
-      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      // The buffer is enqueued again once the last reference to it is gone.
+      rtc::scoped_refptr<V4L2FrameBuffer> buffer(
+          new rtc::RefCountedObject<V4L2FrameBuffer>(
+              _pool, buf.index, buf.bytesused, _currentWidth, _currentHeight,
+              _captureVideoType));
+      // Frames of an unexpected size, and frames to be rotated, take the
+      // conversion path, which drops or rotates them.
+      bool deliver_native =
+          native_buffers_ &&
+          _pool->NumQueued() >= kMinQueuedV4L2Buffers &&
+          (_captureVideoType == VideoType::kMJPEG ||
+           CalcBufferSize(_captureVideoType, _currentWidth, _currentHeight) ==
+               buf.bytesused);
+      if (!deliver_native || IncomingFrameBuffer(buffer) != 0) {
+        // convert to to I420 if needed
+        IncomingFrame(const_cast<uint8_t*>(buffer->data()), buffer->size(),
+                      frameInfo);
       }
     }
   }
@@ -16,6 +16,8 @@
 
 #include <memory>
 
+#include "api/scoped_refptr.h"
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/critical_section.h"
@@ -35,6 +37,10 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
 
  private:
   enum { kNoOfV4L2Bufffers = 4 };
+  // Captured frames are only handed out in their V4L2 buffer while the driver
+  // keeps at least this many buffers to capture into, so that sinks holding
+  // on to frames can't stall the capture.
+  enum { kMinQueuedV4L2Buffers = 2 };
 
   static void CaptureThread(void*);
   bool CaptureProcess();
@@ -54,11 +60,10 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _currentFrameRate;
   bool _captureStarted;
   VideoType _captureVideoType;
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool;
+  // Set by the WebRTC-VideoCapture-V4L2NativeBuffers field trial.
+  const bool native_buffers_;
+  const bool export_dmabuf_;
+  rtc::scoped_refptr<V4L2BufferPool> _pool;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
@@ -20,6 +20,7 @@
 
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
 #include "modules/video_capture/video_capture.h"
@@ -66,6 +67,11 @@ class VideoCaptureImpl : public VideoCaptureModule {
                         size_t videoFrameLength,
                         const VideoCaptureCapability& frameInfo,
                         int64_t captureTime = 0);
+  // Delivers a frame that is already in a VideoFrameBuffer as is, e.g. a
+  // native buffer the capturer wraps without copying. Returns -1 if the frame
+  // has to be rotated, which the caller needs to do through IncomingFrame().
+  int32_t IncomingFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                              int64_t captureTime = 0);
 
   // Platform dependent
   int32_t StartCapture(const VideoCaptureCapability& capability) override;
@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -26,6 +27,7 @@
 #include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "third_party/libaom/source/libaom/aom/aom_codec.h"
 #include "third_party/libaom/source/libaom/aom/aom_encoder.h"
 #include "third_party/libaom/source/libaom/aom/aomcx.h"
@@ -36,7 +38,9 @@ namespace {
 // Encoder configuration parameters
 constexpr int kQpMax = 56;
 constexpr int kQpMin = 10;
-constexpr int kDefaultEncSpeed = 7;  // Use values 6, 7, or 8 for RTC.
+// Use values 6, 7, or 8 for RTC, the higher the faster.
+constexpr int kMinEncSpeed = 6;
+constexpr int kMaxEncSpeed = 8;
 constexpr int kUsageProfile = 1;     // 0 = good quality; 1 = real-time.
 constexpr int kMinQindex = 58;       // Min qindex threshold for QP scaling.
 constexpr int kMaxQindex = 180;      // Max qindex threshold for QP scaling.
@@ -44,6 +48,31 @@ constexpr int kBitDepth = 8;
 constexpr int kLagInFrames = 0;  // No look ahead.
 constexpr int kRtpTicksPerSecond = 90000;
 constexpr float kMinimumFrameRate = 1.0;
+// The speed is revisited once per this many frames, based on how much of the
+// frame interval their encoding took on average.
+constexpr int kFramesPerSpeedUpdate = 30;
+constexpr double kSpeedUpEncodeUsage = 0.7;
+constexpr double kSlowDownEncodeUsage = 0.3;
+
+// The speed to start with, faster for larger frames so that 720p keeps up in
+// real time.
+int GetDefaultEncSpeed(int width, int height) {
+  if (width * height <= 320 * 180)
+    return kMinEncSpeed;
+  if (width * height <= 640 * 360)
+    return 7;
+  return kMaxEncSpeed;
+}
+
+// Keeps the number of encoder threads equal to a possible number of tile
+// columns, (1, 2, 4), which is what libaom splits the frame into for threads.
+int NumberOfThreads(int width, int height, int number_of_cores) {
+  if (width * height >= 640 * 360 && number_of_cores > 4)
+    return 4;
+  if (width * height >= 320 * 180 && number_of_cores > 2)
+    return 2;
+  return 1;
+}
 
 class LibaomAv1Encoder final : public VideoEncoder {
  public:
@@ -66,8 +95,19 @@ class LibaomAv1Encoder final : public VideoEncoder {
   EncoderInfo GetEncoderInfo() const override;
 
  private:
+  // Adapts the speed to how long the last frames took to encode, between the
+  // default speed for the resolution and kMaxEncSpeed. Heavier CPU load is
+  // left to the OveruseFrameDetector driven resolution and frame rate
+  // adaptation, which restarts the encoder at the default speed of the new
+  // resolution.
+  void UpdateSpeed(int64_t encode_time_us);
+
   bool inited_;
   bool keyframe_required_;
+  int default_speed_;
+  int speed_;
+  int frames_since_speed_update_;
+  int64_t encode_time_since_speed_update_us_;
   VideoCodec encoder_settings_;
   aom_image_t* frame_for_encode_;
   aom_codec_ctx_t ctx_;
@@ -103,6 +143,10 @@ int32_t VerifyCodecSettings(const VideoCodec& codec_settings) {
 LibaomAv1Encoder::LibaomAv1Encoder()
     : inited_(false),
       keyframe_required_(true),
+      default_speed_(kMaxEncSpeed),
+      speed_(kMaxEncSpeed),
+      frames_since_speed_update_(0),
+      encode_time_since_speed_update_us_(0),
       frame_for_encode_(nullptr),
       encoded_image_callback_(nullptr) {}
 
@@ -146,7 +190,8 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   // Overwrite default config with input encoder settings & RTC-relevant values.
   cfg_.g_w = encoder_settings_.width;
   cfg_.g_h = encoder_settings_.height;
-  cfg_.g_threads = settings.number_of_cores;
+  cfg_.g_threads =
+      NumberOfThreads(cfg_.g_w, cfg_.g_h, settings.number_of_cores);
   cfg_.g_timebase.num = 1;
   cfg_.g_timebase.den = kRtpTicksPerSecond;
   cfg_.rc_target_bitrate = encoder_settings_.maxBitrate;  // kilobits/sec.
@@ -180,7 +225,11 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   inited_ = true;
 
   // Set control parameters
-  ret = aom_codec_control(&ctx_, AOME_SET_CPUUSED, kDefaultEncSpeed);
+  default_speed_ = GetDefaultEncSpeed(cfg_.g_w, cfg_.g_h);
+  speed_ = default_speed_;
+  frames_since_speed_update_ = 0;
+  encode_time_since_speed_update_us_ = 0;
+  ret = aom_codec_control(&ctx_, AOME_SET_CPUUSED, speed_);
   if (ret != AOM_CODEC_OK) {
     RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::EncodeInit returned " << ret
                         << " on control AV1E_SET_CPUUSED.";
@@ -204,6 +253,21 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
                         << " on control AV1E_SET_AQ_MODE.";
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
+  // One tile column per thread, log2 coded, each row of superblocks of a tile
+  // is encoded by a thread as well.
+  ret = aom_codec_control(&ctx_, AV1E_SET_TILE_COLUMNS,
+                          cfg_.g_threads == 4 ? 2 : cfg_.g_threads - 1);
+  if (ret != AOM_CODEC_OK) {
+    RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::EncodeInit returned " << ret
+                        << " on control AV1E_SET_TILE_COLUMNS.";
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  ret = aom_codec_control(&ctx_, AV1E_SET_ROW_MT, 1);
+  if (ret != AOM_CODEC_OK) {
+    RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::EncodeInit returned " << ret
+                        << " on control AV1E_SET_ROW_MT.";
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
 
   return WEBRTC_VIDEO_CODEC_OK;
 }
@@ -266,6 +330,7 @@ int32_t LibaomAv1Encoder::Encode(
   aom_enc_frame_flags_t flags = (keyframe_required_) ? AOM_EFLAG_FORCE_KF : 0;
 
   // Encode a frame.
+  int64_t encode_start_us = rtc::TimeMicros();
   aom_codec_err_t ret = aom_codec_encode(&ctx_, frame_for_encode_,
                                          frame.timestamp(), duration, flags);
   if (ret != AOM_CODEC_OK) {
@@ -273,6 +338,7 @@ int32_t LibaomAv1Encoder::Encode(
                         << " on aom_codec_encode.";
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
+  UpdateSpeed(rtc::TimeMicros() - encode_start_us);
 
   // Get encoded image data.
   EncodedImage encoded_image;
@@ -337,6 +403,35 @@ int32_t LibaomAv1Encoder::Encode(
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+void LibaomAv1Encoder::UpdateSpeed(int64_t encode_time_us) {
+  encode_time_since_speed_update_us_ += encode_time_us;
+  if (++frames_since_speed_update_ < kFramesPerSpeedUpdate)
+    return;
+  double encode_usage =
+      encode_time_since_speed_update_us_ * encoder_settings_.maxFramerate /
+      (static_cast<double>(frames_since_speed_update_) *
+       rtc::kNumMicrosecsPerSec);
+  frames_since_speed_update_ = 0;
+  encode_time_since_speed_update_us_ = 0;
+
+  int speed = speed_;
+  if (encode_usage > kSpeedUpEncodeUsage)
+    speed = std::min(speed_ + 1, kMaxEncSpeed);
+  else if (encode_usage < kSlowDownEncodeUsage)
+    speed = std::max(speed_ - 1, default_speed_);
+  if (speed == speed_)
+    return;
+  aom_codec_err_t ret = aom_codec_control(&ctx_, AOME_SET_CPUUSED, speed);
+  if (ret != AOM_CODEC_OK) {
+    RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::Encode returned " << ret
+                        << " on control AV1E_SET_CPUUSED.";
+    return;
+  }
+  RTC_LOG(LS_INFO) << "LibaomAv1Encoder speed " << speed_ << " -> " << speed
+                   << ", encode usage " << encode_usage;
+  speed_ = speed;
+}
+
 void LibaomAv1Encoder::SetRates(const RateControlParameters& parameters) {
   if (!inited_) {
     RTC_LOG(LS_WARNING) << "SetRates() while encoder is not initialized";
@@ -40,5 +40,20 @@ TEST(LibaomAv1EncoderTest, InitAndRelease) {
   EXPECT_EQ(encoder->Release(), WEBRTC_VIDEO_CODEC_OK);
 }
 
+TEST(LibaomAv1EncoderTest, InitAndReleaseWithMultipleThreads) {
+  std::unique_ptr<VideoEncoder> encoder = CreateLibaomAv1Encoder();
+  ASSERT_TRUE(encoder);
+  VideoCodec codec_settings;
+  codec_settings.width = 1280;
+  codec_settings.height = 720;
+  codec_settings.maxFramerate = 30;
+  VideoEncoder::Capabilities capabilities(/*loss_notification=*/false);
+  VideoEncoder::Settings encoder_settings(capabilities, /*number_of_cores=*/8,
+                                          /*max_payload_size=*/1200);
+  EXPECT_EQ(encoder->InitEncode(&codec_settings, encoder_settings),
+            WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(encoder->Release(), WEBRTC_VIDEO_CODEC_OK);
+}
+
 }  // namespace
 }  // namespace webrtc
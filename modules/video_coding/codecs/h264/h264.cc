@@ -117,4 +117,24 @@ bool H264Decoder::IsSupported() {
   return IsH264CodecSupported();
 }
 
+std::unique_ptr<H264Decoder> H264Decoder::CreateVaapi() {
+  RTC_DCHECK(H264Decoder::IsVaapiSupported());
+#if defined(WEBRTC_USE_H264_VAAPI)
+  RTC_CHECK(g_rtc_use_h264);
+  RTC_LOG(LS_INFO) << "Creating H264DecoderImpl with VAAPI.";
+  return std::make_unique<H264DecoderImpl>(/*use_vaapi=*/true);
+#else
+  RTC_NOTREACHED();
+  return nullptr;
+#endif
+}
+
+bool H264Decoder::IsVaapiSupported() {
+#if defined(WEBRTC_USE_H264_VAAPI)
+  return IsH264CodecSupported();
+#else
+  return false;
+#endif
+}
+
 }  // namespace webrtc
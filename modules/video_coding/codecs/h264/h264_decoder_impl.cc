@@ -24,6 +24,9 @@ extern "C" {
 #include "third_party/ffmpeg/libavcodec/avcodec.h"
 #include "third_party/ffmpeg/libavformat/avformat.h"
 #include "third_party/ffmpeg/libavutil/imgutils.h"
+#ifdef WEBRTC_USE_H264_VAAPI
+#include "third_party/ffmpeg/libavutil/hwcontext.h"
+#endif
 }  // extern "C"
 
 #include "api/video/color_space.h"
@@ -31,6 +34,9 @@ extern "C" {
 #include "api/video/i420_buffer.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "modules/video_coding/codecs/h264/h264_color_space.h"
+#ifdef WEBRTC_USE_H264_VAAPI
+#include "modules/video_coding/codecs/h264/vaapi_video_frame_buffer.h"
+#endif
 #include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/keep_ref_until_done.h"
@@ -47,6 +53,11 @@ const AVPixelFormat kPixelFormatFullRange = AV_PIX_FMT_YUVJ420P;
 const size_t kYPlaneIndex = 0;
 const size_t kUPlaneIndex = 1;
 const size_t kVPlaneIndex = 2;
+#ifdef WEBRTC_USE_H264_VAAPI
+// Surfaces allocated beyond what the decoder references, decoded frames hold
+// on to theirs until they are rendered.
+const int kExtraVaapiSurfaces = 8;
+#endif
 
 // Used by histograms. Values of entries should not be changed.
 enum H264DecoderImplEvent {
@@ -150,12 +161,36 @@ void H264DecoderImpl::AVFreeBuffer2(void* opaque, uint8_t* data) {
   delete video_frame;
 }
 
+#ifdef WEBRTC_USE_H264_VAAPI
+AVPixelFormat H264DecoderImpl::AVGetFormatVaapi(AVCodecContext* context,
+                                                const AVPixelFormat* formats) {
+  for (const AVPixelFormat* format = formats; *format != AV_PIX_FMT_NONE;
+       ++format) {
+    if (*format == AV_PIX_FMT_VAAPI)
+      return *format;
+  }
+  // Fails the decode, which falls back to software.
+  RTC_LOG(LS_WARNING) << "VAAPI can't decode this H.264 stream.";
+  return AV_PIX_FMT_NONE;
+}
+#endif
+
 H264DecoderImpl::H264DecoderImpl()
-    : pool_(true),
+    : use_vaapi_(false),
+      pool_(true),
       decoded_image_callback_(nullptr),
       has_reported_init_(false),
       has_reported_error_(false) {}
 
+#ifdef WEBRTC_USE_H264_VAAPI
+H264DecoderImpl::H264DecoderImpl(bool use_vaapi)
+    : use_vaapi_(use_vaapi),
+      pool_(true),
+      decoded_image_callback_(nullptr),
+      has_reported_init_(false),
+      has_reported_error_(false) {}
+#endif
+
 H264DecoderImpl::~H264DecoderImpl() {
   Release();
 }
@@ -194,12 +229,25 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
   av_context_->thread_count = 1;
   av_context_->thread_type = FF_THREAD_SLICE;
 
-  // Function used by FFmpeg to get buffers to store decoded frames in.
-  av_context_->get_buffer2 = AVGetBuffer2;
+  // Function used by FFmpeg to get buffers to store decoded frames in. With
+  // VAAPI, FFmpeg allocates the surfaces itself.
+  if (!use_vaapi_)
+    av_context_->get_buffer2 = AVGetBuffer2;
   // |get_buffer2| is called with the context, there |opaque| can be used to get
   // a pointer |this|.
   av_context_->opaque = this;
 
+#ifdef WEBRTC_USE_H264_VAAPI
+  if (use_vaapi_) {
+    ret = InitVaapi();
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      Release();
+      ReportError();
+      return ret;
+    }
+  }
+#endif
+
   AVCodec* codec = avcodec_find_decoder(av_context_->codec_id);
   if (!codec) {
     // This is an indication that FFmpeg has not been initialized or it has not
@@ -214,7 +262,7 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
     RTC_LOG(LS_ERROR) << "avcodec_open2 error: " << res;
     Release();
     ReportError();
-    return WEBRTC_VIDEO_CODEC_ERROR;
+    return DecodeError();
   }
 
   av_frame_.reset(av_frame_alloc());
@@ -227,6 +275,23 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+#ifdef WEBRTC_USE_H264_VAAPI
+int32_t H264DecoderImpl::InitVaapi() {
+  AVBufferRef* device = nullptr;
+  int res = av_hwdevice_ctx_create(&device, AV_HWDEVICE_TYPE_VAAPI, nullptr,
+                                   nullptr, 0);
+  if (res < 0) {
+    RTC_LOG(LS_WARNING) << "av_hwdevice_ctx_create error: " << res;
+    return WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE;
+  }
+  // Owned by |av_context_| from here.
+  av_context_->hw_device_ctx = device;
+  av_context_->get_format = AVGetFormatVaapi;
+  av_context_->extra_hw_frames = kExtraVaapiSurfaces;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+#endif
+
 int32_t H264DecoderImpl::Release() {
   av_context_.reset();
   av_frame_.reset();
@@ -276,14 +341,14 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
   if (result < 0) {
     RTC_LOG(LS_ERROR) << "avcodec_send_packet error: " << result;
     ReportError();
-    return WEBRTC_VIDEO_CODEC_ERROR;
+    return DecodeError();
   }
 
   result = avcodec_receive_frame(av_context_.get(), av_frame_.get());
   if (result < 0) {
     RTC_LOG(LS_ERROR) << "avcodec_receive_frame error: " << result;
     ReportError();
-    return WEBRTC_VIDEO_CODEC_ERROR;
+    return DecodeError();
   }
 
   // We don't expect reordering. Decoded frame tamestamp should match
@@ -298,6 +363,33 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
     qp.emplace(qp_int);
   }
 
+  // Pass on color space from input frame if explicitly specified.
+  const ColorSpace& color_space =
+      input_image.ColorSpace() ? *input_image.ColorSpace()
+                               : ExtractH264ColorSpace(av_context_.get());
+
+#ifdef WEBRTC_USE_H264_VAAPI
+  if (use_vaapi_) {
+    if (av_frame_->format != AV_PIX_FMT_VAAPI) {
+      RTC_LOG(LS_WARNING) << "VAAPI decoder output is not a surface.";
+      av_frame_unref(av_frame_.get());
+      ReportError();
+      return WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE;
+    }
+    // The image stays in the surface, no copy.
+    VideoFrame decoded_frame =
+        VideoFrame::Builder()
+            .set_video_frame_buffer(
+                VaapiVideoFrameBuffer::Create(av_frame_.get()))
+            .set_timestamp_rtp(input_image.Timestamp())
+            .set_color_space(color_space)
+            .build();
+    decoded_image_callback_->Decoded(decoded_frame, absl::nullopt, qp);
+    av_frame_unref(av_frame_.get());
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+#endif
+
   // Obtain the |video_frame| containing the decoded image.
   VideoFrame* input_frame =
       static_cast<VideoFrame*>(av_buffer_get_opaque(av_frame_->buf[0]));
@@ -332,11 +424,6 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
       av_frame_->linesize[kUPlaneIndex], av_frame_->data[kVPlaneIndex],
       av_frame_->linesize[kVPlaneIndex], rtc::KeepRefUntilDone(i420_buffer));
 
-  // Pass on color space from input frame if explicitly specified.
-  const ColorSpace& color_space =
-      input_image.ColorSpace() ? *input_image.ColorSpace()
-                               : ExtractH264ColorSpace(av_context_.get());
-
   VideoFrame decoded_frame = VideoFrame::Builder()
                                  .set_video_frame_buffer(cropped_buffer)
                                  .set_timestamp_rtp(input_image.Timestamp())
@@ -356,13 +443,19 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
 }
 
 const char* H264DecoderImpl::ImplementationName() const {
-  return "FFmpeg";
+  return use_vaapi_ ? "FFmpeg (VAAPI)" : "FFmpeg";
 }
 
 bool H264DecoderImpl::IsInitialized() const {
   return av_context_ != nullptr;
 }
 
+int32_t H264DecoderImpl::DecodeError() const {
+  // The software decoder may manage what the hardware can't.
+  return use_vaapi_ ? WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE
+                    : WEBRTC_VIDEO_CODEC_ERROR;
+}
+
 void H264DecoderImpl::ReportInit() {
   if (has_reported_init_)
     return;
@@ -58,6 +58,13 @@ struct AVFrameDeleter {
 class H264DecoderImpl : public H264Decoder {
  public:
   H264DecoderImpl();
+#ifdef WEBRTC_USE_H264_VAAPI
+  // With |use_vaapi| frames are decoded by the GPU into VAAPI surfaces and
+  // output as VaapiVideoFrameBuffer. InitDecode() and Decode() return
+  // WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE if that fails, so that a
+  // VideoDecoderSoftwareFallbackWrapper switches to a software decoder.
+  explicit H264DecoderImpl(bool use_vaapi);
+#endif
   ~H264DecoderImpl() override;
 
   // If |codec_settings| is NULL it is ignored. If it is not NULL,
@@ -85,13 +92,22 @@ class H264DecoderImpl : public H264Decoder {
                           int flags);
   // Called by FFmpeg when it is done with a video frame, see |AVGetBuffer2|.
   static void AVFreeBuffer2(void* opaque, uint8_t* data);
+#ifdef WEBRTC_USE_H264_VAAPI
+  // Called by FFmpeg to pick the output format, picks VAAPI surfaces.
+  static AVPixelFormat AVGetFormatVaapi(AVCodecContext* context,
+                                        const AVPixelFormat* formats);
+  int32_t InitVaapi();
+#endif
 
   bool IsInitialized() const;
+  // The error to return when decoding fails.
+  int32_t DecodeError() const;
 
   // Reports statistics with histograms.
   void ReportInit();
   void ReportError();
 
+  const bool use_vaapi_;
   I420BufferPool pool_;
   std::unique_ptr<AVCodecContext, AVCodecContextDeleter> av_context_;
   std::unique_ptr<AVFrame, AVFrameDeleter> av_frame_;
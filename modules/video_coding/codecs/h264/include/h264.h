@@ -54,6 +54,13 @@ class RTC_EXPORT H264Decoder : public VideoDecoder {
  public:
   static std::unique_ptr<H264Decoder> Create();
   static bool IsSupported();
+  // Creates a decoder that decodes on the GPU through VAAPI. It returns
+  // WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE when it can't, wrap it with
+  // CreateVideoDecoderSoftwareFallbackWrapper().
+  static std::unique_ptr<H264Decoder> CreateVaapi();
+  // If the build has VAAPI support (|rtc_use_h264_vaapi|). Whether the machine
+  // has a usable GPU is only known once decoding starts.
+  static bool IsVaapiSupported();
 
   ~H264Decoder() override {}
 };
@@ -18,6 +18,7 @@
 #include "api/video/video_frame.h"
 #include "api/video_codecs/video_codec.h"
 #include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_decoder_software_fallback_wrapper.h"
 #include "api/video_codecs/video_encoder.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "media/base/codec.h"
@@ -96,4 +97,32 @@ TEST_F(TestH264Impl, MAYBE_DecodedQpEqualsEncodedQp) {
   EXPECT_EQ(encoded_frame.qp_, *decoded_qp);
 }
 
+#ifdef WEBRTC_USE_H264_VAAPI
+// Decodes on the GPU where the machine has one, in software otherwise.
+class TestH264VaapiImpl : public TestH264Impl {
+ protected:
+  std::unique_ptr<VideoDecoder> CreateDecoder() override {
+    return CreateVideoDecoderSoftwareFallbackWrapper(
+        H264Decoder::Create(), H264Decoder::CreateVaapi());
+  }
+};
+
+TEST_F(TestH264VaapiImpl, EncodeDecode) {
+  VideoFrame input_frame = NextInputFrame();
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Encode(input_frame, nullptr));
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+  // First frame should be a key frame.
+  encoded_frame._frameType = VideoFrameType::kVideoFrameKey;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder_->Decode(encoded_frame, false, 0));
+  std::unique_ptr<VideoFrame> decoded_frame;
+  absl::optional<uint8_t> decoded_qp;
+  ASSERT_TRUE(WaitForDecodedFrame(&decoded_frame, &decoded_qp));
+  ASSERT_TRUE(decoded_frame);
+  // Native VAAPI frames are mapped by I420PSNR().
+  EXPECT_GT(I420PSNR(&input_frame, decoded_frame.get()), 36);
+}
+#endif  // WEBRTC_USE_H264_VAAPI
+
 }  // namespace webrtc
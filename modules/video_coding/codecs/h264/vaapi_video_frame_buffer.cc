@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#ifdef WEBRTC_USE_H264_VAAPI
+
+#include "modules/video_coding/codecs/h264/vaapi_video_frame_buffer.h"
+
+extern "C" {
+#include "third_party/ffmpeg/libavutil/hwcontext.h"
+#include "third_party/ffmpeg/libavutil/hwcontext_vaapi.h"
+}  // extern "C"
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace webrtc {
+
+rtc::scoped_refptr<VaapiVideoFrameBuffer> VaapiVideoFrameBuffer::Create(
+    const AVFrame* av_frame) {
+  RTC_DCHECK_EQ(av_frame->format, AV_PIX_FMT_VAAPI);
+  AVFrame* clone = av_frame_clone(av_frame);
+  RTC_CHECK(clone);
+  return new rtc::RefCountedObject<VaapiVideoFrameBuffer>(clone);
+}
+
+VaapiVideoFrameBuffer::VaapiVideoFrameBuffer(AVFrame* av_frame)
+    : av_frame_(av_frame) {}
+
+VaapiVideoFrameBuffer::~VaapiVideoFrameBuffer() {
+  AVFrame* av_frame = av_frame_;
+  av_frame_free(&av_frame);
+}
+
+VideoFrameBuffer::Type VaapiVideoFrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int VaapiVideoFrameBuffer::width() const {
+  return av_frame_->width;
+}
+
+int VaapiVideoFrameBuffer::height() const {
+  return av_frame_->height;
+}
+
+rtc::scoped_refptr<I420BufferInterface> VaapiVideoFrameBuffer::ToI420() {
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(width(), height());
+  AVFrame* nv12_frame = av_frame_alloc();
+  RTC_CHECK(nv12_frame);
+  nv12_frame->format = AV_PIX_FMT_NV12;
+  int result = av_hwframe_transfer_data(nv12_frame, av_frame_, 0);
+  if (result < 0) {
+    // Receivers expect a buffer, a black frame is the least bad one.
+    RTC_LOG(LS_ERROR) << "av_hwframe_transfer_data error: " << result;
+    I420Buffer::SetBlack(i420_buffer);
+  } else {
+    libyuv::NV12ToI420(nv12_frame->data[0], nv12_frame->linesize[0],
+                       nv12_frame->data[1], nv12_frame->linesize[1],
+                       i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+                       i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+                       i420_buffer->MutableDataV(), i420_buffer->StrideV(),
+                       width(), height());
+  }
+  av_frame_free(&nv12_frame);
+  return i420_buffer;
+}
+
+uint32_t VaapiVideoFrameBuffer::va_surface() const {
+  // FFmpeg keeps the VASurfaceID in the fourth data pointer.
+  return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(av_frame_->data[3]));
+}
+
+void* VaapiVideoFrameBuffer::va_display() const {
+  const AVHWFramesContext* frames_context =
+      reinterpret_cast<AVHWFramesContext*>(av_frame_->hw_frames_ctx->data);
+  const AVVAAPIDeviceContext* device_context =
+      static_cast<AVVAAPIDeviceContext*>(frames_context->device_ctx->hwctx);
+  return device_context->display;
+}
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_USE_H264_VAAPI
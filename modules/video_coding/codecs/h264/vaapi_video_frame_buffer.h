@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_H264_VAAPI_VIDEO_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CODING_CODECS_H264_VAAPI_VIDEO_FRAME_BUFFER_H_
+
+// Only built with VAAPI support for the FFmpeg H.264 decoder, see
+// |rtc_use_h264_vaapi|.
+#ifdef WEBRTC_USE_H264_VAAPI
+
+#include <stdint.h>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+
+extern "C" {
+#include "third_party/ffmpeg/libavutil/frame.h"
+}  // extern "C"
+
+namespace webrtc {
+
+// A native buffer holding a frame decoded by FFmpeg into a VAAPI surface. The
+// decoded NV12 image stays in the surface, a renderer that knows of VAAPI can
+// use va_surface() directly. Everyone else gets a copy in system memory from
+// ToI420(). The surface goes back to the decoder's pool when the buffer is
+// released.
+class VaapiVideoFrameBuffer : public VideoFrameBuffer {
+ public:
+  // Takes a new reference to the surface of |av_frame|, which must be an
+  // AV_PIX_FMT_VAAPI frame.
+  static rtc::scoped_refptr<VaapiVideoFrameBuffer> Create(
+      const AVFrame* av_frame);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  // The VASurfaceID holding the image.
+  uint32_t va_surface() const;
+  // The VADisplay the surface belongs to.
+  void* va_display() const;
+
+ protected:
+  explicit VaapiVideoFrameBuffer(AVFrame* av_frame);
+  ~VaapiVideoFrameBuffer() override;
+
+ private:
+  AVFrame* const av_frame_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_USE_H264_VAAPI
+
+#endif  // MODULES_VIDEO_CODING_CODECS_H264_VAAPI_VIDEO_FRAME_BUFFER_H_
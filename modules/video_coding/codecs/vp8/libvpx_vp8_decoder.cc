@@ -316,6 +316,10 @@ int LibvpxVp8Decoder::ReturnFrame(
     return WEBRTC_VIDEO_CODEC_NO_OUTPUT;
   }
 
+  // Unlike VP9, the libvpx VP8 decoder doesn't support external frame buffers
+  // (vpx_codec_set_frame_buffer_functions() fails), and |img| points into
+  // buffers it overwrites on the next decode. The copy into a pooled buffer is
+  // what lets the frame outlive the call.
   libyuv::I420Copy(img->planes[VPX_PLANE_Y], img->stride[VPX_PLANE_Y],
                    img->planes[VPX_PLANE_U], img->stride[VPX_PLANE_U],
                    img->planes[VPX_PLANE_V], img->stride[VPX_PLANE_V],
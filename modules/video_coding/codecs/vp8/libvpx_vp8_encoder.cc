@@ -52,6 +52,13 @@ const char kVP8IosMaxNumberOfThreadFieldTrialParameter[] = "max_thread";
 const char kVp8ForcePartitionResilience[] =
     "WebRTC-VP8-ForcePartitionResilience";
 
+// Restricts screenshare encoding to the macroblocks covered by the update
+// rect of the input frames.
+const char kVp8ScreenshareActiveMap[] = "WebRTC-VP8-ScreenshareActiveMap";
+
+// Size in pixels of the square macroblocks of the active map.
+constexpr int kMacroblockSize = 16;
+
 // QP is obtained from VP8-bitstream for HW, so the QP corresponds to the
 // bitstream range of [0, 127] and not the user-level range of [0,63].
 constexpr int kLowVp8QpThreshold = 29;
@@ -285,7 +292,8 @@ LibvpxVp8Encoder::LibvpxVp8Encoder(std::unique_ptr<LibvpxInterface> interface,
       key_frame_request_(kMaxSimulcastStreams, false),
       variable_framerate_experiment_(ParseVariableFramerateConfig(
           "WebRTC-VP8VariableFramerateScreenshare")),
-      framerate_controller_(variable_framerate_experiment_.framerate_limit) {
+      framerate_controller_(variable_framerate_experiment_.framerate_limit),
+      use_active_map_(field_trial::IsEnabled(kVp8ScreenshareActiveMap)) {
   // TODO(eladalon/ilnik): These reservations might be wasting memory.
   // InitEncode() is resizing to the actual size, which might be smaller.
   raw_images_.reserve(kMaxSimulcastStreams);
@@ -505,6 +513,8 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   number_of_cores_ = settings.number_of_cores;
   timestamp_ = 0;
   codec_ = *inst;
+  unencoded_update_rect_ =
+      VideoFrame::UpdateRect{0, 0, inst->width, inst->height};
 
   // Code expects simulcastStream resolutions to be correct, make sure they are
   // filled even when there are no simulcast layers.
@@ -962,6 +972,15 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     }
   }
 
+  // Frames dropped before or by the encoder don't update its references, so
+  // the changes are carried over to the next frame.
+  if (frame.has_update_rect()) {
+    unencoded_update_rect_.Union(frame.update_rect());
+  } else {
+    unencoded_update_rect_ =
+        VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()};
+  }
+
   if (frame.update_rect().IsEmpty() && num_steady_state_frames_ >= 3 &&
       !key_frame_requested) {
     if (variable_framerate_experiment_.enabled &&
@@ -1054,6 +1073,9 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     std::fill(key_frame_request_.begin(), key_frame_request_.end(), false);
   }
 
+  if (use_active_map_)
+    UpdateActiveMap(send_key_frame);
+
   // Set the encoder frame flags and temporal layer_id for each spatial stream.
   // Note that streams are defined starting from lowest resolution at
   // position 0 to highest resolution at position |encoders_.size() - 1|,
@@ -1103,11 +1125,50 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Examines frame timestamps only.
     error = GetEncodedPartitions(frame, retransmission_allowed);
   }
+  if (encoded_images_[0].size() > 0)
+    unencoded_update_rect_.MakeEmptyUpdate();
   // TODO(sprang): Shouldn't we use the frame timestamp instead?
   timestamp_ += duration;
   return error;
 }
 
+void LibvpxVp8Encoder::UpdateActiveMap(bool key_frame) {
+  // Inactive macroblocks are coded as unchanged from the last frame, which is
+  // only the previous encoded frame with a single stream and temporal layer.
+  if (encoders_.size() != 1 || codec_.mode != VideoCodecMode::kScreensharing ||
+      codec_.VP8()->numberOfTemporalLayers > 1) {
+    return;
+  }
+
+  const unsigned int cols =
+      (codec_.width + kMacroblockSize - 1) / kMacroblockSize;
+  const unsigned int rows =
+      (codec_.height + kMacroblockSize - 1) / kMacroblockSize;
+  vpx_active_map_t map = {nullptr, rows, cols};
+  const VideoFrame::UpdateRect& rect = unencoded_update_rect_;
+  const bool full_frame =
+      rect.width == codec_.width && rect.height == codec_.height;
+  if (!key_frame && !full_frame) {
+    active_map_.assign(rows * cols, 0);
+    if (!rect.IsEmpty()) {
+      const int first_col = rect.offset_x / kMacroblockSize;
+      const int last_col = (rect.offset_x + rect.width - 1) / kMacroblockSize;
+      const int first_row = rect.offset_y / kMacroblockSize;
+      const int last_row = (rect.offset_y + rect.height - 1) / kMacroblockSize;
+      for (int row = first_row; row <= last_row; ++row) {
+        std::fill(active_map_.begin() + row * cols + first_col,
+                  active_map_.begin() + row * cols + last_col + 1, 1);
+      }
+    }
+    map.active_map = active_map_.data();
+  } else if (!active_map_enabled_) {
+    return;
+  }
+  // A null map marks all macroblocks active.
+  libvpx_->codec_control(&encoders_[0], VP8E_SET_ACTIVEMAP, &map);
+  active_map_enabled_ = map.active_map != nullptr;
+}
+
 void LibvpxVp8Encoder::PopulateCodecSpecific(CodecSpecificInfo* codec_specific,
                                              const vpx_codec_cx_pkt_t& pkt,
                                              int stream_idx,
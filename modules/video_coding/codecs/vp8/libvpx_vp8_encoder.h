@@ -93,6 +93,10 @@ class LibvpxVp8Encoder : public VideoEncoder {
 
   bool UpdateVpxConfiguration(size_t stream_index);
 
+  // Marks the macroblocks outside |unencoded_update_rect_| inactive, so that
+  // libvpx skips them. All macroblocks are active in key frames.
+  void UpdateActiveMap(bool key_frame);
+
   const std::unique_ptr<LibvpxInterface> libvpx_;
 
   const absl::optional<std::vector<CpuSpeedExperiment::Config>>
@@ -139,6 +143,13 @@ class LibvpxVp8Encoder : public VideoEncoder {
   FramerateController framerate_controller_;
   int num_steady_state_frames_ = 0;
 
+  // Screenshare active map related fields.
+  const bool use_active_map_;
+  // The area that changed since the last encoded frame.
+  VideoFrame::UpdateRect unencoded_update_rect_ = {0, 0, 0, 0};
+  std::vector<uint8_t> active_map_;
+  bool active_map_enabled_ = false;
+
   FecControllerOverride* fec_controller_override_ = nullptr;
 };
 
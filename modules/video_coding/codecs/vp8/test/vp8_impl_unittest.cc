@@ -32,6 +32,7 @@
 namespace webrtc {
 
 using ::testing::_;
+using ::testing::A;
 using ::testing::AllOf;
 using ::testing::ElementsAreArray;
 using ::testing::Field;
@@ -552,6 +553,87 @@ TEST_F(TestVp8Impl, KeepsTimestampOnReencode) {
   encoder.Encode(NextInputFrame(), &delta_frame);
 }
 
+TEST_F(TestVp8Impl, ScreenshareActiveMapCoversUpdateRect) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-VP8-ScreenshareActiveMap/Enabled/");
+  auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
+                           VP8Encoder::Settings());
+  codec_settings_.mode = VideoCodecMode::kScreensharing;
+  codec_settings_.VP8()->numberOfTemporalLayers = 1;
+
+  EXPECT_CALL(*vpx, img_wrap(_, _, _, _, _, _))
+      .WillOnce(Invoke([](vpx_image_t* img, vpx_img_fmt_t fmt, unsigned int d_w,
+                          unsigned int d_h, unsigned int stride_align,
+                          unsigned char* img_data) {
+        img->fmt = fmt;
+        img->d_w = d_w;
+        img->d_h = d_h;
+        img->img_data = img_data;
+        return img;
+      }));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, kSettings));
+  MockEncodedImageCallback callback;
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  // Every encode produces one frame packet.
+  uint8_t payload[10] = {0};
+  vpx_codec_cx_pkt_t packet = {};
+  packet.kind = VPX_CODEC_CX_FRAME_PKT;
+  packet.data.frame.buf = payload;
+  packet.data.frame.sz = sizeof(payload);
+  ON_CALL(*vpx, codec_get_cx_data(_, _))
+      .WillByDefault(Invoke(
+          [&packet](vpx_codec_ctx_t*,
+                    vpx_codec_iter_t* iter) -> const vpx_codec_cx_pkt_t* {
+            if (*iter != nullptr)
+              return nullptr;
+            *iter = &packet;
+            return &packet;
+          }));
+
+  std::vector<uint8_t> active_map;
+  bool map_set = false;
+  ON_CALL(*vpx, codec_control(_, VP8E_SET_ACTIVEMAP, A<vpx_active_map*>()))
+      .WillByDefault(
+          Invoke([&](vpx_codec_ctx_t*, vp8e_enc_control_id,
+                     vpx_active_map* map) {
+            map_set = true;
+            active_map.clear();
+            if (map->active_map) {
+              active_map.assign(map->active_map,
+                                map->active_map + map->rows * map->cols);
+            }
+            return VPX_CODEC_OK;
+          }));
+
+  auto delta_frame =
+      std::vector<VideoFrameType>{VideoFrameType::kVideoFrameDelta};
+  encoder.Encode(NextInputFrame(), &delta_frame);
+  EXPECT_FALSE(map_set);
+
+  // Only macroblocks in columns 1 and 2 of row 1 were updated.
+  VideoFrame frame = NextInputFrame();
+  frame.set_update_rect(VideoFrame::UpdateRect{16, 16, 20, 10});
+  encoder.Encode(frame, &delta_frame);
+  const int cols = (kWidth + 15) / 16;
+  const int rows = (kHeight + 15) / 16;
+  std::vector<uint8_t> expected(rows * cols, 0);
+  expected[cols + 1] = 1;
+  expected[cols + 2] = 1;
+  EXPECT_TRUE(map_set);
+  EXPECT_EQ(active_map, expected);
+
+  // A full update activates all macroblocks again.
+  map_set = false;
+  frame = NextInputFrame();
+  frame.clear_update_rect();
+  encoder.Encode(frame, &delta_frame);
+  EXPECT_TRUE(map_set);
+  EXPECT_TRUE(active_map.empty());
+}
+
 TEST(LibvpxVp8EncoderTest, GetEncoderInfoReturnsStaticInformation) {
   auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
   LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
+
+#include "api/units/time_delta.h"
+#include "rtc_base/fake_clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Vp9FrameBuffer = Vp9FrameBufferPool::Vp9FrameBuffer;
+using SharedPool = Vp9FrameBufferPool::SharedPool;
+
+// I420 frames of 640x360 and 320x180.
+constexpr size_t kLargeSize = 640 * 360 * 3 / 2;
+constexpr size_t kSmallSize = 320 * 180 * 3 / 2;
+constexpr int64_t kMaxIdleMs = 1000;
+
+TEST(Vp9FrameBufferPoolTest, SizeClassWastesAtMostAQuarter) {
+  for (size_t size : {1u, 7u, 100u, 4096u, 4097u, 345600u, 3110400u}) {
+    size_t size_class = Vp9FrameBufferPool::SizeClass(size);
+    EXPECT_GE(size_class, size);
+    EXPECT_LE(size_class, size + size / 4);
+  }
+  // Similar sizes share a class.
+  EXPECT_EQ(Vp9FrameBufferPool::SizeClass(kLargeSize),
+            Vp9FrameBufferPool::SizeClass(kLargeSize + 1000));
+}
+
+TEST(Vp9FrameBufferPoolTest, RecyclesFreeBuffers) {
+  Vp9FrameBufferPool pool;
+  rtc::scoped_refptr<Vp9FrameBuffer> in_use = pool.GetFrameBuffer(kLargeSize);
+  Vp9FrameBuffer* free_buffer = pool.GetFrameBuffer(kLargeSize).get();
+  EXPECT_NE(free_buffer, in_use.get());
+  EXPECT_EQ(pool.GetNumBuffersInUse(), 1);
+  // Without a shared pool, buffers of any size are recycled.
+  EXPECT_EQ(pool.GetFrameBuffer(kSmallSize).get(), free_buffer);
+}
+
+TEST(Vp9FrameBufferPoolTest, SharesBuffersOfOtherSizes) {
+  SharedPool shared_pool(10 * kLargeSize, kMaxIdleMs);
+  Vp9FrameBufferPool pool1(&shared_pool);
+  Vp9FrameBufferPool pool2(&shared_pool);
+  Vp9FrameBuffer* large = pool1.GetFrameBuffer(kLargeSize).get();
+  EXPECT_EQ(shared_pool.GetStats().num_buffers, 0u);
+
+  // The resolution drops, the large buffer is of no use to |pool1|.
+  rtc::scoped_refptr<Vp9FrameBuffer> small = pool1.GetFrameBuffer(kSmallSize);
+  EXPECT_NE(small.get(), large);
+  EXPECT_EQ(shared_pool.GetStats().num_buffers, 1u);
+  EXPECT_EQ(shared_pool.GetStats().num_bytes,
+            Vp9FrameBufferPool::SizeClass(kLargeSize));
+
+  EXPECT_EQ(pool2.GetFrameBuffer(kLargeSize).get(), large);
+  EXPECT_EQ(shared_pool.GetStats().num_buffers, 0u);
+}
+
+TEST(Vp9FrameBufferPoolTest, ClearPoolGivesFreeBuffersToSharedPool) {
+  SharedPool shared_pool(10 * kLargeSize, kMaxIdleMs);
+  Vp9FrameBufferPool pool(&shared_pool);
+  rtc::scoped_refptr<Vp9FrameBuffer> in_use = pool.GetFrameBuffer(kLargeSize);
+  pool.GetFrameBuffer(kLargeSize);
+  pool.ClearPool();
+  EXPECT_EQ(shared_pool.GetStats().num_buffers, 1u);
+  // Not recycled once released by the application.
+  in_use = nullptr;
+  EXPECT_EQ(shared_pool.GetStats().num_buffers, 1u);
+}
+
+TEST(Vp9FrameBufferPoolTest, SharedPoolStaysWithinBudget) {
+  const size_t size_class = Vp9FrameBufferPool::SizeClass(kLargeSize);
+  SharedPool shared_pool(3 * size_class, kMaxIdleMs);
+  {
+    Vp9FrameBufferPool pool(&shared_pool);
+    rtc::scoped_refptr<Vp9FrameBuffer> buffers[5];
+    for (auto& buffer : buffers)
+      buffer = pool.GetFrameBuffer(kLargeSize);
+  }
+  EXPECT_EQ(shared_pool.GetStats().num_buffers, 3u);
+  EXPECT_EQ(shared_pool.GetStats().num_bytes, 3 * size_class);
+}
+
+TEST(Vp9FrameBufferPoolTest, SharedPoolDropsIdleBuffers) {
+  rtc::ScopedBaseFakeClock clock;
+  clock.AdvanceTime(TimeDelta::Seconds(1));
+  SharedPool shared_pool(10 * kLargeSize, kMaxIdleMs);
+  Vp9FrameBufferPool pool(&shared_pool);
+  pool.GetFrameBuffer(kLargeSize);
+  pool.ClearPool();
+  clock.AdvanceTime(TimeDelta::Millis(kMaxIdleMs / 2));
+  pool.GetFrameBuffer(kSmallSize);
+  pool.ClearPool();
+  EXPECT_EQ(shared_pool.GetStats().num_buffers, 2u);
+
+  clock.AdvanceTime(TimeDelta::Millis(kMaxIdleMs / 2 + 1));
+  // Only the small buffer is left to take.
+  EXPECT_EQ(shared_pool.Take(Vp9FrameBufferPool::SizeClass(kLargeSize)),
+            nullptr);
+  EXPECT_EQ(shared_pool.GetStats().num_buffers, 1u);
+  EXPECT_NE(shared_pool.Take(Vp9FrameBufferPool::SizeClass(kSmallSize)),
+            nullptr);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -13,9 +13,14 @@
 
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
 
+#include <iterator>
+#include <utility>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
 #include "vpx/vpx_codec.h"
 #include "vpx/vpx_decoder.h"
 #include "vpx/vpx_frame_buffer.h"
@@ -30,8 +35,92 @@ size_t Vp9FrameBufferPool::Vp9FrameBuffer::GetDataSize() const {
   return data_.size();
 }
 
+size_t Vp9FrameBufferPool::Vp9FrameBuffer::GetCapacity() const {
+  return data_.capacity();
+}
+
 void Vp9FrameBufferPool::Vp9FrameBuffer::SetSize(size_t size) {
   data_.SetSize(size);
+  memory_.Set(data_.capacity());
+}
+
+void Vp9FrameBufferPool::Vp9FrameBuffer::EnsureCapacity(size_t capacity) {
+  data_.EnsureCapacity(capacity);
+  memory_.Set(data_.capacity());
+}
+
+Vp9FrameBufferPool::SharedPool* Vp9FrameBufferPool::SharedPool::GetDefault() {
+  static SharedPool* const pool =
+      new SharedPool(kDefaultSharedPoolMaxBytes, kDefaultSharedPoolMaxIdleMs);
+  return pool;
+}
+
+Vp9FrameBufferPool::SharedPool::SharedPool(size_t max_bytes,
+                                           int64_t max_idle_ms)
+    : max_bytes_(max_bytes), max_idle_ms_(max_idle_ms) {}
+
+Vp9FrameBufferPool::SharedPool::~SharedPool() = default;
+
+rtc::scoped_refptr<Vp9FrameBufferPool::Vp9FrameBuffer>
+Vp9FrameBufferPool::SharedPool::Take(size_t size_class) {
+  rtc::CritScope cs(&lock_);
+  Shrink(rtc::TimeMillis());
+  // The most recently given buffer, the oldest are the next to be dropped.
+  for (auto it = free_buffers_.rbegin(); it != free_buffers_.rend(); ++it) {
+    if (it->buffer->GetCapacity() == size_class) {
+      rtc::scoped_refptr<Vp9FrameBuffer> buffer = std::move(it->buffer);
+      free_buffers_.erase(std::next(it).base());
+      num_bytes_ -= size_class;
+      return buffer;
+    }
+  }
+  return nullptr;
+}
+
+void Vp9FrameBufferPool::SharedPool::Give(
+    rtc::scoped_refptr<Vp9FrameBuffer> buffer) {
+  RTC_DCHECK(buffer->HasOneRef());
+  int64_t now_ms = rtc::TimeMillis();
+  rtc::CritScope cs(&lock_);
+  num_bytes_ += buffer->GetCapacity();
+  free_buffers_.push_back({std::move(buffer), now_ms});
+  Shrink(now_ms);
+}
+
+Vp9FrameBufferPool::SharedPool::Stats
+Vp9FrameBufferPool::SharedPool::GetStats() const {
+  rtc::CritScope cs(&lock_);
+  Stats stats;
+  stats.num_buffers = free_buffers_.size();
+  stats.num_bytes = num_bytes_;
+  return stats;
+}
+
+void Vp9FrameBufferPool::SharedPool::Shrink(int64_t now_ms) {
+  while (!free_buffers_.empty() &&
+         (num_bytes_ > max_bytes_ ||
+          now_ms - free_buffers_.front().free_since_ms > max_idle_ms_)) {
+    num_bytes_ -= free_buffers_.front().buffer->GetCapacity();
+    free_buffers_.pop_front();
+  }
+}
+
+// static
+size_t Vp9FrameBufferPool::SizeClass(size_t min_size) {
+  // Multiples of a quarter of the largest power of two not above |min_size|.
+  size_t step = 1;
+  while (step <= min_size / 8)
+    step *= 2;
+  return (min_size + step - 1) / step * step;
+}
+
+Vp9FrameBufferPool::Vp9FrameBufferPool() : Vp9FrameBufferPool(nullptr) {}
+
+Vp9FrameBufferPool::Vp9FrameBufferPool(SharedPool* shared_pool)
+    : shared_pool_(shared_pool) {}
+
+Vp9FrameBufferPool::~Vp9FrameBufferPool() {
+  ClearPool();
 }
 
 bool Vp9FrameBufferPool::InitializeVpxUsePool(
@@ -60,15 +149,35 @@ Vp9FrameBufferPool::GetFrameBuffer(size_t min_size) {
   {
     rtc::CritScope cs(&buffers_lock_);
     // Do we have a buffer we can recycle?
+    size_t size_class = shared_pool_ ? SizeClass(min_size) : min_size;
     for (const auto& buffer : allocated_buffers_) {
-      if (buffer->HasOneRef()) {
+      if (buffer->HasOneRef() &&
+          (!shared_pool_ || buffer->GetCapacity() == size_class)) {
         available_buffer = buffer;
         break;
       }
     }
+    if (available_buffer == nullptr && shared_pool_) {
+      // The free buffers left are of other sizes, e.g. of the resolution
+      // before the last change, they may serve other decoders.
+      for (auto it = allocated_buffers_.begin();
+           it != allocated_buffers_.end();) {
+        if ((*it)->HasOneRef()) {
+          shared_pool_->Give(std::move(*it));
+          it = allocated_buffers_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      available_buffer = shared_pool_->Take(size_class);
+      if (available_buffer != nullptr)
+        allocated_buffers_.push_back(available_buffer);
+    }
     // Otherwise create one.
     if (available_buffer == nullptr) {
       available_buffer = new rtc::RefCountedObject<Vp9FrameBuffer>();
+      if (shared_pool_)
+        available_buffer->EnsureCapacity(size_class);
       allocated_buffers_.push_back(available_buffer);
       if (allocated_buffers_.size() > max_num_buffers_) {
         RTC_LOG(LS_WARNING)
@@ -131,6 +240,15 @@ bool Vp9FrameBufferPool::Resize(size_t max_number_of_buffers) {
 
 void Vp9FrameBufferPool::ClearPool() {
   rtc::CritScope cs(&buffers_lock_);
+  if (shared_pool_ && !allocated_buffers_.empty()) {
+    for (auto& buffer : allocated_buffers_) {
+      if (buffer->HasOneRef())
+        shared_pool_->Give(std::move(buffer));
+    }
+    RTC_HISTOGRAM_COUNTS_100000(
+        "WebRTC.Video.Vp9.SharedFrameBufferPoolKb",
+        static_cast<int>(shared_pool_->GetStats().num_bytes / 1024));
+  }
   allocated_buffers_.clear();
 }
 
@@ -14,12 +14,18 @@
 
 #ifdef RTC_ENABLE_VP9
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
 #include <vector>
 
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/memory/memory_accounting.h"
 #include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
 
 struct vpx_codec_ctx;
 struct vpx_codec_frame_buffer;
@@ -37,6 +43,11 @@ namespace webrtc {
 // video.
 constexpr size_t kDefaultMaxNumBuffers = 68;
 
+// The free buffers kept by the default Vp9FrameBufferPool::SharedPool, about
+// 15 1080p frames, and for how long at most.
+constexpr size_t kDefaultSharedPoolMaxBytes = 48 * 1024 * 1024;
+constexpr int64_t kDefaultSharedPoolMaxIdleMs = 10000;
+
 // This memory pool is used to serve buffers to libvpx for decoding purposes in
 // VP9, which is set up in InitializeVPXUsePool. After the initialization any
 // time libvpx wants to decode a frame it will use buffers provided and released
@@ -69,15 +80,79 @@ class Vp9FrameBufferPool {
    public:
     uint8_t* GetData();
     size_t GetDataSize() const;
+    // The size allocated, at least the data size.
+    size_t GetCapacity() const;
     void SetSize(size_t size);
+    void EnsureCapacity(size_t capacity);
 
     virtual bool HasOneRef() const = 0;
 
    private:
     // Data as an easily resizable buffer.
     rtc::Buffer data_;
+    // The capacity of |data_|, whether the buffer is in use, free in a pool or
+    // in the shared pool. Only resized while the pool holds the only
+    // reference.
+    TrackedMemory memory_{MemoryCategory::kVp9FrameBufferPool};
+  };
+
+  // Free buffers shared by the pools of many decoders. A pool that needs a
+  // buffer of a size class it has no free buffer of takes one from here, and
+  // gives its free buffers of other size classes here, e.g. after a resolution
+  // change or once its decoder is released. The shared buffers are bounded in
+  // bytes, and dropped after being unused for a while, oldest first.
+  class SharedPool {
+   public:
+    struct Stats {
+      size_t num_buffers = 0;
+      size_t num_bytes = 0;
+    };
+
+    // Process wide pool, created on first use and never destroyed.
+    static SharedPool* GetDefault();
+
+    SharedPool(size_t max_bytes, int64_t max_idle_ms);
+    ~SharedPool();
+
+    SharedPool(const SharedPool&) = delete;
+    SharedPool& operator=(const SharedPool&) = delete;
+
+    // Returns a free buffer with a capacity of |size_class| bytes, or null.
+    rtc::scoped_refptr<Vp9FrameBuffer> Take(size_t size_class);
+    // Keeps |buffer|, which must not be referenced anywhere else, for other
+    // pools.
+    void Give(rtc::scoped_refptr<Vp9FrameBuffer> buffer);
+
+    Stats GetStats() const;
+
+   private:
+    struct FreeBuffer {
+      rtc::scoped_refptr<Vp9FrameBuffer> buffer;
+      int64_t free_since_ms;
+    };
+
+    // Drops the buffers that are unused for too long or exceed the budget.
+    void Shrink(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+    const size_t max_bytes_;
+    const int64_t max_idle_ms_;
+    rtc::CriticalSection lock_;
+    // Oldest first.
+    std::deque<FreeBuffer> free_buffers_ RTC_GUARDED_BY(lock_);
+    size_t num_bytes_ RTC_GUARDED_BY(lock_) = 0;
   };
 
+  // The capacity of the buffers allocated for |min_size| bytes by pools with
+  // a SharedPool. There are four size classes per power of two, so that the
+  // buffers of a resolution can serve similar ones without wasting more than a
+  // quarter of their memory.
+  static size_t SizeClass(size_t min_size);
+
+  Vp9FrameBufferPool();
+  // Recycles the buffers of other pools through |shared_pool|, if not null.
+  explicit Vp9FrameBufferPool(SharedPool* shared_pool);
+  ~Vp9FrameBufferPool();
+
   // Configures libvpx to, in the specified context, use this memory pool for
   // buffers used to decompress frames. This is only supported for VP9.
   bool InitializeVpxUsePool(vpx_codec_ctx* vpx_codec_context);
@@ -92,8 +167,9 @@ class Vp9FrameBufferPool {
   // Returns true if change was successful and false if the amount of already
   // allocated buffers is bigger than new value.
   bool Resize(size_t max_number_of_buffers);
-  // Releases allocated buffers, deleting available buffers. Buffers in use are
-  // not deleted until they are no longer referenced.
+  // Releases allocated buffers, deleting available buffers or giving them to
+  // the shared pool. Buffers in use are not deleted until they are no longer
+  // referenced.
   void ClearPool();
 
   // InitializeVpxUsePool configures libvpx to call this function when it needs
@@ -118,6 +194,7 @@ class Vp9FrameBufferPool {
                                        vpx_codec_frame_buffer* fb);
 
  private:
+  SharedPool* const shared_pool_;
   // Protects |allocated_buffers_|.
   rtc::CriticalSection buffers_lock_;
   // All buffers, in use or ready to be recycled.
@@ -1628,7 +1628,11 @@ VP9EncoderImpl::ParseVariableFramerateConfig(std::string group_name) {
 }
 
 VP9DecoderImpl::VP9DecoderImpl()
-    : decode_complete_callback_(nullptr),
+    : frame_buffer_pool_(
+          field_trial::IsEnabled("WebRTC-Vp9SharedFrameBufferPool")
+              ? Vp9FrameBufferPool::SharedPool::GetDefault()
+              : nullptr),
+      decode_complete_callback_(nullptr),
       inited_(false),
       decoder_(nullptr),
       key_frame_required_(true) {}
@@ -204,7 +204,9 @@ class VP9DecoderImpl : public VP9Decoder {
                   int qp,
                   const webrtc::ColorSpace* explicit_color_space);
 
-  // Memory pool used to share buffers between libvpx and webrtc.
+  // Memory pool used to share buffers between libvpx and webrtc. With the
+  // WebRTC-Vp9SharedFrameBufferPool field trial, free buffers are shared with
+  // the other VP9 decoders.
   Vp9FrameBufferPool frame_buffer_pool_;
   DecodedImageCallback* decode_complete_callback_;
   bool inited_;
@@ -17,6 +17,7 @@
 
 #include "modules/include/module_fec_types.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
@@ -24,6 +25,10 @@ using rtc::CritScope;
 
 const float kProtectionOverheadRateThreshold = 0.5;
 
+// Target probability of a frame not being recoverable, with the protection
+// factors of the Reed-Solomon FlexFEC scheme.
+const float kMdsMaxResidualFrameLoss = 0.01f;
+
 FecControllerDefault::FecControllerDefault(
     Clock* clock,
     VCMProtectionCallback* protection_callback)
@@ -32,14 +37,22 @@ FecControllerDefault::FecControllerDefault(
       loss_prot_logic_(new media_optimization::VCMLossProtectionLogic(
           clock_->TimeInMilliseconds())),
       max_payload_size_(1460),
-      overhead_threshold_(GetProtectionOverheadRateThreshold()) {}
+      overhead_threshold_(GetProtectionOverheadRateThreshold()),
+      use_mds_protection_factors_(
+          webrtc::field_trial::IsEnabled("WebRTC-FlexFEC-ReedSolomon")),
+      use_predicted_loss_(
+          webrtc::field_trial::IsEnabled("WebRTC-FecPredictedLoss")) {}
 
 FecControllerDefault::FecControllerDefault(Clock* clock)
     : clock_(clock),
       loss_prot_logic_(new media_optimization::VCMLossProtectionLogic(
           clock_->TimeInMilliseconds())),
       max_payload_size_(1460),
-      overhead_threshold_(GetProtectionOverheadRateThreshold()) {}
+      overhead_threshold_(GetProtectionOverheadRateThreshold()),
+      use_mds_protection_factors_(
+          webrtc::field_trial::IsEnabled("WebRTC-FlexFEC-ReedSolomon")),
+      use_predicted_loss_(
+          webrtc::field_trial::IsEnabled("WebRTC-FecPredictedLoss")) {}
 
 FecControllerDefault::~FecControllerDefault(void) {
   loss_prot_logic_->Release();
@@ -108,6 +121,12 @@ uint32_t FecControllerDefault::UpdateFecRates(
         media_optimization::kMaxFilter;
     uint8_t packet_loss_enc = loss_prot_logic_->FilteredLoss(
         clock_->TimeInMilliseconds(), filter_mode, fraction_lost);
+    // Protect against the loss the congestion controller expects as soon as
+    // it is predicted. It is kept out of the loss history, so that the
+    // protection drops again once the prediction does.
+    if (use_predicted_loss_) {
+      packet_loss_enc = std::max(packet_loss_enc, predicted_loss_);
+    }
     // For now use the filtered loss for computing the robustness settings.
     loss_prot_logic_->UpdateFilteredLossPr(packet_loss_enc);
     if (loss_prot_logic_->SelectedType() == media_optimization::kNone) {
@@ -132,6 +151,25 @@ uint32_t FecControllerDefault::UpdateFecRates(
         loss_prot_logic_->SelectedMethod()->MaxFramesFec();
     key_fec_params.max_fec_frames =
         loss_prot_logic_->SelectedMethod()->MaxFramesFec();
+    // The tables of the selected method are trained for the XOR packet masks.
+    // Erasure codes that recover as many packets as repair packets are
+    // received need less protection, which follows from the loss estimate.
+    // The selected method still decides whether FEC is used at all, e.g.
+    // depending on the RTT when combined with NACK.
+    if (use_mds_protection_factors_) {
+      const media_optimization::VCMProtectionParameters& parameters =
+          loss_prot_logic_->CurrentParameters();
+      if (delta_fec_params.fec_rate > 0) {
+        delta_fec_params.fec_rate = media_optimization::MdsProtectionFactor(
+            parameters.lossPr, parameters.packetsPerFrame,
+            kMdsMaxResidualFrameLoss);
+      }
+      if (key_fec_params.fec_rate > 0) {
+        key_fec_params.fec_rate = media_optimization::MdsProtectionFactor(
+            parameters.lossPr, parameters.packetsPerFrameKey,
+            kMdsMaxResidualFrameLoss);
+      }
+    }
   }
   // Set the FEC packet mask type. |kFecMaskBursty| is more effective for
   // consecutive losses and little/no packet re-ordering. As we currently
@@ -208,4 +246,9 @@ bool FecControllerDefault::UseLossVectorMask() {
   return false;
 }
 
+void FecControllerDefault::OnPredictedPacketLoss(float predicted_loss_ratio) {
+  CritScope lock(&crit_sect_);
+  predicted_loss_ = rtc::saturated_cast<uint8_t>(predicted_loss_ratio * 255);
+}
+
 }  // namespace webrtc
@@ -48,6 +48,7 @@ class FecControllerDefault : public FecController {
       const size_t encoded_image_length,
       const VideoFrameType encoded_image_frametype) override;
   bool UseLossVectorMask() override;
+  void OnPredictedPacketLoss(float predicted_loss_ratio) override;
   float GetProtectionOverheadRateThreshold();
 
  private:
@@ -58,8 +59,15 @@ class FecControllerDefault : public FecController {
   std::unique_ptr<media_optimization::VCMLossProtectionLogic> loss_prot_logic_
       RTC_GUARDED_BY(crit_sect_);
   size_t max_payload_size_ RTC_GUARDED_BY(crit_sect_);
+  // Loss predicted by the congestion controller, in [0, 255].
+  uint8_t predicted_loss_ RTC_GUARDED_BY(crit_sect_) = 0;
   RTC_DISALLOW_COPY_AND_ASSIGN(FecControllerDefault);
   const float overhead_threshold_;
+  // Whether the protection factors are computed for the Reed-Solomon FlexFEC
+  // scheme instead of the XOR packet masks.
+  const bool use_mds_protection_factors_;
+  // Whether the protection covers the predicted loss before it is reported.
+  const bool use_predicted_loss_;
 };
 
 }  // namespace webrtc
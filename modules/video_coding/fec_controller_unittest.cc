@@ -17,6 +17,7 @@
 #include "modules/include/module_fec_types.h"
 #include "modules/video_coding/fec_controller_default.h"
 #include "system_wrappers/include/clock.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -36,6 +37,7 @@ class ProtectionBitrateCalculatorTest : public ::testing::Test {
                           uint32_t* sent_video_rate_bps,
                           uint32_t* sent_nack_rate_bps,
                           uint32_t* sent_fec_rate_bps) override {
+      delta_fec_rate_ = delta_params->fec_rate;
       *sent_video_rate_bps = kCodecBitrateBps;
       *sent_nack_rate_bps = nack_rate_bps_;
       *sent_fec_rate_bps = fec_rate_bps_;
@@ -44,6 +46,7 @@ class ProtectionBitrateCalculatorTest : public ::testing::Test {
 
     uint32_t fec_rate_bps_ = 0;
     uint32_t nack_rate_bps_ = 0;
+    int delta_fec_rate_ = 0;
   };
 
   // Note: simulated clock starts at 1 seconds, since parts of webrtc use 0 as
@@ -111,4 +114,41 @@ TEST_F(ProtectionBitrateCalculatorTest, NoProtection) {
   EXPECT_EQ(kMaxBitrateBps, target_bitrate);
 }
 
+TEST_F(ProtectionBitrateCalculatorTest, ProtectsAgainstPredictedLoss) {
+  static const uint32_t kMaxBitrateBps = 130000;
+  test::ScopedFieldTrials field_trials("WebRTC-FecPredictedLoss/Enabled/");
+  FecControllerDefault fec_controller(&clock_, &protection_callback_);
+  fec_controller.SetProtectionMethod(true /*enable_fec*/,
+                                     false /* enable_nack */);
+  fec_controller.SetEncodingData(640, 480, 1, 1000);
+
+  fec_controller.UpdateFecRates(kMaxBitrateBps, 30, 0,
+                                std::vector<bool>(1, false), 0);
+  EXPECT_EQ(0, protection_callback_.delta_fec_rate_);
+
+  // Protected before any loss is reported.
+  fec_controller.OnPredictedPacketLoss(0.2f);
+  fec_controller.UpdateFecRates(kMaxBitrateBps, 30, 0,
+                                std::vector<bool>(1, false), 0);
+  EXPECT_GT(protection_callback_.delta_fec_rate_, 0);
+
+  // And no longer once the prediction is withdrawn.
+  fec_controller.OnPredictedPacketLoss(0.0f);
+  fec_controller.UpdateFecRates(kMaxBitrateBps, 30, 0,
+                                std::vector<bool>(1, false), 0);
+  EXPECT_EQ(0, protection_callback_.delta_fec_rate_);
+}
+
+TEST_F(ProtectionBitrateCalculatorTest, IgnoresPredictedLossByDefault) {
+  static const uint32_t kMaxBitrateBps = 130000;
+  fec_controller_.SetProtectionMethod(true /*enable_fec*/,
+                                      false /* enable_nack */);
+  fec_controller_.SetEncodingData(640, 480, 1, 1000);
+
+  fec_controller_.OnPredictedPacketLoss(0.2f);
+  fec_controller_.UpdateFecRates(kMaxBitrateBps, 30, 0,
+                                 std::vector<bool>(1, false), 0);
+  EXPECT_EQ(0, protection_callback_.delta_fec_rate_);
+}
+
 }  // namespace webrtc
@@ -13,7 +13,6 @@
 #include <algorithm>
 #include <cstdlib>
 #include <iterator>
-#include <queue>
 #include <utility>
 #include <vector>
 
@@ -119,6 +118,7 @@ void FrameBuffer::StartWaitForNextFrameOnQueue() {
 int64_t FrameBuffer::FindNextFrame(int64_t now_ms) {
   int64_t wait_ms = latest_return_time_ms_ - now_ms;
   frames_to_decode_.clear();
+  const bool low_latency_rendering = timing_->UseLowLatencyRendering();
 
   // |last_continuous_frame_| may be empty below, but nullopt is smaller
   // than everything else and loop will immediately terminate as expected.
@@ -153,7 +153,7 @@ int64_t FrameBuffer::FindNextFrame(int64_t now_ms) {
     }
 
     // Gather all remaining frames for the same superframe.
-    std::vector<FrameMap::iterator> current_superframe;
+    SuperFrame current_superframe;
     current_superframe.push_back(frame_it);
     bool last_layer_completed = frame_it->second.frame->is_last_spatial_layer;
     FrameMap::iterator next_frame_it = frame_it;
@@ -193,6 +193,13 @@ int64_t FrameBuffer::FindNextFrame(int64_t now_ms) {
     if (frame->RenderTime() == -1) {
       frame->SetRenderTime(timing_->RenderTimeMs(frame->Timestamp(), now_ms));
     }
+
+    // Without playout delay the decoder is fed right away, and only with the
+    // newest decodable superframe: the older ones are late and are dropped.
+    if (low_latency_rendering) {
+      wait_ms = 0;
+      continue;
+    }
     wait_ms = timing_->MaxWaitingTime(frame->RenderTime(), now_ms);
 
     // This will cause the frame buffer to prefer high framerate rather
@@ -213,7 +220,7 @@ int64_t FrameBuffer::FindNextFrame(int64_t now_ms) {
 EncodedFrame* FrameBuffer::GetNextFrame() {
   int64_t now_ms = clock_->TimeInMilliseconds();
   // TODO(ilnik): remove |frames_out| use frames_to_decode_ directly.
-  std::vector<EncodedFrame*> frames_out;
+  absl::InlinedVector<EncodedFrame*, kMaxSpatialLayers> frames_out;
 
   RTC_DCHECK(!frames_to_decode_.empty());
   bool superframe_delayed_by_retransmission = false;
@@ -231,6 +238,7 @@ EncodedFrame* FrameBuffer::GetNextFrame() {
   for (FrameMap::iterator& frame_it : frames_to_decode_) {
     RTC_DCHECK(frame_it != frames_.end());
     EncodedFrame* frame = frame_it->second.frame.release();
+    frame_it->second.memory.Set(0);
 
     frame->SetRenderTime(render_time_ms);
 
@@ -348,6 +356,11 @@ void FrameBuffer::UpdateRtt(int64_t rtt_ms) {
   jitter_estimator_.UpdateRtt(rtt_ms);
 }
 
+void FrameBuffer::UpdateQueueingDelayTrend(const QueueingDelayTrend& trend) {
+  rtc::CritScope lock(&crit_);
+  jitter_estimator_.UpdateQueueingDelayTrend(trend);
+}
+
 bool FrameBuffer::ValidReferences(const EncodedFrame& frame) const {
   for (size_t i = 0; i < frame.num_references; ++i) {
     if (frame.references[i] >= frame.id.picture_id)
@@ -505,6 +518,7 @@ int64_t FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
                                      frame->contentType());
   }
 
+  info->second.memory.Set(sizeof(*frame) + frame->size());
   info->second.frame = std::move(frame);
 
   if (info->second.num_missing_continuous == 0) {
@@ -533,13 +547,14 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
   TRACE_EVENT0("webrtc", "FrameBuffer::PropagateContinuity");
   RTC_DCHECK(start->second.continuous);
 
-  std::queue<FrameMap::iterator> continuous_frames;
-  continuous_frames.push(start);
+  // A simple BFS to traverse continuous frames. Visited frames stay in the
+  // vector, which only leaves the inline storage when a long chain of frames
+  // becomes continuous at once, e.g. when a lost keyframe is recovered.
+  absl::InlinedVector<FrameMap::iterator, 16> continuous_frames;
+  continuous_frames.push_back(start);
 
-  // A simple BFS to traverse continuous frames.
-  while (!continuous_frames.empty()) {
-    auto frame = continuous_frames.front();
-    continuous_frames.pop();
+  for (size_t next = 0; next < continuous_frames.size(); ++next) {
+    FrameMap::iterator frame = continuous_frames[next];
 
     if (!last_continuous_frame_ || *last_continuous_frame_ < frame->first) {
       last_continuous_frame_ = frame->first;
@@ -556,7 +571,7 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
         --frame_ref->second.num_missing_continuous;
         if (frame_ref->second.num_missing_continuous == 0) {
           frame_ref->second.continuous = true;
-          continuous_frames.push(frame_ref);
+          continuous_frames.push_back(frame_ref);
         }
       }
     }
@@ -594,9 +609,14 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
   // decremented as frames become continuous/are decoded.
   struct Dependency {
     VideoLayerFrameId id;
+    // Where the referenced frame is buffered, or frames_.end() if it has not
+    // been seen yet.
+    FrameMap::iterator info;
     bool continuous;
   };
-  std::vector<Dependency> not_yet_fulfilled_dependencies;
+  // At most one dependency per reference plus the lower spatial layer.
+  absl::InlinedVector<Dependency, EncodedFrame::kMaxFrameReferences + 1>
+      not_yet_fulfilled_dependencies;
 
   // Find all dependencies that have not yet been fulfilled.
   for (size_t i = 0; i < frame.num_references; ++i) {
@@ -621,7 +641,8 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
       auto ref_info = frames_.find(ref_key);
       bool ref_continuous =
           ref_info != frames_.end() && ref_info->second.continuous;
-      not_yet_fulfilled_dependencies.push_back({ref_key, ref_continuous});
+      not_yet_fulfilled_dependencies.push_back(
+          {ref_key, ref_info, ref_continuous});
     }
   }
 
@@ -638,7 +659,7 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
 
     if (!lower_layer_continuous || !lower_layer_decoded) {
       not_yet_fulfilled_dependencies.push_back(
-          {ref_key, lower_layer_continuous});
+          {ref_key, ref_info, lower_layer_continuous});
     }
   }
 
@@ -649,7 +670,12 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
     if (dep.continuous)
       --info->second.num_missing_continuous;
 
-    frames_[dep.id].dependent_frames.push_back(id);
+    // Inserting into |frames_| does not invalidate the other iterators, so
+    // the lookup above can be reused.
+    FrameMap::iterator ref_info =
+        dep.info != frames_.end() ? dep.info
+                                  : frames_.emplace(dep.id, FrameInfo()).first;
+    ref_info->second.dependent_frames.push_back(id);
   }
 
   return true;
@@ -703,10 +729,10 @@ void FrameBuffer::ClearFramesAndHistory() {
 // TODO(philipel): Avoid the concatenation of frames here, by replacing
 // NextFrame and GetNextFrame with methods returning multiple frames.
 EncodedFrame* FrameBuffer::CombineAndDeleteFrames(
-    const std::vector<EncodedFrame*>& frames) const {
+    rtc::ArrayView<EncodedFrame* const> frames) const {
   RTC_DCHECK(!frames.empty());
   EncodedFrame* first_frame = frames[0];
-  EncodedFrame* last_frame = frames.back();
+  EncodedFrame* last_frame = frames[frames.size() - 1];
   size_t total_length = 0;
   for (size_t i = 0; i < frames.size(); ++i) {
     total_length += frames[i]->size();
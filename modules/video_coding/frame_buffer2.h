@@ -18,7 +18,10 @@
 #include <vector>
 
 #include "absl/container/inlined_vector.h"
+#include "api/array_view.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "api/video/encoded_frame.h"
+#include "api/video/video_codec_constants.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/inter_frame_delay.h"
 #include "modules/video_coding/jitter_estimator.h"
@@ -27,6 +30,7 @@
 #include "rtc_base/critical_section.h"
 #include "rtc_base/event.h"
 #include "rtc_base/experiments/rtt_mult_experiment.h"
+#include "rtc_base/memory/memory_accounting.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/task_utils/repeating_task.h"
@@ -81,6 +85,10 @@ class FrameBuffer {
   // Updates the RTT for jitter buffer estimation.
   void UpdateRtt(int64_t rtt_ms);
 
+  // Updates the queueing delay trend for jitter buffer estimation. May be
+  // called from any thread.
+  void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend);
+
   // Clears the FrameBuffer, removing all the buffered frames.
   void Clear();
 
@@ -110,9 +118,14 @@ class FrameBuffer {
 
     // The actual EncodedFrame.
     std::unique_ptr<EncodedFrame> frame;
+    // The bytes of |frame|.
+    TrackedMemory memory{MemoryCategory::kVideoFrameBuffer};
   };
 
   using FrameMap = std::map<VideoLayerFrameId, FrameInfo>;
+  // The frames of a superframe, one per spatial layer. Kept inline so that
+  // finding and returning the next frame does not allocate.
+  using SuperFrame = absl::InlinedVector<FrameMap::iterator, kMaxSpatialLayers>;
 
   // Check that the references of |frame| are valid.
   bool ValidReferences(const EncodedFrame& frame) const;
@@ -157,7 +170,7 @@ class FrameBuffer {
   // multiple frames at the same time we combine all frames to one frame and
   // return it. See bugs.webrtc.org/10064
   EncodedFrame* CombineAndDeleteFrames(
-      const std::vector<EncodedFrame*>& frames) const;
+      rtc::ArrayView<EncodedFrame* const> frames) const;
 
   // Stores only undecoded frames.
   FrameMap frames_ RTC_GUARDED_BY(crit_);
@@ -178,7 +191,7 @@ class FrameBuffer {
   VCMInterFrameDelay inter_frame_delay_ RTC_GUARDED_BY(crit_);
   absl::optional<VideoLayerFrameId> last_continuous_frame_
       RTC_GUARDED_BY(crit_);
-  std::vector<FrameMap::iterator> frames_to_decode_ RTC_GUARDED_BY(crit_);
+  SuperFrame frames_to_decode_ RTC_GUARDED_BY(crit_);
   bool stopped_ RTC_GUARDED_BY(crit_);
   VCMVideoProtection protection_mode_ RTC_GUARDED_BY(crit_);
   VCMReceiveStatisticsCallback* const stats_callback_;
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/video_coding/frame_buffer2.h"
+#include "modules/video_coding/timing.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+constexpr int kNumSpatialLayers = 3;
+constexpr int kNumSuperFrames = 3000;
+// Picture id offsets of the references of the temporal layer pattern
+// 0, 2, 1, 2 (L3T3).
+constexpr int kTemporalPatternLength = 4;
+constexpr int kTemporalRefs[kTemporalPatternLength] = {4, 1, 2, 1};
+constexpr uint32_t kRtpTimestampDelta = 90000 / 30;
+
+// Makes every frame due for decoding as soon as it is decodable, so that only
+// the bookkeeping of the frame buffer is measured.
+class ImmediateTiming : public VCMTiming {
+ public:
+  explicit ImmediateTiming(Clock* clock) : VCMTiming(clock) {}
+
+  int64_t RenderTimeMs(uint32_t frame_timestamp,
+                       int64_t now_ms) const override {
+    return now_ms;
+  }
+  int64_t MaxWaitingTime(int64_t render_time_ms,
+                         int64_t now_ms) const override {
+    return 0;
+  }
+};
+
+class FakeFrame : public EncodedFrame {
+ public:
+  int64_t ReceivedTime() const override { return 0; }
+  int64_t RenderTime() const override { return _renderTimeMs; }
+};
+
+struct SvcPattern {
+  // Spatial layers above the first predict from the layer below on all
+  // frames, not only on keyframes (KSVC).
+  bool inter_layer_prediction = true;
+  int key_frame_interval = kNumSuperFrames;
+  // The keyframe of every GOP arrives after this many of its following
+  // superframes, which then become continuous all at once.
+  int key_frame_delay = 0;
+};
+
+std::vector<std::unique_ptr<EncodedFrame>> CreateSuperFrame(
+    const SvcPattern& pattern,
+    int picture_id) {
+  int index_in_gop = picture_id % pattern.key_frame_interval;
+  bool key_frame = index_in_gop == 0;
+  std::vector<std::unique_ptr<EncodedFrame>> layers;
+  for (int sid = 0; sid < kNumSpatialLayers; ++sid) {
+    auto frame = std::make_unique<FakeFrame>();
+    frame->id.picture_id = picture_id;
+    frame->id.spatial_layer = sid;
+    frame->SetSpatialIndex(sid);
+    frame->SetTimestamp(picture_id * kRtpTimestampDelta);
+    frame->SetEncodedData(EncodedImageBuffer::Create(100));
+    frame->inter_layer_predicted =
+        sid > 0 && (key_frame || pattern.inter_layer_prediction);
+    frame->is_last_spatial_layer = sid == kNumSpatialLayers - 1;
+    if (!key_frame) {
+      // References reaching back before the keyframe point at it instead.
+      int ref = std::min(kTemporalRefs[index_in_gop % kTemporalPatternLength],
+                         index_in_gop);
+      frame->num_references = 1;
+      frame->references[0] = picture_id - ref;
+    }
+    layers.push_back(std::move(frame));
+  }
+  return layers;
+}
+
+class FrameBufferBenchmark {
+ public:
+  FrameBufferBenchmark()
+      : time_controller_(Timestamp::Seconds(1000)),
+        task_queue_(time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "extract queue",
+            TaskQueueFactory::Priority::NORMAL)),
+        timing_(time_controller_.GetClock()),
+        buffer_(time_controller_.GetClock(), &timing_, nullptr) {}
+
+  // Inserts all superframes in the arrival order of |pattern| and extracts
+  // them for decoding. Returns the time spent in the frame buffer per frame.
+  double Run(const SvcPattern& pattern) {
+    std::vector<int> arrival_order;
+    const int gop_size = pattern.key_frame_interval;
+    for (int gop = 0; gop < kNumSuperFrames; gop += gop_size) {
+      int gop_end = std::min(gop + gop_size, kNumSuperFrames);
+      int key_frame_arrival = std::min(gop + pattern.key_frame_delay, gop_end);
+      for (int picture_id = gop + 1; picture_id <= key_frame_arrival;
+           ++picture_id) {
+        arrival_order.push_back(picture_id);
+      }
+      arrival_order.push_back(gop);
+      for (int picture_id = key_frame_arrival + 1; picture_id < gop_end;
+           ++picture_id) {
+        arrival_order.push_back(picture_id);
+      }
+    }
+
+    int64_t total_ns = 0;
+    int num_frames = 0;
+    for (int picture_id : arrival_order) {
+      for (auto& frame : CreateSuperFrame(pattern, picture_id)) {
+        int64_t start_ns = rtc::SystemTimeNanos();
+        buffer_.InsertFrame(std::move(frame));
+        total_ns += rtc::SystemTimeNanos() - start_ns;
+        ++num_frames;
+      }
+      int64_t start_ns = rtc::SystemTimeNanos();
+      ExtractFrames();
+      total_ns += rtc::SystemTimeNanos() - start_ns;
+    }
+    EXPECT_EQ(num_decoded_, kNumSuperFrames);
+    return static_cast<double>(total_ns) / num_frames;
+  }
+
+ private:
+  // Hands off all decodable superframes.
+  void ExtractFrames() {
+    bool found = true;
+    while (found) {
+      found = false;
+      task_queue_.PostTask([this, &found] {
+        buffer_.NextFrame(
+            0, false, &task_queue_,
+            [this, &found](std::unique_ptr<EncodedFrame> frame,
+                           FrameBuffer::ReturnReason reason) {
+              found = reason == FrameBuffer::kFrameFound;
+              if (found)
+                ++num_decoded_;
+            });
+      });
+      time_controller_.AdvanceTime(TimeDelta::Zero());
+    }
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  rtc::TaskQueue task_queue_;
+  ImmediateTiming timing_;
+  FrameBuffer buffer_;
+  int num_decoded_ = 0;
+};
+
+void RunBenchmark(const std::string& test_case, const SvcPattern& pattern) {
+  FrameBufferBenchmark benchmark;
+  test::PrintResult("frame_buffer_time_per_frame", "", test_case,
+                    benchmark.Run(pattern), "ns", false);
+}
+
+}  // namespace
+
+TEST(FrameBuffer2PerformanceTest, L3T3FullSvc) {
+  RunBenchmark("L3T3", SvcPattern());
+}
+
+TEST(FrameBuffer2PerformanceTest, L3T3KeySvc) {
+  SvcPattern pattern;
+  pattern.inter_layer_prediction = false;
+  RunBenchmark("L3T3_KEY", pattern);
+}
+
+TEST(FrameBuffer2PerformanceTest, L3T3LateKeyFrames) {
+  SvcPattern pattern;
+  pattern.inter_layer_prediction = false;
+  pattern.key_frame_interval = 300;
+  pattern.key_frame_delay = 60;
+  RunBenchmark("L3T3_KEY_late_key_frames", pattern);
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
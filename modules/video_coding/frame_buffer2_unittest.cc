@@ -285,6 +285,22 @@ TEST_F(TestFrameBuffer2, ZeroPlayoutDelay) {
   EXPECT_EQ(0, frames_[0]->RenderTimeMs());
 }
 
+TEST_F(TestFrameBuffer2, ZeroPlayoutDelayDecodesTheNewestFrame) {
+  VCMTiming timing(time_controller_.GetClock());
+  timing.set_max_playout_delay(0);
+  buffer_.reset(
+      new FrameBuffer(time_controller_.GetClock(), &timing, &stats_callback_));
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  InsertFrame(pid, 0, ts, false, true, kFrameSize);
+  InsertFrame(pid + 1, 0, ts + kFps10, false, true, kFrameSize);
+  EXPECT_CALL(stats_callback_, OnDroppedFrames(1));
+  ExtractFrame();
+  CheckFrame(0, pid + 1, 0);
+  EXPECT_EQ(0, frames_[0]->RenderTimeMs());
+}
+
 // Flaky test, see bugs.webrtc.org/7068.
 TEST_F(TestFrameBuffer2, DISABLED_OneUnorderedSuperFrame) {
   uint16_t pid = Rand();
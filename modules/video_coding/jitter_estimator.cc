@@ -18,6 +18,7 @@
 #include <cstdint>
 
 #include "absl/types/optional.h"
+#include "api/units/time_delta.h"
 #include "modules/video_coding/internal_defines.h"
 #include "modules/video_coding/rtt_filter.h"
 #include "rtc_base/experiments/jitter_upper_bound_experiment.h"
@@ -31,6 +32,11 @@ static constexpr int64_t kFsAccuStartupSamples = 5;
 static constexpr double kMaxFramerateEstimate = 200.0;
 static constexpr int64_t kNackCountTimeoutMs = 60000;
 static constexpr double kDefaultMaxTimestampDeviationInSigmas = 3.5;
+static constexpr int64_t kQueueingDelayTrendTimeoutMs = 1000;
+// How far ahead the queueing delay trend is followed, and by how much the
+// estimate may grow because of it.
+static constexpr TimeDelta kQueueingDelayTrendHorizon = TimeDelta::Millis(200);
+static constexpr TimeDelta kMaxQueueingDelayGrowth = TimeDelta::Millis(100);
 }  // namespace
 
 VCMJitterEstimator::VCMJitterEstimator(Clock* clock)
@@ -77,6 +83,8 @@ VCMJitterEstimator& VCMJitterEstimator::operator=(
     _latestNackTimestamp = rhs._latestNackTimestamp;
     _nackCount = rhs._nackCount;
     _rttFilter = rhs._rttFilter;
+    queueing_delay_trend_ = rhs.queueing_delay_trend_;
+    queueing_delay_trend_time_us_ = rhs.queueing_delay_trend_time_us_;
     clock_ = rhs.clock_;
   }
   return *this;
@@ -110,6 +118,8 @@ void VCMJitterEstimator::Reset() {
   _fsCount = 0;
   _startupCount = 0;
   _rttFilter.Reset();
+  queueing_delay_trend_.reset();
+  queueing_delay_trend_time_us_ = 0;
   fps_counter_.Reset();
 }
 
@@ -373,6 +383,12 @@ void VCMJitterEstimator::UpdateRtt(int64_t rttMs) {
   _rttFilter.Update(rttMs);
 }
 
+void VCMJitterEstimator::UpdateQueueingDelayTrend(
+    const QueueingDelayTrend& trend) {
+  queueing_delay_trend_ = trend;
+  queueing_delay_trend_time_us_ = clock_->TimeInMicroseconds();
+}
+
 // Returns the current filtered estimate if available,
 // otherwise tries to calculate an estimate.
 int VCMJitterEstimator::GetJitterEstimate(
@@ -395,6 +411,20 @@ int VCMJitterEstimator::GetJitterEstimate(
     }
   }
 
+  if (queueing_delay_trend_ &&
+      now - queueing_delay_trend_time_us_ <=
+          kQueueingDelayTrendTimeoutMs * 1000) {
+    double change_ms =
+        queueing_delay_trend_
+            ->PredictedChange(kQueueingDelayTrendHorizon,
+                              kMaxQueueingDelayGrowth)
+            .ms<double>();
+    // Draining queues never take the operating system jitter away.
+    jitterMS = std::max(
+        jitterMS + change_ms,
+        std::min(jitterMS, static_cast<double>(OPERATING_SYSTEM_JITTER)));
+  }
+
   static const double kJitterScaleLowThreshold = 5.0;
   static const double kJitterScaleHighThreshold = 10.0;
   double fps = GetFrameRate();
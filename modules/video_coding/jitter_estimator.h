@@ -11,6 +11,8 @@
 #ifndef MODULES_VIDEO_CODING_JITTER_ESTIMATOR_H_
 #define MODULES_VIDEO_CODING_JITTER_ESTIMATOR_H_
 
+#include "absl/types/optional.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "modules/video_coding/rtt_filter.h"
 #include "rtc_base/rolling_accumulator.h"
 
@@ -58,6 +60,12 @@ class VCMJitterEstimator {
   //          - rttMs          : RTT in ms.
   void UpdateRtt(int64_t rttMs);
 
+  // Updates the queueing delay trend of the network path. The estimate grows
+  // ahead of queues building up, and lets go of the delay they added as soon
+  // as they drain rather than as slowly as the filters forget it, until the
+  // trend is older than a second.
+  void UpdateQueueingDelayTrend(const QueueingDelayTrend& trend);
+
   // A constant describing the delay from the jitter buffer to the delay on the
   // receiving side which is not accounted for by the jitter buffer nor the
   // decoding delay estimate.
@@ -148,6 +156,9 @@ class VCMJitterEstimator {
                              // but never goes above _nackLimit
   VCMRttFilter _rttFilter;
 
+  absl::optional<QueueingDelayTrend> queueing_delay_trend_;
+  int64_t queueing_delay_trend_time_us_;
+
   rtc::RollingAccumulator<uint64_t> fps_counter_;
   const double time_deviation_upper_bound_;
   Clock* clock_;
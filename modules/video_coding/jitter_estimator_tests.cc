@@ -144,4 +144,35 @@ TEST_F(TestVCMJitterEstimator, TestUpperBound) {
   EXPECT_GT(max_unbound, static_cast<uint32_t>(max_bounded * 1.25));
 }
 
+TEST_F(TestVCMJitterEstimator, FollowsQueueingDelayTrend) {
+  ValueGenerator gen(10);
+  uint64_t time_delta_us = rtc::kNumMicrosecsPerSec / 30;
+  for (int i = 0; i < 100; ++i) {
+    estimator_->UpdateEstimate(gen.Delay(), gen.FrameSize());
+    AdvanceClock(time_delta_us);
+    gen.Advance();
+  }
+  const int estimate = estimator_->GetJitterEstimate(0, absl::nullopt);
+
+  // Grows 20 ms within the next 200 ms.
+  QueueingDelayTrend trend;
+  trend.queueing_delay = TimeDelta::Millis(50);
+  trend.slope_ms_per_s = 200;
+  trend.confidence = 0.5;
+  estimator_->UpdateQueueingDelayTrend(trend);
+  EXPECT_EQ(estimator_->GetJitterEstimate(0, absl::nullopt), estimate + 20);
+
+  // Draining, but the operating system jitter remains.
+  trend.slope_ms_per_s = -1000;
+  trend.confidence = 1.0;
+  estimator_->UpdateQueueingDelayTrend(trend);
+  EXPECT_EQ(estimator_->GetJitterEstimate(0, absl::nullopt),
+            std::min<int>(estimate,
+                          VCMJitterEstimator::OPERATING_SYSTEM_JITTER));
+
+  // Old trends are ignored.
+  AdvanceClock(2 * rtc::kNumMicrosecsPerSec);
+  EXPECT_EQ(estimator_->GetJitterEstimate(0, absl::nullopt), estimate);
+}
+
 }  // namespace webrtc
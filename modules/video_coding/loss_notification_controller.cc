@@ -43,6 +43,9 @@ LossNotificationController::LossNotificationController(
       current_frame_potentially_decodable_(true) {
   RTC_DCHECK(key_frame_request_sender_);
   RTC_DCHECK(loss_notification_sender_);
+  // It's OK to create this object on a different thread/task queue than
+  // the one used during main operation.
+  sequence_checker_.Detach();
 }
 
 LossNotificationController::~LossNotificationController() = default;
@@ -21,6 +21,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/numerics/safe_minmax.h"
 
 namespace webrtc {
 // Max value of loss rates in off-line model
@@ -682,6 +683,11 @@ VCMProtectionMethodEnum VCMLossProtectionLogic::SelectedType() const {
   return _selectedMethod ? _selectedMethod->Type() : kNone;
 }
 
+const VCMProtectionParameters& VCMLossProtectionLogic::CurrentParameters()
+    const {
+  return _currentParameters;
+}
+
 void VCMLossProtectionLogic::Reset(int64_t nowMs) {
   _lastPrUpdateT = nowMs;
   _lastPacketPerFrameUpdateT = nowMs;
@@ -701,5 +707,45 @@ void VCMLossProtectionLogic::Release() {
   _selectedMethod.reset();
 }
 
+uint8_t MdsProtectionFactor(float loss_probability,
+                            float packets_per_frame,
+                            float max_residual_loss) {
+  // The FEC packet masks limit a frame to 48 media packets.
+  constexpr int kMaxMediaPackets = 48;
+  if (loss_probability <= 0.0f) {
+    return 0;
+  }
+  if (loss_probability >= 1.0f) {
+    return 255;
+  }
+  const double p = loss_probability;
+  const int num_media_packets = rtc::SafeClamp(
+      static_cast<int>(packets_per_frame + 0.5f), 1, kMaxMediaPackets);
+  for (int num_repair_packets = 0; num_repair_packets < num_media_packets;
+       ++num_repair_packets) {
+    // Probability that at most |num_repair_packets| of all packets are lost,
+    // summing the binomial distribution term by term.
+    const int num_packets = num_media_packets + num_repair_packets;
+    double term = std::pow(1.0 - p, num_packets);
+    double recovered = term;
+    for (int k = 1; k <= num_repair_packets; ++k) {
+      term *= (num_packets - k + 1) * p / (k * (1.0 - p));
+      recovered += term;
+    }
+    if (1.0 - recovered <= max_residual_loss) {
+      if (num_repair_packets == 0) {
+        return 0;
+      }
+      // Invert ForwardErrorCorrection::NumFecPackets(), which rounds
+      // |num_media_packets| * factor / 256 to the nearest integer.
+      const int factor =
+          (256 * num_repair_packets - 128 + num_media_packets - 1) /
+          num_media_packets;
+      return rtc::saturated_cast<uint8_t>(factor);
+    }
+  }
+  return 255;
+}
+
 }  // namespace media_optimization
 }  // namespace webrtc
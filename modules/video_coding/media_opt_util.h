@@ -304,6 +304,10 @@ class VCMLossProtectionLogic {
   // Return the protection type of the currently selected method
   VCMProtectionMethodEnum SelectedType() const;
 
+  // Returns the parameters given to the selected method by the last
+  // UpdateMethod().
+  const VCMProtectionParameters& CurrentParameters() const;
+
   // Updates the filtered loss for the average and max window packet loss,
   // and returns the filtered loss probability in the interval [0, 255].
   // The returned filtered loss value depends on the parameter |filter_mode|.
@@ -344,6 +348,16 @@ class VCMLossProtectionLogic {
   int _numLayers;
 };
 
+// Returns the protection factor, in the [0, 255] domain of
+// FecProtectionParams::fec_rate, needed by an erasure code that recovers any
+// |m| lost packets out of |n| media and |m| repair packets, such as
+// Reed-Solomon. The factor is the smallest for which a frame of
+// |packets_per_frame| packets is unrecoverable with a probability of at most
+// |max_residual_loss|, given independent losses with |loss_probability|.
+uint8_t MdsProtectionFactor(float loss_probability,
+                            float packets_per_frame,
+                            float max_residual_loss);
+
 }  // namespace media_optimization
 }  // namespace webrtc
 
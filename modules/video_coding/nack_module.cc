@@ -32,6 +32,10 @@ const int kProcessIntervalMs = 1000 / kProcessFrequency;
 const int kMaxReorderedPackets = 128;
 const int kNumReorderingBuckets = 10;
 const int kDefaultSendNackDelayMs = 0;
+// The width of a slot of the timing wheel, and the number of slots. A turn
+// of the wheel covers more than the retry delays seen with common RTTs.
+const int kTimeSlotMs = kProcessIntervalMs;
+const int kNumTimeSlots = 64;
 
 int64_t GetSendNackDelay() {
   int64_t delay_ms = strtol(
@@ -46,7 +50,11 @@ int64_t GetSendNackDelay() {
 }  // namespace
 
 NackModule::NackInfo::NackInfo()
-    : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
+    : seq_num(0),
+      send_at_seq_num(0),
+      sent_at_time(-1),
+      nack_at_time(-1),
+      retries(0) {}
 
 NackModule::NackInfo::NackInfo(uint16_t seq_num,
                                uint16_t send_at_seq_num,
@@ -55,6 +63,7 @@ NackModule::NackInfo::NackInfo(uint16_t seq_num,
       send_at_seq_num(send_at_seq_num),
       created_at_time(created_at_time),
       sent_at_time(-1),
+      nack_at_time(-1),
       retries(0) {}
 
 NackModule::BackoffSettings::BackoffSettings(TimeDelta min_retry,
@@ -94,6 +103,10 @@ NackModule::NackModule(Clock* clock,
     : clock_(clock),
       nack_sender_(nack_sender),
       keyframe_request_sender_(keyframe_request_sender),
+      keyframe_list_(kMaxPacketAge),
+      recovered_list_(kMaxPacketAge),
+      timing_wheel_(kNumTimeSlots),
+      next_time_slot_(clock->TimeInMilliseconds() / kTimeSlotMs),
       reordering_histogram_(kNumReorderingBuckets, kMaxReorderedPackets),
       initialized_(false),
       rtt_ms_(kDefaultRttMs),
@@ -123,7 +136,7 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
   if (!initialized_) {
     newest_seq_num_ = seq_num;
     if (is_keyframe)
-      keyframe_list_.insert(seq_num);
+      keyframe_list_.Insert(seq_num);
     initialized_ = true;
     return 0;
   }
@@ -146,22 +159,14 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
     return nacks_sent_for_packet;
   }
 
-  // Keep track of new keyframes.
+  // Keep track of new keyframes, and forget the ones too old to matter.
+  keyframe_list_.AdvanceTo(seq_num);
   if (is_keyframe)
-    keyframe_list_.insert(seq_num);
-
-  // And remove old ones so we don't accumulate keyframes.
-  auto it = keyframe_list_.lower_bound(seq_num - kMaxPacketAge);
-  if (it != keyframe_list_.begin())
-    keyframe_list_.erase(keyframe_list_.begin(), it);
+    keyframe_list_.Insert(seq_num);
 
+  recovered_list_.AdvanceTo(seq_num);
   if (is_recovered) {
-    recovered_list_.insert(seq_num);
-
-    // Remove old ones so we don't accumulate recovered packets.
-    auto it = recovered_list_.lower_bound(seq_num - kMaxPacketAge);
-    if (it != recovered_list_.begin())
-      recovered_list_.erase(recovered_list_.begin(), it);
+    recovered_list_.Insert(seq_num);
 
     // Do not send nack for packets recovered by FEC or RTX.
     return 0;
@@ -171,7 +176,7 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
   newest_seq_num_ = seq_num;
 
   // Are there any nacks that are waiting for this seq_num.
-  std::vector<uint16_t> nack_batch = GetNackBatch(kSeqNumOnly);
+  std::vector<uint16_t> nack_batch = GetNackBatchOnSeqNum();
   if (!nack_batch.empty()) {
     // This batch of NACKs is triggered externally; the initiator can
     // batch them with other feedback messages.
@@ -184,22 +189,28 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 void NackModule::ClearUpTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
   nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-  keyframe_list_.erase(keyframe_list_.begin(),
-                       keyframe_list_.lower_bound(seq_num));
-  recovered_list_.erase(recovered_list_.begin(),
-                        recovered_list_.lower_bound(seq_num));
+  keyframe_list_.EraseOlderThan(seq_num);
+  recovered_list_.EraseOlderThan(seq_num);
 }
 
 void NackModule::UpdateRtt(int64_t rtt_ms) {
   rtc::CritScope lock(&crit_);
+  const bool decreased = rtt_ms < rtt_ms_;
   rtt_ms_ = rtt_ms;
+  // Retries only come due earlier with a lower RTT. With a higher one, the
+  // packets are put back on the wheel when their old slot comes up.
+  if (decreased)
+    RescheduleAllNacks();
 }
 
 void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
   nack_list_.clear();
-  keyframe_list_.clear();
-  recovered_list_.clear();
+  keyframe_list_.Clear();
+  recovered_list_.Clear();
+  unsent_nacks_.clear();
+  for (std::vector<ScheduledNack>& time_slot : timing_wheel_)
+    time_slot.clear();
 }
 
 int64_t NackModule::TimeUntilNextProcess() {
@@ -212,7 +223,7 @@ void NackModule::Process() {
     std::vector<uint16_t> nack_batch;
     {
       rtc::CritScope lock(&crit_);
-      nack_batch = GetNackBatch(kTimeOnly);
+      nack_batch = GetNackBatchOnTime();
     }
 
     if (!nack_batch.empty()) {
@@ -237,8 +248,8 @@ void NackModule::Process() {
 }
 
 bool NackModule::RemovePacketsUntilKeyFrame() {
-  while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
+  while (absl::optional<uint16_t> keyframe = keyframe_list_.Oldest()) {
+    auto it = nack_list_.lower_bound(*keyframe);
 
     if (it != nack_list_.begin()) {
       // We have found a keyframe that actually is newer than at least one
@@ -249,7 +260,7 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
 
     // If this keyframe is so old it does not remove any packets from the list,
     // remove it from the list of keyframes and try the next keyframe.
-    keyframe_list_.erase(keyframe_list_.begin());
+    keyframe_list_.Erase(*keyframe);
   }
   return false;
 }
@@ -280,60 +291,128 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
 
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
     // Do not send nack for packets that are already recovered by FEC or RTX
-    if (recovered_list_.find(seq_num) != recovered_list_.end())
+    if (recovered_list_.Contains(seq_num))
       continue;
     NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
                        clock_->TimeInMilliseconds());
     RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    NackInfo& added = nack_list_[seq_num];
+    added = nack_info;
+    ScheduleNack(&added);
+    unsent_nacks_.push_back(seq_num);
   }
 }
 
-std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
-  bool consider_seq_num = options != kTimeOnly;
-  bool consider_timestamp = options != kSeqNumOnly;
-  Timestamp now = clock_->CurrentTime();
+std::vector<uint16_t> NackModule::GetNackBatchOnSeqNum() {
+  const int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    TimeDelta resend_delay = TimeDelta::Millis(rtt_ms_);
-    if (backoff_settings_) {
-      resend_delay =
-          std::max(resend_delay, backoff_settings_->min_retry_interval);
-      if (it->second.retries > 1) {
-        TimeDelta exponential_backoff =
-            std::min(TimeDelta::Millis(rtt_ms_), backoff_settings_->max_rtt) *
-            std::pow(backoff_settings_->base, it->second.retries - 1);
-        resend_delay = std::max(resend_delay, exponential_backoff);
-      }
-    }
-
+  auto waiting_end = unsent_nacks_.begin();
+  for (uint16_t seq_num : unsent_nacks_) {
+    auto it = nack_list_.find(seq_num);
+    if (it == nack_list_.end() || it->second.sent_at_time != -1)
+      continue;
     bool delay_timed_out =
-        now.ms() - it->second.created_at_time >= send_nack_delay_ms_;
-    bool nack_on_rtt_passed =
-        now.ms() - it->second.sent_at_time >= resend_delay.ms();
+        now_ms - it->second.created_at_time >= send_nack_delay_ms_;
     bool nack_on_seq_num_passed =
-        it->second.sent_at_time == -1 &&
         AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
-    if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
-                            (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now.ms();
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                            << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
+    if (delay_timed_out && nack_on_seq_num_passed) {
+      AddToNackBatch(it, now_ms, &nack_batch);
+      continue;
+    }
+    *waiting_end++ = seq_num;
+  }
+  unsent_nacks_.erase(waiting_end, unsent_nacks_.end());
+  return nack_batch;
+}
+
+std::vector<uint16_t> NackModule::GetNackBatchOnTime() {
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  const int64_t now_time_slot = now_ms / kTimeSlotMs;
+  // After a long pause every slot is visited once, not once per turn missed.
+  const int64_t last_time_slot =
+      std::min(now_time_slot, next_time_slot_ + kNumTimeSlots - 1);
+  std::vector<ScheduledNack> due_nacks;
+  for (int64_t time_slot = next_time_slot_; time_slot <= last_time_slot;
+       ++time_slot) {
+    std::vector<ScheduledNack>& slot =
+        timing_wheel_[time_slot % kNumTimeSlots];
+    due_nacks.insert(due_nacks.end(), slot.begin(), slot.end());
+    slot.clear();
+  }
+  // The current slot is visited again on the next call, since packets may
+  // come due later in it.
+  next_time_slot_ = std::max(next_time_slot_, now_time_slot);
+
+  std::vector<uint16_t> nack_batch;
+  for (const ScheduledNack& scheduled : due_nacks) {
+    auto it = nack_list_.find(scheduled.seq_num);
+    if (it == nack_list_.end() ||
+        it->second.nack_at_time != scheduled.nack_at_time) {
       continue;
     }
-    ++it;
+    if (NackTime(it->second) <= now_ms) {
+      AddToNackBatch(it, now_ms, &nack_batch);
+    } else {
+      // Not due yet, or the RTT has grown since the packet was scheduled.
+      ScheduleNack(&it->second);
+    }
   }
+  // Sent in sequence number order, like the nack list.
+  std::sort(nack_batch.begin(), nack_batch.end(),
+            DescendingSeqNumComp<uint16_t>());
   return nack_batch;
 }
 
+void NackModule::AddToNackBatch(NackList::iterator it,
+                                int64_t now_ms,
+                                std::vector<uint16_t>* nack_batch) {
+  nack_batch->emplace_back(it->second.seq_num);
+  ++it->second.retries;
+  it->second.sent_at_time = now_ms;
+  if (it->second.retries >= kMaxNackRetries) {
+    RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+                        << " removed from NACK list due to max retries.";
+    nack_list_.erase(it);
+    return;
+  }
+  ScheduleNack(&it->second);
+}
+
+TimeDelta NackModule::ResendDelay(int retries) const {
+  TimeDelta resend_delay = TimeDelta::Millis(rtt_ms_);
+  if (backoff_settings_) {
+    resend_delay =
+        std::max(resend_delay, backoff_settings_->min_retry_interval);
+    if (retries > 1) {
+      TimeDelta exponential_backoff =
+          std::min(TimeDelta::Millis(rtt_ms_), backoff_settings_->max_rtt) *
+          std::pow(backoff_settings_->base, retries - 1);
+      resend_delay = std::max(resend_delay, exponential_backoff);
+    }
+  }
+  return resend_delay;
+}
+
+int64_t NackModule::NackTime(const NackInfo& nack_info) const {
+  return std::max(nack_info.created_at_time + send_nack_delay_ms_,
+                  nack_info.sent_at_time + ResendDelay(nack_info.retries).ms());
+}
+
+void NackModule::ScheduleNack(NackInfo* nack_info) {
+  nack_info->nack_at_time = NackTime(*nack_info);
+  const int64_t time_slot =
+      std::max(nack_info->nack_at_time / kTimeSlotMs, next_time_slot_);
+  timing_wheel_[time_slot % kNumTimeSlots].push_back(
+      {nack_info->seq_num, nack_info->nack_at_time});
+}
+
+void NackModule::RescheduleAllNacks() {
+  for (std::vector<ScheduledNack>& time_slot : timing_wheel_)
+    time_slot.clear();
+  for (auto& nack : nack_list_)
+    ScheduleNack(&nack.second);
+}
+
 void NackModule::UpdateReorderingStatistics(uint16_t seq_num) {
   RTC_DCHECK(AheadOf(newest_seq_num_, seq_num));
   uint16_t diff = ReverseDiff(newest_seq_num_, seq_num);
@@ -14,13 +14,13 @@
 #include <stdint.h>
 
 #include <map>
-#include <set>
 #include <vector>
 
 #include "api/units/time_delta.h"
 #include "modules/include/module.h"
 #include "modules/include/module_common_types.h"
 #include "modules/video_coding/histogram.h"
+#include "modules/video_coding/seq_num_bitset.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
@@ -46,10 +46,6 @@ class NackModule : public Module {
   void Process() override;
 
  private:
-  // Which fields to consider when deciding which packet to nack in
-  // GetNackBatch.
-  enum NackFilterOptions { kSeqNumOnly, kTimeOnly, kSeqNumAndTime };
-
   // This class holds the sequence number of the packet that is in the nack list
   // as well as the meta data about when it should be nacked and how many times
   // we have tried to nack this packet.
@@ -63,9 +59,21 @@ class NackModule : public Module {
     uint16_t send_at_seq_num;
     int64_t created_at_time;
     int64_t sent_at_time;
+    // The time from which the packet is nacked on time, as last scheduled on
+    // |timing_wheel_|.
+    int64_t nack_at_time;
     int retries;
   };
 
+  // A packet scheduled on |timing_wheel_|, which is stale if the packet has
+  // been removed from the nack list or rescheduled since.
+  struct ScheduledNack {
+    uint16_t seq_num;
+    int64_t nack_at_time;
+  };
+
+  using NackList = std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>>;
+
   struct BackoffSettings {
     BackoffSettings(TimeDelta min_retry, TimeDelta max_rtt, double base);
     static absl::optional<BackoffSettings> ParseFromFieldTrials();
@@ -84,8 +92,31 @@ class NackModule : public Module {
   // Removes packets from the nack list until the next keyframe. Returns true
   // if packets were removed.
   bool RemovePacketsUntilKeyFrame() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
-  std::vector<uint16_t> GetNackBatch(NackFilterOptions options)
+
+  // Returns the packets that haven't been nacked yet and are due since
+  // |newest_seq_num_| has been received.
+  std::vector<uint16_t> GetNackBatchOnSeqNum()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns the packets whose time to be nacked has come. Only visits the
+  // slots of |timing_wheel_| that have come due since the last call.
+  std::vector<uint16_t> GetNackBatchOnTime()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Adds the packet of |it| to |nack_batch| and schedules its next retry, or
+  // removes it from the nack list if it's out of retries.
+  void AddToNackBatch(NackList::iterator it,
+                      int64_t now_ms,
+                      std::vector<uint16_t>* nack_batch)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // The time to wait before a packet that was nacked |retries| times is nacked
+  // again.
+  TimeDelta ResendDelay(int retries) const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns the earliest time |nack_info| may be nacked on time.
+  int64_t NackTime(const NackInfo& nack_info) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Puts |nack_info| on |timing_wheel_| at the earliest time it may be nacked.
+  void ScheduleNack(NackInfo* nack_info) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void RescheduleAllNacks() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Update the reordering distribution.
   void UpdateReorderingStatistics(uint16_t seq_num)
@@ -104,12 +135,18 @@ class NackModule : public Module {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see |initialized_|). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
-      RTC_GUARDED_BY(crit_);
+  NackList nack_list_ RTC_GUARDED_BY(crit_);
+  video_coding::SeqNumBitset keyframe_list_ RTC_GUARDED_BY(crit_);
+  video_coding::SeqNumBitset recovered_list_ RTC_GUARDED_BY(crit_);
+  // The packets in the nack list that haven't been nacked yet, in the order
+  // they were added. May hold packets that have been nacked or removed since.
+  std::vector<uint16_t> unsent_nacks_ RTC_GUARDED_BY(crit_);
+  // Slot i holds the packets due in the time slots t with t % size() == i.
+  // Packets due more than a turn ahead are put back when their slot comes up.
+  std::vector<std::vector<ScheduledNack>> timing_wheel_ RTC_GUARDED_BY(crit_);
+  // The time slot GetNackBatchOnTime() starts at, which is the last one it
+  // visited.
+  int64_t next_time_slot_ RTC_GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(crit_);
   bool initialized_ RTC_GUARDED_BY(crit_);
   int64_t rtt_ms_ RTC_GUARDED_BY(crit_);
@@ -209,6 +209,22 @@ TEST_P(TestNackModule, ResendNack) {
   EXPECT_EQ(expected_nacks_sent, sent_nacks_.size());
 }
 
+TEST_P(TestNackModule, WaitsLongerForResendWhenRttGrows) {
+  nack_module_.OnReceivedPacket(1, false, false);
+  nack_module_.OnReceivedPacket(3, false, false);
+  ASSERT_EQ(1u, sent_nacks_.size());
+
+  nack_module_.UpdateRtt(100);
+  clock_->AdvanceTimeMilliseconds(kDefaultRttMs);
+  nack_module_.Process();
+  EXPECT_EQ(1u, sent_nacks_.size());
+
+  clock_->AdvanceTimeMilliseconds(100 - kDefaultRttMs);
+  nack_module_.Process();
+  EXPECT_EQ(2u, sent_nacks_.size());
+  EXPECT_EQ(2, sent_nacks_[1]);
+}
+
 TEST_P(TestNackModule, ResendPacketMaxRetries) {
   nack_module_.OnReceivedPacket(1, false, false);
   nack_module_.OnReceivedPacket(3, false, false);
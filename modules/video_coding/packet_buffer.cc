@@ -35,6 +35,13 @@
 
 namespace webrtc {
 namespace video_coding {
+namespace {
+
+size_t PacketBytes(const PacketBuffer::Packet& packet) {
+  return sizeof(packet) + packet.video_payload.size();
+}
+
+}  // namespace
 
 PacketBuffer::Packet::Packet(const RtpPacketReceived& rtp_packet,
                              const RTPVideoHeader& video_header,
@@ -63,6 +70,7 @@ PacketBuffer::PacketBuffer(Clock* clock,
       first_packet_received_(false),
       is_cleared_to_first_seq_num_(false),
       buffer_(start_buffer_size),
+      memory_(MemoryCategory::kVideoPacketBuffer),
       sps_pps_idr_is_h264_keyframe_(
           field_trial::IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")) {
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
@@ -127,6 +135,7 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
   }
 
   packet->continuous = false;
+  memory_.Add(PacketBytes(*packet));
   buffer_[index] = std::move(packet);
 
   UpdateMissingPackets(seq_num);
@@ -155,6 +164,7 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   for (size_t i = 0; i < iterations; ++i) {
     auto& stored = buffer_[first_seq_num_ % buffer_.size()];
     if (stored != nullptr && AheadOf<uint16_t>(seq_num, stored->seq_num)) {
+      memory_.Subtract(PacketBytes(*stored));
       stored = nullptr;
     }
     ++first_seq_num_;
@@ -177,6 +187,7 @@ void PacketBuffer::Clear() {
   for (auto& entry : buffer_) {
     entry = nullptr;
   }
+  memory_.Set(0);
 
   first_packet_received_ = false;
   is_cleared_to_first_seq_num_ = false;
@@ -206,8 +217,9 @@ absl::optional<int64_t> PacketBuffer::LastReceivedKeyframePacketMs() const {
 
 bool PacketBuffer::ExpandBufferSize() {
   if (buffer_.size() == max_size_) {
-    RTC_LOG(LS_WARNING) << "PacketBuffer is already at max size (" << max_size_
-                        << "), failed to increase size.";
+    RTC_LOG_EVERY_N_MS(LS_WARNING, 1000)
+        << "PacketBuffer is already at max size (" << max_size_
+        << "), failed to increase size.";
     return false;
   }
 
@@ -332,7 +344,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
       if (is_h264) {
         // Warn if this is an unsafe frame.
         if (has_h264_idr && (!has_h264_sps || !has_h264_pps)) {
-          RTC_LOG(LS_WARNING)
+          RTC_LOG_EVERY_N_MS(LS_WARNING, 1000)
               << "Received H.264-IDR frame "
                  "(SPS: "
               << has_h264_sps << ", PPS: " << has_h264_pps << "). Treating as "
@@ -383,6 +395,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         // Ensure frame boundary flags are properly set.
         packet->video_header.is_first_packet_in_frame = (i == start_seq_num);
         packet->video_header.is_last_packet_in_frame = (i == seq_num);
+        memory_.Subtract(PacketBytes(*packet));
         found_frames.push_back(std::move(packet));
       }
 
@@ -23,6 +23,7 @@
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/memory/memory_accounting.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/clock.h"
@@ -127,6 +128,8 @@ class PacketBuffer {
   // Buffer that holds the the inserted packets and information needed to
   // determine continuity between them.
   std::vector<std::unique_ptr<Packet>> buffer_ RTC_GUARDED_BY(crit_);
+  // The packets in |buffer_| and their payloads.
+  TrackedMemory memory_ RTC_GUARDED_BY(crit_);
 
   // Timestamp of the last received packet/keyframe packet.
   absl::optional<int64_t> last_received_packet_ms_ RTC_GUARDED_BY(crit_);
@@ -70,22 +70,91 @@ class RtpFrameReferenceFinder {
   static const int kMaxGofSaved = 50;
   static const int kMaxPaddingAge = 100;
 
+  // Rings of the state of the unwrapped TL0 picture indices, which are only
+  // kept for the last |kMaxLayerInfo| and |kMaxGofSaved| indices.
+  static const int kTl0RingSize = 64;
+  static_assert(kTl0RingSize > kMaxLayerInfo && kTl0RingSize > kMaxGofSaved,
+                "The rings must hold the indices kept.");
+
   enum FrameDecision { kStash, kHandOff, kDrop };
 
   struct GofInfo {
+    GofInfo() = default;
     GofInfo(GofInfoVP9* gof, uint16_t last_picture_id)
         : gof(gof), last_picture_id(last_picture_id) {}
-    GofInfoVP9* gof;
-    uint16_t last_picture_id;
+    GofInfoVP9* gof = nullptr;
+    uint16_t last_picture_id = 0;
+  };
+
+  // For each temporal layer, the picture id of the last completed frame.
+  using LayerInfo = std::array<int64_t, kMaxTemporalLayers>;
+
+  // Holds a value per unwrapped TL0 picture index, in the slot of the index
+  // modulo |kSize|. A value replaces the one of another index in its slot.
+  template <typename T, size_t kSize>
+  class Tl0Ring {
+   public:
+    // Returns the value of |unwrapped_tl0|, or null if there is none.
+    T* Find(int64_t unwrapped_tl0) {
+      Entry& entry = entries_[Slot(unwrapped_tl0)];
+      if (!entry.used || entry.unwrapped_tl0 != unwrapped_tl0)
+        return nullptr;
+      return &entry.value;
+    }
+
+    // Returns the value of |unwrapped_tl0|, set to |value| if there was none.
+    T* Emplace(int64_t unwrapped_tl0, T value) {
+      Entry& entry = entries_[Slot(unwrapped_tl0)];
+      if (!entry.used || entry.unwrapped_tl0 != unwrapped_tl0) {
+        entry.used = true;
+        entry.unwrapped_tl0 = unwrapped_tl0;
+        entry.value = std::move(value);
+      }
+      return &entry.value;
+    }
+
+    // Removes the values of the indices older than |unwrapped_tl0|.
+    void EraseOlderThan(int64_t unwrapped_tl0) {
+      for (Entry& entry : entries_) {
+        if (entry.unwrapped_tl0 < unwrapped_tl0)
+          entry.used = false;
+      }
+    }
+
+   private:
+    struct Entry {
+      bool used = false;
+      int64_t unwrapped_tl0 = 0;
+      T value;
+    };
+
+    static size_t Slot(int64_t unwrapped_tl0) {
+      return static_cast<uint64_t>(unwrapped_tl0) % kSize;
+    }
+
+    std::array<Entry, kSize> entries_;
   };
 
   // Find the relevant group of pictures and update its "last-picture-id-with
   // padding" sequence number.
   void UpdateLastPictureIdWithPadding(uint16_t seq_num);
 
-  // Retry stashed frames until no more complete frames are found.
+  // Stashes |frame| in the order of the sequence numbers, dropping the oldest
+  // stashed frame if there are too many.
+  void StashFrame(std::unique_ptr<RtpFrameObject> frame);
+
+  // Retries the stashed frames, in order. A frame can only complete newer
+  // frames, so one pass finds all the complete frames.
   void RetryStashedFrames();
 
+  // Retries the stashed frames newer than the frame starting with |seq_num|,
+  // the only ones that handing off that frame could have completed.
+  void RetryStashedFramesAfter(uint16_t seq_num);
+
+  // Retries the stashed frames from |frame_it| to the end.
+  void RetryStashedFramesFrom(
+      std::deque<std::unique_ptr<RtpFrameObject>>::iterator frame_it);
+
   void HandOffFrame(std::unique_ptr<RtpFrameObject> frame);
 
   FrameDecision ManageFrameInternal(RtpFrameObject* frame);
@@ -172,12 +241,12 @@ class RtpFrameReferenceFinder {
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> not_yet_received_seq_num_;
 
   // Frames that have been fully received but didn't have all the information
-  // needed to determine their references.
+  // needed to determine their references, oldest first.
   std::deque<std::unique_ptr<RtpFrameObject>> stashed_frames_;
 
   // Holds the information about the last completed frame for a given temporal
   // layer given an unwrapped Tl0 picture index.
-  std::map<int64_t, std::array<int64_t, kMaxTemporalLayers>> layer_info_;
+  Tl0Ring<LayerInfo, kTl0RingSize> layer_info_;
 
   // Where the current scalability structure is in the
   // |scalability_structures_| array.
@@ -187,7 +256,7 @@ class RtpFrameReferenceFinder {
   std::array<GofInfoVP9, kMaxGofSaved> scalability_structures_;
 
   // Holds the the Gof information for a given unwrapped TL0 picture index.
-  std::map<int64_t, GofInfo> gof_info_;
+  Tl0Ring<GofInfo, kTl0RingSize> gof_info_;
 
   // Keep track of which picture id and which temporal layer that had the
   // up switch flag set.
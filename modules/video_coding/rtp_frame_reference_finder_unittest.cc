@@ -332,6 +332,21 @@ TEST_F(TestRtpFrameReferenceFinder, ClearTo) {
   EXPECT_EQ(3UL, frames_from_callback_.size());
 }
 
+TEST_F(TestRtpFrameReferenceFinder, StashedFramesCompleteAfterKeyframe) {
+  uint16_t sn = Rand();
+  const int kNumDeltaFrames = 30;
+
+  for (int i = kNumDeltaFrames; i > 0; --i)
+    InsertGeneric(sn + i, sn + i, false);
+  EXPECT_EQ(0UL, frames_from_callback_.size());
+
+  InsertGeneric(sn, sn, true);
+  ASSERT_EQ(kNumDeltaFrames + 1UL, frames_from_callback_.size());
+  CheckReferencesGeneric(sn);
+  for (int i = 1; i <= kNumDeltaFrames; ++i)
+    CheckReferencesGeneric(sn + i, sn + i - 1);
+}
+
 TEST_F(TestRtpFrameReferenceFinder, Vp8NoPictureId) {
   uint16_t sn = Rand();
 
@@ -680,6 +695,23 @@ TEST_F(TestRtpFrameReferenceFinder, Vp8InsertManyFrames_0212) {
   }
 }
 
+TEST_F(TestRtpFrameReferenceFinder, Vp8StashedBaseLayerFramesCompleteInOrder) {
+  uint16_t pid = Rand();
+  uint16_t sn = Rand();
+  const int kNumDeltaFrames = 90;
+
+  // More Tl0 picture indices than the kept layer info, wrapping around.
+  for (int i = kNumDeltaFrames; i > 0; --i)
+    InsertVp8(sn + i, sn + i, false, pid + i, 0, (250 + i) % 256, false);
+  EXPECT_EQ(0UL, frames_from_callback_.size());
+
+  InsertVp8(sn, sn, true, pid, 0, 250, false);
+  ASSERT_EQ(kNumDeltaFrames + 1UL, frames_from_callback_.size());
+  CheckReferencesVp8(pid);
+  for (int i = 1; i <= kNumDeltaFrames; ++i)
+    CheckReferencesVp8(pid + i, pid + i - 1);
+}
+
 TEST_F(TestRtpFrameReferenceFinder, Vp8LayerSync) {
   uint16_t pid = Rand();
   uint16_t sn = Rand();
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/seq_num_bitset.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+constexpr int kBitsPerWord = 64;
+
+// The number of bits in the ring is a power of two, so that a sequence number
+// maps to the same bit before and after it wraps around.
+int RingSize(int max_age) {
+  int size = kBitsPerWord;
+  while (size < max_age + 1)
+    size *= 2;
+  return size;
+}
+}  // namespace
+
+SeqNumBitset::SeqNumBitset(int max_age)
+    : max_age_(max_age),
+      slot_mask_(RingSize(max_age) - 1),
+      bits_(RingSize(max_age) / kBitsPerWord, 0) {
+  RTC_DCHECK_GE(max_age, 0);
+  RTC_DCHECK_LT(max_age, 1 << 15);
+}
+
+SeqNumBitset::~SeqNumBitset() = default;
+
+void SeqNumBitset::AdvanceTo(uint16_t seq_num) {
+  if (!newest_) {
+    newest_ = seq_num;
+    return;
+  }
+  if (!AheadOf(seq_num, *newest_))
+    return;
+
+  const int advance = ForwardDiff(*newest_, seq_num);
+  if (advance > max_age_) {
+    std::fill(bits_.begin(), bits_.end(), 0);
+  } else {
+    ClearBits(*newest_ - max_age_, advance);
+  }
+  newest_ = seq_num;
+}
+
+void SeqNumBitset::Insert(uint16_t seq_num) {
+  AdvanceTo(seq_num);
+  if (Age(seq_num) < 0)
+    return;
+  const uint16_t slot = seq_num & slot_mask_;
+  bits_[slot / kBitsPerWord] |= uint64_t{1} << (slot % kBitsPerWord);
+}
+
+void SeqNumBitset::Erase(uint16_t seq_num) {
+  if (Age(seq_num) < 0)
+    return;
+  const uint16_t slot = seq_num & slot_mask_;
+  bits_[slot / kBitsPerWord] &= ~(uint64_t{1} << (slot % kBitsPerWord));
+}
+
+bool SeqNumBitset::Contains(uint16_t seq_num) const {
+  if (Age(seq_num) < 0)
+    return false;
+  const uint16_t slot = seq_num & slot_mask_;
+  return (bits_[slot / kBitsPerWord] >> (slot % kBitsPerWord)) & 1;
+}
+
+void SeqNumBitset::EraseOlderThan(uint16_t seq_num) {
+  if (!newest_)
+    return;
+  if (AheadOf(seq_num, *newest_)) {
+    std::fill(bits_.begin(), bits_.end(), 0);
+    return;
+  }
+  const int age = ForwardDiff(seq_num, *newest_);
+  if (age > max_age_)
+    return;
+  ClearBits(*newest_ - max_age_, max_age_ - age);
+}
+
+absl::optional<uint16_t> SeqNumBitset::Oldest() const {
+  if (!newest_)
+    return absl::nullopt;
+  uint16_t seq_num = *newest_ - max_age_;
+  int remaining = max_age_ + 1;
+  while (remaining > 0) {
+    const uint16_t slot = seq_num & slot_mask_;
+    const int bit = slot % kBitsPerWord;
+    const int count = std::min(kBitsPerWord - bit, remaining);
+    const uint64_t word = bits_[slot / kBitsPerWord] >> bit;
+    if (word != 0) {
+      for (int i = 0; i < count; ++i) {
+        if ((word >> i) & 1)
+          return static_cast<uint16_t>(seq_num + i);
+      }
+    }
+    seq_num += count;
+    remaining -= count;
+  }
+  return absl::nullopt;
+}
+
+void SeqNumBitset::Clear() {
+  std::fill(bits_.begin(), bits_.end(), 0);
+  newest_ = absl::nullopt;
+}
+
+int SeqNumBitset::Age(uint16_t seq_num) const {
+  if (!newest_ || AheadOf(seq_num, *newest_))
+    return -1;
+  const int age = ForwardDiff(seq_num, *newest_);
+  return age <= max_age_ ? age : -1;
+}
+
+void SeqNumBitset::ClearBits(uint16_t seq_num, int count) {
+  while (count > 0) {
+    const uint16_t slot = seq_num & slot_mask_;
+    const int bit = slot % kBitsPerWord;
+    const int num_bits = std::min(kBitsPerWord - bit, count);
+    const uint64_t mask = num_bits == kBitsPerWord
+                              ? ~uint64_t{0}
+                              : ((uint64_t{1} << num_bits) - 1) << bit;
+    bits_[slot / kBitsPerWord] &= ~mask;
+    seq_num += num_bits;
+    count -= num_bits;
+  }
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_SEQ_NUM_BITSET_H_
+#define MODULES_VIDEO_CODING_SEQ_NUM_BITSET_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+namespace video_coding {
+
+// A set of RTP sequence numbers, kept in a window that ends at the newest
+// sequence number seen and spans |max_age| sequence numbers before it. The
+// sequence numbers that fall out of the window as it moves forward are
+// dropped. The set is a ring of bits, so inserting, erasing and looking up a
+// sequence number take constant time.
+class SeqNumBitset {
+ public:
+  // |max_age| must be less than 2^15.
+  explicit SeqNumBitset(int max_age);
+  ~SeqNumBitset();
+
+  // Moves the window forward to end at |seq_num|, if it's newer than the
+  // newest sequence number seen so far.
+  void AdvanceTo(uint16_t seq_num);
+
+  // Moves the window to end at |seq_num| if needed, and inserts |seq_num|
+  // unless it's older than the window.
+  void Insert(uint16_t seq_num);
+  void Erase(uint16_t seq_num);
+  bool Contains(uint16_t seq_num) const;
+
+  // Erases the sequence numbers older than |seq_num|.
+  void EraseOlderThan(uint16_t seq_num);
+
+  // Returns the oldest sequence number in the set, if any.
+  absl::optional<uint16_t> Oldest() const;
+
+  void Clear();
+
+ private:
+  // Returns how many sequence numbers |seq_num| is behind |newest_|, or -1 if
+  // it isn't in the window.
+  int Age(uint16_t seq_num) const;
+  // Clears the bits of |count| sequence numbers, starting at |seq_num|.
+  void ClearBits(uint16_t seq_num, int count);
+
+  const int max_age_;
+  const uint16_t slot_mask_;
+  std::vector<uint64_t> bits_;
+  absl::optional<uint16_t> newest_;
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_SEQ_NUM_BITSET_H_
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/seq_num_bitset.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+constexpr int kMaxAge = 100;
+
+TEST(SeqNumBitsetTest, InsertsAndErases) {
+  SeqNumBitset bitset(kMaxAge);
+  EXPECT_FALSE(bitset.Contains(10));
+  EXPECT_FALSE(bitset.Oldest());
+
+  bitset.Insert(10);
+  bitset.Insert(12);
+  EXPECT_TRUE(bitset.Contains(10));
+  EXPECT_FALSE(bitset.Contains(11));
+  EXPECT_TRUE(bitset.Contains(12));
+  EXPECT_EQ(bitset.Oldest(), 10);
+
+  bitset.Erase(10);
+  EXPECT_FALSE(bitset.Contains(10));
+  EXPECT_EQ(bitset.Oldest(), 12);
+}
+
+TEST(SeqNumBitsetTest, DropsSequenceNumbersOutsideTheWindow) {
+  SeqNumBitset bitset(kMaxAge);
+  bitset.Insert(10);
+  bitset.Insert(20);
+  bitset.AdvanceTo(10 + kMaxAge);
+  EXPECT_TRUE(bitset.Contains(10));
+
+  bitset.AdvanceTo(11 + kMaxAge);
+  EXPECT_FALSE(bitset.Contains(10));
+  EXPECT_TRUE(bitset.Contains(20));
+  EXPECT_EQ(bitset.Oldest(), 20);
+
+  // Too old to be inserted.
+  bitset.Insert(5);
+  EXPECT_FALSE(bitset.Contains(5));
+  EXPECT_EQ(bitset.Oldest(), 20);
+}
+
+TEST(SeqNumBitsetTest, DoesntAliasSequenceNumbersAfterALargeJump) {
+  SeqNumBitset bitset(kMaxAge);
+  bitset.Insert(10);
+  // Maps to the same bit as 10.
+  bitset.AdvanceTo(10 + 1024);
+  EXPECT_FALSE(bitset.Contains(10 + 1024));
+  EXPECT_FALSE(bitset.Oldest());
+}
+
+TEST(SeqNumBitsetTest, HandlesWrapAround) {
+  SeqNumBitset bitset(kMaxAge);
+  bitset.Insert(0xfffe);
+  bitset.Insert(1);
+  EXPECT_TRUE(bitset.Contains(0xfffe));
+  EXPECT_FALSE(bitset.Contains(0xffff));
+  EXPECT_FALSE(bitset.Contains(0));
+  EXPECT_TRUE(bitset.Contains(1));
+  EXPECT_EQ(bitset.Oldest(), 0xfffe);
+
+  bitset.EraseOlderThan(0);
+  EXPECT_FALSE(bitset.Contains(0xfffe));
+  EXPECT_EQ(bitset.Oldest(), 1);
+}
+
+TEST(SeqNumBitsetTest, EraseOlderThan) {
+  SeqNumBitset bitset(kMaxAge);
+  for (uint16_t seq_num = 10; seq_num < 20; ++seq_num)
+    bitset.Insert(seq_num);
+
+  bitset.EraseOlderThan(15);
+  EXPECT_FALSE(bitset.Contains(14));
+  EXPECT_TRUE(bitset.Contains(15));
+  EXPECT_EQ(bitset.Oldest(), 15);
+
+  bitset.EraseOlderThan(100);
+  EXPECT_FALSE(bitset.Contains(19));
+  EXPECT_FALSE(bitset.Oldest());
+}
+
+TEST(SeqNumBitsetTest, Clear) {
+  SeqNumBitset bitset(kMaxAge);
+  bitset.Insert(1000);
+  bitset.Clear();
+  EXPECT_FALSE(bitset.Contains(1000));
+
+  // The window starts over with the next insert.
+  bitset.Insert(10);
+  EXPECT_TRUE(bitset.Contains(10));
+}
+
+}  // namespace
+}  // namespace video_coding
+}  // namespace webrtc
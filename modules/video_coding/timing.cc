@@ -177,7 +177,7 @@ int64_t VCMTiming::RenderTimeMs(uint32_t frame_timestamp,
 
 int64_t VCMTiming::RenderTimeMsInternal(uint32_t frame_timestamp,
                                         int64_t now_ms) const {
-  if (min_playout_delay_ms_ == 0 && max_playout_delay_ms_ == 0) {
+  if (UseLowLatencyRenderingInternal()) {
     // Render as soon as possible.
     return 0;
   }
@@ -210,11 +210,25 @@ int64_t VCMTiming::MaxWaitingTime(int64_t render_time_ms,
   return max_wait_time_ms;
 }
 
+bool VCMTiming::UseLowLatencyRendering() const {
+  rtc::CritScope cs(&crit_sect_);
+  return UseLowLatencyRenderingInternal();
+}
+
+bool VCMTiming::UseLowLatencyRenderingInternal() const {
+  return min_playout_delay_ms_ == 0 && max_playout_delay_ms_ == 0;
+}
+
 int VCMTiming::TargetVideoDelay() const {
   rtc::CritScope cs(&crit_sect_);
   return TargetDelayInternal();
 }
 
+int VCMTiming::UnconstrainedTargetVideoDelay() const {
+  rtc::CritScope cs(&crit_sect_);
+  return jitter_delay_ms_ + RequiredDecodeTimeMs() + render_delay_ms_;
+}
+
 int VCMTiming::TargetDelayInternal() const {
   return std::max(min_playout_delay_ms_,
                   jitter_delay_ms_ + RequiredDecodeTimeMs() + render_delay_ms_);
@@ -84,10 +84,19 @@ class VCMTiming {
   // complete before we must pass it to the decoder.
   virtual int64_t MaxWaitingTime(int64_t render_time_ms, int64_t now_ms) const;
 
+  // Returns true if the playout delay is zero, in which case the frames are
+  // rendered as soon as they are decoded, and decoded as soon as they are
+  // decodable. The jitter estimate is then only reported in the stats.
+  bool UseLowLatencyRendering() const;
+
   // Returns the current target delay which is required delay + decode time +
   // render delay.
   int TargetVideoDelay() const;
 
+  // Returns the target delay without the minimum playout delay, i.e. what the
+  // jitter, decode time and render delay alone require.
+  int UnconstrainedTargetVideoDelay() const;
+
   // Return current timing information. Returns true if the first frame has been
   // decoded, false otherwise.
   virtual bool GetTimings(int* max_decode_ms,
@@ -108,6 +117,8 @@ class VCMTiming {
   int64_t RenderTimeMsInternal(uint32_t frame_timestamp, int64_t now_ms) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
   int TargetDelayInternal() const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+  bool UseLowLatencyRenderingInternal() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
  private:
   rtc::CriticalSection crit_sect_;
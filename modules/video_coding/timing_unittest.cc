@@ -127,4 +127,18 @@ TEST(ReceiverTiming, WrapAround) {
   }
 }
 
+TEST(ReceiverTiming, LowLatencyRenderingWithZeroPlayoutDelay) {
+  SimulatedClock clock(1000);
+  VCMTiming timing(&clock);
+  EXPECT_FALSE(timing.UseLowLatencyRendering());
+  timing.set_max_playout_delay(0);
+  EXPECT_TRUE(timing.UseLowLatencyRendering());
+  timing.IncomingTimestamp(0, clock.TimeInMilliseconds());
+  timing.SetJitterDelay(50);
+  EXPECT_EQ(0, timing.RenderTimeMs(0, clock.TimeInMilliseconds()));
+  timing.set_min_playout_delay(10);
+  timing.set_max_playout_delay(100);
+  EXPECT_FALSE(timing.UseLowLatencyRendering());
+}
+
 }  // namespace webrtc
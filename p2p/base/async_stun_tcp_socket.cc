@@ -12,8 +12,8 @@
 
 #include <errno.h>
 #include <stdint.h>
-#include <string.h>
 
+#include "api/array_view.h"
 #include "api/transport/stun.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
@@ -71,13 +71,12 @@ int AsyncStunTCPSocket::Send(const void* pv,
   if (cb != expected_pkt_len)
     return -1;
 
-  AppendToOutBuffer(pv, cb);
-
   RTC_DCHECK(pad_bytes < 4);
-  char padding[4] = {0};
-  AppendToOutBuffer(padding, pad_bytes);
-
-  int res = FlushOutBuffer();
+  const uint8_t padding[4] = {0};
+  const rtc::ArrayView<const uint8_t> buffers[] = {
+      {static_cast<const uint8_t*>(pv), cb},
+      {padding, static_cast<size_t>(pad_bytes)}};
+  int res = SendOrBuffer(buffers);
   if (res <= 0) {
     // drop packet if we made no progress
     ClearOutBuffer();
@@ -119,10 +118,8 @@ void AsyncStunTCPSocket::ProcessInput(char* data, size_t* len) {
     SignalReadPacket(this, data, expected_pkt_len, remote_addr,
                      rtc::TimeMicros());
 
+    data += actual_length;
     *len -= actual_length;
-    if (*len > 0) {
-      memmove(data, data + actual_length, *len);
-    }
   }
 }
 
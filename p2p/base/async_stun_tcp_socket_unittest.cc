@@ -253,6 +253,36 @@ TEST_F(AsyncStunTCPSocketTest, TestWithSmallSendBuffer) {
                         sizeof(kTurnChannelDataMessageWithOddLength)));
 }
 
+// Test that the packets received by the same reads are all parsed, including
+// those split between two reads.
+TEST_F(AsyncStunTCPSocketTest, TestPacketsReceivedTogether) {
+  rtc::PacketOptions options;
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2) {
+      EXPECT_EQ(static_cast<int>(sizeof(kStunMessageWithZeroLength)),
+                send_socket_->Send(kStunMessageWithZeroLength,
+                                   sizeof(kStunMessageWithZeroLength),
+                                   options));
+    } else {
+      EXPECT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessageWithOddLength)),
+                send_socket_->Send(kTurnChannelDataMessageWithOddLength,
+                                   sizeof(kTurnChannelDataMessageWithOddLength),
+                                   options));
+    }
+  }
+  vss_->ProcessMessagesUntilIdle();
+  ASSERT_EQ(100u, recv_packets_.size());
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2) {
+      EXPECT_TRUE(CheckData(kStunMessageWithZeroLength,
+                            sizeof(kStunMessageWithZeroLength)));
+    } else {
+      EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                            sizeof(kTurnChannelDataMessageWithOddLength)));
+    }
+  }
+}
+
 // Test that SignalSentPacket is fired when a packet is sent.
 TEST_F(AsyncStunTCPSocketTest, SignalSentPacketFiredWhenPacketSent) {
   ASSERT_TRUE(
@@ -338,6 +338,15 @@ const Connection* BasicIceController::MorePingable(const Connection* conn1,
     return least_recently_pinged_conn;
   }
 
+  // Check the kinds of connections that worked before first, without pinging
+  // them more often than the others.
+  if (config_.candidate_pair_history) {
+    const Connection* selected_more_often = SelectedMoreOften(conn1, conn2);
+    if (selected_more_often) {
+      return selected_more_often;
+    }
+  }
+
   // During the initial state when nothing has been pinged yet, return the first
   // one in the ordered |connections_|.
   auto connections = connections_;
@@ -368,6 +377,22 @@ const Connection* BasicIceController::MostLikelyToWork(
   return nullptr;
 }
 
+const Connection* BasicIceController::SelectedMoreOften(
+    const Connection* conn1,
+    const Connection* conn2) const {
+  int count1 = config_.candidate_pair_history->GetSelectedCount(
+      conn1->local_candidate(), conn1->remote_candidate());
+  int count2 = config_.candidate_pair_history->GetSelectedCount(
+      conn2->local_candidate(), conn2->remote_candidate());
+  if (count1 > count2) {
+    return conn1;
+  }
+  if (count2 > count1) {
+    return conn2;
+  }
+  return nullptr;
+}
+
 const Connection* BasicIceController::LeastRecentlyPinged(
     const Connection* conn1,
     const Connection* conn2) {
@@ -87,6 +87,10 @@ class BasicIceController : public IceControllerInterface {
   // UDP relay protocol takes precedence.
   const Connection* MostLikelyToWork(const Connection* conn1,
                                      const Connection* conn2);
+  // Select the connection of the kind that got selected more often before,
+  // according to |config_.candidate_pair_history|.
+  const Connection* SelectedMoreOften(const Connection* conn1,
+                                      const Connection* conn2) const;
   // Compare the last_ping_sent time and return the one least recently pinged.
   const Connection* LeastRecentlyPinged(const Connection* conn1,
                                         const Connection* conn2);
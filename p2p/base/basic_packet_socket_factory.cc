@@ -25,9 +25,16 @@
 #include "rtc_base/socket_server.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/thread.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace rtc {
 
+namespace {
+// Datagrams read per read event with WebRTC-Network-BatchedReceive, which
+// leaves 4 kB of the receive buffer for each of them.
+constexpr size_t kReceiveBatchSize = 16;
+}  // namespace
+
 BasicPacketSocketFactory::BasicPacketSocketFactory()
     : thread_(Thread::Current()), socket_factory_(NULL) {}
 
@@ -55,7 +62,15 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateUdpSocket(
     delete socket;
     return NULL;
   }
-  return new AsyncUDPSocket(socket);
+  if (webrtc::field_trial::IsEnabled("WebRTC-Network-SendTimestamps") &&
+      socket->SetOption(Socket::OPT_SEND_TIMESTAMPS, 1) != 0) {
+    RTC_LOG(LS_INFO) << "UDP send timestamps not supported.";
+  }
+  AsyncUDPSocket* udp_socket = new AsyncUDPSocket(socket);
+  if (webrtc::field_trial::IsEnabled("WebRTC-Network-BatchedReceive")) {
+    udp_socket->SetReceiveBatchSize(kReceiveBatchSize);
+  }
+  return udp_socket;
 }
 
 AsyncPacketSocket* BasicPacketSocketFactory::CreateServerTcpSocket(
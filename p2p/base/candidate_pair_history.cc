@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/candidate_pair_history.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "p2p/base/port.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
+
+namespace cricket {
+
+CandidatePairHistory::CandidatePairHistory(size_t max_entries)
+    : max_entries_(max_entries) {
+  RTC_DCHECK_GT(max_entries_, 0);
+}
+
+CandidatePairHistory::~CandidatePairHistory() = default;
+
+void CandidatePairHistory::RecordSelected(const Candidate& local,
+                                          const Candidate& remote) {
+  std::string key = GetKey(local, remote);
+  rtc::CritScope cs(&crit_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    if (entries_.size() == max_entries_) {
+      entries_.erase(std::min_element(
+          entries_.begin(), entries_.end(),
+          [](const std::pair<const std::string, Entry>& a,
+             const std::pair<const std::string, Entry>& b) {
+            return a.second.last_selected < b.second.last_selected;
+          }));
+    }
+    it = entries_.emplace(std::move(key), Entry()).first;
+  }
+  ++it->second.selected_count;
+  it->second.last_selected = ++last_selected_;
+}
+
+int CandidatePairHistory::GetSelectedCount(const Candidate& local,
+                                           const Candidate& remote) const {
+  const std::string key = GetKey(local, remote);
+  rtc::CritScope cs(&crit_);
+  auto it = entries_.find(key);
+  return it == entries_.end() ? 0 : it->second.selected_count;
+}
+
+std::string CandidatePairHistory::GetKey(const Candidate& local,
+                                         const Candidate& remote) {
+  rtc::StringBuilder key;
+  key << local.network_name() << "/" << local.type() << "/"
+      << local.protocol();
+  if (local.type() == RELAY_PORT_TYPE)
+    key << "/" << local.relay_protocol() << "/" << local.url();
+  key << "|" << remote.type() << "/" << remote.protocol();
+  return key.Release();
+}
+
+}  // namespace cricket
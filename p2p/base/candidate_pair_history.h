@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_CANDIDATE_PAIR_HISTORY_H_
+#define P2P_BASE_CANDIDATE_PAIR_HISTORY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "api/candidate.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace cricket {
+
+// Remembers which kinds of candidate pairs got selected and strongly connected
+// in earlier ICE sessions, so that the pairs likely to work again are checked
+// first, see IceConfig::candidate_pair_history. A pair is identified by the
+// local network, the type and protocol of both candidates and, for relay
+// candidates, the TURN server, since the addresses change between sessions.
+//
+// Thread safe, so that one history can be shared by all the transports of a
+// process.
+class RTC_EXPORT CandidatePairHistory {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 32;
+
+  // Keeps at most |max_entries| kinds of pairs, dropping the ones selected
+  // least recently.
+  explicit CandidatePairHistory(size_t max_entries = kDefaultMaxEntries);
+  ~CandidatePairHistory();
+
+  CandidatePairHistory(const CandidatePairHistory&) = delete;
+  CandidatePairHistory& operator=(const CandidatePairHistory&) = delete;
+
+  void RecordSelected(const Candidate& local, const Candidate& remote);
+  // Returns how often a pair of the kind of |local| and |remote| got
+  // selected, 0 if never.
+  int GetSelectedCount(const Candidate& local, const Candidate& remote) const;
+
+ private:
+  struct Entry {
+    int selected_count = 0;
+    // Value of |last_selected_| when the pair was last selected.
+    int64_t last_selected = 0;
+  };
+
+  static std::string GetKey(const Candidate& local, const Candidate& remote);
+
+  const size_t max_entries_;
+  rtc::CriticalSection crit_;
+  std::map<std::string, Entry> entries_ RTC_GUARDED_BY(crit_);
+  int64_t last_selected_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_CANDIDATE_PAIR_HISTORY_H_
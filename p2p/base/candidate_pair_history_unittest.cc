@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/candidate_pair_history.h"
+
+#include <string>
+
+#include "p2p/base/port.h"
+#include "rtc_base/socket_address.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+Candidate CreateCandidate(const std::string& type,
+                          const std::string& network_name,
+                          const std::string& address) {
+  Candidate candidate;
+  candidate.set_type(type);
+  candidate.set_protocol(UDP_PROTOCOL_NAME);
+  candidate.set_network_name(network_name);
+  candidate.set_address(rtc::SocketAddress(address, 5000));
+  return candidate;
+}
+
+TEST(CandidatePairHistoryTest, CountsPairsOfTheSameKind) {
+  CandidatePairHistory history;
+  const Candidate local = CreateCandidate(LOCAL_PORT_TYPE, "wlan0", "1.1.1.1");
+  const Candidate remote = CreateCandidate(STUN_PORT_TYPE, "", "2.2.2.2");
+  EXPECT_EQ(history.GetSelectedCount(local, remote), 0);
+
+  history.RecordSelected(local, remote);
+  history.RecordSelected(local, remote);
+  // The addresses change between sessions and are not part of the kind.
+  EXPECT_EQ(history.GetSelectedCount(
+                CreateCandidate(LOCAL_PORT_TYPE, "wlan0", "3.3.3.3"),
+                CreateCandidate(STUN_PORT_TYPE, "", "4.4.4.4")),
+            2);
+  EXPECT_EQ(history.GetSelectedCount(
+                CreateCandidate(LOCAL_PORT_TYPE, "eth0", "1.1.1.1"), remote),
+            0);
+  EXPECT_EQ(history.GetSelectedCount(
+                local, CreateCandidate(RELAY_PORT_TYPE, "", "2.2.2.2")),
+            0);
+}
+
+TEST(CandidatePairHistoryTest, DistinguishesRelayServers) {
+  CandidatePairHistory history;
+  Candidate relay1 = CreateCandidate(RELAY_PORT_TYPE, "wlan0", "1.1.1.1");
+  relay1.set_url("turn:turn1.example.com");
+  Candidate relay2 = relay1;
+  relay2.set_url("turn:turn2.example.com");
+  const Candidate remote = CreateCandidate(LOCAL_PORT_TYPE, "", "2.2.2.2");
+
+  history.RecordSelected(relay1, remote);
+  EXPECT_EQ(history.GetSelectedCount(relay1, remote), 1);
+  EXPECT_EQ(history.GetSelectedCount(relay2, remote), 0);
+}
+
+TEST(CandidatePairHistoryTest, DropsTheLeastRecentlySelectedPairs) {
+  CandidatePairHistory history(/*max_entries=*/2);
+  const Candidate remote = CreateCandidate(LOCAL_PORT_TYPE, "", "2.2.2.2");
+  const Candidate local1 = CreateCandidate(LOCAL_PORT_TYPE, "net1", "1.1.1.1");
+  const Candidate local2 = CreateCandidate(LOCAL_PORT_TYPE, "net2", "1.1.1.1");
+  const Candidate local3 = CreateCandidate(LOCAL_PORT_TYPE, "net3", "1.1.1.1");
+
+  history.RecordSelected(local1, remote);
+  history.RecordSelected(local2, remote);
+  history.RecordSelected(local1, remote);
+  history.RecordSelected(local3, remote);
+  EXPECT_EQ(history.GetSelectedCount(local1, remote), 2);
+  EXPECT_EQ(history.GetSelectedCount(local2, remote), 0);
+  EXPECT_EQ(history.GetSelectedCount(local3, remote), 1);
+}
+
+}  // namespace
+}  // namespace cricket
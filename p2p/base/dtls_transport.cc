@@ -26,7 +26,9 @@
 #include "rtc_base/rtc_certificate.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/task_queue_pooled.h"
 #include "rtc_base/thread.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace cricket {
 
@@ -92,9 +94,8 @@ rtc::StreamResult StreamInterfaceChannel::Write(const void* data,
   // Always succeeds, since this is an unreliable transport anyway.
   // TODO(zhihuang): Should this block if ice_transport_'s temporarily
   // unwritable?
-  rtc::PacketOptions packet_options;
   ice_transport_->SendPacket(static_cast<const char*>(data), data_len,
-                             packet_options);
+                             packet_options_);
   if (written) {
     *written = data_len;
   }
@@ -204,6 +205,10 @@ bool DtlsTransport::SetSslMaxProtocolVersion(rtc::SSLProtocolVersion version) {
   return true;
 }
 
+void DtlsTransport::SetSslSessionCache(rtc::SSLSessionCache* session_cache) {
+  ssl_session_cache_ = session_cache;
+}
+
 bool DtlsTransport::SetDtlsRole(rtc::SSLRole role) {
   if (dtls_) {
     RTC_DCHECK(dtls_role_);
@@ -349,7 +354,19 @@ bool DtlsTransport::SetupDtls() {
 
   dtls_->SetIdentity(local_certificate_->identity()->Clone());
   dtls_->SetMode(rtc::SSL_MODE_DTLS);
+  if (webrtc::field_trial::IsEnabled("WebRTC-DtlsHandshakeOffload")) {
+    if (!handshake_task_queue_) {
+      // The queues of all the transports share the threads of the pool.
+      static webrtc::TaskQueueFactory* const factory =
+          webrtc::CreateTaskQueuePooledFactory().release();
+      handshake_task_queue_ = factory->CreateTaskQueue(
+          "DtlsHandshake", webrtc::TaskQueueFactory::Priority::NORMAL);
+    }
+    dtls_->SetHandshakeTaskQueue(handshake_task_queue_.get());
+  }
   dtls_->SetMaxProtocolVersion(ssl_max_version_);
+  if (ssl_session_cache_)
+    dtls_->SetSessionCache(ssl_session_cache_);
   dtls_->SetServerRole(*dtls_role_);
   dtls_->SignalEvent.connect(this, &DtlsTransport::OnDtlsEvent);
   dtls_->SignalSSLHandshakeError.connect(this,
@@ -425,9 +442,12 @@ int DtlsTransport::SendPacket(const char* data,
 
         return ice_transport_->SendPacket(data, size, options);
       } else {
-        return (dtls_->WriteAll(data, size, NULL, NULL) == rtc::SR_SUCCESS)
-                   ? static_cast<int>(size)
-                   : -1;
+        // A record fits in one packet, so the options of the data apply to
+        // the packet the record is sent in.
+        downward_->set_packet_options(options);
+        bool sent = dtls_->WriteAll(data, size, NULL, NULL) == rtc::SR_SUCCESS;
+        downward_->set_packet_options(rtc::PacketOptions());
+        return sent ? static_cast<int>(size) : -1;
       }
     case DTLS_TRANSPORT_FAILED:
       // Can't send anything when we're failed.
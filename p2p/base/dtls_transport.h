@@ -16,8 +16,10 @@
 #include <vector>
 
 #include "api/crypto/crypto_options.h"
+#include "api/task_queue/task_queue_base.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/ice_transport_internal.h"
+#include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/buffer_queue.h"
 #include "rtc_base/constructor_magic.h"
@@ -41,6 +43,12 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
   // Push in a packet; this gets pulled out from Read().
   bool OnPacketReceived(const char* data, size_t size);
 
+  // Options the packets written are sent with, e.g. to batch the records of
+  // application data sent by DtlsTransport::SendPacket().
+  void set_packet_options(const rtc::PacketOptions& options) {
+    packet_options_ = options;
+  }
+
   // Implementations of StreamInterface
   rtc::StreamState GetState() const override;
   void Close() override;
@@ -57,6 +65,7 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
   IceTransportInternal* ice_transport_;  // owned by DtlsTransport
   rtc::StreamState state_;
   rtc::BufferQueue packets_;
+  rtc::PacketOptions packet_options_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(StreamInterfaceChannel);
 };
@@ -141,6 +150,7 @@ class DtlsTransport : public DtlsTransportInternal {
   bool GetOption(rtc::Socket::Option opt, int* value) override;
 
   bool SetSslMaxProtocolVersion(rtc::SSLProtocolVersion version) override;
+  void SetSslSessionCache(rtc::SSLSessionCache* session_cache) override;
 
   // Find out which TLS version was negotiated
   bool GetSslVersionBytes(int* version) const override;
@@ -227,6 +237,10 @@ class DtlsTransport : public DtlsTransportInternal {
   DtlsTransportState dtls_state_ = DTLS_TRANSPORT_NEW;
   // Underlying ice_transport, not owned by this class.
   IceTransportInternal* ice_transport_;
+  // Runs the handshake steps of |dtls_| with the WebRTC-DtlsHandshakeOffload
+  // field trial, so it has to outlive it.
+  std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter>
+      handshake_task_queue_;
   std::unique_ptr<rtc::SSLStreamAdapter> dtls_;  // The DTLS stream
   StreamInterfaceChannel*
       downward_;  // Wrapper for ice_transport_, owned by dtls_.
@@ -235,6 +249,7 @@ class DtlsTransport : public DtlsTransportInternal {
   rtc::scoped_refptr<rtc::RTCCertificate> local_certificate_;
   absl::optional<rtc::SSLRole> dtls_role_;
   rtc::SSLProtocolVersion ssl_max_version_;
+  rtc::SSLSessionCache* ssl_session_cache_ = nullptr;
   webrtc::CryptoOptions crypto_options_;
   rtc::Buffer remote_fingerprint_value_;
   std::string remote_fingerprint_algorithm_;
@@ -109,6 +109,11 @@ class DtlsTransportInternal : public rtc::PacketTransportInternal {
 
   virtual bool SetSslMaxProtocolVersion(rtc::SSLProtocolVersion version) = 0;
 
+  // Sets the cache DTLS sessions are resumed from, see rtc::SSLSessionCache.
+  // It has to outlive the transport. Transports that can't resume sessions
+  // ignore it.
+  virtual void SetSslSessionCache(rtc::SSLSessionCache* session_cache) {}
+
   // Expose the underneath IceTransport.
   virtual IceTransportInternal* ice_transport() = 0;
 
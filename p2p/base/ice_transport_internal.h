@@ -19,6 +19,7 @@
 #include "absl/types/optional.h"
 #include "api/candidate.h"
 #include "api/transport/enums.h"
+#include "p2p/base/candidate_pair_history.h"
 #include "p2p/base/connection.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "p2p/base/port.h"
@@ -163,6 +164,11 @@ struct IceConfig {
 
   absl::optional<rtc::AdapterType> network_preference;
 
+  // If set, the selected connections are recorded in the history, and
+  // connections of the kinds that got selected more often are pinged first.
+  // Not owned, may be shared between transports and has to outlive them.
+  CandidatePairHistory* candidate_pair_history = nullptr;
+
   IceConfig();
   IceConfig(int receiving_timeout_ms,
             int backup_connection_ping_interval,
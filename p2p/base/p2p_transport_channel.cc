@@ -645,6 +645,12 @@ void P2PTransportChannel::SetIceConfig(const IceConfig& config) {
                      << config_.ice_inactive_timeout_or_default();
   }
 
+  if (config_.candidate_pair_history != config.candidate_pair_history) {
+    config_.candidate_pair_history = config.candidate_pair_history;
+    RTC_LOG(LS_INFO) << "Set candidate pair history "
+                     << (config_.candidate_pair_history ? "on" : "off");
+  }
+
   if (config_.network_preference != config.network_preference) {
     config_.network_preference = config.network_preference;
     RequestSortAndStateUpdate(IceControllerEvent::NETWORK_PREFERENCE_CHANGE);
@@ -1716,6 +1722,8 @@ void P2PTransportChannel::SwitchSelectedConnection(Connection* conn,
   // destroyed, so don't use it.
   Connection* old_selected_connection = selected_connection_;
   selected_connection_ = conn;
+  selected_connection_recorded_ = false;
+  MaybeRecordSelectedConnection();
   LogCandidatePairConfig(conn, webrtc::IceCandidatePairConfigType::kSelected);
   network_route_.reset();
   if (old_selected_connection) {
@@ -1784,6 +1792,18 @@ void P2PTransportChannel::SwitchSelectedConnection(Connection* conn,
   ice_controller_->SetSelectedConnection(selected_connection_);
 }
 
+void P2PTransportChannel::MaybeRecordSelectedConnection() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!config_.candidate_pair_history || !selected_connection_ ||
+      selected_connection_recorded_ || selected_connection_->weak()) {
+    return;
+  }
+  config_.candidate_pair_history->RecordSelected(
+      selected_connection_->local_candidate(),
+      selected_connection_->remote_candidate());
+  selected_connection_recorded_ = true;
+}
+
 // Warning: UpdateState should eventually be called whenever a connection
 // is added, deleted, or the write state of any connection changes so that the
 // transport controller will get the up-to-date channel state. However it
@@ -1986,6 +2006,9 @@ void P2PTransportChannel::OnConnectionStateChange(Connection* connection) {
   if (strongly_connected && latest_generation) {
     MaybeStopPortAllocatorSessions();
   }
+  if (connection == selected_connection_) {
+    MaybeRecordSelectedConnection();
+  }
   // We have to unroll the stack before doing this because we may be changing
   // the state of connections while sorting.
   RequestSortAndStateUpdate(
@@ -229,6 +229,9 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   void SortConnections();
   void SortConnectionsIfNeeded();
   void SwitchSelectedConnection(Connection* conn, IceControllerEvent reason);
+  // Records |selected_connection_| in |config_.candidate_pair_history| once
+  // it is strongly connected.
+  void MaybeRecordSelectedConnection();
   void UpdateState();
   void HandleAllTimedOut();
   void MaybeStopPortAllocatorSessions();
@@ -368,6 +371,7 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   std::vector<PortInterface*> pruned_ports_ RTC_GUARDED_BY(network_thread_);
 
   Connection* selected_connection_ RTC_GUARDED_BY(network_thread_) = nullptr;
+  bool selected_connection_recorded_ RTC_GUARDED_BY(network_thread_) = false;
 
   std::vector<RemoteCandidate> remote_candidates_
       RTC_GUARDED_BY(network_thread_);
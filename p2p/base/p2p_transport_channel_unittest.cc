@@ -3482,6 +3482,39 @@ TEST_F(P2PTransportChannelPingTest, TestNoTriggeredChecksWhenWritable) {
   EXPECT_EQ(conn2, FindNextPingableConnectionAndPingIt(&ch));
 }
 
+// Test that connections of the kinds that got selected before are pinged
+// first, but not more often than the others.
+TEST_F(P2PTransportChannelPingTest, TestPingsKindsSelectedBeforeFirst) {
+  FakePortAllocator pa(rtc::Thread::Current(), nullptr);
+  P2PTransportChannel ch("ping history", 1, &pa);
+  CandidatePairHistory history;
+  IceConfig config = ch.config();
+  config.candidate_pair_history = &history;
+  ch.SetIceConfig(config);
+  PrepareChannel(&ch);
+  ch.MaybeStartGathering();
+  ch.AddRemoteCandidate(CreateUdpCandidate(STUN_PORT_TYPE, "1.1.1.1", 1, 1));
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "2.2.2.2", 2, 2));
+
+  Connection* conn1 = WaitForConnectionTo(&ch, "1.1.1.1", 1);
+  Connection* conn2 = WaitForConnectionTo(&ch, "2.2.2.2", 2);
+  ASSERT_TRUE(conn1 != nullptr);
+  ASSERT_TRUE(conn2 != nullptr);
+
+  // |conn2| has the higher priority but a pair like |conn1| worked before.
+  history.RecordSelected(conn1->local_candidate(), conn1->remote_candidate());
+  EXPECT_EQ(conn1, FindNextPingableConnectionAndPingIt(&ch));
+  EXPECT_EQ(conn2, FindNextPingableConnectionAndPingIt(&ch));
+
+  // Once strongly connected, the selected connection is recorded.
+  conn2->ReceivedPingResponse(LOW_RTT, "id");
+  conn2->ReceivedPing();
+  EXPECT_EQ_WAIT(conn2, ch.selected_connection(), kDefaultTimeout);
+  EXPECT_EQ_WAIT(1, history.GetSelectedCount(conn2->local_candidate(),
+                                             conn2->remote_candidate()),
+                 kDefaultTimeout);
+}
+
 TEST_F(P2PTransportChannelPingTest, TestFailedConnectionNotPingable) {
   FakePortAllocator pa(rtc::Thread::Current(), nullptr);
   P2PTransportChannel ch("Do not ping failed connections", 1, &pa);
@@ -514,7 +514,8 @@ class RTC_EXPORT PortAllocator : public sigslot::has_slots<> {
   }
 
   // Delay between different candidate gathering phases (UDP, TURN, TCP).
-  // Defaults to 1 second, but PeerConnection sets it to 50ms.
+  // Defaults to 1 second, but PeerConnection sets it to 50ms. With no delay
+  // all the phases of a network are performed at once.
   // TODO(deadbeef): Get rid of this. Its purpose is to avoid sending too many
   // STUN transactions at once, but that's already happening if you configure
   // multiple STUN servers or have multiple network interfaces. We should
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include <utility>
+
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/location.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/socket_server.h"
+
+namespace cricket {
+namespace {
+
+// Datagrams read per read event of the internal sockets, which receive the
+// data of all clients of a shard.
+constexpr size_t kReceiveBatchSize = 16;
+
+}  // namespace
+
+std::unique_ptr<ShardedTurnServer> ShardedTurnServer::Create(
+    const Config& config) {
+  RTC_DCHECK_GT(config.num_shards, 0);
+  std::unique_ptr<ShardedTurnServer> server(new ShardedTurnServer());
+  server->internal_address_ = config.internal_address;
+  server->shards_.resize(config.num_shards);
+  for (Shard& shard : server->shards_) {
+    shard.thread = rtc::Thread::CreateWithSocketServer();
+    shard.thread->SetName("TurnServerShard", nullptr);
+    shard.thread->Start();
+    server->internal_address_ = shard.thread->Invoke<rtc::SocketAddress>(
+        RTC_FROM_HERE, [&config, &server, &shard] {
+          return StartShard(config, server->internal_address_, &shard);
+        });
+    if (server->internal_address_.IsNil()) {
+      return nullptr;
+    }
+  }
+  RTC_LOG(LS_INFO) << "Started " << server->shards_.size()
+                   << " TURN server shards at "
+                   << server->internal_address_.ToString();
+  return server;
+}
+
+ShardedTurnServer::~ShardedTurnServer() {
+  for (Shard& shard : shards_) {
+    if (!shard.server) {
+      continue;
+    }
+    shard.thread->Invoke<void>(RTC_FROM_HERE,
+                               [&shard] { shard.server.reset(); });
+  }
+  for (Shard& shard : shards_) {
+    if (shard.thread)
+      shard.thread->Stop();
+  }
+}
+
+rtc::SocketAddress ShardedTurnServer::StartShard(
+    const Config& config,
+    const rtc::SocketAddress& address,
+    Shard* shard) {
+  rtc::AsyncSocket* socket =
+      shard->thread->socketserver()->CreateAsyncSocket(address.family(),
+                                                       SOCK_DGRAM);
+  if (!socket) {
+    return rtc::SocketAddress();
+  }
+  if (socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0) {
+    RTC_LOG(LS_ERROR) << "Failed to set SO_REUSEPORT on a TURN server socket.";
+    delete socket;
+    return rtc::SocketAddress();
+  }
+  rtc::AsyncUDPSocket* internal_socket =
+      rtc::AsyncUDPSocket::Create(socket, address);
+  if (!internal_socket) {
+    RTC_LOG(LS_ERROR) << "Failed to bind a TURN server socket at "
+                      << address.ToString();
+    return rtc::SocketAddress();
+  }
+  internal_socket->SetReceiveBatchSize(kReceiveBatchSize);
+  const rtc::SocketAddress bound_address = internal_socket->GetLocalAddress();
+
+  shard->server = std::make_unique<TurnServer>(shard->thread.get());
+  shard->server->set_realm(config.realm);
+  shard->server->set_software(config.software);
+  shard->server->set_auth_hook(config.auth_hook);
+  shard->server->AddInternalSocket(internal_socket, PROTO_UDP);
+  shard->server->SetExternalSocketFactory(
+      new rtc::BasicPacketSocketFactory(shard->thread.get()),
+      rtc::SocketAddress(config.external_ip, 0));
+  return bound_address;
+}
+
+}  // namespace cricket
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARDED_TURN_SERVER_H_
+#define P2P_BASE_SHARDED_TURN_SERVER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "p2p/base/turn_server.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+
+// Runs a TurnServer on each of a number of threads, its shards. Every shard
+// has its own UDP socket bound to the same internal address with
+// SO_REUSEPORT, so the kernel spreads the clients across the shards by the
+// hash of their 5-tuple. The allocations of a client, and their relay sockets,
+// then all live on the thread of one shard, and the shards share no state.
+class ShardedTurnServer {
+ public:
+  struct Config {
+    // If the port is 0, the shards bind the port picked for the first one.
+    rtc::SocketAddress internal_address;
+    // The relay sockets are bound to this address, with any port.
+    rtc::IPAddress external_ip;
+    std::string realm;
+    std::string software;
+    // Called on the threads of all shards, so it has to be thread safe. Not
+    // owned, it has to outlive the server.
+    TurnAuthInterface* auth_hook = nullptr;
+    size_t num_shards = 1;
+  };
+
+  // Starts the threads of the shards. Returns null if any of them can't bind
+  // its internal socket, e.g. because SO_REUSEPORT isn't supported.
+  static std::unique_ptr<ShardedTurnServer> Create(const Config& config);
+  // Stops the threads after destroying the servers on them.
+  ~ShardedTurnServer();
+
+  ShardedTurnServer(const ShardedTurnServer&) = delete;
+  ShardedTurnServer& operator=(const ShardedTurnServer&) = delete;
+
+  // The address all internal sockets are bound to.
+  const rtc::SocketAddress& internal_address() const {
+    return internal_address_;
+  }
+  size_t num_shards() const { return shards_.size(); }
+
+ private:
+  struct Shard {
+    std::unique_ptr<rtc::Thread> thread;
+    // Only accessed on |thread|.
+    std::unique_ptr<TurnServer> server;
+  };
+
+  ShardedTurnServer() = default;
+  // Binds the internal socket of |shard| and starts its server. Returns the
+  // address bound to, which is nil if binding failed.
+  static rtc::SocketAddress StartShard(const Config& config,
+                                       const rtc::SocketAddress& address,
+                                       Shard* shard);
+
+  rtc::SocketAddress internal_address_;
+  std::vector<Shard> shards_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARDED_TURN_SERVER_H_
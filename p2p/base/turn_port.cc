@@ -983,26 +983,25 @@ void TurnPort::HandleDataIndication(const char* data,
                                     size_t size,
                                     int64_t packet_time_us) {
   // Read in the message, and process according to RFC5766, Section 10.4.
-  rtc::ByteBufferReader buf(data, size);
-  TurnMessage msg;
-  if (!msg.Read(&buf)) {
+  // Data indications carry the relayed media, so they are read in place.
+  StunMessageView msg;
+  if (!msg.Parse(data, size)) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received invalid TURN data indication";
     return;
   }
 
   // Check mandatory attributes.
-  const StunAddressAttribute* addr_attr =
-      msg.GetAddress(STUN_ATTR_XOR_PEER_ADDRESS);
-  if (!addr_attr) {
+  rtc::SocketAddress ext_addr;
+  if (!msg.GetXorAddress(STUN_ATTR_XOR_PEER_ADDRESS, &ext_addr)) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Missing STUN_ATTR_XOR_PEER_ADDRESS attribute "
                            "in data indication.";
     return;
   }
 
-  const StunByteStringAttribute* data_attr = msg.GetByteString(STUN_ATTR_DATA);
-  if (!data_attr) {
+  rtc::ArrayView<const char> payload;
+  if (!msg.GetBytes(STUN_ATTR_DATA, &payload)) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Missing STUN_ATTR_DATA attribute in "
                            "data indication.";
@@ -1011,7 +1010,6 @@ void TurnPort::HandleDataIndication(const char* data,
 
   // Log a warning if the data didn't come from an address that we think we have
   // a permission for.
-  rtc::SocketAddress ext_addr(addr_attr->GetAddress());
   if (!HasPermission(ext_addr.ipaddr())) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received TURN data indication with unknown "
@@ -1019,7 +1017,7 @@ void TurnPort::HandleDataIndication(const char* data,
                         << ext_addr.ToSensitiveString();
   }
 
-  DispatchPacket(data_attr->bytes(), data_attr->length(), ext_addr, PROTO_UDP,
+  DispatchPacket(payload.data(), payload.size(), ext_addr, PROTO_UDP,
                  packet_time_us);
 }
 
@@ -10,16 +10,18 @@
 
 #include "p2p/base/turn_server.h"
 
+#include <string.h>
+
 #include <memory>
 #include <tuple>  // for std::tie
 #include <utility>
 
-#include "absl/algorithm/container.h"
 #include "api/packet_socket_factory.h"
 #include "api/transport/stun.h"
 #include "p2p/base/async_stun_tcp_socket.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/byte_buffer.h"
+#include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
@@ -211,7 +213,11 @@ void TurnServer::OnInternalPacket(rtc::AsyncPacketSocket* socket,
   RTC_DCHECK(iter != server_sockets_.end());
   TurnServerConnection conn(addr, iter->second, socket);
   uint16_t msg_type = rtc::GetBE16(data);
-  if (!IsTurnChannelData(msg_type)) {
+  if (msg_type == TURN_SEND_INDICATION && !stun_message_observer_) {
+    // Send indications carry the relayed media and need no authentication,
+    // so they are read in place rather than parsed into a TurnMessage.
+    HandleSendIndication(&conn, data, size);
+  } else if (!IsTurnChannelData(msg_type)) {
     // This is a STUN message.
     HandleStunMessage(&conn, data, size);
   } else {
@@ -226,6 +232,24 @@ void TurnServer::OnInternalPacket(rtc::AsyncPacketSocket* socket,
   }
 }
 
+void TurnServer::HandleSendIndication(TurnServerConnection* conn,
+                                      const char* data,
+                                      size_t size) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  TurnServerAllocation* allocation = FindAllocation(conn);
+  if (!allocation) {
+    // Answered with an allocation mismatch error, like before the fast path.
+    HandleStunMessage(conn, data, size);
+    return;
+  }
+  StunMessageView msg;
+  if (!msg.Parse(data, size)) {
+    RTC_LOG(LS_WARNING) << "Received invalid STUN message";
+    return;
+  }
+  allocation->HandleSendIndication(msg);
+}
+
 void TurnServer::HandleStunMessage(TurnServerConnection* conn,
                                    const char* data,
                                    size_t size) {
@@ -542,6 +566,24 @@ void TurnServer::Send(TurnServerConnection* conn,
   conn->socket()->SendTo(buf.Data(), buf.Length(), conn->src(), options);
 }
 
+void TurnServer::SendChannelData(TurnServerConnection* conn,
+                                 int channel_id,
+                                 const char* data,
+                                 size_t size) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  channel_data_buffer_.SetSize(TURN_CHANNEL_HEADER_SIZE + size);
+  uint8_t* frame = channel_data_buffer_.data();
+  rtc::SetBE16(frame, static_cast<uint16_t>(channel_id));
+  rtc::SetBE16(frame + 2, static_cast<uint16_t>(size));
+  memcpy(frame + TURN_CHANNEL_HEADER_SIZE, data, size);
+  // The end of a batch isn't known here, the socket sends what is pending
+  // once the current task is done.
+  rtc::PacketOptions options;
+  options.batchable = true;
+  conn->socket()->SendTo(channel_data_buffer_.data(),
+                         channel_data_buffer_.size(), conn->src(), options);
+}
+
 void TurnServer::OnAllocationDestroyed(TurnServerAllocation* allocation) {
   RTC_DCHECK(thread_checker_.IsCurrent());
   // Removing the internal socket if the connection is not udp.
@@ -623,13 +665,10 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
 }
 
 TurnServerAllocation::~TurnServerAllocation() {
-  for (ChannelList::iterator it = channels_.begin(); it != channels_.end();
-       ++it) {
-    delete *it;
-  }
-  for (PermissionList::iterator it = perms_.begin(); it != perms_.end(); ++it) {
-    delete *it;
-  }
+  for (const auto& channel : channels_)
+    delete channel.second;
+  for (const auto& perm : perms_)
+    delete perm.second;
   thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
   RTC_LOG(LS_INFO) << ToString() << ": Allocation destroyed";
 }
@@ -736,16 +775,32 @@ void TurnServerAllocation::HandleSendIndication(const TurnMessage* msg) {
     RTC_LOG(LS_WARNING) << ToString() << ": Received invalid send indication";
     return;
   }
+  SendToPeer(data_attr->bytes(), data_attr->length(), peer_attr->GetAddress());
+}
 
+void TurnServerAllocation::HandleSendIndication(const StunMessageView& msg) {
+  // Check mandatory attributes.
+  rtc::ArrayView<const char> data;
+  rtc::SocketAddress peer;
+  if (!msg.GetBytes(STUN_ATTR_DATA, &data) ||
+      !msg.GetXorAddress(STUN_ATTR_XOR_PEER_ADDRESS, &peer)) {
+    RTC_LOG(LS_WARNING) << ToString() << ": Received invalid send indication";
+    return;
+  }
+  SendToPeer(data.data(), data.size(), peer);
+}
+
+void TurnServerAllocation::SendToPeer(const char* data,
+                                      size_t size,
+                                      const rtc::SocketAddress& peer) {
   // If a permission exists, send the data on to the peer.
-  if (HasPermission(peer_attr->GetAddress().ipaddr())) {
-    SendExternal(data_attr->bytes(), data_attr->length(),
-                 peer_attr->GetAddress());
+  if (HasPermission(peer.ipaddr())) {
+    SendExternal(data, size, peer);
   } else {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received send indication without permission"
                            " peer="
-                        << peer_attr->GetAddress().ToSensitiveString();
+                        << peer.ToSensitiveString();
   }
 }
 
@@ -809,7 +864,8 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
     channel1 = new Channel(thread_, channel_id, peer_attr->GetAddress());
     channel1->SignalDestroyed.connect(
         this, &TurnServerAllocation::OnChannelDestroyed);
-    channels_.push_back(channel1);
+    channels_[channel_id] = channel1;
+    channels_by_peer_[channel1->peer()] = channel1;
   } else {
     channel1->Refresh();
   }
@@ -851,11 +907,7 @@ void TurnServerAllocation::OnExternalPacket(
   Channel* channel = FindChannel(addr);
   if (channel) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id());
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(data, size);
-    server_->Send(&conn_, buf);
+    server_->SendChannelData(&conn_, channel->id(), data, size);
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(addr.ipaddr())) {
     // No channel, but a permission exists. Send as a data indication.
@@ -894,7 +946,7 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
     perm = new Permission(thread_, addr);
     perm->SignalDestroyed.connect(this,
                                   &TurnServerAllocation::OnPermissionDestroyed);
-    perms_.push_back(perm);
+    perms_[addr] = perm;
   } else {
     perm->Refresh();
   }
@@ -902,32 +954,20 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
 
 TurnServerAllocation::Permission* TurnServerAllocation::FindPermission(
     const rtc::IPAddress& addr) const {
-  for (PermissionList::const_iterator it = perms_.begin(); it != perms_.end();
-       ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  auto it = perms_.find(addr);
+  return it != perms_.end() ? it->second : nullptr;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     int channel_id) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->id() == channel_id)
-      return *it;
-  }
-  return NULL;
+  auto it = channels_.find(channel_id);
+  return it != channels_.end() ? it->second : nullptr;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     const rtc::SocketAddress& addr) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  auto it = channels_by_peer_.find(addr);
+  return it != channels_by_peer_.end() ? it->second : nullptr;
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
@@ -949,7 +989,9 @@ void TurnServerAllocation::SendErrorResponse(const TurnMessage* req,
 void TurnServerAllocation::SendExternal(const void* data,
                                         size_t size,
                                         const rtc::SocketAddress& peer) {
+  // Batched like the channel data sent the other way.
   rtc::PacketOptions options;
+  options.batchable = true;
   external_socket_->SendTo(data, size, peer, options);
 }
 
@@ -960,15 +1002,15 @@ void TurnServerAllocation::OnMessage(rtc::Message* msg) {
 }
 
 void TurnServerAllocation::OnPermissionDestroyed(Permission* perm) {
-  auto it = absl::c_find(perms_, perm);
-  RTC_DCHECK(it != perms_.end());
-  perms_.erase(it);
+  size_t erased = perms_.erase(perm->peer());
+  RTC_DCHECK_EQ(erased, 1u);
 }
 
 void TurnServerAllocation::OnChannelDestroyed(Channel* channel) {
-  auto it = absl::c_find(channels_, channel);
-  RTC_DCHECK(it != channels_.end());
-  channels_.erase(it);
+  size_t erased = channels_.erase(channel->id());
+  RTC_DCHECK_EQ(erased, 1u);
+  erased = channels_by_peer_.erase(channel->peer());
+  RTC_DCHECK_EQ(erased, 1u);
 }
 
 TurnServerAllocation::Permission::Permission(rtc::Thread* thread,
@@ -11,17 +11,19 @@
 #ifndef P2P_BASE_TURN_SERVER_H_
 #define P2P_BASE_TURN_SERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "p2p/base/port_interface.h"
 #include "rtc_base/async_invoker.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/ip_address.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
@@ -35,6 +37,7 @@ class PacketSocketFactory;
 namespace cricket {
 
 class StunMessage;
+class StunMessageView;
 class TurnMessage;
 class TurnServer;
 
@@ -87,6 +90,7 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string ToString() const;
 
   void HandleTurnMessage(const TurnMessage* msg);
+  void HandleSendIndication(const StunMessageView& msg);
   void HandleChannelData(const char* data, size_t size);
 
   sigslot::signal1<TurnServerAllocation*> SignalDestroyed;
@@ -94,14 +98,33 @@ class TurnServerAllocation : public rtc::MessageHandler,
  private:
   class Channel;
   class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  struct IPAddressHash {
+    size_t operator()(const rtc::IPAddress& ip) const {
+      return rtc::HashIP(ip);
+    }
+  };
+  struct SocketAddressHash {
+    size_t operator()(const rtc::SocketAddress& addr) const {
+      return addr.Hash();
+    }
+  };
+  // Every relayed packet looks up its channel or permission, so they are kept
+  // in hash tables rather than scanned.
+  typedef std::unordered_map<rtc::IPAddress, Permission*, IPAddressHash>
+      PermissionMap;
+  typedef std::unordered_map<int, Channel*> ChannelMap;
+  typedef std::unordered_map<rtc::SocketAddress, Channel*, SocketAddressHash>
+      ChannelAddressMap;
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
   void HandleSendIndication(const TurnMessage* msg);
   void HandleCreatePermissionRequest(const TurnMessage* msg);
   void HandleChannelBindRequest(const TurnMessage* msg);
+  // Sends data of a send indication to |peer|, if it has a permission.
+  void SendToPeer(const char* data,
+                  size_t size,
+                  const rtc::SocketAddress& peer);
 
   void OnExternalPacket(rtc::AsyncPacketSocket* socket,
                         const char* data,
@@ -138,8 +161,10 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string username_;
   std::string origin_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  PermissionMap perms_;
+  // Owns the channels, |channels_by_peer_| indexes the same ones.
+  ChannelMap channels_;
+  ChannelAddressMap channels_by_peer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -271,6 +296,10 @@ class TurnServer : public sigslot::has_slots<> {
   void HandleStunMessage(TurnServerConnection* conn,
                          const char* data,
                          size_t size);
+  // Relays the data of a send indication without parsing all of the message.
+  void HandleSendIndication(TurnServerConnection* conn,
+                            const char* data,
+                            size_t size);
   void HandleBindingRequest(TurnServerConnection* conn, const StunMessage* msg);
   void HandleAllocateRequest(TurnServerConnection* conn,
                              const TurnMessage* msg,
@@ -305,6 +334,13 @@ class TurnServer : public sigslot::has_slots<> {
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
   void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  // Sends |size| bytes relayed from a peer as channel data on |channel_id|.
+  // Consecutive channel data for the same client is batched, and sent with one
+  // system call where supported.
+  void SendChannelData(TurnServerConnection* conn,
+                       int channel_id,
+                       const char* data,
+                       size_t size);
 
   void OnAllocationDestroyed(TurnServerAllocation* allocation);
   void DestroyInternalSocket(rtc::AsyncPacketSocket* socket);
@@ -337,6 +373,8 @@ class TurnServer : public sigslot::has_slots<> {
   rtc::SocketAddress external_addr_;
 
   AllocationMap allocations_;
+  // Reused to frame the channel data relayed to all clients.
+  rtc::Buffer channel_data_buffer_;
 
   rtc::AsyncInvoker invoker_;
 
@@ -10,12 +10,25 @@
 
 #include "p2p/base/turn_server.h"
 
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "api/transport/stun.h"
 #include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/base/sharded_turn_server.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/test_client.h"
 #include "rtc_base/virtual_socket_server.h"
 #include "test/gtest.h"
 
 // NOTE: This is a work in progress. Currently this file only has tests for
-// TurnServerConnection, a primitive class used by TurnServer.
+// TurnServerConnection, a primitive class used by TurnServer, for the channels
+// of an allocation and for ShardedTurnServer.
 
 namespace cricket {
 
@@ -64,4 +77,237 @@ TEST_F(TurnServerConnectionTest, ComparisonOperators) {
   ExpectNotEqual(connection1, connection4);
 }
 
+constexpr char kRealm[] = "example.org";
+constexpr char kUsername[] = "user";
+const rtc::SocketAddress kServerAddress("1.1.1.1", 3478);
+const rtc::SocketAddress kClientAddress("2.2.2.2", 5000);
+const rtc::SocketAddress kFirstPeerAddress("3.3.3.3", 5000);
+const rtc::SocketAddress kSecondPeerAddress("4.4.4.4", 5000);
+const rtc::SocketAddress kOtherPeerAddress("5.5.5.5", 5000);
+constexpr int kFirstChannel = 0x4000;
+constexpr int kSecondChannel = 0x4001;
+constexpr size_t kChannelHeaderSize = 4;
+
+// Accepts every user whose password is its name.
+class TestTurnAuth : public TurnAuthInterface {
+ public:
+  bool GetKey(const std::string& username,
+              const std::string& realm,
+              std::string* key) override {
+    return ComputeStunCredentialHash(username, realm, username, key);
+  }
+};
+
+std::unique_ptr<rtc::AsyncPacketSocket> CreateUdpSocket(
+    rtc::SocketFactory* factory,
+    const rtc::SocketAddress& address) {
+  return absl::WrapUnique(rtc::AsyncUDPSocket::Create(factory, address));
+}
+
+// Drives a TURN allocation from a raw UDP client.
+class TurnServerAllocationTest : public ::testing::Test {
+ public:
+  TurnServerAllocationTest()
+      : thread_(&vss_),
+        server_(&thread_),
+        client_(CreateUdpSocket(&vss_, kClientAddress)) {
+    server_.set_realm(kRealm);
+    server_.set_auth_hook(&auth_);
+    server_.AddInternalSocket(
+        rtc::AsyncUDPSocket::Create(&vss_, kServerAddress), PROTO_UDP);
+    server_.SetExternalSocketFactory(new rtc::BasicPacketSocketFactory(),
+                                     rtc::SocketAddress("1.1.1.2", 0));
+  }
+
+  // Sends |request|, with the credentials once the server sent its nonce,
+  // and returns the response.
+  std::unique_ptr<TurnMessage> SendRequest(TurnMessage* request) {
+    request->SetTransactionID(
+        rtc::CreateRandomString(kStunTransactionIdLength));
+    if (!nonce_.empty()) {
+      request->AddAttribute(std::make_unique<StunByteStringAttribute>(
+          STUN_ATTR_USERNAME, kUsername));
+      request->AddAttribute(
+          std::make_unique<StunByteStringAttribute>(STUN_ATTR_REALM, kRealm));
+      request->AddAttribute(
+          std::make_unique<StunByteStringAttribute>(STUN_ATTR_NONCE, nonce_));
+      std::string key;
+      ComputeStunCredentialHash(kUsername, kRealm, kUsername, &key);
+      request->AddMessageIntegrity(key);
+    }
+    rtc::ByteBufferWriter buf;
+    request->Write(&buf);
+    client_.SendTo(buf.Data(), buf.Length(), kServerAddress);
+
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        client_.NextPacket(rtc::TestClient::kTimeoutMs);
+    if (!packet)
+      return nullptr;
+    auto response = std::make_unique<TurnMessage>();
+    rtc::ByteBufferReader reader(packet->buf, packet->size);
+    if (!response->Read(&reader))
+      return nullptr;
+    return response;
+  }
+
+  // Allocates the relayed address, answering the challenge of the server.
+  bool Allocate() {
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      TurnMessage request;
+      request.SetType(STUN_ALLOCATE_REQUEST);
+      request.AddAttribute(std::make_unique<StunUInt32Attribute>(
+          STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+      std::unique_ptr<TurnMessage> response = SendRequest(&request);
+      if (!response)
+        return false;
+      if (response->type() == STUN_ALLOCATE_RESPONSE) {
+        const StunAddressAttribute* relayed_address =
+            response->GetAddress(STUN_ATTR_XOR_RELAYED_ADDRESS);
+        if (!relayed_address)
+          return false;
+        relayed_address_ = relayed_address->GetAddress();
+        return true;
+      }
+      const StunByteStringAttribute* nonce =
+          response->GetByteString(STUN_ATTR_NONCE);
+      if (!nonce)
+        return false;
+      nonce_ = nonce->GetString();
+    }
+    return false;
+  }
+
+  bool BindChannel(int channel_id, const rtc::SocketAddress& peer) {
+    TurnMessage request;
+    request.SetType(TURN_CHANNEL_BIND_REQUEST);
+    request.AddAttribute(std::make_unique<StunUInt32Attribute>(
+        STUN_ATTR_CHANNEL_NUMBER, channel_id << 16));
+    request.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+        STUN_ATTR_XOR_PEER_ADDRESS, peer));
+    std::unique_ptr<TurnMessage> response = SendRequest(&request);
+    return response && response->type() == TURN_CHANNEL_BIND_RESPONSE;
+  }
+
+  void SendChannelData(int channel_id, const std::string& data) {
+    rtc::ByteBufferWriter buf;
+    buf.WriteUInt16(channel_id);
+    buf.WriteUInt16(data.size());
+    buf.WriteString(data);
+    client_.SendTo(buf.Data(), buf.Length(), kServerAddress);
+  }
+
+  void ExpectChannelData(int channel_id, const std::string& data) {
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        client_.NextPacket(rtc::TestClient::kTimeoutMs);
+    ASSERT_TRUE(packet);
+    ASSERT_EQ(packet->size, kChannelHeaderSize + data.size());
+    EXPECT_EQ(rtc::GetBE16(packet->buf), channel_id);
+    EXPECT_EQ(rtc::GetBE16(packet->buf + 2), data.size());
+    EXPECT_EQ(std::string(packet->buf + kChannelHeaderSize, data.size()),
+              data);
+  }
+
+ protected:
+  rtc::VirtualSocketServer vss_;
+  rtc::AutoSocketServerThread thread_;
+  TestTurnAuth auth_;
+  TurnServer server_;
+  rtc::TestClient client_;
+  std::string nonce_;
+  rtc::SocketAddress relayed_address_;
+};
+
+TEST_F(TurnServerAllocationTest, RelaysTheChannelDataOfEachPeer) {
+  rtc::TestClient first_peer(CreateUdpSocket(&vss_, kFirstPeerAddress));
+  rtc::TestClient second_peer(CreateUdpSocket(&vss_, kSecondPeerAddress));
+  ASSERT_TRUE(Allocate());
+  ASSERT_TRUE(BindChannel(kFirstChannel, kFirstPeerAddress));
+  ASSERT_TRUE(BindChannel(kSecondChannel, kSecondPeerAddress));
+
+  // Each peer reaches the client on its own channel.
+  second_peer.SendTo("second", 6, relayed_address_);
+  ExpectChannelData(kSecondChannel, "second");
+  first_peer.SendTo("first peer", 10, relayed_address_);
+  ExpectChannelData(kFirstChannel, "first peer");
+
+  // The client reaches each peer through its channel.
+  rtc::SocketAddress address;
+  SendChannelData(kFirstChannel, "to first");
+  EXPECT_TRUE(first_peer.CheckNextPacket("to first", 8, &address));
+  EXPECT_EQ(address, relayed_address_);
+  SendChannelData(kSecondChannel, "to second peer");
+  EXPECT_TRUE(second_peer.CheckNextPacket("to second peer", 14, &address));
+  EXPECT_EQ(address, relayed_address_);
+}
+
+TEST_F(TurnServerAllocationTest, RejectsAChannelBoundToAnotherPeer) {
+  ASSERT_TRUE(Allocate());
+  ASSERT_TRUE(BindChannel(kFirstChannel, kFirstPeerAddress));
+  // Refreshing the binding is allowed.
+  EXPECT_TRUE(BindChannel(kFirstChannel, kFirstPeerAddress));
+  EXPECT_FALSE(BindChannel(kFirstChannel, kSecondPeerAddress));
+  EXPECT_FALSE(BindChannel(kSecondChannel, kFirstPeerAddress));
+}
+
+TEST_F(TurnServerAllocationTest, DropsThePacketsOfAPeerWithoutPermission) {
+  rtc::TestClient first_peer(CreateUdpSocket(&vss_, kFirstPeerAddress));
+  rtc::TestClient other_peer(CreateUdpSocket(&vss_, kOtherPeerAddress));
+  ASSERT_TRUE(Allocate());
+  ASSERT_TRUE(BindChannel(kFirstChannel, kFirstPeerAddress));
+
+  other_peer.SendTo("other", 5, relayed_address_);
+  EXPECT_TRUE(client_.CheckNoPacket());
+  // The permission covers every port of the bound peer.
+  rtc::TestClient first_peer_port(
+      CreateUdpSocket(&vss_, rtc::SocketAddress(kFirstPeerAddress.ipaddr(),
+                                                kFirstPeerAddress.port() + 1)));
+  first_peer_port.SendTo("first", 5, relayed_address_);
+  std::unique_ptr<rtc::TestClient::Packet> packet =
+      client_.NextPacket(rtc::TestClient::kTimeoutMs);
+  ASSERT_TRUE(packet);
+  TurnMessage indication;
+  rtc::ByteBufferReader reader(packet->buf, packet->size);
+  ASSERT_TRUE(indication.Read(&reader));
+  EXPECT_EQ(indication.type(), TURN_DATA_INDICATION);
+}
+
+// SO_REUSEPORT only spreads the datagrams across the sockets on Linux.
+#if defined(WEBRTC_LINUX)
+TEST(ShardedTurnServerTest, AllShardsAnswerOnTheSameAddress) {
+  rtc::PhysicalSocketServer socket_server;
+  rtc::AutoSocketServerThread thread(&socket_server);
+
+  ShardedTurnServer::Config config;
+  config.internal_address = rtc::SocketAddress("127.0.0.1", 0);
+  config.external_ip = rtc::IPAddress(INADDR_LOOPBACK);
+  config.num_shards = 4;
+  std::unique_ptr<ShardedTurnServer> server = ShardedTurnServer::Create(config);
+  ASSERT_TRUE(server);
+  EXPECT_EQ(server->num_shards(), 4u);
+  EXPECT_NE(server->internal_address().port(), 0);
+
+  // Clients on many ports, which the kernel spreads across the shards, all
+  // get an answer.
+  for (int i = 0; i < 16; ++i) {
+    rtc::TestClient client(absl::WrapUnique(rtc::AsyncUDPSocket::Create(
+        &socket_server, rtc::SocketAddress("127.0.0.1", 0))));
+    StunMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    client.SendTo(buf.Data(), buf.Length(), server->internal_address());
+
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        client.NextPacket(rtc::TestClient::kTimeoutMs);
+    ASSERT_TRUE(packet);
+    StunMessage response;
+    rtc::ByteBufferReader reader(packet->buf, packet->size);
+    ASSERT_TRUE(response.Read(&reader));
+    EXPECT_EQ(response.type(), STUN_BINDING_RESPONSE);
+    EXPECT_EQ(response.transaction_id(), request.transaction_id());
+  }
+}
+#endif  // defined(WEBRTC_LINUX)
+
 }  // namespace cricket
@@ -1349,31 +1349,37 @@ void AllocationSequence::OnMessage(rtc::Message* msg) {
 
   const char* const PHASE_NAMES[kNumPhases] = {"Udp", "Relay", "Tcp"};
 
-  // Perform all of the phases in the current step.
-  RTC_LOG(LS_INFO) << network_->ToString()
-                   << ": Allocation Phase=" << PHASE_NAMES[phase_];
-
-  switch (phase_) {
-    case PHASE_UDP:
-      CreateUDPPorts();
-      CreateStunPorts();
-      break;
+  // Perform all of the phases in the current step, or all that are left if
+  // there is no step delay.
+  const bool all_phases = session_->allocator()->step_delay() == 0;
+  do {
+    RTC_LOG(LS_INFO) << network_->ToString()
+                     << ": Allocation Phase=" << PHASE_NAMES[phase_];
+
+    switch (phase_) {
+      case PHASE_UDP:
+        CreateUDPPorts();
+        CreateStunPorts();
+        break;
 
-    case PHASE_RELAY:
-      CreateRelayPorts();
-      break;
+      case PHASE_RELAY:
+        CreateRelayPorts();
+        break;
 
-    case PHASE_TCP:
-      CreateTCPPorts();
-      state_ = kCompleted;
-      break;
+      case PHASE_TCP:
+        CreateTCPPorts();
+        state_ = kCompleted;
+        break;
 
-    default:
-      RTC_NOTREACHED();
-  }
+      default:
+        RTC_NOTREACHED();
+    }
+
+    if (state() == kRunning)
+      ++phase_;
+  } while (all_phases && state() == kRunning);
 
   if (state() == kRunning) {
-    ++phase_;
     session_->network_thread()->PostDelayed(RTC_FROM_HERE,
                                             session_->allocator()->step_delay(),
                                             this, MSG_ALLOCATION_PHASE);
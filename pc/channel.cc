@@ -487,9 +487,13 @@ void BaseChannel::UpdateRtpHeaderExtensionMap(
   // NOTE: This doesn't take the BUNDLE case in account meaning the RTP header
   // extension maps are not merged when BUNDLE is enabled. This is fine because
   // the ID for MID should be consistent among all the RTP transports.
-  network_thread_->Invoke<void>(RTC_FROM_HERE, [this, &header_extensions] {
-    rtp_transport_->UpdateRtpHeaderExtensionMap(header_extensions);
-  });
+  // Only the network thread uses the map, and it runs this before any later
+  // Invoke() from the worker thread, so there is no need to block on it.
+  invoker_.AsyncInvoke<void>(
+      RTC_FROM_HERE, network_thread_, [this, header_extensions] {
+        if (rtp_transport_)
+          rtp_transport_->UpdateRtpHeaderExtensionMap(header_extensions);
+      });
 }
 
 bool BaseChannel::RegisterRtpDemuxerSink() {
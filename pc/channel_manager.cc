@@ -189,6 +189,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
     webrtc::RtpTransportInternal* rtp_transport,
     const webrtc::MediaTransportConfig& media_transport_config,
     rtc::Thread* signaling_thread,
+    rtc::Thread* network_thread,
     const std::string& content_name,
     bool srtp_required,
     const webrtc::CryptoOptions& crypto_options,
@@ -198,8 +199,8 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
     return worker_thread_->Invoke<VoiceChannel*>(RTC_FROM_HERE, [&] {
       return CreateVoiceChannel(call, media_config, rtp_transport,
                                 media_transport_config, signaling_thread,
-                                content_name, srtp_required, crypto_options,
-                                ssrc_generator, options);
+                                network_thread, content_name, srtp_required,
+                                crypto_options, ssrc_generator, options);
     });
   }
 
@@ -217,7 +218,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
   }
 
   auto voice_channel = std::make_unique<VoiceChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options, ssrc_generator);
 
@@ -259,6 +260,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
     webrtc::RtpTransportInternal* rtp_transport,
     const webrtc::MediaTransportConfig& media_transport_config,
     rtc::Thread* signaling_thread,
+    rtc::Thread* network_thread,
     const std::string& content_name,
     bool srtp_required,
     const webrtc::CryptoOptions& crypto_options,
@@ -269,8 +271,9 @@ VideoChannel* ChannelManager::CreateVideoChannel(
     return worker_thread_->Invoke<VideoChannel*>(RTC_FROM_HERE, [&] {
       return CreateVideoChannel(
           call, media_config, rtp_transport, media_transport_config,
-          signaling_thread, content_name, srtp_required, crypto_options,
-          ssrc_generator, options, video_bitrate_allocator_factory);
+          signaling_thread, network_thread, content_name, srtp_required,
+          crypto_options, ssrc_generator, options,
+          video_bitrate_allocator_factory);
     });
   }
 
@@ -289,7 +292,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
   }
 
   auto video_channel = std::make_unique<VideoChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options, ssrc_generator);
 
@@ -329,6 +332,7 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel(
     const cricket::MediaConfig& media_config,
     webrtc::RtpTransportInternal* rtp_transport,
     rtc::Thread* signaling_thread,
+    rtc::Thread* network_thread,
     const std::string& content_name,
     bool srtp_required,
     const webrtc::CryptoOptions& crypto_options,
@@ -336,8 +340,8 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel(
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<RtpDataChannel*>(RTC_FROM_HERE, [&] {
       return CreateRtpDataChannel(media_config, rtp_transport, signaling_thread,
-                                  content_name, srtp_required, crypto_options,
-                                  ssrc_generator);
+                                  network_thread, content_name, srtp_required,
+                                  crypto_options, ssrc_generator);
     });
   }
 
@@ -350,7 +354,7 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel(
   }
 
   auto data_channel = std::make_unique<RtpDataChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options, ssrc_generator);
 
@@ -94,7 +94,9 @@ class ChannelManager final {
 
   // The operations below all occur on the worker thread.
   // ChannelManager retains ownership of the created channels, so clients should
-  // call the appropriate Destroy*Channel method when done.
+  // call the appropriate Destroy*Channel method when done. The channels run
+  // their transport on |network_thread|, which is not necessarily the
+  // network_thread() of the ChannelManager.
 
   // Creates a voice channel, to be associated with the specified session.
   VoiceChannel* CreateVoiceChannel(
@@ -103,6 +105,7 @@ class ChannelManager final {
       webrtc::RtpTransportInternal* rtp_transport,
       const webrtc::MediaTransportConfig& media_transport_config,
       rtc::Thread* signaling_thread,
+      rtc::Thread* network_thread,
       const std::string& content_name,
       bool srtp_required,
       const webrtc::CryptoOptions& crypto_options,
@@ -120,6 +123,7 @@ class ChannelManager final {
       webrtc::RtpTransportInternal* rtp_transport,
       const webrtc::MediaTransportConfig& media_transport_config,
       rtc::Thread* signaling_thread,
+      rtc::Thread* network_thread,
       const std::string& content_name,
       bool srtp_required,
       const webrtc::CryptoOptions& crypto_options,
@@ -133,6 +137,7 @@ class ChannelManager final {
       const cricket::MediaConfig& media_config,
       webrtc::RtpTransportInternal* rtp_transport,
       rtc::Thread* signaling_thread,
+      rtc::Thread* network_thread,
       const std::string& content_name,
       bool srtp_required,
       const webrtc::CryptoOptions& crypto_options,
@@ -193,6 +193,8 @@ void DataChannelController::OnTransportClosed() {
 void DataChannelController::SetupDataChannelTransport_n() {
   RTC_DCHECK_RUN_ON(network_thread());
   data_channel_transport_invoker_ = std::make_unique<rtc::AsyncInvoker>();
+  if (data_channel_transport() && send_rate_limit_bps_)
+    data_channel_transport()->SetSendRateLimit(send_rate_limit_bps_);
 }
 
 void DataChannelController::TeardownDataChannelTransport_n() {
@@ -215,6 +217,8 @@ void DataChannelController::OnTransportChanged(
     set_data_channel_transport(new_data_channel_transport);
     if (new_data_channel_transport) {
       new_data_channel_transport->SetDataSink(this);
+      if (send_rate_limit_bps_)
+        new_data_channel_transport->SetSendRateLimit(send_rate_limit_bps_);
 
       // There's a new data channel transport.  This needs to be signaled to the
       // |sctp_data_channels_| so that they can reopen and reconnect.  This is
@@ -230,6 +234,14 @@ void DataChannelController::OnTransportChanged(
   }
 }
 
+void DataChannelController::SetSendRateLimit_n(
+    absl::optional<int> bitrate_bps) {
+  RTC_DCHECK_RUN_ON(network_thread());
+  send_rate_limit_bps_ = bitrate_bps;
+  if (data_channel_transport())
+    data_channel_transport()->SetSendRateLimit(bitrate_bps);
+}
+
 bool DataChannelController::HandleOpenMessage_s(
     const cricket::ReceiveDataParams& params,
     const rtc::CopyOnWriteBuffer& buffer) {
@@ -64,6 +64,10 @@ class DataChannelController : public DataChannelProviderInterface,
   void OnTransportChanged(
       DataChannelTransportInterface* data_channel_transport);
 
+  // Limits the send rate of the data channel transport, including transports
+  // set up later. See DataChannelTransportInterface::SetSendRateLimit().
+  void SetSendRateLimit_n(absl::optional<int> bitrate_bps);
+
   // Creates channel and adds it to the collection of DataChannels that will
   // be offered in a SessionDescription.
   rtc::scoped_refptr<DataChannel> InternalCreateDataChannel(
@@ -167,6 +171,8 @@ class DataChannelController : public DataChannelProviderInterface,
   // thread.
   DataChannelTransportInterface* data_channel_transport_ = nullptr;
 
+  absl::optional<int> send_rate_limit_bps_ RTC_GUARDED_BY(network_thread());
+
   // Cached value of whether the data channel transport is ready to send.
   bool data_channel_transport_ready_to_send_
       RTC_GUARDED_BY(signaling_thread()) = false;
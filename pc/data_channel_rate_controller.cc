@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/data_channel_rate_controller.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+
+namespace webrtc {
+
+DataChannelRateController::DataChannelRateController(
+    BitrateAllocatorInterface* bitrate_allocator,
+    rtc::TaskQueue* worker_queue,
+    rtc::Thread* network_thread,
+    double bitrate_priority,
+    std::function<void(absl::optional<int>)> on_rate_updated)
+    : bitrate_allocator_(bitrate_allocator),
+      worker_queue_(worker_queue),
+      network_thread_(network_thread),
+      on_rate_updated_(std::move(on_rate_updated)) {
+  RTC_DCHECK(bitrate_allocator_);
+  RTC_DCHECK_GT(bitrate_priority, 0);
+  // No min or priority rate, so that media is never paused for data channels.
+  MediaStreamAllocationConfig config;
+  config.min_bitrate_bps = 0;
+  config.max_bitrate_bps = kMaxBitrateBps;
+  config.pad_up_bitrate_bps = 0;
+  config.priority_bitrate_bps = 0;
+  config.enforce_min_bitrate = false;
+  config.bitrate_priority = bitrate_priority;
+  worker_queue_->PostTask([this, config] {
+    RTC_DCHECK_RUN_ON(worker_queue_);
+    bitrate_allocator_->AddObserver(this, config);
+  });
+}
+
+DataChannelRateController::~DataChannelRateController() {
+  rtc::Event thread_sync_event;
+  worker_queue_->PostTask([this, &thread_sync_event] {
+    RTC_DCHECK_RUN_ON(worker_queue_);
+    bitrate_allocator_->RemoveObserver(this);
+    thread_sync_event.Set();
+  });
+  thread_sync_event.Wait(rtc::Event::kForever);
+}
+
+uint32_t DataChannelRateController::OnBitrateUpdated(
+    BitrateAllocationUpdate update) {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  absl::optional<int> bitrate_bps;
+  if (update.target_bitrate > DataRate::Zero())
+    bitrate_bps = update.target_bitrate.bps<int>();
+  invoker_.AsyncInvoke<void>(RTC_FROM_HERE, network_thread_,
+                             [this, bitrate_bps] {
+                               RTC_DCHECK_RUN_ON(network_thread_);
+                               on_rate_updated_(bitrate_bps);
+                             });
+  return 0;
+}
+
+}  // namespace webrtc
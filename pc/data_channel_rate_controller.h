@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_DATA_CHANNEL_RATE_CONTROLLER_H_
+#define PC_DATA_CHANNEL_RATE_CONTROLLER_H_
+
+#include <stdint.h>
+
+#include <functional>
+
+#include "absl/types/optional.h"
+#include "call/bitrate_allocator.h"
+#include "rtc_base/async_invoker.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+
+// Takes a share of the target rate of a call for data channels, so that data
+// channels only use the capacity that media leaves them. The share is
+// allocated next to the media streams in proportion to |bitrate_priority|
+// and passed to |on_rate_updated| on |network_thread|. It is unset while the
+// call has no target rate, for example when no media is sent, which leaves
+// data channels to the congestion control of SCTP alone.
+class DataChannelRateController : public BitrateAllocatorObserver {
+ public:
+  // Data channels are allocated up to this rate.
+  static constexpr uint32_t kMaxBitrateBps = 20000000;
+
+  // |bitrate_allocator| is used on |worker_queue|, and both have to outlive
+  // the controller. Blocks on |worker_queue| when destroyed.
+  DataChannelRateController(
+      BitrateAllocatorInterface* bitrate_allocator,
+      rtc::TaskQueue* worker_queue,
+      rtc::Thread* network_thread,
+      double bitrate_priority,
+      std::function<void(absl::optional<int>)> on_rate_updated);
+  ~DataChannelRateController() override;
+
+  // Implements BitrateAllocatorObserver.
+  uint32_t OnBitrateUpdated(BitrateAllocationUpdate update) override;
+
+ private:
+  BitrateAllocatorInterface* const bitrate_allocator_;
+  rtc::TaskQueue* const worker_queue_;
+  rtc::Thread* const network_thread_;
+  const std::function<void(absl::optional<int>)> on_rate_updated_;
+  rtc::AsyncInvoker invoker_;
+};
+
+}  // namespace webrtc
+
+#endif  // PC_DATA_CHANNEL_RATE_CONTROLLER_H_
@@ -487,6 +487,7 @@ JsepTransportController::CreateDtlsTransport(
 
   RTC_DCHECK(dtls);
   dtls->SetSslMaxProtocolVersion(config_.ssl_max_version);
+  dtls->SetSslSessionCache(config_.ssl_session_cache);
   dtls->ice_transport()->SetIceRole(ice_role_);
   dtls->ice_transport()->SetIceTiebreaker(ice_tiebreaker_);
   dtls->ice_transport()->SetIceConfig(ice_config_);
@@ -1221,6 +1222,11 @@ RTCError JsepTransportController::MaybeCreateJsepTransport(
   if (config_.sctp_factory) {
     sctp_transport =
         config_.sctp_factory->CreateSctpTransport(rtp_dtls_transport.get());
+    if (config_.sctp_send_buffer_size > 0 ||
+        config_.sctp_receive_buffer_size > 0) {
+      sctp_transport->SetBufferSizes(config_.sctp_send_buffer_size,
+                                     config_.sctp_receive_buffer_size);
+    }
   }
 
   DataChannelTransportInterface* data_channel_transport = nullptr;
@@ -80,6 +80,8 @@ class JsepTransportController : public sigslot::has_slots<> {
     // restart.
     bool redetermine_role_on_ice_restart = true;
     rtc::SSLProtocolVersion ssl_max_version = rtc::SSL_PROTOCOL_DTLS_12;
+    // Optional cache the DTLS transports resume sessions from.
+    rtc::SSLSessionCache* ssl_session_cache = nullptr;
     // |crypto_options| is used to determine if created DTLS transports
     // negotiate GCM crypto suites or not.
     webrtc::CryptoOptions crypto_options;
@@ -103,6 +105,9 @@ class JsepTransportController : public sigslot::has_slots<> {
 
     // Factory for SCTP transports.
     cricket::SctpTransportInternalFactory* sctp_factory = nullptr;
+    // Buffer sizes of the SCTP transports created, 0 for the defaults.
+    int sctp_send_buffer_size = 0;
+    int sctp_receive_buffer_size = 0;
 
     // Whether an RtpMediaTransport should be created as default, when no
     // MediaTransportFactory is provided.
@@ -11,6 +11,7 @@
 #include "pc/peer_connection.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <queue>
@@ -892,6 +893,13 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
     absl::optional<int> ice_unwritable_min_checks;
     absl::optional<int> ice_inactive_timeout;
     absl::optional<int> stun_candidate_keepalive_interval;
+    bool parallel_candidate_gathering;
+    bool aggressive_ice_nomination;
+    cricket::CandidatePairHistory* candidate_pair_history;
+    rtc::SSLSessionCache* ssl_session_cache;
+    absl::optional<int> sctp_send_buffer_size;
+    absl::optional<int> sctp_receive_buffer_size;
+    absl::optional<double> data_channel_bitrate_priority;
     webrtc::TurnCustomizer* turn_customizer;
     SdpSemantics sdp_semantics;
     absl::optional<rtc::AdapterType> network_preference;
@@ -959,6 +967,13 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
          ice_inactive_timeout == o.ice_inactive_timeout &&
          stun_candidate_keepalive_interval ==
              o.stun_candidate_keepalive_interval &&
+         parallel_candidate_gathering == o.parallel_candidate_gathering &&
+         aggressive_ice_nomination == o.aggressive_ice_nomination &&
+         candidate_pair_history == o.candidate_pair_history &&
+         ssl_session_cache == o.ssl_session_cache &&
+         sctp_send_buffer_size == o.sctp_send_buffer_size &&
+         sctp_receive_buffer_size == o.sctp_receive_buffer_size &&
+         data_channel_bitrate_priority == o.data_channel_bitrate_priority &&
          turn_customizer == o.turn_customizer &&
          sdp_semantics == o.sdp_semantics &&
          network_preference == o.network_preference &&
@@ -1032,9 +1047,11 @@ void ExtractSharedMediaSessionOptions(
 }
 
 PeerConnection::PeerConnection(PeerConnectionFactory* factory,
+                               rtc::Thread* network_thread,
                                std::unique_ptr<RtcEventLog> event_log,
                                std::unique_ptr<Call> call)
     : factory_(factory),
+      network_thread_(network_thread),
       event_log_(std::move(event_log)),
       event_log_ptr_(event_log_.get()),
       operations_chain_(rtc::OperationsChain::Create()),
@@ -1088,6 +1105,7 @@ PeerConnection::~PeerConnection() {
   // call_ and event_log_ must be destroyed on the worker thread.
   worker_thread()->Invoke<void>(RTC_FROM_HERE, [this] {
     RTC_DCHECK_RUN_ON(worker_thread());
+    data_channel_rate_controller_.reset();
     call_.reset();
     // The event log must outlive call (and any other object that uses it).
     event_log_.reset();
@@ -1212,6 +1230,11 @@ bool PeerConnection::Initialize(
   config.redetermine_role_on_ice_restart =
       configuration.redetermine_role_on_ice_restart;
   config.ssl_max_version = factory_->options().ssl_max_version;
+  config.ssl_session_cache = configuration.ssl_session_cache;
+  config.sctp_send_buffer_size =
+      configuration.sctp_send_buffer_size.value_or(0);
+  config.sctp_receive_buffer_size =
+      configuration.sctp_receive_buffer_size.value_or(0);
   config.disable_encryption = options.disable_encryption;
   config.bundle_policy = configuration.bundle_policy;
   config.rtcp_mux_policy = configuration.rtcp_mux_policy;
@@ -1293,7 +1316,8 @@ bool PeerConnection::Initialize(
     }
   }
 
-  sctp_factory_ = factory_->CreateSctpTransportInternalFactory();
+  sctp_factory_ =
+      factory_->CreateSctpTransportInternalFactory(network_thread());
 
   if (use_datagram_transport_for_data_channels_) {
     if (configuration.enable_rtp_data_channel) {
@@ -1349,6 +1373,24 @@ bool PeerConnection::Initialize(
   transport_controller_->SignalIceCandidatePairChanged.connect(
       this, &PeerConnection::OnTransportControllerCandidateChanged);
 
+  if (configuration.data_channel_bitrate_priority) {
+    worker_thread()->Invoke<void>(RTC_FROM_HERE, [this, &configuration] {
+      RTC_DCHECK_RUN_ON(worker_thread());
+      BitrateAllocatorInterface* bitrate_allocator =
+          call_ ? call_->GetBitrateAllocator() : nullptr;
+      if (!bitrate_allocator)
+        return;
+      data_channel_rate_controller_ =
+          std::make_unique<DataChannelRateController>(
+              bitrate_allocator,
+              call_->GetTransportControllerSend()->GetWorkerQueue(),
+              network_thread(), *configuration.data_channel_bitrate_priority,
+              [this](absl::optional<int> bitrate_bps) {
+                data_channel_controller_.SetSendRateLimit_n(bitrate_bps);
+              });
+    });
+  }
+
   stats_.reset(new StatsCollector(this));
   stats_collector_ = RTCStatsCollector::Create(this);
 
@@ -1424,6 +1466,12 @@ bool PeerConnection::Initialize(
 
 RTCError PeerConnection::ValidateConfiguration(
     const RTCConfiguration& config) const {
+  if (config.data_channel_bitrate_priority &&
+      !(std::isnormal(*config.data_channel_bitrate_priority) &&
+        *config.data_channel_bitrate_priority > 0)) {
+    return RTCError(RTCErrorType::INVALID_RANGE,
+                    "data_channel_bitrate_priority must be positive.");
+  }
   return cricket::P2PTransportChannel::ValidateIceConfig(
       ParseIceConfig(config));
 }
@@ -4466,6 +4514,7 @@ void PeerConnection::Close() {
 
   worker_thread()->Invoke<void>(RTC_FROM_HERE, [this] {
     RTC_DCHECK_RUN_ON(worker_thread());
+    data_channel_rate_controller_.reset();
     call_.reset();
     // The event log must outlive call (and any other object that uses it).
     event_log_.reset();
@@ -5849,8 +5898,10 @@ PeerConnection::InitializePortAllocator_n(
   }
 
   port_allocator_->set_flags(port_allocator_flags);
-  // No step delay is used while allocating ports.
-  port_allocator_->set_step_delay(cricket::kMinimumStepDelay);
+  // With parallel gathering all allocation phases start at once.
+  port_allocator_->set_step_delay(configuration.parallel_candidate_gathering
+                                      ? 0
+                                      : cricket::kMinimumStepDelay);
   port_allocator_->SetCandidateFilter(
       ConvertIceTransportTypeToCandidateFilter(configuration.type));
   port_allocator_->set_max_ipv6_networks(configuration.max_ipv6_networks);
@@ -6185,6 +6236,9 @@ cricket::IceConfig PeerConnection::ParseIceConfig(
   ice_config.ice_inactive_timeout = config.ice_inactive_timeout;
   ice_config.stun_keepalive_interval = config.stun_candidate_keepalive_interval;
   ice_config.network_preference = config.network_preference;
+  if (config.aggressive_ice_nomination)
+    ice_config.default_nomination_mode = cricket::NominationMode::AGGRESSIVE;
+  ice_config.candidate_pair_history = config.candidate_pair_history;
   return ice_config;
 }
 
@@ -6617,8 +6671,8 @@ cricket::VoiceChannel* PeerConnection::CreateVoiceChannel(
 
   cricket::VoiceChannel* voice_channel = channel_manager()->CreateVoiceChannel(
       call_ptr_, configuration_.media_config, rtp_transport,
-      media_transport_config, signaling_thread(), mid, SrtpRequired(),
-      GetCryptoOptions(), &ssrc_generator_, audio_options_);
+      media_transport_config, signaling_thread(), network_thread(), mid,
+      SrtpRequired(), GetCryptoOptions(), &ssrc_generator_, audio_options_);
   if (!voice_channel) {
     return nullptr;
   }
@@ -6640,8 +6694,8 @@ cricket::VideoChannel* PeerConnection::CreateVideoChannel(
 
   cricket::VideoChannel* video_channel = channel_manager()->CreateVideoChannel(
       call_ptr_, configuration_.media_config, rtp_transport,
-      media_transport_config, signaling_thread(), mid, SrtpRequired(),
-      GetCryptoOptions(), &ssrc_generator_, video_options_,
+      media_transport_config, signaling_thread(), network_thread(), mid,
+      SrtpRequired(), GetCryptoOptions(), &ssrc_generator_, video_options_,
       video_bitrate_allocator_factory_.get());
   if (!video_channel) {
     return nullptr;
@@ -6681,7 +6735,8 @@ bool PeerConnection::CreateDataChannel(const std::string& mid) {
       data_channel_controller_.set_rtp_data_channel(
           channel_manager()->CreateRtpDataChannel(
               configuration_.media_config, rtp_transport, signaling_thread(),
-              mid, SrtpRequired(), GetCryptoOptions(), &ssrc_generator_));
+              network_thread(), mid, SrtpRequired(), GetCryptoOptions(),
+              &ssrc_generator_));
       if (!data_channel_controller_.rtp_data_channel()) {
         return false;
       }
@@ -22,6 +22,7 @@
 #include "api/transport/data_channel_transport_interface.h"
 #include "api/turn_customizer.h"
 #include "pc/data_channel_controller.h"
+#include "pc/data_channel_rate_controller.h"
 #include "pc/ice_server_parsing.h"
 #include "pc/jsep_transport_controller.h"
 #include "pc/peer_connection_factory.h"
@@ -112,9 +113,12 @@ class PeerConnection : public PeerConnectionInternal,
     MAX_VALUE = 0x80000,
   };
 
-  explicit PeerConnection(PeerConnectionFactory* factory,
-                          std::unique_ptr<RtcEventLog> event_log,
-                          std::unique_ptr<Call> call);
+  // |network_thread| is the one of the factory's network threads that this
+  // PeerConnection runs its networking on.
+  PeerConnection(PeerConnectionFactory* factory,
+                 rtc::Thread* network_thread,
+                 std::unique_ptr<RtcEventLog> event_log,
+                 std::unique_ptr<Call> call);
 
   bool Initialize(
       const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -245,9 +249,7 @@ class PeerConnection : public PeerConnectionInternal,
   void Close() override;
 
   // PeerConnectionInternal implementation.
-  rtc::Thread* network_thread() const final {
-    return factory_->network_thread();
-  }
+  rtc::Thread* network_thread() const final { return network_thread_; }
   rtc::Thread* worker_thread() const final { return factory_->worker_thread(); }
   rtc::Thread* signaling_thread() const final {
     return factory_->signaling_thread();
@@ -1183,6 +1185,7 @@ class PeerConnection : public PeerConnectionInternal,
   // PeerConnectionFactoryInterface all instances created using the raw pointer
   // will refer to the same reference count.
   const rtc::scoped_refptr<PeerConnectionFactory> factory_;
+  rtc::Thread* const network_thread_;
   PeerConnectionObserver* observer_ RTC_GUARDED_BY(signaling_thread()) =
       nullptr;
 
@@ -1287,6 +1290,11 @@ class PeerConnection : public PeerConnectionInternal,
   // pointer from any thread.
   Call* const call_ptr_;
 
+  // Limits data channels to their share of the target rate of |call_|, if
+  // RTCConfiguration::data_channel_bitrate_priority is set.
+  std::unique_ptr<DataChannelRateController> data_channel_rate_controller_
+      RTC_GUARDED_BY(worker_thread());
+
   std::unique_ptr<StatsCollector> stats_
       RTC_GUARDED_BY(signaling_thread());  // A pointer is passed to senders_
   rtc::scoped_refptr<RTCStatsCollector> stats_collector_
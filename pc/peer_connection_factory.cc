@@ -74,6 +74,9 @@ PeerConnectionFactory::PeerConnectionFactory(
       worker_thread_(dependencies.worker_thread),
       signaling_thread_(dependencies.signaling_thread),
       task_queue_factory_(std::move(dependencies.task_queue_factory)),
+      additional_network_threads_(
+          std::move(dependencies.additional_network_threads)),
+      certificate_pool_size_(dependencies.certificate_pool_size),
       media_engine_(std::move(dependencies.media_engine)),
       call_factory_(std::move(dependencies.call_factory)),
       event_log_factory_(std::move(dependencies.event_log_factory)),
@@ -85,7 +88,8 @@ PeerConnectionFactory::PeerConnectionFactory(
       media_transport_factory_(std::move(dependencies.media_transport_factory)),
       neteq_factory_(std::move(dependencies.neteq_factory)),
       trials_(dependencies.trials ? std::move(dependencies.trials)
-                                  : std::make_unique<FieldTrialBasedConfig>()) {
+                                  : std::make_unique<FieldTrialBasedConfig>()),
+      alpha_cc_config_(dependencies.alpha_cc_config) {
   if (!network_thread_) {
     owned_network_thread_ = rtc::Thread::CreateWithSocketServer();
     owned_network_thread_->SetName("pc_network_thread", nullptr);
@@ -114,11 +118,12 @@ PeerConnectionFactory::PeerConnectionFactory(
 PeerConnectionFactory::~PeerConnectionFactory() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   channel_manager_.reset(nullptr);
+  // The pool stops its rotation on the signaling thread.
+  certificate_pool_.reset();
 
-  // Make sure |worker_thread_| and |signaling_thread_| outlive
-  // |default_socket_factory_| and |default_network_manager_|.
-  default_socket_factory_ = nullptr;
-  default_network_manager_ = nullptr;
+  // Make sure |worker_thread_| and |signaling_thread_| outlive the socket
+  // factories and network managers.
+  network_shards_.clear();
 
   if (wraps_current_thread_)
     rtc::ThreadManager::Instance()->UnwrapCurrentThread();
@@ -128,15 +133,18 @@ bool PeerConnectionFactory::Initialize() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   rtc::InitRandom(rtc::Time32());
 
-  default_network_manager_.reset(new rtc::BasicNetworkManager());
-  if (!default_network_manager_) {
-    return false;
-  }
-
-  default_socket_factory_.reset(
-      new rtc::BasicPacketSocketFactory(network_thread_));
-  if (!default_socket_factory_) {
-    return false;
+  std::vector<rtc::Thread*> network_threads = {network_thread_};
+  network_threads.insert(network_threads.end(),
+                         additional_network_threads_.begin(),
+                         additional_network_threads_.end());
+  for (rtc::Thread* thread : network_threads) {
+    RTC_DCHECK(thread);
+    NetworkShard shard;
+    shard.thread = thread;
+    shard.network_manager = std::make_unique<rtc::BasicNetworkManager>();
+    shard.socket_factory =
+        std::make_unique<rtc::BasicPacketSocketFactory>(thread);
+    network_shards_.push_back(std::move(shard));
   }
 
   channel_manager_ = std::make_unique<cricket::ChannelManager>(
@@ -148,6 +156,16 @@ bool PeerConnectionFactory::Initialize() {
     return false;
   }
 
+  if (certificate_pool_size_ > 0) {
+    rtc::RTCCertificatePool::Config config;
+    config.size = certificate_pool_size_;
+    certificate_pool_ = std::make_unique<rtc::RTCCertificatePool>(
+        signaling_thread_,
+        std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread_,
+                                                       network_thread_),
+        config);
+  }
+
   return true;
 }
 
@@ -246,24 +264,38 @@ PeerConnectionFactory::CreatePeerConnection(
       << "You can't set both allocator and packet_socket_factory; "
          "the former is going away (see bugs.webrtc.org/7447";
 
+  // An injected allocator or socket factory is made for |network_thread_|,
+  // so only PeerConnections using the defaults are spread over the network
+  // threads.
+  NetworkShard* shard = &network_shards_[0];
+  if (!dependencies.allocator && !dependencies.packet_socket_factory) {
+    shard = &network_shards_[next_network_shard_];
+    next_network_shard_ = (next_network_shard_ + 1) % network_shards_.size();
+  }
+  rtc::Thread* network_thread = shard->thread;
+
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
         std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread_,
-                                                       network_thread_);
+                                                       network_thread);
+    if (certificate_pool_) {
+      dependencies.cert_generator = certificate_pool_->CreateGenerator(
+          std::move(dependencies.cert_generator));
+    }
   }
   if (!dependencies.allocator) {
     rtc::PacketSocketFactory* packet_socket_factory;
     if (dependencies.packet_socket_factory)
       packet_socket_factory = dependencies.packet_socket_factory.get();
     else
-      packet_socket_factory = default_socket_factory_.get();
+      packet_socket_factory = shard->socket_factory.get();
 
-    network_thread_->Invoke<void>(RTC_FROM_HERE, [this, &configuration,
-                                                  &dependencies,
-                                                  &packet_socket_factory]() {
+    network_thread->Invoke<void>(RTC_FROM_HERE, [shard, &configuration,
+                                                 &dependencies,
+                                                 &packet_socket_factory]() {
       dependencies.allocator = std::make_unique<cricket::BasicPortAllocator>(
-          default_network_manager_.get(), packet_socket_factory,
+          shard->network_manager.get(), packet_socket_factory,
           configuration.turn_customizer);
     });
   }
@@ -278,7 +310,7 @@ PeerConnectionFactory::CreatePeerConnection(
         std::make_unique<DefaultIceTransportFactory>();
   }
 
-  network_thread_->Invoke<void>(
+  network_thread->Invoke<void>(
       RTC_FROM_HERE,
       rtc::Bind(&cricket::PortAllocator::SetNetworkIgnoreMask,
                 dependencies.allocator.get(), options_.network_ignore_mask));
@@ -293,8 +325,8 @@ PeerConnectionFactory::CreatePeerConnection(
       rtc::Bind(&PeerConnectionFactory::CreateCall_w, this, event_log.get()));
 
   rtc::scoped_refptr<PeerConnection> pc(
-      new rtc::RefCountedObject<PeerConnection>(this, std::move(event_log),
-                                                std::move(call)));
+      new rtc::RefCountedObject<PeerConnection>(
+          this, network_thread, std::move(event_log), std::move(call)));
   ActionsBeforeInitializeForTesting(pc);
   if (!pc->Initialize(configuration, std::move(dependencies))) {
     return nullptr;
@@ -327,9 +359,10 @@ rtc::scoped_refptr<AudioTrackInterface> PeerConnectionFactory::CreateAudioTrack(
 }
 
 std::unique_ptr<cricket::SctpTransportInternalFactory>
-PeerConnectionFactory::CreateSctpTransportInternalFactory() {
+PeerConnectionFactory::CreateSctpTransportInternalFactory(
+    rtc::Thread* network_thread) {
 #ifdef HAVE_SCTP
-  return std::make_unique<cricket::SctpTransportFactory>(network_thread());
+  return std::make_unique<cricket::SctpTransportFactory>(network_thread);
 #else
   return nullptr;
 #endif
@@ -392,6 +425,7 @@ std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
   }
 
   call_config.trials = trials_.get();
+  call_config.alpha_cc_config = alpha_cc_config_;
 
   return std::unique_ptr<Call>(call_factory_->CreateCall(call_config));
 }
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/media_stream_interface.h"
 #include "api/peer_connection_interface.h"
@@ -22,6 +23,7 @@
 #include "media/sctp/sctp_transport_internal.h"
 #include "pc/channel_manager.h"
 #include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/rtc_certificate_pool.h"
 #include "rtc_base/thread.h"
 
 namespace rtc {
@@ -73,7 +75,7 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   void StopAecDump() override;
 
   virtual std::unique_ptr<cricket::SctpTransportInternalFactory>
-  CreateSctpTransportInternalFactory();
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread);
 
   virtual cricket::ChannelManager* channel_manager();
 
@@ -83,6 +85,8 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
     return signaling_thread_;
   }
   rtc::Thread* worker_thread() { return worker_thread_; }
+  // The first of the network threads, which runs the networking of the
+  // PeerConnections unless more network threads were given.
   rtc::Thread* network_thread() { return network_thread_; }
 
   const Options& options() const { return options_; }
@@ -104,6 +108,14 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   virtual ~PeerConnectionFactory();
 
  private:
+  // The networking objects shared by the PeerConnections on one of the
+  // network threads.
+  struct NetworkShard {
+    rtc::Thread* thread;
+    std::unique_ptr<rtc::BasicNetworkManager> network_manager;
+    std::unique_ptr<rtc::BasicPacketSocketFactory> socket_factory;
+  };
+
   bool IsTrialEnabled(absl::string_view key) const;
 
   std::unique_ptr<RtcEventLog> CreateRtcEventLog_w();
@@ -118,8 +130,15 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
   Options options_;
   std::unique_ptr<cricket::ChannelManager> channel_manager_;
-  std::unique_ptr<rtc::BasicNetworkManager> default_network_manager_;
-  std::unique_ptr<rtc::BasicPacketSocketFactory> default_socket_factory_;
+  std::vector<rtc::Thread*> additional_network_threads_;
+  // One per network thread, starting with |network_thread_|.
+  std::vector<NetworkShard> network_shards_;
+  // The shard of the next PeerConnection.
+  size_t next_network_shard_ = 0;
+  const size_t certificate_pool_size_;
+  // Serves the certificates of the PeerConnections without a certificate
+  // generator, when |certificate_pool_size_| isn't 0.
+  std::unique_ptr<rtc::RTCCertificatePool> certificate_pool_;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine_;
   std::unique_ptr<webrtc::CallFactoryInterface> call_factory_;
   std::unique_ptr<RtcEventLogFactoryInterface> event_log_factory_;
@@ -131,6 +150,7 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   std::unique_ptr<MediaTransportFactory> media_transport_factory_;
   std::unique_ptr<NetEqFactory> neteq_factory_;
   const std::unique_ptr<WebRtcKeyValueConfig> trials_;
+  const AlphaCCConfig* const alpha_cc_config_;
 };
 
 }  // namespace webrtc
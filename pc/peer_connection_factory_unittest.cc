@@ -22,23 +22,29 @@
 #include "api/audio_codecs/audio_encoder_factory.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/call/call_factory_interface.h"
 #include "api/create_peerconnection_factory.h"
 #include "api/data_channel_interface.h"
 #include "api/jsep.h"
 #include "api/media_stream_interface.h"
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/video_codecs/builtin_video_decoder_factory.h"
 #include "api/video_codecs/builtin_video_encoder_factory.h"
 #include "api/video_codecs/video_decoder_factory.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "media/base/fake_frame_source.h"
+#include "media/base/fake_media_engine.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "p2p/base/fake_port_allocator.h"
 #include "p2p/base/port.h"
 #include "p2p/base/port_interface.h"
 #include "pc/test/fake_audio_capture_module.h"
+#include "pc/test/fake_sctp_transport.h"
 #include "pc/test/fake_video_track_source.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
 #include "test/gtest.h"
 
 #ifdef WEBRTC_ANDROID
@@ -481,3 +487,71 @@ TEST_F(PeerConnectionFactoryTest, LocalRendering) {
   EXPECT_EQ(3, local_renderer.num_rendered_frames());
   EXPECT_FALSE(local_renderer.black_frame());
 }
+
+// Records the network thread of each PeerConnection, which it creates its
+// SCTP transport factory for.
+class PeerConnectionFactoryWithNetworkThreads
+    : public webrtc::PeerConnectionFactory {
+ public:
+  explicit PeerConnectionFactoryWithNetworkThreads(
+      std::vector<rtc::Thread*> additional_network_threads)
+      : webrtc::PeerConnectionFactory([&] {
+          webrtc::PeerConnectionFactoryDependencies dependencies;
+          dependencies.network_thread = rtc::Thread::Current();
+          dependencies.worker_thread = rtc::Thread::Current();
+          dependencies.signaling_thread = rtc::Thread::Current();
+          dependencies.additional_network_threads =
+              std::move(additional_network_threads);
+          dependencies.task_queue_factory =
+              webrtc::CreateDefaultTaskQueueFactory();
+          dependencies.media_engine =
+              std::make_unique<cricket::FakeMediaEngine>();
+          dependencies.call_factory = webrtc::CreateCallFactory();
+          return dependencies;
+        }()) {}
+
+  std::unique_ptr<cricket::SctpTransportInternalFactory>
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread) override {
+    network_threads_.push_back(network_thread);
+    return std::make_unique<FakeSctpTransportFactory>();
+  }
+
+  std::vector<rtc::Thread*> network_threads_;
+};
+
+TEST(PeerConnectionFactoryNetworkThreadsTest,
+     AssignsPeerConnectionsToNetworkThreadsInTurn) {
+  std::unique_ptr<rtc::Thread> network_thread =
+      rtc::Thread::CreateWithSocketServer();
+  network_thread->Start();
+  rtc::scoped_refptr<PeerConnectionFactoryWithNetworkThreads> factory(
+      new rtc::RefCountedObject<PeerConnectionFactoryWithNetworkThreads>(
+          std::vector<rtc::Thread*>{network_thread.get()}));
+  ASSERT_TRUE(factory->Initialize());
+
+  NullPeerConnectionObserver observer;
+  std::vector<rtc::scoped_refptr<PeerConnectionInterface>> pcs;
+  for (int i = 0; i < 3; ++i) {
+    webrtc::PeerConnectionDependencies dependencies(&observer);
+    dependencies.cert_generator =
+        std::make_unique<FakeRTCCertificateGenerator>();
+    pcs.push_back(factory->CreatePeerConnection(
+        PeerConnectionInterface::RTCConfiguration(), std::move(dependencies)));
+    ASSERT_TRUE(pcs.back());
+  }
+  EXPECT_EQ(factory->network_threads_,
+            std::vector<rtc::Thread*>({rtc::Thread::Current(),
+                                       network_thread.get(),
+                                       rtc::Thread::Current()}));
+
+  // PeerConnections with an injected port allocator stay on the first
+  // network thread, which the allocator is made for.
+  webrtc::PeerConnectionDependencies dependencies(&observer);
+  dependencies.allocator = std::make_unique<cricket::FakePortAllocator>(
+      rtc::Thread::Current(), nullptr);
+  dependencies.cert_generator = std::make_unique<FakeRTCCertificateGenerator>();
+  pcs.push_back(factory->CreatePeerConnection(
+      PeerConnectionInterface::RTCConfiguration(), std::move(dependencies)));
+  ASSERT_TRUE(pcs.back());
+  EXPECT_EQ(rtc::Thread::Current(), factory->network_threads_.back());
+}
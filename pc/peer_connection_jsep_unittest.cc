@@ -61,7 +61,7 @@ class PeerConnectionFactoryForJsepTest : public PeerConnectionFactory {
         }()) {}
 
   std::unique_ptr<cricket::SctpTransportInternalFactory>
-  CreateSctpTransportInternalFactory() {
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread) {
     return std::make_unique<FakeSctpTransportFactory>();
   }
 };
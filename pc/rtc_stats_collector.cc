@@ -10,6 +10,7 @@
 
 #include "pc/rtc_stats_collector.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -926,6 +927,29 @@ rtc::scoped_refptr<RTCStatsReport> CreateReportFilteredBySelector(
   return TakeReferencedStats(report->Copy(), rtpstream_ids);
 }
 
+// Returns |report| itself if it only has stats of |stats_types|, and otherwise
+// a report with copies of these stats.
+rtc::scoped_refptr<const RTCStatsReport> CreateReportFilteredByStatsTypes(
+    rtc::scoped_refptr<const RTCStatsReport> report,
+    const std::set<std::string>& stats_types) {
+  bool has_other_stats = false;
+  for (const RTCStats& stats : *report) {
+    if (!stats_types.count(stats.type())) {
+      has_other_stats = true;
+      break;
+    }
+  }
+  if (!has_other_stats)
+    return report;
+  rtc::scoped_refptr<RTCStatsReport> filtered_report =
+      RTCStatsReport::Create(report->timestamp_us());
+  for (const RTCStats& stats : *report) {
+    if (stats_types.count(stats.type()))
+      filtered_report->AddStats(stats.copy());
+  }
+  return filtered_report;
+}
+
 }  // namespace
 
 RTCStatsCollector::RequestInfo::RequestInfo(
@@ -948,6 +972,16 @@ RTCStatsCollector::RequestInfo::RequestInfo(
                   nullptr,
                   std::move(selector)) {}
 
+RTCStatsCollector::RequestInfo::RequestInfo(
+    std::set<std::string> stats_types,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback)
+    : RequestInfo(FilterMode::kStatsTypes,
+                  std::move(callback),
+                  nullptr,
+                  nullptr) {
+  stats_types_ = std::move(stats_types);
+}
+
 RTCStatsCollector::RequestInfo::RequestInfo(
     RTCStatsCollector::RequestInfo::FilterMode filter_mode,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback,
@@ -961,6 +995,15 @@ RTCStatsCollector::RequestInfo::RequestInfo(
   RTC_DCHECK(!sender_selector_ || !receiver_selector_);
 }
 
+bool RTCStatsCollector::RequestInfo::IsSatisfiedBy(
+    const absl::optional<std::set<std::string>>& stats_types) const {
+  if (!stats_types)
+    return true;
+  return filter_mode_ == FilterMode::kStatsTypes &&
+         std::includes(stats_types->begin(), stats_types->end(),
+                       stats_types_.begin(), stats_types_.end());
+}
+
 rtc::scoped_refptr<RTCStatsCollector> RTCStatsCollector::Create(
     PeerConnectionInternal* pc,
     int64_t cache_lifetime_us) {
@@ -1011,72 +1054,128 @@ void RTCStatsCollector::GetStatsReport(
   GetStatsReportInternal(RequestInfo(std::move(selector), std::move(callback)));
 }
 
+void RTCStatsCollector::GetStatsReport(
+    std::set<std::string> stats_types,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  GetStatsReportInternal(
+      RequestInfo(std::move(stats_types), std::move(callback)));
+}
+
 void RTCStatsCollector::GetStatsReportInternal(
     RTCStatsCollector::RequestInfo request) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  requests_.push_back(std::move(request));
 
   // "Now" using a monotonically increasing timer.
   int64_t cache_now_us = rtc::TimeMicros();
   if (cached_report_ &&
-      cache_now_us - cache_timestamp_us_ <= cache_lifetime_us_) {
+      cache_now_us - cache_timestamp_us_ <= cache_lifetime_us_ &&
+      request.IsSatisfiedBy(cached_report_stats_types_)) {
     // We have a fresh cached report to deliver. Deliver asynchronously, since
     // the caller may not be expecting a synchronous callback, and it avoids
     // reentrancy problems.
     std::vector<RequestInfo> requests;
-    requests.swap(requests_);
+    requests.push_back(std::move(request));
     signaling_thread_->PostTask(
         RTC_FROM_HERE, rtc::Bind(&RTCStatsCollector::DeliverCachedReport, this,
                                  cached_report_, std::move(requests)));
-  } else if (!num_pending_partial_reports_) {
-    // Only start gathering stats if we're not already gathering stats. In the
-    // case of already gathering stats, |callback_| will be invoked when there
-    // are no more pending partial reports.
-
-    // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
-    // UTC), in microseconds. The system clock could be modified and is not
-    // necessarily monotonically increasing.
-    int64_t timestamp_us = rtc::TimeUTCMicros();
-
-    num_pending_partial_reports_ = 2;
-    partial_report_timestamp_us_ = cache_now_us;
-
-    // Prepare |transceiver_stats_infos_| for use in
-    // |ProducePartialResultsOnNetworkThread| and
-    // |ProducePartialResultsOnSignalingThread|.
+    return;
+  }
+  requests_.push_back(std::move(request));
+  // Only start gathering stats if we're not already gathering stats. In the
+  // case of already gathering stats, |callback_| will be invoked when there
+  // are no more pending partial reports.
+  if (!num_pending_partial_reports_)
+    GatherStats_s(cache_now_us);
+}
+
+void RTCStatsCollector::GatherStats_s(int64_t cache_now_us) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  RTC_DCHECK(!requests_.empty());
+  RTC_DCHECK_EQ(num_pending_partial_reports_, 0);
+
+  // Gather the stats of all the types the requests ask for.
+  gathered_stats_types_.emplace();
+  for (const RequestInfo& request : requests_) {
+    if (request.filter_mode() != RequestInfo::FilterMode::kStatsTypes) {
+      gathered_stats_types_ = absl::nullopt;
+      break;
+    }
+    gathered_stats_types_->insert(request.stats_types().begin(),
+                                  request.stats_types().end());
+  }
+
+  // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
+  // UTC), in microseconds. The system clock could be modified and is not
+  // necessarily monotonically increasing.
+  int64_t timestamp_us = rtc::TimeUTCMicros();
+
+  num_pending_partial_reports_ = 2;
+  partial_report_timestamp_us_ = cache_now_us;
+
+  // Prepare |transceiver_stats_infos_| for use in
+  // |ProducePartialResultsOnNetworkThread| and
+  // |ProducePartialResultsOnSignalingThread|. This hops to the worker thread,
+  // so it is skipped if none of the stats that need it are gathered.
+  if (IsGathered({RTCCodecStats::kType, RTCMediaStreamStats::kType,
+                  RTCMediaStreamTrackStats::kType, RTCAudioSourceStats::kType,
+                  RTCVideoSourceStats::kType, RTCInboundRTPStreamStats::kType,
+                  RTCOutboundRTPStreamStats::kType,
+                  RTCRemoteInboundRtpStreamStats::kType})) {
     transceiver_stats_infos_ = PrepareTransceiverStatsInfos_s();
-    // Prepare |transport_names_| for use in
-    // |ProducePartialResultsOnNetworkThread|.
+  }
+  // Prepare |transport_names_| for use in
+  // |ProducePartialResultsOnNetworkThread|. Only the transport related stats
+  // need the stats of the transports.
+  const bool gathers_transport_stats =
+      IsGathered({RTCCertificateStats::kType, RTCIceCandidatePairStats::kType,
+                  RTCLocalIceCandidateStats::kType,
+                  RTCRemoteIceCandidateStats::kType, RTCTransportStats::kType});
+  transport_names_.clear();
+  if (gathers_transport_stats)
     transport_names_ = PrepareTransportNames_s();
 
-    // Prepare |call_stats_| here since GetCallStats() will hop to the worker
-    // thread.
-    // TODO(holmer): To avoid the hop we could move BWE and BWE stats to the
-    // network thread, where it more naturally belongs.
+  // Prepare |call_stats_| here since GetCallStats() will hop to the worker
+  // thread.
+  // TODO(holmer): To avoid the hop we could move BWE and BWE stats to the
+  // network thread, where it more naturally belongs.
+  if (gathers_transport_stats)
     call_stats_ = pc_->GetCallStats();
 
-    // Don't touch |network_report_| on the signaling thread until
-    // ProducePartialResultsOnNetworkThread() has signaled the
-    // |network_report_event_|.
-    network_report_event_.Reset();
-    network_thread_->PostTask(
-        RTC_FROM_HERE,
-        rtc::Bind(&RTCStatsCollector::ProducePartialResultsOnNetworkThread,
-                  this, timestamp_us));
-    ProducePartialResultsOnSignalingThread(timestamp_us);
-  }
+  // Don't touch |network_report_| on the signaling thread until
+  // ProducePartialResultsOnNetworkThread() has signaled the
+  // |network_report_event_|.
+  network_report_event_.Reset();
+  network_thread_->PostTask(
+      RTC_FROM_HERE,
+      rtc::Bind(&RTCStatsCollector::ProducePartialResultsOnNetworkThread, this,
+                timestamp_us));
+  ProducePartialResultsOnSignalingThread(timestamp_us);
+}
+
+bool RTCStatsCollector::IsGathered(
+    std::initializer_list<const char*> stats_types) const {
+  if (!gathered_stats_types_)
+    return true;
+  return std::any_of(stats_types.begin(), stats_types.end(),
+                     [this](const char* stats_type) {
+                       return gathered_stats_types_->count(stats_type) > 0;
+                     });
 }
 
 void RTCStatsCollector::ClearCachedStatsReport() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   cached_report_ = nullptr;
+  cached_report_stats_types_ = absl::nullopt;
 }
 
 void RTCStatsCollector::WaitForPendingRequest() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   // If a request is pending, blocks until the |network_report_event_| is
-  // signaled and then delivers the result. Otherwise this is a NO-OP.
-  MergeNetworkReport_s();
+  // signaled and then delivers the result. Otherwise this is a NO-OP. Merging
+  // starts gathering again if there are requests for stats that were not
+  // gathered, which are waited for as well.
+  while (num_pending_partial_reports_)
+    MergeNetworkReport_s();
 }
 
 void RTCStatsCollector::ProducePartialResultsOnSignalingThread(
@@ -1099,11 +1198,16 @@ void RTCStatsCollector::ProducePartialResultsOnSignalingThreadImpl(
     int64_t timestamp_us,
     RTCStatsReport* partial_report) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  ProduceDataChannelStats_s(timestamp_us, partial_report);
-  ProduceMediaStreamStats_s(timestamp_us, partial_report);
-  ProduceMediaStreamTrackStats_s(timestamp_us, partial_report);
-  ProduceMediaSourceStats_s(timestamp_us, partial_report);
-  ProducePeerConnectionStats_s(timestamp_us, partial_report);
+  if (IsGathered({RTCDataChannelStats::kType}))
+    ProduceDataChannelStats_s(timestamp_us, partial_report);
+  if (IsGathered({RTCMediaStreamStats::kType}))
+    ProduceMediaStreamStats_s(timestamp_us, partial_report);
+  if (IsGathered({RTCMediaStreamTrackStats::kType}))
+    ProduceMediaStreamTrackStats_s(timestamp_us, partial_report);
+  if (IsGathered({RTCAudioSourceStats::kType, RTCVideoSourceStats::kType}))
+    ProduceMediaSourceStats_s(timestamp_us, partial_report);
+  if (IsGathered({RTCPeerConnectionStats::kType}))
+    ProducePeerConnectionStats_s(timestamp_us, partial_report);
 }
 
 void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
@@ -1136,14 +1240,28 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThreadImpl(
     const std::map<std::string, CertificateStatsPair>& transport_cert_stats,
     RTCStatsReport* partial_report) {
   RTC_DCHECK(network_thread_->IsCurrent());
-  ProduceCertificateStats_n(timestamp_us, transport_cert_stats, partial_report);
-  ProduceCodecStats_n(timestamp_us, transceiver_stats_infos_, partial_report);
-  ProduceIceCandidateAndPairStats_n(timestamp_us, transport_stats_by_name,
-                                    call_stats_, partial_report);
-  ProduceTransportStats_n(timestamp_us, transport_stats_by_name,
-                          transport_cert_stats, partial_report);
-  ProduceRTPStreamStats_n(timestamp_us, transceiver_stats_infos_,
-                          partial_report);
+  if (IsGathered({RTCCertificateStats::kType})) {
+    ProduceCertificateStats_n(timestamp_us, transport_cert_stats,
+                              partial_report);
+  }
+  if (IsGathered({RTCCodecStats::kType}))
+    ProduceCodecStats_n(timestamp_us, transceiver_stats_infos_, partial_report);
+  if (IsGathered({RTCIceCandidatePairStats::kType,
+                  RTCLocalIceCandidateStats::kType,
+                  RTCRemoteIceCandidateStats::kType})) {
+    ProduceIceCandidateAndPairStats_n(timestamp_us, transport_stats_by_name,
+                                      call_stats_, partial_report);
+  }
+  if (IsGathered({RTCTransportStats::kType})) {
+    ProduceTransportStats_n(timestamp_us, transport_stats_by_name,
+                            transport_cert_stats, partial_report);
+  }
+  if (IsGathered({RTCInboundRTPStreamStats::kType,
+                  RTCOutboundRTPStreamStats::kType,
+                  RTCRemoteInboundRtpStreamStats::kType})) {
+    ProduceRTPStreamStats_n(timestamp_us, transceiver_stats_infos_,
+                            partial_report);
+  }
 }
 
 void RTCStatsCollector::MergeNetworkReport_s() {
@@ -1173,6 +1291,8 @@ void RTCStatsCollector::MergeNetworkReport_s() {
   RTC_DCHECK_EQ(num_pending_partial_reports_, 0);
   cache_timestamp_us_ = partial_report_timestamp_us_;
   cached_report_ = partial_report_;
+  cached_report_stats_types_ = std::move(gathered_stats_types_);
+  gathered_stats_types_ = absl::nullopt;
   partial_report_ = nullptr;
   transceiver_stats_infos_.clear();
   // Trace WebRTC Stats when getStats is called on Javascript.
@@ -1181,9 +1301,21 @@ void RTCStatsCollector::MergeNetworkReport_s() {
   TRACE_EVENT_INSTANT1("webrtc_stats", "webrtc_stats", "report",
                        cached_report_->ToJson());
 
-  // Deliver report and clear |requests_|.
+  // Deliver report to the requests it has the stats of and remove them from
+  // |requests_|. Requests that came in while gathering may ask for stats that
+  // were not gathered, and start the next gathering. It is started before the
+  // callbacks run, in case they request stats again.
   std::vector<RequestInfo> requests;
-  requests.swap(requests_);
+  std::vector<RequestInfo> unsatisfied_requests;
+  for (RequestInfo& request : requests_) {
+    if (request.IsSatisfiedBy(cached_report_stats_types_))
+      requests.push_back(std::move(request));
+    else
+      unsatisfied_requests.push_back(std::move(request));
+  }
+  requests_ = std::move(unsatisfied_requests);
+  if (!requests_.empty())
+    GatherStats_s(rtc::TimeMicros());
   DeliverCachedReport(cached_report_, std::move(requests));
 }
 
@@ -1197,6 +1329,10 @@ void RTCStatsCollector::DeliverCachedReport(
   for (const RequestInfo& request : requests) {
     if (request.filter_mode() == RequestInfo::FilterMode::kAll) {
       request.callback()->OnStatsDelivered(cached_report);
+    } else if (request.filter_mode() ==
+               RequestInfo::FilterMode::kStatsTypes) {
+      request.callback()->OnStatsDelivered(CreateReportFilteredByStatsTypes(
+          cached_report, request.stats_types()));
     } else {
       bool filter_by_sender_selector;
       rtc::scoped_refptr<RtpSenderInternal> sender_selector;
@@ -1793,6 +1929,53 @@ void RTCStatsCollector::ProduceTransportStats_n(
         transport_stats->srtp_cipher =
             rtc::SrtpCryptoSuiteToName(channel_stats.srtp_crypto_suite);
       }
+      // The receive side estimator runs once per call, like the bandwidth
+      // estimates of the candidate pairs.
+      if (channel_stats.component != cricket::ICE_CANDIDATE_COMPONENT_RTCP &&
+          call_stats_.bwe_estimates > 0) {
+        transport_stats->bwe_estimates = call_stats_.bwe_estimates;
+        transport_stats->bwe_dropped_packets = call_stats_.bwe_dropped_packets;
+        if (call_stats_.bwe_inference_time_p50_us >= 0) {
+          transport_stats->bwe_inference_time_p50 =
+              call_stats_.bwe_inference_time_p50_us /
+              static_cast<double>(rtc::kNumMicrosecsPerSec);
+          transport_stats->bwe_inference_time_p99 =
+              call_stats_.bwe_inference_time_p99_us /
+              static_cast<double>(rtc::kNumMicrosecsPerSec);
+        }
+        if (call_stats_.bwe_pending_packets_p50 >= 0) {
+          transport_stats->bwe_pending_packets_p50 =
+              static_cast<uint32_t>(call_stats_.bwe_pending_packets_p50);
+          transport_stats->bwe_pending_packets_p99 =
+              static_cast<uint32_t>(call_stats_.bwe_pending_packets_p99);
+        }
+        transport_stats->bwe_estimate =
+            static_cast<double>(call_stats_.bwe_estimate_bps);
+        transport_stats->bwe_model_ready = call_stats_.bwe_estimator_ready;
+        if (!call_stats_.bwe_model_version.empty()) {
+          transport_stats->bwe_model_version = call_stats_.bwe_model_version;
+        }
+      }
+      if (channel_stats.component != cricket::ICE_CANDIDATE_COMPONENT_RTCP &&
+          call_stats_.bwe_feedback_target_bps >= 0) {
+        transport_stats->bwe_remote_estimate =
+            static_cast<double>(call_stats_.bwe_feedback_target_bps);
+        transport_stats->bwe_remote_estimate_age =
+            call_stats_.bwe_feedback_age_ms /
+            static_cast<double>(rtc::kNumMillisecsPerSec);
+        if (call_stats_.bwe_feedback_interval_ms >= 0) {
+          transport_stats->bwe_remote_estimate_interval =
+              call_stats_.bwe_feedback_interval_ms /
+              static_cast<double>(rtc::kNumMillisecsPerSec);
+        }
+        transport_stats->bwe_target_bitrate =
+            static_cast<double>(call_stats_.send_bandwidth_bps);
+      }
+      if (channel_stats.component != cricket::ICE_CANDIDATE_COMPONENT_RTCP &&
+          call_stats_.bwe_shadow_gcc_target_bps >= 0) {
+        transport_stats->bwe_shadow_gcc_estimate =
+            static_cast<double>(call_stats_.bwe_shadow_gcc_target_bps);
+      }
       report->AddStats(std::move(transport_stats));
     }
   }
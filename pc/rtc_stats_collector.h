@@ -11,6 +11,7 @@
 #ifndef PC_RTC_STATS_COLLECTOR_H_
 #define PC_RTC_STATS_COLLECTOR_H_
 
+#include <initializer_list>
 #include <map>
 #include <memory>
 #include <set>
@@ -65,6 +66,13 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // as: no RTP streams are received by selector). The result is empty.
   void GetStatsReport(rtc::scoped_refptr<RtpReceiverInternal> selector,
                       rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Gets a report with only the stats of |stats_types|, which are the |kType|
+  // of RTCStats subclasses, e.g. RTCTransportStats::kType. A fresh cached
+  // report is used if it has these types. Otherwise only these types are
+  // gathered, which skips the worker thread hops they don't need, so polling
+  // a few types of stats costs less than polling full reports.
+  void GetStatsReport(std::set<std::string> stats_types,
+                      rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
   // Clears the cache's reference to the most recent stats report. Subsequently
   // calling |GetStatsReport| guarantees fresh stats.
   void ClearCachedStatsReport();
@@ -96,7 +104,12 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
  private:
   class RequestInfo {
    public:
-    enum class FilterMode { kAll, kSenderSelector, kReceiverSelector };
+    enum class FilterMode {
+      kAll,
+      kSenderSelector,
+      kReceiverSelector,
+      kStatsTypes
+    };
 
     // Constructs with FilterMode::kAll.
     explicit RequestInfo(
@@ -109,6 +122,14 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     // applied even if |selector| is null, resulting in an empty report.
     RequestInfo(rtc::scoped_refptr<RtpReceiverInternal> selector,
                 rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+    // Constructs with FilterMode::kStatsTypes.
+    RequestInfo(std::set<std::string> stats_types,
+                rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+
+    // Returns true if a report with the stats of |stats_types|, or with all
+    // stats if it is null, has the stats of this request.
+    bool IsSatisfiedBy(
+        const absl::optional<std::set<std::string>>& stats_types) const;
 
     FilterMode filter_mode() const { return filter_mode_; }
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback() const {
@@ -122,6 +143,10 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
       RTC_DCHECK(filter_mode_ == FilterMode::kReceiverSelector);
       return receiver_selector_;
     }
+    const std::set<std::string>& stats_types() const {
+      RTC_DCHECK(filter_mode_ == FilterMode::kStatsTypes);
+      return stats_types_;
+    }
 
    private:
     RequestInfo(FilterMode filter_mode,
@@ -133,9 +158,14 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback_;
     rtc::scoped_refptr<RtpSenderInternal> sender_selector_;
     rtc::scoped_refptr<RtpReceiverInternal> receiver_selector_;
+    std::set<std::string> stats_types_;
   };
 
   void GetStatsReportInternal(RequestInfo request);
+  // Starts gathering the stats of |requests_|.
+  void GatherStats_s(int64_t cache_now_us);
+  // Returns true if any of |stats_types| is gathered by the pending request.
+  bool IsGathered(std::initializer_list<const char*> stats_types) const;
 
   // Structure for tracking stats about each RtpTransceiver managed by the
   // PeerConnection. This can either by a Plan B style or Unified Plan style
@@ -260,6 +290,9 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // set/reset we know there are no pending stats requests in progress.
   std::vector<RtpTransceiverStatsInfo> transceiver_stats_infos_;
   std::set<std::string> transport_names_;
+  // The types of stats the pending request gathers, or null if it gathers all
+  // of them. Set and reset like |transceiver_stats_infos_|.
+  absl::optional<std::set<std::string>> gathered_stats_types_;
 
   Call::Stats call_stats_;
 
@@ -270,6 +303,8 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   int64_t cache_timestamp_us_;
   int64_t cache_lifetime_us_;
   rtc::scoped_refptr<const RTCStatsReport> cached_report_;
+  // The types of stats in |cached_report_|, or null if it has all of them.
+  absl::optional<std::set<std::string>> cached_report_stats_types_;
 
   // Data recorded and maintained by the stats collector during its lifetime.
   // Some stats are produced from this record instead of other components.
@@ -16,6 +16,7 @@
 #include <initializer_list>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -391,6 +392,13 @@ class RTCStatsCollectorWrapper {
     return WaitForReport(callback);
   }
 
+  rtc::scoped_refptr<const RTCStatsReport> GetStatsReportWithStatsTypes(
+      std::set<std::string> stats_types) {
+    rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
+    stats_collector_->GetStatsReport(std::move(stats_types), callback);
+    return WaitForReport(callback);
+  }
+
   rtc::scoped_refptr<const RTCStatsReport> GetFreshStatsReport() {
     stats_collector_->ClearCachedStatsReport();
     return GetStatsReport();
@@ -762,6 +770,51 @@ TEST_F(RTCStatsCollectorTest, CachedStatsReports) {
   EXPECT_NE(c.get(), d.get());
 }
 
+TEST_F(RTCStatsCollectorTest, GetsOnlyTheStatsOfTheRequestedTypes) {
+  pc_->AddSctpDataChannel(new MockDataChannel(
+      0, "MockDataChannel0", DataChannelInterface::kOpen, "udp", 1, 2, 3, 4));
+
+  rtc::scoped_refptr<const RTCStatsReport> data_channel_report =
+      stats_->GetStatsReportWithStatsTypes({RTCDataChannelStats::kType});
+  EXPECT_EQ(data_channel_report->size(), 1u);
+  EXPECT_EQ(data_channel_report->GetStatsOfType<RTCDataChannelStats>().size(),
+            1u);
+
+  // The cached report doesn't have all stats, so they are gathered.
+  rtc::scoped_refptr<const RTCStatsReport> full_report =
+      stats_->GetStatsReport();
+  EXPECT_TRUE(full_report->Get("RTCPeerConnection"));
+  EXPECT_EQ(full_report->GetStatsOfType<RTCDataChannelStats>().size(), 1u);
+
+  // The cached full report has them.
+  rtc::scoped_refptr<const RTCStatsReport> peer_connection_report =
+      stats_->GetStatsReportWithStatsTypes({RTCPeerConnectionStats::kType});
+  EXPECT_EQ(peer_connection_report->size(), 1u);
+  EXPECT_TRUE(peer_connection_report->Get("RTCPeerConnection"));
+  EXPECT_EQ(peer_connection_report->timestamp_us(),
+            full_report->timestamp_us());
+}
+
+TEST_F(RTCStatsCollectorTest, RequestsForStatsNotBeingGatheredAreGatheredNext) {
+  pc_->AddSctpDataChannel(new MockDataChannel(
+      0, "MockDataChannel0", DataChannelInterface::kOpen, "udp", 1, 2, 3, 4));
+
+  rtc::scoped_refptr<const RTCStatsReport> a, b, c;
+  stats_->stats_collector()->GetStatsReport({RTCPeerConnectionStats::kType},
+                                            RTCStatsObtainer::Create(&a));
+  stats_->stats_collector()->GetStatsReport({RTCDataChannelStats::kType},
+                                            RTCStatsObtainer::Create(&b));
+  stats_->stats_collector()->GetStatsReport({RTCPeerConnectionStats::kType},
+                                            RTCStatsObtainer::Create(&c));
+  EXPECT_TRUE_WAIT(a && b && c, kGetStatsReportTimeoutMs);
+  // |a| and |c| are delivered the same report, which was gathered for them.
+  EXPECT_EQ(a.get(), c.get());
+  EXPECT_EQ(a->size(), 1u);
+  EXPECT_TRUE(a->Get("RTCPeerConnection"));
+  EXPECT_EQ(b->size(), 1u);
+  EXPECT_EQ(b->GetStatsOfType<RTCDataChannelStats>().size(), 1u);
+}
+
 TEST_F(RTCStatsCollectorTest, MultipleCallbacksWithInvalidatedCacheInBetween) {
   rtc::scoped_refptr<const RTCStatsReport> a, b, c;
   stats_->stats_collector()->GetStatsReport(RTCStatsObtainer::Create(&a));
@@ -2317,6 +2370,123 @@ TEST_F(RTCStatsCollectorTest, CollectRTCTransportStatsWithCrypto) {
       report->Get(expected_rtp_transport.id())->cast_to<RTCTransportStats>());
 }
 
+TEST_F(RTCStatsCollectorTest, CollectRTCTransportStatsWithBweEstimator) {
+  const char kTransportName[] = "transport";
+
+  pc_->AddVoiceChannel("audio", kTransportName);
+
+  cricket::TransportChannelStats rtp_transport_channel_stats;
+  rtp_transport_channel_stats.component = cricket::ICE_CANDIDATE_COMPONENT_RTP;
+  rtp_transport_channel_stats.dtls_state = cricket::DTLS_TRANSPORT_NEW;
+  cricket::TransportChannelStats rtcp_transport_channel_stats;
+  rtcp_transport_channel_stats.component =
+      cricket::ICE_CANDIDATE_COMPONENT_RTCP;
+  rtcp_transport_channel_stats.dtls_state = cricket::DTLS_TRANSPORT_NEW;
+  pc_->SetTransportStats(kTransportName, {rtp_transport_channel_stats,
+                                          rtcp_transport_channel_stats});
+
+  Call::Stats call_stats;
+  call_stats.bwe_estimates = 42;
+  call_stats.bwe_dropped_packets = 3;
+  call_stats.bwe_inference_time_p50_us = 250;
+  call_stats.bwe_inference_time_p99_us = 2000;
+  call_stats.bwe_pending_packets_p50 = 10;
+  call_stats.bwe_pending_packets_p99 = 80;
+  call_stats.bwe_estimate_bps = 1200000;
+  call_stats.bwe_estimator_ready = true;
+  call_stats.bwe_model_version = "v2";
+  pc_->SetCallStats(call_stats);
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+
+  const RTCStats* rtp_stats = report->Get(
+      "RTCTransport_transport_" +
+      rtc::ToString(cricket::ICE_CANDIDATE_COMPONENT_RTP));
+  ASSERT_TRUE(rtp_stats);
+  const RTCTransportStats& rtp_transport =
+      rtp_stats->cast_to<RTCTransportStats>();
+  EXPECT_EQ(*rtp_transport.bwe_estimates, 42u);
+  EXPECT_EQ(*rtp_transport.bwe_dropped_packets, 3u);
+  EXPECT_DOUBLE_EQ(*rtp_transport.bwe_inference_time_p50, 0.00025);
+  EXPECT_DOUBLE_EQ(*rtp_transport.bwe_inference_time_p99, 0.002);
+  EXPECT_EQ(*rtp_transport.bwe_pending_packets_p50, 10u);
+  EXPECT_EQ(*rtp_transport.bwe_pending_packets_p99, 80u);
+  EXPECT_DOUBLE_EQ(*rtp_transport.bwe_estimate, 1200000);
+  EXPECT_TRUE(*rtp_transport.bwe_model_ready);
+  EXPECT_EQ(*rtp_transport.bwe_model_version, "v2");
+  EXPECT_FALSE(rtp_transport.bwe_remote_estimate.is_defined());
+
+  // The estimator is not repeated on the RTCP transport.
+  const RTCStats* rtcp_stats = report->Get(
+      "RTCTransport_transport_" +
+      rtc::ToString(cricket::ICE_CANDIDATE_COMPONENT_RTCP));
+  ASSERT_TRUE(rtcp_stats);
+  EXPECT_FALSE(
+      rtcp_stats->cast_to<RTCTransportStats>().bwe_estimates.is_defined());
+}
+
+TEST_F(RTCStatsCollectorTest, CollectRTCTransportStatsWithBweFeedback) {
+  const char kTransportName[] = "transport";
+
+  pc_->AddVoiceChannel("audio", kTransportName);
+
+  cricket::TransportChannelStats rtp_transport_channel_stats;
+  rtp_transport_channel_stats.component = cricket::ICE_CANDIDATE_COMPONENT_RTP;
+  rtp_transport_channel_stats.dtls_state = cricket::DTLS_TRANSPORT_NEW;
+  pc_->SetTransportStats(kTransportName, rtp_transport_channel_stats);
+
+  Call::Stats call_stats;
+  call_stats.send_bandwidth_bps = 900000;
+  call_stats.bwe_feedback_target_bps = 1000000;
+  call_stats.bwe_feedback_age_ms = 40;
+  call_stats.bwe_feedback_interval_ms = 200;
+  pc_->SetCallStats(call_stats);
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+
+  const RTCStats* rtp_stats = report->Get(
+      "RTCTransport_transport_" +
+      rtc::ToString(cricket::ICE_CANDIDATE_COMPONENT_RTP));
+  ASSERT_TRUE(rtp_stats);
+  const RTCTransportStats& rtp_transport =
+      rtp_stats->cast_to<RTCTransportStats>();
+  EXPECT_DOUBLE_EQ(*rtp_transport.bwe_remote_estimate, 1000000);
+  EXPECT_DOUBLE_EQ(*rtp_transport.bwe_remote_estimate_age, 0.04);
+  EXPECT_DOUBLE_EQ(*rtp_transport.bwe_remote_estimate_interval, 0.2);
+  EXPECT_DOUBLE_EQ(*rtp_transport.bwe_target_bitrate, 900000);
+  // No receive side estimator runs in this call.
+  EXPECT_FALSE(rtp_transport.bwe_estimates.is_defined());
+  EXPECT_FALSE(rtp_transport.bwe_model_ready.is_defined());
+  // GCC doesn't run in the shadow in this call.
+  EXPECT_FALSE(rtp_transport.bwe_shadow_gcc_estimate.is_defined());
+}
+
+TEST_F(RTCStatsCollectorTest, CollectRTCTransportStatsWithShadowGcc) {
+  const char kTransportName[] = "transport";
+
+  pc_->AddVoiceChannel("audio", kTransportName);
+
+  cricket::TransportChannelStats rtp_transport_channel_stats;
+  rtp_transport_channel_stats.component = cricket::ICE_CANDIDATE_COMPONENT_RTP;
+  rtp_transport_channel_stats.dtls_state = cricket::DTLS_TRANSPORT_NEW;
+  pc_->SetTransportStats(kTransportName, rtp_transport_channel_stats);
+
+  Call::Stats call_stats;
+  call_stats.bwe_shadow_gcc_target_bps = 700000;
+  pc_->SetCallStats(call_stats);
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+
+  const RTCStats* rtp_stats = report->Get(
+      "RTCTransport_transport_" +
+      rtc::ToString(cricket::ICE_CANDIDATE_COMPONENT_RTP));
+  ASSERT_TRUE(rtp_stats);
+  const RTCTransportStats& rtp_transport =
+      rtp_stats->cast_to<RTCTransportStats>();
+  EXPECT_DOUBLE_EQ(*rtp_transport.bwe_shadow_gcc_estimate, 700000);
+  EXPECT_FALSE(rtp_transport.bwe_remote_estimate.is_defined());
+}
+
 TEST_F(RTCStatsCollectorTest, CollectNoStreamRTCOutboundRTPStreamStats_Audio) {
   cricket::VoiceMediaInfo voice_media_info;
 
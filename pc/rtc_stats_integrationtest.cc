@@ -1032,6 +1032,23 @@ class RTCStatsReportVerifier {
     verifier.TestMemberIsDefined(transport.srtp_cipher);
     verifier.TestMemberIsPositive<uint32_t>(
         transport.selected_candidate_pair_changes);
+    // Only defined while the AlphaCC receive side estimator runs.
+    verifier.MarkMemberTested(transport.bwe_estimates, true);
+    verifier.MarkMemberTested(transport.bwe_dropped_packets, true);
+    verifier.MarkMemberTested(transport.bwe_inference_time_p50, true);
+    verifier.MarkMemberTested(transport.bwe_inference_time_p99, true);
+    verifier.MarkMemberTested(transport.bwe_pending_packets_p50, true);
+    verifier.MarkMemberTested(transport.bwe_pending_packets_p99, true);
+    verifier.MarkMemberTested(transport.bwe_estimate, true);
+    verifier.MarkMemberTested(transport.bwe_model_ready, true);
+    verifier.MarkMemberTested(transport.bwe_model_version, true);
+    // Only defined once the remote AlphaCC receive side sent an estimate.
+    verifier.MarkMemberTested(transport.bwe_remote_estimate, true);
+    verifier.MarkMemberTested(transport.bwe_remote_estimate_age, true);
+    verifier.MarkMemberTested(transport.bwe_remote_estimate_interval, true);
+    verifier.MarkMemberTested(transport.bwe_target_bitrate, true);
+    // Only defined in the calls sampled by bwe_shadow_gcc_percent.
+    verifier.MarkMemberTested(transport.bwe_shadow_gcc_estimate, true);
     return verifier.ExpectAllMembersSuccessfullyTested();
   }
 
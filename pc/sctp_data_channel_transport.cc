@@ -9,9 +9,23 @@
  */
 
 #include "pc/sctp_data_channel_transport.h"
+
+#include <algorithm>
+
 #include "pc/sctp_utils.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 
 namespace webrtc {
+namespace {
+
+// Budget that builds up while data channels send less than the rate limit.
+constexpr int64_t kMaxSendBurstMs = 100;
+// Interval at which a transport blocked by the rate limit checks whether it
+// may send again, so that it also follows changes of the limit in time.
+constexpr int kSendBudgetCheckIntervalMs = 10;
+
+}  // namespace
 
 SctpDataChannelTransport::SctpDataChannelTransport(
     cricket::SctpTransportInternal* sctp_transport)
@@ -47,6 +61,15 @@ RTCError SctpDataChannelTransport::SendData(
   sd_params.max_rtx_count = params.max_rtx_count.value_or(-1);
   sd_params.max_rtx_ms = params.max_rtx_ms.value_or(-1);
 
+  if (send_rate_limit_bps_) {
+    UpdateSendBudget();
+    if (send_budget_bytes_ < 0) {
+      ready_to_send_ = false;
+      ScheduleSendBudgetCheck();
+      return RTCError(RTCErrorType::RESOURCE_EXHAUSTED);
+    }
+  }
+
   cricket::SendDataResult result;
   sctp_transport_->SendData(sd_params, buffer, &result);
 
@@ -54,6 +77,8 @@ RTCError SctpDataChannelTransport::SendData(
   // SendDataResult to RTCError and back again.
   switch (result) {
     case cricket::SendDataResult::SDR_SUCCESS:
+      if (send_rate_limit_bps_)
+        send_budget_bytes_ -= buffer.size();
       return RTCError::OK();
     case cricket::SendDataResult::SDR_BLOCK: {
       // Send buffer is full.
@@ -82,6 +107,50 @@ bool SctpDataChannelTransport::IsReadyToSend() const {
   return ready_to_send_;
 }
 
+void SctpDataChannelTransport::SetSendRateLimit(
+    absl::optional<int> bitrate_bps) {
+  if (bitrate_bps == send_rate_limit_bps_)
+    return;
+  if (!send_rate_limit_bps_)
+    send_budget_bytes_ = 0;
+  UpdateSendBudget();
+  send_rate_limit_bps_ = bitrate_bps;
+}
+
+void SctpDataChannelTransport::UpdateSendBudget() {
+  const int64_t now_ms = rtc::TimeMillis();
+  if (send_rate_limit_bps_) {
+    const int64_t elapsed_ms = now_ms - send_budget_updated_ms_;
+    send_budget_bytes_ = std::min(
+        send_budget_bytes_ + *send_rate_limit_bps_ * elapsed_ms / 8000,
+        *send_rate_limit_bps_ * kMaxSendBurstMs / 8000);
+  }
+  send_budget_updated_ms_ = now_ms;
+}
+
+void SctpDataChannelTransport::ScheduleSendBudgetCheck() {
+  if (send_budget_check_pending_)
+    return;
+  send_budget_check_pending_ = true;
+  invoker_.AsyncInvokeDelayed<void>(
+      RTC_FROM_HERE, rtc::Thread::Current(),
+      [this] { OnSendBudgetCheck(); }, kSendBudgetCheckIntervalMs);
+}
+
+void SctpDataChannelTransport::OnSendBudgetCheck() {
+  send_budget_check_pending_ = false;
+  if (send_rate_limit_bps_) {
+    UpdateSendBudget();
+    if (send_budget_bytes_ < 0) {
+      ScheduleSendBudgetCheck();
+      return;
+    }
+  }
+  // If SCTP is blocked as well, it signals when it can send again.
+  if (!ready_to_send_ && sctp_transport_->ReadyToSendData())
+    OnReadyToSendData();
+}
+
 void SctpDataChannelTransport::OnReadyToSendData() {
   ready_to_send_ = true;
   if (sink_) {
@@ -13,6 +13,7 @@
 
 #include "api/transport/data_channel_transport_interface.h"
 #include "media/sctp/sctp_transport_internal.h"
+#include "rtc_base/async_invoker.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
 namespace webrtc {
@@ -31,8 +32,13 @@ class SctpDataChannelTransport : public DataChannelTransportInterface,
   RTCError CloseChannel(int channel_id) override;
   void SetDataSink(DataChannelSink* sink) override;
   bool IsReadyToSend() const override;
+  void SetSendRateLimit(absl::optional<int> bitrate_bps) override;
 
  private:
+  // Adds the budget earned at the send rate limit since the last update.
+  void UpdateSendBudget();
+  void ScheduleSendBudgetCheck();
+  void OnSendBudgetCheck();
   void OnReadyToSendData();
   void OnDataReceived(const cricket::ReceiveDataParams& params,
                       const rtc::CopyOnWriteBuffer& buffer);
@@ -44,6 +50,14 @@ class SctpDataChannelTransport : public DataChannelTransportInterface,
 
   DataChannelSink* sink_ = nullptr;
   bool ready_to_send_ = false;
+
+  // Bytes that may be sent under |send_rate_limit_bps_|. Whole messages are
+  // sent while it isn't negative, so it goes into debt by up to a message.
+  absl::optional<int> send_rate_limit_bps_;
+  int64_t send_budget_bytes_ = 0;
+  int64_t send_budget_updated_ms_ = 0;
+  bool send_budget_check_pending_ = false;
+  rtc::AsyncInvoker invoker_;
 };
 
 }  // namespace webrtc
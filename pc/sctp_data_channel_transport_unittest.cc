@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/sctp_data_channel_transport.h"
+
+#include "pc/test/fake_sctp_transport.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/gunit.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kChannelId = 1;
+// 10 bytes per millisecond.
+constexpr int kRateLimitBps = 80000;
+
+class FakeDataChannelSink : public DataChannelSink {
+ public:
+  void OnDataReceived(int channel_id,
+                      DataMessageType type,
+                      const rtc::CopyOnWriteBuffer& buffer) override {}
+  void OnChannelClosing(int channel_id) override {}
+  void OnChannelClosed(int channel_id) override {}
+  void OnReadyToSend() override { ++ready_to_send_count_; }
+
+  int ready_to_send_count() const { return ready_to_send_count_; }
+
+ private:
+  int ready_to_send_count_ = 0;
+};
+
+class SctpDataChannelTransportTest : public ::testing::Test {
+ protected:
+  SctpDataChannelTransportTest() : transport_(&sctp_transport_) {
+    transport_.SetDataSink(&sink_);
+    sctp_transport_.SignalReadyToSendData();
+  }
+
+  RTCError Send(size_t size) {
+    return transport_.SendData(kChannelId, SendDataParams(),
+                               rtc::CopyOnWriteBuffer(size));
+  }
+
+  rtc::ScopedFakeClock clock_;
+  FakeSctpTransport sctp_transport_;
+  FakeDataChannelSink sink_;
+  SctpDataChannelTransport transport_;
+};
+
+TEST_F(SctpDataChannelTransportTest, SendsWithoutRateLimit) {
+  for (int i = 0; i < 10; ++i)
+    EXPECT_TRUE(Send(100000).ok());
+  EXPECT_TRUE(transport_.IsReadyToSend());
+}
+
+TEST_F(SctpDataChannelTransportTest, BlocksOverRateLimitUntilBudgetRefills) {
+  transport_.SetSendRateLimit(kRateLimitBps);
+  EXPECT_TRUE(Send(1000).ok());
+  EXPECT_EQ(Send(1000).type(), RTCErrorType::RESOURCE_EXHAUSTED);
+  EXPECT_FALSE(transport_.IsReadyToSend());
+  const int ready_to_send_count = sink_.ready_to_send_count();
+
+  // The first message took 100 ms of budget.
+  clock_.AdvanceTime(TimeDelta::Millis(90));
+  EXPECT_EQ(sink_.ready_to_send_count(), ready_to_send_count);
+  EXPECT_TRUE_SIMULATED_WAIT(
+      sink_.ready_to_send_count() == ready_to_send_count + 1, 30, clock_);
+  EXPECT_TRUE(transport_.IsReadyToSend());
+  EXPECT_TRUE(Send(1000).ok());
+}
+
+TEST_F(SctpDataChannelTransportTest, BuildsUpOnlyABurstOfBudget) {
+  transport_.SetSendRateLimit(kRateLimitBps);
+  clock_.AdvanceTime(TimeDelta::Seconds(10));
+  // 100 ms of budget, and a message is sent as long as it isn't overdrawn.
+  for (int i = 0; i < 6; ++i)
+    EXPECT_TRUE(Send(200).ok());
+  EXPECT_EQ(Send(200).type(), RTCErrorType::RESOURCE_EXHAUSTED);
+}
+
+TEST_F(SctpDataChannelTransportTest, UnblocksWhenRateLimitIsRemoved) {
+  transport_.SetSendRateLimit(kRateLimitBps / 1000);
+  EXPECT_TRUE(Send(100000).ok());
+  EXPECT_EQ(Send(1000).type(), RTCErrorType::RESOURCE_EXHAUSTED);
+  const int ready_to_send_count = sink_.ready_to_send_count();
+
+  transport_.SetSendRateLimit(absl::nullopt);
+  EXPECT_TRUE_SIMULATED_WAIT(
+      sink_.ready_to_send_count() == ready_to_send_count + 1, 20, clock_);
+  EXPECT_TRUE(Send(1000).ok());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -106,6 +106,39 @@ bool SrtpSession::ProtectRtp(void* p,
   return (index) ? GetSendStreamPacketIndex(p, in_len, index) : true;
 }
 
+size_t SrtpSession::ProtectRtpPackets(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer* const> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect SRTP packets: no SRTP Session";
+    return 0;
+  }
+
+  for (size_t i = 0; i < packets.size(); ++i) {
+    rtc::CopyOnWriteBuffer* packet = packets[i];
+    size_t need_len = packet->size() + rtp_auth_tag_len_;
+    if (packet->capacity() < need_len) {
+      RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet: The buffer length "
+                          << packet->capacity() << " is less than the needed "
+                          << need_len;
+      return i;
+    }
+    int len = static_cast<int>(packet->size());
+    int err = srtp_protect(session_, packet->data(), &len);
+    if (err != srtp_err_status_ok) {
+      int seq_num;
+      GetRtpSeqNum(packet->cdata(), packet->size(), &seq_num);
+      RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet, seqnum="
+                          << seq_num << ", err=" << err
+                          << ", last seqnum=" << last_send_seq_num_;
+      return i;
+    }
+    packet->SetSize(len);
+    GetRtpSeqNum(packet->cdata(), packet->size(), &last_send_seq_num_);
+  }
+  return packets.size();
+}
+
 bool SrtpSession::ProtectRtcp(void* p, int in_len, int max_len, int* out_len) {
   RTC_DCHECK(thread_checker_.IsCurrent());
   if (!session_) {
@@ -11,9 +11,13 @@
 #ifndef PC_SRTP_SESSION_H_
 #define PC_SRTP_SESSION_H_
 
+#include <stddef.h>
+
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/scoped_refptr.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/thread_checker.h"
 
 // Forward declaration to avoid pulling in libsrtp headers here
@@ -64,6 +68,12 @@ class SrtpSession {
                   int max_len,
                   int* out_len,
                   int64_t* index);
+  // Encrypts/signs a batch of RTP packets in place, in order, and stops at the
+  // first packet that fails. Each buffer must have capacity for the
+  // authentication tag, and is resized to the protected length. Returns the
+  // number of packets protected.
+  size_t ProtectRtpPackets(
+      rtc::ArrayView<rtc::CopyOnWriteBuffer* const> packets);
   bool ProtectRtcp(void* data, int in_len, int max_len, int* out_len);
   // Decrypts/verifies an invidiual RTP/RTCP packet.
   // If an HMAC is used, this will decrease the packet size.
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "pc/srtp_session.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/ssl_stream_adapter.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace cricket {
+namespace {
+
+constexpr size_t kPacketSize = 1200;
+constexpr size_t kBatchSize = 16;
+constexpr int kBatches = 5000;
+// Room for the longest authentication tag, the one of AES-GCM.
+constexpr size_t kMaxAuthTagSize = 16;
+
+const uint8_t kKey[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqr";
+constexpr size_t kAesCmKeyLength = 30;
+constexpr size_t kAesGcm128KeyLength = 28;
+constexpr size_t kAesGcm256KeyLength = 44;
+
+// Returns the average time in nanoseconds to protect one full size packet, out
+// of batches of |kBatchSize| packets, either one packet per call or a batch
+// per call.
+double MeasureProtectTimeNs(int crypto_suite,
+                            size_t key_length,
+                            bool batched) {
+  SrtpSession session;
+  EXPECT_TRUE(session.SetSend(crypto_suite, kKey, key_length, {}));
+
+  std::vector<uint8_t> rtp_packet(kPacketSize, 0xa5);
+  rtp_packet[0] = 0x80;
+  rtp_packet[1] = 96;
+  rtc::SetBE32(&rtp_packet[8], 0x12345678);
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  for (size_t i = 0; i < kBatchSize; ++i)
+    packets.emplace_back(0, kPacketSize + kMaxAuthTagSize);
+  std::vector<rtc::CopyOnWriteBuffer*> buffers;
+  for (rtc::CopyOnWriteBuffer& packet : packets)
+    buffers.push_back(&packet);
+
+  uint16_t sequence_number = 0;
+  int64_t protect_time_ns = 0;
+  for (int batch = 0; batch < kBatches; ++batch) {
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      rtc::SetBE16(&rtp_packet[2], sequence_number++);
+      packet.SetData(rtp_packet.data(), rtp_packet.size());
+    }
+    int64_t start_ns = rtc::TimeNanos();
+    if (batched) {
+      EXPECT_EQ(kBatchSize, session.ProtectRtpPackets(buffers));
+    } else {
+      for (rtc::CopyOnWriteBuffer& packet : packets) {
+        int length = 0;
+        EXPECT_TRUE(session.ProtectRtp(packet.data(), kPacketSize,
+                                       packet.capacity(), &length));
+      }
+    }
+    protect_time_ns += rtc::TimeNanos() - start_ns;
+  }
+  return static_cast<double>(protect_time_ns) / (kBatches * kBatchSize);
+}
+
+TEST(SrtpSessionPerformanceTest, ProtectTime) {
+  struct CryptoSuite {
+    int suite;
+    size_t key_length;
+    const char* name;
+  };
+  const CryptoSuite kCryptoSuites[] = {
+      {rtc::SRTP_AES128_CM_SHA1_80, kAesCmKeyLength, "aes_cm_128_sha1_80"},
+      {rtc::SRTP_AEAD_AES_128_GCM, kAesGcm128KeyLength, "aead_aes_128_gcm"},
+      {rtc::SRTP_AEAD_AES_256_GCM, kAesGcm256KeyLength, "aead_aes_256_gcm"},
+  };
+  for (const CryptoSuite& suite : kCryptoSuites) {
+    double single_ns =
+        MeasureProtectTimeNs(suite.suite, suite.key_length, false);
+    double batched_ns =
+        MeasureProtectTimeNs(suite.suite, suite.key_length, true);
+    webrtc::test::PrintResult("srtp_protect_time", "_single", suite.name,
+                              single_ns, "ns", false);
+    webrtc::test::PrintResult("srtp_protect_time", "_batched", suite.name,
+                              batched_ns, "ns", false);
+    webrtc::test::PrintResult("srtp_protect_throughput", "_batched",
+                              suite.name, kPacketSize * 8 / batched_ns, "Gbps",
+                              false);
+  }
+}
+
+}  // namespace
+}  // namespace cricket
@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include <string>
+#include <vector>
 
 #include "media/base/fake_rtp.h"
 #include "pc/test/srtp_test_util.h"
@@ -247,4 +248,47 @@ TEST_F(SrtpSessionTest, TestReplay) {
       s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
 }
 
+TEST_F(SrtpSessionTest, TestProtectRtpPackets) {
+  EXPECT_TRUE(s1_.SetSend(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  std::vector<CopyOnWriteBuffer> packets;
+  for (uint16_t seqnum = 1; seqnum <= 3; ++seqnum) {
+    packets.emplace_back(kPcmuFrame, rtp_len_, rtp_len_ + 10);
+    SetBE16(packets.back().data() + 2, seqnum);
+  }
+  std::vector<CopyOnWriteBuffer*> buffers;
+  for (CopyOnWriteBuffer& packet : packets)
+    buffers.push_back(&packet);
+
+  EXPECT_EQ(3u, s1_.ProtectRtpPackets(buffers));
+  for (CopyOnWriteBuffer& packet : packets) {
+    ASSERT_EQ(static_cast<size_t>(rtp_len_ + 10), packet.size());
+    int out_len = 0;
+    EXPECT_TRUE(s2_.UnprotectRtp(packet.data(), static_cast<int>(packet.size()),
+                                 &out_len));
+    EXPECT_EQ(rtp_len_, out_len);
+    EXPECT_EQ(0, memcmp(packet.cdata() + 12, kPcmuFrame + 12, out_len - 12));
+  }
+}
+
+TEST_F(SrtpSessionTest, TestProtectRtpPacketsStopsAtFailure) {
+  EXPECT_TRUE(s1_.SetSend(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  CopyOnWriteBuffer first(kPcmuFrame, rtp_len_, rtp_len_ + 10);
+  // No room for the authentication tag.
+  CopyOnWriteBuffer second(kPcmuFrame, rtp_len_, rtp_len_);
+  CopyOnWriteBuffer third(kPcmuFrame, rtp_len_, rtp_len_ + 10);
+  SetBE16(first.data() + 2, 1);
+  SetBE16(second.data() + 2, 2);
+  SetBE16(third.data() + 2, 3);
+  std::vector<CopyOnWriteBuffer*> buffers = {&first, &second, &third};
+
+  EXPECT_EQ(1u, s1_.ProtectRtpPackets(buffers));
+  EXPECT_EQ(static_cast<size_t>(rtp_len_ + 10), first.size());
+  EXPECT_EQ(static_cast<size_t>(rtp_len_), third.size());
+  EXPECT_EQ(0, memcmp(third.cdata() + 12, kPcmuFrame + 12, rtp_len_ - 12));
+}
+
 }  // namespace rtc
@@ -24,16 +24,23 @@
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/base64/base64.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/trace_event.h"
 #include "rtc_base/zero_memory.h"
 
 namespace webrtc {
 
+namespace {
+// Batches larger than this are protected in several parts.
+constexpr size_t kMaxPendingRtpPackets = 64;
+}  // namespace
+
 SrtpTransport::SrtpTransport(bool rtcp_mux_enabled)
     : RtpTransport(rtcp_mux_enabled) {}
 
@@ -125,8 +132,31 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
         << "Failed to send the packet because SRTP transport is inactive.";
     return false;
   }
+  if (!pending_rtp_packets_.empty() && !options.batchable) {
+    SendPendingRtpPackets();
+  }
+  if (options.batchable && !IsExternalAuthActive()) {
+    if (pending_rtp_packets_.empty()) {
+      if (rtc::Thread* thread = rtc::Thread::Current())
+        thread->Post(RTC_FROM_HERE, this);
+    }
+    pending_rtp_packets_.push_back({std::move(*packet), options, flags});
+    if (options.last_packet_in_batch ||
+        pending_rtp_packets_.size() >= kMaxPendingRtpPackets) {
+      return SendPendingRtpPackets();
+    }
+    return true;
+  }
+
   rtc::PacketOptions updated_options = options;
   TRACE_EVENT0("webrtc", "SRTP Encode");
+  // Packets are protected in place, which needs room for the authentication
+  // tag past the end of the packet. Senders usually leave it, so the buffer
+  // is only reallocated here, or copied below if still shared, as a fallback.
+  int srtp_overhead = 0;
+  if (GetSrtpOverhead(&srtp_overhead)) {
+    packet->EnsureCapacity(packet->size() + srtp_overhead);
+  }
   bool res;
   uint8_t* data = packet->data();
   int len = rtc::checked_cast<int>(packet->size());
@@ -175,6 +205,52 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   return SendPacket(/*rtcp=*/false, packet, updated_options, flags);
 }
 
+bool SrtpTransport::SendPendingRtpPackets() {
+  if (pending_rtp_packets_.empty())
+    return true;
+  std::vector<PendingRtpPacket> packets;
+  packets.swap(pending_rtp_packets_);
+  int srtp_overhead = 0;
+  if (!GetSrtpOverhead(&srtp_overhead)) {
+    RTC_LOG(LS_ERROR) << "Dropping " << packets.size()
+                      << " batched RTP packets, SRTP transport is inactive.";
+    return false;
+  }
+
+  TRACE_EVENT1("webrtc", "SRTP Encode Batch", "packets", packets.size());
+  std::vector<rtc::CopyOnWriteBuffer*> buffers;
+  buffers.reserve(packets.size());
+  for (PendingRtpPacket& pending : packets) {
+    pending.packet.EnsureCapacity(pending.packet.size() + srtp_overhead);
+    buffers.push_back(&pending.packet);
+  }
+
+  rtc::ArrayView<rtc::CopyOnWriteBuffer* const> all_buffers(buffers);
+  bool all_sent = true;
+  size_t begin = 0;
+  while (begin < buffers.size()) {
+    size_t end = begin + send_session_->ProtectRtpPackets(
+                             all_buffers.subview(begin));
+    for (size_t i = begin; i < end; ++i) {
+      all_sent &= SendPacket(/*rtcp=*/false, &packets[i].packet,
+                             packets[i].options, packets[i].flags);
+    }
+    if (end < buffers.size()) {
+      // Drop the packet that failed and go on with the rest of the batch.
+      RTC_LOG(LS_ERROR) << "Failed to protect RTP packet " << end + 1
+                        << " of a batch of " << packets.size();
+      all_sent = false;
+      ++end;
+    }
+    begin = end;
+  }
+  return all_sent;
+}
+
+void SrtpTransport::OnMessage(rtc::Message* msg) {
+  SendPendingRtpPackets();
+}
+
 bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                                    const rtc::PacketOptions& options,
                                    int flags) {
@@ -283,6 +359,7 @@ bool SrtpTransport::SetRtpParams(int send_cs,
   // sessions and call "SetSend/SetRecv". Otherwise we should call
   // "UpdateSend"/"UpdateRecv" on the existing sessions, which will internally
   // call "srtp_update".
+  SendPendingRtpPackets();
   bool new_sessions = false;
   if (!send_session_) {
     RTC_DCHECK(!recv_session_);
@@ -358,6 +435,7 @@ bool SrtpTransport::IsWritable(bool rtcp) const {
 }
 
 void SrtpTransport::ResetParams() {
+  SendPendingRtpPackets();
   send_session_ = nullptr;
   recv_session_ = nullptr;
   send_rtcp_session_ = nullptr;
@@ -27,6 +27,7 @@
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/message_handler.h"
 #include "rtc_base/network_route.h"
 
 namespace webrtc {
@@ -34,11 +35,15 @@ namespace webrtc {
 // This subclass of the RtpTransport is used for SRTP which is reponsible for
 // protecting/unprotecting the packets. It provides interfaces to set the crypto
 // parameters for the SrtpSession underneath.
-class SrtpTransport : public RtpTransport {
+//
+// Batchable RTP packets, see rtc::PacketOptions, are held back until the last
+// packet of their batch and then protected with a single call to
+// SrtpSession::ProtectRtpPackets(). Their buffers are taken from the caller.
+class SrtpTransport : public RtpTransport, public rtc::MessageHandler {
  public:
   explicit SrtpTransport(bool rtcp_mux_enabled);
 
-  virtual ~SrtpTransport() = default;
+  ~SrtpTransport() override = default;
 
   // SrtpTransportInterface specific implementation.
   virtual RTCError SetSrtpSendKey(const cricket::CryptoParams& params);
@@ -114,6 +119,19 @@ class SrtpTransport : public RtpTransport {
   void MaybeUpdateWritableState();
 
  private:
+  struct PendingRtpPacket {
+    rtc::CopyOnWriteBuffer packet;
+    rtc::PacketOptions options;
+    int flags;
+  };
+
+  // Protects and sends the held back batch. Returns false if any packet of it
+  // failed.
+  bool SendPendingRtpPackets();
+  // Implements MessageHandler. Sends the held back batch in case the last
+  // packet of the batch never arrives, e.g. because it was dropped above.
+  void OnMessage(rtc::Message* msg) override;
+
   void ConnectToRtpTransport();
   void CreateSrtpSessions();
 
@@ -167,6 +185,8 @@ class SrtpTransport : public RtpTransport {
   int rtp_abs_sendtime_extn_id_ = -1;
 
   int decryption_failure_count_ = 0;
+
+  std::vector<PendingRtpPacket> pending_rtp_packets_;
 };
 
 }  // namespace webrtc
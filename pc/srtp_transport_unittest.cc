@@ -27,6 +27,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "test/gtest.h"
 
 using rtc::kTestKey1;
@@ -405,6 +406,89 @@ INSTANTIATE_TEST_SUITE_P(ExternalAuth,
                          SrtpTransportTestWithExternalAuth,
                          ::testing::Values(true, false));
 
+TEST_F(SrtpTransportTest, ProtectsRtpPacketInPlaceWhenBufferHasRoom) {
+  std::vector<int> extension_ids;
+  ASSERT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids));
+  size_t rtp_len = sizeof(kPcmuFrame);
+  rtc::CopyOnWriteBuffer packet(
+      kPcmuFrame, rtp_len,
+      rtp_len + rtc::rtp_auth_tag_len(rtc::CS_AES_CM_128_HMAC_SHA1_80));
+  const uint8_t* data = packet.cdata();
+
+  rtc::PacketOptions options;
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(data, packet.cdata());
+  EXPECT_EQ(rtp_len + rtc::rtp_auth_tag_len(rtc::CS_AES_CM_128_HMAC_SHA1_80),
+            packet.size());
+}
+
+TEST_F(SrtpTransportTest, ProtectsRtpPacketWithoutRoomForAuthTag) {
+  std::vector<int> extension_ids;
+  ASSERT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids));
+  ASSERT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids));
+  size_t rtp_len = sizeof(kPcmuFrame);
+  rtc::CopyOnWriteBuffer packet(kPcmuFrame, rtp_len, rtp_len);
+  // Shared with |original|, which must not be modified.
+  rtc::CopyOnWriteBuffer original = packet;
+
+  rtc::PacketOptions options;
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(rtc::CopyOnWriteBuffer(kPcmuFrame, rtp_len), original);
+  ASSERT_TRUE(rtp_sink2_.last_recv_rtp_packet().data());
+  EXPECT_EQ(0, memcmp(rtp_sink2_.last_recv_rtp_packet().data(), kPcmuFrame,
+                      rtp_len));
+}
+
+TEST_F(SrtpTransportTest, ProtectsBatchOnLastPacket) {
+  std::vector<int> extension_ids;
+  ASSERT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids));
+  ASSERT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids));
+  rtc::PacketOptions options;
+  options.batchable = true;
+  for (uint16_t seq_num = 1; seq_num <= 3; ++seq_num) {
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame));
+    rtc::SetBE16(packet.data() + 2, seq_num);
+    options.last_packet_in_batch = seq_num == 3;
+    ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                                cricket::PF_SRTP_BYPASS));
+    EXPECT_EQ(seq_num == 3 ? 3 : 0, rtp_sink2_.rtp_count());
+  }
+  ASSERT_TRUE(rtp_sink2_.last_recv_rtp_packet().data());
+  EXPECT_EQ(3, rtc::GetBE16(rtp_sink2_.last_recv_rtp_packet().data() + 2));
+}
+
+TEST_F(SrtpTransportTest, ProtectsBatchWithoutLastPacketLater) {
+  rtc::AutoThread main_thread;
+  std::vector<int> extension_ids;
+  ASSERT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids));
+  ASSERT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids));
+  rtc::PacketOptions options;
+  options.batchable = true;
+  rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame));
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(0, rtp_sink2_.rtp_count());
+
+  rtc::Thread::Current()->ProcessMessages(0);
+  EXPECT_EQ(1, rtp_sink2_.rtp_count());
+}
+
 // Test directly setting the params with bogus keys.
 TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
   std::vector<int> extension_ids;
@@ -32,6 +32,8 @@ class FakeSctpTransport : public cricket::SctpTransportInternal {
   bool SendData(const cricket::SendDataParams& params,
                 const rtc::CopyOnWriteBuffer& payload,
                 cricket::SendDataResult* result = nullptr) override {
+    if (result)
+      *result = cricket::SDR_SUCCESS;
     return true;
   }
   bool ReadyToSendData() override { return true; }
@@ -25,6 +25,8 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 #include "api/candidate.h"
 #include "api/crypto_params.h"
 #include "api/jsep_ice_candidate.h"
@@ -327,7 +329,7 @@ static bool ParseFmtpAttributes(const std::string& line,
                                 const cricket::MediaType media_type,
                                 MediaContentDescription* media_desc,
                                 SdpParseError* error);
-static bool ParseFmtpParam(const std::string& line,
+static bool ParseFmtpParam(absl::string_view line,
                            std::string* parameter,
                            std::string* value,
                            SdpParseError* error);
@@ -440,12 +442,12 @@ static bool ParseFailedExpectMinFieldNum(const std::string& line,
 
 // |line| is the failing line. The failure is due to the fact that it failed to
 // get the value of |attribute|.
-static bool ParseFailedGetValue(const std::string& line,
-                                const std::string& attribute,
+static bool ParseFailedGetValue(absl::string_view line,
+                                absl::string_view attribute,
                                 SdpParseError* error) {
   rtc::StringBuilder description;
   description << "Failed to get the value of attribute: " << attribute;
-  return ParseFailed(line, description.str(), error);
+  return ParseFailed(std::string(line), description.str(), error);
 }
 
 // The line starting at |line_start| of |message| is the failing line. The
@@ -463,11 +465,11 @@ static bool ParseFailedExpectLine(const std::string& message,
   return ParseFailed(message, line_start, description.str(), error);
 }
 
-static bool AddLine(const std::string& line, std::string* message) {
+static bool AddLine(absl::string_view line, std::string* message) {
   if (!message)
     return false;
 
-  message->append(line);
+  message->append(line.data(), line.size());
   message->append(kLineBreak);
   return true;
 }
@@ -485,7 +487,8 @@ static bool GetLine(const std::string& message,
   if (line_end > 0 && (message.at(line_end - 1) == kReturnChar)) {
     --line_end;
   }
-  *line = message.substr(line_begin, (line_end - line_begin));
+  // Reuses the buffer of |line|, which the parsers keep for all the lines.
+  line->assign(message, line_begin, line_end - line_begin);
   const char* cline = line->c_str();
   // RFC 4566
   // An SDP session description consists of a number of lines of text of
@@ -512,14 +515,14 @@ static bool GetLine(const std::string& message,
 
 // Init |os| to "|type|=|value|".
 static void InitLine(const char type,
-                     const std::string& value,
+                     absl::string_view value,
                      rtc::StringBuilder* os) {
   os->Clear();
-  *os << std::string(1, type) << kSdpDelimiterEqual << value;
+  *os << absl::string_view(&type, 1) << kSdpDelimiterEqual << value;
 }
 
 // Init |os| to "a=|attribute|".
-static void InitAttrLine(const std::string& attribute, rtc::StringBuilder* os) {
+static void InitAttrLine(absl::string_view attribute, rtc::StringBuilder* os) {
   InitLine(kLineTypeAttributes, attribute, os);
 }
 
@@ -543,7 +546,7 @@ static void AddAltProtocolLine(const std::string& protocol,
 }
 
 // Writes a SDP attribute line based on |attribute| and |value| to |message|.
-static void AddAttributeLine(const std::string& attribute,
+static void AddAttributeLine(absl::string_view attribute,
                              int value,
                              std::string* message) {
   rtc::StringBuilder os;
@@ -581,9 +584,9 @@ static bool GetLineWithType(const std::string& message,
   return true;
 }
 
-static bool HasAttribute(const std::string& line,
-                         const std::string& attribute) {
-  if (line.compare(kLinePrefixLength, attribute.size(), attribute) == 0) {
+static bool HasAttribute(const std::string& line, absl::string_view attribute) {
+  if (absl::string_view(line).substr(kLinePrefixLength, attribute.size()) ==
+      attribute) {
     // Make sure that the match is not only a partial match. If length of
     // strings doesn't match, the next character of the line must be ':' or ' '.
     // This function is also used for media descriptions (e.g., "m=audio 9..."),
@@ -599,7 +602,7 @@ static bool HasAttribute(const std::string& line,
 }
 
 static bool AddSsrcLine(uint32_t ssrc_id,
-                        const std::string& attribute,
+                        absl::string_view attribute,
                         const std::string& value,
                         std::string* message) {
   // RFC 5576
@@ -611,21 +614,49 @@ static bool AddSsrcLine(uint32_t ssrc_id,
   return AddLine(os.str(), message);
 }
 
+// Like rtc::tokenize_first(), without copying |source|.
+static bool TokenizeFirst(absl::string_view source,
+                          char delimiter,
+                          absl::string_view* token,
+                          absl::string_view* rest) {
+  size_t left_pos = source.find(delimiter);
+  if (left_pos == absl::string_view::npos) {
+    return false;
+  }
+  // Skip the additional occurrences of the delimiter.
+  size_t right_pos = left_pos + 1;
+  while (right_pos < source.size() && source[right_pos] == delimiter) {
+    ++right_pos;
+  }
+  *token = source.substr(0, left_pos);
+  *rest = source.substr(right_pos);
+  return true;
+}
+
+// Like rtc::string_trim(), without copying |s|.
+static absl::string_view TrimWhitespace(absl::string_view s) {
+  static const char kWhitespace[] = " \n\r\t";
+  size_t first = s.find_first_not_of(kWhitespace);
+  if (first == absl::string_view::npos) {
+    return absl::string_view();
+  }
+  size_t last = s.find_last_not_of(kWhitespace);
+  return s.substr(first, last - first + 1);
+}
+
 // Get value only from <attribute>:<value>.
-static bool GetValue(const std::string& message,
-                     const std::string& attribute,
+static bool GetValue(absl::string_view message,
+                     absl::string_view attribute,
                      std::string* value,
                      SdpParseError* error) {
-  std::string leftpart;
-  if (!rtc::tokenize_first(message, kSdpDelimiterColonChar, &leftpart, value)) {
-    return ParseFailedGetValue(message, attribute, error);
-  }
+  absl::string_view leftpart;
+  absl::string_view rightpart;
   // The left part should end with the expected attribute.
-  if (leftpart.length() < attribute.length() ||
-      leftpart.compare(leftpart.length() - attribute.length(),
-                       attribute.length(), attribute) != 0) {
+  if (!TokenizeFirst(message, kSdpDelimiterColonChar, &leftpart, &rightpart) ||
+      !absl::EndsWith(leftpart, attribute)) {
     return ParseFailedGetValue(message, attribute, error);
   }
+  value->assign(rightpart.data(), rightpart.size());
   return true;
 }
 
@@ -637,10 +668,10 @@ static bool CaseInsensitiveFind(std::string str1, std::string str2) {
 
 template <class T>
 static bool GetValueFromString(const std::string& line,
-                               const std::string& s,
+                               absl::string_view s,
                                T* t,
                                SdpParseError* error) {
-  if (!rtc::FromString(s, t)) {
+  if (!rtc::FromString(std::string(s), t)) {
     rtc::StringBuilder description;
     description << "Invalid value: " << s << ".";
     return ParseFailed(line, description.str(), error);
@@ -649,7 +680,7 @@ static bool GetValueFromString(const std::string& line,
 }
 
 static bool GetPayloadTypeFromString(const std::string& line,
-                                     const std::string& s,
+                                     absl::string_view s,
                                      int* payload_type,
                                      SdpParseError* error) {
   return GetValueFromString(line, s, payload_type, error) &&
@@ -1073,8 +1104,8 @@ bool ParseCandidate(const std::string& message,
     }
   }
 
-  std::vector<std::string> fields;
-  rtc::split(candidate_value, kSdpDelimiterSpaceChar, &fields);
+  std::vector<absl::string_view> fields =
+      absl::StrSplit(candidate_value, kSdpDelimiterSpaceChar);
 
   // RFC 5245
   // a=candidate:<foundation> <component-id> <transport> <priority>
@@ -1086,18 +1117,18 @@ bool ParseCandidate(const std::string& message,
       (fields[6] != kAttributeCandidateTyp)) {
     return ParseFailedExpectMinFieldNum(first_line, expected_min_fields, error);
   }
-  const std::string& foundation = fields[0];
+  const absl::string_view foundation = fields[0];
 
   int component_id = 0;
   if (!GetValueFromString(first_line, fields[1], &component_id, error)) {
     return false;
   }
-  const std::string& transport = fields[2];
+  const std::string transport(fields[2]);
   uint32_t priority = 0;
   if (!GetValueFromString(first_line, fields[3], &priority, error)) {
     return false;
   }
-  const std::string& connection_address = fields[4];
+  const std::string connection_address(fields[4]);
   int port = 0;
   if (!GetValueFromString(first_line, fields[5], &port, error)) {
     return false;
@@ -1125,7 +1156,7 @@ bool ParseCandidate(const std::string& message,
   }
 
   std::string candidate_type;
-  const std::string& type = fields[7];
+  const absl::string_view type = fields[7];
   if (type == kCandidateHost) {
     candidate_type = cricket::LOCAL_PORT_TYPE;
   } else if (type == kCandidateSrflx) {
@@ -1144,7 +1175,7 @@ bool ParseCandidate(const std::string& message,
   // [raddr <connection-address>] [rport <port>]
   if (fields.size() >= (current_position + 2) &&
       fields[current_position] == kAttributeCandidateRaddr) {
-    related_address.SetIP(fields[++current_position]);
+    related_address.SetIP(std::string(fields[++current_position]));
     ++current_position;
   }
   if (fields.size() >= (current_position + 2) &&
@@ -1166,7 +1197,7 @@ bool ParseCandidate(const std::string& message,
   std::string tcptype;
   if (fields.size() >= (current_position + 2) &&
       fields[current_position] == kTcpCandidateType) {
-    tcptype = fields[++current_position];
+    tcptype = std::string(fields[++current_position]);
     ++current_position;
 
     if (tcptype != cricket::TCPTYPE_ACTIVE_STR &&
@@ -1202,9 +1233,9 @@ bool ParseCandidate(const std::string& message,
         return false;
       }
     } else if (fields[i] == kAttributeCandidateUfrag) {
-      username = fields[++i];
+      username = std::string(fields[++i]);
     } else if (fields[i] == kAttributeCandidatePwd) {
-      password = fields[++i];
+      password = std::string(fields[++i]);
     } else if (fields[i] == kAttributeCandidateNetworkId) {
       if (!GetValueFromString(first_line, fields[++i], &network_id, error)) {
         return false;
@@ -1222,7 +1253,8 @@ bool ParseCandidate(const std::string& message,
 
   *candidate = Candidate(component_id, cricket::ProtoToString(protocol),
                          address, priority, username, password, candidate_type,
-                         generation, foundation, network_id, network_cost);
+                         generation, std::string(foundation), network_id,
+                         network_cost);
   candidate->set_related_address(related_address);
   candidate->set_tcptype(tcptype);
   return true;
@@ -1286,20 +1318,21 @@ bool ParseExtmap(const std::string& line,
                  SdpParseError* error) {
   // RFC 5285
   // a=extmap:<value>["/"<direction>] <URI> <extensionattributes>
-  std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  std::vector<absl::string_view> fields =
+      absl::StrSplit(absl::string_view(line).substr(kLinePrefixLength),
+                     kSdpDelimiterSpaceChar);
   const size_t expected_min_fields = 2;
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
   }
-  std::string uri = fields[1];
+  std::string uri(fields[1]);
 
   std::string value_direction;
   if (!GetValue(fields[0], kAttributeExtmap, &value_direction, error)) {
     return false;
   }
-  std::vector<std::string> sub_fields;
-  rtc::split(value_direction, kSdpDelimiterSlashChar, &sub_fields);
+  std::vector<absl::string_view> sub_fields =
+      absl::StrSplit(value_direction, kSdpDelimiterSlashChar);
   int value = 0;
   if (!GetValueFromString(line, sub_fields[0], &value, error)) {
     return false;
@@ -1317,7 +1350,7 @@ bool ParseExtmap(const std::string& line,
     }
 
     encrypted = true;
-    uri = fields[2];
+    uri = std::string(fields[2]);
     if (uri == RtpExtension::kEncryptHeaderExtensionsUri) {
       return ParseFailed(line, "Recursive encrypted header.", error);
     }
@@ -3440,9 +3473,9 @@ bool ParseSsrcAttribute(const std::string& line,
   // RFC 5576
   // a=ssrc:<ssrc-id> <attribute>
   // a=ssrc:<ssrc-id> <attribute>:<value>
-  std::string field1, field2;
-  if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
-                           kSdpDelimiterSpaceChar, &field1, &field2)) {
+  absl::string_view field1, field2;
+  if (!TokenizeFirst(absl::string_view(line).substr(kLinePrefixLength),
+                     kSdpDelimiterSpaceChar, &field1, &field2)) {
     const size_t expected_fields = 2;
     return ParseFailedExpectFieldNum(line, expected_fields, error);
   }
@@ -3457,10 +3490,9 @@ bool ParseSsrcAttribute(const std::string& line,
     return false;
   }
 
-  std::string attribute;
-  std::string value;
-  if (!rtc::tokenize_first(field2, kSdpDelimiterColonChar, &attribute,
-                           &value)) {
+  absl::string_view attribute;
+  absl::string_view value;
+  if (!TokenizeFirst(field2, kSdpDelimiterColonChar, &attribute, &value)) {
     rtc::StringBuilder description;
     description << "Failed to get the ssrc attribute value from " << field2
                 << ". Expected format <attribute>:<value>.";
@@ -3485,29 +3517,29 @@ bool ParseSsrcAttribute(const std::string& line,
   if (attribute == kSsrcAttributeCname) {
     // RFC 5576
     // cname:<value>
-    ssrc_info.cname = value;
+    ssrc_info.cname = std::string(value);
   } else if (attribute == kSsrcAttributeMsid) {
     // draft-alvestrand-mmusic-msid-00
     // msid:identifier [appdata]
-    std::vector<std::string> fields;
-    rtc::split(value, kSdpDelimiterSpaceChar, &fields);
+    std::vector<absl::string_view> fields =
+        absl::StrSplit(value, kSdpDelimiterSpaceChar);
     if (fields.size() < 1 || fields.size() > 2) {
       return ParseFailed(
           line, "Expected format \"msid:<identifier>[ <appdata>]\".", error);
     }
-    ssrc_info.stream_id = fields[0];
+    ssrc_info.stream_id = std::string(fields[0]);
     if (fields.size() == 2) {
-      ssrc_info.track_id = fields[1];
+      ssrc_info.track_id = std::string(fields[1]);
     }
     *msid_signaling |= cricket::kMsidSignalingSsrcAttribute;
   } else if (attribute == kSsrcAttributeMslabel) {
     // draft-alvestrand-rtcweb-mid-01
     // mslabel:<value>
-    ssrc_info.mslabel = value;
+    ssrc_info.mslabel = std::string(value);
   } else if (attribute == kSSrcAttributeLabel) {
     // The label isn't defined.
     // label:<value>
-    ssrc_info.label = value;
+    ssrc_info.label = std::string(value);
   }
   return true;
 }
@@ -3609,8 +3641,9 @@ bool ParseRtpmapAttribute(const std::string& line,
                           const std::vector<int>& payload_types,
                           MediaContentDescription* media_desc,
                           SdpParseError* error) {
-  std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  std::vector<absl::string_view> fields =
+      absl::StrSplit(absl::string_view(line).substr(kLinePrefixLength),
+                     kSdpDelimiterSpaceChar);
   // RFC 4566
   // a=rtpmap:<payload type> <encoding name>/<clock rate>[/<encodingparameters>]
   const size_t expected_min_fields = 2;
@@ -3633,9 +3666,7 @@ bool ParseRtpmapAttribute(const std::string& line,
                         << line;
     return true;
   }
-  const std::string& encoder = fields[1];
-  std::vector<std::string> codec_params;
-  rtc::split(encoder, '/', &codec_params);
+  std::vector<absl::string_view> codec_params = absl::StrSplit(fields[1], '/');
   // <encoding name>/<clock rate>[/<encodingparameters>]
   // 2 mandatory fields
   if (codec_params.size() < 2 || codec_params.size() > 3) {
@@ -3644,7 +3675,7 @@ bool ParseRtpmapAttribute(const std::string& line,
                        "[/<encodingparameters>]\".",
                        error);
   }
-  const std::string& encoding_name = codec_params[0];
+  const std::string encoding_name(codec_params[0]);
   int clock_rate = 0;
   if (!GetValueFromString(line, codec_params[1], &clock_rate, error)) {
     return false;
@@ -3676,14 +3707,20 @@ bool ParseRtpmapAttribute(const std::string& line,
   return true;
 }
 
-bool ParseFmtpParam(const std::string& line,
+bool ParseFmtpParam(absl::string_view line,
                     std::string* parameter,
                     std::string* value,
                     SdpParseError* error) {
-  if (!rtc::tokenize_first(line, kSdpDelimiterEqualChar, parameter, value)) {
-    ParseFailed(line, "Unable to parse fmtp parameter. \'=\' missing.", error);
+  absl::string_view parameter_view;
+  absl::string_view value_view;
+  if (!TokenizeFirst(line, kSdpDelimiterEqualChar, &parameter_view,
+                     &value_view)) {
+    ParseFailed(std::string(line),
+                "Unable to parse fmtp parameter. \'=\' missing.", error);
     return false;
   }
+  parameter->assign(parameter_view.data(), parameter_view.size());
+  value->assign(value_view.data(), value_view.size());
   // a=fmtp:<payload_type> <param1>=<value1>; <param2>=<value2>; ...
   return true;
 }
@@ -3697,16 +3734,15 @@ bool ParseFmtpAttributes(const std::string& line,
     return true;
   }
 
-  std::string line_payload;
-  std::string line_params;
+  absl::string_view line_payload;
+  absl::string_view line_params;
 
   // RFC 5576
   // a=fmtp:<format> <format specific parameters>
   // At least two fields, whereas the second one is any of the optional
   // parameters.
-  if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
-                           kSdpDelimiterSpaceChar, &line_payload,
-                           &line_params)) {
+  if (!TokenizeFirst(absl::string_view(line).substr(kLinePrefixLength),
+                     kSdpDelimiterSpaceChar, &line_payload, &line_params)) {
     ParseFailedExpectMinFieldNum(line, 2, error);
     return false;
   }
@@ -3718,18 +3754,16 @@ bool ParseFmtpAttributes(const std::string& line,
   }
 
   int payload_type = 0;
-  if (!GetPayloadTypeFromString(line_payload, payload_type_str, &payload_type,
-                                error)) {
+  if (!GetPayloadTypeFromString(std::string(line_payload), payload_type_str,
+                                &payload_type, error)) {
     return false;
   }
 
   // Parse out format specific parameters.
-  std::vector<std::string> fields;
-  rtc::split(line_params, kSdpDelimiterSemicolonChar, &fields);
-
   cricket::CodecParameterMap codec_params;
-  for (auto& iter : fields) {
-    if (iter.find(kSdpDelimiterEqual) == std::string::npos) {
+  for (absl::string_view field :
+       absl::StrSplit(line_params, kSdpDelimiterSemicolonChar)) {
+    if (field.find(kSdpDelimiterEqualChar) == absl::string_view::npos) {
       // Only fmtps with equals are currently supported. Other fmtp types
       // should be ignored. Unknown fmtps do not constitute an error.
       continue;
@@ -3737,10 +3771,10 @@ bool ParseFmtpAttributes(const std::string& line,
 
     std::string name;
     std::string value;
-    if (!ParseFmtpParam(rtc::string_trim(iter), &name, &value, error)) {
+    if (!ParseFmtpParam(TrimWhitespace(field), &name, &value, error)) {
       return false;
     }
-    codec_params[name] = value;
+    codec_params[std::move(name)] = std::move(value);
   }
 
   if (media_type == cricket::MEDIA_TYPE_AUDIO) {
@@ -3760,8 +3794,8 @@ bool ParsePacketizationAttribute(const std::string& line,
   if (media_type != cricket::MEDIA_TYPE_VIDEO) {
     return true;
   }
-  std::vector<std::string> packetization_fields;
-  rtc::split(line.c_str(), kSdpDelimiterSpaceChar, &packetization_fields);
+  std::vector<absl::string_view> packetization_fields =
+      absl::StrSplit(line, kSdpDelimiterSpaceChar);
   if (packetization_fields.size() < 2) {
     return ParseFailedGetValue(line, kAttributePacketization, error);
   }
@@ -3775,7 +3809,7 @@ bool ParsePacketizationAttribute(const std::string& line,
                                 error)) {
     return false;
   }
-  std::string packetization = packetization_fields[1];
+  std::string packetization(packetization_fields[1]);
   UpdateVideoCodecPacketization(media_desc->as_video(), payload_type,
                                 packetization);
   return true;
@@ -3789,8 +3823,8 @@ bool ParseRtcpFbAttribute(const std::string& line,
       media_type != cricket::MEDIA_TYPE_VIDEO) {
     return true;
   }
-  std::vector<std::string> rtcp_fb_fields;
-  rtc::split(line.c_str(), kSdpDelimiterSpaceChar, &rtcp_fb_fields);
+  std::vector<absl::string_view> rtcp_fb_fields =
+      absl::StrSplit(line, kSdpDelimiterSpaceChar);
   if (rtcp_fb_fields.size() < 2) {
     return ParseFailedGetValue(line, kAttributeRtcpFb, error);
   }
@@ -3806,11 +3840,11 @@ bool ParseRtcpFbAttribute(const std::string& line,
       return false;
     }
   }
-  std::string id = rtcp_fb_fields[1];
-  std::string param = "";
-  for (std::vector<std::string>::iterator iter = rtcp_fb_fields.begin() + 2;
-       iter != rtcp_fb_fields.end(); ++iter) {
-    param.append(*iter);
+  std::string id(rtcp_fb_fields[1]);
+  std::string param;
+  for (auto iter = rtcp_fb_fields.begin() + 2; iter != rtcp_fb_fields.end();
+       ++iter) {
+    param.append(iter->data(), iter->size());
   }
   const cricket::FeedbackParam feedback_param(id, param);
 
@@ -3278,6 +3278,35 @@ TEST_F(WebRtcSdpTest, DeserializeCandidateWithUfragPwd) {
   EXPECT_TRUE(jcandidate.candidate().IsEquivalent(ref_candidate));
 }
 
+TEST_F(WebRtcSdpTest, DeserializeCandidateNumbers) {
+  JsepIceCandidate jcandidate(kDummyMid, kDummyIndex);
+  std::string sdp = kSdpOneCandidate;
+  Replace("2130706432", "4294967295", &sdp);
+  EXPECT_TRUE(SdpDeserializeCandidate(sdp, &jcandidate));
+  EXPECT_EQ(4294967295u, jcandidate.candidate().priority());
+
+  // The numbers are parsed whole, without sign or overflow.
+  const char* const kInvalidPriorities[] = {"4294967296", "-1", "2130706432x",
+                                            "x2130706432", "+2130706432"};
+  for (const char* priority : kInvalidPriorities) {
+    sdp = kSdpOneCandidate;
+    Replace("2130706432", priority, &sdp);
+    EXPECT_FALSE(SdpDeserializeCandidate(sdp, &jcandidate)) << priority;
+  }
+  sdp = kSdpOneCandidate;
+  Replace(" 1234 ", " 1234x ", &sdp);
+  EXPECT_FALSE(SdpDeserializeCandidate(sdp, &jcandidate));
+}
+
+TEST_F(WebRtcSdpTest, DeserializeSsrcAttributeWithRepeatedDelimiters) {
+  std::string sdp = kSdpFullString;
+  Replace("a=ssrc:1 cname:stream_1_cname", "a=ssrc:1   cname::stream_1_cname",
+          &sdp);
+  JsepSessionDescription jdesc(kDummyType);
+  EXPECT_TRUE(SdpDeserialize(sdp, &jdesc));
+  EXPECT_TRUE(CompareSessionDescription(jdesc_, jdesc));
+}
+
 TEST_F(WebRtcSdpTest, DeserializeSdpWithConferenceFlag) {
   JsepSessionDescription jdesc(kDummyType);
 
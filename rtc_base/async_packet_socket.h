@@ -52,6 +52,10 @@ struct RTC_EXPORT PacketOptions {
   PacketTimeUpdateParams packet_time_params;
   // PacketInfo is passed to SentPacket when signaling this packet is sent.
   PacketInfo info_signaled_after_sent;
+  // Packets sent in a burst may be held back by the socket until the last
+  // packet of the burst, and then be sent together.
+  bool batchable = false;
+  bool last_packet_in_batch = false;
 };
 
 // Provides the ability to receive packets asynchronously. Sends are not
@@ -64,6 +64,16 @@ int AsyncSocketAdapter::SendTo(const void* pv,
   return socket_->SendTo(pv, cb, addr);
 }
 
+int AsyncSocketAdapter::SendMultipleTo(
+    ArrayView<const ArrayView<const uint8_t>> packets,
+    const SocketAddress& addr) {
+  return socket_->SendMultipleTo(packets, addr);
+}
+
+int AsyncSocketAdapter::GetSendTimestamps(ArrayView<int64_t> timestamps) {
+  return socket_->GetSendTimestamps(timestamps);
+}
+
 int AsyncSocketAdapter::Recv(void* pv, size_t cb, int64_t* timestamp) {
   return socket_->Recv(pv, cb, timestamp);
 }
@@ -75,6 +85,10 @@ int AsyncSocketAdapter::RecvFrom(void* pv,
   return socket_->RecvFrom(pv, cb, paddr, timestamp);
 }
 
+int AsyncSocketAdapter::RecvMultipleFrom(ArrayView<ReceiveBuffer> buffers) {
+  return socket_->RecvMultipleFrom(buffers);
+}
+
 int AsyncSocketAdapter::Listen(int backlog) {
   return socket_->Listen(backlog);
 }
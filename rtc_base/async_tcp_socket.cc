@@ -187,6 +187,31 @@ int AsyncTCPSocketBase::FlushOutBuffer() {
   return res;
 }
 
+int AsyncTCPSocketBase::SendOrBuffer(
+    ArrayView<const ArrayView<const uint8_t>> buffers) {
+  RTC_DCHECK(!listen_);
+  RTC_DCHECK(IsOutBufferEmpty());
+  int res = socket_->SendV(buffers);
+  if (res <= 0) {
+    return (res < 0 && socket_->GetError() == EWOULDBLOCK) ? 0 : res;
+  }
+  // Buffers what was not sent, to send it once the socket is writable.
+  size_t skipped = static_cast<size_t>(res);
+  for (const ArrayView<const uint8_t>& buffer : buffers) {
+    if (skipped >= buffer.size()) {
+      skipped -= buffer.size();
+      continue;
+    }
+    AppendToOutBuffer(buffer.data() + skipped, buffer.size() - skipped);
+    skipped = 0;
+  }
+  if (IsOutBufferEmpty()) {
+    return res;
+  }
+  int flushed = FlushOutBuffer();
+  return flushed < 0 ? flushed : res + flushed;
+}
+
 void AsyncTCPSocketBase::AppendToOutBuffer(const void* pv, size_t cb) {
   RTC_DCHECK(outbuf_.size() + cb <= max_outsize_);
   RTC_DCHECK(!listen_);
@@ -219,6 +244,14 @@ void AsyncTCPSocketBase::OnReadEvent(AsyncSocket* socket) {
     size_t total_recv = 0;
     while (true) {
       size_t free_size = inbuf_.capacity() - inbuf_.size();
+      if (free_size < kMinimumRecvSize && inbuf_start_ > 0) {
+        // Moves the partial packet to the front of the buffer.
+        size_t size = inbuf_.size() - inbuf_start_;
+        memmove(inbuf_.data(), inbuf_.data() + inbuf_start_, size);
+        inbuf_.SetSize(size);
+        inbuf_start_ = 0;
+        free_size = inbuf_.capacity() - inbuf_.size();
+      }
       if (free_size < kMinimumRecvSize && inbuf_.capacity() < max_insize_) {
         inbuf_.EnsureCapacity(std::min(max_insize_, inbuf_.capacity() * 2));
         free_size = inbuf_.capacity() - inbuf_.size();
@@ -246,15 +279,19 @@ void AsyncTCPSocketBase::OnReadEvent(AsyncSocket* socket) {
       return;
     }
 
-    size_t size = inbuf_.size();
-    ProcessInput(inbuf_.data<char>(), &size);
+    size_t size = inbuf_.size() - inbuf_start_;
+    ProcessInput(inbuf_.data<char>() + inbuf_start_, &size);
 
-    if (size > inbuf_.size()) {
+    if (size > inbuf_.size() - inbuf_start_) {
       RTC_LOG(LS_ERROR) << "input buffer overflow";
       RTC_NOTREACHED();
+      size = 0;
+    }
+    if (size == 0) {
       inbuf_.Clear();
+      inbuf_start_ = 0;
     } else {
-      inbuf_.SetSize(size);
+      inbuf_start_ = inbuf_.size() - size;
     }
   }
 }
@@ -303,10 +340,10 @@ int AsyncTCPSocket::Send(const void* pv,
     return static_cast<int>(cb);
 
   PacketLength pkt_len = HostToNetwork16(static_cast<PacketLength>(cb));
-  AppendToOutBuffer(&pkt_len, kPacketLenSize);
-  AppendToOutBuffer(pv, cb);
-
-  int res = FlushOutBuffer();
+  const ArrayView<const uint8_t> buffers[] = {
+      {reinterpret_cast<const uint8_t*>(&pkt_len), kPacketLenSize},
+      {static_cast<const uint8_t*>(pv), cb}};
+  int res = SendOrBuffer(buffers);
   if (res <= 0) {
     // drop packet if we made no progress
     ClearOutBuffer();
@@ -336,10 +373,8 @@ void AsyncTCPSocket::ProcessInput(char* data, size_t* len) {
     SignalReadPacket(this, data + kPacketLenSize, pkt_len, remote_addr,
                      TimeMicros());
 
+    data += kPacketLenSize + pkt_len;
     *len -= kPacketLenSize + pkt_len;
-    if (*len > 0) {
-      memmove(data, data + kPacketLenSize + pkt_len, *len);
-    }
   }
 }
 
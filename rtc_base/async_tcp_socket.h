@@ -15,6 +15,7 @@
 
 #include <memory>
 
+#include "api/array_view.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/async_socket.h"
 #include "rtc_base/buffer.h"
@@ -36,6 +37,10 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
   int Send(const void* pv,
            size_t cb,
            const rtc::PacketOptions& options) override = 0;
+  // Processes the |*len| bytes at |data|, and sets |*len| to the number of
+  // bytes left to process with the next ones received, which are the last ones
+  // of |data|. Those are left in place, so that every packet is parsed where
+  // it was received.
   virtual void ProcessInput(char* data, size_t* len) = 0;
   // Signals incoming connection.
   virtual void HandleIncomingConnection(AsyncSocket* socket) = 0;
@@ -62,6 +67,11 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
                                     const SocketAddress& bind_address,
                                     const SocketAddress& remote_address);
   int FlushOutBuffer();
+  // Sends |buffers| one after the other with one call, without copying them,
+  // and buffers what could not be sent. The out buffer must be empty. Returns
+  // the number of bytes sent, 0 if none could be sent because the socket would
+  // block, or -1.
+  int SendOrBuffer(ArrayView<const ArrayView<const uint8_t>> buffers);
   // Add data to |outbuf_|.
   void AppendToOutBuffer(const void* pv, size_t cb);
 
@@ -79,6 +89,9 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
   std::unique_ptr<AsyncSocket> socket_;
   bool listen_;
   Buffer inbuf_;
+  // Start of the bytes of |inbuf_| not processed yet. The buffer is only
+  // compacted once it is full, rather than after every packet.
+  size_t inbuf_start_ = 0;
   Buffer outbuf_;
   size_t max_insize_;
   size_t max_outsize_;
@@ -12,17 +12,33 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <string>
 
+#include "api/array_view.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/time_utils.h"
 
 namespace rtc {
 
 static const int BUF_SIZE = 64 * 1024;
+// Batches larger than this are sent in several parts.
+static const size_t kMaxPendingPackets = 64;
+
+// Prefers the transmit timestamp of the socket, if it reported one, over
+// |now_us|, the time the packet was handed to it.
+static void SetSendTime(int64_t timestamp_us,
+                        int64_t now_us,
+                        SentPacket* sent_packet) {
+  sent_packet->send_time_us = timestamp_us >= 0 ? timestamp_us : now_us;
+  sent_packet->send_time_ms =
+      sent_packet->send_time_us / kNumMicrosecsPerMillisec;
+}
 
 AsyncUDPSocket* AsyncUDPSocket::Create(AsyncSocket* socket,
                                        const SocketAddress& bind_address) {
@@ -69,6 +85,7 @@ int AsyncUDPSocket::Send(const void* pv,
                          const rtc::PacketOptions& options) {
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
+  sent_packet.send_time_us = rtc::TimeMicros();
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
   int ret = socket_->Send(pv, cb);
   SignalSentPacket(this, sent_packet);
@@ -79,15 +96,86 @@ int AsyncUDPSocket::SendTo(const void* pv,
                            size_t cb,
                            const SocketAddress& addr,
                            const rtc::PacketOptions& options) {
+  if (!pending_packets_.empty() &&
+      (!options.batchable || addr != pending_address_)) {
+    SendPendingPackets();
+  }
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
-  int ret = socket_->SendTo(pv, cb, addr);
-  SignalSentPacket(this, sent_packet);
-  return ret;
+  if (!options.batchable) {
+    const int64_t now_us = rtc::TimeMicros();
+    int ret = socket_->SendTo(pv, cb, addr);
+    int64_t timestamp_us = -1;
+    if (ret >= 0)
+      socket_->GetSendTimestamps(ArrayView<int64_t>(&timestamp_us, 1));
+    SetSendTime(timestamp_us, now_us, &sent_packet);
+    SignalSentPacket(this, sent_packet);
+    return ret;
+  }
+
+  if (pending_packets_.empty()) {
+    pending_address_ = addr;
+    if (Thread* thread = Thread::Current())
+      thread->Post(RTC_FROM_HERE, this);
+  }
+  pending_packets_.push_back(
+      {Buffer(static_cast<const uint8_t*>(pv), cb), sent_packet});
+  if (options.last_packet_in_batch ||
+      pending_packets_.size() >= kMaxPendingPackets) {
+    return SendPendingPackets() ? static_cast<int>(cb) : -1;
+  }
+  return static_cast<int>(cb);
+}
+
+bool AsyncUDPSocket::SendPendingPackets() {
+  if (pending_packets_.empty())
+    return true;
+  std::vector<ArrayView<const uint8_t>> packets;
+  packets.reserve(pending_packets_.size());
+  for (const PendingPacket& packet : pending_packets_)
+    packets.emplace_back(packet.data.data(), packet.data.size());
+  int sent = socket_->SendMultipleTo(packets, pending_address_);
+  const int64_t now_us = rtc::TimeMicros();
+  RTC_DCHECK_LE(pending_packets_.size(), kMaxPendingPackets);
+  int64_t timestamps[kMaxPendingPackets];
+  std::fill(timestamps, timestamps + pending_packets_.size(), -1);
+  socket_->GetSendTimestamps(
+      ArrayView<int64_t>(timestamps, pending_packets_.size()));
+  for (size_t i = 0; i < pending_packets_.size(); ++i) {
+    PendingPacket& packet = pending_packets_[i];
+    SetSendTime(timestamps[i], now_us, &packet.sent_packet);
+    SignalSentPacket(this, packet.sent_packet);
+  }
+  bool all_sent = sent == static_cast<int>(pending_packets_.size());
+  if (!all_sent) {
+    RTC_LOG(LS_VERBOSE) << "AsyncUDPSocket sent " << sent << " of "
+                        << pending_packets_.size()
+                        << " batched packets, error " << socket_->GetError();
+  }
+  pending_packets_.clear();
+  return all_sent;
+}
+
+void AsyncUDPSocket::SetReceiveBatchSize(size_t batch_size) {
+  RTC_DCHECK_GT(batch_size, 0);
+  receive_buffers_.clear();
+  if (batch_size <= 1)
+    return;
+  const size_t slot_size = size_ / batch_size;
+  receive_buffers_.resize(batch_size);
+  for (size_t i = 0; i < batch_size; ++i) {
+    receive_buffers_[i].data = ArrayView<uint8_t>(
+        reinterpret_cast<uint8_t*>(buf_) + i * slot_size, slot_size);
+  }
+}
+
+void AsyncUDPSocket::OnMessage(Message* msg) {
+  SendPendingPackets();
 }
 
 int AsyncUDPSocket::Close() {
+  SendPendingPackets();
   return socket_->Close();
 }
 
@@ -114,6 +202,25 @@ void AsyncUDPSocket::SetError(int error) {
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
+  if (!receive_buffers_.empty()) {
+    int count = socket_->RecvMultipleFrom(receive_buffers_);
+    if (count < 0) {
+      // See below.
+      SocketAddress local_addr = socket_->GetLocalAddress();
+      RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                       << "] receive failed with error " << socket_->GetError();
+      return;
+    }
+    for (int i = 0; i < count; ++i) {
+      const Socket::ReceiveBuffer& buffer = receive_buffers_[i];
+      SignalReadPacket(
+          this, reinterpret_cast<const char*>(buffer.data.data()), buffer.size,
+          buffer.address,
+          (buffer.timestamp > -1 ? buffer.timestamp : TimeMicros()));
+    }
+    return;
+  }
+
   SocketAddress remote_addr;
   int64_t timestamp;
   int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
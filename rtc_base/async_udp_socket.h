@@ -14,9 +14,13 @@
 #include <stddef.h>
 
 #include <memory>
+#include <vector>
 
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/async_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/message_handler.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -24,8 +28,13 @@
 namespace rtc {
 
 // Provides the ability to receive packets asynchronously.  Sends are not
-// buffered since it is acceptable to drop packets under high load.
-class AsyncUDPSocket : public AsyncPacketSocket {
+// buffered since it is acceptable to drop packets under high load, except for
+// batchable packets which are held back until the last packet of their batch
+// and then sent with a single Socket::SendMultipleTo() call. Received packets
+// can similarly be read in batches with Socket::RecvMultipleFrom(), see
+// SetReceiveBatchSize(). If the socket has Socket::OPT_SEND_TIMESTAMPS
+// enabled, the sent packets signaled carry its transmit timestamps.
+class AsyncUDPSocket : public AsyncPacketSocket, public MessageHandler {
  public:
   // Binds |socket| and creates AsyncUDPSocket for it. Takes ownership
   // of |socket|. Returns null if bind() fails (|socket| is destroyed
@@ -56,7 +65,25 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Reads up to |batch_size| datagrams per read event with a single
+  // Socket::RecvMultipleFrom() call, and signals them one after the other.
+  // The receive buffer is split between them, which truncates datagrams
+  // larger than 1/|batch_size| of it (64 kB). 1, the default, reads one
+  // datagram per read event into the whole buffer.
+  void SetReceiveBatchSize(size_t batch_size);
+
  private:
+  struct PendingPacket {
+    Buffer data;
+    SentPacket sent_packet;
+  };
+
+  // Sends the pending batch. Returns false if any packet of it failed.
+  bool SendPendingPackets();
+  // Implements MessageHandler. Sends the pending batch in case the last
+  // packet of the batch never arrives, e.g. because it was dropped above.
+  void OnMessage(Message* msg) override;
+
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(AsyncSocket* socket);
   // Called when the underlying socket is ready to send.
@@ -65,6 +92,10 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   std::unique_ptr<AsyncSocket> socket_;
   char* buf_;
   size_t size_;
+  std::vector<PendingPacket> pending_packets_;
+  SocketAddress pending_address_;
+  // Slices of |buf_|, used if more than one datagram is read per read event.
+  std::vector<Socket::ReceiveBuffer> receive_buffers_;
 };
 
 }  // namespace rtc
@@ -12,7 +12,78 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined(WEBRTC_POOLED_BUFFERS)
+#include "rtc_base/memory/size_class_pool.h"
+#endif
+
 namespace rtc {
+namespace {
+
+#if defined(WEBRTC_POOLED_BUFFERS)
+// Size classes of the storage, including its header, the largest one fit for
+// a packet of the size of an Ethernet MTU.
+webrtc::SizeClassPool* StoragePool() {
+  static webrtc::SizeClassPool* const pool =
+      webrtc::SizeClassPool::Create({/*size_classes=*/{256, 512, 1024, 1600},
+                                     /*batch_size=*/16,
+                                     /*max_shared_batches=*/32});
+  return pool;
+}
+
+void* AllocateStorage(size_t size) {
+  return StoragePool()->Allocate(size);
+}
+
+void FreeStorage(void* storage, size_t size) {
+  StoragePool()->Free(storage, size);
+}
+#else
+void* AllocateStorage(size_t size) {
+  return ::operator new(size);
+}
+
+void FreeStorage(void* storage, size_t size) {
+  ::operator delete(storage);
+}
+#endif
+
+}  // namespace
+
+scoped_refptr<CopyOnWriteBuffer::Storage> CopyOnWriteBuffer::Storage::Create(
+    size_t size,
+    size_t capacity) {
+  capacity = std::max(size, capacity);
+  void* memory = AllocateStorage(sizeof(Storage) + capacity);
+  return scoped_refptr<Storage>(new (memory) Storage(size, capacity));
+}
+
+scoped_refptr<CopyOnWriteBuffer::Storage> CopyOnWriteBuffer::Storage::Create(
+    const uint8_t* data,
+    size_t size,
+    size_t capacity) {
+  scoped_refptr<Storage> storage = Create(size, capacity);
+  if (size > 0)
+    std::memcpy(storage->data(), data, size);
+  return storage;
+}
+
+CopyOnWriteBuffer::Storage::Storage(size_t size, size_t capacity)
+    : ref_count_(0), size_(size), capacity_(capacity) {}
+
+RefCountReleaseStatus CopyOnWriteBuffer::Storage::Release() const {
+  const RefCountReleaseStatus status = ref_count_.DecRef();
+  if (status == RefCountReleaseStatus::kDroppedLastRef) {
+    const size_t allocated_size = sizeof(Storage) + capacity_;
+    Storage* storage = const_cast<Storage*>(this);
+    storage->~Storage();
+    FreeStorage(storage, allocated_size);
+  }
+  return status;
+}
 
 CopyOnWriteBuffer::CopyOnWriteBuffer() : offset_(0), size_(0) {
   RTC_DCHECK(IsConsistent());
@@ -32,16 +103,15 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(const std::string& s)
     : CopyOnWriteBuffer(s.data(), s.length()) {}
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
-    : buffer_(size > 0 ? new RefCountedObject<Buffer>(size) : nullptr),
+    : buffer_(size > 0 ? Storage::Create(size, size) : nullptr),
       offset_(0),
       size_(size) {
   RTC_DCHECK(IsConsistent());
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
-    : buffer_(size > 0 || capacity > 0
-                  ? new RefCountedObject<Buffer>(size, capacity)
-                  : nullptr),
+    : buffer_(size > 0 || capacity > 0 ? Storage::Create(size, capacity)
+                                       : nullptr),
       offset_(0),
       size_(size) {
   RTC_DCHECK(IsConsistent());
@@ -61,7 +131,7 @@ void CopyOnWriteBuffer::SetSize(size_t size) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (size > 0) {
-      buffer_ = new RefCountedObject<Buffer>(size);
+      buffer_ = Storage::Create(size, size);
       offset_ = 0;
       size_ = size;
     }
@@ -84,7 +154,7 @@ void CopyOnWriteBuffer::EnsureCapacity(size_t new_capacity) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (new_capacity > 0) {
-      buffer_ = new RefCountedObject<Buffer>(0, new_capacity);
+      buffer_ = Storage::Create(0, new_capacity);
       offset_ = 0;
       size_ = 0;
     }
@@ -103,9 +173,9 @@ void CopyOnWriteBuffer::Clear() {
     return;
 
   if (buffer_->HasOneRef()) {
-    buffer_->Clear();
+    buffer_->SetSize(0);
   } else {
-    buffer_ = new RefCountedObject<Buffer>(0, capacity());
+    buffer_ = Storage::Create(0, capacity());
   }
   offset_ = 0;
   size_ = 0;
@@ -117,8 +187,7 @@ void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
     return;
   }
 
-  buffer_ = new RefCountedObject<Buffer>(buffer_->data() + offset_, size_,
-                                         new_capacity);
+  buffer_ = Storage::Create(buffer_->data() + offset_, size_, new_capacity);
   offset_ = 0;
   RTC_DCHECK(IsConsistent());
 }
@@ -14,6 +14,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <type_traits>
@@ -22,7 +23,9 @@
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/ref_count.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/ref_counter.h"
 #include "rtc_base/system/rtc_export.h"
 
 namespace rtc {
@@ -118,6 +121,13 @@ class RTC_EXPORT CopyOnWriteBuffer {
     return buffer_ ? buffer_->capacity() - offset_ : 0;
   }
 
+  // Returns true if the data is referenced from other buffers too, in which
+  // case writing to this buffer will first make a copy.
+  bool IsShared() const {
+    RTC_DCHECK(IsConsistent());
+    return buffer_ && !buffer_->HasOneRef();
+  }
+
   CopyOnWriteBuffer& operator=(const CopyOnWriteBuffer& buf) {
     RTC_DCHECK(IsConsistent());
     RTC_DCHECK(buf.IsConsistent());
@@ -163,12 +173,18 @@ class RTC_EXPORT CopyOnWriteBuffer {
                 internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
   void SetData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
     if (!buffer_) {
-      buffer_ = size > 0 ? new RefCountedObject<Buffer>(data, size) : nullptr;
+      buffer_ = size > 0 ? Storage::Create(bytes, size, size) : nullptr;
     } else if (!buffer_->HasOneRef()) {
-      buffer_ = new RefCountedObject<Buffer>(data, size, capacity());
+      buffer_ = Storage::Create(bytes, size, capacity());
+    } else if (size > buffer_->capacity()) {
+      buffer_ = Storage::Create(
+          bytes, size,
+          std::max(size, buffer_->capacity() + buffer_->capacity() / 2));
     } else {
-      buffer_->SetData(data, size);
+      std::memcpy(buffer_->data(), bytes, size);
+      buffer_->SetSize(size);
     }
     offset_ = 0;
     size_ = size;
@@ -201,7 +217,8 @@ class RTC_EXPORT CopyOnWriteBuffer {
   void AppendData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
-      buffer_ = new RefCountedObject<Buffer>(data, size);
+      buffer_ = Storage::Create(reinterpret_cast<const uint8_t*>(data), size,
+                                size);
       offset_ = 0;
       size_ = size;
       RTC_DCHECK(IsConsistent());
@@ -210,10 +227,10 @@ class RTC_EXPORT CopyOnWriteBuffer {
 
     UnshareAndEnsureCapacity(std::max(capacity(), size_ + size));
 
-    buffer_->SetSize(offset_ +
-                     size_);  // Remove data to the right of the slice.
-    buffer_->AppendData(data, size);
+    // Overwrites data to the right of the slice.
+    std::memcpy(buffer_->data() + offset_ + size_, data, size);
     size_ += size;
+    buffer_->SetSize(offset_ + size_);
 
     RTC_DCHECK(IsConsistent());
   }
@@ -262,6 +279,42 @@ class RTC_EXPORT CopyOnWriteBuffer {
   }
 
  private:
+  // The reference count and the data of a buffer, allocated at once.
+  class RTC_EXPORT alignas(std::max_align_t) Storage {
+   public:
+    static scoped_refptr<Storage> Create(size_t size, size_t capacity);
+    // Copies |size| bytes from |data|.
+    static scoped_refptr<Storage> Create(const uint8_t* data,
+                                         size_t size,
+                                         size_t capacity);
+
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    void AddRef() const { ref_count_.IncRef(); }
+    RefCountReleaseStatus Release() const;
+    bool HasOneRef() const { return ref_count_.HasOneRef(); }
+
+    template <typename T = uint8_t>
+    T* data() {
+      return reinterpret_cast<T*>(this + 1);
+    }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    void SetSize(size_t size) {
+      RTC_DCHECK_LE(size, capacity_);
+      size_ = size;
+    }
+
+   private:
+    Storage(size_t size, size_t capacity);
+    ~Storage() = default;
+
+    mutable webrtc::webrtc_impl::RefCounter ref_count_;
+    size_t size_;
+    const size_t capacity_;
+  };
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects or there is not enough capacity.
   void UnshareAndEnsureCapacity(size_t new_capacity);
@@ -276,8 +329,8 @@ class RTC_EXPORT CopyOnWriteBuffer {
     }
   }
 
-  // buffer_ is either null, or points to an rtc::Buffer with capacity > 0.
-  scoped_refptr<RefCountedObject<Buffer>> buffer_;
+  // buffer_ is either null, or points to a Storage with capacity > 0.
+  scoped_refptr<Storage> buffer_;
   // This buffer may represent a slice of a original data.
   size_t offset_;  // Offset of a current slice in the original data in buffer_.
                    // Should be 0 if the buffer_ is empty.
@@ -365,4 +365,16 @@ TEST(CopyOnWriteBufferTest, SlicesAreIndependent) {
   EXPECT_EQ(buf.cdata() + 3, slice.cdata());
 }
 
+TEST(CopyOnWriteBufferTest, IsSharedTracksOtherReferences) {
+  CopyOnWriteBuffer buf(kTestData, 10, 10);
+  EXPECT_FALSE(buf.IsShared());
+  {
+    CopyOnWriteBuffer slice = buf.Slice(3, 4);
+    EXPECT_TRUE(buf.IsShared());
+    EXPECT_TRUE(slice.IsShared());
+  }
+  EXPECT_FALSE(buf.IsShared());
+  EXPECT_FALSE(CopyOnWriteBuffer().IsShared());
+}
+
 }  // namespace rtc
@@ -14,9 +14,12 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <atomic>
 #include <string>
 #include <vector>
 
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
@@ -32,6 +35,11 @@
 // This is a guesstimate that should be enough in most cases.
 static const size_t kEventLoggerArgsStrBufferInitialSize = 256;
 static const size_t kTraceArgBufferLength = 32;
+// Events a thread can add before the logging thread writes them out. Must be a
+// power of two.
+static const uint32_t kEventRingCapacity = 1024;
+// Strings passed with TRACE_STR_COPY() are cut to this length.
+static const size_t kMaxCopiedStringLength = 23;
 
 namespace webrtc {
 
@@ -84,6 +92,167 @@ static void EventTracingThreadFunc(void* params);
 // Atomic-int fast path for avoiding logging when disabled.
 static volatile int g_event_logging_active = 0;
 
+struct TraceArg {
+  const char* name;
+  unsigned char type;
+  // Copied from webrtc/rtc_base/trace_event.h TraceValueUnion.
+  union TraceArgValue {
+    bool as_bool;
+    unsigned long long as_uint;
+    long long as_int;
+    double as_double;
+    const void* as_pointer;
+    const char* as_string;
+  } value;
+  // Copy of a TRACE_VALUE_TYPE_COPY_STRING value, which |value| points to.
+  char copied_string[kMaxCopiedStringLength + 1];
+
+  // Assert that the size of the union is equal to the size of the as_uint
+  // field since we are assigning to arbitrary types using it.
+  static_assert(sizeof(TraceArgValue) == sizeof(unsigned long long),
+                "Size of TraceArg value union is not equal to the size of "
+                "the uint field of that union.");
+};
+
+// The trace event macros pass at most two arguments.
+static const int kMaxTraceArgs = 2;
+
+struct TraceEvent {
+  const char* name;
+  const unsigned char* category_enabled;
+  char phase;
+  int num_args;
+  TraceArg args[kMaxTraceArgs];
+  uint64_t timestamp;
+};
+
+// Events of one thread, added by that thread and taken by the logging thread,
+// so that neither takes a lock. Events are dropped while the ring is full.
+class EventRing {
+ public:
+  explicit EventRing(rtc::PlatformThreadId tid) : tid_(tid) {}
+
+  // Called on the thread of the ring. Returns the event to fill in, or null if
+  // the ring is full.
+  TraceEvent* StartAdd() {
+    const uint32_t write = write_.load(std::memory_order_relaxed);
+    if (write - read_.load(std::memory_order_acquire) == kEventRingCapacity) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    return &events_[write % kEventRingCapacity];
+  }
+  void FinishAdd() {
+    write_.store(write_.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_release);
+  }
+
+  // Called on the logging thread.
+  template <typename Callback>
+  void Take(Callback callback) {
+    uint32_t read = read_.load(std::memory_order_relaxed);
+    const uint32_t write = write_.load(std::memory_order_acquire);
+    for (; read != write; ++read)
+      callback(events_[read % kEventRingCapacity]);
+    read_.store(read, std::memory_order_release);
+  }
+  void Skip() {
+    read_.store(write_.load(std::memory_order_acquire),
+                std::memory_order_release);
+  }
+  uint32_t TakeDropped() {
+    return dropped_.exchange(0, std::memory_order_relaxed);
+  }
+
+  rtc::PlatformThreadId tid() const { return tid_; }
+
+  // Set once the thread adds no more events.
+  std::atomic<bool> thread_exited{false};
+
+ private:
+  const rtc::PlatformThreadId tid_;
+  std::atomic<uint32_t> write_{0};
+  std::atomic<uint32_t> read_{0};
+  std::atomic<uint32_t> dropped_{0};
+  TraceEvent events_[kEventRingCapacity];
+};
+
+// The rings of all threads that added events. Rings outlive the logger, which
+// may be set up again, and are deleted once their thread exited and their
+// events were taken.
+class EventRings {
+ public:
+  static EventRings* Get() {
+    // Never destroyed, threads may add events while the process exits.
+    static EventRings* const rings = new EventRings();
+    return rings;
+  }
+
+  EventRing* Add(rtc::PlatformThreadId tid) {
+    EventRing* ring = new EventRing(tid);
+    rtc::CritScope lock(&crit_);
+    rings_.push_back(ring);
+    return ring;
+  }
+
+  // Calls |callback| for every ring. Rings of threads that exited are passed
+  // a last time and then deleted.
+  template <typename Callback>
+  void ForEach(Callback callback) {
+    std::vector<EventRing*> rings;
+    std::vector<EventRing*> exited_rings;
+    {
+      rtc::CritScope lock(&crit_);
+      rings.reserve(rings_.size());
+      for (EventRing* ring : rings_) {
+        if (ring->thread_exited.load(std::memory_order_acquire))
+          exited_rings.push_back(ring);
+        else
+          rings.push_back(ring);
+      }
+      rings_ = rings;
+    }
+    for (EventRing* ring : rings)
+      callback(ring);
+    for (EventRing* ring : exited_rings) {
+      callback(ring);
+      delete ring;
+    }
+  }
+
+ private:
+  rtc::CriticalSection crit_;
+  std::vector<EventRing*> rings_ RTC_GUARDED_BY(crit_);
+};
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+
+ABSL_CONST_INIT thread_local bool thread_event_ring_destroyed = false;
+
+class ThreadEventRing {
+ public:
+  ~ThreadEventRing() {
+    thread_event_ring_destroyed = true;
+    if (ring)
+      ring->thread_exited.store(true, std::memory_order_release);
+  }
+
+  EventRing* ring = nullptr;
+};
+
+// Returns null once the ring of the thread is released, for events added after
+// that while the thread exits.
+EventRing* CurrentThreadEventRing() {
+  if (thread_event_ring_destroyed)
+    return nullptr;
+  static thread_local ThreadEventRing thread_ring;
+  if (!thread_ring.ring)
+    thread_ring.ring = EventRings::Get()->Add(rtc::CurrentThreadId());
+  return thread_ring.ring;
+}
+
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
 // TODO(pbos): Log metadata for all threads, etc.
 class EventLogger final {
  public:
@@ -101,28 +270,43 @@ class EventLogger final {
                      const char** arg_names,
                      const unsigned char* arg_types,
                      const unsigned long long* arg_values,
-                     uint64_t timestamp,
-                     int pid,
-                     rtc::PlatformThreadId thread_id) {
-    std::vector<TraceArg> args(num_args);
+                     uint64_t timestamp) {
+    RTC_DCHECK_LE(num_args, kMaxTraceArgs);
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+    EventRing* ring = CurrentThreadEventRing();
+    if (!ring)
+      return;
+#else
+    // Without thread local storage all threads share one ring.
+    static EventRing* const shared_ring =
+        EventRings::Get()->Add(rtc::CurrentThreadId());
+    static rtc::CriticalSection* const shared_ring_crit =
+        new rtc::CriticalSection();
+    EventRing* ring = shared_ring;
+    rtc::CritScope lock(shared_ring_crit);
+#endif
+    TraceEvent* event = ring->StartAdd();
+    if (!event)
+      return;
+    event->name = name;
+    event->category_enabled = category_enabled;
+    event->phase = phase;
+    event->num_args = num_args;
     for (int i = 0; i < num_args; ++i) {
-      TraceArg& arg = args[i];
+      TraceArg& arg = event->args[i];
       arg.name = arg_names[i];
       arg.type = arg_types[i];
       arg.value.as_uint = arg_values[i];
 
       // Value is a pointer to a temporary string, so we have to make a copy.
       if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-        // Space for the string and for the terminating null character.
-        size_t str_length = strlen(arg.value.as_string) + 1;
-        char* str_copy = new char[str_length];
-        memcpy(str_copy, arg.value.as_string, str_length);
-        arg.value.as_string = str_copy;
+        strncpy(arg.copied_string, arg.value.as_string, kMaxCopiedStringLength);
+        arg.copied_string[kMaxCopiedStringLength] = '\0';
+        arg.value.as_string = arg.copied_string;
       }
     }
-    rtc::CritScope lock(&crit_);
-    trace_events_.push_back(
-        {name, category_enabled, phase, args, timestamp, 1, thread_id});
+    event->timestamp = timestamp;
+    ring->FinishAdd();
   }
 
   // The TraceEvent format is documented here:
@@ -132,54 +316,45 @@ class EventLogger final {
     static const int kLoggingIntervalMs = 100;
     fprintf(output_file_, "{ \"traceEvents\": [\n");
     bool has_logged_event = false;
+    std::string args_str;
+    args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
+    uint32_t dropped_events = 0;
     while (true) {
       bool shutting_down = shutdown_event_.Wait(kLoggingIntervalMs);
-      std::vector<TraceEvent> events;
-      {
-        rtc::CritScope lock(&crit_);
-        trace_events_.swap(events);
-      }
-      std::string args_str;
-      args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
-      for (TraceEvent& e : events) {
-        args_str.clear();
-        if (!e.args.empty()) {
-          args_str += ", \"args\": {";
-          bool is_first_argument = true;
-          for (TraceArg& arg : e.args) {
-            if (!is_first_argument)
-              args_str += ",";
-            is_first_argument = false;
-            args_str += " \"";
-            args_str += arg.name;
-            args_str += "\": ";
-            args_str += TraceArgValueAsString(arg);
-
-            // Delete our copy of the string.
-            if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-              delete[] arg.value.as_string;
-              arg.value.as_string = nullptr;
+      EventRings::Get()->ForEach([&](EventRing* ring) {
+        ring->Take([&](const TraceEvent& e) {
+          args_str.clear();
+          if (e.num_args > 0) {
+            args_str += ", \"args\": {";
+            for (int i = 0; i < e.num_args; ++i) {
+              if (i > 0)
+                args_str += ",";
+              args_str += " \"";
+              args_str += e.args[i].name;
+              args_str += "\": ";
+              args_str += TraceArgValueAsString(e.args[i]);
             }
+            args_str += " }";
           }
-          args_str += " }";
-        }
-        fprintf(output_file_,
-                "%s{ \"name\": \"%s\""
-                ", \"cat\": \"%s\""
-                ", \"ph\": \"%c\""
-                ", \"ts\": %" PRIu64
-                ", \"pid\": %d"
+          fprintf(output_file_,
+                  "%s{ \"name\": \"%s\""
+                  ", \"cat\": \"%s\""
+                  ", \"ph\": \"%c\""
+                  ", \"ts\": %" PRIu64
+                  ", \"pid\": %d"
 #if defined(WEBRTC_WIN)
-                ", \"tid\": %lu"
+                  ", \"tid\": %lu"
 #else
-                ", \"tid\": %d"
+                  ", \"tid\": %d"
 #endif  // defined(WEBRTC_WIN)
-                "%s"
-                "}\n",
-                has_logged_event ? "," : " ", e.name, e.category_enabled,
-                e.phase, e.timestamp, e.pid, e.tid, args_str.c_str());
-        has_logged_event = true;
-      }
+                  "%s"
+                  "}\n",
+                  has_logged_event ? "," : " ", e.name, e.category_enabled,
+                  e.phase, e.timestamp, 1, ring->tid(), args_str.c_str());
+          has_logged_event = true;
+        });
+        dropped_events += ring->TakeDropped();
+      });
       if (shutting_down)
         break;
     }
@@ -187,6 +362,11 @@ class EventLogger final {
     if (output_file_owned_)
       fclose(output_file_);
     output_file_ = nullptr;
+    if (dropped_events > 0) {
+      RTC_LOG(LS_WARNING) << "Dropped " << dropped_events
+                          << " trace events, the logging thread didn't keep "
+                             "up.";
+    }
   }
 
   void Start(FILE* file, bool owned) {
@@ -195,14 +375,14 @@ class EventLogger final {
     RTC_DCHECK(!output_file_);
     output_file_ = file;
     output_file_owned_ = owned;
-    {
-      rtc::CritScope lock(&crit_);
-      // Since the atomic fast-path for adding events to the queue can be
-      // bypassed while the logging thread is shutting down there may be some
-      // stale events in the queue, hence the vector needs to be cleared to not
-      // log events from a previous logging session (which may be days old).
-      trace_events_.clear();
-    }
+    // Since the atomic fast-path for adding events to the rings can be
+    // bypassed while the logging thread is shutting down there may be some
+    // stale events in the rings, hence they need to be skipped to not log
+    // events from a previous logging session (which may be days old).
+    EventRings::Get()->ForEach([](EventRing* ring) {
+      ring->Skip();
+      ring->TakeDropped();
+    });
     // Enable event logging (fast-path). This should be disabled since starting
     // shouldn't be done twice.
     RTC_CHECK_EQ(0,
@@ -227,37 +407,7 @@ class EventLogger final {
   }
 
  private:
-  struct TraceArg {
-    const char* name;
-    unsigned char type;
-    // Copied from webrtc/rtc_base/trace_event.h TraceValueUnion.
-    union TraceArgValue {
-      bool as_bool;
-      unsigned long long as_uint;
-      long long as_int;
-      double as_double;
-      const void* as_pointer;
-      const char* as_string;
-    } value;
-
-    // Assert that the size of the union is equal to the size of the as_uint
-    // field since we are assigning to arbitrary types using it.
-    static_assert(sizeof(TraceArgValue) == sizeof(unsigned long long),
-                  "Size of TraceArg value union is not equal to the size of "
-                  "the uint field of that union.");
-  };
-
-  struct TraceEvent {
-    const char* name;
-    const unsigned char* category_enabled;
-    char phase;
-    std::vector<TraceArg> args;
-    uint64_t timestamp;
-    int pid;
-    rtc::PlatformThreadId tid;
-  };
-
-  static std::string TraceArgValueAsString(TraceArg arg) {
+  static std::string TraceArgValueAsString(const TraceArg& arg) {
     std::string output;
 
     if (arg.type == TRACE_VALUE_TYPE_STRING ||
@@ -317,8 +467,6 @@ class EventLogger final {
     return output;
   }
 
-  rtc::CriticalSection crit_;
-  std::vector<TraceEvent> trace_events_ RTC_GUARDED_BY(crit_);
   rtc::PlatformThread logging_thread_;
   rtc::Event shutdown_event_;
   rtc::ThreadChecker thread_checker_;
@@ -359,7 +507,7 @@ void InternalAddTraceEvent(char phase,
 
   g_event_logger->AddTraceEvent(name, category_enabled, phase, num_args,
                                 arg_names, arg_types, arg_values,
-                                rtc::TimeMicros(), 1, rtc::CurrentThreadId());
+                                rtc::TimeMicros());
 }
 
 }  // namespace
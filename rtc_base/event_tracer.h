@@ -69,7 +69,10 @@ class EventTracer {
 
 namespace rtc {
 namespace tracing {
-// Set up internal event tracer.
+// Set up internal event tracer. Threads add events to buffers of their own
+// without taking a lock, and a background thread writes them out in the
+// Chrome trace format. Events of a thread that adds more than the buffer holds
+// between two writes are dropped.
 void SetupInternalTracer();
 bool StartInternalCapture(const char* filename);
 void StartInternalCaptureToFile(FILE* file);
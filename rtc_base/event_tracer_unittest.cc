@@ -10,7 +10,12 @@
 
 #include "rtc_base/event_tracer.h"
 
+#include <stdio.h>
+
+#include <string>
+
 #include "rtc_base/critical_section.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/trace_event.h"
 #include "test/gtest.h"
@@ -76,6 +81,36 @@ TEST(EventTracerTest, ScopedTraceEvent) {
   EXPECT_EQ(2, TestStatistics::Get()->Count());
   TestStatistics::Get()->Reset();
 }
+
+TEST(EventTracerTest, InternalTracerWritesEventsOfAllThreads) {
+  rtc::tracing::SetupInternalTracer();
+  FILE* file = tmpfile();
+  ASSERT_TRUE(file);
+  rtc::tracing::StartInternalCaptureToFile(file);
+
+  // The thread exits before its events are written.
+  rtc::PlatformThread thread(
+      [](void*) { TRACE_EVENT_INSTANT0("test", "OtherThreadEvent"); }, nullptr,
+      "tracing");
+  thread.Start();
+  thread.Stop();
+  std::string value = "copied";
+  TRACE_EVENT_INSTANT1("test", "CopiedArgEvent", "arg",
+                       TRACE_STR_COPY(value.c_str()));
+  value = "changed";
+  rtc::tracing::StopInternalCapture();
+  rtc::tracing::ShutdownInternalTracer();
+
+  std::string contents;
+  rewind(file);
+  char buffer[256];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    contents.append(buffer, read);
+  fclose(file);
+  EXPECT_NE(contents.find("\"OtherThreadEvent\""), std::string::npos);
+  EXPECT_NE(contents.find("\"arg\": \"copied\""), std::string::npos);
+}
 #endif
 
 }  // namespace webrtc
@@ -0,0 +1,912 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_socket_server.h"
+
+#if defined(WEBRTC_USE_IO_URING)
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+namespace {
+
+// The buffers of the received datagrams, all in one buffer group.
+constexpr uint32_t kRecvBuffers = 256;
+constexpr uint16_t kBufferGroup = 0;
+// The layout of a filled buffer is io_uring_recvmsg_out, the address, the
+// control messages then the payload. The address and control sizes are those
+// requested, whatever their actual size, and keep the control messages
+// aligned.
+constexpr size_t kNameSize = 32;
+constexpr size_t kControlSize = CMSG_SPACE(sizeof(timeval));
+constexpr size_t kRecvHeaderSize =
+    sizeof(io_uring_recvmsg_out) + kNameSize + kControlSize;
+constexpr size_t kRecvBufferSize =
+    kRecvHeaderSize + IoUringSocketServer::kMaxDatagramSize;
+static_assert(sizeof(sockaddr_in6) <= kNameSize, "Too small for IPv6");
+static_assert(kRecvBufferSize % alignof(cmsghdr) == 0, "Misaligned buffers");
+
+// Larger packets are sent synchronously.
+constexpr uint32_t kSendSlots = 256;
+constexpr size_t kMaxSendSize = 2048;
+
+constexpr uint32_t kSubmissionEntries = 256;
+constexpr uint32_t kCompletionEntries = 4 * kRecvBuffers;
+
+// The low byte of the user data of a request tells its kind, the rest the
+// socket or the send slot it is for.
+enum RequestTag : uint64_t { kRecvTag = 1, kSendTag = 2, kCancelTag = 3 };
+
+uint64_t UserData(RequestTag tag, uint32_t key) {
+  return (static_cast<uint64_t>(key) << 8) | tag;
+}
+
+template <typename T>
+T LoadAcquire(const T* value) {
+  return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+void StoreRelease(T* value, T new_value) {
+  __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+}
+
+void* MapMemory(size_t size, int fd, off_t offset) {
+  void* memory =
+      fd < 0 ? mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0)
+             : mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, offset);
+  return memory == MAP_FAILED ? nullptr : memory;
+}
+
+}  // namespace
+
+// Owns the io_uring instance, the received buffers and the send slots. Its
+// descriptor is readable when completions are queued, which is how the epoll
+// loop of the PhysicalSocketServer learns about them.
+class IoUringSocketServer::Ring : public Dispatcher {
+ public:
+  // Defers the submission of the queued requests to the end of the scope.
+  class BatchScope {
+   public:
+    explicit BatchScope(Ring* ring) : ring_(ring) { ++ring_->batch_depth_; }
+    ~BatchScope() {
+      if (--ring_->batch_depth_ == 0)
+        ring_->Submit();
+    }
+
+   private:
+    Ring* const ring_;
+  };
+
+  static std::unique_ptr<Ring> Create();
+  ~Ring() override;
+
+  // Dispatcher:
+  uint32_t GetRequestedEvents() override { return DE_READ; }
+  void OnPreEvent(uint32_t ff) override {}
+  void OnEvent(uint32_t ff, int err) override { ProcessCompletions(); }
+  int GetDescriptor() override { return fd_; }
+  bool IsDescriptorClosed() override { return false; }
+
+  bool multishot_supported() const { return multishot_supported_; }
+  bool delivering_reads() const { return delivering_reads_; }
+  const uint8_t* buffer(uint16_t bid) const {
+    return buffers_ + static_cast<size_t>(bid) * kRecvBufferSize;
+  }
+
+  uint32_t AddSocket(UdpSocket* socket);
+  void RemoveSocket(uint32_t id);
+
+  // Arms the multishot receive of the socket |id|, or arms it once buffers
+  // are returned if all are held.
+  void ArmRecv(uint32_t id);
+  void CancelRecv(uint32_t id);
+  // Copies the packet for an asynchronous send by the socket |id|. Returns
+  // false if it is too large or all the slots are in use.
+  bool QueueSend(uint32_t id,
+                 int fd,
+                 const void* data,
+                 size_t size,
+                 const sockaddr_storage& addr,
+                 socklen_t addr_len);
+  void ReturnBuffer(uint16_t bid);
+  // Queues the socket to be signaled by DeliverPendingReads().
+  void MarkReady(UdpSocket* socket);
+
+  // Submits the queued requests.
+  void Submit();
+  // Queues the completed datagrams for their sockets, before signaling them.
+  void ProcessCompletions();
+
+  IoUringSocketServer::Stats& stats() { return stats_; }
+
+ private:
+  struct SendSlot {
+    uint32_t socket_id;
+    msghdr msg;
+    iovec iov;
+    sockaddr_storage addr;
+    uint8_t data[kMaxSendSize];
+  };
+
+  Ring() = default;
+  bool Init();
+
+  UdpSocket* FindSocket(uint32_t id) const;
+  io_uring_sqe* GetSqe();
+  void MaybeSubmit();
+  void HandleCompletion(const io_uring_cqe& cqe);
+  void HandleRecvCompletion(uint32_t id, const io_uring_cqe& cqe);
+  void DeliverPendingReads();
+  void RearmStoppedRecvs();
+
+  int fd_ = -1;
+  bool multishot_supported_ = true;
+  int batch_depth_ = 0;
+  // Submitted requests whose last completion is still to come.
+  int in_flight_ = 0;
+
+  void* ring_memory_ = nullptr;
+  size_t ring_memory_size_ = 0;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t local_sq_tail_ = 0;
+  uint32_t submitted_tail_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  io_uring_buf_ring* buf_ring_ = nullptr;
+  size_t buf_ring_size_ = 0;
+  uint16_t buf_ring_tail_ = 0;
+  uint8_t* buffers_ = nullptr;
+  // Buffers picked by the kernel and not returned yet.
+  uint32_t held_buffers_ = 0;
+
+  std::unique_ptr<SendSlot[]> send_slots_;
+  std::vector<uint32_t> free_send_slots_;
+
+  uint32_t next_socket_id_ = 1;
+  // Looked up by id, so that the completions of closed sockets are ignored.
+  std::map<uint32_t, UdpSocket*> sockets_;
+  std::vector<uint32_t> ready_ids_;
+  std::vector<uint32_t> delivered_ids_;
+  bool delivering_reads_ = false;
+  std::vector<uint32_t> stopped_ids_;
+
+  IoUringSocketServer::Stats stats_;
+};
+
+class IoUringSocketServer::UdpSocket : public SocketDispatcher {
+ public:
+  struct Datagram {
+    uint16_t bid;
+    uint32_t size;
+  };
+
+  UdpSocket(IoUringSocketServer* ss, Ring* ring)
+      : SocketDispatcher(ss), ring_(ring) {}
+  ~UdpSocket() override { Close(); }
+
+  using SocketDispatcher::Create;
+  bool Create(int family, int type) override;
+
+  uint32_t GetRequestedEvents() override;
+
+  int SetOption(Option opt, int value) override;
+  int SendTo(const void* buffer,
+             size_t length,
+             const SocketAddress& addr) override;
+  int SendMultipleTo(ArrayView<const ArrayView<const uint8_t>> packets,
+                     const SocketAddress& addr) override;
+  int Recv(void* buffer, size_t length, int64_t* timestamp) override;
+  int RecvFrom(void* buffer,
+               size_t length,
+               SocketAddress* out_addr,
+               int64_t* timestamp) override;
+  int RecvMultipleFrom(ArrayView<ReceiveBuffer> buffers) override;
+
+  int Close() override;
+
+  // Called by the ring.
+  int descriptor() const { return s_; }
+  uint32_t ring_id() const { return ring_id_; }
+  msghdr* recv_msg() { return &recv_msg_; }
+  bool listed() const { return listed_; }
+  void set_listed(bool listed) { listed_ = listed; }
+  void OnRecvArmed() { recv_armed_ = true; }
+  void OnRecvStopped() { recv_armed_ = false; }
+  void OnSendBlocked() { EnableEvents(DE_WRITE); }
+  void OnDatagram(uint16_t bid, uint32_t size) {
+    datagrams_.push_back({bid, size});
+    received_any_ = true;
+  }
+  bool received_any() const { return received_any_; }
+  size_t pending_datagrams() const { return datagrams_.size(); }
+  bool CanSignalRead() const {
+    return !datagrams_.empty() && (enabled_events() & DE_READ);
+  }
+  void SignalPendingRead() {
+    DisableEvents(DE_READ);
+    SignalReadEvent(this);
+  }
+  // For kernels without multishot receives, the socket is polled as usual.
+  void FallBackToPolledReads();
+
+ protected:
+  void EnableEvents(uint8_t events) override;
+  void DisableEvents(uint8_t events) override;
+
+ private:
+  // Copies the oldest datagram into |buffer| and returns it to the ring.
+  void PopDatagram(ReceiveBuffer* buffer);
+  int SendSynchronously(const void* buffer,
+                        size_t length,
+                        const SocketAddress& addr);
+
+  Ring* const ring_;
+  // Whether the reads go through the ring rather than recvmsg().
+  bool ring_reads_ = false;
+  uint32_t ring_id_ = 0;
+  bool recv_armed_ = false;
+  bool received_any_ = false;
+  bool listed_ = false;
+  msghdr recv_msg_ = {};
+  std::deque<Datagram> datagrams_;
+};
+
+std::unique_ptr<IoUringSocketServer::Ring> IoUringSocketServer::Ring::Create() {
+  std::unique_ptr<Ring> ring(new Ring());
+  if (!ring->Init())
+    return nullptr;
+  return ring;
+}
+
+bool IoUringSocketServer::Ring::Init() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = kCompletionEntries;
+  fd_ = static_cast<int>(
+      syscall(__NR_io_uring_setup, kSubmissionEntries, &params));
+  if (fd_ < 0) {
+    RTC_LOG_ERR(LS_WARNING) << "io_uring_setup failed";
+    return false;
+  }
+  if (!(params.features & IORING_FEAT_SINGLE_MMAP) ||
+      !(params.features & IORING_FEAT_NODROP)) {
+    RTC_LOG(LS_WARNING) << "io_uring is too old";
+    return false;
+  }
+
+  ring_memory_size_ =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  ring_memory_ = MapMemory(ring_memory_size_, fd_, IORING_OFF_SQ_RING);
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ =
+      static_cast<io_uring_sqe*>(MapMemory(sqes_size_, fd_, IORING_OFF_SQES));
+  if (!ring_memory_ || !sqes_) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to map the io_uring rings";
+    return false;
+  }
+  uint8_t* ring_memory = static_cast<uint8_t*>(ring_memory_);
+  sq_head_ = reinterpret_cast<uint32_t*>(ring_memory + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(ring_memory + params.sq_off.tail);
+  sq_mask_ =
+      *reinterpret_cast<uint32_t*>(ring_memory + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  local_sq_tail_ = submitted_tail_ = *sq_tail_;
+  // The entries are always submitted in order.
+  uint32_t* sq_array =
+      reinterpret_cast<uint32_t*>(ring_memory + params.sq_off.array);
+  for (uint32_t i = 0; i < sq_entries_; ++i)
+    sq_array[i] = i;
+  cq_head_ = reinterpret_cast<uint32_t*>(ring_memory + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(ring_memory + params.cq_off.tail);
+  cq_mask_ =
+      *reinterpret_cast<uint32_t*>(ring_memory + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(ring_memory + params.cq_off.cqes);
+
+  buf_ring_size_ = kRecvBuffers * sizeof(io_uring_buf);
+  buf_ring_ =
+      static_cast<io_uring_buf_ring*>(MapMemory(buf_ring_size_, -1, 0));
+  buffers_ =
+      static_cast<uint8_t*>(MapMemory(kRecvBuffers * kRecvBufferSize, -1, 0));
+  if (!buf_ring_ || !buffers_) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to allocate the receive buffers";
+    return false;
+  }
+  io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = reinterpret_cast<uintptr_t>(buf_ring_);
+  reg.ring_entries = kRecvBuffers;
+  reg.bgid = kBufferGroup;
+  if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PBUF_RING, &reg,
+              1) != 0) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to register the receive buffers";
+    return false;
+  }
+  held_buffers_ = kRecvBuffers;
+  for (uint32_t bid = 0; bid < kRecvBuffers; ++bid)
+    ReturnBuffer(static_cast<uint16_t>(bid));
+
+  send_slots_.reset(new SendSlot[kSendSlots]);
+  free_send_slots_.reserve(kSendSlots);
+  for (uint32_t slot = kSendSlots; slot > 0; --slot)
+    free_send_slots_.push_back(slot - 1);
+  return true;
+}
+
+IoUringSocketServer::Ring::~Ring() {
+  RTC_DCHECK(sockets_.empty()) << "Sockets must be destroyed first";
+  if (fd_ >= 0 && sqes_) {
+    // The kernel may still write to the buffers until the last completions.
+    if (io_uring_sqe* sqe = GetSqe()) {
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = -1;
+      sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+      sqe->user_data = UserData(kCancelTag, 0);
+      ++in_flight_;
+    }
+    while (in_flight_ > 0) {
+      const uint32_t to_submit = local_sq_tail_ - submitted_tail_;
+      StoreRelease(sq_tail_, local_sq_tail_);
+      const long result = syscall(__NR_io_uring_enter, fd_, to_submit, 1,
+                                  IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (result < 0 && errno != EINTR) {
+        RTC_LOG_ERR(LS_ERROR) << "Failed to wait for the io_uring requests";
+        break;
+      }
+      if (result > 0)
+        submitted_tail_ += static_cast<uint32_t>(result);
+      uint32_t head = *cq_head_;
+      const uint32_t tail = LoadAcquire(cq_tail_);
+      for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+        if ((cqe.user_data & 0xff) != kRecvTag ||
+            !(cqe.flags & IORING_CQE_F_MORE)) {
+          --in_flight_;
+        }
+      }
+      StoreRelease(cq_head_, head);
+    }
+  }
+  if (fd_ >= 0)
+    close(fd_);
+  if (ring_memory_)
+    munmap(ring_memory_, ring_memory_size_);
+  if (sqes_)
+    munmap(sqes_, sqes_size_);
+  if (buf_ring_)
+    munmap(buf_ring_, buf_ring_size_);
+  if (buffers_)
+    munmap(buffers_, kRecvBuffers * kRecvBufferSize);
+}
+
+uint32_t IoUringSocketServer::Ring::AddSocket(UdpSocket* socket) {
+  const uint32_t id = next_socket_id_++;
+  sockets_[id] = socket;
+  return id;
+}
+
+void IoUringSocketServer::Ring::RemoveSocket(uint32_t id) {
+  sockets_.erase(id);
+}
+
+IoUringSocketServer::UdpSocket* IoUringSocketServer::Ring::FindSocket(
+    uint32_t id) const {
+  auto it = sockets_.find(id);
+  return it == sockets_.end() ? nullptr : it->second;
+}
+
+void IoUringSocketServer::Ring::ArmRecv(uint32_t id) {
+  UdpSocket* socket = FindSocket(id);
+  if (!socket)
+    return;
+  io_uring_sqe* sqe = held_buffers_ < kRecvBuffers ? GetSqe() : nullptr;
+  if (!sqe) {
+    stopped_ids_.push_back(id);
+    return;
+  }
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = socket->descriptor();
+  sqe->addr = reinterpret_cast<uintptr_t>(socket->recv_msg());
+  sqe->len = 1;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = kBufferGroup;
+  sqe->user_data = UserData(kRecvTag, id);
+  ++in_flight_;
+  socket->OnRecvArmed();
+  MaybeSubmit();
+}
+
+void IoUringSocketServer::Ring::CancelRecv(uint32_t id) {
+  io_uring_sqe* sqe = GetSqe();
+  if (!sqe) {
+    // Cancelled with the others when the ring is destroyed, its datagrams
+    // being dropped until then.
+    return;
+  }
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = UserData(kRecvTag, id);
+  sqe->user_data = UserData(kCancelTag, id);
+  ++in_flight_;
+  MaybeSubmit();
+}
+
+bool IoUringSocketServer::Ring::QueueSend(uint32_t id,
+                                          int fd,
+                                          const void* data,
+                                          size_t size,
+                                          const sockaddr_storage& addr,
+                                          socklen_t addr_len) {
+  if (size > kMaxSendSize || free_send_slots_.empty())
+    return false;
+  io_uring_sqe* sqe = GetSqe();
+  if (!sqe)
+    return false;
+  const uint32_t slot_index = free_send_slots_.back();
+  free_send_slots_.pop_back();
+  SendSlot& slot = send_slots_[slot_index];
+  slot.socket_id = id;
+  memcpy(slot.data, data, size);
+  memcpy(&slot.addr, &addr, addr_len);
+  slot.iov.iov_base = slot.data;
+  slot.iov.iov_len = size;
+  memset(&slot.msg, 0, sizeof(slot.msg));
+  slot.msg.msg_name = &slot.addr;
+  slot.msg.msg_namelen = addr_len;
+  slot.msg.msg_iov = &slot.iov;
+  slot.msg.msg_iovlen = 1;
+
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uintptr_t>(&slot.msg);
+  sqe->len = 1;
+  // Suppress SIGPIPE, as PhysicalSocket does. Without MSG_DONTWAIT, the
+  // sends finding the socket buffer full would hold their slot until it
+  // drains, instead of failing like the synchronous sends.
+  sqe->msg_flags = MSG_NOSIGNAL | MSG_DONTWAIT;
+  sqe->user_data = UserData(kSendTag, slot_index);
+  ++in_flight_;
+  ++stats_.datagrams_sent;
+  MaybeSubmit();
+  return true;
+}
+
+void IoUringSocketServer::Ring::ReturnBuffer(uint16_t bid) {
+  RTC_DCHECK_GT(held_buffers_, 0);
+  // Not through |bufs|, offset in C++ by the empty struct of its declaration.
+  io_uring_buf* buf = reinterpret_cast<io_uring_buf*>(buf_ring_) +
+                      (buf_ring_tail_ & (kRecvBuffers - 1));
+  buf->addr = reinterpret_cast<uintptr_t>(buffer(bid));
+  buf->len = kRecvBufferSize;
+  buf->bid = bid;
+  ++buf_ring_tail_;
+  StoreRelease(&buf_ring_->tail, buf_ring_tail_);
+  --held_buffers_;
+}
+
+void IoUringSocketServer::Ring::MarkReady(UdpSocket* socket) {
+  if (socket->listed())
+    return;
+  socket->set_listed(true);
+  ready_ids_.push_back(socket->ring_id());
+}
+
+io_uring_sqe* IoUringSocketServer::Ring::GetSqe() {
+  if (local_sq_tail_ - LoadAcquire(sq_head_) >= sq_entries_) {
+    Submit();
+    if (local_sq_tail_ - LoadAcquire(sq_head_) >= sq_entries_)
+      return nullptr;
+  }
+  io_uring_sqe* sqe = &sqes_[local_sq_tail_ & sq_mask_];
+  memset(sqe, 0, sizeof(*sqe));
+  ++local_sq_tail_;
+  return sqe;
+}
+
+void IoUringSocketServer::Ring::MaybeSubmit() {
+  if (batch_depth_ == 0)
+    Submit();
+}
+
+void IoUringSocketServer::Ring::Submit() {
+  const uint32_t to_submit = local_sq_tail_ - submitted_tail_;
+  if (to_submit == 0)
+    return;
+  StoreRelease(sq_tail_, local_sq_tail_);
+  const long result =
+      syscall(__NR_io_uring_enter, fd_, to_submit, 0, 0, nullptr, 0);
+  ++stats_.submissions;
+  if (result < 0) {
+    // Retried with the next submission.
+    RTC_LOG_ERR(LS_WARNING) << "io_uring_enter failed";
+    return;
+  }
+  submitted_tail_ += static_cast<uint32_t>(result);
+}
+
+void IoUringSocketServer::Ring::ProcessCompletions() {
+  BatchScope batch(this);
+  uint32_t head = *cq_head_;
+  uint32_t tail = LoadAcquire(cq_tail_);
+  while (head != tail) {
+    for (; head != tail; ++head)
+      HandleCompletion(cqes_[head & cq_mask_]);
+    StoreRelease(cq_head_, head);
+    tail = LoadAcquire(cq_tail_);
+  }
+  DeliverPendingReads();
+  RearmStoppedRecvs();
+}
+
+void IoUringSocketServer::Ring::HandleCompletion(const io_uring_cqe& cqe) {
+  const uint32_t key = static_cast<uint32_t>(cqe.user_data >> 8);
+  switch (cqe.user_data & 0xff) {
+    case kRecvTag:
+      HandleRecvCompletion(key, cqe);
+      break;
+    case kSendTag:
+      if (cqe.res == -EAGAIN || cqe.res == -EWOULDBLOCK) {
+        // The packet is dropped, and the socket signaled once writable.
+        if (UdpSocket* socket = FindSocket(send_slots_[key].socket_id))
+          socket->OnSendBlocked();
+      } else if (cqe.res < 0) {
+        RTC_LOG(LS_VERBOSE) << "io_uring send failed: " << -cqe.res;
+      }
+      free_send_slots_.push_back(key);
+      --in_flight_;
+      break;
+    case kCancelTag:
+      --in_flight_;
+      break;
+    default:
+      RTC_NOTREACHED();
+  }
+}
+
+void IoUringSocketServer::Ring::HandleRecvCompletion(uint32_t id,
+                                                     const io_uring_cqe& cqe) {
+  UdpSocket* socket = FindSocket(id);
+  if (cqe.flags & IORING_CQE_F_BUFFER) {
+    const uint16_t bid =
+        static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+    ++held_buffers_;
+    if (socket && cqe.res >= static_cast<int>(kRecvHeaderSize)) {
+      io_uring_recvmsg_out out;
+      memcpy(&out, buffer(bid), sizeof(out));
+      const uint32_t size = std::min<uint32_t>(
+          out.payloadlen, static_cast<uint32_t>(cqe.res - kRecvHeaderSize));
+      if (out.payloadlen > size || (out.flags & MSG_TRUNC))
+        ++stats_.truncated_datagrams;
+      socket->OnDatagram(bid, size);
+      MarkReady(socket);
+    } else {
+      ReturnBuffer(bid);
+    }
+  }
+  if (cqe.flags & IORING_CQE_F_MORE)
+    return;
+  --in_flight_;
+  if (!socket)
+    return;
+  socket->OnRecvStopped();
+  if (cqe.res == -EINVAL && !socket->received_any()) {
+    RTC_LOG(LS_INFO) << "No multishot receives, polling the sockets instead";
+    multishot_supported_ = false;
+    socket->FallBackToPolledReads();
+  } else if (cqe.res != -ECANCELED) {
+    // Typically ENOBUFS, all the buffers being held.
+    stopped_ids_.push_back(id);
+  }
+}
+
+void IoUringSocketServer::Ring::DeliverPendingReads() {
+  if (delivering_reads_ || ready_ids_.empty())
+    return;
+  delivering_reads_ = true;
+  delivered_ids_.swap(ready_ids_);
+  for (uint32_t id : delivered_ids_) {
+    UdpSocket* socket = FindSocket(id);
+    if (socket)
+      socket->set_listed(false);
+    // Signaled until it stops reading, like a level triggered descriptor.
+    // The handlers may destroy any socket.
+    while (socket && socket->CanSignalRead()) {
+      const size_t pending = socket->pending_datagrams();
+      socket->SignalPendingRead();
+      socket = FindSocket(id);
+      if (socket && socket->pending_datagrams() >= pending)
+        break;
+    }
+    // Those left are signaled again by the next Wait().
+    if (socket && socket->pending_datagrams() > 0)
+      MarkReady(socket);
+  }
+  delivered_ids_.clear();
+  delivering_reads_ = false;
+}
+
+void IoUringSocketServer::Ring::RearmStoppedRecvs() {
+  if (stopped_ids_.empty() || held_buffers_ == kRecvBuffers)
+    return;
+  std::vector<uint32_t> ids;
+  ids.swap(stopped_ids_);
+  for (uint32_t id : ids)
+    ArmRecv(id);
+}
+
+bool IoUringSocketServer::UdpSocket::Create(int family, int type) {
+  ring_reads_ = ring_->multishot_supported();
+  if (!SocketDispatcher::Create(family, type))
+    return false;
+  if (ring_reads_) {
+    // As for RecvMultipleFrom(), each datagram brings its timestamp.
+    int value = 1;
+    setsockopt(s_, SOL_SOCKET, SO_TIMESTAMP, &value, sizeof(value));
+    memset(&recv_msg_, 0, sizeof(recv_msg_));
+    recv_msg_.msg_namelen = kNameSize;
+    recv_msg_.msg_controllen = kControlSize;
+    ring_id_ = ring_->AddSocket(this);
+    ring_->ArmRecv(ring_id_);
+  }
+  return true;
+}
+
+uint32_t IoUringSocketServer::UdpSocket::GetRequestedEvents() {
+  uint32_t events = SocketDispatcher::GetRequestedEvents();
+  return ring_reads_ ? events & ~DE_READ : events;
+}
+
+int IoUringSocketServer::UdpSocket::SendTo(const void* buffer,
+                                           size_t length,
+                                           const SocketAddress& addr) {
+  sockaddr_storage saddr;
+  const socklen_t len =
+      static_cast<socklen_t>(addr.ToSockAddrStorage(&saddr));
+  if (ring_->QueueSend(ring_id_, s_, buffer, length, saddr, len))
+    return static_cast<int>(length);
+  return SendSynchronously(buffer, length, addr);
+}
+
+int IoUringSocketServer::UdpSocket::SetOption(Option opt, int value) {
+  // The sends queued on the ring complete after SendTo() returned, too late
+  // for GetSendTimestamps() to report them.
+  if (opt == OPT_SEND_TIMESTAMPS)
+    return -1;
+  return SocketDispatcher::SetOption(opt, value);
+}
+
+int IoUringSocketServer::UdpSocket::SendMultipleTo(
+    ArrayView<const ArrayView<const uint8_t>> packets,
+    const SocketAddress& addr) {
+  Ring::BatchScope batch(ring_);
+  sockaddr_storage saddr;
+  const socklen_t len =
+      static_cast<socklen_t>(addr.ToSockAddrStorage(&saddr));
+  int sent = 0;
+  for (const ArrayView<const uint8_t>& packet : packets) {
+    if (!ring_->QueueSend(ring_id_, s_, packet.data(), packet.size(), saddr,
+                          len) &&
+        SendSynchronously(packet.data(), packet.size(), addr) < 0) {
+      return sent > 0 ? sent : -1;
+    }
+    ++sent;
+  }
+  return sent;
+}
+
+int IoUringSocketServer::UdpSocket::SendSynchronously(
+    const void* buffer,
+    size_t length,
+    const SocketAddress& addr) {
+  // Keeps the packets in order.
+  ring_->Submit();
+  ++ring_->stats().synchronous_sends;
+  return SocketDispatcher::SendTo(buffer, length, addr);
+}
+
+int IoUringSocketServer::UdpSocket::Recv(void* buffer,
+                                         size_t length,
+                                         int64_t* timestamp) {
+  return RecvFrom(buffer, length, nullptr, timestamp);
+}
+
+int IoUringSocketServer::UdpSocket::RecvFrom(void* buffer,
+                                             size_t length,
+                                             SocketAddress* out_addr,
+                                             int64_t* timestamp) {
+  if (!ring_reads_)
+    return SocketDispatcher::RecvFrom(buffer, length, out_addr, timestamp);
+  EnableEvents(DE_READ);
+  if (datagrams_.empty()) {
+    SetError(EWOULDBLOCK);
+    return SOCKET_ERROR;
+  }
+  ReceiveBuffer receive_buffer;
+  receive_buffer.data =
+      ArrayView<uint8_t>(static_cast<uint8_t*>(buffer), length);
+  PopDatagram(&receive_buffer);
+  if (out_addr)
+    *out_addr = receive_buffer.address;
+  if (timestamp)
+    *timestamp = receive_buffer.timestamp;
+  return static_cast<int>(receive_buffer.size);
+}
+
+int IoUringSocketServer::UdpSocket::RecvMultipleFrom(
+    ArrayView<ReceiveBuffer> buffers) {
+  if (!ring_reads_)
+    return SocketDispatcher::RecvMultipleFrom(buffers);
+  EnableEvents(DE_READ);
+  if (datagrams_.empty()) {
+    SetError(EWOULDBLOCK);
+    return SOCKET_ERROR;
+  }
+  size_t received = 0;
+  for (; received < buffers.size() && !datagrams_.empty(); ++received)
+    PopDatagram(&buffers[received]);
+  return static_cast<int>(received);
+}
+
+void IoUringSocketServer::UdpSocket::PopDatagram(ReceiveBuffer* buffer) {
+  const Datagram datagram = datagrams_.front();
+  datagrams_.pop_front();
+  const uint8_t* data = ring_->buffer(datagram.bid);
+  io_uring_recvmsg_out out;
+  memcpy(&out, data, sizeof(out));
+
+  sockaddr_storage addr;
+  memset(&addr, 0, sizeof(addr));
+  memcpy(&addr, data + sizeof(out), std::min<size_t>(out.namelen, kNameSize));
+  SocketAddressFromSockAddrStorage(addr, &buffer->address);
+
+  buffer->timestamp = -1;
+  msghdr control;
+  memset(&control, 0, sizeof(control));
+  control.msg_control = const_cast<uint8_t*>(data + sizeof(out) + kNameSize);
+  control.msg_controllen = std::min<size_t>(out.controllen, kControlSize);
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&control); cmsg;
+       cmsg = CMSG_NXTHDR(&control, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval tv;
+      memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+      buffer->timestamp =
+          kNumMicrosecsPerSec * static_cast<int64_t>(tv.tv_sec) +
+          static_cast<int64_t>(tv.tv_usec);
+    }
+  }
+
+  buffer->size = std::min<size_t>(datagram.size, buffer->data.size());
+  memcpy(buffer->data.data(), data + kRecvHeaderSize, buffer->size);
+  ring_->ReturnBuffer(datagram.bid);
+  ++ring_->stats().datagrams_received;
+}
+
+int IoUringSocketServer::UdpSocket::Close() {
+  if (ring_id_ != 0) {
+    ring_->RemoveSocket(ring_id_);
+    if (recv_armed_)
+      ring_->CancelRecv(ring_id_);
+    ring_id_ = 0;
+    recv_armed_ = false;
+  }
+  for (const Datagram& datagram : datagrams_)
+    ring_->ReturnBuffer(datagram.bid);
+  datagrams_.clear();
+  listed_ = false;
+  return SocketDispatcher::Close();
+}
+
+void IoUringSocketServer::UdpSocket::FallBackToPolledReads() {
+  ring_->RemoveSocket(ring_id_);
+  ring_id_ = 0;
+  ring_reads_ = false;
+  ss_->Update(this);
+}
+
+void IoUringSocketServer::UdpSocket::EnableEvents(uint8_t events) {
+  if (!ring_reads_) {
+    SocketDispatcher::EnableEvents(events);
+    return;
+  }
+  // Reading never changes the descriptor polled.
+  if (events & ~DE_READ)
+    SocketDispatcher::EnableEvents(events & ~DE_READ);
+  if ((events & DE_READ) && !(enabled_events() & DE_READ)) {
+    PhysicalSocket::EnableEvents(DE_READ);
+    if (!datagrams_.empty() && !ring_->delivering_reads()) {
+      // Reads resumed out of the loop, signaled by the next Wait().
+      ring_->MarkReady(this);
+      ss_->WakeUp();
+    }
+  }
+}
+
+void IoUringSocketServer::UdpSocket::DisableEvents(uint8_t events) {
+  if (!ring_reads_) {
+    SocketDispatcher::DisableEvents(events);
+    return;
+  }
+  if (events & ~DE_READ)
+    SocketDispatcher::DisableEvents(events & ~DE_READ);
+  if (events & DE_READ)
+    PhysicalSocket::DisableEvents(DE_READ);
+}
+
+std::unique_ptr<IoUringSocketServer> IoUringSocketServer::Create() {
+  std::unique_ptr<Ring> ring = Ring::Create();
+  if (!ring)
+    return nullptr;
+  return std::unique_ptr<IoUringSocketServer>(
+      new IoUringSocketServer(std::move(ring)));
+}
+
+IoUringSocketServer::IoUringSocketServer(std::unique_ptr<Ring> ring)
+    : ring_(std::move(ring)) {
+  Add(ring_.get());
+}
+
+IoUringSocketServer::~IoUringSocketServer() {
+  Remove(ring_.get());
+}
+
+AsyncSocket* IoUringSocketServer::CreateAsyncSocket(int family, int type) {
+  if (type != SOCK_DGRAM)
+    return PhysicalSocketServer::CreateAsyncSocket(family, type);
+  UdpSocket* socket = new UdpSocket(this, ring_.get());
+  if (!socket->Create(family, type)) {
+    delete socket;
+    return nullptr;
+  }
+  return socket;
+}
+
+bool IoUringSocketServer::Wait(int cms, bool process_io) {
+  // Signals the sockets left with datagrams to read by the previous loop.
+  if (process_io)
+    ring_->ProcessCompletions();
+  return PhysicalSocketServer::Wait(cms, process_io);
+}
+
+IoUringSocketServer::Stats IoUringSocketServer::GetStats() const {
+  return ring_->stats();
+}
+
+}  // namespace rtc
+
+#endif  // WEBRTC_USE_IO_URING
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_IO_URING_SOCKET_SERVER_H_
+#define RTC_BASE_IO_URING_SOCKET_SERVER_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "rtc_base/physical_socket_server.h"
+
+namespace rtc {
+
+#if defined(WEBRTC_USE_IO_URING)
+
+// A PhysicalSocketServer whose UDP sockets do their I/O through an io_uring
+// ring instead of one recvmmsg()/sendmmsg() syscall per socket and event.
+// Each UDP socket keeps a multishot receive armed, the kernel picking the
+// buffers from a ring of buffers shared by all the sockets, and the sends made
+// while the completions are processed, or by a single SendMultipleTo(), are
+// submitted with one io_uring_enter(). The ring descriptor is polled with the
+// other descriptors, so TCP sockets and the wake ups work as with the
+// PhysicalSocketServer.
+//
+// Datagrams larger than kMaxDatagramSize are truncated. The sends complete
+// asynchronously: one finding the socket buffer full is dropped and the socket
+// signaled once writable, rather than failing with EWOULDBLOCK. As with the
+// PhysicalSocketServer, sockets must be used on the thread running Wait() and
+// be destroyed before the server.
+class IoUringSocketServer : public PhysicalSocketServer {
+ public:
+  struct Stats {
+    int64_t datagrams_received = 0;
+    int64_t truncated_datagrams = 0;
+    int64_t datagrams_sent = 0;
+    // Sent synchronously, being too large for the ring or with the ring full.
+    int64_t synchronous_sends = 0;
+    // io_uring_enter() calls submitting requests.
+    int64_t submissions = 0;
+  };
+
+  static constexpr size_t kMaxDatagramSize = 4000;
+
+  // Returns null if io_uring or one of the features it needs is unavailable,
+  // for instance on kernels older than 5.19.
+  static std::unique_ptr<IoUringSocketServer> Create();
+
+  ~IoUringSocketServer() override;
+
+  // SocketFactory:
+  AsyncSocket* CreateAsyncSocket(int family, int type) override;
+
+  // SocketServer:
+  bool Wait(int cms, bool process_io) override;
+
+  Stats GetStats() const;
+
+ private:
+  class Ring;
+  class UdpSocket;
+
+  explicit IoUringSocketServer(std::unique_ptr<Ring> ring);
+
+  const std::unique_ptr<Ring> ring_;
+};
+
+#endif  // WEBRTC_USE_IO_URING
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_IO_URING_SOCKET_SERVER_H_
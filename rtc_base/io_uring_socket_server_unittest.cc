@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_socket_server.h"
+
+#if defined(WEBRTC_USE_IO_URING)
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/gunit.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/socket_unittest.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+#define MAYBE_SKIP_IO_URING                        \
+  if (!server_) {                                  \
+    RTC_LOG(LS_INFO) << "No io_uring... skipping"; \
+    return;                                        \
+  }
+
+constexpr size_t kPacketSize = 100;
+
+// Reads all the datagrams of a socket when it is signaled.
+class DatagramReader : public sigslot::has_slots<> {
+ public:
+  explicit DatagramReader(AsyncSocket* socket) {
+    socket->SignalReadEvent.connect(this, &DatagramReader::OnReadEvent);
+  }
+
+  const std::vector<std::vector<uint8_t>>& datagrams() const {
+    return datagrams_;
+  }
+
+ private:
+  void OnReadEvent(AsyncSocket* socket) {
+    uint8_t buffer[kPacketSize * 2];
+    int64_t timestamp;
+    int received;
+    while ((received = socket->RecvFrom(buffer, sizeof(buffer), nullptr,
+                                        &timestamp)) >= 0) {
+      datagrams_.emplace_back(buffer, buffer + received);
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> datagrams_;
+};
+
+std::vector<uint8_t> Packet(int index) {
+  return std::vector<uint8_t>(kPacketSize, static_cast<uint8_t>(index));
+}
+
+class IoUringSocketServerTest : public SocketTest {
+ protected:
+  IoUringSocketServerTest() : server_(IoUringSocketServer::Create()) {
+    if (server_)
+      thread_ = std::make_unique<AutoSocketServerThread>(server_.get());
+  }
+
+  void SetUp() override {
+    if (server_)
+      SocketTest::SetUp();
+  }
+
+  std::unique_ptr<AsyncSocket> CreateBoundSocket() {
+    std::unique_ptr<AsyncSocket> socket(
+        server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+    EXPECT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+    return socket;
+  }
+
+  void SendPackets(AsyncSocket* socket, const SocketAddress& to, int count) {
+    for (int i = 0; i < count; ++i) {
+      std::vector<uint8_t> packet = Packet(i);
+      EXPECT_EQ(static_cast<int>(packet.size()),
+                socket->SendTo(packet.data(), packet.size(), to));
+    }
+  }
+
+  std::unique_ptr<IoUringSocketServer> server_;
+  std::unique_ptr<AutoSocketServerThread> thread_;
+};
+
+TEST_F(IoUringSocketServerTest, TestUdpIPv4) {
+  MAYBE_SKIP_IO_URING;
+  SocketTest::TestUdpIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, TestUdpIPv6) {
+  MAYBE_SKIP_IO_URING;
+  SocketTest::TestUdpIPv6();
+}
+
+TEST_F(IoUringSocketServerTest, TestUdpBatchIPv4) {
+  MAYBE_SKIP_IO_URING;
+  SocketTest::TestUdpBatchIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, TestUdpReceiveBatchIPv4) {
+  MAYBE_SKIP_IO_URING;
+  SocketTest::TestUdpReceiveBatchIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, TestUdpReadyToSendIPv4) {
+  MAYBE_SKIP_IO_URING;
+  SocketTest::TestUdpReadyToSendIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, TestSocketRecvTimestampIPv4) {
+  MAYBE_SKIP_IO_URING;
+  SocketTest::TestSocketRecvTimestampIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, TestTcpIPv4) {
+  MAYBE_SKIP_IO_URING;
+  SocketTest::TestTcpIPv4();
+}
+
+TEST_F(IoUringSocketServerTest, SubmitsTheSendsOfABatchAtOnce) {
+  MAYBE_SKIP_IO_URING;
+  std::unique_ptr<AsyncSocket> sender = CreateBoundSocket();
+  std::unique_ptr<AsyncSocket> receiver = CreateBoundSocket();
+  DatagramReader reader(receiver.get());
+
+  std::vector<std::vector<uint8_t>> packets;
+  std::vector<ArrayView<const uint8_t>> views;
+  for (int i = 0; i < 10; ++i)
+    packets.push_back(Packet(i));
+  for (const std::vector<uint8_t>& packet : packets)
+    views.emplace_back(packet);
+  const int64_t submissions = server_->GetStats().submissions;
+  EXPECT_EQ(10, sender->SendMultipleTo(views, receiver->GetLocalAddress()));
+  EXPECT_EQ(submissions + 1, server_->GetStats().submissions);
+
+  EXPECT_EQ_WAIT(10u, reader.datagrams().size(), kTimeout);
+  EXPECT_EQ(packets, reader.datagrams());
+  EXPECT_EQ(10, server_->GetStats().datagrams_sent);
+  EXPECT_EQ(10, server_->GetStats().datagrams_received);
+}
+
+TEST_F(IoUringSocketServerTest, ResumesReceivingAfterRunningOutOfBuffers) {
+  MAYBE_SKIP_IO_URING;
+  std::unique_ptr<AsyncSocket> sender = CreateBoundSocket();
+  std::unique_ptr<AsyncSocket> receiver = CreateBoundSocket();
+  DatagramReader reader(receiver.get());
+  int buffer_size = 1 << 20;
+  receiver->SetOption(Socket::OPT_RCVBUF, buffer_size);
+
+  // More than the buffers of the ring, sent before any is read.
+  SendPackets(sender.get(), receiver->GetLocalAddress(), 300);
+  EXPECT_EQ_WAIT(300u, reader.datagrams().size(), kTimeout);
+  for (size_t i = 0; i < reader.datagrams().size(); ++i)
+    EXPECT_EQ(Packet(static_cast<int>(i)), reader.datagrams()[i]);
+}
+
+TEST_F(IoUringSocketServerTest, ReturnsTheBuffersOfClosedSockets) {
+  MAYBE_SKIP_IO_URING;
+  std::unique_ptr<AsyncSocket> sender = CreateBoundSocket();
+  std::unique_ptr<AsyncSocket> unread = CreateBoundSocket();
+  SendPackets(sender.get(), unread->GetLocalAddress(), 200);
+  // The datagrams are held by the socket, which never reads them.
+  thread_->ProcessMessages(100);
+  unread.reset();
+
+  // Only received with the buffers |unread| held.
+  std::unique_ptr<AsyncSocket> receiver = CreateBoundSocket();
+  DatagramReader reader(receiver.get());
+  SendPackets(sender.get(), receiver->GetLocalAddress(), 200);
+  EXPECT_EQ_WAIT(200u, reader.datagrams().size(), kTimeout);
+}
+
+}  // namespace
+}  // namespace rtc
+
+#endif  // WEBRTC_USE_IO_URING
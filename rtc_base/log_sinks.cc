@@ -17,6 +17,7 @@
 
 #include "rtc_base/checks.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/strings/string_builder.h"
 
 namespace rtc {
 
@@ -73,4 +74,131 @@ CallSessionFileRotatingLogSink::CallSessionFileRotatingLogSink(
 
 CallSessionFileRotatingLogSink::~CallSessionFileRotatingLogSink() {}
 
+namespace {
+// The writer delivers the queued messages at least this often, and sooner when
+// the queue is half full.
+constexpr int kAsyncLogSinkFlushIntervalMs = 100;
+}  // namespace
+
+// A slot of the bounded queue of AsyncLogSink. The queue is the one described
+// by Dmitry Vyukov: a slot is free for the producer claiming |position| when
+// |sequence| == |position|, and holds a message for the consumer when
+// |sequence| == |position| + 1.
+struct AsyncLogSink::Slot {
+  std::atomic<size_t> sequence{0};
+  // Assigned to, so that slots reuse the storage of earlier messages.
+  std::string message;
+  LoggingSeverity severity = LS_NONE;
+  const char* tag = nullptr;
+};
+
+AsyncLogSink::AsyncLogSink(LogSink* sink, size_t max_queued_messages)
+    : sink_(sink),
+      capacity_(max_queued_messages),
+      slots_(new Slot[max_queued_messages]),
+      writer_thread_(&AsyncLogSink::WriterThread,
+                     this,
+                     "AsyncLogSink",
+                     kLowPriority) {
+  RTC_DCHECK(sink_);
+  RTC_DCHECK_GT(capacity_, 1);
+  for (size_t i = 0; i < capacity_; ++i)
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  writer_thread_.Start();
+}
+
+AsyncLogSink::~AsyncLogSink() {
+  stopping_.store(true, std::memory_order_release);
+  wake_up_.Set();
+  writer_thread_.Stop();
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message) {
+  Queue(message, LS_NONE, nullptr);
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message,
+                                LoggingSeverity severity) {
+  Queue(message, severity, nullptr);
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message,
+                                LoggingSeverity severity,
+                                const char* tag) {
+  Queue(message, severity, tag);
+}
+
+void AsyncLogSink::WriterThread(void* sink) {
+  AsyncLogSink* async_sink = static_cast<AsyncLogSink*>(sink);
+  while (true) {
+    async_sink->wake_up_.Wait(kAsyncLogSinkFlushIntervalMs);
+    // Messages queued before the sink was stopped are delivered below.
+    const bool stopping =
+        async_sink->stopping_.load(std::memory_order_acquire);
+    async_sink->Deliver();
+    if (stopping)
+      return;
+  }
+}
+
+void AsyncLogSink::Queue(const std::string& message,
+                         LoggingSeverity severity,
+                         const char* tag) {
+  size_t position = enqueue_position_.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    slot = &slots_[position % capacity_];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence == position) {
+      if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                  std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (sequence < position + 1) {
+      // The slot still holds the message queued |capacity_| positions ago.
+      dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      // Another thread claimed |position| meanwhile.
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+  slot->message = message;
+  slot->severity = severity;
+  slot->tag = tag;
+  slot->sequence.store(position + 1, std::memory_order_release);
+
+  if (position + 1 - dequeue_position_.load(std::memory_order_relaxed) ==
+      capacity_ / 2) {
+    wake_up_.Set();
+  }
+}
+
+void AsyncLogSink::Deliver() {
+  size_t position = dequeue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Slot& slot = slots_[position % capacity_];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+      break;
+    if (slot.tag) {
+      sink_->OnLogMessage(slot.message, slot.severity, slot.tag);
+    } else if (slot.severity != LS_NONE) {
+      sink_->OnLogMessage(slot.message, slot.severity);
+    } else {
+      sink_->OnLogMessage(slot.message);
+    }
+    slot.sequence.store(position + capacity_, std::memory_order_release);
+    ++position;
+    dequeue_position_.store(position, std::memory_order_relaxed);
+  }
+
+  const int dropped = dropped_messages_.exchange(0, std::memory_order_relaxed);
+  if (dropped > 0) {
+    char buffer[64];
+    SimpleStringBuilder warning(buffer);
+    warning << "AsyncLogSink dropped " << dropped << " log messages.\n";
+    sink_->OnLogMessage(warning.str(), LS_WARNING);
+  }
+}
+
 }  // namespace rtc
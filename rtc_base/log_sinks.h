@@ -13,12 +13,15 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/event.h"
 #include "rtc_base/file_rotating_stream.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 
 namespace rtc {
 
@@ -68,6 +71,52 @@ class CallSessionFileRotatingLogSink : public FileRotatingLogSink {
   RTC_DISALLOW_COPY_AND_ASSIGN(CallSessionFileRotatingLogSink);
 };
 
+// Log sink that hands messages to another sink on a thread of its own, so that
+// logging doesn't wait for slow sinks such as files. Messages are queued
+// without taking a lock and delivered in batches. Messages that arrive while
+// |max_queued_messages| are queued are dropped, and the number of dropped
+// messages is delivered as a warning once there is room again.
+class AsyncLogSink : public LogSink {
+ public:
+  static constexpr size_t kDefaultMaxQueuedMessages = 1024;
+
+  // |sink| has to outlive this object.
+  explicit AsyncLogSink(LogSink* sink,
+                        size_t max_queued_messages = kDefaultMaxQueuedMessages);
+  // Delivers the queued messages before it returns. Has to be removed from
+  // LogMessage before.
+  ~AsyncLogSink() override;
+
+  void OnLogMessage(const std::string& message) override;
+  void OnLogMessage(const std::string& message,
+                    LoggingSeverity severity) override;
+  void OnLogMessage(const std::string& message,
+                    LoggingSeverity severity,
+                    const char* tag) override;
+
+ private:
+  struct Slot;
+
+  static void WriterThread(void* sink);
+  void Queue(const std::string& message,
+             LoggingSeverity severity,
+             const char* tag);
+  void Deliver();
+
+  LogSink* const sink_;
+  const size_t capacity_;
+  const std::unique_ptr<Slot[]> slots_;
+  std::atomic<size_t> enqueue_position_{0};
+  // Only advanced by the writer thread.
+  std::atomic<size_t> dequeue_position_{0};
+  std::atomic<int> dropped_messages_{0};
+  std::atomic<bool> stopping_{false};
+  Event wake_up_;
+  PlatformThread writer_thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncLogSink);
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_LOG_SINKS_H_
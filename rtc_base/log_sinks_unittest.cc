@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/log_sinks.h"
+
+#include <string>
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread_types.h"
+#include "rtc_base/thread_annotations.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+class RecordingLogSink : public LogSink {
+ public:
+  // If |hold_first_message| is set, delivering the first message blocks until
+  // Release() is called.
+  explicit RecordingLogSink(bool hold_first_message = false)
+      : hold_first_message_(hold_first_message) {}
+
+  void OnLogMessage(const std::string& message) override {
+    OnLogMessage(message, LS_NONE);
+  }
+
+  void OnLogMessage(const std::string& message,
+                    LoggingSeverity severity) override {
+    bool hold;
+    {
+      CritScope lock(&lock_);
+      thread_ = CurrentThreadRef();
+      messages_.push_back(message);
+      severities_.push_back(severity);
+      hold = hold_first_message_ && messages_.size() == 1;
+    }
+    if (hold) {
+      first_message_.Set();
+      release_.Wait(Event::kForever);
+    }
+  }
+
+  void WaitForFirstMessage() { first_message_.Wait(Event::kForever); }
+  void Release() { release_.Set(); }
+
+  std::vector<std::string> messages() const {
+    CritScope lock(&lock_);
+    return messages_;
+  }
+  std::vector<LoggingSeverity> severities() const {
+    CritScope lock(&lock_);
+    return severities_;
+  }
+  PlatformThreadRef thread() const {
+    CritScope lock(&lock_);
+    return thread_;
+  }
+
+ private:
+  const bool hold_first_message_;
+  Event first_message_;
+  Event release_;
+  CriticalSection lock_;
+  std::vector<std::string> messages_ RTC_GUARDED_BY(lock_);
+  std::vector<LoggingSeverity> severities_ RTC_GUARDED_BY(lock_);
+  PlatformThreadRef thread_ RTC_GUARDED_BY(lock_);
+};
+
+TEST(AsyncLogSinkTest, DeliversMessagesInOrderOnAnotherThread) {
+  RecordingLogSink sink;
+  {
+    AsyncLogSink async_sink(&sink);
+    async_sink.OnLogMessage("first");
+    async_sink.OnLogMessage("second", LS_INFO);
+    async_sink.OnLogMessage("third", LS_ERROR, "tag");
+  }
+  EXPECT_THAT(sink.messages(), ElementsAre("first", "second", "tag: third"));
+  EXPECT_THAT(sink.severities(), ElementsAre(LS_NONE, LS_INFO, LS_ERROR));
+  EXPECT_FALSE(IsThreadRefEqual(sink.thread(), CurrentThreadRef()));
+}
+
+TEST(AsyncLogSinkTest, CountsMessagesDroppedWhileTheQueueIsFull) {
+  RecordingLogSink sink(/*hold_first_message=*/true);
+  {
+    AsyncLogSink async_sink(&sink, /*max_queued_messages=*/4);
+    async_sink.OnLogMessage("held");
+    sink.WaitForFirstMessage();
+    // The held message takes its slot until it is delivered, so 3 fit.
+    for (int i = 0; i < 10; ++i)
+      async_sink.OnLogMessage(std::to_string(i));
+    sink.Release();
+  }
+  const std::vector<std::string> messages = sink.messages();
+  ASSERT_EQ(messages.size(), 5u);
+  EXPECT_EQ(messages[1], "0");
+  EXPECT_EQ(messages[3], "2");
+  EXPECT_THAT(messages[4], HasSubstr("dropped 7 log messages"));
+  EXPECT_EQ(sink.severities()[4], LS_WARNING);
+}
+
+}  // namespace
+}  // namespace rtc
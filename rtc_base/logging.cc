@@ -12,6 +12,10 @@
 
 #include <string.h>
 
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+
 #if RTC_LOG_ENABLED()
 
 #if defined(WEBRTC_WIN)
@@ -41,14 +45,11 @@ static const int kMaxLogLineSize = 1024 - 60;
 #include <vector>
 
 #include "absl/base/attributes.h"
-#include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/string_utils.h"
-#include "rtc_base/strings/string_builder.h"
 #include "rtc_base/thread_annotations.h"
-#include "rtc_base/time_utils.h"
 
 namespace rtc {
 namespace {
@@ -548,6 +549,46 @@ void Log(const LogArgType* fmt, ...) {
 #endif
 
 namespace rtc {
+namespace webrtc_logging_impl {
+
+int LogRateLimiter::ShouldLogEveryN(LoggingSeverity severity, int n) {
+  RTC_DCHECK_GT(n, 0);
+  if (!LogCheckLevel(severity))
+    return -1;
+  const uint32_t count = count_.fetch_add(1, std::memory_order_relaxed);
+  if (count % n != 0)
+    return -1;
+  return count == 0 ? 0 : n - 1;
+}
+
+int LogRateLimiter::ShouldLogEveryNMs(LoggingSeverity severity,
+                                      int64_t interval_ms) {
+  if (!LogCheckLevel(severity))
+    return -1;
+  const int64_t now_ms = TimeMillis();
+  int64_t next_log_time_ms =
+      next_log_time_ms_.load(std::memory_order_relaxed);
+  do {
+    if (now_ms < next_log_time_ms) {
+      count_.fetch_add(1, std::memory_order_relaxed);
+      return -1;
+    }
+  } while (!next_log_time_ms_.compare_exchange_weak(
+      next_log_time_ms, now_ms + interval_ms, std::memory_order_relaxed));
+  return static_cast<int>(count_.exchange(0, std::memory_order_relaxed));
+}
+
+ToStringVal MakeVal(const SkippedLogMessages& x) {
+  if (x.count == 0)
+    return {};
+  char buffer[48];
+  SimpleStringBuilder prefix(buffer);
+  prefix << "(" << x.count << " similar messages skipped) ";
+  return {prefix.str()};
+}
+
+}  // namespace webrtc_logging_impl
+
 // Inefficient default implementation, override is recommended.
 void LogSink::OnLogMessage(const std::string& msg,
                            LoggingSeverity severity,
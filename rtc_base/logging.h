@@ -45,7 +45,10 @@
 #define RTC_BASE_LOGGING_H_
 
 #include <errno.h>
+#include <stdint.h>
 
+#include <atomic>
+#include <limits>
 #include <sstream>  // no-presubmit-check TODO(webrtc:8982)
 #include <string>
 #include <utility>
@@ -614,6 +617,67 @@ inline bool LogCheckLevel(LoggingSeverity sev) {
   return (LogMessage::GetMinLogSeverity() <= sev);
 }
 
+namespace webrtc_logging_impl {
+
+// State of one call site of the rate limited logging macros below.
+class LogRateLimiter {
+ public:
+  constexpr LogRateLimiter() = default;
+
+  // Return -1 if the message shouldn't be logged, and otherwise the number of
+  // messages that were skipped since the previous one that was logged.
+  int ShouldLogEveryN(LoggingSeverity severity, int n);
+  int ShouldLogEveryNMs(LoggingSeverity severity, int64_t interval_ms);
+
+ private:
+  std::atomic<uint32_t> count_{0};
+  std::atomic<int64_t> next_log_time_ms_{
+      std::numeric_limits<int64_t>::min()};
+};
+
+// Prefixes a rate limited message with the number of messages that were
+// skipped before it, if there were any.
+struct SkippedLogMessages {
+  int count;
+};
+
+ToStringVal MakeVal(const SkippedLogMessages& x);
+
+}  // namespace webrtc_logging_impl
+
+// Rate limited versions of RTC_LOG, for messages that may be logged per packet
+// or per frame. Every call site keeps its own state, and the macros can be
+// used on any thread. Messages below the minimum severity are not counted.
+//
+// RTC_LOG_EVERY_N logs the first message and every |n|th after it.
+// RTC_LOG_EVERY_N_MS logs a message if none was logged in the last
+// |interval_ms| milliseconds.
+//
+// Messages that are skipped are counted, and the count is logged with the
+// next message, so that their rate can still be told from the logs. Stream
+// arguments are only evaluated when the message is logged.
+//
+// Like RTC_LOG, they have to be followed by a stream, but they are statements,
+// not expressions.
+#define RTC_LOG_RATE_LIMITED(sev, check)                                   \
+  for (int rtc_log_skipped =                                               \
+           RTC_LOG_ENABLED()                                               \
+               ? []() -> ::rtc::webrtc_logging_impl::LogRateLimiter& {     \
+                   static ::rtc::webrtc_logging_impl::LogRateLimiter       \
+                       rate_limiter;                                       \
+                   return rate_limiter;                                    \
+                 }().check                                                 \
+               : -1;                                                       \
+       rtc_log_skipped >= 0; rtc_log_skipped = -1)                         \
+  RTC_LOG(sev) << ::rtc::webrtc_logging_impl::SkippedLogMessages {         \
+    rtc_log_skipped                                                        \
+  }
+
+#define RTC_LOG_EVERY_N(sev, n) \
+  RTC_LOG_RATE_LIMITED(sev, ShouldLogEveryN(::rtc::sev, (n)))
+#define RTC_LOG_EVERY_N_MS(sev, interval_ms) \
+  RTC_LOG_RATE_LIMITED(sev, ShouldLogEveryNMs(::rtc::sev, (interval_ms)))
+
 #define RTC_LOG_E(sev, ctx, err)                                               \
   RTC_LOG_ENABLED() && ::rtc::webrtc_logging_impl::LogCall() &                 \
                            ::rtc::webrtc_logging_impl::LogStreamer<>()         \
@@ -19,6 +19,7 @@
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
+#include "rtc_base/fake_clock.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/stream.h"
 #include "rtc_base/time_utils.h"
@@ -359,5 +360,64 @@ TEST(LogTest, EnumsAreSupported) {
   stream.Close();
 }
 
+// Returns the number of times |part| occurs in |str|.
+size_t CountOccurrences(const std::string& str, const std::string& part) {
+  size_t count = 0;
+  for (size_t pos = str.find(part); pos != std::string::npos;
+       pos = str.find(part, pos + part.size())) {
+    ++count;
+  }
+  return count;
+}
+
+TEST(LogTest, LogEveryNLogsTheFirstAndEveryNthMessage) {
+  std::string str;
+  LogSinkImpl<StringStream> stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  for (int i = 0; i < 7; ++i)
+    RTC_LOG_EVERY_N(LS_INFO, 3) << "[" << i << "]";
+  LogMessage::RemoveLogToStream(&stream);
+  stream.Close();
+
+  EXPECT_EQ(CountOccurrences(str, "\n"), 3u);
+  EXPECT_NE(std::string::npos, str.find("[0]"));
+  EXPECT_NE(std::string::npos, str.find("(2 similar messages skipped) [3]"));
+  EXPECT_NE(std::string::npos, str.find("(2 similar messages skipped) [6]"));
+}
+
+TEST(LogTest, LogEveryNMsLogsOnceAnInterval) {
+  ScopedFakeClock clock;
+  clock.SetTime(webrtc::Timestamp::Seconds(1));
+  std::string str;
+  LogSinkImpl<StringStream> stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  for (int i = 0; i < 10; ++i) {
+    RTC_LOG_EVERY_N_MS(LS_INFO, 100) << "[" << i << "]";
+    clock.AdvanceTime(webrtc::TimeDelta::Millis(25));
+  }
+  LogMessage::RemoveLogToStream(&stream);
+  stream.Close();
+
+  EXPECT_EQ(CountOccurrences(str, "\n"), 3u);
+  EXPECT_NE(std::string::npos, str.find("[0]"));
+  EXPECT_NE(std::string::npos, str.find("(3 similar messages skipped) [4]"));
+  EXPECT_NE(std::string::npos, str.find("(3 similar messages skipped) [8]"));
+}
+
+TEST(LogTest, RateLimitedLogsDontEvaluateSkippedArguments) {
+  std::string str;
+  LogSinkImpl<StringStream> stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  int evaluations = 0;
+  for (int i = 0; i < 4; ++i)
+    RTC_LOG_EVERY_N(LS_INFO, 2) << ++evaluations;
+  // Messages below the minimum severity are neither logged nor counted.
+  for (int i = 0; i < 4; ++i)
+    RTC_LOG_EVERY_N(LS_VERBOSE, 1) << ++evaluations;
+  LogMessage::RemoveLogToStream(&stream);
+  stream.Close();
+  EXPECT_EQ(evaluations, 2);
+}
+
 }  // namespace rtc
 #endif
@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/memory_accounting.h"
+
+#include <atomic>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Updated with relaxed atomics, the counters don't order anything.
+std::atomic<int64_t> tracked_bytes[kNumMemoryCategories];
+
+void AddTrackedBytes(MemoryCategory category, int64_t bytes) {
+  if (bytes != 0) {
+    tracked_bytes[static_cast<int>(category)].fetch_add(
+        bytes, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+int64_t GetTrackedMemoryBytes(MemoryCategory category) {
+  return tracked_bytes[static_cast<int>(category)].load(
+      std::memory_order_relaxed);
+}
+
+const char* MemoryCategoryName(MemoryCategory category) {
+  switch (category) {
+    case MemoryCategory::kRtpPacketHistory:
+      return "RtpPacketHistory";
+    case MemoryCategory::kVideoPacketBuffer:
+      return "VideoPacketBuffer";
+    case MemoryCategory::kVideoFrameBuffer:
+      return "VideoFrameBuffer";
+    case MemoryCategory::kNetEqPacketBuffer:
+      return "NetEqPacketBuffer";
+    case MemoryCategory::kVp9FrameBufferPool:
+      return "Vp9FrameBufferPool";
+  }
+  RTC_NOTREACHED();
+  return "";
+}
+
+TrackedMemory::TrackedMemory(TrackedMemory&& other)
+    : category_(other.category_), bytes_(other.bytes_) {
+  other.bytes_ = 0;
+}
+
+TrackedMemory::~TrackedMemory() {
+  AddTrackedBytes(category_, -static_cast<int64_t>(bytes_));
+}
+
+void TrackedMemory::Add(size_t bytes) {
+  bytes_ += bytes;
+  AddTrackedBytes(category_, bytes);
+}
+
+void TrackedMemory::Subtract(size_t bytes) {
+  RTC_DCHECK_LE(bytes, bytes_);
+  bytes_ -= bytes;
+  AddTrackedBytes(category_, -static_cast<int64_t>(bytes));
+}
+
+void TrackedMemory::Set(size_t bytes) {
+  AddTrackedBytes(category_,
+                  static_cast<int64_t>(bytes) - static_cast<int64_t>(bytes_));
+  bytes_ = bytes;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_MEMORY_ACCOUNTING_H_
+#define RTC_BASE_MEMORY_MEMORY_ACCOUNTING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// The buffers whose memory is accounted for. The counters are process wide,
+// summed over all the calls.
+enum class MemoryCategory {
+  kRtpPacketHistory,
+  kVideoPacketBuffer,
+  kVideoFrameBuffer,
+  kNetEqPacketBuffer,
+  kVp9FrameBufferPool,
+};
+constexpr int kNumMemoryCategories = 5;
+
+// Returns the bytes currently held by the buffers of |category|. Thread safe.
+RTC_EXPORT int64_t GetTrackedMemoryBytes(MemoryCategory category);
+RTC_EXPORT const char* MemoryCategoryName(MemoryCategory category);
+
+// The bytes held by one buffer, added to the counter of its category. What
+// is still held when it is destroyed is removed from the counter. It is not
+// thread safe, and has to be guarded like the buffer owning it.
+class RTC_EXPORT TrackedMemory {
+ public:
+  explicit TrackedMemory(MemoryCategory category) : category_(category) {}
+  // Takes over the bytes of |other|, which is left empty.
+  TrackedMemory(TrackedMemory&& other);
+  ~TrackedMemory();
+
+  TrackedMemory(const TrackedMemory&) = delete;
+  TrackedMemory& operator=(const TrackedMemory&) = delete;
+
+  void Add(size_t bytes);
+  // |bytes| can't be more than bytes().
+  void Subtract(size_t bytes);
+  void Set(size_t bytes);
+  size_t bytes() const { return bytes_; }
+
+ private:
+  const MemoryCategory category_;
+  size_t bytes_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_MEMORY_MEMORY_ACCOUNTING_H_
@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/memory_accounting.h"
+
+#include <utility>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Other tests may hold memory of the category, only differences are checked.
+constexpr MemoryCategory kCategory = MemoryCategory::kVp9FrameBufferPool;
+
+TEST(MemoryAccountingTest, CountsTheBytesHeld) {
+  const int64_t initial_bytes = GetTrackedMemoryBytes(kCategory);
+  TrackedMemory memory(kCategory);
+  memory.Add(100);
+  memory.Add(50);
+  EXPECT_EQ(memory.bytes(), 150u);
+  EXPECT_EQ(GetTrackedMemoryBytes(kCategory), initial_bytes + 150);
+
+  memory.Subtract(30);
+  EXPECT_EQ(GetTrackedMemoryBytes(kCategory), initial_bytes + 120);
+  memory.Set(10);
+  EXPECT_EQ(memory.bytes(), 10u);
+  EXPECT_EQ(GetTrackedMemoryBytes(kCategory), initial_bytes + 10);
+}
+
+TEST(MemoryAccountingTest, RemovesTheBytesStillHeldWhenDestroyed) {
+  const int64_t initial_bytes = GetTrackedMemoryBytes(kCategory);
+  {
+    TrackedMemory memory(kCategory);
+    memory.Add(1000);
+  }
+  EXPECT_EQ(GetTrackedMemoryBytes(kCategory), initial_bytes);
+}
+
+TEST(MemoryAccountingTest, MovesTheBytes) {
+  const int64_t initial_bytes = GetTrackedMemoryBytes(kCategory);
+  TrackedMemory memory(kCategory);
+  memory.Add(200);
+  {
+    TrackedMemory moved(std::move(memory));
+    EXPECT_EQ(moved.bytes(), 200u);
+    EXPECT_EQ(memory.bytes(), 0u);
+    EXPECT_EQ(GetTrackedMemoryBytes(kCategory), initial_bytes + 200);
+  }
+  EXPECT_EQ(GetTrackedMemoryBytes(kCategory), initial_bytes);
+}
+
+TEST(MemoryAccountingTest, KeepsTheCategoriesApart) {
+  const int64_t initial_history_bytes =
+      GetTrackedMemoryBytes(MemoryCategory::kRtpPacketHistory);
+  TrackedMemory memory(kCategory);
+  memory.Add(300);
+  EXPECT_EQ(GetTrackedMemoryBytes(MemoryCategory::kRtpPacketHistory),
+            initial_history_bytes);
+}
+
+}  // namespace
+}  // namespace webrtc
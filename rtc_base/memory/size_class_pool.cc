@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/size_class_pool.h"
+
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+std::atomic<int> num_pools{0};
+std::atomic<SizeClassPool*> pools[SizeClassPool::kMaxPools];
+
+}  // namespace
+
+struct SizeClassPool::FreeBlock {
+  FreeBlock* next;
+};
+
+void SizeClassPool::FreeList::Push(void* block) {
+  FreeBlock* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = head;
+  head = free_block;
+  ++size;
+}
+
+void* SizeClassPool::FreeList::Pop() {
+  FreeBlock* block = head;
+  head = block->next;
+  --size;
+  return block;
+}
+
+void SizeClassPool::FreeList::DeleteBlocks() {
+  while (head)
+    ::operator delete(Pop());
+}
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+
+// Free blocks of one thread for every pool. Each size class has a list blocks
+// are taken from and freed to, and a spare list, so that a thread allocating
+// and freeing around a batch boundary doesn't move a batch each time.
+class SizeClassPool::ThreadCaches {
+ public:
+  ~ThreadCaches();
+
+  // Returns null once the caches of the thread are destroyed, for blocks that
+  // are allocated or freed after that while the thread exits.
+  static ThreadCaches* Current();
+
+  void* Allocate(SizeClassPool* pool, int size_class) {
+    FreeList& current = current_[pool->id_][size_class];
+    if (!current.head) {
+      std::swap(current, spare_[pool->id_][size_class]);
+      if (!current.head)
+        current = pool->TakeBatch(size_class);
+      if (!current.head)
+        return pool->AllocateBlock(size_class);
+    }
+    return current.Pop();
+  }
+
+  void Free(SizeClassPool* pool, int size_class, void* block) {
+    FreeList& current = current_[pool->id_][size_class];
+    if (current.size == pool->batch_size_) {
+      FreeList& spare = spare_[pool->id_][size_class];
+      if (spare.head)
+        pool->PutBatch(size_class, spare);
+      spare = current;
+      current = FreeList();
+    }
+    current.Push(block);
+  }
+
+ private:
+  FreeList current_[kMaxPools][kMaxSizeClasses];
+  FreeList spare_[kMaxPools][kMaxSizeClasses];
+};
+
+namespace {
+ABSL_CONST_INIT thread_local bool thread_caches_destroyed = false;
+}  // namespace
+
+SizeClassPool::ThreadCaches::~ThreadCaches() {
+  thread_caches_destroyed = true;
+  for (int id = 0; id < kMaxPools; ++id) {
+    SizeClassPool* pool = pools[id].load(std::memory_order_acquire);
+    if (!pool)
+      continue;
+    for (int i = 0; i < pool->num_size_classes_; ++i) {
+      if (current_[id][i].head)
+        pool->PutBatch(i, current_[id][i]);
+      if (spare_[id][i].head)
+        pool->PutBatch(i, spare_[id][i]);
+    }
+  }
+}
+
+SizeClassPool::ThreadCaches* SizeClassPool::ThreadCaches::Current() {
+  if (thread_caches_destroyed)
+    return nullptr;
+  static thread_local ThreadCaches caches;
+  return &caches;
+}
+
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
+SizeClassPool* SizeClassPool::Create(const Config& config) {
+  const int id = num_pools.fetch_add(1, std::memory_order_relaxed);
+  RTC_CHECK_LT(id, kMaxPools);
+  SizeClassPool* pool = new SizeClassPool(config, id);
+  pools[id].store(pool, std::memory_order_release);
+  return pool;
+}
+
+SizeClassPool::SizeClassPool(const Config& config, int id)
+    : id_(id),
+      num_size_classes_(static_cast<int>(config.size_classes.size())),
+      batch_size_(config.batch_size),
+      max_shared_batches_(config.max_shared_batches) {
+  RTC_CHECK_GT(num_size_classes_, 0);
+  RTC_CHECK_LE(num_size_classes_, kMaxSizeClasses);
+  RTC_CHECK_GT(batch_size_, 0);
+  for (int i = 0; i < num_size_classes_; ++i) {
+    size_classes_[i] = config.size_classes[i];
+    RTC_CHECK_GE(size_classes_[i], sizeof(FreeBlock));
+    RTC_CHECK(i == 0 || size_classes_[i] > size_classes_[i - 1]);
+    batches_[i].reserve(max_shared_batches_);
+  }
+}
+
+void* SizeClassPool::Allocate(size_t size) {
+  const int size_class = SizeClass(size);
+  if (size_class < 0)
+    return ::operator new(size);
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  if (ThreadCaches* caches = ThreadCaches::Current())
+    return caches->Allocate(this, size_class);
+#endif
+  return AllocateBlock(size_class);
+}
+
+void SizeClassPool::Free(void* block, size_t size) {
+  const int size_class = SizeClass(size);
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  if (size_class >= 0) {
+    if (ThreadCaches* caches = ThreadCaches::Current()) {
+      caches->Free(this, size_class, block);
+      return;
+    }
+  }
+#endif
+  // Every block is allocated from the heap on its own, with the size of its
+  // class, so it can be returned to the heap on its own as well.
+  ::operator delete(block);
+}
+
+int SizeClassPool::SizeClass(size_t size) const {
+  for (int i = 0; i < num_size_classes_; ++i) {
+    if (size <= size_classes_[i])
+      return i;
+  }
+  return -1;
+}
+
+void* SizeClassPool::AllocateBlock(int size_class) const {
+  return ::operator new(size_classes_[size_class]);
+}
+
+SizeClassPool::FreeList SizeClassPool::TakeBatch(int size_class) {
+  rtc::CritScope lock(&lock_);
+  std::vector<FreeList>& batches = batches_[size_class];
+  if (batches.empty())
+    return FreeList();
+  FreeList batch = batches.back();
+  batches.pop_back();
+  return batch;
+}
+
+void SizeClassPool::PutBatch(int size_class, FreeList batch) {
+  {
+    rtc::CritScope lock(&lock_);
+    std::vector<FreeList>& batches = batches_[size_class];
+    if (batches.size() < max_shared_batches_) {
+      batches.push_back(batch);
+      return;
+    }
+  }
+  batch.DeleteBlocks();
+}
+
+}  // namespace webrtc
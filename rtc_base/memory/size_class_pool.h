@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_SIZE_CLASS_POOL_H_
+#define RTC_BASE_MEMORY_SIZE_CLASS_POOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Allocates blocks of a few fixed sizes and keeps the freed ones for reuse
+// instead of returning them to the heap. Each thread keeps a few free blocks
+// per size class and exchanges them in batches with lists shared by all
+// threads, so blocks allocated on one thread and freed on another are reused
+// too, and the lock of the shared lists is taken once per batch. Sizes above
+// the largest class come from the heap directly.
+//
+// Threads hand their free blocks back to the pools when they exit, so pools
+// are never destroyed and only kMaxPools of them can exist in a process.
+class RTC_EXPORT SizeClassPool {
+ public:
+  static constexpr int kMaxSizeClasses = 8;
+  static constexpr int kMaxPools = 8;
+
+  struct Config {
+    // Block sizes in increasing order, at most kMaxSizeClasses of them.
+    std::vector<size_t> size_classes;
+    // Number of free blocks a thread keeps per size class in each of its two
+    // lists, and moves to or from the shared lists at once.
+    int batch_size = 32;
+    // Batches of free blocks kept per size class for all threads. Blocks
+    // beyond are returned to the heap.
+    size_t max_shared_batches = 16;
+  };
+
+  static SizeClassPool* Create(const Config& config);
+
+  SizeClassPool(const SizeClassPool&) = delete;
+  SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+  // Returns a block of at least |size| bytes, aligned as ::operator new
+  // aligns it.
+  void* Allocate(size_t size);
+  // |size| has to be the size passed to Allocate(). May be called on any
+  // thread.
+  void Free(void* block, size_t size);
+
+ private:
+  class ThreadCaches;
+  struct FreeBlock;
+  struct FreeList {
+    void Push(void* block);
+    void* Pop();
+    void DeleteBlocks();
+
+    FreeBlock* head = nullptr;
+    int size = 0;
+  };
+
+  SizeClassPool(const Config& config, int id);
+  ~SizeClassPool() = delete;
+
+  // Returns the size class for |size|, or -1 if it is too large for any.
+  int SizeClass(size_t size) const;
+  void* AllocateBlock(int size_class) const;
+  // Returns a batch of free blocks, which is empty if there is none left.
+  FreeList TakeBatch(int size_class);
+  void PutBatch(int size_class, FreeList batch);
+
+  const int id_;
+  const int num_size_classes_;
+  size_t size_classes_[kMaxSizeClasses];
+  const int batch_size_;
+  const size_t max_shared_batches_;
+
+  rtc::CriticalSection lock_;
+  std::vector<FreeList> batches_[kMaxSizeClasses] RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_MEMORY_SIZE_CLASS_POOL_H_
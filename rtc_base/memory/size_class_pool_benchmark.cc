@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <new>
+#include <string>
+#include <vector>
+
+#include "rtc_base/event.h"
+#include "rtc_base/memory/size_class_pool.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kPacketSize = 1200;
+constexpr int kBlocksPerRound = 256;
+constexpr int kRounds = 2000;
+
+SizeClassPool* BenchmarkPool() {
+  static SizeClassPool* const pool = SizeClassPool::Create(
+      {/*size_classes=*/{256, 512, 1024, 1600}, /*batch_size=*/16,
+       /*max_shared_batches=*/32});
+  return pool;
+}
+
+// Allocates packet sized blocks on one thread and frees them on another, like
+// packets received on the network thread and released on a worker thread.
+class CrossThreadFrees {
+ public:
+  explicit CrossThreadFrees(SizeClassPool* pool)
+      : pool_(pool), blocks_(kBlocksPerRound) {}
+
+  // Returns the time per allocated and freed block.
+  double Run() {
+    rtc::PlatformThread thread(&FreeMain, this, "free");
+    const int64_t start_us = rtc::TimeMicros();
+    thread.Start();
+    for (int round = 0; round < kRounds; ++round) {
+      for (void*& block : blocks_)
+        block = Allocate();
+      allocated_.Set();
+      freed_.Wait(rtc::Event::kForever);
+    }
+    const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+    thread.Stop();
+    return static_cast<double>(elapsed_us) * rtc::kNumNanosecsPerMicrosec /
+           (kRounds * kBlocksPerRound);
+  }
+
+ private:
+  static void FreeMain(void* context) {
+    CrossThreadFrees* frees = static_cast<CrossThreadFrees*>(context);
+    for (int round = 0; round < kRounds; ++round) {
+      frees->allocated_.Wait(rtc::Event::kForever);
+      for (void* block : frees->blocks_)
+        frees->Free(block);
+      frees->freed_.Set();
+    }
+  }
+
+  void* Allocate() {
+    return pool_ ? pool_->Allocate(kPacketSize) : ::operator new(kPacketSize);
+  }
+
+  void Free(void* block) {
+    if (pool_)
+      pool_->Free(block, kPacketSize);
+    else
+      ::operator delete(block);
+  }
+
+  SizeClassPool* const pool_;
+  std::vector<void*> blocks_;
+  rtc::Event allocated_;
+  rtc::Event freed_;
+};
+
+TEST(SizeClassPoolBenchmark, CrossThreadFrees) {
+  CrossThreadFrees heap(nullptr);
+  test::PrintResult("alloc_free_time_per_block", "", "heap", heap.Run(), "ns",
+                    false, test::ImproveDirection::kSmallerIsBetter);
+  CrossThreadFrees pool(BenchmarkPool());
+  test::PrintResult("alloc_free_time_per_block", "", "size_class_pool",
+                    pool.Run(), "ns", false,
+                    test::ImproveDirection::kSmallerIsBetter);
+}
+
+}  // namespace
+}  // namespace webrtc
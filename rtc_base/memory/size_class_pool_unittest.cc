@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/size_class_pool.h"
+
+#include <string.h>
+
+#include <set>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kBatchSize = 4;
+
+// Pools are never destroyed, so the tests share one and use a size class of
+// their own each.
+SizeClassPool* TestPool() {
+  static SizeClassPool* const pool = SizeClassPool::Create(
+      {/*size_classes=*/{64, 128, 256, 512}, kBatchSize,
+       /*max_shared_batches=*/4});
+  return pool;
+}
+
+struct Blocks {
+  std::vector<void*> blocks;
+  size_t size;
+};
+
+void FreeBlocks(void* context) {
+  Blocks* blocks = static_cast<Blocks*>(context);
+  for (void* block : blocks->blocks)
+    TestPool()->Free(block, blocks->size);
+}
+
+TEST(SizeClassPoolTest, ReusesFreedBlocks) {
+  SizeClassPool* pool = TestPool();
+  void* block = pool->Allocate(60);
+  memset(block, 0xff, 60);
+  pool->Free(block, 60);
+  EXPECT_EQ(pool->Allocate(64), block);
+  pool->Free(block, 64);
+}
+
+TEST(SizeClassPoolTest, AllocatesSizesAboveTheLargestClassFromTheHeap) {
+  SizeClassPool* pool = TestPool();
+  void* block = pool->Allocate(4096);
+  memset(block, 0xff, 4096);
+  pool->Free(block, 4096);
+}
+
+TEST(SizeClassPoolTest, ReusesBlocksFreedOnAnotherThread) {
+  SizeClassPool* pool = TestPool();
+  Blocks freed;
+  freed.size = 200;
+  for (int i = 0; i < 3 * kBatchSize; ++i)
+    freed.blocks.push_back(pool->Allocate(freed.size));
+
+  // The blocks go back to the shared lists when the thread exits.
+  rtc::PlatformThread thread(&FreeBlocks, &freed, "free");
+  thread.Start();
+  thread.Stop();
+
+  const std::set<void*> freed_blocks(freed.blocks.begin(), freed.blocks.end());
+  std::vector<void*> reused;
+  for (int i = 0; i < kBatchSize; ++i) {
+    reused.push_back(pool->Allocate(freed.size));
+    EXPECT_EQ(freed_blocks.count(reused.back()), 1u);
+  }
+  for (void* block : reused)
+    pool->Free(block, freed.size);
+}
+
+TEST(SizeClassPoolTest, ReturnsBlocksBeyondTheSharedBatchesToTheHeap) {
+  SizeClassPool* pool = TestPool();
+  // Far more blocks than the shared lists keep.
+  Blocks freed;
+  freed.size = 500;
+  for (int i = 0; i < 20 * kBatchSize; ++i)
+    freed.blocks.push_back(pool->Allocate(freed.size));
+
+  rtc::PlatformThread thread(&FreeBlocks, &freed, "free");
+  thread.Start();
+  thread.Stop();
+
+  std::vector<void*> blocks;
+  for (int i = 0; i < 20 * kBatchSize; ++i)
+    blocks.push_back(pool->Allocate(freed.size));
+  for (void* block : blocks)
+    pool->Free(block, freed.size);
+}
+
+}  // namespace
+}  // namespace webrtc
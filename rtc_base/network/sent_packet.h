@@ -61,6 +61,9 @@ struct RTC_EXPORT SentPacket {
 
   int64_t packet_id = -1;
   int64_t send_time_ms = -1;
+  // The same send time in microseconds, taken from the transmit timestamp of
+  // the socket if it reports one. -1 if only |send_time_ms| is known.
+  int64_t send_time_us = -1;
   rtc::PacketInfo info;
 };
 
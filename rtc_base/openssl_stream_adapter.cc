@@ -21,19 +21,26 @@
 #include <openssl/ssl.h>
 #endif
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/openssl.h"
 #include "rtc_base/openssl_adapter.h"
 #include "rtc_base/openssl_digest.h"
 #include "rtc_base/openssl_identity.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/ssl_certificate.h"
+#include "rtc_base/ssl_session_cache.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/string_encode.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/field_trial.h"
@@ -261,6 +268,144 @@ static long stream_ctrl(BIO* b, int cmd, long num, void* ptr) {
   }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// OpenSSLStreamAdapter::BufferingStream
+/////////////////////////////////////////////////////////////////////////////
+
+// Outside of the negotiation steps, reads the packets a step left before the
+// ones of the wrapped stream, and writes to the wrapped stream. During a step,
+// which runs on another thread, only reads the packets received before the
+// step and keeps the ones written, to be sent once the step is done.
+class OpenSSLStreamAdapter::BufferingStream : public StreamInterface {
+ public:
+  explicit BufferingStream(StreamInterface* stream) : stream_(stream) {}
+
+  // Takes the packets available from the wrapped stream, and buffers the
+  // writes until EndStep().
+  void BeginStep() {
+    RTC_DCHECK(!in_step_);
+    ReadAvailable(&input_);
+    in_step_ = true;
+  }
+  // Keeps the packets received while a step runs for the next one.
+  void ReadDuringStep() {
+    RTC_DCHECK(in_step_);
+    ReadAvailable(&received_during_step_);
+  }
+  void EndStep() {
+    in_step_ = false;
+    for (Buffer& packet : received_during_step_)
+      input_.push_back(std::move(packet));
+    received_during_step_.clear();
+    for (const Buffer& packet : output_) {
+      size_t written;
+      int error;
+      // Lost packets are retransmitted by the handshake.
+      stream_->Write(packet.data(), packet.size(), &written, &error);
+    }
+    output_.clear();
+  }
+  bool has_input() const { return !input_.empty(); }
+
+  // StreamInterface:
+  StreamState GetState() const override {
+    return in_step_ ? SS_OPEN : stream_->GetState();
+  }
+  StreamResult Read(void* buffer,
+                    size_t buffer_len,
+                    size_t* read,
+                    int* error) override {
+    if (input_.empty()) {
+      return in_step_ ? SR_BLOCK
+                      : stream_->Read(buffer, buffer_len, read, error);
+    }
+    // As for datagrams, what doesn't fit in |buffer| is dropped.
+    const Buffer& packet = input_.front();
+    size_t size = std::min(buffer_len, packet.size());
+    memcpy(buffer, packet.data(), size);
+    input_.pop_front();
+    if (read)
+      *read = size;
+    return SR_SUCCESS;
+  }
+  StreamResult Write(const void* data,
+                     size_t data_len,
+                     size_t* written,
+                     int* error) override {
+    if (!in_step_)
+      return stream_->Write(data, data_len, written, error);
+    output_.emplace_back(static_cast<const uint8_t*>(data), data_len);
+    if (written)
+      *written = data_len;
+    return SR_SUCCESS;
+  }
+  void Close() override {}
+
+ private:
+  // As large as the packets DtlsTransport accepts.
+  static constexpr size_t kMaxPacketSize = 2048;
+
+  void ReadAvailable(std::deque<Buffer>* packets) {
+    uint8_t buffer[kMaxPacketSize];
+    size_t read;
+    int error;
+    while (stream_->Read(buffer, sizeof(buffer), &read, &error) == SR_SUCCESS)
+      packets->emplace_back(buffer, read);
+  }
+
+  StreamInterface* const stream_;
+  bool in_step_ = false;
+  std::deque<Buffer> input_;
+  std::deque<Buffer> received_during_step_;
+  std::vector<Buffer> output_;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// OpenSSLStreamAdapter::HandshakeStep
+/////////////////////////////////////////////////////////////////////////////
+
+// One SSL_connect() or SSL_accept() call run on the handshake task queue.
+class OpenSSLStreamAdapter::HandshakeStep : public RefCountInterface {
+ public:
+  HandshakeStep(SSL* ssl, SSLRole role) : ssl_(ssl), role_(role) {}
+
+  // Returns false if the step was stopped before it started.
+  bool Run() {
+    int expected = kQueued;
+    if (!state_.compare_exchange_strong(expected, kRunning))
+      return false;
+    code_ = (role_ == SSL_CLIENT) ? SSL_connect(ssl_) : SSL_accept(ssl_);
+    ssl_error_ = SSL_get_error(ssl_, code_);
+    // The error queue belongs to the thread.
+    err_code_ = ERR_peek_last_error();
+    ERR_clear_error();
+    state_ = kDone;
+    done_.Set();
+    return true;
+  }
+
+  void Stop() {
+    int expected = kQueued;
+    if (!state_.compare_exchange_strong(expected, kStopped))
+      done_.Wait(Event::kForever);
+  }
+
+  int code() const { return code_; }
+  int ssl_error() const { return ssl_error_; }
+  unsigned long err_code() const { return err_code_; }
+
+ private:
+  enum { kQueued, kRunning, kDone, kStopped };
+
+  SSL* const ssl_;
+  const SSLRole role_;
+  std::atomic<int> state_{kQueued};
+  Event done_;
+  int code_ = 0;
+  int ssl_error_ = SSL_ERROR_NONE;
+  unsigned long err_code_ = 0;
+};
+
 /////////////////////////////////////////////////////////////////////////////
 // OpenSSLStreamAdapter
 /////////////////////////////////////////////////////////////////////////////
@@ -303,8 +448,8 @@ bool OpenSSLStreamAdapter::SetPeerCertificateDigest(
     const unsigned char* digest_val,
     size_t digest_len,
     SSLPeerCertificateDigestError* error) {
-  RTC_DCHECK(!peer_certificate_verified_);
   RTC_DCHECK(!HasPeerCertificateDigest());
+  RTC_DCHECK(pending_peer_certificate_digest_algorithm_.empty());
   size_t expected_len;
   if (error) {
     *error = SSLPeerCertificateDigestError::NONE;
@@ -324,6 +469,14 @@ bool OpenSSLStreamAdapter::SetPeerCertificateDigest(
     return false;
   }
 
+  if (handshake_step_) {
+    // The step may be verifying the certificate of the peer.
+    pending_peer_certificate_digest_value_.SetData(digest_val, digest_len);
+    pending_peer_certificate_digest_algorithm_ = digest_alg;
+    return true;
+  }
+  RTC_DCHECK(!peer_certificate_verified_);
+
   peer_certificate_digest_value_.SetData(digest_val, digest_len);
   peer_certificate_digest_algorithm_ = digest_alg;
 
@@ -416,6 +569,10 @@ bool OpenSSLStreamAdapter::GetSslVersionBytes(int* version) const {
   return true;
 }
 
+bool OpenSSLStreamAdapter::IsSessionResumed() const {
+  return state_ == SSL_CONNECTED && SSL_session_reused(ssl_);
+}
+
 // Key Extractor interface
 bool OpenSSLStreamAdapter::ExportKeyingMaterial(const std::string& label,
                                                 const uint8_t* context,
@@ -522,6 +679,17 @@ void OpenSSLStreamAdapter::SetInitialRetransmissionTimeout(int timeout_ms) {
   dtls_handshake_timeout_ms_ = timeout_ms;
 }
 
+void OpenSSLStreamAdapter::SetSessionCache(SSLSessionCache* session_cache) {
+  RTC_DCHECK(ssl_ctx_ == nullptr);
+  session_cache_ = session_cache;
+}
+
+void OpenSSLStreamAdapter::SetHandshakeTaskQueue(
+    webrtc::TaskQueueBase* task_queue) {
+  RTC_DCHECK(ssl_ctx_ == nullptr);
+  handshake_task_queue_ = task_queue;
+}
+
 //
 // StreamInterface Implementation
 //
@@ -801,7 +969,12 @@ int OpenSSLStreamAdapter::BeginSSL() {
     return -1;
   }
 
-  bio = BIO_new_stream(static_cast<StreamInterface*>(stream()));
+  if (handshake_task_queue_ && ssl_mode_ == SSL_MODE_DTLS) {
+    buffering_stream_ = std::make_unique<BufferingStream>(stream());
+    bio = BIO_new_stream(buffering_stream_.get());
+  } else {
+    bio = BIO_new_stream(static_cast<StreamInterface*>(stream()));
+  }
   if (!bio) {
     return -1;
   }
@@ -814,6 +987,18 @@ int OpenSSLStreamAdapter::BeginSSL() {
 
   SSL_set_app_data(ssl_, this);
 
+  if (session_cache_ && role_ == SSL_CLIENT) {
+    session_cache_key_ = SessionCacheKey();
+    SSL_SESSION* session = session_cache_key_.empty()
+                               ? nullptr
+                               : session_cache_->GetSession(session_cache_key_);
+    if (session) {
+      RTC_LOG(LS_INFO) << "Offering to resume a cached session.";
+      SSL_set_session(ssl_, session);
+      SSL_SESSION_free(session);
+    }
+  }
+
   SSL_set_bio(ssl_, bio, bio);  // the SSL object owns the bio now.
   if (ssl_mode_ == SSL_MODE_DTLS) {
 #ifdef OPENSSL_IS_BORINGSSL
@@ -839,17 +1024,40 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   // Clear the DTLS timer
   Thread::Current()->Clear(this, MSG_TIMEOUT);
 
+  if (buffering_stream_) {
+    StartHandshakeStep();
+    return 0;
+  }
+
   const int code = (role_ == SSL_CLIENT) ? SSL_connect(ssl_) : SSL_accept(ssl_);
   const int ssl_error = SSL_get_error(ssl_, code);
+  return HandleHandshakeResult(code, ssl_error, ERR_peek_last_error());
+}
 
+int OpenSSLStreamAdapter::HandleHandshakeResult(int code,
+                                                int ssl_error,
+                                                unsigned long err_code) {
   switch (ssl_error) {
     case SSL_ERROR_NONE:
       RTC_LOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_)) {
+        RTC_LOG(LS_INFO) << "Resumed a cached session.";
+        SetPeerCertChainFromSession();
+        if (HasPeerCertificateDigest() && !VerifyPeerCertificate())
+          return -1;
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !GetClientAuthEnabled());
 
       state_ = SSL_CONNECTED;
+      if (!session_cache_key_.empty() && peer_certificate_verified_) {
+        SSL_SESSION* session = SSL_get1_session(ssl_);
+        if (session) {
+          session_cache_->AddSession(session_cache_key_, session);
+          SSL_SESSION_free(session);
+        }
+      }
       if (!WaitingToVerifyPeerCertificate()) {
         // We have everything we need to start the connection, so signal
         // SE_OPEN. If we need a client certificate fingerprint and don't have
@@ -882,8 +1090,12 @@ int OpenSSLStreamAdapter::ContinueSSL() {
     case SSL_ERROR_ZERO_RETURN:
     default:
       RTC_LOG(LS_VERBOSE) << " -- error " << code;
+      if (!session_cache_key_.empty()) {
+        // Don't offer the session again if it is what made the handshake
+        // fail.
+        session_cache_->RemoveSession(session_cache_key_);
+      }
       SSLHandshakeError ssl_handshake_err = SSLHandshakeError::UNKNOWN;
-      int err_code = ERR_peek_last_error();
       if (err_code != 0 && ERR_GET_REASON(err_code) == SSL_R_NO_SHARED_CIPHER) {
         ssl_handshake_err = SSLHandshakeError::INCOMPATIBLE_CIPHERSUITE;
       }
@@ -894,6 +1106,67 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   return 0;
 }
 
+void OpenSSLStreamAdapter::StartHandshakeStep() {
+  if (handshake_step_) {
+    // Run by the next step.
+    buffering_stream_->ReadDuringStep();
+    return;
+  }
+  buffering_stream_->BeginStep();
+  handshake_step_ = new RefCountedObject<HandshakeStep>(ssl_, role_);
+  handshake_task_queue_->PostTask(webrtc::ToQueuedTask(
+      [this, step = handshake_step_, thread = Thread::Current(),
+       safety = task_safety_.flag()] {
+        if (!step->Run())
+          return;
+        thread->PostTask(webrtc::ToQueuedTask(
+            safety, [this, step] { OnHandshakeStepDone(step); }));
+      }));
+}
+
+void OpenSSLStreamAdapter::OnHandshakeStepDone(
+    scoped_refptr<HandshakeStep> step) {
+  if (step != handshake_step_) {
+    // Stopped by Cleanup().
+    return;
+  }
+  handshake_step_ = nullptr;
+  buffering_stream_->EndStep();
+
+  if (!pending_peer_certificate_digest_algorithm_.empty()) {
+    Buffer digest_value = std::move(pending_peer_certificate_digest_value_);
+    std::string digest_algorithm =
+        std::move(pending_peer_certificate_digest_algorithm_);
+    pending_peer_certificate_digest_algorithm_.clear();
+    if (!SetPeerCertificateDigest(digest_algorithm, digest_value.data(),
+                                  digest_value.size())) {
+      StreamAdapterInterface::OnEvent(stream(), SE_CLOSE, ssl_error_code_);
+      return;
+    }
+  }
+
+  if (int err =
+          HandleHandshakeResult(step->code(), step->ssl_error(),
+                                step->err_code())) {
+    Error("ContinueSSL", err, 0, true);
+    return;
+  }
+  // Packets received while the step ran.
+  if (state_ == SSL_CONNECTING && buffering_stream_->has_input()) {
+    if (int err = ContinueSSL())
+      Error("ContinueSSL", err, 0, true);
+  }
+}
+
+void OpenSSLStreamAdapter::StopHandshakeStep() {
+  if (!handshake_step_) {
+    return;
+  }
+  handshake_step_->Stop();
+  handshake_step_ = nullptr;
+  buffering_stream_->EndStep();
+}
+
 void OpenSSLStreamAdapter::Error(const char* context,
                                  int err,
                                  uint8_t alert,
@@ -910,6 +1183,7 @@ void OpenSSLStreamAdapter::Error(const char* context,
 
 void OpenSSLStreamAdapter::Cleanup(uint8_t alert) {
   RTC_LOG(LS_INFO) << "Cleanup";
+  StopHandshakeStep();
 
   if (state_ != SSL_ERROR) {
     state_ = SSL_CLOSED;
@@ -1003,6 +1277,11 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
   }
 #endif
 
+  if (session_cache_ && !session_cache_->ConfigureSSLContext(ctx)) {
+    SSL_CTX_free(ctx);
+    return nullptr;
+  }
+
   if (identity_ && !identity_->ConfigureIdentity(ctx)) {
     SSL_CTX_free(ctx);
     return nullptr;
@@ -1076,8 +1355,39 @@ bool OpenSSLStreamAdapter::VerifyPeerCertificate() {
   return true;
 }
 
+std::string OpenSSLStreamAdapter::SessionCacheKey() const {
+  if (!identity_ || !HasPeerCertificateDigest()) {
+    return std::string();
+  }
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  size_t digest_length;
+  if (!identity_->certificate().ComputeDigest(DIGEST_SHA_256, digest,
+                                              sizeof(digest), &digest_length)) {
+    return std::string();
+  }
+  return std::string(ssl_mode_ == SSL_MODE_DTLS ? "dtls|" : "tls|") +
+         hex_encode(reinterpret_cast<const char*>(digest), digest_length) +
+         "|" + peer_certificate_digest_algorithm_ + ":" +
+         hex_encode(peer_certificate_digest_value_.data<char>(),
+                    peer_certificate_digest_value_.size());
+}
+
+void OpenSSLStreamAdapter::SetPeerCertChainFromSession() {
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (!cert) {
+    return;
+  }
+  peer_cert_chain_.reset(
+      new SSLCertChain(std::make_unique<OpenSSLCertificate>(cert)));
+  X509_free(cert);
+}
+
 std::unique_ptr<SSLCertChain> OpenSSLStreamAdapter::GetPeerSSLCertChain()
     const {
+  if (handshake_step_) {
+    // Being set by the step.
+    return nullptr;
+  }
   return peer_cert_chain_ ? peer_cert_chain_->Clone() : nullptr;
 }
 
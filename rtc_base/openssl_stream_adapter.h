@@ -19,11 +19,14 @@
 #include <string>
 #include <vector>
 
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/openssl_identity.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
 
 namespace rtc {
 
@@ -79,6 +82,9 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   void SetMode(SSLMode mode) override;
   void SetMaxProtocolVersion(SSLProtocolVersion version) override;
   void SetInitialRetransmissionTimeout(int timeout_ms) override;
+  void SetSessionCache(SSLSessionCache* session_cache) override;
+  // The handshake is only offloaded in DTLS mode.
+  void SetHandshakeTaskQueue(webrtc::TaskQueueBase* task_queue) override;
 
   StreamResult Read(void* data,
                     size_t data_len,
@@ -98,6 +104,7 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
 
   SSLProtocolVersion GetSslVersion() const override;
   bool GetSslVersionBytes(int* version) const override;
+  bool IsSessionResumed() const override;
   // Key Extractor interface
   bool ExportKeyingMaterial(const std::string& label,
                             const uint8_t* context,
@@ -139,6 +146,9 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
 
   enum { MSG_TIMEOUT = MSG_MAX + 1 };
 
+  class BufferingStream;
+  class HandshakeStep;
+
   // The following three methods return 0 on success and a negative
   // error code on failure. The error code may be from OpenSSL or -1
   // on some other error cases, so it can't really be interpreted
@@ -148,6 +158,15 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   int BeginSSL();
   // Perform SSL negotiation steps.
   int ContinueSSL();
+  // Handles the result of a negotiation step, returning as ContinueSSL().
+  int HandleHandshakeResult(int code, int ssl_error, unsigned long err_code);
+
+  // Runs a negotiation step with the packets received so far on
+  // |handshake_task_queue_|, unless one is running already.
+  void StartHandshakeStep();
+  void OnHandshakeStepDone(scoped_refptr<HandshakeStep> step);
+  // Cancels the step in flight, or waits for it if it started.
+  void StopHandshakeStep();
 
   // Error handler helper. signal is given as true for errors in
   // asynchronous contexts (when an error method was not returned
@@ -175,6 +194,13 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // SSL_CTX_set_cert_verify_callback.
   static int SSLVerifyCallback(X509_STORE_CTX* store, void* arg);
 
+  // Returns the key of the sessions between our certificate and the one of
+  // the peer in |session_cache_|, or an empty string if either is unknown.
+  std::string SessionCacheKey() const;
+  // A resumed handshake doesn't carry the certificate of the peer, so it is
+  // taken from the resumed session.
+  void SetPeerCertChainFromSession();
+
   bool WaitingToVerifyPeerCertificate() const {
     return GetClientAuthEnabled() && !peer_certificate_verified_;
   }
@@ -211,6 +237,11 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // Do DTLS or not
   SSLMode ssl_mode_;
 
+  SSLSessionCache* session_cache_ = nullptr;
+  // Key of the session offered to the server, set by BeginSSL() for clients
+  // with a session cache.
+  std::string session_cache_key_;
+
   // Max. allowed protocol version
   SSLProtocolVersion ssl_max_version_;
 
@@ -220,6 +251,18 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
 
   // TODO(https://bugs.webrtc.org/10261): Completely remove this option in M84.
   const bool support_legacy_tls_protocols_flag_;
+
+  webrtc::TaskQueueBase* handshake_task_queue_ = nullptr;
+  // What the SSL object reads and writes when the handshake is offloaded.
+  std::unique_ptr<BufferingStream> buffering_stream_;
+  // The negotiation step in flight. Until it is done, the SSL object,
+  // |buffering_stream_| and |peer_cert_chain_| belong to it.
+  scoped_refptr<HandshakeStep> handshake_step_;
+  // Set by SetPeerCertificateDigest() while a step is in flight, and verified
+  // once it is done.
+  Buffer pending_peer_certificate_digest_value_;
+  std::string pending_peer_certificate_digest_algorithm_;
+  webrtc::ScopedTaskSafety task_safety_;
 };
 
 /////////////////////////////////////////////////////////////////////////////
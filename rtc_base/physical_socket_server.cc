@@ -45,12 +45,15 @@
 #include "rtc_base/arraysize.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/io_uring_socket_server.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/network_monitor.h"
 #include "rtc_base/null_socket_server.h"
 #include "rtc_base/time_utils.h"
 
 #if defined(WEBRTC_LINUX)
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <linux/sockios.h>
 #endif
 
@@ -113,6 +116,19 @@ std::unique_ptr<SocketServer> SocketServer::CreateDefault() {
 #endif
 }
 
+std::unique_ptr<SocketServer> SocketServer::Create(SocketServerType type) {
+#if defined(WEBRTC_USE_IO_URING)
+  if (type == SocketServerType::kIoUring) {
+    std::unique_ptr<IoUringSocketServer> io_uring_server =
+        IoUringSocketServer::Create();
+    if (io_uring_server)
+      return io_uring_server;
+    RTC_LOG(LS_WARNING) << "io_uring unavailable, using the default server";
+  }
+#endif
+  return CreateDefault();
+}
+
 PhysicalSocket::PhysicalSocket(PhysicalSocketServer* ss, SOCKET s)
     : ss_(ss),
       s_(s),
@@ -294,6 +310,8 @@ int PhysicalSocket::GetOption(Option opt, int* value) {
 #if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
     *value = (*value != IP_PMTUDISC_DONT) ? 1 : 0;
 #endif
+  } else if (opt == OPT_SEND_TIMESTAMPS) {
+    *value = (*value != 0) ? 1 : 0;
   } else if (opt == OPT_DSCP) {
 #if defined(WEBRTC_POSIX)
     // unshift DSCP value to get six most significant bits of IP DiffServ field
@@ -311,6 +329,16 @@ int PhysicalSocket::SetOption(Option opt, int value) {
   if (opt == OPT_DONTFRAGMENT) {
 #if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
     value = (value) ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
+#endif
+  } else if (opt == OPT_SEND_TIMESTAMPS) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+    // Software timestamps taken when a datagram is handed from the socket to
+    // the queueing discipline, which happens within the send call, so they
+    // can be read from the error queue as soon as it returns. Each carries
+    // the index of its datagram, counted from 0 when the option is set.
+    value = value ? (SOF_TIMESTAMPING_TX_SCHED | SOF_TIMESTAMPING_SOFTWARE |
+                     SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY)
+                  : 0;
 #endif
   } else if (opt == OPT_DSCP) {
 #if defined(WEBRTC_POSIX)
@@ -324,7 +352,15 @@ int PhysicalSocket::SetOption(Option opt, int value) {
     ::setsockopt(s_, IPPROTO_IP, IP_TOS, (SockOptArg)&value, sizeof(value));
   }
 #endif
-  return ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
+  int ret = ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (opt == OPT_SEND_TIMESTAMPS && ret == 0) {
+    send_timestamps_enabled_ = value != 0;
+    next_send_id_ = 0;
+    send_timestamps_.clear();
+  }
+#endif
+  return ret;
 }
 
 int PhysicalSocket::Send(const void* pv, size_t cb) {
@@ -352,6 +388,40 @@ int PhysicalSocket::Send(const void* pv, size_t cb) {
   return sent;
 }
 
+#if defined(WEBRTC_POSIX)
+int PhysicalSocket::SendV(ArrayView<const ArrayView<const uint8_t>> buffers) {
+  // Enough for a header, a payload and a padding.
+  static constexpr size_t kMaxBuffers = 8;
+  if (buffers.size() > kMaxBuffers)
+    return AsyncSocket::SendV(buffers);
+  iovec iovs[kMaxBuffers];
+  size_t size = 0;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    iovs[i].iov_base = const_cast<uint8_t*>(buffers[i].data());
+    iovs[i].iov_len = buffers[i].size();
+    size += buffers[i].size();
+  }
+  msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_iov = iovs;
+  message.msg_iovlen = buffers.size();
+  int flags = 0;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Suppress SIGPIPE. See Send() for explanation.
+  flags |= MSG_NOSIGNAL;
+#endif
+  int sent = static_cast<int>(::sendmsg(s_, &message, flags));
+  UpdateLastError();
+  MaybeRemapSendError();
+  RTC_DCHECK(sent <= static_cast<int>(size));
+  if ((sent > 0 && sent < static_cast<int>(size)) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+}
+#endif
+
 int PhysicalSocket::SendTo(const void* buffer,
                            size_t length,
                            const SocketAddress& addr) {
@@ -374,9 +444,123 @@ int PhysicalSocket::SendTo(const void* buffer,
       (sent < 0 && IsBlockingError(GetError()))) {
     EnableEvents(DE_WRITE);
   }
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (send_timestamps_enabled_)
+    ReadSendTimestamps(sent >= 0 ? 1 : 0);
+#endif
   return sent;
 }
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+int PhysicalSocket::SendMultipleTo(
+    ArrayView<const ArrayView<const uint8_t>> packets,
+    const SocketAddress& addr) {
+  // Bounded by UIO_MAXIOV, larger batches are sent in several calls.
+  static constexpr size_t kMaxMessages = 64;
+  sockaddr_storage saddr;
+  socklen_t len = static_cast<socklen_t>(addr.ToSockAddrStorage(&saddr));
+  iovec iovs[kMaxMessages];
+  mmsghdr messages[kMaxMessages];
+  int total_sent = 0;
+  if (send_timestamps_enabled_)
+    send_timestamps_.clear();
+  while (static_cast<size_t>(total_sent) < packets.size()) {
+    size_t count =
+        std::min(kMaxMessages, packets.size() - static_cast<size_t>(total_sent));
+    memset(messages, 0, sizeof(messages[0]) * count);
+    for (size_t i = 0; i < count; ++i) {
+      const ArrayView<const uint8_t>& packet = packets[total_sent + i];
+      iovs[i].iov_base = const_cast<uint8_t*>(packet.data());
+      iovs[i].iov_len = packet.size();
+      messages[i].msg_hdr.msg_name = &saddr;
+      messages[i].msg_hdr.msg_namelen = len;
+      messages[i].msg_hdr.msg_iov = &iovs[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    // Suppress SIGPIPE. See Send() for explanation.
+    int sent = ::sendmmsg(s_, messages, static_cast<unsigned int>(count),
+                          MSG_NOSIGNAL);
+    UpdateLastError();
+    MaybeRemapSendError();
+    if (send_timestamps_enabled_)
+      ReadSendTimestamps(sent > 0 ? sent : 0, /*append=*/true);
+    if (sent < 0) {
+      if (IsBlockingError(GetError()))
+        EnableEvents(DE_WRITE);
+      return total_sent > 0 ? total_sent : -1;
+    }
+    total_sent += sent;
+    if (static_cast<size_t>(sent) < count) {
+      // The socket buffer is full.
+      EnableEvents(DE_WRITE);
+      break;
+    }
+  }
+  return total_sent;
+}
+#endif
+
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+int PhysicalSocket::GetSendTimestamps(ArrayView<int64_t> timestamps) {
+  if (!send_timestamps_enabled_)
+    return 0;
+  const size_t count = std::min(timestamps.size(), send_timestamps_.size());
+  std::copy(send_timestamps_.begin(), send_timestamps_.begin() + count,
+            timestamps.begin());
+  return static_cast<int>(count);
+}
+
+void PhysicalSocket::ReadSendTimestamps(size_t count, bool append) {
+  if (!append)
+    send_timestamps_.clear();
+  const uint32_t first_id = next_send_id_ - send_timestamps_.size();
+  send_timestamps_.resize(send_timestamps_.size() + count, -1);
+  next_send_id_ += count;
+  // The timestamps are taken on the realtime clock.
+  const int64_t clock_offset_us = TimeMicros() - TimeUTCMicros();
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(scm_timestamping)) +
+                                CMSG_SPACE(sizeof(sock_extended_err) +
+                                           sizeof(sockaddr_in6))];
+  // Drained completely, so that stale timestamps never signal an error event.
+  while (true) {
+    msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    if (::recvmsg(s_, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+      break;
+    int64_t timestamp = -1;
+    int64_t id = -1;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg;
+         cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET &&
+          cmsg->cmsg_type == SCM_TIMESTAMPING) {
+        scm_timestamping timestamping;
+        memcpy(&timestamping, CMSG_DATA(cmsg), sizeof(timestamping));
+        // The software timestamp is the first one.
+        const timespec& ts = timestamping.ts[0];
+        timestamp = kNumMicrosecsPerSec * static_cast<int64_t>(ts.tv_sec) +
+                    ts.tv_nsec / kNumNanosecsPerMicrosec + clock_offset_us;
+      } else if ((cmsg->cmsg_level == SOL_IP &&
+                  cmsg->cmsg_type == IP_RECVERR) ||
+                 (cmsg->cmsg_level == SOL_IPV6 &&
+                  cmsg->cmsg_type == IPV6_RECVERR)) {
+        sock_extended_err error;
+        memcpy(&error, CMSG_DATA(cmsg), sizeof(error));
+        if (error.ee_errno == ENOMSG &&
+            error.ee_origin == SO_EE_ORIGIN_TIMESTAMPING) {
+          id = error.ee_data;
+        }
+      }
+    }
+    // Timestamps of datagrams sent by earlier calls are dropped.
+    const uint32_t index = static_cast<uint32_t>(id) - first_id;
+    if (timestamp >= 0 && id >= 0 && index < send_timestamps_.size())
+      send_timestamps_[index] = timestamp;
+  }
+}
+#endif
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
@@ -432,6 +616,64 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+int PhysicalSocket::RecvMultipleFrom(ArrayView<ReceiveBuffer> buffers) {
+  // Same bound as for SendMultipleTo(), larger batches are truncated.
+  static constexpr size_t kMaxMessages = 64;
+  // SIOCGSTAMP only returns the timestamp of the last datagram, so the
+  // timestamps are received per datagram instead.
+  if (!recv_timestamps_enabled_) {
+    int value = 1;
+    setsockopt(s_, SOL_SOCKET, SO_TIMESTAMP, &value, sizeof(value));
+    recv_timestamps_enabled_ = true;
+  }
+  const size_t count = std::min(kMaxMessages, buffers.size());
+  sockaddr_storage addrs[kMaxMessages];
+  iovec iovs[kMaxMessages];
+  mmsghdr messages[kMaxMessages];
+  alignas(cmsghdr) char controls[kMaxMessages][CMSG_SPACE(sizeof(timeval))];
+  memset(messages, 0, sizeof(messages[0]) * count);
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = buffers[i].data.data();
+    iovs[i].iov_len = buffers[i].data.size();
+    messages[i].msg_hdr.msg_name = &addrs[i];
+    messages[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    messages[i].msg_hdr.msg_iov = &iovs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_control = controls[i];
+    messages[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+  }
+  int received = ::recvmmsg(s_, messages, static_cast<unsigned int>(count),
+                            MSG_DONTWAIT, nullptr);
+  UpdateLastError();
+  for (int i = 0; i < received; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    buffer.size = std::min<size_t>(messages[i].msg_len, buffer.data.size());
+    SocketAddressFromSockAddrStorage(addrs[i], &buffer.address);
+    buffer.timestamp = -1;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr); cmsg;
+         cmsg = CMSG_NXTHDR(&messages[i].msg_hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP) {
+        timeval tv;
+        memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+        buffer.timestamp =
+            rtc::kNumMicrosecsPerSec * static_cast<int64_t>(tv.tv_sec) +
+            static_cast<int64_t>(tv.tv_usec);
+      }
+    }
+  }
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  if (udp_ || success) {
+    EnableEvents(DE_READ);
+  }
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  return received;
+}
+#endif
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -586,6 +828,24 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_REUSEPORT:
+#if defined(WEBRTC_POSIX) && defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
+    case OPT_SEND_TIMESTAMPS:
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_TIMESTAMPING;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_SEND_TIMESTAMPS not supported.";
+      return -1;
+#endif
     default:
       RTC_NOTREACHED();
       return -1;
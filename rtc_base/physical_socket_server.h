@@ -132,15 +132,30 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   int SetOption(Option opt, int value) override;
 
   int Send(const void* pv, size_t cb) override;
+#if defined(WEBRTC_POSIX)
+  // Sends the buffers with a single sendmsg() call, without copying them.
+  int SendV(ArrayView<const ArrayView<const uint8_t>> buffers) override;
+#endif
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Sends all the packets with a single sendmmsg() call.
+  int SendMultipleTo(ArrayView<const ArrayView<const uint8_t>> packets,
+                     const SocketAddress& addr) override;
+  // Reports the SO_TIMESTAMPING transmit timestamps read from the error queue.
+  int GetSendTimestamps(ArrayView<int64_t> timestamps) override;
+#endif
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   int RecvFrom(void* buffer,
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Receives the datagrams with a single recvmmsg() call.
+  int RecvMultipleFrom(ArrayView<ReceiveBuffer> buffers) override;
+#endif
 
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
@@ -177,11 +192,26 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   virtual void DisableEvents(uint8_t events);
 
   int TranslateOption(Option opt, int* slevel, int* sopt);
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Reads the transmit timestamps of the last |count| datagrams sent from the
+  // error queue, replacing those of the previous send call unless |append|.
+  void ReadSendTimestamps(size_t count, bool append = false);
+#endif
 
   PhysicalSocketServer* ss_;
   SOCKET s_;
   bool udp_;
   int family_ = 0;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Whether SO_TIMESTAMP was enabled for RecvMultipleFrom().
+  bool recv_timestamps_enabled_ = false;
+  // Whether transmit timestamps were enabled with OPT_SEND_TIMESTAMPS.
+  bool send_timestamps_enabled_ = false;
+  // The SOF_TIMESTAMPING_OPT_ID of the next datagram sent.
+  uint32_t next_send_id_ = 0;
+  // Of the datagrams sent by the last send call, -1 where none was read.
+  std::vector<int64_t> send_timestamps_;
+#endif
   CriticalSection crit_;
   int error_ RTC_GUARDED_BY(crit_);
   ConnState state_;
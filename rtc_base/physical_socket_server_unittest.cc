@@ -22,6 +22,7 @@
 #include "rtc_base/socket_unittest.h"
 #include "rtc_base/test_utils.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 #include "test/gtest.h"
 
 namespace rtc {
@@ -408,6 +409,24 @@ TEST_F(PhysicalSocketTest, TestUdpIPv6) {
   SocketTest::TestUdpIPv6();
 }
 
+TEST_F(PhysicalSocketTest, TestUdpBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpBatchIPv4();
+}
+
+TEST_F(PhysicalSocketTest, TestUdpBatchIPv6) {
+  SocketTest::TestUdpBatchIPv6();
+}
+
+TEST_F(PhysicalSocketTest, TestUdpReceiveBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpReceiveBatchIPv4();
+}
+
+TEST_F(PhysicalSocketTest, TestUdpReceiveBatchIPv6) {
+  SocketTest::TestUdpReceiveBatchIPv6();
+}
+
 // Disable for TSan v2, see
 // https://code.google.com/p/webrtc/issues/detail?id=3498 for details.
 // Also disable for MSan, see:
@@ -461,6 +480,70 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+TEST_F(PhysicalSocketTest, ReportsSendTimestamps) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> socket(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  const SocketAddress address = socket->GetLocalAddress();
+  const uint8_t kData[] = {1, 2, 3};
+  int64_t timestamps[2] = {-1, -1};
+  ASSERT_EQ(3, socket->SendTo(kData, sizeof(kData), address));
+  // Not reported unless enabled.
+  EXPECT_EQ(0, socket->GetSendTimestamps(timestamps));
+
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_SEND_TIMESTAMPS, 1));
+  int value = 0;
+  EXPECT_EQ(0, socket->GetOption(Socket::OPT_SEND_TIMESTAMPS, &value));
+  EXPECT_EQ(1, value);
+
+  // The timestamps are converted to rtc::TimeMicros(), allow for some
+  // imprecision of that.
+  const int64_t kToleranceUs = 1000;
+  int64_t before_us = TimeMicros();
+  ASSERT_EQ(3, socket->SendTo(kData, sizeof(kData), address));
+  int64_t after_us = TimeMicros();
+  ASSERT_EQ(1, socket->GetSendTimestamps(timestamps));
+  EXPECT_GE(timestamps[0], before_us - kToleranceUs);
+  EXPECT_LE(timestamps[0], after_us + kToleranceUs);
+
+  const ArrayView<const uint8_t> packets[] = {kData, kData};
+  before_us = TimeMicros();
+  ASSERT_EQ(2, socket->SendMultipleTo(packets, address));
+  after_us = TimeMicros();
+  ASSERT_EQ(2, socket->GetSendTimestamps(timestamps));
+  EXPECT_GE(timestamps[0], before_us - kToleranceUs);
+  EXPECT_LE(timestamps[0], timestamps[1]);
+  EXPECT_LE(timestamps[1], after_us + kToleranceUs);
+}
+#endif
+
+#if defined(SO_REUSEPORT)
+TEST_F(PhysicalSocketTest, ListenersShareAPortWithReusePort) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> first(
+      server_->CreateAsyncSocket(AF_INET, SOCK_STREAM));
+  ASSERT_EQ(0, first->SetOption(Socket::OPT_REUSEPORT, 1));
+  int value = 0;
+  EXPECT_EQ(0, first->GetOption(Socket::OPT_REUSEPORT, &value));
+  EXPECT_NE(0, value);
+  ASSERT_EQ(0, first->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, first->Listen(5));
+  const SocketAddress address = first->GetLocalAddress();
+
+  // Only sockets that set the option too may bind the port.
+  std::unique_ptr<AsyncSocket> other(
+      server_->CreateAsyncSocket(AF_INET, SOCK_STREAM));
+  EXPECT_NE(0, other->Bind(address));
+  std::unique_ptr<AsyncSocket> second(
+      server_->CreateAsyncSocket(AF_INET, SOCK_STREAM));
+  ASSERT_EQ(0, second->SetOption(Socket::OPT_REUSEPORT, 1));
+  EXPECT_EQ(0, second->Bind(address));
+  EXPECT_EQ(0, second->Listen(5));
+}
+#endif
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/rtc_certificate_pool.h"
+
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+
+namespace {
+
+bool SameKeyParams(const KeyParams& a, const KeyParams& b) {
+  if (a.type() != b.type())
+    return false;
+  if (a.type() == KT_ECDSA)
+    return a.ec_curve() == b.ec_curve();
+  return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+         a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+}
+
+class PooledCertificateGenerator : public RTCCertificateGeneratorInterface {
+ public:
+  PooledCertificateGenerator(
+      Thread* signaling_thread,
+      RTCCertificatePool* pool,
+      std::unique_ptr<RTCCertificateGeneratorInterface> fallback)
+      : signaling_thread_(signaling_thread),
+        pool_(pool),
+        fallback_(std::move(fallback)) {
+    RTC_DCHECK(fallback_);
+  }
+
+  // RTCCertificateGeneratorInterface:
+  void GenerateCertificateAsync(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms,
+      const scoped_refptr<RTCCertificateGeneratorCallback>& callback) override {
+    RTC_DCHECK(signaling_thread_->IsCurrent());
+    scoped_refptr<RTCCertificate> certificate =
+        pool_->Take(key_params, expires_ms);
+    if (!certificate) {
+      fallback_->GenerateCertificateAsync(key_params, expires_ms, callback);
+      return;
+    }
+    // Still asynchronous, as the callers expect.
+    signaling_thread_->PostTask(webrtc::ToQueuedTask(
+        [callback, certificate] { callback->OnSuccess(certificate); }));
+  }
+
+ private:
+  Thread* const signaling_thread_;
+  RTCCertificatePool* const pool_;
+  const std::unique_ptr<RTCCertificateGeneratorInterface> fallback_;
+};
+
+}  // namespace
+
+class RTCCertificatePool::GenerationCallback
+    : public RTCCertificateGeneratorCallback {
+ public:
+  GenerationCallback(RTCCertificatePool* pool,
+                     rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety)
+      : pool_(pool), safety_(std::move(safety)) {}
+
+  void OnSuccess(const scoped_refptr<RTCCertificate>& certificate) override {
+    if (safety_->alive())
+      pool_->OnCertificateGenerated(certificate);
+  }
+  void OnFailure() override {
+    if (safety_->alive())
+      pool_->OnCertificateGenerated(nullptr);
+  }
+
+ private:
+  RTCCertificatePool* const pool_;
+  const rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_;
+};
+
+RTCCertificatePool::RTCCertificatePool(
+    Thread* signaling_thread,
+    std::unique_ptr<RTCCertificateGeneratorInterface> generator,
+    const Config& config)
+    : signaling_thread_(signaling_thread),
+      generator_(std::move(generator)),
+      config_(config) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  RTC_DCHECK(generator_);
+  RTC_DCHECK(config_.key_params.IsValid());
+  Refill();
+  rotation_task_ = webrtc::RepeatingTaskHandle::DelayedStart(
+      signaling_thread_,
+      webrtc::TimeDelta::Millis(config_.rotation_interval_ms), [this] {
+        RemoveStale();
+        Refill();
+        return webrtc::TimeDelta::Millis(config_.rotation_interval_ms);
+      });
+}
+
+RTCCertificatePool::~RTCCertificatePool() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  rotation_task_.Stop();
+}
+
+scoped_refptr<RTCCertificate> RTCCertificatePool::Take(
+    const KeyParams& key_params,
+    const absl::optional<uint64_t>& expires_ms) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (expires_ms || !SameKeyParams(key_params, config_.key_params))
+    return nullptr;
+  RemoveStale();
+  scoped_refptr<RTCCertificate> certificate;
+  if (!certificates_.empty()) {
+    certificate = std::move(certificates_.front().certificate);
+    certificates_.pop_front();
+  }
+  Refill();
+  return certificate;
+}
+
+std::unique_ptr<RTCCertificateGeneratorInterface>
+RTCCertificatePool::CreateGenerator(
+    std::unique_ptr<RTCCertificateGeneratorInterface> fallback) {
+  return std::make_unique<PooledCertificateGenerator>(signaling_thread_, this,
+                                                      std::move(fallback));
+}
+
+size_t RTCCertificatePool::ready_count() const {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  return certificates_.size();
+}
+
+void RTCCertificatePool::RemoveStale() {
+  const int64_t now_ms = TimeMillis();
+  const uint64_t min_expiration_ms =
+      TimeUTCMillis() + config_.min_remaining_lifetime_ms;
+  // The oldest certificates are first.
+  while (!certificates_.empty() &&
+         now_ms - certificates_.front().creation_time_ms >=
+             config_.rotation_interval_ms) {
+    certificates_.pop_front();
+  }
+  for (auto it = certificates_.begin(); it != certificates_.end();) {
+    if (it->certificate->Expires() < min_expiration_ms) {
+      it = certificates_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void RTCCertificatePool::Refill() {
+  while (certificates_.size() + pending_count_ < config_.size) {
+    ++pending_count_;
+    generator_->GenerateCertificateAsync(
+        config_.key_params, absl::nullopt,
+        new RefCountedObject<GenerationCallback>(this, task_safety_.flag()));
+  }
+}
+
+void RTCCertificatePool::OnCertificateGenerated(
+    scoped_refptr<RTCCertificate> certificate) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  RTC_DCHECK_GT(pending_count_, 0);
+  --pending_count_;
+  if (!certificate) {
+    // Requested again by the next Take() or rotation.
+    RTC_LOG(LS_WARNING) << "Failed to generate a pooled certificate.";
+    return;
+  }
+  certificates_.push_back({std::move(certificate), TimeMillis()});
+}
+
+}  // namespace rtc
@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_RTC_CERTIFICATE_POOL_H_
+#define RTC_BASE_RTC_CERTIFICATE_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/ssl_identity.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_checker.h"
+
+namespace rtc {
+
+// Keeps |Config::size| certificates generated ahead of time, so that a
+// PeerConnection doesn't wait on the key generation before its first offer or
+// answer. Each certificate is handed out once, and replaced by a new one
+// generated in the background. The certificates close to their expiration, or
+// held for longer than |Config::rotation_interval_ms|, are replaced as well.
+// Must be created, used and destroyed on the signaling thread.
+class RTC_EXPORT RTCCertificatePool {
+ public:
+  struct Config {
+    size_t size = 4;
+    // The parameters of the pooled certificates, which have the default
+    // lifetime.
+    KeyParams key_params;
+    // The certificates expiring sooner are not handed out.
+    int64_t min_remaining_lifetime_ms = 24 * 60 * 60 * 1000;
+    int64_t rotation_interval_ms = 60 * 60 * 1000;
+  };
+
+  // The certificates are generated with |generator|.
+  RTCCertificatePool(
+      Thread* signaling_thread,
+      std::unique_ptr<RTCCertificateGeneratorInterface> generator,
+      const Config& config);
+  ~RTCCertificatePool();
+
+  // Returns a certificate of the pool if one with |key_params| is ready and
+  // |expires_ms| is not set, null otherwise.
+  scoped_refptr<RTCCertificate> Take(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms);
+
+  // Returns a generator handing out the certificates of the pool, and
+  // forwarding the requests the pool can't serve to |fallback|. The pool has
+  // to outlive it.
+  std::unique_ptr<RTCCertificateGeneratorInterface> CreateGenerator(
+      std::unique_ptr<RTCCertificateGeneratorInterface> fallback);
+
+  // The number of certificates ready to be handed out.
+  size_t ready_count() const;
+
+ private:
+  class GenerationCallback;
+  struct PooledCertificate {
+    scoped_refptr<RTCCertificate> certificate;
+    // rtc::TimeMillis() when the certificate was received.
+    int64_t creation_time_ms;
+  };
+
+  // Drops the certificates which shouldn't be handed out anymore.
+  void RemoveStale();
+  // Requests the certificates missing from the pool.
+  void Refill();
+  void OnCertificateGenerated(scoped_refptr<RTCCertificate> certificate);
+
+  Thread* const signaling_thread_;
+  const std::unique_ptr<RTCCertificateGeneratorInterface> generator_;
+  const Config config_;
+  ThreadChecker thread_checker_;
+  std::deque<PooledCertificate> certificates_;
+  // The generation requests not completed yet.
+  size_t pending_count_ = 0;
+  webrtc::RepeatingTaskHandle rotation_task_;
+  webrtc::ScopedTaskSafety task_safety_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_RTC_CERTIFICATE_POOL_H_
@@ -0,0 +1,179 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/rtc_certificate_pool.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+// Keeps the requests until the test completes them.
+class FakeGenerator : public RTCCertificateGeneratorInterface {
+ public:
+  struct Request {
+    KeyParams key_params;
+    scoped_refptr<RTCCertificateGeneratorCallback> callback;
+  };
+
+  explicit FakeGenerator(std::vector<Request>* requests)
+      : requests_(requests) {}
+
+  void GenerateCertificateAsync(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms,
+      const scoped_refptr<RTCCertificateGeneratorCallback>& callback) override {
+    requests_->push_back({key_params, callback});
+  }
+
+ private:
+  std::vector<Request>* const requests_;
+};
+
+class Callback : public RTCCertificateGeneratorCallback {
+ public:
+  void OnSuccess(const scoped_refptr<RTCCertificate>& certificate) override {
+    certificate_ = certificate;
+  }
+  void OnFailure() override {}
+
+  const scoped_refptr<RTCCertificate>& certificate() const {
+    return certificate_;
+  }
+
+ private:
+  scoped_refptr<RTCCertificate> certificate_;
+};
+
+class RTCCertificatePoolTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kSize = 2;
+
+  RTCCertificatePoolTest() {
+    config_.size = kSize;
+    config_.key_params = KeyParams::ECDSA();
+  }
+
+  std::unique_ptr<RTCCertificatePool> CreatePool() {
+    return std::make_unique<RTCCertificatePool>(
+        Thread::Current(), std::make_unique<FakeGenerator>(&requests_),
+        config_);
+  }
+
+  // Completes the pending requests of the pool.
+  std::vector<scoped_refptr<RTCCertificate>> Generate(
+      const absl::optional<uint64_t>& expires_ms = absl::nullopt) {
+    std::vector<scoped_refptr<RTCCertificate>> certificates;
+    std::vector<FakeGenerator::Request> requests = std::move(requests_);
+    requests_.clear();
+    for (const FakeGenerator::Request& request : requests) {
+      certificates.push_back(RTCCertificateGenerator::GenerateCertificate(
+          request.key_params, expires_ms));
+      request.callback->OnSuccess(certificates.back());
+    }
+    return certificates;
+  }
+
+  RTCCertificatePool::Config config_;
+  std::vector<FakeGenerator::Request> requests_;
+};
+
+TEST_F(RTCCertificatePoolTest, FillsThePoolOnCreation) {
+  std::unique_ptr<RTCCertificatePool> pool = CreatePool();
+  EXPECT_EQ(kSize, requests_.size());
+  EXPECT_EQ(0u, pool->ready_count());
+  Generate();
+  EXPECT_EQ(kSize, pool->ready_count());
+  EXPECT_TRUE(requests_.empty());
+}
+
+TEST_F(RTCCertificatePoolTest, HandsOutEachCertificateOnceAndRefills) {
+  std::unique_ptr<RTCCertificatePool> pool = CreatePool();
+  std::vector<scoped_refptr<RTCCertificate>> generated = Generate();
+
+  scoped_refptr<RTCCertificate> first =
+      pool->Take(KeyParams::ECDSA(), absl::nullopt);
+  EXPECT_EQ(generated[0], first);
+  EXPECT_EQ(1u, requests_.size());
+  scoped_refptr<RTCCertificate> second =
+      pool->Take(KeyParams::ECDSA(), absl::nullopt);
+  EXPECT_EQ(generated[1], second);
+  EXPECT_EQ(2u, requests_.size());
+  // Empty until the new certificates are generated.
+  EXPECT_FALSE(pool->Take(KeyParams::ECDSA(), absl::nullopt));
+  EXPECT_EQ(2u, requests_.size());
+  Generate();
+  EXPECT_EQ(kSize, pool->ready_count());
+}
+
+TEST_F(RTCCertificatePoolTest, DoesNotServeOtherParameters) {
+  std::unique_ptr<RTCCertificatePool> pool = CreatePool();
+  Generate();
+  EXPECT_FALSE(pool->Take(KeyParams::RSA(), absl::nullopt));
+  EXPECT_FALSE(pool->Take(KeyParams::ECDSA(), 60000));
+  EXPECT_EQ(kSize, pool->ready_count());
+}
+
+TEST_F(RTCCertificatePoolTest, ReplacesCertificatesCloseToExpiration) {
+  std::unique_ptr<RTCCertificatePool> pool = CreatePool();
+  // Valid for less than |min_remaining_lifetime_ms|.
+  Generate(/*expires_ms=*/60000);
+  EXPECT_FALSE(pool->Take(KeyParams::ECDSA(), absl::nullopt));
+  EXPECT_EQ(kSize, requests_.size());
+  Generate();
+  EXPECT_TRUE(pool->Take(KeyParams::ECDSA(), absl::nullopt));
+}
+
+TEST_F(RTCCertificatePoolTest, RotatesTheCertificates) {
+  ScopedFakeClock clock;
+  std::unique_ptr<RTCCertificatePool> pool = CreatePool();
+  std::vector<scoped_refptr<RTCCertificate>> old_certificates = Generate();
+
+  clock.AdvanceTime(
+      webrtc::TimeDelta::Millis(config_.rotation_interval_ms));
+  Thread::Current()->ProcessMessages(0);
+  EXPECT_EQ(0u, pool->ready_count());
+  EXPECT_EQ(kSize, requests_.size());
+  std::vector<scoped_refptr<RTCCertificate>> new_certificates = Generate();
+  EXPECT_EQ(new_certificates[0], pool->Take(KeyParams::ECDSA(), absl::nullopt));
+}
+
+TEST_F(RTCCertificatePoolTest, GeneratorFallsBackWhenThePoolIsEmpty) {
+  std::unique_ptr<RTCCertificatePool> pool = CreatePool();
+  std::vector<FakeGenerator::Request> fallback_requests;
+  std::unique_ptr<RTCCertificateGeneratorInterface> generator =
+      pool->CreateGenerator(
+          std::make_unique<FakeGenerator>(&fallback_requests));
+  scoped_refptr<Callback> callback(new RefCountedObject<Callback>());
+
+  generator->GenerateCertificateAsync(KeyParams::ECDSA(), absl::nullopt,
+                                      callback);
+  EXPECT_EQ(1u, fallback_requests.size());
+
+  std::vector<scoped_refptr<RTCCertificate>> generated = Generate();
+  generator->GenerateCertificateAsync(KeyParams::ECDSA(), absl::nullopt,
+                                      callback);
+  EXPECT_EQ(1u, fallback_requests.size());
+  // The callback is still invoked asynchronously.
+  EXPECT_FALSE(callback->certificate());
+  EXPECT_EQ_WAIT(generated[0], callback->certificate(), 1000);
+}
+
+}  // namespace
+}  // namespace rtc
@@ -10,4 +10,57 @@
 
 #include "rtc_base/socket.h"
 
-namespace rtc {}  // namespace rtc
+#include <string.h>
+
+#include <vector>
+
+namespace rtc {
+
+int Socket::SendV(ArrayView<const ArrayView<const uint8_t>> buffers) {
+  size_t size = 0;
+  for (const ArrayView<const uint8_t>& buffer : buffers)
+    size += buffer.size();
+  uint8_t stack_data[2048];
+  std::vector<uint8_t> heap_data;
+  uint8_t* data = stack_data;
+  if (size > sizeof(stack_data)) {
+    heap_data.resize(size);
+    data = heap_data.data();
+  }
+  size_t offset = 0;
+  for (const ArrayView<const uint8_t>& buffer : buffers) {
+    if (!buffer.empty())
+      memcpy(data + offset, buffer.data(), buffer.size());
+    offset += buffer.size();
+  }
+  return Send(data, size);
+}
+
+int Socket::SendMultipleTo(ArrayView<const ArrayView<const uint8_t>> packets,
+                           const SocketAddress& addr) {
+  int sent = 0;
+  for (const ArrayView<const uint8_t>& packet : packets) {
+    if (SendTo(packet.data(), packet.size(), addr) < 0)
+      return sent > 0 ? sent : -1;
+    ++sent;
+  }
+  return sent;
+}
+
+int Socket::GetSendTimestamps(ArrayView<int64_t> timestamps) {
+  return 0;
+}
+
+int Socket::RecvMultipleFrom(ArrayView<ReceiveBuffer> buffers) {
+  if (buffers.empty())
+    return 0;
+  ReceiveBuffer& buffer = buffers[0];
+  int received = RecvFrom(buffer.data.data(), buffer.data.size(),
+                          &buffer.address, &buffer.timestamp);
+  if (received < 0)
+    return -1;
+  buffer.size = static_cast<size_t>(received);
+  return 1;
+}
+
+}  // namespace rtc
@@ -25,6 +25,7 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/socket_address.h"
 
@@ -91,13 +92,45 @@ class Socket {
   virtual int Bind(const SocketAddress& addr) = 0;
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
+  // Sends |buffers| one after the other, as Send() would send them copied
+  // into one buffer, and returns the number of bytes sent. The default
+  // implementation makes that copy and calls Send(), so that sockets adapting
+  // Send(), like the SSL adapters, need not override it.
+  virtual int SendV(ArrayView<const ArrayView<const uint8_t>> buffers);
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends each of |packets| as a separate datagram to |addr|, in order.
+  // Returns the number of packets sent, which stops at the first packet that
+  // fails, or -1 if the first one fails. The default implementation calls
+  // SendTo() once per packet.
+  virtual int SendMultipleTo(ArrayView<const ArrayView<const uint8_t>> packets,
+                             const SocketAddress& addr);
+  // Reports when the datagrams sent by the last SendTo() or SendMultipleTo()
+  // call left the socket for the network stack, one timestamp per datagram in
+  // |timestamps|, in order, in rtc::TimeMicros() microseconds and -1 where
+  // the socket has none. Returns the number of datagrams reported, which is 0
+  // unless OPT_SEND_TIMESTAMPS is enabled. The default implementation reports
+  // none.
+  virtual int GetSendTimestamps(ArrayView<int64_t> timestamps);
   // |timestamp| is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   virtual int RecvFrom(void* pv,
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // Storage for one of the datagrams received by RecvMultipleFrom(), and what
+  // was received into it.
+  struct ReceiveBuffer {
+    ArrayView<uint8_t> data;
+    size_t size = 0;
+    SocketAddress address;
+    // In units of microseconds, -1 if unknown.
+    int64_t timestamp = -1;
+  };
+  // Receives up to |buffers.size()| datagrams, each into its own buffer, in
+  // order. Datagrams larger than their buffer are truncated, as in RecvFrom().
+  // Returns the number of datagrams received, or -1 if none could be. The
+  // default implementation calls RecvFrom() once.
+  virtual int RecvMultipleFrom(ArrayView<ReceiveBuffer> buffers);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -118,6 +151,10 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_REUSEPORT,             // Whether other sockets may bind the same port
+                               // (SO_REUSEPORT), to be set before binding.
+    OPT_SEND_TIMESTAMPS,       // Whether the transmit time of the datagrams
+                               // sent is reported by GetSendTimestamps().
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
@@ -23,6 +23,13 @@ class Thread;
 // TODO(deadbeef): Fix this.
 class NetworkBinderInterface;
 
+enum class SocketServerType {
+  // The PhysicalSocketServer.
+  kDefault,
+  // The IoUringSocketServer, where supported, else the default one.
+  kIoUring,
+};
+
 // Provides the ability to wait for activity on a set of sockets.  The Thread
 // class provides a nice wrapper on a socket server.
 //
@@ -33,6 +40,7 @@ class SocketServer : public SocketFactory {
   static const int kForever = -1;
 
   static std::unique_ptr<SocketServer> CreateDefault();
+  static std::unique_ptr<SocketServer> Create(SocketServerType type);
   // When the socket server is installed into a Thread, this function is
   // called to allow the socket server to use the thread's message queue for
   // any messaging that it might need to perform.
@@ -15,6 +15,8 @@
 #include <string.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "rtc_base/arraysize.h"
@@ -185,6 +187,24 @@ void SocketTest::TestUdpIPv6() {
   UdpInternal(kIPv6Loopback);
 }
 
+void SocketTest::TestUdpBatchIPv4() {
+  UdpBatch(kIPv4Loopback);
+}
+
+void SocketTest::TestUdpBatchIPv6() {
+  MAYBE_SKIP_IPV6;
+  UdpBatch(kIPv6Loopback);
+}
+
+void SocketTest::TestUdpReceiveBatchIPv4() {
+  UdpReceiveBatch(kIPv4Loopback);
+}
+
+void SocketTest::TestUdpReceiveBatchIPv6() {
+  MAYBE_SKIP_IPV6;
+  UdpReceiveBatch(kIPv6Loopback);
+}
+
 void SocketTest::TestUdpReadyToSendIPv4() {
 #if !defined(WEBRTC_MAC)
   // TODO(ronghuawu): Enable this test on mac/ios.
@@ -949,6 +969,60 @@ void SocketTest::UdpInternal(const IPAddress& loopback) {
   }
 }
 
+void SocketTest::UdpBatch(const IPAddress& loopback) {
+  SocketAddress empty = EmptySocketAddressWithFamily(loopback.family());
+  std::unique_ptr<TestClient> receiver(new TestClient(absl::WrapUnique(
+      AsyncUDPSocket::Create(ss_, SocketAddress(loopback, 0)))));
+  std::unique_ptr<AsyncUDPSocket> sender(AsyncUDPSocket::Create(ss_, empty));
+  ASSERT_TRUE(sender);
+
+  // Batchable packets are held back until the last packet of the batch, and
+  // then all arrive in order.
+  rtc::PacketOptions options;
+  options.batchable = true;
+  EXPECT_EQ(3, sender->SendTo("foo", 3, receiver->address(), options));
+  EXPECT_EQ(3, sender->SendTo("bar", 3, receiver->address(), options));
+  options.last_packet_in_batch = true;
+  EXPECT_EQ(6, sender->SendTo("bizbaz", 6, receiver->address(), options));
+  // The receive timestamps of datagrams arriving together are not
+  // necessarily increasing, so only the content is checked.
+  for (const char* expected : {"foo", "bar", "bizbaz"}) {
+    std::unique_ptr<TestClient::Packet> packet =
+        receiver->NextPacket(kTimeout);
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(expected, std::string(packet->buf, packet->size));
+  }
+}
+
+void SocketTest::UdpReceiveBatch(const IPAddress& loopback) {
+  SocketAddress empty = EmptySocketAddressWithFamily(loopback.family());
+  AsyncUDPSocket* receive_socket =
+      AsyncUDPSocket::Create(ss_, SocketAddress(loopback, 0));
+  ASSERT_TRUE(receive_socket);
+  receive_socket->SetReceiveBatchSize(4);
+  std::unique_ptr<TestClient> receiver(
+      new TestClient(absl::WrapUnique(receive_socket)));
+  std::unique_ptr<TestClient> sender(
+      new TestClient(absl::WrapUnique(AsyncUDPSocket::Create(ss_, empty))));
+
+  // More datagrams than fit in one batch, which all arrive in order and
+  // from the sender.
+  const std::vector<std::string> packets = {"foo", "bar", "bizbaz", "a",
+                                            "bc",  "def"};
+  for (const std::string& packet : packets) {
+    EXPECT_EQ(static_cast<int>(packet.size()),
+              sender->SendTo(packet.data(), packet.size(),
+                             receiver->address()));
+  }
+  for (const std::string& expected : packets) {
+    std::unique_ptr<TestClient::Packet> packet =
+        receiver->NextPacket(kTimeout);
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(expected, std::string(packet->buf, packet->size));
+    EXPECT_EQ(sender->address().port(), packet->addr.port());
+  }
+}
+
 void SocketTest::UdpReadyToSend(const IPAddress& loopback) {
   SocketAddress empty = EmptySocketAddressWithFamily(loopback.family());
   // RFC 5737 - The blocks 192.0.2.0/24 (TEST-NET-1) ... are provided for use in
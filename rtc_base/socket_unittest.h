@@ -54,6 +54,10 @@ class SocketTest : public ::testing::Test {
   void TestSingleFlowControlCallbackIPv6();
   void TestUdpIPv4();
   void TestUdpIPv6();
+  void TestUdpBatchIPv4();
+  void TestUdpBatchIPv6();
+  void TestUdpReceiveBatchIPv4();
+  void TestUdpReceiveBatchIPv6();
   void TestUdpReadyToSendIPv4();
   void TestUdpReadyToSendIPv6();
   void TestGetSetOptionsIPv4();
@@ -86,6 +90,8 @@ class SocketTest : public ::testing::Test {
   void SocketServerWaitInternal(const IPAddress& loopback);
   void SingleFlowControlCallbackInternal(const IPAddress& loopback);
   void UdpInternal(const IPAddress& loopback);
+  void UdpBatch(const IPAddress& loopback);
+  void UdpReceiveBatch(const IPAddress& loopback);
   void UdpReadyToSend(const IPAddress& loopback);
   void GetSetOptionsInternal(const IPAddress& loopback);
   void SocketRecvTimestamp(const IPAddress& loopback);
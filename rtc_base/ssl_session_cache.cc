@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/ssl_session_cache.h"
+
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/openssl.h"
+
+namespace rtc {
+namespace {
+
+constexpr char kSessionIdContext[] = "webrtc";
+
+}  // namespace
+
+SSLSessionCache::SSLSessionCache(size_t max_sessions)
+    : max_sessions_(max_sessions) {
+  RTC_DCHECK_GT(max_sessions_, 0);
+  RTC_CHECK_EQ(RAND_bytes(ticket_keys_, sizeof(ticket_keys_)), 1);
+}
+
+SSLSessionCache::~SSLSessionCache() {
+  for (const auto& it : sessions_) {
+    SSL_SESSION_free(it.second.session);
+  }
+}
+
+SSL_SESSION* SSLSessionCache::GetSession(const std::string& key) const {
+  CritScope lock(&lock_);
+  auto it = sessions_.find(key);
+  if (it == sessions_.end())
+    return nullptr;
+  SSL_SESSION_up_ref(it->second.session);
+  return it->second.session;
+}
+
+void SSLSessionCache::AddSession(const std::string& key,
+                                 SSL_SESSION* session) {
+  SSL_SESSION_up_ref(session);
+  CritScope lock(&lock_);
+  auto it = sessions_.find(key);
+  if (it != sessions_.end()) {
+    SSL_SESSION_free(it->second.session);
+  } else if (sessions_.size() == max_sessions_) {
+    auto oldest = sessions_.begin();
+    for (auto entry = sessions_.begin(); entry != sessions_.end(); ++entry) {
+      if (entry->second.sequence_number < oldest->second.sequence_number)
+        oldest = entry;
+    }
+    SSL_SESSION_free(oldest->second.session);
+    sessions_.erase(oldest);
+  }
+  sessions_[key] = Entry{session, next_sequence_number_++};
+}
+
+void SSLSessionCache::RemoveSession(const std::string& key) {
+  CritScope lock(&lock_);
+  auto it = sessions_.find(key);
+  if (it == sessions_.end())
+    return;
+  SSL_SESSION_free(it->second.session);
+  sessions_.erase(it);
+}
+
+bool SSLSessionCache::ConfigureSSLContext(SSL_CTX* ctx) const {
+  // Sessions of servers that verify the peer certificate are only resumed
+  // with a session ID context.
+  if (SSL_CTX_set_session_id_context(
+          ctx, reinterpret_cast<const unsigned char*>(kSessionIdContext),
+          sizeof(kSessionIdContext) - 1) != 1) {
+    return false;
+  }
+  // Without a buffer this returns the length of the keys.
+  const long length = SSL_CTX_get_tlsext_ticket_keys(ctx, nullptr, 0);
+  if (length <= 0 || static_cast<size_t>(length) > sizeof(ticket_keys_)) {
+    return false;
+  }
+  return SSL_CTX_set_tlsext_ticket_keys(ctx, const_cast<uint8_t*>(ticket_keys_),
+                                        length) == 1;
+}
+
+}  // namespace rtc
@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SSL_SESSION_CACHE_H_
+#define RTC_BASE_SSL_SESSION_CACHE_H_
+
+#include <openssl/ossl_typ.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+#ifndef OPENSSL_IS_BORINGSSL
+typedef struct ssl_session_st SSL_SESSION;
+#endif
+
+namespace rtc {
+
+// Keeps the sessions of the handshakes SSLStreamAdapters completed as
+// clients, so that a later handshake between the same two certificates
+// resumes the session and takes one round trip instead of two. On the server
+// side the cache provides the key session tickets are encrypted with, so that
+// a ticket issued by one adapter is accepted by the others using the same
+// cache. A cache may be shared by adapters on any thread.
+class RTC_EXPORT SSLSessionCache {
+ public:
+  static constexpr size_t kDefaultMaxSessions = 32;
+  // Long enough for the ticket keys of OpenSSL, which are longer than the
+  // ones of BoringSSL.
+  static constexpr size_t kMaxTicketKeysLength = 80;
+
+  explicit SSLSessionCache(size_t max_sessions = kDefaultMaxSessions);
+  ~SSLSessionCache();
+
+  SSLSessionCache(const SSLSessionCache&) = delete;
+  SSLSessionCache& operator=(const SSLSessionCache&) = delete;
+
+  // Returns the session stored for |key|, up_refed, or null if there is none.
+  SSL_SESSION* GetSession(const std::string& key) const;
+  // Stores |session| for |key| and up_refs it. Any existing session for the
+  // same key is replaced, and the least recently stored session is dropped
+  // when the cache is full.
+  void AddSession(const std::string& key, SSL_SESSION* session);
+  void RemoveSession(const std::string& key);
+
+  // Makes servers using |ctx| encrypt and decrypt session tickets with the
+  // keys of this cache, and accept to resume the sessions of their tickets.
+  bool ConfigureSSLContext(SSL_CTX* ctx) const;
+
+ private:
+  struct Entry {
+    SSL_SESSION* session;
+    int64_t sequence_number;
+  };
+
+  const size_t max_sessions_;
+  uint8_t ticket_keys_[kMaxTicketKeysLength];
+  CriticalSection lock_;
+  std::map<std::string, Entry> sessions_ RTC_GUARDED_BY(lock_);
+  int64_t next_sequence_number_ RTC_GUARDED_BY(lock_) = 0;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_SSL_SESSION_CACHE_H_
@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/ssl_session_cache.h"
+
+#include <openssl/ssl.h>
+
+#include <string>
+
+#include "rtc_base/gunit.h"
+#include "rtc_base/openssl.h"
+
+namespace rtc {
+namespace {
+
+// Checks that |key| maps to |expected| and releases the returned reference.
+void ExpectSession(const SSLSessionCache& cache,
+                   const std::string& key,
+                   SSL_SESSION* expected) {
+  SSL_SESSION* session = cache.GetSession(key);
+  EXPECT_EQ(session, expected);
+  SSL_SESSION_free(session);
+}
+
+TEST(SSLSessionCacheTest, ReturnsTheLastSessionAddedForAKey) {
+  SSL_CTX* ssl_ctx = SSL_CTX_new(DTLS_method());
+  SSL_SESSION* session_1 = SSL_SESSION_new(ssl_ctx);
+  SSL_SESSION* session_2 = SSL_SESSION_new(ssl_ctx);
+
+  SSLSessionCache cache;
+  ExpectSession(cache, "peer", nullptr);
+  cache.AddSession("peer", session_1);
+  ExpectSession(cache, "peer", session_1);
+  cache.AddSession("peer", session_2);
+  ExpectSession(cache, "peer", session_2);
+  cache.RemoveSession("peer");
+  ExpectSession(cache, "peer", nullptr);
+
+  SSL_SESSION_free(session_1);
+  SSL_SESSION_free(session_2);
+  SSL_CTX_free(ssl_ctx);
+}
+
+TEST(SSLSessionCacheTest, DropsTheLeastRecentlyAddedSession) {
+  SSL_CTX* ssl_ctx = SSL_CTX_new(DTLS_method());
+  SSL_SESSION* session_1 = SSL_SESSION_new(ssl_ctx);
+  SSL_SESSION* session_2 = SSL_SESSION_new(ssl_ctx);
+  SSL_SESSION* session_3 = SSL_SESSION_new(ssl_ctx);
+
+  SSLSessionCache cache(/*max_sessions=*/2);
+  cache.AddSession("peer1", session_1);
+  cache.AddSession("peer2", session_2);
+  cache.AddSession("peer1", session_1);
+  cache.AddSession("peer3", session_3);
+  ExpectSession(cache, "peer1", session_1);
+  ExpectSession(cache, "peer2", nullptr);
+  ExpectSession(cache, "peer3", session_3);
+
+  SSL_SESSION_free(session_1);
+  SSL_SESSION_free(session_2);
+  SSL_SESSION_free(session_3);
+  SSL_CTX_free(ssl_ctx);
+}
+
+TEST(SSLSessionCacheTest, ConfiguresSSLContext) {
+  SSL_CTX* ssl_ctx = SSL_CTX_new(DTLS_method());
+  SSLSessionCache cache;
+  EXPECT_TRUE(cache.ConfigureSSLContext(ssl_ctx));
+  SSL_CTX_free(ssl_ctx);
+}
+
+}  // namespace
+}  // namespace rtc
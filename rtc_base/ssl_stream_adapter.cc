@@ -100,10 +100,19 @@ SSLStreamAdapter::SSLStreamAdapter(std::unique_ptr<StreamInterface> stream)
 
 SSLStreamAdapter::~SSLStreamAdapter() {}
 
+void SSLStreamAdapter::SetSessionCache(SSLSessionCache* session_cache) {}
+
+void SSLStreamAdapter::SetHandshakeTaskQueue(
+    webrtc::TaskQueueBase* task_queue) {}
+
 bool SSLStreamAdapter::GetSslCipherSuite(int* cipher_suite) {
   return false;
 }
 
+bool SSLStreamAdapter::IsSessionResumed() const {
+  return false;
+}
+
 bool SSLStreamAdapter::ExportKeyingMaterial(const std::string& label,
                                             const uint8_t* context,
                                             size_t context_len,
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "api/task_queue/task_queue_base.h"
 #include "rtc_base/deprecation.h"
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/ssl_identity.h"
@@ -26,6 +27,8 @@
 
 namespace rtc {
 
+class SSLSessionCache;
+
 // Constants for SSL profile.
 const int TLS_NULL_WITH_NULL_NULL = 0;
 const int SSL_CIPHER_SUITE_MAX_VALUE = 0xFFFF;
@@ -158,6 +161,20 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // This should only be called before StartSSL().
   virtual void SetInitialRetransmissionTimeout(int timeout_ms) = 0;
 
+  // Sets the cache that sessions are resumed from when acting as a client, and
+  // that provides the session ticket keys when acting as a server, see
+  // SSLSessionCache. The cache has to outlive the adapter.
+  // This should only be called before StartSSL().
+  virtual void SetSessionCache(SSLSessionCache* session_cache);
+
+  // Runs the steps of the DTLS handshake, which compute the key exchange and
+  // the signatures, on |task_queue| instead of the thread of the adapter. The
+  // packets a step sends are sent from the thread of the adapter once the step
+  // is done. The queue has to outlive the adapter, and adapters that can't
+  // offload the handshake ignore it.
+  // This should only be called before StartSSL().
+  virtual void SetHandshakeTaskQueue(webrtc::TaskQueueBase* task_queue);
+
   // StartSSL starts negotiation with a peer, whose certificate is verified
   // using the certificate digest. Generally, SetIdentity() and possibly
   // SetServerRole() should have been called before this.
@@ -205,6 +222,9 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // Will return false until the version has been negotiated.
   virtual bool GetSslVersionBytes(int* version) const = 0;
 
+  // Returns true if the handshake resumed the session of an earlier one.
+  virtual bool IsSessionResumed() const;
+
   // Key Exporter interface from RFC 5705
   // Arguments are:
   // label               -- the exporter label.
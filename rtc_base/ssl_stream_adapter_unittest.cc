@@ -23,8 +23,10 @@
 #include "rtc_base/message_digest.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/ssl_identity.h"
+#include "rtc_base/ssl_session_cache.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/task_queue_for_test.h"
 #include "test/field_trial.h"
 
 using ::testing::Combine;
@@ -382,6 +384,33 @@ class SSLStreamAdapterTestBase : public ::testing::Test,
     server_ssl_->SetIdentity(std::move(server_identity));
   }
 
+  // Replaces the client/server adapters by new ones, for a second handshake
+  // between the same identities or, if |new_server_identity| is set, with a
+  // new identity for the server.
+  void RecreateAdapters(bool new_server_identity) {
+    std::unique_ptr<rtc::SSLIdentity> client_identity =
+        client_ssl_->GetIdentityForTesting()->Clone();
+    std::unique_ptr<rtc::SSLIdentity> server_identity =
+        new_server_identity
+            ? rtc::SSLIdentity::Create("server", server_key_type_)
+            : server_ssl_->GetIdentityForTesting()->Clone();
+    client_ssl_.reset();
+    server_ssl_.reset();
+    CreateStreams();
+
+    client_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(client_stream_));
+    server_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(server_stream_));
+
+    client_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+
+    client_ssl_->SetIdentity(std::move(client_identity));
+    server_ssl_->SetIdentity(std::move(server_identity));
+    identities_set_ = false;
+  }
+
   virtual void OnEvent(rtc::StreamInterface* stream, int sig, int err) {
     RTC_LOG(LS_VERBOSE) << "SSLStreamAdapterTestBase::OnEvent sig=" << sig;
 
@@ -1176,6 +1205,103 @@ TEST_P(SSLStreamAdapterTestDTLS, TestDTLSDelayedIdentityWithBogusDigest) {
   TestHandshakeWithDelayedIdentity(false);
 }
 
+// Test that a second handshake between the same identities resumes the
+// session of the first one.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSResumesCachedSession) {
+  rtc::SSLSessionCache client_cache;
+  rtc::SSLSessionCache server_cache;
+  client_ssl_->SetSessionCache(&client_cache);
+  server_ssl_->SetSessionCache(&server_cache);
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsSessionResumed());
+  EXPECT_FALSE(server_ssl_->IsSessionResumed());
+
+  RecreateAdapters(/*new_server_identity=*/false);
+  client_ssl_->SetSessionCache(&client_cache);
+  server_ssl_->SetSessionCache(&server_cache);
+  TestHandshake();
+  EXPECT_TRUE(client_ssl_->IsSessionResumed());
+  EXPECT_TRUE(server_ssl_->IsSessionResumed());
+  std::unique_ptr<rtc::SSLCertChain> cert_chain =
+      client_ssl_->GetPeerSSLCertChain();
+  ASSERT_NE(nullptr, cert_chain);
+  EXPECT_EQ(cert_chain->Get(0).ToPEMString(),
+            server_identity()->certificate().ToPEMString());
+  TestTransfer(100);
+}
+
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSDoesNotResumeWithAnotherIdentity) {
+  rtc::SSLSessionCache client_cache;
+  rtc::SSLSessionCache server_cache;
+  client_ssl_->SetSessionCache(&client_cache);
+  server_ssl_->SetSessionCache(&server_cache);
+  TestHandshake();
+
+  RecreateAdapters(/*new_server_identity=*/true);
+  client_ssl_->SetSessionCache(&client_cache);
+  server_ssl_->SetSessionCache(&server_cache);
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsSessionResumed());
+  EXPECT_FALSE(server_ssl_->IsSessionResumed());
+}
+
+// Without the ticket keys of the cache the server can't resume the session
+// and falls back to a full handshake.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSFullHandshakeWithAnotherServerCache) {
+  rtc::SSLSessionCache client_cache;
+  rtc::SSLSessionCache server_cache;
+  rtc::SSLSessionCache other_server_cache;
+  client_ssl_->SetSessionCache(&client_cache);
+  server_ssl_->SetSessionCache(&server_cache);
+  TestHandshake();
+
+  RecreateAdapters(/*new_server_identity=*/false);
+  client_ssl_->SetSessionCache(&client_cache);
+  server_ssl_->SetSessionCache(&other_server_cache);
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsSessionResumed());
+  EXPECT_FALSE(server_ssl_->IsSessionResumed());
+}
+
+// Test that the handshake completes with its steps run on another thread.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSConnectWithHandshakeTaskQueue) {
+  webrtc::TaskQueueForTest client_queue("client");
+  webrtc::TaskQueueForTest server_queue("server");
+  client_ssl_->SetHandshakeTaskQueue(client_queue.Get());
+  server_ssl_->SetHandshakeTaskQueue(server_queue.Get());
+  TestHandshake();
+  TestTransfer(100);
+}
+
+TEST_P(SSLStreamAdapterTestDTLS,
+       TestDTLSConnectWithHandshakeTaskQueueAndLostFirstPacket) {
+  webrtc::TaskQueueForTest client_queue("client");
+  webrtc::TaskQueueForTest server_queue("server");
+  client_ssl_->SetHandshakeTaskQueue(client_queue.Get());
+  server_ssl_->SetHandshakeTaskQueue(server_queue.Get());
+  SetLoseFirstPacket(true);
+  TestHandshake();
+}
+
+// The certificates are verified once the digests are set after the handshake.
+TEST_P(SSLStreamAdapterTestDTLS,
+       TestDTLSDelayedIdentityWithHandshakeTaskQueue) {
+  webrtc::TaskQueueForTest client_queue("client");
+  webrtc::TaskQueueForTest server_queue("server");
+  client_ssl_->SetHandshakeTaskQueue(client_queue.Get());
+  server_ssl_->SetHandshakeTaskQueue(server_queue.Get());
+  TestHandshakeWithDelayedIdentity(true);
+}
+
+TEST_P(SSLStreamAdapterTestDTLS,
+       TestDTLSDelayedBogusIdentityWithHandshakeTaskQueue) {
+  webrtc::TaskQueueForTest client_queue("client");
+  webrtc::TaskQueueForTest server_queue("server");
+  client_ssl_->SetHandshakeTaskQueue(client_queue.Get());
+  server_ssl_->SetHandshakeTaskQueue(server_queue.Get());
+  TestHandshakeWithDelayedIdentity(false);
+}
+
 // Test DTLS-SRTP with all high ciphers
 TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSrtpHigh) {
   std::vector<int> high;
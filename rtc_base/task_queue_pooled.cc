@@ -0,0 +1,532 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_pooled.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "absl/strings/string_view.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace {
+
+// Number of tasks a pool thread runs in a row from the same queue before it
+// moves on to the next queue.
+constexpr int kMaxTasksPerTurn = 16;
+
+rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
+    TaskQueueFactory::Priority priority) {
+  switch (priority) {
+    case TaskQueueFactory::Priority::HIGH:
+      return rtc::kRealtimePriority;
+    case TaskQueueFactory::Priority::LOW:
+      return rtc::kLowPriority;
+    case TaskQueueFactory::Priority::NORMAL:
+      return rtc::kNormalPriority;
+    default:
+      RTC_NOTREACHED();
+      return rtc::kNormalPriority;
+  }
+}
+
+class TaskQueuePool;
+class PooledTaskQueue;
+
+struct PoolWorker {
+  PoolWorker(TaskQueuePool* pool, size_t index)
+      : pool(pool), index(index) {}
+
+  TaskQueuePool* const pool;
+  const size_t index;
+  rtc::CriticalSection lock;
+  // Queues waiting for this thread, each holding a reference. The thread
+  // takes them from the front, other threads steal them from the back.
+  std::deque<PooledTaskQueue*> runnable RTC_GUARDED_BY(lock);
+  // Auto reset, set to wake the thread up while it is idle.
+  rtc::Event wakeup;
+  std::unique_ptr<rtc::PlatformThread> thread;
+};
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+ABSL_CONST_INIT thread_local PoolWorker* current_worker = nullptr;
+#endif
+
+class TaskQueuePool {
+ public:
+  TaskQueuePool(int num_threads, rtc::ThreadPriority priority);
+  ~TaskQueuePool();
+
+  TaskQueuePool(const TaskQueuePool&) = delete;
+  TaskQueuePool& operator=(const TaskQueuePool&) = delete;
+
+  // Makes |queue| run on one of the threads. Takes over a reference of
+  // |queue|.
+  void Schedule(PooledTaskQueue* queue);
+
+  // Posts |task| to |queue| in |milliseconds|.
+  void PostDelayedTask(PooledTaskQueue* queue,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds);
+  // Deletes the delayed tasks of |queue| that are not yet posted.
+  void CancelDelayedTasks(PooledTaskQueue* queue);
+
+ private:
+  struct DelayedTask {
+    PooledTaskQueue* queue;
+    std::unique_ptr<QueuedTask> task;
+  };
+  // Fire time and posting order.
+  using DelayedTaskKey = std::pair<int64_t, uint64_t>;
+
+  static void RunWorker(void* context);
+  void WorkerLoop(PoolWorker* worker);
+  // Returns the next queue for |worker|, from its own runnable queues or
+  // stolen from another thread, or null if there is none.
+  PooledTaskQueue* TakeQueue(PoolWorker* worker);
+  // Wakes up an idle thread, |preferred| if it is idle.
+  void WakeUpIdleWorker(PoolWorker* preferred);
+
+  static void RunTimer(void* context);
+  void TimerLoop();
+
+  std::vector<std::unique_ptr<PoolWorker>> workers_;
+  std::atomic<size_t> next_worker_{0};
+
+  rtc::CriticalSection idle_lock_;
+  std::vector<PoolWorker*> idle_workers_ RTC_GUARDED_BY(idle_lock_);
+  bool stopping_ RTC_GUARDED_BY(idle_lock_) = false;
+
+  rtc::CriticalSection delayed_lock_;
+  // Each entry holds a reference of its queue.
+  std::map<DelayedTaskKey, DelayedTask> delayed_tasks_
+      RTC_GUARDED_BY(delayed_lock_);
+  uint64_t next_delayed_order_ RTC_GUARDED_BY(delayed_lock_) = 0;
+  bool timer_stopping_ RTC_GUARDED_BY(delayed_lock_) = false;
+  rtc::Event timer_wakeup_;
+  rtc::PlatformThread timer_thread_;
+};
+
+class PooledTaskQueue final : public TaskQueueBase {
+ public:
+  explicit PooledTaskQueue(TaskQueuePool* pool) : pool_(pool) {}
+
+  void Delete() override;
+  void PostTask(std::unique_ptr<QueuedTask> task) override;
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override;
+
+  void AddRef() { ref_count_.IncRef(); }
+  void Release() {
+    if (ref_count_.DecRef() == rtc::RefCountReleaseStatus::kDroppedLastRef)
+      delete this;
+  }
+
+  // Runs up to |max_tasks| tasks on the calling pool thread. Returns true if
+  // tasks are left, and the queue has to be run again.
+  bool RunTasks(int max_tasks);
+
+ private:
+  ~PooledTaskQueue() override = default;
+
+  TaskQueuePool* const pool_;
+  // The owner holds the first reference, the pool one per pending run and
+  // per delayed task.
+  webrtc_impl::RefCounter ref_count_{1};
+  // Set when the queue stops running after Delete() started.
+  rtc::Event stopped_;
+
+  rtc::CriticalSection lock_;
+  std::queue<std::unique_ptr<QueuedTask>> tasks_ RTC_GUARDED_BY(lock_);
+  // Set while the queue waits for a pool thread or runs on one.
+  bool scheduled_ RTC_GUARDED_BY(lock_) = false;
+  bool running_ RTC_GUARDED_BY(lock_) = false;
+  bool deleted_ RTC_GUARDED_BY(lock_) = false;
+};
+
+void PooledTaskQueue::Delete() {
+  RTC_DCHECK(!IsCurrent());
+
+  std::queue<std::unique_ptr<QueuedTask>> pending_tasks;
+  bool running;
+  {
+    rtc::CritScope lock(&lock_);
+    deleted_ = true;
+    pending_tasks.swap(tasks_);
+    running = running_;
+  }
+  // The running task is the last one to run.
+  if (running)
+    stopped_.Wait(rtc::Event::kForever);
+  pool_->CancelDelayedTasks(this);
+
+  // Tasks may post to other queues when deleted, so do it without the lock.
+  while (!pending_tasks.empty())
+    pending_tasks.pop();
+  Release();
+}
+
+void PooledTaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
+  {
+    rtc::CritScope lock(&lock_);
+    // The task is deleted after the lock is released.
+    if (deleted_)
+      return;
+    tasks_.push(std::move(task));
+    if (scheduled_)
+      return;
+    scheduled_ = true;
+  }
+  AddRef();
+  pool_->Schedule(this);
+}
+
+void PooledTaskQueue::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                      uint32_t milliseconds) {
+  pool_->PostDelayedTask(this, std::move(task), milliseconds);
+}
+
+bool PooledTaskQueue::RunTasks(int max_tasks) {
+  {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(scheduled_);
+    if (deleted_) {
+      scheduled_ = false;
+      return false;
+    }
+    running_ = true;
+  }
+
+  {
+    CurrentTaskQueueSetter set_current(this);
+    for (int i = 0; i < max_tasks; ++i) {
+      std::unique_ptr<QueuedTask> task;
+      {
+        rtc::CritScope lock(&lock_);
+        if (deleted_ || tasks_.empty())
+          break;
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      QueuedTask* release_ptr = task.release();
+      if (release_ptr->Run())
+        delete release_ptr;
+    }
+  }
+
+  rtc::CritScope lock(&lock_);
+  running_ = false;
+  if (deleted_) {
+    scheduled_ = false;
+    stopped_.Set();
+    return false;
+  }
+  if (tasks_.empty()) {
+    scheduled_ = false;
+    return false;
+  }
+  return true;
+}
+
+TaskQueuePool::TaskQueuePool(int num_threads, rtc::ThreadPriority priority)
+    : timer_thread_(&TaskQueuePool::RunTimer,
+                    this,
+                    "TaskQueuePoolTimer",
+                    priority) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i)
+    workers_.push_back(std::make_unique<PoolWorker>(this, i));
+  for (auto& worker : workers_) {
+    worker->thread = std::make_unique<rtc::PlatformThread>(
+        &TaskQueuePool::RunWorker, worker.get(), "TaskQueuePool", priority);
+    worker->thread->Start();
+  }
+  timer_thread_.Start();
+}
+
+TaskQueuePool::~TaskQueuePool() {
+  {
+    rtc::CritScope lock(&idle_lock_);
+    stopping_ = true;
+  }
+  for (auto& worker : workers_)
+    worker->wakeup.Set();
+  for (auto& worker : workers_)
+    worker->thread->Stop();
+
+  {
+    rtc::CritScope lock(&delayed_lock_);
+    timer_stopping_ = true;
+  }
+  timer_wakeup_.Set();
+  timer_thread_.Stop();
+
+  // All queues are deleted by now, only the references are left.
+  for (auto& worker : workers_) {
+    rtc::CritScope lock(&worker->lock);
+    for (PooledTaskQueue* queue : worker->runnable)
+      queue->Release();
+  }
+  rtc::CritScope lock(&delayed_lock_);
+  RTC_DCHECK(delayed_tasks_.empty());
+}
+
+void TaskQueuePool::Schedule(PooledTaskQueue* queue) {
+  PoolWorker* worker = nullptr;
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  // Keep queues posted to from a pool thread on that thread, where their data
+  // is likely to be in the cache.
+  if (current_worker && current_worker->pool == this)
+    worker = current_worker;
+#endif
+  if (!worker)
+    worker = workers_[next_worker_++ % workers_.size()].get();
+  {
+    rtc::CritScope lock(&worker->lock);
+    worker->runnable.push_back(queue);
+  }
+  WakeUpIdleWorker(worker);
+}
+
+void TaskQueuePool::WakeUpIdleWorker(PoolWorker* preferred) {
+  PoolWorker* worker;
+  {
+    rtc::CritScope lock(&idle_lock_);
+    if (idle_workers_.empty())
+      return;
+    auto it =
+        std::find(idle_workers_.begin(), idle_workers_.end(), preferred);
+    if (it == idle_workers_.end())
+      it = idle_workers_.end() - 1;
+    worker = *it;
+    idle_workers_.erase(it);
+  }
+  worker->wakeup.Set();
+}
+
+// static
+void TaskQueuePool::RunWorker(void* context) {
+  PoolWorker* worker = static_cast<PoolWorker*>(context);
+  worker->pool->WorkerLoop(worker);
+}
+
+void TaskQueuePool::WorkerLoop(PoolWorker* worker) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  current_worker = worker;
+#endif
+  while (true) {
+    PooledTaskQueue* queue = TakeQueue(worker);
+    if (!queue) {
+      {
+        rtc::CritScope lock(&idle_lock_);
+        if (stopping_)
+          return;
+        idle_workers_.push_back(worker);
+      }
+      // Queues scheduled before this thread became idle did not wake it up.
+      queue = TakeQueue(worker);
+      if (!queue) {
+        worker->wakeup.Wait(rtc::Event::kForever);
+        continue;
+      }
+      rtc::CritScope lock(&idle_lock_);
+      auto it = std::find(idle_workers_.begin(), idle_workers_.end(), worker);
+      if (it != idle_workers_.end())
+        idle_workers_.erase(it);
+    }
+
+    if (queue->RunTasks(kMaxTasksPerTurn)) {
+      // Let the other queues of this thread have their turn first.
+      rtc::CritScope lock(&worker->lock);
+      worker->runnable.push_back(queue);
+    } else {
+      queue->Release();
+    }
+  }
+}
+
+PooledTaskQueue* TaskQueuePool::TakeQueue(PoolWorker* worker) {
+  {
+    rtc::CritScope lock(&worker->lock);
+    if (!worker->runnable.empty()) {
+      PooledTaskQueue* queue = worker->runnable.front();
+      worker->runnable.pop_front();
+      return queue;
+    }
+  }
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    PoolWorker* victim =
+        workers_[(worker->index + i) % workers_.size()].get();
+    rtc::CritScope lock(&victim->lock);
+    if (!victim->runnable.empty()) {
+      PooledTaskQueue* queue = victim->runnable.back();
+      victim->runnable.pop_back();
+      return queue;
+    }
+  }
+  return nullptr;
+}
+
+void TaskQueuePool::PostDelayedTask(PooledTaskQueue* queue,
+                                    std::unique_ptr<QueuedTask> task,
+                                    uint32_t milliseconds) {
+  const int64_t fire_at_ms = rtc::TimeMillis() + milliseconds;
+  queue->AddRef();
+  {
+    rtc::CritScope lock(&delayed_lock_);
+    delayed_tasks_[{fire_at_ms, next_delayed_order_++}] = {queue,
+                                                           std::move(task)};
+  }
+  timer_wakeup_.Set();
+}
+
+void TaskQueuePool::CancelDelayedTasks(PooledTaskQueue* queue) {
+  std::vector<DelayedTask> cancelled;
+  {
+    rtc::CritScope lock(&delayed_lock_);
+    for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+      if (it->second.queue == queue) {
+        cancelled.push_back(std::move(it->second));
+        it = delayed_tasks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (DelayedTask& delayed_task : cancelled) {
+    delayed_task.task = nullptr;
+    delayed_task.queue->Release();
+  }
+}
+
+// static
+void TaskQueuePool::RunTimer(void* context) {
+  static_cast<TaskQueuePool*>(context)->TimerLoop();
+}
+
+void TaskQueuePool::TimerLoop() {
+  while (true) {
+    DelayedTask due_task = {nullptr, nullptr};
+    int wait_ms = rtc::Event::kForever;
+    {
+      rtc::CritScope lock(&delayed_lock_);
+      if (timer_stopping_)
+        return;
+      if (!delayed_tasks_.empty()) {
+        auto first = delayed_tasks_.begin();
+        const int64_t now_ms = rtc::TimeMillis();
+        if (first->first.first <= now_ms) {
+          due_task = std::move(first->second);
+          delayed_tasks_.erase(first);
+        } else {
+          wait_ms = static_cast<int>(
+              std::min<int64_t>(first->first.first - now_ms,
+                                std::numeric_limits<int>::max()));
+        }
+      }
+    }
+    if (due_task.queue) {
+      due_task.queue->PostTask(std::move(due_task.task));
+      due_task.queue->Release();
+      continue;
+    }
+    timer_wakeup_.Wait(wait_ms);
+  }
+}
+
+class TaskQueuePooledFactory final : public TaskQueueFactory {
+ public:
+  // With |num_threads| 0, uses the process wide pools.
+  explicit TaskQueuePooledFactory(int num_threads)
+      : num_threads_(num_threads) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new PooledTaskQueue(GetPool(priority)));
+  }
+
+ private:
+  static size_t PoolIndex(Priority priority) {
+    switch (priority) {
+      case Priority::HIGH:
+        return 0;
+      case Priority::LOW:
+        return 2;
+      case Priority::NORMAL:
+      default:
+        return 1;
+    }
+  }
+
+  TaskQueuePool* GetPool(Priority priority) const {
+    const size_t index = PoolIndex(priority);
+    if (num_threads_ == 0) {
+      // Created on first use and never destroyed, as task queues may outlive
+      // any factory.
+      static rtc::CriticalSection* const default_lock =
+          new rtc::CriticalSection();
+      static std::array<TaskQueuePool*, 3> default_pools = {};
+      rtc::CritScope lock(default_lock);
+      if (!default_pools[index]) {
+        default_pools[index] = new TaskQueuePool(
+            std::max<int>(1, CpuInfo::DetectNumberOfCores()),
+            TaskQueuePriorityToThreadPriority(priority));
+      }
+      return default_pools[index];
+    }
+    rtc::CritScope lock(&lock_);
+    if (!pools_[index]) {
+      pools_[index] = std::make_unique<TaskQueuePool>(
+          num_threads_, TaskQueuePriorityToThreadPriority(priority));
+    }
+    return pools_[index].get();
+  }
+
+  const int num_threads_;
+  mutable rtc::CriticalSection lock_;
+  mutable std::array<std::unique_ptr<TaskQueuePool>, 3> pools_
+      RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueuePooledFactory() {
+  return std::make_unique<TaskQueuePooledFactory>(0);
+}
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueuePooledFactory(
+    int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  return std::make_unique<TaskQueuePooledFactory>(num_threads);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,37 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_POOLED_H_
+#define RTC_BASE_TASK_QUEUE_POOLED_H_
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Creates task queues that don't own a thread. Each priority has a pool of
+// threads, one per core, shared by all task queues of that priority in the
+// process. A task queue is picked up by one pool thread at a time, which runs
+// a few of its tasks before it gives other queues a turn, and idle threads
+// steal queues from busy ones. Tasks of a queue never overlap and run in FIFO
+// order, so the queues are sequences as SequenceChecker expects, but
+// consecutive tasks may run on different threads. Tasks that block until
+// tasks of other queues ran hold a pool thread meanwhile, so too many of them
+// at once can starve the pool.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueuePooledFactory();
+
+// Same as above but with pools of |num_threads| threads owned by the factory.
+// The factory has to outlive the task queues it creates.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueuePooledFactory(int num_threads);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_POOLED_H_
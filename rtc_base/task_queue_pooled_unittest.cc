@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_pooled.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_test.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread_types.h"
+#include "rtc_base/synchronization/sequence_checker.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "system_wrappers/include/sleep.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWaitForeverMs = rtc::Event::kForever;
+
+std::unique_ptr<TaskQueueFactory> CreateDefaultPooledFactory() {
+  return CreateTaskQueuePooledFactory();
+}
+
+std::unique_ptr<TaskQueueFactory> CreateTwoThreadPooledFactory() {
+  return CreateTaskQueuePooledFactory(2);
+}
+
+INSTANTIATE_TEST_SUITE_P(Pooled,
+                         TaskQueueTest,
+                         ::testing::Values(CreateDefaultPooledFactory,
+                                           CreateTwoThreadPooledFactory));
+
+TEST(TaskQueuePooledTest, ManyQueuesShareThePoolThreads) {
+  constexpr int kNumQueues = 50;
+  auto factory = CreateTaskQueuePooledFactory(2);
+  rtc::CriticalSection lock;
+  std::set<rtc::PlatformThreadId> thread_ids;
+  rtc::Event done;
+  std::atomic<int> remaining(kNumQueues);
+
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> queues;
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues.push_back(factory->CreateTaskQueue(
+        "queue", TaskQueueFactory::Priority::NORMAL));
+  }
+  for (auto& queue : queues) {
+    queue->PostTask(ToQueuedTask([&] {
+      {
+        rtc::CritScope cs(&lock);
+        thread_ids.insert(rtc::CurrentThreadId());
+      }
+      if (--remaining == 0)
+        done.Set();
+    }));
+  }
+  EXPECT_TRUE(done.Wait(kWaitForeverMs));
+
+  rtc::CritScope cs(&lock);
+  EXPECT_LE(thread_ids.size(), 2u);
+}
+
+TEST(TaskQueuePooledTest, TasksOfAQueueRunInOrderWithoutOverlap) {
+  constexpr int kNumQueues = 8;
+  constexpr int kNumTasks = 200;
+  auto factory = CreateTaskQueuePooledFactory(4);
+  struct QueueState {
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue;
+    std::atomic<bool> in_task{false};
+    std::vector<int> order;
+    rtc::Event done;
+  };
+  std::vector<std::unique_ptr<QueueState>> states;
+  for (int i = 0; i < kNumQueues; ++i) {
+    states.push_back(std::make_unique<QueueState>());
+    states.back()->queue = factory->CreateTaskQueue(
+        "queue", TaskQueueFactory::Priority::NORMAL);
+  }
+  for (int task = 0; task < kNumTasks; ++task) {
+    for (auto& state : states) {
+      QueueState* s = state.get();
+      s->queue->PostTask(ToQueuedTask([s, task] {
+        EXPECT_FALSE(s->in_task.exchange(true));
+        s->order.push_back(task);
+        s->in_task = false;
+        if (task == kNumTasks - 1)
+          s->done.Set();
+      }));
+    }
+  }
+  for (auto& state : states) {
+    EXPECT_TRUE(state->done.Wait(kWaitForeverMs));
+    ASSERT_EQ(state->order.size(), static_cast<size_t>(kNumTasks));
+    for (int task = 0; task < kNumTasks; ++task)
+      EXPECT_EQ(state->order[task], task);
+  }
+}
+
+TEST(TaskQueuePooledTest, QueueIsASequence) {
+  auto factory = CreateTaskQueuePooledFactory(4);
+  auto queue =
+      factory->CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+  SequenceChecker checker;
+  checker.Detach();
+  rtc::Event done;
+  constexpr int kNumTasks = 100;
+  for (int i = 0; i < kNumTasks; ++i) {
+    queue->PostTask(ToQueuedTask([&checker, &done, i] {
+      EXPECT_TRUE(checker.IsCurrent());
+      if (i == kNumTasks - 1)
+        done.Set();
+    }));
+  }
+  EXPECT_TRUE(done.Wait(kWaitForeverMs));
+}
+
+TEST(TaskQueuePooledTest, DeleteWaitsForTheRunningTask) {
+  auto factory = CreateTaskQueuePooledFactory(2);
+  auto queue =
+      factory->CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+  rtc::Event started;
+  std::atomic<bool> finished(false);
+  queue->PostTask(ToQueuedTask([&] {
+    started.Set();
+    SleepMs(50);
+    finished = true;
+  }));
+  queue->PostTask(ToQueuedTask([] { ADD_FAILURE(); }));
+  EXPECT_TRUE(started.Wait(kWaitForeverMs));
+  queue = nullptr;
+  EXPECT_TRUE(finished);
+}
+
+}  // namespace
+}  // namespace webrtc
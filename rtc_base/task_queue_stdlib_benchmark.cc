@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/task_queue_stdlib.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kTasksPerProducer = 100000;
+
+struct Producer {
+  TaskQueueBase* queue;
+  int* num_run;
+  int num_tasks;
+  rtc::Event* done;
+};
+
+void ProducerMain(void* context) {
+  Producer* producer = static_cast<Producer*>(context);
+  for (int i = 0; i < kTasksPerProducer; ++i) {
+    producer->queue->PostTask(ToQueuedTask([producer] {
+      if (++*producer->num_run == producer->num_tasks)
+        producer->done->Set();
+    }));
+  }
+}
+
+// Posts tasks from |num_producers| threads at once, like packets arriving in
+// bursts, and reports the time until the task queue ran them all.
+void RunContention(int num_producers) {
+  auto factory = CreateTaskQueueStdlibFactory();
+  auto queue =
+      factory->CreateTaskQueue("consumer", TaskQueueFactory::Priority::NORMAL);
+  int num_run = 0;
+  rtc::Event done;
+  Producer producer{queue.get(), &num_run, num_producers * kTasksPerProducer,
+                    &done};
+
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_producers; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &ProducerMain, &producer, "producer"));
+  }
+  const int64_t start_us = rtc::TimeMicros();
+  for (auto& thread : threads)
+    thread->Start();
+  EXPECT_TRUE(done.Wait(rtc::Event::kForever));
+  const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  for (auto& thread : threads)
+    thread->Stop();
+
+  test::PrintResult("post_and_run_time_per_task", "",
+                    "producers_" + std::to_string(num_producers),
+                    static_cast<double>(elapsed_us) /
+                        (num_producers * kTasksPerProducer) /
+                        rtc::kNumMicrosecsPerMillisec,
+                    "ms", false, test::ImproveDirection::kSmallerIsBetter);
+}
+
+TEST(TaskQueueStdlibBenchmark, PostContention) {
+  for (int num_producers : {1, 2, 4, 8})
+    RunContention(num_producers);
+}
+
+}  // namespace
+}  // namespace webrtc
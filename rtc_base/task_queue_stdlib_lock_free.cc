@@ -0,0 +1,378 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_stdlib.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
+    TaskQueueFactory::Priority priority) {
+  switch (priority) {
+    case TaskQueueFactory::Priority::HIGH:
+      return rtc::kRealtimePriority;
+    case TaskQueueFactory::Priority::LOW:
+      return rtc::kLowPriority;
+    case TaskQueueFactory::Priority::NORMAL:
+      return rtc::kNormalPriority;
+    default:
+      RTC_NOTREACHED();
+      return rtc::kNormalPriority;
+  }
+}
+
+class TaskQueueStdlib final : public TaskQueueBase {
+ public:
+  TaskQueueStdlib(absl::string_view queue_name, rtc::ThreadPriority priority);
+  ~TaskQueueStdlib() override;
+
+  void Delete() override;
+  void PostTask(std::unique_ptr<QueuedTask> task) override;
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override;
+
+ private:
+  using OrderId = uint64_t;
+
+  struct DelayedEntryTimeout {
+    int64_t next_fire_at_ms_{};
+    OrderId order_{};
+
+    bool operator<(const DelayedEntryTimeout& o) const {
+      return std::tie(next_fire_at_ms_, order_) <
+             std::tie(o.next_fire_at_ms_, o.order_);
+    }
+  };
+
+  struct DelayedEntry {
+    DelayedEntryTimeout timeout_;
+    std::unique_ptr<QueuedTask> run_task_;
+
+    // Orders the heap of delayed tasks with the earliest one on top.
+    static bool FiresLater(const DelayedEntry& a, const DelayedEntry& b) {
+      return b.timeout_ < a.timeout_;
+    }
+  };
+
+  // A posted task, linked into |incoming_| by the posting thread and then
+  // into |pending_head_| by the worker thread when it is an immediate task.
+  struct IncomingTask {
+    IncomingTask* next_{};
+    OrderId order_{};
+    bool delayed_{false};
+    int64_t fire_at_ms_{};
+    std::unique_ptr<QueuedTask> run_task_;
+  };
+
+  struct NextTask {
+    bool final_task_{false};
+    std::unique_ptr<QueuedTask> run_task_;
+    int64_t sleep_time_ms_{};
+  };
+
+  void Push(IncomingTask* incoming);
+
+  // Moves the tasks posted since the last call to the pending and delayed
+  // queues.
+  void TakeIncomingTasks();
+
+  NextTask GetNextTask();
+
+  static void ThreadMain(void* context);
+
+  void ProcessTasks();
+
+  void NotifyWake();
+
+  // Indicates if the thread has started.
+  rtc::Event started_;
+
+  // Indicates if the thread has stopped.
+  rtc::Event stopped_;
+
+  // Signaled whenever a new task is pending while the thread waits.
+  rtc::Event flag_notify_;
+
+  // Contains the active worker thread assigned to processing
+  // tasks (including delayed tasks).
+  rtc::PlatformThread thread_;
+
+  // Indicates if the worker thread needs to shutdown now.
+  std::atomic<bool> thread_should_quit_{false};
+
+  // Set while the worker thread waits, or is about to, for |flag_notify_|.
+  std::atomic<bool> waiting_{false};
+
+  // Holds the next order to use for the next task to be
+  // put into one of the pending queues.
+  std::atomic<OrderId> thread_posting_order_{};
+
+  // Tasks posted and not yet taken by the worker thread, newest first.
+  // Posting threads push onto it without a lock and the worker thread takes
+  // the whole list at once, so there is a single consumer and no ABA problem.
+  std::atomic<IncomingTask*> incoming_{nullptr};
+
+  // The members below are only accessed on the worker thread, or after it
+  // stopped.
+
+  // The list of all pending tasks that need to be processed in the
+  // FIFO queue ordering on the worker thread.
+  IncomingTask* pending_head_ = nullptr;
+  IncomingTask* pending_tail_ = nullptr;
+
+  // Heap of all pending tasks that need to be processed at a future time
+  // based upon a delay. On the off change the delayed task should happen at
+  // exactly the same time interval as another task then the task is
+  // processed based on FIFO ordering.
+  std::vector<DelayedEntry> delayed_queue_;
+};
+
+TaskQueueStdlib::TaskQueueStdlib(absl::string_view queue_name,
+                                 rtc::ThreadPriority priority)
+    : started_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      stopped_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      thread_(&TaskQueueStdlib::ThreadMain, this, queue_name, priority) {
+  thread_.Start();
+  started_.Wait(rtc::Event::kForever);
+}
+
+TaskQueueStdlib::~TaskQueueStdlib() {
+  TakeIncomingTasks();
+  while (pending_head_) {
+    IncomingTask* next = pending_head_->next_;
+    delete pending_head_;
+    pending_head_ = next;
+  }
+}
+
+void TaskQueueStdlib::Delete() {
+  RTC_DCHECK(!IsCurrent());
+
+  thread_should_quit_.store(true);
+
+  NotifyWake();
+
+  stopped_.Wait(rtc::Event::kForever);
+  thread_.Stop();
+  delete this;
+}
+
+void TaskQueueStdlib::PostTask(std::unique_ptr<QueuedTask> task) {
+  IncomingTask* incoming = new IncomingTask();
+  incoming->run_task_ = std::move(task);
+  Push(incoming);
+}
+
+void TaskQueueStdlib::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                      uint32_t milliseconds) {
+  IncomingTask* incoming = new IncomingTask();
+  incoming->delayed_ = true;
+  incoming->fire_at_ms_ = rtc::TimeMillis() + milliseconds;
+  incoming->run_task_ = std::move(task);
+  Push(incoming);
+}
+
+void TaskQueueStdlib::Push(IncomingTask* incoming) {
+  incoming->order_ = thread_posting_order_.fetch_add(1);
+  incoming->next_ = incoming_.load(std::memory_order_relaxed);
+  while (!incoming_.compare_exchange_weak(incoming->next_, incoming)) {
+  }
+
+  NotifyWake();
+}
+
+void TaskQueueStdlib::TakeIncomingTasks() {
+  IncomingTask* incoming = incoming_.exchange(nullptr);
+  // Reverse the list into posting order.
+  IncomingTask* posted = nullptr;
+  while (incoming) {
+    IncomingTask* next = incoming->next_;
+    incoming->next_ = posted;
+    posted = incoming;
+    incoming = next;
+  }
+
+  while (posted) {
+    IncomingTask* next = posted->next_;
+    if (posted->delayed_) {
+      DelayedEntry entry;
+      entry.timeout_.next_fire_at_ms_ = posted->fire_at_ms_;
+      entry.timeout_.order_ = posted->order_;
+      entry.run_task_ = std::move(posted->run_task_);
+      delayed_queue_.push_back(std::move(entry));
+      std::push_heap(delayed_queue_.begin(), delayed_queue_.end(),
+                     &DelayedEntry::FiresLater);
+      delete posted;
+    } else {
+      posted->next_ = nullptr;
+      if (pending_tail_)
+        pending_tail_->next_ = posted;
+      else
+        pending_head_ = posted;
+      pending_tail_ = posted;
+    }
+    posted = next;
+  }
+}
+
+TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
+  NextTask result{};
+
+  auto tick = rtc::TimeMillis();
+
+  if (thread_should_quit_.load()) {
+    result.final_task_ = true;
+    return result;
+  }
+
+  TakeIncomingTasks();
+
+  auto pop_pending = [this] {
+    IncomingTask* entry = pending_head_;
+    pending_head_ = entry->next_;
+    if (!pending_head_)
+      pending_tail_ = nullptr;
+    std::unique_ptr<QueuedTask> run_task = std::move(entry->run_task_);
+    delete entry;
+    return run_task;
+  };
+
+  if (delayed_queue_.size() > 0) {
+    const auto& delay_info = delayed_queue_.front().timeout_;
+    if (tick >= delay_info.next_fire_at_ms_) {
+      if (pending_head_ && pending_head_->order_ < delay_info.order_) {
+        result.run_task_ = pop_pending();
+        return result;
+      }
+
+      std::pop_heap(delayed_queue_.begin(), delayed_queue_.end(),
+                    &DelayedEntry::FiresLater);
+      result.run_task_ = std::move(delayed_queue_.back().run_task_);
+      delayed_queue_.pop_back();
+      return result;
+    }
+
+    result.sleep_time_ms_ = delay_info.next_fire_at_ms_ - tick;
+  }
+
+  if (pending_head_)
+    result.run_task_ = pop_pending();
+
+  return result;
+}
+
+// static
+void TaskQueueStdlib::ThreadMain(void* context) {
+  TaskQueueStdlib* me = static_cast<TaskQueueStdlib*>(context);
+  CurrentTaskQueueSetter set_current(me);
+  me->ProcessTasks();
+}
+
+void TaskQueueStdlib::ProcessTasks() {
+  started_.Set();
+
+  while (true) {
+    auto task = GetNextTask();
+
+    if (task.final_task_)
+      break;
+
+    if (task.run_task_) {
+      // process entry immediately then try again
+      QueuedTask* release_ptr = task.run_task_.release();
+      if (release_ptr->Run())
+        delete release_ptr;
+
+      // attempt to sleep again
+      continue;
+    }
+
+    // Posting threads only signal |flag_notify_| while |waiting_| is set, so
+    // look for tasks posted before it was set once more before waiting.
+    waiting_.store(true);
+    if (incoming_.load() || thread_should_quit_.load()) {
+      waiting_.store(false);
+      continue;
+    }
+
+    if (0 == task.sleep_time_ms_)
+      flag_notify_.Wait(rtc::Event::kForever);
+    else
+      flag_notify_.Wait(task.sleep_time_ms_);
+    waiting_.store(false);
+  }
+
+  stopped_.Set();
+}
+
+void TaskQueueStdlib::NotifyWake() {
+  // The queue holds pending tasks to complete. Either tasks are to be
+  // executed immediately or tasks are to be run at some future delayed time.
+  // For immediate tasks the task queue's thread is busy running the task and
+  // the thread will not be waiting on the flag_notify_ event. If no immediate
+  // tasks are available but a delayed task is pending then the thread will be
+  // waiting on flag_notify_ with a delayed time-out of the nearest timed task
+  // to run. If no immediate or pending tasks are available, the thread will
+  // wait on flag_notify_ until signaled that a task has been added (or the
+  // thread to be told to shutdown).
+
+  // When a new immediate task, delayed task, or request to shutdown the thread
+  // is added while the thread waits, or is about to, flag_notify_ is signaled
+  // after. The thread then wakes up immediately and re-assesses what task
+  // needs to be run next (i.e. run a task now, wait for the nearest timed
+  // delayed task, or shutdown the thread). A busy thread is not signaled, so
+  // bursts of tasks posted to it don't make a system call each.
+
+  // Any immediate or delayed pending task (or request to shutdown the thread)
+  // must always be added to the queue prior to checking waiting_, and the
+  // thread sets waiting_ prior to checking the queue a last time. With
+  // sequentially consistent accesses, either the thread finds the task or the
+  // task finds the thread waiting, so the thread can't miss a task and wait
+  // for a signal that may never happen.
+  if (waiting_.exchange(false))
+    flag_notify_.Set();
+}
+
+class TaskQueueStdlibFactory final : public TaskQueueFactory {
+ public:
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new TaskQueueStdlib(name, TaskQueuePriorityToThreadPriority(priority)));
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueStdlibFactory() {
+  return std::make_unique<TaskQueueStdlibFactory>();
+}
+
+}  // namespace webrtc
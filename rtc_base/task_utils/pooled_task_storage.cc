@@ -0,0 +1,38 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/pooled_task_storage.h"
+
+#include "rtc_base/memory/size_class_pool.h"
+
+namespace webrtc {
+namespace webrtc_new_closure_impl {
+namespace {
+
+SizeClassPool* TaskStoragePool() {
+  static SizeClassPool* const pool =
+      SizeClassPool::Create({/*size_classes=*/{64, 128, 256},
+                             /*batch_size=*/32,
+                             /*max_shared_batches=*/16});
+  return pool;
+}
+
+}  // namespace
+
+void* AllocateTaskStorage(size_t size) {
+  return TaskStoragePool()->Allocate(size);
+}
+
+void FreeTaskStorage(void* storage, size_t size) {
+  TaskStoragePool()->Free(storage, size);
+}
+
+}  // namespace webrtc_new_closure_impl
+}  // namespace webrtc
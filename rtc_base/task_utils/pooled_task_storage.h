@@ -0,0 +1,44 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_UTILS_POOLED_TASK_STORAGE_H_
+#define RTC_BASE_TASK_UTILS_POOLED_TASK_STORAGE_H_
+
+#include <stddef.h>
+
+#include "api/task_queue/queued_task.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+namespace webrtc_new_closure_impl {
+
+// Storage for small tasks, from a SizeClassPool, so that it is reused instead
+// of returned to the heap, also when tasks posted by one thread are deleted on
+// another.
+RTC_EXPORT void* AllocateTaskStorage(size_t size);
+// |size| has to be the size passed to AllocateTaskStorage().
+RTC_EXPORT void FreeTaskStorage(void* storage, size_t size);
+
+// Base for the tasks ToQueuedTask() creates, so that posting them to a task
+// queue doesn't allocate in the steady state.
+class PooledQueuedTask : public QueuedTask {
+ public:
+  static void* operator new(size_t size) { return AllocateTaskStorage(size); }
+  // QueuedTask has a virtual destructor, so |size| is the size of the most
+  // derived task.
+  static void operator delete(void* storage, size_t size) {
+    FreeTaskStorage(storage, size);
+  }
+};
+
+}  // namespace webrtc_new_closure_impl
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_UTILS_POOLED_TASK_STORAGE_H_
@@ -11,18 +11,26 @@
 #ifndef RTC_BASE_TASK_UTILS_TO_QUEUED_TASK_H_
 #define RTC_BASE_TASK_UTILS_TO_QUEUED_TASK_H_
 
+#include <stddef.h>
+
 #include <memory>
 #include <type_traits>
 #include <utility>
 
 #include "api/task_queue/queued_task.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
+#include "rtc_base/task_utils/pooled_task_storage.h"
 
 namespace webrtc {
 namespace webrtc_new_closure_impl {
 // Simple implementation of QueuedTask for use with rtc::Bind and lambdas.
 template <typename Closure>
-class ClosureTask : public QueuedTask {
+class ClosureTask : public PooledQueuedTask {
+  // The pooled storage has the alignment of the heap.
+  static_assert(alignof(typename std::decay<Closure>::type) <=
+                    alignof(max_align_t),
+                "Over-aligned closures are not supported");
+
  public:
   explicit ClosureTask(Closure&& closure)
       : closure_(std::forward<Closure>(closure)) {}
@@ -37,7 +45,11 @@ class ClosureTask : public QueuedTask {
 };
 
 template <typename Closure>
-class SafetyClosureTask : public QueuedTask {
+class SafetyClosureTask : public PooledQueuedTask {
+  static_assert(alignof(typename std::decay<Closure>::type) <=
+                    alignof(max_align_t),
+                "Over-aligned closures are not supported");
+
  public:
   explicit SafetyClosureTask(rtc::scoped_refptr<PendingTaskSafetyFlag> safety,
                              Closure&& closure)
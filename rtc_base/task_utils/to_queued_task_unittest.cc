@@ -144,5 +144,31 @@ TEST(ToQueuedTaskTest, PendingTaskSafetyFlag) {
   EXPECT_EQ(1, count);
 }
 
+TEST(ToQueuedTaskTest, ReusesStorageOfDeletedTask) {
+  int count = 0;
+  auto task1 = ToQueuedTask([&count] { ++count; });
+  const QueuedTask* storage = task1.get();
+  RunTask(std::move(task1));
+  auto task2 = ToQueuedTask([&count] { count += 2; });
+  EXPECT_EQ(storage, task2.get());
+  RunTask(std::move(task2));
+  EXPECT_EQ(3, count);
+}
+
+TEST(ToQueuedTaskTest, AcceptsClosureLargerThanPooledStorage) {
+  struct LargeClosure {
+    void operator()() { *sum = data[0] + data[sizeof(data) - 1]; }
+    int* sum;
+    char data[1024];
+  };
+  int sum = 0;
+  LargeClosure closure;
+  closure.sum = &sum;
+  closure.data[0] = 1;
+  closure.data[sizeof(closure.data) - 1] = 2;
+  RunTask(ToQueuedTask(closure));
+  EXPECT_EQ(3, sum);
+}
+
 }  // namespace
 }  // namespace webrtc
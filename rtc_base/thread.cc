@@ -35,6 +35,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/null_socket_server.h"
 #include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/thread_cpu_usage.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 
@@ -344,6 +345,7 @@ Thread::Thread(SocketServer* ss, bool do_init)
       fInitialized_(false),
       fDestroyed_(false),
       stop_(0),
+      dispatching_(0),
       ss_(ss) {
   RTC_DCHECK(ss);
   ss_->SetMessageQueue(this);
@@ -449,6 +451,8 @@ bool Thread::Get(Message* pmsg, int cmsWait, bool process_io) {
       // Otherwise, disposed MessageHandlers will cause deadlocks.
       {
         CritScope cs(&crit_);
+        // Messages posted from now on have to wake up the socket server.
+        AtomicOps::ReleaseStore(&dispatching_, 0);
         // On the first pass, check for delayed messages that have been
         // triggered and calculate the next trigger time.
         if (first_pass) {
@@ -527,8 +531,10 @@ void Thread::Post(const Location& posted_from,
 
   // Keep thread safe
   // Add the message to the end of the queue
-  // Signal for the multiplexer to return
+  // Signal for the multiplexer to return, unless the thread is dispatching
+  // and will find the message before it waits again
 
+  bool wake_up;
   {
     CritScope cs(&crit_);
     Message msg;
@@ -537,8 +543,10 @@ void Thread::Post(const Location& posted_from,
     msg.message_id = id;
     msg.pdata = pdata;
     messages_.push_back(msg);
+    wake_up = AtomicOps::AcquireLoad(&dispatching_) == 0;
   }
-  WakeUpSocketServer();
+  if (wake_up)
+    WakeUpSocketServer();
 }
 
 void Thread::PostDelayed(const Location& posted_from,
@@ -572,8 +580,9 @@ void Thread::DoDelayPost(const Location& posted_from,
 
   // Keep thread safe
   // Add to the priority queue. Gets sorted soonest first.
-  // Signal for the multiplexer to return.
+  // Signal for the multiplexer to return, unless the thread is dispatching.
 
+  bool wake_up;
   {
     CritScope cs(&crit_);
     Message msg;
@@ -588,8 +597,10 @@ void Thread::DoDelayPost(const Location& posted_from,
     // will be misordered, and then only briefly.  This is probably ok.
     ++delayed_next_num_;
     RTC_DCHECK_NE(0, delayed_next_num_);
+    wake_up = AtomicOps::AcquireLoad(&dispatching_) == 0;
   }
-  WakeUpSocketServer();
+  if (wake_up)
+    WakeUpSocketServer();
 }
 
 int Thread::GetDelay() {
@@ -660,7 +671,8 @@ void Thread::Dispatch(Message* pmsg) {
   TRACE_EVENT2("webrtc", "Thread::Dispatch", "src_file",
                pmsg->posted_from.file_name(), "src_func",
                pmsg->posted_from.function_name());
-  int64_t start_time = TimeMillis();
+  ScopedTimeSnapshot time_snapshot;
+  int64_t start_time = time_snapshot.time_ms();
   pmsg->phandler->OnMessage(pmsg);
   int64_t end_time = TimeMillis();
   int64_t diff = TimeDiff(end_time, start_time);
@@ -679,6 +691,10 @@ std::unique_ptr<Thread> Thread::CreateWithSocketServer() {
   return std::unique_ptr<Thread>(new Thread(SocketServer::CreateDefault()));
 }
 
+std::unique_ptr<Thread> Thread::CreateWithSocketServer(SocketServerType type) {
+  return std::unique_ptr<Thread>(new Thread(SocketServer::Create(type)));
+}
+
 std::unique_ptr<Thread> Thread::Create() {
   return std::unique_ptr<Thread>(
       new Thread(std::unique_ptr<SocketServer>(new NullSocketServer())));
@@ -828,7 +844,10 @@ void* Thread::PreRun(void* pv) {
 #if defined(WEBRTC_MAC)
   ScopedAutoReleasePool pool;
 #endif
-  thread->Run();
+  {
+    ScopedThreadCpuRegistration cpu_registration(thread->name_.c_str());
+    thread->Run();
+  }
 
   ThreadManager::Instance()->SetCurrentThread(nullptr);
 #ifdef WEBRTC_WIN
@@ -997,6 +1016,10 @@ bool Thread::ProcessMessages(int cmsLoop) {
     Message msg;
     if (!Get(&msg, cmsNext))
       return !IsQuitting();
+    // Only a loop that calls Get() again right after is sure to see the
+    // messages posted while it dispatches.
+    if (cmsLoop == kForever)
+      AtomicOps::ReleaseStore(&dispatching_, 1);
     Dispatch(&msg);
 
     if (cmsLoop != kForever) {
@@ -195,6 +195,7 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   ~Thread() override;
 
   static std::unique_ptr<Thread> CreateWithSocketServer();
+  static std::unique_ptr<Thread> CreateWithSocketServer(SocketServerType type);
   static std::unique_ptr<Thread> Create();
   static Thread* Current();
 
@@ -566,6 +567,11 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
 
   volatile int stop_;
 
+  // Set while ProcessMessages(kForever) dispatches a message, cleared by Get()
+  // before it looks at the queue. Messages posted meanwhile are seen before
+  // the thread waits again, so the socket server needn't be woken up for them.
+  volatile int dispatching_;
+
   // The SocketServer might not be owned by Thread.
   SocketServer* const ss_;
   // Used if SocketServer ownership lies with |this|.
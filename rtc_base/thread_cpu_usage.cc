@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/thread_cpu_usage.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+#if defined(WEBRTC_LINUX)
+#include <time.h>
+#elif defined(WEBRTC_MAC)
+#include <mach/mach_init.h>
+#include <mach/mach_port.h>
+#include <mach/thread_act.h>
+#include <mach/thread_info.h>
+#endif
+
+namespace rtc {
+
+struct ScopedThreadCpuRegistration::Entry {
+  std::string name;
+  PlatformThreadId id;
+  // What the CPU time of the thread is read with from other threads.
+#if defined(WEBRTC_LINUX)
+  clockid_t clock;
+  bool has_clock;
+#elif defined(WEBRTC_MAC)
+  mach_port_t port;
+#elif defined(WEBRTC_WIN)
+  HANDLE handle;
+#endif
+};
+
+namespace {
+
+using Entry = ScopedThreadCpuRegistration::Entry;
+
+struct Registry {
+  CriticalSection lock;
+  // Held while the threads are sampled, so that they are not unregistered,
+  // and their handles closed, in the meantime.
+  std::vector<Entry*> entries RTC_GUARDED_BY(lock);
+};
+
+Registry* GetRegistry() {
+  // Leaked on purpose, threads may still exit during shutdown.
+  static Registry* const registry = new Registry();
+  return registry;
+}
+
+// Returns -1 if it can't be read.
+int64_t ReadCpuTimeNanos(const Entry& entry) {
+#if defined(WEBRTC_LINUX)
+  struct timespec ts;
+  if (entry.has_clock && clock_gettime(entry.clock, &ts) == 0)
+    return ts.tv_sec * kNumNanosecsPerSec + ts.tv_nsec;
+#elif defined(WEBRTC_MAC)
+  thread_basic_info_data_t info;
+  mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+  if (thread_info(entry.port, THREAD_BASIC_INFO,
+                  reinterpret_cast<thread_info_t>(&info),
+                  &count) == KERN_SUCCESS) {
+    return (info.user_time.seconds + info.system_time.seconds) *
+               kNumNanosecsPerSec +
+           (info.user_time.microseconds + info.system_time.microseconds) *
+               kNumNanosecsPerMicrosec;
+  }
+#elif defined(WEBRTC_WIN)
+  // FILETIME resolution is 100 nanosecs.
+  constexpr int64_t kNanosecsPerFiletime = 100;
+  FILETIME create_time;
+  FILETIME exit_time;
+  FILETIME kernel_time;
+  FILETIME user_time;
+  if (entry.handle != nullptr &&
+      GetThreadTimes(entry.handle, &create_time, &exit_time, &kernel_time,
+                     &user_time) != 0) {
+    auto to_nanos = [](const FILETIME& time) {
+      return ((static_cast<int64_t>(time.dwHighDateTime) << 32) +
+              time.dwLowDateTime) *
+             kNanosecsPerFiletime;
+    };
+    return to_nanos(kernel_time) + to_nanos(user_time);
+  }
+#endif
+  return -1;
+}
+
+}  // namespace
+
+ScopedThreadCpuRegistration::ScopedThreadCpuRegistration(const char* name)
+    : entry_(new Entry()) {
+  entry_->name = name;
+  entry_->id = CurrentThreadId();
+#if defined(WEBRTC_LINUX)
+  entry_->has_clock =
+      pthread_getcpuclockid(pthread_self(), &entry_->clock) == 0;
+#elif defined(WEBRTC_MAC)
+  entry_->port = mach_thread_self();
+#elif defined(WEBRTC_WIN)
+  entry_->handle =
+      OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, entry_->id);
+#endif
+  Registry* registry = GetRegistry();
+  CritScope cs(&registry->lock);
+  registry->entries.push_back(entry_);
+}
+
+ScopedThreadCpuRegistration::~ScopedThreadCpuRegistration() {
+  RTC_DCHECK_EQ(entry_->id, CurrentThreadId());
+  {
+    Registry* registry = GetRegistry();
+    CritScope cs(&registry->lock);
+    auto it =
+        std::find(registry->entries.begin(), registry->entries.end(), entry_);
+    RTC_DCHECK(it != registry->entries.end());
+    registry->entries.erase(it);
+  }
+#if defined(WEBRTC_MAC)
+  mach_port_deallocate(mach_task_self(), entry_->port);
+#elif defined(WEBRTC_WIN)
+  if (entry_->handle != nullptr)
+    CloseHandle(entry_->handle);
+#endif
+  delete entry_;
+}
+
+std::vector<ThreadCpuTime> GetRegisteredThreadsCpuTime() {
+  std::vector<ThreadCpuTime> threads;
+  Registry* registry = GetRegistry();
+  CritScope cs(&registry->lock);
+  threads.reserve(registry->entries.size());
+  for (const Entry* entry : registry->entries) {
+    int64_t cpu_time_ns = ReadCpuTimeNanos(*entry);
+    if (cpu_time_ns >= 0)
+      threads.push_back({entry->name, entry->id, cpu_time_ns});
+  }
+  return threads;
+}
+
+ThreadCpuUsageSampler::ThreadCpuUsageSampler()
+    : last_sample_time_ns_(TimeNanos()) {
+  for (const ThreadCpuTime& thread : GetRegisteredThreadsCpuTime())
+    last_cpu_time_ns_[thread.id] = thread.cpu_time_ns;
+}
+
+ThreadCpuUsageSampler::~ThreadCpuUsageSampler() = default;
+
+std::vector<ThreadCpuUsageSampler::Usage> ThreadCpuUsageSampler::Sample() {
+  const int64_t now_ns = TimeNanos();
+  const int64_t elapsed_ns =
+      std::max<int64_t>(now_ns - last_sample_time_ns_, 1);
+  last_sample_time_ns_ = now_ns;
+
+  std::vector<Usage> usages;
+  std::map<PlatformThreadId, int64_t> cpu_time_ns;
+  for (ThreadCpuTime& thread : GetRegisteredThreadsCpuTime()) {
+    // The threads not seen before started after the previous sample.
+    auto last = last_cpu_time_ns_.find(thread.id);
+    int64_t used_ns = thread.cpu_time_ns;
+    if (last != last_cpu_time_ns_.end())
+      used_ns -= std::min(last->second, thread.cpu_time_ns);
+    cpu_time_ns[thread.id] = thread.cpu_time_ns;
+    usages.push_back({std::move(thread.name), thread.id,
+                      static_cast<double>(used_ns) / elapsed_ns});
+  }
+  // Forgets the threads that exited.
+  last_cpu_time_ns_ = std::move(cpu_time_ns);
+
+  std::stable_sort(usages.begin(), usages.end(),
+                   [](const Usage& a, const Usage& b) {
+                     return a.cpu_usage > b.cpu_usage;
+                   });
+  return usages;
+}
+
+}  // namespace rtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_THREAD_CPU_USAGE_H_
+#define RTC_BASE_THREAD_CPU_USAGE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "rtc_base/platform_thread_types.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace rtc {
+
+struct ThreadCpuTime {
+  std::string name;
+  PlatformThreadId id;
+  // CPU time used by the thread since it started, user and system.
+  int64_t cpu_time_ns;
+};
+
+// Adds the current thread to the process wide registry of threads, under
+// |name|, until it is destroyed, which has to be on the same thread.
+// PlatformThread and rtc::Thread register the threads they run.
+class RTC_EXPORT ScopedThreadCpuRegistration {
+ public:
+  explicit ScopedThreadCpuRegistration(const char* name);
+  ~ScopedThreadCpuRegistration();
+
+  ScopedThreadCpuRegistration(const ScopedThreadCpuRegistration&) = delete;
+  ScopedThreadCpuRegistration& operator=(const ScopedThreadCpuRegistration&) =
+      delete;
+
+  struct Entry;
+
+ private:
+  Entry* const entry_;
+};
+
+// Returns the CPU time of every registered thread, in the order they were
+// registered. Thread safe.
+RTC_EXPORT std::vector<ThreadCpuTime> GetRegisteredThreadsCpuTime();
+
+// Computes the CPU usage of the registered threads between two calls to
+// Sample(). Not thread safe.
+class RTC_EXPORT ThreadCpuUsageSampler {
+ public:
+  struct Usage {
+    std::string name;
+    PlatformThreadId id;
+    // Fraction of a core used since the previous sample, or since the thread
+    // started if it started after it.
+    double cpu_usage;
+  };
+
+  ThreadCpuUsageSampler();
+  ~ThreadCpuUsageSampler();
+
+  // Returns the usage of the threads still registered, busiest first.
+  std::vector<Usage> Sample();
+
+ private:
+  int64_t last_sample_time_ns_;
+  std::map<PlatformThreadId, int64_t> last_cpu_time_ns_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_THREAD_CPU_USAGE_H_
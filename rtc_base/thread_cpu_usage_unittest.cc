@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/thread_cpu_usage.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+// Only run the timing tests on non-instrumented builds, like CpuTimeTest.
+#if defined(THREAD_SANITIZER) || defined(MEMORY_SANITIZER) || \
+    defined(ADDRESS_SANITIZER)
+#define MAYBE_TEST(test_name) DISABLED_##test_name
+#else
+#define MAYBE_TEST(test_name) test_name
+#endif
+
+namespace rtc {
+namespace {
+
+constexpr int kProcessingTimeMillisecs = 200;
+
+struct ThreadState {
+  // Whether the thread uses kProcessingTimeMillisecs of CPU time first.
+  bool busy = false;
+  Event ready;
+  Event stop;
+};
+
+void ThreadFunction(void* param) {
+  ThreadState* state = static_cast<ThreadState*>(param);
+  if (state->busy) {
+    int64_t stop_cpu_time = GetThreadCpuTimeNanos() +
+                            kProcessingTimeMillisecs * kNumNanosecsPerMillisec;
+    while (GetThreadCpuTimeNanos() < stop_cpu_time) {
+    }
+  }
+  state->ready.Set();
+  state->stop.Wait(Event::kForever);
+}
+
+bool IsRegistered(const std::string& name) {
+  for (const ThreadCpuTime& thread : GetRegisteredThreadsCpuTime()) {
+    if (thread.name == name)
+      return true;
+  }
+  return false;
+}
+
+TEST(ThreadCpuUsageTest, RegistersTheCurrentThread) {
+  {
+    ScopedThreadCpuRegistration registration("ThreadCpuUsageTest");
+    std::vector<ThreadCpuTime> threads = GetRegisteredThreadsCpuTime();
+    auto it = std::find_if(threads.begin(), threads.end(),
+                           [](const ThreadCpuTime& thread) {
+                             return thread.id == CurrentThreadId();
+                           });
+    ASSERT_NE(it, threads.end());
+    EXPECT_EQ(it->name, "ThreadCpuUsageTest");
+    EXPECT_GE(it->cpu_time_ns, 0);
+  }
+  EXPECT_FALSE(IsRegistered("ThreadCpuUsageTest"));
+}
+
+TEST(ThreadCpuUsageTest, RegistersPlatformThreadsWhileTheyRun) {
+  ThreadState state;
+  PlatformThread thread(&ThreadFunction, &state, "RegisteredThread");
+  thread.Start();
+  ASSERT_TRUE(state.ready.Wait(Event::kForever));
+  EXPECT_TRUE(IsRegistered("RegisteredThread"));
+
+  state.stop.Set();
+  thread.Stop();
+  EXPECT_FALSE(IsRegistered("RegisteredThread"));
+}
+
+TEST(ThreadCpuUsageTest, MAYBE_TEST(SamplesTheBusiestThreadFirst)) {
+  ThreadCpuUsageSampler sampler;
+  ThreadState busy_state;
+  busy_state.busy = true;
+  ThreadState idle_state;
+  PlatformThread busy_thread(&ThreadFunction, &busy_state, "BusyThread");
+  PlatformThread idle_thread(&ThreadFunction, &idle_state, "IdleThread");
+  busy_thread.Start();
+  idle_thread.Start();
+  ASSERT_TRUE(busy_state.ready.Wait(Event::kForever));
+  ASSERT_TRUE(idle_state.ready.Wait(Event::kForever));
+
+  std::vector<ThreadCpuUsageSampler::Usage> usages = sampler.Sample();
+  double busy_usage = -1;
+  double idle_usage = -1;
+  for (size_t i = 1; i < usages.size(); ++i)
+    EXPECT_GE(usages[i - 1].cpu_usage, usages[i].cpu_usage);
+  for (const ThreadCpuUsageSampler::Usage& usage : usages) {
+    if (usage.name == "BusyThread")
+      busy_usage = usage.cpu_usage;
+    if (usage.name == "IdleThread")
+      idle_usage = usage.cpu_usage;
+  }
+  EXPECT_GT(busy_usage, 0.1);
+  EXPECT_GE(idle_usage, 0);
+  EXPECT_LT(idle_usage, busy_usage);
+
+  busy_state.stop.Set();
+  idle_state.stop.Set();
+  busy_thread.Stop();
+  idle_thread.Stop();
+}
+
+}  // namespace
+}  // namespace rtc
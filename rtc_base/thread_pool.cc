@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/thread_pool.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+struct ThreadPool::Batch {
+  explicit Batch(rtc::FunctionView<void(size_t)> job) : job(job) {}
+
+  const rtc::FunctionView<void(size_t)> job;
+  // Guarded by the lock of the pool.
+  size_t remaining = 0;
+  // Set when |remaining| drops to zero.
+  rtc::Event done;
+};
+
+ThreadPool::ThreadPool(int num_threads,
+                       const char* thread_name,
+                       rtc::ThreadPriority priority) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(std::make_unique<rtc::PlatformThread>(
+        &ThreadPool::RunWorker, this, thread_name, priority));
+    threads_.back()->Start();
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(jobs_.empty());
+    stopping_ = true;
+  }
+  wakeup_.Set();
+  for (auto& thread : threads_)
+    thread->Stop();
+}
+
+void ThreadPool::RunAndWait(size_t num_jobs,
+                            rtc::FunctionView<void(size_t)> job) {
+  if (num_jobs == 0)
+    return;
+  Batch batch(job);
+  {
+    rtc::CritScope lock(&lock_);
+    batch.remaining = num_jobs;
+    for (size_t i = 1; i < num_jobs; ++i)
+      jobs_.push_back({&batch, i});
+  }
+  if (num_jobs > 1)
+    wakeup_.Set();
+
+  Run({&batch, 0});
+  // Take back the jobs no thread has started yet.
+  while (true) {
+    Job own_job;
+    {
+      rtc::CritScope lock(&lock_);
+      auto it = std::find_if(jobs_.begin(), jobs_.end(),
+                             [&](const Job& j) { return j.batch == &batch; });
+      if (it == jobs_.end())
+        break;
+      own_job = *it;
+      jobs_.erase(it);
+    }
+    Run(own_job);
+  }
+  batch.done.Wait(rtc::Event::kForever);
+}
+
+void ThreadPool::RunWorker(void* obj) {
+  static_cast<ThreadPool*>(obj)->WorkerLoop();
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    Job job;
+    {
+      rtc::CritScope lock(&lock_);
+      if (stopping_) {
+        // Pass the wakeup on to the next thread.
+        wakeup_.Set();
+        return;
+      }
+      if (jobs_.empty()) {
+        job.batch = nullptr;
+      } else {
+        job = jobs_.front();
+        jobs_.pop_front();
+        if (!jobs_.empty())
+          wakeup_.Set();
+      }
+    }
+    if (!job.batch) {
+      wakeup_.Wait(rtc::Event::kForever);
+      continue;
+    }
+    Run(job);
+  }
+}
+
+void ThreadPool::Run(const Job& job) {
+  job.batch->job(job.index);
+  rtc::CritScope lock(&lock_);
+  // The batch may be gone as soon as |done| is set.
+  if (--job.batch->remaining == 0)
+    job.batch->done.Set();
+}
+
+}  // namespace webrtc
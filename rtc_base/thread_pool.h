@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_THREAD_POOL_H_
+#define RTC_BASE_THREAD_POOL_H_
+
+#include <stddef.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Threads that help a caller run independent jobs at the same time, e.g. the
+// layers of a simulcast encoder or the channels of an audio block.
+// RunAndWait() is a blocking parallel for: the calling thread works on the
+// jobs too and takes back those no thread had time for, so it never waits on
+// a busy pool. It may be called from several threads at the same time.
+// Task queues sharing threads are created by CreateTaskQueuePooledFactory().
+class ThreadPool {
+ public:
+  // |thread_name| must outlive the pool.
+  ThreadPool(int num_threads,
+             const char* thread_name,
+             rtc::ThreadPriority priority);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t num_threads() const { return threads_.size(); }
+
+  // Calls |job| with every index in [0, |num_jobs|), possibly at the same time
+  // on different threads, and returns once all calls returned.
+  void RunAndWait(size_t num_jobs, rtc::FunctionView<void(size_t)> job);
+
+ private:
+  struct Batch;
+  struct Job {
+    Batch* batch;
+    size_t index;
+  };
+
+  static void RunWorker(void* obj);
+  void WorkerLoop();
+  // Runs |job| and reports it done to its batch.
+  void Run(const Job& job);
+
+  rtc::CriticalSection lock_;
+  // Auto reset, every Set() wakes one thread, which wakes the next if more
+  // jobs are left.
+  rtc::Event wakeup_;
+  std::deque<Job> jobs_ RTC_GUARDED_BY(lock_);
+  bool stopping_ RTC_GUARDED_BY(lock_) = false;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_THREAD_POOL_H_
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kTimeoutMs = 5000;
+
+TEST(ThreadPoolTest, RunsEveryJobOnce) {
+  ThreadPool pool(3, "TestThread", rtc::kNormalPriority);
+  for (size_t num_jobs : {0u, 1u, 2u, 4u, 20u}) {
+    for (int batch = 0; batch < 100; ++batch) {
+      std::vector<std::atomic<int>> runs(num_jobs);
+      pool.RunAndWait(num_jobs, [&](size_t index) { ++runs[index]; });
+      for (const auto& count : runs)
+        EXPECT_EQ(count, 1);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, RunsJobsInParallel) {
+  ThreadPool pool(1, "TestThread", rtc::kNormalPriority);
+  rtc::Event started[2];
+  std::atomic<int> timeouts(0);
+  // Each job waits for the other one, which only works if they overlap.
+  pool.RunAndWait(2, [&](size_t index) {
+    started[index].Set();
+    if (!started[1 - index].Wait(kTimeoutMs))
+      ++timeouts;
+  });
+  EXPECT_EQ(timeouts, 0);
+}
+
+struct BlockingCaller {
+  ThreadPool* pool;
+  // Manual reset, both the blocking batch and the test wait for it.
+  rtc::Event worker_busy{/*manual_reset=*/true, /*initially_signaled=*/false};
+  rtc::Event release_worker;
+};
+
+// Blocks the only thread of |caller->pool| until |release_worker| is set.
+void RunBlockingBatch(void* obj) {
+  auto* caller = static_cast<BlockingCaller*>(obj);
+  caller->pool->RunAndWait(2, [caller](size_t index) {
+    if (index == 0) {
+      // Keeps this thread busy, so that the pool thread gets job 1.
+      EXPECT_TRUE(caller->worker_busy.Wait(kTimeoutMs));
+      return;
+    }
+    caller->worker_busy.Set();
+    EXPECT_TRUE(caller->release_worker.Wait(kTimeoutMs));
+  });
+}
+
+TEST(ThreadPoolTest, CallerRunsJobsWhenPoolIsBusy) {
+  ThreadPool pool(1, "TestThread", rtc::kNormalPriority);
+  BlockingCaller blocking_caller;
+  blocking_caller.pool = &pool;
+  rtc::PlatformThread other_caller(&RunBlockingBatch, &blocking_caller,
+                                   "other_caller");
+  other_caller.Start();
+  ASSERT_TRUE(blocking_caller.worker_busy.Wait(kTimeoutMs));
+
+  const rtc::PlatformThreadRef caller = rtc::CurrentThreadRef();
+  std::atomic<int> runs(0);
+  pool.RunAndWait(3, [&](size_t index) {
+    EXPECT_TRUE(rtc::IsThreadRefEqual(rtc::CurrentThreadRef(), caller));
+    ++runs;
+  });
+  EXPECT_EQ(runs, 3);
+
+  blocking_caller.release_worker.Set();
+  other_caller.Stop();
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "rtc_base/thread.h"
 
+#include <atomic>
 #include <memory>
 
 #include "api/task_queue/task_queue_factory.h"
@@ -1104,6 +1105,42 @@ TEST(ThreadPostTaskTest, InvokesInPostedOrder) {
   fourth.Wait(Event::kForever);
 }
 
+class WakeUpCountingSocketServer : public NullSocketServer {
+ public:
+  void WakeUp() override {
+    ++wake_ups_;
+    NullSocketServer::WakeUp();
+  }
+  int wake_ups() const { return wake_ups_; }
+
+ private:
+  std::atomic<int> wake_ups_{0};
+};
+
+TEST(ThreadPostTaskTest, DoesNotWakeUpThreadWhileItDispatches) {
+  auto socket_server = std::make_unique<WakeUpCountingSocketServer>();
+  WakeUpCountingSocketServer* ss = socket_server.get();
+  Thread background_thread(std::move(socket_server));
+  background_thread.Start();
+
+  Event done;
+  int wake_ups_before = -1;
+  int wake_ups_after = -1;
+  background_thread.PostTask(RTC_FROM_HERE, [&] {
+    wake_ups_before = ss->wake_ups();
+    for (int i = 0; i < 10; ++i)
+      background_thread.PostTask(RTC_FROM_HERE, [] {});
+    background_thread.PostTask(RTC_FROM_HERE, [&] {
+      wake_ups_after = ss->wake_ups();
+      done.Set();
+    });
+  });
+  done.Wait(Event::kForever);
+
+  EXPECT_EQ(wake_ups_before, wake_ups_after);
+  background_thread.Stop();
+}
+
 TEST(ThreadPostDelayedTaskTest, InvokesAsynchronously) {
   std::unique_ptr<rtc::Thread> background_thread(rtc::Thread::Create());
   background_thread->Start();
@@ -27,11 +27,21 @@
 // clang-format on
 #endif
 
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/time_utils.h"
 
 namespace rtc {
+namespace {
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+ABSL_CONST_INIT thread_local ScopedTimeSnapshot* current_time_snapshot =
+    nullptr;
+#endif
+
+}  // namespace
 
 ClockInterface* g_clock = nullptr;
 
@@ -219,6 +229,33 @@ int64_t TimeMicros() {
   return TimeNanos() / kNumNanosecsPerMicrosec;
 }
 
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+ScopedTimeSnapshot::ScopedTimeSnapshot()
+    : time_ms_(TimeMillis()), previous_(current_time_snapshot) {
+  current_time_snapshot = this;
+}
+
+ScopedTimeSnapshot::~ScopedTimeSnapshot() {
+  RTC_DCHECK(current_time_snapshot == this);
+  current_time_snapshot = previous_;
+}
+
+int64_t CoarseTimeMillis() {
+  return current_time_snapshot ? current_time_snapshot->time_ms()
+                               : TimeMillis();
+}
+#else
+// Without thread locals the snapshots are only a clock reading.
+ScopedTimeSnapshot::ScopedTimeSnapshot()
+    : time_ms_(TimeMillis()), previous_(nullptr) {}
+
+ScopedTimeSnapshot::~ScopedTimeSnapshot() = default;
+
+int64_t CoarseTimeMillis() {
+  return TimeMillis();
+}
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
 int64_t TimeAfter(int64_t elapsed) {
   RTC_DCHECK_GE(elapsed, 0);
   return TimeMillis() + elapsed;
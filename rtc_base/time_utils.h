@@ -102,6 +102,32 @@ inline int64_t TimeUntil(int64_t later) {
   return later - TimeMillis();
 }
 
+// Snapshots the time for the thread creating it, for as long as it lives.
+// Meant to be created on the stack once per wakeup of an event loop, like
+// rtc::Thread does for each message it dispatches, so that the code run for
+// the event can read the time with CoarseTimeMillis() instead of the clock.
+// Snapshots nest, the innermost one being the current one.
+class RTC_EXPORT ScopedTimeSnapshot {
+ public:
+  ScopedTimeSnapshot();
+  ~ScopedTimeSnapshot();
+
+  ScopedTimeSnapshot(const ScopedTimeSnapshot&) = delete;
+  ScopedTimeSnapshot& operator=(const ScopedTimeSnapshot&) = delete;
+
+  int64_t time_ms() const { return time_ms_; }
+
+ private:
+  const int64_t time_ms_;
+  ScopedTimeSnapshot* const previous_;
+};
+
+// Returns the time of the current ScopedTimeSnapshot of the thread, or
+// TimeMillis() outside of one. Behind TimeMillis() by as long as the current
+// event has been running, so only for the callers reading the time for every
+// packet that do not need more than that.
+RTC_EXPORT int64_t CoarseTimeMillis();
+
 class TimestampWrapAroundHandler {
  public:
   TimestampWrapAroundHandler();
@@ -10,6 +10,9 @@
 
 #include "rtc_base/time_utils.h"
 
+#include <inttypes.h>
+#include <stdio.h>
+
 #include <memory>
 
 #include "api/units/time_delta.h"
@@ -294,4 +297,74 @@ TEST(FakeClock, SettingTimeWakesThreads) {
   EXPECT_LT(real_end_time_ms - real_start_time_ms, 10000);
 }
 
+TEST(CoarseTimeTest, FollowsTheClockOutsideOfASnapshot) {
+  ScopedBaseFakeClock clock;
+  clock.SetTime(webrtc::Timestamp::Millis(1000));
+  EXPECT_EQ(1000, CoarseTimeMillis());
+  clock.AdvanceTime(webrtc::TimeDelta::Millis(5));
+  EXPECT_EQ(1005, CoarseTimeMillis());
+}
+
+TEST(CoarseTimeTest, ReturnsTheTimeOfTheCurrentSnapshot) {
+  ScopedBaseFakeClock clock;
+  clock.SetTime(webrtc::Timestamp::Millis(1000));
+  {
+    ScopedTimeSnapshot snapshot;
+    EXPECT_EQ(1000, snapshot.time_ms());
+    clock.AdvanceTime(webrtc::TimeDelta::Millis(5));
+    EXPECT_EQ(1000, CoarseTimeMillis());
+    {
+      ScopedTimeSnapshot inner_snapshot;
+      clock.AdvanceTime(webrtc::TimeDelta::Millis(5));
+      EXPECT_EQ(1005, CoarseTimeMillis());
+    }
+    EXPECT_EQ(1000, CoarseTimeMillis());
+  }
+  EXPECT_EQ(1010, CoarseTimeMillis());
+}
+
+TEST(CoarseTimeTest, ThreadsSnapshotTheirMessages) {
+  ScopedBaseFakeClock clock;
+  clock.SetTime(webrtc::Timestamp::Millis(1000));
+  ScopedTimeSnapshot snapshot;
+  std::unique_ptr<Thread> worker(Thread::Create());
+  worker->Start();
+
+  clock.AdvanceTime(webrtc::TimeDelta::Millis(5));
+  int64_t worker_time_ms = -1;
+  Event done;
+  worker->PostTask(webrtc::ToQueuedTask([&] {
+    worker_time_ms = CoarseTimeMillis();
+    done.Set();
+  }));
+  ASSERT_TRUE(done.Wait(Event::kForever));
+  worker->Stop();
+
+  EXPECT_EQ(1005, worker_time_ms);
+  EXPECT_EQ(1000, CoarseTimeMillis());
+}
+
+// Compares the cost of reading the clock with the cost of reading a snapshot.
+// Disabled by default and only intended to be run manually.
+TEST(CoarseTimeTest, DISABLED_Performance) {
+  static const int kNumIterations = 10000000;
+  int64_t sum = 0;
+  int64_t start_us = TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i)
+    sum += TimeMillis();
+  const int64_t clock_us = TimeMicros() - start_us;
+
+  ScopedTimeSnapshot snapshot;
+  start_us = TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i)
+    sum += CoarseTimeMillis();
+  const int64_t snapshot_us = TimeMicros() - start_us;
+
+  printf("%d readings of TimeMillis(): %" PRId64 " us\n", kNumIterations,
+         clock_us);
+  printf("%d readings of CoarseTimeMillis(): %" PRId64 " us\n",
+         kNumIterations, snapshot_us);
+  EXPECT_GT(sum, 0);
+}
+
 }  // namespace rtc
@@ -0,0 +1,111 @@
+#  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+#
+#  Use of this source code is governed by a BSD-style license
+#  that can be found in the LICENSE file in the root of the source
+#  tree. An additional intellectual property rights grant can be found
+#  in the file PATENTS.  All contributing project authors may
+#  be found in the AUTHORS file in the root of the source tree.
+"""Computes the BWE model input from a packets table of alphacc_dataset_export.
+
+The features must match BweModelFeatureExtractor in
+modules/remote_bitrate_estimator/bwe_model_features.h, which computes them in
+the receiver, so that the model is trained on what it is run on.
+
+Example:
+  packets = read_dataset.read_table("call.packets.acc")
+  features = compute_features(packets)
+"""
+
+import sys
+
+import read_dataset
+
+# Must match BweModelFeatureExtractor.
+STEP_MS = 100
+MAX_EMPTY_STEPS = 10
+NUM_FEATURES = 5
+
+
+class _Step(object):
+
+  def __init__(self):
+    self.bytes = 0
+    self.packets = 0
+    self.lost_packets = 0
+    self.delay_sum_us = 0
+
+
+def compute_features(packets):
+  """Returns the features of each step ended by |packets|, as lists of
+  NUM_FEATURES values. The step of the last packet is never ended. |packets|
+  is a dict from column name to the column values, in arrival order. Tables
+  exported before the send_time_us column was added fall back to
+  send_time_ms."""
+  if "send_time_us" in packets:
+    send_times_us = [int(value) for value in packets["send_time_us"]]
+  else:
+    send_times_us = [int(value) * 1000 for value in packets["send_time_ms"]]
+  features = []
+  step = _Step()
+  step_start_ms = None
+  min_delay_us = None
+  last_mean_delay_us = 0.0
+  rtt_s = -1.0
+
+  def finish_step():
+    mean_delay_us = last_mean_delay_us
+    if step.packets > 0:
+      mean_delay_us = float(step.delay_sum_us) / step.packets - min_delay_us
+    expected_packets = step.packets + step.lost_packets
+    features.append([
+        step.bytes * 8.0 / (STEP_MS * 1000.0),
+        mean_delay_us / 1e6,
+        (mean_delay_us - last_mean_delay_us) / 1e6,
+        float(step.lost_packets) / expected_packets
+        if expected_packets > 0 else 0.0,
+        rtt_s if rtt_s >= 0 else 0.0,
+    ])
+    return mean_delay_us
+
+  for i in range(len(packets["arrival_time_ms"])):
+    arrival_time_ms = int(packets["arrival_time_ms"][i])
+    if step_start_ms is None:
+      step_start_ms = arrival_time_ms
+    if arrival_time_ms >= step_start_ms + STEP_MS:
+      last_mean_delay_us = finish_step()
+      step = _Step()
+      step_start_ms += STEP_MS
+      empty_steps = (arrival_time_ms - step_start_ms) // STEP_MS
+      if empty_steps > MAX_EMPTY_STEPS:
+        last_mean_delay_us = finish_step()
+        step_start_ms = arrival_time_ms
+      else:
+        for _ in range(empty_steps):
+          last_mean_delay_us = finish_step()
+          step_start_ms += STEP_MS
+
+    step.bytes += (int(packets["payload_size"][i]) +
+                   int(packets["header_length"][i]) +
+                   int(packets["padding_length"][i]))
+    step.packets += 1
+    step.lost_packets += max(int(packets["loss_count"][i]), 0)
+    delay_us = arrival_time_ms * 1000 - send_times_us[i]
+    min_delay_us = delay_us if min_delay_us is None else min(
+        min_delay_us, delay_us)
+    step.delay_sum_us += delay_us
+    if packets["rtt_s"][i] >= 0:
+      rtt_s = float(packets["rtt_s"][i])
+  return features
+
+
+def main(argv):
+  if len(argv) != 2:
+    print("Usage: %s <prefix>.packets.acc" % argv[0])
+    return 1
+  for row in compute_features(read_dataset.read_table(argv[1])):
+    print(",".join("%.9g" % value for value in row))
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(main(sys.argv))
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/alphacc_dataset/columnar_writer.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+namespace {
+
+size_t ValueSize(ColumnType type) {
+  switch (type) {
+    case ColumnType::kUint8:
+      return 1;
+    case ColumnType::kUint16:
+      return 2;
+    case ColumnType::kUint32:
+    case ColumnType::kInt32:
+    case ColumnType::kFloat:
+      return 4;
+    case ColumnType::kInt64:
+    case ColumnType::kDouble:
+      return 8;
+  }
+  RTC_NOTREACHED();
+  return 0;
+}
+
+// Values are copied in host byte order, which is little-endian on every
+// platform the tools run on.
+template <typename T>
+void AppendValue(std::vector<uint8_t>* buffer, T value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer->insert(buffer->end(), bytes, bytes + sizeof(value));
+}
+
+}  // namespace
+
+std::unique_ptr<ColumnarWriter> ColumnarWriter::Create(
+    const std::string& file_name,
+    std::vector<Column> columns,
+    size_t rows_per_chunk) {
+  RTC_DCHECK_GT(rows_per_chunk, 0);
+  FileWrapper file = FileWrapper::OpenWriteOnly(file_name);
+  if (!file.is_open())
+    return nullptr;
+  return std::unique_ptr<ColumnarWriter>(
+      new ColumnarWriter(std::move(file), std::move(columns), rows_per_chunk));
+}
+
+ColumnarWriter::ColumnarWriter(FileWrapper file,
+                               std::vector<Column> columns,
+                               size_t rows_per_chunk)
+    : file_(std::move(file)),
+      columns_(std::move(columns)),
+      rows_per_chunk_(rows_per_chunk),
+      values_(columns_.size()) {
+  std::vector<uint8_t> header;
+  AppendValue(&header, kMagic);
+  AppendValue(&header, kVersion);
+  AppendValue(&header, rtc::checked_cast<uint32_t>(columns_.size()));
+  for (const Column& column : columns_) {
+    AppendValue(&header, static_cast<uint8_t>(column.type));
+    AppendValue(&header, rtc::checked_cast<uint16_t>(column.name.size()));
+    header.insert(header.end(), column.name.begin(), column.name.end());
+  }
+  write_failed_ = !file_.Write(header.data(), header.size());
+  for (size_t i = 0; i < columns_.size(); ++i)
+    values_[i].reserve(rows_per_chunk_ * ValueSize(columns_[i].type));
+}
+
+ColumnarWriter::~ColumnarWriter() {
+  Close();
+}
+
+void ColumnarWriter::Append(size_t column, const void* value, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(value);
+  values_[column].insert(values_[column].end(), bytes, bytes + size);
+}
+
+void ColumnarWriter::EndRow() {
+  ++rows_;
+#if RTC_DCHECK_IS_ON
+  for (size_t i = 0; i < columns_.size(); ++i)
+    RTC_DCHECK_EQ(values_[i].size(), rows_ * ValueSize(columns_[i].type));
+#endif
+  if (rows_ == rows_per_chunk_)
+    WriteChunk();
+}
+
+void ColumnarWriter::WriteChunk() {
+  if (rows_ == 0)
+    return;
+  std::vector<uint8_t> row_count;
+  AppendValue(&row_count, rtc::checked_cast<uint32_t>(rows_));
+  bool ok = file_.Write(row_count.data(), row_count.size());
+  for (std::vector<uint8_t>& values : values_) {
+    ok = ok && file_.Write(values.data(), values.size());
+    values.clear();
+  }
+  write_failed_ = write_failed_ || !ok;
+  rows_ = 0;
+}
+
+bool ColumnarWriter::Close() {
+  if (!file_.is_open())
+    return !write_failed_;
+  WriteChunk();
+  write_failed_ = !file_.Close() || write_failed_;
+  return !write_failed_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_ALPHACC_DATASET_COLUMNAR_WRITER_H_
+#define RTC_TOOLS_ALPHACC_DATASET_COLUMNAR_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/file_wrapper.h"
+
+namespace webrtc {
+
+enum class ColumnType : uint8_t {
+  kUint8 = 0,
+  kUint16 = 1,
+  kUint32 = 2,
+  kInt32 = 3,
+  kInt64 = 4,
+  kFloat = 5,
+  kDouble = 6,
+};
+
+template <typename T>
+struct ColumnTypeOf;
+template <>
+struct ColumnTypeOf<uint8_t> {
+  static constexpr ColumnType kType = ColumnType::kUint8;
+};
+template <>
+struct ColumnTypeOf<uint16_t> {
+  static constexpr ColumnType kType = ColumnType::kUint16;
+};
+template <>
+struct ColumnTypeOf<uint32_t> {
+  static constexpr ColumnType kType = ColumnType::kUint32;
+};
+template <>
+struct ColumnTypeOf<int32_t> {
+  static constexpr ColumnType kType = ColumnType::kInt32;
+};
+template <>
+struct ColumnTypeOf<int64_t> {
+  static constexpr ColumnType kType = ColumnType::kInt64;
+};
+template <>
+struct ColumnTypeOf<float> {
+  static constexpr ColumnType kType = ColumnType::kFloat;
+};
+template <>
+struct ColumnTypeOf<double> {
+  static constexpr ColumnType kType = ColumnType::kDouble;
+};
+
+// Writes a table to a file in a simple chunked columnar layout:
+//   Header: the magic "ACC1", a uint32 version and a uint32 column count,
+//           then for every column a uint8 ColumnType, a uint16 name length
+//           and the name.
+//   Chunks: until the end of the file, a uint32 row count followed by the
+//           values of every column for those rows, one column after the
+//           other.
+// Values are stored little-endian. Since a column is contiguous within a
+// chunk it can be loaded without per-row parsing, read_dataset.py does so
+// with numpy.
+class ColumnarWriter {
+ public:
+  struct Column {
+    std::string name;
+    ColumnType type;
+  };
+
+  static constexpr uint32_t kMagic = 0x31434341;  // "ACC1"
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kDefaultRowsPerChunk = 64 * 1024;
+
+  // Returns null if |file_name| can't be opened for writing.
+  static std::unique_ptr<ColumnarWriter> Create(
+      const std::string& file_name,
+      std::vector<Column> columns,
+      size_t rows_per_chunk = kDefaultRowsPerChunk);
+
+  ColumnarWriter(const ColumnarWriter&) = delete;
+  ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+  // Writes the rows that haven't been yet.
+  ~ColumnarWriter();
+
+  // Sets the value of |column| in the current row. Every column must be set
+  // exactly once per row, with a value of the column's type.
+  template <typename T>
+  void Set(size_t column, T value) {
+    RTC_DCHECK_LT(column, columns_.size());
+    RTC_DCHECK(columns_[column].type == ColumnTypeOf<T>::kType);
+    Append(column, &value, sizeof(value));
+  }
+  // Ends the current row, writing a chunk once |rows_per_chunk| rows have
+  // been ended.
+  void EndRow();
+
+  // Writes the rows that haven't been yet and returns false if any write so
+  // far has failed.
+  bool Close();
+
+ private:
+  ColumnarWriter(FileWrapper file,
+                 std::vector<Column> columns,
+                 size_t rows_per_chunk);
+
+  void Append(size_t column, const void* value, size_t size);
+  void WriteChunk();
+
+  FileWrapper file_;
+  const std::vector<Column> columns_;
+  const size_t rows_per_chunk_;
+  // The values of the current chunk, one buffer per column.
+  std::vector<std::vector<uint8_t>> values_;
+  size_t rows_ = 0;
+  bool write_failed_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_ALPHACC_DATASET_COLUMNAR_WRITER_H_
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/alphacc_dataset/columnar_writer.h"
+
+#include <string.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+class ColumnarWriterTest : public ::testing::Test {
+ protected:
+  ColumnarWriterTest()
+      : path_(test::TempFilename(test::OutputPath(), "columnar_writer")) {}
+  ~ColumnarWriterTest() override { test::RemoveFile(path_); }
+
+  std::vector<uint8_t> ReadFile() const {
+    std::ifstream file(path_, std::ios_base::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>());
+  }
+
+  const std::string path_;
+};
+
+template <typename T>
+T ReadValue(const std::vector<uint8_t>& data, size_t* offset) {
+  T value;
+  memcpy(&value, data.data() + *offset, sizeof(value));
+  *offset += sizeof(value);
+  return value;
+}
+
+TEST_F(ColumnarWriterTest, WritesHeaderAndChunks) {
+  {
+    std::unique_ptr<ColumnarWriter> writer = ColumnarWriter::Create(
+        path_, {{"a", ColumnType::kInt64}, {"bc", ColumnType::kUint8}},
+        /*rows_per_chunk=*/2);
+    ASSERT_TRUE(writer);
+    for (int i = 0; i < 3; ++i) {
+      writer->Set(0, int64_t{100 + i});
+      writer->Set(1, static_cast<uint8_t>(i));
+      writer->EndRow();
+    }
+    EXPECT_TRUE(writer->Close());
+  }
+
+  const std::vector<uint8_t> data = ReadFile();
+  size_t offset = 0;
+  EXPECT_EQ(ReadValue<uint32_t>(data, &offset), ColumnarWriter::kMagic);
+  EXPECT_EQ(ReadValue<uint32_t>(data, &offset), ColumnarWriter::kVersion);
+  EXPECT_EQ(ReadValue<uint32_t>(data, &offset), 2u);
+  EXPECT_EQ(ReadValue<uint8_t>(data, &offset),
+            static_cast<uint8_t>(ColumnType::kInt64));
+  EXPECT_EQ(ReadValue<uint16_t>(data, &offset), 1u);
+  EXPECT_EQ(ReadValue<char>(data, &offset), 'a');
+  EXPECT_EQ(ReadValue<uint8_t>(data, &offset),
+            static_cast<uint8_t>(ColumnType::kUint8));
+  EXPECT_EQ(ReadValue<uint16_t>(data, &offset), 2u);
+  EXPECT_EQ(ReadValue<char>(data, &offset), 'b');
+  EXPECT_EQ(ReadValue<char>(data, &offset), 'c');
+
+  // A full chunk of two rows, with the values of each column together.
+  EXPECT_EQ(ReadValue<uint32_t>(data, &offset), 2u);
+  EXPECT_EQ(ReadValue<int64_t>(data, &offset), 100);
+  EXPECT_EQ(ReadValue<int64_t>(data, &offset), 101);
+  EXPECT_EQ(ReadValue<uint8_t>(data, &offset), 0u);
+  EXPECT_EQ(ReadValue<uint8_t>(data, &offset), 1u);
+
+  // The remaining row is written on Close().
+  EXPECT_EQ(ReadValue<uint32_t>(data, &offset), 1u);
+  EXPECT_EQ(ReadValue<int64_t>(data, &offset), 102);
+  EXPECT_EQ(ReadValue<uint8_t>(data, &offset), 2u);
+  EXPECT_EQ(offset, data.size());
+}
+
+TEST_F(ColumnarWriterTest, WritesOnlyHeaderWithoutRows) {
+  {
+    std::unique_ptr<ColumnarWriter> writer =
+        ColumnarWriter::Create(path_, {{"a", ColumnType::kDouble}});
+    ASSERT_TRUE(writer);
+  }
+  EXPECT_EQ(ReadFile().size(), 12u + 1 + 2 + 1);
+}
+
+TEST(ColumnarWriterCreateTest, ReturnsNullIfFileCantBeOpened) {
+  EXPECT_FALSE(ColumnarWriter::Create("", {{"a", ColumnType::kInt32}}));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,225 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/alphacc_dataset/dataset_export.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "modules/remote_bitrate_estimator/abs_send_time_unwrapper.h"
+#include "modules/remote_bitrate_estimator/receive_side_feature_provider.h"
+#include "modules/third_party/statcollect/StatRecorder.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_tools/alphacc_dataset/columnar_writer.h"
+
+namespace webrtc {
+namespace {
+
+enum PacketColumn {
+  kArrivalTimeMs,
+  kSendTimeMs,
+  kSsrc,
+  kPaddingLength,
+  kHeaderLength,
+  kPayloadSize,
+  kLossCount,
+  kRttSeconds,
+  kSequenceNumber,
+  kPayloadType,
+  kWindow,
+  kSendTimeUs,
+};
+
+enum WindowColumn {
+  kFirstPacket,
+  kPacketCount,
+  kEndTimeMs,
+  kTargetRateBps,
+};
+
+}  // namespace
+
+AlphaCcDataset DatasetFromEventLog(const ParsedRtcEventLog& log) {
+  std::vector<const LoggedRtpPacket*> rtp_packets;
+  for (const auto& stream : log.incoming_rtp_packets_by_ssrc()) {
+    for (const LoggedRtpPacketIncoming& packet : stream.incoming_packets)
+      rtp_packets.push_back(&packet.rtp);
+  }
+  std::stable_sort(rtp_packets.begin(), rtp_packets.end(),
+                   [](const LoggedRtpPacket* a, const LoggedRtpPacket* b) {
+                     return a->log_time_us() < b->log_time_us();
+                   });
+  std::vector<const LoggedAlphaCcEstimateEvent*> estimates;
+  for (const LoggedAlphaCcEstimateEvent& estimate :
+       log.alpha_cc_estimate_events()) {
+    if (estimate.source == RtcEventAlphaCcEstimate::Source::kSent)
+      estimates.push_back(&estimate);
+  }
+
+  AlphaCcDataset dataset;
+  dataset.packets.reserve(rtp_packets.size());
+  dataset.estimates.reserve(estimates.size());
+  ReceiveSideFeatureProvider feature_provider;
+  AbsSendTimeUnwrapper send_time_unwrapper;
+  auto next_estimate = estimates.begin();
+  auto add_estimate = [&] {
+    const LoggedAlphaCcEstimateEvent& estimate = **next_estimate++;
+    DatasetEstimate dataset_estimate;
+    dataset_estimate.time_ms = estimate.log_time_ms();
+    dataset_estimate.num_packets_before = dataset.packets.size();
+    dataset_estimate.target_rate_bps = estimate.target_rate.bps<double>();
+    dataset.estimates.push_back(dataset_estimate);
+    // The estimate carries the RTT the receive side knew when sending it.
+    if (estimate.rtt_ms)
+      feature_provider.OnRttUpdate(*estimate.rtt_ms);
+  };
+  for (const LoggedRtpPacket* rtp : rtp_packets) {
+    // Estimates are only logged with millisecond precision, packets logged in
+    // the same millisecond are assumed to have come first.
+    while (next_estimate != estimates.end() &&
+           (*next_estimate)->log_time_ms() < rtp->log_time_ms()) {
+      add_estimate();
+    }
+    const RTPHeader& header = rtp->header;
+    ReceivedPacketInfo packet;
+    packet.payload_type = header.payloadType;
+    packet.sequence_number = header.sequenceNumber;
+    // Unwrapped the same way RemoteEstimatorProxy does for the estimator.
+    if (header.extension.hasAbsoluteSendTime) {
+      packet.send_time_us =
+          send_time_unwrapper.UnwrapUs(header.extension.absoluteSendTime);
+      packet.send_time_ms = AbsSendTimeUnwrapper::ToMs(*packet.send_time_us);
+    }
+    packet.ssrc = header.ssrc;
+    packet.padding_length = header.paddingLength;
+    packet.header_length = rtp->header_length;
+    packet.arrival_time_ms = rtp->log_time_ms();
+    // Call hands the estimator the payload size including the padding.
+    packet.payload_size = rtp->total_length - rtp->header_length;
+    feature_provider.OnPacket(header.extension.transportSequenceNumber,
+                              &packet);
+    dataset.packets.push_back(packet);
+  }
+  while (next_estimate != estimates.end())
+    add_estimate();
+  return dataset;
+}
+
+absl::optional<AlphaCcDataset> DatasetFromStatCollectRecording(
+    const std::string& file_name) {
+  FileWrapper file = FileWrapper::OpenReadOnly(file_name);
+  if (!file.is_open())
+    return absl::nullopt;
+  StatCollect::BinaryFileHeader header;
+  if (file.Read(&header, sizeof(header)) != sizeof(header) ||
+      header.magic != SC_BINARY_MAGIC ||
+      header.version != SC_BINARY_VERSION ||
+      header.recordSize != sizeof(StatCollect::BinaryPacketRecord)) {
+    return absl::nullopt;
+  }
+
+  AlphaCcDataset dataset;
+  StatCollect::BinaryPacketRecord record;
+  // A truncated last record is dropped, like parse.py does.
+  while (file.Read(&record, sizeof(record)) == sizeof(record)) {
+    // The recorder stores an estimate with the first packet received after
+    // it was sent.
+    if (record.pacerPacingRate != SC_PACER_PACING_RATE_EMPTY) {
+      DatasetEstimate estimate;
+      estimate.time_ms = record.arrivalTimeMs;
+      estimate.num_packets_before = dataset.packets.size();
+      estimate.target_rate_bps = record.pacerPacingRate;
+      dataset.estimates.push_back(estimate);
+    }
+    ReceivedPacketInfo packet;
+    packet.payload_type = record.payloadType;
+    packet.sequence_number = record.sequenceNumber;
+    packet.send_time_ms = record.sendTimestamp;
+    packet.ssrc = record.ssrc;
+    packet.padding_length = record.paddingLength;
+    packet.header_length = record.headerLength;
+    packet.arrival_time_ms = record.arrivalTimeMs;
+    packet.payload_size = record.payloadSize;
+    dataset.packets.push_back(packet);
+  }
+  return dataset;
+}
+
+bool WriteDataset(const AlphaCcDataset& dataset, const std::string& prefix) {
+  std::unique_ptr<ColumnarWriter> packets = ColumnarWriter::Create(
+      prefix + ".packets.acc", {{"arrival_time_ms", ColumnType::kInt64},
+                                {"send_time_ms", ColumnType::kUint32},
+                                {"ssrc", ColumnType::kUint32},
+                                {"padding_length", ColumnType::kUint32},
+                                {"header_length", ColumnType::kUint32},
+                                {"payload_size", ColumnType::kUint32},
+                                {"loss_count", ColumnType::kInt32},
+                                {"rtt_s", ColumnType::kFloat},
+                                {"sequence_number", ColumnType::kUint16},
+                                {"payload_type", ColumnType::kUint8},
+                                {"window", ColumnType::kInt64},
+                                {"send_time_us", ColumnType::kInt64}});
+  std::unique_ptr<ColumnarWriter> windows = ColumnarWriter::Create(
+      prefix + ".windows.acc", {{"first_packet", ColumnType::kInt64},
+                                {"packet_count", ColumnType::kUint32},
+                                {"end_time_ms", ColumnType::kInt64},
+                                {"target_rate_bps", ColumnType::kDouble}});
+  if (!packets || !windows)
+    return false;
+
+  size_t window = 0;
+  for (size_t i = 0; i < dataset.packets.size(); ++i) {
+    while (window < dataset.estimates.size() &&
+           dataset.estimates[window].num_packets_before <= i) {
+      ++window;
+    }
+    const ReceivedPacketInfo& packet = dataset.packets[i];
+    packets->Set(kArrivalTimeMs, packet.arrival_time_ms);
+    packets->Set(kSendTimeMs, packet.send_time_ms);
+    packets->Set(kSsrc, packet.ssrc);
+    packets->Set(kPaddingLength,
+                 rtc::saturated_cast<uint32_t>(packet.padding_length));
+    packets->Set(kHeaderLength,
+                 rtc::saturated_cast<uint32_t>(packet.header_length));
+    packets->Set(kPayloadSize,
+                 rtc::saturated_cast<uint32_t>(packet.payload_size));
+    packets->Set(kLossCount, packet.loss_count);
+    // Same conversion as OnnxBandwidthEstimator.
+    packets->Set(kRttSeconds,
+                 packet.rtt_ms < 0 ? -1.0f : packet.rtt_ms / 1000.0f);
+    packets->Set(kSequenceNumber, packet.sequence_number);
+    packets->Set(kPayloadType, packet.payload_type);
+    packets->Set(kWindow, window < dataset.estimates.size()
+                              ? static_cast<int64_t>(window)
+                              : int64_t{-1});
+    // Recordings only have the send times in milliseconds.
+    packets->Set(kSendTimeUs, packet.send_time_us.value_or(
+                                  int64_t{packet.send_time_ms} * 1000));
+    packets->EndRow();
+  }
+
+  size_t first_packet = 0;
+  for (const DatasetEstimate& estimate : dataset.estimates) {
+    windows->Set(kFirstPacket, static_cast<int64_t>(first_packet));
+    windows->Set(kPacketCount, rtc::checked_cast<uint32_t>(
+                                   estimate.num_packets_before - first_packet));
+    windows->Set(kEndTimeMs, estimate.time_ms);
+    windows->Set(kTargetRateBps, estimate.target_rate_bps);
+    windows->EndRow();
+    first_packet = estimate.num_packets_before;
+  }
+
+  const bool packets_written = packets->Close();
+  const bool windows_written = windows->Close();
+  return packets_written && windows_written;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_ALPHACC_DATASET_DATASET_EXPORT_H_
+#define RTC_TOOLS_ALPHACC_DATASET_DATASET_EXPORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+
+namespace webrtc {
+
+// An estimate sent by the receive side, which closes a window of packets.
+struct DatasetEstimate {
+  int64_t time_ms = 0;
+  // The number of packets received before the estimate was sent.
+  size_t num_packets_before = 0;
+  double target_rate_bps = 0;
+};
+
+// What the receive-side bandwidth estimator of a call was fed, and what it
+// sent back, both in the order they happened.
+struct AlphaCcDataset {
+  std::vector<ReceivedPacketInfo> packets;
+  std::vector<DatasetEstimate> estimates;
+};
+
+// Builds the dataset from the incoming RTP packets and the sent AlphaCC
+// estimates of a receive-side event log. The send time and loss count are
+// derived like in RemoteEstimatorProxy, the RTT is taken from the latest sent
+// estimate.
+AlphaCcDataset DatasetFromEventLog(const ParsedRtcEventLog& log);
+
+// Builds the dataset from a BinaryStatsRecorder recording. Recordings don't
+// have the loss count nor the RTT, which are left unknown. Returns nullopt if
+// |file_name| can't be read or isn't a recording.
+absl::optional<AlphaCcDataset> DatasetFromStatCollectRecording(
+    const std::string& file_name);
+
+// Writes |dataset| as two columnar tables, see ColumnarWriter:
+//   |prefix|.packets.acc: one row per packet, with the columns of
+//       onnxinfer::PacketFeature in the same order and units, and the index of
+//       the packet's window.
+//   |prefix|.windows.acc: one row per estimate, with the range of packets
+//       received since the previous estimate and the estimated target rate.
+// A window holds the packets fed to the model before it produced the
+// estimate, so that training doesn't need to regroup packets. Packets after
+// the last estimate have window -1. Returns false on write errors.
+bool WriteDataset(const AlphaCcDataset& dataset, const std::string& prefix);
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_ALPHACC_DATASET_DATASET_EXPORT_H_
@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/alphacc_dataset/dataset_export.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "modules/third_party/statcollect/StatRecorder.h"
+#include "rtc_tools/alphacc_dataset/columnar_writer.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+StatCollect::BinaryPacketRecord Record(int64_t arrival_time_ms,
+                                       uint16_t sequence_number,
+                                       double estimate_bps) {
+  StatCollect::BinaryPacketRecord record;
+  record.pacerPacingRate = estimate_bps;
+  record.pacerPaddingRate = estimate_bps;
+  record.arrivalTimeMs = arrival_time_ms;
+  record.sendTimestamp = arrival_time_ms - 10;
+  record.ssrc = 1234;
+  record.paddingLength = 0;
+  record.headerLength = 24;
+  record.payloadSize = 1000;
+  record.lossRate = 0;
+  record.sequenceNumber = sequence_number;
+  record.payloadType = 96;
+  return record;
+}
+
+// Reads |column| of a table written by ColumnarWriter in a single chunk.
+template <typename T>
+std::vector<T> ReadColumn(const std::string& file_name, size_t column) {
+  std::ifstream file(file_name, std::ios_base::binary);
+  const std::string data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+  uint32_t num_columns;
+  memcpy(&num_columns, data.data() + 8, sizeof(num_columns));
+  size_t offset = 12;
+  std::vector<size_t> value_sizes;
+  for (uint32_t i = 0; i < num_columns; ++i) {
+    const ColumnType type = static_cast<ColumnType>(data[offset]);
+    uint16_t name_length;
+    memcpy(&name_length, data.data() + offset + 1, sizeof(name_length));
+    offset += 3 + name_length;
+    value_sizes.push_back(type == ColumnType::kUint8    ? 1
+                          : type == ColumnType::kUint16 ? 2
+                          : type == ColumnType::kInt64 ||
+                                  type == ColumnType::kDouble
+                              ? 8
+                              : 4);
+  }
+  uint32_t rows;
+  memcpy(&rows, data.data() + offset, sizeof(rows));
+  offset += sizeof(rows);
+  for (size_t i = 0; i < column; ++i)
+    offset += rows * value_sizes[i];
+  std::vector<T> values(rows);
+  memcpy(values.data(), data.data() + offset, rows * sizeof(T));
+  return values;
+}
+
+class DatasetExportTest : public ::testing::Test {
+ protected:
+  DatasetExportTest()
+      : path_(test::TempFilename(test::OutputPath(), "dataset_export")) {}
+  ~DatasetExportTest() override {
+    test::RemoveFile(path_);
+    test::RemoveFile(path_ + ".packets.acc");
+    test::RemoveFile(path_ + ".windows.acc");
+  }
+
+  void WriteRecording(
+      const std::vector<StatCollect::BinaryPacketRecord>& records) {
+    FILE* file = fopen(path_.c_str(), "wb");
+    ASSERT_TRUE(file);
+    StatCollect::BinaryFileHeader header = {
+        SC_BINARY_MAGIC, SC_BINARY_VERSION,
+        sizeof(StatCollect::BinaryPacketRecord)};
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(records.data(), sizeof(records[0]), records.size(), file);
+    fclose(file);
+  }
+
+  const std::string path_;
+};
+
+TEST_F(DatasetExportTest, ReadsStatCollectRecording) {
+  WriteRecording({Record(1000, 1, SC_PACER_PACING_RATE_EMPTY),
+                  Record(1010, 2, 300000),
+                  Record(1020, 3, SC_PACER_PACING_RATE_EMPTY)});
+  absl::optional<AlphaCcDataset> dataset =
+      DatasetFromStatCollectRecording(path_);
+  ASSERT_TRUE(dataset);
+  ASSERT_EQ(dataset->packets.size(), 3u);
+  EXPECT_EQ(dataset->packets[1].arrival_time_ms, 1010);
+  EXPECT_EQ(dataset->packets[1].send_time_ms, 1000u);
+  EXPECT_EQ(dataset->packets[1].sequence_number, 2);
+  EXPECT_EQ(dataset->packets[1].payload_size, 1000u);
+  EXPECT_EQ(dataset->packets[1].loss_count, -1);
+  EXPECT_EQ(dataset->packets[1].rtt_ms, -1);
+  // The estimate was sent before the packet it was recorded with.
+  ASSERT_EQ(dataset->estimates.size(), 1u);
+  EXPECT_EQ(dataset->estimates[0].time_ms, 1010);
+  EXPECT_EQ(dataset->estimates[0].num_packets_before, 1u);
+  EXPECT_EQ(dataset->estimates[0].target_rate_bps, 300000);
+}
+
+TEST_F(DatasetExportTest, RejectsOtherFiles) {
+  FILE* file = fopen(path_.c_str(), "wb");
+  ASSERT_TRUE(file);
+  fputs("{\"mediaInfo\":{}}\n", file);
+  fclose(file);
+  EXPECT_FALSE(DatasetFromStatCollectRecording(path_));
+  EXPECT_FALSE(DatasetFromStatCollectRecording(""));
+}
+
+TEST_F(DatasetExportTest, WritesPacketsGroupedByWindow) {
+  AlphaCcDataset dataset;
+  for (int i = 0; i < 5; ++i) {
+    ReceivedPacketInfo packet;
+    packet.arrival_time_ms = 1000 + 10 * i;
+    packet.payload_size = 100 + i;
+    packet.rtt_ms = 50;
+    dataset.packets.push_back(packet);
+  }
+  dataset.estimates.push_back({1015, 2, 300000});
+  dataset.estimates.push_back({1025, 3, 400000});
+  ASSERT_TRUE(WriteDataset(dataset, path_));
+
+  const std::string packets = path_ + ".packets.acc";
+  EXPECT_EQ(ReadColumn<int64_t>(packets, 0),
+            (std::vector<int64_t>{1000, 1010, 1020, 1030, 1040}));
+  EXPECT_EQ(ReadColumn<uint32_t>(packets, 5),
+            (std::vector<uint32_t>{100, 101, 102, 103, 104}));
+  EXPECT_EQ(ReadColumn<float>(packets, 7),
+            (std::vector<float>{0.05f, 0.05f, 0.05f, 0.05f, 0.05f}));
+  EXPECT_EQ(ReadColumn<int64_t>(packets, 10),
+            (std::vector<int64_t>{0, 0, 1, -1, -1}));
+
+  const std::string windows = path_ + ".windows.acc";
+  EXPECT_EQ(ReadColumn<int64_t>(windows, 0), (std::vector<int64_t>{0, 2}));
+  EXPECT_EQ(ReadColumn<uint32_t>(windows, 1), (std::vector<uint32_t>{2, 1}));
+  EXPECT_EQ(ReadColumn<int64_t>(windows, 2),
+            (std::vector<int64_t>{1015, 1025}));
+  EXPECT_EQ(ReadColumn<double>(windows, 3),
+            (std::vector<double>{300000, 400000}));
+}
+
+TEST_F(DatasetExportTest, WritesMicrosecondSendTimes) {
+  AlphaCcDataset dataset;
+  ReceivedPacketInfo packet;
+  packet.send_time_ms = 1000;
+  packet.send_time_us = 999750;
+  dataset.packets.push_back(packet);
+  // Recorded with millisecond send times only.
+  packet.send_time_ms = 1010;
+  packet.send_time_us = absl::nullopt;
+  dataset.packets.push_back(packet);
+  ASSERT_TRUE(WriteDataset(dataset, path_));
+
+  const std::string packets = path_ + ".packets.acc";
+  EXPECT_EQ(ReadColumn<uint32_t>(packets, 1),
+            (std::vector<uint32_t>{1000, 1010}));
+  EXPECT_EQ(ReadColumn<int64_t>(packets, 11),
+            (std::vector<int64_t>{999750, 1010000}));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/types/optional.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "rtc_base/logging.h"
+#include "rtc_tools/alphacc_dataset/dataset_export.h"
+
+ABSL_FLAG(std::string,
+          event_log,
+          "",
+          "A receive-side RtcEventLog to read the packets and the sent AlphaCC "
+          "estimates from.");
+ABSL_FLAG(std::string,
+          stat_collect,
+          "",
+          "A StatCollect binary recording to read the packets and the sent "
+          "estimates from, instead of an event log.");
+ABSL_FLAG(std::string,
+          output,
+          "",
+          "Prefix of the output files, <output>.packets.acc and "
+          "<output>.windows.acc.");
+ABSL_FLAG(int,
+          parse_threads,
+          1,
+          "Number of threads used to decode the event log.");
+
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Converts the input of the receive-side AlphaCC estimator into columnar "
+      "tables for training.\n"
+      "Example usage:\n"
+      "./alphacc_dataset_export --event_log=<logfile> --output=<prefix>\n");
+  absl::ParseCommandLine(argc, argv);
+
+  // Print RTC_LOG warnings and errors even in release builds.
+  if (rtc::LogMessage::GetLogToDebug() > rtc::LS_WARNING) {
+    rtc::LogMessage::LogToDebug(rtc::LS_WARNING);
+  }
+  rtc::LogMessage::SetLogToStderr(true);
+
+  const std::string event_log = absl::GetFlag(FLAGS_event_log);
+  const std::string stat_collect = absl::GetFlag(FLAGS_stat_collect);
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (event_log.empty() == stat_collect.empty() || output.empty()) {
+    std::cerr << "Exactly one of --event_log and --stat_collect, and --output "
+                 "must be given."
+              << std::endl;
+    return -1;
+  }
+
+  absl::optional<webrtc::AlphaCcDataset> dataset;
+  if (!event_log.empty()) {
+    webrtc::ParsedRtcEventLog parsed_log(
+        webrtc::ParsedRtcEventLog::UnconfiguredHeaderExtensions::
+            kAttemptWebrtcDefaultConfig,
+        /*allow_incomplete_logs*/ true,
+        std::max(1, absl::GetFlag(FLAGS_parse_threads)));
+    auto status = parsed_log.ParseFile(event_log);
+    if (!status.ok()) {
+      std::cerr << "Failed to parse " << event_log << ": " << status.message()
+                << std::endl;
+      return -1;
+    }
+    dataset = webrtc::DatasetFromEventLog(parsed_log);
+  } else {
+    dataset = webrtc::DatasetFromStatCollectRecording(stat_collect);
+    if (!dataset) {
+      std::cerr << "Failed to read " << stat_collect
+                << ", it isn't a StatCollect binary recording." << std::endl;
+      return -1;
+    }
+  }
+
+  if (!webrtc::WriteDataset(*dataset, output)) {
+    std::cerr << "Failed to write " << output << std::endl;
+    return -1;
+  }
+  std::cout << dataset->packets.size() << " packets in "
+            << dataset->estimates.size() << " windows written to " << output
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,64 @@
+#  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+#
+#  Use of this source code is governed by a BSD-style license
+#  that can be found in the LICENSE file in the root of the source
+#  tree. An additional intellectual property rights grant can be found
+#  in the file PATENTS.  All contributing project authors may
+#  be found in the AUTHORS file in the root of the source tree.
+"""Reads the tables written by alphacc_dataset_export into numpy arrays.
+
+Example:
+  packets = read_table("call.packets.acc")
+  windows = read_table("call.windows.acc")
+  sizes = packets["payload_size"][packets["window"] == 3]
+"""
+
+import struct
+import sys
+
+import numpy as np
+
+# Must match ColumnarWriter in columnar_writer.h.
+MAGIC = 0x31434341
+VERSION = 1
+DTYPES = ["<u1", "<u2", "<u4", "<i4", "<i8", "<f4", "<f8"]
+
+
+def read_table(file_name):
+  """Returns a dict from column name to a numpy array with all its rows."""
+  with open(file_name, "rb") as f:
+    data = f.read()
+  magic, version, num_columns = struct.unpack_from("<III", data, 0)
+  if magic != MAGIC or version != VERSION:
+    raise ValueError("%s is not a columnar dataset table" % file_name)
+  offset = 12
+  columns = []
+  for _ in range(num_columns):
+    column_type, name_length = struct.unpack_from("<BH", data, offset)
+    offset += 3
+    name = data[offset:offset + name_length].decode("utf-8")
+    offset += name_length
+    columns.append((name, np.dtype(DTYPES[column_type])))
+
+  chunks = dict((name, []) for name, _ in columns)
+  while offset < len(data):
+    (rows,) = struct.unpack_from("<I", data, offset)
+    offset += 4
+    for name, dtype in columns:
+      chunks[name].append(
+          np.frombuffer(data, dtype=dtype, count=rows, offset=offset))
+      offset += rows * dtype.itemsize
+  return dict((name, np.concatenate(chunks[name]) if chunks[name] else
+               np.zeros(0, dtype=dtype)) for name, dtype in columns)
+
+
+def main(argv):
+  for file_name in argv[1:]:
+    table = read_table(file_name)
+    print(file_name)
+    for name, values in table.items():
+      print("  %s: %d rows of %s" % (name, len(values), values.dtype))
+
+
+if __name__ == "__main__":
+  main(sys.argv)
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/alphacc_dataset/replay.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "api/array_view.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+std::vector<DatasetEstimate> ReplaySchedule(const AlphaCcDataset& dataset,
+                                            int64_t interval_ms) {
+  if (interval_ms <= 0)
+    return dataset.estimates;
+
+  std::vector<DatasetEstimate> schedule;
+  if (dataset.packets.empty())
+    return schedule;
+  size_t num_packets = 0;
+  int64_t time_ms = dataset.packets.front().arrival_time_ms;
+  while (num_packets < dataset.packets.size()) {
+    time_ms += interval_ms;
+    while (num_packets < dataset.packets.size() &&
+           dataset.packets[num_packets].arrival_time_ms <= time_ms) {
+      ++num_packets;
+    }
+    DatasetEstimate estimate;
+    estimate.time_ms = time_ms;
+    estimate.num_packets_before = num_packets;
+    schedule.push_back(estimate);
+  }
+  return schedule;
+}
+
+ReplayResult ReplayDataset(const AlphaCcDataset& dataset,
+                           const std::vector<DatasetEstimate>& schedule,
+                           ReceiveSideBandwidthEstimator* estimator) {
+  RTC_DCHECK(estimator);
+  const rtc::ArrayView<const ReceivedPacketInfo> packets(dataset.packets);
+  ReplayResult result;
+  result.estimates.reserve(schedule.size());
+  for (const DatasetEstimate& due : schedule) {
+    const size_t end = std::min(due.num_packets_before, packets.size());
+    const int64_t start_us = rtc::TimeMicros();
+    if (end > result.num_packets) {
+      estimator->OnPacketBatch(
+          packets.subview(result.num_packets, end - result.num_packets));
+      result.num_packets = end;
+    }
+    ReplayEstimate estimate;
+    estimate.time_ms = due.time_ms;
+    estimate.num_packets_before = result.num_packets;
+    if (estimator->IsReady())
+      estimate.target_rate_bps = estimator->GetEstimate();
+    result.inference_time_us += rtc::TimeMicros() - start_us;
+    result.estimates.push_back(estimate);
+  }
+  return result;
+}
+
+absl::optional<double> MeanAbsoluteDifferenceBps(
+    const ReplayResult& result,
+    const std::vector<DatasetEstimate>& schedule) {
+  RTC_DCHECK_EQ(result.estimates.size(), schedule.size());
+  double total_difference_bps = 0;
+  size_t count = 0;
+  for (size_t i = 0; i < result.estimates.size(); ++i) {
+    if (!result.estimates[i].target_rate_bps)
+      continue;
+    total_difference_bps += std::fabs(*result.estimates[i].target_rate_bps -
+                                      schedule[i].target_rate_bps);
+    ++count;
+  }
+  if (count == 0)
+    return absl::nullopt;
+  return total_difference_bps / count;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_ALPHACC_DATASET_REPLAY_H_
+#define RTC_TOOLS_ALPHACC_DATASET_REPLAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+#include "rtc_tools/alphacc_dataset/dataset_export.h"
+
+namespace webrtc {
+
+// An estimate asked for during a replay.
+struct ReplayEstimate {
+  int64_t time_ms = 0;
+  // The number of packets fed to the estimator before.
+  size_t num_packets_before = 0;
+  // Unset while the estimator wasn't ready.
+  absl::optional<double> target_rate_bps;
+};
+
+struct ReplayResult {
+  std::vector<ReplayEstimate> estimates;
+  size_t num_packets = 0;
+  // Wall clock time spent in the estimator.
+  int64_t inference_time_us = 0;
+};
+
+// Returns when the estimator is asked for estimates: at the estimates of
+// |dataset|, or every |interval_ms| of arrival time after the first packet if
+// |interval_ms| is positive.
+std::vector<DatasetEstimate> ReplaySchedule(const AlphaCcDataset& dataset,
+                                            int64_t interval_ms);
+
+// Feeds the packets of |dataset| to |estimator| as fast as possible, in the
+// batches ReceiveSideEstimatorWorker would feed between two estimates of
+// |schedule|, and asks for an estimate at each of them. The packets after the
+// last estimate are not fed.
+ReplayResult ReplayDataset(const AlphaCcDataset& dataset,
+                           const std::vector<DatasetEstimate>& schedule,
+                           ReceiveSideBandwidthEstimator* estimator);
+
+// Returns the mean absolute difference between the estimates of |result| and
+// those of |schedule| it replayed, over the estimates the estimator was ready
+// for, or nullopt if there are none.
+absl::optional<double> MeanAbsoluteDifferenceBps(
+    const ReplayResult& result,
+    const std::vector<DatasetEstimate>& schedule);
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_ALPHACC_DATASET_REPLAY_H_
@@ -0,0 +1,243 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/types/optional.h"
+#include "api/alphacc_config.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "modules/remote_bitrate_estimator/receive_side_bandwidth_estimator.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/string_encode.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_tools/alphacc_dataset/dataset_export.h"
+#include "rtc_tools/alphacc_dataset/replay.h"
+
+ABSL_FLAG(std::string,
+          event_log,
+          "",
+          "A receive-side RtcEventLog to read the packets and the sent AlphaCC "
+          "estimates from.");
+ABSL_FLAG(std::string,
+          stat_collect,
+          "",
+          "A StatCollect binary recording to read the packets and the sent "
+          "estimates from, instead of an event log.");
+ABSL_FLAG(std::string,
+          estimators,
+          "",
+          "Comma separated estimators to replay, each one of "
+          "onnx=<model path>, bwe_model=<model path> and receive_rate.");
+ABSL_FLAG(int,
+          interval_ms,
+          0,
+          "Ask for an estimate every this many milliseconds of arrival time "
+          "instead of when the logged estimates were sent.");
+ABSL_FLAG(std::string,
+          output,
+          "",
+          "If not empty, a CSV file to write the estimates to, one row per "
+          "estimate and one column per estimator.");
+ABSL_FLAG(int,
+          parse_threads,
+          1,
+          "Number of threads used to decode the event log.");
+
+namespace webrtc {
+namespace {
+
+struct Candidate {
+  std::string name;
+  AlphaCCConfig config;
+};
+
+// Parses --estimators, returns an empty list if it is invalid.
+std::vector<Candidate> ParseCandidates(const std::string& estimators) {
+  std::vector<std::string> fields;
+  rtc::split(estimators, ',', &fields);
+  std::vector<Candidate> candidates;
+  for (const std::string& field : fields) {
+    Candidate candidate;
+    candidate.name = field;
+    const size_t separator = field.find('=');
+    const std::string kind = field.substr(0, separator);
+    const std::string model_path =
+        separator == std::string::npos ? "" : field.substr(separator + 1);
+    if (kind == "onnx" && !model_path.empty()) {
+      candidate.config.bwe_estimator_option =
+          AlphaCCConfig::BweEstimatorOption::kOnnx;
+      candidate.config.onnx_model_path = model_path;
+    } else if (kind == "bwe_model" && !model_path.empty()) {
+      candidate.config.bwe_estimator_option =
+          AlphaCCConfig::BweEstimatorOption::kBweModel;
+      candidate.config.bwe_model_path = model_path;
+    } else if (kind == "receive_rate" && model_path.empty()) {
+      candidate.config.bwe_estimator_option =
+          AlphaCCConfig::BweEstimatorOption::kReceiveRate;
+    } else {
+      std::cerr << "Invalid estimator " << field << std::endl;
+      return {};
+    }
+    candidates.push_back(candidate);
+  }
+  return candidates;
+}
+
+bool WriteCsv(const std::string& file_name,
+              const std::vector<DatasetEstimate>& schedule,
+              bool has_logged_estimates,
+              const std::vector<Candidate>& candidates,
+              const std::vector<ReplayResult>& results) {
+  FILE* file = fopen(file_name.c_str(), "w");
+  if (!file)
+    return false;
+  fprintf(file, "time_ms,num_packets");
+  if (has_logged_estimates)
+    fprintf(file, ",logged");
+  for (const Candidate& candidate : candidates)
+    fprintf(file, ",%s", candidate.name.c_str());
+  fprintf(file, "\n");
+  for (size_t i = 0; i < schedule.size(); ++i) {
+    fprintf(file, "%lld,%zu", static_cast<long long>(schedule[i].time_ms),
+            schedule[i].num_packets_before);
+    if (has_logged_estimates)
+      fprintf(file, ",%.0f", schedule[i].target_rate_bps);
+    for (const ReplayResult& result : results) {
+      const absl::optional<double>& estimate =
+          result.estimates[i].target_rate_bps;
+      if (estimate) {
+        fprintf(file, ",%.0f", *estimate);
+      } else {
+        fprintf(file, ",");
+      }
+    }
+    fprintf(file, "\n");
+  }
+  return fclose(file) == 0;
+}
+
+int Run() {
+  const std::string event_log = absl::GetFlag(FLAGS_event_log);
+  const std::string stat_collect = absl::GetFlag(FLAGS_stat_collect);
+  if (event_log.empty() == stat_collect.empty()) {
+    std::cerr << "Exactly one of --event_log and --stat_collect must be given."
+              << std::endl;
+    return -1;
+  }
+  const std::vector<Candidate> candidates =
+      ParseCandidates(absl::GetFlag(FLAGS_estimators));
+  if (candidates.empty()) {
+    std::cerr << "--estimators must list at least one valid estimator."
+              << std::endl;
+    return -1;
+  }
+
+  absl::optional<AlphaCcDataset> dataset;
+  if (!event_log.empty()) {
+    ParsedRtcEventLog parsed_log(
+        ParsedRtcEventLog::UnconfiguredHeaderExtensions::
+            kAttemptWebrtcDefaultConfig,
+        /*allow_incomplete_logs*/ true,
+        std::max(1, absl::GetFlag(FLAGS_parse_threads)));
+    auto status = parsed_log.ParseFile(event_log);
+    if (!status.ok()) {
+      std::cerr << "Failed to parse " << event_log << ": " << status.message()
+                << std::endl;
+      return -1;
+    }
+    dataset = DatasetFromEventLog(parsed_log);
+  } else {
+    dataset = DatasetFromStatCollectRecording(stat_collect);
+    if (!dataset) {
+      std::cerr << "Failed to read " << stat_collect
+                << ", it isn't a StatCollect binary recording." << std::endl;
+      return -1;
+    }
+  }
+
+  const int interval_ms = absl::GetFlag(FLAGS_interval_ms);
+  const bool has_logged_estimates = interval_ms <= 0;
+  const std::vector<DatasetEstimate> schedule =
+      ReplaySchedule(*dataset, interval_ms);
+  std::cout << dataset->packets.size() << " packets, " << schedule.size()
+            << " estimates" << std::endl;
+
+  std::vector<ReplayResult> results;
+  for (const Candidate& candidate : candidates) {
+    const int64_t load_start_us = rtc::TimeMicros();
+    std::unique_ptr<ReceiveSideBandwidthEstimator> estimator =
+        CreateReceiveSideBandwidthEstimator(candidate.config);
+    const int64_t load_time_us = rtc::TimeMicros() - load_start_us;
+    results.push_back(ReplayDataset(*dataset, schedule, estimator.get()));
+    const ReplayResult& result = results.back();
+
+    const double inference_time_s =
+        std::max<int64_t>(result.inference_time_us, 1) /
+        static_cast<double>(rtc::kNumMicrosecsPerSec);
+    const size_t ready_estimates = std::count_if(
+        result.estimates.begin(), result.estimates.end(),
+        [](const ReplayEstimate& estimate) {
+          return estimate.target_rate_bps.has_value();
+        });
+    std::cout << candidate.name << ": loaded in "
+              << load_time_us / rtc::kNumMicrosecsPerMillisec << " ms, "
+              << ready_estimates << " estimates ready, "
+              << static_cast<int64_t>(result.num_packets / inference_time_s)
+              << " packets/s, "
+              << static_cast<int64_t>(schedule.size() / inference_time_s)
+              << " estimates/s";
+    if (has_logged_estimates) {
+      if (absl::optional<double> difference_bps =
+              MeanAbsoluteDifferenceBps(result, schedule)) {
+        std::cout << ", " << static_cast<int64_t>(*difference_bps)
+                  << " bps mean absolute difference to the logged estimates";
+      }
+    }
+    std::cout << std::endl;
+  }
+
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (!output.empty() && !WriteCsv(output, schedule, has_logged_estimates,
+                                   candidates, results)) {
+    std::cerr << "Failed to write " << output << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Replays the packets of a receive-side log through AlphaCC receive side "
+      "estimators, as fast as possible, to compare their estimates and "
+      "throughput.\n"
+      "Example usage:\n"
+      "./alphacc_replay --event_log=<logfile> "
+      "--estimators=onnx=a.onnx,onnx=b.onnx,receive_rate --output=out.csv\n");
+  absl::ParseCommandLine(argc, argv);
+
+  // Print RTC_LOG warnings and errors even in release builds.
+  if (rtc::LogMessage::GetLogToDebug() > rtc::LS_WARNING) {
+    rtc::LogMessage::LogToDebug(rtc::LS_WARNING);
+  }
+  rtc::LogMessage::SetLogToStderr(true);
+  return webrtc::Run();
+}
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/alphacc_dataset/replay.h"
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Estimates the number of packets it was fed, once it got |min_packets|.
+class CountingEstimator : public ReceiveSideBandwidthEstimator {
+ public:
+  explicit CountingEstimator(size_t min_packets) : min_packets_(min_packets) {}
+
+  void OnPacket(const ReceivedPacketInfo& packet) override { ++num_packets_; }
+  void OnPacketBatch(
+      rtc::ArrayView<const ReceivedPacketInfo> packets) override {
+    num_packets_ += packets.size();
+    ++num_batches_;
+  }
+  float GetEstimate() override { return num_packets_; }
+  bool IsReady() const override { return num_packets_ >= min_packets_; }
+
+  size_t num_batches() const { return num_batches_; }
+
+ private:
+  const size_t min_packets_;
+  size_t num_packets_ = 0;
+  size_t num_batches_ = 0;
+};
+
+AlphaCcDataset CreateDataset(const std::vector<int64_t>& arrival_times_ms) {
+  AlphaCcDataset dataset;
+  for (int64_t arrival_time_ms : arrival_times_ms) {
+    ReceivedPacketInfo packet;
+    packet.arrival_time_ms = arrival_time_ms;
+    dataset.packets.push_back(packet);
+  }
+  return dataset;
+}
+
+DatasetEstimate Estimate(int64_t time_ms,
+                         size_t num_packets_before,
+                         double target_rate_bps) {
+  DatasetEstimate estimate;
+  estimate.time_ms = time_ms;
+  estimate.num_packets_before = num_packets_before;
+  estimate.target_rate_bps = target_rate_bps;
+  return estimate;
+}
+
+TEST(AlphaCcReplayTest, SchedulesAtLoggedEstimates) {
+  AlphaCcDataset dataset = CreateDataset({0, 10, 20});
+  dataset.estimates.push_back(Estimate(15, 2, 1000));
+  const std::vector<DatasetEstimate> schedule =
+      ReplaySchedule(dataset, /*interval_ms=*/0);
+  ASSERT_EQ(schedule.size(), 1u);
+  EXPECT_EQ(schedule[0].time_ms, 15);
+  EXPECT_EQ(schedule[0].num_packets_before, 2u);
+}
+
+TEST(AlphaCcReplayTest, SchedulesEveryIntervalUntilTheLastPacket) {
+  const AlphaCcDataset dataset = CreateDataset({100, 110, 150, 320});
+  const std::vector<DatasetEstimate> schedule =
+      ReplaySchedule(dataset, /*interval_ms=*/100);
+  ASSERT_EQ(schedule.size(), 3u);
+  EXPECT_EQ(schedule[0].time_ms, 200);
+  EXPECT_EQ(schedule[0].num_packets_before, 3u);
+  EXPECT_EQ(schedule[1].time_ms, 300);
+  EXPECT_EQ(schedule[1].num_packets_before, 3u);
+  EXPECT_EQ(schedule[2].time_ms, 400);
+  EXPECT_EQ(schedule[2].num_packets_before, 4u);
+}
+
+TEST(AlphaCcReplayTest, FeedsPacketsInBatchesBetweenEstimates) {
+  AlphaCcDataset dataset = CreateDataset({0, 10, 20, 30, 40});
+  const std::vector<DatasetEstimate> schedule = {
+      Estimate(5, 1, 1), Estimate(15, 2, 2), Estimate(16, 2, 2),
+      Estimate(35, 4, 10)};
+  CountingEstimator estimator(/*min_packets=*/2);
+  const ReplayResult result = ReplayDataset(dataset, schedule, &estimator);
+
+  // The last packet comes after the last estimate.
+  EXPECT_EQ(result.num_packets, 4u);
+  EXPECT_EQ(estimator.num_batches(), 3u);
+  ASSERT_EQ(result.estimates.size(), 4u);
+  EXPECT_FALSE(result.estimates[0].target_rate_bps);
+  EXPECT_EQ(result.estimates[1].target_rate_bps, 2);
+  EXPECT_EQ(result.estimates[2].target_rate_bps, 2);
+  EXPECT_EQ(result.estimates[3].target_rate_bps, 4);
+  EXPECT_EQ(result.estimates[3].num_packets_before, 4u);
+
+  // Only over the estimates the estimator was ready for.
+  EXPECT_EQ(MeanAbsoluteDifferenceBps(result, schedule), 2);
+}
+
+TEST(AlphaCcReplayTest, NoDifferenceWithoutReadyEstimates) {
+  AlphaCcDataset dataset = CreateDataset({0, 10});
+  const std::vector<DatasetEstimate> schedule = {Estimate(15, 2, 1000)};
+  CountingEstimator estimator(/*min_packets=*/10);
+  const ReplayResult result = ReplayDataset(dataset, schedule, &estimator);
+  EXPECT_FALSE(MeanAbsoluteDifferenceBps(result, schedule));
+}
+
+}  // namespace
+}  // namespace webrtc
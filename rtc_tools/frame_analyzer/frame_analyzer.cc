@@ -26,6 +26,7 @@
 #include "rtc_tools/frame_analyzer/video_temporal_aligner.h"
 #include "rtc_tools/video_file_reader.h"
 #include "rtc_tools/video_file_writer.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "test/testsupport/perf_test.h"
 
 ABSL_FLAG(int32_t, width, -1, "The width of the reference and test files");
@@ -52,6 +53,16 @@ ABSL_FLAG(std::string,
           "",
           "Where to write aligned YUV ref+test output files, if not present, "
           "no files will be written");
+ABSL_FLAG(int32_t,
+          num_threads,
+          0,
+          "The number of threads scoring the frames, 0 for one per core");
+ABSL_FLAG(int32_t,
+          alignment_search_window,
+          0,
+          "The number of reference frames the first test frame is matched "
+          "against, e.g. the longest expected delay in frames with some "
+          "margin. 0 matches it against the whole reference video");
 ABSL_FLAG(std::string,
           chartjson_result_file,
           "",
@@ -86,6 +97,7 @@ std::string JoinFilename(std::string directory, std::string filename) {
  * Usage:
  * frame_analyzer --label=<test_label> --reference_file=<name_of_file>
  * --test_file_ref=<name_of_file> --width=<frame_width> --height=<frame_height>
+ * [--num_threads=<threads>] [--alignment_search_window=<frames>]
  */
 int main(int argc, char* argv[]) {
   absl::ParseCommandLine(argc, argv);
@@ -117,8 +129,14 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  const int alignment_search_window =
+      absl::GetFlag(FLAGS_alignment_search_window);
   const std::vector<size_t> matching_indices =
-      webrtc::test::FindMatchingFrameIndices(reference_video, test_video);
+      alignment_search_window > 0
+          ? webrtc::test::FindMatchingFrameIndices(reference_video, test_video,
+                                                   alignment_search_window)
+          : webrtc::test::FindMatchingFrameIndices(reference_video,
+                                                   test_video);
 
   // Align the reference video both temporally and geometrically. I.e. align the
   // frames to match up in order to the test video, and align a crop region of
@@ -147,8 +165,11 @@ int main(int argc, char* argv[]) {
   const rtc::scoped_refptr<webrtc::test::Video> color_adjusted_test_video =
       AdjustColors(color_transformation, test_video);
 
+  const int num_threads = absl::GetFlag(FLAGS_num_threads);
   results.frames = webrtc::test::RunAnalysis(
-      aligned_reference_video, color_adjusted_test_video, matching_indices);
+      aligned_reference_video, color_adjusted_test_video, matching_indices,
+      num_threads > 0 ? num_threads
+                      : webrtc::CpuInfo::DetectNumberOfCores());
 
   const std::vector<webrtc::test::Cluster> clusters =
       webrtc::test::CalculateFrameClusters(matching_indices);
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/frame_analyzer/frame_ssim.h"
+
+#include <float.h>
+
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "rtc_tools/frame_analyzer/frame_ssim_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kAVX2, WebRtc_G...
+#endif
+
+namespace webrtc {
+namespace test {
+namespace {
+
+using internal::SsimColumnSums;
+using SumColumnsFunction = void (*)(const uint8_t*,
+                                    int,
+                                    const uint8_t*,
+                                    int,
+                                    int,
+                                    SsimColumnSums*);
+
+SumColumnsFunction SelectSumColumnsFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return &internal::SumSsimColumns_AVX2;
+  }
+#endif
+  return &internal::SumSsimColumns_C;
+}
+
+// The window, its stride and the constants of libyuv.
+constexpr int kWindowSize = 8;
+constexpr int kWindowStride = 4;
+constexpr int64_t kCount = kWindowSize * kWindowSize;
+// (64^2 * (0.01 * 255)^2) and (64^2 * (0.03 * 255)^2), scaled by the number of
+// pixels of the window.
+constexpr int64_t kC1 = (26634 * kCount * kCount) >> 12;
+constexpr int64_t kC2 = (239708 * kCount * kCount) >> 12;
+
+double WindowSsim(const SsimColumnSums& left, const SsimColumnSums& right) {
+  const int64_t sum_a = int64_t{left.sum_a} + right.sum_a;
+  const int64_t sum_b = int64_t{left.sum_b} + right.sum_b;
+  const int64_t sum_sq_a = int64_t{left.sum_sq_a} + right.sum_sq_a;
+  const int64_t sum_sq_b = int64_t{left.sum_sq_b} + right.sum_sq_b;
+  const int64_t sum_axb = int64_t{left.sum_axb} + right.sum_axb;
+
+  const int64_t sum_a_x_sum_b = sum_a * sum_b;
+  const int64_t ssim_n = (2 * sum_a_x_sum_b + kC1) *
+                         (2 * kCount * sum_axb - 2 * sum_a_x_sum_b + kC2);
+  const int64_t sum_a_sq = sum_a * sum_a;
+  const int64_t sum_b_sq = sum_b * sum_b;
+  const int64_t ssim_d =
+      (sum_a_sq + sum_b_sq + kC1) *
+      (kCount * sum_sq_a - sum_a_sq + kCount * sum_sq_b - sum_b_sq + kC2);
+  if (ssim_d == 0)
+    return DBL_MAX;
+  return ssim_n * 1.0 / ssim_d;
+}
+
+}  // namespace
+
+double CalculateI420Ssim(const I420BufferInterface& ref_buffer,
+                         const I420BufferInterface& test_buffer) {
+  RTC_CHECK_EQ(ref_buffer.width(), test_buffer.width());
+  RTC_CHECK_EQ(ref_buffer.height(), test_buffer.height());
+  const int width = test_buffer.width();
+  const int height = test_buffer.height();
+  const int width_uv = (width + 1) >> 1;
+  const int height_uv = (height + 1) >> 1;
+  const double ssim_y =
+      CalculatePlaneSsim(ref_buffer.DataY(), ref_buffer.StrideY(),
+                         test_buffer.DataY(), test_buffer.StrideY(), width,
+                         height);
+  const double ssim_u =
+      CalculatePlaneSsim(ref_buffer.DataU(), ref_buffer.StrideU(),
+                         test_buffer.DataU(), test_buffer.StrideU(), width_uv,
+                         height_uv);
+  const double ssim_v =
+      CalculatePlaneSsim(ref_buffer.DataV(), ref_buffer.StrideV(),
+                         test_buffer.DataV(), test_buffer.StrideV(), width_uv,
+                         height_uv);
+  return ssim_y * 0.8 + 0.1 * (ssim_u + ssim_v);
+}
+
+double CalculatePlaneSsim(const uint8_t* src_a,
+                          int stride_a,
+                          const uint8_t* src_b,
+                          int stride_b,
+                          int width,
+                          int height) {
+  static const SumColumnsFunction sum_columns = SelectSumColumnsFunction();
+  // The windows start at every multiple of 4 below |width| - 8. Each window
+  // covers two column groups, and shares one with the next.
+  const int num_windows =
+      width > kWindowSize
+          ? (width - kWindowSize + kWindowStride - 1) / kWindowStride
+          : 0;
+  std::vector<SsimColumnSums> sums(num_windows + 1);
+
+  int samples = 0;
+  double ssim_total = 0;
+  for (int i = 0; i < height - kWindowSize; i += kWindowStride) {
+    if (num_windows > 0) {
+      sum_columns(src_a, stride_a, src_b, stride_b, num_windows + 1,
+                  sums.data());
+    }
+    // Added in the same order as libyuv, so that the result is identical.
+    for (int j = 0; j < num_windows; ++j) {
+      ssim_total += WindowSsim(sums[j], sums[j + 1]);
+      ++samples;
+    }
+    src_a += stride_a * kWindowStride;
+    src_b += stride_b * kWindowStride;
+  }
+  // NaN for planes too small for a single window, like libyuv.
+  return ssim_total / samples;
+}
+
+namespace internal {
+
+void SumSsimColumns_C(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      int num_groups,
+                      SsimColumnSums* sums) {
+  for (int group = 0; group < num_groups; ++group) {
+    SsimColumnSums& group_sums = sums[group];
+    group_sums = SsimColumnSums();
+    const int column = group * kWindowStride;
+    for (int row = 0; row < kWindowSize; ++row) {
+      const uint8_t* a = src_a + row * stride_a + column;
+      const uint8_t* b = src_b + row * stride_b + column;
+      for (int k = 0; k < kWindowStride; ++k) {
+        group_sums.sum_a += a[k];
+        group_sums.sum_b += b[k];
+        group_sums.sum_sq_a += a[k] * a[k];
+        group_sums.sum_sq_b += b[k] * b[k];
+        group_sums.sum_axb += a[k] * b[k];
+      }
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_FRAME_ANALYZER_FRAME_SSIM_H_
+#define RTC_TOOLS_FRAME_ANALYZER_FRAME_SSIM_H_
+
+#include <stdint.h>
+
+#include "api/video/video_frame_buffer.h"
+
+namespace webrtc {
+namespace test {
+
+// SSIM of an I420 frame, the same as libyuv::I420Ssim(), but using the widest
+// vector instructions supported by the CPU.
+double CalculateI420Ssim(const I420BufferInterface& ref_buffer,
+                         const I420BufferInterface& test_buffer);
+
+// SSIM of a plane, the same as libyuv::CalcFrameSsim(): the mean of the SSIM of
+// the 8x8 windows starting every 4 pixels, in both directions.
+double CalculatePlaneSsim(const uint8_t* src_a,
+                          int stride_a,
+                          const uint8_t* src_b,
+                          int stride_b,
+                          int width,
+                          int height);
+
+namespace internal {
+
+// The sums the SSIM of a window is made of, over 4 columns of 8 rows. A window
+// is made of two consecutive column groups.
+struct SsimColumnSums {
+  int32_t sum_a;
+  int32_t sum_b;
+  int32_t sum_sq_a;
+  int32_t sum_sq_b;
+  int32_t sum_axb;
+};
+
+// Fills |sums| with the sums of the first |num_groups| groups of 4 columns of
+// the 8 rows starting at |src_a| and |src_b|.
+void SumSsimColumns_C(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      int num_groups,
+                      SsimColumnSums* sums);
+
+}  // namespace internal
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_FRAME_ANALYZER_FRAME_SSIM_H_
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/frame_analyzer/frame_ssim_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+namespace test {
+namespace internal {
+
+namespace {
+constexpr int kRows = 8;
+constexpr int kGroupWidth = 4;
+// Groups summed by one vector of 16 pixels.
+constexpr int kGroupsPerVector = 4;
+}  // namespace
+
+void SumSsimColumns_AVX2(const uint8_t* src_a,
+                         int stride_a,
+                         const uint8_t* src_b,
+                         int stride_b,
+                         int num_groups,
+                         SsimColumnSums* sums) {
+  const __m256i ones = _mm256_set1_epi16(1);
+  int group = 0;
+  for (; group + kGroupsPerVector <= num_groups; group += kGroupsPerVector) {
+    const int column = group * kGroupWidth;
+    // The pixel sums of the 16 columns fit in 16 bits, the products are
+    // summed by pairs of columns in 32 bits.
+    __m256i sum_a = _mm256_setzero_si256();
+    __m256i sum_b = _mm256_setzero_si256();
+    __m256i sum_sq_a = _mm256_setzero_si256();
+    __m256i sum_sq_b = _mm256_setzero_si256();
+    __m256i sum_axb = _mm256_setzero_si256();
+    for (int row = 0; row < kRows; ++row) {
+      const __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src_a + row * stride_a + column)));
+      const __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src_b + row * stride_b + column)));
+      sum_a = _mm256_add_epi16(sum_a, a);
+      sum_b = _mm256_add_epi16(sum_b, b);
+      sum_sq_a = _mm256_add_epi32(sum_sq_a, _mm256_madd_epi16(a, a));
+      sum_sq_b = _mm256_add_epi32(sum_sq_b, _mm256_madd_epi16(b, b));
+      sum_axb = _mm256_add_epi32(sum_axb, _mm256_madd_epi16(a, b));
+    }
+    // Everything by pairs of columns, then by groups of 4 columns.
+    alignas(32) int32_t pairs[5][8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(pairs[0]),
+                       _mm256_madd_epi16(sum_a, ones));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(pairs[1]),
+                       _mm256_madd_epi16(sum_b, ones));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(pairs[2]), sum_sq_a);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(pairs[3]), sum_sq_b);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(pairs[4]), sum_axb);
+    for (int k = 0; k < kGroupsPerVector; ++k) {
+      SsimColumnSums& group_sums = sums[group + k];
+      group_sums.sum_a = pairs[0][2 * k] + pairs[0][2 * k + 1];
+      group_sums.sum_b = pairs[1][2 * k] + pairs[1][2 * k + 1];
+      group_sums.sum_sq_a = pairs[2][2 * k] + pairs[2][2 * k + 1];
+      group_sums.sum_sq_b = pairs[3][2 * k] + pairs[3][2 * k + 1];
+      group_sums.sum_axb = pairs[4][2 * k] + pairs[4][2 * k + 1];
+    }
+  }
+  for (; group < num_groups; ++group) {
+    SsimColumnSums& group_sums = sums[group];
+    group_sums = SsimColumnSums();
+    const int column = group * kGroupWidth;
+    for (int row = 0; row < kRows; ++row) {
+      const uint8_t* a = src_a + row * stride_a + column;
+      const uint8_t* b = src_b + row * stride_b + column;
+      for (int k = 0; k < kGroupWidth; ++k) {
+        group_sums.sum_a += a[k];
+        group_sums.sum_b += b[k];
+        group_sums.sum_sq_a += a[k] * a[k];
+        group_sums.sum_sq_b += b[k] * b[k];
+        group_sums.sum_axb += a[k] * b[k];
+      }
+    }
+  }
+  // Avoid the penalty of mixing AVX and legacy SSE code in the caller.
+  _mm256_zeroupper();
+}
+
+}  // namespace internal
+}  // namespace test
+}  // namespace webrtc
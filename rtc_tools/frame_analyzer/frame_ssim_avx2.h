@@ -0,0 +1,37 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This header file is used only by frame_ssim.cc. It defines the AVX2 routine
+// summing the pixels of the SSIM windows.
+
+#ifndef RTC_TOOLS_FRAME_ANALYZER_FRAME_SSIM_AVX2_H_
+#define RTC_TOOLS_FRAME_ANALYZER_FRAME_SSIM_AVX2_H_
+
+#include <stdint.h>
+
+#include "rtc_tools/frame_analyzer/frame_ssim.h"
+
+namespace webrtc {
+namespace test {
+namespace internal {
+
+// Same as SumSsimColumns_C(). Must only be called if the CPU supports AVX2.
+void SumSsimColumns_AVX2(const uint8_t* src_a,
+                         int stride_a,
+                         const uint8_t* src_b,
+                         int stride_b,
+                         int num_groups,
+                         SsimColumnSums* sums);
+
+}  // namespace internal
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_FRAME_ANALYZER_FRAME_SSIM_AVX2_H_
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/frame_analyzer/frame_ssim.h"
+
+#include <cmath>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gtest.h"
+#include "third_party/libyuv/include/libyuv/compare.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "rtc_tools/frame_analyzer/frame_ssim_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace test {
+namespace {
+
+void FillPlane(Random* random, uint8_t* data, int stride, int height) {
+  for (int i = 0; i < stride * height; ++i)
+    data[i] = random->Rand<uint8_t>();
+}
+
+rtc::scoped_refptr<I420Buffer> CreateRandomBuffer(Random* random,
+                                                  int width,
+                                                  int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  FillPlane(random, buffer->MutableDataY(), buffer->StrideY(), height);
+  FillPlane(random, buffer->MutableDataU(), buffer->StrideU(),
+            buffer->ChromaHeight());
+  FillPlane(random, buffer->MutableDataV(), buffer->StrideV(),
+            buffer->ChromaHeight());
+  return buffer;
+}
+
+// Makes |buffer| look like a lossy copy of |ref|.
+void AddNoise(Random* random, const I420Buffer& ref, I420Buffer* buffer) {
+  const int size = ref.StrideY() * ref.height();
+  for (int i = 0; i < size; ++i) {
+    const int value = ref.DataY()[i] + random->Rand(-8, 8);
+    buffer->MutableDataY()[i] = static_cast<uint8_t>(
+        value < 0 ? 0 : (value > 255 ? 255 : value));
+  }
+}
+
+}  // namespace
+
+TEST(FrameSsimTest, MatchesLibyuv) {
+  Random random(0x5eed);
+  const int kSizes[][2] = {{1, 1},    {8, 8},   {9, 9},     {17, 13},
+                           {128, 96}, {352, 288}, {641, 361}};
+  for (const auto& size : kSizes) {
+    const int width = size[0];
+    const int height = size[1];
+    rtc::scoped_refptr<I420Buffer> ref =
+        CreateRandomBuffer(&random, width, height);
+    rtc::scoped_refptr<I420Buffer> test =
+        CreateRandomBuffer(&random, width, height);
+    AddNoise(&random, *ref, test.get());
+
+    const double expected = libyuv::I420Ssim(
+        ref->DataY(), ref->StrideY(), ref->DataU(), ref->StrideU(),
+        ref->DataV(), ref->StrideV(), test->DataY(), test->StrideY(),
+        test->DataU(), test->StrideU(), test->DataV(), test->StrideV(), width,
+        height);
+    const double ssim = CalculateI420Ssim(*ref, *test);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(ssim)) << width << "x" << height;
+    } else {
+      EXPECT_EQ(expected, ssim) << width << "x" << height;
+    }
+  }
+}
+
+TEST(FrameSsimTest, IdenticalFramesHaveSsimOne) {
+  Random random(0x5eed);
+  rtc::scoped_refptr<I420Buffer> ref = CreateRandomBuffer(&random, 64, 48);
+  EXPECT_DOUBLE_EQ(1.0, CalculateI420Ssim(*ref, *ref));
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(FrameSsimTest, Avx2ColumnSumsMatchC) {
+  if (WebRtc_GetCPUInfo(kAVX2) == 0)
+    return;
+  Random random(0x5eed);
+  constexpr int kStride = 160;
+  std::vector<uint8_t> a(kStride * 8);
+  std::vector<uint8_t> b(kStride * 8);
+  FillPlane(&random, a.data(), kStride, 8);
+  FillPlane(&random, b.data(), kStride, 8);
+  // Whole vectors and a scalar tail.
+  for (int num_groups : {1, 4, 7, 39}) {
+    std::vector<internal::SsimColumnSums> expected(num_groups);
+    std::vector<internal::SsimColumnSums> sums(num_groups);
+    internal::SumSsimColumns_C(a.data(), kStride, b.data(), kStride,
+                               num_groups, expected.data());
+    internal::SumSsimColumns_AVX2(a.data(), kStride, b.data(), kStride,
+                                  num_groups, sums.data());
+    for (int i = 0; i < num_groups; ++i) {
+      EXPECT_EQ(expected[i].sum_a, sums[i].sum_a);
+      EXPECT_EQ(expected[i].sum_b, sums[i].sum_b);
+      EXPECT_EQ(expected[i].sum_sq_a, sums[i].sum_sq_a);
+      EXPECT_EQ(expected[i].sum_sq_b, sums[i].sum_sq_b);
+      EXPECT_EQ(expected[i].sum_axb, sums[i].sum_axb);
+    }
+  }
+}
+#endif
+
+}  // namespace test
+}  // namespace webrtc
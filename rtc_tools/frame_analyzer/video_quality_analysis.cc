@@ -12,16 +12,55 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <memory>
 
+#include "api/function_view.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_tools/frame_analyzer/frame_ssim.h"
 #include "test/testsupport/perf_test.h"
 #include "third_party/libyuv/include/libyuv/compare.h"
 
 namespace webrtc {
 namespace test {
 
+namespace {
+
+// Calls |job| with every index in [0, |count|), on |num_threads| threads
+// including the calling one, and returns once all calls returned.
+void RunInParallel(size_t count,
+                   int num_threads,
+                   rtc::FunctionView<void(size_t)> job) {
+  struct Jobs {
+    static void Run(void* obj) {
+      Jobs* jobs = static_cast<Jobs*>(obj);
+      for (size_t i = jobs->next++; i < jobs->count; i = jobs->next++)
+        jobs->job(i);
+    }
+
+    const size_t count;
+    const rtc::FunctionView<void(size_t)> job;
+    std::atomic<size_t> next{0};
+  } jobs{count, job};
+
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  const size_t num_helpers =
+      std::min<size_t>(std::max(num_threads, 1) - 1, count);
+  for (size_t i = 0; i < num_helpers; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &Jobs::Run, &jobs, "FrameAnalyzer"));
+    threads.back()->Start();
+  }
+  Jobs::Run(&jobs);
+  for (const auto& thread : threads)
+    thread->Stop();
+}
+
+}  // namespace
+
 ResultsContainer::ResultsContainer() {}
 ResultsContainer::~ResultsContainer() {}
 
@@ -50,27 +89,35 @@ double Psnr(const rtc::scoped_refptr<I420BufferInterface>& ref_buffer,
 
 double Ssim(const rtc::scoped_refptr<I420BufferInterface>& ref_buffer,
             const rtc::scoped_refptr<I420BufferInterface>& test_buffer) {
-  return CalculateMetric(&libyuv::I420Ssim, ref_buffer, test_buffer);
+  return CalculateI420Ssim(*ref_buffer, *test_buffer);
 }
 
 std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
     const std::vector<size_t>& test_frame_indices) {
-  std::vector<AnalysisResult> results;
-  for (size_t i = 0; i < test_video->number_of_frames(); ++i) {
+  return RunAnalysis(reference_video, test_video, test_frame_indices,
+                     /*num_threads=*/1);
+}
+
+std::vector<AnalysisResult> RunAnalysis(
+    const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
+    const rtc::scoped_refptr<webrtc::test::Video>& test_video,
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads) {
+  std::vector<AnalysisResult> results(test_video->number_of_frames());
+  RunInParallel(results.size(), num_threads, [&](size_t i) {
     const rtc::scoped_refptr<I420BufferInterface>& test_frame =
         test_video->GetFrame(i);
     const rtc::scoped_refptr<I420BufferInterface>& reference_frame =
         reference_video->GetFrame(i);
 
     // Fill in the result struct.
-    AnalysisResult result;
+    AnalysisResult& result = results[i];
     result.frame_number = test_frame_indices[i];
     result.psnr_value = Psnr(reference_frame, test_frame);
     result.ssim_value = Ssim(reference_frame, test_frame);
-    results.push_back(result);
-  }
+  });
 
   return results;
 }
@@ -56,6 +56,15 @@ std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
     const std::vector<size_t>& test_frame_indices);
 
+// As above, but scoring the frames on |num_threads| threads at once. The
+// GetFrame() of both videos must then be thread safe, like those of the videos
+// read from files and of the aligners.
+std::vector<AnalysisResult> RunAnalysis(
+    const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
+    const rtc::scoped_refptr<webrtc::test::Video>& test_video,
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads);
+
 // Compute PSNR for an I420 buffer (all planes). The max return value (in the
 // case where the test and reference frames are exactly the same) will be 48.
 double Psnr(const rtc::scoped_refptr<I420BufferInterface>& ref_buffer,
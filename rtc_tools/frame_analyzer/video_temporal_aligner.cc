@@ -20,6 +20,7 @@
 
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_tools/frame_analyzer/video_quality_analysis.h"
 
@@ -113,6 +114,7 @@ class DownscaledVideo : public rtc::RefCountedObject<Video> {
 
 // Helper class that takes a video and caches the latest frame access. This
 // improves performance a lot since the original source is often from a file.
+// Unlike the other videos, it must not be read from several threads at once.
 class CachedVideo : public rtc::RefCountedObject<Video> {
  public:
   CachedVideo(int max_cache_size, const rtc::scoped_refptr<Video>& video)
@@ -150,13 +152,16 @@ class CachedVideo : public rtc::RefCountedObject<Video> {
   mutable std::deque<CachedFrame> cache_;
 };
 
-// Try matching the test frame against all frames in the reference video and
-// return the index of the best matching frame.
+// Try matching the test frame against the first |search_window| frames in the
+// reference video and return the index of the best matching frame.
 size_t FindBestMatch(const rtc::scoped_refptr<I420BufferInterface>& test_frame,
-                     const Video& reference_video) {
+                     const Video& reference_video,
+                     size_t search_window) {
   std::vector<double> ssim;
-  for (const auto& ref_frame : reference_video)
-    ssim.push_back(Ssim(test_frame, ref_frame));
+  const size_t num_frames =
+      std::min(search_window, reference_video.number_of_frames());
+  for (size_t i = 0; i < num_frames; ++i)
+    ssim.push_back(Ssim(test_frame, reference_video.GetFrame(i)));
   return std::distance(ssim.begin(),
                        std::max_element(ssim.begin(), ssim.end()));
 }
@@ -184,6 +189,15 @@ size_t FindNextMatch(const rtc::scoped_refptr<I420BufferInterface>& test_frame,
 std::vector<size_t> FindMatchingFrameIndices(
     const rtc::scoped_refptr<Video>& reference_video,
     const rtc::scoped_refptr<Video>& test_video) {
+  return FindMatchingFrameIndices(reference_video, test_video,
+                                  std::numeric_limits<size_t>::max());
+}
+
+std::vector<size_t> FindMatchingFrameIndices(
+    const rtc::scoped_refptr<Video>& reference_video,
+    const rtc::scoped_refptr<Video>& test_video,
+    size_t search_window) {
+  RTC_CHECK_GT(search_window, 0u);
   // This is done to get a 10x speedup. We don't need the full resolution in
   // order to match frames, and we should limit file access and not read the
   // same memory tens of times.
@@ -203,8 +217,8 @@ std::vector<size_t> FindMatchingFrameIndices(
        *downscaled_test_video) {
     if (match_indices.empty()) {
       // First frame.
-      match_indices.push_back(
-          FindBestMatch(test_frame, *cached_downscaled_reference_video));
+      match_indices.push_back(FindBestMatch(
+          test_frame, *cached_downscaled_reference_video, search_window));
     } else {
       match_indices.push_back(FindNextMatch(
           test_frame, *looping_reference_video, match_indices.back()));
@@ -31,6 +31,15 @@ std::vector<size_t> FindMatchingFrameIndices(
     const rtc::scoped_refptr<Video>& reference_video,
     const rtc::scoped_refptr<Video>& test_video);
 
+// As above, but the first test frame is only matched against the first
+// |search_window| reference frames instead of all of them, e.g. those the test
+// video may start at given the longest expected delay. Later frames are
+// matched from the previous match onwards either way.
+std::vector<size_t> FindMatchingFrameIndices(
+    const rtc::scoped_refptr<Video>& reference_video,
+    const rtc::scoped_refptr<Video>& test_video,
+    size_t search_window);
+
 // Generate a new video using the frames from the original video. The returned
 // video will have the same number of frames as the size of |indices|, and
 // frame nr i in the returned video will point to frame nr indices[i] in the
@@ -28,6 +28,7 @@
 #include "call/call.h"
 #include "call/video_receive_stream.h"
 #include "call/video_send_stream.h"
+#include "logging/rtc_event_log/events/rtc_event_alpha_cc_estimate.h"
 #include "logging/rtc_event_log/rtc_event_processor.h"
 #include "logging/rtc_event_log/rtc_stream_config.h"
 #include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor.h"
@@ -975,6 +976,17 @@ void EventLogAnalyzer::CreateTotalIncomingBitrateGraph(Plot* plot) {
   }
   plot->AppendTimeSeriesIfNotEmpty(std::move(remb_series));
 
+  // Overlay the AlphaCC estimates sent back to the sender.
+  TimeSeries alpha_cc_series("AlphaCC sent estimate", LineStyle::kStep);
+  for (const auto& estimate : parsed_log_.alpha_cc_estimate_events()) {
+    if (estimate.source != RtcEventAlphaCcEstimate::Source::kSent)
+      continue;
+    float x = config_.GetCallTimeSec(estimate.log_time_us());
+    float y = estimate.target_rate.kbps<float>();
+    alpha_cc_series.points.emplace_back(x, y);
+  }
+  plot->AppendTimeSeriesIfNotEmpty(std::move(alpha_cc_series));
+
   if (!parsed_log_.generic_packets_received().empty()) {
     TimeSeries time_series("Incoming generic bitrate", LineStyle::kLine);
     auto GetPacketSizeKilobits = [](const LoggedGenericPacketReceived& packet) {
@@ -1150,6 +1162,17 @@ void EventLogAnalyzer::CreateTotalOutgoingBitrateGraph(Plot* plot,
   }
   plot->AppendTimeSeriesIfNotEmpty(std::move(remb_series));
 
+  // Overlay the AlphaCC estimates received from the receive side.
+  TimeSeries alpha_cc_series("AlphaCC received estimate", LineStyle::kStep);
+  for (const auto& estimate : parsed_log_.alpha_cc_estimate_events()) {
+    if (estimate.source != RtcEventAlphaCcEstimate::Source::kReceived)
+      continue;
+    float x = config_.GetCallTimeSec(estimate.log_time_us());
+    float y = estimate.target_rate.kbps<float>();
+    alpha_cc_series.points.emplace_back(x, y);
+  }
+  plot->AppendTimeSeriesIfNotEmpty(std::move(alpha_cc_series));
+
   if (!parsed_log_.generic_packets_sent().empty()) {
     {
       TimeSeries time_series("Outgoing generic total bitrate",
@@ -2198,6 +2221,7 @@ void EventLogAnalyzer::CreateIceCandidatePairConfigGraph(Plot* plot) {
           TimeSeries("[" + std::to_string(config.candidate_pair_id) + "]" +
                          candidate_pair_desc,
                      LineStyle::kNone, PointStyle::kHighlight);
+      rtc::CritScope cs(&candidate_pair_desc_lock_);
       candidate_pair_desc_by_id_[config.candidate_pair_id] =
           candidate_pair_desc;
     }
@@ -2228,6 +2252,7 @@ void EventLogAnalyzer::CreateIceCandidatePairConfigGraph(Plot* plot) {
 
 std::string EventLogAnalyzer::GetCandidatePairLogDescriptionFromId(
     uint32_t candidate_pair_id) {
+  rtc::CritScope cs(&candidate_pair_desc_lock_);
   if (candidate_pair_desc_by_id_.find(candidate_pair_id) !=
       candidate_pair_desc_by_id_.end()) {
     return candidate_pair_desc_by_id_[candidate_pair_id];
@@ -20,7 +20,9 @@
 
 #include "logging/rtc_event_log/rtc_event_log_parser.h"
 #include "modules/audio_coding/neteq/tools/neteq_stats_getter.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_tools/rtc_event_log_visualizer/plot_base.h"
 #include "rtc_tools/rtc_event_log_visualizer/triage_notifications.h"
 
@@ -57,6 +59,9 @@ class EventLogAnalyzer {
   // modified while the EventLogAnalyzer is being used.
   EventLogAnalyzer(const ParsedRtcEventLog& log, bool normalize_time);
 
+  // The Create*Graph() methods may be called concurrently, each with its own
+  // plot. CreateTriageNotifications() may not.
+
   void CreatePacketGraph(PacketDirection direction, Plot* plot);
 
   void CreateRtcpTypeGraph(PacketDirection direction, Plot* plot);
@@ -299,7 +304,10 @@ class EventLogAnalyzer {
   std::vector<OutgoingCaptureTimeJump> outgoing_capture_time_jumps_;
   std::vector<OutgoingHighLoss> outgoing_high_loss_alerts_;
 
-  std::map<uint32_t, std::string> candidate_pair_desc_by_id_;
+  // Filled by the ICE plots, which may be computed concurrently.
+  rtc::CriticalSection candidate_pair_desc_lock_;
+  std::map<uint32_t, std::string> candidate_pair_desc_by_id_
+      RTC_GUARDED_BY(candidate_pair_desc_lock_);
 
   AnalyzerConfig config_;
 };
@@ -11,6 +11,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -24,16 +26,22 @@
 #include "absl/flags/usage.h"
 #include "absl/flags/usage_config.h"
 #include "absl/strings/match.h"
+#include "absl/types/optional.h"
+#include "api/function_view.h"
 #include "api/neteq/neteq.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "logging/rtc_event_log/rtc_event_log_parser.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/strings/string_builder.h"
 #include "rtc_tools/rtc_event_log_visualizer/analyzer.h"
 #include "rtc_tools/rtc_event_log_visualizer/plot_base.h"
+#include "rtc_tools/rtc_event_log_visualizer/plot_cache.h"
 #include "rtc_tools/rtc_event_log_visualizer/plot_protobuf.h"
 #include "rtc_tools/rtc_event_log_visualizer/plot_python.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "system_wrappers/include/field_trial.h"
 #include "test/field_trial.h"
 #include "test/testsupport/file_utils.h"
@@ -75,6 +83,26 @@ ABSL_FLAG(bool,
           "WebRTC mapping. This can give very misleading results if the "
           "application negotiates a different mapping.");
 
+ABSL_FLAG(int,
+          parse_threads,
+          1,
+          "Number of threads used to decode the log. More threads speed up "
+          "parsing of large logs.");
+
+ABSL_FLAG(int,
+          plot_threads,
+          0,
+          "Number of threads computing the plots concurrently, or 0 to use "
+          "one per core.");
+
+ABSL_FLAG(std::string,
+          plot_cache_dir,
+          "",
+          "Directory where the computed plots are cached. Running again on the "
+          "same log with the same flags and field trials loads them instead "
+          "of computing them, and only parses the log if some requested plot "
+          "isn't cached. No cache is used if empty.");
+
 ABSL_FLAG(bool,
           print_triage_alerts,
           false,
@@ -183,6 +211,49 @@ class PlotMap {
   std::vector<PlotDeclaration> plots_;
 };
 
+// Calls |job| with every index in [0, |count|), on |num_threads| threads
+// including the calling one, and returns once all calls returned.
+void RunInParallel(size_t count,
+                   int num_threads,
+                   rtc::FunctionView<void(size_t)> job) {
+  struct Jobs {
+    static void Run(void* obj) {
+      Jobs* jobs = static_cast<Jobs*>(obj);
+      for (size_t i = jobs->next++; i < jobs->count; i = jobs->next++)
+        jobs->job(i);
+    }
+
+    const size_t count;
+    const rtc::FunctionView<void(size_t)> job;
+    std::atomic<size_t> next{0};
+  } jobs{count, job};
+
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  const size_t num_helpers =
+      std::min<size_t>(std::max(num_threads, 1) - 1, count);
+  for (size_t i = 0; i < num_helpers; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &Jobs::Run, &jobs, "event_log_plot"));
+    threads.back()->Start();
+  }
+  Jobs::Run(&jobs);
+  for (const auto& thread : threads)
+    thread->Stop();
+}
+
+// Everything besides the log that the plots depend on, for the plot cache.
+std::string PlotSettings(const std::string& wav_path) {
+  rtc::StringBuilder settings;
+  settings << "field_trials=" << absl::GetFlag(FLAGS_force_fieldtrials)
+           << ";wav=" << wav_path << ";show_detector_state="
+           << absl::GetFlag(FLAGS_show_detector_state)
+           << ";show_alr_state=" << absl::GetFlag(FLAGS_show_alr_state)
+           << ";parse_unconfigured_header_extensions="
+           << absl::GetFlag(FLAGS_parse_unconfigured_header_extensions)
+           << ";normalize_time=" << absl::GetFlag(FLAGS_normalize_time);
+  return settings.Release();
+}
+
 bool ContainsHelppackageFlags(absl::string_view filename) {
   return absl::EndsWith(filename, "main.cc");
 }
@@ -248,21 +319,13 @@ int main(int argc, char* argv[]) {
     header_extensions = webrtc::ParsedRtcEventLog::
         UnconfiguredHeaderExtensions::kAttemptWebrtcDefaultConfig;
   }
-  webrtc::ParsedRtcEventLog parsed_log(header_extensions,
-                                       /*allow_incomplete_logs*/ true);
-
-  if (args.size() == 2) {
-    std::string filename = args[1];
-    auto status = parsed_log.ParseFile(filename);
-    if (!status.ok()) {
-      std::cerr << "Failed to parse " << filename << ": " << status.message()
-                << std::endl;
-      return -1;
-    }
-  }
+  webrtc::ParsedRtcEventLog parsed_log(
+      header_extensions, /*allow_incomplete_logs*/ true,
+      std::max(1, absl::GetFlag(FLAGS_parse_threads)));
 
-  webrtc::EventLogAnalyzer analyzer(parsed_log,
-                                    absl::GetFlag(FLAGS_normalize_time));
+  // Created once the log is parsed, which is skipped if every requested plot
+  // is cached.
+  absl::optional<webrtc::EventLogAnalyzer> analyzer;
   std::unique_ptr<webrtc::PlotCollection> collection;
   if (absl::GetFlag(FLAGS_protobuf_output)) {
     collection.reset(new webrtc::ProtobufPlotCollection());
@@ -273,105 +336,105 @@ int main(int argc, char* argv[]) {
 
   PlotMap plots;
   plots.RegisterPlot("incoming_packet_sizes", [&](Plot* plot) {
-    analyzer.CreatePacketGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreatePacketGraph(webrtc::kIncomingPacket, plot);
   });
 
   plots.RegisterPlot("outgoing_packet_sizes", [&](Plot* plot) {
-    analyzer.CreatePacketGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreatePacketGraph(webrtc::kOutgoingPacket, plot);
   });
   plots.RegisterPlot("incoming_rtcp_types", [&](Plot* plot) {
-    analyzer.CreateRtcpTypeGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreateRtcpTypeGraph(webrtc::kIncomingPacket, plot);
   });
   plots.RegisterPlot("outgoing_rtcp_types", [&](Plot* plot) {
-    analyzer.CreateRtcpTypeGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreateRtcpTypeGraph(webrtc::kOutgoingPacket, plot);
   });
   plots.RegisterPlot("incoming_packet_count", [&](Plot* plot) {
-    analyzer.CreateAccumulatedPacketsGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreateAccumulatedPacketsGraph(webrtc::kIncomingPacket, plot);
   });
   plots.RegisterPlot("outgoing_packet_count", [&](Plot* plot) {
-    analyzer.CreateAccumulatedPacketsGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreateAccumulatedPacketsGraph(webrtc::kOutgoingPacket, plot);
   });
   plots.RegisterPlot("incoming_packet_rate", [&](Plot* plot) {
-    analyzer.CreatePacketRateGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreatePacketRateGraph(webrtc::kIncomingPacket, plot);
   });
   plots.RegisterPlot("outgoing_packet_rate", [&](Plot* plot) {
-    analyzer.CreatePacketRateGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreatePacketRateGraph(webrtc::kOutgoingPacket, plot);
   });
   plots.RegisterPlot("total_incoming_packet_rate", [&](Plot* plot) {
-    analyzer.CreateTotalPacketRateGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreateTotalPacketRateGraph(webrtc::kIncomingPacket, plot);
   });
   plots.RegisterPlot("total_outgoing_packet_rate", [&](Plot* plot) {
-    analyzer.CreateTotalPacketRateGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreateTotalPacketRateGraph(webrtc::kOutgoingPacket, plot);
   });
   plots.RegisterPlot("audio_playout",
-                     [&](Plot* plot) { analyzer.CreatePlayoutGraph(plot); });
+                     [&](Plot* plot) { analyzer->CreatePlayoutGraph(plot); });
   plots.RegisterPlot("incoming_audio_level", [&](Plot* plot) {
-    analyzer.CreateAudioLevelGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreateAudioLevelGraph(webrtc::kIncomingPacket, plot);
   });
   plots.RegisterPlot("outgoing_audio_level", [&](Plot* plot) {
-    analyzer.CreateAudioLevelGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreateAudioLevelGraph(webrtc::kOutgoingPacket, plot);
   });
   plots.RegisterPlot("incoming_sequence_number_delta", [&](Plot* plot) {
-    analyzer.CreateSequenceNumberGraph(plot);
+    analyzer->CreateSequenceNumberGraph(plot);
   });
   plots.RegisterPlot("incoming_delay", [&](Plot* plot) {
-    analyzer.CreateIncomingDelayGraph(plot);
+    analyzer->CreateIncomingDelayGraph(plot);
   });
   plots.RegisterPlot("incoming_loss_rate", [&](Plot* plot) {
-    analyzer.CreateIncomingPacketLossGraph(plot);
+    analyzer->CreateIncomingPacketLossGraph(plot);
   });
   plots.RegisterPlot("incoming_bitrate", [&](Plot* plot) {
-    analyzer.CreateTotalIncomingBitrateGraph(plot);
+    analyzer->CreateTotalIncomingBitrateGraph(plot);
   });
   plots.RegisterPlot("outgoing_bitrate", [&](Plot* plot) {
-    analyzer.CreateTotalOutgoingBitrateGraph(
+    analyzer->CreateTotalOutgoingBitrateGraph(
         plot, absl::GetFlag(FLAGS_show_detector_state),
         absl::GetFlag(FLAGS_show_alr_state));
   });
   plots.RegisterPlot("incoming_stream_bitrate", [&](Plot* plot) {
-    analyzer.CreateStreamBitrateGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreateStreamBitrateGraph(webrtc::kIncomingPacket, plot);
   });
   plots.RegisterPlot("outgoing_stream_bitrate", [&](Plot* plot) {
-    analyzer.CreateStreamBitrateGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreateStreamBitrateGraph(webrtc::kOutgoingPacket, plot);
   });
   plots.RegisterPlot("incoming_layer_bitrate_allocation", [&](Plot* plot) {
-    analyzer.CreateBitrateAllocationGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreateBitrateAllocationGraph(webrtc::kIncomingPacket, plot);
   });
   plots.RegisterPlot("outgoing_layer_bitrate_allocation", [&](Plot* plot) {
-    analyzer.CreateBitrateAllocationGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreateBitrateAllocationGraph(webrtc::kOutgoingPacket, plot);
   });
   plots.RegisterPlot("simulated_receiveside_bwe", [&](Plot* plot) {
-    analyzer.CreateReceiveSideBweSimulationGraph(plot);
+    analyzer->CreateReceiveSideBweSimulationGraph(plot);
   });
   plots.RegisterPlot("simulated_sendside_bwe", [&](Plot* plot) {
-    analyzer.CreateSendSideBweSimulationGraph(plot);
+    analyzer->CreateSendSideBweSimulationGraph(plot);
   });
   plots.RegisterPlot("simulated_goog_cc", [&](Plot* plot) {
-    analyzer.CreateGoogCcSimulationGraph(plot);
+    analyzer->CreateGoogCcSimulationGraph(plot);
   });
   plots.RegisterPlot("network_delay_feedback", [&](Plot* plot) {
-    analyzer.CreateNetworkDelayFeedbackGraph(plot);
+    analyzer->CreateNetworkDelayFeedbackGraph(plot);
   });
   plots.RegisterPlot("fraction_loss_feedback", [&](Plot* plot) {
-    analyzer.CreateFractionLossGraph(plot);
+    analyzer->CreateFractionLossGraph(plot);
   });
   plots.RegisterPlot("incoming_timestamps", [&](Plot* plot) {
-    analyzer.CreateTimestampGraph(webrtc::kIncomingPacket, plot);
+    analyzer->CreateTimestampGraph(webrtc::kIncomingPacket, plot);
   });
   plots.RegisterPlot("outgoing_timestamps", [&](Plot* plot) {
-    analyzer.CreateTimestampGraph(webrtc::kOutgoingPacket, plot);
+    analyzer->CreateTimestampGraph(webrtc::kOutgoingPacket, plot);
   });
 
   auto GetFractionLost = [](const webrtc::rtcp::ReportBlock& block) -> float {
     return static_cast<double>(block.fraction_lost()) / 256 * 100;
   };
   plots.RegisterPlot("incoming_rtcp_fraction_lost", [&](Plot* plot) {
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kIncomingPacket, GetFractionLost,
         "Fraction lost (incoming RTCP)", "Loss rate (percent)", plot);
   });
   plots.RegisterPlot("outgoing_rtcp_fraction_lost", [&](Plot* plot) {
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kOutgoingPacket, GetFractionLost,
         "Fraction lost (outgoing RTCP)", "Loss rate (percent)", plot);
   });
@@ -379,12 +442,12 @@ int main(int argc, char* argv[]) {
     return block.cumulative_lost_signed();
   };
   plots.RegisterPlot("incoming_rtcp_cumulative_lost", [&](Plot* plot) {
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kIncomingPacket, GetCumulativeLost,
         "Cumulative lost packets (incoming RTCP)", "Packets", plot);
   });
   plots.RegisterPlot("outgoing_rtcp_cumulative_lost", [&](Plot* plot) {
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kOutgoingPacket, GetCumulativeLost,
         "Cumulative lost packets (outgoing RTCP)", "Packets", plot);
   });
@@ -394,12 +457,12 @@ int main(int argc, char* argv[]) {
     return block.extended_high_seq_num();
   };
   plots.RegisterPlot("incoming_rtcp_highest_seq_number", [&](Plot* plot) {
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kIncomingPacket, GetHighestSeqNumber,
         "Highest sequence number (incoming RTCP)", "Sequence number", plot);
   });
   plots.RegisterPlot("outgoing_rtcp_highest_seq_number", [&](Plot* plot) {
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kOutgoingPacket, GetHighestSeqNumber,
         "Highest sequence number (outgoing RTCP)", "Sequence number", plot);
   });
@@ -408,50 +471,51 @@ int main(int argc, char* argv[]) {
     return static_cast<double>(block.delay_since_last_sr()) / 65536;
   };
   plots.RegisterPlot("incoming_rtcp_delay_since_last_sr", [&](Plot* plot) {
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kIncomingPacket, DelaySinceLastSr,
         "Delay since last received sender report (incoming RTCP)", "Time (s)",
         plot);
   });
   plots.RegisterPlot("outgoing_rtcp_delay_since_last_sr", [&](Plot* plot) {
-    analyzer.CreateSenderAndReceiverReportPlot(
+    analyzer->CreateSenderAndReceiverReportPlot(
         webrtc::kOutgoingPacket, DelaySinceLastSr,
         "Delay since last received sender report (outgoing RTCP)", "Time (s)",
         plot);
   });
 
-  plots.RegisterPlot("pacer_delay",
-                     [&](Plot* plot) { analyzer.CreatePacerDelayGraph(plot); });
+  plots.RegisterPlot("pacer_delay", [&](Plot* plot) {
+    analyzer->CreatePacerDelayGraph(plot);
+  });
   plots.RegisterPlot("audio_encoder_bitrate", [&](Plot* plot) {
-    analyzer.CreateAudioEncoderTargetBitrateGraph(plot);
+    analyzer->CreateAudioEncoderTargetBitrateGraph(plot);
   });
   plots.RegisterPlot("audio_encoder_frame_length", [&](Plot* plot) {
-    analyzer.CreateAudioEncoderFrameLengthGraph(plot);
+    analyzer->CreateAudioEncoderFrameLengthGraph(plot);
   });
   plots.RegisterPlot("audio_encoder_packet_loss", [&](Plot* plot) {
-    analyzer.CreateAudioEncoderPacketLossGraph(plot);
+    analyzer->CreateAudioEncoderPacketLossGraph(plot);
   });
   plots.RegisterPlot("audio_encoder_fec", [&](Plot* plot) {
-    analyzer.CreateAudioEncoderEnableFecGraph(plot);
+    analyzer->CreateAudioEncoderEnableFecGraph(plot);
   });
   plots.RegisterPlot("audio_encoder_dtx", [&](Plot* plot) {
-    analyzer.CreateAudioEncoderEnableDtxGraph(plot);
+    analyzer->CreateAudioEncoderEnableDtxGraph(plot);
   });
   plots.RegisterPlot("audio_encoder_num_channels", [&](Plot* plot) {
-    analyzer.CreateAudioEncoderNumChannelsGraph(plot);
+    analyzer->CreateAudioEncoderNumChannelsGraph(plot);
   });
 
   plots.RegisterPlot("ice_candidate_pair_config", [&](Plot* plot) {
-    analyzer.CreateIceCandidatePairConfigGraph(plot);
+    analyzer->CreateIceCandidatePairConfigGraph(plot);
   });
   plots.RegisterPlot("ice_connectivity_check", [&](Plot* plot) {
-    analyzer.CreateIceConnectivityCheckGraph(plot);
+    analyzer->CreateIceConnectivityCheckGraph(plot);
   });
   plots.RegisterPlot("dtls_transport_state", [&](Plot* plot) {
-    analyzer.CreateDtlsTransportStateGraph(plot);
+    analyzer->CreateDtlsTransportStateGraph(plot);
   });
   plots.RegisterPlot("dtls_writable_state", [&](Plot* plot) {
-    analyzer.CreateDtlsWritableStateGraph(plot);
+    analyzer->CreateDtlsWritableStateGraph(plot);
   });
 
   std::string wav_path;
@@ -464,10 +528,8 @@ int main(int argc, char* argv[]) {
   absl::optional<webrtc::EventLogAnalyzer::NetEqStatsGetterMap> neteq_stats;
 
   plots.RegisterPlot("simulated_neteq_expand_rate", [&](Plot* plot) {
-    if (!neteq_stats) {
-      neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
-    }
-    analyzer.CreateNetEqNetworkStatsGraph(
+    RTC_DCHECK(neteq_stats);
+    analyzer->CreateNetEqNetworkStatsGraph(
         *neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.expand_rate / 16384.f;
@@ -476,10 +538,8 @@ int main(int argc, char* argv[]) {
   });
 
   plots.RegisterPlot("simulated_neteq_speech_expand_rate", [&](Plot* plot) {
-    if (!neteq_stats) {
-      neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
-    }
-    analyzer.CreateNetEqNetworkStatsGraph(
+    RTC_DCHECK(neteq_stats);
+    analyzer->CreateNetEqNetworkStatsGraph(
         *neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.speech_expand_rate / 16384.f;
@@ -488,10 +548,8 @@ int main(int argc, char* argv[]) {
   });
 
   plots.RegisterPlot("simulated_neteq_accelerate_rate", [&](Plot* plot) {
-    if (!neteq_stats) {
-      neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
-    }
-    analyzer.CreateNetEqNetworkStatsGraph(
+    RTC_DCHECK(neteq_stats);
+    analyzer->CreateNetEqNetworkStatsGraph(
         *neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.accelerate_rate / 16384.f;
@@ -500,10 +558,8 @@ int main(int argc, char* argv[]) {
   });
 
   plots.RegisterPlot("simulated_neteq_preemptive_rate", [&](Plot* plot) {
-    if (!neteq_stats) {
-      neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
-    }
-    analyzer.CreateNetEqNetworkStatsGraph(
+    RTC_DCHECK(neteq_stats);
+    analyzer->CreateNetEqNetworkStatsGraph(
         *neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.preemptive_rate / 16384.f;
@@ -512,10 +568,8 @@ int main(int argc, char* argv[]) {
   });
 
   plots.RegisterPlot("simulated_neteq_packet_loss_rate", [&](Plot* plot) {
-    if (!neteq_stats) {
-      neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
-    }
-    analyzer.CreateNetEqNetworkStatsGraph(
+    RTC_DCHECK(neteq_stats);
+    analyzer->CreateNetEqNetworkStatsGraph(
         *neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.packet_loss_rate / 16384.f;
@@ -524,10 +578,8 @@ int main(int argc, char* argv[]) {
   });
 
   plots.RegisterPlot("simulated_neteq_concealment_events", [&](Plot* plot) {
-    if (!neteq_stats) {
-      neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
-    }
-    analyzer.CreateNetEqLifetimeStatsGraph(
+    RTC_DCHECK(neteq_stats);
+    analyzer->CreateNetEqLifetimeStatsGraph(
         *neteq_stats,
         [](const webrtc::NetEqLifetimeStatistics& stats) {
           return static_cast<float>(stats.concealment_events);
@@ -536,10 +588,8 @@ int main(int argc, char* argv[]) {
   });
 
   plots.RegisterPlot("simulated_neteq_preferred_buffer_size", [&](Plot* plot) {
-    if (!neteq_stats) {
-      neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
-    }
-    analyzer.CreateNetEqNetworkStatsGraph(
+    RTC_DCHECK(neteq_stats);
+    analyzer->CreateNetEqNetworkStatsGraph(
         *neteq_stats,
         [](const webrtc::NetEqNetworkStatistics& stats) {
           return stats.preferred_buffer_size_ms;
@@ -585,28 +635,67 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  const std::string filename = args[1];
+  const bool plot_jitter_buffer_delay =
+      absl::c_find(plot_flags, "simulated_neteq_jitter_buffer_delay") !=
+      plot_flags.end();
+  std::unique_ptr<webrtc::PlotCache> cache;
+  if (!absl::GetFlag(FLAGS_plot_cache_dir).empty()) {
+    cache = webrtc::PlotCache::Create(absl::GetFlag(FLAGS_plot_cache_dir),
+                                      filename, PlotSettings(wav_path));
+  }
+
+  // The plots are appended in order, and those not found in the cache are
+  // computed afterwards.
+  std::vector<std::pair<const PlotDeclaration*, Plot*>> uncached_plots;
+  bool simulate_neteq = plot_jitter_buffer_delay;
   for (const auto& plot : plots) {
     if (plot.enabled) {
       Plot* output = collection->AppendNewPlot();
-      plot.plot_func(output);
-      output->SetId(plot.label);
+      if (cache && cache->Load(plot.label, output))
+        continue;
+      uncached_plots.emplace_back(&plot, output);
+      simulate_neteq |= absl::StartsWith(plot.label, "simulated_neteq_");
     }
   }
 
+  if (!uncached_plots.empty() || plot_jitter_buffer_delay ||
+      absl::GetFlag(FLAGS_print_triage_alerts)) {
+    auto status = parsed_log.ParseFile(filename);
+    if (!status.ok()) {
+      std::cerr << "Failed to parse " << filename << ": " << status.message()
+                << std::endl;
+      return -1;
+    }
+    analyzer.emplace(parsed_log, absl::GetFlag(FLAGS_normalize_time));
+  }
+  // Simulated once for all the NetEq plots, before they are computed
+  // concurrently.
+  if (simulate_neteq)
+    neteq_stats = analyzer->SimulateNetEq(wav_path, 48000);
+
+  int plot_threads = absl::GetFlag(FLAGS_plot_threads);
+  if (plot_threads <= 0)
+    plot_threads = webrtc::CpuInfo::DetectNumberOfCores();
+  RunInParallel(uncached_plots.size(), plot_threads, [&](size_t i) {
+    const PlotDeclaration& plot = *uncached_plots[i].first;
+    Plot* output = uncached_plots[i].second;
+    plot.plot_func(output);
+    output->SetId(plot.label);
+    if (cache)
+      cache->Store(plot.label, *output);
+  });
+
   // The model we use for registering plots assumes that the each plot label
   // can be mapped to a lambda that will produce exactly one plot. The
   // simulated_neteq_jitter_buffer_delay plot doesn't fit this model since it
   // creates multiple plots, and would need some state kept between the lambda
   // calls.
-  if (absl::c_find(plot_flags, "simulated_neteq_jitter_buffer_delay") !=
-      plot_flags.end()) {
-    if (!neteq_stats) {
-      neteq_stats = analyzer.SimulateNetEq(wav_path, 48000);
-    }
+  if (plot_jitter_buffer_delay) {
     for (webrtc::EventLogAnalyzer::NetEqStatsGetterMap::const_iterator it =
              neteq_stats->cbegin();
          it != neteq_stats->cend(); ++it) {
-      analyzer.CreateAudioJitterBufferGraph(it->first, it->second.get(),
+      analyzer->CreateAudioJitterBufferGraph(it->first, it->second.get(),
                                             collection->AppendNewPlot());
     }
   }
@@ -614,8 +703,8 @@ int main(int argc, char* argv[]) {
   collection->Draw();
 
   if (absl::GetFlag(FLAGS_print_triage_alerts)) {
-    analyzer.CreateTriageNotifications();
-    analyzer.PrintNotifications(stderr);
+    analyzer->CreateTriageNotifications();
+    analyzer->PrintNotifications(stderr);
   }
 
   return 0;
@@ -10,11 +10,69 @@
 
 #include "rtc_tools/rtc_event_log_visualizer/plot_base.h"
 
+#include <string.h>
+
 #include <algorithm>
 
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+
+void WriteFloat(float value, rtc::ByteBufferWriter* buffer) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  buffer->WriteUInt32(bits);
+}
+
+void WriteDouble(double value, rtc::ByteBufferWriter* buffer) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  buffer->WriteUInt64(bits);
+}
+
+void WriteString(const std::string& value, rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(value.size());
+  buffer->WriteString(value);
+}
+
+bool ReadFloat(rtc::ByteBufferReader* buffer, float* value) {
+  uint32_t bits;
+  if (!buffer->ReadUInt32(&bits))
+    return false;
+  memcpy(value, &bits, sizeof(bits));
+  return true;
+}
+
+bool ReadDouble(rtc::ByteBufferReader* buffer, double* value) {
+  uint64_t bits;
+  if (!buffer->ReadUInt64(&bits))
+    return false;
+  memcpy(value, &bits, sizeof(bits));
+  return true;
+}
+
+bool ReadString(rtc::ByteBufferReader* buffer, std::string* value) {
+  uint64_t size;
+  return buffer->ReadUVarint(&size) && size <= buffer->Length() &&
+         buffer->ReadString(value, size);
+}
+
+// Reads a count of elements at least |min_element_size| bytes each, so that a
+// corrupt count can't make the caller reserve more than the buffer holds.
+bool ReadCount(rtc::ByteBufferReader* buffer,
+               size_t min_element_size,
+               size_t* count) {
+  uint64_t value;
+  if (!buffer->ReadUVarint(&value) ||
+      value > buffer->Length() / min_element_size) {
+    return false;
+  }
+  *count = static_cast<size_t>(value);
+  return true;
+}
+
+}  // namespace
 
 void Plot::SetXAxis(float min_value,
                     float max_value,
@@ -93,4 +151,135 @@ void Plot::AppendTimeSeriesIfNotEmpty(TimeSeries&& time_series) {
   }
 }
 
+void Plot::Serialize(rtc::ByteBufferWriter* buffer) const {
+  WriteFloat(xaxis_min_, buffer);
+  WriteFloat(xaxis_max_, buffer);
+  WriteString(xaxis_label_, buffer);
+  WriteFloat(yaxis_min_, buffer);
+  WriteFloat(yaxis_max_, buffer);
+  WriteString(yaxis_label_, buffer);
+  buffer->WriteUVarint(yaxis_tick_labels_.size());
+  for (const auto& tick_label : yaxis_tick_labels_) {
+    WriteFloat(tick_label.first, buffer);
+    WriteString(tick_label.second, buffer);
+  }
+  WriteString(title_, buffer);
+  WriteString(id_, buffer);
+
+  buffer->WriteUVarint(series_list_.size());
+  for (const TimeSeries& series : series_list_) {
+    WriteString(series.label, buffer);
+    buffer->WriteUInt8(static_cast<uint8_t>(series.line_style));
+    buffer->WriteUInt8(static_cast<uint8_t>(series.point_style));
+    buffer->WriteUVarint(series.points.size());
+    for (const TimeSeriesPoint& point : series.points) {
+      WriteFloat(point.x, buffer);
+      WriteFloat(point.y, buffer);
+    }
+  }
+  buffer->WriteUVarint(interval_list_.size());
+  for (const IntervalSeries& series : interval_list_) {
+    WriteString(series.label, buffer);
+    WriteString(series.color, buffer);
+    buffer->WriteUInt8(static_cast<uint8_t>(series.orientation));
+    buffer->WriteUVarint(series.intervals.size());
+    for (const Interval& interval : series.intervals) {
+      WriteDouble(interval.begin, buffer);
+      WriteDouble(interval.end, buffer);
+    }
+  }
+}
+
+bool Plot::Deserialize(rtc::ByteBufferReader* buffer) {
+  float xaxis_min;
+  float xaxis_max;
+  std::string xaxis_label;
+  float yaxis_min;
+  float yaxis_max;
+  std::string yaxis_label;
+  size_t num_tick_labels;
+  if (!ReadFloat(buffer, &xaxis_min) || !ReadFloat(buffer, &xaxis_max) ||
+      !ReadString(buffer, &xaxis_label) || !ReadFloat(buffer, &yaxis_min) ||
+      !ReadFloat(buffer, &yaxis_max) || !ReadString(buffer, &yaxis_label) ||
+      !ReadCount(buffer, 5, &num_tick_labels)) {
+    return false;
+  }
+  std::vector<std::pair<float, std::string>> yaxis_tick_labels(
+      num_tick_labels);
+  for (auto& tick_label : yaxis_tick_labels) {
+    if (!ReadFloat(buffer, &tick_label.first) ||
+        !ReadString(buffer, &tick_label.second)) {
+      return false;
+    }
+  }
+  std::string title;
+  std::string id;
+  size_t num_series;
+  if (!ReadString(buffer, &title) || !ReadString(buffer, &id) ||
+      !ReadCount(buffer, 4, &num_series)) {
+    return false;
+  }
+
+  std::vector<TimeSeries> series_list(num_series);
+  for (TimeSeries& series : series_list) {
+    uint8_t line_style;
+    uint8_t point_style;
+    size_t num_points;
+    if (!ReadString(buffer, &series.label) ||
+        !buffer->ReadUInt8(&line_style) ||
+        line_style > static_cast<uint8_t>(LineStyle::kBar) ||
+        !buffer->ReadUInt8(&point_style) ||
+        point_style > static_cast<uint8_t>(PointStyle::kHighlight) ||
+        !ReadCount(buffer, 8, &num_points)) {
+      return false;
+    }
+    series.line_style = static_cast<LineStyle>(line_style);
+    series.point_style = static_cast<PointStyle>(point_style);
+    series.points.reserve(num_points);
+    for (size_t i = 0; i < num_points; ++i) {
+      float x;
+      float y;
+      if (!ReadFloat(buffer, &x) || !ReadFloat(buffer, &y))
+        return false;
+      series.points.emplace_back(x, y);
+    }
+  }
+  size_t num_interval_series;
+  if (!ReadCount(buffer, 4, &num_interval_series))
+    return false;
+  std::vector<IntervalSeries> interval_list(num_interval_series);
+  for (IntervalSeries& series : interval_list) {
+    uint8_t orientation;
+    size_t num_intervals;
+    if (!ReadString(buffer, &series.label) ||
+        !ReadString(buffer, &series.color) ||
+        !buffer->ReadUInt8(&orientation) ||
+        orientation > IntervalSeries::kVertical ||
+        !ReadCount(buffer, 16, &num_intervals)) {
+      return false;
+    }
+    series.orientation = static_cast<IntervalSeries::Orientation>(orientation);
+    series.intervals.resize(num_intervals);
+    for (Interval& interval : series.intervals) {
+      if (!ReadDouble(buffer, &interval.begin) ||
+          !ReadDouble(buffer, &interval.end)) {
+        return false;
+      }
+    }
+  }
+
+  xaxis_min_ = xaxis_min;
+  xaxis_max_ = xaxis_max;
+  xaxis_label_ = std::move(xaxis_label);
+  yaxis_min_ = yaxis_min;
+  yaxis_max_ = yaxis_max;
+  yaxis_label_ = std::move(yaxis_label);
+  yaxis_tick_labels_ = std::move(yaxis_tick_labels);
+  title_ = std::move(title);
+  id_ = std::move(id);
+  series_list_ = std::move(series_list);
+  interval_list_ = std::move(interval_list);
+  return true;
+}
+
 }  // namespace webrtc
@@ -15,6 +15,8 @@
 #include <utility>
 #include <vector>
 
+#include "rtc_base/byte_buffer.h"
+
 namespace webrtc {
 
 enum class LineStyle {
@@ -158,6 +160,12 @@ class Plot {
   // Otherwise, the call has no effect and the timeseries is destroyed.
   void AppendTimeSeriesIfNotEmpty(TimeSeries&& time_series);
 
+  // Writes everything the plot is drawn from to |buffer|.
+  void Serialize(rtc::ByteBufferWriter* buffer) const;
+  // Replaces the contents of the plot by the ones written by Serialize().
+  // Returns false, leaving the plot unchanged, if |buffer| is malformed.
+  bool Deserialize(rtc::ByteBufferReader* buffer);
+
  protected:
   float xaxis_min_;
   float xaxis_max_;
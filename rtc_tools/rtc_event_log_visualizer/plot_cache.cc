@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/rtc_event_log_visualizer/plot_cache.h"
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "rtc_base/crc32.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// "WPC1", written first in each file. Change it when the format changes.
+constexpr uint32_t kMagic = 0x31435057;
+constexpr size_t kReadChunkSize = 1 << 20;
+
+bool ReadFile(const std::string& file_name, std::vector<char>* contents) {
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (!file)
+    return false;
+  contents->clear();
+  char chunk[4096];
+  size_t read;
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    contents->insert(contents->end(), chunk, chunk + read);
+  const bool ok = !ferror(file);
+  fclose(file);
+  return ok;
+}
+
+}  // namespace
+
+std::unique_ptr<PlotCache> PlotCache::Create(const std::string& directory,
+                                             const std::string& log_file_name,
+                                             const std::string& settings) {
+  FILE* log_file = fopen(log_file_name.c_str(), "rb");
+  if (!log_file) {
+    RTC_LOG(LS_ERROR) << "Could not open " << log_file_name;
+    return nullptr;
+  }
+  std::vector<char> chunk(kReadChunkSize);
+  uint32_t log_crc = 0;
+  uint64_t log_size = 0;
+  size_t read;
+  while ((read = fread(chunk.data(), 1, chunk.size(), log_file)) > 0) {
+    log_crc = rtc::UpdateCrc32(log_crc, chunk.data(), read);
+    log_size += read;
+  }
+  const bool read_error = ferror(log_file) != 0;
+  fclose(log_file);
+  if (read_error) {
+    RTC_LOG(LS_ERROR) << "Could not read " << log_file_name;
+    return nullptr;
+  }
+
+  char prefix[64];
+  snprintf(prefix, sizeof(prefix), "%08x%08x%016llx", log_crc,
+           rtc::ComputeCrc32(settings),
+           static_cast<unsigned long long>(log_size));  // NOLINT(runtime/int)
+  std::string file_prefix = directory;
+  if (!file_prefix.empty() && file_prefix.back() != '/')
+    file_prefix.push_back('/');
+  file_prefix += prefix;
+  return std::unique_ptr<PlotCache>(new PlotCache(std::move(file_prefix)));
+}
+
+PlotCache::PlotCache(std::string file_prefix)
+    : file_prefix_(std::move(file_prefix)) {}
+
+bool PlotCache::Load(const std::string& label, Plot* plot) const {
+  std::vector<char> contents;
+  if (!ReadFile(FileName(label), &contents))
+    return false;
+  rtc::ByteBufferReader buffer(contents.data(), contents.size());
+  uint32_t magic;
+  if (!buffer.ReadUInt32(&magic) || magic != kMagic ||
+      !plot->Deserialize(&buffer)) {
+    RTC_LOG(LS_WARNING) << "Ignoring the malformed cached plot " << label;
+    return false;
+  }
+  return true;
+}
+
+void PlotCache::Store(const std::string& label, const Plot& plot) const {
+  rtc::ByteBufferWriter buffer;
+  buffer.WriteUInt32(kMagic);
+  plot.Serialize(&buffer);
+
+  // Written aside and renamed, so that an interrupted run leaves no partial
+  // plot behind.
+  const std::string file_name = FileName(label);
+  const std::string temp_file_name = file_name + ".tmp";
+  FILE* file = fopen(temp_file_name.c_str(), "wb");
+  if (!file) {
+    RTC_LOG(LS_WARNING) << "Could not cache the plot " << label << " in "
+                        << file_name;
+    return;
+  }
+  const bool written =
+      fwrite(buffer.Data(), 1, buffer.Length(), file) == buffer.Length();
+  if (fclose(file) != 0 || !written ||
+      rename(temp_file_name.c_str(), file_name.c_str()) != 0) {
+    RTC_LOG(LS_WARNING) << "Could not cache the plot " << label << " in "
+                        << file_name;
+    remove(temp_file_name.c_str());
+  }
+}
+
+std::string PlotCache::FileName(const std::string& label) const {
+  return file_prefix_ + "." + label + ".plot";
+}
+
+}  // namespace webrtc
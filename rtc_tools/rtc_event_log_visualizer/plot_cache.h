@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef RTC_TOOLS_RTC_EVENT_LOG_VISUALIZER_PLOT_CACHE_H_
+#define RTC_TOOLS_RTC_EVENT_LOG_VISUALIZER_PLOT_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "rtc_tools/rtc_event_log_visualizer/plot_base.h"
+
+namespace webrtc {
+
+// Keeps the computed plots of a log in |directory|, one file per plot, so that
+// running the visualizer again on the same log and settings skips parsing and
+// analyzing the log for the plots it already computed. The plots are keyed by
+// a hash of the contents of the log and of |settings|, which must describe
+// everything else the plots depend on. All methods are thread safe.
+class PlotCache {
+ public:
+  // Returns null if |log_file_name| can't be read.
+  static std::unique_ptr<PlotCache> Create(const std::string& directory,
+                                           const std::string& log_file_name,
+                                           const std::string& settings);
+
+  // Replaces the contents of |plot| by the cached plot |label|. Returns false,
+  // leaving |plot| unchanged, if there is none.
+  bool Load(const std::string& label, Plot* plot) const;
+  // Caches |plot| as |label|. Failures are only logged.
+  void Store(const std::string& label, const Plot& plot) const;
+
+ private:
+  explicit PlotCache(std::string file_prefix);
+
+  std::string FileName(const std::string& label) const;
+
+  const std::string file_prefix_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_RTC_EVENT_LOG_VISUALIZER_PLOT_CACHE_H_
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/rtc_event_log_visualizer/plot_cache.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rtc_base/byte_buffer.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kSettings[] = "--normalize_time";
+
+class TestPlot : public Plot {
+ public:
+  void Draw() override {}
+
+  std::string Serialized() const {
+    rtc::ByteBufferWriter buffer;
+    Serialize(&buffer);
+    return std::string(buffer.Data(), buffer.Length());
+  }
+  const std::string& title() const { return title_; }
+  const std::vector<TimeSeries>& series_list() const { return series_list_; }
+};
+
+void FillPlot(Plot* plot) {
+  TimeSeries series("Bitrate", LineStyle::kStep, PointStyle::kHighlight);
+  series.points.emplace_back(0.0f, 300.0f);
+  series.points.emplace_back(1.5f, 450.0f);
+  plot->AppendTimeSeries(std::move(series));
+  IntervalSeries intervals("ALR", "#ff0000", IntervalSeries::kHorizontal);
+  intervals.intervals.emplace_back(0.5, 1.0);
+  plot->AppendIntervalSeries(std::move(intervals));
+  plot->SetXAxis(0, 2, "Time (s)");
+  plot->SetSuggestedYAxis(0, 500, "Bitrate (kbps)", 0, 0.1);
+  plot->SetYAxisTickLabels({{0, "low"}, {500, "high"}});
+  plot->SetTitle("Outgoing bitrate");
+  plot->SetId("outgoing_bitrate");
+}
+
+class PlotCacheTest : public ::testing::Test {
+ protected:
+  PlotCacheTest()
+      : directory_(test::TempFilename(test::OutputPath(), "plot_cache")),
+        log_file_name_(test::TempFilename(test::OutputPath(), "event_log")) {
+    test::RemoveFile(directory_);
+    test::CreateDir(directory_);
+    WriteLog("event log");
+  }
+  ~PlotCacheTest() override {
+    for (const std::string& file : *test::ReadDirectory(directory_))
+      test::RemoveFile(file);
+    test::RemoveDir(directory_);
+    test::RemoveFile(log_file_name_);
+  }
+
+  void WriteLog(const std::string& contents) {
+    std::ofstream(log_file_name_, std::ios::binary) << contents;
+  }
+
+  std::unique_ptr<PlotCache> CreateCache(
+      const std::string& settings = kSettings) {
+    return PlotCache::Create(directory_, log_file_name_, settings);
+  }
+
+  const std::string directory_;
+  const std::string log_file_name_;
+};
+
+TEST_F(PlotCacheTest, LoadsAStoredPlot) {
+  TestPlot plot;
+  FillPlot(&plot);
+  std::unique_ptr<PlotCache> cache = CreateCache();
+  ASSERT_TRUE(cache);
+  cache->Store("outgoing_bitrate", plot);
+
+  TestPlot loaded;
+  ASSERT_TRUE(CreateCache()->Load("outgoing_bitrate", &loaded));
+  EXPECT_EQ(loaded.title(), "Outgoing bitrate");
+  ASSERT_EQ(loaded.series_list().size(), 1u);
+  EXPECT_EQ(loaded.series_list()[0].line_style, LineStyle::kStep);
+  ASSERT_EQ(loaded.series_list()[0].points.size(), 2u);
+  EXPECT_EQ(loaded.series_list()[0].points[1].y, 450.0f);
+  EXPECT_EQ(loaded.Serialized(), plot.Serialized());
+  EXPECT_FALSE(cache->Load("incoming_bitrate", &loaded));
+}
+
+TEST_F(PlotCacheTest, MissesThePlotsOfAnotherLogOrSettings) {
+  TestPlot plot;
+  FillPlot(&plot);
+  CreateCache()->Store("outgoing_bitrate", plot);
+
+  TestPlot loaded;
+  EXPECT_FALSE(CreateCache("--nonormalize_time")
+                   ->Load("outgoing_bitrate", &loaded));
+  WriteLog("other event log");
+  EXPECT_FALSE(CreateCache()->Load("outgoing_bitrate", &loaded));
+  EXPECT_TRUE(loaded.title().empty());
+}
+
+TEST_F(PlotCacheTest, FailsWithoutTheLog) {
+  test::RemoveFile(log_file_name_);
+  EXPECT_FALSE(CreateCache());
+}
+
+TEST(PlotTest, RejectsATruncatedPlot) {
+  TestPlot plot;
+  FillPlot(&plot);
+  const std::string serialized = plot.Serialized();
+
+  TestPlot loaded;
+  for (size_t size = 0; size < serialized.size(); ++size) {
+    rtc::ByteBufferReader buffer(serialized.data(), size);
+    EXPECT_FALSE(loaded.Deserialize(&buffer)) << size;
+  }
+  EXPECT_TRUE(loaded.title().empty());
+  rtc::ByteBufferReader buffer(serialized.data(), serialized.size());
+  EXPECT_TRUE(loaded.Deserialize(&buffer));
+  EXPECT_EQ(loaded.Serialized(), serialized);
+}
+
+}  // namespace
+}  // namespace webrtc
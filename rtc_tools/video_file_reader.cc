@@ -12,12 +12,24 @@
 
 #include <cstdio>
 #include <string>
+#include <utility>
 #include <vector>
 
+#if defined(WEBRTC_POSIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#endif
+
 #include "absl/strings/match.h"
 #include "absl/types/optional.h"
 #include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/string_encode.h"
@@ -54,9 +66,9 @@ class VideoFile : public Video {
       size_t frame_index) const override {
     RTC_CHECK_LT(frame_index, frame_positions_.size());
 
-    fsetpos(file_, &frame_positions_[frame_index]);
     rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
-
+    rtc::CritScope cs(&file_lock_);
+    fsetpos(file_, &frame_positions_[frame_index]);
     if (!ReadBytes(buffer->MutableDataY(), width_ * height_, file_) ||
         !ReadBytes(buffer->MutableDataU(),
                    buffer->ChromaWidth() * buffer->ChromaHeight(), file_) ||
@@ -73,8 +85,136 @@ class VideoFile : public Video {
   const int width_;
   const int height_;
   const std::vector<fpos_t> frame_positions_;
-  FILE* const file_;
+  // Held from seeking to the end of the read.
+  rtc::CriticalSection file_lock_;
+  FILE* const file_ RTC_PT_GUARDED_BY(file_lock_);
+};
+
+#if defined(WEBRTC_POSIX)
+// Frames read ahead of a sequential scan.
+constexpr size_t kReadaheadFrames = 4;
+
+// A read only mapping of a whole file, unmapped once the video and the last
+// of its frames are gone.
+class FileMapping : public rtc::RefCountInterface {
+ public:
+  FileMapping(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+  ~FileMapping() override {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+
+  static rtc::scoped_refptr<FileMapping> Create(FILE* file) {
+    struct stat file_stat;
+    if (fstat(fileno(file), &file_stat) != 0 || file_stat.st_size <= 0)
+      return nullptr;
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if (data == MAP_FAILED)
+      return nullptr;
+    return new rtc::RefCountedObject<FileMapping>(
+        static_cast<const uint8_t*>(data), size);
+  }
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Asks the kernel to read the pages of [offset, offset + size) ahead.
+  void WillNeed(size_t offset, size_t size) const {
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    if (offset >= size_)
+      return;
+    const size_t begin = offset - offset % page_size;
+    const size_t end = std::min(offset + size, size_);
+    madvise(const_cast<uint8_t*>(data_ + begin), end - begin, MADV_WILLNEED);
+  }
+
+ private:
+  const uint8_t* const data_;
+  const size_t size_;
+};
+
+// Returns the frames as views into a mapping of the file, without copying
+// them. The pages are read by the kernel as the frames are accessed, and
+// ahead of the frames once they are read in order.
+class MappedVideoFile : public Video {
+ public:
+  MappedVideoFile(int width,
+                  int height,
+                  std::vector<size_t> frame_offsets,
+                  rtc::scoped_refptr<FileMapping> mapping)
+      : width_(width),
+        height_(height),
+        frame_offsets_(std::move(frame_offsets)),
+        mapping_(std::move(mapping)) {}
+
+  size_t number_of_frames() const override { return frame_offsets_.size(); }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> GetFrame(
+      size_t frame_index) const override {
+    RTC_CHECK_LT(frame_index, frame_offsets_.size());
+
+    const int chroma_width = (width_ + 1) / 2;
+    const int chroma_height = (height_ + 1) / 2;
+    const size_t y_size = static_cast<size_t>(width_) * height_;
+    const size_t uv_size = static_cast<size_t>(chroma_width) * chroma_height;
+    const size_t frame_size = y_size + 2 * uv_size;
+    const size_t offset = frame_offsets_[frame_index];
+    if (offset > mapping_->size() || mapping_->size() - offset < frame_size) {
+      RTC_LOG(LS_ERROR) << "Could not read YUV data for frame " << frame_index;
+      return nullptr;
+    }
+    // Only hints, so a race between threads reading in order costs at most a
+    // redundant or a missed hint.
+    if (next_sequential_index_.exchange(frame_index + 1) == frame_index &&
+        frame_index + 1 < frame_offsets_.size()) {
+      mapping_->WillNeed(frame_offsets_[frame_index + 1],
+                         kReadaheadFrames * frame_size);
+    }
+
+    const uint8_t* y_plane = mapping_->data() + offset;
+    const uint8_t* u_plane = y_plane + y_size;
+    const uint8_t* v_plane = u_plane + uv_size;
+    rtc::scoped_refptr<FileMapping> mapping = mapping_;
+    return WrapI420Buffer(width_, height_, y_plane, width_, u_plane,
+                          chroma_width, v_plane, chroma_width,
+                          [mapping] {});
+  }
+
+ private:
+  const int width_;
+  const int height_;
+  const std::vector<size_t> frame_offsets_;
+  const rtc::scoped_refptr<FileMapping> mapping_;
+  mutable std::atomic<size_t> next_sequential_index_{0};
 };
+#endif  // defined(WEBRTC_POSIX)
+
+// Maps |file| when possible, and otherwise reads the frames from it. Takes
+// ownership of |file|.
+rtc::scoped_refptr<Video> CreateVideoFile(
+    int width,
+    int height,
+    const std::vector<fpos_t>& frame_positions,
+    FILE* file) {
+#if defined(WEBRTC_POSIX)
+  std::vector<size_t> frame_offsets;
+  frame_offsets.reserve(frame_positions.size());
+  for (const fpos_t& position : frame_positions) {
+    fsetpos(file, &position);
+    frame_offsets.push_back(ftello(file));
+  }
+  rtc::scoped_refptr<FileMapping> mapping = FileMapping::Create(file);
+  if (mapping) {
+    fclose(file);
+    return new rtc::RefCountedObject<MappedVideoFile>(
+        width, height, std::move(frame_offsets), std::move(mapping));
+  }
+  RTC_LOG(LS_WARNING) << "Could not map the video file, reading it instead";
+#endif
+  return CreateVideoFile(width, height, frame_positions, file);
+}
 
 }  // namespace
 
@@ -224,8 +364,7 @@ rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name) {
   }
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
-  return new rtc::RefCountedObject<VideoFile>(*width, *height, frame_positions,
-                                              file);
+  return CreateVideoFile(*width, *height, frame_positions, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
@@ -266,8 +405,7 @@ rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
   }
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
-  return new rtc::RefCountedObject<VideoFile>(width, height, frame_positions,
-                                              file);
+  return CreateVideoFile(width, height, frame_positions, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvOrY4mFile(const std::string& file_name,
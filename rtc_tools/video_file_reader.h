@@ -23,8 +23,10 @@
 namespace webrtc {
 namespace test {
 
-// Iterable class representing a sequence of I420 buffers. This class is not
-// thread safe because it is expected to be backed by a file.
+// Iterable class representing a sequence of I420 buffers. The videos opened
+// below may be read from several threads at once. Where the file can be mapped
+// their frames are views into the mapping, which stays mapped as long as any
+// of them, otherwise they read one frame from the file at a time.
 class Video : public rtc::RefCountInterface {
  public:
   class Iterator {
@@ -73,6 +73,21 @@ TEST_F(Y4mFileReaderTest, TestPixelContent) {
   }
 }
 
+TEST_F(Y4mFileReaderTest, TestRandomAccess) {
+  const rtc::scoped_refptr<I420BufferInterface> second = video->GetFrame(1);
+  const rtc::scoped_refptr<I420BufferInterface> first = video->GetFrame(0);
+  EXPECT_EQ(0, first->DataY()[0]);
+  EXPECT_EQ(6 * 4 * 3 / 2, second->DataY()[0]);
+  EXPECT_EQ(6 * 4 * 3 / 2 + 6 * 4, second->DataU()[0]);
+}
+
+TEST_F(Y4mFileReaderTest, TestFrameOutlivesVideo) {
+  const rtc::scoped_refptr<I420BufferInterface> frame = video->GetFrame(1);
+  video = nullptr;
+  EXPECT_EQ(6, frame->width());
+  EXPECT_EQ(6 * 4 * 3 / 2 + 6 * 4 + 3 * 2, frame->DataV()[0]);
+}
+
 class YuvFileReaderTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -123,6 +123,13 @@ std::vector<const RTCStatsMemberInterface*> RTCStats::Members() const {
   return MembersOfThisObjectAndAncestors(0);
 }
 
+void RTCStats::VisitMembers(RTCStatsMemberVisitor* visitor) const {
+  for (const RTCStatsMemberInterface* member : Members()) {
+    if (member->is_defined())
+      member->Accept(visitor);
+  }
+}
+
 std::vector<const RTCStatsMemberInterface*>
 RTCStats::MembersOfThisObjectAndAncestors(size_t additional_capacity) const {
   std::vector<const RTCStatsMemberInterface*> members;
@@ -0,0 +1,397 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtc_stats_binary.h"
+
+#include <string.h>
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "api/stats/rtc_stats_report.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+const uint8_t kMagic[] = {'R', 'S', 'B', '1'};
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+class BinaryWriter : public RTCStatsMemberVisitor {
+ public:
+  explicit BinaryWriter(rtc::Buffer* output) : output_(output) {}
+
+  void WriteStats(const RTCStats& stats) {
+    WriteString(stats.type());
+    WriteString(stats.id());
+    WriteSigned(stats.timestamp_us());
+    std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+    uint64_t num_defined = 0;
+    for (const RTCStatsMemberInterface* member : members)
+      num_defined += member->is_defined();
+    WriteUnsigned(num_defined);
+    for (const RTCStatsMemberInterface* member : members) {
+      if (member->is_defined())
+        member->Accept(this);
+    }
+  }
+
+  void WriteUnsigned(uint64_t value) {
+    while (value >= 0x80) {
+      output_->AppendData(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    output_->AppendData(static_cast<uint8_t>(value));
+  }
+
+  void WriteSigned(int64_t value) { WriteUnsigned(ZigZagEncode(value)); }
+
+  void Visit(const char* name, bool value) override {
+    WriteMember(name, RTCStatsMemberInterface::kBool);
+    WriteBool(value);
+  }
+  void Visit(const char* name, int32_t value) override {
+    WriteMember(name, RTCStatsMemberInterface::kInt32);
+    WriteSigned(value);
+  }
+  void Visit(const char* name, uint32_t value) override {
+    WriteMember(name, RTCStatsMemberInterface::kUint32);
+    WriteUnsigned(value);
+  }
+  void Visit(const char* name, int64_t value) override {
+    WriteMember(name, RTCStatsMemberInterface::kInt64);
+    WriteSigned(value);
+  }
+  void Visit(const char* name, uint64_t value) override {
+    WriteMember(name, RTCStatsMemberInterface::kUint64);
+    WriteUnsigned(value);
+  }
+  void Visit(const char* name, double value) override {
+    WriteMember(name, RTCStatsMemberInterface::kDouble);
+    WriteDouble(value);
+  }
+  void Visit(const char* name, const std::string& value) override {
+    WriteMember(name, RTCStatsMemberInterface::kString);
+    WriteString(value);
+  }
+  void Visit(const char* name, const std::vector<bool>& value) override {
+    WriteMember(name, RTCStatsMemberInterface::kSequenceBool);
+    WriteUnsigned(value.size());
+    for (bool element : value)
+      WriteBool(element);
+  }
+  void Visit(const char* name, const std::vector<int32_t>& value) override {
+    WriteMember(name, RTCStatsMemberInterface::kSequenceInt32);
+    WriteUnsigned(value.size());
+    for (int32_t element : value)
+      WriteSigned(element);
+  }
+  void Visit(const char* name, const std::vector<uint32_t>& value) override {
+    WriteMember(name, RTCStatsMemberInterface::kSequenceUint32);
+    WriteUnsigned(value.size());
+    for (uint32_t element : value)
+      WriteUnsigned(element);
+  }
+  void Visit(const char* name, const std::vector<int64_t>& value) override {
+    WriteMember(name, RTCStatsMemberInterface::kSequenceInt64);
+    WriteUnsigned(value.size());
+    for (int64_t element : value)
+      WriteSigned(element);
+  }
+  void Visit(const char* name, const std::vector<uint64_t>& value) override {
+    WriteMember(name, RTCStatsMemberInterface::kSequenceUint64);
+    WriteUnsigned(value.size());
+    for (uint64_t element : value)
+      WriteUnsigned(element);
+  }
+  void Visit(const char* name, const std::vector<double>& value) override {
+    WriteMember(name, RTCStatsMemberInterface::kSequenceDouble);
+    WriteUnsigned(value.size());
+    for (double element : value)
+      WriteDouble(element);
+  }
+  void Visit(const char* name,
+             const std::vector<std::string>& value) override {
+    WriteMember(name, RTCStatsMemberInterface::kSequenceString);
+    WriteUnsigned(value.size());
+    for (const std::string& element : value)
+      WriteString(element);
+  }
+
+ private:
+  void WriteMember(const char* name, RTCStatsMemberInterface::Type type) {
+    WriteString(name);
+    output_->AppendData(static_cast<uint8_t>(type));
+  }
+
+  void WriteBool(bool value) {
+    output_->AppendData(static_cast<uint8_t>(value ? 1 : 0));
+  }
+
+  void WriteDouble(double value) {
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value), "");
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i)
+      output_->AppendData(static_cast<uint8_t>(bits >> (8 * i)));
+  }
+
+  void WriteString(const char* value) {
+    const size_t size = strlen(value);
+    WriteUnsigned(size);
+    output_->AppendData(reinterpret_cast<const uint8_t*>(value), size);
+  }
+
+  void WriteString(const std::string& value) {
+    WriteUnsigned(value.size());
+    output_->AppendData(reinterpret_cast<const uint8_t*>(value.data()),
+                        value.size());
+  }
+
+  rtc::Buffer* const output_;
+};
+
+class BinaryReader {
+ public:
+  BinaryReader(rtc::ArrayView<const uint8_t> data,
+               RTCStatsReportVisitor* visitor)
+      : data_(data), visitor_(visitor) {}
+
+  bool ReadReports() {
+    while (position_ < data_.size()) {
+      if (!ReadReport())
+        return false;
+    }
+    return true;
+  }
+
+ private:
+  bool ReadReport() {
+    if (data_.size() - position_ < sizeof(kMagic) ||
+        memcmp(data_.data() + position_, kMagic, sizeof(kMagic)) != 0) {
+      return false;
+    }
+    position_ += sizeof(kMagic);
+    int64_t timestamp_us;
+    uint64_t num_stats;
+    if (!ReadSigned(&timestamp_us) || !ReadUnsigned(&num_stats))
+      return false;
+    visitor_->OnReport(timestamp_us);
+    for (uint64_t i = 0; i < num_stats; ++i) {
+      if (!ReadStats())
+        return false;
+    }
+    return true;
+  }
+
+  bool ReadStats() {
+    std::string type;
+    std::string id;
+    int64_t timestamp_us;
+    uint64_t num_members;
+    if (!ReadString(&type) || !ReadString(&id) || !ReadSigned(&timestamp_us) ||
+        !ReadUnsigned(&num_members)) {
+      return false;
+    }
+    visitor_->OnStats(type, id, timestamp_us);
+    for (uint64_t i = 0; i < num_members; ++i) {
+      if (!ReadMember())
+        return false;
+    }
+    return true;
+  }
+
+  bool ReadMember() {
+    std::string name;
+    uint8_t type;
+    if (!ReadString(&name) || !ReadByte(&type))
+      return false;
+    switch (type) {
+      case RTCStatsMemberInterface::kBool: {
+        bool value;
+        return ReadBool(&value) && Visit(name, value);
+      }
+      case RTCStatsMemberInterface::kInt32: {
+        int32_t value;
+        return ReadInt32(&value) && Visit(name, value);
+      }
+      case RTCStatsMemberInterface::kUint32: {
+        uint32_t value;
+        return ReadUint32(&value) && Visit(name, value);
+      }
+      case RTCStatsMemberInterface::kInt64: {
+        int64_t value;
+        return ReadSigned(&value) && Visit(name, value);
+      }
+      case RTCStatsMemberInterface::kUint64: {
+        uint64_t value;
+        return ReadUnsigned(&value) && Visit(name, value);
+      }
+      case RTCStatsMemberInterface::kDouble: {
+        double value;
+        return ReadDouble(&value) && Visit(name, value);
+      }
+      case RTCStatsMemberInterface::kString: {
+        std::string value;
+        return ReadString(&value) && Visit(name, value);
+      }
+      case RTCStatsMemberInterface::kSequenceBool:
+        return ReadSequence<bool>(name, &BinaryReader::ReadBool);
+      case RTCStatsMemberInterface::kSequenceInt32:
+        return ReadSequence<int32_t>(name, &BinaryReader::ReadInt32);
+      case RTCStatsMemberInterface::kSequenceUint32:
+        return ReadSequence<uint32_t>(name, &BinaryReader::ReadUint32);
+      case RTCStatsMemberInterface::kSequenceInt64:
+        return ReadSequence<int64_t>(name, &BinaryReader::ReadSigned);
+      case RTCStatsMemberInterface::kSequenceUint64:
+        return ReadSequence<uint64_t>(name, &BinaryReader::ReadUnsigned);
+      case RTCStatsMemberInterface::kSequenceDouble:
+        return ReadSequence<double>(name, &BinaryReader::ReadDouble);
+      case RTCStatsMemberInterface::kSequenceString:
+        return ReadSequence<std::string>(name, &BinaryReader::ReadString);
+    }
+    return false;
+  }
+
+  template <typename T>
+  bool Visit(const std::string& name, const T& value) {
+    visitor_->Visit(name.c_str(), value);
+    return true;
+  }
+
+  template <typename T>
+  bool ReadSequence(const std::string& name,
+                    bool (BinaryReader::*read_element)(T*)) {
+    uint64_t size;
+    // Every element takes at least one byte.
+    if (!ReadUnsigned(&size) || size > data_.size() - position_)
+      return false;
+    std::vector<T> value;
+    value.reserve(size);
+    for (uint64_t i = 0; i < size; ++i) {
+      T element;
+      if (!(this->*read_element)(&element))
+        return false;
+      value.push_back(std::move(element));
+    }
+    return Visit(name, value);
+  }
+
+  bool ReadByte(uint8_t* value) {
+    if (position_ == data_.size())
+      return false;
+    *value = data_[position_++];
+    return true;
+  }
+
+  bool ReadBool(bool* value) {
+    uint8_t byte;
+    if (!ReadByte(&byte) || byte > 1)
+      return false;
+    *value = byte == 1;
+    return true;
+  }
+
+  bool ReadUnsigned(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadSigned(int64_t* value) {
+    uint64_t encoded;
+    if (!ReadUnsigned(&encoded))
+      return false;
+    *value = ZigZagDecode(encoded);
+    return true;
+  }
+
+  bool ReadInt32(int32_t* value) {
+    int64_t value64;
+    if (!ReadSigned(&value64) ||
+        value64 < std::numeric_limits<int32_t>::min() ||
+        value64 > std::numeric_limits<int32_t>::max()) {
+      return false;
+    }
+    *value = static_cast<int32_t>(value64);
+    return true;
+  }
+
+  bool ReadUint32(uint32_t* value) {
+    uint64_t value64;
+    if (!ReadUnsigned(&value64) ||
+        value64 > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    *value = static_cast<uint32_t>(value64);
+    return true;
+  }
+
+  bool ReadDouble(double* value) {
+    if (data_.size() - position_ < 8)
+      return false;
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i)
+      bits |= static_cast<uint64_t>(data_[position_++]) << (8 * i);
+    memcpy(value, &bits, sizeof(bits));
+    return true;
+  }
+
+  bool ReadString(std::string* value) {
+    uint64_t size;
+    if (!ReadUnsigned(&size) || size > data_.size() - position_)
+      return false;
+    value->assign(reinterpret_cast<const char*>(data_.data() + position_),
+                  size);
+    position_ += size;
+    return true;
+  }
+
+  const rtc::ArrayView<const uint8_t> data_;
+  RTCStatsReportVisitor* const visitor_;
+  size_t position_ = 0;
+};
+
+}  // namespace
+
+void RTCStatsReport::AppendBinary(rtc::Buffer* output) const {
+  RTC_DCHECK(output);
+  BinaryWriter writer(output);
+  output->AppendData(kMagic);
+  writer.WriteSigned(timestamp_us_);
+  writer.WriteUnsigned(stats_.size());
+  for (const auto& stats : stats_)
+    writer.WriteStats(*stats.second);
+}
+
+bool ReadRTCStatsReportsBinary(rtc::ArrayView<const uint8_t> data,
+                               RTCStatsReportVisitor* visitor) {
+  RTC_DCHECK(visitor);
+  return BinaryReader(data, visitor).ReadReports();
+}
+
+}  // namespace webrtc
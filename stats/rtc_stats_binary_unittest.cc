@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtc_stats_binary.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/stats/rtc_stats_report.h"
+#include "rtc_base/buffer.h"
+#include "stats/test/rtc_test_stats.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Records what it visits as lines of text, using the string representation of
+// |RTCStatsMember| for the values.
+class RecordingVisitor : public RTCStatsReportVisitor {
+ public:
+  void OnReport(int64_t timestamp_us) override {
+    lines.push_back("report " + std::to_string(timestamp_us));
+  }
+  void OnStats(const std::string& type,
+               const std::string& id,
+               int64_t timestamp_us) override {
+    lines.push_back(type + " " + id + " " + std::to_string(timestamp_us));
+  }
+
+  void Visit(const char* name, bool value) override { Record(name, value); }
+  void Visit(const char* name, int32_t value) override { Record(name, value); }
+  void Visit(const char* name, uint32_t value) override { Record(name, value); }
+  void Visit(const char* name, int64_t value) override { Record(name, value); }
+  void Visit(const char* name, uint64_t value) override { Record(name, value); }
+  void Visit(const char* name, double value) override { Record(name, value); }
+  void Visit(const char* name, const std::string& value) override {
+    Record(name, value);
+  }
+  void Visit(const char* name, const std::vector<bool>& value) override {
+    Record(name, value);
+  }
+  void Visit(const char* name, const std::vector<int32_t>& value) override {
+    Record(name, value);
+  }
+  void Visit(const char* name, const std::vector<uint32_t>& value) override {
+    Record(name, value);
+  }
+  void Visit(const char* name, const std::vector<int64_t>& value) override {
+    Record(name, value);
+  }
+  void Visit(const char* name, const std::vector<uint64_t>& value) override {
+    Record(name, value);
+  }
+  void Visit(const char* name, const std::vector<double>& value) override {
+    Record(name, value);
+  }
+  void Visit(const char* name,
+             const std::vector<std::string>& value) override {
+    Record(name, value);
+  }
+
+  std::vector<std::string> lines;
+
+ private:
+  template <typename T>
+  void Record(const char* name, const T& value) {
+    lines.push_back(std::string(name) + "=" +
+                    RTCStatsMember<T>(name, value).ValueToString());
+  }
+};
+
+TEST(RTCStatsBinaryTest, ReadsBackAllMemberTypes) {
+  std::unique_ptr<RTCTestStats> stats(new RTCTestStats("id", -12));
+  stats->m_bool = true;
+  stats->m_int32 = std::numeric_limits<int32_t>::min();
+  stats->m_uint32 = std::numeric_limits<uint32_t>::max();
+  stats->m_int64 = -4242424242424242;
+  stats->m_uint64 = std::numeric_limits<uint64_t>::max();
+  stats->m_double = 0.25;
+  stats->m_string = "string";
+  stats->m_sequence_bool = std::vector<bool>{true, false};
+  stats->m_sequence_int32 = std::vector<int32_t>{-1, 300};
+  stats->m_sequence_uint32 = std::vector<uint32_t>{};
+  stats->m_sequence_int64 = std::vector<int64_t>{-42};
+  stats->m_sequence_uint64 = std::vector<uint64_t>{1, 128};
+  stats->m_sequence_double = std::vector<double>{-1.5};
+  stats->m_sequence_string = std::vector<std::string>{"a", ""};
+
+  RecordingVisitor expected;
+  expected.OnReport(1337);
+  expected.OnStats(stats->type(), stats->id(), stats->timestamp_us());
+  for (const RTCStatsMemberInterface* member : stats->Members()) {
+    expected.lines.push_back(std::string(member->name()) + "=" +
+                             member->ValueToString());
+  }
+
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1337);
+  report->AddStats(std::move(stats));
+  rtc::Buffer buffer;
+  report->AppendBinary(&buffer);
+
+  RecordingVisitor visitor;
+  EXPECT_TRUE(ReadRTCStatsReportsBinary(buffer, &visitor));
+  EXPECT_EQ(visitor.lines, expected.lines);
+}
+
+TEST(RTCStatsBinaryTest, SkipsUndefinedMembersAndReadsAppendedReports) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1);
+  std::unique_ptr<RTCTestStats> stats(new RTCTestStats("id", 2));
+  stats->m_uint32 = 3;
+  report->AddStats(std::move(stats));
+  rtc::Buffer buffer;
+  report->AppendBinary(&buffer);
+  RTCStatsReport::Create(4)->AppendBinary(&buffer);
+
+  RecordingVisitor visitor;
+  EXPECT_TRUE(ReadRTCStatsReportsBinary(buffer, &visitor));
+  EXPECT_THAT(visitor.lines, ElementsAre("report 1", "test-stats id 2",
+                                         "mUint32=3", "report 4"));
+}
+
+TEST(RTCStatsBinaryTest, FailsOnTruncatedData) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1);
+  std::unique_ptr<RTCTestStats> stats(new RTCTestStats("id", 2));
+  stats->m_string = "string";
+  report->AddStats(std::move(stats));
+  rtc::Buffer buffer;
+  report->AppendBinary(&buffer);
+
+  for (size_t size = 1; size < buffer.size(); ++size) {
+    RecordingVisitor visitor;
+    EXPECT_FALSE(ReadRTCStatsReportsBinary(
+        rtc::ArrayView<const uint8_t>(buffer.data(), size), &visitor));
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -915,7 +915,21 @@ WEBRTC_RTCSTATS_IMPL(RTCTransportStats, RTCStats, "transport",
     &tls_version,
     &dtls_cipher,
     &srtp_cipher,
-    &selected_candidate_pair_changes)
+    &selected_candidate_pair_changes,
+    &bwe_estimates,
+    &bwe_dropped_packets,
+    &bwe_inference_time_p50,
+    &bwe_inference_time_p99,
+    &bwe_pending_packets_p50,
+    &bwe_pending_packets_p99,
+    &bwe_estimate,
+    &bwe_model_ready,
+    &bwe_model_version,
+    &bwe_remote_estimate,
+    &bwe_remote_estimate_age,
+    &bwe_remote_estimate_interval,
+    &bwe_target_bitrate,
+    &bwe_shadow_gcc_estimate)
 // clang-format on
 
 RTCTransportStats::RTCTransportStats(const std::string& id,
@@ -934,7 +948,21 @@ RTCTransportStats::RTCTransportStats(std::string&& id, int64_t timestamp_us)
       tls_version("tlsVersion"),
       dtls_cipher("dtlsCipher"),
       srtp_cipher("srtpCipher"),
-      selected_candidate_pair_changes("selectedCandidatePairChanges") {}
+      selected_candidate_pair_changes("selectedCandidatePairChanges"),
+      bwe_estimates("bweEstimates"),
+      bwe_dropped_packets("bweDroppedPackets"),
+      bwe_inference_time_p50("bweInferenceTimeP50"),
+      bwe_inference_time_p99("bweInferenceTimeP99"),
+      bwe_pending_packets_p50("bwePendingPacketsP50"),
+      bwe_pending_packets_p99("bwePendingPacketsP99"),
+      bwe_estimate("bweEstimate"),
+      bwe_model_ready("bweModelReady"),
+      bwe_model_version("bweModelVersion"),
+      bwe_remote_estimate("bweRemoteEstimate"),
+      bwe_remote_estimate_age("bweRemoteEstimateAge"),
+      bwe_remote_estimate_interval("bweRemoteEstimateInterval"),
+      bwe_target_bitrate("bweTargetBitrate"),
+      bwe_shadow_gcc_estimate("bweShadowGccEstimate") {}
 
 RTCTransportStats::RTCTransportStats(const RTCTransportStats& other)
     : RTCStats(other.id(), other.timestamp_us()),
@@ -948,7 +976,21 @@ RTCTransportStats::RTCTransportStats(const RTCTransportStats& other)
       tls_version(other.tls_version),
       dtls_cipher(other.dtls_cipher),
       srtp_cipher(other.srtp_cipher),
-      selected_candidate_pair_changes(other.selected_candidate_pair_changes) {}
+      selected_candidate_pair_changes(other.selected_candidate_pair_changes),
+      bwe_estimates(other.bwe_estimates),
+      bwe_dropped_packets(other.bwe_dropped_packets),
+      bwe_inference_time_p50(other.bwe_inference_time_p50),
+      bwe_inference_time_p99(other.bwe_inference_time_p99),
+      bwe_pending_packets_p50(other.bwe_pending_packets_p50),
+      bwe_pending_packets_p99(other.bwe_pending_packets_p99),
+      bwe_estimate(other.bwe_estimate),
+      bwe_model_ready(other.bwe_model_ready),
+      bwe_model_version(other.bwe_model_version),
+      bwe_remote_estimate(other.bwe_remote_estimate),
+      bwe_remote_estimate_age(other.bwe_remote_estimate_age),
+      bwe_remote_estimate_interval(other.bwe_remote_estimate_interval),
+      bwe_target_bitrate(other.bwe_target_bitrate),
+      bwe_shadow_gcc_estimate(other.bwe_shadow_gcc_estimate) {}
 
 RTCTransportStats::~RTCTransportStats() {}
 
@@ -38,6 +38,9 @@ class RTC_EXPORT Clock {
   }
   virtual int64_t TimeInMilliseconds() { return CurrentTime().ms(); }
   virtual int64_t TimeInMicroseconds() { return CurrentTime().us(); }
+  // Like TimeInMilliseconds(), but the real-time clock returns the time the
+  // current event of the thread started at, see rtc::ScopedTimeSnapshot.
+  virtual int64_t CoarseTimeInMilliseconds() { return TimeInMilliseconds(); }
 
   // Retrieve an NTP absolute timestamp.
   virtual NtpTime CurrentNtpTime() = 0;
@@ -18,7 +18,8 @@ extern "C" {
 #endif
 
 // List of features in x86.
-typedef enum { kSSE2, kSSE3 } CPUFeature;
+// kAVX512 is the AVX-512 foundation subset, AVX-512F.
+typedef enum { kSSE2, kSSE3, kAVX2, kAVX512, kFMA3 } CPUFeature;
 
 // List of features in ARM.
 enum {
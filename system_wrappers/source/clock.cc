@@ -39,6 +39,10 @@ class RealTimeClock : public Clock {
   // source is fixed for this clock.
   int64_t TimeInMilliseconds() override { return rtc::TimeMillis(); }
 
+  int64_t CoarseTimeInMilliseconds() override {
+    return rtc::CoarseTimeMillis();
+  }
+
   // Return a timestamp in microseconds relative to some arbitrary source; the
   // source is fixed for this clock.
   int64_t TimeInMicroseconds() override { return rtc::TimeMicros(); }
@@ -11,8 +11,10 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 #include "absl/strings/string_view.h"
 #include "rtc_base/checks.h"
@@ -29,6 +31,39 @@ static const char* trials_init_string = NULL;
 #ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 namespace {
 constexpr char kPersistentStringSeparator = '/';
+
+// The trials of |trials_init_string|, parsed once when it is set, so that
+// FindFullName() is a hash lookup instead of a scan of the whole string.
+struct ParsedFieldTrials {
+  std::unordered_map<std::string, std::string> groups;
+  // The trials replaced by these ones. They are never deleted: only tests
+  // replace the trials, and threads they left running may still read them.
+  const ParsedFieldTrials* previous = nullptr;
+};
+std::atomic<const ParsedFieldTrials*> parsed_trials{nullptr};
+
+// Like FindFullName() used to, stops at the first invalid item and keeps the
+// first group of a trial given twice.
+ParsedFieldTrials* ParseFieldTrials(const absl::string_view trials) {
+  ParsedFieldTrials* parsed = new ParsedFieldTrials();
+  size_t next_item = 0;
+  while (next_item < trials.length()) {
+    size_t name_end = trials.find(kPersistentStringSeparator, next_item);
+    if (name_end == trials.npos || name_end == next_item)
+      break;
+    size_t group_name_end =
+        trials.find(kPersistentStringSeparator, name_end + 1);
+    if (group_name_end == trials.npos || group_name_end == name_end + 1)
+      break;
+    parsed->groups.emplace(
+        std::string(trials.substr(next_item, name_end - next_item)),
+        std::string(
+            trials.substr(name_end + 1, group_name_end - name_end - 1)));
+    next_item = group_name_end + 1;
+  }
+  return parsed;
+}
+
 // Validates the given field trial string.
 //  E.g.:
 //    "WebRTC-experimentFoo/Enabled/WebRTC-experimentBar/Enabled100kbps/"
@@ -103,35 +138,13 @@ std::string MergeFieldTrialsStrings(const char* first, const char* second) {
 }
 
 std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
-    return std::string();
-
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
+  const ParsedFieldTrials* trials =
+      parsed_trials.load(std::memory_order_acquire);
+  if (trials == nullptr)
     return std::string();
 
-  size_t next_item = 0;
-  while (next_item < trials_string.length()) {
-    // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
-      break;
-    size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
-        field_value_end == field_name_end + 1)
-      break;
-    std::string field_name(trials_string, next_item,
-                           field_name_end - next_item);
-    std::string field_value(trials_string, field_name_end + 1,
-                            field_value_end - field_name_end - 1);
-    next_item = field_value_end + 1;
-
-    if (name == field_name)
-      return field_value;
-  }
-  return std::string();
+  const auto it = trials->groups.find(name);
+  return it == trials->groups.end() ? std::string() : it->second;
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
@@ -143,6 +156,11 @@ void InitFieldTrialsFromString(const char* trials_string) {
     RTC_DCHECK(FieldTrialsStringIsValidInternal(trials_string))
         << "Invalid field trials string:" << trials_string;
   };
+  // Parsed even without trials, to keep the previous ones reachable.
+  ParsedFieldTrials* trials = ParseFieldTrials(trials_string ? trials_string
+                                                             : "");
+  trials->previous = parsed_trials.load(std::memory_order_relaxed);
+  parsed_trials.store(trials, std::memory_order_release);
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
   trials_init_string = trials_string;
 }
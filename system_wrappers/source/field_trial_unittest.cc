@@ -103,5 +103,25 @@ TEST(FieldTrialMergingTest, HandlesEmptyInput) {
 #endif  // GTEST_HAS_DEATH_TEST && RTC_DCHECK_IS_ON && !defined(WEBRTC_ANDROID)
         // && !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
 
+#if !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+TEST(FieldTrialTest, FindsTheGroupsOfTheCurrentString) {
+  const char* const previous_trials = GetFieldTrialString();
+  InitFieldTrialsFromString("Audio/Enabled/Video/Disabled100kbps/");
+  EXPECT_EQ(FindFullName("Audio"), "Enabled");
+  EXPECT_EQ(FindFullName("Video"), "Disabled100kbps");
+  EXPECT_EQ(FindFullName("Vid"), "");
+  EXPECT_TRUE(IsEnabled("Audio"));
+  EXPECT_TRUE(IsDisabled("Video"));
+
+  InitFieldTrialsFromString("Video/Enabled/");
+  EXPECT_EQ(FindFullName("Audio"), "");
+  EXPECT_EQ(FindFullName("Video"), "Enabled");
+
+  InitFieldTrialsFromString(nullptr);
+  EXPECT_EQ(FindFullName("Video"), "");
+  InitFieldTrialsFromString(previous_trials);
+}
+#endif  // !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+
 }  // namespace field_trial
 }  // namespace webrtc
@@ -9,7 +9,10 @@
 
 #include "system_wrappers/include/metrics.h"
 
+#include <stdint.h>
+
 #include <algorithm>
+#include <atomic>
 
 #include "rtc_base/critical_section.h"
 #include "rtc_base/thread_annotations.h"
@@ -27,77 +30,149 @@ namespace {
 // linearly/exponentially spaced buckets) if samples are logged more frequently.
 const int kMaxSampleMapSize = 300;
 
+// The samples are counted in an open addressing hash table of atomic slots,
+// so that adding one takes no lock even with many threads adding to the same
+// histogram. A slot packs a sample value, in the high 32 bits, with its count,
+// in the low 32 bits, and is zero while free: its value and count are always
+// updated together by a compare and swap. Freeing the slots on a reset may
+// break a probe sequence, so that a concurrent Add() of a value moves it to
+// another slot; the readers sum the slots of each value.
+constexpr int kSlotBits = 9;
+constexpr size_t kNumSlots = size_t{1} << kSlotBits;
+static_assert(kNumSlots > kMaxSampleMapSize, "");
+
+uint64_t MakeSlot(int sample, uint32_t count) {
+  return (uint64_t{static_cast<uint32_t>(sample)} << 32) | count;
+}
+
+int SlotSample(uint64_t slot) {
+  return static_cast<int32_t>(static_cast<uint32_t>(slot >> 32));
+}
+
+int SlotCount(uint64_t slot) {
+  return static_cast<int>(static_cast<uint32_t>(slot));
+}
+
+size_t SlotIndex(int sample) {
+  // Fibonacci hashing, the samples are often consecutive values.
+  return (static_cast<uint32_t>(sample) * 2654435769u) >> (32 - kSlotBits);
+}
+
 class RtcHistogram {
  public:
   RtcHistogram(const std::string& name, int min, int max, int bucket_count)
-      : min_(min), max_(max), info_(name, min, max, bucket_count) {
+      : min_(min),
+        max_(max),
+        name_(name),
+        bucket_count_(bucket_count),
+        slots_(new std::atomic<uint64_t>[kNumSlots]) {
     RTC_DCHECK_GT(bucket_count, 0);
+    for (size_t i = 0; i < kNumSlots; ++i)
+      slots_[i].store(0, std::memory_order_relaxed);
   }
 
   void Add(int sample) {
     sample = std::min(sample, max_);
     sample = std::max(sample, min_ - 1);  // Underflow bucket.
 
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.size() == kMaxSampleMapSize &&
-        info_.samples.find(sample) == info_.samples.end()) {
-      return;
+    size_t index = SlotIndex(sample);
+    for (size_t probe = 0; probe < kNumSlots; ++probe) {
+      std::atomic<uint64_t>& slot = slots_[index];
+      uint64_t value = slot.load(std::memory_order_relaxed);
+      while (true) {
+        if (value == 0) {
+          // A new value, within the limit of the number of values.
+          if (num_values_.fetch_add(1, std::memory_order_relaxed) >=
+              kMaxSampleMapSize) {
+            num_values_.fetch_sub(1, std::memory_order_relaxed);
+            return;
+          }
+          if (slot.compare_exchange_weak(value, MakeSlot(sample, 1),
+                                         std::memory_order_relaxed)) {
+            return;
+          }
+          num_values_.fetch_sub(1, std::memory_order_relaxed);
+          continue;
+        }
+        if (SlotSample(value) != sample)
+          break;
+        if (slot.compare_exchange_weak(value, value + 1,
+                                       std::memory_order_relaxed)) {
+          return;
+        }
+      }
+      index = (index + 1) % kNumSlots;
     }
-    ++info_.samples[sample];
   }
 
   // Returns a copy (or nullptr if there are no samples) and clears samples.
   std::unique_ptr<SampleInfo> GetAndReset() {
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.empty())
+    std::unique_ptr<SampleInfo> copy(
+        new SampleInfo(name_, min_, max_, bucket_count_));
+    TakeSamples(&copy->samples);
+    if (copy->samples.empty())
       return nullptr;
-
-    SampleInfo* copy =
-        new SampleInfo(info_.name, info_.min, info_.max, info_.bucket_count);
-
-    std::swap(info_.samples, copy->samples);
-
-    return std::unique_ptr<SampleInfo>(copy);
+    return copy;
   }
 
-  const std::string& name() const { return info_.name; }
+  const std::string& name() const { return name_; }
 
   // Functions only for testing.
   void Reset() {
-    rtc::CritScope cs(&crit_);
-    info_.samples.clear();
+    std::map<int, int> samples;
+    TakeSamples(&samples);
   }
 
   int NumEvents(int sample) const {
-    rtc::CritScope cs(&crit_);
-    const auto it = info_.samples.find(sample);
-    return (it == info_.samples.end()) ? 0 : it->second;
+    const std::map<int, int> samples = Samples();
+    const auto it = samples.find(sample);
+    return (it == samples.end()) ? 0 : it->second;
   }
 
   int NumSamples() const {
     int num_samples = 0;
-    rtc::CritScope cs(&crit_);
-    for (const auto& sample : info_.samples) {
+    for (const auto& sample : Samples()) {
       num_samples += sample.second;
     }
     return num_samples;
   }
 
   int MinSample() const {
-    rtc::CritScope cs(&crit_);
-    return (info_.samples.empty()) ? -1 : info_.samples.begin()->first;
+    const std::map<int, int> samples = Samples();
+    return (samples.empty()) ? -1 : samples.begin()->first;
   }
 
   std::map<int, int> Samples() const {
-    rtc::CritScope cs(&crit_);
-    return info_.samples;
+    std::map<int, int> samples;
+    for (size_t i = 0; i < kNumSlots; ++i) {
+      const uint64_t value = slots_[i].load(std::memory_order_relaxed);
+      if (value != 0)
+        samples[SlotSample(value)] += SlotCount(value);
+    }
+    return samples;
   }
 
  private:
-  rtc::CriticalSection crit_;
+  // Frees every slot, adding its samples to |samples|. The samples added
+  // meanwhile are either taken or left for the next call, never lost.
+  void TakeSamples(std::map<int, int>* samples) {
+    for (size_t i = 0; i < kNumSlots; ++i) {
+      const uint64_t value = slots_[i].exchange(0, std::memory_order_relaxed);
+      if (value != 0) {
+        (*samples)[SlotSample(value)] += SlotCount(value);
+        num_values_.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
   const int min_;
   const int max_;
-  SampleInfo info_ RTC_GUARDED_BY(crit_);
+  const std::string name_;
+  const size_t bucket_count_;
+  const std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+  // Number of slots in use, the same value using several of them while a
+  // reset runs concurrently with Add().
+  std::atomic<int> num_values_{0};
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtcHistogram);
 };
@@ -12,8 +12,10 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
 #include "system_wrappers/include/metrics.h"
 #include "test/gtest.h"
 
@@ -164,5 +166,50 @@ TEST_F(MetricsDefaultTest, TestMinMaxBucket) {
   EXPECT_EQ(1u, histograms.begin()->second->samples.size());
 }
 
+TEST_F(MetricsDefaultTest, LimitsTheNumberOfValues) {
+  for (int i = 0; i < 400; ++i)
+    RTC_HISTOGRAM_COUNTS_1000("Histogram", i);
+  EXPECT_EQ(300, metrics::NumSamples("Histogram"));
+  // Values already stored are still counted.
+  RTC_HISTOGRAM_COUNTS_1000("Histogram", 5);
+  EXPECT_EQ(2, metrics::NumEvents("Histogram", 5));
+  RTC_HISTOGRAM_COUNTS_1000("Histogram", 999);
+  EXPECT_EQ(0, metrics::NumEvents("Histogram", 999));
+
+  // New values are stored again once the samples are taken.
+  std::map<std::string, std::unique_ptr<metrics::SampleInfo>> histograms;
+  metrics::GetAndReset(&histograms);
+  EXPECT_EQ(300u, histograms.begin()->second->samples.size());
+  RTC_HISTOGRAM_COUNTS_1000("Histogram", 999);
+  EXPECT_EQ(1, metrics::NumEvents("Histogram", 999));
+}
+
+TEST_F(MetricsDefaultTest, CountsConcurrentSamples) {
+  constexpr int kNumThreads = 4;
+  constexpr int kSamplesPerThread = 10000;
+  auto add_samples = [](void*) {
+    for (int i = 0; i < kSamplesPerThread; ++i)
+      RTC_HISTOGRAM_COUNTS_100("Concurrent", i % 10);
+  };
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        add_samples, nullptr, "MetricsThread"));
+    threads.back()->Start();
+  }
+  // Takes the samples while they are added, none may be lost.
+  int num_samples = 0;
+  std::map<std::string, std::unique_ptr<metrics::SampleInfo>> histograms;
+  for (int i = 0; i < 10; ++i) {
+    metrics::GetAndReset(&histograms);
+    num_samples += NumSamples("Concurrent", histograms);
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+  metrics::GetAndReset(&histograms);
+  num_samples += NumSamples("Concurrent", histograms);
+  EXPECT_EQ(kNumThreads * kSamplesPerThread, num_samples);
+}
+
 }  // namespace webrtc
 #endif
@@ -24,5 +24,17 @@ void FuzzOneInput(const uint8_t* data, size_t size) {
   std::unique_ptr<cricket::IceMessage> stun_msg(new cricket::IceMessage());
   rtc::ByteBufferReader buf(message, size);
   stun_msg->Read(&buf);
+
+  // The in place reader of the TURN relay paths.
+  cricket::StunMessageView view;
+  if (view.Parse(message, size)) {
+    rtc::ArrayView<const char> bytes;
+    view.GetBytes(cricket::STUN_ATTR_DATA, &bytes);
+    uint32_t value;
+    view.GetUInt32(cricket::STUN_ATTR_LIFETIME, &value);
+    rtc::SocketAddress address;
+    view.GetAddress(cricket::STUN_ATTR_MAPPED_ADDRESS, &address);
+    view.GetXorAddress(cricket::STUN_ATTR_XOR_PEER_ADDRESS, &address);
+  }
 }
 }  // namespace webrtc
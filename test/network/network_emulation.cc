@@ -20,43 +20,122 @@
 
 namespace webrtc {
 
+EmulatedPacketHandoff::EmulatedPacketHandoff(
+    rtc::TaskQueue* task_queue,
+    std::function<void(EmulatedIpPacket)> deliver)
+    : task_queue_(task_queue),
+      deliver_(std::move(deliver)),
+      pushed_packets_(nullptr) {}
+
+EmulatedPacketHandoff::~EmulatedPacketHandoff() {
+  PushedPacket* pushed_packet = pushed_packets_.exchange(nullptr);
+  while (pushed_packet) {
+    PushedPacket* next = pushed_packet->next;
+    delete pushed_packet;
+    pushed_packet = next;
+  }
+}
+
+void EmulatedPacketHandoff::Push(EmulatedIpPacket packet) {
+  PushedPacket* pushed_packet =
+      new PushedPacket{std::move(packet), pushed_packets_.load()};
+  while (!pushed_packets_.compare_exchange_weak(pushed_packet->next,
+                                                pushed_packet)) {
+  }
+  // The task posted for the first packet delivers the ones pushed after it.
+  if (pushed_packet->next)
+    return;
+  rtc::CritScope cs(&lock_);
+  if (stopped_)
+    return;
+  task_queue_->PostTask([this] {
+    RTC_DCHECK_RUN_ON(task_queue_);
+    Deliver();
+  });
+}
+
+void EmulatedPacketHandoff::Stop() {
+  rtc::CritScope cs(&lock_);
+  stopped_ = true;
+}
+
+void EmulatedPacketHandoff::Deliver() {
+  // Reverses the pushed packets into the order they were pushed in.
+  PushedPacket* pushed_packet = pushed_packets_.exchange(nullptr);
+  PushedPacket* first = nullptr;
+  while (pushed_packet) {
+    PushedPacket* next = pushed_packet->next;
+    pushed_packet->next = first;
+    first = pushed_packet;
+    pushed_packet = next;
+  }
+  while (first) {
+    std::unique_ptr<PushedPacket> delivered(first);
+    first = first->next;
+    deliver_(std::move(delivered->packet));
+  }
+}
+
+LinkEmulation::LinkEmulation(
+    Clock* clock,
+    rtc::TaskQueue* task_queue,
+    std::unique_ptr<NetworkBehaviorInterface> network_behavior,
+    EmulatedNetworkReceiverInterface* receiver)
+    : clock_(clock),
+      task_queue_(task_queue),
+      network_behavior_(std::move(network_behavior)),
+      receiver_(receiver),
+      handoff_(task_queue, [this](EmulatedIpPacket packet) {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        EnqueuePacket(std::move(packet));
+      }) {}
+
 void LinkEmulation::OnPacketReceived(EmulatedIpPacket packet) {
+  // The packets coming from the nodes of other task queues are handed over in
+  // batches.
+  if (!task_queue_->IsCurrent()) {
+    handoff_.Push(std::move(packet));
+    return;
+  }
   task_queue_->PostTask([this, packet = std::move(packet)]() mutable {
     RTC_DCHECK_RUN_ON(task_queue_);
-
-    uint64_t packet_id = next_packet_id_++;
-    bool sent = network_behavior_->EnqueuePacket(PacketInFlightInfo(
-        packet.ip_packet_size(), packet.arrival_time.us(), packet_id));
-    if (sent) {
-      packets_.emplace_back(StoredPacket{packet_id, std::move(packet), false});
-    }
-    if (process_task_.Running())
-      return;
-    absl::optional<int64_t> next_time_us =
-        network_behavior_->NextDeliveryTimeUs();
-    if (!next_time_us)
-      return;
-    Timestamp current_time = clock_->CurrentTime();
-    process_task_ = RepeatingTaskHandle::DelayedStart(
-        task_queue_->Get(),
-        std::max(TimeDelta::Zero(),
-                 Timestamp::Micros(*next_time_us) - current_time),
-        [this]() {
-          RTC_DCHECK_RUN_ON(task_queue_);
-          Timestamp current_time = clock_->CurrentTime();
-          Process(current_time);
-          absl::optional<int64_t> next_time_us =
-              network_behavior_->NextDeliveryTimeUs();
-          if (!next_time_us) {
-            process_task_.Stop();
-            return TimeDelta::Zero();  // This is ignored.
-          }
-          RTC_DCHECK_GE(*next_time_us, current_time.us());
-          return Timestamp::Micros(*next_time_us) - current_time;
-        });
+    EnqueuePacket(std::move(packet));
   });
 }
 
+void LinkEmulation::EnqueuePacket(EmulatedIpPacket packet) {
+  uint64_t packet_id = next_packet_id_++;
+  bool sent = network_behavior_->EnqueuePacket(PacketInFlightInfo(
+      packet.ip_packet_size(), packet.arrival_time.us(), packet_id));
+  if (sent) {
+    packets_.emplace_back(StoredPacket{packet_id, std::move(packet), false});
+  }
+  if (process_task_.Running())
+    return;
+  absl::optional<int64_t> next_time_us =
+      network_behavior_->NextDeliveryTimeUs();
+  if (!next_time_us)
+    return;
+  Timestamp current_time = clock_->CurrentTime();
+  process_task_ = RepeatingTaskHandle::DelayedStart(
+      task_queue_->Get(),
+      std::max(TimeDelta::Zero(),
+               Timestamp::Micros(*next_time_us) - current_time),
+      [this]() {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        Timestamp current_time = clock_->CurrentTime();
+        Process(current_time);
+        absl::optional<int64_t> next_time_us =
+            network_behavior_->NextDeliveryTimeUs();
+        if (!next_time_us) {
+          process_task_.Stop();
+          return TimeDelta::Zero();  // This is ignored.
+        }
+        RTC_DCHECK_GE(*next_time_us, current_time.us());
+        return Timestamp::Micros(*next_time_us) - current_time;
+      });
+}
+
 void LinkEmulation::Process(Timestamp at_time) {
   std::vector<PacketDeliveryInfo> delivery_infos =
       network_behavior_->DequeueDeliverablePackets(at_time.us());
@@ -160,8 +239,15 @@ void EmulatedNetworkNode::CreateRoute(
 
 void EmulatedNetworkNode::ClearRoute(const rtc::IPAddress& receiver_ip,
                                      std::vector<EmulatedNetworkNode*> nodes) {
-  for (EmulatedNetworkNode* node : nodes)
-    node->router()->RemoveReceiver(receiver_ip);
+  for (EmulatedNetworkNode* node : nodes) {
+    NetworkRouterNode* router = node->router();
+    if (router->task_queue()->IsCurrent()) {
+      router->RemoveReceiver(receiver_ip);
+    } else {
+      SendTask(RTC_FROM_HERE, router->task_queue()->Get(),
+               [&] { router->RemoveReceiver(receiver_ip); });
+    }
+  }
 }
 
 EmulatedNetworkNode::~EmulatedNetworkNode() = default;
@@ -179,7 +265,10 @@ EmulatedEndpointImpl::EmulatedEndpointImpl(uint64_t id,
       clock_(clock),
       task_queue_(task_queue),
       router_(task_queue_),
-      next_port_(kFirstEphemeralPort) {
+      next_port_(kFirstEphemeralPort),
+      handoff_(task_queue, [this](EmulatedIpPacket packet) {
+        OnPacketReceived(std::move(packet));
+      }) {
   constexpr int kIPv4NetworkPrefixLength = 24;
   constexpr int kIPv6NetworkPrefixLength = 64;
 
@@ -276,6 +365,10 @@ rtc::IPAddress EmulatedEndpointImpl::GetPeerLocalAddress() const {
 }
 
 void EmulatedEndpointImpl::OnPacketReceived(EmulatedIpPacket packet) {
+  if (!task_queue_->IsCurrent()) {
+    handoff_.Push(std::move(packet));
+    return;
+  }
   RTC_DCHECK_RUN_ON(task_queue_);
   RTC_CHECK(packet.to.ipaddr() == peer_local_addr_)
       << "Routing error: wrong destination endpoint. Packet.to.ipaddr()=: "
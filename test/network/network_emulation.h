@@ -11,8 +11,10 @@
 #ifndef TEST_NETWORK_NETWORK_EMULATION_H_
 #define TEST_NETWORK_NETWORK_EMULATION_H_
 
+#include <atomic>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -23,7 +25,9 @@
 #include "api/test/network_emulation_manager.h"
 #include "api/test/simulated_network.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/constructor_magic.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/network.h"
 #include "rtc_base/network_constants.h"
 #include "rtc_base/socket_address.h"
@@ -34,18 +38,46 @@
 
 namespace webrtc {
 
+// Hands the packets received on other task queues over to |task_queue|, where
+// they are passed to |deliver| in the order they were pushed. The packets are
+// pushed onto a lock free list and a task is only posted when the list was
+// empty, so a burst of packets crossing over costs a single task.
+class EmulatedPacketHandoff {
+ public:
+  EmulatedPacketHandoff(rtc::TaskQueue* task_queue,
+                        std::function<void(EmulatedIpPacket)> deliver);
+  ~EmulatedPacketHandoff();
+  RTC_DISALLOW_COPY_AND_ASSIGN(EmulatedPacketHandoff);
+
+  void Push(EmulatedIpPacket packet);
+  // Drops the packets pushed from now on instead of posting tasks, so that
+  // the task queues can be destroyed in any order.
+  void Stop();
+
+ private:
+  struct PushedPacket {
+    EmulatedIpPacket packet;
+    PushedPacket* next;
+  };
+  void Deliver() RTC_RUN_ON(task_queue_);
+
+  rtc::TaskQueue* const task_queue_;
+  const std::function<void(EmulatedIpPacket)> deliver_;
+  // Last pushed packet, linked to the ones pushed before it.
+  std::atomic<PushedPacket*> pushed_packets_;
+  rtc::CriticalSection lock_;
+  bool stopped_ RTC_GUARDED_BY(lock_) = false;
+};
 
 class LinkEmulation : public EmulatedNetworkReceiverInterface {
  public:
   LinkEmulation(Clock* clock,
                 rtc::TaskQueue* task_queue,
                 std::unique_ptr<NetworkBehaviorInterface> network_behavior,
-                EmulatedNetworkReceiverInterface* receiver)
-      : clock_(clock),
-        task_queue_(task_queue),
-        network_behavior_(std::move(network_behavior)),
-        receiver_(receiver) {}
+                EmulatedNetworkReceiverInterface* receiver);
+  // May be called on any task queue.
   void OnPacketReceived(EmulatedIpPacket packet) override;
+  void Stop() { handoff_.Stop(); }
 
  private:
   struct StoredPacket {
@@ -53,6 +85,7 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
     EmulatedIpPacket packet;
     bool removed;
   };
+  void EnqueuePacket(EmulatedIpPacket packet) RTC_RUN_ON(task_queue_);
   void Process(Timestamp at_time) RTC_RUN_ON(task_queue_);
 
   Clock* const clock_;
@@ -63,6 +96,7 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
   RepeatingTaskHandle process_task_ RTC_GUARDED_BY(task_queue_);
   std::deque<StoredPacket> packets_ RTC_GUARDED_BY(task_queue_);
   uint64_t next_packet_id_ RTC_GUARDED_BY(task_queue_) = 1;
+  EmulatedPacketHandoff handoff_;
 };
 
 class NetworkRouterNode : public EmulatedNetworkReceiverInterface {
@@ -76,6 +110,8 @@ class NetworkRouterNode : public EmulatedNetworkReceiverInterface {
   void SetWatcher(std::function<void(const EmulatedIpPacket&)> watcher);
   void SetFilter(std::function<bool(const EmulatedIpPacket&)> filter);
 
+  rtc::TaskQueue* task_queue() const { return task_queue_; }
+
  private:
   rtc::TaskQueue* const task_queue_;
   std::map<rtc::IPAddress, EmulatedNetworkReceiverInterface*> routing_
@@ -152,8 +188,10 @@ class EmulatedEndpointImpl : public EmulatedEndpoint {
 
   rtc::IPAddress GetPeerLocalAddress() const override;
 
-  // Will be called to deliver packet into endpoint from network node.
+  // Will be called to deliver packet into endpoint from network node, on any
+  // task queue.
   void OnPacketReceived(EmulatedIpPacket packet) override;
+  void Stop() { handoff_.Stop(); }
 
   void Enable();
   void Disable();
@@ -186,6 +224,7 @@ class EmulatedEndpointImpl : public EmulatedEndpoint {
       RTC_GUARDED_BY(receiver_lock_);
 
   EmulatedNetworkStats stats_ RTC_GUARDED_BY(task_queue_);
+  EmulatedPacketHandoff handoff_;
 };
 
 class EmulatedRoute {
@@ -44,18 +44,43 @@ std::unique_ptr<TimeController> CreateTimeController(TimeMode mode) {
 }  // namespace
 
 NetworkEmulationManagerImpl::NetworkEmulationManagerImpl(TimeMode mode)
+    : NetworkEmulationManagerImpl(mode, /*num_shards=*/1) {}
+
+NetworkEmulationManagerImpl::NetworkEmulationManagerImpl(TimeMode mode,
+                                                         size_t num_shards)
     : time_controller_(CreateTimeController(mode)),
       clock_(time_controller_->GetClock()),
       next_node_id_(1),
       next_ip4_address_(kMinIPv4Address),
       task_queue_(time_controller_->GetTaskQueueFactory()->CreateTaskQueue(
           "NetworkEmulation",
-          TaskQueueFactory::Priority::NORMAL)) {}
+          TaskQueueFactory::Priority::NORMAL)) {
+  RTC_CHECK_GE(num_shards, 1);
+  for (size_t i = 1; i < num_shards; ++i) {
+    shards_.push_back(std::make_unique<TaskQueueForTest>(
+        time_controller_->GetTaskQueueFactory()->CreateTaskQueue(
+            "NetworkEmulationShard" + std::to_string(i),
+            TaskQueueFactory::Priority::NORMAL)));
+  }
+}
 
 // TODO(srte): Ensure that any pending task that must be run for consistency
 // (such as stats collection tasks) are not cancelled when the task queue is
 // destroyed.
-NetworkEmulationManagerImpl::~NetworkEmulationManagerImpl() = default;
+NetworkEmulationManagerImpl::~NetworkEmulationManagerImpl() {
+  if (shards_.empty())
+    return;
+  // The shards keep running while |task_queue_| is destroyed, and the other
+  // way round, stop handing packets over between them.
+  for (auto& endpoint : endpoints_)
+    static_cast<EmulatedEndpointImpl*>(endpoint.get())->Stop();
+  task_queue_.SendTask(
+      [this] {
+        for (auto& node : network_nodes_)
+          node->link()->Stop();
+      },
+      RTC_FROM_HERE);
+}
 
 EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
     BuiltInNetworkBehaviorConfig config) {
@@ -64,8 +89,12 @@ EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
 
 EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
     std::unique_ptr<NetworkBehaviorInterface> network_behavior) {
+  // Round robin over the shards, the first node is on |task_queue_|.
+  size_t shard = next_shard_++ % (shards_.size() + 1);
+  rtc::TaskQueue* node_task_queue =
+      shard == 0 ? &task_queue_ : shards_[shard - 1].get();
   auto node = std::make_unique<EmulatedNetworkNode>(
-      clock_, &task_queue_, std::move(network_behavior));
+      clock_, node_task_queue, std::move(network_behavior));
   EmulatedNetworkNode* out = node.get();
   task_queue_.PostTask([this, node = std::move(node)]() mutable {
     network_nodes_.push_back(std::move(node));
@@ -156,10 +185,9 @@ void NetworkEmulationManagerImpl::ClearRoute(EmulatedRoute* route) {
   RTC_CHECK(route->active) << "Route already cleared";
   task_queue_.SendTask(
       [route]() {
-        // Remove receiver from intermediate nodes.
-        for (auto* node : route->via_nodes) {
-          node->router()->RemoveReceiver(route->to->GetPeerLocalAddress());
-        }
+        // Remove receiver from intermediate nodes, on their task queues.
+        EmulatedNetworkNode::ClearRoute(route->to->GetPeerLocalAddress(),
+                                        route->via_nodes);
         // Remove destination endpoint from source endpoint's router.
         route->from->router()->RemoveReceiver(route->to->GetPeerLocalAddress());
 
@@ -40,6 +40,10 @@ namespace test {
 class NetworkEmulationManagerImpl : public NetworkEmulationManager {
  public:
   explicit NetworkEmulationManagerImpl(TimeMode mode);
+  // Spreads the network nodes over |num_shards| task queues, so that the
+  // packets of large emulated networks are processed in parallel. The
+  // endpoints stay on the first one.
+  NetworkEmulationManagerImpl(TimeMode mode, size_t num_shards);
   ~NetworkEmulationManagerImpl();
 
   EmulatedNetworkNode* CreateEmulatedNode(
@@ -92,6 +96,7 @@ class NetworkEmulationManagerImpl : public NetworkEmulationManager {
   const std::unique_ptr<TimeController> time_controller_;
   Clock* const clock_;
   int next_node_id_;
+  size_t next_shard_ = 0;
 
   RepeatingTaskHandle process_task_handle_;
 
@@ -113,6 +118,10 @@ class NetworkEmulationManagerImpl : public NetworkEmulationManager {
   std::map<EmulatedEndpoint*, EmulatedNetworkManager*>
       endpoint_to_network_manager_;
 
+  // The task queues of the network nodes other than |task_queue_|, they only
+  // access the nodes and hand the packets over to the queues of the nodes and
+  // endpoints they are routed to.
+  std::vector<std::unique_ptr<TaskQueueForTest>> shards_;
   // Must be the last field, so it will be deleted first, because tasks
   // in the TaskQueue can access other fields of the instance of this class.
   TaskQueueForTest task_queue_;
@@ -392,5 +392,38 @@ TEST_F(NetworkEmulationManagerThreeNodesRoutingTest,
   SendPacketsAndValidateDelivery();
 }
 
+TEST(NetworkEmulationManagerTest, DeliversPacketsInOrderOverSeveralShards) {
+  MockReceiver receiver;
+  std::vector<size_t> received_sizes;
+  EXPECT_CALL(receiver, OnPacketReceived(_))
+      .WillRepeatedly([&](EmulatedIpPacket packet) {
+        received_sizes.push_back(packet.size());
+      });
+
+  NetworkEmulationManagerImpl emulation(TimeMode::kSimulated,
+                                        /*num_shards=*/3);
+  EmulatedEndpoint* e1 = emulation.CreateEndpoint(EmulatedEndpointConfig());
+  EmulatedEndpoint* e2 = emulation.CreateEndpoint(EmulatedEndpointConfig());
+  // Every task queue is crossed at least once on the way to e2.
+  std::vector<EmulatedNetworkNode*> nodes;
+  for (int i = 0; i < 5; ++i)
+    nodes.push_back(CreateEmulatedNodeWithDefaultBuiltInConfig(&emulation));
+  EmulatedRoute* route = emulation.CreateRoute(e1, nodes, e2);
+  uint16_t port = e2->BindReceiver(0, &receiver).value();
+
+  constexpr size_t kNumPackets = 20;
+  for (size_t i = 1; i <= kNumPackets; ++i) {
+    e1->SendPacket(rtc::SocketAddress(e1->GetPeerLocalAddress(), 80),
+                   rtc::SocketAddress(e2->GetPeerLocalAddress(), port),
+                   rtc::CopyOnWriteBuffer(i));
+  }
+  emulation.time_controller()->AdvanceTime(kNetworkPacketWaitTimeout);
+
+  ASSERT_EQ(kNumPackets, received_sizes.size());
+  for (size_t i = 0; i < kNumPackets; ++i)
+    EXPECT_EQ(i + 1, received_sizes[i]);
+  emulation.ClearRoute(route);
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/network/trace_network_behavior.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Returns the time of the last line of the trace at |path|, which is the
+// period of the trace, or -1 if the trace is empty or invalid.
+int64_t ReadTracePeriodMs(const std::string& path) {
+  std::ifstream file(path);
+  int64_t last_time_ms = -1;
+  int64_t time_ms;
+  while (file >> time_ms) {
+    if (time_ms < 0 || time_ms < last_time_ms) {
+      return -1;
+    }
+    last_time_ms = time_ms;
+  }
+  if (!file.eof()) {
+    return -1;
+  }
+  return last_time_ms > 0 ? last_time_ms : -1;
+}
+
+bool IsValidDelayLossSeries(const std::string& path) {
+  std::ifstream file(path);
+  int64_t last_time_ms = -1;
+  int64_t time_ms;
+  int delay_ms;
+  int loss_percent;
+  while (file >> time_ms >> delay_ms >> loss_percent) {
+    if (time_ms < last_time_ms || delay_ms < 0 || loss_percent < 0 ||
+        loss_percent > 100) {
+      return false;
+    }
+    last_time_ms = time_ms;
+  }
+  return file.eof();
+}
+
+}  // namespace
+
+std::unique_ptr<TraceNetworkBehavior> TraceNetworkBehavior::Create(
+    Config config,
+    uint64_t random_seed) {
+  int64_t trace_period_ms = ReadTracePeriodMs(config.trace_path);
+  if (trace_period_ms < 0) {
+    RTC_LOG(LS_ERROR) << "Invalid delivery trace " << config.trace_path;
+    return nullptr;
+  }
+  if (!config.delay_loss_path.empty() &&
+      !IsValidDelayLossSeries(config.delay_loss_path)) {
+    RTC_LOG(LS_ERROR) << "Invalid delay and loss series "
+                      << config.delay_loss_path;
+    return nullptr;
+  }
+  return std::unique_ptr<TraceNetworkBehavior>(new TraceNetworkBehavior(
+      std::move(config), trace_period_ms, random_seed));
+}
+
+TraceNetworkBehavior::TraceNetworkBehavior(Config config,
+                                           int64_t trace_period_ms,
+                                           uint64_t random_seed)
+    : config_(std::move(config)),
+      trace_period_ms_(trace_period_ms),
+      trace_file_(config_.trace_path),
+      random_(random_seed) {
+  RTC_DCHECK_GT(config_.bytes_per_opportunity, 0);
+  sequence_checker_.Detach();
+  delay_loss_.delay_ms = config_.delay_ms;
+  delay_loss_.loss_percent = config_.loss_percent;
+  if (!config_.delay_loss_path.empty()) {
+    delay_loss_file_.open(config_.delay_loss_path);
+    DelayLoss first;
+    if (delay_loss_file_ >> first.time_ms >> first.delay_ms >>
+        first.loss_percent) {
+      next_delay_loss_ = first;
+    }
+  }
+}
+
+TraceNetworkBehavior::~TraceNetworkBehavior() = default;
+
+bool TraceNetworkBehavior::EnqueuePacket(PacketInFlightInfo packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (!start_time_us_) {
+    start_time_us_ = packet.send_time_us;
+    ReadNextOpportunity();
+  }
+  if (config_.queue_length_packets > 0 &&
+      queue_.size() >= config_.queue_length_packets) {
+    return false;
+  }
+  queue_.push_back({packet, std::max<size_t>(packet.size, 1)});
+  return true;
+}
+
+std::vector<PacketDeliveryInfo> TraceNetworkBehavior::DequeueDeliverablePackets(
+    int64_t receive_time_us) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  UseOpportunities(receive_time_us);
+  std::vector<PacketDeliveryInfo> packets;
+  while (!delivered_.empty() &&
+         (delivered_.front().receive_time_us ==
+              PacketDeliveryInfo::kNotReceived ||
+          delivered_.front().receive_time_us <= receive_time_us)) {
+    packets.push_back(delivered_.front());
+    delivered_.pop_front();
+  }
+  return packets;
+}
+
+absl::optional<int64_t> TraceNetworkBehavior::NextDeliveryTimeUs() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  absl::optional<int64_t> next_time_us;
+  if (!delivered_.empty()) {
+    next_time_us = delivered_.front().receive_time_us;
+  }
+  if (!queue_.empty()) {
+    // Opportunities before the packet arrives are of no use.
+    int64_t opportunity_us =
+        std::max(next_opportunity_us_, queue_.front().packet.send_time_us);
+    next_time_us = std::min(next_time_us.value_or(opportunity_us),
+                            opportunity_us);
+  }
+  return next_time_us;
+}
+
+void TraceNetworkBehavior::ReadNextOpportunity() {
+  int64_t time_ms;
+  if (!(trace_file_ >> time_ms)) {
+    // Start over, the trace was validated on creation.
+    trace_file_.clear();
+    trace_file_.seekg(0);
+    trace_offset_ms_ += trace_period_ms_;
+    bool read = static_cast<bool>(trace_file_ >> time_ms);
+    RTC_CHECK(read) << "Failed to reread " << config_.trace_path;
+  }
+  next_opportunity_us_ = *start_time_us_ + (trace_offset_ms_ + time_ms) * 1000;
+}
+
+void TraceNetworkBehavior::UpdateDelayLoss(int64_t time_ms) {
+  while (next_delay_loss_ && next_delay_loss_->time_ms <= time_ms) {
+    delay_loss_ = *next_delay_loss_;
+    DelayLoss next;
+    if (delay_loss_file_ >> next.time_ms >> next.delay_ms >>
+        next.loss_percent) {
+      next_delay_loss_ = next;
+    } else {
+      next_delay_loss_.reset();
+    }
+  }
+}
+
+void TraceNetworkBehavior::UseOpportunities(int64_t time_us) {
+  while (!queue_.empty() && next_opportunity_us_ <= time_us) {
+    int64_t opportunity_us = next_opportunity_us_;
+    ReadNextOpportunity();
+    if (queue_.front().packet.send_time_us > opportunity_us) {
+      continue;
+    }
+    UpdateDelayLoss((opportunity_us - *start_time_us_) / 1000);
+    size_t bytes = config_.bytes_per_opportunity;
+    while (bytes > 0 && !queue_.empty() &&
+           queue_.front().packet.send_time_us <= opportunity_us) {
+      QueuedPacket& queued = queue_.front();
+      size_t used = std::min(bytes, queued.remaining_bytes);
+      bytes -= used;
+      queued.remaining_bytes -= used;
+      if (queued.remaining_bytes > 0) {
+        break;
+      }
+      int64_t receive_time_us = PacketDeliveryInfo::kNotReceived;
+      if (static_cast<int>(random_.Rand(0, 99)) >= delay_loss_.loss_percent) {
+        // Packets are not reordered, even if the delay decreases.
+        receive_time_us =
+            std::max(last_receive_time_us_,
+                     opportunity_us + delay_loss_.delay_ms * int64_t{1000});
+        last_receive_time_us_ = receive_time_us;
+      }
+      delivered_.push_back(
+          PacketDeliveryInfo(queued.packet, receive_time_us));
+      queue_.pop_front();
+    }
+  }
+}
+
+}  // namespace webrtc
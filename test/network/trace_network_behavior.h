@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_NETWORK_TRACE_NETWORK_BEHAVIOR_H_
+#define TEST_NETWORK_TRACE_NETWORK_BEHAVIOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/test/simulated_network.h"
+#include "rtc_base/random.h"
+#include "rtc_base/synchronization/sequence_checker.h"
+
+namespace webrtc {
+
+// Link following a Mahimahi packet delivery trace: each line of the trace is
+// the time in ms, relative to the start of the link, of an opportunity to
+// deliver |bytes_per_opportunity| bytes. Several lines with the same time give
+// several opportunities in that ms. Once the trace ends it starts over, with
+// the time of its last line as period, as in Mahimahi. Unused opportunities
+// are lost, packets that don't fit in one take the next ones.
+//
+// Optionally, the propagation delay and the random loss follow a time series
+// with one "time_ms delay_ms loss_percent" line per change, in increasing
+// time, the last values holding until the end.
+//
+// Both files are read while the link runs, so traces of any length only take
+// constant memory. The link starts with the first packet. All methods must be
+// called on the same sequence, as done by NetworkEmulationManager, e.g.
+//
+//   net->CreateEmulatedNode(TraceNetworkBehavior::Create(config));
+class TraceNetworkBehavior : public NetworkBehaviorInterface {
+ public:
+  struct Config {
+    std::string trace_path;
+    // Optional delay and loss time series.
+    std::string delay_loss_path;
+    // Used if there is no delay and loss time series.
+    int delay_ms = 0;
+    int loss_percent = 0;
+    // Mahimahi uses full size packets, including their header.
+    size_t bytes_per_opportunity = 1504;
+    // Packets waiting for an opportunity beyond this are dropped, unlimited if
+    // zero.
+    size_t queue_length_packets = 0;
+  };
+
+  // Returns null if a file can't be opened or the trace is empty or invalid.
+  static std::unique_ptr<TraceNetworkBehavior> Create(
+      Config config,
+      uint64_t random_seed = 1);
+  ~TraceNetworkBehavior() override;
+
+  // NetworkBehaviorInterface.
+  bool EnqueuePacket(PacketInFlightInfo packet) override;
+  std::vector<PacketDeliveryInfo> DequeueDeliverablePackets(
+      int64_t receive_time_us) override;
+  absl::optional<int64_t> NextDeliveryTimeUs() const override;
+
+ private:
+  struct QueuedPacket {
+    PacketInFlightInfo packet;
+    // Bytes still to deliver.
+    size_t remaining_bytes;
+  };
+  struct DelayLoss {
+    int64_t time_ms = 0;
+    int delay_ms = 0;
+    int loss_percent = 0;
+  };
+
+  TraceNetworkBehavior(Config config,
+                       int64_t trace_period_ms,
+                       uint64_t random_seed);
+
+  // Reads the next opportunity into |next_opportunity_us_|.
+  void ReadNextOpportunity();
+  // Advances the delay and loss time series to |time_ms| since the start.
+  void UpdateDelayLoss(int64_t time_ms);
+  // Uses the opportunities up to |time_us| for the queued packets.
+  void UseOpportunities(int64_t time_us);
+
+  SequenceChecker sequence_checker_;
+  const Config config_;
+  const int64_t trace_period_ms_;
+  std::ifstream trace_file_;
+  std::ifstream delay_loss_file_;
+  Random random_;
+
+  // Unset until the first packet.
+  absl::optional<int64_t> start_time_us_;
+  // Time of the trace's first line in the current loop.
+  int64_t trace_offset_ms_ = 0;
+  int64_t next_opportunity_us_ = 0;
+  DelayLoss delay_loss_;
+  absl::optional<DelayLoss> next_delay_loss_;
+  std::deque<QueuedPacket> queue_;
+  // Delivered or lost, in receive time order.
+  std::deque<PacketDeliveryInfo> delivered_;
+  int64_t last_receive_time_us_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // TEST_NETWORK_TRACE_NETWORK_BEHAVIOR_H_
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/network/trace_network_behavior.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int64_t kStartTimeUs = 1000000;
+
+// Returns a packet taking a whole delivery opportunity.
+PacketInFlightInfo FullPacket(uint64_t id,
+                              int64_t send_time_us = kStartTimeUs) {
+  return PacketInFlightInfo(1504, send_time_us, id);
+}
+
+class TraceNetworkBehaviorTest : public ::testing::Test {
+ protected:
+  ~TraceNetworkBehaviorTest() override {
+    for (const std::string& file : files_) {
+      RemoveFile(file);
+    }
+  }
+
+  std::string WriteFile(const std::string& content) {
+    files_.push_back(TempFilename(OutputPath(), "trace_network_behavior"));
+    std::ofstream file(files_.back());
+    file << content;
+    return files_.back();
+  }
+
+  // Returns the receive times, relative to the start, of all packets, -1
+  // for the lost ones.
+  static std::vector<int64_t> DeliverAll(TraceNetworkBehavior* link) {
+    std::vector<int64_t> receive_times_ms;
+    while (absl::optional<int64_t> next_time_us = link->NextDeliveryTimeUs()) {
+      for (const PacketDeliveryInfo& packet :
+           link->DequeueDeliverablePackets(*next_time_us)) {
+        receive_times_ms.push_back(
+            packet.receive_time_us == PacketDeliveryInfo::kNotReceived
+                ? -1
+                : (packet.receive_time_us - kStartTimeUs) / 1000);
+      }
+    }
+    return receive_times_ms;
+  }
+
+  std::vector<std::string> files_;
+};
+
+TEST_F(TraceNetworkBehaviorTest, DeliversOnePacketPerOpportunity) {
+  TraceNetworkBehavior::Config config;
+  config.trace_path = WriteFile("1\n2\n2\n4\n");
+  auto link = TraceNetworkBehavior::Create(config);
+  ASSERT_TRUE(link);
+  for (uint64_t id = 0; id < 4; ++id) {
+    EXPECT_TRUE(link->EnqueuePacket(FullPacket(id)));
+  }
+  EXPECT_THAT(DeliverAll(link.get()), ElementsAre(1, 2, 2, 4));
+}
+
+TEST_F(TraceNetworkBehaviorTest, SplitsOpportunitiesBetweenPackets) {
+  TraceNetworkBehavior::Config config;
+  config.trace_path = WriteFile("1\n2\n3\n");
+  config.bytes_per_opportunity = 1000;
+  auto link = TraceNetworkBehavior::Create(config);
+  ASSERT_TRUE(link);
+  EXPECT_TRUE(link->EnqueuePacket(PacketInFlightInfo(400, kStartTimeUs, 0)));
+  EXPECT_TRUE(link->EnqueuePacket(PacketInFlightInfo(400, kStartTimeUs, 1)));
+  EXPECT_TRUE(link->EnqueuePacket(PacketInFlightInfo(1500, kStartTimeUs, 2)));
+  EXPECT_THAT(DeliverAll(link.get()), ElementsAre(1, 1, 3));
+}
+
+TEST_F(TraceNetworkBehaviorTest, RepeatsTraceWithItsPeriod) {
+  TraceNetworkBehavior::Config config;
+  config.trace_path = WriteFile("2\n5\n");
+  auto link = TraceNetworkBehavior::Create(config);
+  ASSERT_TRUE(link);
+  for (uint64_t id = 0; id < 5; ++id) {
+    EXPECT_TRUE(link->EnqueuePacket(FullPacket(id)));
+  }
+  EXPECT_THAT(DeliverAll(link.get()), ElementsAre(2, 5, 7, 10, 12));
+}
+
+TEST_F(TraceNetworkBehaviorTest, DoesNotUseOpportunitiesBeforePacket) {
+  TraceNetworkBehavior::Config config;
+  config.trace_path = WriteFile("1\n2\n3\n4\n");
+  auto link = TraceNetworkBehavior::Create(config);
+  ASSERT_TRUE(link);
+  EXPECT_TRUE(link->EnqueuePacket(FullPacket(0)));
+  EXPECT_THAT(DeliverAll(link.get()), ElementsAre(1));
+  EXPECT_TRUE(link->EnqueuePacket(FullPacket(1, kStartTimeUs + 2500)));
+  EXPECT_THAT(DeliverAll(link.get()), ElementsAre(3));
+}
+
+TEST_F(TraceNetworkBehaviorTest, FollowsDelayAndLossSeries) {
+  TraceNetworkBehavior::Config config;
+  config.trace_path = WriteFile("1\n2\n3\n4\n");
+  config.delay_loss_path = WriteFile("0 10 0\n2 20 0\n3 0 100\n4 5 0\n");
+  auto link = TraceNetworkBehavior::Create(config);
+  ASSERT_TRUE(link);
+  for (uint64_t id = 0; id < 4; ++id) {
+    EXPECT_TRUE(link->EnqueuePacket(FullPacket(id)));
+  }
+  // The last packet is not delivered before the second one.
+  EXPECT_THAT(DeliverAll(link.get()), ElementsAre(11, 22, -1, 22));
+}
+
+TEST_F(TraceNetworkBehaviorTest, DropsPacketsBeyondQueueLength) {
+  TraceNetworkBehavior::Config config;
+  config.trace_path = WriteFile("1\n");
+  config.queue_length_packets = 2;
+  auto link = TraceNetworkBehavior::Create(config);
+  ASSERT_TRUE(link);
+  EXPECT_TRUE(link->EnqueuePacket(FullPacket(0)));
+  EXPECT_TRUE(link->EnqueuePacket(FullPacket(1)));
+  EXPECT_FALSE(link->EnqueuePacket(FullPacket(2)));
+  EXPECT_THAT(DeliverAll(link.get()), ElementsAre(1, 2));
+}
+
+TEST_F(TraceNetworkBehaviorTest, RejectsInvalidTraces) {
+  TraceNetworkBehavior::Config config;
+  config.trace_path = WriteFile("");
+  EXPECT_FALSE(TraceNetworkBehavior::Create(config));
+  config.trace_path = WriteFile("2\n1\n");
+  EXPECT_FALSE(TraceNetworkBehavior::Create(config));
+  config.trace_path = WriteFile("1\nx\n");
+  EXPECT_FALSE(TraceNetworkBehavior::Create(config));
+  config.trace_path = WriteFile("1\n");
+  config.delay_loss_path = WriteFile("0 10 101\n");
+  EXPECT_FALSE(TraceNetworkBehavior::Create(config));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Plays a sender and a receiver, configured by an AlphaCC config file, over an
+// emulated link following a trace, in simulated time. The estimator of the
+// config, e.g. the ONNX model, runs in the loop, on simulated task queues, so
+// a trace is evaluated as fast as the machine allows instead of in real time.
+//
+// The trace is a JSON file with the link capacity over time:
+//
+//   {
+//     "uplink": {
+//       "trace_pattern": [
+//         {"duration": 5000, "capacity": 1000, "loss": 0, "rtt": 80},
+//         {"duration": 5000, "capacity": 300, "loss": 1, "rtt": 120,
+//          "jitter": 10}
+//       ]
+//     }
+//   }
+//
+// with the duration and the delays in ms, the capacity in kbps and the loss
+// in percent. Only "duration" and "capacity" are required. The uplink carries
+// the media, the return link only gets half of the RTT as delay.
+//
+// Usage: alphacc_trace_runner [--peer_logs] config_file trace_file
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "absl/flags/parse.h"
+#include "api/alphacc_config.h"
+#include "api/test/network_emulation_manager.h"
+#include "api/test/simulated_network.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/strings/json.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/peer_scenario/peer_scenario.h"
+#include "test/peer_scenario/peer_scenario_client.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+struct TracePeriod {
+  TimeDelta duration = TimeDelta::Zero();
+  BuiltInNetworkBehaviorConfig uplink;
+  BuiltInNetworkBehaviorConfig downlink;
+};
+
+bool ParseTrace(const std::string& file_path,
+                std::vector<TracePeriod>* trace) {
+  std::ifstream is(file_path);
+  Json::Reader reader;
+  Json::Value top;
+  Json::Value uplink;
+  Json::Value pattern;
+  if (!reader.parse(is, top) ||
+      !rtc::GetValueFromJsonObject(top, "uplink", &uplink) ||
+      !rtc::GetValueFromJsonObject(uplink, "trace_pattern", &pattern) ||
+      !pattern.isArray()) {
+    return false;
+  }
+  for (const Json::Value& entry : pattern) {
+    TracePeriod period;
+    int duration_ms = 0;
+    int capacity_kbps = 0;
+    if (!rtc::GetIntFromJsonObject(entry, "duration", &duration_ms) ||
+        !rtc::GetIntFromJsonObject(entry, "capacity", &capacity_kbps) ||
+        duration_ms <= 0 || capacity_kbps < 0) {
+      return false;
+    }
+    int loss_percent = 0;
+    int rtt_ms = 0;
+    int jitter_ms = 0;
+    rtc::GetIntFromJsonObject(entry, "loss", &loss_percent);
+    rtc::GetIntFromJsonObject(entry, "rtt", &rtt_ms);
+    rtc::GetIntFromJsonObject(entry, "jitter", &jitter_ms);
+    period.duration = TimeDelta::Millis(duration_ms);
+    period.uplink.link_capacity_kbps = capacity_kbps;
+    period.uplink.loss_percent = loss_percent;
+    period.uplink.queue_delay_ms = rtt_ms / 2;
+    period.uplink.delay_standard_deviation_ms = jitter_ms;
+    period.downlink.queue_delay_ms = rtt_ms - rtt_ms / 2;
+    trace->push_back(period);
+  }
+  return !trace->empty();
+}
+
+PeerScenarioClient::VideoSendTrackConfig VideoConfig(
+    const AlphaCCConfig& config) {
+  PeerScenarioClient::VideoSendTrackConfig video;
+  if (config.video_source_option ==
+      AlphaCCConfig::VideoSourceOption::kVideoFile) {
+    video.generator.video_file->name = config.video_file_path;
+    video.generator.video_file->width = config.video_width;
+    video.generator.video_file->height = config.video_height;
+    video.generator.video_file->framerate = config.video_fps;
+  } else {
+    video.generator.squares_video->width = 640;
+    video.generator.squares_video->height = 480;
+  }
+  return video;
+}
+
+int RunTrace(const AlphaCCConfig& config,
+             const std::vector<TracePeriod>& trace) {
+  TimeDelta duration = TimeDelta::Zero();
+  for (const TracePeriod& period : trace) {
+    duration += period.duration;
+  }
+  if (config.conn_autoclose > 0) {
+    duration = std::min(duration, TimeDelta::Seconds(config.conn_autoclose));
+  }
+
+  int64_t start_us = rtc::TimeMicros();
+  {
+    PeerScenario s("alphacc_trace_runner", TimeMode::kSimulated);
+    auto* sender = s.CreateClient("sender", PeerScenarioClient::Config());
+    auto* receiver = s.CreateClient("receiver", PeerScenarioClient::Config());
+    auto uplink = s.net()->NodeBuilder().config(trace[0].uplink).Build();
+    auto downlink = s.net()->NodeBuilder().config(trace[0].downlink).Build();
+
+    sender->CreateAudio("AUDIO", cricket::AudioOptions());
+    sender->CreateVideo("VIDEO", VideoConfig(config));
+    s.SimpleConnection(sender, receiver, {uplink.node}, {downlink.node});
+
+    TimeDelta elapsed = TimeDelta::Zero();
+    for (const TracePeriod& period : trace) {
+      if (elapsed >= duration) {
+        break;
+      }
+      uplink.simulation->SetConfig(period.uplink);
+      downlink.simulation->SetConfig(period.downlink);
+      TimeDelta period_duration = std::min(period.duration, duration - elapsed);
+      s.ProcessMessages(period_duration);
+      elapsed += period_duration;
+    }
+  }
+  double wall_clock_s = (rtc::TimeMicros() - start_us) / 1e6;
+  printf("Simulated %.1f s in %.1f s, %.1fx real time\n",
+         duration.seconds<double>(), wall_clock_s,
+         duration.seconds<double>() / wall_clock_s);
+  return 0;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 3) {
+    fprintf(stderr, "Usage: %s [--peer_logs] config_file trace_file\n",
+            args[0]);
+    return 1;
+  }
+  if (!webrtc::ParseAlphaCCConfig(args[1])) {
+    fprintf(stderr, "bad config file %s\n", args[1]);
+    return 1;
+  }
+  std::vector<webrtc::test::TracePeriod> trace;
+  if (!webrtc::test::ParseTrace(args[2], &trace)) {
+    fprintf(stderr, "bad trace file %s\n", args[2]);
+    return 1;
+  }
+  webrtc::field_trial::InitFieldTrialsFromString(
+      "WebRTC-KeepAbsSendTimeExtension/Enabled/");
+  return webrtc::test::RunTrace(*webrtc::GetAlphaCCConfig(), trace);
+}
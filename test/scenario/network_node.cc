@@ -76,12 +76,13 @@ NetworkNodeTransport::~NetworkNodeTransport() = default;
 bool NetworkNodeTransport::SendRtp(const uint8_t* packet,
                                    size_t length,
                                    const PacketOptions& options) {
-  int64_t send_time_ms = sender_clock_->TimeInMilliseconds();
+  int64_t send_time_us = sender_clock_->TimeInMicroseconds();
   rtc::SentPacket sent_packet;
   sent_packet.packet_id = options.packet_id;
   sent_packet.info.included_in_feedback = options.included_in_feedback;
   sent_packet.info.included_in_allocation = options.included_in_allocation;
-  sent_packet.send_time_ms = send_time_ms;
+  sent_packet.send_time_ms = send_time_us / 1000;
+  sent_packet.send_time_us = send_time_us;
   sent_packet.info.packet_size_bytes = length;
   sent_packet.info.packet_type = rtc::PacketType::kData;
   sender_call_->OnSentPacket(sent_packet);
@@ -43,5 +43,20 @@ void VideoQualityStats::AddStats(const VideoQualityStats& other) {
   time_between_freezes.AddSamples(other.time_between_freezes);
 }
 
+void VideoStageDelayStats::AddTimingFrameInfo(const TimingFrameInfo& info) {
+  if (info.IsInvalid() || info.EndToEndDelay() < 0)
+    return;
+  encoder_queue.AddSampleMs(info.encode_start_ms - info.capture_time_ms);
+  encode.AddSampleMs(info.encode_finish_ms - info.encode_start_ms);
+  packetization.AddSampleMs(info.packetization_finish_ms -
+                            info.encode_finish_ms);
+  pacing.AddSampleMs(info.pacer_exit_ms - info.packetization_finish_ms);
+  network.AddSampleMs(info.receive_start_ms - info.pacer_exit_ms);
+  depacketization.AddSampleMs(info.receive_finish_ms - info.receive_start_ms);
+  jitter_buffer.AddSampleMs(info.decode_start_ms - info.receive_finish_ms);
+  decode.AddSampleMs(info.decode_finish_ms - info.decode_start_ms);
+  end_to_end.AddSampleMs(info.EndToEndDelay());
+}
+
 }  // namespace test
 }  // namespace webrtc
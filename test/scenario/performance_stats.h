@@ -14,6 +14,7 @@
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "api/video/video_frame_buffer.h"
+#include "api/video/video_timing.h"
 #include "rtc_base/numerics/event_rate_counter.h"
 #include "rtc_base/numerics/sample_stats.h"
 
@@ -96,11 +97,35 @@ struct CollectedVideoSendStats {
   SampleStats<DataRate> media_bitrate;
   SampleStats<DataRate> fec_bitrate;
 };
+// Time spent by timing frames in each stage of the media pipeline, from the
+// timestamps of the video-timing header extension.
+struct VideoStageDelayStats {
+  // From capture until encoding started.
+  SampleStats<TimeDelta> encoder_queue;
+  SampleStats<TimeDelta> encode;
+  // From encoded to handed to the pacer, FEC is generated here.
+  SampleStats<TimeDelta> packetization;
+  // Until the last packet left the pacer.
+  SampleStats<TimeDelta> pacing;
+  // Until the first packet was received.
+  SampleStats<TimeDelta> network;
+  // From the first to the last packet received, including retransmissions and
+  // FEC recovery.
+  SampleStats<TimeDelta> depacketization;
+  // Waiting in the frame buffer for references and the render time.
+  SampleStats<TimeDelta> jitter_buffer;
+  SampleStats<TimeDelta> decode;
+  SampleStats<TimeDelta> end_to_end;
+  // Ignores invalid timing and frames without synchronized sender clocks.
+  void AddTimingFrameInfo(const TimingFrameInfo& info);
+};
+
 struct CollectedVideoReceiveStats {
   SampleStats<TimeDelta> decode_time;
   SampleStats<TimeDelta> decode_time_max;
   SampleStats<double> decode_pixels;
   SampleStats<double> resolution;
+  VideoStageDelayStats stage_delays;
 };
 
 }  // namespace test
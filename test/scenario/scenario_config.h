@@ -156,6 +156,9 @@ struct VideoStreamConfig {
     ~Stream();
     bool abs_send_time = false;
     bool packet_feedback = true;
+    // Sends the video-timing header extension, which gives the per stage
+    // delays of timing frames in VideoReceiveStream::Stats.
+    bool video_timing = false;
     bool use_rtx = true;
     DataRate pad_to_rate = DataRate::Zero();
     TimeDelta nack_history_time = TimeDelta::Millis(1000);
@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/scenario/scenario_sweep.h"
+
+#include <stdio.h>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "test/testsupport/file_utils.h"
+
+#if defined(WEBRTC_POSIX)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace webrtc {
+namespace test {
+namespace {
+
+std::string JsonString(const std::string& value) {
+  std::string out = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  return out + "\"";
+}
+
+#if defined(WEBRTC_POSIX)
+std::string ReadReport(const std::string& path) {
+  std::ifstream file(path);
+  std::stringstream report;
+  report << file.rdbuf();
+  return report.str();
+}
+
+bool WriteReport(const std::string& path, const std::string& report) {
+  std::ofstream file(path, std::ios::trunc);
+  file << report;
+  return file.good();
+}
+
+std::string ErrorReport(const std::string& name, int status) {
+  rtc::StringBuilder sb;
+  sb << "{\"name\": " << JsonString(name) << ", \"error\": ";
+  if (WIFSIGNALED(status)) {
+    sb << "\"killed by signal " << WTERMSIG(status) << "\"}";
+  } else {
+    sb << "\"exited with status " << WEXITSTATUS(status) << "\"}";
+  }
+  return sb.Release();
+}
+#endif
+
+}  // namespace
+
+ScenarioSweep::ScenarioSweep(int max_parallel_cases)
+    : max_parallel_cases_(max_parallel_cases > 0
+                              ? max_parallel_cases
+                              : CpuInfo::DetectNumberOfCores()) {}
+
+ScenarioSweep::~ScenarioSweep() = default;
+
+void ScenarioSweep::AddCase(std::string name, ScenarioSweepCase run_case) {
+  cases_.push_back({std::move(name), std::move(run_case)});
+}
+
+std::string ScenarioSweep::Run() {
+  std::vector<std::string> reports(cases_.size());
+#if defined(WEBRTC_POSIX)
+  // Index of the case run by each child process.
+  std::map<pid_t, size_t> running;
+  std::vector<std::string> report_paths(cases_.size());
+  size_t next_case = 0;
+  while (next_case < cases_.size() || !running.empty()) {
+    if (next_case < cases_.size() &&
+        running.size() < static_cast<size_t>(max_parallel_cases_)) {
+      report_paths[next_case] = TempFilename(OutputPath(), "scenario_sweep");
+      // Don't let the children write out what the parent buffered.
+      fflush(nullptr);
+      pid_t pid = fork();
+      RTC_CHECK_GE(pid, 0) << "Failed to fork the process of a case";
+      if (pid == 0) {
+        std::string report = RunCase(cases_[next_case]);
+        _exit(WriteReport(report_paths[next_case], report) ? 0 : 1);
+      }
+      running[pid] = next_case++;
+      continue;
+    }
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, 0);
+    RTC_CHECK_GT(pid, 0) << "Failed to wait for the process of a case";
+    auto it = running.find(pid);
+    if (it == running.end())
+      continue;
+    size_t index = it->second;
+    running.erase(it);
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+      reports[index] = ReadReport(report_paths[index]);
+    if (reports[index].empty())
+      reports[index] = ErrorReport(cases_[index].name, status);
+    remove(report_paths[index].c_str());
+  }
+#else
+  for (size_t i = 0; i < cases_.size(); ++i)
+    reports[i] = RunCase(cases_[i]);
+#endif
+  rtc::StringBuilder sb;
+  sb << "[";
+  for (size_t i = 0; i < reports.size(); ++i)
+    sb << (i == 0 ? "\n  " : ",\n  ") << reports[i];
+  sb << "\n]\n";
+  return sb.Release();
+}
+
+std::string ScenarioSweep::CaseReport(const std::string& name,
+                                      VideoQualityAnalyzer* analyzer,
+                                      CallStatsCollectors* collectors) {
+  CollectedCallStats& call = collectors->call.stats();
+  VideoQualityStats& video = analyzer->stats();
+  rtc::StringBuilder sb;
+  sb << "{\"name\": " << JsonString(name);
+  sb << ", \"target_rate_kbps\": " << call.target_rate.Mean().kbps<double>();
+  sb << ", \"media_rate_kbps\": "
+     << collectors->video_send.stats().media_bitrate.Mean().kbps<double>();
+  sb << ", \"round_trip_time_ms\": "
+     << call.round_trip_time.Mean().ms<double>();
+  sb << ", \"end_to_end_delay_ms\": {";
+  sb << "\"p50\": " << video.end_to_end_delay.Quantile(0.5).ms<double>();
+  sb << ", \"p95\": " << video.end_to_end_delay.Quantile(0.95).ms<double>();
+  sb << ", \"p99\": " << video.end_to_end_delay.Quantile(0.99).ms<double>();
+  sb << "}";
+  sb << ", \"rendered_frames\": " << video.render.count;
+  sb << ", \"lost_frames\": " << video.lost_count;
+  sb << ", \"freeze_count\": " << video.freeze_count;
+  sb << ", \"freeze_time_ms\": "
+     << video.freeze_duration.Mean().ms<double>() *
+            video.freeze_duration.Count();
+  sb << ", \"psnr_with_freeze\": " << video.psnr_with_freeze.Mean();
+  sb << "}";
+  return sb.Release();
+}
+
+std::string ScenarioSweep::RunCase(const NamedCase& named_case) {
+  // The analyzer and collectors are fed by the scenario until it is destroyed.
+  VideoQualityAnalyzer analyzer;
+  CallStatsCollectors collectors;
+  {
+    Scenario s;
+    named_case.run_case(&s, &analyzer, &collectors);
+  }
+  return CaseReport(named_case.name, &analyzer, &collectors);
+}
+
+}  // namespace test
+}  // namespace webrtc
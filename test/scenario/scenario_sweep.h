@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef TEST_SCENARIO_SCENARIO_SWEEP_H_
+#define TEST_SCENARIO_SCENARIO_SWEEP_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "test/scenario/scenario.h"
+#include "test/scenario/stats_collection.h"
+
+namespace webrtc {
+namespace test {
+
+// Sets up the calls of one case of a sweep in |s| and runs it. The frame
+// pairs of the analyzed video stream should be handed to |analyzer| and the
+// periodic call stats to |collectors|, they make up the report of the case.
+using ScenarioSweepCase = std::function<void(Scenario* s,
+                                             VideoQualityAnalyzer* analyzer,
+                                             CallStatsCollectors* collectors)>;
+
+// Runs many scenario cases, e.g. the combinations of network traces and
+// congestion control configurations of an evaluation, and aggregates their
+// stats into a single report. Every case gets its own Scenario using
+// simulated time. As GlobalSimulatedTimeController overrides the process wide
+// clock, the cases are run in parallel in child processes on POSIX, and one
+// after another on other platforms.
+class ScenarioSweep {
+ public:
+  // Runs up to |max_parallel_cases| cases at once, as many as there are cores
+  // if 0.
+  explicit ScenarioSweep(int max_parallel_cases = 0);
+  ~ScenarioSweep();
+
+  void AddCase(std::string name, ScenarioSweepCase run_case);
+
+  // Runs all the cases and returns the report, a JSON array with an object
+  // per case in the order they were added. A case whose process failed only
+  // reports its name and the error. Since the child processes only inherit
+  // the calling thread, this should not be called while other threads may
+  // hold locks.
+  std::string Run();
+
+  // The JSON object reporting the stats of a case.
+  static std::string CaseReport(const std::string& name,
+                                VideoQualityAnalyzer* analyzer,
+                                CallStatsCollectors* collectors);
+
+ private:
+  struct NamedCase {
+    std::string name;
+    ScenarioSweepCase run_case;
+  };
+
+  std::string RunCase(const NamedCase& named_case);
+
+  const int max_parallel_cases_;
+  std::vector<NamedCase> cases_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_SCENARIO_SCENARIO_SWEEP_H_
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/scenario/scenario_sweep.h"
+
+#include <stdlib.h>
+
+#include <string>
+
+#include "rtc_base/strings/json.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+ScenarioSweepCase VideoCallCase(DataRate bandwidth) {
+  return [bandwidth](Scenario* s, VideoQualityAnalyzer* analyzer,
+                     CallStatsCollectors* collectors) {
+    VideoStreamConfig config;
+    config.hooks.frame_pair_handlers = {analyzer->Handler()};
+    auto* caller = s->CreateClient("caller", CallClientConfig());
+    auto* callee = s->CreateClient("callee", CallClientConfig());
+    NetworkSimulationConfig network_config;
+    network_config.bandwidth = bandwidth;
+    auto route = s->CreateRoutes(
+        caller, {s->CreateSimulationNode(network_config)}, callee,
+        {s->CreateSimulationNode(NetworkSimulationConfig())});
+    VideoStreamPair* video = s->CreateVideoStream(route->forward(), config);
+    s->Every(TimeDelta::Seconds(1), [=] {
+      collectors->call.AddStats(caller->GetStats());
+      collectors->video_send.AddStats(video->send()->GetStats(), s->Now());
+    });
+    s->RunFor(TimeDelta::Seconds(3));
+  };
+}
+}  // namespace
+
+TEST(ScenarioSweepTest, ReportsTheCasesInTheOrderTheyWereAdded) {
+  ScenarioSweep sweep(/*max_parallel_cases=*/2);
+  sweep.AddCase("bandwidth_300kbps",
+                VideoCallCase(DataRate::KilobitsPerSec(300)));
+  sweep.AddCase("bandwidth_1000kbps",
+                VideoCallCase(DataRate::KilobitsPerSec(1000)));
+  sweep.AddCase("bandwidth_100kbps",
+                VideoCallCase(DataRate::KilobitsPerSec(100)));
+
+  Json::Value cases;
+  ASSERT_TRUE(Json::Reader().parse(sweep.Run(), cases));
+  ASSERT_EQ(3u, cases.size());
+  EXPECT_EQ("bandwidth_300kbps", cases[0]["name"].asString());
+  EXPECT_EQ("bandwidth_1000kbps", cases[1]["name"].asString());
+  EXPECT_EQ("bandwidth_100kbps", cases[2]["name"].asString());
+  for (const Json::Value& report : cases) {
+    EXPECT_FALSE(report.isMember("error"));
+    EXPECT_GT(report["rendered_frames"].asInt(), 0);
+    EXPECT_GT(report["target_rate_kbps"].asDouble(), 0);
+    EXPECT_GT(report["end_to_end_delay_ms"]["p95"].asDouble(), 0);
+  }
+}
+
+#if defined(WEBRTC_POSIX)
+TEST(ScenarioSweepTest, ReportsTheCasesThatCrashed) {
+  ScenarioSweep sweep;
+  sweep.AddCase("crashes", [](Scenario*, VideoQualityAnalyzer*,
+                              CallStatsCollectors*) { abort(); });
+  sweep.AddCase("bandwidth_300kbps",
+                VideoCallCase(DataRate::KilobitsPerSec(300)));
+
+  Json::Value cases;
+  ASSERT_TRUE(Json::Reader().parse(sweep.Run(), cases));
+  ASSERT_EQ(2u, cases.size());
+  EXPECT_EQ("crashes", cases[0]["name"].asString());
+  EXPECT_TRUE(cases[0].isMember("error"));
+  EXPECT_FALSE(cases[1].isMember("error"));
+}
+#endif
+
+}  // namespace test
+}  // namespace webrtc
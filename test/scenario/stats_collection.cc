@@ -184,6 +184,12 @@ void VideoReceiveStatsCollector::AddStats(VideoReceiveStream::Stats sample) {
     stats_.decode_pixels.AddSample(sample.width * sample.height);
     stats_.resolution.AddSample(sample.height);
   }
+  if (sample.timing_frame_info &&
+      sample.timing_frame_info->rtp_timestamp !=
+          last_timing_frame_rtp_timestamp_) {
+    last_timing_frame_rtp_timestamp_ = sample.timing_frame_info->rtp_timestamp;
+    stats_.stage_delays.AddTimingFrameInfo(*sample.timing_frame_info);
+  }
 }
 }  // namespace test
 }  // namespace webrtc
@@ -95,6 +95,8 @@ class VideoReceiveStatsCollector {
 
  private:
   CollectedVideoReceiveStats stats_;
+  // The stats report the slowest recent timing frame, often the same one.
+  absl::optional<uint32_t> last_timing_frame_rtp_timestamp_;
 };
 
 struct CallStatsCollectors {
@@ -35,6 +35,7 @@ enum : int {  // The first valid value is 1.
   kAbsSendTimeExtensionId,
   kVideoContentTypeExtensionId,
   kVideoRotationRtpExtensionId,
+  kVideoTimingExtensionId,
 };
 
 constexpr int kDefaultMaxQp = cricket::WebRtcVideoChannel::kDefaultQpMax;
@@ -105,6 +106,10 @@ std::vector<RtpExtension> GetVideoRtpExtensions(
     res.push_back(
         RtpExtension(RtpExtension::kAbsSendTimeUri, kAbsSendTimeExtensionId));
   }
+  if (config.stream.video_timing) {
+    res.push_back(
+        RtpExtension(RtpExtension::kVideoTimingUri, kVideoTimingExtensionId));
+  }
   return res;
 }
 
@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/testsupport/async_file_writer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+void AddWrite(int64_t frames,
+              int64_t queue_time_ms,
+              AsyncFileWriterStats* stats) {
+  int64_t delay_ms = rtc::TimeMillis() - queue_time_ms;
+  stats->frames_written += frames;
+  stats->max_write_delay_ms = std::max(stats->max_write_delay_ms, delay_ms);
+  stats->total_write_delay_ms += delay_ms;
+  ++stats->writes;
+}
+
+// Returns once the tasks posted so far to |task_queue| have run.
+void Flush(rtc::TaskQueue* task_queue) {
+  rtc::Event done;
+  task_queue->PostTask([&done] { done.Set(); });
+  done.Wait(rtc::Event::kForever);
+}
+
+void LogStats(const char* name, const AsyncFileWriterStats& stats) {
+  RTC_LOG(LS_INFO) << name << ": " << stats.frames_written
+                   << " frames written, " << stats.frames_dropped
+                   << " dropped, max write delay " << stats.max_write_delay_ms
+                   << " ms";
+}
+
+}  // namespace
+
+AsyncVideoFrameWriter::AsyncVideoFrameWriter(
+    std::unique_ptr<VideoFrameWriter> writer,
+    TaskQueueFactory* task_queue_factory,
+    size_t max_queued_frames)
+    : writer_(std::move(writer)),
+      max_queued_frames_(max_queued_frames),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "AsyncVideoFrameWriter",
+          TaskQueueFactory::Priority::NORMAL)) {
+  RTC_DCHECK(writer_);
+  RTC_DCHECK_GT(max_queued_frames_, 0);
+}
+
+AsyncVideoFrameWriter::~AsyncVideoFrameWriter() {
+  Close();
+}
+
+bool AsyncVideoFrameWriter::WriteFrame(const VideoFrame& frame) {
+  {
+    rtc::CritScope lock(&crit_);
+    if (closed_)
+      return false;
+    if (queued_frames_ >= max_queued_frames_) {
+      ++stats_.frames_dropped;
+      return false;
+    }
+    ++queued_frames_;
+  }
+  int64_t queue_time_ms = rtc::TimeMillis();
+  task_queue_.PostTask([this, frame, queue_time_ms] {
+    writer_->WriteFrame(frame);
+    rtc::CritScope lock(&crit_);
+    --queued_frames_;
+    AddWrite(1, queue_time_ms, &stats_);
+  });
+  return true;
+}
+
+void AsyncVideoFrameWriter::Close() {
+  {
+    rtc::CritScope lock(&crit_);
+    if (closed_)
+      return;
+    closed_ = true;
+  }
+  Flush(&task_queue_);
+  writer_->Close();
+  LogStats("AsyncVideoFrameWriter", GetStats());
+}
+
+AsyncFileWriterStats AsyncVideoFrameWriter::GetStats() const {
+  rtc::CritScope lock(&crit_);
+  return stats_;
+}
+
+AsyncWavFileWriter::AsyncWavFileWriter(std::string filename,
+                                       int sampling_frequency_in_hz,
+                                       int num_channels,
+                                       TaskQueueFactory* task_queue_factory,
+                                       size_t batch_frames,
+                                       size_t max_queued_batches)
+    : sampling_frequency_in_hz_(sampling_frequency_in_hz),
+      num_channels_(num_channels),
+      batch_frames_(batch_frames),
+      max_queued_batches_(max_queued_batches),
+      wav_writer_(filename, sampling_frequency_in_hz, num_channels),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "AsyncWavFileWriter",
+          TaskQueueFactory::Priority::NORMAL)) {
+  RTC_DCHECK_GT(batch_frames_, 0);
+  RTC_DCHECK_GT(max_queued_batches_, 0);
+}
+
+AsyncWavFileWriter::~AsyncWavFileWriter() {
+  QueueBatch();
+  Flush(&task_queue_);
+  LogStats("AsyncWavFileWriter", GetStats());
+}
+
+bool AsyncWavFileWriter::Render(rtc::ArrayView<const int16_t> data) {
+  if (batch_.empty()) {
+    batch_.reserve(
+        TestAudioDeviceModule::SamplesPerFrame(sampling_frequency_in_hz_) *
+        num_channels_ * batch_frames_);
+  }
+  batch_.insert(batch_.end(), data.begin(), data.end());
+  if (++batch_frame_count_ >= batch_frames_)
+    QueueBatch();
+  return true;
+}
+
+AsyncFileWriterStats AsyncWavFileWriter::GetStats() const {
+  rtc::CritScope lock(&crit_);
+  return stats_;
+}
+
+void AsyncWavFileWriter::QueueBatch() {
+  if (batch_frame_count_ == 0)
+    return;
+  int64_t frames = batch_frame_count_;
+  std::vector<int16_t> samples = std::move(batch_);
+  batch_.clear();
+  batch_frame_count_ = 0;
+  {
+    rtc::CritScope lock(&crit_);
+    if (queued_batches_ >= max_queued_batches_) {
+      stats_.frames_dropped += frames;
+      return;
+    }
+    ++queued_batches_;
+  }
+  int64_t queue_time_ms = rtc::TimeMillis();
+  task_queue_.PostTask(
+      [this, samples = std::move(samples), frames, queue_time_ms] {
+        wav_writer_.WriteSamples(samples.data(), samples.size());
+        rtc::CritScope lock(&crit_);
+        --queued_batches_;
+        AddWrite(frames, queue_time_ms, &stats_);
+      });
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_TESTSUPPORT_ASYNC_FILE_WRITER_H_
+#define TEST_TESTSUPPORT_ASYNC_FILE_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/video/video_frame.h"
+#include "common_audio/wav_file.h"
+#include "modules/audio_device/include/test_audio_device.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+#include "test/testsupport/video_frame_writer.h"
+
+namespace webrtc {
+namespace test {
+
+struct AsyncFileWriterStats {
+  // Video frames, or 10 ms audio frames.
+  int64_t frames_written = 0;
+  // Frames dropped because too many were waiting to be written.
+  int64_t frames_dropped = 0;
+  // Time from queuing frames to having them written.
+  int64_t max_write_delay_ms = 0;
+  int64_t total_write_delay_ms = 0;
+  int64_t writes = 0;
+};
+
+// Writes frames with another VideoFrameWriter, on a task queue of its own, so
+// that the disk doesn't delay the caller. Up to |max_queued_frames| frames
+// wait to be written, further ones are dropped. WriteFrame() only fails for
+// dropped frames, or after Close().
+class AsyncVideoFrameWriter : public VideoFrameWriter {
+ public:
+  AsyncVideoFrameWriter(std::unique_ptr<VideoFrameWriter> writer,
+                        TaskQueueFactory* task_queue_factory,
+                        size_t max_queued_frames);
+  // Writes the queued frames and closes the file, if not closed yet.
+  ~AsyncVideoFrameWriter() override;
+
+  bool WriteFrame(const VideoFrame& frame) override;
+  // Waits for the queued frames to be written, and closes the file.
+  void Close() override;
+
+  AsyncFileWriterStats GetStats() const;
+
+ private:
+  const std::unique_ptr<VideoFrameWriter> writer_;
+  const size_t max_queued_frames_;
+
+  mutable rtc::CriticalSection crit_;
+  size_t queued_frames_ RTC_GUARDED_BY(crit_) = 0;
+  bool closed_ RTC_GUARDED_BY(crit_) = false;
+  AsyncFileWriterStats stats_ RTC_GUARDED_BY(crit_);
+
+  // Last, so that it is destroyed first.
+  rtc::TaskQueue task_queue_;
+};
+
+// Renderer writing to a WAV file on a task queue of its own. The samples are
+// batched into |batch_frames| 10 ms frames per write, and up to
+// |max_queued_batches| batches wait to be written, further ones are dropped.
+class AsyncWavFileWriter : public TestAudioDeviceModule::Renderer {
+ public:
+  AsyncWavFileWriter(std::string filename,
+                     int sampling_frequency_in_hz,
+                     int num_channels,
+                     TaskQueueFactory* task_queue_factory,
+                     size_t batch_frames = 50,
+                     size_t max_queued_batches = 20);
+  // Writes the queued samples and closes the file.
+  ~AsyncWavFileWriter() override;
+
+  int SamplingFrequency() const override { return sampling_frequency_in_hz_; }
+  int NumChannels() const override { return num_channels_; }
+  bool Render(rtc::ArrayView<const int16_t> data) override;
+
+  AsyncFileWriterStats GetStats() const;
+
+ private:
+  // Queues |batch_| to be written.
+  void QueueBatch();
+
+  const int sampling_frequency_in_hz_;
+  const int num_channels_;
+  const size_t batch_frames_;
+  const size_t max_queued_batches_;
+  // Only used on the task queue.
+  WavWriter wav_writer_;
+
+  // Only used by Render(), on the audio device thread.
+  std::vector<int16_t> batch_;
+  size_t batch_frame_count_ = 0;
+
+  mutable rtc::CriticalSection crit_;
+  size_t queued_batches_ RTC_GUARDED_BY(crit_) = 0;
+  AsyncFileWriterStats stats_ RTC_GUARDED_BY(crit_);
+
+  // Last, so that it is destroyed first.
+  rtc::TaskQueue task_queue_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_TESTSUPPORT_ASYNC_FILE_WRITER_H_
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/testsupport/async_file_writer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/video/i420_buffer.h"
+#include "common_audio/wav_file.h"
+#include "rtc_base/event.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// Counts the frames, each write waiting for |write_allowed| if set.
+class FakeVideoFrameWriter : public VideoFrameWriter {
+ public:
+  FakeVideoFrameWriter(rtc::Event* write_allowed, int* frames, bool* closed)
+      : write_allowed_(write_allowed), frames_(frames), closed_(closed) {}
+
+  bool WriteFrame(const VideoFrame& frame) override {
+    if (write_allowed_)
+      write_allowed_->Wait(rtc::Event::kForever);
+    ++*frames_;
+    return true;
+  }
+  void Close() override { *closed_ = true; }
+
+ private:
+  rtc::Event* const write_allowed_;
+  int* const frames_;
+  bool* const closed_;
+};
+
+VideoFrame CreateFrame() {
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(I420Buffer::Create(2, 2))
+      .build();
+}
+
+TEST(AsyncVideoFrameWriterTest, WritesAllFramesBeforeClosing) {
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  int frames = 0;
+  bool closed = false;
+  AsyncVideoFrameWriter writer(
+      std::make_unique<FakeVideoFrameWriter>(nullptr, &frames, &closed),
+      task_queue_factory.get(), 10);
+  for (int i = 0; i < 5; ++i)
+    EXPECT_TRUE(writer.WriteFrame(CreateFrame()));
+  writer.Close();
+  EXPECT_EQ(frames, 5);
+  EXPECT_TRUE(closed);
+  EXPECT_EQ(writer.GetStats().frames_written, 5);
+  EXPECT_EQ(writer.GetStats().frames_dropped, 0);
+  EXPECT_FALSE(writer.WriteFrame(CreateFrame()));
+}
+
+TEST(AsyncVideoFrameWriterTest, DropsFramesBeyondQueueSize) {
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  rtc::Event write_allowed(/*manual_reset=*/true, /*initially_signaled=*/false);
+  int frames = 0;
+  bool closed = false;
+  AsyncVideoFrameWriter writer(
+      std::make_unique<FakeVideoFrameWriter>(&write_allowed, &frames, &closed),
+      task_queue_factory.get(), 2);
+  EXPECT_TRUE(writer.WriteFrame(CreateFrame()));
+  EXPECT_TRUE(writer.WriteFrame(CreateFrame()));
+  EXPECT_FALSE(writer.WriteFrame(CreateFrame()));
+  write_allowed.Set();
+  writer.Close();
+  EXPECT_EQ(frames, 2);
+  EXPECT_EQ(writer.GetStats().frames_written, 2);
+  EXPECT_EQ(writer.GetStats().frames_dropped, 1);
+}
+
+TEST(AsyncWavFileWriterTest, WritesAllSamples) {
+  const int kSamplingFrequencyInHz = 8000;
+  const size_t kSamplesPerFrame =
+      TestAudioDeviceModule::SamplesPerFrame(kSamplingFrequencyInHz);
+  const std::string filename =
+      TempFilename(OutputPath(), "async_wav_file_writer");
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  {
+    AsyncWavFileWriter writer(filename, kSamplingFrequencyInHz, 1,
+                              task_queue_factory.get(), /*batch_frames=*/3);
+    std::vector<int16_t> frame(kSamplesPerFrame);
+    for (int i = 0; i < 7; ++i) {
+      std::fill(frame.begin(), frame.end(), i);
+      EXPECT_TRUE(writer.Render(frame));
+    }
+  }
+  WavReader reader(filename);
+  std::vector<int16_t> samples(8 * kSamplesPerFrame);
+  ASSERT_EQ(reader.ReadSamples(samples.size(), samples.data()),
+            7 * kSamplesPerFrame);
+  for (int i = 0; i < 7; ++i)
+    EXPECT_EQ(samples[i * kSamplesPerFrame], i);
+  RemoveFile(filename);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/testsupport/streaming_yuv_frame_generator.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <utility>
+
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr char kY4mFileSignature[] = "YUV4MPEG2 ";
+constexpr char kY4mFrameSignature[] = "FRAME";
+// Headers are short, but may carry optional parameters.
+constexpr size_t kMaxY4mHeaderSize = 256;
+
+// Reads a line into |line|, returns false at the end of the file or if the
+// line doesn't fit.
+bool ReadLine(FILE* file, char (&line)[kMaxY4mHeaderSize]) {
+  return fgets(line, sizeof(line), file) && strchr(line, '\n');
+}
+
+}  // namespace
+
+StreamingYuvFrameGenerator::StreamingYuvFrameGenerator(
+    const std::string& filename,
+    size_t width,
+    size_t height,
+    int frame_repeat_count,
+    size_t prefetch_frames)
+    : file_(fopen(filename.c_str(), "rb")),
+      width_(width),
+      height_(height),
+      first_frame_offset_(ReadHeader()),
+      frame_display_count_(frame_repeat_count),
+      prefetch_frames_(prefetch_frames),
+      read_thread_(&StreamingYuvFrameGenerator::ReadLoop,
+                   this,
+                   "YuvFilePrefetch",
+                   rtc::kHighPriority) {
+  RTC_CHECK(file_) << "Couldn't open " << filename;
+  RTC_CHECK_GT(width_, 0) << "Missing frame width for " << filename;
+  RTC_CHECK_GT(height_, 0) << "Missing frame height for " << filename;
+  RTC_DCHECK_GT(frame_repeat_count, 0);
+  RTC_DCHECK_GT(prefetch_frames, 0);
+  read_thread_.Start();
+}
+
+StreamingYuvFrameGenerator::~StreamingYuvFrameGenerator() {
+  {
+    rtc::CritScope lock(&crit_);
+    stopped_ = true;
+  }
+  frame_taken_.Set();
+  read_thread_.Stop();
+  fclose(file_);
+  if (stalls() > 0)
+    RTC_LOG(LS_WARNING) << stalls() << " frames were late from the disk";
+}
+
+FrameGeneratorInterface::VideoFrameData
+StreamingYuvFrameGenerator::NextFrame() {
+  // Empty update by default.
+  VideoFrame::UpdateRect update_rect{0, 0, 0, 0};
+  if (current_display_count_ == 0) {
+    bool stalled = false;
+    while (true) {
+      {
+        rtc::CritScope lock(&crit_);
+        if (!frames_.empty()) {
+          last_frame_ = std::move(frames_.front());
+          frames_.pop_front();
+          // The first frame is always waited for.
+          if (stalled && frames_taken_ > 0)
+            ++stalls_;
+          ++frames_taken_;
+          break;
+        }
+      }
+      stalled = true;
+      frame_read_.Wait(rtc::Event::kForever);
+    }
+    frame_taken_.Set();
+    update_rect = VideoFrame::UpdateRect{0, 0, static_cast<int>(width_),
+                                         static_cast<int>(height_)};
+  }
+  if (++current_display_count_ >= frame_display_count_)
+    current_display_count_ = 0;
+
+  return VideoFrameData(last_frame_, update_rect);
+}
+
+int StreamingYuvFrameGenerator::stalls() const {
+  rtc::CritScope lock(&crit_);
+  return stalls_;
+}
+
+long StreamingYuvFrameGenerator::ReadHeader() {
+  if (!file_)
+    return 0;
+  char line[kMaxY4mHeaderSize];
+  if (!ReadLine(file_, line) ||
+      strncmp(line, kY4mFileSignature, strlen(kY4mFileSignature)) != 0) {
+    // Plain yuv file.
+    rewind(file_);
+    return 0;
+  }
+  y4m_ = true;
+  // Parameters are space separated, each starting with a one letter tag.
+  const char* parameter = line + strlen(kY4mFileSignature);
+  while (*parameter) {
+    switch (parameter[0]) {
+      case 'W':
+        width_ = strtoul(parameter + 1, nullptr, 10);
+        break;
+      case 'H':
+        height_ = strtoul(parameter + 1, nullptr, 10);
+        break;
+      case 'C':
+        RTC_CHECK_EQ(strncmp(parameter + 1, "420", 3), 0)
+            << "Unsupported y4m color space";
+        break;
+    }
+    parameter += strcspn(parameter, " \n");
+    parameter += strspn(parameter, " \n");
+  }
+  return ftell(file_);
+}
+
+void StreamingYuvFrameGenerator::ReadFrame(I420Buffer* buffer) {
+  if (ReadFrameData(buffer))
+    return;
+  // No more frames, start over.
+  fseek(file_, first_frame_offset_, SEEK_SET);
+  RTC_CHECK(ReadFrameData(buffer)) << "No complete frame in the file";
+}
+
+bool StreamingYuvFrameGenerator::ReadFrameData(I420Buffer* buffer) {
+  if (y4m_) {
+    char line[kMaxY4mHeaderSize];
+    if (!ReadLine(file_, line) ||
+        strncmp(line, kY4mFrameSignature, strlen(kY4mFrameSignature)) != 0) {
+      return false;
+    }
+  }
+  // Pool buffers have no padding between rows.
+  RTC_DCHECK_EQ(buffer->StrideY(), buffer->width());
+  RTC_DCHECK_EQ(buffer->StrideU(), buffer->ChromaWidth());
+  RTC_DCHECK_EQ(buffer->StrideV(), buffer->ChromaWidth());
+  size_t size_y = static_cast<size_t>(buffer->width()) * buffer->height();
+  size_t size_uv =
+      static_cast<size_t>(buffer->ChromaWidth()) * buffer->ChromaHeight();
+  return fread(buffer->MutableDataY(), 1, size_y, file_) == size_y &&
+         fread(buffer->MutableDataU(), 1, size_uv, file_) == size_uv &&
+         fread(buffer->MutableDataV(), 1, size_uv, file_) == size_uv;
+}
+
+void StreamingYuvFrameGenerator::ReadLoop(void* obj) {
+  static_cast<StreamingYuvFrameGenerator*>(obj)->Read();
+}
+
+void StreamingYuvFrameGenerator::Read() {
+  while (true) {
+    bool full;
+    {
+      rtc::CritScope lock(&crit_);
+      if (stopped_)
+        return;
+      full = frames_.size() >= prefetch_frames_;
+    }
+    if (full) {
+      frame_taken_.Wait(rtc::Event::kForever);
+      continue;
+    }
+    rtc::scoped_refptr<I420Buffer> buffer = buffer_pool_.CreateBuffer(
+        static_cast<int>(width_), static_cast<int>(height_));
+    ReadFrame(buffer.get());
+    {
+      rtc::CritScope lock(&crit_);
+      frames_.push_back(std::move(buffer));
+    }
+    frame_read_.Set();
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
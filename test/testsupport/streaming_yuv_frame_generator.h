@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_TESTSUPPORT_STREAMING_YUV_FRAME_GENERATOR_H_
+#define TEST_TESTSUPPORT_STREAMING_YUV_FRAME_GENERATOR_H_
+
+#include <stdio.h>
+
+#include <deque>
+#include <string>
+
+#include "api/scoped_refptr.h"
+#include "api/test/frame_generator_interface.h"
+#include "api/video/i420_buffer.h"
+#include "common_video/include/i420_buffer_pool.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace test {
+
+// Repeatedly plays a yuv or y4m file, like YuvFileGenerator, but reads the
+// frames ahead on a thread of its own, so that NextFrame() doesn't wait for
+// the disk. Up to |prefetch_frames| frames are read ahead, into buffers
+// recycled from a pool, so that reading doesn't allocate either.
+//
+// The file is a y4m file if it starts with a y4m header, whose frame size
+// then overrides |width| and |height|. Only 4:2:0 y4m files are supported.
+// NextFrame() must be called from one thread at a time.
+class StreamingYuvFrameGenerator : public FrameGeneratorInterface {
+ public:
+  StreamingYuvFrameGenerator(const std::string& filename,
+                             size_t width,
+                             size_t height,
+                             int frame_repeat_count,
+                             size_t prefetch_frames);
+  ~StreamingYuvFrameGenerator() override;
+
+  VideoFrameData NextFrame() override;
+  void ChangeResolution(size_t width, size_t height) override {
+    RTC_NOTREACHED();
+  }
+
+  // Number of frames NextFrame() had to wait for.
+  int stalls() const;
+
+ private:
+  // Parses the y4m file header, if any, and returns the offset of the first
+  // frame.
+  long ReadHeader();
+  // Reads the next frame into |buffer|, starting over at the end of the file.
+  void ReadFrame(I420Buffer* buffer);
+  bool ReadFrameData(I420Buffer* buffer);
+  static void ReadLoop(void* obj);
+  void Read();
+
+  FILE* const file_;
+  size_t width_;
+  size_t height_;
+  bool y4m_ = false;
+  const long first_frame_offset_;
+  const int frame_display_count_;
+  const size_t prefetch_frames_;
+  int current_display_count_ = 0;
+  // Only used on the reading thread.
+  I420BufferPool buffer_pool_;
+  rtc::scoped_refptr<I420Buffer> last_frame_;
+
+  mutable rtc::CriticalSection crit_;
+  std::deque<rtc::scoped_refptr<I420Buffer>> frames_ RTC_GUARDED_BY(crit_);
+  bool stopped_ RTC_GUARDED_BY(crit_) = false;
+  int frames_taken_ RTC_GUARDED_BY(crit_) = 0;
+  int stalls_ RTC_GUARDED_BY(crit_) = 0;
+  // Set when a frame is read and when one is taken, respectively.
+  rtc::Event frame_read_;
+  rtc::Event frame_taken_;
+  rtc::PlatformThread read_thread_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_TESTSUPPORT_STREAMING_YUV_FRAME_GENERATOR_H_
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/testsupport/streaming_yuv_frame_generator.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "api/video/video_frame_buffer.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kWidth = 4;
+constexpr int kHeight = 2;
+constexpr size_t kFrameSize = kWidth * kHeight * 3 / 2;
+
+class StreamingYuvFrameGeneratorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    filename_ = TempFilename(OutputPath(), "streaming_yuv_frame_generator");
+  }
+  void TearDown() override { RemoveFile(filename_); }
+
+  // Writes frames filled with |values|, with y4m headers if |header| isn't
+  // empty.
+  void WriteFile(const std::string& header,
+                 const std::vector<uint8_t>& values) {
+    FILE* file = fopen(filename_.c_str(), "wb");
+    ASSERT_TRUE(file);
+    fputs(header.c_str(), file);
+    for (uint8_t value : values) {
+      if (!header.empty())
+        fputs("FRAME\n", file);
+      std::vector<uint8_t> frame(kFrameSize, value);
+      fwrite(frame.data(), 1, frame.size(), file);
+    }
+    fclose(file);
+  }
+
+  static uint8_t FirstPixel(const FrameGeneratorInterface::VideoFrameData& f) {
+    return f.buffer->ToI420()->DataY()[0];
+  }
+
+  std::string filename_;
+};
+
+TEST_F(StreamingYuvFrameGeneratorTest, PlaysYuvFileInLoop) {
+  WriteFile("", {1, 2, 3});
+  StreamingYuvFrameGenerator generator(filename_, kWidth, kHeight, 1, 2);
+  for (uint8_t expected : {1, 2, 3, 1, 2, 3, 1}) {
+    FrameGeneratorInterface::VideoFrameData frame = generator.NextFrame();
+    EXPECT_EQ(kWidth, frame.buffer->width());
+    EXPECT_EQ(kHeight, frame.buffer->height());
+    EXPECT_EQ(expected, FirstPixel(frame));
+    const I420BufferInterface* i420 = frame.buffer->GetI420();
+    ASSERT_TRUE(i420);
+    EXPECT_EQ(expected, i420->DataV()[i420->ChromaWidth() - 1]);
+  }
+}
+
+TEST_F(StreamingYuvFrameGeneratorTest, ReadsFrameSizeFromY4mHeader) {
+  WriteFile("YUV4MPEG2 W4 H2 F30:1 Ip A0:0 C420jpeg\n", {5, 6});
+  StreamingYuvFrameGenerator generator(filename_, 0, 0, 1, 1);
+  for (uint8_t expected : {5, 6, 5, 6}) {
+    FrameGeneratorInterface::VideoFrameData frame = generator.NextFrame();
+    EXPECT_EQ(kWidth, frame.buffer->width());
+    EXPECT_EQ(kHeight, frame.buffer->height());
+    EXPECT_EQ(expected, FirstPixel(frame));
+  }
+}
+
+TEST_F(StreamingYuvFrameGeneratorTest, RepeatsFrames) {
+  WriteFile("", {1, 2});
+  StreamingYuvFrameGenerator generator(filename_, kWidth, kHeight, 2, 3);
+  for (uint8_t expected : {1, 1, 2, 2, 1}) {
+    FrameGeneratorInterface::VideoFrameData frame = generator.NextFrame();
+    EXPECT_EQ(expected, FirstPixel(frame));
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
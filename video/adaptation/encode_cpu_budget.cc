@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/adaptation/encode_cpu_budget.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "system_wrappers/include/field_trial.h"
+
+namespace webrtc {
+
+namespace {
+
+EncodeCpuBudget* CreateProcessWideBudget() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<int> low_percent("low", 60);
+  FieldTrialParameter<int> high_percent("high", 85);
+  ParseFieldTrial({&enabled, &low_percent, &high_percent},
+                  field_trial::FindFullName("WebRTC-EncodeCpuBudget"));
+  if (!enabled)
+    return nullptr;
+  if (low_percent.Get() <= 0 || high_percent.Get() < low_percent.Get()) {
+    RTC_LOG(LS_WARNING) << "Invalid encode CPU budget, low: "
+                        << low_percent.Get()
+                        << " high: " << high_percent.Get();
+    return nullptr;
+  }
+  const int num_cores = CpuInfo::DetectNumberOfCores();
+  RTC_LOG(LS_INFO) << "Using a process-wide encode CPU budget for "
+                   << num_cores << " cores, low: " << low_percent.Get()
+                   << " high: " << high_percent.Get();
+  return new EncodeCpuBudget(num_cores, low_percent.Get(), high_percent.Get());
+}
+
+}  // namespace
+
+EncodeCpuBudget::EncodeCpuBudget(int num_cores,
+                                 int low_usage_percent_per_core,
+                                 int high_usage_percent_per_core)
+    : low_budget_percent_(num_cores * low_usage_percent_per_core),
+      high_budget_percent_(num_cores * high_usage_percent_per_core) {
+  RTC_DCHECK_GT(num_cores, 0);
+  RTC_DCHECK_LE(low_usage_percent_per_core, high_usage_percent_per_core);
+}
+
+EncodeCpuBudget::~EncodeCpuBudget() = default;
+
+EncodeCpuBudget* EncodeCpuBudget::GetProcessWide() {
+  // Never destroyed, since encoders of any call may use it until exit.
+  static EncodeCpuBudget* const budget = CreateProcessWideBudget();
+  return budget;
+}
+
+int EncodeCpuBudget::AddStream() {
+  rtc::CritScope lock(&crit_);
+  const int stream_id = next_stream_id_++;
+  usage_percent_[stream_id] = 0;
+  return stream_id;
+}
+
+void EncodeCpuBudget::RemoveStream(int stream_id) {
+  rtc::CritScope lock(&crit_);
+  usage_percent_.erase(stream_id);
+}
+
+void EncodeCpuBudget::OnUsageMeasured(int stream_id, int usage_percent) {
+  rtc::CritScope lock(&crit_);
+  auto it = usage_percent_.find(stream_id);
+  RTC_DCHECK(it != usage_percent_.end());
+  if (it != usage_percent_.end())
+    it->second = usage_percent;
+}
+
+bool EncodeCpuBudget::IsOverBudget(int stream_id) const {
+  rtc::CritScope lock(&crit_);
+  if (TotalUsage() <= high_budget_percent_)
+    return false;
+  // At least one stream uses more than its fair share when the total is over
+  // budget.
+  const int num_streams = static_cast<int>(usage_percent_.size());
+  return Usage(stream_id) * num_streams >= high_budget_percent_;
+}
+
+bool EncodeCpuBudget::CanIncreaseUsage(int stream_id) const {
+  rtc::CritScope lock(&crit_);
+  const int total_usage = TotalUsage();
+  if (total_usage < low_budget_percent_)
+    return true;
+  if (total_usage >= high_budget_percent_)
+    return false;
+  // Between the budgets, only the streams below their fair share may grow, at
+  // the expense of the others.
+  const int num_streams = static_cast<int>(usage_percent_.size());
+  return Usage(stream_id) * num_streams < low_budget_percent_;
+}
+
+int EncodeCpuBudget::TotalUsage() const {
+  int total_usage = 0;
+  for (const auto& stream : usage_percent_)
+    total_usage += stream.second;
+  return total_usage;
+}
+
+int EncodeCpuBudget::Usage(int stream_id) const {
+  auto it = usage_percent_.find(stream_id);
+  return it != usage_percent_.end() ? it->second : 0;
+}
+
+}  // namespace webrtc
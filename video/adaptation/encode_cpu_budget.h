@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_ADAPTATION_ENCODE_CPU_BUDGET_H_
+#define VIDEO_ADAPTATION_ENCODE_CPU_BUDGET_H_
+
+#include <map>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Budgets the encode CPU usage of all the video streams that share it, so that
+// the streams of different calls in a process adapt as a whole instead of each
+// reacting to the load caused by the others. The usage of a stream is its
+// encode usage percent as measured by OveruseFrameDetector, i.e. the percent
+// of one core it keeps busy. When the total usage exceeds the high budget, the
+// streams using more than their fair share of it are asked to adapt down.
+// Streams may only adapt up while the total usage is below the low budget, or
+// while they use less than their fair share of it.
+//
+// Methods can be called from any thread.
+class EncodeCpuBudget {
+ public:
+  // The budgets are |num_cores| times the given percent of one core.
+  EncodeCpuBudget(int num_cores,
+                  int low_usage_percent_per_core,
+                  int high_usage_percent_per_core);
+  ~EncodeCpuBudget();
+
+  // Returns the budget shared by all streams in the process, if enabled with
+  // the "WebRTC-EncodeCpuBudget" field trial, otherwise null.
+  static EncodeCpuBudget* GetProcessWide();
+
+  // Returns an id for a new stream, which counts towards the total usage once
+  // its usage is measured.
+  int AddStream();
+  void RemoveStream(int stream_id);
+
+  void OnUsageMeasured(int stream_id, int usage_percent);
+
+  // Returns true if the total usage exceeds the high budget and |stream_id|
+  // uses at least its fair share of it.
+  bool IsOverBudget(int stream_id) const;
+  // Returns true if |stream_id| may increase its usage.
+  bool CanIncreaseUsage(int stream_id) const;
+
+  int low_budget_percent() const { return low_budget_percent_; }
+  int high_budget_percent() const { return high_budget_percent_; }
+
+ private:
+  int TotalUsage() const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  int Usage(int stream_id) const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  const int low_budget_percent_;
+  const int high_budget_percent_;
+  rtc::CriticalSection crit_;
+  int next_stream_id_ RTC_GUARDED_BY(crit_) = 0;
+  // The last measured usage of each stream, or 0 before the first measurement.
+  std::map<int, int> usage_percent_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_ADAPTATION_ENCODE_CPU_BUDGET_H_
@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/adaptation/encode_cpu_budget.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+constexpr int kNumCores = 2;
+constexpr int kLowPercent = 50;
+constexpr int kHighPercent = 80;
+}  // namespace
+
+TEST(EncodeCpuBudgetTest, BudgetsScaleWithNumberOfCores) {
+  EncodeCpuBudget budget(kNumCores, kLowPercent, kHighPercent);
+  EXPECT_EQ(budget.low_budget_percent(), 100);
+  EXPECT_EQ(budget.high_budget_percent(), 160);
+}
+
+TEST(EncodeCpuBudgetTest, LargestStreamAdaptsDownWhenOverBudget) {
+  EncodeCpuBudget budget(kNumCores, kLowPercent, kHighPercent);
+  const int small = budget.AddStream();
+  const int large = budget.AddStream();
+
+  // No single stream overuses its core, but together they exceed the budget.
+  budget.OnUsageMeasured(small, 60);
+  budget.OnUsageMeasured(large, 75);
+  EXPECT_FALSE(budget.IsOverBudget(small));
+  EXPECT_FALSE(budget.IsOverBudget(large));
+
+  budget.OnUsageMeasured(small, 70);
+  budget.OnUsageMeasured(large, 95);
+  EXPECT_FALSE(budget.IsOverBudget(small));
+  EXPECT_TRUE(budget.IsOverBudget(large));
+  EXPECT_FALSE(budget.CanIncreaseUsage(small));
+  EXPECT_FALSE(budget.CanIncreaseUsage(large));
+}
+
+TEST(EncodeCpuBudgetTest, OnlySmallStreamsGrowBetweenBudgets) {
+  EncodeCpuBudget budget(kNumCores, kLowPercent, kHighPercent);
+  const int small = budget.AddStream();
+  const int large = budget.AddStream();
+
+  budget.OnUsageMeasured(small, 20);
+  budget.OnUsageMeasured(large, 60);
+  EXPECT_TRUE(budget.CanIncreaseUsage(small));
+  EXPECT_TRUE(budget.CanIncreaseUsage(large));
+
+  budget.OnUsageMeasured(small, 30);
+  budget.OnUsageMeasured(large, 90);
+  EXPECT_TRUE(budget.CanIncreaseUsage(small));
+  EXPECT_FALSE(budget.CanIncreaseUsage(large));
+}
+
+TEST(EncodeCpuBudgetTest, RemovedStreamsDontCount) {
+  EncodeCpuBudget budget(kNumCores, kLowPercent, kHighPercent);
+  const int stream = budget.AddStream();
+  const int other_stream = budget.AddStream();
+  budget.OnUsageMeasured(stream, 90);
+  budget.OnUsageMeasured(other_stream, 90);
+  EXPECT_TRUE(budget.IsOverBudget(stream));
+
+  budget.RemoveStream(other_stream);
+  EXPECT_FALSE(budget.IsOverBudget(stream));
+  EXPECT_TRUE(budget.CanIncreaseUsage(stream));
+}
+
+}  // namespace webrtc
@@ -518,6 +518,11 @@ OveruseFrameDetector::CreateProcessingUsage(const CpuOveruseOptions& options) {
 
 OveruseFrameDetector::OveruseFrameDetector(
     CpuOveruseMetricsObserver* metrics_observer)
+    : OveruseFrameDetector(metrics_observer, nullptr) {}
+
+OveruseFrameDetector::OveruseFrameDetector(
+    CpuOveruseMetricsObserver* metrics_observer,
+    EncodeCpuBudget* cpu_budget)
     : metrics_observer_(metrics_observer),
       num_process_times_(0),
       // TODO(nisse): Use absl::optional
@@ -529,13 +534,18 @@ OveruseFrameDetector::OveruseFrameDetector(
       num_overuse_detections_(0),
       last_rampup_time_ms_(-1),
       in_quick_rampup_(false),
-      current_rampup_delay_ms_(kStandardRampUpDelayMs) {
+      current_rampup_delay_ms_(kStandardRampUpDelayMs),
+      cpu_budget_(cpu_budget),
+      cpu_budget_stream_id_(cpu_budget ? cpu_budget->AddStream() : -1) {
   task_checker_.Detach();
   ParseFieldTrial({&filter_time_constant_},
                   field_trial::FindFullName("WebRTC-CpuLoadEstimator"));
 }
 
-OveruseFrameDetector::~OveruseFrameDetector() {}
+OveruseFrameDetector::~OveruseFrameDetector() {
+  if (cpu_budget_)
+    cpu_budget_->RemoveStream(cpu_budget_stream_id_);
+}
 
 void OveruseFrameDetector::StartCheckForOveruse(
     TaskQueueBase* task_queue_base,
@@ -556,6 +566,9 @@ void OveruseFrameDetector::StartCheckForOveruse(
 void OveruseFrameDetector::StopCheckForOveruse() {
   RTC_DCHECK_RUN_ON(&task_checker_);
   check_overuse_task_.Stop();
+  // A stopped stream doesn't load the CPU.
+  if (cpu_budget_)
+    cpu_budget_->OnUsageMeasured(cpu_budget_stream_id_, 0);
 }
 
 void OveruseFrameDetector::EncodedFrameTimeMeasured(int encode_duration_ms) {
@@ -640,6 +653,9 @@ void OveruseFrameDetector::CheckForOveruse(
 
   int64_t now_ms = rtc::TimeMillis();
 
+  if (cpu_budget_)
+    cpu_budget_->OnUsageMeasured(cpu_budget_stream_id_, *encode_usage_percent_);
+
   if (IsOverusing(*encode_usage_percent_)) {
     // If the last thing we did was going up, and now have to back down, we need
     // to check if this peak was short. If so we should back off to avoid going
@@ -697,7 +713,8 @@ void OveruseFrameDetector::SetOptions(const CpuOveruseOptions& options) {
 bool OveruseFrameDetector::IsOverusing(int usage_percent) {
   RTC_DCHECK_RUN_ON(&task_checker_);
 
-  if (usage_percent >= options_.high_encode_usage_threshold_percent) {
+  if (usage_percent >= options_.high_encode_usage_threshold_percent ||
+      (cpu_budget_ && cpu_budget_->IsOverBudget(cpu_budget_stream_id_))) {
     ++checks_above_threshold_;
   } else {
     checks_above_threshold_ = 0;
@@ -711,6 +728,8 @@ bool OveruseFrameDetector::IsUnderusing(int usage_percent, int64_t time_now) {
   if (time_now < last_rampup_time_ms_ + delay)
     return false;
 
+  if (cpu_budget_ && !cpu_budget_->CanIncreaseUsage(cpu_budget_stream_id_))
+    return false;
   return usage_percent < options_.low_encode_usage_threshold_percent;
 }
 }  // namespace webrtc
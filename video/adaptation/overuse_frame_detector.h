@@ -23,6 +23,7 @@
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread_annotations.h"
+#include "video/adaptation/encode_cpu_budget.h"
 
 namespace webrtc {
 
@@ -65,6 +66,11 @@ class OveruseFrameDetectorObserverInterface {
 class OveruseFrameDetector {
  public:
   explicit OveruseFrameDetector(CpuOveruseMetricsObserver* metrics_observer);
+  // If |cpu_budget| is not null, overuse is also detected when the streams
+  // sharing it exceed the budget, and underuse only while it allows this
+  // stream to grow. |cpu_budget| must outlive this object.
+  OveruseFrameDetector(CpuOveruseMetricsObserver* metrics_observer,
+                       EncodeCpuBudget* cpu_budget);
   virtual ~OveruseFrameDetector();
 
   // Start to periodically check for overuse.
@@ -158,6 +164,10 @@ class OveruseFrameDetector {
 
   std::unique_ptr<ProcessingUsage> usage_ RTC_PT_GUARDED_BY(task_checker_);
 
+  EncodeCpuBudget* const cpu_budget_;
+  // The id of this stream in |cpu_budget_|, if set.
+  const int cpu_budget_stream_id_;
+
   // If set by field trial, overrides CpuOveruseOptions::filter_time_ms.
   FieldTrialOptional<TimeDelta> filter_time_constant_{"tau"};
 
@@ -20,6 +20,7 @@
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/random.h"
 #include "rtc_base/task_queue_for_test.h"
+#include "video/adaptation/encode_cpu_budget.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -62,6 +63,9 @@ class OveruseFrameDetectorUnderTest : public OveruseFrameDetector {
   explicit OveruseFrameDetectorUnderTest(
       CpuOveruseMetricsObserver* metrics_observer)
       : OveruseFrameDetector(metrics_observer) {}
+  OveruseFrameDetectorUnderTest(CpuOveruseMetricsObserver* metrics_observer,
+                                EncodeCpuBudget* cpu_budget)
+      : OveruseFrameDetector(metrics_observer, cpu_budget) {}
   ~OveruseFrameDetectorUnderTest() {}
 
   using OveruseFrameDetector::CheckForOveruse;
@@ -230,6 +234,9 @@ class OveruseFrameDetectorTest : public ::testing::Test,
   rtc::ScopedFakeClock clock_;
   MockCpuOveruseObserver mock_observer_;
   OveruseFrameDetectorObserverInterface* observer_;
+  // Shared with another stream by the tests that use it, must outlive
+  // |overuse_detector_|.
+  EncodeCpuBudget cpu_budget_{/*num_cores=*/1, /*low=*/50, /*high=*/80};
   std::unique_ptr<OveruseFrameDetectorUnderTest> overuse_detector_;
   int encode_usage_percent_ = -1;
 };
@@ -262,6 +269,42 @@ TEST_F(OveruseFrameDetectorTest, DoubleOveruseAndRecover) {
   TriggerUnderuse();
 }
 
+TEST_F(OveruseFrameDetectorTest, OverusesSharedBudget) {
+  overuse_detector_ =
+      std::make_unique<OveruseFrameDetectorUnderTest>(this, &cpu_budget_);
+  overuse_detector_->SetOptions(options_);
+  const int other_stream = cpu_budget_.AddStream();
+  cpu_budget_.OnUsageMeasured(other_stream, 50);
+
+  // The usage of this stream alone is below the high threshold, but the
+  // streams together exceed the budget.
+  const int kDelayUs = 20 * rtc::kNumMicrosecsPerMillisec;
+  EXPECT_CALL(mock_observer_, AdaptDown()).Times(1);
+  for (int i = 0; i < options_.high_threshold_consecutive_count; ++i) {
+    InsertAndSendFramesWithInterval(1000, kFrameIntervalUs, kWidth, kHeight,
+                                    kDelayUs);
+    overuse_detector_->CheckForOveruse(observer_);
+  }
+  EXPECT_LT(UsagePercent(), options_.high_encode_usage_threshold_percent);
+}
+
+TEST_F(OveruseFrameDetectorTest, NoUnderuseWhileSharedBudgetIsUsed) {
+  overuse_detector_ =
+      std::make_unique<OveruseFrameDetectorUnderTest>(this, &cpu_budget_);
+  overuse_detector_->SetOptions(options_);
+  const int other_stream = cpu_budget_.AddStream();
+  cpu_budget_.OnUsageMeasured(other_stream, 80);
+
+  EXPECT_CALL(mock_observer_, AdaptDown()).Times(0);
+  EXPECT_CALL(mock_observer_, AdaptUp()).Times(0);
+  TriggerUnderuse();
+
+  // Once the other stream stops, this stream may grow again.
+  cpu_budget_.RemoveStream(other_stream);
+  EXPECT_CALL(mock_observer_, AdaptUp()).Times(1);
+  overuse_detector_->CheckForOveruse(observer_);
+}
+
 TEST_F(OveruseFrameDetectorTest, TriggerUnderuseWithMinProcessCount) {
   const int kProcessIntervalUs = 5 * rtc::kNumMicrosecsPerSec;
   options_.min_process_count = 1;
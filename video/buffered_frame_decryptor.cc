@@ -67,26 +67,17 @@ BufferedFrameDecryptor::FrameDecision BufferedFrameDecryptor::DecryptFrame(
     RTC_LOG(LS_ERROR) << "No generic frame descriptor found dropping frame.";
     return FrameDecision::kDrop;
   }
-  // Retrieve the maximum possible size of the decrypted payload.
-  const size_t max_plaintext_byte_size =
-      frame_decryptor_->GetMaxPlaintextByteSize(cricket::MEDIA_TYPE_VIDEO,
-                                                frame->size());
-  RTC_CHECK_LE(max_plaintext_byte_size, frame->size());
-  // Place the decrypted frame inline into the existing frame.
-  rtc::ArrayView<uint8_t> inline_decrypted_bitstream(frame->data(),
-                                                     max_plaintext_byte_size);
-
   // Enable authenticating the header if the field trial isn't disabled.
   std::vector<uint8_t> additional_data;
   if (generic_descriptor_auth_experiment_) {
     additional_data = RtpDescriptorAuthentication(frame->GetRtpVideoHeader());
   }
 
-  // Attempt to decrypt the video frame.
+  // Attempt to decrypt the video frame, inline into the existing frame.
   const FrameDecryptorInterface::Result decrypt_result =
-      frame_decryptor_->Decrypt(cricket::MEDIA_TYPE_VIDEO, /*csrcs=*/{},
-                                additional_data, *frame,
-                                inline_decrypted_bitstream);
+      frame_decryptor_->DecryptInPlace(
+          cricket::MEDIA_TYPE_VIDEO, /*csrcs=*/{}, additional_data,
+          rtc::ArrayView<uint8_t>(frame->data(), frame->size()));
   // Optionally call the callback if there was a change in status
   if (decrypt_result.status != last_status_) {
     last_status_ = decrypt_result.status;
@@ -99,7 +90,7 @@ BufferedFrameDecryptor::FrameDecision BufferedFrameDecryptor::DecryptFrame(
     return first_frame_decrypted_ ? FrameDecision::kDrop
                                   : FrameDecision::kStash;
   }
-  RTC_CHECK_LE(decrypt_result.bytes_written, max_plaintext_byte_size);
+  RTC_CHECK_LE(decrypt_result.bytes_written, frame->size());
   // Update the frame to contain just the written bytes.
   frame->set_size(decrypt_result.bytes_written);
 
@@ -75,7 +75,6 @@ CallStats::CallStats(Clock* clock, TaskQueueBase* task_queue)
       time_of_first_rtt_ms_(-1),
       task_queue_(task_queue) {
   RTC_DCHECK(task_queue_);
-  process_thread_checker_.Detach();
   repeating_task_ =
       RepeatingTaskHandle::DelayedStart(task_queue_, kUpdateInterval, [this]() {
         UpdateAndReport();
@@ -135,14 +134,11 @@ int64_t CallStats::LastProcessedRtt() const {
 }
 
 int64_t CallStats::LastProcessedRttFromProcessThread() const {
-  RTC_DCHECK_RUN_ON(&process_thread_checker_);
   rtc::CritScope lock(&avg_rtt_ms_lock_);
   return avg_rtt_ms_;
 }
 
 void CallStats::OnRttUpdate(int64_t rtt) {
-  RTC_DCHECK_RUN_ON(&process_thread_checker_);
-
   int64_t now_ms = clock_->TimeInMilliseconds();
   task_queue_->PostTask(ToQueuedTask(task_safety_, [this, rtt, now_ms]() {
     RTC_DCHECK_RUN_ON(&construction_thread_checker_);
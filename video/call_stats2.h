@@ -68,7 +68,9 @@ class CallStats {
   };
 
  private:
-  // Part of the RtcpRttStats implementation. Called by RtcpRttStatsImpl.
+  // Part of the RtcpRttStats implementation. Called by RtcpRttStatsImpl, from
+  // the process thread and from the task queues of the rtp modules doing their
+  // periodic work on one.
   void OnRttUpdate(int64_t rtt);
   int64_t LastProcessedRttFromProcessThread() const;
 
@@ -80,24 +82,17 @@ class CallStats {
 
   class RtcpRttStatsImpl : public RtcpRttStats {
    public:
-    explicit RtcpRttStatsImpl(CallStats* owner) : owner_(owner) {
-      process_thread_checker_.Detach();
-    }
+    explicit RtcpRttStatsImpl(CallStats* owner) : owner_(owner) {}
     ~RtcpRttStatsImpl() override = default;
 
    private:
-    void OnRttUpdate(int64_t rtt) override {
-      RTC_DCHECK_RUN_ON(&process_thread_checker_);
-      owner_->OnRttUpdate(rtt);
-    }
+    void OnRttUpdate(int64_t rtt) override { owner_->OnRttUpdate(rtt); }
 
     int64_t LastProcessedRtt() const override {
-      RTC_DCHECK_RUN_ON(&process_thread_checker_);
       return owner_->LastProcessedRttFromProcessThread();
     }
 
     CallStats* const owner_;
-    SequenceChecker process_thread_checker_;
   } rtcp_rtt_stats_impl_{this};
 
   Clock* const clock_;
@@ -137,7 +132,6 @@ class CallStats {
   std::list<CallStatsObserver*> observers_;
 
   SequenceChecker construction_thread_checker_;
-  SequenceChecker process_thread_checker_;
   TaskQueueBase* const task_queue_;
 
   // Used to signal destruction to potentially pending tasks.
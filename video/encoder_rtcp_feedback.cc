@@ -37,7 +37,7 @@ EncoderRtcpFeedback::EncoderRtcpFeedback(Clock* clock,
 }
 
 void EncoderRtcpFeedback::SetRtpVideoSender(
-    const RtpVideoSenderInterface* rtp_video_sender) {
+    RtpVideoSenderInterface* rtp_video_sender) {
   RTC_DCHECK(rtp_video_sender);
   RTC_DCHECK(!rtp_video_sender_);
   rtp_video_sender_ = rtp_video_sender;
@@ -63,6 +63,11 @@ void EncoderRtcpFeedback::OnReceivedIntraFrameRequest(uint32_t ssrc) {
     time_last_intra_request_ms_ = now_ms;
   }
 
+  // The receiver may recover from the last key frame sent on |ssrc|, which
+  // doesn't need to be encoded again.
+  if (rtp_video_sender_ && rtp_video_sender_->RetransmitKeyFrameChain(ssrc))
+    return;
+
   // Always produce key frame for all streams.
   video_stream_encoder_->SendKeyFrame();
 }
@@ -32,7 +32,7 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver,
                       VideoStreamEncoderInterface* encoder);
   ~EncoderRtcpFeedback() override = default;
 
-  void SetRtpVideoSender(const RtpVideoSenderInterface* rtp_video_sender);
+  void SetRtpVideoSender(RtpVideoSenderInterface* rtp_video_sender);
 
   void OnReceivedIntraFrameRequest(uint32_t ssrc) override;
 
@@ -47,7 +47,7 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver,
 
   Clock* const clock_;
   const std::vector<uint32_t> ssrcs_;
-  const RtpVideoSenderInterface* rtp_video_sender_;
+  RtpVideoSenderInterface* rtp_video_sender_;
   VideoStreamEncoderInterface* const video_stream_encoder_;
 
   rtc::CriticalSection crit_;
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_timing_log.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/strings/string_builder.h"
+
+namespace webrtc {
+namespace {
+
+// Frames decoded but not rendered yet. Beyond this, the oldest are written out
+// as not rendered.
+constexpr size_t kMaxPendingFrames = 128;
+// Only every kSampleStep-th pixel of every kSampleStep-th row counts in the
+// fingerprint, which is enough for averages and keeps it cheap.
+constexpr int kSampleStep = 4;
+
+constexpr char kHeader[] =
+    "rtp_timestamp,capture_ntp_ms,first_packet_ms,last_packet_ms,"
+    "decode_start_ms,decode_finish_ms,render_ms,size_bytes,keyframe,qp,width,"
+    "height,fingerprint\n";
+
+}  // namespace
+
+std::unique_ptr<FrameTimingLog> FrameTimingLog::Create(
+    const std::string& path) {
+  FileWrapper file = FileWrapper::OpenWriteOnly(path);
+  if (!file.is_open()) {
+    RTC_LOG(LS_ERROR) << "Failed to open frame timing log " << path;
+    return nullptr;
+  }
+  return std::unique_ptr<FrameTimingLog>(new FrameTimingLog(std::move(file)));
+}
+
+FrameTimingLog::FrameTimingLog(FileWrapper file) : file_(std::move(file)) {
+  file_.Write(kHeader, sizeof(kHeader) - 1);
+}
+
+FrameTimingLog::~FrameTimingLog() {
+  rtc::CritScope lock(&crit_);
+  for (const EncodedFrameInfo& info : pending_frames_)
+    WriteLine(&info, nullptr, -1);
+  file_.Close();
+}
+
+void FrameTimingLog::OnEncodedFrame(uint32_t rtp_timestamp,
+                                    size_t size_bytes,
+                                    bool keyframe,
+                                    int qp) {
+  rtc::CritScope lock(&crit_);
+  if (pending_frames_.size() >= kMaxPendingFrames) {
+    WriteLine(&pending_frames_.front(), nullptr, -1);
+    pending_frames_.pop_front();
+  }
+  pending_frames_.push_back({rtp_timestamp, size_bytes, keyframe, qp});
+}
+
+void FrameTimingLog::OnRenderedFrame(const VideoFrame& frame,
+                                     int64_t render_time_ms) {
+  rtc::CritScope lock(&crit_);
+  auto it = std::find_if(pending_frames_.begin(), pending_frames_.end(),
+                         [&frame](const EncodedFrameInfo& info) {
+                           return info.rtp_timestamp == frame.timestamp();
+                         });
+  if (it == pending_frames_.end()) {
+    WriteLine(nullptr, &frame, render_time_ms);
+    return;
+  }
+  // The frames decoded before this one were dropped.
+  for (; pending_frames_.begin() != it; pending_frames_.pop_front())
+    WriteLine(&pending_frames_.front(), nullptr, -1);
+  WriteLine(&pending_frames_.front(), &frame, render_time_ms);
+  pending_frames_.pop_front();
+}
+
+FrameTimingLog::Fingerprint FrameTimingLog::ComputeFingerprint(
+    const I420BufferInterface& buffer) {
+  Fingerprint fingerprint;
+  const int width = buffer.width();
+  const int height = buffer.height();
+  for (int cell_y = 0; cell_y < kFingerprintSize; ++cell_y) {
+    const int y_begin = cell_y * height / kFingerprintSize;
+    const int y_end =
+        std::max(y_begin + 1, (cell_y + 1) * height / kFingerprintSize);
+    for (int cell_x = 0; cell_x < kFingerprintSize; ++cell_x) {
+      const int x_begin = cell_x * width / kFingerprintSize;
+      const int x_end =
+          std::max(x_begin + 1, (cell_x + 1) * width / kFingerprintSize);
+      int64_t sum = 0;
+      int64_t count = 0;
+      for (int y = y_begin; y < std::min(y_end, height); y += kSampleStep) {
+        const uint8_t* row = buffer.DataY() + y * buffer.StrideY();
+        for (int x = x_begin; x < std::min(x_end, width); x += kSampleStep) {
+          sum += row[x];
+          ++count;
+        }
+      }
+      fingerprint[cell_y * kFingerprintSize + cell_x] =
+          count > 0 ? static_cast<uint8_t>(sum / count) : 0;
+    }
+  }
+  return fingerprint;
+}
+
+void FrameTimingLog::WriteLine(const EncodedFrameInfo* info,
+                               const VideoFrame* frame,
+                               int64_t render_time_ms) {
+  char line[256];
+  rtc::SimpleStringBuilder builder(line);
+  builder << (info ? info->rtp_timestamp : frame->timestamp()) << ",";
+
+  int64_t first_packet_ms = -1;
+  int64_t last_packet_ms = -1;
+  int64_t decode_start_ms = -1;
+  int64_t decode_finish_ms = -1;
+  if (frame) {
+    for (const RtpPacketInfo& packet : frame->packet_infos()) {
+      if (first_packet_ms < 0 || packet.receive_time_ms() < first_packet_ms)
+        first_packet_ms = packet.receive_time_ms();
+      last_packet_ms = std::max(last_packet_ms, packet.receive_time_ms());
+    }
+    if (frame->processing_time()) {
+      decode_start_ms = frame->processing_time()->start.ms();
+      decode_finish_ms = frame->processing_time()->finish.ms();
+    }
+  }
+  builder << (frame && frame->ntp_time_ms() > 0 ? frame->ntp_time_ms() : -1)
+          << "," << first_packet_ms << "," << last_packet_ms << ","
+          << decode_start_ms << "," << decode_finish_ms << ","
+          << render_time_ms << ",";
+
+  if (info) {
+    builder << info->size_bytes << "," << (info->keyframe ? 1 : 0) << ","
+            << info->qp << ",";
+  } else {
+    builder << "-1,-1,-1,";
+  }
+
+  if (frame) {
+    builder << frame->width() << "," << frame->height() << ",";
+    rtc::scoped_refptr<I420BufferInterface> buffer =
+        frame->video_frame_buffer()->ToI420();
+    for (uint8_t value : ComputeFingerprint(*buffer))
+      builder.AppendFormat("%02x", value);
+  } else {
+    builder << "-1,-1,";
+  }
+  builder << "\n";
+  file_.Write(builder.str(), builder.size());
+}
+
+}  // namespace webrtc
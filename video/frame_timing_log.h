@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_FRAME_TIMING_LOG_H_
+#define VIDEO_FRAME_TIMING_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Writes one CSV line per received video frame, so that quality metrics can
+// be computed offline, against the source video, without dumping the decoded
+// frames. The columns are
+//
+//   rtp_timestamp, capture_ntp_ms, first_packet_ms, last_packet_ms,
+//   decode_start_ms, decode_finish_ms, render_ms, size_bytes, keyframe, qp,
+//   width, height, fingerprint
+//
+// with the local times in ms of the receiver's clock, -1 when unknown. Frames
+// that are decoded but never rendered get a line without decode and render
+// times. The fingerprint is the average luma of each cell of a
+// kFingerprintSize x kFingerprintSize grid over the frame, row by row, in
+// hex. Unlike a hash, it survives the coding loss, so offline tools find the
+// source frame of a received one as the one with the closest fingerprint.
+class FrameTimingLog {
+ public:
+  static constexpr int kFingerprintSize = 4;
+  using Fingerprint = std::array<uint8_t, kFingerprintSize * kFingerprintSize>;
+
+  // Returns null if |path| can't be opened.
+  static std::unique_ptr<FrameTimingLog> Create(const std::string& path);
+  ~FrameTimingLog();
+
+  // Called before decoding, |qp| is -1 if unknown.
+  void OnEncodedFrame(uint32_t rtp_timestamp,
+                      size_t size_bytes,
+                      bool keyframe,
+                      int qp);
+  void OnRenderedFrame(const VideoFrame& frame, int64_t render_time_ms);
+
+  static Fingerprint ComputeFingerprint(const I420BufferInterface& buffer);
+
+ private:
+  struct EncodedFrameInfo {
+    uint32_t rtp_timestamp;
+    size_t size_bytes;
+    bool keyframe;
+    int qp;
+  };
+
+  explicit FrameTimingLog(FileWrapper file);
+
+  void WriteLine(const EncodedFrameInfo* info,
+                 const VideoFrame* frame,
+                 int64_t render_time_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  rtc::CriticalSection crit_;
+  FileWrapper file_ RTC_GUARDED_BY(crit_);
+  // Frames waiting to be rendered, in decoding order.
+  std::deque<EncodedFrameInfo> pending_frames_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_FRAME_TIMING_LOG_H_
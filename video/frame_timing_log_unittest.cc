@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_timing_log.h"
+
+#include <string.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "api/video/i420_buffer.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 16;
+constexpr int kHeight = 8;
+
+VideoFrame CreateFrame(uint32_t rtp_timestamp, uint8_t luma) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(kWidth, kHeight);
+  memset(buffer->MutableDataY(), luma, buffer->StrideY() * kHeight);
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_video_frame_buffer(buffer)
+                         .set_timestamp_rtp(rtp_timestamp)
+                         .build();
+  frame.set_processing_time({Timestamp::Millis(10), Timestamp::Millis(12)});
+  return frame;
+}
+
+std::vector<std::string> ReadLines(const std::string& path) {
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(file, line))
+    lines.push_back(line);
+  return lines;
+}
+
+class FrameTimingLogTest : public ::testing::Test {
+ protected:
+  FrameTimingLogTest()
+      : path_(test::TempFilename(test::OutputPath(), "frame_timing_log")) {}
+  ~FrameTimingLogTest() override { test::RemoveFile(path_); }
+
+  const std::string path_;
+};
+
+TEST(FrameTimingLogFingerprintTest, AveragesLumaPerCell) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(kWidth, kHeight);
+  // Left half white, right half black.
+  for (int y = 0; y < kHeight; ++y) {
+    uint8_t* row = buffer->MutableDataY() + y * buffer->StrideY();
+    memset(row, 255, kWidth / 2);
+    memset(row + kWidth / 2, 16, kWidth / 2);
+  }
+  FrameTimingLog::Fingerprint fingerprint =
+      FrameTimingLog::ComputeFingerprint(*buffer);
+  for (int cell_y = 0; cell_y < FrameTimingLog::kFingerprintSize; ++cell_y) {
+    for (int cell_x = 0; cell_x < FrameTimingLog::kFingerprintSize; ++cell_x) {
+      EXPECT_EQ(fingerprint[cell_y * FrameTimingLog::kFingerprintSize + cell_x],
+                cell_x < FrameTimingLog::kFingerprintSize / 2 ? 255 : 16);
+    }
+  }
+}
+
+std::string ExpectedFingerprint(const char* cell) {
+  std::string fingerprint;
+  for (int i = 0; i < FrameTimingLog::kFingerprintSize *
+                          FrameTimingLog::kFingerprintSize;
+       ++i) {
+    fingerprint += cell;
+  }
+  return fingerprint;
+}
+
+TEST_F(FrameTimingLogTest, WritesRenderedFrames) {
+  {
+    std::unique_ptr<FrameTimingLog> log = FrameTimingLog::Create(path_);
+    ASSERT_TRUE(log);
+    log->OnEncodedFrame(3000, 1234, /*keyframe=*/true, 30);
+    log->OnRenderedFrame(CreateFrame(3000, 0x80), 20);
+  }
+  std::vector<std::string> lines = ReadLines(path_);
+  ASSERT_EQ(lines.size(), 2u);
+  EXPECT_EQ(lines[0].rfind("rtp_timestamp,", 0), 0u);
+  EXPECT_EQ(lines[1], "3000,-1,-1,-1,10,12,20,1234,1,30,16,8," +
+                          ExpectedFingerprint("80"));
+}
+
+TEST_F(FrameTimingLogTest, WritesFramesNotRendered) {
+  {
+    std::unique_ptr<FrameTimingLog> log = FrameTimingLog::Create(path_);
+    ASSERT_TRUE(log);
+    log->OnEncodedFrame(3000, 100, /*keyframe=*/true, 30);
+    log->OnEncodedFrame(6000, 200, /*keyframe=*/false, 31);
+    log->OnEncodedFrame(9000, 300, /*keyframe=*/false, -1);
+    // The first frame was dropped, the last is still pending when the log is
+    // destroyed.
+    log->OnRenderedFrame(CreateFrame(6000, 0x10), 40);
+  }
+  std::vector<std::string> lines = ReadLines(path_);
+  ASSERT_EQ(lines.size(), 4u);
+  EXPECT_EQ(lines[1], "3000,-1,-1,-1,-1,-1,-1,100,1,30,-1,-1,");
+  EXPECT_EQ(lines[2], "6000,-1,-1,-1,10,12,40,200,0,31,16,8," +
+                          ExpectedFingerprint("10"));
+  EXPECT_EQ(lines[3], "9000,-1,-1,-1,-1,-1,-1,300,0,-1,-1,-1,");
+}
+
+TEST_F(FrameTimingLogTest, WritesRenderedFramesNotSeenEncoded) {
+  {
+    std::unique_ptr<FrameTimingLog> log = FrameTimingLog::Create(path_);
+    ASSERT_TRUE(log);
+    log->OnRenderedFrame(CreateFrame(3000, 0xff), 20);
+  }
+  std::vector<std::string> lines = ReadLines(path_);
+  ASSERT_EQ(lines.size(), 2u);
+  EXPECT_EQ(lines[1], "3000,-1,-1,-1,10,12,20,-1,-1,-1,16,8," +
+                          ExpectedFingerprint("ff"));
+}
+
+TEST(FrameTimingLogCreateTest, ReturnsNullIfFileCantBeOpened) {
+  EXPECT_FALSE(FrameTimingLog::Create(""));
+}
+
+}  // namespace
+}  // namespace webrtc
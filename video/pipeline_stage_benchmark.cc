@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+#include "test/scenario/stats_collection.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr TimeDelta kRunTime = TimeDelta::Seconds(30);
+// Timing frames are sent every 200 ms, the stats report the slowest of the
+// last second.
+constexpr TimeDelta kStatsInterval = TimeDelta::Millis(200);
+
+struct PipelineConfig {
+  NetworkSimulationConfig network;
+  bool use_ulpfec = false;
+};
+
+void PrintStage(const std::string& test_case,
+                const std::string& stage,
+                SampleStats<TimeDelta>& delays) {
+  EXPECT_FALSE(delays.IsEmpty()) << stage;
+  if (delays.IsEmpty())
+    return;
+  PrintResultMeanAndError(stage + "_delay", "", test_case,
+                          delays.Mean().ms<double>(),
+                          delays.StandardDeviation().ms<double>(), "ms", false,
+                          ImproveDirection::kSmallerIsBetter);
+  PrintResult(stage + "_delay_p95", "", test_case,
+              delays.Quantile(0.95).ms<double>(), "ms", false,
+              ImproveDirection::kSmallerIsBetter);
+}
+
+// Sends VP8 video from a caller to a callee through the full media chain,
+// encoder, packetizer, FEC, pacer, emulated network, depacketizer, jitter
+// buffer and decoder, and reports the time timing frames spent in each stage.
+void RunPipeline(const std::string& test_case, const PipelineConfig& config) {
+  VideoReceiveStatsCollector collector;
+  {
+    Scenario s;
+    CallClient* caller = s.CreateClient("caller", CallClientConfig());
+    CallClient* callee = s.CreateClient("callee", CallClientConfig());
+    auto* route = s.CreateRoutes(
+        caller, {s.CreateSimulationNode(config.network)}, callee,
+        {s.CreateSimulationNode(NetworkSimulationConfig())});
+    VideoStreamPair* video =
+        s.CreateVideoStream(route->forward(), [&](VideoStreamConfig* c) {
+          c->source.generator.width = 1280;
+          c->source.generator.height = 720;
+          c->encoder.codec = VideoStreamConfig::Encoder::Codec::kVideoCodecVP8;
+          c->encoder.implementation =
+              VideoStreamConfig::Encoder::Implementation::kSoftware;
+          c->stream.use_ulpfec = config.use_ulpfec;
+          c->stream.video_timing = true;
+        });
+    s.Every(kStatsInterval, [&] {
+      VideoReceiveStream::Stats stats;
+      ReceiveVideoStream* receive_stream = video->receive();
+      callee->SendTask(
+          [&stats, receive_stream] { stats = receive_stream->GetStats(); });
+      collector.AddStats(stats);
+    });
+    s.RunFor(kRunTime);
+  }
+
+  VideoStageDelayStats& delays = collector.stats().stage_delays;
+  PrintStage(test_case, "encoder_queue", delays.encoder_queue);
+  PrintStage(test_case, "encode", delays.encode);
+  PrintStage(test_case, "packetization", delays.packetization);
+  PrintStage(test_case, "pacing", delays.pacing);
+  PrintStage(test_case, "network", delays.network);
+  PrintStage(test_case, "depacketization", delays.depacketization);
+  PrintStage(test_case, "jitter_buffer", delays.jitter_buffer);
+  PrintStage(test_case, "decode", delays.decode);
+  PrintStage(test_case, "end_to_end", delays.end_to_end);
+}
+
+}  // namespace
+
+TEST(PipelineStageBenchmark, GoodNetwork) {
+  PipelineConfig config;
+  config.network.bandwidth = DataRate::KilobitsPerSec(4000);
+  config.network.delay = TimeDelta::Millis(20);
+  RunPipeline("good_network", config);
+}
+
+TEST(PipelineStageBenchmark, LossyNetworkWithNack) {
+  PipelineConfig config;
+  config.network.bandwidth = DataRate::KilobitsPerSec(2000);
+  config.network.delay = TimeDelta::Millis(50);
+  config.network.loss_rate = 0.02;
+  RunPipeline("lossy_network_nack", config);
+}
+
+TEST(PipelineStageBenchmark, LossyNetworkWithUlpfec) {
+  PipelineConfig config;
+  config.network.bandwidth = DataRate::KilobitsPerSec(2000);
+  config.network.delay = TimeDelta::Millis(50);
+  config.network.loss_rate = 0.02;
+  config.use_ulpfec = true;
+  RunPipeline("lossy_network_ulpfec", config);
+}
+
+TEST(PipelineStageBenchmark, CongestedNetwork) {
+  PipelineConfig config;
+  config.network.bandwidth = DataRate::KilobitsPerSec(500);
+  config.network.delay = TimeDelta::Millis(50);
+  config.network.packet_queue_length_limit = 30;
+  RunPipeline("congested_network", config);
+}
+
+}  // namespace test
+}  // namespace webrtc
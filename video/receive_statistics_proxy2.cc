@@ -971,6 +971,16 @@ void ReceiveStatisticsProxy::OnSyncOffsetUpdated(int64_t video_playout_ntp_ms,
 void ReceiveStatisticsProxy::OnCompleteFrame(bool is_keyframe,
                                              size_t size_bytes,
                                              VideoContentType content_type) {
+  if (!IsCurrentTaskQueueOrThread(worker_thread_)) {
+    // Frames are completed on the receive queue of the stream when it has one
+    // (see Call), rather than on the worker thread.
+    worker_thread_->PostTask(ToQueuedTask(
+        task_safety_, [is_keyframe, size_bytes, content_type, this]() {
+          OnCompleteFrame(is_keyframe, size_bytes, content_type);
+        }));
+    return;
+  }
+
   RTC_DCHECK_RUN_ON(&main_thread_);
 
   if (is_keyframe) {
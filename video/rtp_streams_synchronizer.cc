@@ -16,6 +16,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/rtp_to_ntp_estimator.h"
 
 namespace webrtc {
@@ -43,7 +44,9 @@ RtpStreamsSynchronizer::RtpStreamsSynchronizer(Syncable* syncable_video)
       syncable_audio_(nullptr),
       sync_(),
       last_sync_time_(rtc::TimeNanos()),
-      last_stats_log_ms_(rtc::TimeMillis()) {
+      last_stats_log_ms_(rtc::TimeMillis()),
+      predictive_sync_(
+          field_trial::IsEnabled("WebRTC-Video-PredictiveAvSync")) {
   RTC_DCHECK(syncable_video);
   process_thread_checker_.Detach();
 }
@@ -131,10 +134,20 @@ void RtpStreamsSynchronizer::Process() {
   int target_video_delay_ms = video_info->current_delay_ms;
   // Calculate the necessary extra audio delay and desired total video
   // delay to get the streams in sync.
-  if (!sync_->ComputeDelays(relative_delay_ms, audio_info->current_delay_ms,
-                            &target_audio_delay_ms, &target_video_delay_ms)) {
+  bool new_targets;
+  if (predictive_sync_) {
+    new_targets = sync_->ComputePredictiveDelays(
+        relative_delay_ms, audio_info->current_delay_ms,
+        audio_info->minimum_delay_ms, video_info->current_delay_ms,
+        video_info->minimum_delay_ms, &target_audio_delay_ms,
+        &target_video_delay_ms);
+  } else {
+    new_targets =
+        sync_->ComputeDelays(relative_delay_ms, audio_info->current_delay_ms,
+                             &target_audio_delay_ms, &target_video_delay_ms);
+  }
+  if (!new_targets)
     return;
-  }
 
   if (log_stats) {
     RTC_LOG(LS_INFO) << "Sync delay stats: " << now_ms
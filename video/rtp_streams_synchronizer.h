@@ -60,6 +60,8 @@ class RtpStreamsSynchronizer : public Module {
   rtc::ThreadChecker process_thread_checker_;
   int64_t last_sync_time_ RTC_GUARDED_BY(&process_thread_checker_);
   int64_t last_stats_log_ms_ RTC_GUARDED_BY(&process_thread_checker_);
+  // Jump straight to the delays computed from the jitter buffer minimums.
+  const bool predictive_sync_;
 };
 
 }  // namespace webrtc
@@ -66,6 +66,8 @@ class RtpStreamsSynchronizer {
       RTC_GUARDED_BY(main_checker_);
   RepeatingTaskHandle repeating_task_ RTC_GUARDED_BY(main_checker_);
   int64_t last_stats_log_ms_ RTC_GUARDED_BY(&main_checker_);
+  // Jump straight to the delays computed from the jitter buffer minimums.
+  const bool predictive_sync_;
 };
 
 }  // namespace internal
@@ -20,6 +20,7 @@
 #include "absl/base/macros.h"
 #include "absl/memory/memory.h"
 #include "absl/types/optional.h"
+#include "api/task_queue/task_queue_base.h"
 #include "media/base/media_constants.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
@@ -47,6 +48,7 @@
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/thread.h"
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 #include "system_wrappers/include/ntp_time.h"
@@ -59,6 +61,8 @@ namespace {
 //                 crbug.com/752886
 constexpr int kPacketBufferStartSize = 512;
 constexpr int kPacketBufferMaxSize = 2048;
+// About two seconds of 30 fps video waiting to be decoded.
+constexpr size_t kMaxPooledFrameBuffers = 60;
 
 int PacketBufferMaxSize() {
   // The group here must be a positive power of 2, in which case that is used as
@@ -77,6 +81,14 @@ int PacketBufferMaxSize() {
   return packet_buffer_max_size;
 }
 
+// Transformed frames are handed back on the sequence they were sent from.
+TaskQueueBase* CurrentTaskQueueOrThread() {
+  TaskQueueBase* current = TaskQueueBase::Current();
+  if (!current)
+    current = rtc::Thread::Current();
+  return current;
+}
+
 }  // namespace
 
 std::unique_ptr<RtpRtcp> CreateRtpRtcpModule(
@@ -258,6 +270,7 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
       // directly with |rtp_rtcp_|.
       rtcp_feedback_buffer_(this, nack_sender, this),
       packet_buffer_(clock_, kPacketBufferStartSize, PacketBufferMaxSize()),
+      frame_buffer_pool_(kMaxPooledFrameBuffers),
       has_received_frame_(false),
       frames_decryptable_(false),
       absolute_capture_time_receiver_(clock) {
@@ -298,6 +311,10 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
 
   process_thread_->RegisterModule(rtp_rtcp_.get(), RTC_FROM_HERE);
 
+  // The receiver may be created on another sequence than the one it
+  // processes packets on.
+  packet_sequence_checker_.Detach();
+
   if (config_.rtp.lntf.enabled) {
     loss_notification_controller_ =
         std::make_unique<LossNotificationController>(&rtcp_feedback_buffer_,
@@ -325,7 +342,7 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
   if (frame_transformer) {
     frame_transformer_delegate_ = new rtc::RefCountedObject<
         RtpVideoStreamReceiverFrameTransformerDelegate>(
-        this, std::move(frame_transformer), rtc::Thread::Current(),
+        this, std::move(frame_transformer), CurrentTaskQueueOrThread(),
         config_.rtp.remote_ssrc);
     frame_transformer_delegate_->Init();
   }
@@ -343,8 +360,7 @@ RtpVideoStreamReceiver::~RtpVideoStreamReceiver() {
   if (packet_router_)
     packet_router_->RemoveReceiveRtpModule(rtp_rtcp_.get());
   UpdateHistograms();
-  if (frame_transformer_delegate_)
-    frame_transformer_delegate_->Reset();
+  RemoveFrameTransformer();
 }
 
 void RtpVideoStreamReceiver::AddReceiveCodec(
@@ -487,10 +503,14 @@ void RtpVideoStreamReceiver::OnReceivedPayloadData(
     rtc::CopyOnWriteBuffer codec_payload,
     const RtpPacketReceived& rtp_packet,
     const RTPVideoHeader& video) {
-  RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+  int64_t ntp_time_ms;
+  {
+    rtc::CritScope lock(&ntp_estimator_lock_);
+    ntp_time_ms = ntp_estimator_.Estimate(rtp_packet.Timestamp());
+  }
   auto packet = std::make_unique<video_coding::PacketBuffer::Packet>(
-      rtp_packet, video, ntp_estimator_.Estimate(rtp_packet.Timestamp()),
-      clock_->TimeInMilliseconds());
+      rtp_packet, video, ntp_time_ms, clock_->TimeInMilliseconds());
 
   // Try to extrapolate absolute capture time if it is missing.
   packet->packet_info.set_absolute_capture_time(
@@ -649,7 +669,7 @@ void RtpVideoStreamReceiver::OnRecoveredPacket(const uint8_t* rtp_packet,
 // This method handles both regular RTP packets and packets recovered
 // via FlexFEC.
 void RtpVideoStreamReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
-  RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
 
   if (!receiving_) {
     return;
@@ -773,7 +793,8 @@ void RtpVideoStreamReceiver::OnInsertedPacket(
       RTC_CHECK(depacketizer_it != payload_type_map_.end());
 
       rtc::scoped_refptr<EncodedImageBuffer> bitstream =
-          depacketizer_it->second->AssembleFrame(payloads);
+          depacketizer_it->second->AssembleFrame(payloads,
+                                                 &frame_buffer_pool_);
       if (!bitstream) {
         // Failed to assemble a frame. Discard and continue.
         continue;
@@ -808,7 +829,7 @@ void RtpVideoStreamReceiver::OnInsertedPacket(
 
 void RtpVideoStreamReceiver::OnAssembledFrame(
     std::unique_ptr<video_coding::RtpFrameObject> frame) {
-  RTC_DCHECK_RUN_ON(&network_tc_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   RTC_DCHECK(frame);
 
   const absl::optional<RTPVideoHeader::GenericDescriptorInfo>& descriptor =
@@ -905,7 +926,7 @@ void RtpVideoStreamReceiver::OnDecryptionStatusChange(
 
 void RtpVideoStreamReceiver::SetFrameDecryptor(
     rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor) {
-  RTC_DCHECK_RUN_ON(&network_tc_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   if (buffered_frame_decryptor_ == nullptr) {
     buffered_frame_decryptor_ =
         std::make_unique<BufferedFrameDecryptor>(this, this);
@@ -915,14 +936,21 @@ void RtpVideoStreamReceiver::SetFrameDecryptor(
 
 void RtpVideoStreamReceiver::SetDepacketizerToDecoderFrameTransformer(
     rtc::scoped_refptr<FrameTransformerInterface> frame_transformer) {
-  RTC_DCHECK_RUN_ON(&network_tc_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   frame_transformer_delegate_ =
       new rtc::RefCountedObject<RtpVideoStreamReceiverFrameTransformerDelegate>(
-          this, std::move(frame_transformer), rtc::Thread::Current(),
+          this, std::move(frame_transformer), CurrentTaskQueueOrThread(),
           config_.rtp.remote_ssrc);
   frame_transformer_delegate_->Init();
 }
 
+void RtpVideoStreamReceiver::RemoveFrameTransformer() {
+  if (!frame_transformer_delegate_)
+    return;
+  frame_transformer_delegate_->Reset();
+  frame_transformer_delegate_ = nullptr;
+}
+
 void RtpVideoStreamReceiver::UpdateRtt(int64_t max_rtt_ms) {
   if (nack_module_)
     nack_module_->UpdateRtt(max_rtt_ms);
@@ -938,14 +966,14 @@ absl::optional<int64_t> RtpVideoStreamReceiver::LastReceivedKeyframePacketMs()
 }
 
 void RtpVideoStreamReceiver::AddSecondarySink(RtpPacketSinkInterface* sink) {
-  RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   RTC_DCHECK(!absl::c_linear_search(secondary_sinks_, sink));
   secondary_sinks_.push_back(sink);
 }
 
 void RtpVideoStreamReceiver::RemoveSecondarySink(
     const RtpPacketSinkInterface* sink) {
-  RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   auto it = absl::c_find(secondary_sinks_, sink);
   if (it == secondary_sinks_.end()) {
     // We might be rolling-back a call whose setup failed mid-way. In such a
@@ -993,7 +1021,7 @@ void RtpVideoStreamReceiver::ReceivePacket(const RtpPacketReceived& packet) {
 
 void RtpVideoStreamReceiver::ParseAndHandleEncapsulatingHeader(
     const RtpPacketReceived& packet) {
-  RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   if (packet.PayloadType() == config_.rtp.red_payload_type &&
       packet.payload_size() > 0) {
     if (packet.payload()[0] == config_.rtp.ulpfec_payload_type) {
@@ -1060,9 +1088,14 @@ bool RtpVideoStreamReceiver::DeliverRtcp(const uint8_t* rtcp_packet,
       clock_->CurrentNtpInMilliseconds() - recieved_ntp.ToMs();
   // Don't use old SRs to estimate time.
   if (time_since_recieved <= 1) {
-    ntp_estimator_.UpdateRtcpTimestamp(rtt, ntp_secs, ntp_frac, rtp_timestamp);
-    absl::optional<int64_t> remote_to_local_clock_offset_ms =
-        ntp_estimator_.EstimateRemoteToLocalClockOffsetMs();
+    absl::optional<int64_t> remote_to_local_clock_offset_ms;
+    {
+      rtc::CritScope lock(&ntp_estimator_lock_);
+      ntp_estimator_.UpdateRtcpTimestamp(rtt, ntp_secs, ntp_frac,
+                                         rtp_timestamp);
+      remote_to_local_clock_offset_ms =
+          ntp_estimator_.EstimateRemoteToLocalClockOffsetMs();
+    }
     if (remote_to_local_clock_offset_ms.has_value()) {
       absolute_capture_time_receiver_.SetRemoteToLocalClockOffset(
           Int64MsToQ32x32(*remote_to_local_clock_offset_ms));
@@ -26,6 +26,7 @@
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
 #include "call/video_receive_stream.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 #include "modules/rtp_rtcp/include/remote_ntp_time_estimator.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
@@ -47,7 +48,6 @@
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/thread_annotations.h"
-#include "rtc_base/thread_checker.h"
 #include "video/buffered_frame_decryptor.h"
 #include "video/rtp_video_stream_receiver_frame_transformer_delegate.h"
 
@@ -134,7 +134,7 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
 
   // Returns number of different frames seen.
   int GetUniqueFramesSeen() const {
-    RTC_DCHECK_RUN_ON(&worker_task_checker_);
+    RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
     return frame_counter_.GetUniqueSeen();
   }
 
@@ -183,7 +183,8 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
       FrameDecryptorInterface::Status status) override;
 
   // Optionally set a frame decryptor after a stream has started. This will not
-  // reset the decoder state.
+  // reset the decoder state. Like the transformer and the secondary sinks
+  // below, it is set on the sequence the received packets are processed on.
   void SetFrameDecryptor(
       rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor);
 
@@ -191,6 +192,9 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   // has previously been set. Does not reset the decoder state.
   void SetDepacketizerToDecoderFrameTransformer(
       rtc::scoped_refptr<FrameTransformerInterface> frame_transformer);
+  // Releases the frame transformer, so that a receiver processing packets on
+  // a sequence of its own can still be destroyed on the worker thread.
+  void RemoveFrameTransformer();
 
   // Called by VideoReceiveStream when stats are updated.
   void UpdateRtt(int64_t max_rtt_ms);
@@ -288,7 +292,7 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   void OnInsertedPacket(video_coding::PacketBuffer::InsertResult result);
   ParseGenericDependenciesResult ParseGenericDependenciesExtension(
       const RtpPacketReceived& rtp_packet,
-      RTPVideoHeader* video_header) RTC_RUN_ON(worker_task_checker_);
+      RTPVideoHeader* video_header) RTC_RUN_ON(packet_sequence_checker_);
   void OnAssembledFrame(std::unique_ptr<video_coding::RtpFrameObject> frame);
 
   Clock* const clock_;
@@ -297,7 +301,9 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   PacketRouter* const packet_router_;
   ProcessThread* const process_thread_;
 
-  RemoteNtpTimeEstimator ntp_estimator_;
+  // Updated from RTCP on the worker thread and used on the packet path.
+  rtc::CriticalSection ntp_estimator_lock_;
+  RemoteNtpTimeEstimator ntp_estimator_ RTC_GUARDED_BY(ntp_estimator_lock_);
 
   RtpHeaderExtensionMap rtp_header_extensions_;
   // Set by the field trial WebRTC-ForcePlayoutDelay to override any playout
@@ -308,8 +314,11 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   std::unique_ptr<UlpfecReceiver> ulpfec_receiver_;
 
   SequenceChecker worker_task_checker_;
-  bool receiving_ RTC_GUARDED_BY(worker_task_checker_);
-  int64_t last_packet_log_ms_ RTC_GUARDED_BY(worker_task_checker_);
+  // Received packets are processed on the worker thread, or on a receive
+  // queue of their own when the stream is given one (see Call).
+  SequenceChecker packet_sequence_checker_;
+  std::atomic<bool> receiving_;
+  int64_t last_packet_log_ms_ RTC_GUARDED_BY(packet_sequence_checker_);
 
   const std::unique_ptr<RtpRtcp> rtp_rtcp_;
 
@@ -321,19 +330,23 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   std::unique_ptr<LossNotificationController> loss_notification_controller_;
 
   video_coding::PacketBuffer packet_buffer_;
-  UniqueTimestampCounter frame_counter_ RTC_GUARDED_BY(worker_task_checker_);
+  // The buffers frames are assembled into, they are reused once the frames
+  // have been decoded.
+  EncodedImageBufferPool frame_buffer_pool_;
+  UniqueTimestampCounter frame_counter_
+      RTC_GUARDED_BY(packet_sequence_checker_);
   SeqNumUnwrapper<uint16_t> frame_id_unwrapper_
-      RTC_GUARDED_BY(worker_task_checker_);
+      RTC_GUARDED_BY(packet_sequence_checker_);
 
   // Video structure provided in the dependency descriptor in a first packet
   // of a key frame. It is required to parse dependency descriptor in the
   // following delta packets.
   std::unique_ptr<FrameDependencyStructure> video_structure_
-      RTC_GUARDED_BY(worker_task_checker_);
+      RTC_GUARDED_BY(packet_sequence_checker_);
   // Frame id of the last frame with the attached video structure.
   // absl::nullopt when `video_structure_ == nullptr`;
   absl::optional<int64_t> video_structure_frame_id_
-      RTC_GUARDED_BY(worker_task_checker_);
+      RTC_GUARDED_BY(packet_sequence_checker_);
 
   rtc::CriticalSection reference_finder_lock_;
   std::unique_ptr<video_coding::RtpFrameReferenceFinder> reference_finder_
@@ -358,7 +371,7 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   bool has_received_frame_;
 
   std::vector<RtpPacketSinkInterface*> secondary_sinks_
-      RTC_GUARDED_BY(worker_task_checker_);
+      RTC_GUARDED_BY(packet_sequence_checker_);
 
   // Info for GetSyncInfo is updated on network or worker thread, and queried on
   // the worker thread.
@@ -368,18 +381,15 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   absl::optional<int64_t> last_received_rtp_system_time_ms_
       RTC_GUARDED_BY(sync_info_lock_);
 
-  // Used to validate the buffered frame decryptor is always run on the correct
-  // thread.
-  rtc::ThreadChecker network_tc_;
   // Handles incoming encrypted frames and forwards them to the
   // rtp_reference_finder if they are decryptable.
   std::unique_ptr<BufferedFrameDecryptor> buffered_frame_decryptor_
-      RTC_PT_GUARDED_BY(network_tc_);
+      RTC_PT_GUARDED_BY(packet_sequence_checker_);
   std::atomic<bool> frames_decryptable_;
   absl::optional<ColorSpace> last_color_space_;
 
-  AbsoluteCaptureTimeReceiver absolute_capture_time_receiver_
-      RTC_GUARDED_BY(worker_task_checker_);
+  // Thread-safe, used on the packet path and from RTCP.
+  AbsoluteCaptureTimeReceiver absolute_capture_time_receiver_;
 
   int64_t last_completed_picture_id_ = 0;
 
@@ -10,13 +10,14 @@
 
 #include "video/rtp_video_stream_receiver_frame_transformer_delegate.h"
 
+#include <string.h>
+
 #include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
 #include "modules/rtp_rtcp/source/rtp_descriptor_authentication.h"
 #include "rtc_base/task_utils/to_queued_task.h"
-#include "rtc_base/thread.h"
 #include "video/rtp_video_stream_receiver.h"
 
 namespace webrtc {
@@ -33,7 +34,7 @@ class TransformableVideoReceiverFrame
 
   // Implements TransformableVideoFrameInterface.
   rtc::ArrayView<const uint8_t> GetData() const override {
-    return *frame_->GetEncodedData();
+    return rtc::ArrayView<const uint8_t>(frame_->data(), frame_->size());
   }
 
   void SetData(rtc::ArrayView<const uint8_t> data) override {
@@ -41,6 +42,19 @@ class TransformableVideoReceiverFrame
         EncodedImageBuffer::Create(data.data(), data.size()));
   }
 
+  rtc::ArrayView<uint8_t> GetMutableData(size_t size) override {
+    // The frame was assembled from the received packets into a buffer of its
+    // own, which can be modified in place as long as it's large enough.
+    if (size > frame_->GetEncodedData()->size()) {
+      rtc::scoped_refptr<EncodedImageBuffer> buffer =
+          EncodedImageBuffer::Create(size);
+      memcpy(buffer->data(), frame_->data(), frame_->size());
+      frame_->SetEncodedData(buffer);
+    }
+    frame_->set_size(size);
+    return rtc::ArrayView<uint8_t>(frame_->data(), frame_->size());
+  }
+
   uint32_t GetTimestamp() const override { return frame_->Timestamp(); }
   uint32_t GetSsrc() const override { return ssrc_; }
 
@@ -66,7 +80,7 @@ RtpVideoStreamReceiverFrameTransformerDelegate::
     RtpVideoStreamReceiverFrameTransformerDelegate(
         RtpVideoStreamReceiver* receiver,
         rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
-        rtc::Thread* network_thread,
+        TaskQueueBase* network_thread,
         uint32_t ssrc)
     : receiver_(receiver),
       frame_transformer_(std::move(frame_transformer)),
@@ -96,6 +110,12 @@ void RtpVideoStreamReceiverFrameTransformerDelegate::TransformFrame(
 
 void RtpVideoStreamReceiverFrameTransformerDelegate::OnTransformedFrame(
     std::unique_ptr<TransformableFrameInterface> frame) {
+  // A transformer running synchronously calls back from within
+  // TransformFrame(), the frame is then passed on without a thread hop.
+  if (network_thread_->IsCurrent()) {
+    ManageFrame(std::move(frame));
+    return;
+  }
   rtc::scoped_refptr<RtpVideoStreamReceiverFrameTransformerDelegate> delegate =
       this;
   network_thread_->PostTask(ToQueuedTask(
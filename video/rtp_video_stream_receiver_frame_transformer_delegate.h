@@ -14,9 +14,9 @@
 #include <memory>
 
 #include "api/frame_transformer_interface.h"
+#include "api/task_queue/task_queue_base.h"
 #include "modules/video_coding/frame_object.h"
 #include "rtc_base/synchronization/sequence_checker.h"
-#include "rtc_base/thread.h"
 
 namespace webrtc {
 
@@ -30,7 +30,7 @@ class RtpVideoStreamReceiverFrameTransformerDelegate
   RtpVideoStreamReceiverFrameTransformerDelegate(
       RtpVideoStreamReceiver* receiver,
       rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
-      rtc::Thread* network_thread,
+      TaskQueueBase* network_thread,
       uint32_t ssrc);
 
   void Init();
@@ -56,7 +56,7 @@ class RtpVideoStreamReceiverFrameTransformerDelegate
   RtpVideoStreamReceiver* receiver_ RTC_GUARDED_BY(network_sequence_checker_);
   rtc::scoped_refptr<FrameTransformerInterface> frame_transformer_
       RTC_GUARDED_BY(network_sequence_checker_);
-  rtc::Thread* const network_thread_;
+  TaskQueueBase* const network_thread_;
   const uint32_t ssrc_;
 };
 
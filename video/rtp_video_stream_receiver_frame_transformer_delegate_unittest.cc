@@ -21,6 +21,7 @@
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/event.h"
 #include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/thread.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/mock_frame_transformer.h"
@@ -177,5 +178,49 @@ TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
   rtc::ThreadManager::ProcessAllMessageQueuesForTesting();
 }
 
+TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
+     TransformsFrameDataInPlaceAndSynchronously) {
+  TestRtpVideoStreamReceiver receiver;
+  rtc::scoped_refptr<MockFrameTransformer> mock_frame_transformer(
+      new rtc::RefCountedObject<NiceMock<MockFrameTransformer>>());
+  rtc::scoped_refptr<RtpVideoStreamReceiverFrameTransformerDelegate> delegate =
+      new rtc::RefCountedObject<RtpVideoStreamReceiverFrameTransformerDelegate>(
+          &receiver, mock_frame_transformer, rtc::Thread::Current(),
+          /*remote_ssrc*/ 1111);
+
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  delegate->Init();
+  ASSERT_TRUE(callback);
+
+  const uint8_t data[] = {1, 2, 3, 4};
+  rtc::scoped_refptr<EncodedImageBuffer> buffer =
+      EncodedImageBuffer::Create(data, sizeof(data));
+  auto frame = std::make_unique<video_coding::RtpFrameObject>(
+      0, 0, true, 0, 0, 0, 0, 0, VideoSendTiming(), 0, kVideoCodecGeneric,
+      kVideoRotation_0, VideoContentType::UNSPECIFIED, RTPVideoHeader(),
+      absl::nullopt, RtpPacketInfos(), buffer);
+  ON_CALL(*mock_frame_transformer, Transform)
+      .WillByDefault(
+          [&callback](std::unique_ptr<TransformableFrameInterface> frame) {
+            rtc::ArrayView<uint8_t> data = frame->GetMutableData(3);
+            ASSERT_EQ(3u, data.size());
+            data[0] = 5;
+            callback->OnTransformedFrame(std::move(frame));
+          });
+  EXPECT_CALL(receiver, ManageFrame)
+      .WillOnce([&](std::unique_ptr<video_coding::RtpFrameObject> frame) {
+        // The transform wrote into the buffer the frame was assembled into.
+        EXPECT_EQ(buffer->data(), frame->data());
+        EXPECT_EQ(3u, frame->size());
+        EXPECT_EQ(5, frame->data()[0]);
+        EXPECT_EQ(2, frame->data()[1]);
+      });
+  delegate->TransformFrame(std::move(frame));
+  // The frame was passed on without posting a task.
+  testing::Mock::VerifyAndClearExpectations(&receiver);
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -15,6 +15,7 @@
 #include <algorithm>
 
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
 
 namespace webrtc {
 
@@ -23,6 +24,8 @@ static const int kMaxDeltaDelayMs = 10000;
 static const int kFilterLength = 4;
 // Minimum difference between audio and video to warrant a change.
 static const int kMinDeltaMs = 30;
+// Maximum change of the delay of a stream in a predictive update.
+static const int kMaxJumpMs = 300;
 
 StreamSynchronization::StreamSynchronization(uint32_t video_stream_id,
                                              uint32_t audio_stream_id)
@@ -170,6 +173,67 @@ bool StreamSynchronization::ComputeDelays(int relative_delay_ms,
   return true;
 }
 
+bool StreamSynchronization::ComputePredictiveDelays(
+    int relative_delay_ms,
+    int current_audio_delay_ms,
+    int minimum_audio_delay_ms,
+    int current_video_delay_ms,
+    int minimum_video_delay_ms,
+    int* total_audio_delay_target_ms,
+    int* total_video_delay_target_ms) {
+  RTC_LOG(LS_VERBOSE) << "Audio delay: " << current_audio_delay_ms
+                      << " (min " << minimum_audio_delay_ms
+                      << ") video delay: " << current_video_delay_ms
+                      << " (min " << minimum_video_delay_ms
+                      << ") current diff: " << relative_delay_ms
+                      << " for stream " << audio_stream_id_;
+
+  const int min_audio_ms =
+      std::max(minimum_audio_delay_ms, base_target_delay_ms_);
+  const int min_video_ms =
+      std::max(minimum_video_delay_ms, base_target_delay_ms_);
+  // The streams are in sync when audio is delayed |relative_delay_ms| longer
+  // than video. Of those delays, the lowest leaves the stream that needs the
+  // most delay at its minimum and only delays the other one.
+  int audio_target_ms =
+      std::max(min_audio_ms, min_video_ms + relative_delay_ms);
+  int video_target_ms = audio_target_ms - relative_delay_ms;
+
+  audio_target_ms = rtc::SafeClamp(audio_target_ms,
+                                   current_audio_delay_ms - kMaxJumpMs,
+                                   current_audio_delay_ms + kMaxJumpMs);
+  video_target_ms = rtc::SafeClamp(video_target_ms,
+                                   current_video_delay_ms - kMaxJumpMs,
+                                   current_video_delay_ms + kMaxJumpMs);
+  // A stream that is at its minimum needs no extra delay.
+  if (audio_target_ms <= min_audio_ms)
+    audio_target_ms = base_target_delay_ms_;
+  if (video_target_ms <= min_video_ms)
+    video_target_ms = base_target_delay_ms_;
+  audio_target_ms =
+      std::min(audio_target_ms, base_target_delay_ms_ + kMaxDeltaDelayMs);
+  video_target_ms =
+      std::min(video_target_ms, base_target_delay_ms_ + kMaxDeltaDelayMs);
+
+  if (abs(audio_target_ms - audio_delay_.last_ms) < kMinDeltaMs &&
+      abs(video_target_ms - video_delay_.last_ms) < kMinDeltaMs) {
+    return false;
+  }
+  audio_delay_.extra_ms = audio_target_ms;
+  audio_delay_.last_ms = audio_target_ms;
+  video_delay_.extra_ms = video_target_ms;
+  video_delay_.last_ms = video_target_ms;
+
+  RTC_LOG(LS_VERBOSE) << "Sync video delay " << video_target_ms
+                      << " for video stream " << video_stream_id_
+                      << " and audio delay " << audio_target_ms
+                      << " for audio stream " << audio_stream_id_;
+
+  *total_audio_delay_target_ms = audio_target_ms;
+  *total_video_delay_target_ms = video_target_ms;
+  return true;
+}
+
 void StreamSynchronization::SetTargetBufferingDelay(int target_delay_ms) {
   // Initial extra delay for audio (accounting for existing extra delay).
   audio_delay_.extra_ms += target_delay_ms - base_target_delay_ms_;
@@ -33,6 +33,20 @@ class StreamSynchronization {
                      int* total_audio_delay_target_ms,
                      int* total_video_delay_target_ms);
 
+  // Computes the delays that get the streams in sync with the least delay,
+  // given the minimum delays their jitter buffers need, and jumps straight to
+  // them rather than moving towards them in small steps. Extra delay added to
+  // the stream played out too late is removed before any is added to the
+  // other one. A jump is limited to a few hundred milliseconds from the
+  // current delay of a stream. Returns false if the targets didn't change.
+  bool ComputePredictiveDelays(int relative_delay_ms,
+                               int current_audio_delay_ms,
+                               int minimum_audio_delay_ms,
+                               int current_video_delay_ms,
+                               int minimum_video_delay_ms,
+                               int* total_audio_delay_target_ms,
+                               int* total_video_delay_target_ms);
+
   // On success |relative_delay_ms| contains the number of milliseconds later
   // video is rendered relative audio. If audio is played back later than video
   // |relative_delay_ms| will be negative.
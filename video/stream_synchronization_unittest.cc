@@ -473,4 +473,73 @@ TEST_F(StreamSynchronizationTest,
   BothDelayedVideoLaterTest(kBaseTargetDelayMs);
 }
 
+TEST_F(StreamSynchronizationTest, PredictiveJumpsStraightToSync) {
+  // Video arrives 200 ms after audio, so audio needs 200 ms more delay.
+  int total_audio_delay_ms = 0;
+  int total_video_delay_ms = 0;
+  EXPECT_TRUE(sync_.ComputePredictiveDelays(
+      /*relative_delay_ms=*/200, /*current_audio_delay_ms=*/40,
+      /*minimum_audio_delay_ms=*/40, /*current_video_delay_ms=*/50,
+      /*minimum_video_delay_ms=*/50, &total_audio_delay_ms,
+      &total_video_delay_ms));
+  EXPECT_EQ(250, total_audio_delay_ms);
+  EXPECT_EQ(0, total_video_delay_ms);
+
+  // Nothing changes once the streams are in sync.
+  EXPECT_FALSE(sync_.ComputePredictiveDelays(
+      /*relative_delay_ms=*/200, /*current_audio_delay_ms=*/250,
+      /*minimum_audio_delay_ms=*/40, /*current_video_delay_ms=*/50,
+      /*minimum_video_delay_ms=*/50, &total_audio_delay_ms,
+      &total_video_delay_ms));
+}
+
+TEST_F(StreamSynchronizationTest, PredictiveRemovesExtraDelayFirst) {
+  // Video was delayed to 400 ms for an earlier network delay. Now audio
+  // arrives 100 ms after video, and video is played out too late.
+  int total_audio_delay_ms = 0;
+  int total_video_delay_ms = 0;
+  EXPECT_TRUE(sync_.ComputePredictiveDelays(
+      /*relative_delay_ms=*/-100, /*current_audio_delay_ms=*/60,
+      /*minimum_audio_delay_ms=*/60, /*current_video_delay_ms=*/400,
+      /*minimum_video_delay_ms=*/50, &total_audio_delay_ms,
+      &total_video_delay_ms));
+  // Video only keeps the extra delay needed to wait for audio, which isn't
+  // delayed at all.
+  EXPECT_EQ(0, total_audio_delay_ms);
+  EXPECT_EQ(160, total_video_delay_ms);
+}
+
+TEST_F(StreamSynchronizationTest, PredictiveJumpsAreBounded) {
+  int total_audio_delay_ms = 0;
+  int total_video_delay_ms = 0;
+  EXPECT_TRUE(sync_.ComputePredictiveDelays(
+      /*relative_delay_ms=*/1000, /*current_audio_delay_ms=*/40,
+      /*minimum_audio_delay_ms=*/40, /*current_video_delay_ms=*/50,
+      /*minimum_video_delay_ms=*/50, &total_audio_delay_ms,
+      &total_video_delay_ms));
+  EXPECT_EQ(340, total_audio_delay_ms);
+  EXPECT_EQ(0, total_video_delay_ms);
+
+  EXPECT_TRUE(sync_.ComputePredictiveDelays(
+      /*relative_delay_ms=*/1000, /*current_audio_delay_ms=*/340,
+      /*minimum_audio_delay_ms=*/40, /*current_video_delay_ms=*/50,
+      /*minimum_video_delay_ms=*/50, &total_audio_delay_ms,
+      &total_video_delay_ms));
+  EXPECT_EQ(640, total_audio_delay_ms);
+}
+
+TEST_F(StreamSynchronizationTest, PredictiveKeepsBaseTargetDelay) {
+  const int kBaseTargetDelayMs = 2000;
+  sync_.SetTargetBufferingDelay(kBaseTargetDelayMs);
+  int total_audio_delay_ms = 0;
+  int total_video_delay_ms = 0;
+  EXPECT_TRUE(sync_.ComputePredictiveDelays(
+      /*relative_delay_ms=*/200, /*current_audio_delay_ms=*/2000,
+      /*minimum_audio_delay_ms=*/40, /*current_video_delay_ms=*/2000,
+      /*minimum_video_delay_ms=*/50, &total_audio_delay_ms,
+      &total_video_delay_ms));
+  EXPECT_EQ(kBaseTargetDelayMs + 200, total_audio_delay_ms);
+  EXPECT_EQ(kBaseTargetDelayMs, total_video_delay_ms);
+}
+
 }  // namespace webrtc
@@ -602,6 +602,7 @@ absl::optional<Syncable::Info> VideoReceiveStream::GetInfo() const {
     return absl::nullopt;
 
   info->current_delay_ms = timing_->TargetVideoDelay();
+  info->minimum_delay_ms = timing_->UnconstrainedTargetVideoDelay();
   return info;
 }
 
@@ -37,12 +37,16 @@
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/timing.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
+#include "modules/video_coding/utility/vp9_uncompressed_header_parser.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/experiments/keyframe_interval_settings.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/thread_registry.h"
+#include "rtc_base/task_queue_pooled.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
@@ -176,11 +180,28 @@ class NullVideoDecoder : public webrtc::VideoDecoder {
 // timestamps wraparound to affect FrameBuffer.
 constexpr int kInactiveStreamThresholdMs = 600000;  //  10 minutes.
 
+// Streams decode on threads shared by all streams of the process with
+// "WebRTC-SharedDecodeThreadPool/Enabled/", instead of a thread each. The
+// decode queues are high priority, they run on the process wide pool of pooled
+// task queues of that priority.
+TaskQueueFactory* SharedDecodeQueueFactory() {
+  static TaskQueueFactory* const factory =
+      CreateTaskQueuePooledFactory().release();
+  return factory;
+}
+
+TaskQueueFactory* DecodeQueueFactory(TaskQueueFactory* task_queue_factory) {
+  if (field_trial::IsEnabled("WebRTC-SharedDecodeThreadPool"))
+    return SharedDecodeQueueFactory();
+  return task_queue_factory;
+}
+
 }  // namespace
 
 VideoReceiveStream2::VideoReceiveStream2(
     TaskQueueFactory* task_queue_factory,
     TaskQueueBase* current_queue,
+    TaskQueueBase* packet_queue,
     RtpStreamReceiverControllerInterface* receiver_controller,
     int num_cpu_cores,
     PacketRouter* packet_router,
@@ -194,6 +215,7 @@ VideoReceiveStream2::VideoReceiveStream2(
       config_(std::move(config)),
       num_cpu_cores_(num_cpu_cores),
       worker_thread_(current_queue),
+      packet_queue_(packet_queue),
       clock_(clock),
       call_stats_(call_stats),
       source_tracker_(clock_),
@@ -214,7 +236,11 @@ VideoReceiveStream2::VideoReceiveStream2(
                                  nullptr,  // Use default KeyFrameRequestSender
                                  this,     // OnCompleteFrameCallback
                                  config_.frame_decryptor,
-                                 config_.frame_transformer),
+                                 // Set below when packets are processed on a
+                                 // queue of their own.
+                                 packet_queue == current_queue
+                                     ? config_.frame_transformer
+                                     : nullptr),
       rtp_stream_sync_(current_queue, this),
       max_wait_for_keyframe_ms_(KeyframeIntervalSettings::ParseFromFieldTrials()
                                     .MaxWaitForKeyframeMs()
@@ -222,12 +248,17 @@ VideoReceiveStream2::VideoReceiveStream2(
       max_wait_for_frame_ms_(KeyframeIntervalSettings::ParseFromFieldTrials()
                                  .MaxWaitForFrameMs()
                                  .value_or(kMaxWaitForFrameMs)),
-      decode_queue_(task_queue_factory_->CreateTaskQueue(
+      frame_timing_log_(config_.frame_timing_log_path.empty()
+                            ? nullptr
+                            : FrameTimingLog::Create(
+                                  config_.frame_timing_log_path)),
+      decode_queue_(DecodeQueueFactory(task_queue_factory_)->CreateTaskQueue(
           "DecodingQueue",
           TaskQueueFactory::Priority::HIGH)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream2: " << config_.ToString();
 
   RTC_DCHECK(worker_thread_);
+  RTC_DCHECK(packet_queue_);
   RTC_DCHECK(config_.renderer);
   RTC_DCHECK(call_stats_);
 
@@ -250,6 +281,13 @@ VideoReceiveStream2::VideoReceiveStream2(
   frame_buffer_.reset(
       new video_coding::FrameBuffer(clock_, timing_.get(), &stats_proxy_));
 
+  if (packet_queue_ != worker_thread_ && config_.frame_transformer) {
+    RunOnPacketQueue([this] {
+      rtp_video_stream_receiver_.SetDepacketizerToDecoderFrameTransformer(
+          config_.frame_transformer);
+    });
+  }
+
   // Register with RtpStreamReceiverController.
   media_receiver_ = receiver_controller->CreateReceiver(
       config_.rtp.remote_ssrc, &rtp_video_stream_receiver_);
@@ -269,6 +307,14 @@ VideoReceiveStream2::~VideoReceiveStream2() {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   RTC_LOG(LS_INFO) << "~VideoReceiveStream2: " << config_.ToString();
   Stop();
+  if (packet_queue_ != worker_thread_) {
+    // Deregistering waits for the packets posted to |packet_queue_|, after
+    // that the transformer is the last thing that may still post there.
+    rtx_receiver_.reset();
+    media_receiver_.reset();
+    RunOnPacketQueue(
+        [this] { rtp_video_stream_receiver_.RemoveFrameTransformer(); });
+  }
 }
 
 void VideoReceiveStream2::SignalNetworkState(NetworkState state) {
@@ -381,8 +427,11 @@ void VideoReceiveStream2::Stop() {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   rtp_video_stream_receiver_.StopReceive();
 
-  stats_proxy_.OnUniqueFramesCounted(
-      rtp_video_stream_receiver_.GetUniqueFramesSeen());
+  int unique_frames_seen = 0;
+  RunOnPacketQueue([this, &unique_frames_seen] {
+    unique_frames_seen = rtp_video_stream_receiver_.GetUniqueFramesSeen();
+  });
+  stats_proxy_.OnUniqueFramesCounted(unique_frames_seen);
 
   decode_queue_.PostTask([this] { frame_buffer_->Stop(); });
 
@@ -458,12 +507,14 @@ void VideoReceiveStream2::UpdateHistograms() {
 }
 
 void VideoReceiveStream2::AddSecondarySink(RtpPacketSinkInterface* sink) {
-  rtp_video_stream_receiver_.AddSecondarySink(sink);
+  RunOnPacketQueue(
+      [this, sink] { rtp_video_stream_receiver_.AddSecondarySink(sink); });
 }
 
 void VideoReceiveStream2::RemoveSecondarySink(
     const RtpPacketSinkInterface* sink) {
-  rtp_video_stream_receiver_.RemoveSecondarySink(sink);
+  RunOnPacketQueue(
+      [this, sink] { rtp_video_stream_receiver_.RemoveSecondarySink(sink); });
 }
 
 bool VideoReceiveStream2::SetBaseMinimumPlayoutDelayMs(int delay_ms) {
@@ -505,18 +556,38 @@ void VideoReceiveStream2::OnFrame(const VideoFrame& video_frame) {
       }));
 
   source_tracker_.OnFrameDelivered(video_frame.packet_infos());
+  if (frame_timing_log_)
+    frame_timing_log_->OnRenderedFrame(video_frame,
+                                       frame_meta.decode_timestamp.ms());
   config_.renderer->OnFrame(video_frame);
 }
 
 void VideoReceiveStream2::SetFrameDecryptor(
     rtc::scoped_refptr<webrtc::FrameDecryptorInterface> frame_decryptor) {
-  rtp_video_stream_receiver_.SetFrameDecryptor(std::move(frame_decryptor));
+  RunOnPacketQueue([this, &frame_decryptor] {
+    rtp_video_stream_receiver_.SetFrameDecryptor(std::move(frame_decryptor));
+  });
 }
 
 void VideoReceiveStream2::SetDepacketizerToDecoderFrameTransformer(
     rtc::scoped_refptr<FrameTransformerInterface> frame_transformer) {
-  rtp_video_stream_receiver_.SetDepacketizerToDecoderFrameTransformer(
-      std::move(frame_transformer));
+  RunOnPacketQueue([this, &frame_transformer] {
+    rtp_video_stream_receiver_.SetDepacketizerToDecoderFrameTransformer(
+        std::move(frame_transformer));
+  });
+}
+
+void VideoReceiveStream2::RunOnPacketQueue(rtc::FunctionView<void()> task) {
+  if (packet_queue_ == worker_thread_) {
+    task();
+    return;
+  }
+  rtc::Event done;
+  packet_queue_->PostTask(ToQueuedTask([&task, &done] {
+    task();
+    done.Set();
+  }));
+  done.Wait(rtc::Event::kForever);
 }
 
 void VideoReceiveStream2::SendNack(
@@ -571,6 +642,11 @@ void VideoReceiveStream2::OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) {
   stats_proxy_.OnRttUpdate(avg_rtt_ms);
 }
 
+void VideoReceiveStream2::OnQueueingDelayTrend(
+    const QueueingDelayTrend& trend) {
+  frame_buffer_->UpdateQueueingDelayTrend(trend);
+}
+
 uint32_t VideoReceiveStream2::id() const {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   return config_.rtp.remote_ssrc;
@@ -585,6 +661,7 @@ absl::optional<Syncable::Info> VideoReceiveStream2::GetInfo() const {
     return absl::nullopt;
 
   info->current_delay_ms = timing_->TargetVideoDelay();
+  info->minimum_delay_ms = timing_->UnconstrainedTargetVideoDelay();
   return info;
 }
 
@@ -649,6 +726,15 @@ void VideoReceiveStream2::HandleEncodedFrame(
     }
   }
   stats_proxy_.OnPreDecode(frame->CodecSpecific()->codecType, qp);
+  if (frame_timing_log_) {
+    if (frame->CodecSpecific()->codecType == kVideoCodecVP9 &&
+        !vp9::GetQp(frame->data(), frame->size(), &qp)) {
+      qp = -1;
+    }
+    frame_timing_log_->OnEncodedFrame(
+        frame->Timestamp(), frame->size(),
+        frame->FrameType() == VideoFrameType::kVideoFrameKey, qp);
+  }
   HandleKeyFrameGeneration(frame->FrameType() == VideoFrameType::kVideoFrameKey,
                            now_ms);
   int decode_result = video_receiver_.Decode(frame.get());
@@ -14,8 +14,10 @@
 #include <memory>
 #include <vector>
 
+#include "api/function_view.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "api/transport/media/media_transport_interface.h"
+#include "api/transport/queueing_delay_trend.h"
 #include "api/units/timestamp.h"
 #include "api/video/recordable_encoded_frame.h"
 #include "call/rtp_packet_sink_interface.h"
@@ -28,6 +30,7 @@
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/task_queue.h"
 #include "system_wrappers/include/clock.h"
+#include "video/frame_timing_log.h"
 #include "video/receive_statistics_proxy2.h"
 #include "video/rtp_streams_synchronizer2.h"
 #include "video/rtp_video_stream_receiver.h"
@@ -79,14 +82,18 @@ class VideoReceiveStream2 : public webrtc::VideoReceiveStream,
                             public NackSender,
                             public video_coding::OnCompleteFrameCallback,
                             public Syncable,
-                            public CallStatsObserver {
+                            public CallStatsObserver,
+                            public QueueingDelayTrendObserver {
  public:
   // The default number of milliseconds to pass before re-requesting a key frame
   // to be sent.
   static constexpr int kMaxWaitForKeyFrameMs = 200;
 
+  // Received packets are processed on |packet_queue|, which is either
+  // |current_queue| or a queue the |receiver_controller| posts them to.
   VideoReceiveStream2(TaskQueueFactory* task_queue_factory,
                       TaskQueueBase* current_queue,
+                      TaskQueueBase* packet_queue,
                       RtpStreamReceiverControllerInterface* receiver_controller,
                       int num_cpu_cores,
                       PacketRouter* packet_router,
@@ -140,6 +147,9 @@ class VideoReceiveStream2 : public webrtc::VideoReceiveStream,
   // Implements CallStatsObserver::OnRttUpdate
   void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override;
 
+  // Implements QueueingDelayTrendObserver. May be called from any thread.
+  void OnQueueingDelayTrend(const QueueingDelayTrend& trend) override;
+
   // Implements Syncable.
   uint32_t id() const override;
   absl::optional<Syncable::Info> GetInfo() const override;
@@ -173,6 +183,9 @@ class VideoReceiveStream2 : public webrtc::VideoReceiveStream,
 
   void UpdateHistograms();
 
+  // Runs |task| on |packet_queue_| and waits for it to finish.
+  void RunOnPacketQueue(rtc::FunctionView<void()> task);
+
   SequenceChecker worker_sequence_checker_;
   SequenceChecker module_process_sequence_checker_;
   SequenceChecker network_sequence_checker_;
@@ -183,6 +196,7 @@ class VideoReceiveStream2 : public webrtc::VideoReceiveStream,
   const VideoReceiveStream::Config config_;
   const int num_cpu_cores_;
   TaskQueueBase* const worker_thread_;
+  TaskQueueBase* const packet_queue_;
   Clock* const clock_;
 
   CallStats* const call_stats_;
@@ -251,6 +265,10 @@ class VideoReceiveStream2 : public webrtc::VideoReceiveStream,
   // Set to true while we're requesting keyframes but not yet received one.
   bool keyframe_generation_requested_ RTC_GUARDED_BY(decode_queue_) = false;
 
+  // Set if |config_.frame_timing_log_path| is, written to from the decode
+  // queue and the render thread.
+  const std::unique_ptr<FrameTimingLog> frame_timing_log_;
+
   // Defined last so they are destroyed before all other members.
   rtc::TaskQueue decode_queue_;
 
@@ -83,6 +83,7 @@ class MockRtpVideoSender : public RtpVideoSenderInterface {
                      std::vector<RtpSequenceNumberMap::Info>(
                          uint32_t ssrc,
                          rtc::ArrayView<const uint16_t> sequence_numbers));
+  MOCK_METHOD1(RetransmitKeyFrameChain, bool(uint32_t ssrc));
 
   MOCK_METHOD1(SetFecAllowed, void(bool fec_allowed));
 };
@@ -255,6 +255,9 @@ VideoStreamEncoder::VideoStreamEncoder(
       encoder_switch_experiment_(ParseEncoderSwitchFieldTrial()),
       automatic_animation_detection_experiment_(
           ParseAutomatincAnimationDetectionFieldTrial()),
+      predicted_rate_control_experiment_(
+          ParsePredictedRateControlFieldTrial()),
+      predicted_bitrate_ratio_(1.0),
       encoder_switch_requested_(false),
       input_state_provider_(encoder_stats_observer),
       resource_adaptation_processor_(
@@ -1635,8 +1638,8 @@ void VideoStreamEncoder::OnBitrateUpdated(DataRate target_bitrate,
     encoder_queue_.PostTask([this, target_bitrate, stable_target_bitrate,
                              link_allocation, fraction_lost, round_trip_time_ms,
                              cwnd_reduce_ratio] {
-      DataRate updated_target_bitrate =
-          UpdateTargetBitrate(target_bitrate, cwnd_reduce_ratio);
+      DataRate updated_target_bitrate = ApplyPredictedBitrateRatio(
+          UpdateTargetBitrate(target_bitrate, cwnd_reduce_ratio));
       OnBitrateUpdated(updated_target_bitrate, stable_target_bitrate,
                        link_allocation, fraction_lost, round_trip_time_ms,
                        cwnd_reduce_ratio);
@@ -1708,6 +1711,33 @@ void VideoStreamEncoder::OnBitrateUpdated(DataRate target_bitrate,
   }
 }
 
+void VideoStreamEncoder::OnPredictedBitrateRatio(
+    double predicted_bitrate_ratio) {
+  if (!predicted_rate_control_experiment_.enabled)
+    return;
+  encoder_queue_.PostTask([this, predicted_bitrate_ratio] {
+    RTC_DCHECK_RUN_ON(&encoder_queue_);
+    predicted_bitrate_ratio_ = predicted_bitrate_ratio;
+  });
+}
+
+DataRate VideoStreamEncoder::ApplyPredictedBitrateRatio(
+    DataRate target_bitrate) const {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  if (!predicted_rate_control_experiment_.enabled ||
+      predicted_bitrate_ratio_ >= 1.0 || target_bitrate.IsZero()) {
+    return target_bitrate;
+  }
+  // Never pauses the encoder or goes below the codec minimum, the forecast
+  // is only an extrapolation.
+  const DataRate min_bitrate = std::min(
+      target_bitrate, DataRate::KilobitsPerSec(send_codec_.minBitrate));
+  return std::max(
+      min_bitrate,
+      target_bitrate * std::max(predicted_bitrate_ratio_,
+                                predicted_rate_control_experiment_.min_ratio));
+}
+
 bool VideoStreamEncoder::DropDueToSize(uint32_t pixel_count) const {
   bool simulcast_or_svc =
       (send_codec_.codecType == VideoCodecType::kVideoCodecVP9 &&
@@ -1938,6 +1968,19 @@ VideoStreamEncoder::ParseAutomatincAnimationDetectionFieldTrial() const {
   return result;
 }
 
+VideoStreamEncoder::PredictedRateControlExperiment
+VideoStreamEncoder::ParsePredictedRateControlFieldTrial() const {
+  PredictedRateControlExperiment result;
+  result.Parser()->Parse(
+      webrtc::field_trial::FindFullName("WebRTC-Video-PredictedRateControl"));
+  if (result.enabled) {
+    RTC_LOG(LS_INFO) << "Predicted rate control experiment settings:"
+                        " min_ratio="
+                     << result.min_ratio;
+  }
+  return result;
+}
+
 void VideoStreamEncoder::CheckForAnimatedContent(
     const VideoFrame& frame,
     int64_t time_when_posted_in_us) {
@@ -99,6 +99,8 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
                         int64_t round_trip_time_ms,
                         double cwnd_reduce_ratio) override;
 
+  void OnPredictedBitrateRatio(double predicted_bitrate_ratio) override;
+
   DataRate UpdateTargetBitrate(DataRate target_bitrate,
                                double cwnd_reduce_ratio);
 
@@ -404,6 +406,27 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   AutomaticAnimationDetectionExperiment
       automatic_animation_detection_experiment_ RTC_GUARDED_BY(&encoder_queue_);
 
+  // Lowers the target ahead of a capacity drop the congestion controller
+  // predicts, so that the encoder raises its QP and the frame dropper skips
+  // frames before the send queue builds up.
+  struct PredictedRateControlExperiment {
+    bool enabled = false;
+    // The target is never lowered below this share.
+    double min_ratio = 0.5;
+    std::unique_ptr<StructParametersParser> Parser() {
+      return StructParametersParser::Create(  //
+          "enabled", &enabled,                //
+          "min_ratio", &min_ratio);
+    }
+  };
+
+  PredictedRateControlExperiment ParsePredictedRateControlFieldTrial() const;
+  // Returns |target_bitrate| lowered by the last predicted bitrate ratio.
+  DataRate ApplyPredictedBitrateRatio(DataRate target_bitrate) const;
+
+  const PredictedRateControlExperiment predicted_rate_control_experiment_;
+  double predicted_bitrate_ratio_ RTC_GUARDED_BY(&encoder_queue_);
+
   // An encoder switch is only requested once, this variable is used to keep
   // track of whether a request has been made or not.
   bool encoder_switch_requested_ RTC_GUARDED_BY(&encoder_queue_);
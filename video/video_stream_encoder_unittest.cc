@@ -3758,6 +3758,55 @@ TEST_F(VideoStreamEncoderTest, CallsBitrateObserver) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, PredictedBitrateRatioLowersTarget) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-Video-PredictedRateControl/enabled:true,min_ratio:0.5/");
+  // Reset encoder for field trials to take effect.
+  ConfigureEncoder(video_encoder_config_.Copy());
+
+  video_stream_encoder_->OnPredictedBitrateRatio(0.8);
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      DataRate::BitsPerSec(kLowTargetBitrateBps),
+      DataRate::BitsPerSec(kLowTargetBitrateBps),
+      DataRate::BitsPerSec(kLowTargetBitrateBps), 0, 0, 0);
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(1, codec_width_, codec_height_));
+  WaitForEncodedFrame(1);
+  auto rate_settings = fake_encoder_.GetAndResetLastRateControlSettings();
+  ASSERT_TRUE(rate_settings.has_value());
+  EXPECT_EQ(rate_settings->bitrate.get_sum_bps(),
+            kLowTargetBitrateBps * 4 / 5);
+
+  // A steeper predicted drop is limited to |min_ratio|.
+  video_stream_encoder_->OnPredictedBitrateRatio(0.1);
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      DataRate::BitsPerSec(kLowTargetBitrateBps),
+      DataRate::BitsPerSec(kLowTargetBitrateBps),
+      DataRate::BitsPerSec(kLowTargetBitrateBps), 0, 0, 0);
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(2, codec_width_, codec_height_));
+  WaitForEncodedFrame(2);
+  rate_settings = fake_encoder_.GetAndResetLastRateControlSettings();
+  ASSERT_TRUE(rate_settings.has_value());
+  EXPECT_EQ(rate_settings->bitrate.get_sum_bps(), kLowTargetBitrateBps / 2);
+  video_stream_encoder_->Stop();
+}
+
+TEST_F(VideoStreamEncoderTest, PredictedBitrateRatioIgnoredByDefault) {
+  video_stream_encoder_->OnPredictedBitrateRatio(0.5);
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      DataRate::BitsPerSec(kLowTargetBitrateBps),
+      DataRate::BitsPerSec(kLowTargetBitrateBps),
+      DataRate::BitsPerSec(kLowTargetBitrateBps), 0, 0, 0);
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(1, codec_width_, codec_height_));
+  WaitForEncodedFrame(1);
+  auto rate_settings = fake_encoder_.GetAndResetLastRateControlSettings();
+  ASSERT_TRUE(rate_settings.has_value());
+  EXPECT_EQ(rate_settings->bitrate.get_sum_bps(), kLowTargetBitrateBps);
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, TemporalLayersNotDisabledIfSupported) {
   // 2 TLs configured, temporal layers supported by encoder.
   const int kNumTemporalLayers = 2;